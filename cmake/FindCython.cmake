@@ -0,0 +1,24 @@
+# Find Cython
+# Cython_FOUND - found Cython
+# CYTHON_EXECUTABLE - Cython compiler
+# Cython_VERSION - Cython version
+
+find_program(CYTHON_EXECUTABLE NAMES cython cython3)
+
+if(CYTHON_EXECUTABLE)
+  execute_process(
+    COMMAND ${CYTHON_EXECUTABLE} --version
+    OUTPUT_VARIABLE Cython_VERSION
+    ERROR_VARIABLE Cython_VERSION
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    ERROR_STRIP_TRAILING_WHITESPACE)
+  string(REGEX MATCH "[0-9]+\\.[0-9]+(\\.[0-9]+)?"
+         Cython_VERSION "${Cython_VERSION}")
+endif()
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(Cython
+  REQUIRED_VARS CYTHON_EXECUTABLE
+  VERSION_VAR Cython_VERSION)
+
+mark_as_advanced(CYTHON_EXECUTABLE)
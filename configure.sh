@@ -50,7 +50,7 @@ The following flags enable optional features (disable with --no-<option name>).
 
 The following options configure parameterized features.
 
-  --language-bindings[=java,python,all]
+  --language-bindings[=java,java-api,python,python-api,all]
                           specify language bindings to build
 
 Optional Packages:
@@ -146,7 +146,9 @@ profiling=default
 readline=default
 
 language_bindings_java=default
+language_bindings_java_api=default
 language_bindings_python=default
+language_bindings_python_api=default
 
 abc_dir=default
 antlr_dir=default
@@ -295,7 +297,9 @@ do
       for l in $lang; do
         case $l in
           java) language_bindings_java=ON ;;
+          java-api) language_bindings_java_api=ON ;;
           python) language_bindings_python=ON ;;
+          python-api) language_bindings_python_api=ON ;;
           all)
             language_bindings_python=ON
             language_bindings_java=ON ;;
@@ -429,8 +433,12 @@ cmake_opts=""
 
 [ $language_bindings_java != default ] \
   && cmake_opts="$cmake_opts -DBUILD_BINDINGS_JAVA=$language_bindings_java"
+[ $language_bindings_java_api != default ] \
+  && cmake_opts="$cmake_opts -DBUILD_BINDINGS_JAVA_API=$language_bindings_java_api"
 [ $language_bindings_python != default ] \
   && cmake_opts="$cmake_opts -DBUILD_BINDINGS_PYTHON=$language_bindings_python"
+[ $language_bindings_python_api != default ] \
+  && cmake_opts="$cmake_opts -DBUILD_BINDINGS_PYTHON_API=$language_bindings_python_api"
 
 [ "$abc_dir" != default ] \
   && cmake_opts="$cmake_opts -DABC_DIR=$abc_dir"
@@ -0,0 +1,81 @@
+/*********************                                                        */
+/*! \file replay.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief CVC4 trace replayer
+ **
+ ** The CVC4 trace replayer executable. This program executes a trace of API
+ ** calls recorded by Solver::startTrace, and prints the time each call took,
+ ** so that slow queries can be reproduced and bisected offline. Without
+ ** argument, it records and replays a small trace.
+ **/
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <cvc4/api/cvc4cpp.h>
+
+using namespace CVC4::api;
+
+/** Record a small trace to out */
+void record(std::ostream& out)
+{
+  Solver slv;
+  slv.startTrace(out);
+  slv.setOption("incremental", "true");
+  slv.setOption("produce-models", "true");
+  slv.setLogic("QF_LIA");
+  Term x = slv.mkConst(slv.getIntegerSort(), "x");
+  Term y = slv.mkConst(slv.getIntegerSort(), "y");
+  slv.assertFormula(slv.mkTerm(GT, slv.mkTerm(PLUS, x, y), slv.mkReal(3)));
+  slv.push();
+  slv.assertFormula(slv.mkTerm(LT, x, slv.mkReal(0)));
+  slv.checkSat();
+  slv.getValue(x);
+  slv.pop();
+  slv.checkSatAssuming(slv.mkTerm(EQUAL, x, y));
+  slv.stopTrace();
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc > 2)
+  {
+    std::cerr << "usage: " << argv[0] << " [trace]" << std::endl;
+    return 1;
+  }
+  std::stringstream demo;
+  std::ifstream file;
+  std::istream* in = &demo;
+  if (argc == 2)
+  {
+    file.open(argv[1], std::ios::binary);
+    if (!file)
+    {
+      std::cerr << "cannot open " << argv[1] << std::endl;
+      return 1;
+    }
+    in = &file;
+  }
+  else
+  {
+    record(demo);
+  }
+  try
+  {
+    Solver slv;
+    slv.replayTrace(*in, std::cout);
+  }
+  catch (const CVC4ApiException& e)
+  {
+    std::cerr << e.getMessage() << std::endl;
+    return 1;
+  }
+  return 0;
+}
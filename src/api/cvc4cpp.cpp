@@ -45,14 +45,21 @@
 #include "options/main_options.h"
 #include "options/options.h"
 #include "options/smt_options.h"
+#include "smt/binary_format.h"
+#include "smt/command.h"
 #include "smt/model.h"
 #include "smt/smt_engine.h"
 #include "theory/logic_info.h"
+#include "theory/theory_id.h"
 #include "util/random.h"
 #include "util/result.h"
 #include "util/utility.h"
 
+#include <atomic>
+#include <chrono>
 #include <cstring>
+#include <future>
+#include <limits>
 #include <sstream>
 
 namespace CVC4 {
@@ -1266,9 +1273,68 @@ size_t OpHashFunction::operator()(const Op& t) const
 /* Term                                                                       */
 /* -------------------------------------------------------------------------- */
 
-Term::Term() : d_expr(new CVC4::Expr()) {}
+struct Term::ExprPtr::Box
+{
+  Box(const CVC4::Expr& e) : d_refs(1), d_expr(e) {}
+  /** The number of pointers to this box. */
+  uint32_t d_refs;
+  /** The expression. */
+  CVC4::Expr d_expr;
+};
+
+Term::ExprPtr::ExprPtr() : d_box(nullptr) {}
+
+Term::ExprPtr::ExprPtr(const CVC4::Expr& e) : d_box(new Box(e)) {}
+
+Term::ExprPtr::ExprPtr(const ExprPtr& p) : d_box(p.d_box)
+{
+  if (d_box != nullptr)
+  {
+    ++d_box->d_refs;
+  }
+}
+
+Term::ExprPtr::~ExprPtr() { release(); }
+
+Term::ExprPtr& Term::ExprPtr::operator=(const ExprPtr& p)
+{
+  if (p.d_box != nullptr)
+  {
+    ++p.d_box->d_refs;
+  }
+  release();
+  d_box = p.d_box;
+  return *this;
+}
+
+void Term::ExprPtr::release()
+{
+  if (d_box != nullptr && --d_box->d_refs == 0)
+  {
+    delete d_box;
+  }
+}
 
-Term::Term(const CVC4::Expr& e) : d_expr(new CVC4::Expr(e)) {}
+CVC4::Expr& Term::ExprPtr::operator*() const
+{
+  Assert(d_box != nullptr);
+  return d_box->d_expr;
+}
+
+CVC4::Expr* Term::ExprPtr::operator->() const
+{
+  Assert(d_box != nullptr);
+  return &d_box->d_expr;
+}
+
+CVC4::Expr* Term::ExprPtr::get() const
+{
+  return d_box == nullptr ? nullptr : &d_box->d_expr;
+}
+
+Term::Term() : d_expr(CVC4::Expr()) {}
+
+Term::Term(const CVC4::Expr& e) : d_expr(e) {}
 
 Term::~Term() {}
 
@@ -1457,18 +1523,17 @@ Term Term::iteTerm(const Term& then_t, const Term& else_t) const
 
 std::string Term::toString() const { return d_expr->toString(); }
 
-Term::const_iterator::const_iterator() : d_orig_expr(nullptr), d_pos(0) {}
+Term::const_iterator::const_iterator() : d_orig_expr(), d_pos(0) {}
 
-Term::const_iterator::const_iterator(const std::shared_ptr<CVC4::Expr>& e,
-                                     uint32_t p)
+Term::const_iterator::const_iterator(const ExprPtr& e, uint32_t p)
     : d_orig_expr(e), d_pos(p)
 {
 }
 
 Term::const_iterator::const_iterator(const const_iterator& it)
-    : d_orig_expr(nullptr)
+    : d_orig_expr()
 {
-  if (it.d_orig_expr != nullptr)
+  if (it.d_orig_expr.get() != nullptr)
   {
     d_orig_expr = it.d_orig_expr;
     d_pos = it.d_pos;
@@ -1484,7 +1549,7 @@ Term::const_iterator& Term::const_iterator::operator=(const const_iterator& it)
 
 bool Term::const_iterator::operator==(const const_iterator& it) const
 {
-  if (d_orig_expr == nullptr || it.d_orig_expr == nullptr)
+  if (d_orig_expr.get() == nullptr || it.d_orig_expr.get() == nullptr)
   {
     return false;
   }
@@ -1498,14 +1563,14 @@ bool Term::const_iterator::operator!=(const const_iterator& it) const
 
 Term::const_iterator& Term::const_iterator::operator++()
 {
-  Assert(d_orig_expr != nullptr);
+  Assert(d_orig_expr.get() != nullptr);
   ++d_pos;
   return *this;
 }
 
 Term::const_iterator Term::const_iterator::operator++(int)
 {
-  Assert(d_orig_expr != nullptr);
+  Assert(d_orig_expr.get() != nullptr);
   const_iterator it = *this;
   ++d_pos;
   return it;
@@ -1513,7 +1578,7 @@ Term::const_iterator Term::const_iterator::operator++(int)
 
 Term Term::const_iterator::operator*() const
 {
-  Assert(d_orig_expr != nullptr);
+  Assert(d_orig_expr.get() != nullptr);
   if (!d_pos && (d_orig_expr->getKind() == CVC4::Kind::APPLY_UF))
   {
     return Term(d_orig_expr->getOperator());
@@ -2070,6 +2135,243 @@ size_t RoundingModeHashFunction::operator()(const RoundingMode& rm) const
   return size_t(rm);
 }
 
+/* -------------------------------------------------------------------------- */
+/* Asynchronous satisfiability checks                                         */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * The state of a check run by Solver::checkSatAsync, which is shared by its
+ * handles and the thread running it.
+ */
+struct CheckSatAsyncState
+{
+  CheckSatAsyncState() : d_cancelled(false) {}
+  ~CheckSatAsyncState()
+  {
+    d_cancelled = true;
+    if (d_result.valid())
+    {
+      d_result.wait();
+    }
+  }
+  /** Whether the check was cancelled. */
+  std::atomic<bool> d_cancelled;
+  /** The result of the check. */
+  std::shared_future<Result> d_result;
+};
+
+namespace {
+
+/**
+ * The number of times resources are spent between two notifications of a
+ * CheckSatProgressListener, which bounds the latency of cancellation.
+ */
+const uint64_t s_checkSatProgressInterval = 100;
+
+/** Get the value of statistic name of smt, or 0 if it does not exist. */
+uint64_t getIntStatistic(SmtEngine* smt, const std::string& name)
+{
+  SExpr value = smt->getStatistic(name);
+  return value.isInteger() ? value.getIntegerValue().getUnsignedLong() : 0;
+}
+
+/**
+ * Listens to the progress of a check of Solver::checkSatAsync, on the thread
+ * running the check. Interrupts the check when it is cancelled, and reports
+ * its progress to the user callback.
+ */
+class CheckSatProgressListener : public Listener
+{
+ public:
+  CheckSatProgressListener(SmtEngine* smt,
+                           CheckSatAsyncState* state,
+                           std::function<void(const CheckSatProgress&)> progress,
+                           uint64_t periodMillis)
+      : d_smt(smt),
+        d_state(state),
+        d_progress(progress),
+        d_period(periodMillis),
+        d_start(std::chrono::steady_clock::now()),
+        d_next(d_start + d_period)
+  {
+  }
+
+  void notify() override
+  {
+    if (d_state->d_cancelled)
+    {
+      d_smt->interrupt();
+      return;
+    }
+    if (!d_progress)
+    {
+      return;
+    }
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    if (now < d_next)
+    {
+      return;
+    }
+    d_next = now + d_period;
+    CheckSatProgress p;
+    p.d_conflicts = getIntStatistic(d_smt, "sat::conflicts");
+    p.d_decisions = getIntStatistic(d_smt, "sat::decisions");
+    p.d_lemmas = 0;
+    for (theory::TheoryId tid = theory::THEORY_FIRST;
+         tid < theory::THEORY_LAST;
+         ++tid)
+    {
+      p.d_lemmas +=
+          getIntStatistic(d_smt, theory::getStatsPrefix(tid) + "::lemmas");
+    }
+    p.d_resourceUnits = d_smt->getResourceUsage();
+    p.d_elapsedMillis =
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - d_start)
+            .count();
+    d_progress(p);
+  }
+
+ private:
+  SmtEngine* d_smt;
+  CheckSatAsyncState* d_state;
+  std::function<void(const CheckSatProgress&)> d_progress;
+  std::chrono::milliseconds d_period;
+  std::chrono::steady_clock::time_point d_start;
+  /** The earliest time at which the progress is reported next. */
+  std::chrono::steady_clock::time_point d_next;
+};
+
+}  // namespace
+
+CheckSatHandle::CheckSatHandle(std::shared_ptr<CheckSatAsyncState> state)
+    : d_state(state)
+{
+}
+
+Result CheckSatHandle::get() const { return d_state->d_result.get(); }
+
+bool CheckSatHandle::isReady() const { return waitFor(0); }
+
+bool CheckSatHandle::waitFor(uint64_t millis) const
+{
+  return d_state->d_result.wait_for(std::chrono::milliseconds(millis))
+         == std::future_status::ready;
+}
+
+void CheckSatHandle::cancel() const { d_state->d_cancelled = true; }
+
+/* -------------------------------------------------------------------------- */
+/* Bulk term construction                                                     */
+/* -------------------------------------------------------------------------- */
+
+/** The terms of a TermBuilder, indexed by their handles. */
+class TermBuilderPrivate
+{
+ public:
+  TermBuilderPrivate(NodeManager* nm) : d_nm(nm) {}
+  /** The node manager of the solver of the builder. */
+  NodeManager* d_nm;
+  /** The terms of the builder. */
+  std::vector<Node> d_nodes;
+};
+
+TermBuilder::TermBuilder(const Solver& solver) : d_solver(&solver)
+{
+  CVC4::ExprManagerScope exmgrs(*(solver.d_exprMgr.get()));
+  d_private.reset(new TermBuilderPrivate(NodeManager::currentNM()));
+}
+
+TermBuilder::~TermBuilder()
+{
+  // the terms are released by the node manager of the solver
+  NodeManagerScope nms(d_private->d_nm);
+  d_private.reset();
+}
+
+void TermBuilder::reserve(size_t n) { d_private->d_nodes.reserve(n); }
+
+size_t TermBuilder::size() const { return d_private->d_nodes.size(); }
+
+TermBuilder::Handle TermBuilder::addTerm(Term t)
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_ARG_CHECK_EXPECTED(!t.isNull(), t) << "non-null term";
+  CVC4_API_ARG_CHECK_EXPECTED(
+      t.d_expr->getExprManager() == d_solver->d_exprMgr.get(), t)
+      << "a term of the solver of this builder";
+  std::vector<Node>& nodes = d_private->d_nodes;
+  CVC4_API_CHECK(nodes.size() < std::numeric_limits<Handle>::max())
+      << "Too many terms in builder";
+  NodeManagerScope nms(d_private->d_nm);
+  nodes.push_back(Node::fromExpr(*t.d_expr));
+  return nodes.size() - 1;
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
+TermBuilder::Handle TermBuilder::mkTerm(Kind kind,
+                                        const Handle* children,
+                                        size_t n)
+{
+  return mkTermInternal(kind, nullptr, children, n);
+}
+
+TermBuilder::Handle TermBuilder::mkTerm(Kind kind,
+                                        const std::vector<Handle>& children)
+{
+  return mkTermInternal(kind, nullptr, children.data(), children.size());
+}
+
+TermBuilder::Handle TermBuilder::mkTerm(Op op,
+                                        const std::vector<Handle>& children)
+{
+  return mkTermInternal(op.d_kind, &op, children.data(), children.size());
+}
+
+TermBuilder::Handle TermBuilder::mkTermInternal(Kind kind,
+                                                const Op* op,
+                                                const Handle* children,
+                                                size_t n)
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  std::vector<Node>& nodes = d_private->d_nodes;
+  for (size_t i = 0; i < n; ++i)
+  {
+    CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
+        children[i] < nodes.size(), "child handle", children[i], i)
+        << "a handle of this builder";
+  }
+  CVC4_API_CHECK(nodes.size() < std::numeric_limits<Handle>::max())
+      << "Too many terms in builder";
+  d_solver->checkMkTerm(kind, n);
+
+  NodeManagerScope nms(d_private->d_nm);
+  NodeBuilder<> nb(d_private->d_nm, extToIntKind(kind));
+  if (op != nullptr && op->isIndexedHelper())
+  {
+    nb << Node::fromExpr(*op->d_expr);
+  }
+  for (size_t i = 0; i < n; ++i)
+  {
+    nb << nodes[children[i]];
+  }
+  nodes.push_back(nb.constructNode());
+  return nodes.size() - 1;
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
+Term TermBuilder::getTerm(Handle h) const
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_ARG_CHECK_EXPECTED(h < d_private->d_nodes.size(), h)
+      << "a handle of this builder";
+  NodeManagerScope nms(d_private->d_nm);
+  const Node& n = d_private->d_nodes[h];
+  (void)n.getType(true); /* kick off type checking */
+  return Term(n.toExpr());
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
 /* -------------------------------------------------------------------------- */
 /* Solver                                                                     */
 /* -------------------------------------------------------------------------- */
@@ -2083,8 +2385,29 @@ Solver::Solver(Options* opts)
   if (opts == nullptr) delete o;
 }
 
+Solver::Solver(std::shared_ptr<ExprManager> exprMgr)
+    : d_exprMgr(exprMgr)
+{
+  d_smtEngine.reset(new SmtEngine(d_exprMgr.get()));
+  d_rng.reset(new Random(d_exprMgr->getOptions()[options::seed]));
+}
+
 Solver::~Solver() {}
 
+std::unique_ptr<Solver> Solver::mkSharedSolver() const
+{
+  return std::unique_ptr<Solver>(new Solver(d_exprMgr));
+}
+
+std::unique_ptr<Solver> Solver::fork() const
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  std::unique_ptr<Solver> res(new Solver(d_exprMgr));
+  res->d_smtEngine->forkFrom(*d_smtEngine);
+  return res;
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
 /* Helpers                                                                    */
 /* -------------------------------------------------------------------------- */
 
@@ -3391,6 +3714,10 @@ void Solver::assertFormula(Term term) const
   // CHECK:
   // NodeManager::fromExprManager(d_exprMgr)
   // == NodeManager::fromExprManager(expr.getExprManager())
+  if (d_trace)
+  {
+    d_trace->writeAssertion(*term.d_expr);
+  }
   d_smtEngine->assertFormula(*term.d_expr);
 }
 
@@ -3401,6 +3728,10 @@ Result Solver::checkSat(void) const
 {
   // CHECK:
   // if d_queryMade -> incremental enabled
+  if (d_trace)
+  {
+    d_trace->writeCheckSat();
+  }
   CVC4::Result r = d_smtEngine->checkSat();
   return Result(r);
 }
@@ -3412,6 +3743,10 @@ Result Solver::checkSatAssuming(Term assumption) const
 {
   // CHECK:
   // if assumptions.size() > 0:  incremental enabled?
+  if (d_trace)
+  {
+    d_trace->writeCheckSatAssuming({*assumption.d_expr});
+  }
   CVC4::Result r = d_smtEngine->checkSat(*assumption.d_expr);
   return Result(r);
 }
@@ -3424,10 +3759,98 @@ Result Solver::checkSatAssuming(const std::vector<Term>& assumptions) const
   // CHECK:
   // if assumptions.size() > 0:  incremental enabled?
   std::vector<Expr> eassumptions = termVectorToExprs(assumptions);
+  if (d_trace)
+  {
+    d_trace->writeCheckSatAssuming(eassumptions);
+  }
   CVC4::Result r = d_smtEngine->checkSat(eassumptions);
   return Result(r);
 }
 
+uint32_t Solver::minimize(Term term) const
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_ARG_CHECK_NOT_NULL(term);
+
+  return d_smtEngine->addObjective(*term.d_expr, true);
+
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
+uint32_t Solver::maximize(Term term) const
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_ARG_CHECK_NOT_NULL(term);
+
+  return d_smtEngine->addObjective(*term.d_expr, false);
+
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
+uint32_t Solver::assertSoft(Term formula, uint32_t weight) const
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_ARG_CHECK_NOT_NULL(formula);
+  CVC4_API_ARG_CHECK_EXPECTED(weight > 0, weight) << "a positive weight";
+
+  return d_smtEngine->assertSoft(*formula.d_expr, weight);
+
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
+Result Solver::checkOpt() const
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+
+  CVC4::Result r = d_smtEngine->checkOpt();
+  return Result(r);
+
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
+Term Solver::getObjectiveValue(uint32_t index) const
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+
+  return d_smtEngine->getObjectiveValue(index);
+
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
+CheckSatHandle Solver::checkSatAsync(
+    std::function<void(const CheckSatProgress&)> progress,
+    uint64_t periodMillis) const
+{
+  std::shared_ptr<CheckSatAsyncState> state =
+      std::make_shared<CheckSatAsyncState>();
+  SmtEngine* smt = d_smtEngine.get();
+  CheckSatAsyncState* s = state.get();
+  auto check = [smt, s, progress, periodMillis]() -> Result {
+    // interrupting is only safe from the thread running the check, hence
+    // cancellation is polled by the progress listener
+    std::unique_ptr<ListenerCollection::Registration> registration(
+        smt->registerProgressListener(
+            new CheckSatProgressListener(smt, s, progress, periodMillis),
+            s_checkSatProgressInterval));
+    if (s->d_cancelled)
+    {
+      return Result(CVC4::Result(CVC4::Result::SAT_UNKNOWN,
+                                 CVC4::Result::INTERRUPTED));
+    }
+    try
+    {
+      return Result(smt->checkSat());
+    }
+    catch (const CVC4::Exception& e)
+    {
+      throw CVC4ApiException(e.getMessage());
+    }
+  };
+  // the state outlives the thread, since its destructor waits for it
+  state->d_result = std::async(std::launch::async, check);
+  return CheckSatHandle(state);
+}
+
 /**
  *  ( declare-datatype <symbol> <datatype_decl> )
  */
@@ -3788,6 +4211,37 @@ std::vector<Term> Solver::getUnsatCore(void) const
   return res;
 }
 
+bool Solver::getNextMus(std::vector<Term>& mus) const
+{
+  std::vector<Expr> emus;
+  if (!d_smtEngine->getNextMus(emus))
+  {
+    return false;
+  }
+  mus.clear();
+  for (const Expr& e : emus)
+  {
+    mus.push_back(Term(e));
+  }
+  return true;
+}
+
+std::string Solver::getStatisticsJson() const
+{
+  Statistics emStats = d_exprMgr->getStatistics();
+  Statistics smtStats = d_smtEngine->getStatistics();
+  std::stringstream ss;
+  StatisticsBase::flushInformationJson(ss, {&emStats, &smtStats});
+  return ss.str();
+}
+
+std::string Solver::getStatisticsDeltaJson() const
+{
+  std::stringstream ss;
+  d_smtEngine->getStatisticsDelta().flushInformationJson(ss);
+  return ss.str();
+}
+
 /**
  *  ( get-value ( <term> ) )
  */
@@ -3796,6 +4250,10 @@ Term Solver::getValue(Term term) const
   // CHECK:
   // NodeManager::fromExprManager(d_exprMgr)
   // == NodeManager::fromExprManager(expr.getExprManager())
+  if (d_trace)
+  {
+    d_trace->writeGetValue({*term.d_expr});
+  }
   return d_smtEngine->getValue(*term.d_expr);
 }
 
@@ -3808,11 +4266,17 @@ std::vector<Term> Solver::getValue(const std::vector<Term>& terms) const
   // for e in exprs:
   // NodeManager::fromExprManager(d_exprMgr)
   // == NodeManager::fromExprManager(e.getExprManager())
+  std::vector<Expr> eterms = termVectorToExprs(terms);
+  if (d_trace)
+  {
+    d_trace->writeGetValue(eterms);
+  }
+  std::vector<Expr> values = d_smtEngine->getValues(eterms);
   std::vector<Term> res;
-  for (const Term& t : terms)
+  for (const Expr& v : values)
   {
     /* Can not use emplace_back here since constructor is private. */
-    res.push_back(Term(d_smtEngine->getValue(*t.d_expr)));
+    res.push_back(Term(v));
   }
   return res;
 }
@@ -3831,6 +4295,10 @@ void Solver::pop(uint32_t nscopes) const
 
   for (uint32_t n = 0; n < nscopes; ++n)
   {
+    if (d_trace)
+    {
+      d_trace->writePop();
+    }
     d_smtEngine->pop();
   }
 
@@ -3855,6 +4323,10 @@ void Solver::push(uint32_t nscopes) const
 
   for (uint32_t n = 0; n < nscopes; ++n)
   {
+    if (d_trace)
+    {
+      d_trace->writePush();
+    }
     d_smtEngine->push();
   }
 
@@ -3866,10 +4338,62 @@ void Solver::push(uint32_t nscopes) const
  */
 void Solver::reset(void) const { d_smtEngine->reset(); }
 
+void Solver::readBinary(std::istream& in) const
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  BinaryFormatReader reader(d_exprMgr.get(), in);
+  for (;;)
+  {
+    std::unique_ptr<Command> cmd(reader.nextCommand());
+    if (cmd == nullptr)
+    {
+      break;
+    }
+    cmd->invoke(d_smtEngine.get());
+    const CommandFailure* failure =
+        dynamic_cast<const CommandFailure*>(cmd->getCommandStatus());
+    CVC4_API_CHECK(failure == nullptr) << failure->getMessage();
+  }
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
+void Solver::replayTrace(std::istream& in, std::ostream& timings) const
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  BinaryFormatReader reader(d_exprMgr.get(), in);
+  for (size_t i = 0;; i++)
+  {
+    std::unique_ptr<Command> cmd(reader.nextCommand());
+    if (cmd == nullptr)
+    {
+      break;
+    }
+    auto start = std::chrono::steady_clock::now();
+    cmd->invoke(d_smtEngine.get());
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    const CommandFailure* failure =
+        dynamic_cast<const CommandFailure*>(cmd->getCommandStatus());
+    CVC4_API_CHECK(failure == nullptr) << failure->getMessage();
+    timings << i << " " << cmd->getCommandName() << " " << elapsed.count()
+            << std::endl;
+  }
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
 /**
  *  ( reset-assertions )
  */
-void Solver::resetAssertions(void) const { d_smtEngine->resetAssertions(); }
+void Solver::resetAssertions(void) const
+{
+  if (d_trace)
+  {
+    d_trace->writeResetAssertions();
+  }
+  d_smtEngine->resetAssertions();
+}
+
+void Solver::recycle(void) const { d_smtEngine->recycle(); }
 
 // TODO: issue #2781
 void Solver::setLogicHelper(const std::string& logic) const
@@ -3879,6 +4403,10 @@ void Solver::setLogicHelper(const std::string& logic) const
   try
   {
     CVC4::LogicInfo logic_info(logic);
+    if (d_trace)
+    {
+      d_trace->writeLogic(logic);
+    }
     d_smtEngine->setLogic(logic_info);
   }
   catch (CVC4::IllegalArgumentException& e)
@@ -3928,6 +4456,10 @@ void Solver::setOption(const std::string& option,
       << "Invalid call to 'setOption', solver is already fully initialized";
   try
   {
+    if (d_trace)
+    {
+      d_trace->writeSetOption(option, value);
+    }
     d_smtEngine->setOption(option, value);
   }
   catch (CVC4::OptionException& e)
@@ -3936,6 +4468,29 @@ void Solver::setOption(const std::string& option,
   }
 }
 
+void Solver::startTrace(std::ostream& out)
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  d_trace.reset(new BinaryFormatWriter(out));
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
+void Solver::stopTrace() { d_trace.reset(); }
+
+void Solver::writeBinary(std::ostream& out) const
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  // this fully initializes the SMT engine, after which the logic is set
+  std::vector<Expr> assertions = d_smtEngine->getAssertions();
+  BinaryFormatWriter writer(out);
+  writer.writeLogic(d_smtEngine->getLogicInfo().getLogicString());
+  for (const Expr& e : assertions)
+  {
+    writer.writeAssertion(e);
+  }
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
 Term Solver::ensureTermSort(const Term& term, const Sort& sort) const
 {
   CVC4_API_CHECK(term.getSort() == sort
@@ -21,6 +21,8 @@
 
 #include "api/cvc4cppkind.h"
 
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <set>
@@ -32,6 +34,7 @@
 
 namespace CVC4 {
 
+class BinaryFormatWriter;
 class Expr;
 class Datatype;
 class DatatypeConstructor;
@@ -541,6 +544,7 @@ struct CVC4_PUBLIC SortHashFunction
 class CVC4_PUBLIC Op
 {
   friend class Solver;
+  friend class TermBuilder;
   friend struct OpHashFunction;
 
  public:
@@ -671,8 +675,36 @@ class CVC4_PUBLIC Term
   friend class Datatype;
   friend class DatatypeConstructor;
   friend class Solver;
+  friend class TermBuilder;
   friend struct TermHashFunction;
 
+  /**
+   * A reference-counted pointer to an internal expression. The count is
+   * stored with the expression, so that a term with a new expression is
+   * created with a single allocation. The count is not atomic (as the
+   * reference counts of the internal expressions are not), so that terms are
+   * copied and destroyed without atomic operations.
+   */
+  class ExprPtr
+  {
+   public:
+    ExprPtr();
+    ExprPtr(const CVC4::Expr& e);
+    ExprPtr(const ExprPtr& p);
+    ~ExprPtr();
+    ExprPtr& operator=(const ExprPtr& p);
+    CVC4::Expr& operator*() const;
+    CVC4::Expr* operator->() const;
+    /** @return the expression, or nullptr if this pointer is null */
+    CVC4::Expr* get() const;
+
+   private:
+    struct Box;
+    /** Release the reference to d_box. */
+    void release();
+    Box* d_box;
+  };
+
  public:
   // !!! This constructor is only temporarily public until the parser is fully
   // migrated to the new API. !!!
@@ -831,10 +863,10 @@ class CVC4_PUBLIC Term
 
     /**
      * Constructor
-     * @param e a shared pointer to the expression that we're iterating over
+     * @param e a pointer to the expression that we're iterating over
      * @param p the position of the iterator (e.g. which child it's on)
      */
-    const_iterator(const std::shared_ptr<CVC4::Expr>& e, uint32_t p);
+    const_iterator(const ExprPtr& e, uint32_t p);
 
     /**
      * Copy constructor.
@@ -882,7 +914,7 @@ class CVC4_PUBLIC Term
 
    private:
     /* The original expression to be iterated over */
-    std::shared_ptr<CVC4::Expr> d_orig_expr;
+    ExprPtr d_orig_expr;
     /* Keeps track of the iteration position */
     uint32_t d_pos;
   };
@@ -910,11 +942,8 @@ class CVC4_PUBLIC Term
 
   /**
    * The internal expression wrapped by this term.
-   * This is a shared_ptr rather than a unique_ptr to avoid overhead due to
-   * memory allocation (CVC4::Expr is already ref counted, so this could be
-   * a unique_ptr instead).
    */
-  std::shared_ptr<CVC4::Expr> d_expr;
+  ExprPtr d_expr;
 };
 
 /**
@@ -1626,6 +1655,182 @@ struct CVC4_PUBLIC RoundingModeHashFunction
   inline size_t operator()(const RoundingMode& rm) const;
 };
 
+/* -------------------------------------------------------------------------- */
+/* Asynchronous satisfiability checks                                         */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Lightweight counters describing the progress of a running satisfiability
+ * check, see Solver::checkSatAsync. The counters of the solver are
+ * cumulative over all checks. They are zero if CVC4 was built without
+ * statistics.
+ */
+struct CVC4_PUBLIC CheckSatProgress
+{
+  /** The number of conflicts of the SAT solver. */
+  uint64_t d_conflicts;
+  /** The number of decisions of the SAT solver. */
+  uint64_t d_decisions;
+  /** The number of lemmas sent by the theory solvers. */
+  uint64_t d_lemmas;
+  /** The number of resource units spent by the solver. */
+  uint64_t d_resourceUnits;
+  /** The number of milliseconds elapsed since the check started. */
+  uint64_t d_elapsedMillis;
+};
+
+struct CheckSatAsyncState;
+
+/**
+ * A handle of a satisfiability check running on a separate thread, see
+ * Solver::checkSatAsync. Copies of a handle refer to the same check. When
+ * the last copy is destroyed, the check is cancelled and waited for.
+ */
+class CVC4_PUBLIC CheckSatHandle
+{
+  friend class Solver;
+
+ public:
+  /**
+   * Wait for the check to finish.
+   * @return the result of the check, which is unknown (with explanation
+   * INTERRUPTED) if the check was cancelled
+   */
+  Result get() const;
+
+  /**
+   * @return true if the check has finished
+   */
+  bool isReady() const;
+
+  /**
+   * Wait for the check to finish, for at most the given time.
+   * @param millis the maximal number of milliseconds to wait
+   * @return true if the check has finished
+   */
+  bool waitFor(uint64_t millis) const;
+
+  /**
+   * Cancel the check. This returns immediately, the check stops shortly
+   * afterwards with an unknown result. This has no effect if the check has
+   * already finished.
+   */
+  void cancel() const;
+
+ private:
+  /**
+   * Constructor.
+   * @param state the state of the check
+   */
+  CheckSatHandle(std::shared_ptr<CheckSatAsyncState> state);
+
+  /** The state of the check, shared with the thread running it. */
+  std::shared_ptr<CheckSatAsyncState> d_state;
+};
+
+/* -------------------------------------------------------------------------- */
+/* Bulk term construction                                                     */
+/* -------------------------------------------------------------------------- */
+
+class TermBuilderPrivate;
+
+/**
+ * A builder for constructing many terms at once, e.g. a large DAG. The terms
+ * of a builder are referred to by handles, which are indices into the
+ * builder, so that building a term neither allocates a Term nor converts
+ * between the API and internal representations of terms. The kind and
+ * number of children of each term are checked when it is built, its type is
+ * checked when it is retrieved with getTerm(), at once for all the terms it
+ * contains. A builder must not be used concurrently with its solver from
+ * different threads.
+ */
+class CVC4_PUBLIC TermBuilder
+{
+ public:
+  /** The handle of a term of a builder. */
+  typedef uint32_t Handle;
+
+  /**
+   * Constructor.
+   * @param solver the solver whose terms are built, which must outlive the
+   * builder
+   */
+  TermBuilder(const Solver& solver);
+
+  /**
+   * Destructor.
+   */
+  ~TermBuilder();
+
+  /**
+   * Disallow copy/assignment.
+   */
+  TermBuilder(const TermBuilder&) = delete;
+  TermBuilder& operator=(const TermBuilder&) = delete;
+
+  /**
+   * Reserve space for the given number of terms.
+   * @param n the number of terms
+   */
+  void reserve(size_t n);
+
+  /**
+   * @return the number of terms of this builder
+   */
+  size_t size() const;
+
+  /**
+   * Add an existing term (e.g. a constant or a variable) to this builder.
+   * @param t the term, which must belong to the solver of this builder
+   * @return the handle of the term
+   */
+  Handle addTerm(Term t);
+
+  /**
+   * Build a term of the given kind.
+   * @param kind the kind of the term
+   * @param children the handles of the children of the term
+   * @param n the number of children
+   * @return the handle of the term
+   */
+  Handle mkTerm(Kind kind, const Handle* children, size_t n);
+
+  /**
+   * Build a term of the given kind.
+   * @param kind the kind of the term
+   * @param children the handles of the children of the term
+   * @return the handle of the term
+   */
+  Handle mkTerm(Kind kind, const std::vector<Handle>& children);
+
+  /**
+   * Build a term of the given operator.
+   * @param op the operator of the term
+   * @param children the handles of the children of the term
+   * @return the handle of the term
+   */
+  Handle mkTerm(Op op, const std::vector<Handle>& children);
+
+  /**
+   * Get a term of this builder, after checking its type.
+   * @param h the handle of the term
+   * @return the term
+   */
+  Term getTerm(Handle h) const;
+
+ private:
+  /** Make the term of kind k and the given children, with operator op. */
+  Handle mkTermInternal(Kind kind,
+                        const Op* op,
+                        const Handle* children,
+                        size_t n);
+
+  /** The solver of this builder. */
+  const Solver* d_solver;
+  /** The terms of this builder. */
+  std::unique_ptr<TermBuilderPrivate> d_private;
+};
+
 /* -------------------------------------------------------------------------- */
 /* Solver                                                                     */
 /* -------------------------------------------------------------------------- */
@@ -1635,6 +1840,8 @@ struct CVC4_PUBLIC RoundingModeHashFunction
  */
 class CVC4_PUBLIC Solver
 {
+  friend class TermBuilder;
+
  public:
   /* .................................................................... */
   /* Constructors/Destructors                                             */
@@ -1658,6 +1865,29 @@ class CVC4_PUBLIC Solver
   Solver(const Solver&) = delete;
   Solver& operator=(const Solver&) = delete;
 
+  /**
+   * Create a new solver that shares the term store of this solver.
+   * Sorts and terms of this solver (or of any other solver sharing its term
+   * store) can be used in the new solver as they are, without being copied.
+   * The new solver has its own assertion stack, but shares the options of
+   * this solver. Solvers that share a term store must not be used
+   * concurrently from different threads.
+   * @return the new solver
+   */
+  std::unique_ptr<Solver> mkSharedSolver() const;
+
+  /**
+   * Create a fork of this solver. The fork shares the term store of this
+   * solver (see mkSharedSolver()), and starts with the logic, the declared
+   * symbols, the defined functions and the current assertions of this
+   * solver. The latter are asserted at the base level of the fork, so that
+   * popping the fork never removes them. The fork and this solver can then
+   * be extended and checked independently, e.g. to explore the branches of
+   * a common prefix breadth-first. Requires option produce-assertions.
+   * @return the fork
+   */
+  std::unique_ptr<Solver> fork() const;
+
   /* .................................................................... */
   /* Sorts Handling                                                       */
   /* .................................................................... */
@@ -2381,6 +2611,67 @@ class CVC4_PUBLIC Solver
    */
   Result checkSatAssuming(const std::vector<Term>& assumptions) const;
 
+  /**
+   * Add an objective to minimize. The objectives are optimized by
+   * checkOpt(), lexicographically in the order in which they were added.
+   * @param term the term to minimize, of sort Int, Real or bit-vector
+   * (interpreted as unsigned)
+   * @return the index of the objective
+   */
+  uint32_t minimize(Term term) const;
+
+  /**
+   * Add an objective to maximize. The objectives are optimized by
+   * checkOpt(), lexicographically in the order in which they were added.
+   * @param term the term to maximize, of sort Int, Real or bit-vector
+   * (interpreted as unsigned)
+   * @return the index of the objective
+   */
+  uint32_t maximize(Term term) const;
+
+  /**
+   * Assert a soft formula. The soft formulas form a single objective, added
+   * with the first of them, which is the total weight of the violated soft
+   * formulas to minimize.
+   * Requires to enable option 'produce-unsat-assumptions'.
+   * @param formula the soft formula
+   * @param weight the (positive) weight of the formula
+   * @return the index of the objective of the soft formulas
+   */
+  uint32_t assertSoft(Term formula, uint32_t weight = 1) const;
+
+  /**
+   * Check satisfiability and optimize the objectives.
+   * Requires to enable options 'produce-models' and 'incremental'.
+   * @return the result of the satisfiability check, which is unknown if the
+   * optimum of an objective was not shown (in which case the model has the
+   * best values found)
+   */
+  Result checkOpt() const;
+
+  /**
+   * Get the value of an objective found by the last call to checkOpt().
+   * @param index the index of the objective
+   * @return the value of the objective, or the null term if none was found
+   */
+  Term getObjectiveValue(uint32_t index) const;
+
+  /**
+   * Check satisfiability on a separate thread, and return immediately.
+   * Until the check has finished, this solver (and solvers sharing its term
+   * store) must not be used, except through the returned handle. The solver
+   * must outlive the handle.
+   * @param progress a callback that is called periodically with the progress
+   * of the check, or an empty function. It is called on the thread running
+   * the check, and must not throw.
+   * @param periodMillis the minimal number of milliseconds between two calls
+   * of progress
+   * @return a handle to wait for, query or cancel the check
+   */
+  CheckSatHandle checkSatAsync(
+      std::function<void(const CheckSatProgress&)> progress = nullptr,
+      uint64_t periodMillis = 100) const;
+
   /**
    * Check validity.
    * @return the result of the validity check.
@@ -2552,6 +2843,32 @@ class CVC4_PUBLIC Solver
    */
   std::vector<Term> getUnsatCore() const;
 
+  /**
+   * Get a minimal unsatisfiable subset of the assertions that was not
+   * returned by a previous call since the last check. Requires to enable
+   * option 'unsat-cores-assumptions'.
+   * @param mus the minimal unsatisfiable subset, if one exists
+   * @return true if there is such a minimal unsatisfiable subset
+   */
+  bool getNextMus(std::vector<Term>& mus) const;
+
+  /**
+   * Get the statistics of the solver as a JSON object, which maps the names
+   * of the statistics to their values.
+   * @return the statistics as a JSON object
+   */
+  std::string getStatisticsJson() const;
+
+  /**
+   * Get the change of the statistics of the solver from the check before the
+   * last check (or the start) to the last check, as a JSON object. The
+   * values of numeric statistics are their increase, the values of other
+   * statistics are their value after the last check.
+   * Requires to enable option 'stats'.
+   * @return the change of the statistics as a JSON object
+   */
+  std::string getStatisticsDeltaJson() const;
+
   /**
    * Get the value of the given term.
    * SMT-LIB: ( get-value ( <term> ) )
@@ -2588,6 +2905,24 @@ class CVC4_PUBLIC Solver
    */
   void push(uint32_t nscopes = 1) const;
 
+  /**
+   * Read the commands of an input in the binary format of CVC4 (see
+   * writeBinary) from the given input stream, and execute them.
+   * @param in the input stream
+   */
+  void readBinary(std::istream& in) const;
+
+  /**
+   * Execute the commands of a trace recorded by startTrace, as readBinary,
+   * and write the time each of them took to the given output stream, one
+   * line "<index> <command> <seconds>" per command. This is meant to
+   * reproduce slow queries offline, with the options and the interleaving of
+   * the calls of the recorded run.
+   * @param in the input stream of the trace
+   * @param timings the output stream for the timings
+   */
+  void replayTrace(std::istream& in, std::ostream& timings) const;
+
   /**
    * Reset the solver.
    * SMT-LIB: ( reset )
@@ -2600,6 +2935,15 @@ class CVC4_PUBLIC Solver
    */
   void resetAssertions() const;
 
+  /**
+   * Reset the solver for an independent query, as reset() followed by
+   * setLogic() with the logic that was set, if any, and with the options
+   * the solver was created with. This is meant for pools of solvers that
+   * serve independent queries: the terms of the solver remain valid, and the
+   * memory allocated for the previous queries is reused.
+   */
+  void recycle() const;
+
   /**
    * Set info.
    * SMT-LIB: ( set-info <attribute> )
@@ -2623,6 +2967,35 @@ class CVC4_PUBLIC Solver
    */
   void setOption(const std::string& option, const std::string& value) const;
 
+  /**
+   * Start recording the calls to this solver to the given output stream, in
+   * the binary format of CVC4 (see writeBinary). The recorded calls are
+   * setLogic, setOption, assertFormula, checkSat, checkSatAssuming,
+   * getValue, push, pop and resetAssertions; the terms and sorts they refer
+   * to are written once, when they are first used. A call is recorded before
+   * it is executed; if it cannot be recorded (see writeBinary), an exception
+   * is thrown and the call is not executed. To capture all options, start
+   * recording before the first call to setOption. The trace can be replayed
+   * with replayTrace, or read as input language "binary".
+   * @param out the output stream, which must outlive the recording
+   */
+  void startTrace(std::ostream& out);
+
+  /**
+   * Stop recording the calls to this solver (see startTrace).
+   */
+  void stopTrace();
+
+  /**
+   * Write the logic and the current assertions to the given output stream in
+   * the binary format of CVC4. This format preserves the sharing of terms
+   * and is read in linear time, by readBinary or as input language "binary".
+   * Requires to enable option 'produce-assertions'. Datatypes and parametric
+   * sorts are not supported.
+   * @param out the output stream
+   */
+  void writeBinary(std::ostream& out) const;
+
   /**
    * If needed, convert this term to a given sort. Note that the sort of the
    * term must be convertible into the target sort. Currently only Int to Real
@@ -2641,6 +3014,8 @@ class CVC4_PUBLIC Solver
   SmtEngine* getSmtEngine(void) const;
 
  private:
+  /* Constructor for a solver that uses the given expression manager. */
+  Solver(std::shared_ptr<ExprManager> exprMgr);
   /* Helper to convert a vector of internal types to sorts. */
   std::vector<Type> sortVectorToTypes(const std::vector<Sort>& vector) const;
   /* Helper to convert a vector of sorts to internal types. */
@@ -2672,12 +3047,14 @@ class CVC4_PUBLIC Solver
    */
   Term ensureRealSort(Term expr) const;
 
-  /* The expression manager of this solver. */
-  std::unique_ptr<ExprManager> d_exprMgr;
+  /* The expression manager of this solver (shared by mkSharedSolver()). */
+  std::shared_ptr<ExprManager> d_exprMgr;
   /* The SMT engine of this solver. */
   std::unique_ptr<SmtEngine> d_smtEngine;
   /* The random number generator of this solver. */
   std::unique_ptr<Random> d_rng;
+  /* The writer of the trace of the calls to this solver, if recording. */
+  std::unique_ptr<BinaryFormatWriter> d_trace;
 };
 
 }  // namespace api
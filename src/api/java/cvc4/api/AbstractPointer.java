@@ -0,0 +1,50 @@
+/*********************                                                        */
+/*! \file AbstractPointer.java
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A Java object owning a C++ object.
+ **
+ ** A Java object owning a C++ object of the API, which is deleted by its solver.
+ **/
+
+package cvc4.api;
+
+/**
+ * A Java object that owns a C++ object of the API (a sort, a term or a
+ * result), allocated by the native code and referred to by its address. The
+ * C++ objects are deleted when their solver is closed, which keeps them
+ * alive until then, so that no finalizer and no JNI global reference is
+ * needed.
+ */
+abstract class AbstractPointer {
+  protected final Solver solver;
+  protected final long pointer;
+
+  AbstractPointer(Solver solver, long pointer) {
+    this.solver = solver;
+    this.pointer = pointer;
+    solver.addPointer(this);
+  }
+
+  /** @return the address of the C++ object */
+  long getPointer() {
+    return pointer;
+  }
+
+  /** Delete the C++ object, called by the solver only. */
+  abstract void deletePointer();
+
+  /** @return the addresses of the C++ objects of the given array */
+  static long[] getPointers(AbstractPointer[] objects) {
+    long[] pointers = new long[objects.length];
+    for (int i = 0; i < objects.length; i++) {
+      pointers[i] = objects[i].pointer;
+    }
+    return pointers;
+  }
+}
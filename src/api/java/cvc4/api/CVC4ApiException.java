@@ -0,0 +1,22 @@
+/*********************                                                        */
+/*! \file CVC4ApiException.java
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The exception of the Java API.
+ **
+ ** The exception thrown by the Java API for the exceptions of the C++ API.
+ **/
+
+package cvc4.api;
+
+/** An exception of the C++ API, or an invalid use of the Java API. */
+public class CVC4ApiException extends RuntimeException {
+  public CVC4ApiException(String message) {
+    super(message);
+  }
+}
@@ -0,0 +1,57 @@
+/*********************                                                        */
+/*! \file Result.java
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The result of a satisfiability check.
+ **
+ ** The result of a satisfiability check of the Java API.
+ **/
+
+package cvc4.api;
+
+/** The result of a satisfiability check. */
+public class Result extends AbstractPointer {
+  Result(Solver solver, long pointer) {
+    super(solver, pointer);
+  }
+
+  @Override
+  void deletePointer() {
+    deletePointer(pointer);
+  }
+
+  private static native void deletePointer(long pointer);
+
+  /** @return true if the query was satisfiable */
+  public boolean isSat() {
+    return isSat(pointer);
+  }
+
+  private native boolean isSat(long pointer);
+
+  /** @return true if the query was unsatisfiable */
+  public boolean isUnsat() {
+    return isUnsat(pointer);
+  }
+
+  private native boolean isUnsat(long pointer);
+
+  /** @return true if the satisfiability of the query is unknown */
+  public boolean isSatUnknown() {
+    return isSatUnknown(pointer);
+  }
+
+  private native boolean isSatUnknown(long pointer);
+
+  @Override
+  public String toString() {
+    return toString(pointer);
+  }
+
+  private native String toString(long pointer);
+}
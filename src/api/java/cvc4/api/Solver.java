@@ -0,0 +1,369 @@
+/*********************                                                        */
+/*! \file Solver.java
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The solver of the Java API.
+ **
+ ** The solver of the Java API, which wraps the Solver of the C++ API.
+ **/
+
+package cvc4.api;
+
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * A solver, which wraps a Solver of the C++ API.
+ *
+ * The sorts, terms and results of a solver own C++ objects, which are all
+ * deleted when the solver is closed; they must not be used afterwards. Each
+ * native method only uses JNI local references, and the methods that take or
+ * return arrays of terms (mkConsts, mkTerms, assertFormulas, getValue) cross
+ * JNI once for the whole array, passing the addresses of the terms as a
+ * long[].
+ *
+ * A solver must not be used concurrently from different threads.
+ */
+public class Solver implements AutoCloseable {
+  static {
+    System.loadLibrary("cvc4apijni");
+  }
+
+  private long pointer;
+
+  /** The objects owned by this solver, deleted by close() */
+  private final List<AbstractPointer> pointers = new ArrayList<>();
+
+  public Solver() {
+    pointer = newSolver();
+  }
+
+  private native long newSolver();
+
+  /**
+   * Delete the C++ objects of all the sorts, terms and results of this
+   * solver, and the C++ solver.
+   */
+  @Override
+  public void close() {
+    if (pointer == 0) {
+      return;
+    }
+    for (AbstractPointer p : pointers) {
+      p.deletePointer();
+    }
+    pointers.clear();
+    deletePointer(pointer);
+    pointer = 0;
+  }
+
+  private static native void deletePointer(long pointer);
+
+  void addPointer(AbstractPointer p) {
+    pointers.add(p);
+  }
+
+  Term[] wrapTerms(long[] termPointers) {
+    Term[] terms = new Term[termPointers.length];
+    for (int i = 0; i < termPointers.length; i++) {
+      terms[i] = new Term(this, termPointers[i]);
+    }
+    return terms;
+  }
+
+  /* Sorts ----------------------------------------------------------------- */
+
+  /** @return the Boolean sort */
+  public Sort getBooleanSort() {
+    return new Sort(this, getBooleanSort(pointer));
+  }
+
+  private native long getBooleanSort(long pointer);
+
+  /** @return the integer sort */
+  public Sort getIntegerSort() {
+    return new Sort(this, getIntegerSort(pointer));
+  }
+
+  private native long getIntegerSort(long pointer);
+
+  /** @return the real sort */
+  public Sort getRealSort() {
+    return new Sort(this, getRealSort(pointer));
+  }
+
+  private native long getRealSort(long pointer);
+
+  /**
+   * @param size the size of the bit-vectors
+   * @return the bit-vector sort of the given size
+   */
+  public Sort mkBitVectorSort(int size) {
+    return new Sort(this, mkBitVectorSort(pointer, size));
+  }
+
+  private native long mkBitVectorSort(long pointer, int size);
+
+  /**
+   * @param symbol the name of the sort
+   * @return a new uninterpreted sort
+   */
+  public Sort mkUninterpretedSort(String symbol) {
+    return new Sort(this, mkUninterpretedSort(pointer, symbol));
+  }
+
+  private native long mkUninterpretedSort(long pointer, String symbol);
+
+  /**
+   * @param domain the sorts of the arguments
+   * @param codomain the sort of the result
+   * @return the sort of the functions from domain to codomain
+   */
+  public Sort mkFunctionSort(Sort[] domain, Sort codomain) {
+    return new Sort(this,
+        mkFunctionSort(pointer, AbstractPointer.getPointers(domain),
+            codomain.getPointer()));
+  }
+
+  private native long mkFunctionSort(
+      long pointer, long[] domainPointers, long codomainPointer);
+
+  /* Terms ----------------------------------------------------------------- */
+
+  /** @return the Boolean constant true */
+  public Term mkTrue() {
+    return new Term(this, mkBoolean(pointer, true));
+  }
+
+  /** @return the Boolean constant false */
+  public Term mkFalse() {
+    return new Term(this, mkBoolean(pointer, false));
+  }
+
+  private native long mkBoolean(long pointer, boolean value);
+
+  /**
+   * @param value the value of the constant
+   * @return an integer constant
+   */
+  public Term mkInteger(long value) {
+    return new Term(this, mkInteger(pointer, value));
+  }
+
+  private native long mkInteger(long pointer, long value);
+
+  /**
+   * @param value a decimal or rational number, e.g. "1.5" or "3/2"
+   * @return a real constant
+   */
+  public Term mkReal(String value) {
+    return new Term(this, mkReal(pointer, value));
+  }
+
+  private native long mkReal(long pointer, String value);
+
+  /**
+   * @param size the size of the bit-vector
+   * @param value the value of the bit-vector
+   * @return a bit-vector constant
+   */
+  public Term mkBitVector(int size, long value) {
+    return new Term(this, mkBitVector(pointer, size, value));
+  }
+
+  private native long mkBitVector(long pointer, int size, long value);
+
+  /**
+   * @param sort the sort of the constant
+   * @param symbol the name of the constant
+   * @return a new free constant
+   */
+  public Term mkConst(Sort sort, String symbol) {
+    return new Term(this, mkConst(pointer, sort.getPointer(), symbol));
+  }
+
+  private native long mkConst(long pointer, long sortPointer, String symbol);
+
+  /**
+   * @param sort the sort of the constants
+   * @param symbols the names of the constants
+   * @return a new free constant for each of the symbols
+   */
+  public Term[] mkConsts(Sort sort, String[] symbols) {
+    return wrapTerms(mkConsts(pointer, sort.getPointer(), symbols));
+  }
+
+  private native long[] mkConsts(
+      long pointer, long sortPointer, String[] symbols);
+
+  /**
+   * @param kind the kind of the term
+   * @param children the children of the term
+   * @return the term of the given kind and children
+   */
+  public Term mkTerm(Kind kind, Term... children) {
+    return new Term(this,
+        mkTerm(pointer, kind.getValue(), AbstractPointer.getPointers(children)));
+  }
+
+  private native long mkTerm(long pointer, int kind, long[] childPointers);
+
+  /**
+   * Build a DAG of terms with a single JNI call. The nodes of the DAG are
+   * numbered from 0: the first ones are the given leaves, and node
+   * leaves.length + i is the application of kinds[i] to the next
+   * numChildren[i] nodes of children, which must all be smaller than it.
+   * Only the terms of the roots are returned, which are wrapped in Java
+   * objects; the inner nodes never cross JNI.
+   *
+   * @param leaves the terms the DAG is built from, e.g. its free constants
+   * @param kinds the kinds of the inner nodes
+   * @param numChildren the number of children of the inner nodes
+   * @param children the children of the inner nodes, one after the other
+   * @param roots the nodes whose terms are returned
+   * @return the terms of the roots, in the same order
+   */
+  public Term[] mkTerms(Term[] leaves, Kind[] kinds, int[] numChildren,
+      int[] children, int[] roots) {
+    if (kinds.length != numChildren.length) {
+      throw new CVC4ApiException(
+          "expected as many numbers of children as kinds");
+    }
+    int[] kindValues = new int[kinds.length];
+    for (int i = 0; i < kinds.length; i++) {
+      kindValues[i] = kinds[i].getValue();
+    }
+    return wrapTerms(mkTerms(pointer, AbstractPointer.getPointers(leaves),
+        kindValues, numChildren, children, roots));
+  }
+
+  private native long[] mkTerms(long pointer, long[] leafPointers, int[] kinds,
+      int[] numChildren, int[] children, int[] roots);
+
+  /* Commands -------------------------------------------------------------- */
+
+  /**
+   * @param logic the logic, e.g. "QF_LIA"
+   */
+  public void setLogic(String logic) {
+    setLogic(pointer, logic);
+  }
+
+  private native void setLogic(long pointer, String logic);
+
+  /**
+   * @param option the name of the option
+   * @param value the value of the option
+   */
+  public void setOption(String option, String value) {
+    setOption(pointer, option, value);
+  }
+
+  private native void setOption(long pointer, String option, String value);
+
+  /**
+   * @param option the name of the option
+   * @return the value of the option
+   */
+  public String getOption(String option) {
+    return getOption(pointer, option);
+  }
+
+  private native String getOption(long pointer, String option);
+
+  /**
+   * @param term the formula to assert
+   */
+  public void assertFormula(Term term) {
+    assertFormulas(pointer, new long[] {term.getPointer()});
+  }
+
+  /**
+   * Assert all the given formulas, with a single JNI call.
+   * @param terms the formulas to assert
+   */
+  public void assertFormulas(Term[] terms) {
+    assertFormulas(pointer, AbstractPointer.getPointers(terms));
+  }
+
+  private native void assertFormulas(long pointer, long[] termPointers);
+
+  /** @return the result of the satisfiability check of the assertions */
+  public Result checkSat() {
+    return new Result(this, checkSat(pointer));
+  }
+
+  private native long checkSat(long pointer);
+
+  /**
+   * @param assumptions the formulas to assume
+   * @return the result of the satisfiability check of the assertions and
+   * the assumptions
+   */
+  public Result checkSatAssuming(Term... assumptions) {
+    return new Result(this,
+        checkSatAssuming(pointer, AbstractPointer.getPointers(assumptions)));
+  }
+
+  private native long checkSatAssuming(long pointer, long[] assumptionPointers);
+
+  /**
+   * @param term the term to evaluate
+   * @return the value of the term in the current model
+   */
+  public Term getValue(Term term) {
+    return getValue(new Term[] {term})[0];
+  }
+
+  /**
+   * Get the values of all the given terms, with a single JNI call.
+   * @param terms the terms to evaluate
+   * @return the values of the terms in the current model, in the same order
+   */
+  public Term[] getValue(Term[] terms) {
+    return wrapTerms(getValue(pointer, AbstractPointer.getPointers(terms)));
+  }
+
+  private native long[] getValue(long pointer, long[] termPointers);
+
+  /**
+   * @param nscopes the number of levels to push
+   */
+  public void push(int nscopes) {
+    push(pointer, nscopes);
+  }
+
+  public void push() {
+    push(1);
+  }
+
+  private native void push(long pointer, int nscopes);
+
+  /**
+   * @param nscopes the number of levels to pop
+   */
+  public void pop(int nscopes) {
+    pop(pointer, nscopes);
+  }
+
+  public void pop() {
+    pop(1);
+  }
+
+  private native void pop(long pointer, int nscopes);
+
+  /**
+   * Reset this solver to a state equivalent to a fresh one with the same
+   * options and logic, keeping its terms and sorts.
+   */
+  public void recycle() {
+    recycle(pointer);
+  }
+
+  private native void recycle(long pointer);
+}
@@ -0,0 +1,91 @@
+/*********************                                                        */
+/*! \file Sort.java
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The sorts of the Java API.
+ **
+ ** The sorts of the Java API, which wrap the sorts of the C++ API.
+ **/
+
+package cvc4.api;
+
+/** A sort, which wraps a Sort of the C++ API. */
+public class Sort extends AbstractPointer {
+  Sort(Solver solver, long pointer) {
+    super(solver, pointer);
+  }
+
+  @Override
+  void deletePointer() {
+    deletePointer(pointer);
+  }
+
+  private static native void deletePointer(long pointer);
+
+  /** @return true if this is the Boolean sort */
+  public boolean isBoolean() {
+    return isBoolean(pointer);
+  }
+
+  private native boolean isBoolean(long pointer);
+
+  /** @return true if this is the integer sort */
+  public boolean isInteger() {
+    return isInteger(pointer);
+  }
+
+  private native boolean isInteger(long pointer);
+
+  /** @return true if this is the real sort */
+  public boolean isReal() {
+    return isReal(pointer);
+  }
+
+  private native boolean isReal(long pointer);
+
+  /** @return true if this is a bit-vector sort */
+  public boolean isBitVector() {
+    return isBitVector(pointer);
+  }
+
+  private native boolean isBitVector(long pointer);
+
+  /** @return the size of this bit-vector sort */
+  public int getBVSize() {
+    return getBVSize(pointer);
+  }
+
+  private native int getBVSize(long pointer);
+
+  @Override
+  public boolean equals(Object other) {
+    if (this == other) {
+      return true;
+    }
+    if (!(other instanceof Sort)) {
+      return false;
+    }
+    return equals(pointer, ((Sort) other).pointer);
+  }
+
+  private native boolean equals(long pointer1, long pointer2);
+
+  @Override
+  public int hashCode() {
+    return hashCode(pointer);
+  }
+
+  private native int hashCode(long pointer);
+
+  @Override
+  public String toString() {
+    return toString(pointer);
+  }
+
+  private native String toString(long pointer);
+}
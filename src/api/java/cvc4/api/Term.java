@@ -0,0 +1,84 @@
+/*********************                                                        */
+/*! \file Term.java
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The terms of the Java API.
+ **
+ ** The terms of the Java API, which wrap the terms of the C++ API.
+ **/
+
+package cvc4.api;
+
+/** A term, which wraps a Term of the C++ API. */
+public class Term extends AbstractPointer {
+  Term(Solver solver, long pointer) {
+    super(solver, pointer);
+  }
+
+  @Override
+  void deletePointer() {
+    deletePointer(pointer);
+  }
+
+  private static native void deletePointer(long pointer);
+
+  /** @return the kind of this term */
+  public Kind getKind() {
+    return Kind.fromInt(getKind(pointer));
+  }
+
+  private native int getKind(long pointer);
+
+  /** @return the sort of this term */
+  public Sort getSort() {
+    return new Sort(solver, getSort(pointer));
+  }
+
+  private native long getSort(long pointer);
+
+  /** @return true if this is the null term */
+  public boolean isNull() {
+    return isNull(pointer);
+  }
+
+  private native boolean isNull(long pointer);
+
+  /** @return the children of this term, retrieved with a single JNI call */
+  public Term[] getChildren() {
+    return solver.wrapTerms(getChildren(pointer));
+  }
+
+  private native long[] getChildren(long pointer);
+
+  @Override
+  public boolean equals(Object other) {
+    if (this == other) {
+      return true;
+    }
+    if (!(other instanceof Term)) {
+      return false;
+    }
+    return equals(pointer, ((Term) other).pointer);
+  }
+
+  private native boolean equals(long pointer1, long pointer2);
+
+  @Override
+  public int hashCode() {
+    return hashCode(pointer);
+  }
+
+  private native int hashCode(long pointer);
+
+  @Override
+  public String toString() {
+    return toString(pointer);
+  }
+
+  private native String toString(long pointer);
+}
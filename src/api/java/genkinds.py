@@ -0,0 +1,82 @@
+#!/usr/bin/env python
+#####################
+## genkinds.py
+## This file is part of the CVC4 project.
+## Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+## in the top-level source directory) and their institutional affiliations.
+## All rights reserved.  See the file COPYING in the top-level source
+## directory for licensing information.
+##
+"""
+Generates the Java enum Kind of the kinds of the C++ API from cvc4cppkind.h,
+with the same names and values, so that kinds are passed through JNI as int.
+"""
+
+import argparse
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                '..'))
+from parsekinds import parse_kind_values  # noqa: E402
+
+KIND_JAVA = '''// This file is generated by genkinds.py from cvc4cppkind.h, do not edit.
+
+package cvc4.api;
+
+import java.util.HashMap;
+import java.util.Map;
+
+/** The kinds of the terms of the C++ API. */
+public enum Kind {{
+{values};
+
+  private static final Map<Integer, Kind> byValue = new HashMap<>();
+
+  static {{
+    for (Kind k : Kind.values()) {{
+      byValue.put(k.value, k);
+    }}
+  }}
+
+  private final int value;
+
+  private Kind(int value) {{
+    this.value = value;
+  }}
+
+  /** @return the value of this kind in the C++ API */
+  public int getValue() {{
+    return value;
+  }}
+
+  /**
+   * @param value the value of a kind in the C++ API
+   * @return the kind of the given value
+   */
+  public static Kind fromInt(int value) {{
+    Kind k = byValue.get(value);
+    if (k == null) {{
+      throw new CVC4ApiException("invalid kind value " + value);
+    }}
+    return k;
+  }}
+}}
+'''
+
+
+def generate(kinds, filename):
+    values = ',\n'.join('  {}({})'.format(k, v) for k, v in kinds)
+    with open(filename, 'w') as f:
+        f.write(KIND_JAVA.format(values=values))
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Generate the Java kinds of the C++ API')
+    parser.add_argument('--kinds-header', required=True,
+                        help='the path to cvc4cppkind.h')
+    parser.add_argument('--kinds-file', required=True,
+                        help='the path of the generated Kind.java')
+    args = parser.parse_args()
+    generate(parse_kind_values(args.kinds_header), args.kinds_file)
@@ -0,0 +1,140 @@
+/*********************                                                        */
+/*! \file api_utilities.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Utilities of the JNI code of the Java API.
+ **
+ ** Utilities of the JNI code of the Java API: the conversion of C++
+ ** exceptions to Java ones, and of arrays of C++ objects to and from arrays
+ ** of their addresses.
+ **/
+
+#ifndef CVC4__API__JAVA__API_UTILITIES_H
+#define CVC4__API__JAVA__API_UTILITIES_H
+
+#include <jni.h>
+
+#include <exception>
+#include <string>
+#include <vector>
+
+/**
+ * Throw a cvc4.api.CVC4ApiException with the given message. The exception
+ * is raised in Java when the native method returns.
+ */
+inline void throwCVC4ApiException(JNIEnv* env, const char* message)
+{
+  jclass exceptionClass = env->FindClass("cvc4/api/CVC4ApiException");
+  if (exceptionClass != nullptr)
+  {
+    env->ThrowNew(exceptionClass, message);
+    env->DeleteLocalRef(exceptionClass);
+  }
+}
+
+/**
+ * Wrap the body of a native method, so that the C++ exceptions are thrown
+ * as Java ones, in which case the method returns returnValue.
+ */
+#define CVC4_JAVA_API_TRY_CATCH_BEGIN \
+  try                                 \
+  {
+#define CVC4_JAVA_API_TRY_CATCH_END(env)      \
+  }                                           \
+  catch (const std::exception& e)             \
+  {                                           \
+    throwCVC4ApiException(env, e.what());     \
+  }
+#define CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, returnValue) \
+  CVC4_JAVA_API_TRY_CATCH_END(env)                           \
+  return returnValue;
+
+/**
+ * @return the C++ object at the given address
+ */
+template <class T>
+T* getPointer(jlong pointer)
+{
+  return reinterpret_cast<T*>(pointer);
+}
+
+/**
+ * Convert an array of addresses of C++ objects to a vector of copies of the
+ * objects. The addresses are copied with a single JNI call.
+ */
+template <class T>
+std::vector<T> getObjects(JNIEnv* env, jlongArray pointers)
+{
+  jsize size = env->GetArrayLength(pointers);
+  std::vector<jlong> addresses(size);
+  env->GetLongArrayRegion(pointers, 0, size, addresses.data());
+  std::vector<T> objects;
+  objects.reserve(size);
+  for (jlong address : addresses)
+  {
+    objects.push_back(*getPointer<T>(address));
+  }
+  return objects;
+}
+
+/**
+ * Copy the objects to the heap, and return the array of their addresses,
+ * which are owned by the Java objects that wrap them. The addresses are
+ * copied with a single JNI call.
+ */
+template <class T>
+jlongArray getPointers(JNIEnv* env, const std::vector<T>& objects)
+{
+  std::vector<jlong> addresses;
+  addresses.reserve(objects.size());
+  for (const T& object : objects)
+  {
+    addresses.push_back(reinterpret_cast<jlong>(new T(object)));
+  }
+  jlongArray pointers = env->NewLongArray(addresses.size());
+  if (pointers == nullptr)
+  {
+    // An OutOfMemoryError is pending
+    for (jlong address : addresses)
+    {
+      delete getPointer<T>(address);
+    }
+    return nullptr;
+  }
+  env->SetLongArrayRegion(pointers, 0, addresses.size(), addresses.data());
+  return pointers;
+}
+
+/**
+ * Copy an array of ints with a single JNI call.
+ */
+inline std::vector<jint> getInts(JNIEnv* env, jintArray array)
+{
+  jsize size = env->GetArrayLength(array);
+  std::vector<jint> ints(size);
+  env->GetIntArrayRegion(array, 0, size, ints.data());
+  return ints;
+}
+
+/**
+ * Convert a Java string to a C++ one.
+ */
+inline std::string getString(JNIEnv* env, jstring string)
+{
+  const char* chars = env->GetStringUTFChars(string, nullptr);
+  if (chars == nullptr)
+  {
+    // An OutOfMemoryError is pending
+    return std::string();
+  }
+  std::string result(chars);
+  env->ReleaseStringUTFChars(string, chars);
+  return result;
+}
+
+#endif /* CVC4__API__JAVA__API_UTILITIES_H */
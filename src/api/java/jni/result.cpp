@@ -0,0 +1,65 @@
+/*********************                                                        */
+/*! \file result.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The native methods of cvc4.api.Result.
+ **
+ ** The native methods of cvc4.api.Result.
+ **/
+
+#include "api/cvc4cpp.h"
+#include "api/java/jni/api_utilities.h"
+
+using namespace CVC4::api;
+
+extern "C" {
+
+JNIEXPORT void JNICALL Java_cvc4_api_Result_deletePointer(JNIEnv*,
+                                                          jclass,
+                                                          jlong pointer)
+{
+  delete getPointer<Result>(pointer);
+}
+
+JNIEXPORT jboolean JNICALL Java_cvc4_api_Result_isSat(JNIEnv* env,
+                                                      jobject,
+                                                      jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return getPointer<Result>(pointer)->isSat();
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, false);
+}
+
+JNIEXPORT jboolean JNICALL Java_cvc4_api_Result_isUnsat(JNIEnv* env,
+                                                        jobject,
+                                                        jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return getPointer<Result>(pointer)->isUnsat();
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, false);
+}
+
+JNIEXPORT jboolean JNICALL Java_cvc4_api_Result_isSatUnknown(JNIEnv* env,
+                                                             jobject,
+                                                             jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return getPointer<Result>(pointer)->isSatUnknown();
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, false);
+}
+
+JNIEXPORT jstring JNICALL Java_cvc4_api_Result_toString(JNIEnv* env,
+                                                        jobject,
+                                                        jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return env->NewStringUTF(getPointer<Result>(pointer)->toString().c_str());
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, nullptr);
+}
+
+}  // extern "C"
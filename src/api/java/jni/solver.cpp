@@ -0,0 +1,395 @@
+/*********************                                                        */
+/*! \file solver.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The native methods of cvc4.api.Solver.
+ **
+ ** The native methods of cvc4.api.Solver.
+ **/
+
+#include <sstream>
+
+#include "api/cvc4cpp.h"
+#include "api/java/jni/api_utilities.h"
+
+using namespace CVC4::api;
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL Java_cvc4_api_Solver_newSolver(JNIEnv* env, jobject)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return reinterpret_cast<jlong>(new Solver());
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT void JNICALL Java_cvc4_api_Solver_deletePointer(JNIEnv*,
+                                                          jclass,
+                                                          jlong pointer)
+{
+  delete getPointer<Solver>(pointer);
+}
+
+/* Sorts ------------------------------------------------------------------- */
+
+JNIEXPORT jlong JNICALL Java_cvc4_api_Solver_getBooleanSort(JNIEnv* env,
+                                                            jobject,
+                                                            jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return reinterpret_cast<jlong>(
+      new Sort(getPointer<Solver>(pointer)->getBooleanSort()));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jlong JNICALL Java_cvc4_api_Solver_getIntegerSort(JNIEnv* env,
+                                                            jobject,
+                                                            jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return reinterpret_cast<jlong>(
+      new Sort(getPointer<Solver>(pointer)->getIntegerSort()));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jlong JNICALL Java_cvc4_api_Solver_getRealSort(JNIEnv* env,
+                                                         jobject,
+                                                         jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return reinterpret_cast<jlong>(
+      new Sort(getPointer<Solver>(pointer)->getRealSort()));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jlong JNICALL Java_cvc4_api_Solver_mkBitVectorSort(JNIEnv* env,
+                                                             jobject,
+                                                             jlong pointer,
+                                                             jint size)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  if (size <= 0)
+  {
+    throw CVC4ApiException("expected a positive bit-vector size");
+  }
+  return reinterpret_cast<jlong>(new Sort(
+      getPointer<Solver>(pointer)->mkBitVectorSort(static_cast<uint32_t>(size))));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jlong JNICALL Java_cvc4_api_Solver_mkUninterpretedSort(
+    JNIEnv* env, jobject, jlong pointer, jstring symbol)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return reinterpret_cast<jlong>(new Sort(
+      getPointer<Solver>(pointer)->mkUninterpretedSort(getString(env, symbol))));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jlong JNICALL
+Java_cvc4_api_Solver_mkFunctionSort(JNIEnv* env,
+                                    jobject,
+                                    jlong pointer,
+                                    jlongArray domainPointers,
+                                    jlong codomainPointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  std::vector<Sort> domain = getObjects<Sort>(env, domainPointers);
+  return reinterpret_cast<jlong>(
+      new Sort(getPointer<Solver>(pointer)->mkFunctionSort(
+          domain, *getPointer<Sort>(codomainPointer))));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+/* Terms ------------------------------------------------------------------- */
+
+JNIEXPORT jlong JNICALL Java_cvc4_api_Solver_mkBoolean(JNIEnv* env,
+                                                       jobject,
+                                                       jlong pointer,
+                                                       jboolean value)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return reinterpret_cast<jlong>(
+      new Term(getPointer<Solver>(pointer)->mkBoolean(value)));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jlong JNICALL Java_cvc4_api_Solver_mkInteger(JNIEnv* env,
+                                                       jobject,
+                                                       jlong pointer,
+                                                       jlong value)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return reinterpret_cast<jlong>(new Term(
+      getPointer<Solver>(pointer)->mkReal(static_cast<int64_t>(value))));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jlong JNICALL Java_cvc4_api_Solver_mkReal(JNIEnv* env,
+                                                    jobject,
+                                                    jlong pointer,
+                                                    jstring value)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return reinterpret_cast<jlong>(
+      new Term(getPointer<Solver>(pointer)->mkReal(getString(env, value))));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jlong JNICALL Java_cvc4_api_Solver_mkBitVector(JNIEnv* env,
+                                                         jobject,
+                                                         jlong pointer,
+                                                         jint size,
+                                                         jlong value)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  if (size <= 0)
+  {
+    throw CVC4ApiException("expected a positive bit-vector size");
+  }
+  return reinterpret_cast<jlong>(
+      new Term(getPointer<Solver>(pointer)->mkBitVector(
+          static_cast<uint32_t>(size), static_cast<uint64_t>(value))));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jlong JNICALL Java_cvc4_api_Solver_mkConst(JNIEnv* env,
+                                                     jobject,
+                                                     jlong pointer,
+                                                     jlong sortPointer,
+                                                     jstring symbol)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return reinterpret_cast<jlong>(
+      new Term(getPointer<Solver>(pointer)->mkConst(
+          *getPointer<Sort>(sortPointer), getString(env, symbol))));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jlongArray JNICALL Java_cvc4_api_Solver_mkConsts(JNIEnv* env,
+                                                           jobject,
+                                                           jlong pointer,
+                                                           jlong sortPointer,
+                                                           jobjectArray symbols)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  const Solver* solver = getPointer<Solver>(pointer);
+  const Sort& sort = *getPointer<Sort>(sortPointer);
+  jsize size = env->GetArrayLength(symbols);
+  std::vector<Term> consts;
+  consts.reserve(size);
+  for (jsize i = 0; i < size; ++i)
+  {
+    // Delete the local reference to each symbol, there may be more of them
+    // than the JVM guarantees local references for
+    jstring symbol =
+        static_cast<jstring>(env->GetObjectArrayElement(symbols, i));
+    consts.push_back(solver->mkConst(sort, getString(env, symbol)));
+    env->DeleteLocalRef(symbol);
+  }
+  return getPointers(env, consts);
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, nullptr);
+}
+
+JNIEXPORT jlong JNICALL Java_cvc4_api_Solver_mkTerm(JNIEnv* env,
+                                                    jobject,
+                                                    jlong pointer,
+                                                    jint kind,
+                                                    jlongArray childPointers)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  std::vector<Term> children = getObjects<Term>(env, childPointers);
+  return reinterpret_cast<jlong>(new Term(getPointer<Solver>(pointer)->mkTerm(
+      static_cast<Kind>(kind), children)));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jlongArray JNICALL Java_cvc4_api_Solver_mkTerms(JNIEnv* env,
+                                                          jobject,
+                                                          jlong pointer,
+                                                          jlongArray leafPointers,
+                                                          jintArray kinds,
+                                                          jintArray numChildren,
+                                                          jintArray children,
+                                                          jintArray roots)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  std::vector<Term> leaves = getObjects<Term>(env, leafPointers);
+  std::vector<jint> nodeKinds = getInts(env, kinds);
+  std::vector<jint> nodeNumChildren = getInts(env, numChildren);
+  std::vector<jint> nodeChildren = getInts(env, children);
+  std::vector<jint> rootNodes = getInts(env, roots);
+  if (nodeKinds.size() != nodeNumChildren.size())
+  {
+    throw CVC4ApiException("expected as many numbers of children as kinds");
+  }
+
+  // The nodes are added to the builder in order, so that the children of a
+  // node are handles of the builder
+  TermBuilder builder(*getPointer<Solver>(pointer));
+  builder.reserve(leaves.size() + nodeKinds.size());
+  std::vector<TermBuilder::Handle> handles;
+  handles.reserve(leaves.size() + nodeKinds.size());
+  for (const Term& leaf : leaves)
+  {
+    handles.push_back(builder.addTerm(leaf));
+  }
+  std::vector<TermBuilder::Handle> nodeHandles;
+  size_t next = 0;
+  for (size_t i = 0; i < nodeKinds.size(); ++i)
+  {
+    size_t node = leaves.size() + i;
+    if (nodeNumChildren[i] < 0
+        || nodeChildren.size() - next < static_cast<size_t>(nodeNumChildren[i]))
+    {
+      std::stringstream ss;
+      ss << "invalid number of children " << nodeNumChildren[i]
+         << " of node " << node;
+      throw CVC4ApiException(ss.str());
+    }
+    nodeHandles.clear();
+    for (jint j = 0; j < nodeNumChildren[i]; ++j, ++next)
+    {
+      jint child = nodeChildren[next];
+      if (child < 0 || static_cast<size_t>(child) >= node)
+      {
+        std::stringstream ss;
+        ss << "invalid child " << child << " of node " << node
+           << ", expected a smaller node";
+        throw CVC4ApiException(ss.str());
+      }
+      nodeHandles.push_back(handles[child]);
+    }
+    handles.push_back(builder.mkTerm(static_cast<Kind>(nodeKinds[i]),
+                                     nodeHandles.data(),
+                                     nodeHandles.size()));
+  }
+
+  std::vector<Term> result;
+  result.reserve(rootNodes.size());
+  for (jint root : rootNodes)
+  {
+    if (root < 0 || static_cast<size_t>(root) >= handles.size())
+    {
+      std::stringstream ss;
+      ss << "invalid root " << root;
+      throw CVC4ApiException(ss.str());
+    }
+    result.push_back(builder.getTerm(handles[root]));
+  }
+  return getPointers(env, result);
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, nullptr);
+}
+
+/* Commands ---------------------------------------------------------------- */
+
+JNIEXPORT void JNICALL Java_cvc4_api_Solver_setLogic(JNIEnv* env,
+                                                     jobject,
+                                                     jlong pointer,
+                                                     jstring logic)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  getPointer<Solver>(pointer)->setLogic(getString(env, logic));
+  CVC4_JAVA_API_TRY_CATCH_END(env);
+}
+
+JNIEXPORT void JNICALL Java_cvc4_api_Solver_setOption(JNIEnv* env,
+                                                      jobject,
+                                                      jlong pointer,
+                                                      jstring option,
+                                                      jstring value)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  getPointer<Solver>(pointer)->setOption(getString(env, option),
+                                         getString(env, value));
+  CVC4_JAVA_API_TRY_CATCH_END(env);
+}
+
+JNIEXPORT jstring JNICALL Java_cvc4_api_Solver_getOption(JNIEnv* env,
+                                                         jobject,
+                                                         jlong pointer,
+                                                         jstring option)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  std::string value =
+      getPointer<Solver>(pointer)->getOption(getString(env, option));
+  return env->NewStringUTF(value.c_str());
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, nullptr);
+}
+
+JNIEXPORT void JNICALL Java_cvc4_api_Solver_assertFormulas(
+    JNIEnv* env, jobject, jlong pointer, jlongArray termPointers)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  const Solver* solver = getPointer<Solver>(pointer);
+  for (const Term& t : getObjects<Term>(env, termPointers))
+  {
+    solver->assertFormula(t);
+  }
+  CVC4_JAVA_API_TRY_CATCH_END(env);
+}
+
+JNIEXPORT jlong JNICALL Java_cvc4_api_Solver_checkSat(JNIEnv* env,
+                                                      jobject,
+                                                      jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return reinterpret_cast<jlong>(
+      new Result(getPointer<Solver>(pointer)->checkSat()));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jlong JNICALL Java_cvc4_api_Solver_checkSatAssuming(
+    JNIEnv* env, jobject, jlong pointer, jlongArray assumptionPointers)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  std::vector<Term> assumptions = getObjects<Term>(env, assumptionPointers);
+  return reinterpret_cast<jlong>(
+      new Result(getPointer<Solver>(pointer)->checkSatAssuming(assumptions)));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jlongArray JNICALL Java_cvc4_api_Solver_getValue(
+    JNIEnv* env, jobject, jlong pointer, jlongArray termPointers)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  std::vector<Term> terms = getObjects<Term>(env, termPointers);
+  return getPointers(env, getPointer<Solver>(pointer)->getValue(terms));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, nullptr);
+}
+
+JNIEXPORT void JNICALL Java_cvc4_api_Solver_push(JNIEnv* env,
+                                                 jobject,
+                                                 jlong pointer,
+                                                 jint nscopes)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  getPointer<Solver>(pointer)->push(static_cast<uint32_t>(nscopes));
+  CVC4_JAVA_API_TRY_CATCH_END(env);
+}
+
+JNIEXPORT void JNICALL Java_cvc4_api_Solver_pop(JNIEnv* env,
+                                                jobject,
+                                                jlong pointer,
+                                                jint nscopes)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  getPointer<Solver>(pointer)->pop(static_cast<uint32_t>(nscopes));
+  CVC4_JAVA_API_TRY_CATCH_END(env);
+}
+
+JNIEXPORT void JNICALL Java_cvc4_api_Solver_recycle(JNIEnv* env,
+                                                    jobject,
+                                                    jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  getPointer<Solver>(pointer)->recycle();
+  CVC4_JAVA_API_TRY_CATCH_END(env);
+}
+
+}  // extern "C"
@@ -0,0 +1,102 @@
+/*********************                                                        */
+/*! \file sort.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The native methods of cvc4.api.Sort.
+ **
+ ** The native methods of cvc4.api.Sort.
+ **/
+
+#include "api/cvc4cpp.h"
+#include "api/java/jni/api_utilities.h"
+
+using namespace CVC4::api;
+
+extern "C" {
+
+JNIEXPORT void JNICALL Java_cvc4_api_Sort_deletePointer(JNIEnv*,
+                                                        jclass,
+                                                        jlong pointer)
+{
+  delete getPointer<Sort>(pointer);
+}
+
+JNIEXPORT jboolean JNICALL Java_cvc4_api_Sort_isBoolean(JNIEnv* env,
+                                                        jobject,
+                                                        jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return getPointer<Sort>(pointer)->isBoolean();
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, false);
+}
+
+JNIEXPORT jboolean JNICALL Java_cvc4_api_Sort_isInteger(JNIEnv* env,
+                                                        jobject,
+                                                        jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return getPointer<Sort>(pointer)->isInteger();
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, false);
+}
+
+JNIEXPORT jboolean JNICALL Java_cvc4_api_Sort_isReal(JNIEnv* env,
+                                                     jobject,
+                                                     jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return getPointer<Sort>(pointer)->isReal();
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, false);
+}
+
+JNIEXPORT jboolean JNICALL Java_cvc4_api_Sort_isBitVector(JNIEnv* env,
+                                                          jobject,
+                                                          jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return getPointer<Sort>(pointer)->isBitVector();
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, false);
+}
+
+JNIEXPORT jint JNICALL Java_cvc4_api_Sort_getBVSize(JNIEnv* env,
+                                                    jobject,
+                                                    jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return static_cast<jint>(getPointer<Sort>(pointer)->getBVSize());
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jboolean JNICALL Java_cvc4_api_Sort_equals(JNIEnv* env,
+                                                     jobject,
+                                                     jlong pointer1,
+                                                     jlong pointer2)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return *getPointer<Sort>(pointer1) == *getPointer<Sort>(pointer2);
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, false);
+}
+
+JNIEXPORT jint JNICALL Java_cvc4_api_Sort_hashCode(JNIEnv* env,
+                                                   jobject,
+                                                   jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return static_cast<jint>(SortHashFunction()(*getPointer<Sort>(pointer)));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jstring JNICALL Java_cvc4_api_Sort_toString(JNIEnv* env,
+                                                      jobject,
+                                                      jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return env->NewStringUTF(getPointer<Sort>(pointer)->toString().c_str());
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, nullptr);
+}
+
+}  // extern "C"
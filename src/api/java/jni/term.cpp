@@ -0,0 +1,95 @@
+/*********************                                                        */
+/*! \file term.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The native methods of cvc4.api.Term.
+ **
+ ** The native methods of cvc4.api.Term.
+ **/
+
+#include "api/cvc4cpp.h"
+#include "api/java/jni/api_utilities.h"
+
+using namespace CVC4::api;
+
+extern "C" {
+
+JNIEXPORT void JNICALL Java_cvc4_api_Term_deletePointer(JNIEnv*,
+                                                        jclass,
+                                                        jlong pointer)
+{
+  delete getPointer<Term>(pointer);
+}
+
+JNIEXPORT jint JNICALL Java_cvc4_api_Term_getKind(JNIEnv* env,
+                                                  jobject,
+                                                  jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return static_cast<jint>(getPointer<Term>(pointer)->getKind());
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jlong JNICALL Java_cvc4_api_Term_getSort(JNIEnv* env,
+                                                   jobject,
+                                                   jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return reinterpret_cast<jlong>(new Sort(getPointer<Term>(pointer)->getSort()));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jboolean JNICALL Java_cvc4_api_Term_isNull(JNIEnv* env,
+                                                     jobject,
+                                                     jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return getPointer<Term>(pointer)->isNull();
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, false);
+}
+
+JNIEXPORT jlongArray JNICALL Java_cvc4_api_Term_getChildren(JNIEnv* env,
+                                                            jobject,
+                                                            jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  const Term* term = getPointer<Term>(pointer);
+  std::vector<Term> children(term->begin(), term->end());
+  return getPointers(env, children);
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, nullptr);
+}
+
+JNIEXPORT jboolean JNICALL Java_cvc4_api_Term_equals(JNIEnv* env,
+                                                     jobject,
+                                                     jlong pointer1,
+                                                     jlong pointer2)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return *getPointer<Term>(pointer1) == *getPointer<Term>(pointer2);
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, false);
+}
+
+JNIEXPORT jint JNICALL Java_cvc4_api_Term_hashCode(JNIEnv* env,
+                                                   jobject,
+                                                   jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return static_cast<jint>(TermHashFunction()(*getPointer<Term>(pointer)));
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, 0);
+}
+
+JNIEXPORT jstring JNICALL Java_cvc4_api_Term_toString(JNIEnv* env,
+                                                      jobject,
+                                                      jlong pointer)
+{
+  CVC4_JAVA_API_TRY_CATCH_BEGIN;
+  return env->NewStringUTF(getPointer<Term>(pointer)->toString().c_str());
+  CVC4_JAVA_API_TRY_CATCH_END_RETURN(env, nullptr);
+}
+
+}  // extern "C"
@@ -0,0 +1,80 @@
+#!/usr/bin/env python
+#####################
+## parsekinds.py
+## This file is part of the CVC4 project.
+## Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+## in the top-level source directory) and their institutional affiliations.
+## All rights reserved.  See the file COPYING in the top-level source
+## directory for licensing information.
+##
+"""
+Parses the Kind enum of cvc4cppkind.h, for the generators of the kinds of the
+language bindings (python/genkinds.py, java/genkinds.py).
+"""
+
+import re
+
+ENUM_START = 'enum CVC4_PUBLIC Kind'
+ENUM_END = '};'
+
+# Kinds that are not exposed by the bindings
+SKIPPED = ('INTERNAL_KIND', 'UNDEFINED_KIND', 'LAST_KIND')
+
+
+def camel_case(name):
+    """BITVECTOR_ADD -> BitvectorAdd"""
+    return ''.join(w.capitalize() for w in name.split('_'))
+
+
+def parse_kinds(header):
+    """The names of the kinds of the enum, in declaration order"""
+    return [name for name, _ in parse_kind_values(header)]
+
+
+def parse_kind_values(header):
+    """The names and values of the kinds of the enum, in declaration order"""
+    kinds = []
+    value = 0
+    in_enum = False
+    in_comment = False
+    # The depth of the nested #if blocks, and the depth of the outermost
+    # disabled one (#if 0), if any
+    depth = 0
+    disabled = None
+    with open(header) as f:
+        for line in f:
+            line = line.strip()
+            if not in_enum:
+                in_enum = line.startswith(ENUM_START)
+                continue
+            if in_comment:
+                in_comment = '*/' not in line
+                continue
+            if line.startswith('#if'):
+                depth += 1
+                if disabled is None and line.split()[1:2] == ['0']:
+                    disabled = depth
+                continue
+            if line.startswith('#endif'):
+                if disabled == depth:
+                    disabled = None
+                depth -= 1
+                continue
+            if disabled is not None:
+                continue
+            if line.startswith('/*'):
+                in_comment = '*/' not in line
+                continue
+            if line.startswith('//') or not line:
+                continue
+            if line.startswith(ENUM_END):
+                break
+            m = re.match(r'([A-Z][A-Z0-9_]*)\s*(=\s*-?\d+)?\s*,?$', line)
+            if m:
+                if m.group(2):
+                    value = int(m.group(2).lstrip('=').strip())
+                kinds.append((m.group(1), value))
+                value += 1
+    if not kinds:
+        raise RuntimeError('no kinds found in ' + header)
+    return kinds
@@ -0,0 +1,136 @@
+# The declarations of the C++ API (cvc4cpp.h) used by the Python bindings.
+
+from libc.stdint cimport int32_t, int64_t, uint32_t, uint64_t
+from libcpp cimport bool
+from libcpp.string cimport string
+from libcpp.vector cimport vector
+
+from cvc4kinds cimport Kind
+
+
+cdef extern from "api/cvc4cpp.h" namespace "CVC4":
+    cdef cppclass Options:
+        pass
+
+
+cdef extern from "api/cvc4cpp.h" namespace "CVC4::api":
+    cdef cppclass Result:
+        Result() except +
+        bint isNull() except +
+        bint isSat() except +
+        bint isUnsat() except +
+        bint isSatUnknown() except +
+        bint operator==(const Result& r) except +
+        bint operator!=(const Result& r) except +
+        string getUnknownExplanation() except +
+        string toString() except +
+
+    cdef cppclass Sort:
+        Sort() except +
+        bint operator==(const Sort&) except +
+        bint operator!=(const Sort&) except +
+        bint isNull() except +
+        bint isBoolean() except +
+        bint isInteger() except +
+        bint isReal() except +
+        bint isString() except +
+        bint isBitVector() except +
+        bint isFunction() except +
+        bint isArray() except +
+        uint32_t getBVSize() except +
+        string toString() except +
+
+    cdef cppclass SortHashFunction:
+        SortHashFunction() except +
+        size_t operator()(const Sort& s) except +
+
+    cdef cppclass Op:
+        Op() except +
+        bint operator==(const Op&) except +
+        bint operator!=(const Op&) except +
+        Kind getKind() except +
+        Sort getSort() except +
+        bint isNull() except +
+        bint isIndexed() except +
+        string toString() except +
+
+    cdef cppclass Term:
+        Term() except +
+        bint operator==(const Term&) except +
+        bint operator!=(const Term&) except +
+        Kind getKind() except +
+        Sort getSort() except +
+        Op getOp() except +
+        bint hasOp() except +
+        bint isNull() except +
+        Term notTerm() except +
+        Term andTerm(const Term& t) except +
+        Term orTerm(const Term& t) except +
+        Term eqTerm(const Term& t) except +
+        Term impTerm(const Term& t) except +
+        Term iteTerm(const Term& then_t, const Term& else_t) except +
+        string toString() except +
+        cppclass const_iterator:
+            const_iterator() except +
+            bint operator==(const const_iterator& it) except +
+            bint operator!=(const const_iterator& it) except +
+            const_iterator& operator++()
+            Term operator*() except +
+        const_iterator begin() except +
+        const_iterator end() except +
+
+    cdef cppclass TermHashFunction:
+        TermHashFunction() except +
+        size_t operator()(const Term& t) except +
+
+    cdef cppclass Solver:
+        Solver(Options*) except +
+        Sort getBooleanSort() except +
+        Sort getIntegerSort() except +
+        Sort getRealSort() except +
+        Sort getStringSort() except +
+        Sort mkArraySort(Sort indexSort, Sort elemSort) except +
+        Sort mkBitVectorSort(uint32_t size) except +
+        Sort mkFunctionSort(const vector[Sort]& sorts, Sort codomain) except +
+        Sort mkUninterpretedSort(const string& symbol) except +
+        Term mkTerm(Kind kind, const vector[Term]& children) except +
+        Term mkTerm(Op op, const vector[Term]& children) except +
+        Op mkOp(Kind kind, uint32_t arg) except +
+        Op mkOp(Kind kind, uint32_t arg1, uint32_t arg2) except +
+        Term mkTrue() except +
+        Term mkFalse() except +
+        Term mkBoolean(bint val) except +
+        Term mkReal(const string& s) except +
+        Term mkString(const string& s) except +
+        Term mkBitVector(uint32_t size, uint64_t val) except +
+        Term mkConst(Sort sort, const string& symbol) except +
+        Term mkVar(Sort sort, const string& symbol) except +
+        void assertFormula(Term term) except +
+        Result checkSat() except + nogil
+        Result checkSatAssuming(const vector[Term]& assumptions) except + nogil
+        Term declareFun(const string& symbol, const vector[Sort]& sorts,
+                        Sort sort) except +
+        vector[Term] getAssertions() except +
+        string getInfo(const string& flag) except +
+        string getOption(const string& option) except +
+        vector[Term] getUnsatAssumptions() except +
+        vector[Term] getUnsatCore() except +
+        Term getValue(Term term) except +
+        vector[Term] getValue(const vector[Term]& terms) except +
+        void pop(uint32_t nscopes) except +
+        void push(uint32_t nscopes) except +
+        void reset() except +
+        void resetAssertions() except +
+        void recycle() except +
+        void setInfo(const string& keyword, const string& value) except +
+        void setLogic(const string& logic) except +
+        void setOption(const string& option, const string& value) except +
+
+    cdef cppclass TermBuilder:
+        TermBuilder(const Solver& solver) except +
+        void reserve(size_t n) except +
+        size_t size() except +
+        uint32_t addTerm(Term t) except +
+        uint32_t mkTerm(Kind kind, const uint32_t* children, size_t n) except +
+        uint32_t mkTerm(Op op, const vector[uint32_t]& children) except +
+        Term getTerm(uint32_t h) except +
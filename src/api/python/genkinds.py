@@ -0,0 +1,100 @@
+#!/usr/bin/env python
+#####################
+## genkinds.py
+## This file is part of the CVC4 project.
+## Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+## in the top-level source directory) and their institutional affiliations.
+## All rights reserved.  See the file COPYING in the top-level source
+## directory for licensing information.
+##
+"""
+Generates the Cython declarations of the kinds of the C++ API from
+cvc4cppkind.h, so that the Python bindings never get out of sync with it:
+
+  <prefix>.pxd   the extern declaration of the Kind enum
+  <prefix>.pxi   the Python class kind and the namespace kinds, with one
+                 attribute per kind, included by pycvc4.pyx
+"""
+
+import argparse
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                '..'))
+from parsekinds import SKIPPED, camel_case, parse_kinds  # noqa: E402
+
+PXD_HEADER = '''# This file is generated by genkinds.py from cvc4cppkind.h, do not edit.
+
+cdef extern from "api/cvc4cppkind.h" namespace "CVC4::api":
+    cdef enum Kind:
+'''
+
+PXI_HEADER = '''# This file is generated by genkinds.py from cvc4cppkind.h, do not edit.
+
+cimport cvc4kinds
+
+cdef dict _kind_names = {{
+{names}
+}}
+
+cdef class kind:
+    """A kind of the C++ API, e.g. kinds.And."""
+    cdef cvc4kinds.Kind k
+    cdef str name
+
+    def __cinit__(self, int kindint):
+        self.k = <cvc4kinds.Kind> kindint
+        self.name = _kind_names.get(kindint, "InternalKind")
+
+    def __eq__(self, other):
+        return isinstance(other, kind) and <int> self.k == <int> (<kind> other).k
+
+    def __ne__(self, other):
+        return not self == other
+
+    def __hash__(self):
+        return <int> self.k
+
+    def __str__(self):
+        return self.name
+
+    def __repr__(self):
+        return "kinds." + self.name
+
+    def as_int(self):
+        return <int> self.k
+
+
+class kinds:
+    """The kinds of the C++ API, e.g. kinds.Plus for PLUS."""
+{attributes}
+'''
+
+
+def generate(kinds, prefix):
+    with open(prefix + '.pxd', 'w') as f:
+        f.write(PXD_HEADER)
+        for k in kinds:
+            f.write('        {}\n'.format(k))
+
+    exposed = [k for k in kinds if k not in SKIPPED]
+    names = '\n'.join(
+        '    <int> cvc4kinds.{}: "{}",'.format(k, camel_case(k))
+        for k in exposed)
+    attributes = '\n'.join(
+        '    {} = kind(<int> cvc4kinds.{})'.format(camel_case(k), k)
+        for k in exposed)
+    with open(prefix + '.pxi', 'w') as f:
+        f.write(PXI_HEADER.format(names=names, attributes=attributes))
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Generate the Cython kinds of the C++ API')
+    parser.add_argument('--kinds-header', required=True,
+                        help='the path to cvc4cppkind.h')
+    parser.add_argument('--kinds-file-prefix', required=True,
+                        help='the prefix of the generated files')
+    args = parser.parse_args()
+    generate(parse_kinds(args.kinds_header), args.kinds_file_prefix)
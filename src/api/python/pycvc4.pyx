@@ -0,0 +1,479 @@
+# distutils: language = c++
+#
+# The Python bindings of the C++ API (cvc4cpp.h).
+#
+# Terms and sorts are thin wrappers that hold the C++ objects by value (a
+# single reference counted pointer), together with a reference to their
+# solver, which keeps it alive while they are in use. Methods that take or
+# return many terms (mkConsts, assertFormulas, getValues, TermBuilder) convert
+# between Python and C++ once for the whole batch, and checkSat releases the
+# GIL while the solver runs, so that other Python threads can make progress.
+# C++ exceptions are raised as RuntimeError.
+
+from cython.operator cimport dereference as deref, preincrement as inc
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp.string cimport string
+from libcpp.vector cimport vector
+
+from cvc4 cimport Op as c_Op
+from cvc4 cimport Result as c_Result
+from cvc4 cimport Solver as c_Solver
+from cvc4 cimport Sort as c_Sort
+from cvc4 cimport SortHashFunction as c_SortHashFunction
+from cvc4 cimport Term as c_Term
+from cvc4 cimport TermBuilder as c_TermBuilder
+from cvc4 cimport TermHashFunction as c_TermHashFunction
+from cvc4kinds cimport Kind as c_Kind
+
+include "cvc4kinds.pxi"
+
+# Sorts, operators and terms refer to their solver
+cdef class Solver
+
+
+cdef c_SortHashFunction csorthash = c_SortHashFunction()
+cdef c_TermHashFunction ctermhash = c_TermHashFunction()
+
+
+cdef class Result:
+    cdef c_Result cr
+
+    def isNull(self):
+        return self.cr.isNull()
+
+    def isSat(self):
+        return self.cr.isSat()
+
+    def isUnsat(self):
+        return self.cr.isUnsat()
+
+    def isSatUnknown(self):
+        return self.cr.isSatUnknown()
+
+    def getUnknownExplanation(self):
+        return self.cr.getUnknownExplanation().decode()
+
+    def __eq__(self, other):
+        return isinstance(other, Result) and self.cr == (<Result> other).cr
+
+    def __ne__(self, other):
+        return not self == other
+
+    def __str__(self):
+        return self.cr.toString().decode()
+
+    def __repr__(self):
+        return self.cr.toString().decode()
+
+
+cdef Result _result(c_Result cr):
+    cdef Result r = Result.__new__(Result)
+    r.cr = cr
+    return r
+
+
+cdef class Sort:
+    cdef c_Sort csort
+    cdef Solver solver
+
+    def __cinit__(self, Solver solver):
+        self.solver = solver
+
+    def isBoolean(self):
+        return self.csort.isBoolean()
+
+    def isInteger(self):
+        return self.csort.isInteger()
+
+    def isReal(self):
+        return self.csort.isReal()
+
+    def isString(self):
+        return self.csort.isString()
+
+    def isBitVector(self):
+        return self.csort.isBitVector()
+
+    def isFunction(self):
+        return self.csort.isFunction()
+
+    def isArray(self):
+        return self.csort.isArray()
+
+    def getBVSize(self):
+        return self.csort.getBVSize()
+
+    def __eq__(self, other):
+        return isinstance(other, Sort) and self.csort == (<Sort> other).csort
+
+    def __ne__(self, other):
+        return not self == other
+
+    def __hash__(self):
+        return csorthash(self.csort)
+
+    def __str__(self):
+        return self.csort.toString().decode()
+
+    def __repr__(self):
+        return self.csort.toString().decode()
+
+
+cdef Sort _sort(Solver solver, c_Sort cs):
+    cdef Sort s = Sort.__new__(Sort, solver)
+    s.csort = cs
+    return s
+
+
+cdef class Op:
+    cdef c_Op cop
+    cdef Solver solver
+
+    def __cinit__(self, Solver solver):
+        self.solver = solver
+
+    def getKind(self):
+        return kind(<int> self.cop.getKind())
+
+    def isIndexed(self):
+        return self.cop.isIndexed()
+
+    def __eq__(self, other):
+        return isinstance(other, Op) and self.cop == (<Op> other).cop
+
+    def __ne__(self, other):
+        return not self == other
+
+    def __str__(self):
+        return self.cop.toString().decode()
+
+    def __repr__(self):
+        return self.cop.toString().decode()
+
+
+cdef class Term:
+    cdef c_Term cterm
+    cdef Solver solver
+
+    def __cinit__(self, Solver solver):
+        self.solver = solver
+
+    def getKind(self):
+        return kind(<int> self.cterm.getKind())
+
+    def getSort(self):
+        return _sort(self.solver, self.cterm.getSort())
+
+    def hasOp(self):
+        return self.cterm.hasOp()
+
+    def getOp(self):
+        cdef Op op = Op.__new__(Op, self.solver)
+        op.cop = self.cterm.getOp()
+        return op
+
+    def isNull(self):
+        return self.cterm.isNull()
+
+    def notTerm(self):
+        return _term(self.solver, self.cterm.notTerm())
+
+    def andTerm(self, Term t):
+        return _term(self.solver, self.cterm.andTerm(t.cterm))
+
+    def orTerm(self, Term t):
+        return _term(self.solver, self.cterm.orTerm(t.cterm))
+
+    def eqTerm(self, Term t):
+        return _term(self.solver, self.cterm.eqTerm(t.cterm))
+
+    def impTerm(self, Term t):
+        return _term(self.solver, self.cterm.impTerm(t.cterm))
+
+    def iteTerm(self, Term then_t, Term else_t):
+        return _term(self.solver, self.cterm.iteTerm(then_t.cterm, else_t.cterm))
+
+    def __iter__(self):
+        cdef c_Term.const_iterator it = self.cterm.begin()
+        cdef c_Term.const_iterator end = self.cterm.end()
+        while it != end:
+            yield _term(self.solver, deref(it))
+            inc(it)
+
+    def __eq__(self, other):
+        return isinstance(other, Term) and self.cterm == (<Term> other).cterm
+
+    def __ne__(self, other):
+        return not self == other
+
+    def __hash__(self):
+        return ctermhash(self.cterm)
+
+    def __str__(self):
+        return self.cterm.toString().decode()
+
+    def __repr__(self):
+        return self.cterm.toString().decode()
+
+
+cdef Term _term(Solver solver, c_Term ct):
+    # Terms are created by the solver only, without going through __init__
+    cdef Term t = Term.__new__(Term, solver)
+    t.cterm = ct
+    return t
+
+
+cdef vector[c_Term] _terms(terms) except *:
+    cdef vector[c_Term] v
+    v.reserve(len(terms))
+    for t in terms:
+        v.push_back((<Term?> t).cterm)
+    return v
+
+
+cdef list _termlist(Solver solver, const vector[c_Term]& v):
+    return [_term(solver, ct) for ct in v]
+
+
+cdef vector[c_Sort] _sorts(sorts) except *:
+    cdef vector[c_Sort] v
+    v.reserve(len(sorts))
+    for s in sorts:
+        v.push_back((<Sort?> s).csort)
+    return v
+
+
+cdef class Solver:
+    cdef c_Solver* csolver
+
+    def __cinit__(self):
+        self.csolver = new c_Solver(NULL)
+
+    def __dealloc__(self):
+        del self.csolver
+
+    # Sorts
+
+    def getBooleanSort(self):
+        return _sort(self, self.csolver.getBooleanSort())
+
+    def getIntegerSort(self):
+        return _sort(self, self.csolver.getIntegerSort())
+
+    def getRealSort(self):
+        return _sort(self, self.csolver.getRealSort())
+
+    def getStringSort(self):
+        return _sort(self, self.csolver.getStringSort())
+
+    def mkArraySort(self, Sort indexSort, Sort elemSort):
+        return _sort(self, self.csolver.mkArraySort(indexSort.csort,
+                                                    elemSort.csort))
+
+    def mkBitVectorSort(self, uint32_t size):
+        return _sort(self, self.csolver.mkBitVectorSort(size))
+
+    def mkFunctionSort(self, sorts, Sort codomain):
+        return _sort(self, self.csolver.mkFunctionSort(_sorts(sorts),
+                                                       codomain.csort))
+
+    def mkUninterpretedSort(self, str symbol):
+        return _sort(self, self.csolver.mkUninterpretedSort(symbol.encode()))
+
+    # Terms
+
+    def mkTerm(self, kind_or_op, *children):
+        """
+        Create a term of the given kind or operator, with the terms given as
+        arguments, or in a single list, as children.
+        """
+        if len(children) == 1 and isinstance(children[0], (list, tuple)):
+            children = children[0]
+        cdef vector[c_Term] v = _terms(children)
+        if isinstance(kind_or_op, Op):
+            return _term(self, self.csolver.mkTerm((<Op> kind_or_op).cop, v))
+        return _term(self, self.csolver.mkTerm((<kind?> kind_or_op).k, v))
+
+    def mkOp(self, kind k, *args):
+        cdef Op op = Op.__new__(Op, self)
+        if len(args) == 1:
+            op.cop = self.csolver.mkOp(k.k, <uint32_t> args[0])
+        elif len(args) == 2:
+            op.cop = self.csolver.mkOp(k.k, <uint32_t> args[0],
+                                       <uint32_t> args[1])
+        else:
+            raise ValueError("mkOp expects one or two indices")
+        return op
+
+    def mkTrue(self):
+        return _term(self, self.csolver.mkTrue())
+
+    def mkFalse(self):
+        return _term(self, self.csolver.mkFalse())
+
+    def mkBoolean(self, bint val):
+        return _term(self, self.csolver.mkBoolean(val))
+
+    def mkReal(self, val):
+        """Create a real constant from an int, or a string like "1/3"."""
+        return _term(self, self.csolver.mkReal(str(val).encode()))
+
+    def mkString(self, str s):
+        return _term(self, self.csolver.mkString(s.encode()))
+
+    def mkBitVector(self, uint32_t size, uint64_t val=0):
+        return _term(self, self.csolver.mkBitVector(size, val))
+
+    def mkConst(self, Sort sort, str symbol=""):
+        return _term(self, self.csolver.mkConst(sort.csort, symbol.encode()))
+
+    def mkConsts(self, Sort sort, symbols):
+        """Create a constant of the given sort for each of the symbols."""
+        cdef list result = []
+        for symbol in symbols:
+            result.append(_term(self, self.csolver.mkConst(
+                sort.csort, (<str?> symbol).encode())))
+        return result
+
+    def mkVar(self, Sort sort, str symbol=""):
+        return _term(self, self.csolver.mkVar(sort.csort, symbol.encode()))
+
+    def declareFun(self, str symbol, sorts, Sort sort):
+        return _term(self, self.csolver.declareFun(symbol.encode(),
+                                                   _sorts(sorts), sort.csort))
+
+    # Commands
+
+    def assertFormula(self, Term term):
+        self.csolver.assertFormula(term.cterm)
+
+    def assertFormulas(self, terms):
+        """Assert all the given formulas."""
+        for t in terms:
+            self.csolver.assertFormula((<Term?> t).cterm)
+
+    def checkSat(self):
+        cdef c_Result cr
+        with nogil:
+            cr = self.csolver.checkSat()
+        return _result(cr)
+
+    def checkSatAssuming(self, *assumptions):
+        if len(assumptions) == 1 and isinstance(assumptions[0], (list, tuple)):
+            assumptions = assumptions[0]
+        cdef vector[c_Term] v = _terms(assumptions)
+        cdef c_Result cr
+        with nogil:
+            cr = self.csolver.checkSatAssuming(v)
+        return _result(cr)
+
+    def getAssertions(self):
+        return _termlist(self, self.csolver.getAssertions())
+
+    def getInfo(self, str flag):
+        return self.csolver.getInfo(flag.encode()).decode()
+
+    def getOption(self, str option):
+        return self.csolver.getOption(option.encode()).decode()
+
+    def getUnsatAssumptions(self):
+        return _termlist(self, self.csolver.getUnsatAssumptions())
+
+    def getUnsatCore(self):
+        return _termlist(self, self.csolver.getUnsatCore())
+
+    def getValue(self, Term term):
+        return _term(self, self.csolver.getValue(term.cterm))
+
+    def getValues(self, terms):
+        """Get the values of all the given terms, with a single call."""
+        return _termlist(self, self.csolver.getValue(_terms(terms)))
+
+    def pop(self, uint32_t nscopes=1):
+        self.csolver.pop(nscopes)
+
+    def push(self, uint32_t nscopes=1):
+        self.csolver.push(nscopes)
+
+    def reset(self):
+        self.csolver.reset()
+
+    def resetAssertions(self):
+        self.csolver.resetAssertions()
+
+    def recycle(self):
+        self.csolver.recycle()
+
+    def setInfo(self, str keyword, str value):
+        self.csolver.setInfo(keyword.encode(), value.encode())
+
+    def setLogic(self, str logic):
+        self.csolver.setLogic(logic.encode())
+
+    def setOption(self, str option, str value):
+        self.csolver.setOption(option.encode(), value.encode())
+
+
+cdef class TermBuilder:
+    """
+    A builder for constructing many terms at once, which refers to its terms
+    by integer handles. Terms are only wrapped in Python objects when they are
+    retrieved with getTerm() or getTerms().
+    """
+    cdef c_TermBuilder* cbuilder
+    cdef Solver solver
+
+    def __cinit__(self, Solver solver):
+        self.solver = solver
+        self.cbuilder = new c_TermBuilder(solver.csolver[0])
+
+    def __dealloc__(self):
+        del self.cbuilder
+
+    def __len__(self):
+        return self.cbuilder.size()
+
+    def reserve(self, size_t n):
+        self.cbuilder.reserve(n)
+
+    def addTerm(self, Term t):
+        return self.cbuilder.addTerm(t.cterm)
+
+    def addTerms(self, terms):
+        return [self.cbuilder.addTerm((<Term?> t).cterm) for t in terms]
+
+    def mkTerm(self, kind_or_op, *children):
+        """
+        Build a term of the given kind or operator, with the handles given as
+        arguments, or in a single list, as children. Returns its handle.
+        """
+        if len(children) == 1 and isinstance(children[0], (list, tuple)):
+            children = children[0]
+        cdef vector[uint32_t] v
+        v.reserve(len(children))
+        for h in children:
+            v.push_back(<uint32_t> h)
+        if isinstance(kind_or_op, Op):
+            return self.cbuilder.mkTerm((<Op> kind_or_op).cop, v)
+        return self.cbuilder.mkTerm((<kind?> kind_or_op).k, v.data(), v.size())
+
+    def mkTerms(self, kind k, rows):
+        """
+        Build a term of the given kind for each of the sequences of child
+        handles. Returns the list of their handles.
+        """
+        cdef vector[uint32_t] v
+        cdef list result = []
+        for row in rows:
+            v.clear()
+            for h in row:
+                v.push_back(<uint32_t> h)
+            result.append(self.cbuilder.mkTerm(k.k, v.data(), v.size()))
+        return result
+
+    def getTerm(self, uint32_t h):
+        return _term(self.solver, self.cbuilder.getTerm(h))
+
+    def getTerms(self, handles):
+        return [_term(self.solver, self.cbuilder.getTerm(<uint32_t> h))
+                for h in handles]
@@ -0,0 +1,337 @@
+/*********************                                                        */
+/*! \file cdflat_hashmap.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A context-dependent hash map with flat storage
+ **
+ ** A context-dependent hash map with flat storage. The (key, value) pairs
+ ** are stored inline in a vector, in insertion order, and indexed by an
+ ** open-addressing table with linear probing. The map is the only
+ ** ContextObj: a scope saves the number of entries and the length of a trail
+ ** of overwritten values, and popping the scope undoes the trail and drops
+ ** the entries inserted since.
+ **
+ ** Since keys only disappear on pop, they are removed in the reverse order
+ ** of their insertion. The last inserted key is always at the end of its
+ ** probe sequence, so it is removed by simply clearing its slot.
+ **
+ ** The interface follows CDHashMap<>, with these differences:
+ **  - operator[] returns an Element by value (a handle on the entry);
+ **  - inserting a key may invalidate iterators, and pointers to the data;
+ **  - there is no insertAtContextLevelZero().
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__CONTEXT__CDFLAT_HASHMAP_H
+#define CVC4__CONTEXT__CDFLAT_HASHMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "base/check.h"
+#include "context/context.h"
+
+namespace CVC4 {
+namespace context {
+
+template <class Key, class Data, class HashFcn = std::hash<Key> >
+class CDFlatHashMap : public ContextObj
+{
+ public:
+  using value_type = std::pair<Key, Data>;
+
+ private:
+  /** The value of an empty slot of the table */
+  static const size_t s_empty = std::numeric_limits<size_t>::max();
+
+  /** The hash function */
+  HashFcn d_hash;
+  /** The (key, value) pairs, in insertion order */
+  std::vector<value_type> d_entries;
+  /**
+   * The open-addressing table. Each slot is the index of an entry or
+   * s_empty. The size is a power of two and at least twice the number of
+   * entries.
+   */
+  std::vector<size_t> d_slots;
+  /** 64 minus the base 2 logarithm of the size of d_slots */
+  unsigned d_shift;
+  /**
+   * The old values of the entries overwritten in the scopes above level 0,
+   * with the indices of the entries.
+   */
+  std::vector<std::pair<size_t, Data> > d_trail;
+  /**
+   * The number of entries removed by clear(). The sizes saved for the scopes
+   * and the indices in d_trail count these entries too, so that the entries
+   * inserted after a clear() are dropped by the pops.
+   */
+  size_t d_cleared;
+
+  /** The number of entries when the current scope was saved */
+  size_t d_savedEntries;
+  /** The length of d_trail when the current scope was saved */
+  size_t d_savedTrail;
+  /**
+   * The number of entries at the start of the scope that this map was last
+   * saved for. Values of entries with a smaller index must be logged when
+   * overwritten.
+   */
+  size_t d_scopeStart;
+
+  /** Copy constructor, used by save(). It only copies the sizes. */
+  CDFlatHashMap(const CDFlatHashMap& m)
+      : ContextObj(m),
+        d_hash(m.d_hash),
+        d_shift(64),
+        d_cleared(0),
+        d_savedEntries(m.d_cleared + m.d_entries.size()),
+        d_savedTrail(m.d_trail.size()),
+        d_scopeStart(m.d_scopeStart)
+  {
+  }
+
+  CDFlatHashMap& operator=(const CDFlatHashMap&) = delete;
+
+  ContextObj* save(ContextMemoryManager* pCMM) override
+  {
+    ContextObj* p = new (pCMM) CDFlatHashMap(*this);
+    d_scopeStart = d_cleared + d_entries.size();
+    return p;
+  }
+
+  void restore(ContextObj* data) override
+  {
+    // the saved copy owns no memory, so we do not call its destructor
+    CDFlatHashMap* p = static_cast<CDFlatHashMap*>(data);
+    while (d_trail.size() > p->d_savedTrail)
+    {
+      const std::pair<size_t, Data>& t = d_trail.back();
+      // after a clear(), the entry may be gone
+      if (t.first >= d_cleared)
+      {
+        d_entries[t.first - d_cleared].second = t.second;
+      }
+      d_trail.pop_back();
+    }
+    while (!d_entries.empty()
+           && d_cleared + d_entries.size() > p->d_savedEntries)
+    {
+      size_t slot = findSlot(d_entries.back().first);
+      Assert(d_slots[slot] == d_entries.size() - 1);
+      d_slots[slot] = s_empty;
+      d_entries.pop_back();
+    }
+    d_scopeStart = p->d_scopeStart;
+  }
+
+  /**
+   * Returns the slot of k: the slot with the index of the entry of k, or
+   * the empty slot that ends the probe sequence of k.
+   */
+  size_t findSlot(const Key& k) const
+  {
+    size_t mask = d_slots.size() - 1;
+    // Fibonacci hashing, since many hash functions (e.g. std::hash<int>) do
+    // not spread the keys over the low bits
+    size_t slot = static_cast<size_t>(
+        (static_cast<uint64_t>(d_hash(k)) * 0x9e3779b97f4a7c15ULL) >> d_shift);
+    while (d_slots[slot] != s_empty && !(d_entries[d_slots[slot]].first == k))
+    {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  /** Returns the index of the entry of k, or s_empty */
+  size_t findIndex(const Key& k) const
+  {
+    return d_slots.empty() ? s_empty : d_slots[findSlot(k)];
+  }
+
+  /** Rebuilds the table with twice as many slots */
+  void grow()
+  {
+    size_t size = d_slots.empty() ? 16 : 2 * d_slots.size();
+    d_shift = d_slots.empty() ? 60 : d_shift - 1;
+    d_slots.assign(size, s_empty);
+    // insertion order keeps the invariant that a key is at the end of the
+    // probe sequences of the keys inserted before it
+    for (size_t i = 0, nentries = d_entries.size(); i < nentries; i++)
+    {
+      d_slots[findSlot(d_entries[i].first)] = i;
+    }
+  }
+
+  /** Adds an entry for k, which is not in the map. Returns its index. */
+  size_t addEntry(const Key& k, const Data& d)
+  {
+    if (getContext()->getLevel() > 0)
+    {
+      // so that the entry is dropped on pop
+      makeCurrent();
+    }
+    if (2 * (d_entries.size() + 1) > d_slots.size())
+    {
+      grow();
+    }
+    size_t slot = findSlot(k);
+    Assert(d_slots[slot] == s_empty);
+    d_slots[slot] = d_entries.size();
+    d_entries.push_back(value_type(k, d));
+    return d_slots[slot];
+  }
+
+  /** Sets the data of the entry with index i */
+  void setData(size_t i, const Data& d)
+  {
+    if (getContext()->getLevel() > 0)
+    {
+      makeCurrent();
+      if (d_cleared + i < d_scopeStart)
+      {
+        d_trail.push_back(
+            std::pair<size_t, Data>(d_cleared + i, d_entries[i].second));
+      }
+    }
+    d_entries[i].second = d;
+  }
+
+ public:
+  CDFlatHashMap(Context* context)
+      : ContextObj(context),
+        d_shift(64),
+        d_cleared(0),
+        d_savedEntries(0),
+        d_savedTrail(0),
+        d_scopeStart(0)
+  {
+  }
+
+  ~CDFlatHashMap() { destroy(); }
+
+  /** Removes all entries, in all contexts */
+  void clear()
+  {
+    d_cleared += d_entries.size();
+    d_entries.clear();
+    d_slots.clear();
+    d_shift = 64;
+  }
+
+  /**
+   * A handle on the entry of a key, returned by operator[]. It is valid
+   * until the key is removed by a pop.
+   */
+  class Element
+  {
+    CDFlatHashMap* d_map;
+    size_t d_index;
+
+   public:
+    Element(CDFlatHashMap* map, size_t index) : d_map(map), d_index(index) {}
+
+    const Key& getKey() const { return d_map->d_entries[d_index].first; }
+    const Data& get() const { return d_map->d_entries[d_index].second; }
+    operator Data() const { return get(); }
+    const Data& operator=(const Data& data)
+    {
+      d_map->setData(d_index, data);
+      return get();
+    }
+  }; /* class CDFlatHashMap<>::Element */
+
+  // The usual operators of map
+
+  size_t size() const { return d_entries.size(); }
+
+  bool empty() const { return d_entries.empty(); }
+
+  size_t count(const Key& k) const { return findIndex(k) == s_empty ? 0 : 1; }
+
+  // If a key is not present, a new entry is created and inserted
+  Element operator[](const Key& k)
+  {
+    size_t i = findIndex(k);
+    if (i == s_empty)
+    {
+      i = addEntry(k, Data());
+    }
+    return Element(this, i);
+  }
+
+  bool insert(const Key& k, const Data& d)
+  {
+    size_t i = findIndex(k);
+    if (i == s_empty)
+    {
+      addEntry(k, d);
+      return true;
+    }
+    setData(i, d);
+    return false;
+  }
+
+  class iterator
+  {
+    const std::pair<Key, Data>* d_it;
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::pair<Key, Data>;
+    using difference_type = ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    iterator(const value_type* p) : d_it(p) {}
+
+    // Default constructor
+    iterator() : d_it(nullptr) {}
+
+    // (Dis)equality
+    bool operator==(const iterator& i) const { return d_it == i.d_it; }
+    bool operator!=(const iterator& i) const { return d_it != i.d_it; }
+
+    // Dereference operators.
+    const value_type& operator*() const { return *d_it; }
+    const value_type* operator->() const { return d_it; }
+
+    // Prefix increment
+    iterator& operator++()
+    {
+      ++d_it;
+      return *this;
+    }
+  }; /* class CDFlatHashMap<>::iterator */
+
+  typedef iterator const_iterator;
+
+  iterator begin() const { return iterator(d_entries.data()); }
+
+  iterator end() const { return iterator(d_entries.data() + d_entries.size()); }
+
+  iterator find(const Key& k) const
+  {
+    size_t i = findIndex(k);
+    return i == s_empty ? end() : iterator(d_entries.data() + i);
+  }
+}; /* class CDFlatHashMap<> */
+
+template <class Key, class Data, class HashFcn>
+const size_t CDFlatHashMap<Key, Data, HashFcn>::s_empty;
+
+}  // namespace context
+}  // namespace CVC4
+
+#endif /* CVC4__CONTEXT__CDFLAT_HASHMAP_H */
@@ -12,8 +12,10 @@
  ** \brief Context-dependent queue class with an explicit trail of elements
  **
  ** Context-dependent First-In-First-Out queue class.
- ** The implementation is based on a combination of CDList and a CDO<size_t>
- ** for tracking the next element to dequeue from the list.
+ ** The implementation is a CDList that also saves and restores the index of
+ ** the next element to dequeue, so that a scope saves both with a single
+ ** (constant size) copy. Unlike CDQueue, dequeued elements are kept: the
+ ** list is a trail of all the elements enqueued in the current context.
  ** The implementation is currently not full featured.
  **/
 
@@ -31,27 +33,49 @@ namespace context {
 
 
 template <class T>
-class CDTrailQueue {
+class CDTrailQueue : public CDList<T> {
 private:
-
-  /** List of elements in the queue. */
-  CDList<T> d_list;
+  typedef CDList<T> ParentType;
 
   /** Points to the next element in the current context to dequeue. */
-  CDO<size_t> d_iter;
+  size_t d_iter;
+
+protected:
+
+  /**
+   * Private copy constructor used only by save().
+   */
+  CDTrailQueue(const CDTrailQueue<T>& q) : ParentType(q), d_iter(q.d_iter) {}
+
+  /** Implementation of mandatory ContextObj method save:
+   *  the base class saves the size of the list in its copy constructor.
+   */
+  ContextObj* save(ContextMemoryManager* pCMM) override
+  {
+    return new(pCMM) CDTrailQueue<T>(*this);
+  }
 
+  /**
+   * Implementation of mandatory ContextObj method restore: restores the
+   * iterator, and truncates the list to its previous size.
+   */
+  void restore(ContextObj* data) override
+  {
+    d_iter = static_cast<CDTrailQueue<T>*>(data)->d_iter;
+    ParentType::restore(data);
+  }
 
 public:
 
   /** Creates a new CDTrailQueue associated with the current context. */
   CDTrailQueue(Context* context)
-    : d_list(context),
-      d_iter(context, 0)
+    : ParentType(context),
+      d_iter(0)
   {}
 
   /** Returns true if the queue is empty in the current context. */
   bool empty() const{
-    return d_iter >= d_list.size();
+    return d_iter >= ParentType::size();
   }
 
   /**
@@ -59,8 +83,8 @@ public:
    * Returns its index in the queue.
    */
   size_t enqueue(const T& data){
-    size_t res = d_list.size();
-    d_list.push_back(data);
+    size_t res = ParentType::size();
+    ParentType::push_back(data);
     return res;
   }
 
@@ -69,24 +93,24 @@ public:
   }
 
   const T& front() const{
-    return d_list[frontIndex()];
+    return (*this)[frontIndex()];
   }
 
   /** Moves the iterator for the queue forward. */
   void dequeue(){
     Assert(!empty()) << "Attempting to queue from an empty queue.";
+    ParentType::makeCurrent();
     d_iter = d_iter + 1;
   }
 
-  const T& operator[](size_t index) const{
-    Assert(index < d_list.size());
-    return d_list[index];
-  }
-
+  /** The number of elements that were enqueued in the current context. */
   size_t size() const{
-    return d_list.size();
+    return ParentType::size();
   }
 
+  // operator[], begin() and end() are the ones of CDList: the elements that
+  // were enqueued in the current context, dequeued or not.
+
 };/* class CDTrailQueue<> */
 
 }/* CVC4::context namespace */
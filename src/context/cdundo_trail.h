@@ -0,0 +1,133 @@
+/*********************                                                        */
+/*! \file cdundo_trail.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A context-dependent undo log of word-sized writes
+ **
+ ** A context-dependent undo log of word-sized writes. Instead of saving a
+ ** copy of a whole object on its first modification in a scope (as CDO<>
+ ** does), the trail records the old value of each location that is written
+ ** through it, and writes the old values back in reverse order on pop. The
+ ** trail itself is the only ContextObj: its saved copy is just the length of
+ ** the trail at the time of the push.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__CONTEXT__CDUNDO_TRAIL_H
+#define CVC4__CONTEXT__CDUNDO_TRAIL_H
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "base/check.h"
+#include "context/context.h"
+
+namespace CVC4 {
+namespace context {
+
+/**
+ * An undo log for plain data. A data structure that is modified often, but
+ * in few places per scope, can keep its fields as ordinary (non-CDO) members
+ * and change them with set(). On pop, every location changed since the
+ * matching push is restored, with the cost proportional to the number of
+ * writes rather than to the size of the structure.
+ *
+ * The restored locations must be alive when the context is popped. Only
+ * trivially copyable values of at most a word are supported; larger
+ * structures are expected to log the fields that change.
+ */
+class CDUndoTrail : public ContextObj
+{
+  /** An entry of the trail: the old value of a location */
+  struct Entry
+  {
+    /** The location */
+    void* d_location;
+    /** The value of the location before the write */
+    uint64_t d_old;
+    /** The number of bytes of the location */
+    size_t d_bytes;
+  };
+
+  /** The writes made through this trail, oldest first */
+  std::vector<Entry> d_trail;
+
+  /**
+   * The length of d_trail. Saved copies only keep this field; the trail of a
+   * saved copy is empty.
+   */
+  size_t d_size;
+
+ protected:
+  /** Copy constructor, used by save() */
+  CDUndoTrail(const CDUndoTrail& t) : ContextObj(t), d_size(t.d_size) {}
+
+  CDUndoTrail& operator=(const CDUndoTrail& t) = delete;
+
+  ContextObj* save(ContextMemoryManager* pCMM) override
+  {
+    return new (pCMM) CDUndoTrail(*this);
+  }
+
+  void restore(ContextObj* pContextObj) override
+  {
+    size_t size = static_cast<CDUndoTrail*>(pContextObj)->d_size;
+    Assert(size <= d_trail.size());
+    while (d_trail.size() > size)
+    {
+      const Entry& e = d_trail.back();
+      std::memcpy(e.d_location, &e.d_old, e.d_bytes);
+      d_trail.pop_back();
+    }
+    d_size = size;
+    // Explicitly call destructor as it will not otherwise get called.
+    static_cast<CDUndoTrail*>(pContextObj)->d_trail.~vector<Entry>();
+  }
+
+ public:
+  CDUndoTrail(Context* context) : ContextObj(context), d_size(0) {}
+
+  ~CDUndoTrail() { destroy(); }
+
+  /**
+   * Set location to value in the current context. The old value of location
+   * is restored when the current scope is popped.
+   */
+  template <class T>
+  void set(T& location, const T& value)
+  {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "CDUndoTrail only logs trivially copyable values");
+    static_assert(sizeof(T) <= sizeof(uint64_t),
+                  "CDUndoTrail only logs word-sized values");
+    if (getContext()->getLevel() > 0)
+    {
+      // at level 0 there is nothing to restore
+      makeCurrent();
+      Entry e;
+      e.d_location = &location;
+      e.d_old = 0;
+      std::memcpy(&e.d_old, &location, sizeof(T));
+      e.d_bytes = sizeof(T);
+      d_trail.push_back(e);
+      d_size = d_trail.size();
+    }
+    location = value;
+  }
+
+  /** The number of writes that will be undone by popping to level 0 */
+  size_t size() const { return d_trail.size(); }
+}; /* class CDUndoTrail */
+
+}  // namespace context
+}  // namespace CVC4
+
+#endif /* CVC4__CONTEXT__CDUNDO_TRAIL_H */
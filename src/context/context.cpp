@@ -16,6 +16,7 @@
 
 
 #include <iostream>
+#include <typeinfo>
 #include <vector>
 
 #include "base/check.h"
@@ -142,7 +143,14 @@ void ContextObj::update()
                    << *getContext() << std::endl;
 
   // Call save() to save the information in the current object
-  ContextObj* pContextObjSaved = save(d_pScope->getCMM());
+  ContextMemoryManager* pCMM = d_pScope->getCMM();
+  uint64_t bytesAllocated = pCMM->getBytesAllocated();
+  ContextObj* pContextObjSaved = save(pCMM);
+  if (pCMM->isTrackingTypes())
+  {
+    pCMM->recordSave(typeid(*this).name(),
+                     pCMM->getBytesAllocated() - bytesAllocated);
+  }
 
   Debug("context") << "in update(" << this << ") with restore "
                    << pContextObjSaved << ": waypoint 1" << std::endl
@@ -15,6 +15,7 @@
  **/
 
 
+#include <algorithm>
 #include <cstdlib>
 #include <vector>
 #include <deque>
@@ -33,6 +34,57 @@ namespace context {
 
 #ifndef CVC4_DEBUG_CONTEXT_MEMORY_MANAGER
 
+namespace {
+
+/**
+ * The chunks kept from the memory managers destroyed by a thread, see
+ * ContextMemoryManager::maxPooledChunks.
+ */
+struct ChunkPool {
+  std::vector<char*> d_chunks;
+  ~ChunkPool();
+};
+
+thread_local ChunkPool s_chunkPool;
+
+/**
+ * Is the pool of the thread destroyed, in which case the memory managers that
+ * are destroyed later (static ones) free their chunks
+ */
+thread_local bool s_chunkPoolDestroyed = false;
+
+ChunkPool::~ChunkPool() {
+  for (char* chunk : d_chunks) {
+    free(chunk);
+  }
+  s_chunkPoolDestroyed = true;
+}
+
+/** Get a chunk from the pool of the thread, or a new one */
+char* allocateChunk(size_t size) {
+  if (!s_chunkPoolDestroyed && !s_chunkPool.d_chunks.empty()) {
+    char* chunk = s_chunkPool.d_chunks.back();
+    s_chunkPool.d_chunks.pop_back();
+    return chunk;
+  }
+  char* chunk = (char*)malloc(size);
+  if (chunk == NULL) {
+    throw std::bad_alloc();
+  }
+  return chunk;
+}
+
+/** Give the chunk back to the pool of the thread, or free it if full */
+void releaseChunk(char* chunk, size_t maxPooled) {
+  if (!s_chunkPoolDestroyed && s_chunkPool.d_chunks.size() < maxPooled) {
+    s_chunkPool.d_chunks.push_back(chunk);
+  } else {
+    free(chunk);
+  }
+}
+
+}  // namespace
+
 void ContextMemoryManager::newChunk() {
 
   // Increment index to chunk list
@@ -42,33 +94,41 @@ void ContextMemoryManager::newChunk() {
 
   // Create new chunk if no free chunk available
   if(d_freeChunks.empty()) {
-    d_chunkList.push_back((char*)malloc(chunkSizeBytes));
-    if(d_chunkList.back() == NULL) {
-      throw std::bad_alloc();
-    }
+    d_chunkList.push_back(allocateChunk(chunkSizeBytes));
 
 #ifdef CVC4_VALGRIND
     VALGRIND_MAKE_MEM_NOACCESS(d_chunkList.back(), chunkSizeBytes);
 #endif /* CVC4_VALGRIND */
+    d_maxChunks = std::max(
+        d_maxChunks, static_cast<uint64_t>(d_chunkList.size()
+                                           + d_freeChunks.size()));
   }
   // If there is a free chunk, use that
   else {
     d_chunkList.push_back(d_freeChunks.back());
     d_freeChunks.pop_back();
   }
+  d_windowMaxChunks = std::max(d_windowMaxChunks, d_chunkList.size());
   // Set up the current chunk pointers
   d_nextFree = d_chunkList.back();
   d_endChunk = d_nextFree + chunkSizeBytes;
 }
 
 
-ContextMemoryManager::ContextMemoryManager() : d_indexChunkList(0) {
+ContextMemoryManager::ContextMemoryManager()
+    : d_indexChunkList(0),
+      d_bytesAllocated(0),
+      d_maxBytesAllocated(0),
+      d_maxChunks(1),
+      d_chunksReleased(0),
+      d_windowMaxChunks(1),
+      d_lastWindowMaxChunks(1),
+      d_windowPops(0),
+      d_trackTypes(false)
+{
   // Create initial chunk
-  d_chunkList.push_back((char*)malloc(chunkSizeBytes));
+  d_chunkList.push_back(allocateChunk(chunkSizeBytes));
   d_nextFree = d_chunkList.back();
-  if(d_nextFree == NULL) {
-    throw std::bad_alloc();
-  }
   d_endChunk = d_nextFree + chunkSizeBytes;
 
 #ifdef CVC4_VALGRIND
@@ -84,13 +144,13 @@ ContextMemoryManager::~ContextMemoryManager() {
   VALGRIND_DESTROY_MEMPOOL(this);
 #endif /* CVC4_VALGRIND */
 
-  // Delete all chunks
+  // Give all chunks back to the pool of the thread
   while(!d_chunkList.empty()) {
-    free(d_chunkList.back());
+    releaseChunk(d_chunkList.back(), maxPooledChunks);
     d_chunkList.pop_back();
   }
   while(!d_freeChunks.empty()) {
-    free(d_freeChunks.back());
+    releaseChunk(d_freeChunks.back(), maxPooledChunks);
     d_freeChunks.pop_back();
   }
 }
@@ -108,6 +168,8 @@ void* ContextMemoryManager::newData(size_t size) {
     AlwaysAssert(d_nextFree <= d_endChunk)
         << "Request is bigger than memory chunk size";
   }
+  d_bytesAllocated += size;
+  d_maxBytesAllocated = std::max(d_maxBytesAllocated, d_bytesAllocated);
   Debug("context") << "ContextMemoryManager::newData(" << size
                    << ") returning " << res << " at level "
                    << d_chunkList.size() << std::endl;
@@ -130,6 +192,7 @@ void ContextMemoryManager::push() {
   d_nextFreeStack.push_back(d_nextFree);
   d_endChunkStack.push_back(d_endChunk);
   d_indexChunkListStack.push_back(d_indexChunkList);
+  d_bytesAllocatedStack.push_back(d_bytesAllocated);
 }
 
 
@@ -161,10 +224,53 @@ void ContextMemoryManager::pop() {
   }
   d_indexChunkListStack.pop_back();
 
-  // Delete excess free chunks
-  while(d_freeChunks.size() > maxFreeChunks) {
+  // Account for the region of the popped level
+  size_t level = d_bytesAllocatedStack.size();
+  if (d_maxLevelBytes.size() <= level)
+  {
+    d_maxLevelBytes.resize(level + 1, 0);
+  }
+  d_maxLevelBytes[level] = std::max(
+      d_maxLevelBytes[level], d_bytesAllocated - d_bytesAllocatedStack.back());
+  d_bytesAllocated = d_bytesAllocatedStack.back();
+  d_bytesAllocatedStack.pop_back();
+
+  // Delete excess free chunks: keep those that were in use recently
+  if (++d_windowPops == freeChunksWindow)
+  {
+    d_lastWindowMaxChunks = d_windowMaxChunks;
+    d_windowMaxChunks = d_chunkList.size();
+    d_windowPops = 0;
+  }
+  size_t peak = std::max(d_windowMaxChunks, d_lastWindowMaxChunks);
+  size_t maxFree = std::min(
+      static_cast<size_t>(maxFreeChunks),
+      std::max(static_cast<size_t>(minFreeChunks), peak - d_chunkList.size()));
+  while (d_freeChunks.size() > maxFree)
+  {
     free(d_freeChunks.front());
     d_freeChunks.pop_front();
+    ++d_chunksReleased;
+  }
+}
+
+void ContextMemoryManager::getMaxLevelBytes(std::vector<uint64_t>& bytes) const
+{
+  bytes = d_maxLevelBytes;
+  // the current regions
+  size_t nlevels = d_bytesAllocatedStack.size() + 1;
+  if (bytes.size() < nlevels)
+  {
+    bytes.resize(nlevels, 0);
+  }
+  uint64_t start = 0;
+  for (size_t level = 0; level < nlevels; level++)
+  {
+    uint64_t end = level < d_bytesAllocatedStack.size()
+                       ? d_bytesAllocatedStack[level]
+                       : d_bytesAllocated;
+    bytes[level] = std::max(bytes[level], end - start);
+    start = end;
   }
 }
 
@@ -20,8 +20,11 @@
 #ifndef CVC4__CONTEXT__CONTEXT_MM_H
 #define CVC4__CONTEXT__CONTEXT_MM_H
 
+#include <algorithm>
+#include <cstdint>
 #include <deque>
 #include <limits>
+#include <map>
 #include <vector>
 
 namespace CVC4 {
@@ -52,6 +55,24 @@ class ContextMemoryManager {
    */
   static const unsigned maxFreeChunks = 100;
 
+  /**
+   * The free list may always keep this many chunks.  Beyond that, it only
+   * keeps the chunks that were in use during the last freeChunksWindow pops
+   * (a recent peak), so that after a deep pop that is not followed by
+   * similar pushes the memory is returned to the system.
+   */
+  static const unsigned minFreeChunks = 8;
+
+  /** The number of pops over which the peak use of chunks is measured */
+  static const unsigned freeChunksWindow = 256;
+
+  /**
+   * The chunks of a destroyed memory manager are kept, up to this many per
+   * thread, for the memory managers created later by the same thread (for
+   * example by SmtEngine::reset()).
+   */
+  static const unsigned maxPooledChunks = 1024;
+
   /**
    * List of all chunks that are currently active
    */
@@ -97,6 +118,48 @@ class ContextMemoryManager {
    */
   std::vector<unsigned> d_indexChunkListStack;
 
+  /**
+   * Part of the stack of saved regions.  This vector stores the saved value
+   * of d_bytesAllocated.
+   */
+  std::vector<uint64_t> d_bytesAllocatedStack;
+
+  /** The number of bytes allocated in all the current regions */
+  uint64_t d_bytesAllocated;
+
+  /** The maximum of d_bytesAllocated */
+  uint64_t d_maxBytesAllocated;
+
+  /** The maximum number of chunks held, active or free */
+  uint64_t d_maxChunks;
+
+  /** The number of chunks that were returned to the system */
+  uint64_t d_chunksReleased;
+
+  /** The maximum number of active chunks in the current window of pops */
+  size_t d_windowMaxChunks;
+
+  /** The maximum number of active chunks in the previous window of pops */
+  size_t d_lastWindowMaxChunks;
+
+  /** The number of pops in the current window */
+  unsigned d_windowPops;
+
+  /**
+   * The maximum number of bytes allocated in the region of each level, for
+   * the regions that were popped.
+   */
+  std::vector<uint64_t> d_maxLevelBytes;
+
+  /** Whether saves are recorded per type, see recordSave() */
+  bool d_trackTypes;
+
+  /**
+   * The number of saves and the number of bytes they allocated, per type of
+   * context-dependent object (by the name given by typeid).
+   */
+  std::map<const char*, std::pair<uint64_t, uint64_t> > d_typeSaves;
+
   /**
    * Private method to grab a new chunk for the current region.  Uses chunk
    * from d_freeChunks if available.  Creates a new one otherwise.  Sets the
@@ -146,6 +209,45 @@ class ContextMemoryManager {
    */
   void pop();
 
+  /** The number of bytes allocated in all the current regions */
+  const uint64_t& getBytesAllocated() const { return d_bytesAllocated; }
+
+  /** The maximum number of bytes allocated at any time */
+  const uint64_t& getMaxBytesAllocated() const { return d_maxBytesAllocated; }
+
+  /** The maximum number of chunks held at any time, active or free */
+  const uint64_t& getMaxChunks() const { return d_maxChunks; }
+
+  /** The number of chunks that were returned to the system */
+  const uint64_t& getChunksReleased() const { return d_chunksReleased; }
+
+  /**
+   * Get the maximum number of bytes allocated in a region of each level,
+   * including the current regions.
+   */
+  void getMaxLevelBytes(std::vector<uint64_t>& bytes) const;
+
+  /** Enable or disable the recording of saves per type */
+  void setTrackTypes(bool track) { d_trackTypes = track; }
+
+  /** Are saves recorded per type? */
+  bool isTrackingTypes() const { return d_trackTypes; }
+
+  /** Record a save of an object of type name, that allocated bytes */
+  void recordSave(const char* name, uint64_t bytes)
+  {
+    std::pair<uint64_t, uint64_t>& s = d_typeSaves[name];
+    s.first++;
+    s.second += bytes;
+  }
+
+  /** The number of saves and of bytes they allocated, per type */
+  const std::map<const char*, std::pair<uint64_t, uint64_t> >& getTypeSaves()
+      const
+  {
+    return d_typeSaves;
+  }
+
 };/* class ContextMemoryManager */
 
 #else /* CVC4_DEBUG_CONTEXT_MEMORY_MANAGER */
@@ -166,7 +268,14 @@ class ContextMemoryManager
     return std::numeric_limits<unsigned>::max();
   }
 
-  ContextMemoryManager() { d_allocations.push_back(std::vector<char*>()); }
+  ContextMemoryManager()
+      : d_bytesAllocated(0),
+        d_maxBytesAllocated(0),
+        d_noChunks(0),
+        d_trackTypes(false)
+  {
+    d_allocations.push_back(std::vector<char*>());
+  }
   ~ContextMemoryManager()
   {
     for (const auto& levelAllocs : d_allocations)
@@ -182,10 +291,16 @@ class ContextMemoryManager
   {
     void* alloc = malloc(size);
     d_allocations.back().push_back(static_cast<char*>(alloc));
+    d_bytesAllocated += size;
+    d_maxBytesAllocated = std::max(d_maxBytesAllocated, d_bytesAllocated);
     return alloc;
   }
 
-  void push() { d_allocations.push_back(std::vector<char*>()); }
+  void push()
+  {
+    d_allocations.push_back(std::vector<char*>());
+    d_bytesAllocatedStack.push_back(d_bytesAllocated);
+  }
 
   void pop()
   {
@@ -194,10 +309,38 @@ class ContextMemoryManager
       free(alloc);
     }
     d_allocations.pop_back();
+    d_bytesAllocated = d_bytesAllocatedStack.back();
+    d_bytesAllocatedStack.pop_back();
+  }
+
+  const uint64_t& getBytesAllocated() const { return d_bytesAllocated; }
+  const uint64_t& getMaxBytesAllocated() const { return d_maxBytesAllocated; }
+  // there are no chunks in this implementation
+  const uint64_t& getMaxChunks() const { return d_noChunks; }
+  const uint64_t& getChunksReleased() const { return d_noChunks; }
+  void getMaxLevelBytes(std::vector<uint64_t>& bytes) const { bytes.clear(); }
+  void setTrackTypes(bool track) { d_trackTypes = track; }
+  bool isTrackingTypes() const { return d_trackTypes; }
+  void recordSave(const char* name, uint64_t bytes)
+  {
+    std::pair<uint64_t, uint64_t>& s = d_typeSaves[name];
+    s.first++;
+    s.second += bytes;
+  }
+  const std::map<const char*, std::pair<uint64_t, uint64_t> >& getTypeSaves()
+      const
+  {
+    return d_typeSaves;
   }
 
  private:
   std::vector<std::vector<char*>> d_allocations;
+  std::vector<uint64_t> d_bytesAllocatedStack;
+  uint64_t d_bytesAllocated;
+  uint64_t d_maxBytesAllocated;
+  uint64_t d_noChunks;
+  bool d_trackTypes;
+  std::map<const char*, std::pair<uint64_t, uint64_t> > d_typeSaves;
 }; /* ContextMemoryManager */
 
 #endif /* CVC4_DEBUG_CONTEXT_MEMORY_MANAGER */
@@ -117,7 +117,8 @@ public:
 
   /** Gets the next decision based on strategies that are enabled */
   SatLiteral getNext(bool &stopSearch) {
-    NodeManager::currentResourceManager()->spendResource(options::decisionStep());
+    NodeManager::currentResourceManager()->spendResource(
+        ResourceManager::Resource::DecisionStep, options::decisionStep());
     Assert(d_cnfStream != NULL)
         << "Forgot to set cnfStream for decision engine?";
     Assert(d_satSolver != NULL)
@@ -204,6 +205,19 @@ public:
   SatValue getSatValue(TNode n) {
     return getSatValue(getSatLiteral(n));
   }
+  /**
+   * Get the value of the sat literal of n, or SAT_VALUE_UNKNOWN if n has no
+   * sat literal. This looks up n once, where hasSatLiteral() followed by
+   * getSatValue() looks it up twice.
+   */
+  SatValue tryGetSatValue(TNode n)
+  {
+    const CnfStream::NodeToLiteralMap& cache =
+        d_cnfStream->getTranslationCache();
+    CnfStream::NodeToLiteralMap::const_iterator it = cache.find(n);
+    return it == cache.end() ? SAT_VALUE_UNKNOWN
+                             : d_satSolver->value((*it).second);
+  }
   Node getNode(SatLiteral l) {
     return d_cnfStream->getNode(l);
   }
@@ -214,9 +214,9 @@ bool JustificationHeuristic::checkJustified(TNode n)
 
 DecisionWeight JustificationHeuristic::getExploredThreshold(TNode n)
 {
-  return
-    d_exploredThreshold.find(n) == d_exploredThreshold.end() ?
-    numeric_limits<DecisionWeight>::max() : d_exploredThreshold[n];
+  ExploredThreshold::const_iterator it = d_exploredThreshold.find(n);
+  return it == d_exploredThreshold.end() ? numeric_limits<DecisionWeight>::max()
+                                         : (*it).second;
 }
 
 void JustificationHeuristic::setExploredThreshold(TNode n)
@@ -254,47 +254,50 @@ DecisionWeight JustificationHeuristic::getWeightPolarized(TNode n, bool polarity
     return getWeight(n);
   }
 
-  if(d_weightCache.find(n) == d_weightCache.end()) {
-    Kind k = n.getKind();
-    theory::TheoryId tId  = theory::kindToTheoryId(k);
-    DecisionWeight dW1, dW2;
-    if(tId != theory::THEORY_BOOL) {
-      dW1 = dW2 = getWeight(n);
-    } else {
+  WeightCache::const_iterator it = d_weightCache.find(n);
+  if (it != d_weightCache.end())
+  {
+    return polarity ? (*it).second.first : (*it).second.second;
+  }
+  Kind k = n.getKind();
+  theory::TheoryId tId  = theory::kindToTheoryId(k);
+  DecisionWeight dW1, dW2;
+  if(tId != theory::THEORY_BOOL) {
+    dW1 = dW2 = getWeight(n);
+  } else {
 
-      if(k == kind::OR) {
-        dW1 = numeric_limits<DecisionWeight>::max(), dW2 = 0;
-        for(TNode::iterator i=n.begin(); i != n.end(); ++i) {
-          dW1 = min(dW1, getWeightPolarized(*i, true));
-          dW2 = max(dW2, getWeightPolarized(*i, false));
-        }
-      } else if(k == kind::AND) {
-        dW1 = 0, dW2 = numeric_limits<DecisionWeight>::max();
-        for(TNode::iterator i=n.begin(); i != n.end(); ++i) {
-          dW1 = max(dW1, getWeightPolarized(*i, true));
-          dW2 = min(dW2, getWeightPolarized(*i, false));
-        }
-      } else if(k == kind::IMPLIES) {
-        dW1 = min(getWeightPolarized(n[0], false),
-                  getWeightPolarized(n[1], true));
-        dW2 = max(getWeightPolarized(n[0], true),
-                  getWeightPolarized(n[1], false));
-      } else if(k == kind::NOT) {
-        dW1 = getWeightPolarized(n[0], false);
-        dW2 = getWeightPolarized(n[0], true);
-      } else {
-        dW1 = 0;
-        for(TNode::iterator i=n.begin(); i != n.end(); ++i) {
-          dW1 = max(dW1, getWeightPolarized(*i, true));
-          dW1 = max(dW1, getWeightPolarized(*i, false));
-        }
-        dW2 = dW1;
+    if(k == kind::OR) {
+      dW1 = numeric_limits<DecisionWeight>::max(), dW2 = 0;
+      for(TNode::iterator i=n.begin(); i != n.end(); ++i) {
+        dW1 = min(dW1, getWeightPolarized(*i, true));
+        dW2 = max(dW2, getWeightPolarized(*i, false));
       }
-
+    } else if(k == kind::AND) {
+      dW1 = 0, dW2 = numeric_limits<DecisionWeight>::max();
+      for(TNode::iterator i=n.begin(); i != n.end(); ++i) {
+        dW1 = max(dW1, getWeightPolarized(*i, true));
+        dW2 = min(dW2, getWeightPolarized(*i, false));
+      }
+    } else if(k == kind::IMPLIES) {
+      dW1 = min(getWeightPolarized(n[0], false),
+                getWeightPolarized(n[1], true));
+      dW2 = max(getWeightPolarized(n[0], true),
+                getWeightPolarized(n[1], false));
+    } else if(k == kind::NOT) {
+      dW1 = getWeightPolarized(n[0], false);
+      dW2 = getWeightPolarized(n[0], true);
+    } else {
+      dW1 = 0;
+      for(TNode::iterator i=n.begin(); i != n.end(); ++i) {
+        dW1 = max(dW1, getWeightPolarized(*i, true));
+        dW1 = max(dW1, getWeightPolarized(*i, false));
+      }
+      dW2 = dW1;
     }
-    d_weightCache[n] = make_pair(dW1, dW2);
+
   }
-  return polarity ? d_weightCache[n].get().first : d_weightCache[n].get().second;
+  d_weightCache.insert(n, make_pair(dW1, dW2));
+  return polarity ? dW1 : dW2;
 }
 
 DecisionWeight JustificationHeuristic::getWeight(TNode n) {
@@ -334,49 +337,48 @@ DecisionWeight JustificationHeuristic::getWeight(TNode n) {
   return n.getAttribute(DecisionWeightAttr());
 }
 
-typedef vector<TNode> ChildList;
-TNode JustificationHeuristic::getChildByWeight(TNode n, int i, bool polarity) {
-  if(options::decisionUseWeight()) {
-    // TODO: Optimize storing & access
-    if(d_childCache.find(n) == d_childCache.end()) {
-      ChildList list0(n.begin(), n.end()), list1(n.begin(), n.end());
-      std::sort(list0.begin(), list0.end(), JustificationHeuristic::myCompareClass(this,false));
-      std::sort(list1.begin(), list1.end(), JustificationHeuristic::myCompareClass(this,true));
-      d_childCache[n] = make_pair(list0, list1);
-    }
-    return polarity ? d_childCache[n].get().second[i] : d_childCache[n].get().first[i];
-  } else {
-    return n[i];
+const JustificationHeuristic::ChildList*
+JustificationHeuristic::getChildrenByWeight(TNode n, bool polarity)
+{
+  if (!options::decisionUseWeight())
+  {
+    return nullptr;
   }
+  // the orderings are computed once per node, the elements of the cache
+  // stay in place when other nodes are inserted
+  ChildCache::const_iterator it = d_childCache.find(n);
+  if (it == d_childCache.end())
+  {
+    ChildList list0(n.begin(), n.end()), list1(n.begin(), n.end());
+    std::sort(list0.begin(), list0.end(), JustificationHeuristic::myCompareClass(this,false));
+    std::sort(list1.begin(), list1.end(), JustificationHeuristic::myCompareClass(this,true));
+    d_childCache.insert(n, make_pair(list0, list1));
+    it = d_childCache.find(n);
+  }
+  return polarity ? &(*it).second.second : &(*it).second.first;
 }
 
 SatValue JustificationHeuristic::tryGetSatValue(Node n)
 {
-  Debug("decision") << "   "  << n << " has sat value " << " ";
-  if(d_decisionEngine->hasSatLiteral(n) ) {
-    Debug("decision") << d_decisionEngine->getSatValue(n) << std::endl;
-    return d_decisionEngine->getSatValue(n);
-  } else {
-    Debug("decision") << "NO SAT LITERAL" << std::endl;
-    return SAT_VALUE_UNKNOWN;
-  }//end of else
+  SatValue val = d_decisionEngine->tryGetSatValue(n);
+  Debug("decision") << "   " << n << " has sat value " << val << std::endl;
+  return val;
 }
 
-JustificationHeuristic::IteList
-JustificationHeuristic::getITEs(TNode n)
+const JustificationHeuristic::IteList& JustificationHeuristic::getITEs(
+    TNode n)
 {
-  IteCache::iterator it = d_iteCache.find(n);
-  if(it != d_iteCache.end()) {
-    return (*it).second;
-  } else {
+  IteCache::const_iterator it = d_iteCache.find(n);
+  if (it == d_iteCache.end())
+  {
     // Compute the list of ITEs
-    // TODO: optimize by avoiding multiple lookup for d_iteCache[n]
     d_visitedComputeITE.clear();
     IteList ilist;
     computeITEs(n, ilist);
     d_iteCache.insert(n, ilist);
-    return ilist;
+    it = d_iteCache.find(n);
   }
+  return (*it).second;
 }
 
 void JustificationHeuristic::computeITEs(TNode n, IteList &l)
@@ -561,8 +563,9 @@ JustificationHeuristic::handleAndOrEasy(TNode node, SatValue desiredVal)
 
   int numChildren = node.getNumChildren();
   SatValue desiredValInverted = invertValue(desiredVal);
+  const ChildList* byWeight = getChildrenByWeight(node, desiredVal);
   for(int i = 0; i < numChildren; ++i) {
-    TNode curNode = getChildByWeight(node, i, desiredVal);
+    TNode curNode = byWeight == nullptr ? node[i] : (*byWeight)[i];
     if ( tryGetSatValue(curNode) != desiredValInverted ) {
       SearchResult ret = findSplitterRec(curNode, desiredVal);
       if(ret != DONT_KNOW) {
@@ -575,7 +578,8 @@ JustificationHeuristic::handleAndOrEasy(TNode node, SatValue desiredVal)
 }
 
 int JustificationHeuristic::getStartIndex(TNode node) {
-  return d_startIndexCache[node];
+  StartIndexCache::const_iterator it = d_startIndexCache.find(node);
+  return it == d_startIndexCache.end() ? 0 : (*it).second;
 }
 void JustificationHeuristic::saveStartIndex(TNode node, int val) {
   d_startIndexCache[node] = val;
@@ -589,8 +593,9 @@ JustificationHeuristic::SearchResult JustificationHeuristic::handleAndOrHard(TNo
   int numChildren = node.getNumChildren();
   bool noSplitter = true;
   int i_st = getStartIndex(node);
+  const ChildList* byWeight = getChildrenByWeight(node, desiredVal);
   for(int i = i_st; i < numChildren; ++i) {
-    TNode curNode = getChildByWeight(node, i, desiredVal);
+    TNode curNode = byWeight == nullptr ? node[i] : (*byWeight)[i];
     SearchResult ret = findSplitterRec(curNode, desiredVal);
     if (ret == FOUND_SPLITTER) {
       if(i != i_st) saveStartIndex(node, i);
@@ -701,7 +706,7 @@ JustificationHeuristic::SearchResult JustificationHeuristic::handleITE(TNode nod
 
 JustificationHeuristic::SearchResult JustificationHeuristic::handleEmbeddedITEs(TNode node)
 {
-  const IteList l = getITEs(node);
+  const IteList& l = getITEs(node);
   Trace("decision::jh::ite") << " ite size = " << l.size() << std::endl;
 
   bool noSplitter = true;
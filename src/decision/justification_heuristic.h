@@ -146,14 +146,18 @@ public:
   static DecisionWeight getWeight(TNode);
   bool compareByWeightFalse(TNode, TNode);
   bool compareByWeightTrue(TNode, TNode);
-  TNode getChildByWeight(TNode n, int i, bool polarity);
+  /**
+   * Get the children of n sorted by their polarized weights, or null if the
+   * weights are not used to order the children, see decisionUseWeight.
+   */
+  const ChildList* getChildrenByWeight(TNode n, bool polarity);
 
   /* If literal exists corresponding to the node return
      that. Otherwise an UNKNOWN */
   SatValue tryGetSatValue(Node n);
 
   /* Get list of all term-ITEs for the atomic formula v */
-  JustificationHeuristic::IteList getITEs(TNode n);
+  const JustificationHeuristic::IteList& getITEs(TNode n);
 
 
   /**
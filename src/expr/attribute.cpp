@@ -50,6 +50,9 @@ void AttributeManager::deleteAllAttributes(NodeValue* nv) {
   deleteFromTable(d_nodes, nv);
   deleteFromTable(d_types, nv);
   deleteFromTable(d_strings, nv);
+  deleteFromDenseTables(d_denseBools, nv);
+  deleteFromDenseTables(d_denseNodes, nv);
+  deleteFromDenseTables(d_denseTypes, nv);
 }
 
 void AttributeManager::deleteAllAttributes() {
@@ -59,6 +62,9 @@ void AttributeManager::deleteAllAttributes() {
   deleteAllFromTable(d_nodes);
   deleteAllFromTable(d_types);
   deleteAllFromTable(d_strings);
+  deleteAllFromDenseTables(d_denseBools);
+  deleteAllFromDenseTables(d_denseNodes);
+  deleteAllFromDenseTables(d_denseTypes);
 }
 
 void AttributeManager::deleteAttributes(const AttrIdVec& atids) {
@@ -97,6 +103,16 @@ void AttributeManager::deleteAttributes(const AttrIdVec& atids) {
       deleteAttributesFromTable(d_strings, ids);
       break;
 
+    case AttrTableDenseBool:
+      deleteAttributesFromDenseTables(d_denseBools, ids);
+      break;
+    case AttrTableDenseNode:
+      deleteAttributesFromDenseTables(d_denseNodes, ids);
+      break;
+    case AttrTableDenseTypeNode:
+      deleteAttributesFromDenseTables(d_denseTypes, ids);
+      break;
+
     case AttrTableCDBool:
     case AttrTableCDUInt64:
     case AttrTableCDTNode:
@@ -24,8 +24,10 @@
 #ifndef CVC4__EXPR__ATTRIBUTE_H
 #define CVC4__EXPR__ATTRIBUTE_H
 
+#include <memory>
 #include <string>
 #include <stdint.h>
+#include <vector>
 #include "expr/attribute_unique_id.h"
 
 // include supporting templates
@@ -57,6 +59,19 @@ class AttributeManager {
   template <class T>
   void reconstructTable(AttrHash<T>& table);
 
+  template <class T>
+  void deleteFromDenseTables(
+      std::vector<std::unique_ptr<DenseAttrTable<T>>>& tables, NodeValue* nv);
+
+  template <class T>
+  void deleteAllFromDenseTables(
+      std::vector<std::unique_ptr<DenseAttrTable<T>>>& tables);
+
+  template <class T>
+  void deleteAttributesFromDenseTables(
+      std::vector<std::unique_ptr<DenseAttrTable<T>>>& tables,
+      const std::vector<uint64_t>& ids);
+
   /**
    * getTable<> is a helper template that gets the right table from an
    * AttributeManager given its type.
@@ -64,6 +79,13 @@ class AttributeManager {
   template <class T, bool context_dep>
   friend struct getTable;
 
+  /**
+   * getDenseTables<> is a helper template that gets the dense tables of
+   * a value type from an AttributeManager.
+   */
+  template <class T>
+  friend struct getDenseTables;
+
   bool d_inGarbageCollection;
 
   void clearDeleteAllAttributesBuffer();
@@ -89,6 +111,24 @@ public:
   /** Underlying hash table for string-valued attributes */
   AttrHash<std::string> d_strings;
 
+  /** Dense tables for boolean-valued attributes, by attribute id */
+  std::vector<std::unique_ptr<DenseAttrTable<bool>>> d_denseBools;
+  /** Dense tables for node-valued attributes, by attribute id */
+  std::vector<std::unique_ptr<DenseAttrTable<Node>>> d_denseNodes;
+  /** Dense tables for types attributes, by attribute id */
+  std::vector<std::unique_ptr<DenseAttrTable<TypeNode>>> d_denseTypes;
+
+  /**
+   * Get the dense table of the attribute with the given id and value type,
+   * or null if no value was set for it.
+   */
+  template <class T>
+  const DenseAttrTable<T>* getDenseTable(uint64_t id) const;
+
+  /** Get the dense table of the attribute, allocating it if necessary. */
+  template <class T>
+  DenseAttrTable<T>& getOrMakeDenseTable(uint64_t id);
+
   /**
    * Get a particular attribute on a particular node.
    *
@@ -272,31 +312,181 @@ struct getTable<std::string, false> {
   }
 };
 
+/**
+ * The getDenseTables<> template provides (static) access to the
+ * AttributeManager field holding the dense tables of a value type.
+ */
+template <class T>
+struct getDenseTables;
+
+/** Access the "d_denseBools" member of AttributeManager. */
+template <>
+struct getDenseTables<bool> {
+  static const AttrTableId id = AttrTableDenseBool;
+  typedef std::vector<std::unique_ptr<DenseAttrTable<bool>>> tables_type;
+  static inline tables_type& get(AttributeManager& am) {
+    return am.d_denseBools;
+  }
+  static inline const tables_type& get(const AttributeManager& am) {
+    return am.d_denseBools;
+  }
+};
+
+/** Access the "d_denseNodes" member of AttributeManager. */
+template <>
+struct getDenseTables<Node> {
+  static const AttrTableId id = AttrTableDenseNode;
+  typedef std::vector<std::unique_ptr<DenseAttrTable<Node>>> tables_type;
+  static inline tables_type& get(AttributeManager& am) {
+    return am.d_denseNodes;
+  }
+  static inline const tables_type& get(const AttributeManager& am) {
+    return am.d_denseNodes;
+  }
+};
+
+/** Access the "d_denseTypes" member of AttributeManager. */
+template <>
+struct getDenseTables<TypeNode> {
+  static const AttrTableId id = AttrTableDenseTypeNode;
+  typedef std::vector<std::unique_ptr<DenseAttrTable<TypeNode>>> tables_type;
+  static inline tables_type& get(AttributeManager& am) {
+    return am.d_denseTypes;
+  }
+  static inline const tables_type& get(const AttributeManager& am) {
+    return am.d_denseTypes;
+  }
+};
+
 }/* CVC4::expr::attr namespace */
 
 // ATTRIBUTE MANAGER IMPLEMENTATIONS ===========================================
 
 namespace attr {
 
-// implementation for AttributeManager::getAttribute()
+template <class T>
+inline const DenseAttrTable<T>* AttributeManager::getDenseTable(
+    uint64_t id) const
+{
+  const typename getDenseTables<T>::tables_type& tables =
+      getDenseTables<T>::get(*this);
+  return id < tables.size() ? tables[id].get() : nullptr;
+}
+
+template <class T>
+inline DenseAttrTable<T>& AttributeManager::getOrMakeDenseTable(uint64_t id)
+{
+  typename getDenseTables<T>::tables_type& tables =
+      getDenseTables<T>::get(*this);
+  if (id >= tables.size())
+  {
+    tables.resize(id + 1);
+  }
+  if (tables[id] == nullptr)
+  {
+    tables[id].reset(new DenseAttrTable<T>);
+  }
+  return *tables[id];
+}
+
+/* Helper template class for accessing the value of an attribute,
+ * specialized based on whether AttrKind is stored in a dense table or
+ * in the hash table of its value type. */
+template <class AttrKind, bool dense = AttrKind::dense>
+struct AttrStorage;
+
+/**
+ * Specialization of AttrStorage<> helper template for AttrKinds stored
+ * in the hash table of their value type.
+ */
 template <class AttrKind>
-typename AttrKind::value_type
-AttributeManager::getAttribute(NodeValue* nv, const AttrKind&) const {
+struct AttrStorage<AttrKind, false> {
   typedef typename AttrKind::value_type value_type;
   typedef KindValueToTableValueMapping<value_type> mapping;
   typedef typename getTable<value_type, AttrKind::context_dependent>::
             table_type table_type;
 
-  const table_type& ah =
-    getTable<value_type, AttrKind::context_dependent>::get(*this);
-  typename table_type::const_iterator i =
-    ah.find(std::make_pair(AttrKind::getId(), nv));
+  /** The id of the table */
+  static const AttrTableId table_id =
+      getTable<value_type, AttrKind::context_dependent>::id;
 
-  if(i == ah.end()) {
-    return typename AttrKind::value_type();
+  /** Does nv have the attribute? */
+  static inline bool has(const AttributeManager& am, NodeValue* nv) {
+    const table_type& ah =
+      getTable<value_type, AttrKind::context_dependent>::get(am);
+    return ah.find(std::make_pair(AttrKind::getId(), nv)) != ah.end();
+  }
+
+  /** Get the attribute of nv in ret, if nv has it */
+  static inline bool get(const AttributeManager& am,
+                         NodeValue* nv,
+                         value_type& ret) {
+    const table_type& ah =
+      getTable<value_type, AttrKind::context_dependent>::get(am);
+    typename table_type::const_iterator i =
+      ah.find(std::make_pair(AttrKind::getId(), nv));
+
+    if(i == ah.end()) {
+      return false;
+    }
+
+    ret = mapping::convertBack((*i).second);
+    return true;
+  }
+
+  /** Set the attribute of nv */
+  static inline void set(AttributeManager& am,
+                         NodeValue* nv,
+                         const value_type& value) {
+    table_type& ah =
+      getTable<value_type, AttrKind::context_dependent>::get(am);
+    ah[std::make_pair(AttrKind::getId(), nv)] = mapping::convert(value);
+  }
+};
+
+/**
+ * Specialization of AttrStorage<> helper template for AttrKinds stored
+ * in a dense table, indexed by the id of the node.
+ */
+template <class AttrKind>
+struct AttrStorage<AttrKind, true> {
+  typedef typename AttrKind::value_type value_type;
+
+  /** The id of the table */
+  static const AttrTableId table_id = getDenseTables<value_type>::id;
+
+  static inline bool has(const AttributeManager& am, NodeValue* nv) {
+    const DenseAttrTable<value_type>* t =
+        am.getDenseTable<value_type>(AttrKind::getId());
+    return t != nullptr && t->has(nv->getId());
+  }
+
+  static inline bool get(const AttributeManager& am,
+                         NodeValue* nv,
+                         value_type& ret) {
+    const DenseAttrTable<value_type>* t =
+        am.getDenseTable<value_type>(AttrKind::getId());
+    return t != nullptr && t->get(nv->getId(), ret);
+  }
+
+  static inline void set(AttributeManager& am,
+                         NodeValue* nv,
+                         const value_type& value) {
+    am.getOrMakeDenseTable<value_type>(AttrKind::getId())
+        .set(nv->getId(), value);
   }
+};
 
-  return mapping::convertBack((*i).second);
+// implementation for AttributeManager::getAttribute()
+template <class AttrKind>
+typename AttrKind::value_type
+AttributeManager::getAttribute(NodeValue* nv, const AttrKind&) const {
+  typename AttrKind::value_type ret;
+  if (!AttrStorage<AttrKind>::get(*this, nv, ret))
+  {
+    return typename AttrKind::value_type();
+  }
+  return ret;
 }
 
 /* Helper template class for hasAttribute(), specialized based on
@@ -324,23 +514,10 @@ struct HasAttribute<true, AttrKind> {
   static inline bool getAttribute(const AttributeManager* am,
                                   NodeValue* nv,
                                   typename AttrKind::value_type& ret) {
-    typedef typename AttrKind::value_type value_type;
-    typedef KindValueToTableValueMapping<value_type> mapping;
-    typedef typename getTable<value_type,
-                              AttrKind::context_dependent>::table_type
-      table_type;
-
-    const table_type& ah =
-      getTable<value_type, AttrKind::context_dependent>::get(*am);
-    typename table_type::const_iterator i =
-      ah.find(std::make_pair(AttrKind::getId(), nv));
-
-    if(i == ah.end()) {
+    if (!AttrStorage<AttrKind>::get(*am, nv, ret))
+    {
       ret = AttrKind::default_value;
-    } else {
-      ret = mapping::convertBack((*i).second);
     }
-
     return true;
   }
 };
@@ -353,43 +530,13 @@ template <class AttrKind>
 struct HasAttribute<false, AttrKind> {
   static inline bool hasAttribute(const AttributeManager* am,
                                   NodeValue* nv) {
-    typedef typename AttrKind::value_type value_type;
-    //typedef KindValueToTableValueMapping<value_type> mapping;
-    typedef typename getTable<value_type, AttrKind::context_dependent>::
-              table_type table_type;
-
-    const table_type& ah =
-      getTable<value_type, AttrKind::context_dependent>::get(*am);
-    typename table_type::const_iterator i =
-      ah.find(std::make_pair(AttrKind::getId(), nv));
-
-    if(i == ah.end()) {
-      return false;
-    }
-
-    return true;
+    return AttrStorage<AttrKind>::has(*am, nv);
   }
 
   static inline bool getAttribute(const AttributeManager* am,
                                   NodeValue* nv,
                                   typename AttrKind::value_type& ret) {
-    typedef typename AttrKind::value_type value_type;
-    typedef KindValueToTableValueMapping<value_type> mapping;
-    typedef typename getTable<value_type, AttrKind::context_dependent>::
-              table_type table_type;
-
-    const table_type& ah =
-      getTable<value_type, AttrKind::context_dependent>::get(*am);
-    typename table_type::const_iterator i =
-      ah.find(std::make_pair(AttrKind::getId(), nv));
-
-    if(i == ah.end()) {
-      return false;
-    }
-
-    ret = mapping::convertBack((*i).second);
-
-    return true;
+    return AttrStorage<AttrKind>::get(*am, nv, ret);
   }
 };
 
@@ -413,14 +560,7 @@ inline void
 AttributeManager::setAttribute(NodeValue* nv,
                                const AttrKind&,
                                const typename AttrKind::value_type& value) {
-  typedef typename AttrKind::value_type value_type;
-  typedef KindValueToTableValueMapping<value_type> mapping;
-  typedef typename getTable<value_type, AttrKind::context_dependent>::
-            table_type table_type;
-
-  table_type& ah =
-      getTable<value_type, AttrKind::context_dependent>::get(*this);
-  ah[std::make_pair(AttrKind::getId(), nv)] = mapping::convert(value);
+  AttrStorage<AttrKind>::set(*this, nv, value);
 }
 
 /** Search for the NodeValue in all attribute tables and remove it. */
@@ -435,6 +575,49 @@ inline void AttributeManager::deleteFromTable(AttrHash<T>& table,
   }
 }
 
+/** Remove the NodeValue from all dense tables. */
+template <class T>
+inline void AttributeManager::deleteFromDenseTables(
+    std::vector<std::unique_ptr<DenseAttrTable<T>>>& tables, NodeValue* nv)
+{
+  // This cannot use nv as anything other than an id!
+  for (std::unique_ptr<DenseAttrTable<T>>& table : tables)
+  {
+    if (table != nullptr)
+    {
+      table->erase(nv->getId());
+    }
+  }
+}
+
+/** Remove all attributes from the dense tables. */
+template <class T>
+inline void AttributeManager::deleteAllFromDenseTables(
+    std::vector<std::unique_ptr<DenseAttrTable<T>>>& tables)
+{
+  Assert(!d_inGarbageCollection);
+  d_inGarbageCollection = true;
+  tables.clear();
+  d_inGarbageCollection = false;
+}
+
+/** Remove the attributes with the given ids from the dense tables. */
+template <class T>
+inline void AttributeManager::deleteAttributesFromDenseTables(
+    std::vector<std::unique_ptr<DenseAttrTable<T>>>& tables,
+    const std::vector<uint64_t>& ids)
+{
+  d_inGarbageCollection = true;
+  for (uint64_t id : ids)
+  {
+    if (id < tables.size())
+    {
+      tables[id].reset();
+    }
+  }
+  d_inGarbageCollection = false;
+}
+
 /** Remove all attributes from the table. */
 template <class T>
 inline void AttributeManager::deleteAllFromTable(AttrHash<T>& table) {
@@ -447,10 +630,7 @@ inline void AttributeManager::deleteAllFromTable(AttrHash<T>& table) {
 
 template <class AttrKind>
 AttributeUniqueId AttributeManager::getAttributeId(const AttrKind& attr){
-  typedef typename AttrKind::value_type value_type;
-  AttrTableId tableId = getTable<value_type,
-                                 AttrKind::context_dependent>::id;
-  return AttributeUniqueId(tableId, attr.getId());
+  return AttributeUniqueId(AttrStorage<AttrKind>::table_id, attr.getId());
 }
 
 template <class T>
@@ -24,7 +24,9 @@
 #define CVC4__EXPR__ATTRIBUTE_INTERNALS_H
 
 #include <cstdint>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace CVC4 {
 namespace expr {
@@ -334,6 +336,213 @@ public:
   }
 };/* class AttrHash<bool> */
 
+// ATTRIBUTE DENSE TABLES ======================================================
+
+/**
+ * A "DenseAttrTable<value_type>" holds the values of a single attribute
+ * kind, indexed by the ids of the nodes rather than hashed. It is used for
+ * the few attribute kinds that are looked up on (almost) every visit of a
+ * node, such as the type and the rewrite caches. Since the ids of nodes are
+ * not reused, the table is split into pages, which are allocated when their
+ * first value is set and freed when their last value is removed.
+ */
+template <class value_type>
+class DenseAttrTable
+{
+ public:
+  /** The number of values on a page is 2^PAGE_BITS */
+  static const uint64_t PAGE_BITS = 10;
+  static const uint64_t PAGE_SIZE = static_cast<uint64_t>(1) << PAGE_BITS;
+
+  /** Does the node with the given id have a value? */
+  bool has(uint64_t id) const
+  {
+    const Page* page = getPage(id);
+    return page != nullptr && page->has(id & (PAGE_SIZE - 1));
+  }
+
+  /** Get the value of the node with the given id, if it has one */
+  bool get(uint64_t id, value_type& ret) const
+  {
+    const Page* page = getPage(id);
+    uint64_t i = id & (PAGE_SIZE - 1);
+    if (page == nullptr || !page->has(i))
+    {
+      return false;
+    }
+    ret = page->d_values[i];
+    return true;
+  }
+
+  /** Set the value of the node with the given id */
+  void set(uint64_t id, const value_type& value)
+  {
+    uint64_t p = id >> PAGE_BITS;
+    if (p >= d_pages.size())
+    {
+      d_pages.resize(p + 1);
+    }
+    if (d_pages[p] == nullptr)
+    {
+      d_pages[p].reset(new Page);
+    }
+    Page& page = *d_pages[p];
+    uint64_t i = id & (PAGE_SIZE - 1);
+    if (!page.has(i))
+    {
+      page.d_present[i >> 6] |= GetBitSet(i & 63);
+      ++page.d_size;
+    }
+    page.d_values[i] = value;
+  }
+
+  /** Remove the value of the node with the given id, if it has one */
+  void erase(uint64_t id)
+  {
+    uint64_t p = id >> PAGE_BITS;
+    if (p >= d_pages.size() || d_pages[p] == nullptr)
+    {
+      return;
+    }
+    Page& page = *d_pages[p];
+    uint64_t i = id & (PAGE_SIZE - 1);
+    if (!page.has(i))
+    {
+      return;
+    }
+    page.d_present[i >> 6] &= ~GetBitSet(i & 63);
+    if (--page.d_size == 0)
+    {
+      d_pages[p].reset();
+    }
+    else
+    {
+      page.d_values[i] = value_type();
+    }
+  }
+
+ private:
+  /** A page of PAGE_SIZE consecutive ids */
+  struct Page
+  {
+    Page() : d_present(), d_size(0) {}
+    bool has(uint64_t i) const
+    {
+      return (d_present[i >> 6] & GetBitSet(i & 63)) != 0;
+    }
+    /** The values, which are default-constructed if not present */
+    value_type d_values[PAGE_SIZE];
+    /** The bits of the ids that have a value */
+    uint64_t d_present[PAGE_SIZE / 64];
+    /** The number of ids that have a value */
+    uint64_t d_size;
+  };
+
+  /** Get the page of the given id, or null if it is not allocated */
+  const Page* getPage(uint64_t id) const
+  {
+    uint64_t p = id >> PAGE_BITS;
+    return p < d_pages.size() ? d_pages[p].get() : nullptr;
+  }
+
+  /** The pages, by id / PAGE_SIZE */
+  std::vector<std::unique_ptr<Page>> d_pages;
+};/* class DenseAttrTable<> */
+
+/**
+ * In the case of Boolean-valued attributes, a dense table is a bit set: a
+ * node has the attribute iff its value is true.
+ */
+template <>
+class DenseAttrTable<bool>
+{
+ public:
+  /** The number of bits on a page is 2^PAGE_BITS */
+  static const uint64_t PAGE_BITS = 12;
+  static const uint64_t PAGE_SIZE = static_cast<uint64_t>(1) << PAGE_BITS;
+
+  /** Is the value of the node with the given id true? */
+  bool has(uint64_t id) const
+  {
+    uint64_t p = id >> PAGE_BITS;
+    if (p >= d_pages.size() || d_pages[p] == nullptr)
+    {
+      return false;
+    }
+    uint64_t i = id & (PAGE_SIZE - 1);
+    return (d_pages[p]->d_bits[i >> 6] & GetBitSet(i & 63)) != 0;
+  }
+
+  /** Get the value of the node with the given id, if it is true */
+  bool get(uint64_t id, bool& ret) const
+  {
+    ret = has(id);
+    return ret;
+  }
+
+  /** Set the value of the node with the given id */
+  void set(uint64_t id, bool value)
+  {
+    if (!value)
+    {
+      erase(id);
+      return;
+    }
+    uint64_t p = id >> PAGE_BITS;
+    if (p >= d_pages.size())
+    {
+      d_pages.resize(p + 1);
+    }
+    if (d_pages[p] == nullptr)
+    {
+      d_pages[p].reset(new Page);
+    }
+    Page& page = *d_pages[p];
+    uint64_t i = id & (PAGE_SIZE - 1);
+    uint64_t& word = page.d_bits[i >> 6];
+    if ((word & GetBitSet(i & 63)) == 0)
+    {
+      word |= GetBitSet(i & 63);
+      ++page.d_size;
+    }
+  }
+
+  /** Set the value of the node with the given id to false */
+  void erase(uint64_t id)
+  {
+    uint64_t p = id >> PAGE_BITS;
+    if (p >= d_pages.size() || d_pages[p] == nullptr)
+    {
+      return;
+    }
+    Page& page = *d_pages[p];
+    uint64_t i = id & (PAGE_SIZE - 1);
+    uint64_t& word = page.d_bits[i >> 6];
+    if ((word & GetBitSet(i & 63)) != 0)
+    {
+      word &= ~GetBitSet(i & 63);
+      if (--page.d_size == 0)
+      {
+        d_pages[p].reset();
+      }
+    }
+  }
+
+ private:
+  /** A page of PAGE_SIZE consecutive ids */
+  struct Page
+  {
+    Page() : d_bits(), d_size(0) {}
+    /** The bits of the ids whose value is true */
+    uint64_t d_bits[PAGE_SIZE / 64];
+    /** The number of ids whose value is true */
+    uint64_t d_size;
+  };
+
+  /** The pages, by id / PAGE_SIZE */
+  std::vector<std::unique_ptr<Page>> d_pages;
+};/* class DenseAttrTable<bool> */
+
 }/* CVC4::expr::attr namespace */
 
 // ATTRIBUTE IDENTIFIER ASSIGNMENT TEMPLATE ====================================
@@ -377,10 +586,20 @@ struct LastAttributeId {
  *
  * @param context_dep whether this attribute kind is
  * context-dependent
+ *
+ * @param dense_t whether the values of this attribute kind are stored in a
+ * dense table indexed by node id (see DenseAttrTable), rather than in the
+ * hash table of its value type
  */
-template <class T, class value_t, bool context_dep = false>
+template <class T,
+          class value_t,
+          bool context_dep = false,
+          bool dense_t = false>
 class Attribute
 {
+  static_assert(!context_dep || !dense_t,
+                "context-dependent attributes cannot be dense");
+
   /**
    * The unique ID associated to this attribute.  Assigned statically,
    * at load time.
@@ -408,24 +627,35 @@ public:
    */
   static const bool context_dependent = context_dep;
 
+  /** Whether the values are stored in a dense table */
+  static const bool dense = dense_t;
+
   /**
    * Register this attribute kind and check that the ID is a valid ID
    * for bool-valued attributes.  Fail an assert if not.  Otherwise
-   * return the id.
+   * return the id.  The ids of dense attribute kinds index their tables,
+   * and are assigned separately.
    */
   static inline uint64_t registerAttribute() {
     typedef typename attr::KindValueToTableValueMapping<value_t>::
                      table_value_type table_value_type;
-    return attr::LastAttributeId<table_value_type, context_dep>::getNextId();
+    return dense_t
+               ? attr::LastAttributeId<attr::DenseAttrTable<value_t>,
+                                       false>::getNextId()
+               : attr::LastAttributeId<table_value_type,
+                                       context_dep>::getNextId();
   }
 };/* class Attribute<> */
 
 /**
  * An "attribute type" structure for boolean flags (special).
  */
-template <class T, bool context_dep>
-class Attribute<T, bool, context_dep>
+template <class T, bool context_dep, bool dense_t>
+class Attribute<T, bool, context_dep, dense_t>
 {
+  static_assert(!context_dep || !dense_t,
+                "context-dependent attributes cannot be dense");
+
   /** IDs for bool-valued attributes are actually bit assignments. */
   static const uint64_t s_id;
 
@@ -456,12 +686,21 @@ public:
    */
   static const bool context_dependent = context_dep;
 
+  /** Whether the values are stored in a dense table */
+  static const bool dense = dense_t;
+
   /**
    * Register this attribute kind and check that the ID is a valid ID
    * for bool-valued attributes.  Fail an assert if not.  Otherwise
-   * return the id.
+   * return the id.  Dense attribute kinds have their own bit sets, so
+   * their ids are not limited.
    */
   static inline uint64_t registerAttribute() {
+    if (dense_t)
+    {
+      return attr::LastAttributeId<attr::DenseAttrTable<bool>,
+                                   false>::getNextId();
+    }
     const uint64_t id = attr::LastAttributeId<bool, context_dep>::getNextId();
     AlwaysAssert(id <= 63) << "Too many boolean node attributes registered "
                               "during initialization !";
@@ -472,15 +711,15 @@ public:
 // ATTRIBUTE IDENTIFIER ASSIGNMENT =============================================
 
 /** Assign unique IDs to attributes at load time. */
-template <class T, class value_t, bool context_dep>
-const uint64_t Attribute<T, value_t, context_dep>::s_id =
-    Attribute<T, value_t,  context_dep>::registerAttribute();
+template <class T, class value_t, bool context_dep, bool dense_t>
+const uint64_t Attribute<T, value_t, context_dep, dense_t>::s_id =
+    Attribute<T, value_t, context_dep, dense_t>::registerAttribute();
 
 
 /** Assign unique IDs to attributes at load time. */
-template <class T, bool context_dep>
-const uint64_t Attribute<T, bool, context_dep>::s_id =
-    Attribute<T, bool, context_dep>::registerAttribute();
+template <class T, bool context_dep, bool dense_t>
+const uint64_t Attribute<T, bool, context_dep, dense_t>::s_id =
+    Attribute<T, bool, context_dep, dense_t>::registerAttribute();
 
 }/* CVC4::expr namespace */
 }/* CVC4 namespace */
@@ -41,6 +41,9 @@ enum AttrTableId {
   AttrTableCDNode,
   AttrTableCDString,
   AttrTableCDPointer,
+  AttrTableDenseBool,
+  AttrTableDenseNode,
+  AttrTableDenseTypeNode,
   LastAttrTable
 };
 
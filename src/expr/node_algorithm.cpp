@@ -17,17 +17,100 @@
 
 #include "expr/node_algorithm.h"
 
+#include <algorithm>
+
 #include "expr/attribute.h"
 
 namespace CVC4 {
 namespace expr {
 
+struct SymbolsTag
+{
+};
+struct FreeVariablesTag
+{
+};
+/**
+ * Attribute caching the symbols of the terms that getSymbols was called on,
+ * as an SEXPR of these symbols sorted by id.
+ */
+typedef expr::Attribute<SymbolsTag, Node> SymbolsAttr;
+/** Same as above, for the free variables of getFreeVariables */
+typedef expr::Attribute<FreeVariablesTag, Node> FreeVariablesAttr;
+
+/**
+ * Returns the SEXPR of the symbols of n sorted by id, and caches it in the
+ * SymbolsAttr attribute of n. The traversal stops at the subterms whose
+ * symbols are cached. Only the terms queried are annotated, the memory used
+ * by the cache stays linear in the size of the queries.
+ */
+Node getSymbolsCached(TNode n)
+{
+  Node ret = n.getAttribute(SymbolsAttr());
+  if (!ret.isNull())
+  {
+    return ret;
+  }
+  std::vector<Node> syms;
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit;
+  TNode cur;
+  visit.push_back(n);
+  do
+  {
+    cur = visit.back();
+    visit.pop_back();
+    if (visited.find(cur) != visited.end())
+    {
+      continue;
+    }
+    visited.insert(cur);
+    Node cached = cur.getAttribute(SymbolsAttr());
+    if (!cached.isNull())
+    {
+      syms.insert(syms.end(), cached.begin(), cached.end());
+      continue;
+    }
+    if (cur.isVar() && cur.getKind() != kind::BOUND_VARIABLE)
+    {
+      syms.push_back(cur);
+    }
+    if (cur.hasOperator())
+    {
+      visit.push_back(cur.getOperator());
+    }
+    for (TNode cn : cur)
+    {
+      visit.push_back(cn);
+    }
+  } while (!visit.empty());
+  std::sort(syms.begin(), syms.end());
+  syms.erase(std::unique(syms.begin(), syms.end()), syms.end());
+  ret = NodeManager::currentNM()->mkNode(kind::SEXPR, syms);
+  // do not annotate variables, their attribute would refer to themselves
+  if (!n.isVar())
+  {
+    n.setAttribute(SymbolsAttr(), ret);
+  }
+  return ret;
+}
+
 bool hasSubterm(TNode n, TNode t, bool strict)
 {
   if (!strict && n == t)
   {
     return true;
   }
+  // the symbols of n are cached
+  if (t.isVar() && t.getKind() != kind::BOUND_VARIABLE)
+  {
+    if (n == t)
+    {
+      return false;
+    }
+    Node syms = getSymbolsCached(n);
+    return std::binary_search(syms.begin(), syms.end(), Node(t));
+  }
 
   std::unordered_set<TNode, TNodeHashFunction> visited;
   std::vector<TNode> toProcess;
@@ -190,8 +273,9 @@ struct HasBoundVarComputedTag
 {
 };
 /** Attribute true for expressions with bound variables in them */
-typedef expr::Attribute<HasBoundVarTag, bool> HasBoundVarAttr;
-typedef expr::Attribute<HasBoundVarComputedTag, bool> HasBoundVarComputedAttr;
+typedef expr::Attribute<HasBoundVarTag, bool, false, true> HasBoundVarAttr;
+typedef expr::Attribute<HasBoundVarComputedTag, bool, false, true>
+    HasBoundVarComputedAttr;
 
 bool hasBoundVar(TNode n)
 {
@@ -228,9 +312,8 @@ bool hasFreeVar(TNode n)
   return getFreeVariables(n, fvs, false);
 }
 
-bool getFreeVariables(TNode n,
-                      std::unordered_set<Node, NodeHashFunction>& fvs,
-                      bool computeFv)
+void getFreeVariablesInternal(TNode n,
+                              std::unordered_set<Node, NodeHashFunction>& fvs)
 {
   std::unordered_set<TNode, TNodeHashFunction> bound_var;
   std::unordered_map<TNode, bool, TNodeHashFunction> visited;
@@ -246,6 +329,18 @@ bool getFreeVariables(TNode n,
     {
       continue;
     }
+    Node cached = cur.getAttribute(FreeVariablesAttr());
+    if (!cached.isNull())
+    {
+      for (const Node& v : cached)
+      {
+        if (bound_var.find(v) == bound_var.end())
+        {
+          fvs.insert(v);
+        }
+      }
+      continue;
+    }
     Kind k = cur.getKind();
     bool isQuant = cur.isClosure();
     std::unordered_map<TNode, bool, TNodeHashFunction>::iterator itv =
@@ -256,14 +351,7 @@ bool getFreeVariables(TNode n,
       {
         if (bound_var.find(cur) == bound_var.end())
         {
-          if (computeFv)
-          {
-            fvs.insert(cur);
-          }
-          else
-          {
-            return true;
-          }
+          fvs.insert(cur);
         }
       }
       else if (isQuant)
@@ -297,8 +385,34 @@ bool getFreeVariables(TNode n,
       visited[cur] = true;
     }
   } while (!visit.empty());
+}
 
-  return !fvs.empty();
+bool getFreeVariables(TNode n,
+                      std::unordered_set<Node, NodeHashFunction>& fvs,
+                      bool computeFv)
+{
+  if (!hasBoundVar(n))
+  {
+    return false;
+  }
+  Node cached = n.getAttribute(FreeVariablesAttr());
+  if (cached.isNull())
+  {
+    std::unordered_set<Node, NodeHashFunction> nfvs;
+    getFreeVariablesInternal(n, nfvs);
+    std::vector<Node> fvList(nfvs.begin(), nfvs.end());
+    std::sort(fvList.begin(), fvList.end());
+    cached = NodeManager::currentNM()->mkNode(kind::SEXPR, fvList);
+    if (n.getKind() != kind::BOUND_VARIABLE)
+    {
+      n.setAttribute(FreeVariablesAttr(), cached);
+    }
+  }
+  if (computeFv)
+  {
+    fvs.insert(cached.begin(), cached.end());
+  }
+  return cached.getNumChildren() > 0;
 }
 
 bool getVariables(TNode n, std::unordered_set<TNode, TNodeHashFunction>& vs)
@@ -335,8 +449,8 @@ bool getVariables(TNode n, std::unordered_set<TNode, TNodeHashFunction>& vs)
 
 void getSymbols(TNode n, std::unordered_set<Node, NodeHashFunction>& syms)
 {
-  std::unordered_set<TNode, TNodeHashFunction> visited;
-  getSymbols(n, syms, visited);
+  Node cached = getSymbolsCached(n);
+  syms.insert(cached.begin(), cached.end());
 }
 
 void getSymbols(TNode n,
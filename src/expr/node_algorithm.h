@@ -36,6 +36,9 @@ namespace expr {
  * @param t The subterm to search for
  * @param strict If true, a term is not considered to be a subterm of itself
  * @return true iff t is a subterm in n
+ *
+ * If t is a symbol (see getSymbols), this looks up t in the cached symbols
+ * of n instead of traversing n.
  */
 bool hasSubterm(TNode n, TNode t, bool strict = false);
 
@@ -77,6 +80,9 @@ bool hasFreeVar(TNode n);
  * @param computeFv If this flag is false, then we only return true/false and
  * do not add to fvs.
  * @return true iff this node contains a free variable.
+ *
+ * The free variables of n are cached in an attribute of n, hence calling this
+ * function again on n, or on a term containing n, does not traverse n again.
  */
 bool getFreeVariables(TNode n,
                       std::unordered_set<Node, NodeHashFunction>& fvs,
@@ -95,6 +101,8 @@ bool getVariables(TNode n, std::unordered_set<TNode, TNodeHashFunction>& vs);
  * of n. A symbol is a variable that does not have kind BOUND_VARIABLE.
  * @param n The node under investigation
  * @param syms The set which the symbols of n are added to
+ *
+ * As for getFreeVariables, the symbols of n are cached in an attribute of n.
  */
 void getSymbols(TNode n, std::unordered_set<Node, NodeHashFunction>& syms);
 
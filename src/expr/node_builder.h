@@ -683,13 +683,10 @@ private:
   expr::NodeValue* constructNV();
   expr::NodeValue* constructNV() const;
 
-#ifdef CVC4_DEBUG
-  // Throws a TypeCheckingExceptionPrivate on a failure.
+  // Throws a TypeCheckingExceptionPrivate on a failure.  Does nothing if
+  // not in debug mode, unless the construction is trusted, in which case
+  // the type of n is computed from the types of its children, unchecked.
   void maybeCheckType(const TNode n) const;
-#else /* CVC4_DEBUG */
-  // Do nothing if not in debug mode.
-  inline void maybeCheckType(const TNode n) const {}
-#endif /* CVC4_DEBUG */
 
 public:
 
@@ -934,11 +931,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
            "no children permitted";
 
     // we have to copy the inline NodeValue out
-    expr::NodeValue* nv = (expr::NodeValue*)
-      std::malloc(sizeof(expr::NodeValue));
-    if(nv == NULL) {
-      throw std::bad_alloc();
-    }
+    expr::NodeValue* nv = d_nm->allocateNodeValue(0);
     // there are no children, so we don't have to worry about
     // reference counts in this case.
     nv->d_nchildren = 0;
@@ -1012,12 +1005,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
        * reference count. */
 
       // create the canonical expression value for this node
-      expr::NodeValue* nv = (expr::NodeValue*)
-        std::malloc(sizeof(expr::NodeValue) +
-                    ( sizeof(expr::NodeValue*) * d_inlineNv.d_nchildren ));
-      if(nv == NULL) {
-        throw std::bad_alloc();
-      }
+      expr::NodeValue* nv = d_nm->allocateNodeValue(d_inlineNv.d_nchildren);
       nv->d_nchildren = d_inlineNv.d_nchildren;
       nv->d_kind = d_inlineNv.d_kind;
       nv->d_id = d_nm->next_id++;// FIXME multithreading
@@ -1070,10 +1058,24 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
        * d_nv is repointed to d_inlineNv so that destruction of the
        * NodeBuilder doesn't cause any problems, and the (old) value
        * it had is placed into the NodeManager's pool and returned in
-       * a Node wrapper. */
-
-      crop();
-      expr::NodeValue* nv = d_nv;
+       * a Node wrapper.  If the NodeManager allocates from an arena,
+       * d_nv is instead copied into a block of the arena and freed
+       * (the child reference counts are taken over by the copy). */
+
+      expr::NodeValue* nv;
+      if(d_nm->d_nodeValueArena == nullptr) {
+        crop();
+        nv = d_nv;
+      } else {
+        nv = d_nm->allocateNodeValue(d_nv->d_nchildren);
+        nv->d_nchildren = d_nv->d_nchildren;
+        nv->d_kind = d_nv->d_kind;
+        nv->d_rc = 0;
+        std::copy(d_nv->d_children,
+                  d_nv->d_children + d_nv->d_nchildren,
+                  nv->d_children);
+        free(d_nv);
+      }
       nv->d_id = d_nm->next_id++;// FIXME multithreading
       d_nv = &d_inlineNv;
       d_nvMaxChildren = nchild_thresh;
@@ -1114,11 +1116,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
            "no children permitted";
 
     // we have to copy the inline NodeValue out
-    expr::NodeValue* nv = (expr::NodeValue*)
-      std::malloc(sizeof(expr::NodeValue));
-    if(nv == NULL) {
-      throw std::bad_alloc();
-    }
+    expr::NodeValue* nv = d_nm->allocateNodeValue(0);
     // there are no children, so we don't have to worry about
     // reference counts in this case.
     nv->d_nchildren = 0;
@@ -1189,12 +1187,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
        * count. */
 
       // create the canonical expression value for this node
-      expr::NodeValue* nv = (expr::NodeValue*)
-        std::malloc(sizeof(expr::NodeValue) +
-                    ( sizeof(expr::NodeValue*) * d_inlineNv.d_nchildren ));
-      if(nv == NULL) {
-        throw std::bad_alloc();
-      }
+      expr::NodeValue* nv = d_nm->allocateNodeValue(d_inlineNv.d_nchildren);
       nv->d_nchildren = d_inlineNv.d_nchildren;
       nv->d_kind = d_inlineNv.d_kind;
       nv->d_id = d_nm->next_id++;// FIXME multithreading
@@ -1243,12 +1236,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
        * decremented to match at NodeBuilder destruction time. */
 
       // create the canonical expression value for this node
-      expr::NodeValue* nv = (expr::NodeValue*)
-        std::malloc(sizeof(expr::NodeValue) +
-                    ( sizeof(expr::NodeValue*) * d_nv->d_nchildren ));
-      if(nv == NULL) {
-        throw std::bad_alloc();
-      }
+      expr::NodeValue* nv = d_nm->allocateNodeValue(d_nv->d_nchildren);
       nv->d_nchildren = d_nv->d_nchildren;
       nv->d_kind = d_nv->d_kind;
       nv->d_id = d_nm->next_id++;// FIXME multithreading
@@ -1305,10 +1293,18 @@ void NodeBuilder<nchild_thresh>::internalCopy(const NodeBuilder<N>& nb) {
   }
 }
 
-#ifdef CVC4_DEBUG
 template <unsigned nchild_thresh>
 inline void NodeBuilder<nchild_thresh>::maybeCheckType(const TNode n) const
 {
+  /* in trusted construction, propagate the types bottom up so that the
+     type of each node is computed once, from the cached types of its
+     children; the full check is left to the first getType(n, true) */
+  if (d_nm->getOptions()[options::trustedConstruction])
+  {
+    d_nm->propagateType(n);
+    return;
+  }
+#ifdef CVC4_DEBUG
   /* force an immediate type check, if early type checking is
      enabled and the current node isn't a variable or constant */
   if( d_nm->getOptions()[options::earlyTypeChecking] ) {
@@ -1319,8 +1315,8 @@ inline void NodeBuilder<nchild_thresh>::maybeCheckType(const TNode n) const
       d_nm->getType(n, true);
     }
   }
-}
 #endif /* CVC4_DEBUG */
+}
 
 template <unsigned nchild_thresh>
 std::ostream& operator<<(std::ostream& out, const NodeBuilder<nchild_thresh>& nb) {
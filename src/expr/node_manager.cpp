@@ -18,6 +18,7 @@
 #include "expr/node_manager.h"
 
 #include <algorithm>
+#include <chrono>
 #include <stack>
 #include <utility>
 
@@ -28,6 +29,7 @@
 #include "expr/node_manager_attributes.h"
 #include "expr/node_manager_listeners.h"
 #include "expr/type_checker.h"
+#include "options/expr_options.h"
 #include "options/options.h"
 #include "options/smt_options.h"
 #include "util/resource_manager.h"
@@ -84,6 +86,41 @@ struct NVReclaim {
 
 } // namespace
 
+class NodeManager::GCStatistics
+{
+ public:
+  GCStatistics(StatisticsRegistry* registry)
+      : d_registry(registry),
+        d_time("expr::NodeManager::gcTime"),
+        d_numPauses("expr::NodeManager::gcPauses", 0),
+        d_maxPause("expr::NodeManager::gcMaxPauseMicroseconds", 0),
+        d_numReclaimed("expr::NodeManager::gcReclaimedNodes", 0)
+  {
+    d_registry->registerStat(&d_time);
+    d_registry->registerStat(&d_numPauses);
+    d_registry->registerStat(&d_maxPause);
+    d_registry->registerStat(&d_numReclaimed);
+  }
+
+  ~GCStatistics()
+  {
+    d_registry->unregisterStat(&d_time);
+    d_registry->unregisterStat(&d_numPauses);
+    d_registry->unregisterStat(&d_maxPause);
+    d_registry->unregisterStat(&d_numReclaimed);
+  }
+
+  StatisticsRegistry* d_registry;
+  /** Total time spent reclaiming zombies. */
+  TimerStat d_time;
+  /** Number of calls to reclaimZombies() that reclaimed a node. */
+  IntStat d_numPauses;
+  /** Longest such call. */
+  IntStat d_maxPause;
+  /** Number of reclaimed nodes. */
+  IntStat d_numReclaimed;
+}; /* class NodeManager::GCStatistics */
+
 namespace attr {
   struct LambdaBoundVarListTag { };
 }/* CVC4::attr namespace */
@@ -125,6 +162,12 @@ NodeManager::NodeManager(ExprManager* exprManager,
 }
 
 void NodeManager::init() {
+  d_gcBatchSize = (*d_options)[options::gcBatchSize];
+  d_gcStats.reset(new GCStatistics(d_statisticsRegistry));
+  if ((*d_options)[options::nodeArena])
+  {
+    d_nodeValueArena.reset(new expr::NodeValueArena());
+  }
   poolInsert( &expr::NodeValue::null() );
 
   for(unsigned i = 0; i < unsigned(kind::LAST_KIND); ++i) {
@@ -150,6 +193,22 @@ void NodeManager::init() {
   if((*d_options)[options::cpuTime]) {
     d_resourceManager->useCPUTime(true);
   }
+  std::vector<std::pair<ResourceManager::Resource, uint64_t>> kindLimits;
+  ResourceManager::parseResourceLimits(
+      (*d_options)[options::perCallResourceKindLimits], kindLimits);
+  for (const std::pair<ResourceManager::Resource, uint64_t>& l : kindLimits)
+  {
+    d_resourceManager->setResourceLimit(l.first, l.second);
+  }
+  if ((*d_options)[options::memoryLimit] != 0)
+  {
+    d_resourceManager->setMemoryLimit((*d_options)[options::memoryLimit]);
+  }
+  if ((*d_options)[options::memorySoftLimit] != 0)
+  {
+    d_resourceManager->setMemoryLimit((*d_options)[options::memorySoftLimit],
+                                      true);
+  }
 
   // Do not notify() upon registration as these were handled manually above.
   d_registrations->add(d_options->registerTlimitListener(
@@ -191,6 +250,32 @@ NodeManager::~NodeManager() {
 
   Assert(!d_attrManager->inGarbageCollection());
 
+  if (d_nodeValueArena != nullptr)
+  {
+    // All attributes are gone, so no destructors other than those of the
+    // constant payloads need to run. The constants are in the pool and were
+    // allocated with malloc(), everything else is released with the arena.
+    {
+      // Payloads holding a TypeNode (e.g. EmptySet) zombify it when they are
+      // deleted, which must not reclaim zombies while the pool is iterated.
+      ScopedBool dontGC(d_inReclaimZombies);
+      for (NodeValue* nv : d_nodeValuePool)
+      {
+        if (nv->getMetaKind() == kind::metakind::CONSTANT)
+        {
+          kind::metakind::deleteNodeValueConstant(nv);
+          free(nv);
+        }
+      }
+    }
+    d_nodeValuePool.clear();
+    poolInsert(&expr::NodeValue::null());
+    d_zombies.clear();
+    d_zombieStack.clear();
+    d_maxedOut.clear();
+    d_nodeValueArena.reset();
+  }
+
   std::vector<NodeValue*> order = TopologicalSort(d_maxedOut);
   d_maxedOut.clear();
 
@@ -228,6 +313,7 @@ NodeManager::~NodeManager() {
   }
 
   // defensive coding, in case destruction-order issues pop up (they often do)
+  d_gcStats.reset();
   delete d_statisticsRegistry;
   d_statisticsRegistry = NULL;
   delete d_registrations;
@@ -253,7 +339,7 @@ const DType& NodeManager::getDTypeForIndex(unsigned index) const
   return *d_ownedDTypes[index];
 }
 
-void NodeManager::reclaimZombies() {
+void NodeManager::reclaimZombies(size_t limit) {
   // FIXME multithreading
   Assert(!d_attrManager->inGarbageCollection());
 
@@ -267,45 +353,24 @@ void NodeManager::reclaimZombies() {
   // and ensures that d_inReclaimZombies is set back to false.
   ScopedBool r(d_inReclaimZombies);
 
-  // We copy the set away and clear the NodeManager's set of zombies.
-  // This is because reclaimZombie() decrements the RC of the
-  // NodeValue's children, which may (recursively) reclaim them.
-  //
-  // Let's say we're reclaiming zombie NodeValue "A" and its child "B"
-  // then becomes a zombie (NodeManager::markForDeletion(B) is called).
-  //
-  // One way to handle B's zombification would be simply to put it
-  // into d_zombies.  This is what we do.  However, if we were to
-  // concurrently process d_zombies in the loop below, such addition
-  // may be invisible to us (B is leaked) or even invalidate our
-  // iterator, causing a crash.  So we need to copy the set away.
-
-  vector<NodeValue*> zombies;
-  zombies.reserve(d_zombies.size());
-  remove_copy_if(d_zombies.begin(),
-                 d_zombies.end(),
-                 back_inserter(zombies),
-                 NodeValueReferenceCountNonZero());
-  d_zombies.clear();
-
-#ifdef _LIBCPP_VERSION
-  NodeValue* last = NULL;
-#endif
-  for(vector<NodeValue*>::iterator i = zombies.begin();
-      i != zombies.end();
-      ++i) {
-    NodeValue* nv = *i;
-#ifdef _LIBCPP_VERSION
-    // Work around an apparent bug in libc++'s hash_set<> which can
-    // (very occasionally) have an element repeated.
-    if(nv == last) {
-      continue;
-    }
-    last = nv;
-#endif
+  // Reclaiming a zombie decrements the RC of the NodeValue's children,
+  // which may zombify them (NodeManager::markForDeletion() is called).
+  // These are pushed onto d_zombieStack and hence reclaimed next (if
+  // within the limit), so we only look at the top of the stack.
+  size_t numReclaimed = 0;
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  d_gcStats->d_time.start();
+
+  while (!d_zombieStack.empty() && (limit == 0 || numReclaimed < limit))
+  {
+    NodeValue* nv = d_zombieStack.back();
+    d_zombieStack.pop_back();
+    d_zombies.erase(nv);
 
     // collect ONLY IF still zero
     if(nv->d_rc == 0) {
+      ++numReclaimed;
       if(Debug.isOn("gc")) {
         Debug("gc") << "deleting node value " << nv
                     << " [" << nv->d_id << "]: ";
@@ -351,10 +416,23 @@ void NodeManager::reclaimZombies() {
         // constant, but then, you should probably use a smart-pointer
         // type for a constant payload.)
         kind::metakind::deleteNodeValueConstant(nv);
+        free(nv);
+      } else {
+        deallocateNodeValue(nv);
       }
-      free(nv);
     }
   }
+
+  d_gcStats->d_time.stop();
+  if (numReclaimed > 0)
+  {
+    std::chrono::microseconds pause =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+    ++d_gcStats->d_numPauses;
+    d_gcStats->d_maxPause.maxAssign(pause.count());
+    d_gcStats->d_numReclaimed += numReclaimed;
+  }
 }/* NodeManager::reclaimZombies() */
 
 std::vector<NodeValue*> NodeManager::TopologicalSort(
@@ -420,7 +498,10 @@ TypeNode NodeManager::getType(TNode n, bool check)
 
   Debug("getType") << this << " getting type for " << &n << " " << n << ", check=" << check << ", needsCheck = " << needsCheck << ", hasType = " << hasType << endl;
   
-  if(needsCheck && !(*d_options)[options::earlyTypeChecking]) {
+  if (needsCheck
+      && (!(*d_options)[options::earlyTypeChecking]
+          || (*d_options)[options::trustedConstruction]))
+  {
     /* Iterate and compute the children bottom up. This avoids stack
        overflows in computeType() when the Node graph is really deep,
        which should only affect us when we're type checking lazily. */
@@ -430,6 +511,14 @@ TypeNode NodeManager::getType(TNode n, bool check)
     while( !worklist.empty() ) {
       TNode m = worklist.top();
 
+      /* A node shared in the DAG may be pushed several times, check it
+         only once */
+      if (getAttribute(m, TypeCheckedAttr()))
+      {
+        worklist.pop();
+        continue;
+      }
+
       bool readyToCompute = true;
 
       for( TNode::iterator it = m.begin(), end = m.end();
@@ -468,6 +557,26 @@ TypeNode NodeManager::getType(TNode n, bool check)
   return typeNode;
 }
 
+void NodeManager::propagateType(TNode n)
+{
+  kind::MetaKind mk = n.getMetaKind();
+  if (mk == kind::metakind::VARIABLE || mk == kind::metakind::NULLARY_OPERATOR
+      || hasAttribute(n, TypeAttr()))
+  {
+    return;
+  }
+  for (TNode nc : n)
+  {
+    if (!hasAttribute(nc, TypeAttr()))
+    {
+      // computed lazily, by the first call to getType()
+      return;
+    }
+  }
+  NodeManagerScope nms(this);
+  TypeChecker::computeType(this, n, false);
+}
+
 Node NodeManager::mkSkolem(const std::string& prefix, const TypeNode& type, const std::string& comment, int flags) {
   Node n = NodeBuilder<0>(this, kind::SKOLEM);
   setAttribute(n, TypeAttr(), type);
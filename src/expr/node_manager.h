@@ -28,6 +28,7 @@
 #ifndef CVC4__NODE_MANAGER_H
 #define CVC4__NODE_MANAGER_H
 
+#include <memory>
 #include <vector>
 #include <string>
 #include <unordered_set>
@@ -36,6 +37,8 @@
 #include "expr/kind.h"
 #include "expr/metakind.h"
 #include "expr/node_value.h"
+#include "expr/node_value_arena.h"
+#include "expr/node_value_hash_set.h"
 #include "options/options.h"
 
 namespace CVC4 {
@@ -80,6 +83,19 @@ class NodeManagerListener {
   virtual void nmNotifyDeleteNode(TNode n) {}
 }; /* class NodeManagerListener */
 
+/**
+ * The NodeManager owns the pool of hash-consed NodeValues, the attribute
+ * tables and the set of zombies of all nodes created through it.
+ *
+ * A NodeManager and its nodes must only be used by one thread at a time:
+ * the reference counts in the NodeValue header are packed bit-fields that
+ * are not updated atomically, so copying a Node concurrently from two
+ * threads corrupts its reference count. Distinct NodeManagers, on the other
+ * hand, share no mutable state (all global state that is modified after
+ * initialization is thread_local) and may be used concurrently from
+ * different threads, e.g., by the portfolio command executor. Terms are
+ * moved between NodeManagers with Expr::exportTo().
+ */
 class NodeManager {
   template <unsigned nchild_thresh> friend class CVC4::NodeBuilder;
   friend class NodeManagerScope;
@@ -94,14 +110,9 @@ class NodeManager {
   friend std::vector<DatatypeType> ExprManager::mkMutualDatatypeTypes(
       std::vector<Datatype>&, std::set<Type>&, uint32_t);
 
-  /** Predicate for use with STL algorithms */
-  struct NodeValueReferenceCountNonZero {
-    bool operator()(expr::NodeValue* nv) { return nv->d_rc > 0; }
-  };
-
-  typedef std::unordered_set<expr::NodeValue*,
-                             expr::NodeValuePoolHashFunction,
-                             expr::NodeValuePoolEq> NodeValuePool;
+  typedef expr::NodeValueHashSet<expr::NodeValuePoolHashFunction,
+                                 expr::NodeValuePoolEq>
+      NodeValuePool;
   typedef std::unordered_set<expr::NodeValue*,
                              expr::NodeValueIDHashFunction,
                              expr::NodeValueIDEquality> NodeValueIDSet;
@@ -147,12 +158,29 @@ class NodeManager {
   bool d_inReclaimZombies;
 
   /**
-   * The set of zombie nodes.  We may want to revisit this design, as
-   * we might like to delete nodes in least-recently-used order.  But
-   * we also need to avoid processing a zombie twice.
+   * The set of zombie nodes.  This avoids processing a zombie twice,
+   * d_zombieStack holds the same nodes in the order they were zombified.
    */
   NodeValueIDSet d_zombies;
 
+  /**
+   * The zombie nodes, the most recently zombified one last.  Zombies are
+   * reclaimed from the back: nodes that die young (e.g., temporaries of
+   * rewriting) are recycled first, and the children zombified by reclaiming
+   * a node are reclaimed right after it.
+   */
+  std::vector<expr::NodeValue*> d_zombieStack;
+
+  /**
+   * The maximal number of zombies reclaimed at once when the number of
+   * zombies exceeds the threshold (--gc-batch), 0 for no limit.
+   */
+  size_t d_gcBatchSize;
+
+  /** Statistics about the reclamation of zombies. */
+  class GCStatistics;
+  std::unique_ptr<GCStatistics> d_gcStats;
+
   /**
    * NodeValues with maxed out reference counts. These live as long as the
    * NodeManager. They have a custom deallocation procedure at the very end.
@@ -215,6 +243,27 @@ class NodeManager {
    */
   unsigned d_skolemCounter;
 
+  /**
+   * The allocator for the non-constant NodeValues if --node-arena is
+   * enabled, null otherwise. With an arena, the NodeValues are not
+   * reclaimed one by one when this NodeManager is destroyed but released in
+   * bulk.
+   */
+  std::unique_ptr<expr::NodeValueArena> d_nodeValueArena;
+
+  /**
+   * Allocate the memory for a (non-constant) NodeValue with nchildren
+   * children.
+   *
+   * @throws bad_alloc if the allocation fails
+   */
+  inline expr::NodeValue* allocateNodeValue(uint32_t nchildren);
+
+  /**
+   * Release the memory of a NodeValue obtained from allocateNodeValue().
+   */
+  inline void deallocateNodeValue(expr::NodeValue* nv);
+
   /**
    * Look up a NodeValue in the pool associated to this NodeManager.
    * The NodeValue argument need not be a "completely-constructed"
@@ -241,6 +290,21 @@ class NodeManager {
    */
   inline expr::NodeValue* poolLookup(expr::NodeValue* nv) const;
 
+  /**
+   * Look up the node of the given kind and N children in the pool, without
+   * building it.  The children are put, without touching their reference
+   * counts, in a NodeValue on the stack whose pool hash is that of the node.
+   * Returns NULL if the node is not in the pool, or if it is not a plain
+   * operator application (e.g. it has an operator given as a BUILTIN), in
+   * which case the caller should build it with a NodeBuilder.
+   *
+   * This is the fast path of the mkNode() variants with few children, which
+   * the rewriters call mostly on nodes that already exist.
+   */
+  template <size_t N>
+  inline expr::NodeValue* poolLookupChildren(Kind kind,
+                                             const TNode (&children)[N]) const;
+
   /**
    * Insert a NodeValue into the NodeManager's pool.
    *
@@ -290,11 +354,14 @@ class NodeManager {
     // destructor, then `markForDeletion()` will be called on n2.
     Assert(d_zombies.find(nv) == d_zombies.end() || *d_zombies.find(nv) == nv);
 
-    d_zombies.insert(nv);  // FIXME multithreading
+    if (d_zombies.insert(nv).second)  // FIXME multithreading
+    {
+      d_zombieStack.push_back(nv);
+    }
 
     if(safeToReclaimZombies()) {
       if(d_zombies.size() > 5000) {
-        reclaimZombies();
+        reclaimZombies(d_gcBatchSize);
       }
     }
   }
@@ -313,9 +380,10 @@ class NodeManager {
   }
 
   /**
-   * Reclaim all zombies.
+   * Reclaim at most limit zombies (all if limit is 0), the most recently
+   * zombified ones first.
    */
-  void reclaimZombies();
+  void reclaimZombies(size_t limit = 0);
 
   /**
    * It is safe to collect zombies.
@@ -935,6 +1003,14 @@ public:
    */
   TypeNode getType(TNode n, bool check = false);
 
+  /**
+   * Compute the type of n without checking it, provided that the types of
+   * its children are known, so that the computation does not recurse.  This
+   * is used to propagate types bottom up when the construction of nodes is
+   * trusted (see option trustedConstruction).
+   */
+  void propagateType(TNode n);
+
   /**
    * Convert a node to an expression.  Uses the ExprManager
    * associated to this NodeManager.
@@ -1207,12 +1283,76 @@ inline expr::NodeValue* NodeManager::poolLookup(expr::NodeValue* nv) const {
   }
 }
 
+template <size_t N>
+inline expr::NodeValue* NodeManager::poolLookupChildren(
+    Kind kind, const TNode (&children)[N]) const
+{
+  kind::MetaKind mk = kind::metaKindOf(kind);
+  if (mk != kind::metakind::OPERATOR && mk != kind::metakind::PARAMETERIZED)
+  {
+    return NULL;
+  }
+  NVStorage<N> nvStorage;
+  expr::NodeValue& nvStack = reinterpret_cast<expr::NodeValue&>(nvStorage);
+
+  nvStack.d_id = 0;
+  nvStack.d_kind = expr::NodeValue::kindToDKind(kind);
+  nvStack.d_rc = 0;
+  nvStack.d_nchildren = N;
+
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6))
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+
+  for (size_t i = 0; i < N; ++i)
+  {
+    // the NodeBuilder turns BUILTIN operators into other nodes
+    if (children[i].isNull() || children[i].getKind() == kind::BUILTIN)
+    {
+      return NULL;
+    }
+    nvStack.d_children[i] = children[i].d_nv;
+  }
+  expr::NodeValue* nv = poolLookup(&nvStack);
+
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6))
+#pragma GCC diagnostic pop
+#endif
+
+  return nv;
+}
+
 inline void NodeManager::poolInsert(expr::NodeValue* nv) {
   Assert(d_nodeValuePool.find(nv) == d_nodeValuePool.end())
       << "NodeValue already in the pool!";
   d_nodeValuePool.insert(nv);// FIXME multithreading
 }
 
+inline expr::NodeValue* NodeManager::allocateNodeValue(uint32_t nchildren)
+{
+  size_t size =
+      sizeof(expr::NodeValue) + sizeof(expr::NodeValue*) * nchildren;
+  void* p = d_nodeValueArena == nullptr ? std::malloc(size)
+                                        : d_nodeValueArena->allocate(size);
+  if (p == NULL)
+  {
+    throw std::bad_alloc();
+  }
+  return static_cast<expr::NodeValue*>(p);
+}
+
+inline void NodeManager::deallocateNodeValue(expr::NodeValue* nv)
+{
+  if (d_nodeValueArena == nullptr)
+  {
+    std::free(nv);
+    return;
+  }
+  d_nodeValueArena->deallocate(
+      nv, sizeof(expr::NodeValue) + sizeof(expr::NodeValue*) * nv->d_nchildren);
+}
+
 inline void NodeManager::poolRemove(expr::NodeValue* nv) {
   Assert(d_nodeValuePool.find(nv) != d_nodeValuePool.end())
       << "NodeValue is not in the pool!";
@@ -1280,6 +1420,12 @@ inline Kind NodeManager::operatorToKind(TNode n) {
 }
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1) {
+  const TNode children[1] = {child1};
+  expr::NodeValue* nv = poolLookupChildren(kind, children);
+  if (nv != NULL)
+  {
+    return Node(nv);
+  }
   NodeBuilder<1> nb(this, kind);
   nb << child1;
   return nb.constructNode();
@@ -1292,6 +1438,12 @@ inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1) {
 }
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1, TNode child2) {
+  const TNode children[2] = {child1, child2};
+  expr::NodeValue* nv = poolLookupChildren(kind, children);
+  if (nv != NULL)
+  {
+    return Node(nv);
+  }
   NodeBuilder<2> nb(this, kind);
   nb << child1 << child2;
   return nb.constructNode();
@@ -1305,6 +1457,12 @@ inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2) {
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1, TNode child2,
                                 TNode child3) {
+  const TNode children[3] = {child1, child2, child3};
+  expr::NodeValue* nv = poolLookupChildren(kind, children);
+  if (nv != NULL)
+  {
+    return Node(nv);
+  }
   NodeBuilder<3> nb(this, kind);
   nb << child1 << child2 << child3;
   return nb.constructNode();
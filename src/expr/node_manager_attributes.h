@@ -35,8 +35,10 @@ namespace attr {
 typedef Attribute<attr::VarNameTag, std::string> VarNameAttr;
 typedef Attribute<attr::GlobalVarTag(), bool> GlobalVarAttr;
 typedef Attribute<attr::SortArityTag, uint64_t> SortArityAttr;
-typedef expr::Attribute<expr::attr::TypeTag, TypeNode> TypeAttr;
-typedef expr::Attribute<expr::attr::TypeCheckedTag, bool> TypeCheckedAttr;
+// The types are looked up on every type check, so they are dense
+typedef expr::Attribute<expr::attr::TypeTag, TypeNode, false, true> TypeAttr;
+typedef expr::Attribute<expr::attr::TypeCheckedTag, bool, false, true>
+    TypeCheckedAttr;
 
 }/* CVC4::expr namespace */
 }/* CVC4 namespace */
@@ -0,0 +1,178 @@
+/*********************                                                        */
+/*! \file node_map.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A map from nodes to values, indexed by the ids of the nodes
+ **
+ ** A map from nodes to values, for the caches of passes and utilities that
+ ** would otherwise use an std::unordered_map<Node, T, NodeHashFunction>.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__EXPR__NODE_MAP_H
+#define CVC4__EXPR__NODE_MAP_H
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "expr/node.h"
+
+namespace CVC4 {
+namespace expr {
+
+/**
+ * A map from nodes to values of type T, stored in arrays indexed by the ids
+ * of the nodes. Compared to an unordered map, a lookup does not hash, and
+ * the map does not take references to its keys: since the NodeManager never
+ * reuses the id of a node, the entry of a node that is reclaimed is never
+ * found again. As a consequence, the keys cannot be enumerated, and all keys
+ * must belong to the same NodeManager.
+ *
+ * The arrays are allocated in pages of PAGE_SIZE consecutive ids, so a map of
+ * a few nodes created at different times costs a few pages. The entries are
+ * stamped by an epoch, which allows clear() to run in constant time. The
+ * values of cleared entries are only destroyed when they are overwritten or
+ * when the map is released, so a map whose values hold nodes should be
+ * released rather than cleared when these nodes should be reclaimed.
+ */
+template <class T>
+class NodeMap
+{
+ public:
+  /** The number of entries on a page is 2^PAGE_BITS */
+  static const uint64_t PAGE_BITS = 8;
+  static const uint64_t PAGE_SIZE = static_cast<uint64_t>(1) << PAGE_BITS;
+
+  NodeMap() : d_epoch(1), d_size(0) {}
+
+  /** The number of entries */
+  size_t size() const { return d_size; }
+  /** Is the map empty? */
+  bool empty() const { return d_size == 0; }
+
+  /** Does n have an entry? */
+  bool contains(TNode n) const { return find(n) != nullptr; }
+
+  /** Get the value of n, or null if it has no entry */
+  const T* find(TNode n) const
+  {
+    uint64_t id = n.getId();
+    uint64_t p = id >> PAGE_BITS;
+    if (p >= d_pages.size() || d_pages[p] == nullptr)
+    {
+      return nullptr;
+    }
+    const Page& page = *d_pages[p];
+    uint64_t i = id & (PAGE_SIZE - 1);
+    return page.d_epochs[i] == d_epoch ? &page.d_values[i] : nullptr;
+  }
+  /** Get the value of n, or null if it has no entry */
+  T* find(TNode n)
+  {
+    return const_cast<T*>(static_cast<const NodeMap*>(this)->find(n));
+  }
+
+  /**
+   * Get the value of n, inserting a default-constructed value if it has no
+   * entry
+   */
+  T& operator[](TNode n)
+  {
+    uint64_t id = n.getId();
+    uint64_t p = id >> PAGE_BITS;
+    if (p >= d_pages.size())
+    {
+      d_pages.resize(p + 1);
+    }
+    if (d_pages[p] == nullptr)
+    {
+      d_pages[p].reset(new Page);
+    }
+    Page& page = *d_pages[p];
+    uint64_t i = id & (PAGE_SIZE - 1);
+    if (page.d_epochs[i] != d_epoch)
+    {
+      page.d_epochs[i] = d_epoch;
+      page.d_values[i] = T();
+      ++d_size;
+    }
+    return page.d_values[i];
+  }
+
+  /** Set the value of n */
+  void insert(TNode n, const T& value) { (*this)[n] = value; }
+
+  /** Remove the entry of n, returns true if it had one */
+  bool erase(TNode n)
+  {
+    uint64_t id = n.getId();
+    uint64_t p = id >> PAGE_BITS;
+    if (p >= d_pages.size() || d_pages[p] == nullptr)
+    {
+      return false;
+    }
+    Page& page = *d_pages[p];
+    uint64_t i = id & (PAGE_SIZE - 1);
+    if (page.d_epochs[i] != d_epoch)
+    {
+      return false;
+    }
+    page.d_epochs[i] = 0;
+    page.d_values[i] = T();
+    --d_size;
+    return true;
+  }
+
+  /**
+   * Remove all entries, in constant time. The pages and the values of the
+   * entries are kept, see release().
+   */
+  void clear()
+  {
+    d_size = 0;
+    if (++d_epoch == 0)
+    {
+      // the epochs wrapped around, so old stamps could match again
+      release();
+    }
+  }
+
+  /** Remove all entries, and free the pages and the values of the entries */
+  void release()
+  {
+    d_pages.clear();
+    d_epoch = 1;
+    d_size = 0;
+  }
+
+ private:
+  /** A page of PAGE_SIZE consecutive ids */
+  struct Page
+  {
+    Page() : d_epochs() {}
+    /** The values, only meaningful for the entries of the current epoch */
+    T d_values[PAGE_SIZE];
+    /** The epoch at which each entry was set, 0 if never */
+    uint32_t d_epochs[PAGE_SIZE];
+  };
+
+  /** The pages, by id / PAGE_SIZE */
+  std::vector<std::unique_ptr<Page>> d_pages;
+  /** The current epoch, which is never 0 */
+  uint32_t d_epoch;
+  /** The number of entries of the current epoch */
+  size_t d_size;
+}; /* class NodeMap */
+
+}  // namespace expr
+}  // namespace CVC4
+
+#endif /* CVC4__EXPR__NODE_MAP_H */
@@ -0,0 +1,100 @@
+/*********************                                                        */
+/*! \file node_value_arena.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A slab allocator for NodeValues.
+ **
+ ** A slab allocator for NodeValues.
+ **/
+
+#include "expr/node_value_arena.h"
+
+#include <cstdlib>
+
+#include "base/check.h"
+
+namespace CVC4 {
+namespace expr {
+
+NodeValueArena::NodeValueArena() : d_next(NULL), d_end(NULL), d_reserved(0)
+{
+  for (size_t k = 0; k <= s_maxUnits; ++k)
+  {
+    d_free[k] = NULL;
+  }
+}
+
+NodeValueArena::~NodeValueArena()
+{
+  for (char* chunk : d_chunks)
+  {
+    std::free(chunk);
+  }
+  for (void* p : d_large)
+  {
+    std::free(p);
+  }
+}
+
+void* NodeValueArena::allocate(size_t size)
+{
+  Assert(size > 0 && size % s_unit == 0);
+  size_t units = size / s_unit;
+  if (units > s_maxUnits)
+  {
+    void* p = std::malloc(size);
+    if (p != NULL)
+    {
+      d_large.insert(p);
+      d_reserved += size;
+    }
+    return p;
+  }
+  if (d_free[units] != NULL)
+  {
+    void* p = d_free[units];
+    d_free[units] = *static_cast<void**>(p);
+    return p;
+  }
+  if (static_cast<size_t>(d_end - d_next) < size)
+  {
+    // The rest of the current chunk is lost, it is at most the size of the
+    // largest block.
+    char* chunk = static_cast<char*>(std::malloc(s_chunkSize));
+    if (chunk == NULL)
+    {
+      return NULL;
+    }
+    d_chunks.push_back(chunk);
+    d_reserved += s_chunkSize;
+    d_next = chunk;
+    d_end = chunk + s_chunkSize;
+  }
+  void* p = d_next;
+  d_next += size;
+  return p;
+}
+
+void NodeValueArena::deallocate(void* p, size_t size)
+{
+  Assert(size > 0 && size % s_unit == 0);
+  size_t units = size / s_unit;
+  if (units > s_maxUnits)
+  {
+    Assert(d_large.find(p) != d_large.end());
+    d_large.erase(p);
+    d_reserved -= size;
+    std::free(p);
+    return;
+  }
+  *static_cast<void**>(p) = d_free[units];
+  d_free[units] = p;
+}
+
+}  // namespace expr
+}  // namespace CVC4
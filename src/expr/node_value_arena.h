@@ -0,0 +1,81 @@
+/*********************                                                        */
+/*! \file node_value_arena.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A slab allocator for NodeValues.
+ **
+ ** A slab allocator for NodeValues. Small blocks are carved out of large
+ ** chunks and recycled through one free list per block size, larger blocks
+ ** are allocated with malloc(). All memory is released in bulk when the
+ ** arena is destroyed, which allows the NodeManager to skip the reclamation
+ ** of its nodes one by one.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__EXPR__NODE_VALUE_ARENA_H
+#define CVC4__EXPR__NODE_VALUE_ARENA_H
+
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
+
+namespace CVC4 {
+namespace expr {
+
+class NodeValueArena
+{
+ public:
+  NodeValueArena();
+
+  /** Releases all memory ever allocated by this arena. */
+  ~NodeValueArena();
+
+  /**
+   * Allocate a block of size bytes, size must be a multiple of the size of a
+   * pointer. Returns NULL if no memory is available.
+   */
+  void* allocate(size_t size);
+
+  /** Return the block p of size bytes obtained from allocate(). */
+  void deallocate(void* p, size_t size);
+
+  /** Get the total number of bytes obtained from the system. */
+  size_t getNumBytesReserved() const { return d_reserved; }
+
+ private:
+  NodeValueArena(const NodeValueArena&) = delete;
+  NodeValueArena& operator=(const NodeValueArena&) = delete;
+
+  /** The unit block sizes are measured in. */
+  static const size_t s_unit = sizeof(void*);
+  /** Blocks of at most this many units are allocated from the chunks. */
+  static const size_t s_maxUnits = 32;
+  /** The size of a chunk in bytes. */
+  static const size_t s_chunkSize = 64 * 1024;
+
+  /** The chunks allocated so far. */
+  std::vector<char*> d_chunks;
+  /** The unused part of the last chunk. */
+  char* d_next;
+  char* d_end;
+  /**
+   * The heads of the free lists, d_free[k] for blocks of k units. The first
+   * word of a free block points to the next one.
+   */
+  void* d_free[s_maxUnits + 1];
+  /** Blocks that are too large for the chunks. */
+  std::unordered_set<void*> d_large;
+  /** Total number of bytes obtained from the system. */
+  size_t d_reserved;
+}; /* class NodeValueArena */
+
+}  // namespace expr
+}  // namespace CVC4
+
+#endif /* CVC4__EXPR__NODE_VALUE_ARENA_H */
@@ -0,0 +1,221 @@
+/*********************                                                        */
+/*! \file node_value_hash_set.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A compact hash set of NodeValue pointers.
+ **
+ ** A compact hash set of NodeValue pointers, used as the pool of a
+ ** NodeManager. It uses open addressing with linear probing and keeps (32
+ ** bits of) the hash of each element in a parallel array, so that probes
+ ** rarely need to look at the NodeValues themselves. Compared to a
+ ** std::unordered_set, this saves the separately allocated list node and
+ ** the bucket pointer per element: a slot takes 12 bytes.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__EXPR__NODE_VALUE_HASH_SET_H
+#define CVC4__EXPR__NODE_VALUE_HASH_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "base/check.h"
+
+namespace CVC4 {
+namespace expr {
+
+class NodeValue;
+
+template <class Hash, class Equal>
+class NodeValueHashSet
+{
+ public:
+  class const_iterator
+      : public std::iterator<std::forward_iterator_tag, NodeValue*>
+  {
+   public:
+    const_iterator(NodeValue* const* slot, NodeValue* const* end)
+        : d_slot(slot), d_end(end)
+    {
+      skipEmpty();
+    }
+    NodeValue* operator*() const { return *d_slot; }
+    const_iterator& operator++()
+    {
+      ++d_slot;
+      skipEmpty();
+      return *this;
+    }
+    bool operator==(const const_iterator& it) const
+    {
+      return d_slot == it.d_slot;
+    }
+    bool operator!=(const const_iterator& it) const
+    {
+      return d_slot != it.d_slot;
+    }
+
+   private:
+    void skipEmpty()
+    {
+      while (d_slot != d_end && *d_slot == nullptr)
+      {
+        ++d_slot;
+      }
+    }
+    NodeValue* const* d_slot;
+    NodeValue* const* d_end;
+  }; /* class NodeValueHashSet::const_iterator */
+
+  NodeValueHashSet()
+      : d_nodes(s_minCapacity, nullptr), d_hashes(s_minCapacity, 0), d_size(0)
+  {
+  }
+
+  size_t size() const { return d_size; }
+
+  bool empty() const { return d_size == 0; }
+
+  const_iterator begin() const
+  {
+    return const_iterator(d_nodes.data(), d_nodes.data() + d_nodes.size());
+  }
+
+  const_iterator end() const
+  {
+    NodeValue* const* e = d_nodes.data() + d_nodes.size();
+    return const_iterator(e, e);
+  }
+
+  /**
+   * Find an element equal to nv, which need not be a fully constructed
+   * NodeValue (see NodeManager::poolLookup()).
+   */
+  const_iterator find(const NodeValue* nv) const
+  {
+    uint32_t h = static_cast<uint32_t>(Hash()(nv));
+    for (size_t i = index(h);; i = (i + 1) & mask())
+    {
+      if (d_nodes[i] == nullptr)
+      {
+        return end();
+      }
+      if (d_hashes[i] == h && Equal()(d_nodes[i], nv))
+      {
+        return const_iterator(d_nodes.data() + i,
+                              d_nodes.data() + d_nodes.size());
+      }
+    }
+  }
+
+  /** Insert nv, which must not be in the set. */
+  void insert(NodeValue* nv)
+  {
+    // keep the load factor below 3/4
+    if (4 * (d_size + 1) > 3 * d_nodes.size())
+    {
+      rehash(2 * d_nodes.size());
+    }
+    place(nv, static_cast<uint32_t>(Hash()(nv)));
+    ++d_size;
+  }
+
+  /** Remove nv, which must be in the set. */
+  void erase(const NodeValue* nv)
+  {
+    size_t i = index(static_cast<uint32_t>(Hash()(nv)));
+    while (d_nodes[i] != nv)
+    {
+      Assert(d_nodes[i] != nullptr) << "NodeValue is not in the set";
+      i = (i + 1) & mask();
+    }
+    // Shift the following entries of the probe sequence back so that no
+    // tombstones are needed.
+    for (size_t j = (i + 1) & mask(); d_nodes[j] != nullptr;
+         j = (j + 1) & mask())
+    {
+      size_t k = index(d_hashes[j]);
+      // move j to i unless its home slot k lies cyclically in (i, j]
+      if (i <= j ? (i < k && k <= j) : (i < k || k <= j))
+      {
+        continue;
+      }
+      d_nodes[i] = d_nodes[j];
+      d_hashes[i] = d_hashes[j];
+      i = j;
+    }
+    d_nodes[i] = nullptr;
+    --d_size;
+  }
+
+  void clear()
+  {
+    std::vector<NodeValue*>(s_minCapacity, nullptr).swap(d_nodes);
+    std::vector<uint32_t>(s_minCapacity, 0).swap(d_hashes);
+    d_size = 0;
+  }
+
+ private:
+  static const size_t s_minCapacity = 64;
+
+  size_t mask() const { return d_nodes.size() - 1; }
+
+  /**
+   * The home slot of hash h. The pool hashes of NodeValues are not well
+   * distributed in their low bits, so they are mixed first.
+   */
+  size_t index(uint32_t h) const
+  {
+    return static_cast<size_t>((h * UINT64_C(0x9e3779b97f4a7c15)) >> 32)
+           & mask();
+  }
+
+  /** Put nv with hash h into the first free slot of its probe sequence. */
+  void place(NodeValue* nv, uint32_t h)
+  {
+    size_t i = index(h);
+    while (d_nodes[i] != nullptr)
+    {
+      i = (i + 1) & mask();
+    }
+    d_nodes[i] = nv;
+    d_hashes[i] = h;
+  }
+
+  void rehash(size_t capacity)
+  {
+    std::vector<NodeValue*> nodes(capacity, nullptr);
+    std::vector<uint32_t> hashes(capacity, 0);
+    nodes.swap(d_nodes);
+    hashes.swap(d_hashes);
+    for (size_t i = 0, size = nodes.size(); i < size; ++i)
+    {
+      if (nodes[i] != nullptr)
+      {
+        place(nodes[i], hashes[i]);
+      }
+    }
+  }
+
+  /**
+   * The table, empty slots are null. Its size is a power of two. The hash of
+   * d_nodes[i] is d_hashes[i].
+   */
+  std::vector<NodeValue*> d_nodes;
+  std::vector<uint32_t> d_hashes;
+  /** The number of elements. */
+  size_t d_size;
+}; /* class NodeValueHashSet */
+
+}  // namespace expr
+}  // namespace CVC4
+
+#endif /* CVC4__EXPR__NODE_VALUE_HASH_SET_H */
@@ -20,21 +20,18 @@
 
 #include <ostream>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
-#include "context/cdhashmap.h"
-#include "context/cdhashset.h"
-#include "context/context.h"
+#include "base/check.h"
 #include "expr/expr.h"
 #include "expr/expr_manager_scope.h"
 #include "expr/type.h"
 
 namespace CVC4 {
 
-using ::CVC4::context::CDHashMap;
-using ::CVC4::context::CDHashSet;
-using ::CVC4::context::Context;
 using ::std::copy;
 using ::std::endl;
 using ::std::ostream_iterator;
@@ -42,11 +39,121 @@ using ::std::pair;
 using ::std::string;
 using ::std::vector;
 
+/**
+ * A hash map with nested scopes. The bindings are stored in a single hash
+ * map, and each binding made in a scope is recorded in an undo log together
+ * with the binding it replaced. Popping a scope replays its part of the log
+ * backwards.
+ *
+ * Unlike a CDHashMap over a private context, a binding costs one entry in the
+ * log and no context object, and popping a scope only visits the bindings
+ * made in that scope.
+ */
+template <class Key, class Data, class HashFcn = std::hash<Key>>
+class ScopedHashMap
+{
+ public:
+  using const_iterator =
+      typename std::unordered_map<Key, Data, HashFcn>::const_iterator;
+
+  const_iterator find(const Key& k) const { return d_map.find(k); }
+  const_iterator end() const { return d_map.end(); }
+  bool contains(const Key& k) const { return d_map.find(k) != d_map.end(); }
+
+  /**
+   * Bind k to d in the current scope. The previous binding of k, if any, is
+   * restored when the current scope is popped.
+   */
+  void insert(const Key& k, const Data& d)
+  {
+    typename std::unordered_map<Key, Data, HashFcn>::iterator it =
+        d_map.find(k);
+    if (it == d_map.end())
+    {
+      if (!d_scopes.empty())
+      {
+        d_log.emplace_back(k, false, Data());
+      }
+      d_map.emplace(k, d);
+    }
+    else
+    {
+      if (!d_scopes.empty())
+      {
+        d_log.emplace_back(k, true, it->second);
+      }
+      it->second = d;
+    }
+  }
+
+  /**
+   * Bind k to d at level zero, i.e. the binding survives all the scopes that
+   * are currently pushed. If k is bound in one of these scopes, that binding
+   * is kept until the scope is popped, and d is restored afterwards.
+   */
+  void insertAtLevelZero(const Key& k, const Data& d)
+  {
+    typename std::unordered_map<Key, Data, HashFcn>::iterator it =
+        d_map.find(k);
+    if (it == d_map.end())
+    {
+      // k is not in the log either
+      d_map.emplace(k, d);
+      return;
+    }
+    // the first entry of k in the log holds its binding at level zero
+    for (LogEntry& e : d_log)
+    {
+      if (std::get<0>(e) == k)
+      {
+        std::get<1>(e) = true;
+        std::get<2>(e) = d;
+        return;
+      }
+    }
+    it->second = d;
+  }
+
+  void pushScope() { d_scopes.push_back(d_log.size()); }
+
+  void popScope()
+  {
+    Assert(!d_scopes.empty());
+    size_t start = d_scopes.back();
+    d_scopes.pop_back();
+    while (d_log.size() > start)
+    {
+      LogEntry& e = d_log.back();
+      if (std::get<1>(e))
+      {
+        d_map[std::get<0>(e)] = std::get<2>(e);
+      }
+      else
+      {
+        d_map.erase(std::get<0>(e));
+      }
+      d_log.pop_back();
+    }
+  }
+
+  size_t getLevel() const { return d_scopes.size(); }
+
+ private:
+  /** A key, whether it was bound, and the data it was bound to */
+  using LogEntry = std::tuple<Key, bool, Data>;
+  /** The current bindings */
+  std::unordered_map<Key, Data, HashFcn> d_map;
+  /** The bindings replaced in the pushed scopes, in order */
+  std::vector<LogEntry> d_log;
+  /** The size of d_log when each of the pushed scopes was entered */
+  std::vector<size_t> d_scopes;
+}; /* class ScopedHashMap */
+
 /** Overloaded type trie.
  *
  * This data structure stores a trie of expressions with
  * the same name, and must be distinguished by their argument types.
- * It is context-dependent.
+ * The set of active symbols is scoped.
  *
  * Using the argument allowFunVariants,
  * it may either be configured to allow function variants or not,
@@ -93,12 +200,14 @@ using ::std::vector;
  */
 class OverloadedTypeTrie {
  public:
-  OverloadedTypeTrie(Context* c, bool allowFunVariants = false)
-      : d_overloaded_symbols(new (true) CDHashSet<Expr, ExprHashFunction>(c)),
-        d_allowFunctionVariants(allowFunVariants)
+  OverloadedTypeTrie(bool allowFunVariants = false)
+      : d_allowFunctionVariants(allowFunVariants)
   {
   }
-  ~OverloadedTypeTrie() { d_overloaded_symbols->deleteSelf(); }
+
+  /** push and pop the scope of the overloaded symbols */
+  void pushScope() { d_overloaded_symbols.pushScope(); }
+  void popScope() { d_overloaded_symbols.popScope(); }
 
   /** is this function overloaded? */
   bool isOverloadedFunction(Expr fun) const;
@@ -140,9 +249,9 @@ class OverloadedTypeTrie {
   bool markOverloaded(const string& name, Expr obj);
   /** the null expression */
   Expr d_nullExpr;
-  // The (context-independent) trie storing that maps expected argument
+  // The (unscoped) trie storing that maps expected argument
   // vectors to symbols. All expressions stored in d_symbols are only
-  // interpreted as active if they also appear in the context-dependent
+  // interpreted as active if they also appear in the scoped
   // set d_overloaded_symbols.
   class TypeArgTrie {
    public:
@@ -155,7 +264,7 @@ class OverloadedTypeTrie {
    * above. */
   std::unordered_map<std::string, TypeArgTrie> d_overload_type_arg_trie;
   /** The set of overloaded symbols. */
-  CDHashSet<Expr, ExprHashFunction>* d_overloaded_symbols;
+  ScopedHashMap<Expr, bool, ExprHashFunction> d_overloaded_symbols;
   /** allow function variants
    * This is true if we allow overloading (non-constant) functions that expect
    * the same argument types.
@@ -171,7 +280,7 @@ class OverloadedTypeTrie {
 };
 
 bool OverloadedTypeTrie::isOverloadedFunction(Expr fun) const {
-  return d_overloaded_symbols->find(fun) != d_overloaded_symbols->end();
+  return d_overloaded_symbols.contains(fun);
 }
 
 Expr OverloadedTypeTrie::getOverloadedConstantForType(const std::string& name,
@@ -302,7 +411,10 @@ bool OverloadedTypeTrie::markOverloaded(const string& name, Expr obj) {
   }
 
   // otherwise, update the symbols
-  d_overloaded_symbols->insert(obj);
+  if (!d_overloaded_symbols.contains(obj))
+  {
+    d_overloaded_symbols.insert(obj, true);
+  }
   tat->d_symbols[rangeType] = obj;
   return true;
 }
@@ -341,19 +453,9 @@ Expr OverloadedTypeTrie::getOverloadedFunctionAt(
 
 class SymbolTable::Implementation {
  public:
-  Implementation()
-      : d_context(),
-        d_exprMap(new (true) CDHashMap<string, Expr>(&d_context)),
-        d_typeMap(new (true) TypeMap(&d_context))
-  {
-    d_overload_trie = new OverloadedTypeTrie(&d_context);
-  }
+  Implementation() : d_overload_trie(new OverloadedTypeTrie()) {}
 
-  ~Implementation() {
-    d_exprMap->deleteSelf();
-    d_typeMap->deleteSelf();
-    delete d_overload_trie;
-  }
+  ~Implementation() { delete d_overload_trie; }
 
   bool bind(const string& name, Expr obj, bool levelZero, bool doOverload);
   void bindType(const string& name, Type t, bool levelZero = false);
@@ -381,15 +483,12 @@ class SymbolTable::Implementation {
                                      const std::vector<Type>& argTypes) const;
   //------------------------ end operator overloading
  private:
-  /** The context manager for the scope maps. */
-  Context d_context;
-
   /** A map for expressions. */
-  CDHashMap<string, Expr>* d_exprMap;
+  ScopedHashMap<string, Expr> d_exprMap;
 
   /** A map for types. */
-  using TypeMap = CDHashMap<string, std::pair<vector<Type>, Type>>;
-  TypeMap* d_typeMap;
+  using TypeMap = ScopedHashMap<string, std::pair<vector<Type>, Type>>;
+  TypeMap d_typeMap;
 
   //------------------------ operator overloading
   // the null expression
@@ -415,20 +514,20 @@ bool SymbolTable::Implementation::bind(const string& name, Expr obj,
     }
   }
   if (levelZero) {
-    d_exprMap->insertAtContextLevelZero(name, obj);
+    d_exprMap.insertAtLevelZero(name, obj);
   } else {
-    d_exprMap->insert(name, obj);
+    d_exprMap.insert(name, obj);
   }
   return true;
 }
 
 bool SymbolTable::Implementation::isBound(const string& name) const {
-  return d_exprMap->find(name) != d_exprMap->end();
+  return d_exprMap.contains(name);
 }
 
 Expr SymbolTable::Implementation::lookup(const string& name) const {
   Assert(isBound(name));
-  Expr expr = (*d_exprMap->find(name)).second;
+  Expr expr = d_exprMap.find(name)->second;
   if (isOverloadedFunction(expr)) {
     return d_nullExpr;
   } else {
@@ -439,9 +538,9 @@ Expr SymbolTable::Implementation::lookup(const string& name) const {
 void SymbolTable::Implementation::bindType(const string& name, Type t,
                                            bool levelZero) {
   if (levelZero) {
-    d_typeMap->insertAtContextLevelZero(name, make_pair(vector<Type>(), t));
+    d_typeMap.insertAtLevelZero(name, make_pair(vector<Type>(), t));
   } else {
-    d_typeMap->insert(name, make_pair(vector<Type>(), t));
+    d_typeMap.insert(name, make_pair(vector<Type>(), t));
   }
 }
 
@@ -458,18 +557,18 @@ void SymbolTable::Implementation::bindType(const string& name,
     Debug("sort") << "], " << t << ")" << endl;
   }
   if (levelZero) {
-    d_typeMap->insertAtContextLevelZero(name, make_pair(params, t));
+    d_typeMap.insertAtLevelZero(name, make_pair(params, t));
   } else {
-    d_typeMap->insert(name, make_pair(params, t));
+    d_typeMap.insert(name, make_pair(params, t));
   }
 }
 
 bool SymbolTable::Implementation::isBoundType(const string& name) const {
-  return d_typeMap->find(name) != d_typeMap->end();
+  return d_typeMap.contains(name);
 }
 
 Type SymbolTable::Implementation::lookupType(const string& name) const {
-  pair<vector<Type>, Type> p = (*d_typeMap->find(name)).second;
+  pair<vector<Type>, Type> p = d_typeMap.find(name)->second;
   PrettyCheckArgument(p.first.size() == 0, name,
                       "type constructor arity is wrong: "
                       "`%s' requires %u parameters but was provided 0",
@@ -479,7 +578,7 @@ Type SymbolTable::Implementation::lookupType(const string& name) const {
 
 Type SymbolTable::Implementation::lookupType(const string& name,
                                              const vector<Type>& params) const {
-  pair<vector<Type>, Type> p = (*d_typeMap->find(name)).second;
+  pair<vector<Type>, Type> p = d_typeMap.find(name)->second;
   PrettyCheckArgument(p.first.size() == params.size(), params,
                       "type constructor arity is wrong: "
                       "`%s' requires %u parameters but was provided %u",
@@ -534,21 +633,27 @@ Type SymbolTable::Implementation::lookupType(const string& name,
 }
 
 size_t SymbolTable::Implementation::lookupArity(const string& name) {
-  pair<vector<Type>, Type> p = (*d_typeMap->find(name)).second;
+  pair<vector<Type>, Type> p = d_typeMap.find(name)->second;
   return p.first.size();
 }
 
 void SymbolTable::Implementation::popScope() {
-  if (d_context.getLevel() == 0) {
+  if (d_exprMap.getLevel() == 0) {
     throw ScopeException();
   }
-  d_context.pop();
+  d_exprMap.popScope();
+  d_typeMap.popScope();
+  d_overload_trie->popScope();
 }
 
-void SymbolTable::Implementation::pushScope() { d_context.push(); }
+void SymbolTable::Implementation::pushScope() {
+  d_exprMap.pushScope();
+  d_typeMap.pushScope();
+  d_overload_trie->pushScope();
+}
 
 size_t SymbolTable::Implementation::getLevel() const {
-  return d_context.getLevel();
+  return d_exprMap.getLevel();
 }
 
 void SymbolTable::Implementation::reset() {
@@ -572,9 +677,9 @@ Expr SymbolTable::Implementation::getOverloadedFunctionForTypes(
 
 bool SymbolTable::Implementation::bindWithOverloading(const string& name,
                                                       Expr obj) {
-  CDHashMap<string, Expr>::const_iterator it = d_exprMap->find(name);
-  if (it != d_exprMap->end()) {
-    const Expr& prev_bound_obj = (*it).second;
+  ScopedHashMap<string, Expr>::const_iterator it = d_exprMap.find(name);
+  if (it != d_exprMap.end()) {
+    const Expr& prev_bound_obj = it->second;
     if (prev_bound_obj != obj) {
       return d_overload_trie->bind(name, prev_bound_obj, obj);
     }
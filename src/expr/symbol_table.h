@@ -50,7 +50,9 @@ class CVC4_PUBLIC SymbolTable {
    * level, then the binding is replaced. If <code>name</code> is bound
    * in a previous level, then the binding is "covered" by this one
    * until the current scope is popped.
-   * If levelZero is true the name shouldn't be already bound.
+   * If levelZero is true and <code>name</code> is bound in a scope that is
+   * not yet popped, then that binding covers this one until the scope is
+   * popped.
    *
    * When doOverload is true:
    * if <code>name</code> is already bound to an expression in the current
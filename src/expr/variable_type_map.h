@@ -48,6 +48,14 @@ public:
   Expr& operator[](Expr e) { return d_variables[e]; }
   Type& operator[](Type t) { return d_types[t]; }
 
+  /** Get the image of e, or the null expression if e is not mapped. */
+  Expr find(Expr e) const
+  {
+    std::unordered_map<Expr, Expr, ExprHashFunction>::const_iterator it =
+        d_variables.find(e);
+    return it == d_variables.end() ? Expr() : it->second;
+  }
+
 };/* class VariableTypeMap */
 
 typedef std::unordered_map<uint64_t, uint64_t> VarMap;
@@ -54,17 +54,35 @@ CommandExecutor::CommandExecutor(api::Solver* solver, Options& options)
       d_smtEngine(d_solver->getSmtEngine()),
       d_options(options),
       d_stats("driver"),
+      d_executeTime("executeTime"),
       d_result(),
       d_replayStream(NULL)
-{}
+{
+  d_stats.registerStat(&d_executeTime);
+}
 
 void CommandExecutor::flushStatistics(std::ostream& out) const
 {
+  if (d_options.getStatsJson())
+  {
+    flushStatisticsJson(out, {});
+    return;
+  }
   d_solver->getExprManager()->getStatistics().flushInformation(out);
   d_smtEngine->getStatistics().flushInformation(out);
   d_stats.flushInformation(out);
 }
 
+void CommandExecutor::flushStatisticsJson(
+    std::ostream& out, std::vector<const StatisticsBase*> extra) const
+{
+  Statistics emStats = d_solver->getExprManager()->getStatistics();
+  Statistics smtStats = d_smtEngine->getStatistics();
+  extra.insert(extra.begin(), {&emStats, &smtStats, &d_stats});
+  StatisticsBase::flushInformationJson(out, extra);
+  out << std::endl;
+}
+
 void CommandExecutor::safeFlushStatistics(int fd) const
 {
   d_solver->getExprManager()->safeFlushStatistics(fd);
@@ -83,6 +101,8 @@ bool CommandExecutor::doCommand(Command* cmd)
   if( d_options.getParseOnly() ) {
     return true;
   }
+  // reentrant, since command sequences are executed recursively
+  TimerStat::CodeTimer executeTimer(d_executeTime, true);
 
   CommandSequence *seq = dynamic_cast<CommandSequence*>(cmd);
   if(seq != NULL) {
@@ -123,12 +143,21 @@ bool CommandExecutor::doCommandSingleton(Command* cmd)
   } else {
     status = smtEngineInvoke(d_smtEngine, cmd, NULL);
   }
+  return processResult(cmd, status);
+}
 
+bool CommandExecutor::processResult(Command* cmd, bool status)
+{
   Result res;
   CheckSatCommand* cs = dynamic_cast<CheckSatCommand*>(cmd);
   if(cs != NULL) {
     d_result = res = cs->getResult();
   }
+  CheckSatAssumingCommand* csa = dynamic_cast<CheckSatAssumingCommand*>(cmd);
+  if (csa != NULL)
+  {
+    d_result = res = csa->getResult();
+  }
   QueryCommand* q = dynamic_cast<QueryCommand*>(cmd);
   if(q != NULL) {
     d_result = res = q->getResult();
@@ -138,7 +167,22 @@ bool CommandExecutor::doCommandSingleton(Command* cmd)
     d_result = res = csy->getResult();
   }
 
-  if((cs != NULL || q != NULL) && d_options.getStatsEveryQuery()) {
+  if ((cs != NULL || q != NULL) && d_options.getStatsEveryQuery()
+      && d_options.getStatsJson())
+  {
+    std::ostream& err = *d_options.getErr();
+    try
+    {
+      getAnsweringSmtEngine()->getStatisticsDelta().flushInformationJson(err);
+      err << std::endl;
+    }
+    catch (const ModalException&)
+    {
+      // no query was made yet, since the first query failed
+    }
+  }
+  else if ((cs != NULL || q != NULL) && d_options.getStatsEveryQuery())
+  {
     std::ostringstream ossCurStats;
     flushStatistics(ossCurStats);
     std::ostream& err = *d_options.getErr();
@@ -192,6 +236,20 @@ bool CommandExecutor::doCommandSingleton(Command* cmd)
         }
       }
     }
+
+    if (status && d_options.getDumpMuses() > 0
+        && res.asSatisfiabilityResult() == Result::UNSAT)
+    {
+      // in portfolio mode, only the engine that answered can enumerate them
+      SmtEngine* smt = getAnsweringSmtEngine();
+      std::vector<Expr> mus;
+      for (unsigned i = 0, n = d_options.getDumpMuses();
+           i < n && smt->getNextMus(mus);
+           ++i)
+      {
+        UnsatCore(smt, mus).toStream(*d_options.getOut());
+      }
+    }
   }
   return status;
 }
@@ -203,13 +261,14 @@ bool smtEngineInvoke(SmtEngine* smt, Command* cmd, std::ostream *out)
   } else {
     cmd->invoke(smt, *out);
   }
+  if (!cmd->fail())
+  {
+    return true;
+  }
   // ignore the error if the command-verbosity is 0 for this command
   std::string commandName =
       std::string("command-verbosity:") + cmd->getCommandName();
-  if(smt->getOption(commandName).getIntegerValue() == 0) {
-    return true;
-  }
-  return !cmd->fail();
+  return smt->getOption(commandName).getIntegerValue() == 0;
 }
 
 void printStatsIncremental(std::ostream& out,
@@ -306,7 +365,8 @@ void CommandExecutor::printStatsFilterZeros(std::ostream& out,
 
 void CommandExecutor::flushOutputStreams() {
   if(d_options.getStatistics()) {
-    if(d_options.getStatsHideZeros() == false) {
+    if (d_options.getStatsHideZeros() == false || d_options.getStatsJson())
+    {
       flushStatistics(*(d_options.getErr()));
     } else {
       std::ostringstream ossStats;
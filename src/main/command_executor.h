@@ -41,6 +41,8 @@ protected:
  SmtEngine* d_smtEngine;
  Options& d_options;
  StatisticsRegistry d_stats;
+ /** Time spent executing commands, see doCommand */
+ TimerStat d_executeTime;
  Result d_result;
  ExprStream* d_replayStream;
 
@@ -49,6 +51,7 @@ public:
 
  virtual ~CommandExecutor()
  {
+   d_stats.unregisterStat(&d_executeTime);
    if (d_replayStream != NULL)
    {
      delete d_replayStream;
@@ -94,6 +97,27 @@ protected:
   /** Executes treating cmd as a singleton */
   virtual bool doCommandSingleton(CVC4::Command* cmd);
 
+  /**
+   * Get the SmtEngine that answered the last check-sat, query or check-synth
+   * command, it has the model, proof, etc. of the last result.
+   */
+  virtual SmtEngine* getAnsweringSmtEngine() const { return d_smtEngine; }
+
+  /**
+   * Flushes the statistics, and the given additional statistics, to out as a
+   * single JSON object on its own line.
+   */
+  void flushStatisticsJson(
+      std::ostream& out, std::vector<const StatisticsBase*> extra) const;
+
+  /**
+   * Records the result of cmd (if it is a check-sat, query or check-synth
+   * command), prints statistics if requested and issues the getter commands
+   * for dumping models, proofs, etc. Returns the overall status, which is
+   * status conjoined with the status of the getter commands.
+   */
+  bool processResult(CVC4::Command* cmd, bool status);
+
 private:
   CommandExecutor();
 
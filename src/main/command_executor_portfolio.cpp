@@ -0,0 +1,921 @@
+/*********************                                                        */
+/*! \file command_executor_portfolio.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief An additional layer between commands and invoking them in
+ ** portfolio mode.
+ **/
+
+#include "main/command_executor_portfolio.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "api/cvc4cpp.h"
+#include "main/main.h"
+#include "options/set_language.h"
+#include "smt/command.h"
+#include "util/integer.h"
+#include "util/rational.h"
+
+namespace CVC4 {
+namespace main {
+
+namespace {
+
+/**
+ * The options that are set on the SmtEngine of thread i > 0 to diversify
+ * the portfolio. Thread i uses entry (i - 1) modulo the number of entries,
+ * and additionally a SAT solver seed that is unique to the thread.
+ */
+const char* const s_portfolioConfigs[][2] = {
+    {"decision-mode", "justification"},
+    {"simplification-mode", "none"},
+    {"random-frequency", "0.02"},
+    {"decision-mode", "justification-stoponly"},
+};
+
+const size_t s_numPortfolioConfigs =
+    sizeof(s_portfolioConfigs) / sizeof(s_portfolioConfigs[0]);
+
+/** Is cmd a command that is run concurrently on all threads? */
+bool isCheckCommand(Command* cmd)
+{
+  return dynamic_cast<CheckSatCommand*>(cmd) != nullptr
+         || dynamic_cast<CheckSatAssumingCommand*>(cmd) != nullptr
+         || dynamic_cast<QueryCommand*>(cmd) != nullptr;
+}
+
+/**
+ * Is cmd a command that refers to the answer of the last check-sat command
+ * and must hence be run by the thread that answered it?
+ */
+bool isGetterCommand(Command* cmd)
+{
+  return dynamic_cast<GetValueCommand*>(cmd) != nullptr
+         || dynamic_cast<GetAssignmentCommand*>(cmd) != nullptr
+         || dynamic_cast<GetModelCommand*>(cmd) != nullptr
+         || dynamic_cast<GetProofCommand*>(cmd) != nullptr
+         || dynamic_cast<GetInstantiationsCommand*>(cmd) != nullptr
+         || dynamic_cast<GetUnsatAssumptionsCommand*>(cmd) != nullptr
+         || dynamic_cast<GetUnsatCoreCommand*>(cmd) != nullptr;
+}
+
+/** Get the result of a check command cmd (see isCheckCommand). */
+Result getCheckResult(Command* cmd)
+{
+  CheckSatCommand* cs = dynamic_cast<CheckSatCommand*>(cmd);
+  if (cs != nullptr)
+  {
+    return cs->getResult();
+  }
+  CheckSatAssumingCommand* csa = dynamic_cast<CheckSatAssumingCommand*>(cmd);
+  if (csa != nullptr)
+  {
+    return csa->getResult();
+  }
+  QueryCommand* q = dynamic_cast<QueryCommand*>(cmd);
+  if (q != nullptr)
+  {
+    return q->getResult();
+  }
+  return Result();
+}
+
+/** Is e a Boolean connective whose children are formulas? */
+bool isBooleanConnective(const Expr& e)
+{
+  switch (e.getKind())
+  {
+    case kind::NOT:
+    case kind::AND:
+    case kind::OR:
+    case kind::IMPLIES:
+    case kind::XOR: return true;
+    case kind::EQUAL:
+    case kind::ITE: return e[1].getType().isBoolean();
+    default: return false;
+  }
+}
+
+/** Is e an arithmetic comparison? */
+bool isArithAtom(const Expr& e)
+{
+  switch (e.getKind())
+  {
+    case kind::LT:
+    case kind::LEQ:
+    case kind::GT:
+    case kind::GEQ: return true;
+    case kind::EQUAL: return e[0].getType().isReal();
+    default: return false;
+  }
+}
+
+/** The integer bounds of a variable, if it has them. */
+struct IntBounds
+{
+  bool d_hasLower = false;
+  bool d_hasUpper = false;
+  Integer d_lower;
+  Integer d_upper;
+
+  void addLower(const Integer& c)
+  {
+    if (!d_hasLower || d_lower < c)
+    {
+      d_lower = c;
+    }
+    d_hasLower = true;
+  }
+
+  void addUpper(const Integer& c)
+  {
+    if (!d_hasUpper || c < d_upper)
+    {
+      d_upper = c;
+    }
+    d_hasUpper = true;
+  }
+};
+
+/**
+ * If the asserted atom compares an integer variable with a constant, add
+ * the bound it gives to bounds.
+ */
+void addBound(const Expr& atom,
+              std::unordered_map<Expr, IntBounds, ExprHashFunction>& bounds)
+{
+  if (!isArithAtom(atom))
+  {
+    return;
+  }
+  Kind k = atom.getKind();
+  Expr x = atom[0];
+  Expr c = atom[1];
+  if (!x.isVariable())
+  {
+    // c k x is x k' c with the comparison turned around
+    std::swap(x, c);
+    k = k == kind::LT ? kind::GT
+                      : k == kind::GT ? kind::LT
+                                      : k == kind::LEQ
+                                            ? kind::GEQ
+                                            : k == kind::GEQ ? kind::LEQ : k;
+  }
+  if (!x.isVariable() || !x.getType().isInteger()
+      || c.getKind() != kind::CONST_RATIONAL)
+  {
+    return;
+  }
+  const Rational& r = c.getConst<Rational>();
+  IntBounds& b = bounds[x];
+  switch (k)
+  {
+    case kind::LT: b.addUpper(r.ceiling() - 1); break;
+    case kind::LEQ: b.addUpper(r.floor()); break;
+    case kind::GT: b.addLower(r.floor() + 1); break;
+    case kind::GEQ: b.addLower(r.ceiling()); break;
+    case kind::EQUAL:
+      b.addLower(r.ceiling());
+      b.addUpper(r.floor());
+      break;
+    default: break;
+  }
+}
+
+}  // namespace
+
+CommandExecutorPortfolio::CommandExecutorPortfolio(api::Solver* solver,
+                                                   Options& options)
+    : CommandExecutor(solver, options),
+      d_assertions(1),
+      d_mainInSync(true),
+      d_lastWinner(0),
+      d_stop(false)
+{
+  size_t numThreads = options.getThreads();
+  assert(numThreads > 1);
+  uint64_t seed =
+      d_smtEngine->getOption("random-seed").getIntegerValue().getUnsignedLong();
+  for (size_t i = 1; i < numThreads; ++i)
+  {
+    Options opts;
+    opts.copyValues(options);
+    d_workers.emplace_back(new api::Solver(&opts));
+    d_vmaps.emplace_back(new ExprManagerMapCollection());
+
+    SmtEngine* smt = d_workers.back()->getSmtEngine();
+    const char* const* config =
+        s_portfolioConfigs[(i - 1) % s_numPortfolioConfigs];
+    smt->setOption(config[0], SExpr(std::string(config[1])));
+    std::stringstream ss;
+    ss << (seed + i);
+    smt->setOption("random-seed", SExpr(ss.str()));
+  }
+  d_active.resize(numThreads, true);
+  d_wins.resize(numThreads, 0);
+
+  if (options.getShareLemmas())
+  {
+    std::vector<ExprManager*> ems;
+    ems.push_back(d_solver->getExprManager());
+    for (const std::unique_ptr<api::Solver>& w : d_workers)
+    {
+      ems.push_back(w->getExprManager());
+    }
+    d_exchange.reset(new LemmaExchange(ems, options));
+  }
+}
+
+CommandExecutorPortfolio::~CommandExecutorPortfolio()
+{
+  // The variable maps and the lemma exchange refer to expressions of the
+  // worker's ExprManagers.
+  d_exchange.reset();
+  d_vmaps.clear();
+  d_workers.clear();
+}
+
+SmtEngine* CommandExecutorPortfolio::getSmtEngine(size_t i) const
+{
+  assert(i < getNumThreads());
+  return i == 0 ? d_smtEngine : d_workers[i - 1]->getSmtEngine();
+}
+
+SmtEngine* CommandExecutorPortfolio::getAnsweringSmtEngine() const
+{
+  return getSmtEngine(d_lastWinner);
+}
+
+Command* CommandExecutorPortfolio::getCommandForThread(Command* cmd, size_t i)
+{
+  if (i == 0)
+  {
+    return cmd->clone();
+  }
+  return cmd->exportTo(d_workers[i - 1]->getExprManager(), *d_vmaps[i - 1]);
+}
+
+void CommandExecutorPortfolio::deactivate(size_t i, const std::string& reason)
+{
+  assert(i > 0 && d_active[i]);
+  if (d_options.getVerbosity() > 0)
+  {
+    *d_options.getErr() << "portfolio: disabling thread " << i << ": "
+                        << reason << std::endl;
+  }
+  d_active[i] = false;
+}
+
+void CommandExecutorPortfolio::setLemmaChannels(const std::vector<bool>& run,
+                                                bool enable)
+{
+  for (size_t i = 0, n = getNumThreads(); i < n; ++i)
+  {
+    if (run[i])
+    {
+      LemmaChannels* channels = getSmtEngine(i)->channels();
+      channels->setLemmaInputChannel(
+          enable ? d_exchange->getInputChannel(i) : nullptr);
+      channels->setLemmaOutputChannel(
+          enable ? d_exchange->getOutputChannel(i) : nullptr);
+    }
+  }
+}
+
+void CommandExecutorPortfolio::flushStatistics(std::ostream& out) const
+{
+  if (d_options.getStatsJson())
+  {
+    StatisticsRegistry portfolio("portfolio");
+    std::vector<std::unique_ptr<IntStat>> stats;
+    for (size_t i = 0, n = getNumThreads(); i < n; ++i)
+    {
+      std::string prefix = "thread" + std::to_string(i) + "::";
+      stats.emplace_back(new IntStat(prefix + "wins", d_wins[i]));
+      if (d_exchange != nullptr)
+      {
+        stats.emplace_back(new IntStat(prefix + "lemmasExported",
+                                       d_exchange->getNumExported(i)));
+        stats.emplace_back(new IntStat(prefix + "lemmasImported",
+                                       d_exchange->getNumImported(i)));
+      }
+    }
+    for (const std::unique_ptr<IntStat>& s : stats)
+    {
+      portfolio.registerStat(s.get());
+    }
+    flushStatisticsJson(out, {&portfolio});
+    return;
+  }
+  CommandExecutor::flushStatistics(out);
+  for (size_t i = 0, n = getNumThreads(); i < n; ++i)
+  {
+    out << "portfolio::thread" << i << "::wins, " << d_wins[i] << std::endl;
+    if (d_exchange != nullptr)
+    {
+      out << "portfolio::thread" << i << "::lemmasExported, "
+          << d_exchange->getNumExported(i) << std::endl;
+      out << "portfolio::thread" << i << "::lemmasImported, "
+          << d_exchange->getNumImported(i) << std::endl;
+    }
+  }
+}
+
+bool CommandExecutorPortfolio::doCommandSingleton(Command* cmd)
+{
+  if (isCheckCommand(cmd))
+  {
+    if (d_options.getCubeDepth() > 0 && d_mainInSync
+        && dynamic_cast<CheckSatCommand*>(cmd) != nullptr
+        && static_cast<CheckSatCommand*>(cmd)->getExpr().isNull())
+    {
+      return doCubeAndConquer(cmd);
+    }
+    return doCheckInParallel(cmd);
+  }
+
+  if (d_options.getCubeDepth() > 0)
+  {
+    // keep track of the assertions for choosing the cube atoms
+    if (dynamic_cast<AssertCommand*>(cmd) != nullptr)
+    {
+      d_assertions.back().push_back(
+          static_cast<AssertCommand*>(cmd)->getExpr());
+    }
+    else if (dynamic_cast<PushCommand*>(cmd) != nullptr)
+    {
+      d_assertions.emplace_back();
+    }
+    else if (dynamic_cast<PopCommand*>(cmd) != nullptr)
+    {
+      if (d_assertions.size() > 1)
+      {
+        d_assertions.pop_back();
+      }
+    }
+    else if (dynamic_cast<ResetCommand*>(cmd) != nullptr
+             || dynamic_cast<ResetAssertionsCommand*>(cmd) != nullptr)
+    {
+      d_assertions.clear();
+      d_assertions.emplace_back();
+    }
+  }
+
+  bool isBlock = dynamic_cast<BlockModelCommand*>(cmd) != nullptr
+                 || dynamic_cast<BlockModelValuesCommand*>(cmd) != nullptr;
+  if ((isGetterCommand(cmd) || isBlock) && d_lastWinner != 0)
+  {
+    // only the thread that answered the last check has a model, proof, etc.
+    std::unique_ptr<Command> c(getCommandForThread(cmd, d_lastWinner));
+    bool status = smtEngineInvoke(
+        getSmtEngine(d_lastWinner),
+        c.get(),
+        d_options.getVerbosity() >= -1 ? d_options.getOut() : nullptr);
+    if (isBlock)
+    {
+      // A blocking constraint can only be added by the winner, all other
+      // threads (including the main one) continue without it and are hence
+      // out of sync. We continue sequentially on the winner.
+      for (size_t i = 1, n = getNumThreads(); i < n; ++i)
+      {
+        if (i != d_lastWinner && d_active[i])
+        {
+          deactivate(i, "blocking models is not supported in parallel");
+        }
+      }
+      d_mainInSync = false;
+    }
+    return status;
+  }
+
+  bool status = true;
+  if (d_mainInSync)
+  {
+    status = CommandExecutor::doCommandSingleton(cmd);
+  }
+  if (isBlock)
+  {
+    for (size_t i = 1, n = getNumThreads(); i < n; ++i)
+    {
+      if (d_active[i])
+      {
+        deactivate(i, "blocking models is not supported in parallel");
+      }
+    }
+    return status;
+  }
+  for (size_t i = 1, n = getNumThreads(); i < n; ++i)
+  {
+    if (!d_active[i])
+    {
+      continue;
+    }
+    std::unique_ptr<Command> c;
+    try
+    {
+      c.reset(getCommandForThread(cmd, i));
+    }
+    catch (ExportUnsupportedException& e)
+    {
+      if (!d_mainInSync && i == d_lastWinner)
+      {
+        throw;
+      }
+      deactivate(i, e.getMessage());
+      continue;
+    }
+    // if the main thread is out of sync, the winner took over its output
+    bool isMain = !d_mainInSync && i == d_lastWinner;
+    std::ostream* out = isMain && d_options.getVerbosity() >= -1
+                            ? d_options.getOut()
+                            : nullptr;
+    bool s = smtEngineInvoke(getSmtEngine(i), c.get(), out);
+    if (isMain)
+    {
+      status = s;
+    }
+  }
+
+  DeclareFunctionCommand* decl = dynamic_cast<DeclareFunctionCommand*>(cmd);
+  if (d_exchange != nullptr && d_mainInSync && decl != nullptr)
+  {
+    // make the declared symbol known to the lemma exchange
+    Expr f = decl->getFunction();
+    std::vector<Expr> vars(1, f);
+    for (size_t i = 1, n = getNumThreads(); i < n; ++i)
+    {
+      vars.push_back(d_active[i] ? d_vmaps[i - 1]->d_typeMap.find(f)
+                                 : Expr());
+    }
+    d_exchange->addSharedVariable(vars);
+  }
+  return status;
+}
+
+size_t CommandExecutorPortfolio::runThreads(
+    const std::vector<bool>& run, const std::function<bool(size_t)>& work)
+{
+  size_t n = getNumThreads();
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<bool> finished(n, true);
+  size_t numRunning = 0;
+  // the thread that reported the first definitive answer, n if none did
+  size_t winner = n;
+  d_stop = false;
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (!run[i])
+    {
+      continue;
+    }
+    finished[i] = false;
+    ++numRunning;
+    threads.emplace_back([&, i]() {
+      bool definitive = work(i);
+      std::lock_guard<std::mutex> lock(mutex);
+      finished[i] = true;
+      --numRunning;
+      if (definitive && winner == n)
+      {
+        winner = i;
+      }
+      cv.notify_all();
+    });
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return winner != n || numRunning == 0; });
+    d_stop = true;
+    // An engine might not have started its search when we interrupt it
+    // the first time, hence we keep interrupting until all have finished.
+    while (numRunning > 0)
+    {
+      for (size_t i = 0; i < n; ++i)
+      {
+        if (!finished[i])
+        {
+          getSmtEngine(i)->interrupt();
+        }
+      }
+      cv.wait_for(lock, std::chrono::milliseconds(10));
+    }
+  }
+  for (std::thread& t : threads)
+  {
+    t.join();
+  }
+  return winner;
+}
+
+bool CommandExecutorPortfolio::doCheckInParallel(Command* cmd)
+{
+  size_t n = getNumThreads();
+  std::vector<std::unique_ptr<Command>> cmds(n);
+  std::vector<std::ostringstream> outs(n);
+  std::vector<char> status(n, false);
+  std::vector<bool> run(n, false);
+  for (size_t i = 0; i < n; ++i)
+  {
+    if ((i == 0 && !d_mainInSync) || (i > 0 && !d_active[i]))
+    {
+      continue;
+    }
+    try
+    {
+      cmds[i].reset(getCommandForThread(cmd, i));
+    }
+    catch (ExportUnsupportedException& e)
+    {
+      if (!d_mainInSync && i == d_lastWinner)
+      {
+        throw;
+      }
+      deactivate(i, e.getMessage());
+      continue;
+    }
+    outs[i] << language::SetLanguage(d_options.getOutputLanguage());
+    run[i] = true;
+  }
+
+  // The lemmas are only valid for the current assertions, hence they are
+  // only exchanged during this check. In cube-and-conquer mode, the threads
+  // solve under different assumptions and thus don't exchange lemmas.
+  if (d_exchange != nullptr)
+  {
+    d_exchange->clear();
+    setLemmaChannels(run, true);
+  }
+  size_t winner = runThreads(run, [&](size_t i) {
+    try
+    {
+      status[i] = smtEngineInvoke(getSmtEngine(i), cmds[i].get(), &outs[i]);
+    }
+    catch (Exception& e)
+    {
+      outs[i] << e << std::endl;
+    }
+    return status[i] && !getCheckResult(cmds[i].get()).isUnknown();
+  });
+  if (d_exchange != nullptr)
+  {
+    setLemmaChannels(run, false);
+    d_exchange->clear();
+  }
+
+  if (winner == n)
+  {
+    // no thread gave a definitive answer, report the main one if possible
+    winner = 0;
+    while (cmds[winner] == nullptr)
+    {
+      ++winner;
+    }
+  }
+  if (d_options.getVerbosity() > 0)
+  {
+    *d_options.getErr() << "portfolio: thread " << winner << " answered"
+                        << std::endl;
+  }
+  ++d_wins[winner];
+  d_lastWinner = winner;
+  if (d_options.getVerbosity() >= -1)
+  {
+    *d_options.getOut() << outs[winner].str() << std::flush;
+  }
+  return processResult(cmds[winner].get(), status[winner]);
+}
+
+std::vector<Expr> CommandExecutorPortfolio::getCubeAtoms(size_t n) const
+{
+  // Count, for each atom (a formula that is not a Boolean connective), the
+  // number of connectives in the current assertions it occurs in. Atoms that
+  // occur in many places are the most constrained and split the search space
+  // best.
+  std::unordered_map<Expr, size_t, ExprHashFunction> count;
+  std::unordered_set<Expr, ExprHashFunction> visited;
+  std::vector<Expr> visit;
+  for (const std::vector<Expr>& level : d_assertions)
+  {
+    visit.insert(visit.end(), level.begin(), level.end());
+  }
+  while (!visit.empty())
+  {
+    Expr cur = visit.back();
+    visit.pop_back();
+    if (!visited.insert(cur).second || !isBooleanConnective(cur))
+    {
+      continue;
+    }
+    for (size_t i = 0, nchildren = cur.getNumChildren(); i < nchildren; ++i)
+    {
+      Expr child = cur[i];
+      if (cur.getKind() == kind::ITE && i == 0)
+      {
+        // the condition of an ITE is a formula even if the ITE is a term
+      }
+      else if (!child.getType().isBoolean())
+      {
+        continue;
+      }
+      if (isBooleanConnective(child))
+      {
+        visit.push_back(child);
+      }
+      else if (!child.isConst() && child.getKind() != kind::FORALL
+               && child.getKind() != kind::EXISTS)
+      {
+        ++count[child];
+      }
+    }
+  }
+
+  std::vector<std::pair<size_t, Expr>> atoms;
+  for (const std::pair<const Expr, size_t>& p : count)
+  {
+    atoms.emplace_back(p.second, p.first);
+  }
+  std::sort(atoms.begin(),
+            atoms.end(),
+            [](const std::pair<size_t, Expr>& a,
+               const std::pair<size_t, Expr>& b) {
+              return a.first > b.first
+                     || (a.first == b.first
+                         && a.second.getId() < b.second.getId());
+            });
+  std::vector<Expr> res;
+  for (size_t i = 0; i < n && i < atoms.size(); ++i)
+  {
+    res.push_back(atoms[i].second);
+  }
+  return res;
+}
+
+std::vector<Expr> CommandExecutorPortfolio::getIntBranchAtoms(size_t n) const
+{
+  // Count, for each integer variable, the number of arithmetic atoms it
+  // occurs in, and collect the bounds of the top-level assertions.
+  std::unordered_map<Expr, size_t, ExprHashFunction> count;
+  std::unordered_map<Expr, IntBounds, ExprHashFunction> bounds;
+  std::unordered_set<Expr, ExprHashFunction> visited;
+  std::vector<Expr> visit;
+  for (const std::vector<Expr>& level : d_assertions)
+  {
+    for (const Expr& a : level)
+    {
+      visit.push_back(a);
+      if (a.getKind() == kind::AND)
+      {
+        for (const Expr& conjunct : a)
+        {
+          addBound(conjunct, bounds);
+        }
+      }
+      else
+      {
+        addBound(a, bounds);
+      }
+    }
+  }
+  std::vector<Expr> atoms;
+  while (!visit.empty())
+  {
+    Expr cur = visit.back();
+    visit.pop_back();
+    if (!visited.insert(cur).second)
+    {
+      continue;
+    }
+    if (isArithAtom(cur))
+    {
+      atoms.push_back(cur);
+    }
+    visit.insert(visit.end(), cur.begin(), cur.end());
+  }
+  for (const Expr& atom : atoms)
+  {
+    // the variables below atom, each counted once
+    std::unordered_set<Expr, ExprHashFunction> seen;
+    std::vector<Expr> terms(atom.begin(), atom.end());
+    while (!terms.empty())
+    {
+      Expr t = terms.back();
+      terms.pop_back();
+      if (!seen.insert(t).second)
+      {
+        continue;
+      }
+      if (t.isVariable())
+      {
+        if (t.getType().isInteger())
+        {
+          ++count[t];
+        }
+      }
+      else if (!isArithAtom(t))
+      {
+        terms.insert(terms.end(), t.begin(), t.end());
+      }
+    }
+  }
+
+  std::vector<std::pair<size_t, Expr>> vars;
+  for (const std::pair<const Expr, size_t>& p : count)
+  {
+    vars.emplace_back(p.second, p.first);
+  }
+  std::sort(vars.begin(),
+            vars.end(),
+            [](const std::pair<size_t, Expr>& a,
+               const std::pair<size_t, Expr>& b) {
+              return a.first > b.first
+                     || (a.first == b.first
+                         && a.second.getId() < b.second.getId());
+            });
+  std::vector<Expr> res;
+  ExprManager* em = d_solver->getExprManager();
+  for (size_t i = 0; res.size() < n && i < vars.size(); ++i)
+  {
+    const Expr& x = vars[i].second;
+    Integer split;
+    std::unordered_map<Expr, IntBounds, ExprHashFunction>::const_iterator it =
+        bounds.find(x);
+    if (it != bounds.end())
+    {
+      const IntBounds& b = it->second;
+      if (b.d_hasLower && b.d_hasUpper)
+      {
+        if (b.d_upper <= b.d_lower)
+        {
+          // x is fixed (or its bounds conflict), branching on it is useless
+          continue;
+        }
+        split = (b.d_lower + b.d_upper).floorDivideQuotient(Integer(2));
+      }
+      else if (b.d_hasLower)
+      {
+        split = b.d_lower;
+      }
+      else if (b.d_hasUpper)
+      {
+        split = b.d_upper - 1;
+      }
+    }
+    res.push_back(em->mkExpr(kind::LEQ, x, em->mkConst(Rational(split))));
+  }
+  return res;
+}
+
+bool CommandExecutorPortfolio::doCubeAndConquer(Command* cmd)
+{
+  size_t n = getNumThreads();
+  std::vector<Expr> atoms;
+  if (d_options.getCubeIntBranches())
+  {
+    atoms = getIntBranchAtoms(d_options.getCubeDepth());
+  }
+  if (atoms.empty())
+  {
+    atoms = getCubeAtoms(d_options.getCubeDepth());
+  }
+  if (atoms.empty())
+  {
+    return doCheckInParallel(cmd);
+  }
+  size_t numCubes = static_cast<size_t>(1) << atoms.size();
+  if (d_options.getVerbosity() > 0)
+  {
+    *d_options.getErr() << "portfolio: splitting into " << numCubes
+                        << " cubes on " << atoms << std::endl;
+  }
+
+  // the cube atoms in the ExprManager of each thread
+  std::vector<std::vector<Expr>> threadAtoms(n);
+  std::vector<bool> run(n, false);
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (i > 0 && !d_active[i])
+    {
+      continue;
+    }
+    try
+    {
+      for (const Expr& a : atoms)
+      {
+        threadAtoms[i].push_back(
+            i == 0 ? a : a.exportTo(d_workers[i - 1]->getExprManager(),
+                                    *d_vmaps[i - 1]));
+      }
+    }
+    catch (ExportUnsupportedException& e)
+    {
+      deactivate(i, e.getMessage());
+      continue;
+    }
+    run[i] = true;
+  }
+
+  // the last check-sat-assuming command of each thread and its output
+  std::vector<std::unique_ptr<Command>> cmds(n);
+  std::vector<std::ostringstream> outs(n);
+  std::vector<char> status(n, true);
+  // whether thread i got an unknown answer for one of its cubes
+  std::vector<char> unknown(n, false);
+  std::atomic<size_t> nextCube(0);
+  size_t winner = runThreads(run, [&](size_t i) {
+    ExprManager* em = i == 0 ? d_solver->getExprManager()
+                             : d_workers[i - 1]->getExprManager();
+    size_t cube;
+    while (!d_stop && (cube = nextCube++) < numCubes)
+    {
+      std::vector<Expr> assumptions;
+      for (size_t j = 0, size = threadAtoms[i].size(); j < size; ++j)
+      {
+        const Expr& a = threadAtoms[i][j];
+        assumptions.push_back(((cube >> j) & 1) ? a
+                                                : em->mkExpr(kind::NOT, a));
+      }
+      std::unique_ptr<Command> c(new CheckSatAssumingCommand(assumptions));
+      std::ostringstream out;
+      out << language::SetLanguage(d_options.getOutputLanguage());
+      bool s = false;
+      try
+      {
+        s = smtEngineInvoke(getSmtEngine(i), c.get(), &out);
+      }
+      catch (Exception& e)
+      {
+        out << e << std::endl;
+      }
+      Result r = getCheckResult(c.get());
+      if (!s || r.isUnknown() || r.isSat() == Result::SAT || !cmds[i])
+      {
+        // remember the first and any non-unsat answer of this thread
+        unknown[i] = unknown[i] || !s || r.isUnknown();
+        status[i] = s;
+        cmds[i] = std::move(c);
+        outs[i].str(out.str());
+      }
+      if (s && r.isSat() == Result::SAT)
+      {
+        return true;
+      }
+    }
+    return false;
+  });
+
+  if (winner == n)
+  {
+    // all cubes are unsat unless some thread got an unknown answer (or was
+    // interrupted), report an answer of such a thread if there is one
+    winner = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+      if (cmds[i] != nullptr && (cmds[winner] == nullptr || unknown[i]))
+      {
+        winner = i;
+        if (unknown[i])
+        {
+          break;
+        }
+      }
+    }
+  }
+  if (d_options.getVerbosity() > 0)
+  {
+    *d_options.getErr() << "portfolio: thread " << winner << " answered"
+                        << std::endl;
+  }
+  ++d_wins[winner];
+  d_lastWinner = winner;
+  if (d_options.getVerbosity() >= -1)
+  {
+    *d_options.getOut() << outs[winner].str() << std::flush;
+  }
+  return processResult(cmds[winner].get(), status[winner]);
+}
+
+}  // namespace main
+}  // namespace CVC4
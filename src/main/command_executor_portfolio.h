@@ -0,0 +1,163 @@
+/*********************                                                        */
+/*! \file command_executor_portfolio.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief An additional layer between commands and invoking them in
+ ** portfolio mode.
+ **
+ ** The portfolio command executor maintains one SmtEngine per thread, each
+ ** with its own ExprManager and a differently configured set of options.
+ ** Commands that modify the assertion stack are replayed on all engines,
+ ** check-sat commands are run concurrently and the first definitive answer
+ ** wins, the other engines are interrupted. While solving, the engines
+ ** exchange short learned clauses and lemmas (see LemmaExchange).
+ **/
+
+#ifndef CVC4__MAIN__COMMAND_EXECUTOR_PORTFOLIO_H
+#define CVC4__MAIN__COMMAND_EXECUTOR_PORTFOLIO_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "expr/variable_type_map.h"
+#include "main/command_executor.h"
+#include "main/lemma_exchange.h"
+
+namespace CVC4 {
+
+namespace api {
+class Solver;
+}
+
+namespace main {
+
+class CommandExecutorPortfolio : public CommandExecutor
+{
+ public:
+  CommandExecutorPortfolio(api::Solver* solver, Options& options);
+
+  ~CommandExecutorPortfolio();
+
+  void flushStatistics(std::ostream& out) const override;
+
+ protected:
+  bool doCommandSingleton(CVC4::Command* cmd) override;
+  SmtEngine* getAnsweringSmtEngine() const override;
+
+ private:
+  CommandExecutorPortfolio();
+
+  /** Get the number of threads (and hence SmtEngines) of this portfolio. */
+  size_t getNumThreads() const { return d_workers.size() + 1; }
+
+  /** Get the SmtEngine of thread i, thread 0 is the main SmtEngine. */
+  SmtEngine* getSmtEngine(size_t i) const;
+
+  /**
+   * Get a copy of cmd for thread i. For thread 0 this is a clone of cmd,
+   * for all other threads cmd is exported to the ExprManager of the thread.
+   */
+  Command* getCommandForThread(Command* cmd, size_t i);
+
+  /**
+   * Run cmd (a check-sat, check-sat-assuming or query command)
+   * concurrently on all SmtEngines. The result of the first thread that
+   * reports sat or unsat is printed, all other threads are interrupted.
+   */
+  bool doCheckInParallel(Command* cmd);
+
+  /**
+   * Solve the check-sat command cmd by cube-and-conquer: the search space is
+   * split into 2^d cubes over the d atoms returned by getCubeAtoms(), where
+   * d is the value of --cube-depth. The threads take cubes from a shared
+   * queue and solve them as check-sat-assuming calls. The answer is sat if
+   * one of the cubes is sat, and unsat if all of them are unsat.
+   */
+  bool doCubeAndConquer(Command* cmd);
+
+  /**
+   * Get (at most) n atoms of the current assertions for splitting, preferring
+   * the ones that occur in the largest number of Boolean connectives.
+   */
+  std::vector<Expr> getCubeAtoms(size_t n) const;
+
+  /**
+   * Get (at most) n branches x <= c over the integer variables of the
+   * current assertions (--cube-int-branches), preferring the variables that
+   * occur in the largest number of arithmetic atoms. The split point c is the
+   * middle of the bounds the top-level assertions give for x, so that the
+   * cubes are the boxes a branch-and-bound search would explore first.
+   */
+  std::vector<Expr> getIntBranchAtoms(size_t n) const;
+
+  /**
+   * Run work(i) on a separate thread for every thread i with run[i] set.
+   * The function work returns true if it found a definitive answer. In that
+   * case, d_stop is set and all other threads are interrupted. Returns the
+   * thread that found the first definitive answer, or getNumThreads() if
+   * there is none.
+   */
+  size_t runThreads(const std::vector<bool>& run,
+                    const std::function<bool(size_t)>& work);
+
+  /**
+   * Stop replaying commands on thread i > 0, e.g., because a command could
+   * not be exported to its ExprManager.
+   */
+  void deactivate(size_t i, const std::string& reason);
+
+  /**
+   * Install (if enable is true) or remove the channels of d_exchange on the
+   * SmtEngines of the threads i with run[i] set.
+   */
+  void setLemmaChannels(const std::vector<bool>& run, bool enable);
+
+  /** The solvers of threads 1..n-1 (thread 0 is d_solver). */
+  std::vector<std::unique_ptr<api::Solver>> d_workers;
+  /**
+   * The variable maps for exporting commands to threads 1..n-1. These
+   * refer to expressions of the worker's ExprManagers and are thus declared
+   * after d_workers to be destroyed first.
+   */
+  std::vector<std::unique_ptr<ExprManagerMapCollection>> d_vmaps;
+  /**
+   * The exchange of lemmas between the threads, null if lemmas are not
+   * shared. Declared after d_workers since it refers to their ExprManagers.
+   */
+  std::unique_ptr<LemmaExchange> d_exchange;
+  /** Whether commands are still replayed on thread i > 0. */
+  std::vector<bool> d_active;
+  /**
+   * The assertions of the main thread, per assertion level. Only maintained
+   * in cube-and-conquer mode.
+   */
+  std::vector<std::vector<Expr>> d_assertions;
+  /**
+   * Whether the main thread is still in sync with the command stream. If
+   * not, the thread of d_lastWinner is the only active thread and replaces
+   * the main thread.
+   */
+  bool d_mainInSync;
+  /**
+   * The thread that answered the last check-sat command. Getter commands
+   * (get-model, get-value, ...) are forwarded to this thread.
+   */
+  size_t d_lastWinner;
+  /** Set by runThreads() once a definitive answer was found. */
+  std::atomic<bool> d_stop;
+  /** Number of check-sat commands won per thread. */
+  std::vector<unsigned> d_wins;
+}; /* class CommandExecutorPortfolio */
+
+}  // namespace main
+}  // namespace CVC4
+
+#endif /* CVC4__MAIN__COMMAND_EXECUTOR_PORTFOLIO_H */
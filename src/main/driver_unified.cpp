@@ -30,6 +30,7 @@
 #include "expr/expr_iomanip.h"
 #include "expr/expr_manager.h"
 #include "main/command_executor.h"
+#include "main/command_executor_portfolio.h"
 #include "main/interactive_shell.h"
 #include "main/main.h"
 #include "options/options.h"
@@ -160,6 +161,8 @@ int runCvc4(int argc, char* argv[], Options& opts) {
         opts.setInputLanguage(language::input::LANG_SYGUS);
         //since there is no sygus output language, set this to SMT lib 2
         //opts.setOutputLanguage(language::output::LANG_SMTLIB_V2_0);
+      } else if(len >= 6 && !strcmp(".cvc4b", filename + len - 6)) {
+        opts.setInputLanguage(language::input::LANG_BINARY);
       }
     }
   }
@@ -184,7 +187,31 @@ int runCvc4(int argc, char* argv[], Options& opts) {
   // Create the expression manager using appropriate options
   std::unique_ptr<api::Solver> solver;
   solver.reset(new api::Solver(&opts));
-  pExecutor = new CommandExecutor(solver.get(), opts);
+
+  bool portfolio = opts.getThreads() > 1;
+  if (portfolio && !opts.getIncrementalParallel()
+      && (opts.getIncrementalSolving() || opts.getTearDownIncremental() > 0
+          || (opts.getInteractive() && inputFromStdin)))
+  {
+    if (!opts.getFallbackSequential())
+    {
+      throw OptionException(
+          "Incremental solving is not supported in portfolio mode, use "
+          "--incremental-parallel or --fallback-sequential");
+    }
+    Warning() << "Incremental solving is not supported in portfolio mode, "
+                 "falling back to sequential mode"
+              << endl;
+    portfolio = false;
+  }
+  if (portfolio)
+  {
+    pExecutor = new CommandExecutorPortfolio(solver.get(), opts);
+  }
+  else
+  {
+    pExecutor = new CommandExecutor(solver.get(), opts);
+  }
 
   std::unique_ptr<Parser> replayParser;
   if (opts.getReplayInputFilename() != "")
@@ -212,6 +239,11 @@ int runCvc4(int argc, char* argv[], Options& opts) {
     ReferenceStat<std::string> s_statFilename("filename", filenameStr);
     RegisterStatistic statFilenameReg(&pExecutor->getStatisticsRegistry(),
                                       &s_statFilename);
+    // Parse time statistics, the time spent executing the parsed commands
+    // is recorded by the command executor
+    TimerStat s_statParseTime("parseTime");
+    RegisterStatistic statParseTimeReg(&pExecutor->getStatisticsRegistry(),
+                                       &s_statParseTime);
     // set filename in smt engine
     pExecutor->getSmtEngine()->setFilename(filenameStr);
 
@@ -310,6 +342,7 @@ int runCvc4(int argc, char* argv[], Options& opts) {
         }
 
         try {
+          TimerStat::CodeTimer parseTimer(s_statParseTime);
           cmd = parser->nextCommand();
           if (cmd == NULL) break;
         } catch (UnsafeInterruptException& e) {
@@ -434,7 +467,10 @@ int runCvc4(int argc, char* argv[], Options& opts) {
       }
     } else {
       if(!opts.wasSetByUserIncrementalSolving()) {
-        cmd = new SetOptionCommand("incremental", SExpr(false));
+        // cube-and-conquer answers each check-sat by a sequence of
+        // check-sat-assuming calls, which requires incremental solving
+        bool incremental = portfolio && opts.getCubeDepth() > 0;
+        cmd = new SetOptionCommand("incremental", SExpr(incremental));
         cmd->setMuted(true);
         pExecutor->doCommand(cmd);
         delete cmd;
@@ -464,6 +500,7 @@ int runCvc4(int argc, char* argv[], Options& opts) {
           break;
         }
         try {
+          TimerStat::CodeTimer parseTimer(s_statParseTime);
           cmd = parser->nextCommand();
           if (cmd == NULL) break;
         } catch (UnsafeInterruptException& e) {
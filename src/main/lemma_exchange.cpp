@@ -0,0 +1,240 @@
+/*********************                                                        */
+/*! \file lemma_exchange.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Exchange of lemmas between the threads of a portfolio.
+ **
+ ** Exchange of lemmas between the threads of a portfolio.
+ **/
+
+#include "main/lemma_exchange.h"
+
+#include <cassert>
+#include <unordered_set>
+
+#include "expr/kind.h"
+
+namespace CVC4 {
+namespace main {
+
+class LemmaExchange::InputChannel : public LemmaInputChannel
+{
+ public:
+  InputChannel(LemmaExchange& exchange, size_t thread)
+      : d_exchange(exchange), d_thread(thread), d_next(0)
+  {
+  }
+
+  bool hasNewLemma() override
+  {
+    while (d_pending.isNull() && d_next < d_exchange.d_numLemmas)
+    {
+      d_pending = d_exchange.receive(d_thread, d_next);
+    }
+    return !d_pending.isNull();
+  }
+
+  Expr getNewLemma() override
+  {
+    assert(!d_pending.isNull());
+    Expr lemma = d_pending;
+    d_pending = Expr();
+    return lemma;
+  }
+
+  /** Start over with the lemmas sent after the exchange was cleared. */
+  void reset()
+  {
+    d_next = 0;
+    d_pending = Expr();
+  }
+
+ private:
+  LemmaExchange& d_exchange;
+  size_t d_thread;
+  /** The index of the next lemma to look at. */
+  size_t d_next;
+  /** The lemma returned by the next call to getNewLemma(). */
+  Expr d_pending;
+}; /* class LemmaExchange::InputChannel */
+
+class LemmaExchange::OutputChannel : public LemmaOutputChannel
+{
+ public:
+  OutputChannel(LemmaExchange& exchange, size_t thread)
+      : d_exchange(exchange), d_thread(thread)
+  {
+  }
+
+  void notifyNewLemma(Expr lemma) override
+  {
+    d_exchange.send(d_thread, lemma);
+  }
+
+ private:
+  LemmaExchange& d_exchange;
+  size_t d_thread;
+}; /* class LemmaExchange::OutputChannel */
+
+LemmaExchange::LemmaExchange(const std::vector<ExprManager*>& exprManagers,
+                             const Options& options)
+    : d_exprManager(new ExprManager(options)),
+      d_threadExprManagers(exprManagers),
+      d_numLemmas(0),
+      d_exported(exprManagers.size(), 0),
+      d_imported(exprManagers.size(), 0)
+{
+  for (size_t i = 0, n = exprManagers.size(); i < n; ++i)
+  {
+    d_vmaps.emplace_back(new ExprManagerMapCollection());
+    d_inputs.emplace_back(new InputChannel(*this, i));
+    d_outputs.emplace_back(new OutputChannel(*this, i));
+  }
+}
+
+LemmaExchange::~LemmaExchange()
+{
+  // The lemmas and variable maps refer to expressions of d_exprManager.
+  d_lemmas.clear();
+  d_vmaps.clear();
+}
+
+LemmaInputChannel* LemmaExchange::getInputChannel(size_t i)
+{
+  return d_inputs[i].get();
+}
+
+LemmaOutputChannel* LemmaExchange::getOutputChannel(size_t i)
+{
+  return d_outputs[i].get();
+}
+
+void LemmaExchange::addSharedVariable(const std::vector<Expr>& vars)
+{
+  assert(vars.size() == d_threadExprManagers.size());
+  size_t n = vars.size();
+  size_t first = 0;
+  while (first < n && vars[first].isNull())
+  {
+    ++first;
+  }
+  if (first == n)
+  {
+    return;
+  }
+  Expr var;
+  try
+  {
+    var = vars[first].exportTo(d_exprManager.get(), *d_vmaps[first]);
+  }
+  catch (ExportUnsupportedException& e)
+  {
+    // lemmas with this variable are not shared
+    return;
+  }
+  for (size_t i = first + 1; i < n; ++i)
+  {
+    if (!vars[i].isNull())
+    {
+      d_vmaps[i]->d_typeMap[vars[i]] = var;
+      d_vmaps[i]->d_typeMap[var] = vars[i];
+    }
+  }
+}
+
+void LemmaExchange::clear()
+{
+  d_lemmas.clear();
+  d_numLemmas = 0;
+  for (std::unique_ptr<InputChannel>& in : d_inputs)
+  {
+    in->reset();
+  }
+}
+
+bool LemmaExchange::isShareable(const Expr& e,
+                                const ExprManagerMapCollection& vmap)
+{
+  std::unordered_set<Expr, ExprHashFunction> visited;
+  std::vector<Expr> visit;
+  visit.push_back(e);
+  while (!visit.empty())
+  {
+    Expr cur = visit.back();
+    visit.pop_back();
+    if (!visited.insert(cur).second)
+    {
+      continue;
+    }
+    if (cur.getKind() == kind::BOUND_VARIABLE)
+    {
+      return false;
+    }
+    if (cur.isVariable())
+    {
+      if (vmap.d_typeMap.find(cur).isNull())
+      {
+        return false;
+      }
+      continue;
+    }
+    if (cur.hasOperator())
+    {
+      visit.push_back(cur.getOperator());
+    }
+    visit.insert(visit.end(), cur.begin(), cur.end());
+  }
+  return true;
+}
+
+void LemmaExchange::send(size_t i, const Expr& lemma)
+{
+  // The variable map of thread i is only used by thread i while solving.
+  if (!isShareable(lemma, *d_vmaps[i]))
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(d_mutex);
+  try
+  {
+    d_lemmas.emplace_back(i, lemma.exportTo(d_exprManager.get(), *d_vmaps[i]));
+  }
+  catch (ExportUnsupportedException& e)
+  {
+    return;
+  }
+  d_numLemmas = d_lemmas.size();
+  ++d_exported[i];
+}
+
+Expr LemmaExchange::receive(size_t i, size_t& next)
+{
+  std::lock_guard<std::mutex> lock(d_mutex);
+  for (size_t size = d_lemmas.size(); next < size;)
+  {
+    const std::pair<size_t, Expr>& p = d_lemmas[next++];
+    if (p.first == i || !isShareable(p.second, *d_vmaps[i]))
+    {
+      continue;
+    }
+    try
+    {
+      Expr lemma = p.second.exportTo(d_threadExprManagers[i], *d_vmaps[i]);
+      ++d_imported[i];
+      return lemma;
+    }
+    catch (ExportUnsupportedException& e)
+    {
+      continue;
+    }
+  }
+  return Expr();
+}
+
+}  // namespace main
+}  // namespace CVC4
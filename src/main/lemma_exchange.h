@@ -0,0 +1,117 @@
+/*********************                                                        */
+/*! \file lemma_exchange.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Exchange of lemmas between the threads of a portfolio.
+ **
+ ** The SmtEngines of a portfolio have separate ExprManagers, each of which
+ ** may only be used by the thread of its SmtEngine. Lemmas are therefore
+ ** exported into an ExprManager owned by the exchange, which is only accessed
+ ** while holding a lock, and from there into the ExprManagers of the
+ ** receiving threads. Receivers check for new lemmas without locking.
+ **/
+
+#ifndef CVC4__MAIN__LEMMA_EXCHANGE_H
+#define CVC4__MAIN__LEMMA_EXCHANGE_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "expr/expr.h"
+#include "expr/expr_manager.h"
+#include "expr/variable_type_map.h"
+#include "smt_util/lemma_input_channel.h"
+#include "smt_util/lemma_output_channel.h"
+
+namespace CVC4 {
+namespace main {
+
+class LemmaExchange
+{
+ public:
+  /**
+   * Create an exchange between the threads whose SmtEngines use the given
+   * ExprManagers, thread i uses exprManagers[i].
+   */
+  LemmaExchange(const std::vector<ExprManager*>& exprManagers,
+                const Options& options);
+
+  ~LemmaExchange();
+
+  /** Get the channel on which thread i receives the lemmas of the others. */
+  LemmaInputChannel* getInputChannel(size_t i);
+
+  /** Get the channel on which thread i sends its lemmas. */
+  LemmaOutputChannel* getOutputChannel(size_t i);
+
+  /**
+   * Make the variables vars[i] of the threads i known as the same variable,
+   * lemmas are only exchanged if all of their variables are known. A thread
+   * that does not have the variable passes a null expression. Must not be
+   * called while the threads are solving.
+   */
+  void addSharedVariable(const std::vector<Expr>& vars);
+
+  /**
+   * Drop all lemmas sent so far. Must not be called while the threads are
+   * solving.
+   */
+  void clear();
+
+  /** Get the number of lemmas sent by thread i. */
+  unsigned getNumExported(size_t i) const { return d_exported[i]; }
+
+  /** Get the number of lemmas thread i received from other threads. */
+  unsigned getNumImported(size_t i) const { return d_imported[i]; }
+
+ private:
+  class InputChannel;
+  class OutputChannel;
+
+  /**
+   * Whether all variables of e are known in vmap, i.e., whether e can be
+   * exported without introducing fresh variables.
+   */
+  static bool isShareable(const Expr& e, const ExprManagerMapCollection& vmap);
+
+  /** Send lemma (of the ExprManager of thread i) to the other threads. */
+  void send(size_t i, const Expr& lemma);
+
+  /**
+   * Get the next lemma for thread i from the lemmas starting at index next,
+   * exported to the ExprManager of thread i. Updates next to the index after
+   * the returned lemma. Returns a null expression if there is none.
+   */
+  Expr receive(size_t i, size_t& next);
+
+  /** The ExprManager all exchanged lemmas are exported to. */
+  std::unique_ptr<ExprManager> d_exprManager;
+  /** The ExprManagers of the threads. */
+  std::vector<ExprManager*> d_threadExprManagers;
+  /** The variable maps between d_exprManager and that of thread i. */
+  std::vector<std::unique_ptr<ExprManagerMapCollection>> d_vmaps;
+  /** The lemmas sent so far, with the thread that sent them. */
+  std::vector<std::pair<size_t, Expr>> d_lemmas;
+  /** The size of d_lemmas, which may be read without holding d_mutex. */
+  std::atomic<size_t> d_numLemmas;
+  /** Protects d_exprManager and d_lemmas. */
+  std::mutex d_mutex;
+  std::vector<std::unique_ptr<InputChannel>> d_inputs;
+  std::vector<std::unique_ptr<OutputChannel>> d_outputs;
+  /** Per-thread statistics, only written by their own thread. */
+  std::vector<unsigned> d_exported;
+  std::vector<unsigned> d_imported;
+}; /* class LemmaExchange */
+
+}  // namespace main
+}  // namespace CVC4
+
+#endif /* CVC4__MAIN__LEMMA_EXCHANGE_H */
@@ -38,6 +38,7 @@
 #include "main/main.h"
 #include "options/options.h"
 #include "smt/smt_engine.h"
+#include "util/profiler.h"
 #include "util/safe_print.h"
 #include "util/statistics.h"
 
@@ -85,6 +86,22 @@ void sigterm_handler(int sig, siginfo_t* info, void*)
   abort();
 }
 
+/**
+ * Handler for SIGUSR1, which prints the statistics (or the profile) without
+ * interrupting the solver.
+ */
+void sigusr1_handler(int sig, siginfo_t* info, void*)
+{
+  if (pOptions != NULL && pOptions->getStatistics() && pExecutor != NULL)
+  {
+    pExecutor->safeFlushStatistics(STDERR_FILENO);
+  }
+  else if (Profiler::isEnabled())
+  {
+    Profiler::safeFlush(STDERR_FILENO);
+  }
+}
+
 /** Handler for SIGINT, i.e., when the user hits control C. */
 void sigint_handler(int sig, siginfo_t* info, void*) {
   safe_print(STDERR_FILENO, "CVC4 interrupted by user.\n");
@@ -339,6 +356,15 @@ void cvc4_init()
     throw Exception(string("sigaction(SIGTERM) failure: ") + strerror(errno));
   }
 
+  struct sigaction act6;
+  act6.sa_sigaction = sigusr1_handler;
+  act6.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&act6.sa_mask);
+  if (sigaction(SIGUSR1, &act6, NULL))
+  {
+    throw Exception(string("sigaction(SIGUSR1) failure: ") + strerror(errno));
+  }
+
 #endif /* __WIN32__ */
 
   set_unexpected(cvc4unexpected);
@@ -115,6 +115,10 @@ OutputLanguage toOutputLanguage(InputLanguage language) {
     // these entries directly correspond (by design)
     return OutputLanguage(int(language));
 
+  case input::LANG_BINARY:
+    // there is no binary output language, results are printed in SMT-LIB
+    return output::LANG_SMTLIB_V2_6;
+
   default:
     // Revert to the default (AST) language.
     //
@@ -214,6 +218,10 @@ InputLanguage toInputLanguage(std::string language) {
   {
     return input::LANG_SYGUS_V2;
   }
+  else if (language == "binary" || language == "LANG_BINARY")
+  {
+    return input::LANG_BINARY;
+  }
   else if (language == "auto" || language == "LANG_AUTO")
   {
     return input::LANG_AUTO;
@@ -64,6 +64,11 @@ enum CVC4_PUBLIC Language
   LANG_SYGUS,
   /** The SyGuS input language version 2.0 */
   LANG_SYGUS_V2,
+  /**
+   * The binary format of CVC4 (see smt/binary_format.h). This is only an input
+   * language, inputs in this format are written by api::Solver::writeBinary.
+   */
+  LANG_BINARY,
 
   // START OUTPUT-ONLY LANGUAGES AT ENUM VALUE 10
   // THESE ARE IN PRINCIPLE NOT POSSIBLE INPUT LANGUAGES
@@ -101,6 +106,7 @@ inline std::ostream& operator<<(std::ostream& out, Language lang) {
     out << "LANG_SYGUS";
     break;
   case LANG_SYGUS_V2: out << "LANG_SYGUS_V2"; break;
+  case LANG_BINARY: out << "LANG_BINARY"; break;
   default:
     out << "undefined_input_language";
   }
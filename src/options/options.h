@@ -199,13 +199,17 @@ public:
   OutputLanguage getOutputLanguage() const;
   bool getUfHo() const;
   bool getCheckProofs() const;
+  unsigned getCubeDepth() const;
+  bool getCubeIntBranches() const;
   bool getDumpInstantiations() const;
   bool getDumpModels() const;
+  unsigned getDumpMuses() const;
   bool getDumpProofs() const;
   bool getDumpSynth() const;
   bool getDumpUnsatCores() const;
   bool getEarlyExit() const;
   bool getFallbackSequential() const;
+  bool getFastParser() const;
   bool getFilesystemAccess() const;
   bool getForceNoLimitCpuWhileDump() const;
   bool getHelp() const;
@@ -219,12 +223,15 @@ public:
   bool getProduceModels() const;
   bool getProof() const;
   bool getSegvSpin() const;
+  bool getShareLemmas() const;
   bool getSemanticChecks() const;
   bool getStatistics() const;
   bool getStatsEveryQuery() const;
+  bool getStatsJson() const;
   bool getStatsHideZeros() const;
   bool getStrictParsing() const;
   int getTearDownIncremental() const;
+  unsigned getThreads() const;
   bool getVersion() const;
   bool getWaitToJoin() const;
   const std::string& getForceLogicString() const;
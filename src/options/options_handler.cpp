@@ -17,6 +17,7 @@
 #include "options/options_handler.h"
 
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <cerrno>
 
@@ -37,6 +38,7 @@
 #include "options/option_exception.h"
 #include "options/smt_options.h"
 #include "options/theory_options.h"
+#include "util/resource_manager.h"
 
 namespace CVC4 {
 namespace options {
@@ -106,6 +108,27 @@ unsigned long OptionsHandler::limitHandler(std::string option,
   return ms;
 }
 
+void OptionsHandler::checkResourceLimits(std::string option,
+                                         std::string value)
+{
+  std::vector<std::pair<ResourceManager::Resource, uint64_t>> limits;
+  if (!ResourceManager::parseResourceLimits(value, limits))
+  {
+    std::stringstream ss;
+    ss << "option `" << option
+       << "` requires a comma-separated list of KIND=N, where KIND is one of";
+    for (size_t i = 0;
+         i < static_cast<size_t>(ResourceManager::Resource::Count);
+         ++i)
+    {
+      ss << (i == 0 ? " " : ", ")
+         << ResourceManager::toString(
+                static_cast<ResourceManager::Resource>(i));
+    }
+    throw OptionException(ss.str());
+  }
+}
+
 /* options/base_options_handlers.h */
 void OptionsHandler::notifyPrintSuccess(std::string option) {
   d_options->d_setPrintSuccessListeners.notify();
@@ -161,6 +184,18 @@ void OptionsHandler::checkBvSatSolver(std::string option, SatSolverMode m)
   }
 }
 
+void OptionsHandler::checkDPLLSatSolver(std::string option,
+                                        DPLLSatSolverMode m)
+{
+  if (m == DPLLSatSolverMode::CADICAL && !Configuration::isBuiltWithCadical())
+  {
+    std::stringstream ss;
+    ss << "option `" << option
+       << "' requires CVC4 to be built with CaDiCaL for mode cadical";
+    throw OptionException(ss.str());
+  }
+}
+
 void OptionsHandler::checkBitblastMode(std::string option, BitblastMode m)
 {
   if (m == options::BitblastMode::LAZY)
@@ -210,12 +245,9 @@ void OptionsHandler::checkBitblastMode(std::string option, BitblastMode m)
 void OptionsHandler::setBitblastAig(std::string option, bool arg)
 {
   if(arg) {
-    if(options::bitblastMode.wasSetByUser()) {
-      if (options::bitblastMode() != options::BitblastMode::EAGER)
-      {
-        throw OptionException("bitblast-aig must be used with eager bitblaster");
-      }
-    } else {
+    // the lazy bit-blaster converts its atom definitions through AIGs too
+    if (!options::bitblastMode.wasSetByUser())
+    {
       options::BitblastMode mode = stringToBitblastMode("", "eager");
       options::bitblastMode.set(mode);
     }
@@ -30,6 +30,7 @@
 #include "options/option_exception.h"
 #include "options/options.h"
 #include "options/printer_modes.h"
+#include "options/prop_options.h"
 #include "options/quantifiers_options.h"
 
 namespace CVC4 {
@@ -52,6 +53,10 @@ public:
     options::less_equal(2)(option, value);
   }
 
+  void unsignedLessEqual16(const std::string& option, unsigned value) {
+    options::less_equal(16)(option, value);
+  }
+
   void doubleGreaterOrEqual0(const std::string& option, double value) {
     options::greater_equal(0.0)(option, value);
   }
@@ -74,6 +79,9 @@ public:
 
   void setBitblastAig(std::string option, bool arg);
 
+  // prop/options_handlers.h
+  void checkDPLLSatSolver(std::string option, DPLLSatSolverMode m);
+
   // theory/options_handlers.h
   void notifyUseTheoryList(std::string option);
   std::string handleUseTheoryList(std::string option, std::string optarg);
@@ -102,6 +110,7 @@ public:
   void statsEnabledBuild(std::string option, bool value);
 
   unsigned long limitHandler(std::string option, std::string optarg);
+  void checkResourceLimits(std::string option, std::string value);
 
   void notifyTlimit(const std::string& option);
   void notifyTlimitPer(const std::string& option);
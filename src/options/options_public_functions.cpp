@@ -58,6 +58,14 @@ bool Options::getCheckProofs() const{
   return (*this)[options::checkProofs];
 }
 
+unsigned Options::getCubeDepth() const{
+  return (*this)[options::cubeDepth];
+}
+
+bool Options::getCubeIntBranches() const{
+  return (*this)[options::cubeIntBranches];
+}
+
 bool Options::getDumpInstantiations() const{
   return (*this)[options::dumpInstantiations];
 }
@@ -66,6 +74,10 @@ bool Options::getDumpModels() const{
   return (*this)[options::dumpModels];
 }
 
+unsigned Options::getDumpMuses() const{
+  return (*this)[options::dumpMuses];
+}
+
 bool Options::getDumpProofs() const{
   return (*this)[options::dumpProofs];
 }
@@ -86,6 +98,10 @@ bool Options::getFallbackSequential() const{
   return (*this)[options::fallbackSequential];
 }
 
+bool Options::getFastParser() const{
+  return (*this)[options::fastParser];
+}
+
 bool Options::getFilesystemAccess() const{
   return (*this)[options::filesystemAccess];
 }
@@ -150,6 +166,10 @@ bool Options::getStatsEveryQuery() const{
   return (*this)[options::statsEveryQuery];
 }
 
+bool Options::getStatsJson() const{
+  return (*this)[options::statsJson];
+}
+
 bool Options::getStatsHideZeros() const{
   return (*this)[options::statsHideZeros];
 }
@@ -162,6 +182,14 @@ int Options::getTearDownIncremental() const{
   return (*this)[options::tearDownIncremental];
 }
 
+bool Options::getShareLemmas() const{
+  return (*this)[options::shareLemmas];
+}
+
+unsigned Options::getThreads() const{
+  return (*this)[options::threads];
+}
+
 bool Options::getVersion() const{
   return (*this)[options::version];
 }
@@ -245,8 +245,8 @@ Options::~Options() {
 
 void Options::copyValues(const Options& options){
   if(this != &options) {
-    delete d_holder;
-    d_holder = new options::OptionsHolder(*options.d_holder);
+    // Assigning in place reuses the storage of the current values
+    *d_holder = *options.d_holder;
   }
 }
 
@@ -439,6 +439,7 @@ Languages currently supported as arguments to the -L / --lang option:\n\
   smt2.6.1 | smtlib2.6.1         SMT-LIB format 2.6 with support for the strings standard\n\
   tptp                           TPTP format (cnf, fof and tff)\n\
   sygus | sygus2                 SyGuS version 1.0 and 2.0 formats\n\
+  binary                         binary format of CVC4 for assertion sets\n\
 \n\
 Languages currently supported as arguments to the --output-lang option:\n\
   auto                           match output language to input language\n\
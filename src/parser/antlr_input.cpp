@@ -145,8 +145,10 @@ AntlrInputStream::newFileInputStream(const std::string& name,
 #endif
   pANTLR3_INPUT_STREAM input = NULL;
   if(useMmap) {
+    // NULL if the file cannot be mapped, e.g. if it is not a regular file
     input = MemoryMappedInputBufferNew(name);
-  } else {
+  }
+  if(input == NULL) {
     input = newAntlr3FileStream(name);
   }
   if(input == NULL) {
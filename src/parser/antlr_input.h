@@ -79,7 +79,9 @@ public:
    *
    * @param name the path of the file to read
    * @param useMmap <code>true</code> if the input should use memory-mapped I/O; otherwise, the
-   * input will use the standard ANTLR3 I/O implementation.
+   * input will use the standard ANTLR3 I/O implementation. The standard
+   * implementation is also used for files that cannot be mapped, such as
+   * pipes and empty files.
    */
   static AntlrInputStream* newFileInputStream(const std::string& name,
                                               bool useMmap = false);
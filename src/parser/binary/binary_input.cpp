@@ -0,0 +1,111 @@
+/*********************                                                        */
+/*! \file binary_input.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief An input for the binary format of assertion sets
+ **/
+
+#include "parser/binary/binary_input.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "base/output.h"
+#include "parser/parser.h"
+#include "parser/parser_exception.h"
+#include "smt/command.h"
+
+namespace CVC4 {
+namespace parser {
+
+BinaryInputStream::BinaryInputStream(std::istream* owned,
+                                     std::istream& input,
+                                     const std::string& name)
+    : InputStream(name), d_owned(owned), d_input(input)
+{
+}
+
+BinaryInputStream* BinaryInputStream::newFileInputStream(
+    const std::string& name)
+{
+  std::ifstream* in = new std::ifstream(name, std::ios::in | std::ios::binary);
+  if (!in->is_open())
+  {
+    delete in;
+    throw InputStreamException("Couldn't open file: " + name);
+  }
+  return new BinaryInputStream(in, *in, name);
+}
+
+BinaryInputStream* BinaryInputStream::newStreamInputStream(
+    std::istream& input, const std::string& name)
+{
+  return new BinaryInputStream(nullptr, input, name);
+}
+
+BinaryInputStream* BinaryInputStream::newStringInputStream(
+    const std::string& input, const std::string& name)
+{
+  std::istringstream* in = new std::istringstream(input);
+  return new BinaryInputStream(in, *in, name);
+}
+
+BinaryInput::BinaryInput(BinaryInputStream& inputStream)
+    : Input(inputStream), d_input(inputStream.getStream()), d_parser(nullptr)
+{
+}
+
+BinaryInput::~BinaryInput() {}
+
+void BinaryInput::setParser(Parser& parser) { d_parser = &parser; }
+
+void BinaryInput::warning(const std::string& msg)
+{
+  Warning() << getInputStream()->getName() << ": " << msg << std::endl;
+}
+
+void BinaryInput::parseError(const std::string& msg, bool eofException)
+{
+  const std::string& name = getInputStream()->getName();
+  if (eofException)
+  {
+    throw ParserEndOfFileException(msg, name, 0, 0);
+  }
+  throw ParserException(msg, name, 0, 0);
+}
+
+Command* BinaryInput::parseCommand()
+{
+  try
+  {
+    if (d_reader == nullptr)
+    {
+      d_reader.reset(
+          new BinaryFormatReader(d_parser->getExprManager(), d_input));
+    }
+    return d_reader->nextCommand();
+  }
+  catch (ParserException&)
+  {
+    throw;
+  }
+  catch (Exception& e)
+  {
+    parseError(e.getMessage());
+  }
+  return nullptr;
+}
+
+Expr BinaryInput::parseExpr()
+{
+  parseError("Expressions cannot be parsed from the binary format");
+  return Expr();
+}
+
+}  // namespace parser
+}  // namespace CVC4
@@ -0,0 +1,104 @@
+/*********************                                                        */
+/*! \file binary_input.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief An input for the binary format of assertion sets
+ **/
+
+#include "cvc4parser_private.h"
+
+#ifndef CVC4__PARSER__BINARY__BINARY_INPUT_H
+#define CVC4__PARSER__BINARY__BINARY_INPUT_H
+
+#include <istream>
+#include <memory>
+#include <string>
+
+#include "parser/input.h"
+#include "smt/binary_format.h"
+
+namespace CVC4 {
+
+class Command;
+
+namespace parser {
+
+/** An input stream of BinaryInput, which reads from a std::istream */
+class BinaryInputStream : public InputStream
+{
+ public:
+  /** Create an input stream reading the file with the given name */
+  static BinaryInputStream* newFileInputStream(const std::string& name);
+  /**
+   * Create an input stream reading from input, which is not owned by the
+   * returned stream. The name is used in error messages.
+   */
+  static BinaryInputStream* newStreamInputStream(std::istream& input,
+                                                 const std::string& name);
+  /** Create an input stream reading the string input */
+  static BinaryInputStream* newStringInputStream(const std::string& input,
+                                                 const std::string& name);
+
+  /** Get the stream to read from */
+  std::istream& getStream() { return d_input; }
+
+ private:
+  BinaryInputStream(std::istream* owned,
+                    std::istream& input,
+                    const std::string& name);
+  /** The stream we own, if any */
+  std::unique_ptr<std::istream> d_owned;
+  /** The stream to read from */
+  std::istream& d_input;
+}; /* class BinaryInputStream */
+
+/**
+ * An input in the binary format of CVC4 (see smt/binary_format.h), which
+ * consists of declarations, assertions and check-sat commands.
+ */
+class BinaryInput : public Input
+{
+ public:
+  /** Create an input reading from inputStream, which it takes ownership of */
+  BinaryInput(BinaryInputStream& inputStream);
+  ~BinaryInput() override;
+
+ protected:
+  /**
+   * Parse a command from the input. Returns <code>NULL</code> if
+   * there is no command there to parse.
+   *
+   * @throws ParserException if an error is encountered during parsing.
+   */
+  Command* parseCommand() override;
+
+  /** Expressions cannot be parsed from the binary format, this throws */
+  Expr parseExpr() override;
+
+  /** Issue a warning */
+  void warning(const std::string& msg) override;
+
+  /** Throw a ParserException */
+  void parseError(const std::string& msg, bool eofException = false) override;
+
+  /** Set the parser state */
+  void setParser(Parser& parser) override;
+
+ private:
+  /** The stream we read from */
+  std::istream& d_input;
+  /** The parser state */
+  Parser* d_parser;
+  /** The reader of the format, created when the first command is parsed */
+  std::unique_ptr<BinaryFormatReader> d_reader;
+}; /* class BinaryInput */
+
+}  // namespace parser
+}  // namespace CVC4
+
+#endif /* CVC4__PARSER__BINARY__BINARY_INPUT_H */
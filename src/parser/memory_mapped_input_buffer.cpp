@@ -100,6 +100,10 @@ static ANTLR3_UINT32 MemoryMapFile(pANTLR3_INPUT_STREAM input,
   if(stat(filename.c_str(), &st) == -1) {
     return ANTLR3_ERR_NOFILE;
   }
+  // only regular, non-empty files can be mapped (mmap fails on length 0)
+  if(!S_ISREG(st.st_mode) || st.st_size == 0) {
+    return ANTLR3_ERR_NOFILE;
+  }
 
   input->sizeBuf = st.st_size;
 
@@ -112,8 +116,11 @@ static ANTLR3_UINT32 MemoryMapFile(pANTLR3_INPUT_STREAM input,
   errno = 0;
   close(fd);
   if(intptr_t(input->data) == -1) {
+    input->data = NULL;
     return ANTLR3_ERR_NOMEM;
   }
+  // the lexer reads the input front to back, let the kernel read ahead
+  madvise(input->data, input->sizeBuf, MADV_SEQUENTIAL);
 
   return ANTLR3_SUCCESS;
 }
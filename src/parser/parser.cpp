@@ -88,6 +88,11 @@ Expr Parser::getSymbol(const std::string& name, SymbolType type) {
   assert(isDeclared(name, type));
 
   if (type == SYM_VARIABLE) {
+    Expr letVar = lookupLetVar(name);
+    if (!letVar.isNull())
+    {
+      return letVar;
+    }
     // Functions share var namespace
     return d_symtab->lookup(name);
   }
@@ -271,9 +276,56 @@ void Parser::defineVar(const std::string& name, const Expr& val,
     ss << ", maybe the symbol has already been defined?";
     parseError(ss.str()); 
   }
+  if (!levelZero && !d_letBindings.empty())
+  {
+    // the new binding shadows a let binding of the same name
+    std::unordered_map<std::string, std::vector<Expr>>::iterator it =
+        d_letBindings.find(name);
+    if (it != d_letBindings.end())
+    {
+      it->second.push_back(Expr());
+      d_letTrail.push_back(std::make_pair(name, scopeLevel()));
+    }
+  }
   assert(isDeclared(name));
 }
 
+void Parser::defineLetVar(const std::string& name, const Expr& val)
+{
+  Debug("parser") << "defineLetVar( " << name << " := " << val << ")"
+                  << std::endl;
+  d_letBindings[name].push_back(val);
+  d_letTrail.push_back(std::make_pair(name, scopeLevel()));
+}
+
+Expr Parser::lookupLetVar(const std::string& name) const
+{
+  if (d_letBindings.empty())
+  {
+    return Expr();
+  }
+  std::unordered_map<std::string, std::vector<Expr>>::const_iterator it =
+      d_letBindings.find(name);
+  return it == d_letBindings.end() ? Expr() : it->second.back();
+}
+
+void Parser::popLetBindings()
+{
+  size_t level = scopeLevel();
+  while (!d_letTrail.empty() && d_letTrail.back().second > level)
+  {
+    std::unordered_map<std::string, std::vector<Expr>>::iterator it =
+        d_letBindings.find(d_letTrail.back().first);
+    assert(it != d_letBindings.end());
+    it->second.pop_back();
+    if (it->second.empty())
+    {
+      d_letBindings.erase(it);
+    }
+    d_letTrail.pop_back();
+  }
+}
+
 void Parser::defineType(const std::string& name,
                         const Type& type,
                         bool levelZero)
@@ -516,8 +568,9 @@ Expr Parser::mkHoApply(Expr expr, std::vector<Expr>& args)
 bool Parser::isDeclared(const std::string& name, SymbolType type) {
   switch (type) {
     case SYM_VARIABLE:
-      return d_reservedSymbols.find(name) != d_reservedSymbols.end() ||
-             d_symtab->isBound(name);
+      return !lookupLetVar(name).isNull()
+             || d_reservedSymbols.find(name) != d_reservedSymbols.end()
+             || d_symtab->isBound(name);
     case SYM_SORT:
       return d_symtab->isBoundType(name);
   }
@@ -639,8 +692,28 @@ Command* Parser::nextCommand()
     // don't count set-option commands as to not get stuck in an infinite
     // loop of resourcing out
     const Options& options = getExprManager()->getOptions();
-    d_resourceManager->spendResource(options.getParseStep());
+    d_resourceManager->spendResource(ResourceManager::Resource::ParseStep,
+                                     options.getParseStep());
+  }
+  return cmd;
+}
+
+Command* Parser::parseCommandFrom(Input& input)
+{
+  Input* current = d_input;
+  d_input = &input;
+  input.setParser(*this);
+  Command* cmd = NULL;
+  try
+  {
+    cmd = input.parseCommand();
+  }
+  catch (...)
+  {
+    d_input = current;
+    throw;
   }
+  d_input = current;
   return cmd;
 }
 
@@ -648,7 +721,8 @@ Expr Parser::nextExpression()
 {
   Debug("parser") << "nextExpression()" << std::endl;
   const Options& options = getExprManager()->getOptions();
-  d_resourceManager->spendResource(options.getParseStep());
+  d_resourceManager->spendResource(ResourceManager::Resource::ParseStep,
+                                   options.getParseStep());
   Expr result;
   if (!done()) {
     try {
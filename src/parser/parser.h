@@ -23,6 +23,9 @@
 #include <set>
 #include <list>
 #include <cassert>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "expr/expr.h"
 #include "expr/expr_stream.h"
@@ -179,6 +182,20 @@ private:
   */
  std::set<std::string> d_reservedSymbols;
 
+ /**
+  * The let bindings in scope, which are not stored in the symbol table. For
+  * each name, the stack of the expressions it is let-bound to, innermost
+  * last. A null expression records that a binding of the symbol table made
+  * in the body of the let shadows the let binding.
+  */
+ std::unordered_map<std::string, std::vector<Expr>> d_letBindings;
+
+ /**
+  * The names of the entries of d_letBindings, in the order in which they
+  * were made, together with the scope level at which they were made.
+  */
+ std::vector<std::pair<std::string, size_t>> d_letTrail;
+
  /** How many anonymous functions we've created. */
  size_t d_anonymousFunctionCount;
 
@@ -239,6 +256,15 @@ private:
   */
  Expr getSymbol(const std::string& var_name, SymbolType type);
 
+ /**
+  * Returns the expression that name is let-bound to in the current scope, or
+  * the null expression if it is not let-bound or the let binding is shadowed.
+  */
+ Expr lookupLetVar(const std::string& name) const;
+
+ /** Remove the let bindings made above the current scope level. */
+ void popLetBindings();
+
 protected:
  /** The API Solver object. */
  api::Solver* d_solver;
@@ -284,6 +310,15 @@ public:
     d_done = false;
   }
 
+  /**
+   * Parse the next command of input, which replaces the current input of the
+   * parser while the command is parsed. This lets an input hand the commands
+   * that it does not support to an input of another kind, e.g. an ANTLR
+   * input. The input is not owned by the parser. Returns NULL at the end of
+   * input.
+   */
+  Command* parseCommandFrom(Input& input);
+
   /**
    * Check if we are done -- either the end of input has been reached, or some
    * error has been encountered.
@@ -526,6 +561,15 @@ public:
   void defineVar(const std::string& name, const Expr& val,
                  bool levelZero = false, bool doOverload = false);
 
+  /**
+   * Create a let binding of name to val in the current scope, which must be
+   * the scope of the let. The binding is not stored in the symbol table, it
+   * is pushed on a stack of the parser that is truncated when the scope is
+   * popped. Since let bindings are neither overloaded nor global, this
+   * avoids the work of defineVar for the many bindings of let-heavy inputs.
+   */
+  void defineLetVar(const std::string& name, const Expr& val);
+
   /**
    * Create a new type definition.
    *
@@ -760,10 +804,16 @@ public:
       d_assertionLevel = scopeLevel();
       d_reservedSymbols.clear();
     }
+    if (!d_letTrail.empty())
+    {
+      popLetBindings();
+    }
   }
 
   virtual void reset() {
     d_symtab->reset();
+    d_letBindings.clear();
+    d_letTrail.clear();
   }
 
   void setGlobalDeclarations(bool flag) {
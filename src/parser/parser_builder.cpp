@@ -22,12 +22,14 @@
 #include <string>
 
 #include "api/cvc4cpp.h"
+#include "binary/binary_input.h"
 #include "cvc/cvc.h"
 #include "expr/expr_manager.h"
 #include "options/options.h"
 #include "parser/input.h"
 #include "parser/parser.h"
 #include "smt2/smt2.h"
+#include "smt2/smt2_fast_input.h"
 #include "tptp/tptp.h"
 
 namespace CVC4 {
@@ -58,30 +60,79 @@ void ParserBuilder::init(api::Solver* solver, const std::string& filename)
   d_checksEnabled = true;
   d_strictMode = false;
   d_canIncludeFile = true;
-  d_mmap = false;
+  d_mmap = true;
   d_parseOnly = false;
   d_logicIsForced = false;
   d_forcedLogic = "";
+  d_fastParser = false;
 }
 
 Parser* ParserBuilder::build()
 {
   Input* input = NULL;
-  switch( d_inputType ) {
-  case FILE_INPUT:
-    input = Input::newFileInput(d_lang, d_filename, d_mmap);
-    break;
-  case LINE_BUFFERED_STREAM_INPUT:
-    assert( d_streamInput != NULL );
-    input = Input::newStreamInput(d_lang, *d_streamInput, d_filename, true);
-    break;
-  case STREAM_INPUT:
-    assert( d_streamInput != NULL );
-    input = Input::newStreamInput(d_lang, *d_streamInput, d_filename);
-    break;
-  case STRING_INPUT:
-    input = Input::newStringInput(d_lang, d_stringInput, d_filename);
-    break;
+  if (d_lang == language::input::LANG_BINARY)
+  {
+    BinaryInputStream* inputStream = NULL;
+    switch (d_inputType)
+    {
+      case FILE_INPUT:
+        inputStream = BinaryInputStream::newFileInputStream(d_filename);
+        break;
+      case LINE_BUFFERED_STREAM_INPUT:
+      case STREAM_INPUT:
+        assert(d_streamInput != NULL);
+        inputStream =
+            BinaryInputStream::newStreamInputStream(*d_streamInput, d_filename);
+        break;
+      case STRING_INPUT:
+        inputStream =
+            BinaryInputStream::newStringInputStream(d_stringInput, d_filename);
+        break;
+    }
+    input = new BinaryInput(*inputStream);
+  }
+  else if (d_fastParser && language::isInputLang_smt2(d_lang))
+  {
+    // the hand-written parser reads all inputs through a std::istream, it
+    // does not need line buffering nor memory mapping
+    Smt2FastInputStream* inputStream = NULL;
+    switch (d_inputType)
+    {
+      case FILE_INPUT:
+        inputStream = Smt2FastInputStream::newFileInputStream(d_filename);
+        break;
+      case LINE_BUFFERED_STREAM_INPUT:
+      case STREAM_INPUT:
+        assert(d_streamInput != NULL);
+        inputStream = Smt2FastInputStream::newStreamInputStream(*d_streamInput,
+                                                                d_filename);
+        break;
+      case STRING_INPUT:
+        inputStream = Smt2FastInputStream::newStringInputStream(d_stringInput,
+                                                                d_filename);
+        break;
+    }
+    input = new Smt2FastInput(*inputStream, d_lang);
+  }
+  else
+  {
+    switch (d_inputType)
+    {
+      case FILE_INPUT:
+        input = Input::newFileInput(d_lang, d_filename, d_mmap);
+        break;
+      case LINE_BUFFERED_STREAM_INPUT:
+        assert(d_streamInput != NULL);
+        input = Input::newStreamInput(d_lang, *d_streamInput, d_filename, true);
+        break;
+      case STREAM_INPUT:
+        assert(d_streamInput != NULL);
+        input = Input::newStreamInput(d_lang, *d_streamInput, d_filename);
+        break;
+      case STRING_INPUT:
+        input = Input::newStringInput(d_lang, d_stringInput, d_filename);
+        break;
+    }
   }
 
   assert(input != NULL);
@@ -96,6 +147,10 @@ Parser* ParserBuilder::build()
     case language::input::LANG_TPTP:
       parser = new Tptp(d_solver, input, d_strictMode, d_parseOnly);
       break;
+    case language::input::LANG_BINARY:
+      // the binary format has no symbols, the base parser state suffices
+      parser = new Parser(d_solver, input, d_strictMode, d_parseOnly);
+      break;
     default:
       if (language::isInputLang_smt2(d_lang))
       {
@@ -171,7 +226,8 @@ ParserBuilder& ParserBuilder::withOptions(const Options& options) {
       .withChecks(options.getSemanticChecks())
       .withStrictMode(options.getStrictParsing())
       .withParseOnly(options.getParseOnly())
-      .withIncludeFile(options.getFilesystemAccess());
+      .withIncludeFile(options.getFilesystemAccess())
+      .withFastParser(options.getFastParser());
   if(options.wasSetByUserForceLogicString()) {
     LogicInfo tmp(options.getForceLogicString());
     retval = retval.withForcedLogic(tmp.getLogicString());
@@ -195,6 +251,12 @@ ParserBuilder& ParserBuilder::withForcedLogic(const std::string& logic) {
   return *this;
 }
 
+ParserBuilder& ParserBuilder::withFastParser(bool flag)
+{
+  d_fastParser = flag;
+  return *this;
+}
+
 ParserBuilder& ParserBuilder::withStreamInput(std::istream& input) {
   d_inputType = STREAM_INPUT;
   d_streamInput = &input;
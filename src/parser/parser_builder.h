@@ -88,6 +88,9 @@ class CVC4_PUBLIC ParserBuilder {
   /** The forced logic name */
   std::string d_forcedLogic;
 
+  /** Should we use the hand-written parser for SMT-LIB 2 inputs? */
+  bool d_fastParser;
+
   /** Initialize this parser builder */
   void init(api::Solver* solver, const std::string& filename);
 
@@ -128,9 +131,10 @@ class CVC4_PUBLIC ParserBuilder {
 
   /**
    * Should the parser memory-map its input? This is only relevant if
-   * the parser will have a file input.
+   * the parser will have a file input. Files that are not regular files are
+   * read as usual.
    *
-   * (Default: no)
+   * (Default: yes)
    */
   ParserBuilder& withMmap(bool flag = true);
 
@@ -175,6 +179,14 @@ class CVC4_PUBLIC ParserBuilder {
 
   /** Set the parser to use the given logic string. */
   ParserBuilder& withForcedLogic(const std::string& logic);
+
+  /**
+   * Should the parser use the hand-written streaming parser (Smt2FastInput)
+   * rather than the ANTLR parser? This is only relevant for SMT-LIB 2 inputs.
+   *
+   * (Default: no)
+   */
+  ParserBuilder& withFastParser(bool flag = true);
 };/* class ParserBuilder */
 
 }/* CVC4::parser namespace */
@@ -1788,9 +1788,7 @@ termNonVariable[CVC4::Expr& expr, CVC4::Expr& expr2]
     { // now implement these bindings
       for (const std::pair<std::string, Expr>& binder : binders)
       {
-        {
-          PARSER_STATE->defineVar(binder.first, binder.second);
-        }
+        PARSER_STATE->defineLetVar(binder.first, binder.second);
       }
     }
     RPAREN_TOK
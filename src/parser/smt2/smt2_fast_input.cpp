@@ -0,0 +1,1604 @@
+/*********************                                                        */
+/*! \file smt2_fast_input.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the hand-written streaming lexer and parser for
+ ** SMT-LIB 2 inputs
+ **/
+
+#include "parser/smt2/smt2_fast_input.h"
+
+#include <cctype>
+#include <fstream>
+#include <sstream>
+
+#include "api/cvc4cpp.h"
+#include "base/check.h"
+#include "base/output.h"
+#include "expr/datatype.h"
+#include "expr/expr_manager.h"
+#include "parser/parser_exception.h"
+#include "parser/smt2/smt2.h"
+#include "smt/command.h"
+#include "util/floatingpoint.h"
+#include "util/integer.h"
+#include "util/rational.h"
+
+namespace CVC4 {
+namespace parser {
+
+Smt2FastInputStream::Smt2FastInputStream(std::istream* owned,
+                                         std::istream& input,
+                                         const std::string& name)
+    : InputStream(name), d_owned(owned), d_input(input)
+{
+}
+
+Smt2FastInputStream* Smt2FastInputStream::newFileInputStream(
+    const std::string& name)
+{
+  std::ifstream* in = new std::ifstream(name, std::ios::in | std::ios::binary);
+  if (!in->is_open())
+  {
+    delete in;
+    throw InputStreamException("Couldn't open file: " + name);
+  }
+  return new Smt2FastInputStream(in, *in, name);
+}
+
+Smt2FastInputStream* Smt2FastInputStream::newStreamInputStream(
+    std::istream& input, const std::string& name)
+{
+  return new Smt2FastInputStream(nullptr, input, name);
+}
+
+Smt2FastInputStream* Smt2FastInputStream::newStringInputStream(
+    const std::string& input, const std::string& name)
+{
+  std::istringstream* in = new std::istringstream(input);
+  return new Smt2FastInputStream(in, *in, name);
+}
+
+Smt2FastInput::Smt2FastInput(Smt2FastInputStream& inputStream,
+                             InputLanguage lang)
+    : Input(inputStream),
+      d_parser(nullptr),
+      d_lang(lang),
+      d_delegateLineOffset(0),
+      d_buf(inputStream.getStreamBuffer()),
+      d_hasPeeked(false),
+      d_peeked(EOF_TOK),
+      d_line(1),
+      d_column(0),
+      d_tokLine(1),
+      d_tokColumn(0)
+{
+}
+
+Smt2FastInput::~Smt2FastInput() {}
+
+void Smt2FastInput::setParser(Parser& parser)
+{
+  d_parser = static_cast<Smt2*>(&parser);
+}
+
+void Smt2FastInput::warning(const std::string& msg)
+{
+  Warning() << getInputStream()->getName() << ':' << d_tokLine << '.'
+            << d_tokColumn << ": " << msg << std::endl;
+}
+
+void Smt2FastInput::parseError(const std::string& msg, bool eofException)
+{
+  const std::string& name = getInputStream()->getName();
+  Debug("parser") << "Throwing exception: " << name << ":" << d_tokLine << "."
+                  << d_tokColumn << ": " << msg << std::endl;
+  if (eofException)
+  {
+    throw ParserEndOfFileException(msg, name, d_tokLine, d_tokColumn);
+  }
+  throw ParserException(msg, name, d_tokLine, d_tokColumn);
+}
+
+/* -------------------------------------------------------------------------- */
+/* Lexer                                                                      */
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+/** Is c a character of a simple symbol, other than a letter or digit? */
+bool isSymbolChar(int c)
+{
+  switch (c)
+  {
+    case '+':
+    case '-':
+    case '/':
+    case '*':
+    case '=':
+    case '%':
+    case '?':
+    case '!':
+    case '.':
+    case '$':
+    case '_':
+    case '~':
+    case '&':
+    case '^':
+    case '<':
+    case '>':
+    case '@': return true;
+    default: return false;
+  }
+}
+
+/** Is c a character of a simple symbol? */
+bool isSimpleSymbolChar(int c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+         || (c >= '0' && c <= '9') || isSymbolChar(c);
+}
+
+bool isDigit(int c) { return c >= '0' && c <= '9'; }
+
+}  // namespace
+
+int Smt2FastInput::getChar()
+{
+  int c = d_buf->sbumpc();
+  if (c == '\n')
+  {
+    d_line++;
+    d_column = 0;
+  }
+  else
+  {
+    d_column++;
+  }
+  return c;
+}
+
+Smt2FastInput::Token Smt2FastInput::lexToken()
+{
+  const int eof = std::char_traits<char>::eof();
+  d_text.clear();
+  // skip whitespace and comments
+  int c;
+  for (;;)
+  {
+    c = peekChar();
+    if (c == ' ' || c == '\t' || c == '\f' || c == '\r' || c == '\n')
+    {
+      getChar();
+    }
+    else if (c == ';')
+    {
+      while (c != eof && c != '\n' && c != '\r')
+      {
+        getChar();
+        c = peekChar();
+      }
+    }
+    else
+    {
+      break;
+    }
+  }
+  d_tokLine = d_line;
+  d_tokColumn = d_column;
+  if (c == eof)
+  {
+    return EOF_TOK;
+  }
+  getChar();
+  switch (c)
+  {
+    case '(': return LPAREN_TOK;
+    case ')': return RPAREN_TOK;
+    case '|':
+      for (;;)
+      {
+        c = getChar();
+        if (c == '|')
+        {
+          return QUOTED_SYMBOL_TOK;
+        }
+        else if (c == eof)
+        {
+          d_parser->unexpectedEOF("unterminated |quoted| symbol");
+        }
+        else if (c == '\\')
+        {
+          parseError("backslash not permitted in |quoted| symbol");
+        }
+        d_text.push_back(static_cast<char>(c));
+      }
+    case '"': lexString(); return STRING_TOK;
+    case ':':
+      d_text.push_back(':');
+      while (isSimpleSymbolChar(peekChar()))
+      {
+        d_text.push_back(static_cast<char>(getChar()));
+      }
+      if (d_text.size() == 1)
+      {
+        parseError("Expected a keyword after `:'");
+      }
+      return KEYWORD_TOK;
+    case '#':
+    {
+      d_text.push_back('#');
+      c = getChar();
+      d_text.push_back(static_cast<char>(c));
+      if (c == 'x')
+      {
+        while (std::isxdigit(peekChar()))
+        {
+          d_text.push_back(static_cast<char>(getChar()));
+        }
+      }
+      else if (c == 'b')
+      {
+        while (peekChar() == '0' || peekChar() == '1')
+        {
+          d_text.push_back(static_cast<char>(getChar()));
+        }
+      }
+      else
+      {
+        parseError("Expected a hexadecimal or binary constant");
+      }
+      if (d_text.size() == 2 || isSimpleSymbolChar(peekChar()))
+      {
+        parseError("Bad syntax for " + std::string(c == 'x' ? "hex" : "binary")
+                   + " constant");
+      }
+      return c == 'x' ? HEX_TOK : BINARY_TOK;
+    }
+    default: break;
+  }
+  if (isDigit(c))
+  {
+    d_text.push_back(static_cast<char>(c));
+    while (isDigit(peekChar()))
+    {
+      d_text.push_back(static_cast<char>(getChar()));
+    }
+    if (c == '0' && d_text.size() > 1 && d_parser->strictModeEnabled())
+    {
+      parseError("Numerals with leading zeroes are not permitted in strict "
+                 "mode");
+    }
+    if (peekChar() != '.')
+    {
+      return NUMERAL_TOK;
+    }
+    d_text.push_back(static_cast<char>(getChar()));
+    if (!isDigit(peekChar()))
+    {
+      parseError("Decimal constants must have a fractional part");
+    }
+    while (isDigit(peekChar()))
+    {
+      d_text.push_back(static_cast<char>(getChar()));
+    }
+    return DECIMAL_TOK;
+  }
+  if (!isSimpleSymbolChar(c))
+  {
+    std::stringstream ss;
+    ss << "Unexpected character `" << static_cast<char>(c) << "'";
+    parseError(ss.str());
+  }
+  d_text.push_back(static_cast<char>(c));
+  while (isSimpleSymbolChar(peekChar()))
+  {
+    d_text.push_back(static_cast<char>(getChar()));
+  }
+  return SYMBOL_TOK;
+}
+
+void Smt2FastInput::lexString()
+{
+  const int eof = std::char_traits<char>::eof();
+  // This computes the result of the str rule of the ANTLR grammar, where
+  // SMT-LIB >=2.5 and SyGuS escape '"' by '""', and otherwise backslash
+  // sequences are kept as they are.
+  bool dupDblQuote = d_parser->escapeDupDblQuote();
+  for (;;)
+  {
+    int c = getChar();
+    if (c == eof)
+    {
+      d_parser->unexpectedEOF("unterminated string literal");
+    }
+    else if (c == '"')
+    {
+      if (!dupDblQuote || peekChar() != '"')
+      {
+        return;
+      }
+      getChar();
+    }
+    else if (c == '\\' && !dupDblQuote)
+    {
+      d_text.push_back('\\');
+      c = getChar();
+      if (c == eof)
+      {
+        d_parser->unexpectedEOF("unterminated string literal");
+      }
+    }
+    if (static_cast<unsigned char>(c) > 127)
+    {
+      parseError(
+          "Extended/unprintable characters are not "
+          "part of SMT-LIB, and they must be encoded "
+          "as escape sequences");
+    }
+    d_text.push_back(static_cast<char>(c));
+  }
+}
+
+Smt2FastInput::Token Smt2FastInput::nextToken()
+{
+  if (d_hasPeeked)
+  {
+    d_hasPeeked = false;
+    return d_peeked;
+  }
+  return lexToken();
+}
+
+Smt2FastInput::Token Smt2FastInput::peekToken()
+{
+  if (!d_hasPeeked)
+  {
+    d_peeked = lexToken();
+    d_hasPeeked = true;
+  }
+  return d_peeked;
+}
+
+void Smt2FastInput::expectToken(Token t)
+{
+  Token n = nextToken();
+  if (n != t)
+  {
+    std::string msg = "Expected " + tokenName(t) + ", got " + tokenName(n);
+    if (n == EOF_TOK)
+    {
+      d_parser->unexpectedEOF(msg);
+    }
+    parseError(msg);
+  }
+}
+
+std::string Smt2FastInput::tokenName(Token t)
+{
+  switch (t)
+  {
+    case LPAREN_TOK: return "`('";
+    case RPAREN_TOK: return "`)'";
+    case SYMBOL_TOK: return "a symbol";
+    case QUOTED_SYMBOL_TOK: return "a quoted symbol";
+    case KEYWORD_TOK: return "a keyword";
+    case NUMERAL_TOK: return "a numeral";
+    case DECIMAL_TOK: return "a decimal";
+    case HEX_TOK: return "a hexadecimal constant";
+    case BINARY_TOK: return "a binary constant";
+    case STRING_TOK: return "a string literal";
+    case EOF_TOK: return "end of input";
+  }
+  return "?";
+}
+
+/* -------------------------------------------------------------------------- */
+/* Commands                                                                   */
+/* -------------------------------------------------------------------------- */
+
+Command* Smt2FastInput::parseCommand()
+{
+  if (d_delegate != nullptr)
+  {
+    // the remaining commands of the input of the ANTLR parser, e.g. those of
+    // an included file
+    Command* cmd = nullptr;
+    try
+    {
+      cmd = d_parser->parseCommandFrom(*d_delegate);
+    }
+    catch (ParserEndOfFileException& e)
+    {
+      throw ParserEndOfFileException(e.getMessage(),
+                                     e.getFilename(),
+                                     delegateLine(e),
+                                     e.getColumn());
+    }
+    catch (ParserException& e)
+    {
+      throw ParserException(
+          e.getMessage(), e.getFilename(), delegateLine(e), e.getColumn());
+    }
+    if (cmd != nullptr)
+    {
+      return cmd;
+    }
+    d_delegate.reset();
+  }
+  Token t = nextToken();
+  if (t == EOF_TOK)
+  {
+    return nullptr;
+  }
+  if (t != LPAREN_TOK)
+  {
+    parseError("Expected SMT-LIBv2 command, got " + tokenName(t));
+  }
+  unsigned long line = d_tokLine;
+  unsigned long column = d_tokColumn;
+  t = nextToken();
+  if (t != SYMBOL_TOK)
+  {
+    if (t == EOF_TOK)
+    {
+      d_parser->unexpectedEOF("Expected SMT-LIBv2 command");
+    }
+    parseError("Expected SMT-LIBv2 command, got " + tokenName(t));
+  }
+  std::string cmdName = d_text;
+  std::unique_ptr<Command> cmd(parseCommandBody(cmdName));
+  if (cmd == nullptr)
+  {
+    return delegateCommand(cmdName, line, column);
+  }
+  expectToken(RPAREN_TOK);
+  return cmd.release();
+}
+
+Command* Smt2FastInput::delegateCommand(const std::string& cmdName,
+                                        unsigned long line,
+                                        unsigned long column)
+{
+  // The command is placed at its column, and the lines of the errors of the
+  // ANTLR parser are shifted by delegateLine, so that they refer to the
+  // positions of the input.
+  d_delegateLineOffset = line - 1;
+  std::string text(column, ' ');
+  text += "(" + cmdName;
+  readCommandText(text);
+  Debug("parser") << "Smt2FastInput: handing `" << cmdName
+                  << "' to the ANTLR parser" << std::endl;
+  d_delegate.reset(
+      Input::newStringInput(d_lang, text, getInputStream()->getName()));
+  return parseCommand();
+}
+
+unsigned long Smt2FastInput::delegateLine(const ParserException& e) const
+{
+  if (e.getLine() <= 0 || e.getFilename() != getInputStream()->getName())
+  {
+    // not positioned, or in an included file
+    return e.getLine();
+  }
+  return e.getLine() + d_delegateLineOffset;
+}
+
+void Smt2FastInput::readCommandText(std::string& text)
+{
+  Assert(!d_hasPeeked);
+  const int eof = std::char_traits<char>::eof();
+  bool dupDblQuote = d_parser->escapeDupDblQuote();
+  size_t depth = 0;
+  for (;;)
+  {
+    int c = getChar();
+    if (c == eof)
+    {
+      d_parser->unexpectedEOF("Expected `)' to end the command");
+    }
+    text.push_back(static_cast<char>(c));
+    if (c == '(')
+    {
+      depth++;
+    }
+    else if (c == ')')
+    {
+      if (depth == 0)
+      {
+        return;
+      }
+      depth--;
+    }
+    else if (c == '"' || c == '|')
+    {
+      // string literals and quoted symbols may contain parentheses; an
+      // escaped "" is read as two consecutive string literals
+      int end = c;
+      do
+      {
+        c = getChar();
+        if (c == eof)
+        {
+          d_parser->unexpectedEOF(end == '"' ? "unterminated string literal"
+                                             : "unterminated |quoted| symbol");
+        }
+        text.push_back(static_cast<char>(c));
+        if (c == '\\' && end == '"' && !dupDblQuote
+            && peekChar() != eof)
+        {
+          text.push_back(static_cast<char>(getChar()));
+        }
+      } while (c != end);
+    }
+    else if (c == ';')
+    {
+      // comments may contain parentheses as well
+      while (peekChar() != eof && peekChar() != '\n' && peekChar() != '\r')
+      {
+        text.push_back(static_cast<char>(getChar()));
+      }
+    }
+  }
+}
+
+Command* Smt2FastInput::parseCommandBody(const std::string& cmdName)
+{
+  Smt2* ps = d_parser;
+  std::unique_ptr<Command> cmd;
+  Expr expr, expr2;
+  std::string name;
+  std::vector<Type> sorts;
+  std::vector<Expr> terms;
+  if (cmdName == "set-logic")
+  {
+    name = parseSymbol(CHECK_NONE, SYM_SORT);
+    cmd.reset(ps->setLogic(name));
+  }
+  else if (cmdName == "set-info")
+  {
+    name = parseKeyword();
+    SExpr sexpr = parseSExpr();
+    ps->setInfo(name.c_str() + 1, sexpr);
+    cmd.reset(new SetInfoCommand(name.c_str() + 1, sexpr));
+  }
+  else if (cmdName == "get-info")
+  {
+    name = parseKeyword();
+    cmd.reset(new GetInfoCommand(name.c_str() + 1));
+  }
+  else if (cmdName == "set-option")
+  {
+    name = parseKeyword();
+    SExpr sexpr = parseSExpr();
+    ps->setOption(name.c_str() + 1, sexpr);
+    cmd.reset(new SetOptionCommand(name.c_str() + 1, sexpr));
+    // global-declarations affects parsing, see the ANTLR grammar
+    if (name == ":global-declarations")
+    {
+      ps->setGlobalDeclarations(sexpr.getValue() == "true");
+    }
+  }
+  else if (cmdName == "get-option")
+  {
+    name = parseKeyword();
+    cmd.reset(new GetOptionCommand(name.c_str() + 1));
+  }
+  else if (cmdName == "declare-sort")
+  {
+    ps->checkThatLogicIsSet();
+    if (!ps->isTheoryEnabled(Smt2::THEORY_UF)
+        && !ps->isTheoryEnabled(Smt2::THEORY_ARRAYS)
+        && !ps->isTheoryEnabled(Smt2::THEORY_DATATYPES)
+        && !ps->isTheoryEnabled(Smt2::THEORY_SETS))
+    {
+      ps->parseErrorLogic("Free sort symbols not allowed in ");
+    }
+    name = parseSymbol(CHECK_UNDECLARED, SYM_SORT);
+    ps->checkUserSymbol(name);
+    uint64_t arity = parseNumeral();
+    if (arity == 0)
+    {
+      Type type = ps->mkSort(name);
+      cmd.reset(new DeclareTypeCommand(name, 0, type));
+    }
+    else
+    {
+      Type type = ps->mkSortConstructor(name, arity);
+      cmd.reset(new DeclareTypeCommand(name, arity, type));
+    }
+  }
+  else if (cmdName == "define-sort")
+  {
+    ps->checkThatLogicIsSet();
+    name = parseSymbol(CHECK_UNDECLARED, SYM_SORT);
+    ps->checkUserSymbol(name);
+    expectToken(LPAREN_TOK);
+    std::vector<std::string> names;
+    while (peekToken() != RPAREN_TOK)
+    {
+      names.push_back(parseSymbol(CHECK_NONE, SYM_SORT));
+    }
+    nextToken();
+    ps->pushScope(true);
+    for (const std::string& n : names)
+    {
+      sorts.push_back(ps->mkSort(n));
+    }
+    Type t = parseSort();
+    ps->popScope();
+    // This name is not its own distinct sort, it's an alias.
+    ps->defineParameterizedType(name, sorts, t);
+    cmd.reset(new DefineTypeCommand(name, sorts, t));
+  }
+  else if (cmdName == "declare-fun")
+  {
+    ps->checkThatLogicIsSet();
+    name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    ps->checkUserSymbol(name);
+    expectToken(LPAREN_TOK);
+    parseSortList(sorts);
+    Type t = parseSort();
+    if (!sorts.empty())
+    {
+      t = ps->mkFlatFunctionType(sorts, t);
+    }
+    if (t.isFunction() && !ps->isTheoryEnabled(Smt2::THEORY_UF))
+    {
+      ps->parseError("Functions (of non-zero arity) cannot "
+                     "be declared in logic "
+                     + ps->getLogic().getLogicString()
+                     + " unless option --uf-ho is used.");
+    }
+    // we allow overloading for function declarations
+    Expr func = ps->mkVar(name, t, ExprManager::VAR_FLAG_NONE, true);
+    cmd.reset(new DeclareFunctionCommand(name, func, t));
+  }
+  else if (cmdName == "declare-const")
+  {
+    ps->checkThatLogicIsSet();
+    name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    ps->checkUserSymbol(name);
+    Type t = parseSort();
+    // allow overloading here
+    Expr c = ps->mkVar(name, t, ExprManager::VAR_FLAG_NONE, true);
+    cmd.reset(new DeclareFunctionCommand(name, c, t));
+  }
+  else if (cmdName == "define-fun")
+  {
+    ps->checkThatLogicIsSet();
+    name = parseSymbol(CHECK_UNDECLARED, SYM_VARIABLE);
+    ps->checkUserSymbol(name);
+    std::vector<std::pair<std::string, Type>> sortedVarNames;
+    std::vector<Expr> flattenVars;
+    expectToken(LPAREN_TOK);
+    parseSortedVarList(sortedVarNames);
+    Type t = parseSort();
+    if (!sortedVarNames.empty())
+    {
+      for (const std::pair<std::string, Type>& svn : sortedVarNames)
+      {
+        sorts.push_back(svn.second);
+      }
+      t = ps->mkFlatFunctionType(sorts, t, flattenVars);
+    }
+    ps->pushScope(true);
+    terms = ps->mkBoundVars(sortedVarNames);
+    expr = parseTerm(expr2);
+    if (!flattenVars.empty())
+    {
+      // apply the body of the definition to the implicit variables
+      expr = ps->mkHoApply(expr, flattenVars);
+      terms.insert(terms.end(), flattenVars.begin(), flattenVars.end());
+    }
+    ps->popScope();
+    // declare the name after parsing the body, since recursion is not
+    // permitted; we allow overloading for function definitions
+    Expr func = ps->mkVar(name, t, ExprManager::VAR_FLAG_DEFINED, true);
+    cmd.reset(new DefineFunctionCommand(name, func, terms, expr));
+  }
+  else if (cmdName == "get-value")
+  {
+    ps->checkThatLogicIsSet();
+    if (peekToken() != LPAREN_TOK)
+    {
+      ps->parseError(
+          "The get-value command expects a list of "
+          "terms.  Perhaps you forgot a pair of "
+          "parentheses?");
+    }
+    nextToken();
+    parseTermList(terms);
+    cmd.reset(new GetValueCommand(terms));
+  }
+  else if (cmdName == "get-assignment")
+  {
+    ps->checkThatLogicIsSet();
+    cmd.reset(new GetAssignmentCommand());
+  }
+  else if (cmdName == "assert")
+  {
+    ps->checkThatLogicIsSet();
+    ps->clearLastNamedTerm();
+    expr = parseTerm(expr2);
+    bool inUnsatCore = ps->lastNamedTerm().first == expr;
+    cmd.reset(new AssertCommand(expr, inUnsatCore));
+    if (inUnsatCore)
+    {
+      // set the expression name, if there was a named term
+      std::pair<Expr, std::string> namedTerm = ps->lastNamedTerm();
+      Command* csen =
+          new SetExpressionNameCommand(namedTerm.first, namedTerm.second);
+      csen->setMuted(true);
+      ps->preemptCommand(csen);
+    }
+  }
+  else if (cmdName == "check-sat")
+  {
+    ps->checkThatLogicIsSet();
+    if (peekToken() != RPAREN_TOK)
+    {
+      expr = parseTerm(expr2);
+      if (ps->strictModeEnabled())
+      {
+        ps->parseError(
+            "Extended commands (such as check-sat with an argument) are not "
+            "permitted while operating in strict compliance mode.");
+      }
+    }
+    cmd.reset(new CheckSatCommand(expr));
+  }
+  else if (cmdName == "check-sat-assuming")
+  {
+    ps->checkThatLogicIsSet();
+    if (peekToken() != LPAREN_TOK)
+    {
+      ps->parseError(
+          "The check-sat-assuming command expects a "
+          "list of terms.  Perhaps you forgot a pair of "
+          "parentheses?");
+    }
+    nextToken();
+    parseTermList(terms);
+    cmd.reset(new CheckSatAssumingCommand(terms));
+  }
+  else if (cmdName == "get-assertions")
+  {
+    ps->checkThatLogicIsSet();
+    cmd.reset(new GetAssertionsCommand());
+  }
+  else if (cmdName == "get-proof")
+  {
+    ps->checkThatLogicIsSet();
+    cmd.reset(new GetProofCommand());
+  }
+  else if (cmdName == "get-unsat-assumptions")
+  {
+    ps->checkThatLogicIsSet();
+    cmd.reset(new GetUnsatAssumptionsCommand);
+  }
+  else if (cmdName == "get-unsat-core")
+  {
+    ps->checkThatLogicIsSet();
+    cmd.reset(new GetUnsatCoreCommand);
+  }
+  else if (cmdName == "get-model")
+  {
+    ps->checkThatLogicIsSet();
+    cmd.reset(new GetModelCommand());
+  }
+  else if (cmdName == "push" || cmdName == "pop")
+  {
+    ps->checkThatLogicIsSet();
+    cmd.reset(parsePushPop(cmdName == "push"));
+  }
+  else if (cmdName == "echo")
+  {
+    if (peekToken() == RPAREN_TOK)
+    {
+      cmd.reset(new EchoCommand());
+    }
+    else
+    {
+      Token t = nextToken();
+      if (t == LPAREN_TOK || t == KEYWORD_TOK)
+      {
+        ps->parseError("Expected a simple symbolic expression in echo");
+      }
+      cmd.reset(new EchoCommand(mkAtomicSExpr(t).toString()));
+    }
+  }
+  else if (cmdName == "reset" && ps->v2_5())
+  {
+    cmd.reset(new ResetCommand());
+    ps->reset();
+  }
+  else if (cmdName == "reset-assertions")
+  {
+    cmd.reset(new ResetAssertionsCommand());
+    ps->resetAssertions();
+  }
+  else if (cmdName == "exit")
+  {
+    cmd.reset(new QuitCommand());
+  }
+  else if (cmdName == "benchmark")
+  {
+    ps->parseError(
+        "In SMT-LIBv2 mode, but got something that looks like SMT-LIBv1, "
+        "which is not supported anymore.");
+  }
+  else
+  {
+    // handed to the ANTLR parser by parseCommand
+    return nullptr;
+  }
+  if (ps->v2_0() && ps->strictModeEnabled()
+      && (cmdName == "declare-const" || cmdName == "get-model"
+          || cmdName == "echo" || cmdName == "reset"
+          || cmdName == "reset-assertions"))
+  {
+    ps->parseError(
+        "SMT-LIB 2.5 commands are not permitted while operating in strict "
+        "compliance mode and in SMT-LIB 2.0 mode.");
+  }
+  return cmd.release();
+}
+
+Command* Smt2FastInput::parsePushPop(bool isPush)
+{
+  Smt2* ps = d_parser;
+  if (peekToken() != NUMERAL_TOK)
+  {
+    if (ps->strictModeEnabled())
+    {
+      ps->parseError(isPush ? "Strict compliance mode demands an integer to be "
+                              "provided to PUSH.  Maybe you want (push 1)?"
+                            : "Strict compliance mode demands an integer to be "
+                              "provided to POP.Maybe you want (pop 1)?");
+    }
+    if (isPush)
+    {
+      ps->pushScope();
+      return new PushCommand();
+    }
+    ps->popScope();
+    return new PopCommand();
+  }
+  uint64_t n = parseNumeral();
+  if (!isPush && n > ps->scopeLevel())
+  {
+    ps->parseError("Attempted to pop above the top stack frame.");
+  }
+  if (n == 0)
+  {
+    return new EmptyCommand();
+  }
+  std::unique_ptr<CommandSequence> seq(new CommandSequence());
+  for (uint64_t i = 0; i < n; i++)
+  {
+    Command* c;
+    if (isPush)
+    {
+      ps->pushScope();
+      c = new PushCommand();
+    }
+    else
+    {
+      ps->popScope();
+      c = new PopCommand();
+    }
+    if (n == 1)
+    {
+      return c;
+    }
+    c->setMuted(true);
+    seq->addCommand(c);
+  }
+  return seq.release();
+}
+
+/* -------------------------------------------------------------------------- */
+/* Terms                                                                      */
+/* -------------------------------------------------------------------------- */
+
+Expr Smt2FastInput::parseExpr()
+{
+  if (peekToken() == EOF_TOK)
+  {
+    return Expr();
+  }
+  Expr annot;
+  return parseTerm(annot);
+}
+
+Expr Smt2FastInput::parseTerm(Expr& annot)
+{
+  std::vector<TermFrame> stack;
+  Expr expr;
+  for (;;)
+  {
+    if (!parseTermStart(stack, expr, annot))
+    {
+      continue;
+    }
+    // pass the complete term to the frames on the stack
+    while (!stack.empty() && finishSubterm(stack.back(), expr, annot))
+    {
+      stack.pop_back();
+    }
+    if (stack.empty())
+    {
+      return expr;
+    }
+  }
+}
+
+bool Smt2FastInput::parseTermStart(std::vector<TermFrame>& stack,
+                                   Expr& expr,
+                                   Expr& annot)
+{
+  Smt2* ps = d_parser;
+  annot = Expr();
+  Token t = nextToken();
+  if (t != LPAREN_TOK)
+  {
+    expr = mkAtomicTerm(t);
+    return true;
+  }
+  t = nextToken();
+  if (t == SYMBOL_TOK)
+  {
+    if (d_text == "let")
+    {
+      stack.emplace_back(TermFrame::LET);
+      expectToken(LPAREN_TOK);
+      ps->pushScope(true);
+      expectToken(LPAREN_TOK);
+      stack.back().d_name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+      return false;
+    }
+    else if (d_text == "forall" || d_text == "exists")
+    {
+      Kind k = d_text == "forall" ? kind::FORALL : kind::EXISTS;
+      ps->pushScope(true);
+      Expr bvl = parseBoundVarList();
+      stack.emplace_back(TermFrame::QUANT);
+      stack.back().d_quant = k;
+      stack.back().d_bvl = bvl;
+      return false;
+    }
+    else if (d_text == "!")
+    {
+      stack.emplace_back(TermFrame::ATTRIBUTE);
+      return false;
+    }
+    else if (d_text == "_")
+    {
+      // an indexed constant, e.g. (_ bv5 32)
+      if (nextToken() != SYMBOL_TOK)
+      {
+        ps->parseError("Expected an indexed constant");
+      }
+      std::string name = d_text;
+      std::vector<uint64_t> numerals;
+      parseNumeralList(numerals);
+      expr = ps->mkIndexedConstant(name, numerals).getExpr();
+      return true;
+    }
+    else if (d_text == "as")
+    {
+      ParseOp p;
+      parseAscription(p);
+      expr = ps->parseOpToExpr(p);
+      return true;
+    }
+    else if ((d_text == "match"
+              && (ps->v2_6() || ps->sygus())
+              && ps->isTheoryEnabled(Smt2::THEORY_DATATYPES))
+             || (d_text == "lambda" && ps->getLogic().isHigherOrder())
+             || (d_text == "comprehension"
+                 && ps->isTheoryEnabled(Smt2::THEORY_SETS)))
+    {
+      ps->parseError("`" + d_text
+                     + "' terms are not supported by the fast SMT-LIBv2 "
+                       "parser, use the default parser instead");
+    }
+    else if (d_text == "mkTuple"
+             && ps->isTheoryEnabled(Smt2::THEORY_DATATYPES))
+    {
+      stack.emplace_back(TermFrame::APPLY);
+      stack.back().d_op.d_name = "mkTuple";
+      return false;
+    }
+    stack.emplace_back(TermFrame::APPLY);
+    stack.back().d_op.d_name = d_text;
+    return false;
+  }
+  else if (t == QUOTED_SYMBOL_TOK)
+  {
+    stack.emplace_back(TermFrame::APPLY);
+    stack.back().d_op.d_name = d_text;
+    return false;
+  }
+  else if (t == LPAREN_TOK)
+  {
+    // a qualified identifier as the operator of an application
+    stack.emplace_back(TermFrame::APPLY);
+    t = nextToken();
+    if (t == SYMBOL_TOK && d_text == "_")
+    {
+      parseIndexedIdentifier(stack.back().d_op);
+      return false;
+    }
+    else if (t == SYMBOL_TOK && d_text == "as")
+    {
+      parseAscription(stack.back().d_op);
+      return false;
+    }
+  }
+  if (t == EOF_TOK)
+  {
+    ps->unexpectedEOF("Expected a term");
+  }
+  ps->parseError("Expected a term, got " + tokenName(t));
+  return false;
+}
+
+bool Smt2FastInput::finishSubterm(TermFrame& f, Expr& expr, Expr& annot)
+{
+  Smt2* ps = d_parser;
+  switch (f.d_frameKind)
+  {
+    case TermFrame::APPLY:
+      f.d_args.push_back(expr);
+      if (peekToken() != RPAREN_TOK)
+      {
+        return false;
+      }
+      nextToken();
+      if (f.d_op.d_name == "mkTuple" && f.d_op.d_expr.isNull()
+          && ps->isTheoryEnabled(Smt2::THEORY_DATATYPES)
+          && !ps->isDeclared("mkTuple", SYM_VARIABLE))
+      {
+        std::vector<api::Sort> sorts;
+        std::vector<api::Term> terms;
+        for (const Expr& arg : f.d_args)
+        {
+          sorts.emplace_back(arg.getType());
+          terms.emplace_back(arg);
+        }
+        expr = ps->getSolver()->mkTuple(sorts, terms).getExpr();
+      }
+      else
+      {
+        expr = ps->applyParseOp(f.d_op, f.d_args);
+      }
+      annot = Expr();
+      return true;
+    case TermFrame::LET:
+      if (!f.d_inBody)
+      {
+        // this is a parallel let, so we have to save up all the bindings
+        // and define them only after the last one
+        if (!f.d_names.insert(f.d_name).second)
+        {
+          std::stringstream ss;
+          ss << "warning: symbol `" << f.d_name
+             << "' bound multiple times by let;"
+             << " the last binding will be used, shadowing earlier ones";
+          ps->warning(ss.str());
+        }
+        f.d_binders.push_back(std::make_pair(f.d_name, expr));
+        expectToken(RPAREN_TOK);
+        if (peekToken() == LPAREN_TOK)
+        {
+          nextToken();
+          f.d_name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+          return false;
+        }
+        expectToken(RPAREN_TOK);
+        for (const std::pair<std::string, Expr>& binder : f.d_binders)
+        {
+          ps->defineVar(binder.first, binder.second);
+        }
+        f.d_inBody = true;
+        return false;
+      }
+      expectToken(RPAREN_TOK);
+      ps->popScope();
+      annot = Expr();
+      return true;
+    case TermFrame::QUANT:
+    {
+      expectToken(RPAREN_TOK);
+      ps->popScope();
+      std::vector<Expr> args;
+      args.push_back(f.d_bvl);
+      args.push_back(expr);
+      if (!annot.isNull())
+      {
+        args.push_back(annot);
+      }
+      expr = ps->getExprManager()->mkExpr(f.d_quant, args);
+      annot = Expr();
+      return true;
+    }
+    case TermFrame::ATTRIBUTE: parseAttributes(expr, annot); return true;
+  }
+  return true;
+}
+
+void Smt2FastInput::parseAttributes(Expr& expr, Expr& annot)
+{
+  Smt2* ps = d_parser;
+  ExprManager* em = ps->getExprManager();
+  std::vector<Expr> patexprs;
+  bool hasAttribute = false;
+  while (peekToken() != RPAREN_TOK)
+  {
+    hasAttribute = true;
+    std::string attr = parseKeyword();
+    if (attr == ":named")
+    {
+      SExpr sexpr = parseSExpr();
+      Expr func = ps->setNamedAttribute(expr, sexpr);
+      std::string name = sexpr.getValue();
+      // bind name to expr with define-fun
+      Command* c =
+          new DefineNamedFunctionCommand(name, func, std::vector<Expr>(), expr);
+      c->setMuted(true);
+      ps->preemptCommand(c);
+    }
+    else if (attr == ":pattern")
+    {
+      expectToken(LPAREN_TOK);
+      std::vector<Expr> pat;
+      parseTermList(pat);
+      patexprs.push_back(em->mkExpr(kind::INST_PATTERN, pat));
+    }
+    else if (attr == ":no-pattern")
+    {
+      Expr e2;
+      Expr pat = parseTerm(e2);
+      patexprs.push_back(em->mkExpr(kind::INST_NO_PATTERN, pat));
+    }
+    else if (attr == ":quant-inst-max-level" || attr == ":rr-priority")
+    {
+      Expr n = em->mkConst(Rational(parseNumeral()));
+      std::vector<Expr> values;
+      values.push_back(n);
+      std::string attrName = attr.substr(1);
+      Expr avar = ps->mkVar(attrName, em->booleanType());
+      patexprs.push_back(em->mkExpr(kind::INST_ATTRIBUTE, avar));
+      Command* c = new SetUserAttributeCommand(attrName, avar, values);
+      c->setMuted(true);
+      ps->preemptCommand(c);
+    }
+    else if (attr == ":axiom" || attr == ":conjecture")
+    {
+      std::string attrName = attr.substr(1);
+      Expr avar = ps->mkVar(attrName, em->booleanType());
+      patexprs.push_back(em->mkExpr(kind::INST_ATTRIBUTE, avar));
+      Command* c = new SetUserAttributeCommand(attrName, avar);
+      c->setMuted(true);
+      ps->preemptCommand(c);
+    }
+    else if (attr == ":rewrite-rule" || attr == ":fun-def")
+    {
+      ps->parseError("attribute " + attr
+                     + " is not supported by the fast SMT-LIBv2 parser, "
+                       "use the default parser instead");
+    }
+    else
+    {
+      // skip the value of the attribute, if any
+      Token t = peekToken();
+      if (t != RPAREN_TOK && t != KEYWORD_TOK)
+      {
+        parseSExpr();
+      }
+      ps->attributeNotSupported(attr);
+    }
+  }
+  if (!hasAttribute)
+  {
+    ps->parseError("Expected an attribute");
+  }
+  nextToken();
+  if (!patexprs.empty())
+  {
+    if (!annot.isNull() && annot.getKind() == kind::INST_PATTERN_LIST)
+    {
+      for (const Expr& pat : annot)
+      {
+        if (pat.getKind() == kind::INST_PATTERN)
+        {
+          patexprs.push_back(pat);
+        }
+      }
+    }
+    annot = em->mkExpr(kind::INST_PATTERN_LIST, patexprs);
+  }
+}
+
+Expr Smt2FastInput::mkAtomicTerm(Token t)
+{
+  Smt2* ps = d_parser;
+  api::Solver* slv = ps->getSolver();
+  switch (t)
+  {
+    case NUMERAL_TOK: return slv->mkReal(d_text).getExpr();
+    case DECIMAL_TOK:
+      return slv->ensureTermSort(slv->mkReal(d_text), slv->getRealSort())
+          .getExpr();
+    case HEX_TOK: return slv->mkBitVector(d_text.substr(2), 16).getExpr();
+    case BINARY_TOK: return slv->mkBitVector(d_text.substr(2), 2).getExpr();
+    case STRING_TOK: return slv->mkString(d_text, true).getExpr();
+    case SYMBOL_TOK:
+      if (d_text == "mkTuple" && ps->isTheoryEnabled(Smt2::THEORY_DATATYPES)
+          && !ps->isDeclared("mkTuple", SYM_VARIABLE))
+      {
+        return slv
+            ->mkTuple(std::vector<api::Sort>(), std::vector<api::Term>())
+            .getExpr();
+      }
+      CVC4_FALLTHROUGH;
+    case QUOTED_SYMBOL_TOK:
+    {
+      ParseOp p;
+      p.d_name = d_text;
+      return ps->parseOpToExpr(p);
+    }
+    case EOF_TOK: ps->unexpectedEOF("Expected a term"); break;
+    default: ps->parseError("Expected a term, got " + tokenName(t)); break;
+  }
+  return Expr();
+}
+
+void Smt2FastInput::parseTermList(std::vector<Expr>& terms)
+{
+  Expr annot;
+  do
+  {
+    terms.push_back(parseTerm(annot));
+  } while (peekToken() != RPAREN_TOK);
+  nextToken();
+}
+
+void Smt2FastInput::parseIndexedIdentifier(ParseOp& p)
+{
+  Smt2* ps = d_parser;
+  if (nextToken() != SYMBOL_TOK)
+  {
+    ps->parseError("Expected an indexed identifier");
+  }
+  if (d_text == "is" && (ps->v2_6() || ps->sygus())
+      && ps->isTheoryEnabled(Smt2::THEORY_DATATYPES))
+  {
+    Expr f2;
+    Expr f = parseTerm(f2);
+    if (f.getKind() == kind::APPLY_CONSTRUCTOR && f.getNumChildren() == 0)
+    {
+      // for nullary constructors, must get the operator
+      f = f.getOperator();
+    }
+    if (!f.getType().isConstructor())
+    {
+      ps->parseError(
+          "Bad syntax for test (_ is X), X must be a constructor.");
+    }
+    p.d_expr = Datatype::datatypeOf(f)[Datatype::indexOf(f)].getTester();
+    expectToken(RPAREN_TOK);
+  }
+  else if (d_text == "tupSel" && ps->isTheoryEnabled(Smt2::THEORY_DATATYPES))
+  {
+    // we adopt a special syntax (_ tupSel n)
+    p.d_kind = kind::APPLY_SELECTOR;
+    // put n in expr so that the caller can deal with this case
+    p.d_expr = ps->getExprManager()->mkConst(Rational(parseNumeral()));
+    expectToken(RPAREN_TOK);
+  }
+  else
+  {
+    std::string name = d_text;
+    std::vector<uint64_t> numerals;
+    parseNumeralList(numerals);
+    p.d_expr = ps->mkIndexedOp(name, numerals).getExpr();
+  }
+}
+
+void Smt2FastInput::parseAscription(ParseOp& p)
+{
+  Smt2* ps = d_parser;
+  Token t = nextToken();
+  if (t == SYMBOL_TOK && d_text == "const" && !ps->strictModeEnabled())
+  {
+    p.d_kind = kind::STORE_ALL;
+  }
+  else if (t == SYMBOL_TOK || t == QUOTED_SYMBOL_TOK)
+  {
+    p.d_name = d_text;
+  }
+  else if (t == LPAREN_TOK && nextToken() == SYMBOL_TOK && d_text == "_")
+  {
+    parseIndexedIdentifier(p);
+  }
+  else
+  {
+    ps->parseError("Expected an identifier in ascription");
+  }
+  Type type = parseSort();
+  ps->applyTypeAscription(p, type);
+  expectToken(RPAREN_TOK);
+}
+
+/* -------------------------------------------------------------------------- */
+/* Sorts, symbols and symbolic expressions                                    */
+/* -------------------------------------------------------------------------- */
+
+Type Smt2FastInput::parseSort()
+{
+  Smt2* ps = d_parser;
+  ExprManager* em = ps->getExprManager();
+  Token t = nextToken();
+  if (t == SYMBOL_TOK || t == QUOTED_SYMBOL_TOK)
+  {
+    return ps->getSort(d_text);
+  }
+  if (t != LPAREN_TOK)
+  {
+    ps->parseError("Expected a sort, got " + tokenName(t));
+  }
+  t = nextToken();
+  bool indexed = false;
+  if (t == SYMBOL_TOK && d_text == "_")
+  {
+    indexed = true;
+    t = nextToken();
+  }
+  if (t != SYMBOL_TOK && t != QUOTED_SYMBOL_TOK)
+  {
+    ps->parseError("Expected a sort symbol, got " + tokenName(t));
+  }
+  std::string name = d_text;
+  std::vector<Type> args;
+  if (!indexed && name == "->" && ps->getLogic().isHigherOrder())
+  {
+    parseSortList(args);
+    if (args.size() < 2)
+    {
+      ps->parseError("Arrow types must have at least 2 arguments");
+    }
+    // flatten the type
+    Type rangeType = args.back();
+    args.pop_back();
+    return ps->mkFlatFunctionType(args, rangeType);
+  }
+  if (peekToken() == NUMERAL_TOK)
+  {
+    if (!indexed)
+    {
+      std::stringstream ss;
+      ss << "SMT-LIB requires use of an indexed sort here, e.g. (_ " << name
+         << " ...)";
+      ps->parseError(ss.str());
+    }
+    std::vector<uint64_t> numerals;
+    parseNumeralList(numerals);
+    if (name == "BitVec")
+    {
+      if (numerals.size() != 1)
+      {
+        ps->parseError("Illegal bitvector type.");
+      }
+      if (numerals.front() == 0)
+      {
+        ps->parseError("Illegal bitvector size: 0");
+      }
+      return em->mkBitVectorType(numerals.front());
+    }
+    else if (name == "FloatingPoint")
+    {
+      if (numerals.size() != 2)
+      {
+        ps->parseError("Illegal floating-point type.");
+      }
+      if (!validExponentSize(numerals[0]))
+      {
+        ps->parseError("Illegal floating-point exponent size");
+      }
+      if (!validSignificandSize(numerals[1]))
+      {
+        ps->parseError("Illegal floating-point significand size");
+      }
+      return em->mkFloatingPointType(numerals[0], numerals[1]);
+    }
+    std::stringstream ss;
+    ss << "unknown indexed sort symbol `" << name << "'";
+    ps->parseError(ss.str());
+  }
+  parseSortList(args);
+  if (indexed)
+  {
+    std::stringstream ss;
+    ss << "Unexpected use of indexing operator `_' before `" << name
+       << "', try leaving it out";
+    ps->parseError(ss.str());
+  }
+  if (args.empty())
+  {
+    ps->parseError(
+        "Extra parentheses around sort name not "
+        "permitted in SMT-LIB");
+  }
+  else if (name == "Array" && ps->isTheoryEnabled(Smt2::THEORY_ARRAYS))
+  {
+    if (args.size() != 2)
+    {
+      ps->parseError("Illegal array type.");
+    }
+    return em->mkArrayType(args[0], args[1]);
+  }
+  else if (name == "Set" && ps->isTheoryEnabled(Smt2::THEORY_SETS))
+  {
+    if (args.size() != 1)
+    {
+      ps->parseError("Illegal set type.");
+    }
+    return em->mkSetType(args[0]);
+  }
+  else if (name == "Tuple")
+  {
+    return em->mkTupleType(args);
+  }
+  return ps->getSort(name, args);
+}
+
+void Smt2FastInput::parseSortList(std::vector<Type>& sorts)
+{
+  while (peekToken() != RPAREN_TOK)
+  {
+    sorts.push_back(parseSort());
+  }
+  nextToken();
+}
+
+void Smt2FastInput::parseSortedVarList(
+    std::vector<std::pair<std::string, Type>>& vars)
+{
+  while (peekToken() != RPAREN_TOK)
+  {
+    expectToken(LPAREN_TOK);
+    std::string name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    Type t = parseSort();
+    expectToken(RPAREN_TOK);
+    vars.push_back(std::make_pair(name, t));
+  }
+  nextToken();
+}
+
+Expr Smt2FastInput::parseBoundVarList()
+{
+  std::vector<std::pair<std::string, Type>> sortedVarNames;
+  expectToken(LPAREN_TOK);
+  parseSortedVarList(sortedVarNames);
+  std::vector<Expr> args = d_parser->mkBoundVars(sortedVarNames);
+  return d_parser->getExprManager()->mkExpr(kind::BOUND_VAR_LIST, args);
+}
+
+std::string Smt2FastInput::parseSymbol(DeclarationCheck check,
+                                       SymbolType type)
+{
+  Token t = nextToken();
+  if (t != SYMBOL_TOK && t != QUOTED_SYMBOL_TOK)
+  {
+    if (t == EOF_TOK)
+    {
+      d_parser->unexpectedEOF("Expected a symbol");
+    }
+    d_parser->parseError("Expected a symbol, got " + tokenName(t));
+  }
+  if (!d_parser->isAbstractValue(d_text))
+  {
+    // if an abstract value, SmtEngine handles declaration
+    d_parser->checkDeclaration(d_text, check, type);
+  }
+  return d_text;
+}
+
+std::string Smt2FastInput::parseKeyword()
+{
+  Token t = nextToken();
+  if (t != KEYWORD_TOK)
+  {
+    if (t == EOF_TOK)
+    {
+      d_parser->unexpectedEOF("Expected a keyword");
+    }
+    d_parser->parseError("Expected a keyword, got " + tokenName(t));
+  }
+  return d_text;
+}
+
+uint64_t Smt2FastInput::parseNumeral()
+{
+  expectToken(NUMERAL_TOK);
+  std::stringstream ss(d_text);
+  uint64_t result;
+  ss >> result;
+  return result;
+}
+
+void Smt2FastInput::parseNumeralList(std::vector<uint64_t>& numerals)
+{
+  do
+  {
+    numerals.push_back(parseNumeral());
+  } while (peekToken() != RPAREN_TOK);
+  nextToken();
+}
+
+SExpr Smt2FastInput::parseSExpr()
+{
+  Token t = nextToken();
+  if (t != LPAREN_TOK)
+  {
+    return mkAtomicSExpr(t);
+  }
+  // parse the nested lists iteratively
+  std::vector<std::vector<SExpr>> stack(1);
+  for (;;)
+  {
+    t = nextToken();
+    if (t == LPAREN_TOK)
+    {
+      stack.emplace_back();
+    }
+    else if (t == RPAREN_TOK)
+    {
+      SExpr s(stack.back());
+      stack.pop_back();
+      if (stack.empty())
+      {
+        return s;
+      }
+      stack.back().push_back(s);
+    }
+    else
+    {
+      stack.back().push_back(mkAtomicSExpr(t));
+    }
+  }
+}
+
+SExpr Smt2FastInput::mkAtomicSExpr(Token t)
+{
+  switch (t)
+  {
+    case NUMERAL_TOK: return SExpr(Integer(d_text));
+    case DECIMAL_TOK: return SExpr(Rational::fromDecimal(d_text));
+    case HEX_TOK: return SExpr(Integer(d_text.substr(2), 16));
+    case BINARY_TOK: return SExpr(Integer(d_text.substr(2), 2));
+    case STRING_TOK: return SExpr(d_text);
+    case SYMBOL_TOK:
+    case QUOTED_SYMBOL_TOK: return SExpr(SExpr::Keyword(d_text));
+    case KEYWORD_TOK: return SExpr(d_text);
+    case EOF_TOK:
+      d_parser->unexpectedEOF("Expected a symbolic expression");
+      break;
+    default:
+      d_parser->parseError("Expected a symbolic expression, got "
+                           + tokenName(t));
+      break;
+  }
+  return SExpr();
+}
+
+}  // namespace parser
+}  // namespace CVC4
@@ -0,0 +1,296 @@
+/*********************                                                        */
+/*! \file smt2_fast_input.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A hand-written streaming lexer and parser for SMT-LIB 2 inputs
+ **/
+
+#include "cvc4parser_private.h"
+
+#ifndef CVC4__PARSER__SMT2__SMT2_FAST_INPUT_H
+#define CVC4__PARSER__SMT2__SMT2_FAST_INPUT_H
+
+#include <istream>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "expr/expr.h"
+#include "expr/kind.h"
+#include "expr/type.h"
+#include "options/language.h"
+#include "parser/input.h"
+#include "parser/parser.h"
+#include "parser/smt2/parse_op.h"
+#include "util/sexpr.h"
+
+namespace CVC4 {
+
+class Command;
+
+namespace parser {
+
+class Smt2;
+
+/** An input stream of Smt2FastInput, which reads from a std::istream */
+class Smt2FastInputStream : public InputStream
+{
+ public:
+  /** Create an input stream reading the file with the given name */
+  static Smt2FastInputStream* newFileInputStream(const std::string& name);
+  /**
+   * Create an input stream reading from input, which is not owned by the
+   * returned stream. The name is used in error messages.
+   */
+  static Smt2FastInputStream* newStreamInputStream(std::istream& input,
+                                                   const std::string& name);
+  /** Create an input stream reading the string input */
+  static Smt2FastInputStream* newStringInputStream(const std::string& input,
+                                                   const std::string& name);
+
+  /** Get the stream buffer to read from */
+  std::streambuf* getStreamBuffer() { return d_input.rdbuf(); }
+
+ private:
+  Smt2FastInputStream(std::istream* owned,
+                      std::istream& input,
+                      const std::string& name);
+  /** The stream we own, if any */
+  std::unique_ptr<std::istream> d_owned;
+  /** The stream to read from */
+  std::istream& d_input;
+}; /* class Smt2FastInputStream */
+
+/** Smt2FastInput
+ *
+ * An input for the SMT-LIB 2 language that is lexed and parsed by hand,
+ * rather than by the ANTLR-generated Smt2Lexer and Smt2Parser. Characters are
+ * read directly from the stream buffer of the input and tokens are not stored,
+ * so that the memory used by parsing does not depend on the size of the
+ * input. Terms are parsed iteratively using an explicit stack, so that deeply
+ * nested terms (e.g. long chains of let bindings in generated benchmarks) do
+ * not exhaust the call stack.
+ *
+ * Terms and commands are constructed through the same parser state (Smt2) as
+ * by the ANTLR parser, so that symbols, overloading and theory operators are
+ * handled identically. This parser supports the SMT-LIB 2 script commands,
+ * together with declare-const, get-model, echo, reset and reset-assertions.
+ * The text of any other command (e.g. a datatype declaration, a recursive
+ * function definition, include or one of CVC4's extended commands) is handed
+ * to the ANTLR parser, which parses it with the same parser state. Terms that
+ * are only used with these commands (match, lambda and set comprehension
+ * terms, and the attributes of rewrite rules and function definitions) are
+ * reported as not supported by a parse error.
+ */
+class Smt2FastInput : public Input
+{
+ public:
+  /**
+   * Create an input reading from inputStream, which it takes ownership of.
+   * The commands handed to the ANTLR parser are parsed in language lang.
+   */
+  Smt2FastInput(Smt2FastInputStream& inputStream, InputLanguage lang);
+  ~Smt2FastInput() override;
+
+ protected:
+  /**
+   * Parse a command from the input. Returns <code>NULL</code> if
+   * there is no command there to parse.
+   *
+   * @throws ParserException if an error is encountered during parsing.
+   */
+  Command* parseCommand() override;
+
+  /**
+   * Parse an expression from the input. Returns a null
+   * <code>Expr</code> if there is no expression there to parse.
+   *
+   * @throws ParserException if an error is encountered during parsing.
+   */
+  Expr parseExpr() override;
+
+  /** Issue a warning with the current position of the input */
+  void warning(const std::string& msg) override;
+
+  /** Throw a ParserException with the current position of the input */
+  void parseError(const std::string& msg, bool eofException = false) override;
+
+  /** Set the parser state, which must be an Smt2 object */
+  void setParser(Parser& parser) override;
+
+ private:
+  /** The tokens of SMT-LIB 2 */
+  enum Token
+  {
+    LPAREN_TOK,
+    RPAREN_TOK,
+    SYMBOL_TOK,
+    QUOTED_SYMBOL_TOK,
+    KEYWORD_TOK,
+    NUMERAL_TOK,
+    DECIMAL_TOK,
+    HEX_TOK,
+    BINARY_TOK,
+    STRING_TOK,
+    EOF_TOK
+  };
+  /** A partially parsed term, see parseTerm */
+  struct TermFrame
+  {
+    enum FrameKind
+    {
+      /** an application of d_op to d_args */
+      APPLY,
+      /** a let with bindings d_binders, whose body is parsed if d_inBody */
+      LET,
+      /** a quantified formula of kind d_quant with bound variables d_bvl */
+      QUANT,
+      /** an attributed term (! t ...) */
+      ATTRIBUTE
+    };
+    TermFrame(FrameKind k)
+        : d_frameKind(k), d_inBody(false), d_quant(kind::UNDEFINED_KIND)
+    {
+    }
+    FrameKind d_frameKind;
+    ParseOp d_op;
+    std::vector<Expr> d_args;
+    std::vector<std::pair<std::string, Expr>> d_binders;
+    std::unordered_set<std::string> d_names;
+    std::string d_name;
+    bool d_inBody;
+    Kind d_quant;
+    Expr d_bvl;
+  };
+
+  //------------------------- lexer
+  /** Read the next character, updating the position */
+  int getChar();
+  /** Peek at the next character */
+  int peekChar() { return d_buf->sgetc(); }
+  /** Lex the next token of the input, storing its text in d_text */
+  Token lexToken();
+  /** Lex the remainder of a string literal, whose '"' was read */
+  void lexString();
+  /** Get the next token, consuming it */
+  Token nextToken();
+  /** Get the next token, without consuming it */
+  Token peekToken();
+  /** Consume the next token, which must be t */
+  void expectToken(Token t);
+  /** Get a description of token t for error messages */
+  static std::string tokenName(Token t);
+  //------------------------- end lexer
+
+  //------------------------- parser
+  /**
+   * Parse the body of the command cmdName, without its parentheses. Returns
+   * NULL if the command is not supported, without consuming its body.
+   */
+  Command* parseCommandBody(const std::string& cmdName);
+  /**
+   * Hand the command cmdName, whose opening parenthesis is at the given
+   * position of the input and whose name was consumed, to the ANTLR parser,
+   * and return its first command.
+   */
+  Command* delegateCommand(const std::string& cmdName,
+                           unsigned long line,
+                           unsigned long column);
+  /**
+   * Append the text of the remainder of the current command to text, up to
+   * and including its closing parenthesis.
+   */
+  void readCommandText(std::string& text);
+  /**
+   * The line of the input of the error e of the ANTLR parser, which was raised
+   * while parsing the commands it was handed.
+   */
+  unsigned long delegateLine(const ParserException& e) const;
+  /** Parse the body of a push or pop command */
+  Command* parsePushPop(bool isPush);
+  /**
+   * Parse a term, returning its expression and setting annot to its
+   * annotation, if any (for instance, the patterns of an attributed term).
+   */
+  Expr parseTerm(Expr& annot);
+  /**
+   * Parse the beginning of a term. Returns true if this parses a complete
+   * term, which is stored in expr and annot. Otherwise, pushes the partially
+   * parsed term on stack and returns false.
+   */
+  bool parseTermStart(std::vector<TermFrame>& stack, Expr& expr, Expr& annot);
+  /**
+   * Add the complete subterm expr (with annotation annot) to the frame f.
+   * Returns true if this completes the term of f, which is then stored in
+   * expr and annot.
+   */
+  bool finishSubterm(TermFrame& f, Expr& expr, Expr& annot);
+  /** Parse the attributes of the attributed term expr, see ATTRIBUTE */
+  void parseAttributes(Expr& expr, Expr& annot);
+  /** Get the expression of the atomic term of token t */
+  Expr mkAtomicTerm(Token t);
+  /** Parse a list of terms, ending with a closing parenthesis */
+  void parseTermList(std::vector<Expr>& terms);
+  /** Parse an indexed identifier (_ ...), where "(_" was consumed */
+  void parseIndexedIdentifier(ParseOp& p);
+  /** Parse an ascribed identifier (as ...), where "(as" was consumed */
+  void parseAscription(ParseOp& p);
+  /** Parse a sort */
+  Type parseSort();
+  /** Parse a list of sorts, ending with a closing parenthesis */
+  void parseSortList(std::vector<Type>& sorts);
+  /** Parse a list of sorted variables, ending with a closing parenthesis */
+  void parseSortedVarList(std::vector<std::pair<std::string, Type>>& vars);
+  /** Parse a list of sorted variables, and make a bound variable list */
+  Expr parseBoundVarList();
+  /** Parse a symbol, with the given declaration check */
+  std::string parseSymbol(DeclarationCheck check, SymbolType type);
+  /** Parse a keyword, returning its text including the colon */
+  std::string parseKeyword();
+  /** Parse a numeral */
+  uint64_t parseNumeral();
+  /** Parse a non-empty list of numerals, ending with a closing parenthesis */
+  void parseNumeralList(std::vector<uint64_t>& numerals);
+  /** Parse a symbolic expression */
+  SExpr parseSExpr();
+  /** Get the symbolic expression of the atomic token t */
+  SExpr mkAtomicSExpr(Token t);
+  //------------------------- end parser
+
+  /** The parser state */
+  Smt2* d_parser;
+  /** The language of the commands handed to the ANTLR parser */
+  InputLanguage d_lang;
+  /**
+   * The input of the ANTLR parser for the last command it was handed, until
+   * it is exhausted. It yields more than one command for include.
+   */
+  std::unique_ptr<Input> d_delegate;
+  /** The number of lines of the input before the text of d_delegate */
+  unsigned long d_delegateLineOffset;
+  /** The stream buffer we read from */
+  std::streambuf* d_buf;
+  /** The text of the last lexed token */
+  std::string d_text;
+  /** Whether a token was peeked, and which */
+  bool d_hasPeeked;
+  Token d_peeked;
+  /** The current position in the input */
+  unsigned long d_line;
+  unsigned long d_column;
+  /** The position of the start of the last lexed token */
+  unsigned long d_tokLine;
+  unsigned long d_tokColumn;
+}; /* class Smt2FastInput */
+
+}  // namespace parser
+}  // namespace CVC4
+
+#endif /* CVC4__PARSER__SMT2__SMT2_FAST_INPUT_H */
@@ -25,7 +25,13 @@
 #include <cmath>
 #include "base/check.h"
 #include "expr/node_algorithm.h"
+#include "expr/expr_manager.h"
+#include "expr/variable_type_map.h"
 #include "options/options.h"
+#include "options/smt_options.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/rewriter.h"
 
 using namespace CVC4;
 using namespace CVC4::theory;
@@ -38,13 +44,51 @@ namespace passes {
 
 namespace {
 
-void addLemmaForPair(TNode args1,
+/* Return true if all arguments of the function application term are
+ * constants */
+bool hasConstantArgs(TNode term)
+{
+  if (term.getKind() == kind::SELECT)
+  {
+    return term[1].isConst();
+  }
+  for (TNode arg : term)
+  {
+    if (!arg.isConst())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Add the equality of arg1 and arg2 to eqs, unless it rewrites to true.
+ * Returns false if the equality rewrites to false, i.e. if the arguments are
+ * provably distinct. */
+bool addArgEquality(TNode arg1,
+                    TNode arg2,
+                    std::vector<Node>& eqs,
+                    NodeManager* nm)
+{
+  Node eq = nm->mkNode(kind::EQUAL, arg1, arg2);
+  Node req = Rewriter::rewrite(eq);
+  if (req.isConst())
+  {
+    return req.getConst<bool>();
+  }
+  eqs.push_back(eq);
+  return true;
+}
+
+/* Return the lemma for the pair of applications args1 and args2 of func, or
+ * the null node if their arguments are provably distinct, in which case no
+ * lemma is needed. */
+Node getLemmaForPair(TNode args1,
                      TNode args2,
                      const TNode func,
-                     AssertionPipeline* assertionsToPreprocess,
                      NodeManager* nm)
 {
-  Node args_eq;
+  std::vector<Node> eqs;
 
   if (args1.getKind() == kind::APPLY_UF)
   {
@@ -53,19 +97,12 @@ void addLemmaForPair(TNode args1,
     Assert(args1.getNumChildren() == args2.getNumChildren());
     Assert(args1.getNumChildren() >= 1);
 
-    std::vector<Node> eqs(args1.getNumChildren());
-
     for (unsigned i = 0, n = args1.getNumChildren(); i < n; ++i)
     {
-      eqs[i] = nm->mkNode(kind::EQUAL, args1[i], args2[i]);
-    }
-    if (eqs.size() >= 2)
-    {
-      args_eq = nm->mkNode(kind::AND, eqs);
-    }
-    else
-    {
-      args_eq = eqs[0];
+      if (!addArgEquality(args1[i], args2[i], eqs, nm))
+      {
+        return Node::null();
+      }
     }
   }
   else
@@ -74,18 +111,28 @@ void addLemmaForPair(TNode args1,
     Assert(args2.getKind() == kind::SELECT && args2[0] == func);
     Assert(args1.getNumChildren() == 2);
     Assert(args2.getNumChildren() == 2);
-    args_eq = nm->mkNode(kind::EQUAL, args1[1], args2[1]);
+    if (!addArgEquality(args1[1], args2[1], eqs, nm))
+    {
+      return Node::null();
+    }
   }
   Node func_eq = nm->mkNode(kind::EQUAL, args1, args2);
-  Node lemma = nm->mkNode(kind::IMPLIES, args_eq, func_eq);
-  assertionsToPreprocess->push_back(lemma);
+  if (eqs.empty())
+  {
+    /* the arguments are provably equal */
+    return func_eq;
+  }
+  Node args_eq = eqs.size() == 1 ? eqs[0] : nm->mkNode(kind::AND, eqs);
+  return nm->mkNode(kind::IMPLIES, args_eq, func_eq);
 }
 
 void storeFunctionAndAddLemmas(TNode func,
                                TNode term,
                                FunctionToArgsMap& fun_to_args,
+                               FunctionToArgsMap& fun_to_nonconst_args,
                                SubstitutionMap& fun_to_skolem,
-                               AssertionPipeline* assertions,
+                               std::vector<Node>& lemmas,
+                               uint64_t& numPruned,
                                NodeManager* nm,
                                std::vector<TNode>* vec)
 {
@@ -101,12 +148,31 @@ void storeFunctionAndAddLemmas(TNode func,
                                tn,
                                "is a variable created by the ackermannization "
                                "preprocessing pass");
-    for (const auto& t : set)
+    /* Distinct applications whose arguments are all constants have distinct
+     * arguments, hence an application with constant arguments only needs to
+     * be paired with the applications that have a non-constant argument. */
+    bool constArgs = hasConstantArgs(term);
+    TNodeSet& nonConst = fun_to_nonconst_args[func];
+    const TNodeSet& partners = constArgs ? nonConst : set;
+    numPruned += set.size() - partners.size();
+    for (const auto& t : partners)
     {
-      addLemmaForPair(t, term, func, assertions, nm);
+      Node lemma = getLemmaForPair(t, term, func, nm);
+      if (lemma.isNull())
+      {
+        ++numPruned;
+      }
+      else
+      {
+        lemmas.push_back(lemma);
+      }
     }
     fun_to_skolem.addSubstitution(term, skolem);
     set.insert(term);
+    if (!constArgs)
+    {
+      nonConst.insert(term);
+    }
     /* Add the arguments of term (newest element in set) to the vector, so that
      * collectFunctionsAndLemmas will process them as well.
      * This is only needed if the set has at least two elements
@@ -139,9 +205,11 @@ void storeFunctionAndAddLemmas(TNode func,
  * f(g(x))=f(g(y)).
  * Now that we see g(x) and g(y), we explicitly add them as well. */
 void collectFunctionsAndLemmas(FunctionToArgsMap& fun_to_args,
+                               FunctionToArgsMap& fun_to_nonconst_args,
                                SubstitutionMap& fun_to_skolem,
                                std::vector<TNode>* vec,
-                               AssertionPipeline* assertions)
+                               std::vector<Node>& lemmas,
+                               uint64_t& numPruned)
 {
   TNodeSet seen;
   NodeManager* nm = NodeManager::currentNM();
@@ -158,15 +226,24 @@ void collectFunctionsAndLemmas(FunctionToArgsMap& fun_to_args,
         storeFunctionAndAddLemmas(term.getOperator(),
                                   term,
                                   fun_to_args,
+                                  fun_to_nonconst_args,
                                   fun_to_skolem,
-                                  assertions,
+                                  lemmas,
+                                  numPruned,
                                   nm,
                                   vec);
       }
       else if (term.getKind() == kind::SELECT)
       {
-        storeFunctionAndAddLemmas(
-            term[0], term, fun_to_args, fun_to_skolem, assertions, nm, vec);
+        storeFunctionAndAddLemmas(term[0],
+                                  term,
+                                  fun_to_args,
+                                  fun_to_nonconst_args,
+                                  fun_to_skolem,
+                                  lemmas,
+                                  numPruned,
+                                  nm,
+                                  vec);
       }
       else
       {
@@ -295,6 +372,77 @@ Ackermann::Ackermann(PreprocessingPassContext* preprocContext)
 {
 }
 
+Result Ackermann::solveLazy(AssertionPipeline* assertionsToPreprocess,
+                            const std::vector<Node>& lemmas)
+{
+  /* After ackermannization, the assertions contain no function applications,
+   * and variables of uninterpreted sorts are eliminated if bit-vectors are
+   * enabled. */
+  LogicInfo logic = d_logic.getUnlockedCopy();
+  logic.disableTheory(THEORY_ARRAYS);
+  if (logic.isTheoryEnabled(THEORY_BV))
+  {
+    logic.disableTheory(THEORY_UF);
+  }
+  logic.lock();
+
+  NodeManager* nm = NodeManager::currentNM();
+  try
+  {
+    ExprManager em(nm->getOptions());
+    ExprManagerMapCollection vmap;
+    SmtEngine subsmt(&em);
+    subsmt.setIsInternalSubsolver();
+    subsmt.setOption("incremental", SExpr("true"));
+    subsmt.setOption("produce-models", SExpr("true"));
+    subsmt.setOption("ackermann", SExpr("false"));
+    subsmt.setLogic(logic);
+    for (const Node& a : assertionsToPreprocess->ref())
+    {
+      subsmt.assertFormula(a.toExpr().exportTo(&em, vmap));
+    }
+    std::vector<Expr> subLemmas;
+    for (const Node& l : lemmas)
+    {
+      subLemmas.push_back(l.toExpr().exportTo(&em, vmap));
+    }
+    std::vector<bool> added(lemmas.size(), false);
+    while (true)
+    {
+      ++d_statistics.d_numLazyRounds;
+      Result r = subsmt.checkSat().asSatisfiabilityResult();
+      Trace("ackermann") << "Lazy ackermannization: " << r << std::endl;
+      if (r.isSat() != Result::SAT)
+      {
+        return r;
+      }
+      /* add the lemmas violated by the candidate model */
+      size_t numAdded = 0;
+      for (size_t i = 0, size = subLemmas.size(); i < size; ++i)
+      {
+        if (!added[i] && !subsmt.getValue(subLemmas[i]).getConst<bool>())
+        {
+          subsmt.assertFormula(subLemmas[i]);
+          added[i] = true;
+          ++numAdded;
+        }
+      }
+      Trace("ackermann") << "...added " << numAdded << " lemmas" << std::endl;
+      if (numAdded == 0)
+      {
+        return r;
+      }
+      d_statistics.d_numLazyLemmas += numAdded;
+    }
+  }
+  catch (const Exception& e)
+  {
+    Trace("ackermann") << "...lazy ackermannization failed: " << e
+                       << std::endl;
+  }
+  return Result(Result::SAT_UNKNOWN, Result::UNKNOWN_REASON);
+}
+
 PreprocessingPassResult Ackermann::applyInternal(
     AssertionPipeline* assertionsToPreprocess)
 {
@@ -307,8 +455,29 @@ PreprocessingPassResult Ackermann::applyInternal(
   {
     to_process.push_back(a);
   }
-  collectFunctionsAndLemmas(
-      d_funcToArgs, d_funcToSkolem, &to_process, assertionsToPreprocess);
+  std::vector<Node> lemmas;
+  uint64_t numPruned = 0;
+  collectFunctionsAndLemmas(d_funcToArgs,
+                            d_funcToNonConstArgs,
+                            d_funcToSkolem,
+                            &to_process,
+                            lemmas,
+                            numPruned);
+  d_statistics.d_numPrunedPairs += numPruned;
+
+  /* The lazy mode replaces the assertions by their satisfiability, which is
+   * only possible if no model, proof or unsat core is needed. */
+  bool lazy = options::ackermannLazy() && !options::produceModels()
+              && !options::proof() && !options::unsatCores()
+              && !options::unsatCoresAssumptions() && !lemmas.empty();
+  if (!lazy)
+  {
+    for (const Node& lemma : lemmas)
+    {
+      assertionsToPreprocess->push_back(lemma);
+    }
+    d_statistics.d_numLemmas += lemmas.size();
+  }
 
   /* replace applications of UF by skolems */
   // FIXME for model building, github issue #1901
@@ -322,9 +491,56 @@ PreprocessingPassResult Ackermann::applyInternal(
   usortsToBitVectors(
       d_logic, assertionsToPreprocess, d_usortCardinality, d_usVarsToBVVars);
 
+  if (lazy)
+  {
+    for (Node& lemma : lemmas)
+    {
+      lemma = d_usVarsToBVVars.apply(d_funcToSkolem.apply(lemma));
+    }
+    Result r = solveLazy(assertionsToPreprocess, lemmas);
+    if (r.isSat() == Result::SAT_UNKNOWN)
+    {
+      /* fall back to adding all lemmas */
+      for (const Node& lemma : lemmas)
+      {
+        assertionsToPreprocess->push_back(lemma);
+      }
+      d_statistics.d_numLemmas += lemmas.size();
+      return PreprocessingPassResult::NO_CONFLICT;
+    }
+    bool isSat = r.isSat() == Result::SAT;
+    Node res = NodeManager::currentNM()->mkConst(isSat);
+    for (unsigned i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+    {
+      assertionsToPreprocess->replace(i, res);
+    }
+    return isSat ? PreprocessingPassResult::NO_CONFLICT
+                 : PreprocessingPassResult::CONFLICT;
+  }
+
   return PreprocessingPassResult::NO_CONFLICT;
 }
 
+Ackermann::Statistics::Statistics()
+    : d_numLemmas("preprocessing::passes::Ackermann::numLemmas", 0),
+      d_numPrunedPairs("preprocessing::passes::Ackermann::numPrunedPairs", 0),
+      d_numLazyLemmas("preprocessing::passes::Ackermann::numLazyLemmas", 0),
+      d_numLazyRounds("preprocessing::passes::Ackermann::numLazyRounds", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_numLemmas);
+  smtStatisticsRegistry()->registerStat(&d_numPrunedPairs);
+  smtStatisticsRegistry()->registerStat(&d_numLazyLemmas);
+  smtStatisticsRegistry()->registerStat(&d_numLazyRounds);
+}
+
+Ackermann::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numLemmas);
+  smtStatisticsRegistry()->unregisterStat(&d_numPrunedPairs);
+  smtStatisticsRegistry()->unregisterStat(&d_numLazyLemmas);
+  smtStatisticsRegistry()->unregisterStat(&d_numLazyRounds);
+}
+
 /* -------------------------------------------------------------------------- */
 
 }  // namespace passes
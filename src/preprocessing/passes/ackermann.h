@@ -27,9 +27,12 @@
 #define CVC4__PREPROCESSING__PASSES__ACKERMANN_H
 
 #include <unordered_map>
+#include <vector>
 #include "expr/node.h"
 #include "preprocessing/preprocessing_pass.h"
 #include "preprocessing/preprocessing_pass_context.h"
+#include "util/result.h"
+#include "util/statistics_registry.h"
 
 namespace CVC4 {
 namespace preprocessing {
@@ -60,13 +63,47 @@ class Ackermann : public PreprocessingPass
    * - For each uninterpreted sort S, suppose k is the number of variables with
    *   sort S, then for each such variable X, introduce a fresh variable BV_X
    *   with BV with size log_2(k)+1 and use it to replace all occurrences of X.
+   *
+   * Lemmas for pairs whose arguments are provably distinct (e.g. distinct
+   * constants) are not added, and applications whose arguments are all
+   * constants are not paired with each other.
+   *
+   * If --ackermann-lazy is enabled, the lemmas are not added upfront.
+   * Instead, the formula is solved by a subsolver, and the lemmas that are
+   * violated by its candidate model are added to it until it is unsat, or a
+   * model satisfying all lemmas is found.
    */
   PreprocessingPassResult applyInternal(
       AssertionPipeline* assertionsToPreprocess) override;
 
  private:
+  /**
+   * Solve the assertions, to which the lemmas of ackermannization are added
+   * lazily, as described above. Returns the result of the subsolver, which
+   * is unknown if it could not be run or gave up.
+   */
+  Result solveLazy(AssertionPipeline* assertionsToPreprocess,
+                   const std::vector<Node>& lemmas);
+
+  struct Statistics
+  {
+    /** The number of lemmas added by ackermannization */
+    IntStat d_numLemmas;
+    /** The number of pairs of applications for which no lemma is needed */
+    IntStat d_numPrunedPairs;
+    /** The number of lemmas added lazily to the subsolver */
+    IntStat d_numLazyLemmas;
+    /** The number of refinement rounds of the lazy mode */
+    IntStat d_numLazyRounds;
+    Statistics();
+    ~Statistics();
+  };
+
   /* Map each function to a set of terms associated with it */
   FunctionToArgsMap d_funcToArgs;
+  /* Map each function to the subset of its terms that have a non-constant
+   * argument */
+  FunctionToArgsMap d_funcToNonConstArgs;
   /* Map each function-application term to the new Skolem variable created by
    * ackermannization */
   theory::SubstitutionMap d_funcToSkolem;
@@ -76,6 +113,7 @@ class Ackermann : public PreprocessingPass
   /* Map each uninterpreted sort to the number of variables in this sort. */
   USortToBVSizeMap d_usortCardinality;
   LogicInfo d_logic;
+  Statistics d_statistics;
 };
 
 }  // namespace passes
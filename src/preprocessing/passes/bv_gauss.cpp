@@ -265,6 +265,66 @@ BVGauss::Result BVGauss::gaussElim(Integer prime,
   #ifdef CVC4_ASSERTIONS
   for (size_t i = 1; i < nrows; ++i) Assert(lhs[i].size() == ncols);
 #endif
+
+  /* For small moduli, eliminate on machine words rather than Integers, and
+   * on packed bit rows modulo 2. Both compute the same elimination as below,
+   * on a matrix normalized to values modulo prime beforehand. */
+  if (prime.length() <= 32)
+  {
+    Result ret;
+    if (prime == 2)
+    {
+      size_t nwords = (ncols + 1 + 63) / 64;
+      std::vector<std::vector<uint64_t>> rows(
+          nrows, std::vector<uint64_t>(nwords, 0));
+      for (size_t i = 0; i < nrows; ++i)
+      {
+        for (size_t j = 0; j <= ncols; ++j)
+        {
+          const Integer& elem = j < ncols ? lhs[i][j] : rhs[i];
+          if (elem.isBitSet(0))
+          {
+            rows[i][j / 64] |= uint64_t(1) << (j % 64);
+          }
+        }
+      }
+      ret = gaussElimGF2(ncols, rows);
+      for (size_t i = 0; i < nrows; ++i)
+      {
+        for (size_t j = 0; j <= ncols; ++j)
+        {
+          Integer elem((rows[i][j / 64] >> (j % 64)) & 1);
+          (j < ncols ? lhs[i][j] : rhs[i]) = elem;
+        }
+      }
+    }
+    else
+    {
+      uint64_t p = prime.getUnsignedLong();
+      std::vector<uint64_t> wrhs(nrows);
+      std::vector<std::vector<uint64_t>> wlhs(nrows,
+                                              std::vector<uint64_t>(ncols));
+      for (size_t i = 0; i < nrows; ++i)
+      {
+        wrhs[i] = rhs[i].euclidianDivideRemainder(prime).getUnsignedLong();
+        for (size_t j = 0; j < ncols; ++j)
+        {
+          wlhs[i][j] =
+              lhs[i][j].euclidianDivideRemainder(prime).getUnsignedLong();
+        }
+      }
+      ret = gaussElimWord(p, wrhs, wlhs);
+      for (size_t i = 0; i < nrows; ++i)
+      {
+        rhs[i] = Integer(wrhs[i]);
+        for (size_t j = 0; j < ncols; ++j)
+        {
+          lhs[i][j] = Integer(wlhs[i][j]);
+        }
+      }
+    }
+    return ret;
+  }
   /* (1) if element in pivot column is non-zero and != 1, divide row elements
    *     by element in pivot column modulo prime, i.e., multiply row with
    *     multiplicative inverse of element in pivot column modulo prime
@@ -397,6 +457,220 @@ BVGauss::Result BVGauss::gaussElim(Integer prime,
   return BVGauss::Result::UNIQUE;
 }
 
+namespace {
+
+/* Compute the multiplicative inverse of x modulo m, or 0 if x and m are not
+ * coprime. */
+uint64_t modInverseWord(uint64_t x, uint64_t m)
+{
+  int64_t r0 = m, r1 = x, t0 = 0, t1 = 1;
+  while (r1 != 0)
+  {
+    int64_t q = r0 / r1;
+    int64_t r = r0 - q * r1;
+    r0 = r1;
+    r1 = r;
+    int64_t t = t0 - q * t1;
+    t0 = t1;
+    t1 = t;
+  }
+  if (r0 != 1)
+  {
+    return 0;
+  }
+  return t0 < 0 ? t0 + m : t0;
+}
+
+/* Compute x - y modulo m, for x, y < m. */
+inline uint64_t modSubWord(uint64_t x, uint64_t y, uint64_t m)
+{
+  return x >= y ? x - y : x + (m - y);
+}
+
+inline bool testBit(const std::vector<uint64_t>& row, size_t i)
+{
+  return (row[i / 64] >> (i % 64)) & 1;
+}
+
+/* Add row 'from' to row 'to' modulo 2. */
+inline void xorRow(std::vector<uint64_t>& to, const std::vector<uint64_t>& from)
+{
+  for (size_t w = 0, nwords = to.size(); w < nwords; ++w)
+  {
+    to[w] ^= from[w];
+  }
+}
+
+}  // namespace
+
+BVGauss::Result BVGauss::gaussElimWord(uint64_t prime,
+                                       std::vector<uint64_t>& rhs,
+                                       std::vector<std::vector<uint64_t>>& lhs)
+{
+  Assert(prime > 1 && prime <= (uint64_t(1) << 32));
+
+  size_t nrows = lhs.size();
+  size_t ncols = lhs[0].size();
+
+  /* see gaussElim for steps (1) to (3) */
+  for (size_t pcol = 0, prow = 0; pcol < ncols && prow < nrows; ++pcol, ++prow)
+  {
+    for (size_t j = prow; j < nrows; ++j)
+    {
+      /* exchange rows if pivot elem is 0 */
+      if (j == prow)
+      {
+        while (lhs[j][pcol] == 0)
+        {
+          for (size_t k = prow + 1; k < nrows; ++k)
+          {
+            if (lhs[k][pcol] != 0)
+            {
+              std::swap(rhs[j], rhs[k]);
+              std::swap(lhs[j], lhs[k]);
+              break;
+            }
+          }
+          if (pcol >= ncols - 1) break;
+          if (lhs[j][pcol] == 0) pcol += 1;
+        }
+      }
+
+      if (lhs[j][pcol] != 0)
+      {
+        /* (1) */
+        if (lhs[j][pcol] != 1)
+        {
+          uint64_t inv = modInverseWord(lhs[j][pcol], prime);
+          if (inv == 0)
+          {
+            return BVGauss::Result::INVALID; /* not coprime */
+          }
+          for (size_t k = pcol; k < ncols; ++k)
+          {
+            lhs[j][k] = lhs[j][k] * inv % prime;
+            if (j <= prow) continue; /* pivot */
+            lhs[j][k] = modSubWord(lhs[j][k], lhs[prow][k], prime);
+          }
+          rhs[j] = rhs[j] * inv % prime;
+          if (j > prow) { rhs[j] = modSubWord(rhs[j], rhs[prow], prime); }
+        }
+        /* (2) */
+        else if (j != prow)
+        {
+          for (size_t k = pcol; k < ncols; ++k)
+          {
+            lhs[j][k] = modSubWord(lhs[j][k], lhs[prow][k], prime);
+          }
+          rhs[j] = modSubWord(rhs[j], rhs[prow], prime);
+        }
+      }
+    }
+    /* (3) */
+    for (size_t j = 0; j < prow; ++j)
+    {
+      uint64_t mul = lhs[j][pcol];
+      if (mul != 0)
+      {
+        for (size_t k = pcol; k < ncols; ++k)
+        {
+          lhs[j][k] = modSubWord(lhs[j][k], lhs[prow][k] * mul % prime, prime);
+        }
+        rhs[j] = modSubWord(rhs[j], rhs[prow] * mul % prime, prime);
+      }
+    }
+  }
+
+  bool ispart = false;
+  for (size_t i = 0; i < nrows; ++i)
+  {
+    size_t pcol = i;
+    while (pcol < ncols && lhs[i][pcol] == 0) ++pcol;
+    if (pcol >= ncols)
+    {
+      if (rhs[i] != 0)
+      {
+        /* no solution */
+        return BVGauss::Result::NONE;
+      }
+      continue;
+    }
+    for (size_t j = pcol + 1; j < ncols && !ispart; ++j)
+    {
+      ispart = lhs[i][j] != 0;
+    }
+  }
+
+  return ispart ? BVGauss::Result::PARTIAL : BVGauss::Result::UNIQUE;
+}
+
+BVGauss::Result BVGauss::gaussElimGF2(size_t ncols,
+                                      std::vector<std::vector<uint64_t>>& rows)
+{
+  size_t nrows = rows.size();
+
+  /* see gaussElim for steps (2) and (3), modulo 2 every non-zero element is
+   * one and step (1) is not needed */
+  for (size_t pcol = 0, prow = 0; pcol < ncols && prow < nrows; ++pcol, ++prow)
+  {
+    for (size_t j = prow; j < nrows; ++j)
+    {
+      /* exchange rows if pivot elem is 0 */
+      if (j == prow)
+      {
+        while (!testBit(rows[j], pcol))
+        {
+          for (size_t k = prow + 1; k < nrows; ++k)
+          {
+            if (testBit(rows[k], pcol))
+            {
+              std::swap(rows[j], rows[k]);
+              break;
+            }
+          }
+          if (pcol >= ncols - 1) break;
+          if (!testBit(rows[j], pcol)) pcol += 1;
+        }
+      }
+      /* (2), the pivot row has no non-zero elements left of pcol */
+      if (j != prow && testBit(rows[j], pcol))
+      {
+        xorRow(rows[j], rows[prow]);
+      }
+    }
+    /* (3) */
+    for (size_t j = 0; j < prow; ++j)
+    {
+      if (testBit(rows[j], pcol))
+      {
+        xorRow(rows[j], rows[prow]);
+      }
+    }
+  }
+
+  bool ispart = false;
+  for (size_t i = 0; i < nrows; ++i)
+  {
+    size_t pcol = i;
+    while (pcol < ncols && !testBit(rows[i], pcol)) ++pcol;
+    if (pcol >= ncols)
+    {
+      if (testBit(rows[i], ncols))
+      {
+        /* no solution */
+        return BVGauss::Result::NONE;
+      }
+      continue;
+    }
+    for (size_t j = pcol + 1; j < ncols && !ispart; ++j)
+    {
+      ispart = testBit(rows[i], j);
+    }
+  }
+
+  return ispart ? BVGauss::Result::PARTIAL : BVGauss::Result::UNIQUE;
+}
+
 /**
  * Apply Gaussian Elimination on a set of equations modulo some (prime)
  * number given as bit-vector equations.
@@ -94,6 +94,24 @@ class BVGauss : public PreprocessingPass
                           std::vector<Integer>& rhs,
                           std::vector<std::vector<Integer>>& lhs);
 
+  /**
+   * Gaussian Elimination as in gaussElim, on a matrix of machine words whose
+   * elements are normalized to values modulo prime, with prime < 2^32 (such
+   * that products of elements do not overflow).
+   */
+  static Result gaussElimWord(uint64_t prime,
+                              std::vector<uint64_t>& rhs,
+                              std::vector<std::vector<uint64_t>>& lhs);
+
+  /**
+   * Gaussian Elimination as in gaussElim modulo 2, on a matrix whose rows are
+   * packed into 64-bit words, such that row operations are word-level XORs.
+   * The bits 0 to ncols - 1 of a row are its lhs elements and bit ncols is its
+   * rhs element.
+   */
+  static Result gaussElimGF2(size_t ncols,
+                             std::vector<std::vector<uint64_t>>& rows);
+
   static Result gaussElimRewriteForUrem(
       const std::vector<Node>& equations,
       std::unordered_map<Node, Node, NodeHashFunction>& res);
@@ -0,0 +1,642 @@
+/*********************                                                        */
+/*! \file bv_sls.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The BvSls preprocessing pass
+ **
+ ** Runs a word-level stochastic local search on the assertions, before they
+ ** are bit-blasted.
+ **/
+
+#include "preprocessing/passes/bv_sls.h"
+
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "options/bv_options.h"
+#include "options/smt_options.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/evaluator.h"
+#include "theory/rewriter.h"
+#include "util/bitvector.h"
+#include "util/random.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+namespace {
+
+/** The probability of a random value instead of an inverse value */
+const double s_randomValueProb = 0.1;
+
+/** A random bit-vector of the given width */
+BitVector randomBitVector(unsigned width)
+{
+  Random& rnd = Random::getRandom();
+  Integer val(0);
+  for (unsigned bits = 0; bits < width; bits += 32)
+  {
+    val = val.multiplyByPow2(32)
+          + Integer(static_cast<unsigned long>(rnd.rand() & 0xffffffff));
+  }
+  return BitVector(width, val);
+}
+
+/** A random bit-vector in the unsigned range [lo, hi], where lo <= hi */
+BitVector randomBitVector(const BitVector& lo, const BitVector& hi)
+{
+  Integer range = hi.getValue() - lo.getValue() + Integer(1);
+  Integer offset =
+      randomBitVector(lo.getSize() + 1).getValue().floorDivideRemainder(range);
+  return BitVector(lo.getSize(), lo.getValue() + offset);
+}
+
+/**
+ * The state of the local search: the terms of the assertions in post-order,
+ * so that the children of a term come before it, and their current values.
+ */
+class LocalSearch
+{
+ public:
+  LocalSearch() : d_nm(NodeManager::currentNM()) {}
+
+  /**
+   * Compute the terms of the assertions and their initial values. Returns
+   * false if some free symbol is not of Boolean or bit-vector type, or if
+   * some term cannot be evaluated.
+   */
+  bool init(const std::vector<Node>& assertions);
+
+  /**
+   * Do at most maxMoves moves, returns true if the current values satisfy
+   * all assertions. The number of moves done is stored in numMoves.
+   */
+  bool search(uint64_t maxMoves, uint64_t& numMoves);
+
+  /** Get the equalities of the free symbols to their current values */
+  void getModel(std::vector<Node>& eqs) const;
+
+ private:
+  /** Compute the value of term i from the current values of its children */
+  Node evaluate(size_t i) const;
+  /** Set the value of free symbol i, and update the terms that contain it */
+  void assign(size_t i, Node val);
+  /**
+   * Select the child of term i to propagate the target value t to, stored
+   * in child, and the target value of that child, stored in ct. Returns
+   * false if no child of term i contains a free symbol.
+   */
+  bool selectPath(size_t i, Node t, size_t& child, Node& ct);
+  /**
+   * Compute a value of child pos of term i such that term i has value t for
+   * the current values of its other children. Returns null if there is none,
+   * or if the kind of term i is not supported.
+   */
+  Node inverseValue(size_t i, size_t pos, Node t) const;
+  /** A random value of type tn */
+  Node randomValue(TypeNode tn) const;
+
+  /** The node manager */
+  NodeManager* d_nm;
+  /** The evaluator of the terms on the values of their children */
+  theory::Evaluator d_eval;
+  /** The terms in post-order */
+  std::vector<Node> d_terms;
+  /** The index of each term in d_terms */
+  std::unordered_map<Node, size_t, NodeHashFunction> d_index;
+  /** The indices of the children of each term */
+  std::vector<std::vector<size_t>> d_children;
+  /** The indices of the parents of each term */
+  std::vector<std::vector<size_t>> d_parents;
+  /** The current value of each term */
+  std::vector<Node> d_values;
+  /** Whether each term contains a free symbol, the others are fixed */
+  std::vector<bool> d_hasSymbol;
+  /** Whether each term is in the queue of assign() */
+  std::vector<bool> d_queued;
+  /** The indices of the free symbols */
+  std::vector<size_t> d_symbols;
+  /** The indices of the assertions */
+  std::vector<size_t> d_roots;
+};
+
+bool LocalSearch::init(const std::vector<Node>& assertions)
+{
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit(assertions.begin(), assertions.end());
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    if (d_index.find(cur) != d_index.end())
+    {
+      visit.pop_back();
+      continue;
+    }
+    if (visited.insert(cur).second)
+    {
+      visit.insert(visit.end(), cur.begin(), cur.end());
+      continue;
+    }
+    visit.pop_back();
+    size_t i = d_terms.size();
+    d_terms.push_back(cur);
+    d_index[cur] = i;
+    d_children.emplace_back();
+    d_parents.emplace_back();
+    bool hasSymbol = false;
+    for (const Node& c : cur)
+    {
+      size_t ci = d_index[c];
+      d_children[i].push_back(ci);
+      d_parents[ci].push_back(i);
+      hasSymbol = hasSymbol || d_hasSymbol[ci];
+    }
+    Node val;
+    if (cur.isConst())
+    {
+      val = cur;
+    }
+    else if (cur.isVar())
+    {
+      TypeNode tn = cur.getType();
+      if (tn.isBoolean())
+      {
+        val = d_nm->mkConst(false);
+      }
+      else if (tn.isBitVector())
+      {
+        val = d_nm->mkConst(BitVector(tn.getBitVectorSize()));
+      }
+      else
+      {
+        Trace("bv-sls") << "...unsupported symbol " << cur << std::endl;
+        return false;
+      }
+      hasSymbol = true;
+      d_symbols.push_back(i);
+    }
+    else if (cur.getNumChildren() > 0)
+    {
+      val = evaluate(i);
+    }
+    if (val.isNull() || !val.isConst())
+    {
+      Trace("bv-sls") << "...cannot evaluate " << cur << std::endl;
+      return false;
+    }
+    d_values.push_back(val);
+    d_hasSymbol.push_back(hasSymbol);
+    d_queued.push_back(false);
+  }
+  for (const Node& a : assertions)
+  {
+    d_roots.push_back(d_index[a]);
+  }
+  return true;
+}
+
+Node LocalSearch::evaluate(size_t i) const
+{
+  TNode n = d_terms[i];
+  NodeBuilder<> nb(n.getKind());
+  if (n.getMetaKind() == kind::metakind::PARAMETERIZED)
+  {
+    nb << n.getOperator();
+  }
+  for (size_t c : d_children[i])
+  {
+    nb << d_values[c];
+  }
+  Node nc = nb;
+  // the evaluator falls back to the rewriter on the kinds it does not support
+  return d_eval.eval(nc, std::vector<Node>(), std::vector<Node>());
+}
+
+void LocalSearch::assign(size_t i, Node val)
+{
+  d_values[i] = val;
+  // the terms are updated in post-order, so each term is evaluated once
+  std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> queue;
+  for (size_t p : d_parents[i])
+  {
+    if (!d_queued[p])
+    {
+      d_queued[p] = true;
+      queue.push(p);
+    }
+  }
+  while (!queue.empty())
+  {
+    size_t j = queue.top();
+    queue.pop();
+    d_queued[j] = false;
+    Node v = evaluate(j);
+    Assert(v.isConst());
+    if (v == d_values[j])
+    {
+      continue;
+    }
+    d_values[j] = v;
+    for (size_t p : d_parents[j])
+    {
+      if (!d_queued[p])
+      {
+        d_queued[p] = true;
+        queue.push(p);
+      }
+    }
+  }
+}
+
+bool LocalSearch::search(uint64_t maxMoves, uint64_t& numMoves)
+{
+  Random& rnd = Random::getRandom();
+  Node trueNode = d_nm->mkConst(true);
+  std::vector<size_t> unsat;
+  for (numMoves = 0;; ++numMoves)
+  {
+    unsat.clear();
+    for (size_t r : d_roots)
+    {
+      if (d_values[r] != trueNode)
+      {
+        unsat.push_back(r);
+      }
+    }
+    if (unsat.empty())
+    {
+      return true;
+    }
+    if (numMoves == maxMoves)
+    {
+      return false;
+    }
+    // propagate the target value of an unsatisfied assertion down a path to
+    // a free symbol
+    size_t cur = unsat[rnd.pick(0, unsat.size() - 1)];
+    Node t = trueNode;
+    while (d_values[cur] != t && !d_terms[cur].isVar())
+    {
+      size_t child;
+      Node ct;
+      if (!selectPath(cur, t, child, ct))
+      {
+        break;
+      }
+      cur = child;
+      t = ct;
+    }
+    if (d_terms[cur].isVar() && d_values[cur] != t)
+    {
+      Trace("bv-sls-debug") << "move " << numMoves << ": " << d_terms[cur]
+                            << " := " << t << std::endl;
+      assign(cur, t);
+    }
+  }
+}
+
+void LocalSearch::getModel(std::vector<Node>& eqs) const
+{
+  for (size_t i : d_symbols)
+  {
+    eqs.push_back(d_terms[i].eqNode(d_values[i]));
+  }
+}
+
+bool LocalSearch::selectPath(size_t i, Node t, size_t& child, Node& ct)
+{
+  TNode n = d_terms[i];
+  Kind k = n.getKind();
+  const std::vector<size_t>& children = d_children[i];
+  Random& rnd = Random::getRandom();
+  std::vector<size_t> cand;
+  for (size_t pos = 0, size = children.size(); pos < size; ++pos)
+  {
+    if (d_hasSymbol[children[pos]])
+    {
+      cand.push_back(pos);
+    }
+  }
+  if (cand.empty())
+  {
+    return false;
+  }
+
+  if (k == kind::AND || k == kind::OR)
+  {
+    // unless the target is the controlling value, all children must have
+    // the target value, so select one that does not
+    if (t.getConst<bool>() == (k == kind::AND))
+    {
+      std::vector<size_t> wrong;
+      for (size_t pos : cand)
+      {
+        if (d_values[children[pos]] != t)
+        {
+          wrong.push_back(pos);
+        }
+      }
+      if (wrong.empty())
+      {
+        return false;
+      }
+      cand.swap(wrong);
+    }
+    child = children[cand[rnd.pick(0, cand.size() - 1)]];
+    ct = t;
+    return true;
+  }
+  if (k == kind::NOT)
+  {
+    child = children[0];
+    ct = d_nm->mkConst(!t.getConst<bool>());
+    return true;
+  }
+  if (k == kind::ITE)
+  {
+    bool cond = d_values[children[0]].getConst<bool>();
+    size_t sel = children[cond ? 1 : 2];
+    size_t other = children[cond ? 2 : 1];
+    bool flipCond = d_hasSymbol[children[0]]
+                    && (!d_hasSymbol[sel]
+                        || (d_values[other] == t && rnd.pickWithProb(0.5)));
+    if (flipCond)
+    {
+      child = children[0];
+      ct = d_nm->mkConst(!cond);
+      return true;
+    }
+    if (!d_hasSymbol[sel])
+    {
+      return false;
+    }
+    child = sel;
+    ct = t;
+    return true;
+  }
+
+  size_t pos = cand[rnd.pick(0, cand.size() - 1)];
+  child = children[pos];
+  ct = Node::null();
+  // occasional random values avoid cycling between the same values
+  if (!rnd.pickWithProb(s_randomValueProb))
+  {
+    ct = inverseValue(i, pos, t);
+  }
+  if (ct.isNull())
+  {
+    ct = randomValue(d_terms[child].getType());
+  }
+  return true;
+}
+
+Node LocalSearch::inverseValue(size_t i, size_t pos, Node t) const
+{
+  TNode n = d_terms[i];
+  Kind k = n.getKind();
+  const std::vector<size_t>& children = d_children[i];
+  size_t nchildren = children.size();
+
+  if ((k == kind::EQUAL || k == kind::XOR) && nchildren == 2)
+  {
+    Node s = d_values[children[1 - pos]];
+    if (t.getConst<bool>() == (k == kind::EQUAL))
+    {
+      return s;
+    }
+    if (s.getType().isBoolean())
+    {
+      return d_nm->mkConst(!s.getConst<bool>());
+    }
+    const BitVector& sv = s.getConst<BitVector>();
+    BitVector r = randomBitVector(sv.getSize());
+    return d_nm->mkConst(r == sv ? r + BitVector(sv.getSize(), 1u) : r);
+  }
+
+  if (k == kind::BITVECTOR_ULT || k == kind::BITVECTOR_ULE
+      || k == kind::BITVECTOR_UGT || k == kind::BITVECTOR_UGE
+      || k == kind::BITVECTOR_SLT || k == kind::BITVECTOR_SLE
+      || k == kind::BITVECTOR_SGT || k == kind::BITVECTOR_SGE)
+  {
+    bool isSigned = k == kind::BITVECTOR_SLT || k == kind::BITVECTOR_SLE
+                    || k == kind::BITVECTOR_SGT || k == kind::BITVECTOR_SGE;
+    bool isStrict = k == kind::BITVECTOR_ULT || k == kind::BITVECTOR_UGT
+                    || k == kind::BITVECTOR_SLT || k == kind::BITVECTOR_SGT;
+    bool isLess = (k == kind::BITVECTOR_ULT || k == kind::BITVECTOR_ULE
+                   || k == kind::BITVECTOR_SLT || k == kind::BITVECTOR_SLE)
+                  == (pos == 0);
+    if (!t.getConst<bool>())
+    {
+      // not (x < s) is x >= s, and not (x <= s) is x > s
+      isLess = !isLess;
+      isStrict = !isStrict;
+    }
+    BitVector s = d_values[children[1 - pos]].getConst<BitVector>();
+    unsigned w = s.getSize();
+    // the signed order is the unsigned order with the sign bit flipped
+    BitVector flip = isSigned ? BitVector::mkMinSigned(w) : BitVector(w);
+    s = s ^ flip;
+    BitVector zero(w), ones = BitVector::mkOnes(w);
+    BitVector r;
+    if (isLess)
+    {
+      if (isStrict && s == zero)
+      {
+        return Node::null();
+      }
+      r = randomBitVector(zero, isStrict ? s - BitVector(w, 1u) : s);
+    }
+    else
+    {
+      if (isStrict && s == ones)
+      {
+        return Node::null();
+      }
+      r = randomBitVector(isStrict ? s + BitVector(w, 1u) : s, ones);
+    }
+    return d_nm->mkConst(r ^ flip);
+  }
+
+  if (!t.getType().isBitVector())
+  {
+    return Node::null();
+  }
+  const BitVector& tv = t.getConst<BitVector>();
+  unsigned w = tv.getSize();
+  switch (k)
+  {
+    case kind::BITVECTOR_NOT: return d_nm->mkConst(~tv);
+    case kind::BITVECTOR_NEG: return d_nm->mkConst(-tv);
+    case kind::BITVECTOR_PLUS:
+    case kind::BITVECTOR_XOR:
+    {
+      BitVector r = tv;
+      for (size_t j = 0; j < nchildren; ++j)
+      {
+        if (j != pos)
+        {
+          const BitVector& s = d_values[children[j]].getConst<BitVector>();
+          r = k == kind::BITVECTOR_PLUS ? r - s : r ^ s;
+        }
+      }
+      return d_nm->mkConst(r);
+    }
+    case kind::BITVECTOR_SUB:
+    {
+      const BitVector& s = d_values[children[1 - pos]].getConst<BitVector>();
+      return d_nm->mkConst(pos == 0 ? tv + s : s - tv);
+    }
+    case kind::BITVECTOR_AND:
+    case kind::BITVECTOR_OR:
+    {
+      bool isAnd = k == kind::BITVECTOR_AND;
+      BitVector s = isAnd ? BitVector::mkOnes(w) : BitVector(w);
+      for (size_t j = 0; j < nchildren; ++j)
+      {
+        if (j != pos)
+        {
+          const BitVector& sj = d_values[children[j]].getConst<BitVector>();
+          s = isAnd ? s & sj : s | sj;
+        }
+      }
+      // the bits not controlled by the other children are those of t, the
+      // others are free (they are those of t if t is reachable at all)
+      BitVector free = randomBitVector(w);
+      return d_nm->mkConst(isAnd ? (tv & s) | (free & ~s)
+                                 : (tv & ~s) | (free & s & tv));
+    }
+    case kind::BITVECTOR_MULT:
+    {
+      BitVector s(w, 1u);
+      for (size_t j = 0; j < nchildren; ++j)
+      {
+        if (j != pos)
+        {
+          s = s * d_values[children[j]].getConst<BitVector>();
+        }
+      }
+      if (!s.isBitSet(0))
+      {
+        // an even factor has no inverse
+        return Node::null();
+      }
+      Integer inv = s.getValue().modInverse(Integer(1).multiplyByPow2(w));
+      return d_nm->mkConst(BitVector(w, tv.getValue() * inv));
+    }
+    case kind::BITVECTOR_CONCAT:
+    {
+      // the first child holds the most significant bits
+      unsigned low = 0;
+      for (size_t j = pos + 1; j < nchildren; ++j)
+      {
+        low += d_terms[children[j]].getType().getBitVectorSize();
+      }
+      unsigned cw = d_terms[children[pos]].getType().getBitVectorSize();
+      return d_nm->mkConst(tv.extract(low + cw - 1, low));
+    }
+    case kind::BITVECTOR_EXTRACT:
+    {
+      const BitVectorExtract& ext =
+          n.getOperator().getConst<BitVectorExtract>();
+      const BitVector& v = d_values[children[0]].getConst<BitVector>();
+      unsigned cw = v.getSize();
+      BitVector r = tv;
+      if (ext.low > 0)
+      {
+        r = r.concat(v.extract(ext.low - 1, 0));
+      }
+      if (ext.high + 1 < cw)
+      {
+        r = v.extract(cw - 1, ext.high + 1).concat(r);
+      }
+      return d_nm->mkConst(r);
+    }
+    case kind::BITVECTOR_ZERO_EXTEND:
+    case kind::BITVECTOR_SIGN_EXTEND:
+    {
+      unsigned cw = d_terms[children[0]].getType().getBitVectorSize();
+      return d_nm->mkConst(tv.extract(cw - 1, 0));
+    }
+    default: return Node::null();
+  }
+}
+
+Node LocalSearch::randomValue(TypeNode tn) const
+{
+  if (tn.isBoolean())
+  {
+    return d_nm->mkConst(Random::getRandom().pickWithProb(0.5));
+  }
+  Assert(tn.isBitVector());
+  return d_nm->mkConst(randomBitVector(tn.getBitVectorSize()));
+}
+
+}  // namespace
+
+BvSls::BvSls(PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "bv-sls"){};
+
+PreprocessingPassResult BvSls::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  LocalSearch ls;
+  if (!ls.init(assertionsToPreprocess->ref()))
+  {
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
+  uint64_t numMoves = 0;
+  bool found = ls.search(options::bvSls(), numMoves);
+  d_statistics.d_numMoves += numMoves;
+  Trace("bv-sls") << "...moves: " << numMoves << ", found model: " << found
+                  << std::endl;
+  if (!found)
+  {
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
+  ++d_statistics.d_numSolved;
+
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<Node> eqs;
+  if (options::produceModels())
+  {
+    ls.getModel(eqs);
+  }
+  for (size_t i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+  {
+    Node a = nm->mkConst(true);
+    if (i == 0 && !eqs.empty())
+    {
+      a = theory::Rewriter::rewrite(
+          eqs.size() == 1 ? eqs[0] : nm->mkNode(kind::AND, eqs));
+    }
+    assertionsToPreprocess->replace(i, a);
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+BvSls::Statistics::Statistics()
+    : d_numMoves("preprocessing::passes::BvSls::numMoves", 0),
+      d_numSolved("preprocessing::passes::BvSls::numSolved", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_numMoves);
+  smtStatisticsRegistry()->registerStat(&d_numSolved);
+}
+
+BvSls::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numMoves);
+  smtStatisticsRegistry()->unregisterStat(&d_numSolved);
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
@@ -0,0 +1,75 @@
+/*********************                                                        */
+/*! \file bv_sls.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The BvSls preprocessing pass
+ **
+ ** Runs a word-level stochastic local search on the assertions, before they
+ ** are bit-blasted.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PASSES__BV_SLS_H
+#define CVC4__PREPROCESSING__PASSES__BV_SLS_H
+
+#include "preprocessing/preprocessing_pass.h"
+#include "preprocessing/preprocessing_pass_context.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+/**
+ * This pass searches for a model of the assertions with a propagation-based
+ * local search on the values of the free symbols, which must be of Boolean or
+ * bit-vector type (Niemetz, Preiner and Biere, "Propagation Based Local
+ * Search for Bit-Precise Reasoning", FMSD 2017). Each move picks an
+ * unsatisfied assertion and propagates the value it should have down a path
+ * to a free symbol, computing at each operator a value of the selected
+ * operand that gives the operator its target value for the current values of
+ * the other operands (or a random value if there is none). The values of the
+ * terms are kept up to date bottom up with the Evaluator.
+ *
+ * The search stops after options::bvSls() moves. If it finds a model, all
+ * assertions are replaced by true or, if models are produced, by the
+ * equalities of the free symbols to their values. Otherwise the assertions
+ * are unchanged.
+ *
+ * This is only sound for non-incremental, quantifier-free queries whose
+ * assertions are the whole problem. The caller must ensure this.
+ */
+class BvSls : public PreprocessingPass
+{
+ public:
+  BvSls(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  struct Statistics
+  {
+    /** number of moves done by the local search */
+    IntStat d_numMoves;
+    /** number of queries for which the local search found a model */
+    IntStat d_numSolved;
+    Statistics();
+    ~Statistics();
+  };
+
+  Statistics d_statistics;
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
+
+#endif /* CVC4__PREPROCESSING__PASSES__BV_SLS_H */
@@ -0,0 +1,246 @@
+/*********************                                                        */
+/*! \file cardinality_constraints.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The cardinality constraints preprocessing pass
+ **
+ ** Hands the cardinality constraints over Boolean-valued ITEs to the SAT
+ ** solver.
+ **/
+
+#include "preprocessing/passes/cardinality_constraints.h"
+
+#include "options/smt_options.h"
+#include "prop/prop_engine.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/rewriter.h"
+
+using namespace CVC4::kind;
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+CardinalityConstraints::CardinalityConstraints(
+    PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "cardinality-constraints"){};
+
+PreprocessingPassResult CardinalityConstraints::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  if (!d_preprocContext->getPropEngine()->nativeCardinality())
+  {
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
+  NodeManager::currentResourceManager()->spendResource(
+      ResourceManager::Resource::PreprocessStep, options::preprocessStep());
+
+  for (size_t i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+  {
+    Node a = (*assertionsToPreprocess)[i];
+    Node r = replaceAtoms(a);
+    if (r != a)
+    {
+      assertionsToPreprocess->replace(i, theory::Rewriter::rewrite(r));
+    }
+  }
+  for (const Node& def : d_definitions)
+  {
+    assertionsToPreprocess->push_back(def);
+  }
+  d_cache.clear();
+  d_condVars.clear();
+  d_definitions.clear();
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+Node CardinalityConstraints::replaceAtoms(TNode n)
+{
+  std::unordered_map<Node, Node, NodeHashFunction>::iterator it =
+      d_cache.find(n);
+  if (it != d_cache.end())
+  {
+    return it->second;
+  }
+  Node ret = n;
+  Kind k = n.getKind();
+  if (k == GEQ || (k == EQUAL && n[0].getType().isReal()))
+  {
+    Node r = replaceAtom(n);
+    if (!r.isNull())
+    {
+      ret = r;
+    }
+  }
+  else if (k == NOT || k == AND || k == OR || k == IMPLIES || k == XOR
+           || (k == ITE && n.getType().isBoolean())
+           || (k == EQUAL && n[0].getType().isBoolean()))
+  {
+    NodeBuilder<> nb(k);
+    bool changed = false;
+    for (const Node& child : n)
+    {
+      Node rc = replaceAtoms(child);
+      changed = changed || rc != child;
+      nb << rc;
+    }
+    if (changed)
+    {
+      ret = nb;
+    }
+  }
+  d_cache[n] = ret;
+  return ret;
+}
+
+Node CardinalityConstraints::replaceAtom(TNode atom)
+{
+  std::vector<Node> lits;
+  Rational constant;
+  if (!addTerm(atom[0], Rational(1), lits, constant)
+      || !addTerm(atom[1], Rational(-1), lits, constant) || lits.size() < 2)
+  {
+    return Node::null();
+  }
+  Trace("cardinality-constraints")
+      << "CardinalityConstraints: " << atom << std::endl;
+  // the atom is (~ (+ lits) (- constant)) where ~ is >= or =
+  NodeManager* nm = NodeManager::currentNM();
+  Rational bound = -constant;
+  Integer n(lits.size());
+  if (atom.getKind() == EQUAL && !bound.isIntegral())
+  {
+    return nm->mkConst(false);
+  }
+  Integer k = bound.ceiling();
+  // (>= (+ lits) k)
+  Node geq = k <= 0 ? nm->mkConst(true)
+                    : (k > n ? nm->mkConst(false)
+                             : mkConstraint(lits, k.getUnsignedInt()));
+  if (atom.getKind() == GEQ)
+  {
+    return geq;
+  }
+  // (= (+ lits) k) is (and (>= (+ lits) k) (not (>= (+ lits) (+ k 1))))
+  k += 1;
+  Node gt = k <= 0 ? nm->mkConst(true)
+                   : (k > n ? nm->mkConst(false)
+                            : mkConstraint(lits, k.getUnsignedInt()));
+  return nm->mkNode(AND, geq, gt.notNode());
+}
+
+bool CardinalityConstraints::addTerm(TNode n,
+                                     const Rational& coeff,
+                                     std::vector<Node>& lits,
+                                     Rational& constant)
+{
+  switch (n.getKind())
+  {
+    case CONST_RATIONAL:
+      constant += coeff * n.getConst<Rational>();
+      return true;
+    case PLUS:
+      for (const Node& child : n)
+      {
+        if (!addTerm(child, coeff, lits, constant))
+        {
+          return false;
+        }
+      }
+      return true;
+    case MULT:
+      return n.getNumChildren() == 2 && n[0].getKind() == CONST_RATIONAL
+             && addTerm(
+                    n[1], coeff * n[0].getConst<Rational>(), lits, constant);
+    case ITE:
+    {
+      if (n[1].getKind() != CONST_RATIONAL || n[2].getKind() != CONST_RATIONAL)
+      {
+        return false;
+      }
+      // (ite c a b) is b + (a - b) * c
+      const Rational& b = n[2].getConst<Rational>();
+      Rational c = coeff * (n[1].getConst<Rational>() - b);
+      constant += coeff * b;
+      if (c.isZero())
+      {
+        return true;
+      }
+      Node lit = mkLiteral(n[0]);
+      if (c == Rational(1))
+      {
+        lits.push_back(lit);
+      }
+      else if (c == Rational(-1))
+      {
+        // -c is (not c) - 1
+        lits.push_back(lit.getKind() == NOT ? lit[0] : lit.notNode());
+        constant -= 1;
+      }
+      else
+      {
+        return false;
+      }
+      return true;
+    }
+    default: return false;
+  }
+}
+
+Node CardinalityConstraints::mkLiteral(TNode cond)
+{
+  TNode atom = cond.getKind() == NOT ? cond[0] : cond;
+  if (atom.isVar())
+  {
+    return cond;
+  }
+  std::unordered_map<Node, Node, NodeHashFunction>::iterator it =
+      d_condVars.find(cond);
+  if (it != d_condVars.end())
+  {
+    return it->second;
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  Node v = nm->mkSkolem("pbc",
+                        nm->booleanType(),
+                        "a condition of a cardinality constraint");
+  d_condVars[cond] = v;
+  d_definitions.push_back(v.eqNode(cond));
+  return v;
+}
+
+Node CardinalityConstraints::mkConstraint(const std::vector<Node>& lits,
+                                          unsigned k)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  Node p = nm->mkSkolem("pb", nm->booleanType(), "a cardinality constraint");
+  d_preprocContext->getPropEngine()->addCardinalityConstraint(p, lits, k);
+  ++d_statistics.d_numConstraints;
+  d_statistics.d_numLiterals += lits.size();
+  return p;
+}
+
+CardinalityConstraints::Statistics::Statistics()
+    : d_numConstraints(
+          "preprocessing::passes::CardinalityConstraints::numConstraints", 0),
+      d_numLiterals(
+          "preprocessing::passes::CardinalityConstraints::numLiterals", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_numConstraints);
+  smtStatisticsRegistry()->registerStat(&d_numLiterals);
+}
+
+CardinalityConstraints::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numConstraints);
+  smtStatisticsRegistry()->unregisterStat(&d_numLiterals);
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
@@ -0,0 +1,115 @@
+/*********************                                                        */
+/*! \file cardinality_constraints.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The cardinality constraints preprocessing pass
+ **
+ ** Hands the cardinality constraints over Boolean-valued ITEs to the SAT
+ ** solver.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PASSES__CARDINALITY_CONSTRAINTS_H
+#define CVC4__PREPROCESSING__PASSES__CARDINALITY_CONSTRAINTS_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "preprocessing/preprocessing_pass.h"
+#include "preprocessing/preprocessing_pass_context.h"
+#include "util/rational.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+/**
+ * This pass recognizes the arithmetic atoms that compare a sum of
+ * Boolean-valued ITEs, i.e. terms (ite c a b) where a - b is 1 or -1, to a
+ * constant, such as
+ *   (>= (+ (ite c1 1 0) (ite c2 1 0) (* -1 (ite c3 1 0))) k).
+ * Each such inequality is equivalent to "at least k' of the literals l1 ...
+ * ln are true", where li is ci or its negation. The pass replaces it by a
+ * fresh Boolean variable p, and adds the constraint p <=> (at least k' of l1
+ * ... ln are true) to the SAT solver, which propagates it natively with
+ * counters instead of sending the sum to the simplex solver. An equality is
+ * replaced by the conjunction of two inequalities.
+ *
+ * The literals given to the SAT solver are Boolean variables: a condition
+ * that is not a variable is replaced by a fresh variable v, and the
+ * definition (= v c) is added to the assertions.
+ *
+ * The constraints are never removed from the SAT solver, and their variables
+ * must not be substituted by later simplifications. Hence this pass is only
+ * sound if it runs after the simplifications, in non-incremental mode. The
+ * caller must ensure this. The pass does nothing if the SAT solver does not
+ * support native cardinality constraints.
+ */
+class CardinalityConstraints : public PreprocessingPass
+{
+ public:
+  CardinalityConstraints(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  /**
+   * Returns n with the cardinality atoms in its Boolean structure replaced.
+   */
+  Node replaceAtoms(TNode n);
+  /**
+   * Returns the replacement of the arithmetic atom atom, or null if it is
+   * not a cardinality constraint.
+   */
+  Node replaceAtom(TNode atom);
+  /**
+   * Adds coeff * n to the sum of the literals lits plus constant. Returns
+   * false if n is not a sum of Boolean-valued ITEs and constants.
+   */
+  bool addTerm(TNode n,
+               const Rational& coeff,
+               std::vector<Node>& lits,
+               Rational& constant);
+  /** Returns the literal for the condition of a Boolean-valued ITE */
+  Node mkLiteral(TNode cond);
+  /**
+   * Returns the variable defined by the constraint (at least k of lits are
+   * true) added to the SAT solver.
+   */
+  Node mkConstraint(const std::vector<Node>& lits, unsigned k);
+
+  /** The replacements of the nodes of the current application */
+  std::unordered_map<Node, Node, NodeHashFunction> d_cache;
+  /** The variables for the conditions that are not variables */
+  std::unordered_map<Node, Node, NodeHashFunction> d_condVars;
+  /** The definitions of the variables of d_condVars to assert */
+  std::vector<Node> d_definitions;
+
+  struct Statistics
+  {
+    /** number of cardinality constraints added to the SAT solver */
+    IntStat d_numConstraints;
+    /** number of literals of these constraints */
+    IntStat d_numLiterals;
+    Statistics();
+    ~Statistics();
+  };
+
+  Statistics d_statistics;
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
+
+#endif /* CVC4__PREPROCESSING__PASSES__CARDINALITY_CONSTRAINTS_H */
@@ -13,16 +13,24 @@
  **
  ** Converts integer operations into bitvector operations. The width of the
  ** bitvectors is controlled through the `--solve-int-as-bv` command line
- ** option.
+ ** option. With `--solve-int-as-bv-ranges`, the variables that are bounded by
+ ** the top-level assertions are given the smallest width fitting their range,
+ ** and the width of the arithmetic terms is derived from their range.
  **/
 
 #include "preprocessing/passes/int_to_bv.h"
 
+#include <algorithm>
+#include <map>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "expr/node.h"
+#include "options/smt_options.h"
+#include "theory/arith/arith_msum.h"
+#include "theory/bv/theory_bv_utils.h"
 #include "theory/rewriter.h"
 #include "theory/theory.h"
 
@@ -36,6 +44,221 @@ using NodeMap = std::unordered_map<Node, Node, NodeHashFunction>;
 
 namespace {
 
+/** A non-empty interval of integers */
+struct IntToBVInterval
+{
+  Integer d_lower;
+  Integer d_upper;
+  IntToBVInterval() {}
+  IntToBVInterval(const Integer& lower, const Integer& upper)
+      : d_lower(lower), d_upper(upper)
+  {
+  }
+}; /* struct IntToBVInterval */
+
+using NodeIntegerMap = std::unordered_map<Node, Integer, NodeHashFunction>;
+using NodeIntervalMap =
+    std::unordered_map<Node, IntToBVInterval, NodeHashFunction>;
+
+/** The smallest width of a signed bit-vector that can represent value */
+unsigned intToBVSignedWidth(const Integer& value)
+{
+  Integer magnitude = value.sgn() < 0 ? -value - Integer(1) : value;
+  return magnitude.sgn() == 0 ? 1 : magnitude.length() + 1;
+}
+
+/** The smallest width of a signed bit-vector that can represent interval */
+unsigned intToBVSignedWidth(const IntToBVInterval& interval)
+{
+  return std::max(intToBVSignedWidth(interval.d_lower),
+                  intToBVSignedWidth(interval.d_upper));
+}
+
+/**
+ * Tightens the bounds in lower and upper with the bounds on an integer
+ * variable implied by lit, which is a top-level conjunct of the assertions.
+ */
+void intToBVAddBound(TNode lit, NodeIntegerMap& lower, NodeIntegerMap& upper)
+{
+  bool pol = true;
+  Node atom = Rewriter::rewrite(lit);
+  while (atom.getKind() == kind::NOT)
+  {
+    pol = !pol;
+    atom = atom[0];
+  }
+  Kind k = atom.getKind();
+  if ((k != kind::GEQ && (k != kind::EQUAL || !pol))
+      || !atom[0].getType().isInteger())
+  {
+    return;
+  }
+  std::map<Node, Node> msum;
+  if (!ArithMSum::getMonomialSumLit(atom, msum))
+  {
+    return;
+  }
+  Node var;
+  Rational coeff;
+  Rational constant(0);
+  for (const std::pair<const Node, Node>& m : msum)
+  {
+    Rational c = m.second.isNull() ? Rational(1) : m.second.getConst<Rational>();
+    if (m.first.isNull())
+    {
+      constant = c;
+    }
+    else if (!var.isNull() || !m.first.isVar() || !c.isIntegral())
+    {
+      return;
+    }
+    else
+    {
+      var = m.first;
+      coeff = c;
+    }
+  }
+  if (var.isNull() || !var.getType().isInteger() || !constant.isIntegral())
+  {
+    return;
+  }
+  // coeff * var + constant >= 0, or = 0 for equalities
+  if (!pol)
+  {
+    // coeff * var + constant < 0, i.e. -coeff * var - constant - 1 >= 0
+    coeff = -coeff;
+    constant = -constant - Rational(1);
+  }
+  Rational bound = -constant / coeff;
+  if (coeff.sgn() > 0 || k == kind::EQUAL)
+  {
+    Integer b = bound.ceiling();
+    NodeIntegerMap::iterator it = lower.find(var);
+    if (it == lower.end() || it->second < b)
+    {
+      lower[var] = b;
+    }
+  }
+  if (coeff.sgn() < 0 || k == kind::EQUAL)
+  {
+    Integer b = bound.floor();
+    NodeIntegerMap::iterator it = upper.find(var);
+    if (it == upper.end() || b < it->second)
+    {
+      upper[var] = b;
+    }
+  }
+}
+
+/**
+ * Computes the ranges of the integer variables that are bounded from below
+ * and from above by the top-level conjuncts of assertions.
+ */
+void intToBVComputeBounds(const std::vector<Node>& assertions,
+                          NodeIntervalMap& bounds)
+{
+  NodeIntegerMap lower;
+  NodeIntegerMap upper;
+  std::vector<TNode> visit(assertions.begin(), assertions.end());
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (!visited.insert(cur).second)
+    {
+      continue;
+    }
+    if (cur.getKind() == kind::AND)
+    {
+      for (const TNode& child : cur)
+      {
+        visit.push_back(child);
+      }
+    }
+    else
+    {
+      intToBVAddBound(cur, lower, upper);
+    }
+  }
+  for (const std::pair<const Node, Integer>& l : lower)
+  {
+    NodeIntegerMap::const_iterator u = upper.find(l.first);
+    // an empty range makes the problem unsatisfiable, leave it to the solver
+    if (u != upper.end() && l.second <= u->second)
+    {
+      bounds[l.first] = IntToBVInterval(l.second, u->second);
+    }
+  }
+}
+
+/**
+ * Computes in res the range of the arithmetic term current from the ranges of
+ * its children. Returns false if the range of a child is unknown.
+ */
+bool intToBVComputeInterval(TNode current,
+                            const NodeIntervalMap& intervals,
+                            IntToBVInterval& res)
+{
+  std::vector<const IntToBVInterval*> children;
+  for (const TNode& child : current)
+  {
+    NodeIntervalMap::const_iterator it = intervals.find(child);
+    if (it == intervals.end())
+    {
+      if (current.getKind() == kind::ITE && children.empty())
+      {
+        // the condition of an ite
+        children.push_back(nullptr);
+        continue;
+      }
+      return false;
+    }
+    children.push_back(&it->second);
+  }
+  switch (current.getKind())
+  {
+    case kind::PLUS:
+      res.d_lower = children[0]->d_lower + children[1]->d_lower;
+      res.d_upper = children[0]->d_upper + children[1]->d_upper;
+      return true;
+    case kind::MINUS:
+      res.d_lower = children[0]->d_lower - children[1]->d_upper;
+      res.d_upper = children[0]->d_upper - children[1]->d_lower;
+      return true;
+    case kind::UMINUS:
+      res.d_lower = -children[0]->d_upper;
+      res.d_upper = -children[0]->d_lower;
+      return true;
+    case kind::MULT:
+    {
+      const IntToBVInterval& a = *children[0];
+      const IntToBVInterval& b = *children[1];
+      Integer products[] = {a.d_lower * b.d_lower,
+                            a.d_lower * b.d_upper,
+                            a.d_upper * b.d_lower,
+                            a.d_upper * b.d_upper};
+      res.d_lower = products[0];
+      res.d_upper = products[0];
+      for (const Integer& p : products)
+      {
+        res.d_lower = p < res.d_lower ? p : res.d_lower;
+        res.d_upper = res.d_upper < p ? p : res.d_upper;
+      }
+      return true;
+    }
+    case kind::ITE:
+    {
+      const IntToBVInterval& a = *children[1];
+      const IntToBVInterval& b = *children[2];
+      res.d_lower = a.d_lower < b.d_lower ? a.d_lower : b.d_lower;
+      res.d_upper = a.d_upper < b.d_upper ? b.d_upper : a.d_upper;
+      return true;
+    }
+    default: return false;
+  }
+}
+
 // TODO: clean this up
 struct intToBV_stack_element
 {
@@ -123,9 +346,19 @@ Node intToBVMakeBinary(TNode n, NodeMap& cache)
   return cache[n];
 }
 
-Node intToBV(TNode n, NodeMap& cache)
+/**
+ * Translates n to bit-vectors. The ranges of the bounded integer variables
+ * are given by bounds. The range of the translated integer terms is stored in
+ * intervals, and the constraints keeping the variables that were given a
+ * smaller width within their range are added to guards.
+ */
+Node intToBV(TNode n,
+             NodeMap& cache,
+             const NodeIntervalMap& bounds,
+             NodeIntervalMap& intervals,
+             std::vector<Node>& guards)
 {
-  int size = options::solveIntAsBV();
+  unsigned size = options::solveIntAsBV();
   AlwaysAssert(size > 0);
   AlwaysAssert(!options::incrementalSolving());
 
@@ -174,6 +407,7 @@ Node intToBV(TNode n, NodeMap& cache)
       kind::Kind_t newKind = current.getKind();
       if (max > 0)
       {
+        bool arith = true;
         switch (newKind)
         {
           case kind::PLUS:
@@ -196,21 +430,33 @@ Node intToBV(TNode n, NodeMap& cache)
             newKind = kind::BITVECTOR_NEG;
             max = max + 1;
             break;
+          case kind::ITE: arith = current.getType().isInteger(); break;
           case kind::LT: newKind = kind::BITVECTOR_SLT; break;
           case kind::LEQ: newKind = kind::BITVECTOR_SLE; break;
           case kind::GT: newKind = kind::BITVECTOR_SGT; break;
           case kind::GEQ: newKind = kind::BITVECTOR_SGE; break;
-          case kind::EQUAL:
-          case kind::ITE: break;
+          case kind::EQUAL: arith = false; break;
           default:
             if (Theory::theoryOf(current) == THEORY_BOOL)
             {
+              arith = false;
               break;
             }
             throw TypeCheckingException(
                 current.toExpr(),
                 string("Cannot translate to BV: ") + current.toString());
         }
+        IntToBVInterval interval;
+        if (arith && intToBVComputeInterval(current, intervals, interval))
+        {
+          intervals[current] = interval;
+          if (options::solveIntAsBVRanges())
+          {
+            // Computing modulo 2^width is exact when the value of the term
+            // fits, which the guards on the variables ensure.
+            max = std::min(max, intToBVSignedWidth(interval));
+          }
+        }
         for (unsigned i = 0; i < children.size(); ++i)
         {
           TypeNode type = children[i].getType();
@@ -226,6 +472,11 @@ Node intToBV(TNode n, NodeMap& cache)
                 BitVectorSignExtend(max - bvsize));
             children[i] = nm->mkNode(signExtendOp, children[i]);
           }
+          else if (bvsize > max)
+          {
+            // the value of the child is only needed modulo 2^max
+            children[i] = bv::utils::mkExtract(children[i], max - 1, 0);
+          }
         }
       }
       NodeBuilder<> builder(newKind);
@@ -267,9 +518,37 @@ Node intToBV(TNode n, NodeMap& cache)
         {
           if (current.getType() == nm->integerType())
           {
+            unsigned width = size;
+            NodeIntervalMap::const_iterator it = bounds.find(current);
+            if (it != bounds.end()
+                && intToBVSignedWidth(it->second) < width)
+            {
+              width = intToBVSignedWidth(it->second);
+            }
             result = nm->mkSkolem("__intToBV_var",
-                                  nm->mkBitVectorType(size),
+                                  nm->mkBitVectorType(width),
                                   "Variable introduced in intToBV pass");
+            if (width < size)
+            {
+              // keep the variable within its range, which the widths of the
+              // terms containing it rely on
+              const IntToBVInterval& range = it->second;
+              intervals[current] = range;
+              guards.push_back(nm->mkNode(
+                  kind::AND,
+                  nm->mkNode(kind::BITVECTOR_SGE,
+                             result,
+                             nm->mkConst(BitVector(width, range.d_lower))),
+                  nm->mkNode(kind::BITVECTOR_SLE,
+                             result,
+                             nm->mkConst(BitVector(width, range.d_upper)))));
+            }
+            else
+            {
+              Integer bound = Integer(1).multiplyByPow2(size - 1);
+              intervals[current] =
+                  IntToBVInterval(-bound, bound - Integer(1));
+            }
           }
           else
           {
@@ -284,7 +563,6 @@ Node intToBV(TNode n, NodeMap& cache)
             {
               Rational constant = current.getConst<Rational>();
               AlwaysAssert(constant.isIntegral());
-              AlwaysAssert(constant >= 0);
               BitVector bv(size, constant.getNumerator());
               if (bv.toSignedInteger() != constant.getNumerator())
               {
@@ -294,6 +572,8 @@ Node intToBV(TNode n, NodeMap& cache)
                         + current.toString());
               }
               result = nm->mkConst(bv);
+              intervals[current] = IntToBVInterval(constant.getNumerator(),
+                                                   constant.getNumerator());
               break;
             }
             case kind::CONST_BOOLEAN: break;
@@ -326,10 +606,22 @@ PreprocessingPassResult IntToBV::applyInternal(
     AssertionPipeline* assertionsToPreprocess)
 {
   unordered_map<Node, Node, NodeHashFunction> cache;
-  for (unsigned i = 0; i < assertionsToPreprocess->size(); ++i)
+  NodeIntervalMap bounds;
+  if (options::solveIntAsBVRanges())
+  {
+    intToBVComputeBounds(assertionsToPreprocess->ref(), bounds);
+  }
+  NodeIntervalMap intervals;
+  std::vector<Node> guards;
+  for (unsigned i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
   {
     assertionsToPreprocess->replace(
-        i, intToBV((*assertionsToPreprocess)[i], cache));
+        i,
+        intToBV((*assertionsToPreprocess)[i], cache, bounds, intervals, guards));
+  }
+  for (const Node& guard : guards)
+  {
+    assertionsToPreprocess->push_back(guard);
   }
   return PreprocessingPassResult::NO_CONFLICT;
 }
@@ -55,28 +55,26 @@ Node RealToInt::realToIntInternal(TNode n, NodeMap& cache, std::vector<Node>& va
           std::map<Node, Node> msum;
           if (ArithMSum::getMonomialSumLit(ret_lit, msum))
           {
-            // get common coefficient
-            std::vector<Node> coeffs;
+            // get common coefficient, the least common multiple of the
+            // denominators keeps the constants, hence the bit-widths of a
+            // later int-to-bv translation, small
+            bool hasCoeff = false;
+            Integer lcm(1);
             for (std::map<Node, Node>::iterator itm = msum.begin();
                  itm != msum.end();
                  ++itm)
             {
-              Node v = itm->first;
               Node c = itm->second;
               if (!c.isNull())
               {
                 Assert(c.isConst());
-                coeffs.push_back(NodeManager::currentNM()->mkConst(
-                    Rational(c.getConst<Rational>().getDenominator())));
+                hasCoeff = true;
+                lcm = lcm.lcm(c.getConst<Rational>().getDenominator());
               }
             }
-            Node cc =
-                coeffs.empty()
-                    ? Node::null()
-                    : (coeffs.size() == 1
-                           ? coeffs[0]
-                           : Rewriter::rewrite(NodeManager::currentNM()->mkNode(
-                                 kind::MULT, coeffs)));
+            Node cc = hasCoeff
+                          ? NodeManager::currentNM()->mkConst(Rational(lcm))
+                          : Node::null();
             std::vector<Node> sum;
             for (std::map<Node, Node>::iterator itm = msum.begin();
                  itm != msum.end();
@@ -32,8 +32,14 @@ Rewrite::Rewrite(PreprocessingPassContext* preprocContext)
 PreprocessingPassResult Rewrite::applyInternal(
   AssertionPipeline* assertionsToPreprocess)
 {	
-  for (unsigned i = 0; i < assertionsToPreprocess->size(); ++i) {
-    assertionsToPreprocess->replace(i, Rewriter::rewrite((*assertionsToPreprocess)[i]));
+  std::vector<Node> rewritten = assertionsToPreprocess->ref();
+  Rewriter::rewriteBatch(rewritten);
+  for (size_t i = 0, size = rewritten.size(); i < size; ++i)
+  {
+    if (rewritten[i] != (*assertionsToPreprocess)[i])
+    {
+      assertionsToPreprocess->replace(i, rewritten[i]);
+    }
   }
 
   return PreprocessingPassResult::NO_CONFLICT;
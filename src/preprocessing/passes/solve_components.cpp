@@ -0,0 +1,345 @@
+/*********************                                                        */
+/*! \file solve_components.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The solve components preprocessing pass
+ **
+ ** Solve the independent components of the assertions in parallel.
+ **/
+
+#include "preprocessing/passes/solve_components.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "expr/expr_manager.h"
+#include "expr/node_algorithm.h"
+#include "expr/variable_type_map.h"
+#include "options/smt_options.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/rewriter.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+namespace {
+
+/** A subsolver for a group of components */
+struct Subsolver
+{
+  /** The expression manager of the subsolver */
+  std::unique_ptr<ExprManager> d_em;
+  /** The map of the symbols exported to d_em */
+  ExprManagerMapCollection d_vmap;
+  /** The subsolver */
+  std::unique_ptr<SmtEngine> d_smt;
+  /** The result of the subsolver */
+  Result d_result;
+};
+
+}  // namespace
+
+SolveComponents::SolveComponents(PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "solve-components"){};
+
+void SolveComponents::computeComponents(
+    AssertionPipeline* assertionsToPreprocess,
+    std::vector<std::vector<size_t>>& components,
+    std::vector<std::vector<Node>>& syms)
+{
+  size_t n = assertionsToPreprocess->size();
+  // union-find over the assertions, where two assertions are in the same set
+  // if they share a free symbol
+  std::vector<size_t> parent(n);
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find = [&parent](size_t i) {
+    while (parent[i] != i)
+    {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+  // maps each free symbol to the first assertion containing it
+  std::unordered_map<Node, size_t, NodeHashFunction> owner;
+  std::vector<bool> hasSyms(n, false);
+  for (size_t i = 0; i < n; ++i)
+  {
+    std::unordered_set<Node, NodeHashFunction> asyms;
+    expr::getSymbols((*assertionsToPreprocess)[i], asyms);
+    hasSyms[i] = !asyms.empty();
+    for (const Node& s : asyms)
+    {
+      auto it = owner.find(s);
+      if (it == owner.end())
+      {
+        owner[s] = i;
+        continue;
+      }
+      size_t ri = find(i);
+      size_t rj = find(it->second);
+      if (ri != rj)
+      {
+        parent[ri] = rj;
+      }
+    }
+  }
+  std::unordered_map<size_t, size_t> rootToComponent;
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (!hasSyms[i])
+    {
+      continue;
+    }
+    size_t root = find(i);
+    auto it = rootToComponent.find(root);
+    if (it == rootToComponent.end())
+    {
+      it = rootToComponent.emplace(root, components.size()).first;
+      components.emplace_back();
+      syms.emplace_back();
+    }
+    components[it->second].push_back(i);
+  }
+  for (const std::pair<const Node, size_t>& p : owner)
+  {
+    syms[rootToComponent[find(p.second)]].push_back(p.first);
+  }
+  // sort the symbols, so that the result does not depend on hashing
+  for (std::vector<Node>& csyms : syms)
+  {
+    std::sort(csyms.begin(), csyms.end());
+  }
+}
+
+PreprocessingPassResult SolveComponents::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  NodeManager::currentResourceManager()->spendResource(
+      ResourceManager::Resource::PreprocessStep, options::preprocessStep());
+  NodeManager* nm = NodeManager::currentNM();
+  Node trueNode = nm->mkConst(true);
+  Node falseNode = nm->mkConst(false);
+
+  for (const Node& a : assertionsToPreprocess->ref())
+  {
+    if (a == falseNode)
+    {
+      return PreprocessingPassResult::CONFLICT;
+    }
+  }
+
+  std::vector<std::vector<size_t>> components;
+  std::vector<std::vector<Node>> syms;
+  computeComponents(assertionsToPreprocess, components, syms);
+  d_statistics.d_numComponents += components.size();
+  size_t numGroups = std::min<size_t>(options::solveComponents(),
+                                      components.size());
+  Trace("solve-components") << "Found " << components.size()
+                            << " components, solving in " << numGroups
+                            << " groups" << std::endl;
+  if (numGroups < 2)
+  {
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
+
+  // Pack the components into groups of roughly the same size, assigning
+  // the largest components first
+  std::vector<size_t> order(components.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&syms](size_t i, size_t j) {
+    return syms[i].size() > syms[j].size();
+  });
+  std::vector<std::vector<size_t>> groupAssertions(numGroups);
+  std::vector<std::vector<Node>> groupSyms(numGroups);
+  for (size_t c : order)
+  {
+    size_t g = 0;
+    for (size_t i = 1; i < numGroups; ++i)
+    {
+      if (groupSyms[i].size() < groupSyms[g].size())
+      {
+        g = i;
+      }
+    }
+    groupAssertions[g].insert(
+        groupAssertions[g].end(), components[c].begin(), components[c].end());
+    groupSyms[g].insert(groupSyms[g].end(), syms[c].begin(), syms[c].end());
+  }
+
+  // Make the subsolvers. Exporting the assertions must be done on this
+  // thread, since it accesses the node manager of the main solver.
+  SmtEngine* smt = d_preprocContext->getSmt();
+  std::vector<std::unique_ptr<Subsolver>> subsolvers(numGroups);
+  try
+  {
+    for (size_t g = 0; g < numGroups; ++g)
+    {
+      subsolvers[g].reset(new Subsolver);
+      Subsolver& sub = *subsolvers[g];
+      sub.d_em.reset(new ExprManager(nm->getOptions()));
+      sub.d_smt.reset(new SmtEngine(sub.d_em.get()));
+      sub.d_smt->setIsInternalSubsolver();
+      sub.d_smt->setLogic(smt->getLogicInfo());
+      for (size_t i : groupAssertions[g])
+      {
+        sub.d_smt->assertFormula((*assertionsToPreprocess)[i].toExpr().exportTo(
+            sub.d_em.get(), sub.d_vmap));
+      }
+    }
+  }
+  catch (const ExportUnsupportedException& e)
+  {
+    Trace("solve-components") << "...cannot export: " << e << std::endl;
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
+
+  // Run the subsolvers, interrupting all of them once one reports unsat
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<bool> finished(numGroups, false);
+  size_t numRunning = numGroups;
+  bool foundUnsat = false;
+  std::vector<std::thread> threads;
+  for (size_t g = 0; g < numGroups; ++g)
+  {
+    threads.emplace_back([&, g]() {
+      Result r(Result::SAT_UNKNOWN, Result::UNKNOWN_REASON);
+      try
+      {
+        r = subsolvers[g]->d_smt->checkSat().asSatisfiabilityResult();
+      }
+      catch (const Exception& e)
+      {
+        Trace("solve-components") << "...group " << g << " failed: " << e
+                                  << std::endl;
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      subsolvers[g]->d_result = r;
+      finished[g] = true;
+      --numRunning;
+      foundUnsat = foundUnsat || r.isSat() == Result::UNSAT;
+      cv.notify_all();
+    });
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return foundUnsat || numRunning == 0; });
+    // A subsolver might not have started its search when we interrupt it
+    // the first time, hence we keep interrupting until all have finished.
+    while (numRunning > 0)
+    {
+      for (size_t g = 0; g < numGroups; ++g)
+      {
+        if (!finished[g])
+        {
+          subsolvers[g]->d_smt->interrupt();
+        }
+      }
+      cv.wait_for(lock, std::chrono::milliseconds(10));
+    }
+  }
+  for (std::thread& t : threads)
+  {
+    t.join();
+  }
+
+  if (foundUnsat)
+  {
+    Trace("solve-components") << "...unsat" << std::endl;
+    for (size_t i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+    {
+      assertionsToPreprocess->replace(i, falseNode);
+    }
+    return PreprocessingPassResult::CONFLICT;
+  }
+
+  // Replace the assertions of the satisfiable groups
+  bool needModels = options::produceModels();
+  for (size_t g = 0; g < numGroups; ++g)
+  {
+    Subsolver& sub = *subsolvers[g];
+    Trace("solve-components") << "...group " << g << ": " << sub.d_result
+                              << std::endl;
+    if (sub.d_result.isSat() != Result::SAT)
+    {
+      continue;
+    }
+    ++d_statistics.d_numGroupsSolved;
+    std::vector<Node> eqs;
+    if (needModels)
+    {
+      bool canImport = true;
+      for (const Node& s : groupSyms[g])
+      {
+        TypeNode tn = s.getType();
+        if (!tn.isBoolean() && !tn.isReal() && !tn.isBitVector())
+        {
+          canImport = false;
+          break;
+        }
+        Expr es = sub.d_vmap.d_typeMap[s.toExpr()];
+        Node v = Node::fromExpr(sub.d_smt->getValue(es).exportTo(
+            nm->toExprManager(), sub.d_vmap));
+        if (!v.isConst())
+        {
+          canImport = false;
+          break;
+        }
+        eqs.push_back(s.eqNode(v));
+      }
+      if (!canImport)
+      {
+        // leave the group to the main solver
+        continue;
+      }
+    }
+    std::vector<size_t>& indices = groupAssertions[g];
+    for (size_t i = 0, size = indices.size(); i < size; ++i)
+    {
+      Node a = trueNode;
+      if (i == 0 && !eqs.empty())
+      {
+        a = theory::Rewriter::rewrite(eqs.size() == 1
+                                          ? eqs[0]
+                                          : nm->mkNode(kind::AND, eqs));
+      }
+      assertionsToPreprocess->replace(indices[i], a);
+    }
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+SolveComponents::Statistics::Statistics()
+    : d_numComponents("preprocessing::passes::SolveComponents::numComponents",
+                      0),
+      d_numGroupsSolved(
+          "preprocessing::passes::SolveComponents::numGroupsSolved", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_numComponents);
+  smtStatisticsRegistry()->registerStat(&d_numGroupsSolved);
+}
+
+SolveComponents::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numComponents);
+  smtStatisticsRegistry()->unregisterStat(&d_numGroupsSolved);
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
@@ -0,0 +1,86 @@
+/*********************                                                        */
+/*! \file solve_components.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The solve components preprocessing pass
+ **
+ ** Solve the independent components of the assertions in parallel.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PASSES__SOLVE_COMPONENTS_H
+#define CVC4__PREPROCESSING__PASSES__SOLVE_COMPONENTS_H
+
+#include <vector>
+
+#include "expr/node.h"
+#include "preprocessing/preprocessing_pass.h"
+#include "preprocessing/preprocessing_pass_context.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+/**
+ * This pass partitions the assertions into components that share no free
+ * symbols, and packs these into up to options::solveComponents() groups.
+ * Each group is exported to a subsolver with its own ExprManager, and the
+ * subsolvers are run in parallel on separate threads.
+ *
+ * If a group is unsatisfiable, all assertions are replaced by false. If a
+ * group is satisfiable, its assertions are replaced by true or, if models
+ * are produced, by the equalities of its free symbols to their values in
+ * the model of the subsolver (which requires the values to be constants of
+ * Boolean, arithmetic or bit-vector type). Groups for which the subsolver
+ * answers unknown, or whose model cannot be imported, are left to the main
+ * solver.
+ *
+ * This is only sound if the components are independent, which is the case
+ * for non-incremental, quantifier-free queries without separation logic or
+ * sets (whose universe is shared by all assertions). The caller must ensure
+ * this.
+ */
+class SolveComponents : public PreprocessingPass
+{
+ public:
+  SolveComponents(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  /**
+   * Compute the components of the assertions, stored as lists of indices of
+   * assertions in components, and their free symbols in syms. Assertions
+   * without free symbols are not in any component.
+   */
+  static void computeComponents(AssertionPipeline* assertionsToPreprocess,
+                                std::vector<std::vector<size_t>>& components,
+                                std::vector<std::vector<Node>>& syms);
+
+  struct Statistics
+  {
+    /** number of components found */
+    IntStat d_numComponents;
+    /** number of groups of components solved by subsolvers */
+    IntStat d_numGroupsSolved;
+    Statistics();
+    ~Statistics();
+  };
+
+  Statistics d_statistics;
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
+
+#endif /* CVC4__PREPROCESSING__PASSES__SOLVE_COMPONENTS_H */
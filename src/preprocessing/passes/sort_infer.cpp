@@ -35,9 +35,10 @@ PreprocessingPassResult SortInferencePass::applyInternal(
 {
   SortInference* si = d_preprocContext->getTheoryEngine()->getSortInference();
 
-  if (options::sortInference())
+  // sort inference is skipped if it runs out of time
+  if (options::sortInference()
+      && si->initialize(assertionsToPreprocess->ref()))
   {
-    si->initialize(assertionsToPreprocess->ref());
     std::map<Node, Node> model_replace_f;
     std::map<Node, std::map<TypeNode, Node> > visited;
     for (unsigned i = 0, size = assertionsToPreprocess->size(); i < size; i++)
@@ -30,10 +30,17 @@ PreprocessingPassResult StaticLearning::applyInternal(
     AssertionPipeline* assertionsToPreprocess)
 {
   NodeManager::currentResourceManager()->spendResource(
-      options::preprocessStep());
+      ResourceManager::Resource::PreprocessStep, options::preprocessStep());
 
   for (unsigned i = 0; i < assertionsToPreprocess->size(); ++i)
   {
+    // No theory learns from constants and Boolean literals
+    TNode atom = (*assertionsToPreprocess)[i];
+    atom = atom.getKind() == kind::NOT ? atom[0] : atom;
+    if (atom.isConst() || atom.isVar())
+    {
+      continue;
+    }
     NodeBuilder<> learned(kind::AND);
     learned << (*assertionsToPreprocess)[i];
     d_preprocContext->getTheoryEngine()->ppStaticLearn(
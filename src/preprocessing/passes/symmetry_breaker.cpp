@@ -14,7 +14,9 @@
 
 #include "preprocessing/passes/symmetry_breaker.h"
 
+#include "options/smt_options.h"
 #include "preprocessing/passes/symmetry_detect.h"
+#include "preprocessing/passes/symmetry_refine.h"
 
 using namespace std;
 using namespace CVC4::kind;
@@ -139,8 +141,18 @@ PreprocessingPassResult SymBreakerPass::applyInternal(
   Trace("sym-break-pass") << "Apply symmetry breaker pass..." << std::endl;
   // detect symmetries
   std::vector<std::vector<Node>> sterms;
-  symbreak::SymmetryDetect symd;
-  symd.computeTerms(sterms, assertionsToPreprocess->ref());
+  if (options::symmetryBreakerRefine())
+  {
+    symbreak::SymmetryRefine symr;
+    symr.computeTerms(sterms,
+                      assertionsToPreprocess->ref(),
+                      options::symmetryBreakerTimeLimit());
+  }
+  else
+  {
+    symbreak::SymmetryDetect symd;
+    symd.computeTerms(sterms, assertionsToPreprocess->ref());
+  }
   if (Trace.isOn("sym-break-pass") || Trace.isOn("sb-constraint"))
   {
     if (sterms.empty())
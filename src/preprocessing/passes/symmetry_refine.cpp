@@ -0,0 +1,292 @@
+/*********************                                                        */
+/*! \file symmetry_refine.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Symmetry detection by colour refinement
+ **/
+
+#include "preprocessing/passes/symmetry_refine.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "theory/quantifiers/term_util.h"
+#include "theory/rewriter.h"
+
+using namespace std;
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+namespace symbreak {
+
+SymmetryRefine::SymmetryRefine() {}
+
+bool SymmetryRefine::isCandidate(TNode n)
+{
+  if (!n.isVar() || n.getKind() == kind::BOUND_VARIABLE)
+  {
+    return false;
+  }
+  TypeNode tn = n.getType();
+  return tn.isFirstClass() && !tn.isFunction();
+}
+
+void SymmetryRefine::collect(TNode n)
+{
+  if (d_index.find(n) != d_index.end())
+  {
+    return;
+  }
+  // post-order traversal, so that children come before parents
+  std::vector<std::pair<TNode, bool> > visit;
+  visit.push_back(std::pair<TNode, bool>(n, false));
+  while (!visit.empty())
+  {
+    std::pair<TNode, bool> cur = visit.back();
+    visit.pop_back();
+    if (d_index.find(cur.first) != d_index.end())
+    {
+      continue;
+    }
+    if (!cur.second)
+    {
+      visit.push_back(std::pair<TNode, bool>(cur.first, true));
+      for (const TNode& c : cur.first)
+      {
+        if (d_index.find(c) == d_index.end())
+        {
+          visit.push_back(std::pair<TNode, bool>(c, false));
+        }
+      }
+      continue;
+    }
+    size_t id = d_nodes.size();
+    d_index[cur.first] = id;
+    d_nodes.push_back(cur.first);
+    d_children.push_back(std::vector<size_t>());
+    d_parents.push_back(std::vector<std::pair<size_t, size_t> >());
+    for (size_t i = 0, nchild = cur.first.getNumChildren(); i < nchild; i++)
+    {
+      size_t cid = d_index[cur.first[i]];
+      d_children[id].push_back(cid);
+      d_parents[cid].push_back(std::pair<size_t, size_t>(id, i));
+    }
+  }
+}
+
+void SymmetryRefine::initColours(
+    const std::unordered_set<TNode, TNodeHashFunction>& roots)
+{
+  std::map<std::vector<size_t>, size_t> colours;
+  d_colour.resize(d_nodes.size());
+  for (size_t i = 0, size = d_nodes.size(); i < size; i++)
+  {
+    TNode n = d_nodes[i];
+    std::vector<size_t> key;
+    key.push_back(static_cast<size_t>(n.getKind()));
+    key.push_back(static_cast<size_t>(d_tcanon.getIdForType(n.getType())));
+    key.push_back(roots.find(n) != roots.end() ? 1 : 0);
+    if (n.getMetaKind() == kind::metakind::PARAMETERIZED)
+    {
+      key.push_back(static_cast<size_t>(n.getOperator().getId()));
+    }
+    if (!isCandidate(n) && n.getNumChildren() == 0
+        && n.getKind() != kind::BOUND_VARIABLE)
+    {
+      // constants and other leaves are fixed by all permutations we consider
+      key.push_back(static_cast<size_t>(n.getId()));
+    }
+    std::map<std::vector<size_t>, size_t>::iterator it = colours.find(key);
+    if (it == colours.end())
+    {
+      size_t c = colours.size();
+      colours[key] = c;
+      d_colour[i] = c;
+    }
+    else
+    {
+      d_colour[i] = it->second;
+    }
+  }
+}
+
+size_t SymmetryRefine::refine()
+{
+  static const size_t noPosition = std::numeric_limits<size_t>::max();
+  std::map<std::vector<size_t>, size_t> colours;
+  std::vector<size_t> colour(d_nodes.size());
+  for (size_t i = 0, size = d_nodes.size(); i < size; i++)
+  {
+    std::vector<size_t> key;
+    key.push_back(d_colour[i]);
+    // the colours of the children
+    bool comm = theory::quantifiers::TermUtil::isComm(d_nodes[i].getKind());
+    size_t start = key.size();
+    for (size_t c : d_children[i])
+    {
+      key.push_back(d_colour[c]);
+    }
+    if (comm)
+    {
+      std::sort(key.begin() + start, key.end());
+    }
+    key.push_back(noPosition);
+    // the colours of the parents and the positions in them
+    std::vector<std::pair<size_t, size_t> > parents;
+    for (const std::pair<size_t, size_t>& p : d_parents[i])
+    {
+      bool pcomm =
+          theory::quantifiers::TermUtil::isComm(d_nodes[p.first].getKind());
+      parents.push_back(std::pair<size_t, size_t>(
+          d_colour[p.first], pcomm ? noPosition : p.second));
+    }
+    std::sort(parents.begin(), parents.end());
+    for (const std::pair<size_t, size_t>& p : parents)
+    {
+      key.push_back(p.first);
+      key.push_back(p.second);
+    }
+    std::map<std::vector<size_t>, size_t>::iterator it = colours.find(key);
+    if (it == colours.end())
+    {
+      size_t c = colours.size();
+      colours[key] = c;
+      colour[i] = c;
+    }
+    else
+    {
+      colour[i] = it->second;
+    }
+  }
+  d_colour.swap(colour);
+  return colours.size();
+}
+
+Node SymmetryRefine::normalize(Node n)
+{
+  return d_tcanon.getCanonicalTerm(theory::Rewriter::rewrite(n), true);
+}
+
+bool SymmetryRefine::isAutomorphism(
+    const std::vector<Node>& assertions,
+    const std::unordered_set<Node, NodeHashFunction>& nassertions,
+    const std::vector<Node>& vars,
+    const std::vector<Node>& subs)
+{
+  // Since the permutation has a finite order, it suffices that the image of
+  // each assertion is an assertion.
+  for (const Node& a : assertions)
+  {
+    Node sa = a.substitute(vars.begin(), vars.end(), subs.begin(), subs.end());
+    if (nassertions.find(normalize(sa)) == nassertions.end())
+    {
+      Trace("sym-refine") << "...not preserved : " << a << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+void SymmetryRefine::computeTerms(std::vector<std::vector<Node> >& sterms,
+                                  const std::vector<Node>& assertions,
+                                  uint64_t timeLimit)
+{
+  if (timeLimit > 0)
+  {
+    d_timer.set(timeLimit);
+  }
+  std::unordered_set<TNode, TNodeHashFunction> roots;
+  for (const Node& a : assertions)
+  {
+    roots.insert(a);
+    collect(a);
+  }
+  initColours(roots);
+  size_t ncolours = 0;
+  size_t rounds = 0;
+  for (;;)
+  {
+    if (timeLimit > 0 && d_timer.expired())
+    {
+      Trace("sym-refine") << "...time limit reached in refinement" << std::endl;
+      return;
+    }
+    size_t n = refine();
+    rounds++;
+    if (n == ncolours)
+    {
+      break;
+    }
+    ncolours = n;
+  }
+  Trace("sym-refine") << "Colour refinement: " << d_nodes.size()
+                      << " nodes, " << ncolours << " colours after " << rounds
+                      << " rounds" << std::endl;
+
+  // the candidate classes, in the order of the nodes
+  std::map<size_t, std::vector<Node> > classes;
+  std::vector<size_t> order;
+  for (size_t i = 0, size = d_nodes.size(); i < size; i++)
+  {
+    if (isCandidate(d_nodes[i]))
+    {
+      std::vector<Node>& cl = classes[d_colour[i]];
+      if (cl.empty())
+      {
+        order.push_back(d_colour[i]);
+      }
+      cl.push_back(d_nodes[i]);
+    }
+  }
+
+  std::unordered_set<Node, NodeHashFunction> nassertions;
+  for (const Node& a : assertions)
+  {
+    nassertions.insert(normalize(a));
+  }
+  for (size_t c : order)
+  {
+    const std::vector<Node>& cl = classes[c];
+    if (cl.size() < 2)
+    {
+      continue;
+    }
+    if (timeLimit > 0 && d_timer.expired())
+    {
+      Trace("sym-refine") << "...time limit reached in checks" << std::endl;
+      return;
+    }
+    Trace("sym-refine") << "Check candidate " << cl << std::endl;
+    // the transposition of the first two variables
+    std::vector<Node> subs = cl;
+    std::swap(subs[0], subs[1]);
+    if (!isAutomorphism(assertions, nassertions, cl, subs))
+    {
+      continue;
+    }
+    if (cl.size() > 2)
+    {
+      // the cycle over all variables
+      subs.clear();
+      subs.insert(subs.end(), cl.begin() + 1, cl.end());
+      subs.push_back(cl[0]);
+      if (!isAutomorphism(assertions, nassertions, cl, subs))
+      {
+        continue;
+      }
+    }
+    Trace("sym-refine") << "...symmetric" << std::endl;
+    sterms.push_back(cl);
+  }
+}
+
+}  // namespace symbreak
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
@@ -0,0 +1,111 @@
+/*********************                                                        */
+/*! \file symmetry_refine.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Symmetry detection by colour refinement
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PASSES__SYMMETRY_REFINE_H
+#define CVC4__PREPROCESSING__PASSES__SYMMETRY_REFINE_H
+
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/term_canonize.h"
+#include "util/resource_manager.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+namespace symbreak {
+
+/**
+ * Symmetry detection by colour refinement over the DAG of the assertions.
+ *
+ * Every node of the DAG gets a colour, which is first determined by its
+ * kind, operator and type. It is then refined by the colours of its children
+ * and of its parents (with their positions, except below commutative
+ * operators) until the number of colours is stable. Variables that are
+ * exchanged by an automorphism of the assertions have the same final
+ * colour, so the classes of variables with equal colours are candidates for
+ * symmetries. Each round takes time linear in the size of the DAG (up to
+ * a logarithmic factor).
+ *
+ * Colour refinement may give the same colour to variables that are not
+ * symmetric. A candidate class { x1, ..., xn } is therefore checked: the
+ * transposition (x1 x2) and the cycle (x1 ... xn) generate all the
+ * permutations of the class, and we check that they map the set of
+ * (rewritten, canonized) assertions to itself.
+ */
+class SymmetryRefine
+{
+ public:
+  SymmetryRefine();
+
+  /**
+   * Get the symmetries of assertions. If a vector in sterms contains two
+   * variables x and y, then assertions and assertions { x -> y, y -> x } are
+   * equisatisfiable. The classes in sterms are disjoint.
+   *
+   * If timeLimit is not 0, stops after timeLimit milliseconds and returns
+   * the classes that were checked so far.
+   */
+  void computeTerms(std::vector<std::vector<Node> >& sterms,
+                    const std::vector<Node>& assertions,
+                    uint64_t timeLimit = 0);
+
+ private:
+  /** The nodes of the DAG, children before parents */
+  std::vector<TNode> d_nodes;
+  /** The index of each node in d_nodes */
+  std::unordered_map<TNode, size_t, TNodeHashFunction> d_index;
+  /** The children of each node, as indices in d_nodes */
+  std::vector<std::vector<size_t> > d_children;
+  /** The parents of each node, with the position of the node in them */
+  std::vector<std::vector<std::pair<size_t, size_t> > > d_parents;
+  /** The current colour of each node */
+  std::vector<size_t> d_colour;
+  /** Canonizer used for comparing permuted assertions */
+  expr::TermCanonize d_tcanon;
+  /** The timer for the time limit */
+  Timer d_timer;
+
+  /** Adds the nodes of n to the fields above */
+  void collect(TNode n);
+  /** Is n a variable whose permutations we consider? */
+  static bool isCandidate(TNode n);
+  /** The initial colours of the nodes */
+  void initColours(const std::unordered_set<TNode, TNodeHashFunction>& roots);
+  /**
+   * Refine the colours once. Returns the number of colours after
+   * the round.
+   */
+  size_t refine();
+  /** Returns the rewritten and canonized form of n */
+  Node normalize(Node n);
+  /**
+   * Does the substitution vars -> subs map the normalized assertions in
+   * nassertions to themselves?
+   */
+  bool isAutomorphism(const std::vector<Node>& assertions,
+                      const std::unordered_set<Node, NodeHashFunction>& nassertions,
+                      const std::vector<Node>& vars,
+                      const std::vector<Node>& subs);
+};
+
+}  // namespace symbreak
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
+
+#endif /* CVC4__PREPROCESSING__PASSES__SYMMETRY_REFINE_H */
@@ -32,16 +32,24 @@ UnconstrainedSimplifier::UnconstrainedSimplifier(
     PreprocessingPassContext* preprocContext)
     : PreprocessingPass(preprocContext, "unconstrained-simplifier"),
       d_numUnconstrainedElim("preprocessor::number of unconstrained elims", 0),
+      d_numDefsReintroduced(
+          "preprocessor::number of unconstrained definitions reintroduced", 0),
       d_context(preprocContext->getDecisionContext()),
       d_substitutions(preprocContext->getDecisionContext()),
-      d_logicInfo(preprocContext->getLogicInfo())
+      d_logicInfo(preprocContext->getLogicInfo()),
+      d_constrainedSyms(preprocContext->getUserContext()),
+      d_eliminatedSyms(preprocContext->getUserContext()),
+      d_defs(preprocContext->getUserContext()),
+      d_numDefsAsserted(preprocContext->getUserContext(), 0)
 {
   smtStatisticsRegistry()->registerStat(&d_numUnconstrainedElim);
+  smtStatisticsRegistry()->registerStat(&d_numDefsReintroduced);
 }
 
 UnconstrainedSimplifier::~UnconstrainedSimplifier()
 {
   smtStatisticsRegistry()->unregisterStat(&d_numUnconstrainedElim);
+  smtStatisticsRegistry()->unregisterStat(&d_numDefsReintroduced);
 }
 
 struct unc_preprocess_stack_element
@@ -108,6 +116,7 @@ Node UnconstrainedSimplifier::newUnconstrainedVar(TypeNode t, TNode var)
       t,
       "a new var introduced because of unconstrained variable "
           + var.toString());
+  d_newVars.insert(n);
   return n;
 }
 
@@ -780,6 +789,13 @@ void UnconstrainedSimplifier::processUnconstrained()
     if (!currentSub.isNull())
     {
       Assert(currentSub.isVar());
+      if (options::incrementalSolving()
+          && d_newVars.find(currentSub) == d_newVars.end())
+      {
+        // The definition current = currentSub must be a definition of a
+        // fresh variable, see d_defs
+        currentSub = newUnconstrainedVar(current.getType(), currentSub);
+      }
       d_substitutions.addSubstitution(current, currentSub, false);
     }
     if (workList.empty())
@@ -824,14 +840,77 @@ PreprocessingPassResult UnconstrainedSimplifier::applyInternal(
     visitAll(assertion);
   }
 
+  bool incremental = options::incrementalSolving();
+  if (incremental)
+  {
+    // Variables of previous assertions are constrained. If some of them were
+    // unconstrained when expressions were eliminated, the definitions of the
+    // eliminated expressions must be asserted again.
+    bool reintroduce = false;
+    for (const std::pair<const TNode, unsigned>& v : d_visited)
+    {
+      if (!v.first.isVar())
+      {
+        continue;
+      }
+      if (d_eliminatedSyms.contains(v.first))
+      {
+        reintroduce = true;
+      }
+      if (d_constrainedSyms.contains(v.first))
+      {
+        d_unconstrained.erase(v.first);
+      }
+    }
+    if (reintroduce)
+    {
+      for (size_t i = d_numDefsAsserted.get(), size = d_defs.size(); i < size;
+           ++i)
+      {
+        Trace("unc-simp") << "Reintroduce " << d_defs[i] << std::endl;
+        assertionsToPreprocess->push_back(d_defs[i]);
+        ++d_numDefsReintroduced;
+      }
+      d_numDefsAsserted = d_defs.size();
+    }
+    for (const std::pair<const TNode, unsigned>& v : d_visited)
+    {
+      if (v.first.isVar())
+      {
+        d_constrainedSyms.insert(v.first);
+      }
+    }
+  }
+
   if (!d_unconstrained.empty())
   {
+    if (incremental)
+    {
+      for (TNode v : d_unconstrained)
+      {
+        d_eliminatedSyms.insert(v);
+      }
+    }
     processUnconstrained();
     //    d_substitutions.print(Message.getStream());
     for (Node& assertion : assertions)
     {
       assertion = Rewriter::rewrite(d_substitutions.apply(assertion));
     }
+    if (incremental)
+    {
+      // remember the definitions of the eliminated expressions, where the
+      // fresh variables are constrained from now on
+      for (const auto& sub : d_substitutions)
+      {
+        Node def = sub.first.eqNode(d_substitutions.apply(sub.first));
+        d_defs.push_back(Rewriter::rewrite(def));
+      }
+      for (const Node& v : d_newVars)
+      {
+        d_constrainedSyms.insert(v);
+      }
+    }
   }
 
   // to clear substitutions map
@@ -840,6 +919,7 @@ PreprocessingPassResult UnconstrainedSimplifier::applyInternal(
   d_visited.clear();
   d_visitedOnce.clear();
   d_unconstrained.clear();
+  d_newVars.clear();
 
   return PreprocessingPassResult::NO_CONFLICT;
 }
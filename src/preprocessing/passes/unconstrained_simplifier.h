@@ -25,6 +25,9 @@
 #include <unordered_set>
 #include <vector>
 
+#include "context/cdhashset.h"
+#include "context/cdlist.h"
+#include "context/cdo.h"
 #include "context/context.h"
 #include "expr/node.h"
 #include "preprocessing/preprocessing_pass.h"
@@ -49,6 +52,8 @@ class UnconstrainedSimplifier : public PreprocessingPass
  private:
   /** number of expressions eliminated due to unconstrained simplification */
   IntStat d_numUnconstrainedElim;
+  /** number of definitions of eliminated expressions asserted again */
+  IntStat d_numDefsReintroduced;
 
   using TNodeCountMap = std::unordered_map<TNode, unsigned, TNodeHashFunction>;
   using TNodeMap = std::unordered_map<TNode, TNode, TNodeHashFunction>;
@@ -63,6 +68,29 @@ class UnconstrainedSimplifier : public PreprocessingPass
 
   const LogicInfo& d_logicInfo;
 
+  //------------------------- incremental solving
+  /**
+   * The following are used in incremental mode, where a variable that is
+   * unconstrained in the assertions of one check may be constrained by the
+   * assertions of a later check. To stay sound, every expression t that is
+   * eliminated is replaced by a fresh variable k (or a formula over fresh
+   * variables, see the bit-vector comparisons), and the definition t = k is
+   * remembered for the current user context. Once an assertion of a later
+   * check contains a variable that was unconstrained when expressions were
+   * eliminated, the remembered definitions are asserted again.
+   */
+  /** The variables of the assertions processed in the current user context */
+  context::CDHashSet<Node, NodeHashFunction> d_constrainedSyms;
+  /** The variables that were unconstrained when expressions were eliminated */
+  context::CDHashSet<Node, NodeHashFunction> d_eliminatedSyms;
+  /** The definitions of the eliminated expressions */
+  context::CDList<Node> d_defs;
+  /** The number of definitions in d_defs that were asserted again */
+  context::CDO<size_t> d_numDefsAsserted;
+  /** The fresh variables introduced in the current call */
+  std::unordered_set<Node, NodeHashFunction> d_newVars;
+  //------------------------- end incremental solving
+
   void visitAll(TNode assertion);
   Node newUnconstrainedVar(TypeNode t, TNode var);
   void processUnconstrained();
@@ -16,21 +16,93 @@
 
 #include "preprocessing/preprocessing_pass.h"
 
+#include <chrono>
+#include <unordered_set>
+#include <vector>
+
+#include "options/smt_options.h"
+#include "preprocessing/preprocessing_pass_registry.h"
 #include "smt/dump.h"
 #include "smt/smt_statistics_registry.h"
 
 namespace CVC4 {
 namespace preprocessing {
 
+namespace {
+
+/* Return the number of distinct nodes in the assertions */
+size_t getDagSize(const std::vector<Node>& assertions)
+{
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> toVisit(assertions.begin(), assertions.end());
+  while (!toVisit.empty())
+  {
+    TNode cur = toVisit.back();
+    toVisit.pop_back();
+    if (visited.insert(cur).second)
+    {
+      toVisit.insert(toVisit.end(), cur.begin(), cur.end());
+    }
+  }
+  return visited.size();
+}
+
+}  // namespace
+
 PreprocessingPassResult PreprocessingPass::apply(
     AssertionPipeline* assertionsToPreprocess) {
-  TimerStat::CodeTimer codeTimer(d_timer);
-  Trace("preprocessing") << "PRE " << d_name << std::endl;
-  Chat() << d_name << "..." << std::endl;
-  dumpAssertions(("pre-" + d_name).c_str(), *assertionsToPreprocess);
-  PreprocessingPassResult result = applyInternal(assertionsToPreprocess);
-  dumpAssertions(("post-" + d_name).c_str(), *assertionsToPreprocess);
-  Trace("preprocessing") << "POST " << d_name << std::endl;
+  PreprocessingPassRegistry& ppReg = PreprocessingPassRegistry::getInstance();
+  bool adaptive = options::preprocessAdaptive();
+  bool profile = options::preprocessProfile();
+  std::string logic;
+  if (adaptive)
+  {
+    logic = d_preprocContext->getLogicInfo().getLogicString();
+    if (ppReg.shouldSkip(logic, d_name))
+    {
+      Trace("preprocessing") << "SKIP " << d_name << std::endl;
+      return PreprocessingPassResult::NO_CONFLICT;
+    }
+  }
+  std::vector<Node> before;
+  size_t numSubsts = 0;
+  if (adaptive || profile)
+  {
+    before = assertionsToPreprocess->ref();
+    numSubsts = d_preprocContext->getTopLevelSubstitutions().size();
+  }
+  auto start = std::chrono::steady_clock::now();
+
+  PreprocessingPassResult result;
+  {
+    TimerStat::CodeTimer codeTimer(d_timer);
+    Trace("preprocessing") << "PRE " << d_name << std::endl;
+    Chat() << d_name << "..." << std::endl;
+    dumpAssertions(("pre-" + d_name).c_str(), *assertionsToPreprocess);
+    result = applyInternal(assertionsToPreprocess);
+    dumpAssertions(("post-" + d_name).c_str(), *assertionsToPreprocess);
+    Trace("preprocessing") << "POST " << d_name << std::endl;
+  }
+
+  if (adaptive)
+  {
+    uint64_t millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+    bool changed = result == PreprocessingPassResult::CONFLICT
+                   || before != assertionsToPreprocess->ref()
+                   || numSubsts
+                          != d_preprocContext->getTopLevelSubstitutions().size();
+    ppReg.recordApplication(logic, d_name, millis, changed);
+  }
+  if (profile)
+  {
+    ++d_applications;
+    d_nodesIn += getDagSize(before);
+    d_nodesOut += getDagSize(assertionsToPreprocess->ref());
+    d_substitutions +=
+        d_preprocContext->getTopLevelSubstitutions().size() - numSubsts;
+  }
   return result;
 }
 
@@ -47,15 +119,35 @@ void PreprocessingPass::dumpAssertions(const char* key,
 
 PreprocessingPass::PreprocessingPass(PreprocessingPassContext* preprocContext,
                                      const std::string& name)
-    : d_name(name), d_timer("preprocessing::" + name) {
+    : d_name(name),
+      d_timer("preprocessing::" + name),
+      d_applications("preprocessing::" + name + "::applications", 0),
+      d_nodesIn("preprocessing::" + name + "::nodesIn", 0),
+      d_nodesOut("preprocessing::" + name + "::nodesOut", 0),
+      d_substitutions("preprocessing::" + name + "::substitutions", 0)
+{
   d_preprocContext = preprocContext;
   smtStatisticsRegistry()->registerStat(&d_timer);
+  if (options::preprocessProfile())
+  {
+    smtStatisticsRegistry()->registerStat(&d_applications);
+    smtStatisticsRegistry()->registerStat(&d_nodesIn);
+    smtStatisticsRegistry()->registerStat(&d_nodesOut);
+    smtStatisticsRegistry()->registerStat(&d_substitutions);
+  }
 }
 
 PreprocessingPass::~PreprocessingPass() {
   Assert(smt::smtEngineInScope());
   if (smtStatisticsRegistry() != nullptr) {
     smtStatisticsRegistry()->unregisterStat(&d_timer);
+    if (options::preprocessProfile())
+    {
+      smtStatisticsRegistry()->unregisterStat(&d_applications);
+      smtStatisticsRegistry()->unregisterStat(&d_nodesIn);
+      smtStatisticsRegistry()->unregisterStat(&d_nodesOut);
+      smtStatisticsRegistry()->unregisterStat(&d_substitutions);
+    }
   }
 }
 
@@ -21,6 +21,9 @@
  ** - Dumping assertions before and after the pass
  ** - Initializing the timer
  ** - Tracing and chatting
+ ** - Recording statistics of the pass with --preprocess-profile
+ ** - Skipping the pass with --preprocess-adaptive, see
+ **   PreprocessingPassRegistry::shouldSkip
  **
  ** Optionally, preprocessing passes can overwrite the initInteral() method to
  ** do work that only needs to be done once.
@@ -37,6 +40,7 @@
 #include "preprocessing/preprocessing_pass_context.h"
 #include "smt/smt_engine_scope.h"
 #include "theory/logic_info.h"
+#include "util/statistics_registry.h"
 
 namespace CVC4 {
 namespace preprocessing {
@@ -77,6 +81,16 @@ class PreprocessingPass {
   std::string d_name;
   /* Timer for registering the preprocessing time of this pass */
   TimerStat d_timer;
+  /*
+   * Statistics of the applications of this pass, which are only registered
+   * with --preprocess-profile: the number of applications, the number of
+   * nodes in the assertions before and after each application, and the
+   * number of top-level substitutions learned.
+   */
+  IntStat d_applications;
+  IntStat d_nodesIn;
+  IntStat d_nodesOut;
+  IntStat d_substitutions;
 };
 
 }  // namespace preprocessing
@@ -61,9 +61,11 @@ class PreprocessingPassContext
     return d_symsInAssertions;
   }
 
+  /** Spend the given amount of preprocessing resources */
   void spendResource(unsigned amount)
   {
-    d_resourceManager->spendResource(amount);
+    d_resourceManager->spendResource(ResourceManager::Resource::PreprocessStep,
+                                     amount);
   }
 
   const LogicInfo& getLogicInfo() { return d_smt->d_logic; }
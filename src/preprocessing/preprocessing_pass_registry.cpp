@@ -31,7 +31,9 @@
 #include "preprocessing/passes/bv_eager_atoms.h"
 #include "preprocessing/passes/bv_gauss.h"
 #include "preprocessing/passes/bv_intro_pow2.h"
+#include "preprocessing/passes/bv_sls.h"
 #include "preprocessing/passes/bv_to_bool.h"
+#include "preprocessing/passes/cardinality_constraints.h"
 #include "preprocessing/passes/extended_rewriter_pass.h"
 #include "preprocessing/passes/global_negate.h"
 #include "preprocessing/passes/ho_elim.h"
@@ -47,6 +49,7 @@
 #include "preprocessing/passes/real_to_int.h"
 #include "preprocessing/passes/rewrite.h"
 #include "preprocessing/passes/sep_skolem_emp.h"
+#include "preprocessing/passes/solve_components.h"
 #include "preprocessing/passes/sort_infer.h"
 #include "preprocessing/passes/static_learning.h"
 #include "preprocessing/passes/sygus_inference.h"
@@ -70,10 +73,15 @@ PreprocessingPassRegistry& PreprocessingPassRegistry::getInstance()
 
 void PreprocessingPassRegistry::registerPassInfo(
     const std::string& name,
-    std::function<PreprocessingPass*(PreprocessingPassContext*)> ctor)
+    std::function<PreprocessingPass*(PreprocessingPassContext*)> ctor,
+    bool optional)
 {
   AlwaysAssert(!ContainsKey(d_ppInfo, name));
   d_ppInfo[name] = ctor;
+  if (optional)
+  {
+    d_optionalPasses.insert(name);
+  }
 }
 
 PreprocessingPass* PreprocessingPassRegistry::createPass(
@@ -98,6 +106,44 @@ bool PreprocessingPassRegistry::hasPass(const std::string& name)
   return d_ppInfo.find(name) != d_ppInfo.end();
 }
 
+void PreprocessingPassRegistry::recordApplication(const std::string& logic,
+                                                  const std::string& name,
+                                                  uint64_t millis,
+                                                  bool changed)
+{
+  std::lock_guard<std::mutex> lock(d_historyMutex);
+  PassHistory& h = d_history[logic + ":" + name];
+  ++h.d_applications;
+  h.d_millis += millis;
+  if (changed)
+  {
+    ++h.d_changed;
+  }
+}
+
+bool PreprocessingPassRegistry::shouldSkip(const std::string& logic,
+                                           const std::string& name)
+{
+  if (d_optionalPasses.find(name) == d_optionalPasses.end())
+  {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(d_historyMutex);
+  auto it = d_history.find(logic + ":" + name);
+  if (it == d_history.end())
+  {
+    return false;
+  }
+  PassHistory& h = it->second;
+  if (h.d_applications < 2 || h.d_changed > 0
+      || h.d_millis < 10 * h.d_applications)
+  {
+    return false;
+  }
+  ++h.d_skipped;
+  return h.d_skipped % 8 != 0;
+}
+
 namespace {
 
 /**
@@ -118,9 +164,9 @@ PreprocessingPass* callCtor(PreprocessingPassContext* ppCtx)
 PreprocessingPassRegistry::PreprocessingPassRegistry()
 {
   registerPassInfo("apply-substs", callCtor<ApplySubsts>);
-  registerPassInfo("bv-gauss", callCtor<BVGauss>);
-  registerPassInfo("static-learning", callCtor<StaticLearning>);
-  registerPassInfo("ite-simp", callCtor<ITESimp>);
+  registerPassInfo("bv-gauss", callCtor<BVGauss>, true);
+  registerPassInfo("static-learning", callCtor<StaticLearning>, true);
+  registerPassInfo("ite-simp", callCtor<ITESimp>, true);
   registerPassInfo("apply-to-const", callCtor<ApplyToConst>);
   registerPassInfo("global-negate", callCtor<GlobalNegate>);
   registerPassInfo("int-to-bv", callCtor<IntToBV>);
@@ -128,14 +174,18 @@ PreprocessingPassRegistry::PreprocessingPassRegistry()
   registerPassInfo("real-to-int", callCtor<RealToInt>);
   registerPassInfo("sygus-infer", callCtor<SygusInference>);
   registerPassInfo("bv-to-bool", callCtor<BVToBool>);
-  registerPassInfo("bv-intro-pow2", callCtor<BvIntroPow2>);
+  registerPassInfo("bv-intro-pow2", callCtor<BvIntroPow2>, true);
+  registerPassInfo("bv-sls", callCtor<BvSls>);
   registerPassInfo("sort-inference", callCtor<SortInferencePass>);
   registerPassInfo("sep-skolem-emp", callCtor<SepSkolemEmp>);
+  registerPassInfo("solve-components", callCtor<SolveComponents>);
   registerPassInfo("rewrite", callCtor<Rewrite>);
   registerPassInfo("bv-abstraction", callCtor<BvAbstraction>);
   registerPassInfo("bv-eager-atoms", callCtor<BvEagerAtoms>);
   registerPassInfo("pseudo-boolean-processor",
                    callCtor<PseudoBooleanProcessor>);
+  registerPassInfo("cardinality-constraints",
+                   callCtor<CardinalityConstraints>);
   registerPassInfo("unconstrained-simplifier",
                    callCtor<UnconstrainedSimplifier>);
   registerPassInfo("quantifiers-preprocess", callCtor<QuantifiersPreprocess>);
@@ -144,7 +194,7 @@ PreprocessingPassRegistry::PreprocessingPassRegistry()
   registerPassInfo("non-clausal-simp", callCtor<NonClausalSimp>);
   registerPassInfo("ackermann", callCtor<Ackermann>);
   registerPassInfo("sym-break", callCtor<SymBreakerPass>);
-  registerPassInfo("ext-rew-pre", callCtor<ExtRewPre>);
+  registerPassInfo("ext-rew-pre", callCtor<ExtRewPre>, true);
   registerPassInfo("theory-preprocess", callCtor<TheoryPreprocess>);
   registerPassInfo("quantifier-macros", callCtor<QuantifierMacros>);
   registerPassInfo("nl-ext-purify", callCtor<NlExtPurify>);
@@ -20,8 +20,10 @@
 #define CVC4__PREPROCESSING__PREPROCESSING_PASS_REGISTRY_H
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "preprocessing/preprocessing_pass.h"
 
@@ -50,10 +52,13 @@ class PreprocessingPassRegistry {
    * @param name The name of the preprocessing pass to register
    * @param ctor A function that creates an instance of the pass given a
    *             preprocessing pass context
+   * @param optional Whether the pass only simplifies the assertions, and may
+   *                 hence be skipped by the adaptive scheduling of passes
    */
   void registerPassInfo(
       const std::string& name,
-      std::function<PreprocessingPass*(PreprocessingPassContext*)> ctor);
+      std::function<PreprocessingPass*(PreprocessingPassContext*)> ctor,
+      bool optional = false);
 
   /**
    * Creates an instance of a pass.
@@ -77,7 +82,50 @@ class PreprocessingPassRegistry {
    */
   bool hasPass(const std::string& name);
 
+  /**
+   * Records an application of a pass on a logic, for the adaptive scheduling
+   * of passes (--preprocess-adaptive).
+   *
+   * @param logic The logic of the solver that applied the pass
+   * @param name The name of the pass
+   * @param millis The time in milliseconds the application took
+   * @param changed Whether the application changed the assertions
+   */
+  void recordApplication(const std::string& logic,
+                         const std::string& name,
+                         uint64_t millis,
+                         bool changed);
+
+  /**
+   * Returns true if the adaptive scheduling of passes skips the next
+   * application of a pass on a logic. This is the case if the pass is
+   * optional, was applied at least twice on the logic without ever changing
+   * the assertions, and took at least 10 milliseconds per application on
+   * average. Every eighth skipped application is performed nevertheless, so
+   * that the history of the pass is updated.
+   *
+   * @param logic The logic of the solver that applies the pass
+   * @param name The name of the pass
+   */
+  bool shouldSkip(const std::string& logic, const std::string& name);
+
  private:
+  /** The history of the applications of a pass on a logic */
+  struct PassHistory
+  {
+    PassHistory() : d_applications(0), d_changed(0), d_millis(0), d_skipped(0)
+    {
+    }
+    /** The number of applications */
+    uint64_t d_applications;
+    /** The number of applications that changed the assertions */
+    uint64_t d_changed;
+    /** The total time of the applications, in milliseconds */
+    uint64_t d_millis;
+    /** The number of applications skipped */
+    uint64_t d_skipped;
+  };
+
   /**
    * Private constructor for the preprocessing pass registry. The
    * registry is a singleton and no other instance should be created.
@@ -92,6 +140,17 @@ class PreprocessingPassRegistry {
       std::string,
       std::function<PreprocessingPass*(PreprocessingPassContext*)> >
       d_ppInfo;
+
+  /** The names of the optional passes */
+  std::unordered_set<std::string> d_optionalPasses;
+
+  /**
+   * Map from a logic and the name of a pass, separated by a colon, to the
+   * history of the pass on the logic. The registry is shared by all solver
+   * instances, hence the history is protected by d_historyMutex.
+   */
+  std::unordered_map<std::string, PassHistory> d_history;
+  std::mutex d_historyMutex;
 };  // class PreprocessingPassRegistry
 
 }  // namespace preprocessing
@@ -25,6 +25,7 @@
 #include "smt/smt_statistics_registry.h"
 #include "theory/rewriter.h"
 #include "theory/theory.h"
+#include "util/hash.h"
 
 using namespace std;
 namespace CVC4 {
@@ -179,11 +180,10 @@ bool ContainsTermITEVisitor::containsTermITE(TNode e)
     return false;
   }
 
-  NodeBoolMap::const_iterator end = d_cache.end();
-  NodeBoolMap::const_iterator tmp_it = d_cache.find(e);
-  if (tmp_it != end)
+  const bool* cached = d_cache.find(e);
+  if (cached != nullptr)
   {
-    return (*tmp_it).second;
+    return *cached;
   }
 
   bool foundTermIte = false;
@@ -212,10 +212,10 @@ bool ContainsTermITEVisitor::containsTermITE(TNode e)
       }
       else
       {
-        tmp_it = d_cache.find(child);
-        if (tmp_it != end)
+        cached = d_cache.find(child);
+        if (cached != nullptr)
         {
-          foundTermIte = (*tmp_it).second;
+          foundTermIte = *cached;
         }
         else
         {
@@ -236,7 +236,7 @@ bool ContainsTermITEVisitor::containsTermITE(TNode e)
   }
   return foundTermIte;
 }
-void ContainsTermITEVisitor::garbageCollect() { d_cache.clear(); }
+void ContainsTermITEVisitor::garbageCollect() { d_cache.release(); }
 
 /*********************                                                        */
 /* IncomingArcCounter
@@ -269,9 +269,10 @@ void IncomingArcCounter::computeReachability(
     {
       continue;
     }
-    if (d_reachCount.find(back) != d_reachCount.end())
+    uint32_t* count = d_reachCount.find(back);
+    if (count != nullptr)
     {
-      d_reachCount[back] = 1 + d_reachCount[back];
+      ++(*count);
     }
     else
     {
@@ -307,7 +308,11 @@ void ITECompressor::reset()
   d_compressed.clear();
 }
 
-void ITECompressor::garbageCollect() { reset(); }
+void ITECompressor::garbageCollect()
+{
+  d_incoming.clear();
+  d_compressed.release();
+}
 
 ITECompressor::Statistics::Statistics()
     : d_compressCalls("ite-simp::compressCalls", 0),
@@ -334,7 +339,7 @@ Node ITECompressor::push_back_boolean(Node original, Node compressed)
     d_compressed[rewritten] = rewritten;
     return rewritten;
   }
-  else if (d_compressed.find(rewritten) != d_compressed.end())
+  else if (d_compressed.contains(rewritten))
   {
     Node res = d_compressed[rewritten];
     d_compressed[original] = res;
@@ -440,9 +445,10 @@ Node ITECompressor::compressTerm(Node toCompress)
     return toCompress;
   }
 
-  if (d_compressed.find(toCompress) != d_compressed.end())
+  const Node* cached = d_compressed.find(toCompress);
+  if (cached != nullptr)
   {
-    return d_compressed[toCompress];
+    return *cached;
   }
   if (toCompress.getKind() == kind::ITE)
   {
@@ -450,7 +456,7 @@ Node ITECompressor::compressTerm(Node toCompress)
     if (cmpCnd.isConst())
     {
       Node branch = (cmpCnd == d_true) ? toCompress[1] : toCompress[2];
-      Node res = compressTerm(toCompress);
+      Node res = compressTerm(branch);
       d_compressed[toCompress] = res;
       return res;
     }
@@ -486,15 +492,16 @@ Node ITECompressor::compressTerm(Node toCompress)
 
 Node ITECompressor::compressBoolean(Node toCompress)
 {
-  static int instance = 0;
+  static thread_local int instance = 0;
   ++instance;
   if (toCompress.isConst() || toCompress.isVar())
   {
     return toCompress;
   }
-  if (d_compressed.find(toCompress) != d_compressed.end())
+  const Node* cached = d_compressed.find(toCompress);
+  if (cached != nullptr)
   {
-    return d_compressed[toCompress];
+    return *cached;
   }
   else if (toCompress.getKind() == kind::ITE)
   {
@@ -560,7 +567,7 @@ TermITEHeightCounter::TermITEHeightCounter() : d_termITEHeight() {}
 
 TermITEHeightCounter::~TermITEHeightCounter() {}
 
-void TermITEHeightCounter::clear() { d_termITEHeight.clear(); }
+void TermITEHeightCounter::clear() { d_termITEHeight.release(); }
 
 size_t TermITEHeightCounter::cache_size() const
 {
@@ -585,11 +592,10 @@ uint32_t TermITEHeightCounter::termITEHeight(TNode e)
     return 0;
   }
 
-  NodeCountMap::const_iterator end = d_termITEHeight.end();
-  NodeCountMap::const_iterator tmp_it = d_termITEHeight.find(e);
-  if (tmp_it != end)
+  const uint32_t* cached = d_termITEHeight.find(e);
+  if (cached != nullptr)
   {
-    return (*tmp_it).second;
+    return *cached;
   }
 
   uint32_t returnValue = 0;
@@ -627,10 +633,10 @@ uint32_t TermITEHeightCounter::termITEHeight(TNode e)
       }
       else
       {
-        tmp_it = d_termITEHeight.find(child);
-        if (tmp_it != end)
+        cached = d_termITEHeight.find(child);
+        if (cached != nullptr)
         {
-          returnValue = (*tmp_it).second;
+          returnValue = *cached;
         }
         else
         {
@@ -646,7 +652,7 @@ ITESimplifier::ITESimplifier(ContainsTermITEVisitor* contains)
     : d_containsVisitor(contains),
       d_termITEHeight(),
       d_constantLeaves(),
-      d_allocatedConstantLeaves(),
+      d_constantLeafSets(),
       d_citeEqConstApplications(0),
       d_constantIteEqualsConstantCache(),
       d_replaceOverCache(),
@@ -665,7 +671,7 @@ ITESimplifier::~ITESimplifier()
 {
   clearSimpITECaches();
   Assert(d_constantLeaves.empty());
-  Assert(d_allocatedConstantLeaves.empty());
+  Assert(d_constantLeafSets.empty());
 }
 
 bool ITESimplifier::leavesAreConst(TNode e)
@@ -676,23 +682,18 @@ bool ITESimplifier::leavesAreConst(TNode e)
 void ITESimplifier::clearSimpITECaches()
 {
   Chat() << "clear ite caches " << endl;
-  for (size_t i = 0, N = d_allocatedConstantLeaves.size(); i < N; ++i)
-  {
-    NodeVec* curr = d_allocatedConstantLeaves[i];
-    delete curr;
-  }
   d_citeEqConstApplications = 0;
   d_constantLeaves.clear();
-  d_allocatedConstantLeaves.clear();
+  d_constantLeafSets.clear();
   d_termITEHeight.clear();
   d_constantIteEqualsConstantCache.clear();
   d_replaceOverCache.clear();
   d_replaceOverTermIteCache.clear();
-  d_simpITECache.clear();
+  d_simpITECache.release();
   d_simpVars.clear();
   d_simpConstCache.clear();
-  d_leavesConstCache.clear();
-  d_simpContextCache.clear();
+  d_leavesConstCache.release();
+  d_simpContextCache.release();
 }
 
 bool ITESimplifier::doneALotOfWorkHeuristic() const
@@ -743,7 +744,7 @@ bool ITESimplifier::isConstantIte(TNode e)
   }
   else if (ite::isTermITE(e))
   {
-    NodeVec* constants = computeConstantLeaves(e);
+    const NodeVec* constants = computeConstantLeaves(e);
     return constants != NULL;
   }
   else
@@ -752,7 +753,23 @@ bool ITESimplifier::isConstantIte(TNode e)
   }
 }
 
-ITESimplifier::NodeVec* ITESimplifier::computeConstantLeaves(TNode ite)
+size_t ITESimplifier::NodeVecHashFunction::operator()(
+    const NodeVec& v) const
+{
+  uint64_t hash = fnv1a::fnv1a_64(v.size());
+  for (const Node& n : v)
+  {
+    hash = fnv1a::fnv1a_64(NodeHashFunction()(n), hash);
+  }
+  return static_cast<size_t>(hash);
+}
+
+const ITESimplifier::NodeVec* ITESimplifier::mkConstantLeaves(NodeVec& leaves)
+{
+  return &*d_constantLeafSets.insert(std::move(leaves)).first;
+}
+
+const ITESimplifier::NodeVec* ITESimplifier::computeConstantLeaves(TNode ite)
 {
   Assert(ite::isTermITE(ite));
   ConstantLeavesMap::const_iterator it = d_constantLeaves.find(ite);
@@ -761,68 +778,67 @@ ITESimplifier::NodeVec* ITESimplifier::computeConstantLeaves(TNode ite)
   {
     return (*it).second;
   }
-  TNode thenB = ite[1];
-  TNode elseB = ite[2];
-
-  // special case 2 constant children
-  if (thenB.isConst() && elseB.isConst())
-  {
-    NodeVec* pair = new NodeVec(2);
-    d_allocatedConstantLeaves.push_back(pair);
-
-    (*pair)[0] = std::min(thenB, elseB);
-    (*pair)[1] = std::max(thenB, elseB);
-    d_constantLeaves[ite] = pair;
-    return pair;
-  }
-  // At least 1 is an ITE
-  if (!(thenB.isConst() || thenB.getKind() == kind::ITE)
-      || !(elseB.isConst() || elseB.getKind() == kind::ITE))
-  {
-    // Cannot be a termITE tree
-    d_constantLeaves[ite] = NULL;
-    return NULL;
-  }
 
-  // At least 1 is not a constant
-  TNode definitelyITE = thenB.isConst() ? elseB : thenB;
-  TNode maybeITE = thenB.isConst() ? thenB : elseB;
-
-  NodeVec* defChildren = computeConstantLeaves(definitelyITE);
-  if (defChildren == NULL)
-  {
-    d_constantLeaves[ite] = NULL;
-    return NULL;
-  }
-
-  NodeVec scratch;
-  NodeVec* maybeChildren = NULL;
-  if (maybeITE.getKind() == kind::ITE)
-  {
-    maybeChildren = computeConstantLeaves(maybeITE);
-  }
-  else
-  {
-    scratch.push_back(maybeITE);
-    maybeChildren = &scratch;
-  }
-  if (maybeChildren == NULL)
+  // Compute the leaves of the ites below ite first, using an explicit stack
+  // so that long chains of ites do not exhaust the call stack
+  std::vector<TNode> toVisit;
+  toVisit.push_back(ite);
+  while (!toVisit.empty())
   {
-    d_constantLeaves[ite] = NULL;
-    return NULL;
-  }
-
-  NodeVec* both = new NodeVec(defChildren->size() + maybeChildren->size());
-  d_allocatedConstantLeaves.push_back(both);
-  NodeVec::iterator newEnd;
-  newEnd = std::set_union(defChildren->begin(),
-                          defChildren->end(),
-                          maybeChildren->begin(),
-                          maybeChildren->end(),
-                          both->begin());
-  both->resize(newEnd - both->begin());
-  d_constantLeaves[ite] = both;
-  return both;
+    TNode cur = toVisit.back();
+    if (d_constantLeaves.find(cur) != d_constantLeaves.end())
+    {
+      toVisit.pop_back();
+      continue;
+    }
+    TNode thenB = cur[1];
+    TNode elseB = cur[2];
+    if (!(thenB.isConst() || thenB.getKind() == kind::ITE)
+        || !(elseB.isConst() || elseB.getKind() == kind::ITE))
+    {
+      // Cannot be a termITE tree
+      d_constantLeaves[cur] = NULL;
+      toVisit.pop_back();
+      continue;
+    }
+    bool pending = false;
+    for (unsigned i = 1; i <= 2; ++i)
+    {
+      if (!cur[i].isConst()
+          && d_constantLeaves.find(cur[i]) == d_constantLeaves.end())
+      {
+        toVisit.push_back(cur[i]);
+        pending = true;
+      }
+    }
+    if (pending)
+    {
+      continue;
+    }
+    toVisit.pop_back();
+
+    NodeVec thenScratch(1, thenB);
+    NodeVec elseScratch(1, elseB);
+    const NodeVec* thenLeaves =
+        thenB.isConst() ? &thenScratch : d_constantLeaves[thenB];
+    const NodeVec* elseLeaves =
+        elseB.isConst() ? &elseScratch : d_constantLeaves[elseB];
+    if (thenLeaves == NULL || elseLeaves == NULL)
+    {
+      d_constantLeaves[cur] = NULL;
+      continue;
+    }
+    NodeVec both(thenLeaves->size() + elseLeaves->size());
+    NodeVec::iterator newEnd;
+    newEnd = std::set_union(thenLeaves->begin(),
+                            thenLeaves->end(),
+                            elseLeaves->begin(),
+                            elseLeaves->end(),
+                            both.begin());
+    both.resize(newEnd - both.begin());
+    d_constantLeaves[cur] = mkConstantLeaves(both);
+  }
+  return d_constantLeaves[ite];
 }
 
 // This is uncached! Better for protoyping or getting limited size examples
@@ -842,44 +858,47 @@ struct IteTreeSearchData
 };
 void iteTreeSearch(Node e, int depth, IteTreeSearchData& search)
 {
-  if (search.maxDepth >= 0 && depth > search.maxDepth)
-  {
-    search.failure = true;
-  }
-  if (search.failure)
-  {
-    return;
-  }
-  if (search.visited.find(e) != search.visited.end())
-  {
-    return;
-  }
-  else
-  {
-    search.visited.insert(e);
-  }
-
-  if (e.isConst())
-  {
-    search.constants.insert(e);
-    if (search.maxConstants >= 0
-        && search.constants.size() > (unsigned)search.maxConstants)
+  std::vector<std::pair<Node, int>> toVisit;
+  toVisit.push_back(std::make_pair(e, depth));
+  while (!toVisit.empty() && !search.failure)
+  {
+    Node cur = toVisit.back().first;
+    int curDepth = toVisit.back().second;
+    toVisit.pop_back();
+    if (search.maxDepth >= 0 && curDepth > search.maxDepth)
     {
       search.failure = true;
+      break;
     }
-  }
-  else if (e.getKind() == kind::ITE)
-  {
-    iteTreeSearch(e[1], depth + 1, search);
-    iteTreeSearch(e[2], depth + 1, search);
-  }
-  else
-  {
-    search.nonConstants.insert(e);
-    if (search.maxNonconstants >= 0
-        && search.nonConstants.size() > (unsigned)search.maxNonconstants)
+    if (search.visited.find(cur) != search.visited.end())
     {
-      search.failure = true;
+      continue;
+    }
+    search.visited.insert(cur);
+
+    if (cur.isConst())
+    {
+      search.constants.insert(cur);
+      if (search.maxConstants >= 0
+          && search.constants.size() > (unsigned)search.maxConstants)
+      {
+        search.failure = true;
+      }
+    }
+    else if (cur.getKind() == kind::ITE)
+    {
+      // visit the then branch first
+      toVisit.push_back(std::make_pair(cur[2], curDepth + 1));
+      toVisit.push_back(std::make_pair(cur[1], curDepth + 1));
+    }
+    else
+    {
+      search.nonConstants.insert(cur);
+      if (search.maxNonconstants >= 0
+          && search.nonConstants.size() > (unsigned)search.maxNonconstants)
+      {
+        search.failure = true;
+      }
     }
   }
 }
@@ -922,25 +941,51 @@ Node ITESimplifier::replaceOver(Node n, Node replaceWith, Node simpVar)
 
 Node ITESimplifier::replaceOverTermIte(Node e, Node simpAtom, Node simpVar)
 {
-  if (e.getKind() == kind::ITE)
+  if (e.getKind() != kind::ITE)
   {
-    pair<Node, Node> p = make_pair(e, simpAtom);
+    return replaceOver(simpAtom, e, simpVar);
+  }
+  // Rebuild the ite tree of e bottom-up, using an explicit stack
+  std::vector<Node> toVisit;
+  toVisit.push_back(e);
+  while (!toVisit.empty())
+  {
+    Node cur = toVisit.back();
+    pair<Node, Node> p = make_pair(cur, simpAtom);
     if (d_replaceOverTermIteCache.find(p) != d_replaceOverTermIteCache.end())
     {
-      return d_replaceOverTermIteCache[p];
+      toVisit.pop_back();
+      continue;
     }
-    Assert(!e.getType().isBoolean());
-    Node cnd = e[0];
-    Node newThen = replaceOverTermIte(e[1], simpAtom, simpVar);
-    Node newElse = replaceOverTermIte(e[2], simpAtom, simpVar);
-    Node newIte = cnd.iteNode(newThen, newElse);
-    d_replaceOverTermIteCache[p] = newIte;
-    return newIte;
-  }
-  else
-  {
-    return replaceOver(simpAtom, e, simpVar);
+    Assert(!cur.getType().isBoolean());
+    bool pending = false;
+    for (unsigned i = 1; i <= 2; ++i)
+    {
+      if (cur[i].getKind() == kind::ITE
+          && d_replaceOverTermIteCache.find(make_pair(cur[i], simpAtom))
+                 == d_replaceOverTermIteCache.end())
+      {
+        toVisit.push_back(cur[i]);
+        pending = true;
+      }
+    }
+    if (pending)
+    {
+      continue;
+    }
+    toVisit.pop_back();
+    Node branches[2];
+    for (unsigned i = 1; i <= 2; ++i)
+    {
+      branches[i - 1] =
+          cur[i].getKind() == kind::ITE
+              ? d_replaceOverTermIteCache[make_pair(cur[i], simpAtom)]
+              : replaceOver(simpAtom, cur[i], simpVar);
+    }
+    Node cnd = cur[0];
+    d_replaceOverTermIteCache[p] = cnd.iteNode(branches[0], branches[1]);
   }
+  return d_replaceOverTermIteCache[make_pair(e, simpAtom)];
 }
 
 Node ITESimplifier::attemptLiftEquality(TNode atom)
@@ -1086,79 +1131,93 @@ Node ITESimplifier::transformAtom(TNode atom)
   }
 }
 
-static unsigned numBranches = 0;
-static unsigned numFalseBranches = 0;
-static unsigned itesMade = 0;
+static thread_local unsigned numBranches = 0;
+static thread_local unsigned numFalseBranches = 0;
+static thread_local unsigned itesMade = 0;
 
 Node ITESimplifier::constantIteEqualsConstant(TNode cite, TNode constant)
 {
-  static int instance = 0;
-  ++instance;
   Debug("ite::constantIteEqualsConstant")
-      << instance << "constantIteEqualsConstant(" << cite << ", " << constant
-      << ")" << endl;
+      << "constantIteEqualsConstant(" << cite << ", " << constant << ")"
+      << endl;
   if (cite.isConst())
   {
-    Node res = (cite == constant) ? d_true : d_false;
-    Debug("ite::constantIteEqualsConstant") << instance << "->" << res << endl;
-    return res;
+    return (cite == constant) ? d_true : d_false;
   }
-  std::pair<Node, Node> pair = make_pair(cite, constant);
-
-  NodePairMap::const_iterator eq_pos =
-      d_constantIteEqualsConstantCache.find(pair);
-  if (eq_pos != d_constantIteEqualsConstantCache.end())
-  {
-    Debug("ite::constantIteEqualsConstant")
-        << instance << "->" << (*eq_pos).second << endl;
-    return (*eq_pos).second;
-  }
-
-  ++d_citeEqConstApplications;
-
-  NodeVec* leaves = computeConstantLeaves(cite);
-  Assert(leaves != NULL);
-  if (std::binary_search(leaves->begin(), leaves->end(), constant))
+  // Compute the equalities of the branches of cite first, using an explicit
+  // stack so that long chains of ites do not exhaust the call stack
+  std::vector<TNode> toVisit;
+  toVisit.push_back(cite);
+  while (!toVisit.empty())
   {
+    TNode cur = toVisit.back();
+    std::pair<Node, Node> pair = make_pair(cur, constant);
+    if (d_constantIteEqualsConstantCache.find(pair)
+        != d_constantIteEqualsConstantCache.end())
+    {
+      toVisit.pop_back();
+      continue;
+    }
+    const NodeVec* leaves = computeConstantLeaves(cur);
+    Assert(leaves != NULL);
+    if (!std::binary_search(leaves->begin(), leaves->end(), constant))
+    {
+      ++d_citeEqConstApplications;
+      d_constantIteEqualsConstantCache[pair] = d_false;
+      toVisit.pop_back();
+      continue;
+    }
     if (leaves->size() == 1)
     {
       // probably unreachable
+      ++d_citeEqConstApplications;
       d_constantIteEqualsConstantCache[pair] = d_true;
-      Debug("ite::constantIteEqualsConstant")
-          << instance << "->" << d_true << endl;
-      return d_true;
+      toVisit.pop_back();
+      continue;
     }
-    else
+    Assert(cur.getKind() == kind::ITE);
+    bool pending = false;
+    for (unsigned i = 1; i <= 2; ++i)
     {
-      Assert(cite.getKind() == kind::ITE);
-      TNode cnd = cite[0];
-      TNode tB = cite[1];
-      TNode fB = cite[2];
-      Node tEqs = constantIteEqualsConstant(tB, constant);
-      Node fEqs = constantIteEqualsConstant(fB, constant);
-      Node boolIte = cnd.iteNode(tEqs, fEqs);
-      if (!(tEqs.isConst() || fEqs.isConst()))
+      if (!cur[i].isConst()
+          && d_constantIteEqualsConstantCache.find(make_pair(cur[i], constant))
+                 == d_constantIteEqualsConstantCache.end())
       {
-        ++numBranches;
+        toVisit.push_back(cur[i]);
+        pending = true;
       }
-      if (!(tEqs == d_false || fEqs == d_false))
-      {
-        ++numFalseBranches;
-      }
-      ++itesMade;
-      d_constantIteEqualsConstantCache[pair] = boolIte;
-      // Debug("ite::constantIteEqualsConstant") << instance << "->" << boolIte
-      // << endl;
-      return boolIte;
     }
+    if (pending)
+    {
+      continue;
+    }
+    toVisit.pop_back();
+    Node eqs[2];
+    for (unsigned i = 1; i <= 2; ++i)
+    {
+      eqs[i - 1] =
+          cur[i].isConst()
+              ? ((cur[i] == constant) ? d_true : d_false)
+              : d_constantIteEqualsConstantCache[make_pair(cur[i], constant)];
+    }
+    Node tEqs = eqs[0];
+    Node fEqs = eqs[1];
+    Node boolIte = cur[0].iteNode(tEqs, fEqs);
+    if (!(tEqs.isConst() || fEqs.isConst()))
+    {
+      ++numBranches;
+    }
+    if (!(tEqs == d_false || fEqs == d_false))
+    {
+      ++numFalseBranches;
+    }
+    ++itesMade;
+    ++d_citeEqConstApplications;
+    d_constantIteEqualsConstantCache[pair] = boolIte;
   }
-  else
-  {
-    d_constantIteEqualsConstantCache[pair] = d_false;
-    Debug("ite::constantIteEqualsConstant")
-        << instance << "->" << d_false << endl;
-    return d_false;
-  }
+  Node res = d_constantIteEqualsConstantCache[make_pair(cite, constant)];
+  Debug("ite::constantIteEqualsConstant") << "->" << res << endl;
+  return res;
 }
 
 Node ITESimplifier::intersectConstantIte(TNode lcite, TNode rcite)
@@ -1184,8 +1243,8 @@ Node ITESimplifier::intersectConstantIte(TNode lcite, TNode rcite)
   Assert(lcite.getKind() == kind::ITE);
   Assert(rcite.getKind() == kind::ITE);
 
-  NodeVec* leftValues = computeConstantLeaves(lcite);
-  NodeVec* rightValues = computeConstantLeaves(rcite);
+  const NodeVec* leftValues = computeConstantLeaves(lcite);
+  const NodeVec* rightValues = computeConstantLeaves(rcite);
 
   uint32_t smaller = std::min(leftValues->size(), rightValues->size());
 
@@ -1248,7 +1307,7 @@ Node ITESimplifier::attemptEagerRemoval(TNode atom)
         }
       }
 
-      NodeVec* leaves = computeConstantLeaves(cite);
+      const NodeVec* leaves = computeConstantLeaves(cite);
       Assert(leaves != NULL);
       if (!std::binary_search(leaves->begin(), leaves->end(), constant))
       {
@@ -1284,37 +1343,67 @@ bool ITESimplifier::leavesAreConst(TNode e, theory::TheoryId tid)
     return true;
   }
 
-  unordered_map<Node, bool, NodeHashFunction>::iterator it;
-  it = d_leavesConstCache.find(e);
-  if (it != d_leavesConstCache.end())
-  {
-    return (*it).second;
-  }
-
-  if (!containsTermITE(e) && theory::Theory::isLeafOf(e, tid))
-  {
-    d_leavesConstCache[e] = false;
-    return false;
-  }
-
-  Assert(e.getNumChildren() > 0);
-  size_t k = 0, sz = e.getNumChildren();
-
-  if (e.getKind() == kind::ITE)
+  const bool* cached;
+  std::vector<TNode> toVisit;
+  toVisit.push_back(e);
+  while (!toVisit.empty())
   {
-    k = 1;
-  }
+    TNode cur = toVisit.back();
+    if (d_leavesConstCache.contains(cur))
+    {
+      toVisit.pop_back();
+      continue;
+    }
+    if (!containsTermITE(cur) && theory::Theory::isLeafOf(cur, tid))
+    {
+      d_leavesConstCache[cur] = false;
+      toVisit.pop_back();
+      continue;
+    }
 
-  for (; k < sz; ++k)
-  {
-    if (!leavesAreConst(e[k], tid))
+    Assert(cur.getNumChildren() > 0);
+    size_t k = (cur.getKind() == kind::ITE) ? 1 : 0;
+    size_t sz = cur.getNumChildren();
+    // A child known to have a non-constant leaf decides cur
+    bool hasNonConst = false;
+    bool pending = false;
+    for (size_t i = k; i < sz && !hasNonConst; ++i)
     {
-      d_leavesConstCache[e] = false;
-      return false;
+      if (cur[i].isConst())
+      {
+        continue;
+      }
+      cached = d_leavesConstCache.find(cur[i]);
+      if (cached == nullptr)
+      {
+        pending = true;
+      }
+      else if (!*cached)
+      {
+        hasNonConst = true;
+      }
+    }
+    if (hasNonConst)
+    {
+      d_leavesConstCache[cur] = false;
+      toVisit.pop_back();
+      continue;
+    }
+    if (!pending)
+    {
+      d_leavesConstCache[cur] = true;
+      toVisit.pop_back();
+      continue;
+    }
+    for (size_t i = k; i < sz; ++i)
+    {
+      if (!cur[i].isConst() && !d_leavesConstCache.contains(cur[i]))
+      {
+        toVisit.push_back(cur[i]);
+      }
     }
   }
-  d_leavesConstCache[e] = true;
-  return true;
+  return d_leavesConstCache[e];
 }
 
 Node ITESimplifier::simpConstants(TNode simpContext,
@@ -1330,23 +1419,55 @@ Node ITESimplifier::simpConstants(TNode simpContext,
 
   if (iteNode.getKind() == kind::ITE)
   {
-    NodeBuilder<> builder(kind::ITE);
-    builder << iteNode[0];
-    unsigned i = 1;
-    for (; i < iteNode.getNumChildren(); ++i)
+    // Simplify the ite tree of iteNode bottom-up, using an explicit stack so
+    // that long chains of ites do not exhaust the call stack. Only the leaves
+    // of the tree, which are not ites, are simplified by a recursive call.
+    std::vector<TNode> toVisit;
+    toVisit.push_back(iteNode);
+    while (!toVisit.empty())
     {
-      Node n = simpConstants(simpContext, iteNode[i], simpVar);
-      if (n.isNull())
+      TNode cur = toVisit.back();
+      if (d_simpConstCache.find(pair<Node, Node>(simpContext, cur))
+          != d_simpConstCache.end())
       {
-        return n;
+        toVisit.pop_back();
+        continue;
+      }
+      bool pending = false;
+      for (unsigned i = 1; i < cur.getNumChildren(); ++i)
+      {
+        if (cur[i].getKind() == kind::ITE
+            && d_simpConstCache.find(pair<Node, Node>(simpContext, cur[i]))
+                   == d_simpConstCache.end())
+        {
+          toVisit.push_back(cur[i]);
+          pending = true;
+        }
       }
-      builder << n;
+      if (pending)
+      {
+        continue;
+      }
+      toVisit.pop_back();
+      NodeBuilder<> builder(kind::ITE);
+      builder << cur[0];
+      for (unsigned i = 1; i < cur.getNumChildren(); ++i)
+      {
+        Node n = cur[i].getKind() == kind::ITE
+                     ? d_simpConstCache[pair<Node, Node>(simpContext, cur[i])]
+                     : simpConstants(simpContext, cur[i], simpVar);
+        if (n.isNull())
+        {
+          return n;
+        }
+        builder << n;
+      }
+      // Mark the substitution and continue
+      Node result = builder;
+      result = theory::Rewriter::rewrite(result);
+      d_simpConstCache[pair<Node, Node>(simpContext, cur)] = result;
     }
-    // Mark the substitution and continue
-    Node result = builder;
-    result = theory::Rewriter::rewrite(result);
-    d_simpConstCache[pair<Node, Node>(simpContext, iteNode)] = result;
-    return result;
+    return d_simpConstCache[pair<Node, Node>(simpContext, iteNode)];
   }
 
   if (!containsTermITE(iteNode))
@@ -1395,11 +1516,10 @@ Node ITESimplifier::getSimpVar(TypeNode t)
 
 Node ITESimplifier::createSimpContext(TNode c, Node& iteNode, Node& simpVar)
 {
-  NodeMap::iterator it;
-  it = d_simpContextCache.find(c);
-  if (it != d_simpContextCache.end())
+  const Node* cached = d_simpContextCache.find(c);
+  if (cached != nullptr)
   {
-    return (*it).second;
+    return *cached;
   }
 
   if (!containsTermITE(c))
@@ -1449,18 +1569,25 @@ Node ITESimplifier::createSimpContext(TNode c, Node& iteNode, Node& simpVar)
 typedef std::unordered_set<Node, NodeHashFunction> NodeSet;
 void countReachable_(Node x, Kind k, NodeSet& visited, uint32_t& reached)
 {
-  if (visited.find(x) != visited.end())
-  {
-    return;
-  }
-  visited.insert(x);
-  if (x.getKind() == k)
-  {
-    ++reached;
-  }
-  for (unsigned i = 0, N = x.getNumChildren(); i < N; ++i)
+  std::vector<TNode> toVisit;
+  toVisit.push_back(x);
+  while (!toVisit.empty())
   {
-    countReachable_(x[i], k, visited, reached);
+    TNode cur = toVisit.back();
+    toVisit.pop_back();
+    if (visited.find(cur) != visited.end())
+    {
+      continue;
+    }
+    visited.insert(cur);
+    if (cur.getKind() == k)
+    {
+      ++reached;
+    }
+    for (unsigned i = 0, N = cur.getNumChildren(); i < N; ++i)
+    {
+      toVisit.push_back(cur[i]);
+    }
   }
 }
 
@@ -1545,7 +1672,7 @@ Node ITESimplifier::simpITE(TNode assertion)
   vector<preprocess_stack_element> toVisit;
   toVisit.push_back(assertion);
 
-  static int call = 0;
+  static thread_local int call = 0;
   ++call;
   int iteration = 0;
 
@@ -1569,8 +1696,7 @@ Node ITESimplifier::simpITE(TNode assertion)
       continue;
     }
 
-    NodeMap::iterator find = d_simpITECache.find(current);
-    if (find != d_simpITECache.end())
+    if (d_simpITECache.contains(current))
     {
       toVisit.pop_back();
       continue;
@@ -1587,7 +1713,7 @@ Node ITESimplifier::simpITE(TNode assertion)
       }
       for (unsigned i = 0; i < current.getNumChildren(); ++i)
       {
-        Assert(d_simpITECache.find(current[i]) != d_simpITECache.end());
+        Assert(d_simpITECache.contains(current[i]));
         Node child = current[i];
         Node childRes = d_simpITECache[current[i]];
         builder << childRes;
@@ -1624,8 +1750,7 @@ Node ITESimplifier::simpITE(TNode assertion)
              ++child_it)
         {
           TNode childNode = *child_it;
-          NodeMap::iterator childFind = d_simpITECache.find(childNode);
-          if (childFind == d_simpITECache.end())
+          if (!d_simpITECache.contains(childNode))
           {
             toVisit.push_back(childNode);
           }
@@ -24,9 +24,11 @@
 #define CVC4__ITE_UTILITIES_H
 
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "expr/node.h"
+#include "expr/node_map.h"
 #include "util/hash.h"
 #include "util/statistics_registry.h"
 
@@ -59,8 +61,7 @@ class ContainsTermITEVisitor
   size_t cache_size() const { return d_cache.size(); }
 
  private:
-  typedef std::unordered_map<Node, bool, NodeHashFunction> NodeBoolMap;
-  NodeBoolMap d_cache;
+  expr::NodeMap<bool> d_cache;
 };
 
 class ITEUtilities
@@ -106,21 +107,13 @@ class IncomingArcCounter
 
   inline uint32_t lookupIncoming(Node n) const
   {
-    NodeCountMap::const_iterator it = d_reachCount.find(n);
-    if (it == d_reachCount.end())
-    {
-      return 0;
-    }
-    else
-    {
-      return (*it).second;
-    }
+    const uint32_t* count = d_reachCount.find(n);
+    return count == nullptr ? 0 : *count;
   }
   void clear();
 
  private:
-  typedef std::unordered_map<Node, uint32_t, NodeHashFunction> NodeCountMap;
-  NodeCountMap d_reachCount;
+  expr::NodeMap<uint32_t> d_reachCount;
 
   bool d_skipVariables;
   bool d_skipConstants;
@@ -152,8 +145,7 @@ class TermITEHeightCounter
   size_t cache_size() const;
 
  private:
-  typedef std::unordered_map<Node, uint32_t, NodeHashFunction> NodeCountMap;
-  NodeCountMap d_termITEHeight;
+  expr::NodeMap<uint32_t> d_termITEHeight;
 }; /* class TermITEHeightCounter */
 
 /**
@@ -179,8 +171,7 @@ class ITECompressor
   std::vector<Node>* d_assertions;
   IncomingArcCounter d_incoming;
 
-  typedef std::unordered_map<Node, Node, NodeHashFunction> NodeMap;
-  NodeMap d_compressed;
+  expr::NodeMap<Node> d_compressed;
 
   void reset();
 
@@ -231,7 +222,7 @@ class ITESimplifier
   //     constant
   // or  termITE(cnd, ConstantIte, ConstantIte)
   typedef std::vector<Node> NodeVec;
-  typedef std::unordered_map<Node, NodeVec*, NodeHashFunction>
+  typedef std::unordered_map<Node, const NodeVec*, NodeHashFunction>
       ConstantLeavesMap;
   ConstantLeavesMap d_constantLeaves;
 
@@ -246,10 +237,17 @@ class ITESimplifier
 
   /** If its not a constant and containsTermITE(ite),
    * returns a sorted NodeVec of the leaves. */
-  NodeVec* computeConstantLeaves(TNode ite);
+  const NodeVec* computeConstantLeaves(TNode ite);
 
-  // Lists all of the vectors in d_constantLeaves for fast deletion.
-  std::vector<NodeVec*> d_allocatedConstantLeaves;
+  struct NodeVecHashFunction
+  {
+    size_t operator()(const NodeVec& v) const;
+  };
+  // The distinct vectors of d_constantLeaves. Each is stored once, so that the
+  // ites of a tree over the same constants share their leaves.
+  std::unordered_set<NodeVec, NodeVecHashFunction> d_constantLeafSets;
+  /** Returns the stored copy of the sorted vector of leaves. */
+  const NodeVec* mkConstantLeaves(NodeVec& leaves);
 
   /* transforms */
   Node transformAtom(TNode atom);
@@ -276,7 +274,7 @@ class ITESimplifier
   Node replaceOver(Node n, Node replaceWith, Node simpVar);
   Node replaceOverTermIte(Node term, Node simpAtom, Node simpVar);
 
-  std::unordered_map<Node, bool, NodeHashFunction> d_leavesConstCache;
+  expr::NodeMap<bool> d_leavesConstCache;
   bool leavesAreConst(TNode e, theory::TheoryId tid);
   bool leavesAreConst(TNode e);
 
@@ -285,11 +283,10 @@ class ITESimplifier
   std::unordered_map<TypeNode, Node, TypeNode::HashFunction> d_simpVars;
   Node getSimpVar(TypeNode t);
 
-  typedef std::unordered_map<Node, Node, NodeHashFunction> NodeMap;
-  NodeMap d_simpContextCache;
+  expr::NodeMap<Node> d_simpContextCache;
   Node createSimpContext(TNode c, Node& iteNode, Node& simpVar);
 
-  NodeMap d_simpITECache;
+  expr::NodeMap<Node> d_simpITECache;
   Node simpITEAtom(TNode atom);
 
  private:
@@ -41,11 +41,11 @@ void AstPrinter::toStream(
     DagificationVisitor dv(dag);
     NodeVisitor<DagificationVisitor> visitor;
     visitor.run(dv, n);
-    const theory::SubstitutionMap& lets = dv.getLets();
+    const DagificationVisitor::LetList& lets = dv.getLets();
     if(!lets.empty()) {
       out << "(LET ";
       bool first = true;
-      for(theory::SubstitutionMap::const_iterator i = lets.begin();
+      for(DagificationVisitor::LetList::const_iterator i = lets.begin();
           i != lets.end();
           ++i) {
         if(! first) {
@@ -16,12 +16,11 @@
 
 #include "printer/dagification_visitor.h"
 
-#include "context/context.h"
+#include <algorithm>
+#include <sstream>
+
 #include "expr/node_algorithm.h"
 #include "expr/node_manager_attributes.h"
-#include "theory/substitutions.h"
-
-#include <sstream>
 
 namespace CVC4 {
 namespace printer {
@@ -33,8 +32,9 @@ DagificationVisitor::DagificationVisitor(unsigned threshold,
       d_nodeCount(),
       d_reservedLetNames(),
       d_top(),
-      d_context(new context::Context()),
-      d_substitutions(new theory::SubstitutionMap(d_context)),
+      d_dagified(),
+      d_lets(),
+      d_body(),
       d_letVar(0),
       d_done(false),
       d_uniqueParent(),
@@ -44,10 +44,7 @@ DagificationVisitor::DagificationVisitor(unsigned threshold,
   AlwaysAssertArgument(threshold > 0, threshold);
 }
 
-DagificationVisitor::~DagificationVisitor() {
-  delete d_substitutions;
-  delete d_context;
-}
+DagificationVisitor::~DagificationVisitor() {}
 
 bool DagificationVisitor::alreadyVisited(TNode current, TNode parent) {
   Kind ck = current.getKind();
@@ -150,8 +147,11 @@ void DagificationVisitor::done(TNode node) {
   Node::dag::Scope scopeTrace(Trace.getStream(), false);
 #endif /* CVC4_TRACING */
 
-  // letify subexprs before parents (cascading LETs)
+  // letify subexprs before parents (cascading LETs); a subexpr is added to
+  // d_substNodes each time it is seen beyond the threshold
   std::sort(d_substNodes.begin(), d_substNodes.end());
+  d_substNodes.erase(std::unique(d_substNodes.begin(), d_substNodes.end()),
+                     d_substNodes.end());
 
   for(std::vector<TNode>::iterator i = d_substNodes.begin();
       i != d_substNodes.end();
@@ -173,35 +173,85 @@ void DagificationVisitor::done(TNode node) {
     } while (d_reservedLetNames.find(ss.str()) != d_reservedLetNames.end());
     Node letvar = NodeManager::currentNM()->mkSkolem(ss.str(), (*i).getType(), "dagification", NodeManager::SKOLEM_NO_NOTIFY | NodeManager::SKOLEM_EXACT_NAME);
 
-    // apply previous substitutions to the rhs, enabling cascading LETs
-    Node n = d_substitutions->apply(*i);
-    Assert(!d_substitutions->hasSubstitution(n));
-    d_substitutions->addSubstitution(n, letvar);
+    // apply previous let bindings to the rhs, enabling cascading LETs. Since
+    // subexprs are created before their parents, all the letified subexprs of
+    // this expr precede it in d_substNodes, hence each subexpr is dagified
+    // only once overall.
+    Node n = dagify(*i);
+    d_lets.push_back(std::make_pair(n, letvar));
+    d_dagified[*i] = letvar;
   }
+
+  d_body = dagify(d_top);
+}
+
+Node DagificationVisitor::dagify(TNode n)
+{
+  std::vector<TNode> visit;
+  visit.push_back(n);
+  do
+  {
+    TNode cur = visit.back();
+    std::unordered_map<TNode, Node, TNodeHashFunction>::iterator it =
+        d_dagified.find(cur);
+    if (it != d_dagified.end() && !it->second.isNull())
+    {
+      visit.pop_back();
+      continue;
+    }
+    bool isParam = cur.getMetaKind() == kind::metakind::PARAMETERIZED;
+    if (cur.getNumChildren() == 0 && !isParam)
+    {
+      d_dagified[cur] = cur;
+      visit.pop_back();
+    }
+    else if (it == d_dagified.end())
+    {
+      // mark as being visited, and visit the operator and children
+      d_dagified[cur] = Node::null();
+      if (isParam)
+      {
+        visit.push_back(cur.getOperator());
+      }
+      visit.insert(visit.end(), cur.begin(), cur.end());
+    }
+    else
+    {
+      NodeBuilder<> nb(cur.getKind());
+      bool childChanged = false;
+      if (isParam)
+      {
+        Node op = d_dagified[cur.getOperator()];
+        childChanged = op != cur.getOperator();
+        nb << op;
+      }
+      for (const TNode& cn : cur)
+      {
+        Node dcn = d_dagified[cn];
+        Assert(!dcn.isNull());
+        childChanged = childChanged || dcn != cn;
+        nb << dcn;
+      }
+      d_dagified[cur] = childChanged ? Node(nb) : Node(cur);
+      visit.pop_back();
+    }
+  } while (!visit.empty());
+  return d_dagified[n];
 }
 
-const theory::SubstitutionMap& DagificationVisitor::getLets() {
+const DagificationVisitor::LetList& DagificationVisitor::getLets()
+{
   AlwaysAssert(d_done)
       << "DagificationVisitor must be used as a visitor before "
          "getting the dagified version out!";
-  return *d_substitutions;
+  return d_lets;
 }
 
 Node DagificationVisitor::getDagifiedBody() {
   AlwaysAssert(d_done)
       << "DagificationVisitor must be used as a visitor before "
          "getting the dagified version out!";
-
-#ifdef CVC4_TRACING
-#  ifdef CVC4_DEBUG
-  // turn off dagification for Debug stream while we're doing this work
-  Node::dag::Scope scopeDebug(Debug.getStream(), false);
-#  endif /* CVC4_DEBUG */
-  // turn off dagification for Trace stream while we're doing this work
-  Node::dag::Scope scopeTrace(Trace.getStream(), false);
-#endif /* CVC4_TRACING */
-
-  return d_substitutions->apply(d_top);
+  return d_body;
 }
 
 }/* CVC4::printer namespace */
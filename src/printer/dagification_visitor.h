@@ -22,6 +22,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "expr/node.h"
@@ -29,14 +30,6 @@
 
 namespace CVC4 {
 
-namespace context {
-  class Context;
-}/* CVC4::context namespace */
-
-namespace theory {
-  class SubstitutionMap;
-}/* CVC4::theory namespace */
-
 namespace printer {
 
 /**
@@ -81,15 +74,22 @@ class DagificationVisitor {
   TNode d_top;
 
   /**
-   * This class doesn't operate in a context-dependent fashion, but
-   * SubstitutionMap does, so we need a context.
+   * A map of subexprs to their let-substituted version, i.e. the expr where
+   * all letified subexprs are replaced by their let variable (for letified
+   * exprs, this is the let variable itself).
+   */
+  std::unordered_map<TNode, Node, TNodeHashFunction> d_dagified;
+
+  /**
+   * The let bindings, in the order they are introduced. A binding is a pair
+   * of the let-substituted subexpr and its let variable.
    */
-  context::Context* d_context;
+  std::vector<std::pair<Node, Node> > d_lets;
 
   /**
-   * A map of subexprs to their newly-introduced let bindings.
+   * The let-substituted version of the top-most node.
    */
-  theory::SubstitutionMap* d_substitutions;
+  Node d_body;
 
   /**
    * The current count of let bindings.  Used to build unique names
@@ -126,11 +126,21 @@ class DagificationVisitor {
    */
   std::vector<TNode> d_substNodes;
 
+  /**
+   * Computes the let-substituted version of n (and of all its subexprs) with
+   * respect to the let bindings introduced so far, and stores it in
+   * d_dagified.
+   */
+  Node dagify(TNode n);
+
 public:
 
   /** Our visitor doesn't return anything. */
   typedef void return_type;
 
+  /** The type of the list of let bindings */
+  typedef std::vector<std::pair<Node, Node> > LetList;
+
   /**
    * Construct a dagification visitor with the given threshold and let
    * binding prefix.
@@ -168,9 +178,10 @@ public:
   void done(TNode node);
 
   /**
-   * Get the let substitutions.
+   * Get the let bindings. Each binding only refers to the let variables
+   * of the bindings that precede it.
    */
-  const theory::SubstitutionMap& getLets();
+  const LetList& getLets();
 
   /**
    * Return the let-substituted expression.
@@ -28,7 +28,7 @@ using namespace std;
 
 namespace CVC4 {
 
-unique_ptr<Printer> Printer::d_printers[language::output::LANG_MAX];
+thread_local unique_ptr<Printer> Printer::d_printers[language::output::LANG_MAX];
 
 unique_ptr<Printer> Printer::makePrinter(OutputLanguage lang)
 {
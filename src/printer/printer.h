@@ -107,7 +107,8 @@ class Printer
   static std::unique_ptr<Printer> makePrinter(OutputLanguage lang);
 
   /** Printers for each OutputLanguage */
-  static std::unique_ptr<Printer> d_printers[language::output::LANG_MAX];
+  static thread_local std::unique_ptr<Printer>
+      d_printers[language::output::LANG_MAX];
 
 }; /* class Printer */
 
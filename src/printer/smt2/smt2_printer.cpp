@@ -65,10 +65,10 @@ void Smt2Printer::toStream(
     DagificationVisitor dv(dag);
     NodeVisitor<DagificationVisitor> visitor;
     visitor.run(dv, n);
-    const theory::SubstitutionMap& lets = dv.getLets();
+    const DagificationVisitor::LetList& lets = dv.getLets();
     if(!lets.empty()) {
-      theory::SubstitutionMap::const_iterator i = lets.begin();
-      theory::SubstitutionMap::const_iterator i_end = lets.end();
+      DagificationVisitor::LetList::const_iterator i = lets.begin();
+      DagificationVisitor::LetList::const_iterator i_end = lets.end();
       for(; i != i_end; ++ i) {
         out << "(let ((";
         toStream(out, (*i).second, toDepth, types, TypeNode::null());
@@ -80,8 +80,8 @@ void Smt2Printer::toStream(
     Node body = dv.getDagifiedBody();
     toStream(out, body, toDepth, types, TypeNode::null());
     if(!lets.empty()) {
-      theory::SubstitutionMap::const_iterator i = lets.begin();
-      theory::SubstitutionMap::const_iterator i_end = lets.end();
+      DagificationVisitor::LetList::const_iterator i = lets.begin();
+      DagificationVisitor::LetList::const_iterator i_end = lets.end();
       for(; i != i_end; ++ i) {
         out << ")";
       }
@@ -945,10 +945,11 @@ void Smt2Printer::toStream(std::ostream& out,
       out << ' ';
     }
   }
-  stringstream parens;
-  
-  // calculate the child type casts
-  std::map< unsigned, TypeNode > force_child_type;
+  // the number of parentheses to close after the children
+  size_t parens = 0;
+
+  // calculate the child type casts, a null type means no cast
+  std::vector<TypeNode> force_child_type;
   if( parametricTypeChildren ){
     if( n.getNumChildren()>1 ){
       TypeNode force_ct = n[0].getType();
@@ -961,9 +962,7 @@ void Smt2Printer::toStream(std::ostream& out,
         }
       }
       if( do_force ){
-        for(size_t i = 0; i < n.getNumChildren(); ++i ) {
-          force_child_type[i] = force_ct;
-        }
+        force_child_type.resize(n.getNumChildren(), force_ct);
       }
     }
   // operators that may require type casting
@@ -971,16 +970,19 @@ void Smt2Printer::toStream(std::ostream& out,
     if(n.getKind()==kind::SELECT){
       TypeNode indexType = TypeNode::leastCommonTypeNode( n[0].getType().getArrayIndexType(), n[1].getType() );
       TypeNode elemType = n[0].getType().getArrayConstituentType();
+      force_child_type.resize(2);
       force_child_type[0] = NodeManager::currentNM()->mkArrayType( indexType, elemType );
       force_child_type[1] = indexType;
     }else if(n.getKind()==kind::STORE){
       TypeNode indexType = TypeNode::leastCommonTypeNode( n[0].getType().getArrayIndexType(), n[1].getType() );
       TypeNode elemType = TypeNode::leastCommonTypeNode( n[0].getType().getArrayConstituentType(), n[2].getType() );
+      force_child_type.resize(3);
       force_child_type[0] = NodeManager::currentNM()->mkArrayType( indexType, elemType );
       force_child_type[1] = indexType;
       force_child_type[2] = elemType;
     }else if(n.getKind()==kind::MEMBER){
       TypeNode elemType = TypeNode::leastCommonTypeNode( n[0].getType(), n[1].getType().getSetElementType() );
+      force_child_type.resize(2);
       force_child_type[0] = elemType;
       force_child_type[1] = NodeManager::currentNM()->mkSetType( elemType );
     }else{
@@ -1000,21 +1002,21 @@ void Smt2Printer::toStream(std::ostream& out,
         }
       }
       Assert(opt.getNumChildren() == n.getNumChildren() + 1);
+      force_child_type.reserve(n.getNumChildren());
       for(size_t i = 0; i < n.getNumChildren(); ++i ) {
-        force_child_type[i] = opt[i];
+        force_child_type.push_back(opt[i]);
       }
     }
   }
   
   for(size_t i = 0, c = 1; i < n.getNumChildren(); ) {
     if(toDepth != 0) {
-      Node cn = n[i];
-      std::map< unsigned, TypeNode >::iterator itfc = force_child_type.find( i );
-      if( itfc!=force_child_type.end() ){
-        toStream(out, cn, toDepth < 0 ? toDepth : toDepth - c, types, itfc->second);
-      }else{
-        toStream(out, cn, toDepth < 0 ? toDepth : toDepth - c, types, TypeNode::null());
-      }
+      toStream(out,
+               n[i],
+               toDepth < 0 ? toDepth : toDepth - c,
+               types,
+               i < force_child_type.size() ? force_child_type[i]
+                                           : TypeNode::null());
     } else {
       out << "(...)";
     }
@@ -1023,7 +1025,7 @@ void Smt2Printer::toStream(std::ostream& out,
         // not going to work properly for parameterized kinds!
         Assert(n.getMetaKind() != kind::metakind::PARAMETERIZED);
         out << " (" << smtKindString(n.getKind(), d_variant) << ' ';
-        parens << ')';
+        ++parens;
         ++c;
       } else {
         out << ' ';
@@ -1031,7 +1033,11 @@ void Smt2Printer::toStream(std::ostream& out,
     }
   }
   if(n.getNumChildren() != 0) {
-    out << parens.str() << ')';
+    for (; parens > 0; --parens)
+    {
+      out << ')';
+    }
+    out << ')';
   }
 }/* Smt2Printer::toStream(TNode) */
 
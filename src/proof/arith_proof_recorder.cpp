@@ -23,7 +23,8 @@
 namespace CVC4 {
 namespace proof {
 
-ArithProofRecorder::ArithProofRecorder() : d_lemmasToFarkasCoefficients()
+ArithProofRecorder::ArithProofRecorder()
+    : d_savedConflicts(), d_lemmasToFarkasCoefficients()
 {
   // Nothing else
 }
@@ -57,17 +58,27 @@ void ArithProofRecorder::saveFarkasCoefficients(
     }
   }
 
-  std::set<Node> lits;
-  std::copy(
-      conflict.begin(), conflict.end(), std::inserter(lits, lits.begin()));
+  d_savedConflicts.emplace_back(std::move(conflict), *farkasCoefficients);
+}
 
-  d_lemmasToFarkasCoefficients[lits] =
-      std::make_pair(std::move(conflict), *farkasCoefficients);
+void ArithProofRecorder::indexSavedConflicts() const
+{
+  for (std::pair<Node, theory::arith::RationalVector>& saved :
+       d_savedConflicts)
+  {
+    std::set<Node> lits;
+    std::copy(saved.first.begin(),
+              saved.first.end(),
+              std::inserter(lits, lits.begin()));
+    d_lemmasToFarkasCoefficients[lits] = std::move(saved);
+  }
+  d_savedConflicts.clear();
 }
 
 bool ArithProofRecorder::hasFarkasCoefficients(
     const std::set<Node>& conflict) const
 {
+  indexSavedConflicts();
   return d_lemmasToFarkasCoefficients.find(conflict)
          != d_lemmasToFarkasCoefficients.end();
 }
@@ -75,6 +86,7 @@ bool ArithProofRecorder::hasFarkasCoefficients(
 std::pair<Node, theory::arith::RationalVectorCP>
 ArithProofRecorder::getFarkasCoefficients(const std::set<Node>& conflict) const
 {
+  indexSavedConflicts();
   if (auto *p = FindOrNull(d_lemmasToFarkasCoefficients, conflict))
   {
     return std::make_pair(p->first, &p->second);
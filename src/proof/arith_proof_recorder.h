@@ -47,6 +47,7 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 #include "expr/node.h"
 #include "theory/arith/constraint_forward.h"
@@ -96,8 +97,20 @@ class ArithProofRecorder
       const std::set<Node>& conflict) const;
 
  protected:
+  /**
+   * Move the conflicts of d_savedConflicts to d_lemmasToFarkasCoefficients,
+   * indexing them by their literals.
+   */
+  void indexSavedConflicts() const;
+
+  // The conflicts and their Farkas coefficients that are not yet indexed, in
+  // the order they were saved. Saving a conflict during search only appends it
+  // here: the conflicts are indexed lazily, when a proof is requested.
+  mutable std::vector<std::pair<Node, theory::arith::RationalVector>>
+      d_savedConflicts;
   // For each lemma, save the Farkas coefficients of that lemma
-  std::map<std::set<Node>, std::pair<Node, theory::arith::RationalVector>>
+  mutable std::map<std::set<Node>,
+                   std::pair<Node, theory::arith::RationalVector>>
       d_lemmasToFarkasCoefficients;
 };
 
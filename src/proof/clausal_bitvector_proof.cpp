@@ -17,6 +17,7 @@
 #include "cvc4_private.h"
 
 #include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <iterator>
 #include <map>
@@ -47,10 +48,72 @@ ClausalBitVectorProof::ClausalBitVectorProof(theory::bv::TheoryBV* bv,
       d_clauses(),
       d_originalClauseIndices(),
       d_binaryDratProof(),
+      d_dratFileStream(),
       d_coreClauseIndices(),
       d_dratTranslationStatistics(),
       d_dratOptimizationStatistics()
 {
+  if (!options::bvSatProofFile().empty())
+  {
+    d_dratFileStream.reset(new std::ofstream(
+        options::bvSatProofFile(),
+        std::ios::out | std::ios::binary | std::ios::trunc));
+    if (!d_dratFileStream->good())
+    {
+      throw Exception("Cannot open file for the SAT proof: "
+                      + options::bvSatProofFile());
+    }
+  }
+}
+
+std::ostream& ClausalBitVectorProof::getDratOstream()
+{
+  if (d_dratFileStream)
+  {
+    return *d_dratFileStream;
+  }
+  return d_binaryDratProof;
+}
+
+void ClausalBitVectorProof::resetDratProof()
+{
+  if (d_dratFileStream)
+  {
+    d_dratFileStream->close();
+    d_dratFileStream->open(options::bvSatProofFile(),
+                           std::ios::out | std::ios::binary | std::ios::trunc);
+  }
+  else
+  {
+    d_binaryDratProof.str("");
+  }
+}
+
+std::string ClausalBitVectorProof::getBinaryDratProof()
+{
+  if (d_dratFileStream)
+  {
+    d_dratFileStream->flush();
+    std::ifstream in(options::bvSatProofFile(), std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in),
+                       std::istreambuf_iterator<char>());
+  }
+  return d_binaryDratProof.str();
+}
+
+bool ClausalBitVectorProof::getBinaryDratProofFile(std::string& filename)
+{
+  if (d_dratFileStream)
+  {
+    d_dratFileStream->flush();
+    filename = options::bvSatProofFile();
+    return false;
+  }
+  filename = "cvc4-drat-XXXXXX";
+  std::unique_ptr<std::fstream> dratStream = openTmpFile(&filename);
+  (*dratStream) << d_binaryDratProof.str();
+  dratStream->close();
+  return true;
 }
 
 void ClausalBitVectorProof::attachToSatSolver(prop::SatSolver& sat_solver)
@@ -97,7 +160,7 @@ void ClausalBitVectorProof::calculateAtomsInBitblastingProof()
   // Debug dump of DRAT Proof
   if (Debug.isOn("bv::clausal"))
   {
-    std::string serializedDratProof = d_binaryDratProof.str();
+    std::string serializedDratProof = getBinaryDratProof();
     Debug("bv::clausal") << "option: " << options::bvOptimizeSatProof()
                          << std::endl;
     Debug("bv::clausal") << "binary DRAT proof byte count: "
@@ -136,7 +199,7 @@ void ClausalBitVectorProof::optimizeDratProof()
   {
     Debug("bv::clausal") << "Optimizing DRAT" << std::endl;
     std::string formulaFilename("cvc4-dimacs-XXXXXX");
-    std::string dratFilename("cvc4-drat-XXXXXX");
+    std::string dratFilename;
     std::string optDratFilename("cvc4-optimized-drat-XXXXXX");
     std::string optFormulaFilename("cvc4-optimized-formula-XXXXXX");
 
@@ -149,13 +212,11 @@ void ClausalBitVectorProof::optimizeDratProof()
       formStream->close();
     }
 
+    bool isTmpDratFile = getBinaryDratProofFile(dratFilename);
     {
-      std::unique_ptr<std::fstream> dratStream = openTmpFile(&dratFilename);
-      const int64_t startPos = static_cast<int64_t>(dratStream->tellp());
-      (*dratStream) << d_binaryDratProof.str();
+      std::ifstream dratStream(dratFilename, std::ios::binary | std::ios::ate);
       d_dratOptimizationStatistics.d_initialDratSize.setData(
-          static_cast<int64_t>(dratStream->tellp()) - startPos);
-      dratStream->close();
+          static_cast<int64_t>(dratStream.tellg()));
     }
 
     std::unique_ptr<std::fstream> optDratStream = openTmpFile(&optDratFilename);
@@ -182,16 +243,17 @@ void ClausalBitVectorProof::optimizeDratProof()
 #endif
 
     {
-      d_binaryDratProof.str("");
-      Assert(d_binaryDratProof.str().size() == 0);
-
-      const int64_t startPos = static_cast<int64_t>(d_binaryDratProof.tellp());
+      // replace the proof by the optimized one, which is written to the file
+      // of --bv-sat-proof-file if the proof is streamed
+      resetDratProof();
+      std::ostream& out = getDratOstream();
+      const int64_t startPos = static_cast<int64_t>(out.tellp());
       std::ifstream lratStream(optDratFilename);
       std::copy(std::istreambuf_iterator<char>(lratStream),
                 std::istreambuf_iterator<char>(),
-                std::ostreambuf_iterator<char>(d_binaryDratProof));
+                std::ostreambuf_iterator<char>(out));
       d_dratOptimizationStatistics.d_optimizedDratSize.setData(
-          static_cast<int64_t>(d_binaryDratProof.tellp()) - startPos);
+          static_cast<int64_t>(out.tellp()) - startPos);
     }
 
     if (options::bvOptimizeSatProof() == options::BvOptimizeSatProof::FORMULA)
@@ -241,7 +303,10 @@ void ClausalBitVectorProof::optimizeDratProof()
 
     Assert(d_coreClauseIndices.size() > 0);
     remove(formulaFilename.c_str());
-    remove(dratFilename.c_str());
+    if (isTmpDratFile)
+    {
+      remove(dratFilename.c_str());
+    }
     remove(optDratFilename.c_str());
     remove(optFormulaFilename.c_str());
     Debug("bv::clausal") << "Optimized DRAT" << std::endl;
@@ -349,7 +414,7 @@ void LfscDratBitVectorProof::printEmptyClauseProof(std::ostream& os,
   os << "(@ dratProof ";
   paren << ")";
   d_dratTranslationStatistics.d_totalTime.start();
-  drat::DratProof pf = drat::DratProof::fromBinary(d_binaryDratProof.str());
+  drat::DratProof pf = drat::DratProof::fromBinary(getBinaryDratProof());
   d_dratTranslationStatistics.d_totalTime.stop();
   pf.outputAsLfsc(os, 2);
   os << "\n";
@@ -375,11 +440,17 @@ void LfscLratBitVectorProof::printEmptyClauseProof(std::ostream& os,
   os << "(@ lratProof ";
   paren << ")";
   d_dratTranslationStatistics.d_totalTime.start();
+  std::string dratFilename;
+  bool isTmpDratFile = getBinaryDratProofFile(dratFilename);
   lrat::LratProof pf =
       lrat::LratProof::fromDratProof(d_clauses,
                                      d_coreClauseIndices,
-                                     d_binaryDratProof.str(),
+                                     dratFilename,
                                      d_dratTranslationStatistics.d_toolTime);
+  if (isTmpDratFile)
+  {
+    remove(dratFilename.c_str());
+  }
   d_dratTranslationStatistics.d_totalTime.stop();
   pf.outputAsLfsc(os);
   os << "\n";
@@ -397,11 +468,17 @@ void LfscErBitVectorProof::printEmptyClauseProof(std::ostream& os,
          "bitblasting mode";
 
   d_dratTranslationStatistics.d_totalTime.start();
+  std::string dratFilename;
+  bool isTmpDratFile = getBinaryDratProofFile(dratFilename);
   er::ErProof pf =
       er::ErProof::fromBinaryDratProof(d_clauses,
                                        d_coreClauseIndices,
-                                       d_binaryDratProof.str(),
+                                       dratFilename,
                                        d_dratTranslationStatistics.d_toolTime);
+  if (isTmpDratFile)
+  {
+    remove(dratFilename.c_str());
+  }
   d_dratTranslationStatistics.d_totalTime.stop();
 
   pf.outputAsLfsc(os);
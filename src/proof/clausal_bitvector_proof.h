@@ -21,7 +21,9 @@
 #ifndef CVC4__PROOF__CLAUSAL_BITVECTOR_PROOF_H
 #define CVC4__PROOF__CLAUSAL_BITVECTOR_PROOF_H
 
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <unordered_map>
 
@@ -54,7 +56,12 @@ class ClausalBitVectorProof : public BitVectorProof
                     prop::SatVariable trueVar,
                     prop::SatVariable falseVar) override;
 
-  std::ostream& getDratOstream() { return d_binaryDratProof; }
+  /**
+   * Get the stream the SAT solver writes its binary DRAT proof to. This is the
+   * file of --bv-sat-proof-file if it is set, so that the proof is not kept
+   * in memory during solving.
+   */
+  std::ostream& getDratOstream();
 
   void registerUsedClause(ClauseId id, prop::SatClause& clause);
 
@@ -64,8 +71,11 @@ class ClausalBitVectorProof : public BitVectorProof
   // A list of all clauses and their ids which are passed into the SAT solver
   std::unordered_map<ClauseId, prop::SatClause> d_clauses{};
   std::vector<ClauseId> d_originalClauseIndices{};
-  // Stores the proof recieved from the SAT solver.
+  // Stores the proof recieved from the SAT solver, unless it is streamed to
+  // the file of --bv-sat-proof-file
   std::ostringstream d_binaryDratProof{};
+  // The stream to the file of --bv-sat-proof-file, if it is set
+  std::unique_ptr<std::ofstream> d_dratFileStream;
   std::vector<ClauseId> d_coreClauseIndices{};
 
   struct DratTranslationStatistics
@@ -82,7 +92,28 @@ class ClausalBitVectorProof : public BitVectorProof
 
   DratTranslationStatistics d_dratTranslationStatistics;
 
+  /**
+   * Get the binary DRAT proof received from the SAT solver, reading it back
+   * from the file of --bv-sat-proof-file if it is streamed.
+   */
+  std::string getBinaryDratProof();
+
+  /**
+   * Get the name of a file containing the binary DRAT proof received from the
+   * SAT solver. If the proof is streamed, this is the file of
+   * --bv-sat-proof-file. Otherwise, the proof is written to a new temporary
+   * file.
+   *
+   * @param filename set to the name of the file
+   * @return true if the file is temporary, and must be removed by the caller
+   */
+  bool getBinaryDratProofFile(std::string& filename);
+
  private:
+  // Discards the DRAT proof received from the SAT solver, so that the stream
+  // returned by `getDratOstream` can be used to store another one
+  void resetDratProof();
+
   // Optimizes the DRAT proof stored in `d_binaryDratProof` and returns a list
   // of clause actually needed to check that proof (a smaller UNSAT core)
   void optimizeDratProof();
@@ -118,14 +118,15 @@ class ErProof
    *
    * @param clauses A store of clauses that might be in our formula
    * @param usedIds the ids of clauses that are actually in our formula
-   * @param dratBinary  The DRAT proof from the SAT solver, as a binary stream
+   * @param dratFilename The name of a file containing the DRAT proof from the
+   *        SAT solver, in the binary format
    *
    * @return the Er proof and a timer of the execution of drat2er
    */
   static ErProof fromBinaryDratProof(
       const std::unordered_map<ClauseId, prop::SatClause>& clauses,
       const std::vector<ClauseId>& usedIds,
-      const std::string& dratBinary,
+      const std::string& dratFilename,
       TimerStat& toolTimer
       );
 
@@ -51,7 +51,7 @@ using proof::LfscResolutionBitVectorProof;
 using proof::ResolutionBitVectorProof;
 
 unsigned CVC4::ProofLetCount::counter = 0;
-static unsigned LET_COUNT = 1;
+static thread_local unsigned LET_COUNT = 1;
 
 TheoryProofEngine::TheoryProofEngine()
   : d_registrationCache()
@@ -16,8 +16,10 @@
 
 #include "prop/bvminisat/bvminisat.h"
 
+#include "options/bv_options.h"
 #include "prop/bvminisat/simp/SimpSolver.h"
 #include "proof/clause_id.h"
+#include "proof/proof_manager.h"
 #include "proof/sat_proof.h"
 #include "util/statistics_registry.h"
 
@@ -70,6 +72,23 @@ ClauseId BVMinisatSatSolver::addClause(SatClause& clause,
   return clause_id;
 }
 
+bool BVMinisatSatSolver::nativeXor()
+{
+  return options::bvNativeXor() && !THEORY_PROOF_ON();
+}
+
+ClauseId BVMinisatSatSolver::addXorClause(SatClause& clause,
+                                          bool rhs,
+                                          bool removable)
+{
+  Debug("sat::minisat") << "Add xor clause " << clause << " = " << rhs << "\n";
+  Assert(nativeXor());
+  BVMinisat::vec<BVMinisat::Lit> minisat_clause;
+  toMinisatClause(clause, minisat_clause);
+  d_minisat->addXorClause(minisat_clause, rhs);
+  return ClauseIdError;
+}
+
 SatValue BVMinisatSatSolver::propagate() {
   return toSatLiteralValue(d_minisat->propagateAssumptions());
 }
@@ -249,6 +268,11 @@ BVMinisatSatSolver::Statistics::Statistics(StatisticsRegistry* registry,
       d_statMaxLiterals(prefix + "::bvminisat::max_literals"),
       d_statTotLiterals(prefix + "::bvminisat::tot_literals"),
       d_statEliminatedVars(prefix + "::bvminisat::eliminated_vars"),
+      d_statXorPropagations(prefix + "::bvminisat::xor_propagations"),
+      d_statXorConflicts(prefix + "::bvminisat::xor_conflicts"),
+      d_statGaussEliminations(prefix + "::bvminisat::gauss_eliminations"),
+      d_statGaussUnits(prefix + "::bvminisat::gauss_units"),
+      d_statGaussEquivalences(prefix + "::bvminisat::gauss_equivalences"),
       d_statCallsToSolve(prefix + "::bvminisat::calls_to_solve", 0),
       d_statSolveTime(prefix + "::bvminisat::solve_time"),
       d_registerStats(!prefix.empty())
@@ -268,6 +292,11 @@ BVMinisatSatSolver::Statistics::Statistics(StatisticsRegistry* registry,
   d_registry->registerStat(&d_statMaxLiterals);
   d_registry->registerStat(&d_statTotLiterals);
   d_registry->registerStat(&d_statEliminatedVars);
+  d_registry->registerStat(&d_statXorPropagations);
+  d_registry->registerStat(&d_statXorConflicts);
+  d_registry->registerStat(&d_statGaussEliminations);
+  d_registry->registerStat(&d_statGaussUnits);
+  d_registry->registerStat(&d_statGaussEquivalences);
   d_registry->registerStat(&d_statCallsToSolve);
   d_registry->registerStat(&d_statSolveTime);
 }
@@ -286,6 +315,11 @@ BVMinisatSatSolver::Statistics::~Statistics() {
   d_registry->unregisterStat(&d_statMaxLiterals);
   d_registry->unregisterStat(&d_statTotLiterals);
   d_registry->unregisterStat(&d_statEliminatedVars);
+  d_registry->unregisterStat(&d_statXorPropagations);
+  d_registry->unregisterStat(&d_statXorConflicts);
+  d_registry->unregisterStat(&d_statGaussEliminations);
+  d_registry->unregisterStat(&d_statGaussUnits);
+  d_registry->unregisterStat(&d_statGaussEquivalences);
   d_registry->unregisterStat(&d_statCallsToSolve);
   d_registry->unregisterStat(&d_statSolveTime);
 }
@@ -305,6 +339,11 @@ void BVMinisatSatSolver::Statistics::init(BVMinisat::SimpSolver* minisat){
   d_statMaxLiterals.setData(minisat->max_literals);
   d_statTotLiterals.setData(minisat->tot_literals);
   d_statEliminatedVars.setData(minisat->eliminated_vars);
+  d_statXorPropagations.setData(minisat->xor_propagations);
+  d_statXorConflicts.setData(minisat->xor_conflicts);
+  d_statGaussEliminations.setData(minisat->gauss_eliminations);
+  d_statGaussUnits.setData(minisat->gauss_units);
+  d_statGaussEquivalences.setData(minisat->gauss_equivalences);
 }
 
 } /* namespace CVC4::prop */
@@ -72,10 +72,9 @@ public:
 
   ClauseId addClause(SatClause& clause, bool removable) override;
 
-  ClauseId addXorClause(SatClause& clause, bool rhs, bool removable) override
-  {
-    Unreachable() << "Minisat does not support native XOR reasoning";
-  }
+  bool nativeXor() override;
+
+  ClauseId addXorClause(SatClause& clause, bool rhs, bool removable) override;
 
   SatValue propagate() override;
 
@@ -134,6 +133,9 @@ public:
     ReferenceStat<uint64_t> d_statLearntsLiterals,  d_statMaxLiterals;
     ReferenceStat<uint64_t> d_statTotLiterals;
     ReferenceStat<int> d_statEliminatedVars;
+    ReferenceStat<uint64_t> d_statXorPropagations, d_statXorConflicts;
+    ReferenceStat<uint64_t> d_statGaussEliminations, d_statGaussUnits;
+    ReferenceStat<uint64_t> d_statGaussEquivalences;
     IntStat d_statCallsToSolve;
     TimerStat d_statSolveTime;
     bool d_registerStats;
@@ -22,6 +22,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <math.h>
 
+#include <algorithm>
 #include <vector>
 #include <iostream>
 
@@ -76,6 +77,7 @@ static BoolOption    opt_luby_restart      (_cat, "luby",        "Use the Luby r
 static IntOption     opt_restart_first     (_cat, "rfirst",      "The base restart interval", 25, IntRange(1, INT32_MAX));
 static DoubleOption  opt_restart_inc       (_cat, "rinc",        "Restart interval increase factor", 3, DoubleRange(1, false, HUGE_VAL, false));
 static DoubleOption  opt_garbage_frac      (_cat, "gc-frac",     "The fraction of wasted memory allowed before a garbage collection is triggered",  0.20, DoubleRange(0, false, HUGE_VAL, false));
+static IntOption     opt_compact_interval  (_cat, "compact-int", "Compact the clause arena every this many database reductions (0 = never)", 4, IntRange(0, INT32_MAX));
 
 //=================================================================================================
 // Proof declarations
@@ -104,6 +106,7 @@ Solver::Solver(CVC4::context::Context* c) :
   , rnd_pol          (false)
   , rnd_init_act     (opt_rnd_init_act)
   , garbage_frac     (opt_garbage_frac)
+  , compact_interval (opt_compact_interval)
   , restart_first    (opt_restart_first)
   , restart_inc      (opt_restart_inc)
 
@@ -120,6 +123,7 @@ Solver::Solver(CVC4::context::Context* c) :
     //
   , solves(0), starts(0), decisions(0), rnd_decisions(0), propagations(0), conflicts(0)
   , dec_vars(0), clauses_literals(0), learnts_literals(0), max_literals(0), tot_literals(0)
+  , xor_propagations(0), xor_conflicts(0), gauss_eliminations(0), gauss_units(0), gauss_equivalences(0)
 
   , need_to_propagate(false)
   , only_bcp(false)
@@ -136,6 +140,7 @@ Solver::Solver(CVC4::context::Context* c) :
   , remove_satisfied   (true)
 
   , ca                 ()
+  , gauss_needed       (false)
 
   // even though these are temporaries and technically should be set
   // before calling, lets initialize them. this will reduces chances of
@@ -143,6 +148,7 @@ Solver::Solver(CVC4::context::Context* c) :
   // being (incorrectly) used without initialization.
   , seen(),  analyze_stack(), analyze_toclear(), add_tmp()
   , max_learnts(0.0), learntsize_adjust_confl(0.0), learntsize_adjust_cnt(0)
+  , reductions(0)
 
     // Resource constraints:
     //
@@ -178,6 +184,7 @@ Var Solver::newVar(bool sign, bool dvar)
     int v = nVars();
     watches  .init(mkLit(v, false));
     watches  .init(mkLit(v, true ));
+    xor_watches.push();
     assigns  .push(l_Undef);
     vardata  .push(mkVarData(CRef_Undef, 0));
     marker   .push(0);
@@ -303,11 +310,64 @@ bool Solver::addClause_(vec<Lit>& ps, ClauseId& id)
     return ok;
 }
 
+bool Solver::addXorClause(const vec<Lit>& ps, bool rhs)
+{
+    Assert(d_bvp == NULL) << "XOR constraints are not supported with proofs";
+    if (decisionLevel() > 0) {
+      cancelUntil(0);
+    }
+
+    if (!ok) return false;
+
+    // Fold the signs and the assigned variables into the right-hand side, and remove the pairs of
+    // equal variables:
+    std::vector<Var> vars;
+    for (int i = 0; i < ps.size(); i++){
+        rhs ^= sign(ps[i]);
+        if (value(var(ps[i])) != l_Undef)
+            rhs ^= (value(var(ps[i])) == l_True);
+        else
+            vars.push_back(var(ps[i]));
+    }
+    std::sort(vars.begin(), vars.end());
+    int i, j;
+    for (i = j = 0; i < (int)vars.size(); i++){
+        if (i + 1 < (int)vars.size() && vars[i] == vars[i + 1])
+            i++;
+        else
+            vars[j++] = vars[i];
+    }
+    vars.resize(j);
+
+    clause_added = true;
+    ClauseId id;
+    if (vars.size() == 0){
+        if (rhs) return ok = false;
+        return true;
+    }else if (vars.size() == 1){
+        return addClause(mkLit(vars[0], !rhs), id);
+    }else if (vars.size() == 2){
+        Lit a = mkLit(vars[0]), b = mkLit(vars[1], !rhs);
+        return addClause(a, b, id) && addClause(~a, ~b, id);
+    }
+
+    XorClause x;
+    x.vars = vars;
+    x.rhs  = rhs;
+    xor_watches[vars[0]].push(xors.size());
+    xor_watches[vars[1]].push(xors.size());
+    xors.push_back(x);
+    gauss_needed = true;
+    return true;
+}
+
+
 void Solver::attachClause(CRef cr) {
     const Clause& c = ca[cr];
     assert(c.size() > 1);
-    watches[~c[0]].push(Watcher(cr, c[1]));
-    watches[~c[1]].push(Watcher(cr, c[0]));
+    bool binary = c.size() == 2;
+    watches[~c[0]].push(Watcher(cr, c[1], binary));
+    watches[~c[1]].push(Watcher(cr, c[0], binary));
     if (c.learnt()) learnts_literals += c.size();
     else            clauses_literals += c.size(); }
 
@@ -352,6 +412,11 @@ bool Solver::satisfied(const Clause& c) const {
 //
 void Solver::cancelUntil(int level) {
     if (decisionLevel() > level){
+      while (xor_reason_levels.size() > 0 && xor_reason_levels.last() > level){
+        ca.free(xor_reasons.last());
+        xor_reasons.pop();
+        xor_reason_levels.pop();
+      }
       Debug("bvminisat::explain") << OUTPUT_TAG << " backtracking to " << level << std::endl;
       for (int c = trail.size()-1; c >= trail_lim[level]; c--){
             Var      x  = var(trail[c]);
@@ -811,6 +876,26 @@ CRef Solver::propagate()
             if (value(blocker) == l_True){
                 *j++ = *i++; continue; }
 
+            // Binary clauses are handled from the watcher alone, the clause is only touched to
+            // put the implied literal first, as 'analyze()' expects of reasons:
+            if (i->binary){
+                CRef cr = i->cref;
+                *j++ = *i++;
+                if (value(blocker) == l_False){
+                    confl = cr;
+                    qhead = trail.size();
+                    // Copy the remaining watches:
+                    while (i < end)
+                        *j++ = *i++;
+                }else{
+                    Clause& c = ca[cr];
+                    if (c[0] != blocker)
+                        c[1] = c[0], c[0] = blocker;
+                    uncheckedEnqueue(blocker, cr);
+                }
+                continue;
+            }
+
             // Make sure the false literal is data[1]:
             CRef     cr        = i->cref;
             Clause&  c         = ca[cr];
@@ -847,6 +932,9 @@ CRef Solver::propagate()
         NextClause:;
         }
         ws.shrink(i - j);
+
+        if (confl == CRef_Undef && xor_watches[var(p)].size() > 0)
+            confl = propagateXors(var(p));
     }
     propagations += num_props;
     simpDB_props -= num_props;
@@ -855,6 +943,166 @@ CRef Solver::propagate()
 }
 
 
+CRef Solver::propagateXors(Var v)
+{
+    CRef  confl = CRef_Undef;
+    vec<int>& ws = xor_watches[v];
+    int i, j;
+    for (i = j = 0; i < ws.size(); i++){
+        XorClause& x = xors[ws[i]];
+        // Make sure 'v' is vars[1]:
+        if (x.vars[0] == v)
+            std::swap(x.vars[0], x.vars[1]);
+        assert(x.vars[1] == v);
+
+        // Look for new watch:
+        bool found = false;
+        for (size_t k = 2; k < x.vars.size(); k++)
+            if (value(x.vars[k]) == l_Undef){
+                std::swap(x.vars[1], x.vars[k]);
+                xor_watches[x.vars[1]].push(ws[i]);
+                found = true;
+                break; }
+        if (found) continue;
+
+        // Did not find watch -- all variables but vars[0] are assigned:
+        ws[j++] = ws[i];
+        bool parity = x.rhs;
+        for (size_t k = 1; k < x.vars.size(); k++)
+            parity ^= (value(x.vars[k]) == l_True);
+        Lit implied = mkLit(x.vars[0], !parity);
+        if (value(implied) == l_True)
+            continue;
+
+        if (value(implied) == l_Undef){
+            xor_propagations++;
+            uncheckedEnqueue(implied, xorClause(x, implied));
+        }else{
+            xor_conflicts++;
+            confl = xorClause(x, lit_Undef);
+            qhead = trail.size();
+            // Copy the remaining watches:
+            for (i++; i < ws.size(); i++)
+                ws[j++] = ws[i];
+            break;
+        }
+    }
+    ws.shrink(i - j);
+    return confl;
+}
+
+
+CRef Solver::xorClause(const XorClause& x, Lit p)
+{
+    vec<Lit> lits;
+    if (p != lit_Undef)
+        lits.push(p);
+    for (size_t k = 0; k < x.vars.size(); k++)
+        if (p == lit_Undef || x.vars[k] != var(p))
+            lits.push(mkLit(x.vars[k], value(x.vars[k]) == l_True));
+    CRef cr = ca.alloc(lits, false);
+    xor_reasons.push(cr);
+    xor_reason_levels.push(decisionLevel());
+    return cr;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  gaussJordan : ()  ->  [bool]
+|
+|  Description:
+|    Run Gauss-Jordan elimination on the XOR constraints restricted to the unassigned variables at
+|    the top level. The rows of the reduced matrix with one variable are asserted as units, the
+|    rows with two variables are added as equivalences. Returns FALSE if the XOR constraints are
+|    unsatisfiable.
+|________________________________________________________________________________________________@*/
+bool Solver::gaussJordan()
+{
+    assert(decisionLevel() == 0);
+    gauss_needed = false;
+
+    // Number the unassigned variables of the XOR constraints:
+    vec<int>           column(nVars(), -1);
+    std::vector<Var>   vars;
+    for (size_t i = 0; i < xors.size(); i++)
+        for (Var v : xors[i].vars)
+            if (value(v) == l_Undef && column[v] == -1){
+                column[v] = vars.size();
+                vars.push_back(v); }
+
+    size_t nrows = xors.size(), words = (vars.size() + 63) / 64;
+    // The elimination takes up to nrows * nrows * words operations
+    if (vars.size() == 0 || nrows * nrows * words > gauss_limit)
+        return true;
+    gauss_eliminations++;
+
+    std::vector<std::vector<uint64_t> > rows(nrows, std::vector<uint64_t>(words, 0));
+    std::vector<char>                   rhs(nrows);
+    for (size_t i = 0; i < nrows; i++){
+        bool r = xors[i].rhs;
+        for (Var v : xors[i].vars)
+            if (value(v) == l_Undef)
+                rows[i][column[v] / 64] ^= UINT64_C(1) << (column[v] % 64);
+            else
+                r ^= (value(v) == l_True);
+        rhs[i] = r;
+    }
+
+    // Reduce the matrix to reduced row echelon form:
+    size_t rank = 0;
+    for (size_t col = 0; col < vars.size() && rank < nrows; col++){
+        size_t   w   = col / 64;
+        uint64_t bit = UINT64_C(1) << (col % 64);
+        size_t   pivot = rank;
+        while (pivot < nrows && (rows[pivot][w] & bit) == 0)
+            pivot++;
+        if (pivot == nrows) continue;
+        std::swap(rows[pivot], rows[rank]);
+        std::swap(rhs[pivot], rhs[rank]);
+        for (size_t i = 0; i < nrows; i++)
+            if (i != rank && (rows[i][w] & bit) != 0){
+                for (size_t k = w; k < words; k++)
+                    rows[i][k] ^= rows[rank][k];
+                rhs[i] = rhs[i] != rhs[rank]; }
+        rank++;
+    }
+
+    // The rows below the rank are empty:
+    for (size_t i = rank; i < nrows; i++)
+        if (rhs[i]) return ok = false;
+
+    for (size_t i = 0; i < rank && ok; i++){
+        // Find the (first two) variables of the row:
+        Var first = var_Undef, second = var_Undef;
+        bool more = false;
+        for (size_t k = 0; k < words && !more; k++)
+            for (uint64_t b = rows[i][k]; b != 0 && !more; b &= b - 1){
+                Var v = vars[k * 64 + __builtin_ctzll(b)];
+                if      (first  == var_Undef) first  = v;
+                else if (second == var_Undef) second = v;
+                else                          more   = true; }
+        if (more) continue;
+
+        ClauseId id;
+        if (second == var_Undef){
+            gauss_units++;
+            Lit p = mkLit(first, !rhs[i]);
+            if (value(p) == l_Undef)
+                uncheckedEnqueue(p);
+            else if (value(p) == l_False)
+                return ok = false;
+        }else if (gauss_binaries.insert(std::make_pair(first, second)).second){
+            gauss_equivalences++;
+            Lit a = mkLit(first), b = mkLit(second, !rhs[i]);
+            if (!addClause(a, b, id) || !addClause(~a, ~b, id))
+                return false;
+        }
+    }
+    return ok = (propagate() == CRef_Undef);
+}
+
+
 /*_________________________________________________________________________________________________
 |
 |  reduceDB : ()  ->  [void]
@@ -885,7 +1133,10 @@ void Solver::reduceDB()
             learnts[j++] = learnts[i];
     }
     learnts.shrink(i - j);
-    checkGarbage();
+    if (compact_interval > 0 && ++reductions % compact_interval == 0)
+        garbageCollect();
+    else
+        checkGarbage();
 }
 
 
@@ -933,6 +1184,9 @@ bool Solver::simplify()
     if (!ok || propagate() != CRef_Undef)
         return ok = false;
 
+    if ((gauss_needed || nAssigns() != simpDB_assigns) && xors.size() > 0 && !gaussJordan())
+        return false;
+
     if (nAssigns() == simpDB_assigns || (simpDB_props > 0))
         return true;
 
@@ -1407,12 +1661,32 @@ void Solver::toDimacs(FILE* f, const vec<Lit>& assumps)
 //=================================================================================================
 // Garbage Collection methods:
 
+struct reloc_lt {
+    ClauseAllocator& ca;
+    reloc_lt(ClauseAllocator& ca_) : ca(ca_) {}
+    bool operator () (CRef x, CRef y) { return ca[x].activity() > ca[y].activity(); }
+};
 void Solver::relocAll(ClauseAllocator& to)
 {
+    // The clauses are laid out in the new region in the order they are relocated. Relocate the
+    // original clauses first, then the learnt clauses by decreasing activity, so that the clauses
+    // visited most often by 'propagate()' end up close to each other.
+    watches.cleanAll();
+
+    // All original:
+    //
+    for (int i = 0; i < clauses.size(); i++)
+      ca.reloc(clauses[i], to, d_bvp ? d_bvp->getSatProof() : NULL);
+
+    // All learnt:
+    //
+    sort(learnts, reloc_lt(ca));
+    for (int i = 0; i < learnts.size(); i++)
+      ca.reloc(learnts[i], to, d_bvp ? d_bvp->getSatProof() : NULL);
+
     // All watchers:
     //
     // for (int i = 0; i < watches.size(); i++)
-    watches.cleanAll();
     for (int v = 0; v < nVars(); v++)
         for (int s = 0; s < 2; s++){
             Lit p = mkLit(v, s);
@@ -1431,15 +1705,10 @@ void Solver::relocAll(ClauseAllocator& to)
           ca.reloc(vardata[v].reason, to, d_bvp ? d_bvp->getSatProof() : NULL);
     }
 
-    // All learnt:
-    //
-    for (int i = 0; i < learnts.size(); i++)
-      ca.reloc(learnts[i], to, d_bvp ? d_bvp->getSatProof() : NULL);
-
-    // All original:
+    // All reasons and conflicts derived from XOR constraints:
     //
-    for (int i = 0; i < clauses.size(); i++)
-      ca.reloc(clauses[i], to, d_bvp ? d_bvp->getSatProof() : NULL);
+    for (int i = 0; i < xor_reasons.size(); i++)
+      ca.reloc(xor_reasons[i], to, NULL);
 
     if(d_bvp){ d_bvp->getSatProof()->finishUpdateCRef(); }
 }
@@ -21,6 +21,8 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #ifndef BVMinisat_Solver_h
 #define BVMinisat_Solver_h
 
+#include <set>
+#include <utility>
 #include <vector>
 
 #include "context/context.h"
@@ -117,6 +119,7 @@ public:
     bool    addClause (Lit p, Lit q, Lit r, ClauseId& id);                    // Add a ternary clause to the solver. 
     bool    addClause_(      vec<Lit>& ps, ClauseId& id);                     // Add a clause to the solver without making superflous internal copy. Will
                                                                 // change the passed vector 'ps'.
+    bool    addXorClause (const vec<Lit>& ps, bool rhs);                      // Add the constraint 'rhs = ps[0] xor ... xor ps[n-1]' to the solver.
 
     // Solving:
     //
@@ -192,6 +195,7 @@ public:
     bool      rnd_pol;            // Use random polarities for branching heuristics.
     bool      rnd_init_act;       // Initialize variable activities with a small random value.
     double    garbage_frac;       // The fraction of wasted memory allowed before a garbage collection is triggered.
+    int       compact_interval;   // Compact the clause arena every this many database reductions (0 means never).
 
     int       restart_first;      // The initial restart limit.                                                                (default 100)
     double    restart_inc;        // The factor with which the restart limit is multiplied in each restart.                    (default 1.5)
@@ -205,6 +209,7 @@ public:
     //
     uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts;
     uint64_t dec_vars, clauses_literals, learnts_literals, max_literals, tot_literals;
+    uint64_t xor_propagations, xor_conflicts, gauss_eliminations, gauss_units, gauss_equivalences;
 
     // Bitvector Propagations
     //
@@ -228,10 +233,13 @@ public:
     struct VarData { CRef reason; int level; };
     static inline VarData mkVarData(CRef cr, int l){ VarData d = {cr, l}; return d; }
 
+    // Binary clauses are flagged in their watchers, whose blocker is then the other literal of the
+    // clause, so that propagating them never touches the clause arena:
     struct Watcher {
         CRef cref;
         Lit  blocker;
-        Watcher(CRef cr, Lit p) : cref(cr), blocker(p) {}
+        bool binary;
+        Watcher(CRef cr, Lit p, bool bin = false) : cref(cr), blocker(p), binary(bin) {}
         bool operator==(const Watcher& w) const { return cref == w.cref; }
         bool operator!=(const Watcher& w) const { return cref != w.cref; }
     };
@@ -276,6 +284,21 @@ public:
 
     ClauseAllocator     ca;
 
+    // XOR constraints:
+    //
+    struct XorClause {
+        std::vector<Var> vars;            // The first two variables are watched.
+        bool             rhs;
+    };
+    std::vector<XorClause> xors;          // List of XOR constraints (of at least three variables).
+    vec<vec<int> >      xor_watches;      // 'xor_watches[v]' is a list of (the indices of) the XOR constraints watching 'v'.
+    vec<CRef>           xor_reasons;      // Reason and conflict clauses derived from XOR constraints, freed on backtracking.
+    vec<int>            xor_reason_levels;// The decision level at which each of 'xor_reasons' was derived.
+    bool                gauss_needed;     // Whether XOR constraints or top-level assignments were added since the last 'gaussJordan()'.
+    std::set<std::pair<Var, Var> >
+                        gauss_binaries;   // The equivalences derived by 'gaussJordan()' so far.
+    static const uint64_t gauss_limit = 100000000; // Bound on the work of one 'gaussJordan()'.
+
     // Temporaries (to reduce allocation overhead). Each variable is prefixed by the method in which it is
     // used, exept 'seen' wich is used in several places.
     //
@@ -287,6 +310,7 @@ public:
     double              max_learnts;
     double              learntsize_adjust_confl;
     int                 learntsize_adjust_cnt;
+    int                 reductions;         // Number of calls to 'reduceDB()', paces the compaction of the clause arena.
 
     // Resource contraints:
     //
@@ -305,6 +329,9 @@ public:
     void     uncheckedEnqueue (Lit p, CRef from = CRef_Undef);                         // Enqueue a literal. Assumes value of literal is undefined.
     bool     enqueue          (Lit p, CRef from = CRef_Undef);                         // Test if fact 'p' contradicts current state, enqueue otherwise.
     CRef     propagate        ();                                                      // Perform unit propagation. Returns possibly conflicting clause.
+    CRef     propagateXors    (Var v);                                                 // Propagate the XOR constraints watching 'v'. Returns possibly conflicting clause.
+    CRef     xorClause        (const XorClause& x, Lit p);                             // Build the reason clause of 'p' (or the conflict clause if 'p' is 'lit_Undef').
+    bool     gaussJordan      ();                                                      // Derive top-level units and equivalences from the XOR constraints.
     void     cancelUntil      (int level);                                             // Backtrack until a certain level.
 
     enum UIP {
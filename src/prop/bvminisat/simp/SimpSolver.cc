@@ -204,6 +204,17 @@ bool SimpSolver::addClause_(vec<Lit>& ps, ClauseId& id)
 }
 
 
+bool SimpSolver::addXorClause(const vec<Lit>& ps, bool rhs)
+{
+    // Variable elimination only takes clauses into account:
+    for (int i = 0; i < ps.size(); i++){
+        assert(!isEliminated(var(ps[i])));
+        setFrozen(var(ps[i]), true);
+    }
+    return Solver::addXorClause(ps, rhs);
+}
+
+
 void SimpSolver::removeClause(CRef cr)
 {
     const Clause& c = ca[cr];
@@ -49,6 +49,7 @@ class SimpSolver : public Solver {
     bool    addClause (Lit p, Lit q, ClauseId& id);        // Add a binary clause to the solver.
     bool    addClause (Lit p, Lit q, Lit r, ClauseId& id); // Add a ternary clause to the solver.
     bool    addClause_( vec<Lit>& ps, ClauseId& id);
+    bool    addXorClause(const vec<Lit>& ps, bool rhs); // Add an XOR constraint, its variables are frozen.
     bool    substitute(Var v, Lit x);  // Replace all occurences of v with x (may cause a contradiction).
 
     // Variable mode:
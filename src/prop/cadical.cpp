@@ -11,15 +11,24 @@
  **
  ** \brief Wrapper for CaDiCaL SAT Solver.
  **
- ** Implementation of the CaDiCaL SAT solver for CVC4 (bitvectors).
+ ** Implementation of the CaDiCaL SAT solver for CVC4 (bitvectors), and of
+ ** the DPLL(T) interface on top of CaDiCaL's external propagator interface.
  **/
 
 #include "prop/cadical.h"
 
 #ifdef CVC4_USE_CADICAL
 
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+
 #include "base/check.h"
+#include "base/output.h"
+#include "options/smt_options.h"
 #include "proof/sat_proof.h"
+#include "prop/theory_proxy.h"
 
 namespace CVC4 {
 namespace prop {
@@ -54,6 +63,11 @@ CadicalLit toCadicalLit(const SatLiteral lit)
 
 CadicalVar toCadicalVar(SatVariable var) { return var; }
 
+SatLiteral toSatLiteral(CadicalLit lit)
+{
+  return SatLiteral(std::abs(lit), lit < 0);
+}
+
 }  // namespace helper functions
 
 CadicalSolver::CadicalSolver(StatisticsRegistry* registry,
@@ -175,6 +189,644 @@ CadicalSolver::Statistics::~Statistics() {
   d_registry->unregisterStat(&d_solveTime);
 }
 
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Connects CaDiCaL to the theories for CadicalDPLLSatSolver. It keeps track
+ * of the values of the observed variables (the theory atoms) and of the
+ * decision levels of CaDiCaL, which are mirrored by the SAT context.
+ */
+class CadicalPropagator : public CaDiCaL::ExternalPropagator
+{
+ public:
+  CadicalPropagator(CadicalDPLLSatSolver& solver,
+                    context::Context* context,
+                    TheoryProxy* proxy)
+      : d_solver(solver),
+        d_context(context),
+        d_proxy(proxy),
+        d_checked(false),
+        d_propagated(0),
+        d_reasonPos(0),
+        d_clausePos(0)
+  {
+  }
+
+  /**
+   * Register the new variable var. Theory atoms are observed, variables that
+   * are preregistered (with the theories) at a decision level > 0 are
+   * preregistered again when backtracking below that level.
+   */
+  void addVar(SatVariable var, bool isTheoryAtom, bool preRegister)
+  {
+    if (var >= d_vars.size())
+    {
+      d_vars.resize(var + 1);
+    }
+    VarInfo& info = d_vars[var];
+    info.d_theoryAtom = isTheoryAtom;
+    info.d_userLevel = d_solver.d_activations.size();
+    if (isTheoryAtom)
+    {
+      d_solver.d_solver->add_observed_var(toCadicalVar(var));
+    }
+    if (preRegister)
+    {
+      d_register.emplace_back(var, d_levels.size());
+    }
+  }
+
+  /** Add clause as an external clause at the next opportunity. */
+  void addClause(const std::vector<CadicalLit>& clause)
+  {
+    d_clauses.push_back(clause);
+  }
+
+  /** The value of var in the current (partial) assignment, if known. */
+  SatValue value(SatVariable var) const
+  {
+    if (var < d_vars.size() && d_vars[var].d_value != SAT_VALUE_UNKNOWN)
+    {
+      return d_vars[var].d_value;
+    }
+    if (var < d_model.size())
+    {
+      return d_model[var];
+    }
+    return SAT_VALUE_UNKNOWN;
+  }
+
+  void notify_assignment(int lit, bool is_fixed) override
+  {
+    VarInfo& info = d_vars[std::abs(lit)];
+    SatValue value = lit > 0 ? SAT_VALUE_TRUE : SAT_VALUE_FALSE;
+    if (info.d_value == value)
+    {
+      // Already assigned at a higher level, it now becomes fixed
+      info.d_fixed = info.d_fixed || is_fixed;
+      return;
+    }
+    info.d_value = value;
+    info.d_fixed = is_fixed;
+    d_trail.push_back(lit);
+    d_checked = false;
+    if (info.d_theoryAtom)
+    {
+      d_proxy->enqueueTheoryLiteral(toSatLiteral(lit));
+    }
+  }
+
+  void notify_new_decision_level() override
+  {
+    d_levels.push_back(d_trail.size());
+    d_context->push();
+  }
+
+  void notify_backtrack(size_t level) override { backtrack(level); }
+
+  /**
+   * Backtrack to decision level, which does not unassign the fixed
+   * literals: they are asserted again at the new level.
+   */
+  void backtrack(size_t level)
+  {
+    if (d_levels.size() <= level)
+    {
+      return;
+    }
+    std::vector<CadicalLit> fixed;
+    for (size_t i = d_levels[level], size = d_trail.size(); i < size; ++i)
+    {
+      VarInfo& info = d_vars[std::abs(d_trail[i])];
+      if (info.d_fixed)
+      {
+        fixed.push_back(d_trail[i]);
+      }
+      else
+      {
+        info.d_value = SAT_VALUE_UNKNOWN;
+      }
+    }
+    d_trail.resize(d_levels[level]);
+    for (size_t i = level, size = d_levels.size(); i < size; ++i)
+    {
+      d_context->pop();
+    }
+    d_levels.resize(level);
+    d_propagations.clear();
+    d_propagated = 0;
+    d_checked = false;
+
+    // Register variables that have not been registered yet
+    for (auto it = d_register.rbegin();
+         it != d_register.rend() && it->second > level;
+         ++it)
+    {
+      it->second = level;
+      d_proxy->variableNotify(it->first);
+    }
+
+    for (CadicalLit lit : fixed)
+    {
+      d_trail.push_back(lit);
+      if (d_vars[std::abs(lit)].d_theoryAtom)
+      {
+        d_proxy->enqueueTheoryLiteral(toSatLiteral(lit));
+      }
+    }
+  }
+
+  bool cb_check_found_model(const std::vector<int>& model) override
+  {
+    if (!d_clauses.empty())
+    {
+      return false;
+    }
+    d_model.assign(d_vars.size(), SAT_VALUE_UNKNOWN);
+    for (int lit : model)
+    {
+      if (static_cast<size_t>(std::abs(lit)) < d_model.size())
+      {
+        d_model[std::abs(lit)] = lit > 0 ? SAT_VALUE_TRUE : SAT_VALUE_FALSE;
+      }
+    }
+    size_t numVars = d_vars.size();
+    do
+    {
+      d_proxy->theoryCheck(theory::Theory::EFFORT_FULL);
+    } while (d_clauses.empty() && d_vars.size() == numVars
+             && d_proxy->theoryNeedCheck());
+    d_model.clear();
+    // If the theories introduced new variables, the assignment is no longer
+    // complete and CaDiCaL continues the search.
+    return d_clauses.empty() && d_vars.size() == numVars;
+  }
+
+  int cb_decide() override
+  {
+    d_proxy->spendResource(ResourceManager::Resource::DecisionStep,
+                           options::decisionStep());
+    SatLiteral lit = d_proxy->getNextTheoryDecisionRequest();
+    while (lit != undefSatLiteral)
+    {
+      if (value(lit.getSatVariable()) == SAT_VALUE_UNKNOWN)
+      {
+        return toCadicalLit(lit);
+      }
+      lit = d_proxy->getNextTheoryDecisionRequest();
+    }
+    return 0;
+  }
+
+  int cb_propagate() override
+  {
+    if (d_propagated == d_propagations.size())
+    {
+      d_propagations.clear();
+      d_propagated = 0;
+      if (d_checked)
+      {
+        return 0;
+      }
+      d_checked = true;
+      d_proxy->theoryCheck(theory::Theory::EFFORT_STANDARD);
+      d_proxy->theoryPropagate(d_propagations);
+    }
+    while (d_propagated < d_propagations.size())
+    {
+      SatLiteral lit = d_propagations[d_propagated++];
+      SatValue v = value(lit.getSatVariable());
+      if (lit.isNegated())
+      {
+        v = invertValue(v);
+      }
+      if (v != SAT_VALUE_TRUE)
+      {
+        ++d_solver.d_statistics.d_numTheoryPropagations;
+        return toCadicalLit(lit);
+      }
+    }
+    return 0;
+  }
+
+  int cb_add_reason_clause_lit(int propagated_lit) override
+  {
+    if (d_reasonPos == 0)
+    {
+      SatClause explanation;
+      d_proxy->explainPropagation(toSatLiteral(propagated_lit), explanation);
+      d_reason.clear();
+      for (const SatLiteral& lit : explanation)
+      {
+        d_reason.push_back(toCadicalLit(lit));
+      }
+    }
+    if (d_reasonPos < d_reason.size())
+    {
+      return d_reason[d_reasonPos++];
+    }
+    d_reasonPos = 0;
+    return 0;
+  }
+
+  bool cb_has_external_clause() override { return !d_clauses.empty(); }
+
+  int cb_add_external_clause_lit() override
+  {
+    Assert(!d_clauses.empty());
+    const std::vector<CadicalLit>& clause = d_clauses.front();
+    if (d_clausePos < clause.size())
+    {
+      return clause[d_clausePos++];
+    }
+    d_clauses.pop_front();
+    d_clausePos = 0;
+    return 0;
+  }
+
+  /** Called after a user push, at decision level 0. */
+  void userPush()
+  {
+    Assert(d_levels.empty());
+    d_userTrail.push_back(d_trail.size());
+  }
+
+  /**
+   * Called after a user pop, at decision level 0 and after the SAT context
+   * was popped. Forgets the variables introduced at the popped level, and
+   * asserts the fixed literals that were asserted at that level again.
+   */
+  void userPop()
+  {
+    Assert(d_levels.empty());
+    size_t userLevel = d_solver.d_activations.size();
+    for (SatVariable var = 0, size = d_vars.size(); var < size; ++var)
+    {
+      VarInfo& info = d_vars[var];
+      if (info.d_userLevel > userLevel)
+      {
+        if (info.d_theoryAtom)
+        {
+          d_solver.d_solver->remove_observed_var(toCadicalVar(var));
+        }
+        info = VarInfo();
+        info.d_dead = true;
+      }
+    }
+    size_t start = d_userTrail.back();
+    d_userTrail.pop_back();
+    size_t j = start;
+    for (size_t i = start, size = d_trail.size(); i < size; ++i)
+    {
+      const VarInfo& info = d_vars[std::abs(d_trail[i])];
+      if (info.d_dead)
+      {
+        continue;
+      }
+      d_trail[j++] = d_trail[i];
+      if (info.d_theoryAtom)
+      {
+        d_proxy->enqueueTheoryLiteral(toSatLiteral(d_trail[i]));
+      }
+    }
+    d_trail.resize(j);
+    d_register.clear();
+  }
+
+ private:
+  struct VarInfo
+  {
+    VarInfo()
+        : d_value(SAT_VALUE_UNKNOWN),
+          d_theoryAtom(false),
+          d_fixed(false),
+          d_dead(false),
+          d_userLevel(0)
+    {
+    }
+    SatValue d_value;
+    bool d_theoryAtom;
+    /** Whether the value is fixed (assigned at decision level 0). */
+    bool d_fixed;
+    /** Whether the variable was introduced at a popped user level. */
+    bool d_dead;
+    /** The user level at which the variable was introduced. */
+    size_t d_userLevel;
+  };
+
+  CadicalDPLLSatSolver& d_solver;
+  context::Context* d_context;
+  TheoryProxy* d_proxy;
+
+  std::vector<VarInfo> d_vars;
+  /** The assigned observed literals, in the order of assignment. */
+  std::vector<CadicalLit> d_trail;
+  /** The size of d_trail at the start of each decision level. */
+  std::vector<size_t> d_levels;
+  /** The size of d_trail at the start of each user level. */
+  std::vector<size_t> d_userTrail;
+  /** The preregistered variables, with the level they were registered at. */
+  std::vector<std::pair<SatVariable, size_t>> d_register;
+  /** The assignment passed to cb_check_found_model(), during the check. */
+  std::vector<SatValue> d_model;
+
+  /** Whether the theories were checked since the last assignment. */
+  bool d_checked;
+  /** The theory propagations, the first d_propagated have been returned. */
+  SatClause d_propagations;
+  size_t d_propagated;
+  /** The reason clause being returned by cb_add_reason_clause_lit(). */
+  std::vector<CadicalLit> d_reason;
+  size_t d_reasonPos;
+  /** The clauses to be added, the first d_clausePos literals of the first
+   * one have been returned. */
+  std::deque<std::vector<CadicalLit>> d_clauses;
+  size_t d_clausePos;
+}; /* class CadicalPropagator */
+
+CadicalDPLLSatSolver::CadicalDPLLSatSolver(StatisticsRegistry* registry)
+    : d_solver(new CaDiCaL::Solver()),
+      d_context(nullptr),
+      // Note: CaDiCaL variables start with index 1 rather than 0 since negated
+      //       literals are represented as the negation of the index.
+      d_nextVarIdx(1),
+      d_okay(true),
+      d_inSearch(false),
+      d_sat(false),
+      d_numModelVars(0),
+      d_statistics(registry)
+{
+  d_solver->set("quiet", 1);  // CaDiCaL is verbose by default
+  // The propagator relies on literals being unassigned in the reverse order
+  // of their assignment.
+  d_solver->set("chrono", 0);
+
+  d_true = newVar(false, false, false);
+  d_false = newVar(false, false, false);
+  d_solver->add(toCadicalVar(d_true));
+  d_solver->add(0);
+  d_solver->add(-toCadicalVar(d_false));
+  d_solver->add(0);
+}
+
+CadicalDPLLSatSolver::~CadicalDPLLSatSolver()
+{
+  if (d_propagator)
+  {
+    d_solver->disconnect_external_propagator();
+  }
+}
+
+void CadicalDPLLSatSolver::initialize(context::Context* context,
+                                      TheoryProxy* theoryProxy)
+{
+  d_context = context;
+  d_propagator.reset(new CadicalPropagator(*this, context, theoryProxy));
+  d_solver->connect_external_propagator(d_propagator.get());
+  for (SatVariable var = 1; var < d_nextVarIdx; ++var)
+  {
+    d_propagator->addVar(var, false, false);
+  }
+}
+
+ClauseId CadicalDPLLSatSolver::addClause(SatClause& clause, bool removable)
+{
+  std::vector<CadicalLit> lits;
+  for (const SatLiteral& lit : clause)
+  {
+    lits.push_back(toCadicalLit(lit));
+  }
+  if (!d_activations.empty())
+  {
+    lits.push_back(-d_activations.back());
+  }
+  ++d_statistics.d_numClauses;
+  if (d_propagator && d_inSearch)
+  {
+    ++d_statistics.d_numTheoryLemmas;
+    d_propagator->addClause(lits);
+  }
+  else
+  {
+    for (CadicalLit lit : lits)
+    {
+      d_solver->add(lit);
+    }
+    d_solver->add(0);
+  }
+  return ClauseIdError;
+}
+
+ClauseId CadicalDPLLSatSolver::addXorClause(SatClause& clause,
+                                            bool rhs,
+                                            bool removable)
+{
+  // CaDiCaL has no native XOR constraints, the XOR is encoded as a chain of
+  // fresh variables t_i <=> t_{i-1} xor l_i, whose last variable is asserted
+  if (clause.empty())
+  {
+    if (rhs)
+    {
+      SatClause empty;
+      addClause(empty, removable);
+    }
+    return ClauseIdError;
+  }
+  SatLiteral acc = clause[0];
+  for (size_t i = 1, size = clause.size(); i < size; i++)
+  {
+    SatLiteral l = clause[i];
+    SatLiteral t(newVar(false, false, true));
+    SatClause c1{~t, acc, l};
+    SatClause c2{~t, ~acc, ~l};
+    SatClause c3{t, ~acc, l};
+    SatClause c4{t, acc, ~l};
+    addClause(c1, removable);
+    addClause(c2, removable);
+    addClause(c3, removable);
+    addClause(c4, removable);
+    acc = t;
+  }
+  SatClause unit{rhs ? acc : ~acc};
+  addClause(unit, removable);
+  return ClauseIdError;
+}
+
+SatVariable CadicalDPLLSatSolver::newVar(bool isTheoryAtom,
+                                        bool preRegister,
+                                        bool canErase)
+{
+  ++d_statistics.d_numVariables;
+  SatVariable var = d_nextVarIdx++;
+  if (d_propagator)
+  {
+    d_propagator->addVar(var, isTheoryAtom, preRegister);
+  }
+  return var;
+}
+
+SatValue CadicalDPLLSatSolver::solve()
+{
+  return solve(std::vector<SatLiteral>());
+}
+
+SatValue CadicalDPLLSatSolver::solve(
+    const std::vector<SatLiteral>& assumptions)
+{
+  TimerStat::CodeTimer codeTimer(d_statistics.d_solveTime);
+  d_sat = false;
+  d_unsatAssumptions.clear();
+  for (CadicalLit act : d_activations)
+  {
+    d_solver->assume(act);
+  }
+  for (const SatLiteral& lit : assumptions)
+  {
+    d_solver->assume(toCadicalLit(lit));
+  }
+  d_inSearch = true;
+  SatValue res = toSatValue(d_solver->solve());
+  d_inSearch = false;
+  if (res == SAT_VALUE_FALSE)
+  {
+    // failed() is only available until the clauses are modified, e.g. on pop
+    for (const SatLiteral& lit : assumptions)
+    {
+      if (d_solver->failed(toCadicalLit(lit)))
+      {
+        d_unsatAssumptions.push_back(lit);
+      }
+    }
+  }
+  d_sat = (res == SAT_VALUE_TRUE);
+  d_okay = (res != SAT_VALUE_FALSE);
+  d_numModelVars = d_nextVarIdx;
+  ++d_statistics.d_numSatCalls;
+  return res;
+}
+
+SatValue CadicalDPLLSatSolver::solve(long unsigned int& resource)
+{
+  Trace("limit") << "CadicalDPLLSatSolver::solve(): have limit of " << resource
+                 << " conflicts" << std::endl;
+  if (resource > 0)
+  {
+    // the limit only applies to the next call to solve()
+    d_solver->limit("conflicts",
+                    static_cast<int>(std::min<long unsigned int>(
+                        resource, std::numeric_limits<int>::max())));
+  }
+  SatValue res = solve();
+  // CaDiCaL does not report the conflicts of a call, the budget is consumed
+  // if it was exhausted, and is an upper bound otherwise
+  Trace("limit") << "CadicalDPLLSatSolver::solve(): result " << res
+                 << std::endl;
+  return res;
+}
+
+void CadicalDPLLSatSolver::getUnsatAssumptions(
+    std::vector<SatLiteral>& unsatAssumptions)
+{
+  unsatAssumptions.insert(unsatAssumptions.end(),
+                          d_unsatAssumptions.begin(),
+                          d_unsatAssumptions.end());
+}
+
+void CadicalDPLLSatSolver::interrupt() { d_solver->terminate(); }
+
+SatValue CadicalDPLLSatSolver::value(SatLiteral l)
+{
+  if (d_sat && l.getSatVariable() < d_numModelVars)
+  {
+    return toSatValueLit(d_solver->val(toCadicalLit(l)));
+  }
+  SatValue v = d_propagator->value(l.getSatVariable());
+  return l.isNegated() ? invertValue(v) : v;
+}
+
+SatValue CadicalDPLLSatSolver::modelValue(SatLiteral l)
+{
+  Assert(d_sat);
+  return value(l);
+}
+
+unsigned CadicalDPLLSatSolver::getAssertionLevel() const
+{
+  return d_activations.size();
+}
+
+bool CadicalDPLLSatSolver::ok() const { return d_okay; }
+
+void CadicalDPLLSatSolver::push()
+{
+  resetTrail();
+  d_activations.push_back(toCadicalVar(newVar(false, false, false)));
+  d_context->push();  // SAT context for CVC4
+  d_propagator->userPush();
+}
+
+void CadicalDPLLSatSolver::pop()
+{
+  Assert(!d_activations.empty());
+  resetTrail();
+  // Disable the clauses of the popped level for good
+  d_solver->add(-d_activations.back());
+  d_solver->add(0);
+  d_activations.pop_back();
+  d_context->pop();  // SAT context for CVC4
+  d_propagator->userPop();
+  d_okay = true;
+}
+
+void CadicalDPLLSatSolver::resetTrail()
+{
+  d_sat = false;
+  d_propagator->backtrack(0);
+}
+
+bool CadicalDPLLSatSolver::properExplanation(SatLiteral lit,
+                                             SatLiteral expl) const
+{
+  return true;
+}
+
+void CadicalDPLLSatSolver::requirePhase(SatLiteral lit)
+{
+  d_solver->phase(toCadicalLit(lit));
+}
+
+bool CadicalDPLLSatSolver::isDecision(SatVariable decn) const
+{
+  return d_solver->is_decision(toCadicalVar(decn));
+}
+
+CadicalDPLLSatSolver::Statistics::Statistics(StatisticsRegistry* registry)
+    : d_registry(registry),
+      d_numSatCalls("prop::cadical::calls_to_solve", 0),
+      d_numVariables("prop::cadical::variables", 0),
+      d_numClauses("prop::cadical::clauses", 0),
+      d_numTheoryPropagations("prop::cadical::theory_propagations", 0),
+      d_numTheoryLemmas("prop::cadical::clauses_during_search", 0),
+      d_solveTime("prop::cadical::solve_time")
+{
+  d_registry->registerStat(&d_numSatCalls);
+  d_registry->registerStat(&d_numVariables);
+  d_registry->registerStat(&d_numClauses);
+  d_registry->registerStat(&d_numTheoryPropagations);
+  d_registry->registerStat(&d_numTheoryLemmas);
+  d_registry->registerStat(&d_solveTime);
+}
+
+CadicalDPLLSatSolver::Statistics::~Statistics()
+{
+  d_registry->unregisterStat(&d_numSatCalls);
+  d_registry->unregisterStat(&d_numVariables);
+  d_registry->unregisterStat(&d_numClauses);
+  d_registry->unregisterStat(&d_numTheoryPropagations);
+  d_registry->unregisterStat(&d_numTheoryLemmas);
+  d_registry->unregisterStat(&d_solveTime);
+}
+
 }  // namespace prop
 }  // namespace CVC4
 
@@ -11,7 +11,8 @@
  **
  ** \brief Wrapper for CaDiCaL SAT Solver.
  **
- ** Implementation of the CaDiCaL SAT solver for CVC4 (bitvectors).
+ ** Implementation of the CaDiCaL SAT solver for CVC4 (bitvectors), and of
+ ** the DPLL(T) interface on top of CaDiCaL's external propagator interface.
  **/
 
 #include "cvc4_private.h"
@@ -25,6 +26,11 @@
 
 #include <cadical.hpp>
 
+#include <memory>
+#include <vector>
+
+#include "context/context.h"
+
 namespace CVC4 {
 namespace prop {
 
@@ -83,6 +89,116 @@ class CadicalSolver : public SatSolver
   Statistics d_statistics;
 };
 
+class CadicalPropagator;
+
+/**
+ * The main SAT solver of DPLL(T) backed by CaDiCaL. The theories are
+ * connected through CaDiCaL's external propagator interface (IPASIR-UP):
+ * theory atoms are observed variables, theory propagations are propagated
+ * with lazily computed reasons, and lemmas and conflicts are added as
+ * external clauses.
+ *
+ * User levels are implemented with activation literals: a clause added at
+ * user level n > 0 is extended by the negation of the activation literal of
+ * level n, and solve() assumes the activation literals of all levels. Popping
+ * a level permanently falsifies its activation literal. Removable lemmas are
+ * kept like all other clauses.
+ */
+class CadicalDPLLSatSolver : public DPLLSatSolverInterface
+{
+ public:
+  CadicalDPLLSatSolver(StatisticsRegistry* registry);
+
+  ~CadicalDPLLSatSolver() override;
+
+  void initialize(context::Context* context,
+                  TheoryProxy* theoryProxy) override;
+
+  ClauseId addClause(SatClause& clause, bool removable) override;
+
+  /** Adds the XOR as a chain of fresh variables defined by clauses. */
+  ClauseId addXorClause(SatClause& clause, bool rhs, bool removable) override;
+
+  SatVariable newVar(bool isTheoryAtom,
+                     bool preRegister,
+                     bool canErase) override;
+
+  SatVariable trueVar() override { return d_true; }
+
+  SatVariable falseVar() override { return d_false; }
+
+  SatValue solve() override;
+  /**
+   * Solves with a budget of resource conflicts, or without budget if it is 0.
+   * Returns unknown if the budget is exhausted.
+   */
+  SatValue solve(long unsigned int& resource) override;
+  SatValue solve(const std::vector<SatLiteral>& assumptions) override;
+
+  void getUnsatAssumptions(std::vector<SatLiteral>& unsatAssumptions) override;
+
+  void interrupt() override;
+
+  SatValue value(SatLiteral l) override;
+
+  SatValue modelValue(SatLiteral l) override;
+
+  unsigned getAssertionLevel() const override;
+
+  bool ok() const override;
+
+  void push() override;
+
+  void pop() override;
+
+  void resetTrail() override;
+
+  bool properExplanation(SatLiteral lit, SatLiteral expl) const override;
+
+  void requirePhase(SatLiteral lit) override;
+
+  bool isDecision(SatVariable decn) const override;
+
+ private:
+  std::unique_ptr<CaDiCaL::Solver> d_solver;
+  std::unique_ptr<CadicalPropagator> d_propagator;
+
+  /** The SAT context, pushed on every user and decision level. */
+  context::Context* d_context;
+
+  unsigned d_nextVarIdx;
+  bool d_okay;
+  /** Whether solve() is running. */
+  bool d_inSearch;
+  /** Whether the last call to solve() returned sat. */
+  bool d_sat;
+  /** The number of variables at the end of the last call to solve(). */
+  SatVariable d_numModelVars;
+  SatVariable d_true;
+  SatVariable d_false;
+  /** The activation literal of each user level. */
+  std::vector<int> d_activations;
+  /** The failed assumptions of the last call to solve(), if it was unsat. */
+  std::vector<SatLiteral> d_unsatAssumptions;
+
+  struct Statistics
+  {
+    StatisticsRegistry* d_registry;
+    IntStat d_numSatCalls;
+    IntStat d_numVariables;
+    IntStat d_numClauses;
+    IntStat d_numTheoryPropagations;
+    IntStat d_numTheoryLemmas;
+    TimerStat d_solveTime;
+    Statistics(StatisticsRegistry* registry);
+    ~Statistics();
+  };
+
+  Statistics d_statistics;
+
+  friend class CadicalPropagator;
+};
+
 }  // namespace prop
 }  // namespace CVC4
 
@@ -17,6 +17,7 @@
  **/
 #include "prop/cnf_stream.h"
 
+#include <algorithm>
 #include <queue>
 
 #include "base/check.h"
@@ -24,6 +25,7 @@
 #include "expr/expr.h"
 #include "expr/node.h"
 #include "options/bv_options.h"
+#include "options/prop_options.h"
 #include "proof/clause_id.h"
 #include "proof/cnf_proof.h"
 #include "proof/proof_manager.h"
@@ -33,6 +35,7 @@
 #include "prop/theory_proxy.h"
 #include "smt/command.h"
 #include "smt/smt_engine_scope.h"
+#include "smt/smt_statistics_registry.h"
 #include "theory/theory.h"
 #include "theory/theory_engine.h"
 
@@ -60,8 +63,31 @@ CnfStream::CnfStream(SatSolver* satSolver, Registrar* registrar,
 TseitinCnfStream::TseitinCnfStream(SatSolver* satSolver, Registrar* registrar,
                                    context::Context* context,
                                    bool fullLitToNodeMap, std::string name)
-  : CnfStream(satSolver, registrar, context, fullLitToNodeMap, name)
-{}
+    : CnfStream(satSolver, registrar, context, fullLitToNodeMap, name),
+      d_gateHashing(options::cnfStructHash() && !PROOF_ON()),
+      d_gateHash(context),
+      d_polarityAware(options::cnfPolarity() && !PROOF_ON()),
+      d_definedPolarity(context),
+      d_statistics(name)
+{
+}
+
+TseitinCnfStream::Statistics::Statistics(const std::string& name)
+    : d_gateHashHits(name + "::cnf::gateHashHits", 0),
+      d_polarityClausesSaved(name + "::cnf::polarityClausesSaved", 0),
+      d_polarityCompletions(name + "::cnf::polarityCompletions", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_gateHashHits);
+  smtStatisticsRegistry()->registerStat(&d_polarityClausesSaved);
+  smtStatisticsRegistry()->registerStat(&d_polarityCompletions);
+}
+
+TseitinCnfStream::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_gateHashHits);
+  smtStatisticsRegistry()->unregisterStat(&d_polarityClausesSaved);
+  smtStatisticsRegistry()->unregisterStat(&d_polarityCompletions);
+}
 
 void CnfStream::assertClause(TNode node, SatClause& c) {
   Debug("cnf") << "Inserting into stream " << c << " node = " << node << endl;
@@ -118,6 +144,23 @@ void CnfStream::assertClause(TNode node, SatLiteral a, SatLiteral b, SatLiteral
   assertClause(node, clause);
 }
 
+void CnfStream::assertXorClause(TNode node, SatClause& c, bool rhs)
+{
+  Debug("cnf") << "Inserting into stream " << c << " = " << rhs
+               << " node = " << node << endl;
+  Assert(d_satSolver->nativeXor());
+  if (Dump.isOn("clauses"))
+  {
+    Node n = rhs ? getNode(c[0]) : getNode(~c[0]);
+    for (unsigned i = 1; i < c.size(); ++i)
+    {
+      n = NodeManager::currentNM()->mkNode(kind::XOR, n, getNode(c[i]));
+    }
+    Dump("clauses") << AssertCommand(Expr(n.toExpr()));
+  }
+  d_satSolver->addXorClause(c, rhs, d_removable);
+}
+
 bool CnfStream::hasLiteral(TNode n) const {
   NodeToLiteralMap::const_iterator find = d_nodeToLiteralMap.find(n);
   return find != d_nodeToLiteralMap.end();
@@ -171,7 +214,10 @@ void TseitinCnfStream::ensureLiteral(TNode n, bool noPreregistration) {
     lit = convertAtom(n, noPreregistration);
   }
 
-  Assert(hasLiteral(n) && getNode(lit) == n);
+  // n may share its literal with a structurally equal gate, in which case the
+  // literal maps back to that gate
+  Assert(hasLiteral(n) && getLiteral(n) == lit
+         && d_literalToNodeMap.contains(lit));
   Debug("ensureLiteral") << "CnfStream::ensureLiteral(): out lit is " << lit << std::endl;
 }
 
@@ -272,27 +318,67 @@ SatLiteral CnfStream::getLiteral(TNode node) {
   return literal;
 }
 
-SatLiteral TseitinCnfStream::handleXor(TNode xorNode) {
-  Assert(!hasLiteral(xorNode)) << "Atom already mapped!";
+SatLiteral TseitinCnfStream::handleXor(TNode xorNode, unsigned polarity)
+{
   Assert(xorNode.getKind() == XOR) << "Expecting an XOR expression!";
   Assert(xorNode.getNumChildren() == 2) << "Expecting exactly 2 children!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
 
+  if (d_satSolver->nativeXor() && !PROOF_ON())
+  {
+    Assert(!hasLiteral(xorNode)) << "Atom already mapped!";
+    // Flatten the nested XORs that have no literal yet into a single XOR
+    // constraint, the bound avoids blowing up shared subterms
+    const size_t maxSize = 32;
+    SatClause clause;
+    std::vector<TNode> visit;
+    visit.push_back(xorNode);
+    while (!visit.empty())
+    {
+      TNode cur = visit.back();
+      visit.pop_back();
+      for (const TNode& child : cur)
+      {
+        if (child.getKind() == XOR && !hasLiteral(child)
+            && clause.size() + visit.size() < maxSize)
+        {
+          visit.push_back(child);
+        }
+        else
+        {
+          clause.push_back(toCNF(child));
+        }
+      }
+    }
+    SatLiteral xorLit = newLiteral(xorNode);
+    clause.push_back(xorLit);
+    assertXorClause(xorNode, clause, false);
+    return xorLit;
+  }
+
   SatLiteral a = toCNF(xorNode[0]);
   SatLiteral b = toCNF(xorNode[1]);
 
-  SatLiteral xorLit = newLiteral(xorNode);
+  bool isNew = !hasLiteral(xorNode);
+  SatLiteral xorLit = isNew ? newLiteral(xorNode) : getLiteral(xorNode);
 
-  assertClause(xorNode.negate(), a, b, ~xorLit);
-  assertClause(xorNode.negate(), ~a, ~b, ~xorLit);
-  assertClause(xorNode, a, ~b, xorLit);
-  assertClause(xorNode, ~a, b, xorLit);
+  if (polarity & POLARITY_POS)
+  {
+    assertClause(xorNode.negate(), a, b, ~xorLit);
+    assertClause(xorNode.negate(), ~a, ~b, ~xorLit);
+  }
+  if (polarity & POLARITY_NEG)
+  {
+    assertClause(xorNode, a, ~b, xorLit);
+    assertClause(xorNode, ~a, b, xorLit);
+  }
+  recordDefinition(xorLit, isNew, polarity, 2, 2);
 
   return xorLit;
 }
 
-SatLiteral TseitinCnfStream::handleOr(TNode orNode) {
-  Assert(!hasLiteral(orNode)) << "Atom already mapped!";
+SatLiteral TseitinCnfStream::handleOr(TNode orNode, unsigned polarity)
+{
   Assert(orNode.getKind() == OR) << "Expecting an OR expression!";
   Assert(orNode.getNumChildren() > 1) << "Expecting more then 1 child!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
@@ -305,31 +391,48 @@ SatLiteral TseitinCnfStream::handleOr(TNode orNode) {
   TNode::const_iterator node_it_end = orNode.end();
   SatClause clause(n_children + 1);
   for(int i = 0; node_it != node_it_end; ++node_it, ++i) {
-    clause[i] = toCNF(*node_it);
+    clause[i] = toCNF(*node_it, false, polarity);
+  }
+
+  // (a_1 | ... | a_n) is the negation of the gate (~a_1 & ... & ~a_n)
+  SatClause gate;
+  for (unsigned i = 0; i < n_children; ++i)
+  {
+    gate.push_back(~clause[i]);
   }
 
   // Get the literal for this node
-  SatLiteral orLit = newLiteral(orNode);
+  bool isNew;
+  SatLiteral orLit = gateLiteral(orNode, gate, true, polarity, isNew);
 
   // lit <- (a_1 | a_2 | a_3 | ... | a_n)
   // lit | ~(a_1 | a_2 | a_3 | ... | a_n)
   // (lit | ~a_1) & (lit | ~a_2) & (lit & ~a_3) & ... & (lit & ~a_n)
-  for(unsigned i = 0; i < n_children; ++i) {
-    assertClause(orNode, orLit, ~clause[i]);
+  if (polarity & POLARITY_NEG)
+  {
+    for (unsigned i = 0; i < n_children; ++i)
+    {
+      assertClause(orNode, orLit, ~clause[i]);
+    }
   }
 
   // lit -> (a_1 | a_2 | a_3 | ... | a_n)
   // ~lit | a_1 | a_2 | a_3 | ... | a_n
-  clause[n_children] = ~orLit;
-  // This needs to go last, as the clause might get modified by the SAT solver
-  assertClause(orNode.negate(), clause);
+  if (polarity & POLARITY_POS)
+  {
+    clause[n_children] = ~orLit;
+    // This needs to go last, as the clause might get modified by the SAT
+    // solver
+    assertClause(orNode.negate(), clause);
+  }
+  recordDefinition(orLit, isNew, polarity, 1, n_children);
 
   // Return the literal
   return orLit;
 }
 
-SatLiteral TseitinCnfStream::handleAnd(TNode andNode) {
-  Assert(!hasLiteral(andNode)) << "Atom already mapped!";
+SatLiteral TseitinCnfStream::handleAnd(TNode andNode, unsigned polarity)
+{
   Assert(andNode.getKind() == AND) << "Expecting an AND expression!";
   Assert(andNode.getNumChildren() > 1) << "Expecting more than 1 child!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
@@ -342,58 +445,202 @@ SatLiteral TseitinCnfStream::handleAnd(TNode andNode) {
   TNode::const_iterator node_it_end = andNode.end();
   SatClause clause(n_children + 1);
   for(int i = 0; node_it != node_it_end; ++node_it, ++i) {
-    clause[i] = ~toCNF(*node_it);
+    clause[i] = ~toCNF(*node_it, false, polarity);
+  }
+
+  SatClause gate;
+  for (unsigned i = 0; i < n_children; ++i)
+  {
+    gate.push_back(~clause[i]);
   }
 
   // Get the literal for this node
-  SatLiteral andLit = newLiteral(andNode);
+  bool isNew;
+  SatLiteral andLit = gateLiteral(andNode, gate, false, polarity, isNew);
 
   // lit -> (a_1 & a_2 & a_3 & ... & a_n)
   // ~lit | (a_1 & a_2 & a_3 & ... & a_n)
   // (~lit | a_1) & (~lit | a_2) & ... & (~lit | a_n)
-  for(unsigned i = 0; i < n_children; ++i) {
-    assertClause(andNode.negate(), ~andLit, ~clause[i]);
+  if (polarity & POLARITY_POS)
+  {
+    for (unsigned i = 0; i < n_children; ++i)
+    {
+      assertClause(andNode.negate(), ~andLit, ~clause[i]);
+    }
   }
 
   // lit <- (a_1 & a_2 & a_3 & ... a_n)
   // lit | ~(a_1 & a_2 & a_3 & ... & a_n)
   // lit | ~a_1 | ~a_2 | ~a_3 | ... | ~a_n
-  clause[n_children] = andLit;
-  // This needs to go last, as the clause might get modified by the SAT solver
-  assertClause(andNode, clause);
+  if (polarity & POLARITY_NEG)
+  {
+    clause[n_children] = andLit;
+    // This needs to go last, as the clause might get modified by the SAT
+    // solver
+    assertClause(andNode, clause);
+  }
+  recordDefinition(andLit, isNew, polarity, n_children, 1);
 
   return andLit;
 }
 
-SatLiteral TseitinCnfStream::handleImplies(TNode impliesNode) {
-  Assert(!hasLiteral(impliesNode)) << "Atom already mapped!";
+bool TseitinCnfStream::normalizeGate(SatClause& inputs) const
+{
+  if (!d_gateHashing)
+  {
+    return false;
+  }
+  std::sort(inputs.begin(), inputs.end());
+  inputs.erase(std::unique(inputs.begin(), inputs.end()), inputs.end());
+  // complementary literals are adjacent after sorting
+  for (unsigned i = 1; i < inputs.size(); ++i)
+  {
+    if (inputs[i] == ~inputs[i - 1])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TseitinCnfStream::registerSharedLiteral(TNode node, SatLiteral lit)
+{
+  Debug("cnf") << "registerSharedLiteral(" << node << ") => " << lit << endl;
+  ++d_statistics.d_gateHashHits;
+  d_nodeToLiteralMap.insert(node, lit);
+  d_nodeToLiteralMap.insert(node.notNode(), ~lit);
+  // the literal keeps mapping back to the gate that introduced it
+  if (d_fullLitToNodeMap || Dump.isOn("clauses"))
+  {
+    d_literalToNodeMap.insert_safe(lit, node);
+    d_literalToNodeMap.insert_safe(~lit, node.notNode());
+  }
+}
+
+SatLiteral TseitinCnfStream::gateLiteral(TNode node,
+                                         SatClause& gate,
+                                         bool negated,
+                                         unsigned& polarity,
+                                         bool& isNew)
+{
+  isNew = false;
+  if (hasLiteral(node))
+  {
+    return getLiteral(node);
+  }
+  bool hashed = normalizeGate(gate);
+  if (hashed)
+  {
+    GateHash::const_iterator it = d_gateHash.find(gate);
+    if (it != d_gateHash.end())
+    {
+      SatLiteral lit = negated ? ~(*it).second : (*it).second;
+      registerSharedLiteral(node, lit);
+      polarity = missingPolarity(lit, polarity);
+      return lit;
+    }
+  }
+  SatLiteral lit = newLiteral(node);
+  isNew = true;
+  if (hashed)
+  {
+    d_gateHash.insert(gate, negated ? ~lit : lit);
+  }
+  return lit;
+}
+
+unsigned TseitinCnfStream::flipPolarity(unsigned polarity)
+{
+  return ((polarity & POLARITY_POS) ? POLARITY_NEG : 0)
+         | ((polarity & POLARITY_NEG) ? POLARITY_POS : 0);
+}
+
+unsigned TseitinCnfStream::missingPolarity(SatLiteral lit,
+                                           unsigned polarity) const
+{
+  PolarityMap::const_iterator it = d_definedPolarity.find(lit.getSatVariable());
+  if (it == d_definedPolarity.end())
+  {
+    // atoms and gates translated in full
+    return 0;
+  }
+  unsigned defined = lit.isNegated() ? flipPolarity((*it).second)
+                                     : (*it).second;
+  return polarity & ~defined;
+}
+
+void TseitinCnfStream::recordDefinition(SatLiteral lit,
+                                        bool isNew,
+                                        unsigned polarity,
+                                        unsigned nPos,
+                                        unsigned nNeg)
+{
+  if (!d_polarityAware || polarity == 0)
+  {
+    return;
+  }
+  unsigned pos = (polarity & POLARITY_POS) ? nPos : 0;
+  unsigned neg = (polarity & POLARITY_NEG) ? nNeg : 0;
+  if (isNew)
+  {
+    d_statistics.d_polarityClausesSaved += nPos + nNeg - pos - neg;
+  }
+  else
+  {
+    Debug("cnf") << "recordDefinition(" << lit << "): completed " << polarity
+                 << endl;
+    d_statistics.d_polarityClausesSaved += -static_cast<int64_t>(pos + neg);
+    ++d_statistics.d_polarityCompletions;
+  }
+  // the polarity of the variable, lit may be negated
+  unsigned defined = lit.isNegated() ? flipPolarity(polarity) : polarity;
+  PolarityMap::const_iterator it = d_definedPolarity.find(lit.getSatVariable());
+  if (it != d_definedPolarity.end())
+  {
+    defined |= (*it).second;
+  }
+  d_definedPolarity.insert(lit.getSatVariable(), defined);
+}
+
+SatLiteral TseitinCnfStream::handleImplies(TNode impliesNode,
+                                           unsigned polarity)
+{
   Assert(impliesNode.getKind() == IMPLIES)
       << "Expecting an IMPLIES expression!";
   Assert(impliesNode.getNumChildren() == 2) << "Expecting exactly 2 children!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
 
   // Convert the children to cnf
-  SatLiteral a = toCNF(impliesNode[0]);
-  SatLiteral b = toCNF(impliesNode[1]);
+  SatLiteral a = toCNF(impliesNode[0], false, flipPolarity(polarity));
+  SatLiteral b = toCNF(impliesNode[1], false, polarity);
 
-  SatLiteral impliesLit = newLiteral(impliesNode);
+  bool isNew = !hasLiteral(impliesNode);
+  SatLiteral impliesLit =
+      isNew ? newLiteral(impliesNode) : getLiteral(impliesNode);
 
   // lit -> (a->b)
   // ~lit | ~ a | b
-  assertClause(impliesNode.negate(), ~impliesLit, ~a, b);
+  if (polarity & POLARITY_POS)
+  {
+    assertClause(impliesNode.negate(), ~impliesLit, ~a, b);
+  }
 
   // (a->b) -> lit
   // ~(~a | b) | lit
   // (a | l) & (~b | l)
-  assertClause(impliesNode, a, impliesLit);
-  assertClause(impliesNode, ~b, impliesLit);
+  if (polarity & POLARITY_NEG)
+  {
+    assertClause(impliesNode, a, impliesLit);
+    assertClause(impliesNode, ~b, impliesLit);
+  }
+  recordDefinition(impliesLit, isNew, polarity, 1, 2);
 
   return impliesLit;
 }
 
 
-SatLiteral TseitinCnfStream::handleIff(TNode iffNode) {
-  Assert(!hasLiteral(iffNode)) << "Atom already mapped!";
+SatLiteral TseitinCnfStream::handleIff(TNode iffNode, unsigned polarity)
+{
   Assert(iffNode.getKind() == EQUAL) << "Expecting an EQUAL expression!";
   Assert(iffNode.getNumChildren() == 2) << "Expecting exactly 2 children!";
 
@@ -404,37 +651,46 @@ SatLiteral TseitinCnfStream::handleIff(TNode iffNode) {
   SatLiteral b = toCNF(iffNode[1]);
 
   // Get the now literal
-  SatLiteral iffLit = newLiteral(iffNode);
+  bool isNew = !hasLiteral(iffNode);
+  SatLiteral iffLit = isNew ? newLiteral(iffNode) : getLiteral(iffNode);
 
   // lit -> ((a-> b) & (b->a))
   // ~lit | ((~a | b) & (~b | a))
   // (~a | b | ~lit) & (~b | a | ~lit)
-  assertClause(iffNode.negate(), ~a, b, ~iffLit);
-  assertClause(iffNode.negate(), a, ~b, ~iffLit);
+  if (polarity & POLARITY_POS)
+  {
+    assertClause(iffNode.negate(), ~a, b, ~iffLit);
+    assertClause(iffNode.negate(), a, ~b, ~iffLit);
+  }
 
   // (a<->b) -> lit
   // ~((a & b) | (~a & ~b)) | lit
   // (~(a & b)) & (~(~a & ~b)) | lit
   // ((~a | ~b) & (a | b)) | lit
   // (~a | ~b | lit) & (a | b | lit)
-  assertClause(iffNode, ~a, ~b, iffLit);
-  assertClause(iffNode, a, b, iffLit);
+  if (polarity & POLARITY_NEG)
+  {
+    assertClause(iffNode, ~a, ~b, iffLit);
+    assertClause(iffNode, a, b, iffLit);
+  }
+  recordDefinition(iffLit, isNew, polarity, 2, 2);
 
   return iffLit;
 }
 
 
-SatLiteral TseitinCnfStream::handleNot(TNode notNode) {
-  Assert(!hasLiteral(notNode)) << "Atom already mapped!";
+SatLiteral TseitinCnfStream::handleNot(TNode notNode, unsigned polarity)
+{
   Assert(notNode.getKind() == NOT) << "Expecting a NOT expression!";
   Assert(notNode.getNumChildren() == 1) << "Expecting exactly 1 child!";
 
-  SatLiteral notLit = ~toCNF(notNode[0]);
+  SatLiteral notLit = ~toCNF(notNode[0], false, flipPolarity(polarity));
 
   return notLit;
 }
 
-SatLiteral TseitinCnfStream::handleIte(TNode iteNode) {
+SatLiteral TseitinCnfStream::handleIte(TNode iteNode, unsigned polarity)
+{
   Assert(iteNode.getKind() == ITE);
   Assert(iteNode.getNumChildren() == 3);
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
@@ -442,10 +698,11 @@ SatLiteral TseitinCnfStream::handleIte(TNode iteNode) {
   Debug("cnf") << "handleIte(" << iteNode[0] << " " << iteNode[1] << " " << iteNode[2] << ")" << endl;
 
   SatLiteral condLit = toCNF(iteNode[0]);
-  SatLiteral thenLit = toCNF(iteNode[1]);
-  SatLiteral elseLit = toCNF(iteNode[2]);
+  SatLiteral thenLit = toCNF(iteNode[1], false, polarity);
+  SatLiteral elseLit = toCNF(iteNode[2], false, polarity);
 
-  SatLiteral iteLit = newLiteral(iteNode);
+  bool isNew = !hasLiteral(iteNode);
+  SatLiteral iteLit = isNew ? newLiteral(iteNode) : getLiteral(iteNode);
 
   // If ITE is true then one of the branches is true and the condition
   // implies which one
@@ -453,9 +710,12 @@ SatLiteral TseitinCnfStream::handleIte(TNode iteNode) {
   // lit -> (t | e) & (b -> t) & (!b -> e)
   // lit -> (t | e) & (!b | t) & (b | e)
   // (!lit | t | e) & (!lit | !b | t) & (!lit | b | e)
-  assertClause(iteNode.negate(), ~iteLit, thenLit, elseLit);
-  assertClause(iteNode.negate(), ~iteLit, ~condLit, thenLit);
-  assertClause(iteNode.negate(), ~iteLit, condLit, elseLit);
+  if (polarity & POLARITY_POS)
+  {
+    assertClause(iteNode.negate(), ~iteLit, thenLit, elseLit);
+    assertClause(iteNode.negate(), ~iteLit, ~condLit, thenLit);
+    assertClause(iteNode.negate(), ~iteLit, condLit, elseLit);
+  }
 
   // If ITE is false then one of the branches is false and the condition
   // implies which one
@@ -463,48 +723,70 @@ SatLiteral TseitinCnfStream::handleIte(TNode iteNode) {
   // !lit -> (!t | !e) & (b -> !t) & (!b -> !e)
   // !lit -> (!t | !e) & (!b | !t) & (b | !e)
   // (lit | !t | !e) & (lit | !b | !t) & (lit | b | !e)
-  assertClause(iteNode, iteLit, ~thenLit, ~elseLit);
-  assertClause(iteNode, iteLit, ~condLit, ~thenLit);
-  assertClause(iteNode, iteLit, condLit, ~elseLit);
+  if (polarity & POLARITY_NEG)
+  {
+    assertClause(iteNode, iteLit, ~thenLit, ~elseLit);
+    assertClause(iteNode, iteLit, ~condLit, ~thenLit);
+    assertClause(iteNode, iteLit, condLit, ~elseLit);
+  }
+  recordDefinition(iteLit, isNew, polarity, 3, 3);
 
   return iteLit;
 }
 
 
-SatLiteral TseitinCnfStream::toCNF(TNode node, bool negated) {
+SatLiteral TseitinCnfStream::toCNF(TNode node, bool negated, unsigned polarity)
+{
   Debug("cnf") << "toCNF(" << node << ", negated = " << (negated ? "true" : "false") << ")" << endl;
 
   SatLiteral nodeLit;
   Node negatedNode = node.notNode();
 
-  // If the non-negated node has already been translated, get the translation
+  // The directions of the definition of node that are needed
+  if (!d_polarityAware)
+  {
+    polarity = POLARITY_BOTH;
+  }
+  else if (negated)
+  {
+    polarity = flipPolarity(polarity);
+  }
+
+  // If the non-negated node has already been translated, get the
+  // translation, and complete its definition if it was translated for the
+  // other polarity only
+  bool translate = true;
   if(hasLiteral(node)) {
     Debug("cnf") << "toCNF(): already translated" << endl;
     nodeLit = getLiteral(node);
-  } else {
+    polarity = missingPolarity(nodeLit, polarity);
+    translate = polarity != 0;
+  }
+  if (translate)
+  {
     // Handle each Boolean operator case
     switch(node.getKind()) {
     case NOT:
-      nodeLit = handleNot(node);
+      nodeLit = handleNot(node, polarity);
       break;
     case XOR:
-      nodeLit = handleXor(node);
+      nodeLit = handleXor(node, polarity);
       break;
     case ITE:
-      nodeLit = handleIte(node);
+      nodeLit = handleIte(node, polarity);
       break;
     case IMPLIES:
-      nodeLit = handleImplies(node);
+      nodeLit = handleImplies(node, polarity);
       break;
     case OR:
-      nodeLit = handleOr(node);
+      nodeLit = handleOr(node, polarity);
       break;
     case AND:
-      nodeLit = handleAnd(node);
+      nodeLit = handleAnd(node, polarity);
       break;
     case EQUAL:
       if(node[0].getType().isBoolean()) {
-        nodeLit = handleIff(node);
+        nodeLit = handleIff(node, polarity);
       } else {
         nodeLit = convertAtom(node);
       }
@@ -542,7 +824,7 @@ void TseitinCnfStream::convertAndAssertAnd(TNode node, bool negated) {
     TNode::const_iterator disjunct = node.begin();
     for(int i = 0; i < nChildren; ++ disjunct, ++ i) {
       Assert(disjunct != node.end());
-      clause[i] = toCNF(*disjunct, true);
+      clause[i] = toCNF(*disjunct, true, POLARITY_POS);
     }
     Assert(disjunct == node.end());
     assertClause(node.negate(), clause);
@@ -558,7 +840,7 @@ void TseitinCnfStream::convertAndAssertOr(TNode node, bool negated) {
     TNode::const_iterator disjunct = node.begin();
     for(int i = 0; i < nChildren; ++ disjunct, ++ i) {
       Assert(disjunct != node.end());
-      clause[i] = toCNF(*disjunct, false);
+      clause[i] = toCNF(*disjunct, false, POLARITY_POS);
     }
     Assert(disjunct == node.end());
     assertClause(node, clause);
@@ -635,8 +917,8 @@ void TseitinCnfStream::convertAndAssertIff(TNode node, bool negated) {
 void TseitinCnfStream::convertAndAssertImplies(TNode node, bool negated) {
   if (!negated) {
     // p => q
-    SatLiteral p = toCNF(node[0], false);
-    SatLiteral q = toCNF(node[1], false);
+    SatLiteral p = toCNF(node[0], false, POLARITY_NEG);
+    SatLiteral q = toCNF(node[1], false, POLARITY_POS);
     // Construct the clause ~p || q
     SatClause clause(2);
     clause[0] = ~p;
@@ -654,8 +936,8 @@ void TseitinCnfStream::convertAndAssertImplies(TNode node, bool negated) {
 void TseitinCnfStream::convertAndAssertIte(TNode node, bool negated) {
   // ITE(p, q, r)
   SatLiteral p = toCNF(node[0], false);
-  SatLiteral q = toCNF(node[1], negated);
-  SatLiteral r = toCNF(node[2], negated);
+  SatLiteral q = toCNF(node[1], negated, POLARITY_POS);
+  SatLiteral r = toCNF(node[2], negated, POLARITY_POS);
   // Construct the clauses:
   // (p => q) and (!p => r)
   Node nnode = node;
@@ -711,7 +993,8 @@ void TseitinCnfStream::convertAndAssert(TNode node, bool negated) {
                << ", negated = " << (negated ? "true" : "false") << ")" << endl;
 
   if (d_convertAndAssertCounter % ResourceManager::getFrequencyCount() == 0) {
-    NodeManager::currentResourceManager()->spendResource(options::cnfStep());
+    NodeManager::currentResourceManager()->spendResource(
+        ResourceManager::Resource::CnfStep, options::cnfStep());
     d_convertAndAssertCounter = 0;
   }
   ++d_convertAndAssertCounter;
@@ -25,6 +25,7 @@
 #ifndef CVC4__PROP__CNF_STREAM_H
 #define CVC4__PROP__CNF_STREAM_H
 
+#include "context/cdhashmap.h"
 #include "context/cdinsert_hashmap.h"
 #include "context/cdlist.h"
 #include "expr/node.h"
@@ -32,6 +33,7 @@
 #include "prop/registrar.h"
 #include "prop/theory_proxy.h"
 #include "smt_util/lemma_channels.h"
+#include "util/statistics_registry.h"
 
 namespace CVC4 {
 
@@ -135,6 +137,15 @@ class CnfStream {
    */
   void assertClause(TNode node, SatLiteral a, SatLiteral b, SatLiteral c);
 
+  /**
+   * Asserts the XOR constraint rhs = l_1 xor ... xor l_n of the literals in
+   * clause to the sat solver, which must support native XOR reasoning.
+   * @param node the node giving rise to this constraint
+   * @param clause the literals of the constraint
+   * @param rhs the right-hand side of the constraint
+   */
+  void assertXorClause(TNode node, SatClause& clause, bool rhs);
+
   /**
    * Acquires a new variable from the SAT solver to represent the node
    * and inserts the necessary data it into the mapping tables.
@@ -279,23 +290,37 @@ class TseitinCnfStream : public CnfStream {
    */
   void convertAndAssert(TNode node, bool negated);
 
+  /**
+   * The directions of the definition of a gate. POLARITY_POS stands for the
+   * clauses lit -> gate, which are needed where the gate may be asserted
+   * true, POLARITY_NEG for the clauses gate -> lit.
+   */
+  enum Polarity
+  {
+    POLARITY_POS = 1,
+    POLARITY_NEG = 2,
+    POLARITY_BOTH = 3
+  };
+
   // Each of these formulas handles takes care of a Node of each Kind.
   //
-  // Each handleX(Node &n) is responsible for:
+  // Each handleX(Node &n, polarity) is responsible for:
   //   - constructing a new literal, l (if necessary)
   //   - calling registerNode(n,l)
-  //   - adding clauses assure that l is equivalent to the Node
+  //   - adding clauses assure that l is equivalent to the Node, or only
+  //     implies it or is implied by it as given by polarity
   //   - calling toCNF on its children (if necessary)
   //   - returning l
   //
-  // handleX( n ) can assume that n is not in d_translationCache
-  SatLiteral handleNot(TNode node);
-  SatLiteral handleXor(TNode node);
-  SatLiteral handleImplies(TNode node);
-  SatLiteral handleIff(TNode node);
-  SatLiteral handleIte(TNode node);
-  SatLiteral handleAnd(TNode node);
-  SatLiteral handleOr(TNode node);
+  // handleX( n ) can assume that n is not in d_translationCache, or that it
+  // is but its definition lacks the directions in polarity
+  SatLiteral handleNot(TNode node, unsigned polarity);
+  SatLiteral handleXor(TNode node, unsigned polarity);
+  SatLiteral handleImplies(TNode node, unsigned polarity);
+  SatLiteral handleIff(TNode node, unsigned polarity);
+  SatLiteral handleIte(TNode node, unsigned polarity);
+  SatLiteral handleAnd(TNode node, unsigned polarity);
+  SatLiteral handleOr(TNode node, unsigned polarity);
 
   void convertAndAssertAnd(TNode node, bool negated);
   void convertAndAssertOr(TNode node, bool negated);
@@ -308,12 +333,97 @@ class TseitinCnfStream : public CnfStream {
    * Transforms the node into CNF recursively.
    * @param node the formula to transform
    * @param negated whether the literal is negated
+   * @param polarity the polarities in which the returned literal occurs,
+   * only these directions of the definition of the formula are added in
+   * polarity-aware mode
    * @return the literal representing the root of the formula
    */
-  SatLiteral toCNF(TNode node, bool negated = false);
+  SatLiteral toCNF(TNode node,
+                   bool negated = false,
+                   unsigned polarity = POLARITY_BOTH);
 
   void ensureLiteral(TNode n, bool noPreregistration = false) override;
 
+  /**
+   * Cache of the literals of AND gates, keyed by their sorted inputs. OR
+   * gates are hashed as the negation of the AND of their negated inputs.
+   */
+  typedef context::CDInsertHashMap<SatClause, SatLiteral, SatClauseHashFunction>
+      GateHash;
+
+  /**
+   * Normalize the inputs of an AND gate to a key of d_gateHash. Returns
+   * false if the gate is not hashed, because structural hashing is disabled
+   * or because the inputs contain complementary literals.
+   */
+  bool normalizeGate(SatClause& inputs) const;
+
+  /**
+   * Map node to the literal lit of a structurally equal gate instead of
+   * giving it a literal and definitional clauses of its own.
+   */
+  void registerSharedLiteral(TNode node, SatLiteral lit);
+
+  /**
+   * Get the literal of the gate node whose inputs, as an AND gate, are gate.
+   * If negated, node is the negation of that AND gate. Sets isNew if the
+   * literal is created. Otherwise, if the literal is shared with an equal
+   * gate, polarity is reduced to the directions that gate lacks.
+   */
+  SatLiteral gateLiteral(TNode node,
+                         SatClause& gate,
+                         bool negated,
+                         unsigned& polarity,
+                         bool& isNew);
+
+  static unsigned flipPolarity(unsigned polarity);
+
+  /** The directions in polarity that the definition of lit lacks */
+  unsigned missingPolarity(SatLiteral lit, unsigned polarity) const;
+
+  /**
+   * Remember that the directions polarity of the definition of lit were
+   * added, which have nPos and nNeg clauses, isNew if lit was just created.
+   */
+  void recordDefinition(SatLiteral lit,
+                        bool isNew,
+                        unsigned polarity,
+                        unsigned nPos,
+                        unsigned nNeg);
+
+  /** Whether structurally equal gates share their literal */
+  const bool d_gateHashing;
+
+  /** The literals of the translated gates */
+  GateHash d_gateHash;
+
+  /**
+   * Whether to only add the directions of gate definitions that their
+   * occurrences need (Plaisted-Greenbaum)
+   */
+  const bool d_polarityAware;
+
+  typedef context::CDHashMap<SatVariable, unsigned> PolarityMap;
+  /**
+   * The directions of the definitions of the gate variables, relative to the
+   * positive literal, in polarity-aware mode. Variables that are not in the
+   * map are fully defined.
+   */
+  PolarityMap d_definedPolarity;
+
+  struct Statistics
+  {
+    /** Number of gates that reused the literal of an equal gate */
+    IntStat d_gateHashHits;
+    /** Number of definitional clauses left out by polarity-aware mode */
+    IntStat d_polarityClausesSaved;
+    /** Number of gates whose definition was completed later */
+    IntStat d_polarityCompletions;
+    Statistics(const std::string& name);
+    ~Statistics();
+  };
+  Statistics d_statistics;
+
 }; /* class TseitinCnfStream */
 
 } /* CVC4::prop namespace */
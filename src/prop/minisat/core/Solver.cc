@@ -36,6 +36,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "prop/minisat/minisat.h"
 #include "prop/minisat/mtl/Sort.h"
 #include "prop/theory_proxy.h"
+#include "util/profiler.h"
 
 using namespace CVC4::prop;
 
@@ -96,6 +97,13 @@ static IntOption     opt_restart_first     (_cat, "rfirst",      "The base resta
 static DoubleOption  opt_restart_inc       (_cat, "rinc",        "Restart interval increase factor", 3, DoubleRange(1, false, HUGE_VAL, false));
 static DoubleOption  opt_garbage_frac      (_cat, "gc-frac",     "The fraction of wasted memory allowed before a garbage collection is triggered",  0.20, DoubleRange(0, false, HUGE_VAL, false));
 
+// The step size of CHB starts at 'chb_step_init' and decreases by 'chb_step_dec' with each
+// conflict down to 'chb_step_min' (Liang et al., "Exponential Recency Weighted Average Branching
+// Heuristic for SAT Solvers", AAAI 2016).
+static const double  chb_step_init = 0.4;
+static const double  chb_step_min  = 0.06;
+static const double  chb_step_dec  = 0.000001;
+
 //=================================================================================================
 // Proof declarations
 CRef Solver::TCRef_Undef = CRef_Undef;
@@ -124,6 +132,9 @@ Solver::Solver(CVC4::prop::TheoryProxy* proxy, CVC4::context::Context* context,
   , assertionLevel(0)
   , enable_incremental(enable_incremental)
   , minisat_busy(false)
+  , search_region(CVC4::Profiler::isEnabled()
+                      ? CVC4::Profiler::registerRegion("sat::search")
+                      : CVC4::Profiler::UNREGISTERED)
     // Parameters (user settable):
     //
   , verbosity        (0)
@@ -153,6 +164,8 @@ Solver::Solver(CVC4::prop::TheoryProxy* proxy, CVC4::context::Context* context,
     //
   , solves(0), starts(0), decisions(0), rnd_decisions(0), propagations(0), conflicts(0), resources_consumed(0)
   , dec_vars(0), clauses_literals(0), learnts_literals(0), max_literals(0), tot_literals(0)
+  , inprocessings(0), subsumed_clauses(0), vivified_clauses(0), vivified_literals(0)
+  , released_vars(0), card_propagations(0), card_conflicts(0)
 
   , ok                 (true)
   , cla_inc            (1)
@@ -164,6 +177,21 @@ Solver::Solver(CVC4::prop::TheoryProxy* proxy, CVC4::context::Context* context,
   , order_heap         (VarOrderLt(activity))
   , progress_estimate  (0)
   , remove_satisfied   (!enable_incremental)
+  , card_head          (0)
+  , tiered_reduce      (false)
+  , lbd_stamp          (0)
+  , branch_chb         (false)
+  , lemma_bump         (false)
+  , chb_step           (chb_step_init)
+  , chb_head           (0)
+  , use_target_phase   (false)
+  , use_rephase        (false)
+  , target_assigned    (0)
+  , best_assigned      (0)
+  , next_rephase       (0)
+  , rephase_count      (0)
+  , memory_pressure    (0)
+  , release_lemma_vars (false)
 
     // Resource constraints:
     //
@@ -211,10 +239,21 @@ Var Solver::newVar(bool sign, bool dvar, bool isTheoryAtom, bool preRegister, bo
     vardata  .push(VarData(CRef_Undef, -1, -1, assertionLevel, -1));
     activity .push(rnd_init_act ? drand(random_seed) * 0.00001 : 0);
     seen     .push(0);
+    chb_last_conflict.push(0);
     polarity .push(sign);
+    original_phases.push(sign);
+    target_phases.push(l_Undef);
+    best_phases.push(l_Undef);
     decision .push();
     trail    .capacity(v+1);
     theory   .push(isTheoryAtom);
+    lemma_vars.push(0);
+    released .push(0);
+    card_occurs.push();
+    card_occurs.push();
+    card_activations.push();
+    card_activations.push();
+    card_reasons.push(-1);
 
     setDecisionVar(v, dvar);
 
@@ -243,9 +282,18 @@ void Solver::resizeVars(int newSize) {
     vardata.shrink(shrinkSize);
     activity.shrink(shrinkSize);
     seen.shrink(shrinkSize);
+    chb_last_conflict.shrink(shrinkSize);
     polarity.shrink(shrinkSize);
+    original_phases.shrink(shrinkSize);
+    target_phases.shrink(shrinkSize);
+    best_phases.shrink(shrinkSize);
     decision.shrink(shrinkSize);
     theory.shrink(shrinkSize);
+    lemma_vars.shrink(shrinkSize);
+    released.shrink(shrinkSize);
+    card_occurs.shrink(2 * shrinkSize);
+    card_activations.shrink(2 * shrinkSize);
+    card_reasons.shrink(shrinkSize);
 
   }
 
@@ -265,15 +313,24 @@ CRef Solver::reason(Var x) {
   // What's the literal we are trying to explain
   Lit l = mkLit(x, value(x) != l_True);
 
-  // Get the explanation from the theory
-  SatClause explanation_cl;
-  // FIXME: at some point return a tag with the theory that spawned you
-  proxy->explainPropagation(MinisatSatSolver::toSatLiteral(l), explanation_cl);
+  // Get the explanation from the cardinality constraint that propagated the
+  // literal, or else from the theory
   vec<Lit> explanation;
-  MinisatSatSolver::toMinisatClause(explanation_cl, explanation);
-
-  Debug("pf::sat") << "Solver::reason: explanation_cl = " << explanation_cl
-                   << std::endl;
+  if (card_reasons[x] != -1)
+  {
+    cardinalityReason(card_reasons[x], l, explanation);
+  }
+  else
+  {
+    SatClause explanation_cl;
+    // FIXME: at some point return a tag with the theory that spawned you
+    proxy->explainPropagation(MinisatSatSolver::toSatLiteral(l),
+                              explanation_cl);
+    MinisatSatSolver::toMinisatClause(explanation_cl, explanation);
+
+    Debug("pf::sat") << "Solver::reason: explanation_cl = " << explanation_cl
+                     << std::endl;
+  }
 
   // Sort the literals by trail index level
   lemma_lt lt(*this);
@@ -523,6 +580,17 @@ void Solver::attachClause(CRef cr) {
     watches[~c[1]].push(Watcher(cr, c[0]));
     if (c.removable()) learnts_literals += c.size();
     else            clauses_literals += c.size();
+
+    // A released variable is a decision variable again once it occurs in a clause
+    if (release_lemma_vars) {
+        for (int i = 0; i < c.size(); i++) {
+            Var v = var(c[i]);
+            if (released[v]) {
+                released[v] = 0;
+                setDecisionVar(v, true);
+            }
+        }
+    }
 }
 
 
@@ -580,6 +648,11 @@ void Solver::cancelUntil(int level) {
             Var      x  = var(trail[c]);
             assigns [x] = l_Undef;
             vardata[x].trail_index = -1;
+            if (c < card_head){
+                const vec<int>& occ = card_occurs[toInt(~trail[c])];
+                for (int i = 0; i < occ.size(); i++) cards[occ[i]].num_false--;
+            }
+            card_reasons[x] = -1;
             if ((phase_saving > 1 ||
                  ((phase_saving == 1) && c > trail_lim.last())
                  ) && ((polarity[x] & 0x2) == 0)) {
@@ -589,6 +662,8 @@ void Solver::cancelUntil(int level) {
         }
         qhead = trail_lim[level];
         trail.shrink(trail.size() - trail_lim[level]);
+        if (chb_head > trail.size()) chb_head = trail.size();
+        if (card_head > trail.size()) card_head = trail.size();
         trail_lim.shrink(trail_lim.size() - level);
         flipped.shrink(flipped.size() - level);
 
@@ -603,6 +678,62 @@ void Solver::cancelUntil(int level) {
 
 void Solver::resetTrail() { cancelUntil(0); }
 
+void Solver::updatePhases(int consistent)
+{
+    if (consistent > target_assigned){
+        for (int i = 0; i < consistent; i++)
+            target_phases[var(trail[i])] = lbool(!sign(trail[i]));
+        target_assigned = consistent; }
+    if (consistent > best_assigned){
+        for (int i = 0; i < consistent; i++)
+            best_phases[var(trail[i])] = lbool(!sign(trail[i]));
+        best_assigned = consistent; }
+}
+
+void Solver::rephase()
+{
+    assert(decisionLevel() == 0);
+
+    // The schedule alternates the best phases with the original, inverted and random phases
+    static const int schedule_size = 6;
+    int strategy = rephase_count % schedule_size;
+    Debug("minisat") << "rephase " << rephase_count << ", strategy " << strategy << std::endl;
+    for (Var v = 0; v < nVars(); v++){
+        // Keep the phases required by the theories
+        if (polarity[v] & 0x2) continue;
+        switch (strategy){
+            case 1:  polarity[v] = original_phases[v]; break;
+            case 3:  polarity[v] = !original_phases[v]; break;
+            case 5:  polarity[v] = drand(random_seed) < 0.5; break;
+            default:
+                if (best_phases[v] != l_Undef) polarity[v] = best_phases[v] == l_False;
+                break;
+        }
+        target_phases[v] = l_Undef;
+    }
+    target_assigned = 0;
+    if (strategy % 2 == 0) best_assigned = 0;
+
+    rephase_count++;
+    next_rephase = conflicts + (uint64_t)options::satRephaseInterval() * (rephase_count + 1);
+}
+
+void Solver::chbReward(bool conflict)
+{
+    // Variables that occurred in a recent conflict get a higher reward when they are assigned
+    double multiplier = conflict ? 1.0 : 0.9;
+    for (int i = chb_head; i < trail.size(); i++){
+        Var    v      = var(trail[i]);
+        double reward = multiplier / (conflicts - chb_last_conflict[v] + 1);
+        activity[v] = (1 - chb_step) * activity[v] + chb_step * reward;
+        if (order_heap.inHeap(v))
+            order_heap.update(v);
+    }
+    chb_head = trail.size();
+    if (conflict && chb_step > chb_step_min)
+        chb_step = std::max(chb_step_min, chb_step - chb_step_dec);
+}
+
 //=================================================================================================
 // Major methods:
 
@@ -721,6 +852,13 @@ Lit Solver::pickBranchLit()
         Assert(dec_pol == l_True || dec_pol == l_False);
         decisionLit = mkLit(next, (dec_pol == l_True));
       }
+      else if (use_target_phase && !rnd_pol && (polarity[next] & 0x2) == 0
+               && target_phases[next] != l_Undef)
+      {
+        // Phases required by the theories are kept, otherwise extend the
+        // largest conflict-free assignment
+        decisionLit = mkLit(next, target_phases[next] == l_False);
+      }
       else
       {
         // If it can't use internal heuristic to do that
@@ -788,7 +926,14 @@ int Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
           Clause& c = ca[confl];
           max_resolution_level = std::max(max_resolution_level, c.level());
 
-          if (c.removable()) claBumpActivity(c);
+          if (c.removable()) {
+            claBumpActivity(c);
+            if (tiered_reduce && c.lbd() > core_lbd) {
+              c.used(true);
+              int lbd = computeLBD(c);
+              if (lbd < c.lbd()) c.lbd(lbd);
+            }
+          }
         }
 
         for (int j = (p == lit_Undef) ? 0 : 1, size = ca[confl].size();
@@ -799,7 +944,7 @@ int Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
 
           if (!seen[var(q)] && level(var(q)) > 0)
           {
-            varBumpActivity(var(q));
+            varBumpConflict(var(q));
             seen[var(q)] = 1;
             if (level(var(q)) >= decisionLevel())
               pathC++;
@@ -945,6 +1090,29 @@ bool Solver::litRedundant(Lit p, uint32_t abstract_levels)
 }
 
 
+template<class C>
+int Solver::computeLBD(const C& c)
+{
+    lbd_stamp++;
+    int lbd = 0;
+    for (int i = 0; i < c.size(); i++){
+        int l = level(var(c[i]));
+        if (l < 0){
+            // An unassigned literal
+            lbd++;
+            continue;
+        }
+        if (l >= lbd_seen.size())
+            lbd_seen.growTo(l + 1, 0);
+        if (lbd_seen[l] != lbd_stamp){
+            lbd_seen[l] = lbd_stamp;
+            lbd++;
+        }
+    }
+    return lbd;
+}
+
+
 /*_________________________________________________________________________________________________
 |
 |  analyzeFinal : (p : Lit)  ->  [void]
@@ -1039,6 +1207,17 @@ CRef Solver::propagate(TheoryCheckType type)
     do {
         // Propagate on the clauses
         confl = propagateBool();
+        // Propagate on the cardinality constraints, back to the clauses if
+        // something was propagated
+        if (confl == CRef_Undef && !cards.empty()) {
+            propagateCardinality();
+            if (lemmas.size() > 0) {
+                confl = updateLemmas();
+            }
+            if (confl == CRef_Undef && qhead < trail.size()) {
+                continue;
+            }
+        }
         // If no conflict, do the theory check
         if (confl == CRef_Undef && type != CHECK_WITHOUT_THEORY) {
             // Do the theory check
@@ -1110,6 +1289,115 @@ void Solver::propagateTheory() {
   }
 }
 
+/*_________________________________________________________________________________________________
+|
+|  propagateCardinality : [void]  ->  [void]
+|
+|  Description:
+|    Counts the literals of the trail in the cardinality constraints, and propagates the constraints
+|    whose counter or activation changed. Propagated literals get a lazy reason, built by
+|    'cardinalityReason()' when needed. Conflicts are added as lemmas.
+|________________________________________________________________________________________________@*/
+void Solver::propagateCardinality()
+{
+    bool no_conflict = true;
+    while (no_conflict && card_pending.size() > 0){
+        no_conflict = checkCardinality(card_pending.last());
+        card_pending.pop();
+    }
+    while (no_conflict && card_head < trail.size()){
+        Lit p = trail[card_head++];
+        // The counters must take 'p' into account even after a conflict, for 'cancelUntil()'
+        const vec<int>& occ = card_occurs[toInt(~p)];
+        for (int i = 0; i < occ.size(); i++){
+            cards[occ[i]].num_false++;
+            if (no_conflict) no_conflict = checkCardinality(occ[i]);
+        }
+        const vec<int>& act = card_activations[toInt(p)];
+        for (int i = 0; no_conflict && i < act.size(); i++)
+            no_conflict = checkCardinality(act[i]);
+    }
+}
+
+bool Solver::checkCardinality(int i)
+{
+    const CardConstraint& c = cards[i];
+    int slack = (int)c.lits.size() - c.bound - c.num_false;
+    if (slack < 0){
+        // Too many literals are false, the constraint cannot be active
+        if (value(c.activation) == l_Undef){
+            uncheckedEnqueue(~c.activation, CRef_Lazy);
+            card_reasons[var(c.activation)] = i;
+            card_propagations++;
+        }else if (value(c.activation) == l_True){
+            vec<Lit> confl;
+            cardinalityReason(i, lit_Undef, confl);
+            ClauseId id;
+            addClause(confl, true, id);
+            card_conflicts++;
+            return false;
+        }
+    }else if (slack == 0 && value(c.activation) == l_True){
+        // The constraint is active and no more literals may be false
+        for (size_t k = 0; k < c.lits.size(); k++){
+            Lit l = c.lits[k];
+            if (value(l) == l_Undef){
+                uncheckedEnqueue(l, CRef_Lazy);
+                card_reasons[var(l)] = i;
+                card_propagations++;
+            }
+        }
+    }
+    return true;
+}
+
+void Solver::cardinalityReason(int i, Lit p, vec<Lit>& out)
+{
+    const CardConstraint& c = cards[i];
+    // The constraint is violated by 'n - bound + 1' false literals, it propagates one of its literals
+    // with one false literal less
+    int needed = (int)c.lits.size() - c.bound + 1;
+    int limit = trail.size();
+    if (p != lit_Undef){
+        limit = trail_index(var(p));
+        if (p != ~c.activation){
+            out.push(p);
+            needed--;
+        }
+    }
+    out.push(~c.activation);
+    for (size_t k = 0; needed > 0 && k < c.lits.size(); k++){
+        Lit l = c.lits[k];
+        if (value(l) == l_False && trail_index(var(l)) < limit){
+            out.push(l);
+            needed--;
+        }
+    }
+    assert(needed <= 0);
+}
+
+void Solver::addCardinality(Lit p, const vec<Lit>& ps, int k)
+{
+    assert(decisionLevel() == 0);
+    // 'p -> at least k of ps' and '~p -> at least n - k + 1 of the negations of ps'
+    for (int half = 0; half < 2; half++){
+        int i = cards.size();
+        cards.push_back(CardConstraint());
+        CardConstraint& c = cards.back();
+        c.activation = half == 0 ? p : ~p;
+        c.bound = half == 0 ? k : ps.size() - k + 1;
+        c.num_false = 0;
+        for (int j = 0; j < ps.size(); j++){
+            Lit l = half == 0 ? ps[j] : ~ps[j];
+            c.lits.push_back(l);
+            card_occurs[toInt(l)].push(i);
+            if (value(l) == l_False && trail_index(var(l)) < card_head) c.num_false++;
+        }
+        card_activations[toInt(c.activation)].push(i);
+        card_pending.push(i);
+    }
+}
+
 /*_________________________________________________________________________________________________
 |
 |  theoryCheck: [void]  ->  [Clause*]
@@ -1215,6 +1503,11 @@ struct reduceDB_lt {
 };
 void Solver::reduceDB()
 {
+    if (tiered_reduce) {
+        reduceDBTiered();
+        return;
+    }
+
     int     i, j;
     double  extra_lim = cla_inc / clauses_removable.size();    // Remove any clause below this activity
 
@@ -1229,10 +1522,90 @@ void Solver::reduceDB()
             clauses_removable[j++] = clauses_removable[i];
     }
     clauses_removable.shrink(i - j);
+    if (release_lemma_vars) releaseLemmaVars();
     checkGarbage();
 }
 
 
+struct reduceDBTiered_lt {
+    ClauseAllocator& ca;
+    reduceDBTiered_lt(ClauseAllocator& ca_) : ca(ca_) {}
+    bool operator () (CRef x, CRef y) {
+        return ca[x].lbd() > ca[y].lbd() || (ca[x].lbd() == ca[y].lbd() && ca[x].activity() < ca[y].activity()); }
+};
+void Solver::reduceDBTiered()
+{
+    int       i, j;
+    vec<CRef> local;
+
+    // Keep binary, locked and core clauses, and the clauses of the second tier that were used
+    // since the last reduction:
+    for (i = j = 0; i < clauses_removable.size(); i++){
+        Clause& c = ca[clauses_removable[i]];
+        if (c.size() <= 2 || locked(c) || c.lbd() <= core_lbd || (c.lbd() <= tier2_lbd && c.used()))
+            clauses_removable[j++] = clauses_removable[i];
+        else
+            local.push(clauses_removable[i]);
+        c.used(false);
+    }
+    clauses_removable.shrink(i - j);
+
+    // From the rest, delete the half with the highest LBD (and lowest activity among equals):
+    sort(local, reduceDBTiered_lt(ca));
+    for (i = 0; i < local.size(); i++){
+        if (i < local.size() / 2)
+            removeClause(local[i]);
+        else
+            clauses_removable.push(local[i]);
+    }
+    if (release_lemma_vars) releaseLemmaVars();
+    checkGarbage();
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  releaseLemmaVars : [void]  ->  [void]
+|
+|  Description:
+|    Release the variables that occurred in removable theory lemmas, but occur in no clause after
+|    the reduction of the clause database: their watcher lists are freed, and they are no longer
+|    decided on, until a new clause mentions them. The variables themselves, and the atoms that
+|    the CNF stream maps to them, are kept, since the theories have preregistered these atoms and
+|    may still propagate them.
+|________________________________________________________________________________________________@*/
+void Solver::releaseLemmaVars()
+{
+    vec<char> occurs(nVars(), 0);
+    for (int i = 0; i < clauses_persistent.size(); i++){
+        const Clause& c = ca[clauses_persistent[i]];
+        for (int k = 0; k < c.size(); k++) occurs[var(c[k])] = 1;
+    }
+    for (int i = 0; i < clauses_removable.size(); i++){
+        const Clause& c = ca[clauses_removable[i]];
+        for (int k = 0; k < c.size(); k++) occurs[var(c[k])] = 1;
+    }
+    for (int i = 0; i < lemmas.size(); i++)
+        for (int k = 0; k < lemmas[i].size(); k++) occurs[var(lemmas[i][k])] = 1;
+    for (size_t i = 0; i < cards.size(); i++){
+        occurs[var(cards[i].activation)] = 1;
+        for (size_t k = 0; k < cards[i].lits.size(); k++) occurs[var(cards[i].lits[k])] = 1;
+    }
+
+    for (Var v = 0; v < nVars(); v++){
+        if (!lemma_vars[v]) continue;
+        lemma_vars[v] = 0;
+        if (occurs[v] || !decision[v]) continue;
+        watches[mkLit(v, false)].clear(true);
+        watches[mkLit(v, true )].clear(true);
+        setDecisionVar(v, false);
+        released[v] = 1;
+        released_vars++;
+    }
+    Debug("minisat::release") << "Solver::releaseLemmaVars(): " << released_vars << " released" << std::endl;
+}
+
+
 void Solver::removeSatisfied(vec<CRef>& cs)
 {
     int i, j;
@@ -1266,6 +1639,172 @@ void Solver::removeClausesAboveLevel(vec<CRef>& cs, int level)
     cs.shrink(i - j);
 }
 
+/*_________________________________________________________________________________________________
+|
+|  inprocess : [void]  ->  [bool]
+|
+|  Description:
+|    Subsume and vivify the learnt clauses at decision level 0. Theory atoms are treated like any
+|    other literal, only Boolean propagation is used. A clause is only strengthened if it lives at
+|    the current assertion level, and only removed if it is subsumed by a clause that lives at
+|    least as long, so that push() and pop() are not affected.
+|________________________________________________________________________________________________@*/
+bool Solver::inprocess()
+{
+    assert(decisionLevel() == 0);
+    Debug("minisat::inprocess") << "Solver::inprocess(): " << clauses_removable.size() << " learnts" << std::endl;
+
+    inprocessings++;
+    next_inprocess = conflicts + options::satInprocessInterval();
+
+    subsumeLearnts();
+    vivifyLearnts();
+    checkGarbage();
+
+    return ok;
+}
+
+void Solver::subsumeLearnts()
+{
+    // Occurrence lists of the clauses that may be removed
+    vec<vec<CRef> > occurs(2 * nVars());
+    for (int i = 0; i < clauses_removable.size(); i++){
+        const Clause& c = ca[clauses_removable[i]];
+        if (!locked(c))
+            for (int k = 0; k < c.size(); k++)
+                occurs[toInt(c[k])].push(clauses_removable[i]);
+    }
+
+    // Limit the work to a few passes over the clause database
+    int64_t budget = 10 * (clauses_literals + learnts_literals);
+    vec<char> marked(2 * nVars(), 0);
+    for (int pass = 0; pass < 2 && budget > 0; pass++){
+        const vec<CRef>& cs = pass == 0 ? clauses_persistent : clauses_removable;
+        for (int i = 0; i < cs.size() && budget > 0; i++){
+            CRef cr = cs[i];
+            const Clause& c = ca[cr];
+            if (c.mark() == 1)
+                continue;
+
+            // Look for the supersets of c among the clauses of its least frequent literal
+            Lit best = c[0];
+            for (int k = 1; k < c.size(); k++)
+                if (occurs[toInt(c[k])].size() < occurs[toInt(best)].size())
+                    best = c[k];
+            for (int k = 0; k < c.size(); k++)
+                marked[toInt(c[k])] = 1;
+
+            const vec<CRef>& occ = occurs[toInt(best)];
+            for (int j = 0; j < occ.size(); j++){
+                const Clause& d = ca[occ[j]];
+                if (occ[j] == cr || d.mark() == 1 || d.size() < c.size() || d.level() < c.level())
+                    continue;
+                int found = 0;
+                for (int k = 0; k < d.size() && found + d.size() - k >= c.size(); k++)
+                    found += marked[toInt(d[k])];
+                budget -= d.size();
+                if (found == c.size()){
+                    Debug("minisat::inprocess") << "Solver::subsumeLearnts(): " << c << " subsumes " << d << std::endl;
+                    subsumed_clauses++;
+                    removeClause(occ[j]);
+                }
+            }
+
+            for (int k = 0; k < c.size(); k++)
+                marked[toInt(c[k])] = 0;
+        }
+    }
+
+    int i, j;
+    for (i = j = 0; i < clauses_removable.size(); i++)
+        if (ca[clauses_removable[i]].mark() != 1)
+            clauses_removable[j++] = clauses_removable[i];
+    clauses_removable.shrink(i - j);
+}
+
+struct vivify_lt {
+    ClauseAllocator& ca;
+    const vec<CRef>& cs;
+    vivify_lt(ClauseAllocator& ca_, const vec<CRef>& cs_) : ca(ca_), cs(cs_) {}
+    bool operator () (int x, int y) { return ca[cs[x]].activity() > ca[cs[y]].activity(); }
+};
+void Solver::vivifyLearnts()
+{
+    // The candidates by decreasing activity, as indices into 'clauses_removable'
+    vec<int> cands;
+    for (int i = 0; i < clauses_removable.size(); i++){
+        const Clause& c = ca[clauses_removable[i]];
+        if (c.size() > 2 && c.level() == assertionLevel && !locked(c) && !satisfied(c))
+            cands.push(i);
+    }
+    sort(cands, vivify_lt(ca, clauses_removable));
+
+    // Limit the work to about one propagation per learnt literal
+    uint64_t limit = propagations + learnts_literals;
+    vec<Lit> lits;
+    for (int i = 0; i < cands.size() && propagations < limit; i++){
+        CRef cr = clauses_removable[cands[i]];
+        const Clause& c = ca[cr];
+        // Units found so far may have changed the clause
+        if (locked(c) || satisfied(c))
+            continue;
+        detachClause(cr, true);
+
+        // Assume the negation of the literals one by one: if this leads to a conflict, or makes a
+        // literal of the clause true, the remaining literals are not needed. Literals that are
+        // made false are not needed either.
+        lits.clear();
+        for (int k = 0; k < c.size(); k++){
+            Lit p = c[k];
+            if (value(p) == l_False)
+                continue;
+            lits.push(p);
+            if (value(p) == l_True)
+                break;
+            newDecisionLevel();
+            uncheckedEnqueue(~p);
+            if (propagateBool() != CRef_Undef)
+                break;
+        }
+        cancelUntil(0);
+
+        if (lits.size() == c.size()){
+            attachClause(cr);
+            continue;
+        }
+
+        Debug("minisat::inprocess") << "Solver::vivifyLearnts(): shortened " << c << " to " << lits.size() << " literals" << std::endl;
+        vivified_clauses++;
+        vivified_literals += c.size() - lits.size();
+        int   level = c.level();
+        int   lbd   = c.lbd();
+        float act   = ca[cr].activity();
+        ca[cr].mark(1);
+        ca.free(cr);
+        if (lits.size() == 1){
+            // The clause is removed from 'clauses_removable' below
+            assert(value(lits[0]) == l_Undef);
+            uncheckedEnqueue(lits[0]);
+            if (propagateBool() != CRef_Undef){
+                ok = false;
+                break;
+            }
+        }else{
+            CRef nr = ca.alloc(level, lits, true);
+            ca[nr].activity() = act;
+            if (lbd < ca[nr].lbd()) ca[nr].lbd(lbd);
+            attachClause(nr);
+            clauses_removable[cands[i]] = nr;
+        }
+    }
+
+    int i, j;
+    for (i = j = 0; i < clauses_removable.size(); i++)
+        if (ca[clauses_removable[i]].mark() != 1)
+            clauses_removable[j++] = clauses_removable[i];
+    clauses_removable.shrink(i - j);
+}
+
 void Solver::rebuildOrderHeap()
 {
     vec<Var> vs;
@@ -1345,9 +1884,13 @@ lbool Solver::search(int nof_conflicts)
                 return l_False;
             }
 
+            // The trail below the conflicting level is conflict-free
+            if (use_target_phase || use_rephase) updatePhases(trail_lim.last());
+
             // Analyze the conflict
             learnt_clause.clear();
             int max_level = analyze(confl, learnt_clause, backtrack_level);
+            if (branch_chb) chbReward(true);
             cancelUntil(backtrack_level);
 
             // Assert the conflict clause and the asserting literal
@@ -1364,6 +1907,7 @@ lbool Solver::search(int nof_conflicts)
               clauses_removable.push(cr);
               attachClause(cr);
               claBumpActivity(ca[cr]);
+              if (tiered_reduce) ca[cr].lbd(computeLBD(learnt_clause));
               uncheckedEnqueue(learnt_clause[0], cr);
               PROOF(ClauseId id =
                         ProofManager::getSatProof()->registerClause(cr, LEARNT);
@@ -1374,9 +1918,22 @@ lbool Solver::search(int nof_conflicts)
                                ->storeClauseGlue(id, cl_levels.size());)
                         ProofManager::getSatProof()
                             ->endResChain(id););
+
+              // Share short clauses with a low LBD with the other portfolio
+              // threads
+              if (proxy->isSharingLemmas()
+                  && learnt_clause.size()
+                         <= static_cast<int>(options::shareLemmaLength())
+                  && computeLBD(learnt_clause)
+                         <= static_cast<int>(options::shareLemmaLbd()))
+              {
+                SatClause clause;
+                MinisatSatSolver::toSatClause(ca[cr], clause);
+                proxy->notifyNewLemma(clause);
+              }
             }
 
-            varDecayActivity();
+            if (!branch_chb) varDecayActivity();
             claDecayActivity();
 
             if (--learntsize_adjust_cnt == 0){
@@ -1399,6 +1956,8 @@ lbool Solver::search(int nof_conflicts)
 
         } else {
 
+            if (branch_chb) chbReward(false);
+
 	    // If this was a final check, we are satisfiable
             if (check_type == CHECK_FINAL) {
 	      bool decisionEngineDone = proxy->isDecisionEngineDone();
@@ -1423,6 +1982,8 @@ lbool Solver::search(int nof_conflicts)
             {
               // Reached bound on number of conflicts:
               progress_estimate = progressEstimate();
+              if (use_target_phase || use_rephase) updatePhases(trail.size());
+              target_assigned = 0;
               cancelUntil(0);
               // [mdeters] notify theory engine of restarts for deferred
               // theory processing
@@ -1435,9 +1996,19 @@ lbool Solver::search(int nof_conflicts)
                 return l_False;
             }
 
+            // Simplify the learnt clauses (the proofs cannot record this):
+            if (decisionLevel() == 0 && options::satInprocess() && !PROOF_ON()
+                && conflicts >= next_inprocess && !inprocess()) {
+                return l_False;
+            }
+
             if (clauses_removable.size()-nAssigns() >= max_learnts) {
                 // Reduce the set of learnt clauses:
                 reduceDB();
+            } else if (proxy->getMemoryPressureCount() != memory_pressure) {
+                // Reduce it early when memory is short:
+                memory_pressure = proxy->getMemoryPressureCount();
+                reduceDB();
             }
 
             Lit next = lit_Undef;
@@ -1542,6 +2113,16 @@ lbool Solver::solve_()
     solves++;
 
     max_learnts               = nClauses() * learntsize_factor;
+    next_inprocess            = conflicts + options::satInprocessInterval();
+    tiered_reduce             = options::satTieredReduce();
+    branch_chb                = options::satBranching() == options::SatBranchingMode::CHB;
+    use_target_phase          = options::satTargetPhase();
+    use_rephase               = options::satRephase();
+    next_rephase              = conflicts + options::satRephaseInterval();
+    target_assigned           = 0;
+    best_assigned             = 0;
+    lemma_bump                = options::satLemmaBump();
+    release_lemma_vars        = options::satReleaseLemmaVars();
     learntsize_adjust_confl   = learntsize_adjust_start_confl;
     learntsize_adjust_cnt     = (int)learntsize_adjust_confl;
     lbool   status            = l_Undef;
@@ -1557,9 +2138,13 @@ lbool Solver::solve_()
     int curr_restarts = 0;
     while (status == l_Undef){
         double rest_base = luby_restart ? luby(restart_inc, curr_restarts) : pow(restart_inc, curr_restarts);
-        status = search(rest_base * restart_first);
+        {
+            CVC4::ProfileScope searchScope(search_region);
+            status = search(rest_base * restart_first);
+        }
         if (!withinBudget(options::satConflictStep())) break; // FIXME add restart option?
         curr_restarts++;
+        if (status == l_Undef && use_rephase && conflicts >= next_rephase) rephase();
     }
 
     if(!withinBudget(options::satConflictStep()))
@@ -1745,6 +2330,11 @@ void Solver::pop()
     if (user_level(x) > assertionLevel) {
       assigns[x] = l_Undef;
       vardata[x] = VarData(CRef_Undef, -1, -1, intro_level(x), -1);
+      if (trail.size() <= card_head) {
+        const vec<int>& occ = card_occurs[toInt(~trail.last())];
+        for (int i = 0; i < occ.size(); i++) cards[occ[i]].num_false--;
+      }
+      card_reasons[x] = -1;
       if(phase_saving >= 1 && (polarity[x] & 0x2) == 0)
         polarity[x] = sign(trail.last());
       insertVarOrder(x);
@@ -1755,6 +2345,8 @@ void Solver::pop()
   }
   // The head should be at the trail top
   qhead = trail.size();
+  if (chb_head > trail.size()) chb_head = trail.size();
+  if (card_head > trail.size()) card_head = trail.size();
 
   // Remove the clauses
   removeClausesAboveLevel(clauses_persistent, assertionLevel);
@@ -1778,7 +2370,8 @@ CRef Solver::updateLemmas() {
   Debug("minisat::lemmas") << "Solver::updateLemmas() begin" << std::endl;
 
   // Avoid adding lemmas indefinitely without resource-out
-  proxy->spendResource(options::lemmaStep());
+  proxy->spendResource(ResourceManager::Resource::LemmaStep,
+                       options::lemmaStep());
 
   CRef conflict = CRef_Undef;
 
@@ -1811,6 +2404,11 @@ CRef Solver::updateLemmas() {
         Debug("minisat::lemmas") << "Solver::updateLemmas(): found empty clause" << std::endl;
         continue;
       }
+      if (lemma_bump) {
+        for (int k = 0; k < lemma.size(); ++k) {
+          varBumpConflict(var(lemma[k]));
+        }
+      }
       // Sort the lemma to be able to attach
       sort(lemma, lt);
       // See if the lemma propagates something
@@ -1870,6 +2468,9 @@ CRef Solver::updateLemmas() {
          );
       if (removable) {
         clauses_removable.push(lemma_ref);
+        for (int k = 0; k < lemma.size(); ++ k) {
+          lemma_vars[var(lemma[k])] = 1;
+        }
       } else {
         clauses_persistent.push(lemma_ref);
       }
@@ -1944,6 +2545,8 @@ void ClauseAllocator::reloc(CRef& cr,
   // Copy extra data-fields:
   // (This could be cleaned-up. Generalize Clause-constructor to be applicable here instead?)
   to[cr].mark(c.mark());
+  to[cr].lbd(c.lbd());
+  to[cr].used(c.used());
   if (to[cr].removable())         to[cr].activity() = c.activity();
   else if (to[cr].has_extra()) to[cr].calcAbstraction();
 }
@@ -1953,7 +2556,7 @@ inline bool Solver::withinBudget(uint64_t amount) const
   Assert(proxy);
   // spendResource sets async_interrupt or throws UnsafeInterruptException
   // depending on whether hard-limit is enabled
-  proxy->spendResource(amount);
+  proxy->spendResource(ResourceManager::Resource::SatConflictStep, amount);
 
   bool within_budget =  !asynch_interrupt &&
     (conflict_budget    < 0 || conflicts < (uint64_t)conflict_budget) &&
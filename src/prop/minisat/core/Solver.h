@@ -24,6 +24,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "cvc4_private.h"
 
 #include <iosfwd>
+#include <vector>
 
 #include "base/output.h"
 #include "context/context.h"
@@ -109,6 +110,9 @@ protected:
   /** True if we are currently solving. */
   bool minisat_busy;
 
+  /** The profiled region of a search between two restarts */
+  uint32_t search_region;
+
   // Information about registration of variables
   struct VarIntroInfo {
     Var var;
@@ -183,6 +187,7 @@ public:
     bool    addClause (Lit p, Lit q, Lit r, bool removable, ClauseId& id); // Add a ternary clause to the solver.
     bool    addClause_(      vec<Lit>& ps, bool removable, ClauseId& id);  // Add a clause to the solver without making superflous internal copy. Will
                                                                                  // change the passed vector 'ps'.
+    void    addCardinality(Lit p, const vec<Lit>& ps, int k);              // Add the constraint 'p <-> (at least k of ps are true)' to the solver.
 
     // Solving:
     //
@@ -275,6 +280,9 @@ public:
     //
     uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts, resources_consumed;
     uint64_t dec_vars, clauses_literals, learnts_literals, max_literals, tot_literals;
+    uint64_t inprocessings, subsumed_clauses, vivified_clauses, vivified_literals;
+    uint64_t released_vars;
+    uint64_t card_propagations, card_conflicts;
 
 protected:
 
@@ -354,6 +362,27 @@ protected:
     // CVC4 Stuff
     vec<bool>           theory;           // Is the variable representing a theory atom
 
+    // Cardinality constraints:
+    //
+    struct CardConstraint {
+        Lit              activation;      // The constraint is 'activation -> at least 'bound' of 'lits' are true'.
+        std::vector<Lit> lits;
+        int              bound;
+        int              num_false;       // The number of literals of 'lits' false on the trail before 'card_head'.
+    };
+    std::vector<CardConstraint> cards;    // List of cardinality constraints, two for each call to 'addCardinality()'.
+    vec<vec<int> >      card_occurs;      // 'card_occurs[toInt(lit)]' is a list of (the indices of) the constraints 'lit' occurs in.
+    vec<vec<int> >      card_activations; // 'card_activations[toInt(lit)]' is a list of (the indices of) the constraints activated by 'lit'.
+    vec<int>            card_reasons;     // The constraint that propagated each variable, or -1.
+    vec<int>            card_pending;     // The constraints to check at the next propagation, regardless of the trail.
+    int                 card_head;        // The trail entries before this index have been counted in the constraints.
+
+    // Learnt clauses with at most this LBD are never removed by 'reduceDBTiered()'.
+    static const int    core_lbd = 2;
+    // Learnt clauses with at most this LBD are kept by 'reduceDBTiered()' if they were used in a
+    // conflict since the last reduction.
+    static const int    tier2_lbd = 6;
+
     enum TheoryCheckType {
       // Quick check, but don't perform theory reasoning
       CHECK_WITHOUT_THEORY,
@@ -374,6 +403,28 @@ protected:
     vec<Lit>            add_tmp;
 
     double              max_learnts;
+    bool                tiered_reduce;      // Whether 'reduceDB()' keeps the learnt clauses in tiers by their LBD.
+    vec<uint64_t>       lbd_seen;           // The last 'lbd_stamp' at which each decision level was seen by 'computeLBD()'.
+    uint64_t            lbd_stamp;
+    bool                branch_chb;         // Whether the activities are conflict history based (CHB) scores instead of VSIDS activities.
+    bool                lemma_bump;         // Whether the variables of theory lemmas are bumped as if they occurred in a conflict.
+    double              chb_step;           // The current CHB step size, decreases with the conflicts.
+    vec<uint64_t>       chb_last_conflict;  // The number of conflicts when each variable last occurred in a conflict, for CHB.
+    int                 chb_head;           // The trail entries before this index have been rewarded by 'chbReward()'.
+    bool                use_target_phase;   // Whether decisions prefer the target phases to the saved phases.
+    bool                use_rephase;        // Whether the saved phases are reset periodically by 'rephase()'.
+    vec<lbool>          target_phases;      // The value of each variable in the largest conflict-free trail since the last restart.
+    vec<lbool>          best_phases;        // The value of each variable in the largest conflict-free trail since the last rephasing to the best phases.
+    vec<char>           original_phases;    // The initial polarity of each variable.
+    int                 target_assigned;    // The size of the trail saved in 'target_phases'.
+    int                 best_assigned;      // The size of the trail saved in 'best_phases'.
+    uint64_t            next_rephase;       // Number of conflicts at which 'rephase()' runs next.
+    int                 rephase_count;      // Number of calls to 'rephase()', selects the strategy in the schedule.
+    uint64_t            next_inprocess;     // Number of conflicts at which 'inprocess()' runs next.
+    uint64_t            memory_pressure;    // The memory pressure count of the resource manager at the last 'reduceDB()'.
+    bool                release_lemma_vars; // Whether 'reduceDB()' releases the variables that only occurred in deleted theory lemmas.
+    vec<char>           lemma_vars;         // Whether each variable occurred in a removable theory lemma since it was last considered for release.
+    vec<char>           released;           // Whether each variable was released by 'releaseLemmaVars()' and occurs in no clause since.
     double              learntsize_adjust_confl;
     int                 learntsize_adjust_cnt;
 
@@ -394,6 +445,9 @@ protected:
     CRef     propagate        (TheoryCheckType type);                                  // Perform Boolean and Theory. Returns possibly conflicting clause.
     CRef     propagateBool    ();                                                      // Perform Boolean propagation. Returns possibly conflicting clause.
     void     propagateTheory  ();                                                      // Perform Theory propagation.
+    void     propagateCardinality();                                                   // Propagate the cardinality constraints, conflicts are added as lemmas.
+    bool     checkCardinality (int i);                                                 // Propagate 'cards[i]' after its counter or activation changed. Returns FALSE on a conflict.
+    void     cardinalityReason(int i, Lit p, vec<Lit>& out);                           // The explanation of 'p' by 'cards[i]' (or the conflict if 'p' is 'lit_Undef'), 'p' first.
     void     theoryCheck      (CVC4::theory::Theory::Effort effort);                   // Perform a theory satisfiability check. Adds lemmas.
     CRef     updateLemmas     ();                                                      // Add the lemmas, backtraking if necessary and return a conflict if there is one
     void     cancelUntil      (int level);                                             // Backtrack until a certain level.
@@ -403,7 +457,12 @@ protected:
     lbool    search           (int nof_conflicts);                                     // Search for a given number of conflicts.
     lbool    solve_           ();                                                      // Main solve method (assumptions given in 'assumptions').
     void     reduceDB         ();                                                      // Reduce the set of learnt clauses.
+    void     reduceDBTiered   ();                                                      // Reduce the set of learnt clauses by their LBD.
+    void     releaseLemmaVars ();                                                      // Release the variables of deleted theory lemmas that occur in no clause.
     void     removeSatisfied  (vec<CRef>& cs);                                         // Shrink 'cs' to contain only non-satisfied clauses.
+    bool     inprocess        ();                                                      // Simplify the learnt clauses at decision level 0. Returns FALSE if a conflict was found.
+    void     subsumeLearnts   ();                                                      // Remove learnt clauses that are subsumed by other clauses.
+    void     vivifyLearnts    ();                                                      // Remove literals from learnt clauses that are implied by unit propagation.
     void     rebuildOrderHeap ();
 
     // Maintaining Variable/Clause activity:
@@ -411,6 +470,10 @@ protected:
     void     varDecayActivity ();                      // Decay all variables with the specified factor. Implemented by increasing the 'bump' value instead.
     void     varBumpActivity  (Var v, double inc);     // Increase a variable with the current 'bump' value.
     void     varBumpActivity  (Var v);                 // Increase a variable with the current 'bump' value.
+    void     varBumpConflict  (Var v);                 // Record that a variable occurs in a conflict (or a theory lemma) for the branching heuristic.
+    void     chbReward        (bool conflict);         // Update the CHB scores of the variables assigned since the last call.
+    void     updatePhases     (int consistent);        // Save the first 'consistent' literals of the trail as target (and best) phases if they are the largest so far.
+    void     rephase          ();                      // Reset the saved phases by the next strategy of the rephasing schedule.
     void     claDecayActivity ();                      // Decay all clauses with the specified factor. Implemented by increasing the 'bump' value instead.
     void     claBumpActivity  (Clause& c);             // Increase a clause with the current 'bump' value.
 
@@ -428,6 +491,8 @@ protected:
     //
     int      decisionLevel    ()      const; // Gives the current decisionlevel.
     uint32_t abstractLevel    (Var x) const; // Used to represent an abstraction of sets of decision levels.
+    template<class C>
+    int      computeLBD       (const C& c);          // Number of distinct decision levels of the literals in 'c'.
     CRef     reason           (Var x); // Get the reason of the variable (non const as it might create the explanation on the fly)
     bool     hasReasonClause  (Var x) const; // Does the variable have a reason
     bool     isPropagated     (Var x) const; // Does the variable have a propagated variables
@@ -485,6 +550,9 @@ inline void Solver::insertVarOrder(Var x) {
 
 inline void Solver::varDecayActivity() { var_inc *= (1 / var_decay); }
 inline void Solver::varBumpActivity(Var v) { varBumpActivity(v, var_inc); }
+inline void Solver::varBumpConflict(Var v) {
+    if (branch_chb) chb_last_conflict[v] = conflicts;
+    else varBumpActivity(v); }
 inline void Solver::varBumpActivity(Var v, double inc) {
     if ( (activity[v] += inc) > 1e100 ) {
         // Rescale:
@@ -193,7 +193,9 @@ class Clause {
         unsigned has_extra : 1;
         unsigned reloced   : 1;
         unsigned size      : 27;
-        unsigned level     : 32; }                            header;
+        unsigned level     : 24;
+        unsigned lbd       : 7;
+        unsigned used      : 1; }                             header;
     union { Lit lit; float act; uint32_t abs; CRef rel; } data[0];
 
     friend class ClauseAllocator;
@@ -207,6 +209,9 @@ class Clause {
         header.reloced   = 0;
         header.size      = ps.size();
         header.level     = level;
+        header.lbd       = ps.size() < max_lbd ? ps.size() : max_lbd;
+        header.used      = 0;
+        assert(header.level == (unsigned)level);
 
         for (int i = 0; i < ps.size(); i++) 
             data[i].lit = ps[i];
@@ -219,6 +224,9 @@ class Clause {
     }
 
 public:
+    // Larger LBDs are not distinguished.
+    static const int max_lbd = 127;
+
     void calcAbstraction() {
         assert(header.has_extra);
         uint32_t abstraction = 0;
@@ -232,6 +240,10 @@ public:
     void         shrink      (int i)         { assert(i <= size()); if (header.has_extra) data[header.size-i] = data[header.size]; header.size -= i; }
     void         pop         ()              { shrink(1); }
     bool         removable   ()      const   { return header.removable; }
+    int          lbd         ()      const   { return header.lbd; }
+    void         lbd         (int l)         { header.lbd = l < max_lbd ? l : max_lbd; }
+    bool         used        ()      const   { return header.used; }
+    void         used        (bool u)        { header.used = u; }
     bool         has_extra   ()      const   { return header.has_extra; }
     uint32_t     mark        ()      const   { return header.mark; }
     void         mark        (uint32_t m)    { header.mark = m; }
@@ -16,6 +16,7 @@
 
 #include "prop/minisat/minisat.h"
 
+#include "options/arith_options.h"
 #include "options/base_options.h"
 #include "options/decision_options.h"
 #include "options/prop_options.h"
@@ -185,6 +186,28 @@ SatValue MinisatSatSolver::solve() {
   return toSatLiteralValue(d_minisat->solve());
 }
 
+SatValue MinisatSatSolver::solve(const std::vector<SatLiteral>& assumptions)
+{
+  setupOptions();
+  d_minisat->budgetOff();
+  Minisat::vec<Minisat::Lit> assumps;
+  for (const SatLiteral& lit : assumptions)
+  {
+    assumps.push(toMinisatLit(lit));
+  }
+  return toSatLiteralValue(d_minisat->solve(assumps));
+}
+
+void MinisatSatSolver::getUnsatAssumptions(
+    std::vector<SatLiteral>& unsatAssumptions)
+{
+  // the final conflict is a clause over the negations of the assumptions
+  for (int i = 0, size = d_minisat->conflict.size(); i < size; ++i)
+  {
+    unsatAssumptions.push_back(toSatLiteral(~d_minisat->conflict[i]));
+  }
+}
+
 bool MinisatSatSolver::ok() const {
   return d_minisat->okay();
 }
@@ -216,6 +239,26 @@ bool MinisatSatSolver::isDecision(SatVariable decn) const {
   return d_minisat->isDecision( decn );
 }
 
+bool MinisatSatSolver::nativeCardinality() const
+{
+  return options::pbNative() && !PROOF_ON();
+}
+
+void MinisatSatSolver::addCardinalityConstraint(SatLiteral lit,
+                                                const SatClause& lits,
+                                                unsigned k)
+{
+  Debug("sat::minisat") << "Add cardinality constraint " << lit << " <=> "
+                        << lits << " >= " << k << "\n";
+  Assert(nativeCardinality());
+  Minisat::vec<Minisat::Lit> minisat_lits;
+  for (const SatLiteral& l : lits)
+  {
+    minisat_lits.push(toMinisatLit(l));
+  }
+  d_minisat->addCardinality(toMinisatLit(lit), minisat_lits, k);
+}
+
 /** Incremental interface */
 
 unsigned MinisatSatSolver::getAssertionLevel() const {
@@ -244,7 +287,14 @@ MinisatSatSolver::Statistics::Statistics(StatisticsRegistry* registry) :
     d_statClausesLiterals("sat::clauses_literals"),
     d_statLearntsLiterals("sat::learnts_literals"),
     d_statMaxLiterals("sat::max_literals"),
-    d_statTotLiterals("sat::tot_literals")
+    d_statTotLiterals("sat::tot_literals"),
+    d_statInprocessings("sat::inprocessings"),
+    d_statSubsumedClauses("sat::subsumed_clauses"),
+    d_statVivifiedClauses("sat::vivified_clauses"),
+    d_statVivifiedLiterals("sat::vivified_literals"),
+    d_statReleasedVars("sat::released_vars"),
+    d_statCardPropagations("sat::card_propagations"),
+    d_statCardConflicts("sat::card_conflicts")
 {
   d_registry->registerStat(&d_statStarts);
   d_registry->registerStat(&d_statDecisions);
@@ -255,6 +305,13 @@ MinisatSatSolver::Statistics::Statistics(StatisticsRegistry* registry) :
   d_registry->registerStat(&d_statLearntsLiterals);
   d_registry->registerStat(&d_statMaxLiterals);
   d_registry->registerStat(&d_statTotLiterals);
+  d_registry->registerStat(&d_statInprocessings);
+  d_registry->registerStat(&d_statSubsumedClauses);
+  d_registry->registerStat(&d_statVivifiedClauses);
+  d_registry->registerStat(&d_statVivifiedLiterals);
+  d_registry->registerStat(&d_statReleasedVars);
+  d_registry->registerStat(&d_statCardPropagations);
+  d_registry->registerStat(&d_statCardConflicts);
 }
 
 MinisatSatSolver::Statistics::~Statistics() {
@@ -267,6 +324,13 @@ MinisatSatSolver::Statistics::~Statistics() {
   d_registry->unregisterStat(&d_statLearntsLiterals);
   d_registry->unregisterStat(&d_statMaxLiterals);
   d_registry->unregisterStat(&d_statTotLiterals);
+  d_registry->unregisterStat(&d_statInprocessings);
+  d_registry->unregisterStat(&d_statSubsumedClauses);
+  d_registry->unregisterStat(&d_statVivifiedClauses);
+  d_registry->unregisterStat(&d_statVivifiedLiterals);
+  d_registry->unregisterStat(&d_statReleasedVars);
+  d_registry->unregisterStat(&d_statCardPropagations);
+  d_registry->unregisterStat(&d_statCardConflicts);
 }
 
 void MinisatSatSolver::Statistics::init(Minisat::SimpSolver* d_minisat){
@@ -279,6 +343,13 @@ void MinisatSatSolver::Statistics::init(Minisat::SimpSolver* d_minisat){
   d_statLearntsLiterals.setData(d_minisat->learnts_literals);
   d_statMaxLiterals.setData(d_minisat->max_literals);
   d_statTotLiterals.setData(d_minisat->tot_literals);
+  d_statInprocessings.setData(d_minisat->inprocessings);
+  d_statSubsumedClauses.setData(d_minisat->subsumed_clauses);
+  d_statVivifiedClauses.setData(d_minisat->vivified_clauses);
+  d_statVivifiedLiterals.setData(d_minisat->vivified_literals);
+  d_statReleasedVars.setData(d_minisat->released_vars);
+  d_statCardPropagations.setData(d_minisat->card_propagations);
+  d_statCardConflicts.setData(d_minisat->card_conflicts);
 }
 
 } /* namespace CVC4::prop */
@@ -55,6 +55,8 @@ public:
 
   SatValue solve() override;
   SatValue solve(long unsigned int&) override;
+  SatValue solve(const std::vector<SatLiteral>& assumptions) override;
+  void getUnsatAssumptions(std::vector<SatLiteral>& unsatAssumptions) override;
 
   bool ok() const override;
 
@@ -80,6 +82,12 @@ public:
 
   bool isDecision(SatVariable decn) const override;
 
+  bool nativeCardinality() const override;
+
+  void addCardinalityConstraint(SatLiteral lit,
+                                const SatClause& lits,
+                                unsigned k) override;
+
  private:
 
   /** The SatSolver used */
@@ -98,6 +106,10 @@ public:
     ReferenceStat<uint64_t> d_statConflicts, d_statClausesLiterals;
     ReferenceStat<uint64_t> d_statLearntsLiterals,  d_statMaxLiterals;
     ReferenceStat<uint64_t> d_statTotLiterals;
+    ReferenceStat<uint64_t> d_statInprocessings, d_statSubsumedClauses;
+    ReferenceStat<uint64_t> d_statVivifiedClauses, d_statVivifiedLiterals;
+    ReferenceStat<uint64_t> d_statReleasedVars;
+    ReferenceStat<uint64_t> d_statCardPropagations, d_statCardConflicts;
   public:
     Statistics(StatisticsRegistry* registry);
     ~Statistics();
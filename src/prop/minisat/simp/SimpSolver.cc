@@ -204,6 +204,20 @@ bool SimpSolver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
 }
 
 
+void SimpSolver::addCardinality(Lit p, const vec<Lit>& ps, int k)
+{
+    // Variable elimination only takes clauses into account:
+    if (use_simplification){
+        setFrozen(var(p), true);
+        for (int i = 0; i < ps.size(); i++){
+            assert(!isEliminated(var(ps[i])));
+            setFrozen(var(ps[i]), true);
+        }
+    }
+    Solver::addCardinality(p, ps, k);
+}
+
+
 void SimpSolver::removeClause(CRef cr)
 {
     const Clause& c = ca[cr];
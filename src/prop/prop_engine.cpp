@@ -28,6 +28,7 @@
 #include "options/decision_options.h"
 #include "options/main_options.h"
 #include "options/options.h"
+#include "options/prop_options.h"
 #include "options/smt_options.h"
 #include "proof/proof_manager.h"
 #include "prop/cnf_stream.h"
@@ -91,11 +92,18 @@ PropEngine::PropEngine(TheoryEngine* te, DecisionEngine *de, Context* satContext
 
   Debug("prop") << "Constructing the PropEngine" << endl;
 
-  d_satSolver = SatSolverFactory::createDPLLMinisat(smtStatisticsRegistry());
+  if (options::satSolver() == options::DPLLSatSolverMode::CADICAL)
+  {
+    d_satSolver = SatSolverFactory::createDPLLCadical(smtStatisticsRegistry());
+  }
+  else
+  {
+    d_satSolver = SatSolverFactory::createDPLLMinisat(smtStatisticsRegistry());
+  }
 
   d_registrar = new theory::TheoryRegistrar(d_theoryEngine);
   d_cnfStream = new CVC4::prop::TseitinCnfStream(
-      d_satSolver, d_registrar, userContext, true);
+      d_satSolver, d_registrar, userContext, true, "prop");
 
   d_theoryProxy = new TheoryProxy(
       this, d_theoryEngine, d_decisionEngine, d_context, d_cnfStream, replayLog,
@@ -168,7 +176,10 @@ void PropEngine::printSatisfyingAssignment(){
   }
 }
 
-Result PropEngine::checkSat() {
+Result PropEngine::checkSat() { return checkSat(std::vector<Node>()); }
+
+Result PropEngine::checkSat(const std::vector<Node>& assumptions)
+{
   Assert(!d_inCheckSat) << "Sat solver in solve()!";
   Debug("prop") << "PropEngine::checkSat()" << endl;
 
@@ -187,7 +198,22 @@ Result PropEngine::checkSat() {
   d_interrupted = false;
 
   // Check the problem
-  SatValue result = d_satSolver->solve();
+  SatValue result;
+  if (assumptions.empty())
+  {
+    result = d_satSolver->solve();
+  }
+  else
+  {
+    std::vector<SatLiteral> assumps;
+    for (const Node& a : assumptions)
+    {
+      Assert(a.getType().isBoolean());
+      d_cnfStream->ensureLiteral(a);
+      assumps.push_back(d_cnfStream->getLiteral(a));
+    }
+    result = d_satSolver->solve(assumps);
+  }
 
   if( result == SAT_VALUE_UNKNOWN ) {
 
@@ -196,6 +222,10 @@ Result PropEngine::checkSat() {
       why = Result::TIMEOUT;
     if (d_resourceManager->outOfResources())
       why = Result::RESOURCEOUT;
+    if (d_resourceManager->outOfMemory())
+    {
+      why = Result::MEMOUT;
+    }
 
     return Result(Result::SAT_UNKNOWN, why);
   }
@@ -211,6 +241,16 @@ Result PropEngine::checkSat() {
   return Result(result == SAT_VALUE_TRUE ? Result::SAT : Result::UNSAT);
 }
 
+void PropEngine::getUnsatAssumptions(std::vector<Node>& unsatAssumptions)
+{
+  std::vector<SatLiteral> lits;
+  d_satSolver->getUnsatAssumptions(lits);
+  for (const SatLiteral& lit : lits)
+  {
+    unsatAssumptions.push_back(d_cnfStream->getNode(lit));
+  }
+}
+
 Node PropEngine::getValue(TNode node) const {
   Assert(node.getType().isBoolean());
   Assert(d_cnfStream->hasLiteral(node));
@@ -259,6 +299,29 @@ void PropEngine::ensureLiteral(TNode n) {
   d_cnfStream->ensureLiteral(n);
 }
 
+bool PropEngine::nativeCardinality() const
+{
+  return d_satSolver->nativeCardinality();
+}
+
+void PropEngine::addCardinalityConstraint(TNode lit,
+                                          const std::vector<Node>& lits,
+                                          unsigned k)
+{
+  Assert(!d_inCheckSat) << "Sat solver in solve()!";
+  Debug("prop") << "addCardinalityConstraint(" << lit << ", " << k << ")"
+                << endl;
+  SatClause clause;
+  for (const Node& l : lits)
+  {
+    d_cnfStream->ensureLiteral(l);
+    clause.push_back(d_cnfStream->getLiteral(l));
+  }
+  d_cnfStream->ensureLiteral(lit);
+  d_satSolver->addCardinalityConstraint(
+      d_cnfStream->getLiteral(lit), clause, k);
+}
+
 void PropEngine::push() {
   Assert(!d_inCheckSat) << "Sat solver in solve()!";
   d_satSolver->push();
@@ -295,9 +358,9 @@ void PropEngine::interrupt()
   Debug("prop") << "interrupt()" << endl;
 }
 
-void PropEngine::spendResource(unsigned amount)
+void PropEngine::spendResource(ResourceManager::Resource r, unsigned amount)
 {
-  d_resourceManager->spendResource(amount);
+  d_resourceManager->spendResource(r, amount);
 }
 
 bool PropEngine::properExplanation(TNode node, TNode expl) const {
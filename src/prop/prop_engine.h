@@ -29,6 +29,7 @@
 #include "options/options.h"
 #include "proof/proof_manager.h"
 #include "smt_util/lemma_channels.h"
+#include "util/resource_manager.h"
 #include "util/result.h"
 #include "util/unsafe_interrupt_exception.h"
 
@@ -160,6 +161,19 @@ public:
    */
   Result checkSat();
 
+  /**
+   * Checks the current context for satisfiability under the given Boolean
+   * assumptions, which are given a SAT literal if they do not have one.
+   */
+  Result checkSat(const std::vector<Node>& assumptions);
+
+  /**
+   * Get the subset of the assumptions of the last call to
+   * checkSat(assumptions) used to derive unsatisfiability, if it returned
+   * unsat.
+   */
+  void getUnsatAssumptions(std::vector<Node>& unsatAssumptions);
+
   /**
    * Get the value of a boolean variable.
    *
@@ -190,6 +204,22 @@ public:
    */
   void ensureLiteral(TNode n);
 
+  /**
+   * Return true if the SAT solver propagates cardinality constraints
+   * natively.
+   */
+  bool nativeCardinality() const;
+
+  /**
+   * Add the constraint lit <=> (at least k of lits are true) to the SAT
+   * solver. The literal lit and the elements of lits must be Boolean
+   * variables or their negations. The constraint is never removed, hence
+   * lit should be a fresh variable that it defines.
+   */
+  void addCardinalityConstraint(TNode lit,
+                                const std::vector<Node>& lits,
+                                unsigned k);
+
   /**
    * Push the context level.
    */
@@ -228,7 +258,7 @@ public:
    * Informs the ResourceManager that a resource has been spent.  If out of
    * resources, can throw an UnsafeInterruptException exception.
    */
-  void spendResource(unsigned amount);
+  void spendResource(ResourceManager::Resource r, unsigned amount);
 
   /**
    * For debugging.  Return true if "expl" is a well-formed
@@ -152,6 +152,27 @@ public:
   virtual void requirePhase(SatLiteral lit) = 0;
 
   virtual bool isDecision(SatVariable decn) const = 0;
+
+  /**
+   * Get the assumptions that were used to derive unsatisfiability by the last
+   * call to solve(assumptions), if it returned SAT_VALUE_FALSE.
+   */
+  virtual void getUnsatAssumptions(
+      std::vector<SatLiteral>& unsatAssumptions) = 0;
+
+  /** Return true if the solver supports native cardinality constraints */
+  virtual bool nativeCardinality() const { return false; }
+
+  /**
+   * Add the constraint lit <=> (at least k of lits are true). Must be called
+   * at decision level 0, and the constraint is never removed.
+   */
+  virtual void addCardinalityConstraint(SatLiteral lit,
+                                        const SatClause& lits,
+                                        unsigned k)
+  {
+    Unreachable() << "The SAT solver does not support cardinality constraints";
+  }
 };/* class DPLLSatSolverInterface */
 
 inline std::ostream& operator <<(std::ostream& out, prop::SatLiteral lit) {
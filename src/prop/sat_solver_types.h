@@ -178,6 +178,19 @@ struct SatLiteralHashFunction {
  */
 typedef std::vector<SatLiteral> SatClause;
 
+struct SatClauseHashFunction
+{
+  inline size_t operator()(const SatClause& clause) const
+  {
+    size_t acc = 0;
+    for (const SatLiteral& l : clause)
+    {
+      acc = acc * 31 + l.hash();
+    }
+    return acc;
+  }
+};
+
 struct SatClauseSetHashFunction
 {
   inline size_t operator()(
@@ -19,6 +19,7 @@
 #include "context/context.h"
 #include "decision/decision_engine.h"
 #include "expr/expr_stream.h"
+#include "expr/node_manager.h"
 #include "options/decision_options.h"
 #include "prop/cnf_stream.h"
 #include "prop/prop_engine.h"
@@ -51,14 +52,17 @@ TheoryProxy::TheoryProxy(PropEngine* propEngine,
       d_replayLog(replayLog),
       d_replayStream(replayStream),
       d_queue(context),
-      d_replayedDecisions("prop::theoryproxy::replayedDecisions", 0)
+      d_replayedDecisions("prop::theoryproxy::replayedDecisions", 0),
+      d_explainedPropagations("prop::theoryproxy::explainedPropagations", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_replayedDecisions);
+  smtStatisticsRegistry()->registerStat(&d_explainedPropagations);
 }
 
 TheoryProxy::~TheoryProxy() {
   /* nothing to do for now */
   smtStatisticsRegistry()->unregisterStat(&d_replayedDecisions);
+  smtStatisticsRegistry()->unregisterStat(&d_explainedPropagations);
 }
 
 /** The lemma input channel we are using. */
@@ -98,6 +102,7 @@ void TheoryProxy::theoryPropagate(std::vector<SatLiteral>& output) {
 void TheoryProxy::explainPropagation(SatLiteral l, SatClause& explanation) {
   TNode lNode = d_cnfStream->getNode(l);
   Debug("prop-explain") << "explainPropagation(" << lNode << ")" << std::endl;
+  ++d_explainedPropagations;
 
   LemmaProofRecipe* proofRecipe = NULL;
   PROOF(proofRecipe = new LemmaProofRecipe;);
@@ -161,10 +166,11 @@ TNode TheoryProxy::getNode(SatLiteral lit) {
 }
 
 void TheoryProxy::notifyRestart() {
-  d_propEngine->spendResource(options::restartStep());
+  d_propEngine->spendResource(ResourceManager::Resource::RestartStep,
+                              options::restartStep());
   d_theoryEngine->notifyRestart();
 
-  static uint32_t lemmaCount = 0;
+  static thread_local uint32_t lemmaCount = 0;
 
   if(inputChannel() != NULL) {
     while(inputChannel()->hasNewLemma()) {
@@ -192,6 +198,8 @@ void TheoryProxy::notifyRestart() {
   }
 }
 
+bool TheoryProxy::isSharingLemmas() { return outputChannel() != NULL; }
+
 void TheoryProxy::notifyNewLemma(SatClause& lemma) {
   Assert(lemma.size() > 0);
   if(outputChannel() != NULL) {
@@ -238,9 +246,14 @@ void TheoryProxy::logDecision(SatLiteral lit) {
 #endif /* CVC4_REPLAY */
 }
 
-void TheoryProxy::spendResource(unsigned amount)
+void TheoryProxy::spendResource(ResourceManager::Resource r, unsigned amount)
+{
+  d_theoryEngine->spendResource(r, amount);
+}
+
+uint64_t TheoryProxy::getMemoryPressureCount() const
 {
-  d_theoryEngine->spendResource(amount);
+  return NodeManager::currentResourceManager()->getMemoryPressureCount();
 }
 
 bool TheoryProxy::isDecisionRelevant(SatVariable var) {
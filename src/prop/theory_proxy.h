@@ -34,6 +34,7 @@
 #include "smt_util/lemma_input_channel.h"
 #include "smt_util/lemma_output_channel.h"
 #include "theory/theory.h"
+#include "util/resource_manager.h"
 #include "util/statistics_registry.h"
 
 namespace CVC4 {
@@ -88,11 +89,20 @@ public:
 
   void notifyNewLemma(SatClause& lemma);
 
+  /**
+   * Whether learned clauses are shared with other portfolio threads, i.e.,
+   * whether there is a lemma output channel.
+   */
+  bool isSharingLemmas();
+
   SatLiteral getNextReplayDecision();
 
   void logDecision(SatLiteral lit);
 
-  void spendResource(unsigned amount);
+  void spendResource(ResourceManager::Resource r, unsigned amount);
+
+  /** Get the memory pressure count of the resource manager */
+  uint64_t getMemoryPressureCount() const;
 
   bool isDecisionEngineDone();
 
@@ -146,6 +156,9 @@ public:
    */
   IntStat d_replayedDecisions;
 
+  /** Statistic: the number of explained theory propagations. */
+  IntStat d_explainedPropagations;
+
 };/* class SatSolver */
 
 }/* CVC4::prop namespace */
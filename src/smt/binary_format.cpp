@@ -0,0 +1,1053 @@
+/*********************                                                        */
+/*! \file binary_format.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the binary format for assertion sets
+ **/
+
+#include "smt/binary_format.h"
+
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "base/exception.h"
+#include "expr/node.h"
+#include "expr/node_builder.h"
+#include "expr/node_manager.h"
+#include "expr/node_manager_attributes.h"
+#include "expr/type_node.h"
+#include "smt/command.h"
+#include "util/bitvector.h"
+#include "util/divisible.h"
+#include "util/floatingpoint.h"
+#include "util/rational.h"
+#include "util/regexp.h"
+
+using namespace CVC4::kind;
+
+namespace CVC4 {
+
+namespace {
+
+/** The magic string at the start of the format */
+const char s_magic[] = "CVC4BIN";
+const size_t s_magicLength = sizeof(s_magic);
+
+/** The tags of records */
+enum RecordTag
+{
+  TAG_KIND = 1,
+  TAG_TYPE,
+  TAG_TERM,
+  TAG_LOGIC,
+  TAG_ASSERT,
+  TAG_CHECK_SAT,
+  TAG_SET_OPTION,
+  TAG_PUSH,
+  TAG_POP,
+  TAG_RESET_ASSERTIONS,
+  TAG_CHECK_SAT_ASSUMING,
+  TAG_GET_VALUE
+};
+
+/**
+ * The codes of the type constants supported by the format. These are fixed
+ * (unlike the values of TypeConstant, which depend on the build).
+ */
+const TypeConstant s_typeConstants[] = {BOOLEAN_TYPE,
+                                        INTEGER_TYPE,
+                                        REAL_TYPE,
+                                        STRING_TYPE,
+                                        REGEXP_TYPE,
+                                        ROUNDINGMODE_TYPE};
+const size_t s_numTypeConstants =
+    sizeof(s_typeConstants) / sizeof(s_typeConstants[0]);
+
+/** The codes of rounding modes */
+const RoundingMode s_roundingModes[] = {roundNearestTiesToEven,
+                                        roundNearestTiesToAway,
+                                        roundTowardPositive,
+                                        roundTowardNegative,
+                                        roundTowardZero};
+const size_t s_numRoundingModes =
+    sizeof(s_roundingModes) / sizeof(s_roundingModes[0]);
+
+void putUnsigned(std::string& buf, uint64_t n)
+{
+  while (n >= 0x80)
+  {
+    buf.push_back(static_cast<char>((n & 0x7f) | 0x80));
+    n >>= 7;
+  }
+  buf.push_back(static_cast<char>(n));
+}
+
+void putString(std::string& buf, const std::string& s)
+{
+  putUnsigned(buf, s.size());
+  buf.append(s);
+}
+
+void unsupported(const std::string& what)
+{
+  throw Exception(what + " cannot be written in the binary format");
+}
+
+/** Append the floating-point size of the conversion operator n of type T */
+template <class T>
+void putConvertSort(std::string& buf, TNode n)
+{
+  const FloatingPointSize& t = n.getConst<T>().t;
+  putUnsigned(buf, t.exponent());
+  putUnsigned(buf, t.significand());
+}
+
+/** Append the bit-vector size of the conversion operator n of type T */
+template <class T>
+void putToBVSize(std::string& buf, TNode n)
+{
+  putUnsigned(buf, n.getConst<T>().bvs.size);
+}
+
+}  // namespace
+
+/* -------------------------------------------------------------------------- */
+/* Writer                                                                     */
+/* -------------------------------------------------------------------------- */
+
+class BinaryFormatWriterPrivate
+{
+ public:
+  BinaryFormatWriterPrivate(std::ostream& out) : d_out(out), d_numNodes(0) {}
+  /** Write the record buf */
+  void flush(const std::string& buf) { d_out.write(buf.data(), buf.size()); }
+  /** Get the identifier of kind k, writing its record if necessary */
+  uint64_t writeKind(Kind k);
+  /** Get the identifier of type tn, writing its records if necessary */
+  uint64_t writeType(TypeNode tn);
+  /** Get the identifier of term n, writing its records if necessary */
+  uint64_t writeTerm(TNode n);
+
+ private:
+  /** Write the record of the term n, whose subterms have been written */
+  void writeTermRecord(TNode n);
+  /** Append the value of the constant n to buf */
+  void putConstant(std::string& buf, TNode n);
+  /** The output */
+  std::ostream& d_out;
+  /** The identifiers of the written kinds, types and terms */
+  std::unordered_map<Kind, uint64_t, kind::KindHashFunction> d_kinds;
+  std::unordered_map<TypeNode, uint64_t, TypeNodeHashFunction> d_types;
+  std::unordered_map<Node, uint64_t, NodeHashFunction> d_terms;
+  /** The number of written types and terms */
+  uint64_t d_numNodes;
+};
+
+uint64_t BinaryFormatWriterPrivate::writeKind(Kind k)
+{
+  std::unordered_map<Kind, uint64_t, kind::KindHashFunction>::iterator it =
+      d_kinds.find(k);
+  if (it != d_kinds.end())
+  {
+    return it->second;
+  }
+  std::string buf;
+  buf.push_back(static_cast<char>(TAG_KIND));
+  putString(buf, kind::kindToString(k));
+  flush(buf);
+  uint64_t id = d_kinds.size();
+  d_kinds[k] = id;
+  return id;
+}
+
+uint64_t BinaryFormatWriterPrivate::writeType(TypeNode tn)
+{
+  std::unordered_map<TypeNode, uint64_t, TypeNodeHashFunction>::iterator it =
+      d_types.find(tn);
+  if (it != d_types.end())
+  {
+    return it->second;
+  }
+  Kind k = tn.getKind();
+  std::string payload;
+  switch (k)
+  {
+    case TYPE_CONSTANT:
+    {
+      TypeConstant tc = tn.getConst<TypeConstant>();
+      size_t code = 0;
+      while (code < s_numTypeConstants && s_typeConstants[code] != tc)
+      {
+        code++;
+      }
+      if (code == s_numTypeConstants)
+      {
+        unsupported("type " + tn.toString());
+      }
+      putUnsigned(payload, code);
+      break;
+    }
+    case BITVECTOR_TYPE: putUnsigned(payload, tn.getBitVectorSize()); break;
+    case FLOATINGPOINT_TYPE:
+      putUnsigned(payload, tn.getFloatingPointExponentSize());
+      putUnsigned(payload, tn.getFloatingPointSignificandSize());
+      break;
+    case SORT_TYPE:
+    {
+      // only uninterpreted sorts, whose only child is their sort tag
+      std::string name;
+      if (!tn.isSort() || tn.getNumChildren() != 1
+          || !tn.getAttribute(expr::VarNameAttr(), name))
+      {
+        unsupported("sort " + tn.toString());
+      }
+      putString(payload, name);
+      break;
+    }
+    default:
+    {
+      if (tn.getMetaKind() != metakind::OPERATOR)
+      {
+        unsupported("type " + tn.toString());
+      }
+      putUnsigned(payload, tn.getNumChildren());
+      for (const TypeNode& tc : tn)
+      {
+        putUnsigned(payload, writeType(tc));
+      }
+      break;
+    }
+  }
+  std::string buf;
+  uint64_t kid = writeKind(k);
+  buf.push_back(static_cast<char>(TAG_TYPE));
+  putUnsigned(buf, kid);
+  buf.append(payload);
+  flush(buf);
+  uint64_t id = d_numNodes++;
+  d_types[tn] = id;
+  return id;
+}
+
+uint64_t BinaryFormatWriterPrivate::writeTerm(TNode n)
+{
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit;
+  visit.push_back(n);
+  do
+  {
+    TNode cur = visit.back();
+    if (d_terms.find(cur) != d_terms.end())
+    {
+      visit.pop_back();
+    }
+    else if (visited.insert(cur).second)
+    {
+      if (cur.getMetaKind() == metakind::PARAMETERIZED)
+      {
+        visit.push_back(cur.getOperator());
+      }
+      visit.insert(visit.end(), cur.begin(), cur.end());
+    }
+    else
+    {
+      // all subterms of cur have been written
+      visit.pop_back();
+      writeTermRecord(cur);
+    }
+  } while (!visit.empty());
+  return d_terms[n];
+}
+
+void BinaryFormatWriterPrivate::writeTermRecord(TNode n)
+{
+  Kind k = n.getKind();
+  std::string payload;
+  switch (n.getMetaKind())
+  {
+    case metakind::VARIABLE:
+    {
+      if (k != VARIABLE && k != BOUND_VARIABLE)
+      {
+        unsupported("variable " + n.toString());
+      }
+      std::string name;
+      n.getAttribute(expr::VarNameAttr(), name);
+      putString(payload, name);
+      putUnsigned(payload, writeType(n.getType()));
+      break;
+    }
+    case metakind::NULLARY_OPERATOR:
+      putUnsigned(payload, writeType(n.getType()));
+      break;
+    case metakind::CONSTANT: putConstant(payload, n); break;
+    case metakind::PARAMETERIZED:
+      putUnsigned(payload, n.getNumChildren() + 1);
+      putUnsigned(payload, d_terms[n.getOperator()]);
+      for (const Node& nc : n)
+      {
+        putUnsigned(payload, d_terms[nc]);
+      }
+      break;
+    case metakind::OPERATOR:
+      putUnsigned(payload, n.getNumChildren());
+      for (const Node& nc : n)
+      {
+        putUnsigned(payload, d_terms[nc]);
+      }
+      break;
+    default: unsupported("term " + n.toString()); break;
+  }
+  std::string buf;
+  uint64_t kid = writeKind(k);
+  buf.push_back(static_cast<char>(TAG_TERM));
+  putUnsigned(buf, kid);
+  buf.append(payload);
+  flush(buf);
+  d_terms[n] = d_numNodes++;
+}
+
+void BinaryFormatWriterPrivate::putConstant(std::string& buf, TNode n)
+{
+  switch (n.getKind())
+  {
+    case CONST_BOOLEAN: putUnsigned(buf, n.getConst<bool>() ? 1 : 0); break;
+    case CONST_RATIONAL:
+      putString(buf, n.getConst<Rational>().toString());
+      break;
+    case CONST_BITVECTOR:
+    {
+      const BitVector& bv = n.getConst<BitVector>();
+      putUnsigned(buf, bv.getSize());
+      putString(buf, bv.getValue().toString(16));
+      break;
+    }
+    case CONST_STRING:
+    {
+      const std::vector<unsigned>& vec = n.getConst<String>().getVec();
+      putUnsigned(buf, vec.size());
+      for (unsigned c : vec)
+      {
+        putUnsigned(buf, c);
+      }
+      break;
+    }
+    case CONST_ROUNDINGMODE:
+    {
+      RoundingMode rm = n.getConst<RoundingMode>();
+      size_t code = 0;
+      while (code < s_numRoundingModes && s_roundingModes[code] != rm)
+      {
+        code++;
+      }
+      putUnsigned(buf, code);
+      break;
+    }
+    case CONST_FLOATINGPOINT:
+    {
+      const FloatingPoint& fp = n.getConst<FloatingPoint>();
+      putUnsigned(buf, fp.t.exponent());
+      putUnsigned(buf, fp.t.significand());
+      putString(buf, fp.pack().getValue().toString(16));
+      break;
+    }
+    case BITVECTOR_EXTRACT_OP:
+      putUnsigned(buf, n.getConst<BitVectorExtract>().high);
+      putUnsigned(buf, n.getConst<BitVectorExtract>().low);
+      break;
+    case BITVECTOR_REPEAT_OP:
+      putUnsigned(buf, n.getConst<BitVectorRepeat>().repeatAmount);
+      break;
+    case BITVECTOR_ZERO_EXTEND_OP:
+      putUnsigned(buf, n.getConst<BitVectorZeroExtend>().zeroExtendAmount);
+      break;
+    case BITVECTOR_SIGN_EXTEND_OP:
+      putUnsigned(buf, n.getConst<BitVectorSignExtend>().signExtendAmount);
+      break;
+    case BITVECTOR_ROTATE_LEFT_OP:
+      putUnsigned(buf, n.getConst<BitVectorRotateLeft>().rotateLeftAmount);
+      break;
+    case BITVECTOR_ROTATE_RIGHT_OP:
+      putUnsigned(buf, n.getConst<BitVectorRotateRight>().rotateRightAmount);
+      break;
+    case INT_TO_BITVECTOR_OP:
+      putUnsigned(buf, n.getConst<IntToBitVector>().size);
+      break;
+    case DIVISIBLE_OP:
+      putString(buf, n.getConst<Divisible>().k.toString());
+      break;
+    case FLOATINGPOINT_TO_FP_IEEE_BITVECTOR_OP:
+      putConvertSort<FloatingPointToFPIEEEBitVector>(buf, n);
+      break;
+    case FLOATINGPOINT_TO_FP_FLOATINGPOINT_OP:
+      putConvertSort<FloatingPointToFPFloatingPoint>(buf, n);
+      break;
+    case FLOATINGPOINT_TO_FP_REAL_OP:
+      putConvertSort<FloatingPointToFPReal>(buf, n);
+      break;
+    case FLOATINGPOINT_TO_FP_SIGNED_BITVECTOR_OP:
+      putConvertSort<FloatingPointToFPSignedBitVector>(buf, n);
+      break;
+    case FLOATINGPOINT_TO_FP_UNSIGNED_BITVECTOR_OP:
+      putConvertSort<FloatingPointToFPUnsignedBitVector>(buf, n);
+      break;
+    case FLOATINGPOINT_TO_FP_GENERIC_OP:
+      putConvertSort<FloatingPointToFPGeneric>(buf, n);
+      break;
+    case FLOATINGPOINT_TO_UBV_OP: putToBVSize<FloatingPointToUBV>(buf, n); break;
+    case FLOATINGPOINT_TO_SBV_OP: putToBVSize<FloatingPointToSBV>(buf, n); break;
+    case FLOATINGPOINT_TO_UBV_TOTAL_OP:
+      putToBVSize<FloatingPointToUBVTotal>(buf, n);
+      break;
+    case FLOATINGPOINT_TO_SBV_TOTAL_OP:
+      putToBVSize<FloatingPointToSBVTotal>(buf, n);
+      break;
+    default: unsupported("constant " + n.toString()); break;
+  }
+}
+
+BinaryFormatWriter::BinaryFormatWriter(std::ostream& out)
+    : d_private(new BinaryFormatWriterPrivate(out))
+{
+  std::string buf(s_magic, s_magicLength);
+  putUnsigned(buf, BINARY_FORMAT_VERSION);
+  d_private->flush(buf);
+}
+
+BinaryFormatWriter::~BinaryFormatWriter() {}
+
+void BinaryFormatWriter::writeLogic(const std::string& logic)
+{
+  std::string buf;
+  buf.push_back(static_cast<char>(TAG_LOGIC));
+  putString(buf, logic);
+  d_private->flush(buf);
+}
+
+void BinaryFormatWriter::writeAssertion(Expr e)
+{
+  NodeManagerScope nms(NodeManager::fromExprManager(e.getExprManager()));
+  uint64_t id = d_private->writeTerm(Node::fromExpr(e));
+  std::string buf;
+  buf.push_back(static_cast<char>(TAG_ASSERT));
+  putUnsigned(buf, id);
+  d_private->flush(buf);
+}
+
+void BinaryFormatWriter::writeCheckSat()
+{
+  d_private->flush(std::string(1, static_cast<char>(TAG_CHECK_SAT)));
+}
+
+void BinaryFormatWriter::writeSetOption(const std::string& name,
+                                        const std::string& value)
+{
+  std::string buf;
+  buf.push_back(static_cast<char>(TAG_SET_OPTION));
+  putString(buf, name);
+  putString(buf, value);
+  d_private->flush(buf);
+}
+
+void BinaryFormatWriter::writePush()
+{
+  d_private->flush(std::string(1, static_cast<char>(TAG_PUSH)));
+}
+
+void BinaryFormatWriter::writePop()
+{
+  d_private->flush(std::string(1, static_cast<char>(TAG_POP)));
+}
+
+void BinaryFormatWriter::writeResetAssertions()
+{
+  d_private->flush(std::string(1, static_cast<char>(TAG_RESET_ASSERTIONS)));
+}
+
+void BinaryFormatWriter::writeCheckSatAssuming(
+    const std::vector<Expr>& assumptions)
+{
+  writeTermList(TAG_CHECK_SAT_ASSUMING, assumptions);
+}
+
+void BinaryFormatWriter::writeGetValue(const std::vector<Expr>& terms)
+{
+  writeTermList(TAG_GET_VALUE, terms);
+}
+
+void BinaryFormatWriter::writeTermList(unsigned tag,
+                                       const std::vector<Expr>& terms)
+{
+  std::vector<uint64_t> ids;
+  for (const Expr& e : terms)
+  {
+    NodeManagerScope nms(NodeManager::fromExprManager(e.getExprManager()));
+    ids.push_back(d_private->writeTerm(Node::fromExpr(e)));
+  }
+  std::string buf;
+  buf.push_back(static_cast<char>(tag));
+  putUnsigned(buf, ids.size());
+  for (uint64_t id : ids)
+  {
+    putUnsigned(buf, id);
+  }
+  d_private->flush(buf);
+}
+
+/* -------------------------------------------------------------------------- */
+/* Reader                                                                     */
+/* -------------------------------------------------------------------------- */
+
+class BinaryFormatReaderPrivate
+{
+ public:
+  BinaryFormatReaderPrivate(ExprManager* em, std::istream& in)
+      : d_em(em), d_nm(NodeManager::fromExprManager(em)), d_in(in)
+  {
+  }
+  /** Throw an exception for malformed input */
+  void malformed(const std::string& msg)
+  {
+    throw Exception("Malformed binary input: " + msg);
+  }
+  /** Read a byte, returns EOF at the end of the input */
+  int readByte() { return d_in.get(); }
+  uint64_t readUnsigned();
+  unsigned readUnsigned32();
+  std::string readString();
+  /** Read a kind identifier */
+  Kind readKind();
+  /** Read a type identifier */
+  TypeNode readTypeId();
+  /** Read a term identifier */
+  Node readTermId();
+  /** Read the identifier of a formula, used as what (e.g. an assertion) */
+  Node readFormulaId(const char* what);
+  /** Read a list of term identifiers */
+  std::vector<Expr> readTermIds();
+  /** Read a kind record */
+  void readKindRecord();
+  /** Read a type record, returns its declaration if it is a sort */
+  Command* readTypeRecord();
+  /** Read a term record, returns its declaration if it is a variable */
+  Command* readTermRecord();
+  /** Read the value of a constant of kind k */
+  Node readConstant(Kind k);
+
+  /** The expression manager and node manager of the input */
+  ExprManager* d_em;
+  NodeManager* d_nm;
+
+ private:
+  /** The input */
+  std::istream& d_in;
+  /** The kinds, types and terms of the input, by their identifiers */
+  std::vector<Kind> d_kinds;
+  std::vector<TypeNode> d_types;
+  std::vector<Node> d_terms;
+};
+
+uint64_t BinaryFormatReaderPrivate::readUnsigned()
+{
+  uint64_t n = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7)
+  {
+    int c = readByte();
+    if (c == EOF)
+    {
+      malformed("unexpected end of input");
+    }
+    n |= static_cast<uint64_t>(c & 0x7f) << shift;
+    if ((c & 0x80) == 0)
+    {
+      return n;
+    }
+  }
+  malformed("integer too large");
+  return 0;
+}
+
+unsigned BinaryFormatReaderPrivate::readUnsigned32()
+{
+  uint64_t n = readUnsigned();
+  if (n > std::numeric_limits<unsigned>::max())
+  {
+    malformed("integer too large");
+  }
+  return static_cast<unsigned>(n);
+}
+
+std::string BinaryFormatReaderPrivate::readString()
+{
+  uint64_t size = readUnsigned();
+  std::string s;
+  // do not trust the size to allocate
+  for (uint64_t i = 0; i < size; i++)
+  {
+    int c = readByte();
+    if (c == EOF)
+    {
+      malformed("unexpected end of input");
+    }
+    s.push_back(static_cast<char>(c));
+  }
+  return s;
+}
+
+Kind BinaryFormatReaderPrivate::readKind()
+{
+  uint64_t id = readUnsigned();
+  if (id >= d_kinds.size())
+  {
+    malformed("undefined kind");
+  }
+  return d_kinds[id];
+}
+
+TypeNode BinaryFormatReaderPrivate::readTypeId()
+{
+  uint64_t id = readUnsigned();
+  if (id >= d_types.size() || d_types[id].isNull())
+  {
+    malformed("undefined type");
+  }
+  return d_types[id];
+}
+
+Node BinaryFormatReaderPrivate::readTermId()
+{
+  uint64_t id = readUnsigned();
+  if (id >= d_terms.size() || d_terms[id].isNull())
+  {
+    malformed("undefined term");
+  }
+  return d_terms[id];
+}
+
+Node BinaryFormatReaderPrivate::readFormulaId(const char* what)
+{
+  Node n = readTermId();
+  try
+  {
+    if (!n.getType(true).isBoolean())
+    {
+      malformed(std::string(what) + " is not a formula");
+    }
+  }
+  catch (TypeCheckingExceptionPrivate& e)
+  {
+    std::stringstream ss;
+    ss << "ill-typed " << what << ": " << e.getMessage();
+    malformed(ss.str());
+  }
+  return n;
+}
+
+std::vector<Expr> BinaryFormatReaderPrivate::readTermIds()
+{
+  uint64_t size = readUnsigned();
+  std::vector<Expr> terms;
+  // do not trust the size to allocate
+  for (uint64_t i = 0; i < size; i++)
+  {
+    terms.push_back(readTermId().toExpr());
+  }
+  return terms;
+}
+
+void BinaryFormatReaderPrivate::readKindRecord()
+{
+  // initialized once, readers may run in several threads
+  static const std::unordered_map<std::string, Kind> s_kindNames = []() {
+    std::unordered_map<std::string, Kind> names;
+    for (int k = 0; k < LAST_KIND; k++)
+    {
+      names[kind::kindToString(Kind(k))] = Kind(k);
+    }
+    return names;
+  }();
+  std::string name = readString();
+  std::unordered_map<std::string, Kind>::const_iterator it =
+      s_kindNames.find(name);
+  if (it == s_kindNames.end())
+  {
+    malformed("unknown kind " + name);
+  }
+  d_kinds.push_back(it->second);
+}
+
+Command* BinaryFormatReaderPrivate::readTypeRecord()
+{
+  Kind k = readKind();
+  TypeNode tn;
+  Command* cmd = NULL;
+  switch (k)
+  {
+    case TYPE_CONSTANT:
+    {
+      uint64_t code = readUnsigned();
+      if (code >= s_numTypeConstants)
+      {
+        malformed("unknown type constant");
+      }
+      tn = d_nm->mkTypeConst(s_typeConstants[code]);
+      break;
+    }
+    case BITVECTOR_TYPE:
+    {
+      unsigned size = readUnsigned32();
+      if (size == 0)
+      {
+        malformed("bit-vector type of size 0");
+      }
+      tn = d_nm->mkBitVectorType(size);
+      break;
+    }
+    case FLOATINGPOINT_TYPE:
+    {
+      unsigned e = readUnsigned32();
+      unsigned s = readUnsigned32();
+      if (!validExponentSize(e) || !validSignificandSize(s))
+      {
+        malformed("invalid floating-point type");
+      }
+      tn = d_nm->mkFloatingPointType(e, s);
+      break;
+    }
+    case SORT_TYPE:
+    {
+      std::string name = readString();
+      tn = d_nm->mkSort(name);
+      cmd = new DeclareTypeCommand(name, 0, tn.toType());
+      break;
+    }
+    default:
+    {
+      if (kind::metaKindOf(k) != metakind::OPERATOR)
+      {
+        malformed("unexpected type kind " + kind::kindToString(k));
+      }
+      std::vector<TypeNode> children;
+      uint64_t n = readUnsigned();
+      for (uint64_t i = 0; i < n; i++)
+      {
+        children.push_back(readTypeId());
+      }
+      tn = d_nm->mkTypeNode(k, children);
+      break;
+    }
+  }
+  d_types.push_back(tn);
+  d_terms.push_back(Node::null());
+  return cmd;
+}
+
+Command* BinaryFormatReaderPrivate::readTermRecord()
+{
+  Kind k = readKind();
+  Node n;
+  Command* cmd = NULL;
+  switch (kind::metaKindOf(k))
+  {
+    case metakind::VARIABLE:
+    {
+      std::string name = readString();
+      TypeNode tn = readTypeId();
+      if (k == VARIABLE)
+      {
+        // user variables are made by the expression manager, which notifies
+        // its listeners (e.g. for dumping)
+        Type t = tn.toType();
+        n = Node::fromExpr(name.empty() ? d_em->mkVar(t) : d_em->mkVar(name, t));
+        cmd = new DeclareFunctionCommand(
+            name.empty() ? n.toString() : name, n.toExpr(), tn.toType());
+      }
+      else if (k == BOUND_VARIABLE)
+      {
+        n = name.empty() ? d_nm->mkBoundVar(tn) : d_nm->mkBoundVar(name, tn);
+      }
+      else
+      {
+        malformed("unexpected variable kind " + kind::kindToString(k));
+      }
+      break;
+    }
+    case metakind::NULLARY_OPERATOR:
+      n = d_nm->mkNullaryOperator(readTypeId(), k);
+      break;
+    case metakind::CONSTANT: n = readConstant(k); break;
+    case metakind::PARAMETERIZED:
+    case metakind::OPERATOR:
+    {
+      uint64_t nchildren = readUnsigned();
+      if (kind::metaKindOf(k) == metakind::PARAMETERIZED && nchildren == 0)
+      {
+        malformed("missing operator of " + kind::kindToString(k));
+      }
+      NodeBuilder<> nb(k);
+      for (uint64_t i = 0; i < nchildren; i++)
+      {
+        nb << readTermId();
+      }
+      if (nb.getNumChildren() < metakind::getLowerBoundForKind(k)
+          || nb.getNumChildren() > metakind::getUpperBoundForKind(k))
+      {
+        malformed("wrong number of children of " + kind::kindToString(k));
+      }
+      n = nb.constructNode();
+      break;
+    }
+    default: malformed("unexpected term kind " + kind::kindToString(k)); break;
+  }
+  d_types.push_back(TypeNode::null());
+  d_terms.push_back(n);
+  return cmd;
+}
+
+Node BinaryFormatReaderPrivate::readConstant(Kind k)
+{
+  switch (k)
+  {
+    case CONST_BOOLEAN: return d_nm->mkConst(readUnsigned() != 0);
+    case CONST_RATIONAL:
+    {
+      std::string s = readString();
+      try
+      {
+        size_t slash = s.find('/');
+        if (slash != std::string::npos && Integer(s.substr(slash + 1)).isZero())
+        {
+          malformed("rational with zero denominator");
+        }
+        return d_nm->mkConst(Rational(s));
+      }
+      catch (std::invalid_argument&)
+      {
+        malformed("invalid rational " + s);
+      }
+      break;
+    }
+    case CONST_BITVECTOR:
+    {
+      unsigned size = readUnsigned32();
+      std::string s = readString();
+      try
+      {
+        return d_nm->mkConst(BitVector(size, Integer(s, 16)));
+      }
+      catch (std::invalid_argument&)
+      {
+        malformed("invalid bit-vector value " + s);
+      }
+      break;
+    }
+    case CONST_STRING:
+    {
+      std::vector<unsigned> vec;
+      uint64_t size = readUnsigned();
+      for (uint64_t i = 0; i < size; i++)
+      {
+        unsigned c = readUnsigned32();
+        if (c >= String::num_codes())
+        {
+          malformed("invalid character in string");
+        }
+        vec.push_back(c);
+      }
+      return d_nm->mkConst(String(vec));
+    }
+    case CONST_ROUNDINGMODE:
+    {
+      uint64_t code = readUnsigned();
+      if (code >= s_numRoundingModes)
+      {
+        malformed("unknown rounding mode");
+      }
+      return d_nm->mkConst(s_roundingModes[code]);
+    }
+    case CONST_FLOATINGPOINT:
+    {
+      unsigned e = readUnsigned32();
+      unsigned s = readUnsigned32();
+      std::string v = readString();
+      if (!validExponentSize(e) || !validSignificandSize(s))
+      {
+        malformed("invalid floating-point type");
+      }
+      try
+      {
+        return d_nm->mkConst(
+            FloatingPoint(e, s, BitVector(e + s, Integer(v, 16))));
+      }
+      catch (std::invalid_argument&)
+      {
+        malformed("invalid floating-point value " + v);
+      }
+      break;
+    }
+    case BITVECTOR_EXTRACT_OP:
+    {
+      unsigned high = readUnsigned32();
+      unsigned low = readUnsigned32();
+      return d_nm->mkConst(BitVectorExtract(high, low));
+    }
+    case BITVECTOR_REPEAT_OP:
+      return d_nm->mkConst(BitVectorRepeat(readUnsigned32()));
+    case BITVECTOR_ZERO_EXTEND_OP:
+      return d_nm->mkConst(BitVectorZeroExtend(readUnsigned32()));
+    case BITVECTOR_SIGN_EXTEND_OP:
+      return d_nm->mkConst(BitVectorSignExtend(readUnsigned32()));
+    case BITVECTOR_ROTATE_LEFT_OP:
+      return d_nm->mkConst(BitVectorRotateLeft(readUnsigned32()));
+    case BITVECTOR_ROTATE_RIGHT_OP:
+      return d_nm->mkConst(BitVectorRotateRight(readUnsigned32()));
+    case INT_TO_BITVECTOR_OP:
+      return d_nm->mkConst(IntToBitVector(readUnsigned32()));
+    case DIVISIBLE_OP:
+    {
+      std::string s = readString();
+      try
+      {
+        return d_nm->mkConst(Divisible(Integer(s)));
+      }
+      catch (std::exception&)
+      {
+        malformed("invalid divisor " + s);
+      }
+      break;
+    }
+    case FLOATINGPOINT_TO_FP_IEEE_BITVECTOR_OP:
+    case FLOATINGPOINT_TO_FP_FLOATINGPOINT_OP:
+    case FLOATINGPOINT_TO_FP_REAL_OP:
+    case FLOATINGPOINT_TO_FP_SIGNED_BITVECTOR_OP:
+    case FLOATINGPOINT_TO_FP_UNSIGNED_BITVECTOR_OP:
+    case FLOATINGPOINT_TO_FP_GENERIC_OP:
+    {
+      unsigned e = readUnsigned32();
+      unsigned s = readUnsigned32();
+      if (!validExponentSize(e) || !validSignificandSize(s))
+      {
+        malformed("invalid floating-point type");
+      }
+      switch (k)
+      {
+        case FLOATINGPOINT_TO_FP_IEEE_BITVECTOR_OP:
+          return d_nm->mkConst(FloatingPointToFPIEEEBitVector(e, s));
+        case FLOATINGPOINT_TO_FP_FLOATINGPOINT_OP:
+          return d_nm->mkConst(FloatingPointToFPFloatingPoint(e, s));
+        case FLOATINGPOINT_TO_FP_REAL_OP:
+          return d_nm->mkConst(FloatingPointToFPReal(e, s));
+        case FLOATINGPOINT_TO_FP_SIGNED_BITVECTOR_OP:
+          return d_nm->mkConst(FloatingPointToFPSignedBitVector(e, s));
+        case FLOATINGPOINT_TO_FP_UNSIGNED_BITVECTOR_OP:
+          return d_nm->mkConst(FloatingPointToFPUnsignedBitVector(e, s));
+        default: return d_nm->mkConst(FloatingPointToFPGeneric(e, s));
+      }
+    }
+    case FLOATINGPOINT_TO_UBV_OP:
+      return d_nm->mkConst(FloatingPointToUBV(readUnsigned32()));
+    case FLOATINGPOINT_TO_SBV_OP:
+      return d_nm->mkConst(FloatingPointToSBV(readUnsigned32()));
+    case FLOATINGPOINT_TO_UBV_TOTAL_OP:
+      return d_nm->mkConst(FloatingPointToUBVTotal(readUnsigned32()));
+    case FLOATINGPOINT_TO_SBV_TOTAL_OP:
+      return d_nm->mkConst(FloatingPointToSBVTotal(readUnsigned32()));
+    default:
+      malformed("unexpected constant kind " + kind::kindToString(k));
+      break;
+  }
+  return Node::null();
+}
+
+BinaryFormatReader::BinaryFormatReader(ExprManager* em, std::istream& in)
+    : d_private(new BinaryFormatReaderPrivate(em, in))
+{
+  char magic[s_magicLength];
+  for (size_t i = 0; i < s_magicLength; i++)
+  {
+    int c = d_private->readByte();
+    magic[i] = static_cast<char>(c);
+    if (c == EOF || magic[i] != s_magic[i])
+    {
+      throw Exception("Input is not in the binary format");
+    }
+  }
+  // the records of earlier versions are a subset of those of this version
+  uint64_t version = d_private->readUnsigned();
+  if (version == 0 || version > BINARY_FORMAT_VERSION)
+  {
+    throw Exception("Unsupported version of the binary format");
+  }
+}
+
+BinaryFormatReader::~BinaryFormatReader() {}
+
+Command* BinaryFormatReader::nextCommand()
+{
+  NodeManagerScope nms(d_private->d_nm);
+  for (;;)
+  {
+    int tag = d_private->readByte();
+    Command* cmd = NULL;
+    switch (tag)
+    {
+      case EOF: return NULL;
+      case TAG_KIND: d_private->readKindRecord(); break;
+      case TAG_TYPE: cmd = d_private->readTypeRecord(); break;
+      case TAG_TERM: cmd = d_private->readTermRecord(); break;
+      case TAG_LOGIC:
+        return new SetBenchmarkLogicCommand(d_private->readString());
+      case TAG_ASSERT:
+        return new AssertCommand(
+            d_private->readFormulaId("assertion").toExpr());
+      case TAG_CHECK_SAT: return new CheckSatCommand();
+      case TAG_SET_OPTION:
+      {
+        std::string name = d_private->readString();
+        std::string value = d_private->readString();
+        return new SetOptionCommand(name, SExpr(value));
+      }
+      case TAG_PUSH: return new PushCommand();
+      case TAG_POP: return new PopCommand();
+      case TAG_RESET_ASSERTIONS: return new ResetAssertionsCommand();
+      case TAG_CHECK_SAT_ASSUMING:
+      {
+        uint64_t size = d_private->readUnsigned();
+        std::vector<Expr> assumptions;
+        for (uint64_t i = 0; i < size; i++)
+        {
+          assumptions.push_back(
+              d_private->readFormulaId("assumption").toExpr());
+        }
+        return new CheckSatAssumingCommand(assumptions);
+      }
+      case TAG_GET_VALUE:
+      {
+        std::vector<Expr> terms = d_private->readTermIds();
+        if (terms.empty())
+        {
+          d_private->malformed("get-value without terms");
+        }
+        return new GetValueCommand(terms);
+      }
+      default: d_private->malformed("unknown record"); break;
+    }
+    if (cmd != NULL)
+    {
+      return cmd;
+    }
+  }
+}
+
+}  // namespace CVC4
@@ -0,0 +1,124 @@
+/*********************                                                        */
+/*! \file binary_format.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A compact binary format for assertion sets
+ **
+ ** A compact binary format for assertion sets, which can be written and read
+ ** in time linear in the size of the DAG of the assertions.
+ **/
+
+#include "cvc4_public.h"
+
+#ifndef CVC4__SMT__BINARY_FORMAT_H
+#define CVC4__SMT__BINARY_FORMAT_H
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "expr/expr.h"
+#include "expr/expr_manager.h"
+
+namespace CVC4 {
+
+class Command;
+
+/**
+ * The version of the binary format written by BinaryFormatWriter. Readers
+ * reject inputs of later versions.
+ *
+ * An input in the binary format consists of a header (the magic string
+ * "CVC4BIN" followed by a zero byte and the version) and a sequence of
+ * records. Integers are written as unsigned LEB128 numbers and strings as
+ * their length followed by their bytes. Each record starts with a tag:
+ * - a kind record gives the name of the next kind identifier,
+ * - a type or term record defines the next node identifier, by the
+ *   identifier of its kind and its payload (the identifiers of its children,
+ *   the name and type of a variable, the value of a constant, etc.),
+ * - a logic, assert, check-sat, set-option, push, pop, reset-assertions,
+ *   check-sat-assuming or get-value record corresponds to the SMT-LIB
+ *   command (push and pop records are for one level).
+ * Kinds are identified by name, so that inputs do not depend on the
+ * numbering of kinds of a particular build. Each node is written once, so
+ * that the sharing of the assertions is preserved.
+ *
+ * Version 2 added the records after check-sat, for traces of API calls (see
+ * api::Solver::startTrace). Inputs of version 1 are still read.
+ */
+const unsigned BINARY_FORMAT_VERSION = 2;
+
+class BinaryFormatWriterPrivate;
+class BinaryFormatReaderPrivate;
+
+/**
+ * Writes assertions in the binary format. Datatypes, parametric sorts and
+ * constants of theories other than the core, arithmetic, bit-vector,
+ * floating-point and string theories are not supported, for these an
+ * exception is thrown.
+ */
+class CVC4_PUBLIC BinaryFormatWriter
+{
+ public:
+  /** Create a writer to out, and write the header of the format */
+  BinaryFormatWriter(std::ostream& out);
+  ~BinaryFormatWriter();
+  /** Write a logic record */
+  void writeLogic(const std::string& logic);
+  /** Write an assert record for the formula e, and the nodes it contains */
+  void writeAssertion(Expr e);
+  /** Write a check-sat record */
+  void writeCheckSat();
+  /** Write a set-option record */
+  void writeSetOption(const std::string& name, const std::string& value);
+  /** Write a push record for one level */
+  void writePush();
+  /** Write a pop record for one level */
+  void writePop();
+  /** Write a reset-assertions record */
+  void writeResetAssertions();
+  /** Write a check-sat-assuming record, and the nodes it contains */
+  void writeCheckSatAssuming(const std::vector<Expr>& assumptions);
+  /** Write a get-value record, and the nodes it contains */
+  void writeGetValue(const std::vector<Expr>& terms);
+
+ private:
+  /** Write a record with the given tag for the list terms */
+  void writeTermList(unsigned tag, const std::vector<Expr>& terms);
+  std::unique_ptr<BinaryFormatWriterPrivate> d_private;
+}; /* class BinaryFormatWriter */
+
+/**
+ * Reads an input in the binary format as a sequence of commands. The
+ * variables and sorts of the input are returned as declarations, when they
+ * are first read.
+ */
+class CVC4_PUBLIC BinaryFormatReader
+{
+ public:
+  /**
+   * Create a reader from in, whose nodes are created by em. Throws an
+   * exception if in does not start with the header of the format.
+   */
+  BinaryFormatReader(ExprManager* em, std::istream& in);
+  ~BinaryFormatReader();
+  /**
+   * Read the next command of the input, which is owned by the caller.
+   * Returns NULL at the end of the input. Throws an exception if the input is
+   * malformed or ill-typed.
+   */
+  Command* nextCommand();
+
+ private:
+  std::unique_ptr<BinaryFormatReaderPrivate> d_private;
+}; /* class BinaryFormatReader */
+
+}  // namespace CVC4
+
+#endif /* CVC4__SMT__BINARY_FORMAT_H */
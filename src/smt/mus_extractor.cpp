@@ -0,0 +1,338 @@
+/*********************                                                        */
+/*! \file mus_extractor.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Extraction and enumeration of minimal unsatisfiable subsets
+ **/
+
+#include "smt/mus_extractor.h"
+
+#include <algorithm>
+#include <thread>
+#include <unordered_set>
+
+#include "base/output.h"
+#include "expr/node_manager.h"
+#include "expr/variable_type_map.h"
+#include "options/smt_options.h"
+
+namespace CVC4 {
+namespace smt {
+
+namespace {
+
+/** A subsolver checking a subset of the assertions */
+struct Subsolver
+{
+  /** The expression manager of the subsolver */
+  std::unique_ptr<ExprManager> d_em;
+  /** The map of the symbols exported to d_em */
+  ExprManagerMapCollection d_vmap;
+  /** The subsolver */
+  std::unique_ptr<SmtEngine> d_smt;
+  /** Maps the exported assertions of the subset to their index */
+  std::unordered_map<Expr, size_t, ExprHashFunction> d_subset;
+  /** The exported assertions outside the subset, with their index */
+  std::vector<std::pair<Expr, size_t>> d_others;
+};
+
+}  // namespace
+
+MusExtractor::MusExtractor(const LogicInfo& logic,
+                           const std::vector<Expr>& assertions,
+                           const std::vector<Expr>& expanded)
+    : d_logic(logic), d_assertions(assertions), d_expanded(expanded)
+{
+  Assert(assertions.size() == expanded.size());
+  for (size_t i = 0, size = d_assertions.size(); i < size; ++i)
+  {
+    d_indices[d_assertions[i]] = i;
+  }
+}
+
+MusExtractor::~MusExtractor()
+{
+  // the selectors must be destroyed before their expression manager
+  d_selectors.clear();
+  d_mapSolver.reset();
+  d_mapEm.reset();
+}
+
+std::vector<Expr> MusExtractor::getAssertions(
+    const std::vector<size_t>& indices) const
+{
+  std::vector<Expr> res;
+  for (size_t i : indices)
+  {
+    res.push_back(d_assertions[i]);
+  }
+  return res;
+}
+
+void MusExtractor::checkSubsets(
+    const std::vector<std::vector<size_t>>& subsets,
+    bool grow,
+    std::vector<CheckResult>& results)
+{
+  results.clear();
+  results.resize(subsets.size());
+
+  // Make the subsolvers. Exporting the assertions must be done on this
+  // thread, since it accesses the node manager of the main solver.
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<std::unique_ptr<Subsolver>> subsolvers(subsets.size());
+  try
+  {
+    for (size_t s = 0, nsubsets = subsets.size(); s < nsubsets; ++s)
+    {
+      subsolvers[s].reset(new Subsolver);
+      Subsolver& sub = *subsolvers[s];
+      sub.d_em.reset(new ExprManager(nm->getOptions()));
+      sub.d_smt.reset(new SmtEngine(sub.d_em.get()));
+      SmtEngine& smt = *sub.d_smt;
+      smt.setIsInternalSubsolver();
+      smt.setOption("produce-unsat-cores", SExpr("false"));
+      smt.setOption("check-unsat-cores", SExpr("false"));
+      smt.setOption("unsat-cores-assumptions", SExpr("true"));
+      smt.setOption("minimize-unsat-cores", SExpr("false"));
+      smt.setOption("produce-models", SExpr(grow ? "true" : "false"));
+      smt.setLogic(d_logic);
+      std::vector<bool> inSubset(d_expanded.size(), false);
+      for (size_t i : subsets[s])
+      {
+        Expr e = d_expanded[i].exportTo(sub.d_em.get(), sub.d_vmap);
+        sub.d_subset[e] = i;
+        smt.assertFormula(e);
+        inSubset[i] = true;
+      }
+      if (grow)
+      {
+        for (size_t i = 0, size = d_expanded.size(); i < size; ++i)
+        {
+          if (!inSubset[i])
+          {
+            sub.d_others.emplace_back(
+                d_expanded[i].exportTo(sub.d_em.get(), sub.d_vmap), i);
+          }
+        }
+      }
+    }
+  }
+  catch (const ExportUnsupportedException& e)
+  {
+    Trace("mus") << "...cannot export: " << e << std::endl;
+    return;
+  }
+
+  auto run = [&](size_t s) {
+    Subsolver& sub = *subsolvers[s];
+    CheckResult& cr = results[s];
+    try
+    {
+      cr.d_result = sub.d_smt->checkSat().asSatisfiabilityResult();
+      if (cr.d_result.isSat() == Result::UNSAT)
+      {
+        UnsatCore core = sub.d_smt->getUnsatCore();
+        for (const Expr& e : core)
+        {
+          cr.d_core.push_back(sub.d_subset[e]);
+        }
+        std::sort(cr.d_core.begin(), cr.d_core.end());
+      }
+      else if (cr.d_result.isSat() == Result::SAT && grow)
+      {
+        cr.d_grown = subsets[s];
+        for (const std::pair<Expr, size_t>& p : sub.d_others)
+        {
+          Expr v = sub.d_smt->getValue(p.first);
+          if (v.isConst() && v.getConst<bool>())
+          {
+            cr.d_grown.push_back(p.second);
+          }
+        }
+        std::sort(cr.d_grown.begin(), cr.d_grown.end());
+      }
+    }
+    catch (const Exception& e)
+    {
+      Trace("mus") << "...check " << s << " failed: " << e << std::endl;
+      cr = CheckResult();
+    }
+  };
+  if (subsolvers.size() == 1)
+  {
+    run(0);
+    return;
+  }
+  std::vector<std::thread> threads;
+  for (size_t s = 0, nsubsets = subsolvers.size(); s < nsubsets; ++s)
+  {
+    threads.emplace_back(run, s);
+  }
+  for (std::thread& t : threads)
+  {
+    t.join();
+  }
+}
+
+std::vector<size_t> MusExtractor::shrinkIndices(std::vector<size_t> core)
+{
+  size_t numThreads = std::max<size_t>(options::musThreads(), 1);
+  // Assertions that are critical for the current core are critical for all
+  // of its unsatisfiable subsets, since removing them from a subset leaves a
+  // subset of a satisfiable set.
+  std::unordered_set<size_t> critical;
+  while (true)
+  {
+    std::vector<size_t> candidates;
+    for (size_t i : core)
+    {
+      if (critical.find(i) == critical.end())
+      {
+        candidates.push_back(i);
+        if (candidates.size() == numThreads)
+        {
+          break;
+        }
+      }
+    }
+    if (candidates.empty())
+    {
+      break;
+    }
+    std::vector<std::vector<size_t>> subsets;
+    for (size_t c : candidates)
+    {
+      subsets.emplace_back();
+      for (size_t i : core)
+      {
+        if (i != c)
+        {
+          subsets.back().push_back(i);
+        }
+      }
+    }
+    std::vector<CheckResult> results;
+    checkSubsets(subsets, false, results);
+    const std::vector<size_t>* next = nullptr;
+    for (size_t s = 0, nsubsets = subsets.size(); s < nsubsets; ++s)
+    {
+      Trace("mus") << "...without " << candidates[s] << ": "
+                   << results[s].d_result << std::endl;
+      if (results[s].d_result.isSat() != Result::UNSAT)
+      {
+        // the assertion is critical (or we do not know that it is not)
+        critical.insert(candidates[s]);
+      }
+      else if (next == nullptr || results[s].d_core.size() < next->size())
+      {
+        next = &results[s].d_core;
+      }
+    }
+    if (next != nullptr)
+    {
+      core = *next;
+    }
+  }
+  return core;
+}
+
+std::vector<Expr> MusExtractor::shrink(const std::vector<Expr>& core)
+{
+  std::vector<size_t> indices;
+  for (const Expr& e : core)
+  {
+    Assert(d_indices.find(e) != d_indices.end());
+    indices.push_back(d_indices[e]);
+  }
+  std::sort(indices.begin(), indices.end());
+  std::vector<size_t> mus = shrinkIndices(indices);
+  Trace("mus") << "MusExtractor::shrink: " << core.size() << " -> "
+               << mus.size() << std::endl;
+  return getAssertions(mus);
+}
+
+bool MusExtractor::getNextMus(std::vector<Expr>& mus)
+{
+  if (d_mapSolver == nullptr)
+  {
+    d_mapEm.reset(new ExprManager);
+    d_mapSolver.reset(new SmtEngine(d_mapEm.get()));
+    d_mapSolver->setIsInternalSubsolver();
+    d_mapSolver->setOption("incremental", SExpr("true"));
+    d_mapSolver->setOption("produce-models", SExpr("true"));
+    d_mapSolver->setLogic("QF_SAT");
+    for (size_t i = 0, size = d_assertions.size(); i < size; ++i)
+    {
+      d_selectors.push_back(d_mapEm->mkVar(d_mapEm->booleanType()));
+    }
+  }
+  while (true)
+  {
+    Result r = d_mapSolver->checkSat().asSatisfiabilityResult();
+    if (r.isSat() != Result::SAT)
+    {
+      // all subsets are explored
+      return false;
+    }
+    std::vector<size_t> seed;
+    for (size_t i = 0, size = d_selectors.size(); i < size; ++i)
+    {
+      if (d_mapSolver->getValue(d_selectors[i]).getConst<bool>())
+      {
+        seed.push_back(i);
+      }
+    }
+    std::vector<CheckResult> results;
+    checkSubsets({seed}, true, results);
+    const CheckResult& cr = results[0];
+    Trace("mus") << "MusExtractor::getNextMus: seed of size " << seed.size()
+                 << ": " << cr.d_result << std::endl;
+    std::vector<Expr> lits;
+    if (cr.d_result.isSat() == Result::UNSAT)
+    {
+      // block the supersets of the MUS
+      std::vector<size_t> m = shrinkIndices(cr.d_core);
+      for (size_t i : m)
+      {
+        lits.push_back(d_selectors[i].notExpr());
+      }
+      d_mapSolver->assertFormula(lits.empty()
+                                     ? d_mapEm->mkConst(false)
+                                     : lits.size() == 1
+                                           ? lits[0]
+                                           : d_mapEm->mkExpr(kind::OR, lits));
+      mus = getAssertions(m);
+      return true;
+    }
+    // Block the subsets of the seed, grown by its model. If the check is
+    // unknown, we block the subsets of the seed only, which may miss MUSes.
+    const std::vector<size_t>& grown =
+        cr.d_result.isSat() == Result::SAT ? cr.d_grown : seed;
+    std::vector<bool> inGrown(d_selectors.size(), false);
+    for (size_t i : grown)
+    {
+      inGrown[i] = true;
+    }
+    for (size_t i = 0, size = d_selectors.size(); i < size; ++i)
+    {
+      if (!inGrown[i])
+      {
+        lits.push_back(d_selectors[i]);
+      }
+    }
+    d_mapSolver->assertFormula(lits.empty()
+                                   ? d_mapEm->mkConst(false)
+                                   : lits.size() == 1
+                                         ? lits[0]
+                                         : d_mapEm->mkExpr(kind::OR, lits));
+  }
+}
+
+}  // namespace smt
+}  // namespace CVC4
@@ -0,0 +1,120 @@
+/*********************                                                        */
+/*! \file mus_extractor.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Extraction and enumeration of minimal unsatisfiable subsets
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__SMT__MUS_EXTRACTOR_H
+#define CVC4__SMT__MUS_EXTRACTOR_H
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "expr/expr.h"
+#include "expr/expr_manager.h"
+#include "smt/smt_engine.h"
+#include "theory/logic_info.h"
+#include "util/result.h"
+
+namespace CVC4 {
+namespace smt {
+
+/**
+ * Extracts minimal unsatisfiable subsets (MUSes) of a fixed set of
+ * assertions, and enumerates them.
+ *
+ * Subsets of the assertions are checked by fresh subsolvers, each with its
+ * own expression manager, that use assumption-based unsat cores. Up to
+ * options::musThreads() subsets are checked in parallel. The subsolvers are
+ * created and the assertions exported on the calling thread, only the checks
+ * run on other threads.
+ */
+class MusExtractor
+{
+ public:
+  /**
+   * Create an extractor for the given assertions, whose definitions are
+   * expanded in expanded, which are checked in the given logic.
+   */
+  MusExtractor(const LogicInfo& logic,
+               const std::vector<Expr>& assertions,
+               const std::vector<Expr>& expanded);
+  ~MusExtractor();
+
+  /**
+   * Shrink core, an unsatisfiable subset of the assertions, to a MUS. The core
+   * is shrunk by deletion: if the core without one of its assertions is still
+   * unsatisfiable, the unsat core of that check replaces the core (clause-set
+   * refinement), otherwise the assertion is critical. Assertions for which a
+   * check is unknown are kept, hence the result is minimal only if all checks
+   * succeed.
+   */
+  std::vector<Expr> shrink(const std::vector<Expr>& core);
+
+  /**
+   * Compute a MUS of the assertions that was not returned by a previous call.
+   * Returns false if there is no such MUS. The subsets of the assertions are
+   * explored using a map solver over one selector per assertion. Satisfiable
+   * subsets are grown by the assertions that hold in their model, before
+   * their subsets are blocked. Unsatisfiable subsets are shrunk to a MUS,
+   * whose supersets are blocked.
+   */
+  bool getNextMus(std::vector<Expr>& mus);
+
+ private:
+  /** The result of checking a subset of the assertions */
+  struct CheckResult
+  {
+    CheckResult() : d_result(Result::SAT_UNKNOWN, Result::UNKNOWN_REASON) {}
+    /** The satisfiability of the subset */
+    Result d_result;
+    /** If unsat, the indices of an unsat core of the subset */
+    std::vector<size_t> d_core;
+    /**
+     * If sat and the check was asked to grow, the indices of the assertions
+     * that hold in the model of the subset, including the subset itself
+     */
+    std::vector<size_t> d_grown;
+  };
+  /**
+   * Check the given subsets of the assertions (given by indices), in parallel
+   * if there are several. If grow is true, the satisfiable subsets are grown
+   * by the assertions that hold in their model.
+   */
+  void checkSubsets(const std::vector<std::vector<size_t>>& subsets,
+                    bool grow,
+                    std::vector<CheckResult>& results);
+  /** Shrink the unsatisfiable subset core (given by indices) to a MUS */
+  std::vector<size_t> shrinkIndices(std::vector<size_t> core);
+  /** Get the assertions of the given indices */
+  std::vector<Expr> getAssertions(const std::vector<size_t>& indices) const;
+
+  /** The logic of the subsolvers */
+  LogicInfo d_logic;
+  /** The assertions */
+  std::vector<Expr> d_assertions;
+  /** The assertions whose definitions are expanded, which are checked */
+  std::vector<Expr> d_expanded;
+  /** Maps the assertions to their index */
+  std::unordered_map<Expr, size_t, ExprHashFunction> d_indices;
+  /** The expression manager of the map solver */
+  std::unique_ptr<ExprManager> d_mapEm;
+  /** The map solver, whose models are the unexplored subsets */
+  std::unique_ptr<SmtEngine> d_mapSolver;
+  /** The selector of each assertion in the map solver */
+  std::vector<Expr> d_selectors;
+}; /* class MusExtractor */
+
+}  // namespace smt
+}  // namespace CVC4
+
+#endif /* CVC4__SMT__MUS_EXTRACTOR_H */
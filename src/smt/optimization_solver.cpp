@@ -0,0 +1,418 @@
+/*********************                                                        */
+/*! \file optimization_solver.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Optimization of objectives and soft assertions
+ **/
+
+#include "smt/optimization_solver.h"
+
+#include <limits>
+#include <unordered_map>
+
+#include "base/check.h"
+#include "base/output.h"
+#include "expr/expr_manager.h"
+#include "options/smt_options.h"
+#include "util/bitvector.h"
+
+namespace CVC4 {
+namespace smt {
+
+OptimizationSolver::OptimizationSolver(SmtEngine* smt)
+    : d_smt(smt),
+      d_softIndex(std::numeric_limits<size_t>::max()),
+      d_numChecks(0)
+{
+}
+
+OptimizationSolver::~OptimizationSolver() {}
+
+size_t OptimizationSolver::addObjective(const Expr& term,
+                                        bool minimize,
+                                        size_t level)
+{
+  d_objectives.emplace_back();
+  Objective& o = d_objectives.back();
+  o.d_term = term;
+  o.d_minimize = minimize;
+  o.d_level = level;
+  return d_objectives.size() - 1;
+}
+
+size_t OptimizationSolver::addSoftAssertion(const Expr& formula,
+                                            const Integer& weight,
+                                            size_t level)
+{
+  Assert(weight.sgn() > 0);
+  if (d_softIndex == std::numeric_limits<size_t>::max())
+  {
+    d_softIndex = d_objectives.size();
+    d_objectives.emplace_back();
+    Objective& o = d_objectives.back();
+    o.d_minimize = true;
+    o.d_level = level;
+  }
+  Objective& o = d_objectives[d_softIndex];
+  o.d_soft.push_back(formula);
+  o.d_weights.push_back(weight);
+  o.d_softLevels.push_back(level);
+  return d_softIndex;
+}
+
+void OptimizationSolver::pop(size_t level)
+{
+  // the objectives are added in order of non-decreasing level
+  while (!d_objectives.empty() && d_objectives.back().d_level > level)
+  {
+    d_objectives.pop_back();
+  }
+  if (d_softIndex >= d_objectives.size())
+  {
+    d_softIndex = std::numeric_limits<size_t>::max();
+    return;
+  }
+  Objective& o = d_objectives[d_softIndex];
+  while (!o.d_softLevels.empty() && o.d_softLevels.back() > level)
+  {
+    o.d_soft.pop_back();
+    o.d_weights.pop_back();
+    o.d_softLevels.pop_back();
+  }
+}
+
+Expr OptimizationSolver::getObjectiveValue(size_t i) const
+{
+  Assert(i < d_objectives.size());
+  return d_objectives[i].d_value;
+}
+
+Result OptimizationSolver::check(const std::vector<Expr>& extra)
+{
+  if (d_numChecks >= options::optMaxChecks())
+  {
+    return Result(Result::SAT_UNKNOWN, Result::INCOMPLETE);
+  }
+  d_numChecks++;
+  std::vector<Expr> assumptions(d_fixed);
+  assumptions.insert(assumptions.end(), extra.begin(), extra.end());
+  return d_smt->checkSat(assumptions).asSatisfiabilityResult();
+}
+
+Result OptimizationSolver::checkOpt()
+{
+  d_numChecks = 0;
+  d_fixed.clear();
+  for (Objective& o : d_objectives)
+  {
+    o.d_value = Expr();
+  }
+  bool optimal = true;
+  for (size_t i = 0, nobjs = d_objectives.size(); i <= nobjs; ++i)
+  {
+    // The model of the last check of the previous objective may be gone, so
+    // we check again under the bounds of the previous objectives. These
+    // checks are not counted, since they are satisfiable, and the last one
+    // provides the model of the optimum.
+    Result r = d_smt->checkSat(d_fixed).asSatisfiabilityResult();
+    if (r.isSat() != Result::SAT || i == nobjs)
+    {
+      Trace("opt") << "OptimizationSolver::checkOpt: " << r << " after "
+                   << d_numChecks << " checks" << std::endl;
+      if (r.isSat() == Result::SAT && !optimal)
+      {
+        return Result(Result::SAT_UNKNOWN, Result::INCOMPLETE);
+      }
+      return r;
+    }
+    Objective& o = d_objectives[i];
+    bool oOptimal;
+    if (o.d_term.isNull())
+    {
+      oOptimal = optimizeSoft(o);
+    }
+    else
+    {
+      Expr value = d_smt->getValue(o.d_term);
+      if (!value.isConst())
+      {
+        // the model value is not a constant (e.g. an algebraic number)
+        oOptimal = false;
+      }
+      else if (o.d_term.getType().isBitVector())
+      {
+        oOptimal = optimizeBv(o, value);
+      }
+      else
+      {
+        oOptimal = optimizeArith(o, value);
+      }
+    }
+    Trace("opt") << "OptimizationSolver::checkOpt: objective " << i << " is "
+                 << o.d_value << (oOptimal ? "" : " (not shown optimal)")
+                 << std::endl;
+    optimal = optimal && oOptimal;
+  }
+  Unreachable();
+}
+
+bool OptimizationSolver::optimizeArith(Objective& o, const Expr& value)
+{
+  ExprManager* em = d_smt->getExprManager();
+  bool isInt = o.d_term.getType().isInteger();
+  // We minimize u, which is the term if minimizing and its negation
+  // otherwise. The search first decreases u by steps of increasing powers of
+  // two until a lower bound is found, then bisects the interval between the
+  // lower bound and the best value.
+  Expr u = o.d_minimize ? o.d_term : em->mkExpr(kind::UMINUS, o.d_term);
+  Rational best = value.getConst<Rational>();
+  if (!o.d_minimize)
+  {
+    best = -best;
+  }
+  // if hasLower is true, then no model has u <= lower
+  bool hasLower = false;
+  Rational lower;
+  uint32_t k = 0;
+  bool optimal = false;
+  while (!optimal)
+  {
+    if (isInt && hasLower && lower + Rational(1) >= best)
+    {
+      optimal = true;
+      break;
+    }
+    Rational cand;
+    if (!hasLower)
+    {
+      cand = best - Rational(Integer(1).multiplyByPow2(k));
+      k++;
+    }
+    else
+    {
+      cand = (lower + best) / Rational(2);
+      if (isInt)
+      {
+        cand = Rational(cand.floor());
+      }
+    }
+    Result r = check({em->mkExpr(kind::LEQ, u, em->mkConst(cand))});
+    if (r.isSat() == Result::UNSAT)
+    {
+      hasLower = true;
+      lower = cand;
+      if (isInt)
+      {
+        continue;
+      }
+      // For reals, bisecting may not terminate, hence we also check whether
+      // the best value is optimal.
+      r = check({em->mkExpr(kind::LT, u, em->mkConst(best))});
+      if (r.isSat() == Result::UNSAT)
+      {
+        optimal = true;
+        break;
+      }
+    }
+    if (r.isSat() != Result::SAT)
+    {
+      break;
+    }
+    Expr v = d_smt->getValue(u);
+    if (!v.isConst())
+    {
+      break;
+    }
+    best = v.getConst<Rational>();
+  }
+  Trace("opt") << "OptimizationSolver::optimizeArith: " << best
+               << (hasLower ? "" : " (no lower bound found)") << std::endl;
+  d_fixed.push_back(em->mkExpr(kind::LEQ, u, em->mkConst(best)));
+  o.d_value = em->mkConst(o.d_minimize ? best : -best);
+  return optimal;
+}
+
+bool OptimizationSolver::optimizeBv(Objective& o, const Expr& value)
+{
+  ExprManager* em = d_smt->getExprManager();
+  // Decide the bits of the optimum from the most significant one. A bit is
+  // set to its preferred value if the best model has it, otherwise it is
+  // checked, and the bits decided so far are assumed.
+  unsigned size = BitVectorType(o.d_term.getType()).getSize();
+  bool pref = !o.d_minimize;
+  Expr prefConst = em->mkConst(BitVector(1u, pref ? 1u : 0u));
+  BitVector best = value.getConst<BitVector>();
+  size_t nfixed = d_fixed.size();
+  bool optimal = true;
+  for (unsigned i = size; i-- > 0;)
+  {
+    Expr bit = em->mkExpr(em->mkConst(BitVectorExtract(i, i)), o.d_term);
+    Expr isPref = em->mkExpr(kind::EQUAL, bit, prefConst);
+    if (best.isBitSet(i) == pref)
+    {
+      d_fixed.push_back(isPref);
+      continue;
+    }
+    Result r = check({isPref});
+    if (r.isSat() == Result::SAT)
+    {
+      best = d_smt->getValue(o.d_term).getConst<BitVector>();
+      d_fixed.push_back(isPref);
+    }
+    else if (r.isSat() == Result::UNSAT)
+    {
+      d_fixed.push_back(isPref.notExpr());
+    }
+    else
+    {
+      optimal = false;
+      break;
+    }
+  }
+  Trace("opt") << "OptimizationSolver::optimizeBv: " << best << std::endl;
+  d_fixed.resize(nfixed);
+  o.d_value = em->mkConst(best);
+  d_fixed.push_back(
+      optimal ? em->mkExpr(kind::EQUAL, o.d_term, o.d_value)
+              : em->mkExpr(o.d_minimize ? kind::BITVECTOR_ULE
+                                        : kind::BITVECTOR_UGE,
+                           o.d_term,
+                           o.d_value));
+  return optimal;
+}
+
+bool OptimizationSolver::optimizeSoft(Objective& o)
+{
+  ExprManager* em = d_smt->getExprManager();
+  // the weights of duplicate soft assertions are added
+  std::vector<Expr> soft;
+  std::vector<Integer> weights;
+  std::unordered_map<Expr, size_t, ExprHashFunction> indices;
+  for (size_t i = 0, nsoft = o.d_soft.size(); i < nsoft; ++i)
+  {
+    auto it = indices.find(o.d_soft[i]);
+    if (it == indices.end())
+    {
+      indices[o.d_soft[i]] = soft.size();
+      soft.push_back(o.d_soft[i]);
+      weights.push_back(o.d_weights[i]);
+    }
+    else
+    {
+      weights[it->second] += o.d_weights[i];
+    }
+  }
+  if (soft.empty())
+  {
+    o.d_value = em->mkConst(Rational(0));
+    return true;
+  }
+  // The soft assertions that hold in the current model are the best known
+  // solution, in case the optimum is not found.
+  std::vector<Expr> bestKept;
+  Integer bestCost(0);
+  for (size_t i = 0, nsoft = soft.size(); i < nsoft; ++i)
+  {
+    Expr v = d_smt->getValue(soft[i]);
+    if (v.isConst() && v.getConst<bool>())
+    {
+      bestKept.push_back(soft[i]);
+    }
+    else
+    {
+      bestCost += weights[i];
+    }
+  }
+
+  // Core-guided search by implicit hitting sets: the soft assertions outside
+  // a minimum weight hitting set of the cores found so far are assumed. If
+  // they are satisfiable, the hitting set is optimal, otherwise the unsat
+  // assumptions give a new core. The hitting sets are computed by a
+  // subsolver over one selector per soft assertion, whose total weight is
+  // minimized by an optimization solver of its own.
+  ExprManager hsEm;
+  SmtEngine hsSmt(&hsEm);
+  hsSmt.setIsInternalSubsolver();
+  hsSmt.setOption("incremental", SExpr("true"));
+  hsSmt.setOption("produce-models", SExpr("true"));
+  hsSmt.setLogic("QF_LIA");
+  std::vector<Expr> selectors;
+  std::vector<Expr> costs;
+  Expr zero = hsEm.mkConst(Rational(0));
+  for (size_t i = 0, nsoft = soft.size(); i < nsoft; ++i)
+  {
+    selectors.push_back(hsEm.mkVar(hsEm.booleanType()));
+    costs.push_back(hsEm.mkExpr(
+        kind::ITE, selectors[i], hsEm.mkConst(Rational(weights[i])), zero));
+  }
+  Expr cost = costs.size() == 1 ? costs[0] : hsEm.mkExpr(kind::PLUS, costs);
+  std::vector<bool> inHs(soft.size(), false);
+  Integer hsCost(0);
+  bool optimal = false;
+  while (true)
+  {
+    std::vector<Expr> kept;
+    for (size_t i = 0, nsoft = soft.size(); i < nsoft; ++i)
+    {
+      if (!inHs[i])
+      {
+        kept.push_back(soft[i]);
+      }
+    }
+    Result r = check(kept);
+    if (r.isSat() == Result::SAT)
+    {
+      optimal = true;
+      bestKept = kept;
+      bestCost = hsCost;
+      break;
+    }
+    else if (r.isSat() != Result::UNSAT)
+    {
+      break;
+    }
+    std::vector<Expr> lits;
+    for (const Expr& e : d_smt->getUnsatAssumptions())
+    {
+      auto it = indices.find(e);
+      if (it != indices.end())
+      {
+        lits.push_back(selectors[it->second]);
+      }
+    }
+    Trace("opt") << "OptimizationSolver::optimizeSoft: core of size "
+                 << lits.size() << std::endl;
+    if (lits.empty())
+    {
+      // the bounds of the previous objectives are unsatisfiable, which
+      // contradicts the previous checks
+      break;
+    }
+    hsSmt.assertFormula(lits.size() == 1 ? lits[0]
+                                         : hsEm.mkExpr(kind::OR, lits));
+    OptimizationSolver hsOpt(&hsSmt);
+    hsOpt.addObjective(cost, true, 0);
+    if (hsOpt.checkOpt().isSat() != Result::SAT)
+    {
+      break;
+    }
+    hsCost = hsOpt.getObjectiveValue(0).getConst<Rational>().getNumerator();
+    for (size_t i = 0, nsoft = soft.size(); i < nsoft; ++i)
+    {
+      inHs[i] = hsSmt.getValue(selectors[i]).getConst<bool>();
+    }
+  }
+  Trace("opt") << "OptimizationSolver::optimizeSoft: " << bestCost
+               << std::endl;
+  d_fixed.insert(d_fixed.end(), bestKept.begin(), bestKept.end());
+  o.d_value = em->mkConst(Rational(bestCost));
+  return optimal;
+}
+
+}  // namespace smt
+}  // namespace CVC4
@@ -0,0 +1,135 @@
+/*********************                                                        */
+/*! \file optimization_solver.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Optimization of objectives and soft assertions
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__SMT__OPTIMIZATION_SOLVER_H
+#define CVC4__SMT__OPTIMIZATION_SOLVER_H
+
+#include <vector>
+
+#include "expr/expr.h"
+#include "smt/smt_engine.h"
+#include "util/integer.h"
+#include "util/rational.h"
+#include "util/result.h"
+
+namespace CVC4 {
+namespace smt {
+
+/**
+ * Optimizes objectives over the assertions of an SmtEngine. The objectives
+ * are terms of sort Int, Real or bit-vector (interpreted as unsigned) to
+ * minimize or maximize, and the total weight of the violated soft assertions,
+ * which is minimized. They are optimized lexicographically, in the order in
+ * which they were added.
+ *
+ * The search runs inside the SmtEngine: each step is a check of its
+ * assertions under assumptions that bound the objectives, hence the SAT
+ * solver keeps its learned clauses between the steps, and the assertions of
+ * the SmtEngine are never changed. The last check is made under the optimal
+ * bounds, so that its model is optimal.
+ */
+class OptimizationSolver
+{
+ public:
+  OptimizationSolver(SmtEngine* smt);
+  ~OptimizationSolver();
+
+  /**
+   * Add the objective to minimize (or maximize) term, at the given user
+   * level. Returns the index of the objective.
+   */
+  size_t addObjective(const Expr& term, bool minimize, size_t level);
+  /**
+   * Add the soft assertion formula with the given (positive) weight, at the
+   * given user level. The soft assertions form a single objective, added with
+   * the first of them. Returns the index of this objective.
+   */
+  size_t addSoftAssertion(const Expr& formula,
+                          const Integer& weight,
+                          size_t level);
+  /** Remove the objectives and soft assertions above the given user level */
+  void pop(size_t level);
+  /** Get the number of objectives */
+  size_t size() const { return d_objectives.size(); }
+
+  /**
+   * Optimize the objectives. Returns SAT if they were all shown optimal, and
+   * unknown if the optimum of one of them was not shown, because a check was
+   * unknown, or options::optMaxChecks() checks did not suffice (which is
+   * notably the case for unbounded objectives, or Real objectives whose
+   * optimum is not attained). In both cases, the model of the SmtEngine
+   * realizes the values of the objectives.
+   */
+  Result checkOpt();
+  /**
+   * Get the value of objective i found by the last call to checkOpt, or the
+   * null expression if there is none.
+   */
+  Expr getObjectiveValue(size_t i) const;
+
+ private:
+  /** An objective */
+  struct Objective
+  {
+    /** The term to optimize, null for the soft assertions */
+    Expr d_term;
+    /** Whether to minimize d_term */
+    bool d_minimize;
+    /** The user level at which the objective was added */
+    size_t d_level;
+    /** The soft assertions */
+    std::vector<Expr> d_soft;
+    /** The weight of each soft assertion */
+    std::vector<Integer> d_weights;
+    /** The user level of each soft assertion */
+    std::vector<size_t> d_softLevels;
+    /** The best value found by the last call to checkOpt */
+    Expr d_value;
+  };
+  /**
+   * Check the assertions under the assumptions d_fixed and extra, counting
+   * the check. Returns unknown without checking if options::optMaxChecks()
+   * checks were made by this call to checkOpt.
+   */
+  Result check(const std::vector<Expr>& extra = std::vector<Expr>());
+  /**
+   * Optimize the Int or Real objective o, whose value in the current model
+   * is value, then bound it by the best value found in d_fixed. Returns
+   * whether this value was shown optimal.
+   */
+  bool optimizeArith(Objective& o, const Expr& value);
+  /** Same as above, for a bit-vector objective */
+  bool optimizeBv(Objective& o, const Expr& value);
+  /**
+   * Same as above, for the soft assertions, which are bounded in d_fixed by
+   * assuming the soft assertions that hold in the best model found.
+   */
+  bool optimizeSoft(Objective& o);
+
+  /** The SmtEngine whose assertions are checked */
+  SmtEngine* d_smt;
+  /** The objectives */
+  std::vector<Objective> d_objectives;
+  /** The index of the objective of the soft assertions, if any */
+  size_t d_softIndex;
+  /** The assumptions that bound the objectives optimized so far */
+  std::vector<Expr> d_fixed;
+  /** The number of checks made by the current call to checkOpt */
+  unsigned d_numChecks;
+}; /* class OptimizationSolver */
+
+}  // namespace smt
+}  // namespace CVC4
+
+#endif /* CVC4__SMT__OPTIMIZATION_SOLVER_H */
@@ -17,8 +17,12 @@
 #include "smt/smt_engine.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <chrono>
+#include <fstream>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <stack>
@@ -56,6 +60,7 @@
 #include "options/bv_options.h"
 #include "options/datatypes_options.h"
 #include "options/decision_options.h"
+#include "options/idl_options.h"
 #include "options/language.h"
 #include "options/main_options.h"
 #include "options/open_ostream.h"
@@ -85,7 +90,10 @@
 #include "smt/managed_ostreams.h"
 #include "smt/model_blocker.h"
 #include "smt/model_core_builder.h"
+#include "smt/mus_extractor.h"
+#include "smt/optimization_solver.h"
 #include "smt/smt_engine_scope.h"
+#include "smt/strategy_selector.h"
 #include "smt/term_formula_removal.h"
 #include "smt/update_ostream.h"
 #include "smt_util/boolean_simplification.h"
@@ -110,6 +118,7 @@
 #include "theory/theory_traits.h"
 #include "util/hash.h"
 #include "util/proof.h"
+#include "util/profiler.h"
 #include "util/random.h"
 #include "util/resource_manager.h"
 
@@ -156,6 +165,51 @@ public:
   }
 };
 
+/**
+ * Records a trace of the timed regions during its lifetime, and writes it to
+ * a file if its lifetime is at least the threshold of --trace-slow-queries.
+ * Nested tracers, e.g. of the checks of subsolvers, record nothing.
+ */
+class SlowQueryTracer
+{
+ public:
+  SlowQueryTracer()
+      : d_active(options::traceSlowQueries() > 0 && Profiler::beginTrace()),
+        d_start(std::chrono::steady_clock::now())
+  {
+  }
+  ~SlowQueryTracer()
+  {
+    if (!d_active)
+    {
+      return;
+    }
+    Profiler::endTrace();
+    static std::atomic<unsigned> s_numQueries(0);
+    unsigned query = s_numQueries++;
+    std::chrono::milliseconds elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - d_start);
+    if (static_cast<unsigned long>(elapsed.count())
+        < options::traceSlowQueries())
+    {
+      return;
+    }
+    std::string file = options::traceSlowQueriesPrefix() + "-"
+                       + std::to_string(query) + ".json";
+    std::ofstream out(file);
+    Profiler::writeTrace(out);
+    Notice() << "SmtEngine: check " << query << " took " << elapsed.count()
+             << "ms, its trace is written to " << file << std::endl;
+  }
+
+ private:
+  /** Whether this tracer records the trace */
+  bool d_active;
+  /** The time at which the trace started */
+  std::chrono::steady_clock::time_point d_start;
+};/* class SlowQueryTracer */
+
 /**
  * Representation of a defined function.  We keep these around in
  * SmtEngine to permit expanding definitions late (and lazily), to
@@ -177,6 +231,50 @@ public:
   Node getFormula() const { return d_formula; }
 };/* class DefinedFunction */
 
+/**
+ * The memory used by the context-dependent objects of a context: the
+ * maximum number of bytes allocated in a region of each context level, and
+ * the number of saves and of bytes they allocated, per type of object (the
+ * latter only with --stats).
+ */
+class ContextMemoryStat : public Stat
+{
+  const context::ContextMemoryManager* d_cmm;
+
+ public:
+  ContextMemoryStat(const std::string& name,
+                    const context::ContextMemoryManager* cmm)
+      : Stat(name), d_cmm(cmm)
+  {
+  }
+
+  void flushInformation(std::ostream& out) const override
+  {
+    std::vector<uint64_t> levels;
+    d_cmm->getMaxLevelBytes(levels);
+    out << "[levels : [";
+    for (size_t i = 0, nlevels = levels.size(); i < nlevels; i++)
+    {
+      out << (i > 0 ? ", " : "") << "(" << i << " : " << levels[i] << ")";
+    }
+    out << "], types : [";
+    bool first = true;
+    for (const auto& t : d_cmm->getTypeSaves())
+    {
+      out << (first ? "" : ", ") << "(" << t.first << " : " << t.second.first
+          << " saves " << t.second.second << " bytes)";
+      first = false;
+    }
+    out << "]]";
+  }
+
+  void safeFlushInformation(int fd) const override
+  {
+    // printing the levels would allocate
+    safe_print(fd, "<unsupported>");
+  }
+};/* class ContextMemoryStat */
+
 struct SmtEngineStatistics {
   /** time spent in definition-expansion */
   TimerStat d_definitionExpansionTime;
@@ -205,10 +303,39 @@ struct SmtEngineStatistics {
 
   /** Has something simplified to false? */
   IntStat d_simplifiedToFalse;
+  /** Number of assertions whose preprocessing was found in the cache */
+  IntStat d_ppCacheHits;
+  /** Number of check-sat-assuming assumptions passed to the SAT solver */
+  IntStat d_numSatAssumptions;
+  /** The strategy selected by --strategy-table for the last check */
+  BackedStat<std::string> d_strategy;
   /** Number of resource units spent. */
   ReferenceStat<uint64_t> d_resourceUnitsUsed;
 
-  SmtEngineStatistics()
+  /** Bytes allocated in the memory of the SAT context */
+  ReferenceStat<uint64_t> d_satContextBytes;
+  /** Maximum number of bytes allocated in the memory of the SAT context */
+  ReferenceStat<uint64_t> d_satContextMaxBytes;
+  /** Maximum number of chunks held by the memory of the SAT context */
+  ReferenceStat<uint64_t> d_satContextMaxChunks;
+  /** Chunks released to the system by the memory of the SAT context */
+  ReferenceStat<uint64_t> d_satContextChunksReleased;
+  /** Per-level and per-type memory of the SAT context */
+  ContextMemoryStat d_satContextMemory;
+  /** Bytes allocated in the memory of the user context */
+  ReferenceStat<uint64_t> d_userContextBytes;
+  /** Maximum number of bytes allocated in the memory of the user context */
+  ReferenceStat<uint64_t> d_userContextMaxBytes;
+  /** Per-level and per-type memory of the user context */
+  ContextMemoryStat d_userContextMemory;
+  /** The steps spent and units used, per kind of resources */
+  std::vector<std::unique_ptr<ReferenceStat<uint64_t>>> d_resourceStats;
+  /** The profile of the timed regions, if profiling */
+  ProfilerStat d_profile;
+  /** Whether d_profile is registered */
+  bool d_profileRegistered;
+
+  SmtEngineStatistics(context::Context* c, context::UserContext* u)
       : d_definitionExpansionTime("smt::SmtEngine::definitionExpansionTime"),
         d_numConstantProps("smt::SmtEngine::numConstantProps", 0),
         d_cnfConversionTime("smt::SmtEngine::cnfConversionTime"),
@@ -222,7 +349,26 @@ struct SmtEngineStatistics {
         d_pushPopTime("smt::SmtEngine::pushPopTime"),
         d_processAssertionsTime("smt::SmtEngine::processAssertionsTime"),
         d_simplifiedToFalse("smt::SmtEngine::simplifiedToFalse", 0),
-        d_resourceUnitsUsed("smt::SmtEngine::resourceUnitsUsed")
+        d_ppCacheHits("smt::SmtEngine::ppCacheHits", 0),
+        d_numSatAssumptions("smt::SmtEngine::numSatAssumptions", 0),
+        d_strategy("smt::SmtEngine::strategy", "none"),
+        d_resourceUnitsUsed("smt::SmtEngine::resourceUnitsUsed"),
+        d_satContextBytes("smt::SmtEngine::satContextBytes",
+                          c->getCMM()->getBytesAllocated()),
+        d_satContextMaxBytes("smt::SmtEngine::satContextMaxBytes",
+                             c->getCMM()->getMaxBytesAllocated()),
+        d_satContextMaxChunks("smt::SmtEngine::satContextMaxChunks",
+                              c->getCMM()->getMaxChunks()),
+        d_satContextChunksReleased("smt::SmtEngine::satContextChunksReleased",
+                                   c->getCMM()->getChunksReleased()),
+        d_satContextMemory("smt::SmtEngine::satContextMemory", c->getCMM()),
+        d_userContextBytes("smt::SmtEngine::userContextBytes",
+                           u->getCMM()->getBytesAllocated()),
+        d_userContextMaxBytes("smt::SmtEngine::userContextMaxBytes",
+                              u->getCMM()->getMaxBytesAllocated()),
+        d_userContextMemory("smt::SmtEngine::userContextMemory", u->getCMM()),
+        d_profile("smt::SmtEngine::profile"),
+        d_profileRegistered(false)
   {
     smtStatisticsRegistry()->registerStat(&d_definitionExpansionTime);
     smtStatisticsRegistry()->registerStat(&d_numConstantProps);
@@ -237,7 +383,18 @@ struct SmtEngineStatistics {
     smtStatisticsRegistry()->registerStat(&d_pushPopTime);
     smtStatisticsRegistry()->registerStat(&d_processAssertionsTime);
     smtStatisticsRegistry()->registerStat(&d_simplifiedToFalse);
+    smtStatisticsRegistry()->registerStat(&d_ppCacheHits);
+    smtStatisticsRegistry()->registerStat(&d_numSatAssumptions);
+    smtStatisticsRegistry()->registerStat(&d_strategy);
     smtStatisticsRegistry()->registerStat(&d_resourceUnitsUsed);
+    smtStatisticsRegistry()->registerStat(&d_satContextBytes);
+    smtStatisticsRegistry()->registerStat(&d_satContextMaxBytes);
+    smtStatisticsRegistry()->registerStat(&d_satContextMaxChunks);
+    smtStatisticsRegistry()->registerStat(&d_satContextChunksReleased);
+    smtStatisticsRegistry()->registerStat(&d_satContextMemory);
+    smtStatisticsRegistry()->registerStat(&d_userContextBytes);
+    smtStatisticsRegistry()->registerStat(&d_userContextMaxBytes);
+    smtStatisticsRegistry()->registerStat(&d_userContextMemory);
   }
 
   ~SmtEngineStatistics() {
@@ -254,7 +411,57 @@ struct SmtEngineStatistics {
     smtStatisticsRegistry()->unregisterStat(&d_pushPopTime);
     smtStatisticsRegistry()->unregisterStat(&d_processAssertionsTime);
     smtStatisticsRegistry()->unregisterStat(&d_simplifiedToFalse);
+    smtStatisticsRegistry()->unregisterStat(&d_ppCacheHits);
+    smtStatisticsRegistry()->unregisterStat(&d_numSatAssumptions);
+    smtStatisticsRegistry()->unregisterStat(&d_strategy);
     smtStatisticsRegistry()->unregisterStat(&d_resourceUnitsUsed);
+    smtStatisticsRegistry()->unregisterStat(&d_satContextBytes);
+    smtStatisticsRegistry()->unregisterStat(&d_satContextMaxBytes);
+    smtStatisticsRegistry()->unregisterStat(&d_satContextMaxChunks);
+    smtStatisticsRegistry()->unregisterStat(&d_satContextChunksReleased);
+    smtStatisticsRegistry()->unregisterStat(&d_satContextMemory);
+    smtStatisticsRegistry()->unregisterStat(&d_userContextBytes);
+    smtStatisticsRegistry()->unregisterStat(&d_userContextMaxBytes);
+    smtStatisticsRegistry()->unregisterStat(&d_userContextMemory);
+    if (d_profileRegistered)
+    {
+      smtStatisticsRegistry()->unregisterStat(&d_profile);
+    }
+    for (const std::unique_ptr<ReferenceStat<uint64_t>>& s : d_resourceStats)
+    {
+      smtStatisticsRegistry()->unregisterStat(s.get());
+    }
+  }
+
+  /** Register the statistics of the kinds of resources spent in rm */
+  void registerResourceStats(const ResourceManager* rm)
+  {
+    size_t count = static_cast<size_t>(ResourceManager::Resource::Count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      ResourceManager::Resource r = static_cast<ResourceManager::Resource>(i);
+      std::string prefix = std::string("smt::SmtEngine::resource::")
+                           + ResourceManager::toString(r);
+      d_resourceStats.emplace_back(new ReferenceStat<uint64_t>(
+          prefix + "::steps", rm->getResourceSteps(r)));
+      d_resourceStats.emplace_back(new ReferenceStat<uint64_t>(
+          prefix + "::units", rm->getResourceUnits(r)));
+    }
+    for (const std::unique_ptr<ReferenceStat<uint64_t>>& s : d_resourceStats)
+    {
+      smtStatisticsRegistry()->registerStat(s.get());
+    }
+  }
+
+  /** Enable profiling and report the profile with the statistics */
+  void registerProfile()
+  {
+    Profiler::setEnabled(true);
+    if (!d_profileRegistered)
+    {
+      smtStatisticsRegistry()->registerStat(&d_profile);
+      d_profileRegistered = true;
+    }
   }
 };/* struct SmtEngineStatistics */
 
@@ -484,6 +691,23 @@ class SmtEnginePrivate : public NodeManagerListener {
    */
   unsigned d_simplifyAssertionsDepth;
 
+  /**
+   * Cache of expandAndSubstitute, for each generation of the definitions and
+   * top-level substitutions. It is not context-dependent, so that assertions
+   * that are asserted again after a pop are not preprocessed again.
+   */
+  std::map<uint64_t, NodeToNodeHashMap> d_ppCache;
+  /**
+   * The current generation of the definitions and top-level substitutions.
+   * A fresh generation is taken whenever one of them changes. Since these
+   * are restored on pop, so is the generation.
+   */
+  CDO<uint64_t> d_ppCacheGeneration;
+  /** The number of top-level substitutions of the current generation */
+  CDO<size_t> d_ppCacheSubstsSize;
+  /** The next fresh generation */
+  uint64_t d_ppCacheNextGeneration;
+
   /** TODO: whether certain preprocess steps are necessary */
   //bool d_needsExpandDefs;
 
@@ -491,6 +715,22 @@ class SmtEnginePrivate : public NodeManagerListener {
   /** mapping from expressions to name */
   context::CDHashMap< Node, std::string, NodeHashFunction > d_exprNames;
   //------------------------------- end expression names
+
+  //------------------------------- assumption-based unsat cores
+  /** the activation literals guarding the current assertions */
+  context::CDList<Node> d_activationLits;
+  /** mapping from activation literals to the assertions they guard */
+  context::CDHashMap<Node, Node, NodeHashFunction> d_activationLitToAssertion;
+  //------------------------------- end assumption-based unsat cores
+
+  /**
+   * The assumptions of the current check that are passed to the SAT solver
+   * as assumptions, see trySatAssumption.
+   */
+  std::vector<Node> d_satAssumptions;
+
+  /** The selector of the options of each query, if --strategy-table */
+  std::unique_ptr<smt::StrategySelector> d_strategySelector;
  public:
   IteSkolemMap& getIteSkolemMap() { return d_assertions.getIteSkolemMap(); }
 
@@ -563,8 +803,13 @@ class SmtEnginePrivate : public NodeManagerListener {
         d_abstractValueMap(&d_fakeContext),
         d_abstractValues(),
         d_simplifyAssertionsDepth(0),
+        d_ppCacheGeneration(smt.d_userContext, 0),
+        d_ppCacheSubstsSize(smt.d_userContext, 0),
+        d_ppCacheNextGeneration(1),
         // d_needsExpandDefs(true),  //TODO?
         d_exprNames(smt.d_userContext),
+        d_activationLits(smt.d_userContext),
+        d_activationLitToAssertion(smt.d_userContext),
         d_iteRemover(smt.d_userContext),
         d_sygusConjectureStale(smt.d_userContext, true)
   {
@@ -652,9 +897,11 @@ class SmtEnginePrivate : public NodeManagerListener {
   void cleanupPreprocessingPasses() { d_passes.clear(); }
 
   ResourceManager* getResourceManager() { return d_resourceManager; }
+  /** Spend the given amount of preprocessing resources */
   void spendResource(unsigned amount)
   {
-    d_resourceManager->spendResource(amount);
+    d_resourceManager->spendResource(ResourceManager::Resource::PreprocessStep,
+                                     amount);
   }
 
   void nmNotifyNewSort(TypeNode tn, uint32_t flags) override
@@ -725,6 +972,13 @@ class SmtEnginePrivate : public NodeManagerListener {
    */
   void processAssertions();
 
+  /**
+   * Add the features of the assertions to be processed to the strategy
+   * selector, and set the options of the strategy it selects, before the
+   * assertions are preprocessed.
+   */
+  void selectStrategy();
+
   /** Process a user push.
   */
   void notifyPush() {
@@ -765,11 +1019,75 @@ class SmtEnginePrivate : public NodeManagerListener {
                   bool isAssumption = false,
                   bool maybeHasFv = false);
 
+  /**
+   * Returns the formula n guarded by a fresh activation literal a, i.e.
+   * (=> a n), and remembers that a guards n. Used if assumption-based unsat
+   * cores are enabled, in which case the activation literals are assumed when
+   * checking satisfiability.
+   */
+  Node guardAssertion(TNode n);
+
+  /** Get the activation literals guarding the current assertions */
+  const context::CDList<Node>& getActivationLiterals() const
+  {
+    return d_activationLits;
+  }
+
+  /**
+   * Get the assertions guarded by the activation literals in lits, in the
+   * order in which they were asserted. Literals that are not activation
+   * literals are ignored.
+   */
+  void getGuardedAssertions(const std::vector<Node>& lits,
+                            std::vector<Expr>& assertions) const;
+
+  /**
+   * If the atom of the assumption n, after the top-level substitutions, is
+   * already known to the SAT solver, remembers the corresponding literal as
+   * an assumption of the SAT solver for the next check and returns true.
+   * Otherwise returns false, and n must be asserted in a new context. Using
+   * the literal directly keeps the clauses learned while it was assumed, and
+   * avoids preprocessing n again: the atoms of the SAT solver are already
+   * preprocessed, and n is equivalent to the literal modulo the top-level
+   * substitutions, which are entailed by the assertions. The literal is not
+   * added to the assertion list, so this must not be used if models are
+   * checked.
+   */
+  bool trySatAssumption(TNode n);
+
+  /** Get the SAT solver assumptions of the current check */
+  const std::vector<Node>& getSatAssumptions() const
+  {
+    return d_satAssumptions;
+  }
+
+  /** Clear the SAT solver assumptions of the current check */
+  void clearSatAssumptions() { d_satAssumptions.clear(); }
+
   /** Expand definitions in n. */
   Node expandDefinitions(TNode n,
                          NodeToNodeHashMap& cache,
                          bool expandOnly = false);
 
+  /**
+   * Expand definitions in n and apply the top-level substitutions to it,
+   * using the cache d_ppCache for the current generation. The argument cache
+   * is the cache of expandDefinitions.
+   */
+  Node expandAndSubstitute(TNode n, NodeToNodeHashMap& cache);
+
+  /**
+   * Update the generation of d_ppCache to the current top-level substitutions
+   * and remove the entries of generations that can no longer be current.
+   */
+  void updatePreprocessCache();
+
+  /** Notify that the definitions have changed, which invalidates d_ppCache */
+  void notifyDefinitionsChanged()
+  {
+    d_ppCacheGeneration = d_ppCacheNextGeneration++;
+  }
+
   /**
    * Simplify node "in" by expanding definitions and applying any
    * substitutions learned from preprocessing.
@@ -812,6 +1130,62 @@ class SmtEnginePrivate : public NodeManagerListener {
     return retval;
   }
 
+  /**
+   * Get the value of n in model m, postprocessed for output to the user. The
+   * definitions in n are expanded using cache, which the caller may share
+   * between the terms of a get-value command. The values of the subterms are
+   * cached by m until it is reset.
+   */
+  Node getValue(Node n, TheoryModel* m, NodeToNodeHashMap& cache)
+  {
+    // do not need to apply preprocessing substitutions (should be recorded
+    // in model already)
+    Trace("smt") << "--- getting value of " << n << endl;
+    TypeNode expectedType = n.getType();
+
+    // Expand, then normalize
+    n = expandDefinitions(n, cache);
+    // There are two ways model values for terms are computed (for historical
+    // reasons).  One way is that used in check-model; the other is that
+    // used by the Model classes.  It's not clear to me exactly how these
+    // two are different, but they need to be unified.  This ugly hack here
+    // is to fix bug 554 until we can revamp boolean-terms and models [MGD]
+
+    //AJR : necessary?
+    if(!n.getType().isFunction()) {
+      n = Rewriter::rewrite(n);
+    }
+
+    Trace("smt") << "--- getting value of " << n << endl;
+    Node resultNode;
+    if(m != NULL) {
+      resultNode = m->getValue(n);
+    }
+    Trace("smt") << "--- got value " << n << " = " << resultNode << endl;
+    resultNode = d_smt.postprocess(resultNode, expectedType);
+    Trace("smt") << "--- model-post returned " << resultNode << endl;
+    Trace("smt") << "--- model-post returned " << resultNode.getType() << endl;
+    Trace("smt") << "--- model-post expected " << expectedType << endl;
+
+    // type-check the result we got
+    // Notice that lambdas have function type, which does not respect the
+    // subtype relation, so we ignore them here.
+    Assert(resultNode.isNull() || resultNode.getKind() == kind::LAMBDA
+           || resultNode.getType().isSubtypeOf(expectedType))
+        << "Run with -t smt for details.";
+
+    // Ensure it's a constant, or a lambda (for uninterpreted functions), or
+    // a choice (for approximate values).
+    Assert(resultNode.getKind() == kind::LAMBDA
+           || resultNode.getKind() == kind::CHOICE || resultNode.isConst());
+
+    if(options::abstractValues() && resultNode.getType().isArray()) {
+      resultNode = mkAbstractValue(resultNode);
+      Trace("smt") << "--- abstract value >> " << resultNode << endl;
+    }
+    return resultNode;
+  }
+
   void addUseTheoryListListener(TheoryEngine* theoryEngine){
     Options& nodeManagerOptions = NodeManager::currentNM()->getOptions();
     d_listenerRegistrations->add(
@@ -863,6 +1237,8 @@ SmtEngine::SmtEngine(ExprManager* em)
       d_dumpCommands(),
       d_defineCommands(),
       d_logic(),
+      d_userLogic(),
+      d_userLogicSet(false),
       d_originalOptions(),
       d_isInternalSubsolver(false),
       d_pendingPops(0),
@@ -884,9 +1260,10 @@ SmtEngine::SmtEngine(ExprManager* em)
   d_originalOptions.copyValues(em->getOptions());
   d_private = new smt::SmtEnginePrivate(*this);
   d_statisticsRegistry = new StatisticsRegistry();
-  d_stats = new SmtEngineStatistics();
+  d_stats = new SmtEngineStatistics(d_context, d_userContext);
   d_stats->d_resourceUnitsUsed.setData(
       d_private->getResourceManager()->getResourceUsage());
+  d_stats->registerResourceStats(d_private->getResourceManager());
 
   // The ProofManager is constructed before any other proof objects such as
   // SatProof and TheoryProofs. The TheoryProofEngine and the SatProof are
@@ -908,6 +1285,18 @@ SmtEngine::SmtEngine(ExprManager* em)
 void SmtEngine::finishInit()
 {
   Trace("smt-debug") << "SmtEngine::finishInit" << std::endl;
+  // attribute the context memory to the types of context-dependent objects
+  d_context->getCMM()->setTrackTypes(options::statistics());
+  d_userContext->getCMM()->setTrackTypes(options::statistics());
+  if (options::profile())
+  {
+    d_stats->registerProfile();
+  }
+  else if (options::traceSlowQueries() > 0)
+  {
+    // the regions are registered only when profiling is enabled
+    Profiler::setEnabled(true);
+  }
   // We have mutual dependency here, so we add the prop engine to the theory
   // engine later (it is non-essential there)
   d_theoryEngine = new TheoryEngine(d_context,
@@ -916,8 +1305,27 @@ void SmtEngine::finishInit()
                                     const_cast<const LogicInfo&>(d_logic),
                                     d_channels);
 
-  // Add the theories
+  // Use the difference logic solver for the arithmetic of QF_IDL, unless
+  // proofs are needed, which it does not produce
+  if (options::idlSolver() && d_logic.isPure(THEORY_ARITH)
+      && !d_logic.isQuantified() && d_logic.isDifferenceLogic()
+      && d_logic.areIntegersUsed() && !d_logic.areRealsUsed()
+      && !options::proof() && !options::unsatCores())
+  {
+    Trace("smt") << "using the idl solver" << endl;
+    d_theoryEngine->enableTheoryAlternative("idl");
+  }
+
+  // Add the theories. With lazy theories, the ones that are not enabled by
+  // the logic are only constructed if they are used, except UF, which is
+  // used for all logics. The proofs and unsat cores register all theories.
+  bool lazyTheories =
+      options::lazyTheories() && !options::proof() && !options::unsatCores();
   for(TheoryId id = theory::THEORY_FIRST; id < theory::THEORY_LAST; ++id) {
+    if (lazyTheories && !d_logic.isTheoryEnabled(id) && id != THEORY_UF)
+    {
+      continue;
+    }
     TheoryConstructor::addTheory(d_theoryEngine, id);
     //register with proof engine if applicable
 #ifdef CVC4_PROOF
@@ -1122,6 +1530,8 @@ void SmtEngine::setLogic(const LogicInfo& logic)
                          "finished initializing.");
   }
   d_logic = logic;
+  d_userLogic = logic;
+  d_userLogicSet = true;
   setLogicInternal();
 }
 
@@ -1320,10 +1730,75 @@ void SmtEngine::setDefaults() {
     setOption("produce-assertions", SExpr("true"));
   }
 
-  // Disable options incompatible with incremental solving, unsat cores, and
-  // proofs or output an error if enabled explicitly
-  if (options::incrementalSolving() || options::unsatCores()
-      || options::proof())
+  if (options::dumpMuses() > 0 && !options::unsatCoresAssumptions())
+  {
+    if (options::unsatCoresAssumptions.wasSetByUser())
+    {
+      throw OptionException(
+          "dumping minimal unsatisfiable subsets requires assumption-based "
+          "unsat cores");
+    }
+    Notice() << "SmtEngine: turning on assumption-based unsat cores to "
+                "support dump-muses"
+             << endl;
+    options::unsatCoresAssumptions.set(true);
+  }
+
+  // Assumption-based unsat cores guard each assertion by an activation
+  // literal, which must not be eliminated by preprocessing and must be
+  // visible to the SAT solver of the prop engine.
+  if (options::unsatCoresAssumptions())
+  {
+    if (options::unsatCores())
+    {
+      throw OptionException(
+          "assumption-based unsat cores cannot be combined with "
+          "--produce-unsat-cores");
+    }
+    if (options::bitblastMode() == options::BitblastMode::EAGER)
+    {
+      if (options::bitblastMode.wasSetByUser())
+      {
+        throw OptionException(
+            "eager bit-blasting not supported with assumption-based unsat "
+            "cores. Try --bitblast=lazy");
+      }
+      Notice() << "SmtEngine: setting bit-blast mode to lazy to support "
+                  "assumption-based unsat cores"
+               << endl;
+      setOption("bitblastMode", SExpr("lazy"));
+    }
+    if (options::simplificationMode() != options::SimplificationMode::NONE)
+    {
+      if (options::simplificationMode.wasSetByUser())
+      {
+        throw OptionException(
+            "simplification not supported with assumption-based unsat cores");
+      }
+      Notice() << "SmtEngine: turning off simplification to support "
+                  "assumption-based unsat cores"
+               << endl;
+      options::simplificationMode.set(options::SimplificationMode::NONE);
+    }
+    if (options::unconstrainedSimp())
+    {
+      if (options::unconstrainedSimp.wasSetByUser())
+      {
+        throw OptionException(
+            "unconstrained simplification not supported with "
+            "assumption-based unsat cores");
+      }
+      Notice() << "SmtEngine: turning off unconstrained simplification to "
+                  "support assumption-based unsat cores"
+               << endl;
+      options::unconstrainedSimp.set(false);
+    }
+  }
+
+  // Disable options incompatible with unsat cores and proofs or output an
+  // error if enabled explicitly. Unconstrained simplification supports
+  // incremental solving, but is only enabled by default if not incremental.
+  if (options::unsatCores() || options::proof())
   {
     if (options::unconstrainedSimp())
     {
@@ -1331,15 +1806,15 @@ void SmtEngine::setDefaults() {
       {
         throw OptionException(
             "unconstrained simplification not supported with unsat "
-            "cores/proofs/incremental solving");
+            "cores/proofs");
       }
       Notice() << "SmtEngine: turning off unconstrained simplification to "
-                  "support unsat cores/proofs/incremental solving"
+                  "support unsat cores/proofs"
                << endl;
       options::unconstrainedSimp.set(false);
     }
   }
-  else
+  else if (!options::incrementalSolving() && !options::unsatCoresAssumptions())
   {
     // Turn on unconstrained simplification for QF_AUFBV
     if (!options::unconstrainedSimp.wasSetByUser())
@@ -1720,6 +2195,13 @@ void SmtEngine::setDefaults() {
     Trace("smt") << "setting arith rewrite equalities " << arithRewriteEq << endl;
     options::arithRewriteEq.set(arithRewriteEq);
   }
+  // The IDL solver gives up on disequalities, so it only sees inequalities
+  if (!options::idlRewriteEq.wasSetByUser()
+      && d_theoryEngine->useTheoryAlternative("idl"))
+  {
+    Trace("smt") << "setting idl rewrite equalities" << endl;
+    options::idlRewriteEq.set(true);
+  }
   if(!  options::arithHeuristicPivots.wasSetByUser()) {
     int16_t heuristicPivots = 5;
     if(d_logic.isPure(THEORY_ARITH) && !d_logic.isQuantified()) {
@@ -1820,6 +2302,51 @@ void SmtEngine::setDefaults() {
     options::decisionMode.set(decMode);
     options::decisionStopOnly.set(stoponly);
   }
+  if (options::satSolver() == options::DPLLSatSolverMode::CADICAL)
+  {
+    if (options::proof())
+    {
+      throw OptionException(
+          "--sat-solver=cadical does not support proofs. Try "
+          "--sat-solver=minisat.");
+    }
+    // The decision engine needs the values of all SAT variables during
+    // search, the propagator only tracks the theory atoms.
+    if (options::decisionMode() != options::DecisionMode::INTERNAL)
+    {
+      if (options::decisionMode.wasSetByUser())
+      {
+        throw OptionException(
+            "--sat-solver=cadical only supports --decision=internal.");
+      }
+      Notice() << "SmtEngine: setting decision mode to internal for "
+               << "--sat-solver=cadical" << endl;
+      options::decisionMode.set(options::DecisionMode::INTERNAL);
+      options::decisionStopOnly.set(false);
+    }
+  }
+  // The justification heuristic reads the values of the literals of Boolean
+  // gates, which the polarity-aware CNF only defines in one direction.
+  if (options::cnfPolarity()
+      && options::decisionMode() != options::DecisionMode::INTERNAL)
+  {
+    if (options::decisionMode.wasSetByUser())
+    {
+      if (options::cnfPolarity.wasSetByUser())
+      {
+        throw OptionException(
+            "--cnf-polarity only supports --decision=internal.");
+      }
+      options::cnfPolarity.set(false);
+    }
+    else
+    {
+      Notice() << "SmtEngine: setting decision mode to internal for "
+               << "--cnf-polarity" << endl;
+      options::decisionMode.set(options::DecisionMode::INTERNAL);
+      options::decisionStopOnly.set(false);
+    }
+  }
   if( options::incrementalSolving() ){
     //disable modes not supported by incremental
     options::sortInference.set( false );
@@ -2627,6 +3154,7 @@ void SmtEngine::defineFunction(Expr func,
   // d_haveAdditions = true;
   Debug("smt") << "definedFunctions insert " << funcNode << " " << formNode << endl;
   d_definedFunctions->insert(funcNode, def);
+  d_private->notifyDefinitionsChanged();
 }
 
 void SmtEngine::defineFunctionsRec(
@@ -3054,11 +3582,16 @@ Result SmtEngine::check() {
 
   resourceManager->beginCall();
 
-  // Only way we can be out of resource is if cumulative budget is on
-  if (resourceManager->cumulativeLimitOn() &&
-      resourceManager->out()) {
-    Result::UnknownExplanation why = resourceManager->outOfResources() ?
-                             Result::RESOURCEOUT : Result::TIMEOUT;
+  // Only way we can be out of resource is if cumulative budget is on, or if
+  // the memory is over its limit
+  if ((resourceManager->cumulativeLimitOn() || resourceManager->outOfMemory())
+      && resourceManager->out())
+  {
+    Result::UnknownExplanation why =
+        resourceManager->outOfMemory()
+            ? Result::MEMOUT
+            : resourceManager->outOfResources() ? Result::RESOURCEOUT
+                                                : Result::TIMEOUT;
     return Result(Result::VALIDITY_UNKNOWN, why, d_filename);
   }
 
@@ -3087,7 +3620,21 @@ Result SmtEngine::check() {
 
   Chat() << "solving..." << endl;
   Trace("smt") << "SmtEngine::check(): running check" << endl;
-  Result result = d_propEngine->checkSat();
+  Result result;
+  const std::vector<Node>& satAssumptions = d_private->getSatAssumptions();
+  if (options::unsatCoresAssumptions())
+  {
+    const context::CDList<Node>& lits = d_private->getActivationLiterals();
+    result = d_propEngine->checkSat(std::vector<Node>(lits.begin(), lits.end()));
+  }
+  else if (!satAssumptions.empty())
+  {
+    result = d_propEngine->checkSat(satAssumptions);
+  }
+  else
+  {
+    result = d_propEngine->checkSat();
+  }
 
   resourceManager->endCall();
   Trace("limit") << "SmtEngine::check(): cumulative millis " << resourceManager->getTimeUsage()
@@ -3201,6 +3748,53 @@ bool SmtEnginePrivate::checkForBadSkolems(TNode n, TNode skolem, unordered_map<N
   return false;
 }
 
+Node SmtEnginePrivate::expandAndSubstitute(TNode n, NodeToNodeHashMap& cache)
+{
+  NodeToNodeHashMap& entries = d_ppCache[d_ppCacheGeneration.get()];
+  NodeToNodeHashMap::const_iterator it = entries.find(n);
+  if (it != entries.end())
+  {
+    ++(d_smt.d_stats->d_ppCacheHits);
+    return it->second;
+  }
+  Node res = applySubstitutions(expandDefinitions(n, cache));
+  entries[n] = res;
+  return res;
+}
+
+void SmtEnginePrivate::updatePreprocessCache()
+{
+  size_t size = d_preprocessingPassContext->getTopLevelSubstitutions().size();
+  if (size != d_ppCacheSubstsSize.get())
+  {
+    d_ppCacheGeneration = d_ppCacheNextGeneration++;
+    d_ppCacheSubstsSize = size;
+  }
+  uint64_t generation = d_ppCacheGeneration.get();
+  // Generations after the current one were taken in user contexts that have
+  // been popped. Without user contexts, only the current one remains.
+  d_ppCache.erase(d_ppCache.upper_bound(generation), d_ppCache.end());
+  if (d_smt.getNumUserLevels() == 0)
+  {
+    d_ppCache.erase(d_ppCache.begin(), d_ppCache.lower_bound(generation));
+  }
+}
+
+void SmtEnginePrivate::selectStrategy()
+{
+  if (d_strategySelector == nullptr)
+  {
+    std::unique_ptr<smt::StrategySelector> selector(new smt::StrategySelector);
+    selector->loadTable(options::strategyTable());
+    d_strategySelector = std::move(selector);
+  }
+  d_strategySelector->addAssertions(d_assertions.ref());
+  std::string name =
+      d_strategySelector->select(NodeManager::currentNM()->getOptions());
+  Chat() << "selected strategy: " << (name.empty() ? "none" : name) << endl;
+  d_smt.d_stats->d_strategy.setData(name.empty() ? "none" : name);
+}
+
 void SmtEnginePrivate::processAssertions() {
   TimerStat::CodeTimer paTimer(d_smt.d_stats->d_processAssertionsTime);
   spendResource(options::preprocessStep());
@@ -3223,6 +3817,11 @@ void SmtEnginePrivate::processAssertions() {
     return;
   }
 
+  if (!options::strategyTable().empty())
+  {
+    selectStrategy();
+  }
+
   if (options::bvGaussElim())
   {
     d_passes["bv-gauss"]->apply(&d_assertions);
@@ -3248,6 +3847,17 @@ void SmtEnginePrivate::processAssertions() {
 
   // Assertions are NOT guaranteed to be rewritten by this point
 
+  // Whether the top-level substitutions are applied together with definition
+  // expansion, so that both can be cached across push and pop. This is only
+  // done if none of the passes between the two is enabled.
+  bool useCache = options::ppCache() && !options::unsatCores()
+                  && !options::proof() && !options::globalNegate()
+                  && !options::nlExtPurify() && !options::solveRealAsInt()
+                  && options::solveIntAsBV() == 0 && !options::ackermann()
+                  && !options::bvAbstraction() && !options::extRewPrep()
+                  && !options::unconstrainedSimp()
+                  && !options::bvIntroducePow2();
+
   Trace("smt-proc") << "SmtEnginePrivate::processAssertions() : pre-definition-expansion" << endl;
   dumpAssertions("pre-definition-expansion", d_assertions);
   {
@@ -3255,8 +3865,19 @@ void SmtEnginePrivate::processAssertions() {
     Trace("simplify") << "SmtEnginePrivate::simplify(): expanding definitions" << endl;
     TimerStat::CodeTimer codeTimer(d_smt.d_stats->d_definitionExpansionTime);
     unordered_map<Node, Node, NodeHashFunction> cache;
+    if (useCache)
+    {
+      updatePreprocessCache();
+    }
     for(unsigned i = 0; i < d_assertions.size(); ++ i) {
-      d_assertions.replace(i, expandDefinitions(d_assertions[i], cache));
+      if (useCache && !d_assertions.isSubstsIndex(i))
+      {
+        d_assertions.replace(i, expandAndSubstitute(d_assertions[i], cache));
+      }
+      else
+      {
+        d_assertions.replace(i, expandDefinitions(d_assertions[i], cache));
+      }
     }
   }
   Trace("smt-proc") << "SmtEnginePrivate::processAssertions() : post-definition-expansion" << endl;
@@ -3338,7 +3959,7 @@ void SmtEnginePrivate::processAssertions() {
     // are skipped
     d_passes["rewrite"]->apply(&d_assertions);
   }
-  else
+  else if (!useCache)
   {
     d_passes["apply-substs"]->apply(&d_assertions);
   }
@@ -3437,6 +4058,31 @@ void SmtEnginePrivate::processAssertions() {
   Trace("smt-proc") << "SmtEnginePrivate::processAssertions() : post-simplify" << endl;
   dumpAssertions("post-simplify", d_assertions);
 
+  // Solving the components of the assertions separately is only sound if
+  // they do not interact through quantification over shared sorts, the
+  // heap of separation logic or the universe set.
+  if (options::solveComponents() > 0 && noConflict
+      && !options::incrementalSolving() && !d_smt.d_isInternalSubsolver
+      && !options::unsatCores() && !options::unsatCoresAssumptions()
+      && !options::proof() && !options::globalNegate() && !options::ufHo()
+      && !d_smt.d_logic.isQuantified()
+      && !d_smt.d_logic.isTheoryEnabled(THEORY_SEP)
+      && !d_smt.d_logic.isTheoryEnabled(THEORY_SETS))
+  {
+    d_passes["solve-components"]->apply(&d_assertions);
+  }
+
+  // The local search replaces the assertions when it finds a model, which is
+  // only sound if they are the whole problem
+  if (options::bvSls() > 0 && noConflict && !options::incrementalSolving()
+      && !d_smt.d_isInternalSubsolver && !options::unsatCores()
+      && !options::unsatCoresAssumptions() && !options::proof()
+      && !options::globalNegate() && d_smt.d_logic.isPure(THEORY_BV)
+      && !d_smt.d_logic.isQuantified())
+  {
+    d_passes["bv-sls"]->apply(&d_assertions);
+  }
+
   if (options::symmetryBreakerExp() && !options::incrementalSolving())
   {
     // apply symmetry breaking if not in incremental mode
@@ -3446,6 +4092,15 @@ void SmtEnginePrivate::processAssertions() {
   if(options::doStaticLearning()) {
     d_passes["static-learning"]->apply(&d_assertions);
   }
+
+  // The cardinality constraints are never removed from the SAT solver, and
+  // their variables must not be substituted after they are added
+  if (options::pbNative() && noConflict && !options::incrementalSolving()
+      && !options::repeatSimp() && !options::unsatCores()
+      && !options::unsatCoresAssumptions() && !options::proof())
+  {
+    d_passes["cardinality-constraints"]->apply(&d_assertions);
+  }
   Debug("smt") << " d_assertions     : " << d_assertions.size() << endl;
 
   {
@@ -3653,6 +4308,51 @@ void SmtEnginePrivate::addFormula(
   //d_assertions.push_back(Rewriter::rewrite(n));
 }
 
+Node SmtEnginePrivate::guardAssertion(TNode n)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  Node a = nm->mkSkolem("a",
+                        nm->booleanType(),
+                        "activation literal of an assertion, for "
+                        "assumption-based unsat cores");
+  d_activationLits.push_back(a);
+  d_activationLitToAssertion[a] = n;
+  return nm->mkNode(kind::IMPLIES, a, n);
+}
+
+void SmtEnginePrivate::getGuardedAssertions(const std::vector<Node>& lits,
+                                            std::vector<Expr>& assertions) const
+{
+  // collect the assertions in the order in which they were asserted
+  std::unordered_set<Node, NodeHashFunction> litSet(lits.begin(), lits.end());
+  for (const Node& a : d_activationLits)
+  {
+    if (litSet.find(a) != litSet.end())
+    {
+      assertions.push_back(
+          (*d_activationLitToAssertion.find(a)).second.toExpr());
+    }
+  }
+}
+
+bool SmtEnginePrivate::trySatAssumption(TNode n)
+{
+  Node lit = applySubstitutions(n);
+  if (lit.isConst())
+  {
+    return false;
+  }
+  TNode atom = lit.getKind() == kind::NOT ? lit[0] : lit;
+  if (!d_smt.d_propEngine->isSatLiteral(atom))
+  {
+    return false;
+  }
+  Trace("smt-sat-assume") << "SAT assumption " << lit << " for " << n
+                          << std::endl;
+  d_satAssumptions.push_back(lit);
+  return true;
+}
+
 void SmtEngine::ensureBoolean(const Expr& e)
 {
   Type type = e.getType(options::typeChecking());
@@ -3708,6 +4408,7 @@ Result SmtEngine::checkSatisfiability(const vector<Expr>& assumptions,
     SmtScope smts(this);
     finalOptionsAreSet();
     doPendingPops();
+    SlowQueryTracer tracer;
 
     Trace("smt") << "SmtEngine::" << (isQuery ? "query" : "checkSat") << "("
                  << assumptions << ")" << endl;
@@ -3748,14 +4449,44 @@ Result SmtEngine::checkSatisfiability(const vector<Expr>& assumptions,
       d_assumptions = assumptions;
     }
 
-    if (!d_assumptions.empty())
+    // The assumptions that are asserted in a new context
+    std::vector<Expr> asserted;
+    d_private->clearSatAssumptions();
+    // The SAT assumptions are not in the assertion list, which the model is
+    // checked against, hence they are not used when checking models.
+    if (options::satAssumptions() && !isQuery && !options::unsatCores()
+        && !options::unsatCoresAssumptions() && !options::proof()
+        && !options::checkModels())
+    {
+      // make the top-level substitutions and the SAT literals up to date
+      d_private->processAssertions();
+      for (Expr e : d_assumptions)
+      {
+        e = d_private->substituteAbstractValues(Node::fromExpr(e)).toExpr();
+        ensureBoolean(e);
+        if (d_private->trySatAssumption(e.getNode()))
+        {
+          ++d_stats->d_numSatAssumptions;
+        }
+        else
+        {
+          asserted.push_back(e);
+        }
+      }
+    }
+    else
+    {
+      asserted = d_assumptions;
+    }
+
+    if (!asserted.empty())
     {
       internalPush();
       didInternalPush = true;
     }
 
     Result r(Result::SAT_UNKNOWN, Result::UNKNOWN_REASON);
-    for (Expr e : d_assumptions)
+    for (Expr e : asserted)
     {
       // Substitute out any abstract values in ex.
       e = d_private->substituteAbstractValues(Node::fromExpr(e)).toExpr();
@@ -3768,10 +4499,16 @@ Result SmtEngine::checkSatisfiability(const vector<Expr>& assumptions,
       {
         d_assertionList->push_back(e);
       }
-      d_private->addFormula(e.getNode(), inUnsatCore, true, true);
+      Node n = e.getNode();
+      if (options::unsatCoresAssumptions())
+      {
+        n = d_private->guardAssertion(n);
+      }
+      d_private->addFormula(n, inUnsatCore, true, true);
     }
 
     r = isQuery ? check().asValidityResult() : check().asSatisfiabilityResult();
+    d_private->clearSatAssumptions();
 
     if ((options::solveRealAsInt() || options::solveIntAsBV() > 0)
         && r.asSatisfiabilityResult().isSat() == Result::UNSAT)
@@ -3838,6 +4575,8 @@ Result SmtEngine::checkSatisfiability(const vector<Expr>& assumptions,
                    << d_status;
     }
     d_expectedStatus = Result();
+    // The minimal unsatisfiable subsets are enumerated anew for each query
+    d_musExtractor.reset();
     // Update the SMT mode
     if (d_status.asSatisfiabilityResult().isSat() == Result::UNSAT)
     {
@@ -3851,6 +4590,15 @@ Result SmtEngine::checkSatisfiability(const vector<Expr>& assumptions,
     {
       d_smtMode = SMT_MODE_SAT_UNKNOWN;
     }
+    // Remember the change of the statistics by this query
+    if (options::statistics())
+    {
+      Statistics stats = getStatistics();
+      d_statisticsDelta.reset(new Statistics(
+          d_lastStatistics == nullptr ? stats
+                                      : stats.getDelta(*d_lastStatistics)));
+      d_lastStatistics.reset(new Statistics(stats));
+    }
 
     Trace("smt") << "SmtEngine::" << (isQuery ? "query" : "checkSat") << "("
                  << assumptions << ") => " << r << endl;
@@ -3879,8 +4627,11 @@ Result SmtEngine::checkSatisfiability(const vector<Expr>& assumptions,
     return r;
   } catch (UnsafeInterruptException& e) {
     AlwaysAssert(d_private->getResourceManager()->out());
-    Result::UnknownExplanation why = d_private->getResourceManager()->outOfResources() ?
-      Result::RESOURCEOUT : Result::TIMEOUT;
+    ResourceManager* rm = d_private->getResourceManager();
+    Result::UnknownExplanation why =
+        rm->outOfMemory()
+            ? Result::MEMOUT
+            : rm->outOfResources() ? Result::RESOURCEOUT : Result::TIMEOUT;
     return Result(Result::SAT_UNKNOWN, why, d_filename);
   }
 }
@@ -3936,7 +4687,12 @@ Result SmtEngine::assertFormula(const Expr& ex, bool inUnsatCore)
     d_assertionList->push_back(e);
   }
   bool maybeHasFv = language::isInputLangSygus(options::inputLanguage());
-  d_private->addFormula(e.getNode(), inUnsatCore, true, false, maybeHasFv);
+  Node n = e.getNode();
+  if (options::unsatCoresAssumptions())
+  {
+    n = d_private->guardAssertion(n);
+  }
+  d_private->addFormula(n, inUnsatCore, true, false, maybeHasFv);
   return quickCheck().asValidityResult();
 }/* SmtEngine::assertFormula() */
 
@@ -4236,65 +4992,39 @@ Expr SmtEngine::getValue(const Expr& ex) const
   // Ensure expr is type-checked at this point.
   e.getType(options::typeChecking());
 
-  // do not need to apply preprocessing substitutions (should be recorded
-  // in model already)
+  TheoryModel* m = getAvailableModel("get-value");
+  unordered_map<Node, Node, NodeHashFunction> cache;
+  return d_private->getValue(Node::fromExpr(e), m, cache).toExpr();
+}
 
-  Node n = Node::fromExpr(e);
-  Trace("smt") << "--- getting value of " << n << endl;
-  TypeNode expectedType = n.getType();
+vector<Expr> SmtEngine::getValues(const vector<Expr>& exprs)
+{
+  SmtScope smts(this);
 
-  // Expand, then normalize
-  unordered_map<Node, Node, NodeHashFunction> cache;
-  n = d_private->expandDefinitions(n, cache);
-  // There are two ways model values for terms are computed (for historical
-  // reasons).  One way is that used in check-model; the other is that
-  // used by the Model classes.  It's not clear to me exactly how these
-  // two are different, but they need to be unified.  This ugly hack here
-  // is to fix bug 554 until we can revamp boolean-terms and models [MGD]
+  Trace("smt") << "SMT getValues(" << exprs.size() << " terms)" << endl;
+  if(Dump.isOn("benchmark")) {
+    Dump("benchmark") << GetValueCommand(exprs);
+  }
 
-  //AJR : necessary?
-  if(!n.getType().isFunction()) {
-    n = Rewriter::rewrite(n);
+  vector<Node> nodes;
+  for (const Expr& ex : exprs)
+  {
+    Assert(ex.getExprManager() == d_exprManager);
+    // Substitute out any abstract values in ex.
+    Expr e = d_private->substituteAbstractValues(Node::fromExpr(ex)).toExpr();
+    // Ensure expr is type-checked at this point.
+    e.getType(options::typeChecking());
+    nodes.push_back(Node::fromExpr(e));
   }
 
-  Trace("smt") << "--- getting value of " << n << endl;
+  // The terms share the expansion of definitions, and the model caches the
+  // values of their common subterms.
   TheoryModel* m = getAvailableModel("get-value");
-  Node resultNode;
-  if(m != NULL) {
-    resultNode = m->getValue(n);
-  }
-  Trace("smt") << "--- got value " << n << " = " << resultNode << endl;
-  resultNode = postprocess(resultNode, expectedType);
-  Trace("smt") << "--- model-post returned " << resultNode << endl;
-  Trace("smt") << "--- model-post returned " << resultNode.getType() << endl;
-  Trace("smt") << "--- model-post expected " << expectedType << endl;
-
-  // type-check the result we got
-  // Notice that lambdas have function type, which does not respect the subtype
-  // relation, so we ignore them here.
-  Assert(resultNode.isNull() || resultNode.getKind() == kind::LAMBDA
-         || resultNode.getType().isSubtypeOf(expectedType))
-      << "Run with -t smt for details.";
-
-  // Ensure it's a constant, or a lambda (for uninterpreted functions), or
-  // a choice (for approximate values).
-  Assert(resultNode.getKind() == kind::LAMBDA
-         || resultNode.getKind() == kind::CHOICE || resultNode.isConst());
-
-  if(options::abstractValues() && resultNode.getType().isArray()) {
-    resultNode = d_private->mkAbstractValue(resultNode);
-    Trace("smt") << "--- abstract value >> " << resultNode << endl;
-  }
-
-  return resultNode.toExpr();
-}
-
-vector<Expr> SmtEngine::getValues(const vector<Expr>& exprs)
-{
+  unordered_map<Node, Node, NodeHashFunction> cache;
   vector<Expr> result;
-  for (const Expr& e : exprs)
+  for (const Node& n : nodes)
   {
-    result.push_back(getValue(e));
+    result.push_back(d_private->getValue(n, m, cache).toExpr());
   }
   return result;
 }
@@ -4504,6 +5234,156 @@ Result SmtEngine::blockModelValues(const std::vector<Expr>& exprs)
   return assertFormula(eblocker);
 }
 
+unsigned SmtEngine::enumerateProjectedModels(
+    const std::vector<Expr>& exprs,
+    std::function<bool(const std::vector<Expr>&)> callback,
+    unsigned limit)
+{
+  Trace("smt") << "SMT enumerateProjectedModels()" << endl;
+  SmtScope smts(this);
+
+  finalOptionsAreSet();
+
+  PrettyCheckArgument(
+      !exprs.empty(),
+      "enumerate projected models must be called on non-empty set of terms");
+  if (!options::produceModels())
+  {
+    throw ModalException(
+        "Cannot enumerate models when produce-models options is off.");
+  }
+  if (!options::incrementalSolving())
+  {
+    throw ModalException(
+        "Cannot enumerate models when not solving incrementally (use "
+        "--incremental)");
+  }
+  // the blocking assertions are removed when we are done
+  push();
+  unsigned nmodels = 0;
+  bool minimize = !d_logic.isQuantified();
+  options::ModelCoresMode mcm =
+      options::modelCoresMode() == options::ModelCoresMode::NONE
+          ? options::ModelCoresMode::SIMPLE
+          : options::modelCoresMode();
+  while (limit == 0 || nmodels < limit)
+  {
+    Result r = checkSat();
+    if (r.asSatisfiabilityResult().isSat() != Result::SAT)
+    {
+      break;
+    }
+    TheoryModel* m = getAvailableModel("enumerate projected models");
+    Assert(m != nullptr);
+    std::vector<Expr> eassertsProc = getExpandedAssertions();
+    // The blocking assertions of the previous models are part of the
+    // assertions, hence the models of the minimized values are new.
+    if (minimize && !eassertsProc.empty())
+    {
+      ModelCoreBuilder::setModelCore(eassertsProc, m, mcm);
+    }
+    std::vector<Expr> vals;
+    std::vector<Expr> toBlock;
+    for (const Expr& e : exprs)
+    {
+      Node n = Node::fromExpr(e);
+      if (minimize && n.isVar() && n.getKind() != kind::BOUND_VARIABLE
+          && !m->isModelCoreSymbol(e))
+      {
+        vals.push_back(Expr());
+        continue;
+      }
+      vals.push_back(m->getValue(e));
+      toBlock.push_back(e);
+    }
+    Trace("smt") << "...model #" << nmodels << " blocks " << toBlock.size()
+                 << " of " << exprs.size() << " terms" << endl;
+    nmodels++;
+    if (!callback(vals) || toBlock.empty())
+    {
+      // stopped by the callback, or all models were enumerated
+      break;
+    }
+    Expr eblocker = ModelBlocker::getModelBlocker(
+        eassertsProc, m, options::BlockModelsMode::VALUES, toBlock);
+    assertFormula(eblocker);
+  }
+  pop();
+  return nmodels;
+}
+
+size_t SmtEngine::addObjective(const Expr& term, bool minimize)
+{
+  Trace("smt") << "SMT addObjective(" << term << ", " << minimize << ")"
+               << endl;
+  SmtScope smts(this);
+  finalOptionsAreSet();
+  Type type = term.getType(options::typeChecking());
+  PrettyCheckArgument(type.isReal() || type.isBitVector(),
+                      term,
+                      "objective must be of sort Int, Real or bit-vector");
+  if (d_optSolver == nullptr)
+  {
+    d_optSolver.reset(new smt::OptimizationSolver(this));
+  }
+  return d_optSolver->addObjective(term, minimize, d_userLevels.size());
+}
+
+size_t SmtEngine::assertSoft(const Expr& formula, unsigned weight)
+{
+  Trace("smt") << "SMT assertSoft(" << formula << ", " << weight << ")"
+               << endl;
+  SmtScope smts(this);
+  finalOptionsAreSet();
+  ensureBoolean(formula);
+  PrettyCheckArgument(
+      weight > 0, weight, "soft assertions must have a positive weight");
+  if (!options::unsatAssumptions())
+  {
+    throw ModalException(
+        "Cannot assert soft formulas when produce-unsat-assumptions option "
+        "is off.");
+  }
+  if (d_optSolver == nullptr)
+  {
+    d_optSolver.reset(new smt::OptimizationSolver(this));
+  }
+  return d_optSolver->addSoftAssertion(
+      formula, Integer(weight), d_userLevels.size());
+}
+
+Result SmtEngine::checkOpt()
+{
+  Trace("smt") << "SMT checkOpt()" << endl;
+  SmtScope smts(this);
+  finalOptionsAreSet();
+  if (!options::produceModels())
+  {
+    throw ModalException(
+        "Cannot optimize objectives when produce-models options is off.");
+  }
+  if (!options::incrementalSolving())
+  {
+    throw ModalException(
+        "Cannot optimize objectives when not solving incrementally (use "
+        "--incremental)");
+  }
+  if (d_optSolver == nullptr)
+  {
+    return checkSat();
+  }
+  return d_optSolver->checkOpt();
+}
+
+Expr SmtEngine::getObjectiveValue(size_t i)
+{
+  SmtScope smts(this);
+  PrettyCheckArgument(d_optSolver != nullptr && i < d_optSolver->size(),
+                      i,
+                      "no objective of this index");
+  return d_optSolver->getObjectiveValue(i);
+}
+
 std::pair<Expr, Expr> SmtEngine::getSepHeapAndNilExpr(void)
 {
   if (!d_logic.isTheoryEnabled(THEORY_SEP))
@@ -4584,6 +5464,16 @@ void SmtEngine::checkProof()
 
 UnsatCore SmtEngine::getUnsatCoreInternal()
 {
+  if (options::unsatCoresAssumptions())
+  {
+    if (d_smtMode != SMT_MODE_UNSAT)
+    {
+      throw RecoverableModalException(
+          "Cannot get an unsat core unless immediately preceded by UNSAT/VALID "
+          "response.");
+    }
+    return UnsatCore(this, getAssumptionUnsatCore());
+  }
 #if IS_PROOFS_BUILD
   if (!options::unsatCores())
   {
@@ -4606,6 +5496,79 @@ UnsatCore SmtEngine::getUnsatCoreInternal()
 #endif /* IS_PROOFS_BUILD */
 }
 
+std::vector<Expr> SmtEngine::getAssumptionUnsatCore()
+{
+  std::vector<Node> unsatAssumptions;
+  d_propEngine->getUnsatAssumptions(unsatAssumptions);
+  std::vector<Expr> core;
+  d_private->getGuardedAssertions(unsatAssumptions, core);
+  const context::CDList<Node>& lits = d_private->getActivationLiterals();
+  if (core.empty() && lits.size() > 0)
+  {
+    // The SAT solver found a conflict without any assumption, e.g. if
+    // preprocessing simplified the assertions to false. We conservatively
+    // take all assertions as the core.
+    std::vector<Node> allLits(lits.begin(), lits.end());
+    d_private->getGuardedAssertions(allLits, core);
+  }
+  Trace("unsat-core-assumptions")
+      << "SmtEngine::getAssumptionUnsatCore(): core of size " << core.size()
+      << " from " << lits.size() << " assertions" << endl;
+  if (!options::minimizeUnsatCores())
+  {
+    return core;
+  }
+  std::unique_ptr<smt::MusExtractor> extractor(mkMusExtractor(core));
+  core = extractor->shrink(core);
+  Trace("unsat-core-assumptions")
+      << "SmtEngine::getAssumptionUnsatCore(): minimized core of size "
+      << core.size() << endl;
+  return core;
+}
+
+smt::MusExtractor* SmtEngine::mkMusExtractor(
+    const std::vector<Expr>& assertions)
+{
+  // the subsolvers of the extractor do not know the definitions
+  std::vector<Expr> expanded;
+  std::unordered_map<Node, Node, NodeHashFunction> cache;
+  for (const Expr& e : assertions)
+  {
+    expanded.push_back(
+        d_private->expandDefinitions(Node::fromExpr(e), cache, true).toExpr());
+  }
+  return new smt::MusExtractor(getLogicInfo(), assertions, expanded);
+}
+
+bool SmtEngine::getNextMus(std::vector<Expr>& mus)
+{
+  Trace("smt") << "SMT getNextMus()" << endl;
+  SmtScope smts(this);
+  finalOptionsAreSet();
+  if (!options::unsatCoresAssumptions())
+  {
+    throw ModalException(
+        "Cannot get minimal unsatisfiable subsets when "
+        "unsat-cores-assumptions option is off.");
+  }
+  if (d_smtMode != SMT_MODE_UNSAT)
+  {
+    throw RecoverableModalException(
+        "Cannot get minimal unsatisfiable subsets unless immediately preceded "
+        "by UNSAT/VALID response.");
+  }
+  if (d_musExtractor == nullptr)
+  {
+    const context::CDList<Node>& lits = d_private->getActivationLiterals();
+    std::vector<Node> allLits(lits.begin(), lits.end());
+    std::vector<Expr> assertions;
+    d_private->getGuardedAssertions(allLits, assertions);
+    d_musExtractor.reset(mkMusExtractor(assertions));
+  }
+  mus.clear();
+  return d_musExtractor->getNextMus(mus);
+}
+
 void SmtEngine::checkUnsatCore() {
   Assert(options::unsatCores())
       << "cannot check unsat core if unsat cores are turned off";
@@ -5237,9 +6200,24 @@ bool SmtEngine::getAbduct(const Expr& conj, const Type& grammarType, Expr& abd)
   conjn = conjn.negate();
   d_abdConj = conjn.toExpr();
   asserts.push_back(conjn);
+  // reuse the encoding of the axioms and the grammar if they did not change
+  // since the last call
+  TypeNode abdGType = TypeNode::fromType(grammarType);
+  if (d_abdSession == nullptr)
+  {
+    d_abdSession.reset(new theory::quantifiers::SygusAbduct);
+  }
+  if (!d_abdSession->isInitializedFor(axioms, abdGType))
+  {
+    d_abdSession->initialize(axioms, abdGType);
+  }
+  else
+  {
+    Trace("sygus-abduct") << "SmtEngine::getAbduct: reuse the encoding of the "
+                          << axioms.size() << " assertions" << std::endl;
+  }
   std::string name("A");
-  Node aconj = theory::quantifiers::SygusAbduct::mkAbductionConjecture(
-      name, asserts, axioms, TypeNode::fromType(grammarType));
+  Node aconj = d_abdSession->mkConjecture(name, asserts);
   // should be a quantified conjecture with one function-to-synthesize
   Assert(aconj.getKind() == kind::FORALL && aconj[0].getNumChildren() == 1);
   // remember the abduct-to-synthesize
@@ -5394,6 +6372,40 @@ vector<Expr> SmtEngine::getAssertions() {
   return vector<Expr>(d_assertionList->begin(), d_assertionList->end());
 }
 
+void SmtEngine::forkFrom(SmtEngine& parent)
+{
+  SmtScope smts(this);
+  PrettyCheckArgument(parent.d_exprManager == d_exprManager,
+                      parent,
+                      "Cannot fork an SmtEngine with a different ExprManager.");
+  if (d_fullyInited)
+  {
+    throw ModalException(
+        "Cannot fork into an SmtEngine after the engine has finished "
+        "initializing.");
+  }
+  Trace("smt") << "SMT forkFrom()" << endl;
+  // this fully initializes parent, and throws if it has no assertion list
+  std::vector<Expr> assertions = parent.getAssertions();
+  setLogic(parent.d_logic.getUnlockedCopy());
+  for (const Command* c : parent.d_modelGlobalCommands)
+  {
+    d_modelGlobalCommands.push_back(c->clone());
+  }
+  for (const Command* c : *parent.d_modelCommands)
+  {
+    d_modelCommands->push_back(c->clone());
+  }
+  for (const auto& def : *parent.d_definedFunctions)
+  {
+    d_definedFunctions->insert(def.first, def.second);
+  }
+  for (const Expr& e : assertions)
+  {
+    assertFormula(e);
+  }
+}
+
 void SmtEngine::push()
 {
   SmtScope smts(this);
@@ -5449,6 +6461,10 @@ void SmtEngine::pop() {
     internalPop(true);
   }
   d_userLevels.pop_back();
+  if (d_optSolver != nullptr)
+  {
+    d_optSolver->pop(d_userLevels.size());
+  }
 
   // Clear out assertion queues etc., in case anything is still in there
   d_private->notifyPop();
@@ -5520,6 +6536,18 @@ void SmtEngine::reset()
   new(this) SmtEngine(em);
 }
 
+void SmtEngine::recycle()
+{
+  Trace("smt") << "SMT recycle()" << endl;
+  LogicInfo logic = d_userLogic;
+  bool logicSet = d_userLogicSet;
+  reset();
+  if (logicSet)
+  {
+    setLogic(logic);
+  }
+}
+
 void SmtEngine::resetAssertions()
 {
   SmtScope smts(this);
@@ -5533,6 +6561,7 @@ void SmtEngine::resetAssertions()
   while(!d_userLevels.empty()) {
     pop();
   }
+  d_optSolver.reset();
 
   // Also remember the global push/pop around everything.
   Assert(d_userLevels.size() == 0 && d_userContext->getLevel() == 1);
@@ -5558,6 +6587,13 @@ void SmtEngine::setResourceLimit(unsigned long units, bool cumulative) {
 void SmtEngine::setTimeLimit(unsigned long milis, bool cumulative) {
   d_private->getResourceManager()->setTimeLimit(milis, cumulative);
 }
+ListenerCollection::Registration* SmtEngine::registerProgressListener(
+    Listener* listener, uint64_t interval)
+{
+  ResourceManager* rm = d_private->getResourceManager();
+  rm->setProgressInterval(interval);
+  return rm->registerProgressListener(listener);
+}
 
 unsigned long SmtEngine::getResourceUsage() const {
   return d_private->getResourceManager()->getResourceUsage();
@@ -5587,6 +6623,17 @@ SExpr SmtEngine::getStatistic(std::string name) const
   return d_statisticsRegistry->getStatistic(name);
 }
 
+Statistics SmtEngine::getStatisticsDelta() const
+{
+  if (d_statisticsDelta == nullptr)
+  {
+    throw ModalException(
+        "Cannot get the change of the statistics unless statistics are "
+        "enabled (try --stats) and a query was made.");
+  }
+  return *d_statisticsDelta;
+}
+
 void SmtEngine::safeFlushStatistics(int fd) const {
   d_statisticsRegistry->safeFlushInformation(fd);
 }
@@ -5673,6 +6720,9 @@ void SmtEngine::setOption(const std::string& key, const CVC4::SExpr& value)
 }
 
 void SmtEngine::setIsInternalSubsolver() { d_isInternalSubsolver = true; }
+
+bool SmtEngine::isInternalSubsolver() const { return d_isInternalSubsolver; }
+
 CVC4::SExpr SmtEngine::getOption(const std::string& key) const
 {
   NodeManagerScope nms(d_nodeManager);
@@ -19,9 +19,11 @@
 #ifndef CVC4__SMT_ENGINE_H
 #define CVC4__SMT_ENGINE_H
 
+#include <functional>
 #include <string>
 #include <vector>
 
+#include "base/listener.h"
 #include "base/modal_exception.h"
 #include "context/cdhashmap_forward.h"
 #include "context/cdhashset_forward.h"
@@ -97,6 +99,8 @@ namespace smt {
 
   struct SmtEngineStatistics;
   class SmtEnginePrivate;
+  class MusExtractor;
+  class OptimizationSolver;
   class SmtScope;
   class BooleanTermConverter;
 
@@ -110,6 +114,9 @@ namespace smt {
 
 namespace theory {
   class TheoryModel;
+  namespace quantifiers {
+  class SygusAbduct;
+  }/* CVC4::theory::quantifiers namespace */
 }/* CVC4::theory namespace */
 
 // TODO: SAT layer (esp. CNF- versus non-clausal solvers under the
@@ -204,6 +211,8 @@ class CVC4_PUBLIC SmtEngine
    * --sygus-abduct.
    */
   void setIsInternalSubsolver();
+  /** Is this an internal subsolver (see setIsInternalSubsolver)? */
+  bool isInternalSubsolver() const;
 
   /** set the input name */
   void setFilename(std::string filename);
@@ -242,6 +251,64 @@ class CVC4_PUBLIC SmtEngine
    */
   Result blockModelValues(const std::vector<Expr>& exprs);
 
+  /**
+   * Enumerate the models of the current assertions projected on exprs. Only
+   * permitted if produce-models and incremental solving are on.
+   *
+   * This repeatedly checks satisfiability and calls callback with the values
+   * of exprs in the model found, then blocks these values. If the logic is
+   * quantifier-free, the values are first minimized: a value is replaced by
+   * the null expression if exprs[i] is a free constant whose value does not
+   * matter for the assertions to hold (see ModelCoreBuilder), and is not
+   * blocked. Each call to callback thus stands for a set of models, and these
+   * sets are disjoint.
+   *
+   * The enumeration stops when there are no more models, when the
+   * satisfiability of the assertions is unknown, when callback returns false
+   * or when limit (if non-zero) calls to callback were made. The blocking
+   * assertions are then removed. Returns the number of calls to callback.
+   */
+  unsigned enumerateProjectedModels(
+      const std::vector<Expr>& exprs,
+      std::function<bool(const std::vector<Expr>&)> callback,
+      unsigned limit = 0);
+
+  /**
+   * Add the objective to minimize (or maximize) term, which must be of sort
+   * Int, Real or bit-vector (interpreted as unsigned). The objectives are
+   * optimized by checkOpt(), lexicographically in the order in which they
+   * were added, and are removed when popping the user level at which they
+   * were added. Returns the index of the objective.
+   */
+  size_t addObjective(const Expr& term, bool minimize);
+
+  /**
+   * Add the soft assertion formula with the given positive weight. The soft
+   * assertions form a single objective, added with the first of them, which
+   * is the total weight of the violated soft assertions to minimize. Soft
+   * assertions are removed when popping the user level at which they were
+   * added. Requires produce-unsat-assumptions. Returns the index of the
+   * objective of the soft assertions.
+   */
+  size_t assertSoft(const Expr& formula, unsigned weight);
+
+  /**
+   * Check satisfiability and optimize the objectives. Only permitted if
+   * produce-models and incremental solving are on. The result is SAT if the
+   * objectives were all shown optimal, and unknown if the optimum of one of
+   * them was not shown (see option opt-max-checks), in which case the
+   * model realizes the best values found, if the assertions are satisfiable.
+   * The assertions are not changed.
+   */
+  Result checkOpt();
+
+  /**
+   * Get the value of objective i found by the last call to checkOpt(), or the
+   * null expression if there is none. The value of the objective of the soft
+   * assertions is the total weight of the soft assertions that do not hold.
+   */
+  Expr getObjectiveValue(size_t i);
+
   /** When using separation logic, obtain the expression for the heap.  */
   Expr getSepHeapExpr();
 
@@ -630,12 +697,34 @@ class CVC4_PUBLIC SmtEngine
    */
   UnsatCore getUnsatCore();
 
+  /**
+   * Get a minimal unsatisfiable subset (MUS) of the assertions that was not
+   * returned by a previous call since the last UNSAT or VALID query (only if
+   * immediately preceded by such a query). Returns false if there is no such
+   * MUS. Only permitted if unsat-cores-assumptions is on.
+   */
+  bool getNextMus(std::vector<Expr>& mus);
+
   /**
    * Get the current set of assertions.  Only permitted if the
    * SmtEngine is set to operate interactively.
    */
   std::vector<Expr> getAssertions();
 
+  /**
+   * Make this SmtEngine a fork of parent, which must use the same
+   * ExprManager: this SmtEngine gets the logic, the declarations, the
+   * defined functions and the current assertions of parent, the latter at
+   * its base level. This SmtEngine must not be fully initialized yet. Only
+   * permitted if parent is set to operate interactively.
+   *
+   * The assertions are preprocessed and solved again by this SmtEngine, it
+   * does not share the internal state of parent.
+   *
+   * @throw ModalException
+   */
+  void forkFrom(SmtEngine& parent);
+
   /**
    * Push a user-level context.
    * throw@ ModalException, LogicException, UnsafeInterruptException
@@ -658,6 +747,15 @@ class CVC4_PUBLIC SmtEngine
   /** Reset all assertions, global declarations, etc.  */
   void resetAssertions();
 
+  /**
+   * Reset the solver for an independent query, as reset() followed by
+   * setLogic() with the logic that was set, if any. This is meant for pools
+   * of solvers: the nodes of the ExprManager are kept, and so are the chunks
+   * of the context memory managers (see ContextMemoryManager), so that the
+   * next query reuses the memory of the previous ones.
+   */
+  void recycle();
+
   /**
    * Interrupt a running query.  This can be called from another thread
    * or from a signal handler.  Throws a ModalException if the SmtEngine
@@ -732,6 +830,18 @@ class CVC4_PUBLIC SmtEngine
    */
   void setTimeLimit(unsigned long millis, bool cumulative = false);
 
+  /**
+   * Register a listener that is notified periodically while this SmtEngine
+   * is working, namely every interval times resources are spent. The
+   * listener is notified by the thread running the SmtEngine, and may for
+   * instance interrupt() it or inspect its statistics. The returned
+   * Registration takes over the memory of the listener, and must be
+   * destroyed before this SmtEngine. The interval is shared by all progress
+   * listeners of the SmtEngines of the same ExprManager.
+   */
+  ListenerCollection::Registration* registerProgressListener(
+      Listener* listener, uint64_t interval);
+
   /**
    * Get the current resource usage count for this SmtEngine.  This
    * function can be used to ascertain reasonable values to pass as
@@ -771,6 +881,15 @@ class CVC4_PUBLIC SmtEngine
   /** Get the value of one named statistic from this SmtEngine. */
   SExpr getStatistic(std::string name) const;
 
+  /**
+   * Get the change of the statistics of this SmtEngine from the query before
+   * the last query (or the start) to the last query, see
+   * Statistics::getDelta.
+   *
+   * @throw ModalException if statistics are disabled or no query was made
+   */
+  Statistics getStatisticsDelta() const;
+
   /** Flush statistic from this SmtEngine. Safe to use in a signal handler. */
   void safeFlushStatistics(int fd) const;
 
@@ -870,11 +989,25 @@ class CVC4_PUBLIC SmtEngine
   /**
    * Internal method to get an unsatisfiable core (only if immediately preceded
    * by an UNSAT or VALID query). Only permitted if CVC4 was built with
-   * unsat-core support and produce-unsat-cores is on. Does not dump the
-   * command.
+   * unsat-core support and produce-unsat-cores is on, or if
+   * unsat-cores-assumptions is on. Does not dump the command.
    */
   UnsatCore getUnsatCoreInternal();
 
+  /**
+   * Get the unsatisfiable core of the last UNSAT or VALID query from the
+   * activation literals of the assertions in the final conflict of the SAT
+   * solver. If minimize-unsat-cores is on, the core is minimized by removing
+   * its assertions one at a time.
+   */
+  std::vector<Expr> getAssumptionUnsatCore();
+
+  /**
+   * Make an extractor of minimal unsatisfiable subsets of the given
+   * assertions, with their definitions expanded.
+   */
+  smt::MusExtractor* mkMusExtractor(const std::vector<Expr>& assertions);
+
   /**
    * Check that an unsatisfiable core is indeed unsatisfiable.
    */
@@ -1094,6 +1227,30 @@ class CVC4_PUBLIC SmtEngine
    */
   std::unique_ptr<SmtEngine> d_subsolver;
 
+  /**
+   * The encoding of the assertions and the grammar of the last get-abduct
+   * command. It is reused by the next get-abduct commands for as long as they
+   * are the same, so that only their goals are encoded anew.
+   */
+  std::unique_ptr<theory::quantifiers::SygusAbduct> d_abdSession;
+
+  /**
+   * The enumerator of minimal unsatisfiable subsets of the assertions of the
+   * last UNSAT or VALID query, if getNextMus() was called since.
+   */
+  std::unique_ptr<smt::MusExtractor> d_musExtractor;
+
+  /** The objectives of checkOpt(), if any were added */
+  std::unique_ptr<smt::OptimizationSolver> d_optSolver;
+
+  /** The statistics after the last query, if statistics are enabled */
+  std::unique_ptr<Statistics> d_lastStatistics;
+  /**
+   * The change of the statistics from the query before the last query (or
+   * the start) to the last query, if statistics are enabled.
+   */
+  std::unique_ptr<Statistics> d_statisticsDelta;
+
   /**
    * If applicable, the function-to-synthesize that the subsolver is solving
    * for. This is used for the get-abduct command.
@@ -1163,6 +1320,13 @@ class CVC4_PUBLIC SmtEngine
    */
   LogicInfo d_logic;
 
+  /**
+   * The logic set by the user, before it is extended by setDefaults() (for
+   * recycle()), valid if d_userLogicSet.
+   */
+  LogicInfo d_userLogic;
+  bool d_userLogicSet;
+
   /**
    * Keep a copy of the original option settings (for reset()).
    */
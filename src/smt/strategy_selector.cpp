@@ -0,0 +1,237 @@
+/*********************                                                        */
+/*! \file strategy_selector.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the selection of the options of a query
+ **/
+
+#include "smt/strategy_selector.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#include "base/output.h"
+#include "options/option_exception.h"
+
+using namespace CVC4::kind;
+
+namespace CVC4 {
+namespace smt {
+
+namespace {
+
+/** The names of the features, in the order of StrategySelector::Feature */
+const char* s_featureNames[] = {
+    "assertions", "nodes", "quantifiers", "bv-width", "mults", "ite-depth"};
+
+/** Returns true if n is a multiplication of at least two non-constants */
+bool isNonLinearMult(TNode n)
+{
+  Kind k = n.getKind();
+  if (k != MULT && k != NONLINEAR_MULT && k != BITVECTOR_MULT)
+  {
+    return false;
+  }
+  size_t nonConst = 0;
+  for (TNode c : n)
+  {
+    if (!c.isConst())
+    {
+      nonConst++;
+    }
+  }
+  return nonConst >= 2;
+}
+
+}  // namespace
+
+StrategySelector::StrategySelector()
+{
+  std::fill(d_features, d_features + NUM_FEATURES, 0);
+}
+
+void StrategySelector::loadTable(const std::string& filename)
+{
+  std::ifstream in(filename);
+  if (!in)
+  {
+    throw OptionException("cannot read the strategy table " + filename);
+  }
+  loadTable(in, filename);
+}
+
+void StrategySelector::loadTable(std::istream& in, const std::string& name)
+{
+  d_table.clear();
+  std::string line;
+  for (size_t lineNum = 1; std::getline(in, line); lineNum++)
+  {
+    std::stringstream ss(line);
+    std::string token;
+    if (!(ss >> token) || token[0] == '#')
+    {
+      continue;
+    }
+    std::stringstream where;
+    where << name << ":" << lineNum << ": ";
+    Strategy s;
+    s.d_name = token;
+    bool inOptions = false;
+    while (ss >> token)
+    {
+      if (!inOptions)
+      {
+        if (token == ":")
+        {
+          inOptions = true;
+          continue;
+        }
+        size_t pos = token.find_first_of("<>");
+        if (pos == std::string::npos || pos + 1 >= token.size()
+            || token[pos + 1] != '=')
+        {
+          throw OptionException(where.str() + "expected a condition, not "
+                                + token);
+        }
+        Condition c;
+        const char** fn =
+            std::find(s_featureNames, s_featureNames + NUM_FEATURES,
+                      token.substr(0, pos));
+        if (fn == s_featureNames + NUM_FEATURES)
+        {
+          throw OptionException(where.str() + "unknown feature "
+                                + token.substr(0, pos));
+        }
+        c.d_feature = static_cast<Feature>(fn - s_featureNames);
+        c.d_upper = token[pos] == '<';
+        std::stringstream bs(token.substr(pos + 2));
+        if (!(bs >> c.d_bound) || !bs.eof())
+        {
+          throw OptionException(where.str() + "bad bound in " + token);
+        }
+        s.d_conditions.push_back(c);
+      }
+      else
+      {
+        size_t pos = token.find('=');
+        if (pos == std::string::npos || pos == 0)
+        {
+          throw OptionException(where.str() + "expected an option, not "
+                                + token);
+        }
+        s.d_options.emplace_back(token.substr(0, pos), token.substr(pos + 1));
+      }
+    }
+    if (!inOptions)
+    {
+      throw OptionException(where.str() + "missing : before the options");
+    }
+    d_table.push_back(s);
+  }
+}
+
+void StrategySelector::addAssertions(const std::vector<Node>& assertions)
+{
+  d_features[NUM_ASSERTIONS] += assertions.size();
+  // the ITE depth of the visited nodes
+  std::unordered_map<TNode, uint64_t, TNodeHashFunction> visited;
+  std::vector<TNode> visit(assertions.begin(), assertions.end());
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    std::unordered_map<TNode, uint64_t, TNodeHashFunction>::iterator it =
+        visited.find(cur);
+    if (it == visited.end())
+    {
+      // pre-visit: count the node, then visit its children
+      visited[cur] = 0;
+      d_features[NUM_NODES]++;
+      Kind k = cur.getKind();
+      if (k == FORALL || k == EXISTS)
+      {
+        d_features[NUM_QUANTIFIERS]++;
+      }
+      else if (isNonLinearMult(cur))
+      {
+        d_features[NUM_MULTS]++;
+      }
+      TypeNode tn = cur.getType();
+      if (tn.isBitVector())
+      {
+        d_features[MAX_BV_WIDTH] = std::max<uint64_t>(d_features[MAX_BV_WIDTH],
+                                                      tn.getBitVectorSize());
+      }
+      visit.insert(visit.end(), cur.begin(), cur.end());
+      continue;
+    }
+    visit.pop_back();
+    if (it->second == 0)
+    {
+      // post-visit: the children pushed by the pre-visit of cur have been
+      // post-visited, and a DAG has no other unfinished nodes below cur
+      uint64_t depth = 0;
+      for (TNode c : cur)
+      {
+        depth = std::max(depth, visited[c] - 1);
+      }
+      if (cur.getKind() == ITE)
+      {
+        depth++;
+      }
+      // the depth is stored shifted by one, 0 marks unfinished nodes
+      it->second = depth + 1;
+      d_features[MAX_ITE_DEPTH] = std::max(d_features[MAX_ITE_DEPTH], depth);
+    }
+  }
+}
+
+bool StrategySelector::applies(const Strategy& s) const
+{
+  for (const Condition& c : s.d_conditions)
+  {
+    uint64_t v = d_features[c.d_feature];
+    if (c.d_upper ? v > c.d_bound : v < c.d_bound)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string StrategySelector::select(Options& opts)
+{
+  if (Trace.isOn("strategy"))
+  {
+    Trace("strategy") << "StrategySelector::select, features:";
+    for (size_t i = 0; i < NUM_FEATURES; i++)
+    {
+      Trace("strategy") << " " << s_featureNames[i] << "=" << d_features[i];
+    }
+    Trace("strategy") << std::endl;
+  }
+  for (const Strategy& s : d_table)
+  {
+    if (!applies(s))
+    {
+      continue;
+    }
+    Trace("strategy") << "...select " << s.d_name << std::endl;
+    for (const std::pair<std::string, std::string>& o : s.d_options)
+    {
+      opts.setOption(o.first, o.second);
+    }
+    return s.d_name;
+  }
+  Trace("strategy") << "...no strategy applies" << std::endl;
+  return "";
+}
+
+}  // namespace smt
+}  // namespace CVC4
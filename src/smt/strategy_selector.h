@@ -0,0 +1,122 @@
+/*********************                                                        */
+/*! \file strategy_selector.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Selection of the options of a query based on its features
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__SMT__STRATEGY_SELECTOR_H
+#define CVC4__SMT__STRATEGY_SELECTOR_H
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "expr/node.h"
+#include "options/options.h"
+
+namespace CVC4 {
+namespace smt {
+
+/**
+ * Selects the options of each query from a table of strategies, e.g. learned
+ * offline, based on cheap syntactic features of the asserted formulas.
+ *
+ * The table is a text file with one strategy per line:
+ *   <name> <feature><op><bound>* : <option>=<value>*
+ * where <op> is <= or >=, and the features are:
+ *   assertions   the number of assertions,
+ *   nodes        the number of nodes of the assertions,
+ *   quantifiers  the number of quantified formulas,
+ *   bv-width     the largest bit-vector width,
+ *   mults        the number of non-linear multiplications,
+ *   ite-depth    the largest nesting depth of term and formula ITEs.
+ * Empty lines and lines starting with # are ignored. The first strategy
+ * whose conditions all hold is selected, hence a strategy without conditions
+ * is the default for the following ones.
+ *
+ * The features are accumulated over all the formulas asserted so far (they
+ * are not decreased on pop). The options of the selected strategy are set
+ * before preprocessing, and stay set for the following queries unless they
+ * are set again, hence the strategies of a table should set the same
+ * options. Options that are only read when the solver is initialized (e.g.
+ * the theories or the modules that are enabled) are not affected, the table
+ * should consist of preprocessing and search options.
+ */
+class StrategySelector
+{
+ public:
+  /** The features of the input */
+  enum Feature
+  {
+    NUM_ASSERTIONS,
+    NUM_NODES,
+    NUM_QUANTIFIERS,
+    MAX_BV_WIDTH,
+    NUM_MULTS,
+    MAX_ITE_DEPTH,
+    NUM_FEATURES
+  };
+
+  StrategySelector();
+
+  /**
+   * Load the table of strategies from the file with the given name. Throws an
+   * OptionException if it cannot be read, or if it is malformed, e.g. if it
+   * refers to an unknown feature.
+   */
+  void loadTable(const std::string& filename);
+  /** Load the table of strategies from in, name is used in error messages */
+  void loadTable(std::istream& in, const std::string& name);
+
+  /** Add the features of the given assertions to the features of the input */
+  void addAssertions(const std::vector<Node>& assertions);
+  /** Get the value of feature f of the input */
+  uint64_t getFeature(Feature f) const { return d_features[f]; }
+
+  /**
+   * Select the strategy of the features of the input, and set its options in
+   * opts. Returns the name of the strategy, or the empty string if no
+   * strategy applies. Throws an OptionException if an option of the strategy
+   * is unknown, or cannot be set to its value.
+   */
+  std::string select(Options& opts);
+
+ private:
+  /** A condition on a feature of the input */
+  struct Condition
+  {
+    Feature d_feature;
+    /** Whether the condition is an upper bound, or a lower bound */
+    bool d_upper;
+    uint64_t d_bound;
+  };
+  /** A strategy, i.e. a line of the table */
+  struct Strategy
+  {
+    std::string d_name;
+    std::vector<Condition> d_conditions;
+    std::vector<std::pair<std::string, std::string>> d_options;
+  };
+  /** Whether the conditions of s hold */
+  bool applies(const Strategy& s) const;
+
+  /** The table */
+  std::vector<Strategy> d_table;
+  /** The features of the input */
+  uint64_t d_features[NUM_FEATURES];
+}; /* class StrategySelector */
+
+}  // namespace smt
+}  // namespace CVC4
+
+#endif /* CVC4__SMT__STRATEGY_SELECTOR_H */
@@ -15,6 +15,7 @@
  **/
 #include "smt/term_formula_removal.h"
 
+#include <unordered_map>
 #include <vector>
 
 #include "expr/node_algorithm.h"
@@ -54,190 +55,292 @@ void RemoveTermFormulas::run(std::vector<Node>& output, IteSkolemMap& iteSkolemM
   }
 }
 
-Node RemoveTermFormulas::run(TNode node, std::vector<Node>& output,
-                    IteSkolemMap& iteSkolemMap, bool inQuant, bool inTerm) {
-  // Current node
-  Debug("ite") << "removeITEs(" << node << ")" << " " << inQuant << " " << inTerm << endl;
+namespace {
 
-  //if(node.isVar() || node.isConst()){
-  //   (options::biasedITERemoval() && !containsTermITE(node))){
-  //if(node.isVar()){
-  //  return Node(node);
-  //}
-  if( node.getKind()==kind::INST_PATTERN_LIST ){
-    return Node(node);
+/** A node to visit in the traversals of RemoveTermFormulas */
+struct TermFormulaFrame
+{
+  TermFormulaFrame(TNode n, bool inQuant, bool inTerm)
+      : d_node(n),
+        d_inQuant(inQuant),
+        d_inTerm(inTerm),
+        d_childInQuant(inQuant),
+        d_childInTerm(inTerm),
+        d_expanded(false)
+  {
   }
+  /** The node */
+  TNode d_node;
+  /** The flags the node is visited with */
+  bool d_inQuant;
+  bool d_inTerm;
+  /** The flags the children of the node are visited with */
+  bool d_childInQuant;
+  bool d_childInTerm;
+  /** Whether the children of the node were pushed */
+  bool d_expanded;
+};
+
+}  // namespace
 
-  // The result may be cached already
-  int cv = cacheVal( inQuant, inTerm );
-  std::pair<Node, int> cacheKey(node, cv);
-  NodeManager *nodeManager = NodeManager::currentNM();
-  TermFormulaCache::const_iterator i = d_tfCache.find(cacheKey);
-  if (i != d_tfCache.end())
+Node RemoveTermFormulas::run(TNode node, std::vector<Node>& output,
+                    IteSkolemMap& iteSkolemMap, bool inQuant, bool inTerm) {
+  std::vector<std::pair<Node, Node> > newDefs;
+  Node ret = runInternal(node, inQuant, inTerm, newDefs);
+  // Remove term formulas from the definitions of the skolems introduced
+  // above, which may introduce further skolems. This is done here rather than
+  // in runInternal, so that chains of nested term ites do not lead to
+  // recursion.
+  for (size_t i = 0; i < newDefs.size(); ++i)
   {
-    Node cached = (*i).second;
-    Debug("ite") << "removeITEs: in-cache: " << cached << endl;
-    return cached.isNull() ? Node(node) : cached;
+    Node skolem = newDefs[i].first;
+    Node newAssertion = newDefs[i].second;
+    newAssertion = runInternal(newAssertion, false, false, newDefs);
+    iteSkolemMap[skolem] = output.size();
+    output.push_back(newAssertion);
   }
+  return ret;
+}
 
-
-  TypeNode nodeType = node.getType();
-  Node skolem;
-  Node newAssertion;
-  // Handle non-Boolean ITEs here. Boolean ones (within terms) are handled
-  // in the "non-variable Boolean term within term" case below.
-  if (node.getKind() == kind::ITE && !nodeType.isBoolean())
+Node RemoveTermFormulas::runInternal(
+    TNode node,
+    bool inQuant,
+    bool inTerm,
+    std::vector<std::pair<Node, Node> >& newDefs)
+{
+  NodeManager* nodeManager = NodeManager::currentNM();
+  std::vector<TermFormulaFrame> toVisit;
+  toVisit.push_back(TermFormulaFrame(node, inQuant, inTerm));
+  while (!toVisit.empty())
   {
-    // Here, we eliminate the ITE if we are not Boolean and if we do not contain
-    // a bound variable.
-    if (!inQuant || !expr::hasBoundVar(node))
+    TermFormulaFrame& f = toVisit.back();
+    TNode cur = f.d_node;
+    std::pair<Node, int> cacheKey(cur, cacheVal(f.d_inQuant, f.d_inTerm));
+    if (!f.d_expanded)
     {
-      skolem = getSkolemForNode(node);
-      if (skolem.isNull())
+      // The result may be cached already
+      if (d_tfCache.find(cacheKey) != d_tfCache.end())
       {
-        // Make the skolem to represent the ITE
-        skolem = nodeManager->mkSkolem(
-            "termITE",
-            nodeType,
-            "a variable introduced due to term-level ITE removal");
-        d_skolem_cache.insert(node, skolem);
-
-        // The new assertion
-        newAssertion = nodeManager->mkNode(
-            kind::ITE, node[0], skolem.eqNode(node[1]), skolem.eqNode(node[2]));
+        toVisit.pop_back();
+        continue;
       }
-    }
-  }
-  else if (node.getKind() == kind::LAMBDA)
-  {
-    // if a lambda, do lambda-lifting
-    if (!inQuant)
-    {
-      skolem = getSkolemForNode(node);
-      if (skolem.isNull())
+      Debug("ite") << "removeITEs(" << cur << ")"
+                   << " " << f.d_inQuant << " " << f.d_inTerm << endl;
+      if (cur.getKind() == kind::INST_PATTERN_LIST)
       {
-        // Make the skolem to represent the lambda
-        skolem = nodeManager->mkSkolem(
-            "lambdaF",
-            nodeType,
-            "a function introduced due to term-level lambda removal");
-        d_skolem_cache.insert(node, skolem);
-
-        // The new assertion
-        std::vector<Node> children;
-        // bound variable list
-        children.push_back(node[0]);
-        // body
-        std::vector<Node> skolem_app_c;
-        skolem_app_c.push_back(skolem);
-        skolem_app_c.insert(skolem_app_c.end(), node[0].begin(), node[0].end());
-        Node skolem_app = nodeManager->mkNode(kind::APPLY_UF, skolem_app_c);
-        children.push_back(skolem_app.eqNode(node[1]));
-        // axiom defining skolem
-        newAssertion = nodeManager->mkNode(kind::FORALL, children);
+        d_tfCache.insert(cacheKey, Node::null());
+        toVisit.pop_back();
+        continue;
       }
-    }
-  }
-  else if (node.getKind() == kind::CHOICE)
-  {
-    // If a Hilbert choice function, witness the choice.
-    //   For details on this operator, see
-    //   http://planetmath.org/hilbertsvarepsilonoperator.
-    if (!inQuant)
-    {
-      skolem = getSkolemForNode(node);
-      if (skolem.isNull())
+      Node newAssertion;
+      Node skolem =
+          getSkolemReplacement(cur, f.d_inQuant, f.d_inTerm, newAssertion);
+      // if the term should be replaced by a skolem
+      if (!skolem.isNull())
       {
-        // Make the skolem to witness the choice
-        skolem = nodeManager->mkSkolem(
-            "choiceK",
-            nodeType,
-            "a skolem introduced due to term-level Hilbert choice removal");
-        d_skolem_cache.insert(node, skolem);
-
-        Assert(node[0].getNumChildren() == 1);
-
-        // The new assertion is the assumption that the body
-        // of the choice operator holds for the Skolem
-        newAssertion = node[1].substitute(node[0][0], skolem);
+        // Attach the skolem
+        d_tfCache.insert(cacheKey, skolem);
+        // if the definition of the skolem is new in this user context
+        if (!newAssertion.isNull())
+        {
+          Debug("ite") << "*** term formula removal introduced " << skolem
+                       << " for " << cur << std::endl;
+          newDefs.push_back(std::make_pair(skolem, newAssertion));
+        }
+        toVisit.pop_back();
+        continue;
+      }
+      if (cur.isClosure())
+      {
+        // Remember if we're inside a quantifier
+        f.d_childInQuant = true;
+      }
+      else if (!f.d_inTerm && hasNestedTermChildren(cur))
+      {
+        // Remember if we're inside a term
+        Debug("ite") << "In term because of " << cur << " " << cur.getKind()
+                     << std::endl;
+        f.d_childInTerm = true;
       }
+      f.d_expanded = true;
+      bool childInQuant = f.d_childInQuant;
+      bool childInTerm = f.d_childInTerm;
+      int childCv = cacheVal(childInQuant, childInTerm);
+      // Push the children in reverse, so that they are processed in order.
+      // Notice that f may be invalidated by the pushes.
+      for (size_t i = cur.getNumChildren(); i > 0; --i)
+      {
+        TNode child = cur[i - 1];
+        if (d_tfCache.find(std::make_pair(Node(child), childCv))
+            == d_tfCache.end())
+        {
+          toVisit.push_back(TermFormulaFrame(child, childInQuant, childInTerm));
+        }
+      }
+      continue;
     }
-  }
-  else if (node.getKind() != kind::BOOLEAN_TERM_VARIABLE && nodeType.isBoolean()
-           && inTerm
-           && !inQuant)
-  {
-    // if a non-variable Boolean term within another term, replace it
-    skolem = getSkolemForNode(node);
-    if (skolem.isNull())
-    {
-      // Make the skolem to represent the Boolean term
-      // Skolems introduced for Boolean formulas appearing in terms have a
-      // special kind (BOOLEAN_TERM_VARIABLE) that ensures they are handled
-      // properly in theory combination. We must use this kind here instead of a
-      // generic skolem.
-      skolem = nodeManager->mkBooleanTermVariable();
-      d_skolem_cache.insert(node, skolem);
+    int childCv = cacheVal(f.d_childInQuant, f.d_childInTerm);
+    toVisit.pop_back();
 
-      // The new assertion
-      newAssertion = skolem.eqNode(node);
+    // Remove the term formulas from the children
+    vector<Node> newChildren;
+    bool somethingChanged = false;
+    if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+    {
+      newChildren.push_back(cur.getOperator());
     }
-  }
-
-  // if the term should be replaced by a skolem
-  if( !skolem.isNull() ){
-    // Attach the skolem
-    d_tfCache.insert(cacheKey, skolem);
-
-    // if the skolem was introduced in this call
-    if (!newAssertion.isNull())
+    for (TNode::const_iterator it = cur.begin(), end = cur.end(); it != end;
+         ++it)
     {
-      Debug("ite") << "*** term formula removal introduced " << skolem
-                   << " for " << node << std::endl;
-
-      // Remove ITEs from the new assertion, rewrite it and push it to the
-      // output
-      newAssertion = run(newAssertion, output, iteSkolemMap, false, false);
+      TermFormulaCache::const_iterator itc =
+          d_tfCache.find(std::make_pair(Node(*it), childCv));
+      Assert(itc != d_tfCache.end());
+      Node newChild = (*itc).second.isNull() ? Node(*it) : (*itc).second;
+      somethingChanged |= (newChild != *it);
+      newChildren.push_back(newChild);
+    }
 
-      iteSkolemMap[skolem] = output.size();
-      output.push_back(newAssertion);
+    // If changes, we rewrite
+    if (somethingChanged)
+    {
+      d_tfCache.insert(cacheKey, nodeManager->mkNode(cur.getKind(), newChildren));
+    }
+    else
+    {
+      d_tfCache.insert(cacheKey, Node::null());
     }
+  }
+  TermFormulaCache::const_iterator itc =
+      d_tfCache.find(std::make_pair(Node(node), cacheVal(inQuant, inTerm)));
+  Assert(itc != d_tfCache.end());
+  Node cached = (*itc).second;
+  Debug("ite") << "removeITEs: result: " << cached << endl;
+  return cached.isNull() ? Node(node) : cached;
+}
 
-    // The representation is now the skolem
+Node RemoveTermFormulas::getSkolemReplacement(TNode node,
+                                              bool inQuant,
+                                              bool inTerm,
+                                              Node& newAssertion)
+{
+  Kind k = node.getKind();
+  TypeNode nodeType = node.getType();
+  bool doReplace;
+  // Handle non-Boolean ITEs here. Boolean ones (within terms) are handled
+  // in the "non-variable Boolean term within term" case below.
+  if (k == kind::ITE && !nodeType.isBoolean())
+  {
+    // Here, we eliminate the ITE if we are not Boolean and if we do not contain
+    // a bound variable.
+    doReplace = !inQuant || !expr::hasBoundVar(node);
+  }
+  else if (k == kind::LAMBDA || k == kind::CHOICE)
+  {
+    // lambdas and Hilbert choices are eliminated outside of quantifiers
+    doReplace = !inQuant;
+  }
+  else
+  {
+    // if a non-variable Boolean term within another term, replace it
+    doReplace = k != kind::BOOLEAN_TERM_VARIABLE && nodeType.isBoolean()
+              && inTerm && !inQuant;
+  }
+  if (!doReplace)
+  {
+    return Node::null();
+  }
+  Node skolem = getSkolemForNode(node);
+  if (!skolem.isNull())
+  {
     return skolem;
   }
-
-  if (node.isClosure())
+  std::unordered_map<Node, std::pair<Node, Node>, NodeHashFunction>::iterator
+      it = d_skolemDefs.find(node);
+  if (it != d_skolemDefs.end())
+  {
+    // Reuse the skolem introduced for node in a user context that was popped,
+    // whose definition must be asserted again
+    skolem = it->second.first;
+    newAssertion = it->second.second;
+  }
+  else
   {
-    // Remember if we're inside a quantifier
-    inQuant = true;
-  }else if( !inTerm && hasNestedTermChildren( node ) ){
-    // Remember if we're inside a term
-    Debug("ite") << "In term because of " << node << " " << node.getKind() << std::endl;
-    inTerm = true;
+    mkSkolemDefinition(node, skolem, newAssertion);
+    d_skolemDefs[node] = std::make_pair(skolem, newAssertion);
   }
+  d_skolem_cache.insert(node, skolem);
+  return skolem;
+}
 
-  // If not an ITE, go deep
-  vector<Node> newChildren;
-  bool somethingChanged = false;
-  if(node.getMetaKind() == kind::metakind::PARAMETERIZED) {
-    newChildren.push_back(node.getOperator());
+void RemoveTermFormulas::mkSkolemDefinition(TNode node,
+                                            Node& skolem,
+                                            Node& newAssertion)
+{
+  NodeManager* nodeManager = NodeManager::currentNM();
+  TypeNode nodeType = node.getType();
+  if (node.getKind() == kind::ITE && !nodeType.isBoolean())
+  {
+    // Make the skolem to represent the ITE
+    skolem = nodeManager->mkSkolem(
+        "termITE",
+        nodeType,
+        "a variable introduced due to term-level ITE removal");
+
+    // The new assertion
+    newAssertion = nodeManager->mkNode(
+        kind::ITE, node[0], skolem.eqNode(node[1]), skolem.eqNode(node[2]));
   }
-  // Remove the ITEs from the children
-  for(TNode::const_iterator it = node.begin(), end = node.end(); it != end; ++it) {
-    Node newChild = run(*it, output, iteSkolemMap, inQuant, inTerm);
-    somethingChanged |= (newChild != *it);
-    newChildren.push_back(newChild);
+  else if (node.getKind() == kind::LAMBDA)
+  {
+    // if a lambda, do lambda-lifting
+    // Make the skolem to represent the lambda
+    skolem = nodeManager->mkSkolem(
+        "lambdaF",
+        nodeType,
+        "a function introduced due to term-level lambda removal");
+
+    // The new assertion
+    std::vector<Node> children;
+    // bound variable list
+    children.push_back(node[0]);
+    // body
+    std::vector<Node> skolem_app_c;
+    skolem_app_c.push_back(skolem);
+    skolem_app_c.insert(skolem_app_c.end(), node[0].begin(), node[0].end());
+    Node skolem_app = nodeManager->mkNode(kind::APPLY_UF, skolem_app_c);
+    children.push_back(skolem_app.eqNode(node[1]));
+    // axiom defining skolem
+    newAssertion = nodeManager->mkNode(kind::FORALL, children);
   }
+  else if (node.getKind() == kind::CHOICE)
+  {
+    // If a Hilbert choice function, witness the choice.
+    //   For details on this operator, see
+    //   http://planetmath.org/hilbertsvarepsilonoperator.
+    // Make the skolem to witness the choice
+    skolem = nodeManager->mkSkolem(
+        "choiceK",
+        nodeType,
+        "a skolem introduced due to term-level Hilbert choice removal");
+
+    Assert(node[0].getNumChildren() == 1);
 
-  // If changes, we rewrite
-  if(somethingChanged) {
-    Node cached = nodeManager->mkNode(node.getKind(), newChildren);
-    d_tfCache.insert(cacheKey, cached);
-    return cached;
-  } else {
-    d_tfCache.insert(cacheKey, Node::null());
-    return node;
+    // The new assertion is the assumption that the body
+    // of the choice operator holds for the Skolem
+    newAssertion = node[1].substitute(node[0][0], skolem);
+  }
+  else
+  {
+    Assert(nodeType.isBoolean());
+    // Make the skolem to represent the Boolean term
+    // Skolems introduced for Boolean formulas appearing in terms have a
+    // special kind (BOOLEAN_TERM_VARIABLE) that ensures they are handled
+    // properly in theory combination. We must use this kind here instead of a
+    // generic skolem.
+    skolem = nodeManager->mkBooleanTermVariable();
+
+    // The new assertion
+    newAssertion = skolem.eqNode(node);
   }
 }
 
@@ -253,49 +356,94 @@ Node RemoveTermFormulas::getSkolemForNode(Node node) const
 }
 
 Node RemoveTermFormulas::replace(TNode node, bool inQuant, bool inTerm) const {
-  if( node.getKind()==kind::INST_PATTERN_LIST ){
-    return Node(node);
-  }
-
-  // Check the cache
-  NodeManager *nodeManager = NodeManager::currentNM();
-  int cv = cacheVal( inQuant, inTerm );
-  TermFormulaCache::const_iterator i = d_tfCache.find(make_pair(node, cv));
-  if (i != d_tfCache.end())
-  {
-    Node cached = (*i).second;
-    return cached.isNull() ? Node(node) : cached;
-  }
-
-  if (node.isClosure())
+  NodeManager* nodeManager = NodeManager::currentNM();
+  std::unordered_map<std::pair<Node, int>,
+                     Node,
+                     PairHashFunction<Node, int, NodeHashFunction> >
+      visited;
+  std::vector<TermFormulaFrame> toVisit;
+  toVisit.push_back(TermFormulaFrame(node, inQuant, inTerm));
+  while (!toVisit.empty())
   {
-    // Remember if we're inside a quantifier
-    inQuant = true;
-  }else if( !inTerm && hasNestedTermChildren( node ) ){
-    // Remember if we're inside a term
-    inTerm = true;
-  }  
+    TermFormulaFrame& f = toVisit.back();
+    TNode cur = f.d_node;
+    std::pair<Node, int> key(cur, cacheVal(f.d_inQuant, f.d_inTerm));
+    if (!f.d_expanded)
+    {
+      if (visited.find(key) != visited.end())
+      {
+        toVisit.pop_back();
+        continue;
+      }
+      if (cur.getKind() == kind::INST_PATTERN_LIST)
+      {
+        visited[key] = cur;
+        toVisit.pop_back();
+        continue;
+      }
+      // Check the cache
+      TermFormulaCache::const_iterator i = d_tfCache.find(key);
+      if (i != d_tfCache.end())
+      {
+        Node cached = (*i).second;
+        visited[key] = cached.isNull() ? Node(cur) : cached;
+        toVisit.pop_back();
+        continue;
+      }
+      if (cur.isClosure())
+      {
+        // Remember if we're inside a quantifier
+        f.d_childInQuant = true;
+      }
+      else if (!f.d_inTerm && hasNestedTermChildren(cur))
+      {
+        // Remember if we're inside a term
+        f.d_childInTerm = true;
+      }
+      f.d_expanded = true;
+      bool childInQuant = f.d_childInQuant;
+      bool childInTerm = f.d_childInTerm;
+      int childCv = cacheVal(childInQuant, childInTerm);
+      for (size_t j = cur.getNumChildren(); j > 0; --j)
+      {
+        TNode child = cur[j - 1];
+        if (visited.find(std::make_pair(Node(child), childCv))
+            == visited.end())
+        {
+          toVisit.push_back(TermFormulaFrame(child, childInQuant, childInTerm));
+        }
+      }
+      continue;
+    }
+    int childCv = cacheVal(f.d_childInQuant, f.d_childInTerm);
+    toVisit.pop_back();
 
-  vector<Node> newChildren;
-  bool somethingChanged = false;
-  if(node.getMetaKind() == kind::metakind::PARAMETERIZED) {
-    newChildren.push_back(node.getOperator());
-  }
-  // Replace in children
-  for(TNode::const_iterator it = node.begin(), end = node.end(); it != end; ++it) {
-    Node newChild = replace(*it, inQuant, inTerm);
-    somethingChanged |= (newChild != *it);
-    newChildren.push_back(newChild);
-  }
+    vector<Node> newChildren;
+    bool somethingChanged = false;
+    if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+    {
+      newChildren.push_back(cur.getOperator());
+    }
+    // Replace in children
+    for (TNode::const_iterator it = cur.begin(), end = cur.end(); it != end;
+         ++it)
+    {
+      Node newChild = visited[std::make_pair(Node(*it), childCv)];
+      Assert(!newChild.isNull());
+      somethingChanged |= (newChild != *it);
+      newChildren.push_back(newChild);
+    }
 
-  // If changes, we rewrite
-  if(somethingChanged) {
-    return nodeManager->mkNode(node.getKind(), newChildren);
-  } else {
-    return node;
+    // If changes, we rewrite
+    visited[key] = somethingChanged
+                       ? nodeManager->mkNode(cur.getKind(), newChildren)
+                       : Node(cur);
   }
+  return visited[std::make_pair(Node(node), cacheVal(inQuant, inTerm))];
 }
 
+void RemoveTermFormulas::garbageCollect() { d_skolemDefs.clear(); }
+
 // returns true if the children of node should be considered nested terms 
 bool RemoveTermFormulas::hasNestedTermChildren( TNode node ) {
   return theory::kindToTheoryId(node.getKind())!=theory::THEORY_BOOL && 
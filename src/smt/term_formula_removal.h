@@ -19,6 +19,7 @@
 #pragma once
 
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "context/cdinsert_hashmap.h"
@@ -76,6 +77,40 @@ class RemoveTermFormulas {
    */
   inline Node getSkolemForNode(Node node) const;
 
+  /** skolem definitions
+   *
+   * This maps terms to the skolem we introduced for them and its defining
+   * assertion (before term formula removal). Unlike d_skolem_cache, this is
+   * not context dependent, so that when a term is processed again after the
+   * user context in which its skolem was introduced is popped, we reuse the
+   * skolem and assert its definition again, instead of introducing a fresh
+   * skolem.
+   */
+  std::unordered_map<Node, std::pair<Node, Node>, NodeHashFunction>
+      d_skolemDefs;
+
+  /**
+   * Get the skolem that replaces node, when visited with the flags inQuant and
+   * inTerm of run(...), or the null node if node should not be replaced. If
+   * the skolem is not yet defined in the current user context, newAssertion
+   * is set to its defining assertion.
+   */
+  Node getSkolemReplacement(TNode node,
+                            bool inQuant,
+                            bool inTerm,
+                            Node& newAssertion);
+  /** Make a fresh skolem for node and its defining assertion */
+  void mkSkolemDefinition(TNode node, Node& skolem, Node& newAssertion);
+  /**
+   * Removes term formulas from node, which is traversed iteratively. The
+   * skolems introduced by this call are added to newDefs, together with
+   * their definitions, whose term formulas are not removed.
+   */
+  Node runInternal(TNode node,
+                   bool inQuant,
+                   bool inTerm,
+                   std::vector<std::pair<Node, Node> >& newDefs);
+
   static bool hasNestedTermChildren( TNode node );
 public:
 
@@ -132,6 +167,10 @@ public:
    * inQuant is whether we are processing node in the body of quantified formula
    * inTerm is whether we are are processing node in a "term" position, that is, it is a subterm
    *        of a parent term that is not a Boolean connective.
+   *
+   * A term that was replaced in a user context that has since been popped is
+   * replaced by the same skolem as before, whose definition is added to
+   * assertions again.
    */
   Node run(TNode node, std::vector<Node>& additionalAssertions,
            IteSkolemMap& iteSkolemMap, bool inQuant, bool inTerm);
@@ -145,7 +184,10 @@ public:
   /** Returns true if e contains a term ite. */
   bool containsTermITE(TNode e) const;
 
-  /** Garbage collects non-context dependent data-structures. */
+  /**
+   * Garbage collects non-context dependent data-structures. After this,
+   * terms replaced in popped user contexts are replaced by fresh skolems.
+   */
   void garbageCollect();
 };/* class RemoveTTE */
 
@@ -584,7 +584,7 @@ ApproxGLPK::ApproxGLPK(const ArithVariables& v, TreeLog& l, ApproximateStatistic
   , d_solvedRelaxation(false)
   , d_solvedMIP(false)
 {
-  static int instance = 0;
+  static thread_local int instance = 0;
   ++instance;
   d_instanceID = instance;
 
@@ -2193,7 +2193,7 @@ bool ApproxGLPK::attemptMir(int nid, const MirInfo& mir){
 bool ApproxGLPK::loadVB(int nid, int M, int j, int ri, bool wantUb, VirtualBound& tmp){
   if(ri <= 0) { return true; }
 
-  static int instance = 0;
+  static thread_local int instance = 0;
   ++instance;
   Debug("glpk::loadVB") << "loadVB() " << instance << endl;
 
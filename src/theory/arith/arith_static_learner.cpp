@@ -38,6 +38,7 @@ namespace arith {
 ArithStaticLearner::ArithStaticLearner(context::Context* userContext) :
   d_minMap(userContext),
   d_maxMap(userContext),
+  d_processed(userContext),
   d_statistics()
 {
 }
@@ -60,9 +61,12 @@ ArithStaticLearner::Statistics::~Statistics(){
 
 void ArithStaticLearner::staticLearning(TNode n, NodeBuilder<>& learned){
 
+  if (d_processed.find(n) != d_processed.end())
+  {
+    return;
+  }
   vector<TNode> workList;
   workList.push_back(n);
-  TNodeSet processed;
 
   //Contains an underapproximation of nodes that must hold.
   TNodeSet defTrue;
@@ -74,7 +78,7 @@ void ArithStaticLearner::staticLearning(TNode n, NodeBuilder<>& learned){
 
     bool unprocessedChildren = false;
     for(TNode::iterator i = n.begin(), iend = n.end(); i != iend; ++i) {
-      if(processed.find(*i) == processed.end()) {
+      if(d_processed.find(*i) == d_processed.end()) {
         // unprocessed child
         workList.push_back(*i);
         unprocessedChildren = true;
@@ -92,10 +96,10 @@ void ArithStaticLearner::staticLearning(TNode n, NodeBuilder<>& learned){
 
     workList.pop_back();
     // has node n been processed in the meantime ?
-    if(processed.find(n) != processed.end()) {
+    if(d_processed.find(n) != d_processed.end()) {
       continue;
     }
-    processed.insert(n);
+    d_processed.insert(n);
 
     process(n,learned, defTrue);
 
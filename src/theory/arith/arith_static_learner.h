@@ -23,6 +23,7 @@
 #include <set>
 
 #include "context/cdhashmap.h"
+#include "context/cdhashset.h"
 #include "context/context.h"
 #include "theory/arith/arith_utilities.h"
 #include "util/statistics_registry.h"
@@ -41,6 +42,12 @@ private:
   CDNodeToMinMaxMap d_minMap;
   CDNodeToMinMaxMap d_maxMap;
 
+  /**
+   * The nodes processed by staticLearning in the current user context. Their
+   * subterms are not traversed again when they occur in later assertions.
+   */
+  context::CDHashSet<Node, NodeHashFunction> d_processed;
+
 public:
   ArithStaticLearner(context::Context* userContext);
   ~ArithStaticLearner();
@@ -80,7 +80,7 @@ Result::Sat AttemptSolutionSDP::attempt(const ApproximateSimplex::Solution& sol)
   d_errorSet.reduceToSignals();
   d_errorSet.setSelectionRule(options::ErrorSelectionRule::VAR_ORDER);
 
-  static int instance = 0;
+  static thread_local int instance = 0;
   ++instance;
 
   if(processSignals()){
@@ -0,0 +1,377 @@
+/*********************                                                        */
+/*! \file basis_factorization.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A sparse LU factorization of a simplex basis in double precision.
+ **
+ ** A sparse LU factorization of a simplex basis in double precision.
+ **/
+#include "theory/arith/basis_factorization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+
+#include "base/check.h"
+
+using namespace std;
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+namespace {
+
+/**
+ * A pivot must be at least this fraction of the largest entry of its column
+ * (threshold partial pivoting).
+ */
+const double s_pivotThreshold = 0.1;
+/** Columns whose entries are all below this are singular. */
+const double s_singularTolerance = 1e-11;
+/** Entries that cancel to below this fraction are dropped. */
+const double s_dropTolerance = 1e-14;
+
+}  // namespace
+
+BasisFactorization::BasisFactorization() : d_size(0), d_updates(0) {}
+
+bool BasisFactorization::factorize(const vector<SparseVector>& columns)
+{
+  d_size = columns.size();
+  d_etas.clear();
+  d_pivotRow.assign(d_size, 0);
+  d_diagonal.assign(d_size, 0.0);
+  d_uRows.assign(d_size, SparseVector());
+  d_uColumns.assign(d_size, vector<uint32_t>());
+  d_order.clear();
+  d_slot.assign(d_size, 0);
+  d_updates = 0;
+
+  // the active submatrix by rows, and the rows of each active column
+  vector<map<uint32_t, double>> rows(d_size);
+  vector<set<uint32_t>> cols(d_size);
+  for (uint32_t k = 0; k < d_size; ++k)
+  {
+    for (const pair<uint32_t, double>& e : columns[k])
+    {
+      Assert(e.first < d_size);
+      if (e.second != 0.0)
+      {
+        rows[e.first][k] += e.second;
+        cols[k].insert(e.first);
+      }
+    }
+  }
+  // the active columns by their number of entries
+  set<pair<size_t, uint32_t>> byCount;
+  for (uint32_t k = 0; k < d_size; ++k)
+  {
+    byCount.insert(make_pair(cols[k].size(), k));
+  }
+
+  while (!byCount.empty())
+  {
+    // Markowitz: the shortest column, and in it the shortest row among the
+    // entries that are large enough
+    uint32_t q = byCount.begin()->second;
+    byCount.erase(byCount.begin());
+    double largest = 0.0;
+    for (uint32_t i : cols[q])
+    {
+      largest = max(largest, fabs(rows[i][q]));
+    }
+    if (largest < s_singularTolerance)
+    {
+      return false;
+    }
+    uint32_t p = d_size;
+    for (uint32_t i : cols[q])
+    {
+      double a = fabs(rows[i][q]);
+      if (a >= s_pivotThreshold * largest
+          && (p == d_size || rows[i].size() < rows[p].size()
+              || (rows[i].size() == rows[p].size() && a > fabs(rows[p][q]))))
+      {
+        p = i;
+      }
+    }
+    Assert(p < d_size);
+    double pivot = rows[p][q];
+    const map<uint32_t, double>& pivotRow = rows[p];
+
+    // the other columns of the pivot row change their counts
+    for (const pair<const uint32_t, double>& e : pivotRow)
+    {
+      if (e.first != q)
+      {
+        byCount.erase(make_pair(cols[e.first].size(), e.first));
+        cols[e.first].erase(p);
+      }
+    }
+
+    Eta eta(false, p);
+    for (uint32_t i : cols[q])
+    {
+      if (i == p)
+      {
+        continue;
+      }
+      map<uint32_t, double>& row = rows[i];
+      double mult = row[q] / pivot;
+      row.erase(q);
+      eta.d_entries.push_back(make_pair(i, mult));
+      for (const pair<const uint32_t, double>& e : pivotRow)
+      {
+        if (e.first == q)
+        {
+          continue;
+        }
+        double added = mult * e.second;
+        pair<map<uint32_t, double>::iterator, bool> res =
+            row.insert(make_pair(e.first, 0.0));
+        double old = res.first->second;
+        double sum = old - added;
+        if (fabs(sum) <= s_dropTolerance * max(fabs(old), fabs(added)))
+        {
+          if (!res.second)
+          {
+            cols[e.first].erase(i);
+          }
+          row.erase(res.first);
+        }
+        else
+        {
+          res.first->second = sum;
+          if (res.second)
+          {
+            cols[e.first].insert(i);
+          }
+        }
+      }
+    }
+    cols[q].clear();
+    if (!eta.d_entries.empty())
+    {
+      d_etas.push_back(eta);
+    }
+
+    d_pivotRow[q] = p;
+    d_diagonal[q] = pivot;
+    for (const pair<const uint32_t, double>& e : pivotRow)
+    {
+      if (e.first != q)
+      {
+        d_uRows[p].push_back(e);
+        d_uColumns[e.first].push_back(p);
+        byCount.insert(make_pair(cols[e.first].size(), e.first));
+      }
+    }
+    rows[p].clear();
+    d_slot[q] = d_order.size();
+    d_order.push_back(q);
+  }
+  return true;
+}
+
+void BasisFactorization::ftran(vector<double>& b, vector<double>* spike) const
+{
+  Assert(b.size() == d_size);
+  for (const Eta& eta : d_etas)
+  {
+    if (eta.d_isRow)
+    {
+      double sum = 0.0;
+      for (const pair<uint32_t, double>& e : eta.d_entries)
+      {
+        sum += e.second * b[e.first];
+      }
+      b[eta.d_pivot] -= sum;
+    }
+    else
+    {
+      double t = b[eta.d_pivot];
+      if (t != 0.0)
+      {
+        for (const pair<uint32_t, double>& e : eta.d_entries)
+        {
+          b[e.first] -= e.second * t;
+        }
+      }
+    }
+  }
+  if (spike != NULL)
+  {
+    *spike = b;
+  }
+
+  vector<double> x(d_size, 0.0);
+  for (size_t slot = d_order.size(); slot-- > 0;)
+  {
+    uint32_t r = d_order[slot];
+    if (r == d_size)
+    {
+      continue;
+    }
+    uint32_t p = d_pivotRow[r];
+    double sum = b[p];
+    for (const pair<uint32_t, double>& e : d_uRows[p])
+    {
+      sum -= e.second * x[e.first];
+    }
+    x[r] = sum / d_diagonal[r];
+  }
+  b.swap(x);
+}
+
+void BasisFactorization::btran(vector<double>& c) const
+{
+  Assert(c.size() == d_size);
+  vector<double> z(d_size, 0.0);
+  for (uint32_t r : d_order)
+  {
+    if (r == d_size)
+    {
+      continue;
+    }
+    uint32_t p = d_pivotRow[r];
+    double t = c[r] / d_diagonal[r];
+    z[p] = t;
+    if (t != 0.0)
+    {
+      for (const pair<uint32_t, double>& e : d_uRows[p])
+      {
+        c[e.first] -= t * e.second;
+      }
+    }
+  }
+
+  for (vector<Eta>::const_reverse_iterator i = d_etas.rbegin(),
+                                           i_end = d_etas.rend();
+       i != i_end;
+       ++i)
+  {
+    const Eta& eta = *i;
+    if (eta.d_isRow)
+    {
+      double t = z[eta.d_pivot];
+      if (t != 0.0)
+      {
+        for (const pair<uint32_t, double>& e : eta.d_entries)
+        {
+          z[e.first] -= e.second * t;
+        }
+      }
+    }
+    else
+    {
+      double sum = 0.0;
+      for (const pair<uint32_t, double>& e : eta.d_entries)
+      {
+        sum += e.second * z[e.first];
+      }
+      z[eta.d_pivot] -= sum;
+    }
+  }
+  c.swap(z);
+}
+
+void BasisFactorization::moveLast(uint32_t position)
+{
+  d_order[d_slot[position]] = d_size;
+  d_slot[position] = d_order.size();
+  d_order.push_back(position);
+}
+
+bool BasisFactorization::update(uint32_t position, const vector<double>& spike)
+{
+  Assert(spike.size() == d_size);
+  uint32_t r = position;
+  uint32_t p = d_pivotRow[r];
+
+  // remove the old column from U
+  for (uint32_t i : d_uColumns[r])
+  {
+    SparseVector& row = d_uRows[i];
+    for (size_t k = 0; k < row.size(); ++k)
+    {
+      if (row[k].first == r)
+      {
+        row[k] = row.back();
+        row.pop_back();
+        break;
+      }
+    }
+  }
+  d_uColumns[r].clear();
+
+  // the spike is the new column, which becomes the last one of U
+  double largest = fabs(spike[p]);
+  for (uint32_t i = 0; i < d_size; ++i)
+  {
+    if (i != p && spike[i] != 0.0)
+    {
+      d_uRows[i].push_back(make_pair(r, spike[i]));
+      d_uColumns[r].push_back(i);
+      largest = max(largest, fabs(spike[i]));
+    }
+  }
+
+  // Row p becomes the last row of U. Eliminate its entries for the positions
+  // after r with the rows of those positions, in their order.
+  double diagonal = spike[p];
+  map<uint32_t, double> pending;
+  for (const pair<uint32_t, double>& e : d_uRows[p])
+  {
+    pending[d_slot[e.first]] += e.second;
+  }
+  d_uRows[p].clear();
+  Eta eta(true, p);
+  while (!pending.empty())
+  {
+    uint32_t c = d_order[pending.begin()->first];
+    double value = pending.begin()->second;
+    pending.erase(pending.begin());
+    if (value == 0.0)
+    {
+      continue;
+    }
+    double mult = value / d_diagonal[c];
+    uint32_t pc = d_pivotRow[c];
+    eta.d_entries.push_back(make_pair(pc, mult));
+    for (const pair<uint32_t, double>& e : d_uRows[pc])
+    {
+      if (e.first == r)
+      {
+        diagonal -= mult * e.second;
+      }
+      else
+      {
+        Assert(d_slot[e.first] > d_slot[c]);
+        pending[d_slot[e.first]] -= mult * e.second;
+      }
+    }
+  }
+  if (!(fabs(diagonal) > s_singularTolerance * max(1.0, largest)))
+  {
+    return false;
+  }
+  if (!eta.d_entries.empty())
+  {
+    d_etas.push_back(eta);
+  }
+  d_diagonal[r] = diagonal;
+  moveLast(r);
+  ++d_updates;
+  return true;
+}
+
+}/* CVC4::theory::arith namespace */
+}/* CVC4::theory namespace */
+}/* CVC4 namespace */
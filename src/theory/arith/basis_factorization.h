@@ -0,0 +1,112 @@
+/*********************                                                        */
+/*! \file basis_factorization.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A sparse LU factorization of a simplex basis in double precision.
+ **
+ ** The basis B is an m x m matrix whose column k (its position) is the
+ ** column of the k-th basic variable. factorize() eliminates B with
+ ** Markowitz pivoting into E B = U, where E is a product of column etas and
+ ** U is upper triangular up to a permutation. A basis change replaces one
+ ** column: update() does this with the Forrest-Tomlin update, which moves
+ ** the replaced column and its pivot row last in U and eliminates the row
+ ** with the rows of U, recording the elimination as a row eta in E. After
+ ** enough updates the caller refactorizes.
+ **
+ ** ftran() and btran() solve B x = b and B^T y = c, which is all a revised
+ ** simplex needs to compute the entering column and the leaving row on
+ ** demand.
+ **/
+
+#include "cvc4_private.h"
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+class BasisFactorization
+{
+ public:
+  /** (row, coefficient) pairs. */
+  typedef std::vector<std::pair<uint32_t, double>> SparseVector;
+
+  BasisFactorization();
+
+  /**
+   * Factorizes the basis whose column at each position is given, which
+   * also sets the size of the basis. Returns false if the basis is
+   * numerically singular.
+   */
+  bool factorize(const std::vector<SparseVector>& columns);
+
+  /**
+   * Solves B x = b. b is indexed by row, and is replaced by x, which is
+   * indexed by position. If spike is not NULL, it is set to E b, which
+   * update() needs when b is the column that enters the basis.
+   */
+  void ftran(std::vector<double>& b, std::vector<double>* spike) const;
+
+  /**
+   * Solves B^T y = c. c is indexed by position, and is replaced by y, which
+   * is indexed by row.
+   */
+  void btran(std::vector<double>& c) const;
+
+  /**
+   * Replaces the column at position by the column whose ftran() computed
+   * spike. Returns false if the updated basis is numerically singular, in
+   * which case the factorization must be recomputed.
+   */
+  bool update(uint32_t position, const std::vector<double>& spike);
+
+  /** The number of updates since the last factorization. */
+  uint32_t getNumUpdates() const { return d_updates; }
+
+ private:
+  /** Either b[i] -= m * b[d_pivot] (a column eta) or b[d_pivot] -= m * b[i]. */
+  struct Eta
+  {
+    bool d_isRow;
+    uint32_t d_pivot;
+    SparseVector d_entries;
+    Eta(bool isRow, uint32_t pivot) : d_isRow(isRow), d_pivot(pivot) {}
+  };
+
+  /** Makes position the last one of the order of U. */
+  void moveLast(uint32_t position);
+
+  uint32_t d_size;
+
+  std::vector<Eta> d_etas;
+
+  /** The pivot row of U of each position. */
+  std::vector<uint32_t> d_pivotRow;
+  /** The diagonal entry of U of each position. */
+  std::vector<double> d_diagonal;
+  /** The off-diagonal entries of each row of U as (position, value). */
+  std::vector<SparseVector> d_uRows;
+  /** For each position, the rows whose entries may contain it. */
+  std::vector<std::vector<uint32_t>> d_uColumns;
+
+  /** The positions in the order of U, d_size for a moved position. */
+  std::vector<uint32_t> d_order;
+  /** The index of each position in d_order. */
+  std::vector<uint32_t> d_slot;
+
+  uint32_t d_updates;
+}; /* class BasisFactorization */
+
+}/* CVC4::theory::arith namespace */
+}/* CVC4::theory namespace */
+}/* CVC4 namespace */
@@ -220,6 +220,14 @@ public:
     return *(this);
   }
 
+  /** Computes this += a * b without allocating for small values. */
+  DeltaRational& addProduct(const DeltaRational& a, const Rational& b){
+    c.addProduct(a.c, b);
+    k.addProduct(a.k, b);
+
+    return *(this);
+  }
+
   DeltaRational& operator/=(const Rational& a){
     Assert(!a.isZero());
     c /= a;
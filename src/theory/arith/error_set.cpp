@@ -33,7 +33,6 @@ ErrorInformation::ErrorInformation()
   , d_sgn(0)
   , d_relaxed(false)
   , d_inFocus(false)
-  , d_handle()
   , d_amount(NULL)
   , d_metric(0)
 {
@@ -46,7 +45,6 @@ ErrorInformation::ErrorInformation(ArithVar var, ConstraintP vio, int sgn)
   , d_sgn(sgn)
   , d_relaxed(false)
   , d_inFocus(false)
-  , d_handle()
   , d_amount(NULL)
   , d_metric(0)
 {
@@ -71,7 +69,6 @@ ErrorInformation::ErrorInformation(const ErrorInformation& ei)
   , d_sgn(ei.d_sgn)
   , d_relaxed(ei.d_relaxed)
   , d_inFocus(ei.d_inFocus)
-  , d_handle(ei.d_handle)
   , d_metric(0)
 {
   if(ei.d_amount == NULL){
@@ -88,7 +85,6 @@ ErrorInformation& ErrorInformation::operator=(const ErrorInformation& ei){
   d_sgn = ei.d_sgn;
   d_relaxed = (ei.d_relaxed);
   d_inFocus = (ei.d_inFocus);
-  d_handle = (ei.d_handle);
   d_metric = ei.d_metric;
   if(d_amount != NULL && ei.d_amount != NULL){
     Debug("arith::error::mem") << "assignment assign " << d_variable << " "  << d_amount << endl;
@@ -178,6 +174,9 @@ void ErrorSet::recomputeAmount(ErrorInformation& ei,
     case options::ErrorSelectionRule::MAXIMUM_AMOUNT:
       ei.setAmount(computeDiff(ei.getVariable()));
       break;
+    case options::ErrorSelectionRule::STEEPEST_EDGE:
+      ei.setAmount(computeNormalizedDiff(ei.getVariable()));
+      break;
     case options::ErrorSelectionRule::SUM_METRIC:
       ei.setMetric(sumMetric(ei.getVariable()));
       break;
@@ -190,20 +189,13 @@ void ErrorSet::recomputeAmount(ErrorInformation& ei,
 void ErrorSet::setSelectionRule(options::ErrorSelectionRule rule)
 {
   if(rule != getSelectionRule()){
-    FocusSet into(ComparatorPivotRule(this, rule));
-    FocusSet::const_iterator iter = d_focus.begin();
-    FocusSet::const_iterator i_end = d_focus.end();
-    for(; iter != i_end; ++iter){
-      ArithVar v = *iter;
-      ErrorInformation& ei = d_errInfo.get(v);
-      if(ei.inFocus()){
-        recomputeAmount(ei, rule);
-        FocusSetHandle handle = into.push(v);
-        ei.setHandle(handle);
-      }
+    // recompute the keys, then rebuild the heap in place
+    for (ArithVar v : d_focus)
+    {
+      recomputeAmount(d_errInfo.get(v), rule);
     }
-    d_focus.swap(into);
     d_selectionRule = rule;
+    d_focus.setComparator(ComparatorPivotRule(this, rule));
   }
   Assert(getSelectionRule() == rule);
 }
@@ -240,6 +232,7 @@ bool ComparatorPivotRule::operator()(ArithVar v, ArithVar u) const {
       }
     }
     case options::ErrorSelectionRule::MAXIMUM_AMOUNT:
+    case options::ErrorSelectionRule::STEEPEST_EDGE:
     {
       const DeltaRational& vamt = d_errorSet->getAmount(v);
       const DeltaRational& uamt = d_errorSet->getAmount(u);
@@ -255,22 +248,11 @@ bool ComparatorPivotRule::operator()(ArithVar v, ArithVar u) const {
 }
 
 void ErrorSet::update(ErrorInformation& ei){
-  if(ei.inFocus()){
-
-    switch(getSelectionRule()){
-      case options::ErrorSelectionRule::MINIMUM_AMOUNT:
-      case options::ErrorSelectionRule::MAXIMUM_AMOUNT:
-        ei.setAmount(computeDiff(ei.getVariable()));
-        d_focus.update(ei.getHandle(), ei.getVariable());
-        break;
-      case options::ErrorSelectionRule::SUM_METRIC:
-        ei.setMetric(sumMetric(ei.getVariable()));
-        d_focus.update(ei.getHandle(), ei.getVariable());
-        break;
-      case options::ErrorSelectionRule::VAR_ORDER:
-        // do nothing
-        break;
-    }
+  if (ei.inFocus()
+      && getSelectionRule() != options::ErrorSelectionRule::VAR_ORDER)
+  {
+    recomputeAmount(ei, getSelectionRule());
+    d_focus.update(ei.getVariable());
   }
 }
 
@@ -290,7 +272,7 @@ void ErrorSet::transitionVariableOutOfError(ArithVar v) {
     ei.setUnrelaxed();
   }
   if(ei.inFocus()){
-    d_focus.erase(ei.getHandle());
+    d_focus.erase(v);
     ei.setInFocus(false);
   }
   d_errInfo.remove(v);
@@ -306,28 +288,16 @@ void ErrorSet::transitionVariableIntoError(ArithVar v) {
   d_errInfo.set(v, ErrorInformation(v, c, sgn));
   ErrorInformation& ei = d_errInfo.get(v);
 
-  switch(getSelectionRule()){
-    case options::ErrorSelectionRule::MINIMUM_AMOUNT:
-    case options::ErrorSelectionRule::MAXIMUM_AMOUNT:
-      ei.setAmount(computeDiff(v));
-      break;
-    case options::ErrorSelectionRule::SUM_METRIC:
-      ei.setMetric(sumMetric(ei.getVariable()));
-      break;
-    case options::ErrorSelectionRule::VAR_ORDER:
-      // do nothing
-      break;
-  }
+  recomputeAmount(ei, getSelectionRule());
   ei.setInFocus(true);
-  FocusSetHandle handle = d_focus.push(v);
-  ei.setHandle(handle);
+  d_focus.push(v);
 }
 
 void ErrorSet::dropFromFocus(ArithVar v) {
   Assert(inError(v));
   ErrorInformation& ei = d_errInfo.get(v);
   Assert(ei.inFocus());
-  d_focus.erase(ei.getHandle());
+  d_focus.erase(v);
   ei.setInFocus(false);
   d_outOfFocus.push_back(v);
 }
@@ -336,22 +306,10 @@ void ErrorSet::addBackIntoFocus(ArithVar v) {
   Assert(inError(v));
   ErrorInformation& ei = d_errInfo.get(v);
   Assert(!ei.inFocus());
-  switch(getSelectionRule()){
-    case options::ErrorSelectionRule::MINIMUM_AMOUNT:
-    case options::ErrorSelectionRule::MAXIMUM_AMOUNT:
-      ei.setAmount(computeDiff(v));
-      break;
-    case options::ErrorSelectionRule::SUM_METRIC:
-      ei.setMetric(sumMetric(v));
-      break;
-    case options::ErrorSelectionRule::VAR_ORDER:
-      // do nothing
-      break;
-  }
+  recomputeAmount(ei, getSelectionRule());
 
   ei.setInFocus(true);
-  FocusSetHandle handle = d_focus.push(v);
-  ei.setHandle(handle);
+  d_focus.push(v);
 }
 
 void ErrorSet::blur(){
@@ -435,8 +393,15 @@ DeltaRational ErrorSet::computeDiff(ArithVar v) const{
   return diff;
 }
 
+DeltaRational ErrorSet::computeNormalizedDiff(ArithVar v) const
+{
+  uint32_t length = d_tableauSizes.getRowLength(v);
+  DeltaRational diff = computeDiff(v);
+  return length > 1 ? diff / Rational(length) : diff;
+}
+
 void ErrorSet::debugPrint(std::ostream& out) const {
-  static int instance = 0;
+  static thread_local int instance = 0;
   ++instance;
   out << "error set debugprint " << instance << endl;
   for(error_iterator i = errorBegin(), i_end = errorEnd();
@@ -461,8 +426,7 @@ void ErrorSet::focusDownToJust(ArithVar v) {
 
   ErrorInformation& vei = d_errInfo.get(v);
   vei.setInFocus(true);
-  FocusSetHandle handle = d_focus.push(v);
-  vei.setHandle(handle);
+  d_focus.push(v);
 }
 
 void ErrorSet::pushErrorInto(ArithVarVec& vec) const{
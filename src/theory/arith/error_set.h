@@ -29,7 +29,7 @@
 #include "theory/arith/delta_rational.h"
 #include "theory/arith/partial_model.h"
 #include "theory/arith/tableau_sizes.h"
-#include "util/bin_heap.h"
+#include "util/dary_heap.h"
 #include "util/statistics_registry.h"
 
 namespace CVC4 {
@@ -94,8 +94,7 @@ private:
 
 // typedef FocusSet::point_iterator FocusSetHandle;
 
-typedef BinaryHeap<ArithVar, ComparatorPivotRule> FocusSet;
-typedef FocusSet::handle FocusSetHandle;
+typedef IndexedDAryHeap<ArithVar, ComparatorPivotRule> FocusSet;
 
 
 class ErrorInformation {
@@ -126,11 +125,9 @@ private:
 
   /**
    * If this is true, then the variable is in the focus set and the focus heap.
-   * d_handle is then a reasonable thing to interpret.
    * If this is false, the variable is somewhere in
    */
   bool d_inFocus;
-  FocusSetHandle d_handle;
 
   /**
    * Auxillary information for storing the difference between a variable and its bound.
@@ -182,12 +179,6 @@ public:
   void setMetric(uint32_t m) { d_metric = m; }
   uint32_t getMetric() const { return d_metric; }
 
-  inline void setHandle(FocusSetHandle h) {
-    Assert(d_inFocus);
-    d_handle = h;
-  }
-  inline const FocusSetHandle& getHandle() const{ return d_handle; }
-
   inline ConstraintP getViolated() const { return d_violated; }
 
   bool debugInitialized() const {
@@ -260,6 +251,14 @@ private:
 public:
   DeltaRational computeDiff(ArithVar x) const;
 private:
+ /**
+  * Computes the difference between the assignment and its bound for the
+  * basic variable x, divided by the length of the row of x. This
+  * approximates steepest edge: a large violation is less attractive when its
+  * row is long, since a pivot on it disturbs more variables.
+  */
+ DeltaRational computeNormalizedDiff(ArithVar x) const;
+
  void recomputeAmount(ErrorInformation& ei, options::ErrorSelectionRule r);
 
  void update(ErrorInformation& ei);
@@ -281,7 +281,7 @@ WitnessImprovement FCSimplexDecisionProcedure::focusDownToJust(ArithVar v){
 UpdateInfo FCSimplexDecisionProcedure::selectPrimalUpdate(ArithVar basic, LinearEqualityModule::UpdatePreferenceFunction upf, LinearEqualityModule::VarPreferenceFunction bpf) {
   UpdateInfo selected;
 
-  static int instance = 0 ;
+  static thread_local int instance = 0 ;
   ++instance;
 
   Debug("arith::selectPrimalUpdate")
@@ -508,7 +508,7 @@ bool debugUpdatedBasic(const UpdateInfo& selected, ArithVar updated){
 void FCSimplexDecisionProcedure::updateAndSignal(const UpdateInfo& selected, WitnessImprovement w){
   ArithVar nonbasic = selected.nonbasic();
 
-  static bool verbose = false;
+  static thread_local bool verbose = false;
 
   Debug("updateAndSignal") << "updateAndSignal " << selected << endl;
 
@@ -715,8 +715,8 @@ bool FCSimplexDecisionProcedure::debugDualLike(WitnessImprovement w, ostream& ou
 }
 
 Result::Sat FCSimplexDecisionProcedure::dualLike(){
-  static int instance = 0;
-  static bool verbose = false;
+  static thread_local int instance = 0;
+  static thread_local bool verbose = false;
 
   TimerStat::CodeTimer codeTimer(d_statistics.d_fcTimer);
 
@@ -0,0 +1,394 @@
+/*********************                                                        */
+/*! \file fp_simplex.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A double precision simplex that warm starts the exact simplex.
+ **
+ ** A double precision simplex that warm starts the exact simplex.
+ **/
+#include "theory/arith/fp_simplex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "base/output.h"
+#include "theory/arith/partial_model.h"
+#include "theory/arith/tableau.h"
+
+using namespace std;
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+namespace {
+
+/** Relative tolerance for a value to be within a bound. */
+const double s_feasibilityTolerance = 1e-9;
+/** Entries below this fraction of the largest entry of a row are not pivots. */
+const double s_pivotTolerance = 1e-7;
+/** Entries of a computed row below this magnitude are dropped. */
+const double s_dropTolerance = 1e-12;
+/** The relative disagreement of a pivot computed by btran and by ftran. */
+const double s_pivotAgreement = 1e-7;
+/** The basis is refactorized after this many updates. */
+const uint32_t s_refactorPeriod = 64;
+
+const double s_infinity = numeric_limits<double>::infinity();
+
+/** The tolerance around a bound, 0 for a missing bound. */
+double tolerance(double bound)
+{
+  return std::isinf(bound) ? 0.0
+                           : s_feasibilityTolerance * max(1.0, fabs(bound));
+}
+
+}  // namespace
+
+FloatingPointSimplex::FloatingPointSimplex(const ArithVariables& vars,
+                                           const Tableau& tableau)
+    : d_vars(vars), d_pivots(0)
+{
+  ArithVar n = vars.getNumberOfVariables();
+  d_columns.resize(n);
+  d_basisPosition.resize(n, -1);
+  d_values.resize(n, 0.0);
+  d_lower.resize(n, -s_infinity);
+  d_upper.resize(n, s_infinity);
+  d_positions.resize(n, UNCHANGED);
+  d_live.resize(n, false);
+  d_rowBuffer.resize(n, 0.0);
+
+  const double delta = ApproximateSimplex::SMALL_FIXED_DELTA;
+  for (ArithVariables::var_iterator i = vars.var_begin(), i_end = vars.var_end();
+       i != i_end;
+       ++i)
+  {
+    ArithVar v = *i;
+    d_live[v] = true;
+    d_values[v] = vars.getAssignment(v).approx(delta);
+    if (vars.hasLowerBound(v))
+    {
+      d_lower[v] = vars.getLowerBound(v).approx(delta);
+    }
+    if (vars.hasUpperBound(v))
+    {
+      d_upper[v] = vars.getUpperBound(v).approx(delta);
+    }
+  }
+
+  // row i, with its basic variable at position i, is the constraint i of A
+  for (Tableau::BasicIterator i = tableau.beginBasic(),
+                              i_end = tableau.endBasic();
+       i != i_end;
+       ++i)
+  {
+    ArithVar basic = *i;
+    uint32_t rowIndex = d_rows.size();
+    d_rows.push_back(Row());
+    d_basisPosition[basic] = d_basis.size();
+    d_basis.push_back(basic);
+    Row& row = d_rows.back();
+    for (Tableau::RowIterator j = tableau.basicRowIterator(basic); !j.atEnd();
+         ++j)
+    {
+      const Tableau::Entry& entry = *j;
+      ArithVar col = entry.getColVar();
+      double c = entry.getCoefficient().getDouble();
+      row.push_back(Entry(col, c));
+      d_columns[col].push_back(make_pair(rowIndex, c));
+    }
+  }
+}
+
+double FloatingPointSimplex::violation(ArithVar v) const
+{
+  double value = d_values[v];
+  if (value < d_lower[v] - tolerance(d_lower[v]))
+  {
+    return value - d_lower[v];
+  }
+  if (value > d_upper[v] + tolerance(d_upper[v]))
+  {
+    return value - d_upper[v];
+  }
+  return 0.0;
+}
+
+bool FloatingPointSimplex::canMove(ArithVar v, bool increase) const
+{
+  return increase ? d_values[v] < d_upper[v] - tolerance(d_upper[v])
+                  : d_values[v] > d_lower[v] + tolerance(d_lower[v]);
+}
+
+int FloatingPointSimplex::selectLeaving(bool bland) const
+{
+  int best = -1;
+  double bestViolation = 0.0;
+  for (uint32_t k = 0; k < d_basis.size(); ++k)
+  {
+    double v = fabs(violation(d_basis[k]));
+    if (v == 0.0)
+    {
+      continue;
+    }
+    if (best < 0
+        || (bland ? d_basis[k] < d_basis[best] : v > bestViolation))
+    {
+      best = k;
+      bestViolation = v;
+    }
+  }
+  return best;
+}
+
+ArithVar FloatingPointSimplex::selectEntering(const Row& row,
+                                              bool increase,
+                                              bool bland) const
+{
+  double largest = 0.0;
+  for (const Entry& e : row)
+  {
+    largest = max(largest, fabs(e.d_coeff));
+  }
+
+  ArithVar best = ARITHVAR_SENTINEL;
+  double bestCoeff = 0.0;
+  for (const Entry& e : row)
+  {
+    double a = fabs(e.d_coeff);
+    if (a < s_pivotTolerance * largest)
+    {
+      continue;
+    }
+    // basic moves with e.d_var if the coefficient is positive
+    if (!canMove(e.d_var, (e.d_coeff > 0) == increase))
+    {
+      continue;
+    }
+    if (best == ARITHVAR_SENTINEL || (bland ? e.d_var < best : a > bestCoeff))
+    {
+      best = e.d_var;
+      bestCoeff = a;
+    }
+  }
+  return best;
+}
+
+void FloatingPointSimplex::computeRow(uint32_t position, Row& row)
+{
+  // B x_B + N x_N = 0, so x_B = -B^-1 N x_N and the row of position is
+  // -e_position^T B^-1 N
+  vector<double> y(d_basis.size(), 0.0);
+  y[position] = 1.0;
+  d_factorization.btran(y);
+
+  row.clear();
+  vector<ArithVar> touched;
+  for (uint32_t i = 0; i < d_rows.size(); ++i)
+  {
+    if (y[i] == 0.0)
+    {
+      continue;
+    }
+    for (const Entry& e : d_rows[i])
+    {
+      if (d_basisPosition[e.d_var] >= 0)
+      {
+        continue;
+      }
+      if (d_rowBuffer[e.d_var] == 0.0)
+      {
+        touched.push_back(e.d_var);
+      }
+      d_rowBuffer[e.d_var] -= y[i] * e.d_coeff;
+      if (d_rowBuffer[e.d_var] == 0.0)
+      {
+        // keep it touched when it cancels exactly
+        d_rowBuffer[e.d_var] = numeric_limits<double>::min();
+      }
+    }
+  }
+  for (ArithVar v : touched)
+  {
+    double c = d_rowBuffer[v];
+    d_rowBuffer[v] = 0.0;
+    if (fabs(c) > s_dropTolerance)
+    {
+      row.push_back(Entry(v, c));
+    }
+  }
+}
+
+bool FloatingPointSimplex::refactor()
+{
+  vector<BasisFactorization::SparseVector> columns;
+  columns.reserve(d_basis.size());
+  for (ArithVar b : d_basis)
+  {
+    columns.push_back(d_columns[b]);
+  }
+  if (!d_factorization.factorize(columns))
+  {
+    Debug("arith::fp") << "fp simplex: the basis is singular" << endl;
+    return false;
+  }
+
+  // B x_B = -N x_N
+  vector<double> rhs(d_rows.size(), 0.0);
+  for (uint32_t i = 0; i < d_rows.size(); ++i)
+  {
+    for (const Entry& e : d_rows[i])
+    {
+      if (d_basisPosition[e.d_var] < 0)
+      {
+        rhs[i] -= e.d_coeff * d_values[e.d_var];
+      }
+    }
+  }
+  d_factorization.ftran(rhs, NULL);
+  for (uint32_t k = 0; k < d_basis.size(); ++k)
+  {
+    if (!std::isfinite(rhs[k]))
+    {
+      Debug("arith::fp") << "fp simplex: values overflowed" << endl;
+      return false;
+    }
+    d_values[d_basis[k]] = rhs[k];
+  }
+  return true;
+}
+
+bool FloatingPointSimplex::pivotAndUpdate(uint32_t position,
+                                          ArithVar entering,
+                                          double coeff,
+                                          double bound)
+{
+  ArithVar basic = d_basis[position];
+
+  // the column of entering in the basis, the coefficient of entering in the
+  // row of position k is -column[k]
+  vector<double> column(d_rows.size(), 0.0);
+  for (const pair<uint32_t, double>& e : d_columns[entering])
+  {
+    column[e.first] = e.second;
+  }
+  vector<double> spike;
+  d_factorization.ftran(column, &spike);
+  if (fabs(column[position] + coeff) > s_pivotAgreement * max(1.0, fabs(coeff)))
+  {
+    Debug("arith::fp") << "fp simplex: pivot " << coeff << " vs "
+                       << -column[position] << endl;
+    return false;
+  }
+
+  // update the assignment
+  double theta = (bound - d_values[basic]) / coeff;
+  if (!std::isfinite(theta))
+  {
+    return false;
+  }
+  d_values[entering] += theta;
+  for (uint32_t k = 0; k < d_basis.size(); ++k)
+  {
+    d_values[d_basis[k]] -= column[k] * theta;
+  }
+  d_values[basic] = bound;
+  d_positions[basic] = bound == d_lower[basic] ? AT_LOWER : AT_UPPER;
+
+  d_basis[position] = entering;
+  d_basisPosition[entering] = position;
+  d_basisPosition[basic] = -1;
+
+  if (d_factorization.getNumUpdates() + 1 >= s_refactorPeriod
+      || !d_factorization.update(position, spike))
+  {
+    return refactor();
+  }
+  return true;
+}
+
+LinResult FloatingPointSimplex::solve(uint32_t pivotLimit)
+{
+  if (!refactor())
+  {
+    return LinUnknown;
+  }
+  // like the exact simplex, pick the largest violation for a while and then
+  // switch to Bland's rule, which cannot cycle
+  const uint32_t heuristicPivots = d_rows.size() + 1;
+  Row row;
+  while (true)
+  {
+    bool bland = d_pivots >= heuristicPivots;
+    int position = selectLeaving(bland);
+    if (position < 0)
+    {
+      Debug("arith::fp") << "fp simplex: feasible after " << d_pivots << endl;
+      return LinFeasible;
+    }
+    if (d_pivots >= pivotLimit)
+    {
+      return LinExhausted;
+    }
+    ArithVar basic = d_basis[position];
+    bool increase = violation(basic) < 0;
+    computeRow(position, row);
+    ArithVar entering = selectEntering(row, increase, bland);
+    if (entering == ARITHVAR_SENTINEL)
+    {
+      Debug("arith::fp") << "fp simplex: row of " << basic << " is infeasible"
+                         << endl;
+      return LinInfeasible;
+    }
+    double coeff = 0.0;
+    for (const Entry& e : row)
+    {
+      if (e.d_var == entering)
+      {
+        coeff = e.d_coeff;
+      }
+    }
+    double bound = increase ? d_lower[basic] : d_upper[basic];
+    if (!pivotAndUpdate(position, entering, coeff, bound))
+    {
+      Debug("arith::fp") << "fp simplex: pivot failed" << endl;
+      return LinUnknown;
+    }
+    ++d_pivots;
+  }
+}
+
+ApproximateSimplex::Solution FloatingPointSimplex::extractSolution() const
+{
+  ApproximateSimplex::Solution sol;
+  for (ArithVar v = 0; v < d_live.size(); ++v)
+  {
+    if (!d_live[v])
+    {
+      continue;
+    }
+    if (d_basisPosition[v] >= 0)
+    {
+      sol.newBasis.add(v);
+      continue;
+    }
+    switch (d_positions[v])
+    {
+      case AT_LOWER: sol.newValues.set(v, d_vars.getLowerBound(v)); break;
+      case AT_UPPER: sol.newValues.set(v, d_vars.getUpperBound(v)); break;
+      default: sol.newValues.set(v, d_vars.getAssignment(v)); break;
+    }
+  }
+  return sol;
+}
+
+}/* CVC4::theory::arith namespace */
+}/* CVC4::theory namespace */
+}/* CVC4 namespace */
@@ -0,0 +1,150 @@
+/*********************                                                        */
+/*! \file fp_simplex.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A double precision simplex that warm starts the exact simplex.
+ **
+ ** Copies the current Tableau and assignment into doubles and runs the same
+ ** bounded simplex as DualSimplexDecisionProcedure on the copy: a basic
+ ** variable that violates a bound leaves the basis at that bound, first
+ ** choosing the variable with the largest violation and then switching to
+ ** Bland's rule.
+ **
+ ** Unlike the exact Tableau, the copy is not kept in solved form. The rows
+ ** of the Tableau at the start are kept as the constraint matrix A, and the
+ ** basis is kept as an LU factorization (see BasisFactorization). Each pivot
+ ** only computes the row of the leaving variable (with btran) and the column
+ ** of the entering one (with ftran), so a pivot costs about the size of the
+ ** factorization instead of a row operation on every row that contains the
+ ** entering variable.
+ **
+ ** The result is only a proposal: extractSolution() returns the final basis
+ ** and the exact bounds the non-basic variables sit at, which
+ ** AttemptSolutionSDP imports into the exact Tableau. The exact simplex then
+ ** verifies the proposal and repairs what the rounding errors got wrong. If
+ ** the numerics fail, the solver gives up with LinUnknown and the exact
+ ** state is never touched.
+ **/
+
+#include "cvc4_private.h"
+
+#pragma once
+
+#include <vector>
+
+#include "theory/arith/approx_simplex.h"
+#include "theory/arith/arithvar.h"
+#include "theory/arith/basis_factorization.h"
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+class ArithVariables;
+class Tableau;
+
+class FloatingPointSimplex
+{
+ public:
+  FloatingPointSimplex(const ArithVariables& vars, const Tableau& tableau);
+
+  /**
+   * Runs at most pivotLimit pivots. Returns LinFeasible if every variable is
+   * within its bounds up to the tolerance, LinInfeasible if a row cannot be
+   * repaired, LinExhausted if the pivot limit is reached, and LinUnknown if
+   * the numerics failed.
+   */
+  LinResult solve(uint32_t pivotLimit);
+
+  /** The final basis and the values of the non-basic variables. */
+  ApproximateSimplex::Solution extractSolution() const;
+
+  uint32_t getPivots() const { return d_pivots; }
+
+ private:
+  /** Where a non-basic variable sits. */
+  enum Position
+  {
+    UNCHANGED,
+    AT_LOWER,
+    AT_UPPER
+  };
+
+  struct Entry
+  {
+    ArithVar d_var;
+    double d_coeff;
+    Entry(ArithVar v, double c) : d_var(v), d_coeff(c) {}
+  };
+  /** 0 = sum of the entries. */
+  typedef std::vector<Entry> Row;
+
+  /** By how much v violates its bounds, negative if it is below. */
+  double violation(ArithVar v) const;
+  /** Whether v may increase (or decrease) as a non-basic variable. */
+  bool canMove(ArithVar v, bool increase) const;
+
+  /** The basis position to repair, -1 if there is none. */
+  int selectLeaving(bool bland) const;
+  /**
+   * The non-basic variable of row to enter the basis when the basic
+   * variable moves in the given direction, ARITHVAR_SENTINEL if there is
+   * none.
+   */
+  ArithVar selectEntering(const Row& row, bool increase, bool bland) const;
+
+  /**
+   * Computes the basic variable at position as the sum of the entries of row
+   * over the non-basic variables.
+   */
+  void computeRow(uint32_t position, Row& row);
+
+  /**
+   * Moves the basic variable at position to bound and exchanges it with
+   * entering, whose coefficient in the row of position is coeff. Returns
+   * false if the numerics failed.
+   */
+  bool pivotAndUpdate(uint32_t position,
+                      ArithVar entering,
+                      double coeff,
+                      double bound);
+  /**
+   * Factorizes the basis and recomputes the values of the basic variables
+   * from the non-basic ones. Returns false if the numerics failed.
+   */
+  bool refactor();
+
+  const ArithVariables& d_vars;
+
+  /** The rows of the tableau at the start. */
+  std::vector<Row> d_rows;
+  /** The column of each variable in d_rows. */
+  std::vector<BasisFactorization::SparseVector> d_columns;
+
+  /** The basic variable at each position of the basis. */
+  std::vector<ArithVar> d_basis;
+  /** The basis position of each variable, -1 for the non-basic ones. */
+  std::vector<int> d_basisPosition;
+  BasisFactorization d_factorization;
+
+  std::vector<double> d_values;
+  std::vector<double> d_lower;
+  std::vector<double> d_upper;
+  std::vector<Position> d_positions;
+  /** Whether the variable exists. */
+  std::vector<bool> d_live;
+
+  /** Scratch space for computeRow(), indexed by variable. */
+  std::vector<double> d_rowBuffer;
+
+  uint32_t d_pivots;
+}; /* class FloatingPointSimplex */
+
+}/* CVC4::theory::arith namespace */
+}/* CVC4::theory namespace */
+}/* CVC4 namespace */
@@ -214,7 +214,8 @@ void LinearEqualityModule::updateUntracked(ArithVar x_i, const DeltaRational& v)
     const Rational& a_ji = entry.getCoefficient();
 
     const DeltaRational& assignment = d_variables.getAssignment(x_j);
-    DeltaRational  nAssignment = assignment+(diff * a_ji);
+    DeltaRational nAssignment = assignment;
+    nAssignment.addProduct(diff, a_ji);
     d_variables.setAssignment(x_j, nAssignment);
 
     d_basicVariableUpdates(x_j);
@@ -254,7 +255,8 @@ void LinearEqualityModule::updateTracked(ArithVar x_i, const DeltaRational& v){
     const Rational& a_ji = entry.getCoefficient();
 
     const DeltaRational& assignment = d_variables.getAssignment(x_j);
-    DeltaRational  nAssignment = assignment+(diff * a_ji);
+    DeltaRational nAssignment = assignment;
+    nAssignment.addProduct(diff, a_ji);
     Debug("update") << x_j << " " << a_ji << assignment << " -> " << nAssignment << endl;
     BoundCounts xjBefore = d_variables.atBoundCounts(x_j);
     d_variables.setAssignment(x_j, nAssignment);
@@ -280,7 +282,7 @@ void LinearEqualityModule::pivotAndUpdate(ArithVar x_i, ArithVar x_j, const Delt
 
   TimerStat::CodeTimer codeTimer(d_statistics.d_pivotTime);
 
-  static int instance = 0;
+  static thread_local int instance = 0;
 
   if(Debug.isOn("arith::tracking::pre")){
     ++instance;
@@ -474,7 +476,7 @@ DeltaRational LinearEqualityModule::computeRowValue(ArithVar x, bool useSafe) co
     const Rational& coeff = entry.getCoefficient();
 
     const DeltaRational& assignment = d_variables.getAssignment(nonbasic, useSafe);
-    sum = sum + (assignment * coeff);
+    sum.addProduct(assignment, coeff);
   }
   return sum;
 }
@@ -1154,7 +1156,7 @@ UpdateInfo LinearEqualityModule::speculativeUpdate(ArithVar nb, const Rational&
 
   int focusCoeffSgn = focusCoeff.sgn();
 
-  static int instance = 0;
+  static thread_local int instance = 0;
   ++instance;
   Debug("speculativeUpdate") << "speculativeUpdate " << instance << endl;
   Debug("speculativeUpdate") << "nb " << nb << endl;
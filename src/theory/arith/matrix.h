@@ -665,7 +665,7 @@ public:
 
         const Entry& other = d_entries.get(bufferEntry);
         T& coeff = entry.getCoefficient();
-        coeff += mult * other.getCoefficient();
+        coeff.addProduct(mult, other.getCoefficient());
 
         if(coeff.sgn() == 0){
           removeEntry(id);
@@ -725,7 +725,7 @@ public:
         const Entry& other = d_entries.get(bufferEntry);
         T& coeff = entry.getCoefficient();
         int coeffOldSgn = coeff.sgn();
-        coeff += mult * other.getCoefficient();
+        coeff.addProduct(mult, other.getCoefficient());
         int coeffNewSgn = coeff.sgn();
 
         if(coeffOldSgn != coeffNewSgn){
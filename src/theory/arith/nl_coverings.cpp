@@ -0,0 +1,283 @@
+/*********************                                                        */
+/*! \file nl_coverings.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Refutation of univariate non-linear constraints by cylindrical
+ ** algebraic coverings.
+ **
+ ** Refutation of univariate non-linear constraints by cylindrical algebraic
+ ** coverings.
+ **/
+
+#include "theory/arith/nl_coverings.h"
+
+#include <algorithm>
+#include <map>
+
+#include "base/output.h"
+#include "theory/arith/arith_msum.h"
+
+using namespace CVC4::kind;
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+bool NlCoverings::Constraint::isSatisfiedBy(int sgn) const
+{
+  if (d_kind == EQUAL)
+  {
+    return (sgn == 0) == d_polarity;
+  }
+  return (sgn >= 0) == d_polarity;
+}
+
+bool NlCoverings::getConstraint(Node lit, Node& var, Constraint& c)
+{
+  c.d_lit = lit;
+  c.d_polarity = lit.getKind() != NOT;
+  Node atom = c.d_polarity ? lit : lit[0];
+  c.d_kind = atom.getKind();
+  if (c.d_kind != GEQ && (c.d_kind != EQUAL || !atom[0].getType().isReal()))
+  {
+    return false;
+  }
+  std::map<Node, Node> msum;
+  if (!ArithMSum::getMonomialSumLit(atom, msum))
+  {
+    return false;
+  }
+  var = Node::null();
+  std::vector<Rational> coeffs;
+  for (const std::pair<const Node, Node>& m : msum)
+  {
+    Rational coeff(1);
+    if (!m.second.isNull())
+    {
+      if (!m.second.isConst())
+      {
+        return false;
+      }
+      coeff = m.second.getConst<Rational>();
+    }
+    size_t degree = 0;
+    if (!m.first.isNull())
+    {
+      Node v = m.first;
+      degree = 1;
+      if (m.first.getKind() == NONLINEAR_MULT)
+      {
+        v = m.first[0];
+        degree = m.first.getNumChildren();
+        for (const Node& f : m.first)
+        {
+          if (f != v)
+          {
+            return false;
+          }
+        }
+      }
+      if (!var.isNull() && var != v)
+      {
+        return false;
+      }
+      var = v;
+    }
+    if (coeffs.size() <= degree)
+    {
+      coeffs.resize(degree + 1);
+    }
+    coeffs[degree] += coeff;
+  }
+  c.d_poly = UnivariatePolynomial(coeffs);
+  return !var.isNull();
+}
+
+bool NlCoverings::getCovering(const std::vector<Constraint>& constraints,
+                              std::vector<Node>& conflict)
+{
+  // the roots of all polynomials are the roots of their square-free product
+  UnivariatePolynomial prod(std::vector<Rational>(1, Rational(1)));
+  for (const Constraint& c : constraints)
+  {
+    if (c.d_poly.getDegree() >= 1)
+    {
+      prod = prod * c.d_poly;
+    }
+  }
+  UnivariatePolynomial sf = prod.squareFreePart();
+  std::vector<UnivariatePolynomial::Root> roots;
+  sf.isolateRoots(roots);
+  // separate the isolating intervals so that there are rational points
+  // between the roots
+  for (size_t k = 0; k + 1 < roots.size(); k++)
+  {
+    while (roots[k].d_upper >= roots[k + 1].d_lower)
+    {
+      sf.refineRoot(roots[k]);
+      sf.refineRoot(roots[k + 1]);
+    }
+  }
+  Trace("nl-cov") << "...square-free product " << sf << " has " << roots.size()
+                  << " real roots" << std::endl;
+
+  // the cells alternate between the sectors and the roots
+  size_t ncells = 2 * roots.size() + 1;
+  std::vector<std::vector<size_t> > violated(ncells);
+  for (size_t i = 0; i < ncells; i++)
+  {
+    std::vector<int> sgns(constraints.size());
+    if (i % 2 == 0)
+    {
+      size_t k = i / 2;
+      Rational sample(0);
+      if (roots.empty())
+      {
+        // any point will do
+      }
+      else if (k == 0)
+      {
+        sample = roots[0].d_lower - Rational(1);
+      }
+      else if (k == roots.size())
+      {
+        sample = roots.back().d_upper + Rational(1);
+      }
+      else
+      {
+        sample = (roots[k - 1].d_upper + roots[k].d_lower) / Rational(2);
+      }
+      for (size_t j = 0, size = constraints.size(); j < size; j++)
+      {
+        sgns[j] = constraints[j].d_poly.sgnAt(sample);
+      }
+    }
+    else
+    {
+      const UnivariatePolynomial::Root& r = roots[i / 2];
+      for (size_t j = 0, size = constraints.size(); j < size; j++)
+      {
+        const UnivariatePolynomial& p = constraints[j].d_poly;
+        if (r.isExact())
+        {
+          sgns[j] = p.sgnAt(r.d_lower);
+          continue;
+        }
+        // The root is the only root of sf in the interval, and the roots of
+        // p are roots of sf. Either it is a root of p, or p has no root in
+        // the closed interval.
+        UnivariatePolynomial g = UnivariatePolynomial::gcd(p, sf);
+        if (g.getDegree() >= 1 && g.countRoots(r.d_lower, r.d_upper) > 0)
+        {
+          sgns[j] = 0;
+        }
+        else
+        {
+          sgns[j] = p.sgnAt(r.d_lower);
+        }
+      }
+    }
+    for (size_t j = 0, size = constraints.size(); j < size; j++)
+    {
+      if (!constraints[j].isSatisfiedBy(sgns[j]))
+      {
+        violated[i].push_back(j);
+      }
+    }
+    if (violated[i].empty())
+    {
+      Trace("nl-cov") << "...cell " << i << " is satisfiable" << std::endl;
+      return false;
+    }
+  }
+
+  // greedily pick the constraint that covers the most uncovered cells
+  std::vector<bool> covered(ncells, false);
+  size_t ncovered = 0;
+  while (ncovered < ncells)
+  {
+    std::vector<size_t> count(constraints.size(), 0);
+    for (size_t i = 0; i < ncells; i++)
+    {
+      if (!covered[i])
+      {
+        for (size_t j : violated[i])
+        {
+          count[j]++;
+        }
+      }
+    }
+    size_t best = 0;
+    for (size_t j = 1, size = constraints.size(); j < size; j++)
+    {
+      if (count[j] > count[best])
+      {
+        best = j;
+      }
+    }
+    Assert(count[best] > 0);
+    conflict.push_back(constraints[best].d_lit);
+    for (size_t i = 0; i < ncells; i++)
+    {
+      if (!covered[i]
+          && std::find(violated[i].begin(), violated[i].end(), best)
+                 != violated[i].end())
+      {
+        covered[i] = true;
+        ncovered++;
+      }
+    }
+  }
+  return true;
+}
+
+bool NlCoverings::check(const std::vector<Node>& assertions,
+                        std::vector<Node>& lemmas)
+{
+  std::map<Node, std::vector<Constraint> > constraints;
+  std::map<Node, bool> nonlinear;
+  for (const Node& lit : assertions)
+  {
+    Node var;
+    Constraint c;
+    if (getConstraint(lit, var, c))
+    {
+      constraints[var].push_back(c);
+      if (c.d_poly.getDegree() >= 2)
+      {
+        nonlinear[var] = true;
+      }
+    }
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  bool sent = false;
+  for (const std::pair<const Node, bool>& v : nonlinear)
+  {
+    Trace("nl-cov") << "Coverings for " << v.first << " with "
+                    << constraints[v.first].size() << " constraints"
+                    << std::endl;
+    std::vector<Node> conflict;
+    if (getCovering(constraints[v.first], conflict))
+    {
+      std::vector<Node> disj;
+      for (const Node& lit : conflict)
+      {
+        disj.push_back(lit.negate());
+      }
+      Node lem = disj.size() == 1 ? disj[0] : nm->mkNode(OR, disj);
+      Trace("nl-cov") << "...conflict : " << lem << std::endl;
+      lemmas.push_back(lem);
+      sent = true;
+    }
+  }
+  return sent;
+}
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
@@ -0,0 +1,79 @@
+/*********************                                                        */
+/*! \file nl_coverings.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Refutation of univariate non-linear constraints by cylindrical
+ ** algebraic coverings.
+ **
+ ** This is the base case of the cylindrical algebraic coverings method
+ ** (Abraham et al., JLAMP 2021): the real roots of the polynomials of the
+ ** constraints on a variable x split the real line into cells on which every
+ ** polynomial has a constant sign. If each cell violates some constraint,
+ ** these intervals cover the real line and the constraints that cover it
+ ** are a conflict. Otherwise a cell satisfies all of them. Unlike
+ ** incremental linearization, this decides the constraints on x, whatever
+ ** their degree.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__ARITH__NL_COVERINGS_H
+#define CVC4__THEORY__ARITH__NL_COVERINGS_H
+
+#include <vector>
+
+#include "expr/node.h"
+#include "theory/arith/univariate_polynomial.h"
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+class NlCoverings
+{
+ public:
+  /**
+   * For each variable x with a non-linear constraint among assertions, checks
+   * the assertions that are constraints on x alone. If they have no real
+   * solution, adds a lemma to lemmas that excludes the ones that cover the
+   * real line. Returns true if it added a lemma.
+   */
+  bool check(const std::vector<Node>& assertions, std::vector<Node>& lemmas);
+
+ private:
+  /** The constraint lit, which is p(x) ~ 0 for an atom ~ of kind d_kind. */
+  struct Constraint
+  {
+    Node d_lit;
+    UnivariatePolynomial d_poly;
+    /** GEQ or EQUAL */
+    Kind d_kind;
+    bool d_polarity;
+    /** Does a value of d_poly with the given sign satisfy the constraint? */
+    bool isSatisfiedBy(int sgn) const;
+  };
+
+  /**
+   * If lit is a constraint on a single variable, sets var and c accordingly
+   * and returns true.
+   */
+  static bool getConstraint(Node lit, Node& var, Constraint& c);
+  /**
+   * Computes a covering of the real line by the cells on which constraints
+   * are violated. Returns false if there is a cell that satisfies all of
+   * them, and otherwise adds the constraints of the covering to conflict.
+   */
+  static bool getCovering(const std::vector<Constraint>& constraints,
+                          std::vector<Node>& conflict);
+}; /* class NlCoverings */
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__ARITH__NL_COVERINGS_H */
@@ -23,6 +23,7 @@
 #include "expr/node_algorithm.h"
 #include "expr/node_builder.h"
 #include "options/arith_options.h"
+#include "smt/smt_statistics_registry.h"
 #include "theory/arith/arith_msum.h"
 #include "theory/arith/arith_utilities.h"
 #include "theory/arith/theory_arith.h"
@@ -184,10 +185,12 @@ bool hasNewMonomials(Node n, const std::vector<Node>& existing) {
 NonlinearExtension::NonlinearExtension(TheoryArith& containing,
                                        eq::EqualityEngine* ee)
     : d_lemmas(containing.getUserContext()),
+      d_lemmaGroups(containing.getUserContext()),
       d_zero_split(containing.getUserContext()),
       d_containing(containing),
       d_ee(ee),
       d_needsLastCall(false),
+      d_linRounds(0),
       d_model(containing.getSatContext()),
       d_builtModel(containing.getSatContext(), false)
 {
@@ -211,6 +214,42 @@ NonlinearExtension::NonlinearExtension(TheoryArith& containing,
 
 NonlinearExtension::~NonlinearExtension() {}
 
+NonlinearExtension::LemmaFamilyStats::LemmaFamilyStats(const std::string& name)
+    : d_generated("theory::arith::nl::" + name + "::generated", 0),
+      d_new("theory::arith::nl::" + name + "::new", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_generated);
+  smtStatisticsRegistry()->registerStat(&d_new);
+}
+
+NonlinearExtension::LemmaFamilyStats::~LemmaFamilyStats()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_generated);
+  smtStatisticsRegistry()->unregisterStat(&d_new);
+}
+
+NonlinearExtension::Statistics::Statistics()
+    : d_splitZero("splitZero"),
+      d_tfInitialRefine("tfInitialRefine"),
+      d_sign("sign"),
+      d_tfMonotonic("tfMonotonic"),
+      d_magnitude("magnitude"),
+      d_inferBounds("inferBounds"),
+      d_factoring("factoring"),
+      d_resBounds("resBounds"),
+      d_tangentPlanes("tangentPlanes"),
+      d_tfTangentPlanes("tfTangentPlanes"),
+      d_coverings("coverings"),
+      d_tangentPlanesCached("theory::arith::nl::tangentPlanes::cached", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_tangentPlanesCached);
+}
+
+NonlinearExtension::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_tangentPlanesCached);
+}
+
 // Returns a reference to either map[key] if it exists in the map
 // or to a default value otherwise.
 //
@@ -571,8 +610,13 @@ unsigned NonlinearExtension::filterLemma(Node lem, std::vector<Node>& out)
 }
 
 unsigned NonlinearExtension::filterLemmas(std::vector<Node>& lemmas,
-                                          std::vector<Node>& out)
+                                          std::vector<Node>& out,
+                                          LemmaFamilyStats* family)
 {
+  if (family != nullptr)
+  {
+    family->d_generated += lemmas.size();
+  }
   if (options::nlExtEntailConflicts())
   {
     // check if any are entailed to be false
@@ -593,6 +637,10 @@ unsigned NonlinearExtension::filterLemmas(std::vector<Node>& lemmas,
         // return just this lemma
         if (filterLemma(lem, out) > 0)
         {
+          if (family != nullptr)
+          {
+            ++family->d_new;
+          }
           lemmas.clear();
           return 1;
         }
@@ -605,10 +653,56 @@ unsigned NonlinearExtension::filterLemmas(std::vector<Node>& lemmas,
   {
     sum += filterLemma(lem, out);
   }
+  if (family != nullptr)
+  {
+    family->d_new += sum;
+  }
   lemmas.clear();
   return sum;
 }
 
+bool NonlinearExtension::hasSentLemmaGroup(Node key) const
+{
+  context::CDHashMap<Node, Node, NodeHashFunction>::const_iterator it =
+      d_lemmaGroups.find(key);
+  if (it == d_lemmaGroups.end())
+  {
+    return false;
+  }
+  for (const Node& lem : (*it).second)
+  {
+    if (d_lemmas.find(lem) == d_lemmas.end())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void NonlinearExtension::addLemmaGroup(Node key,
+                                       const std::vector<Node>& lemmas,
+                                       size_t start)
+{
+  Assert(start + 1 < lemmas.size());
+  NodeBuilder<> nb(AND);
+  for (size_t i = start, size = lemmas.size(); i < size; i++)
+  {
+    nb << Rewriter::rewrite(lemmas[i]);
+  }
+  d_lemmaGroups[key] = nb.constructNode();
+}
+
+bool NonlinearExtension::checkCoverings(const std::vector<Node>& assertions,
+                                        std::vector<Node>& lems)
+{
+  Trace("nl-ext") << "Get coverings lemmas..." << std::endl;
+  d_linRounds = 0;
+  std::vector<Node> lemmas;
+  d_coverings.check(assertions, lemmas);
+  filterLemmas(lemmas, lems, &d_statistics.d_coverings);
+  return !lems.empty();
+}
+
 void NonlinearExtension::getAssertions(std::vector<Node>& assertions)
 {
   Trace("nl-ext") << "Getting assertions..." << std::endl;
@@ -1096,7 +1190,7 @@ int NonlinearExtension::checkLastCall(const std::vector<Node>& assertions,
   if (options::nlExtSplitZero()) {
     Trace("nl-ext") << "Get zero split lemmas..." << std::endl;
     lemmas = checkSplitZero();
-    filterLemmas(lemmas, lems);
+    filterLemmas(lemmas, lems, &d_statistics.d_splitZero);
     if (!lems.empty())
     {
       Trace("nl-ext") << "  ...finished with " << lems.size() << " new lemmas."
@@ -1107,7 +1201,7 @@ int NonlinearExtension::checkLastCall(const std::vector<Node>& assertions,
 
   //-----------------------------------initial lemmas for transcendental functions
   lemmas = checkTranscendentalInitialRefine();
-  filterLemmas(lemmas, lems);
+  filterLemmas(lemmas, lems, &d_statistics.d_tfInitialRefine);
   if (!lems.empty())
   {
     Trace("nl-ext") << "  ...finished with " << lems.size() << " new lemmas."
@@ -1117,7 +1211,7 @@ int NonlinearExtension::checkLastCall(const std::vector<Node>& assertions,
 
   //-----------------------------------lemmas based on sign (comparison to zero)
   lemmas = checkMonomialSign();
-  filterLemmas(lemmas, lems);
+  filterLemmas(lemmas, lems, &d_statistics.d_sign);
   if (!lems.empty())
   {
     Trace("nl-ext") << "  ...finished with " << lems.size() << " new lemmas."
@@ -1127,7 +1221,7 @@ int NonlinearExtension::checkLastCall(const std::vector<Node>& assertions,
 
   //-----------------------------------monotonicity of transdental functions
   lemmas = checkTranscendentalMonotonic();
-  filterLemmas(lemmas, lems);
+  filterLemmas(lemmas, lems, &d_statistics.d_tfMonotonic);
   if (!lems.empty())
   {
     Trace("nl-ext") << "  ...finished with " << lems.size() << " new lemmas."
@@ -1154,7 +1248,7 @@ int NonlinearExtension::checkLastCall(const std::vector<Node>& assertions,
     // c is effort level
     lemmas = checkMonomialMagnitude( c );
     unsigned nlem = lemmas.size();
-    filterLemmas(lemmas, lems);
+    filterLemmas(lemmas, lems, &d_statistics.d_magnitude);
     if (!lems.empty())
     {
       Trace("nl-ext") << "  ...finished with " << lems.size()
@@ -1179,12 +1273,12 @@ int NonlinearExtension::checkLastCall(const std::vector<Node>& assertions,
   // Trace("nl-ext") << "Bound lemmas : " << lemmas.size() << ", " <<
   // nt_lemmas.size() << std::endl;  prioritize lemmas that do not
   // introduce new monomials
-  filterLemmas(lemmas, lems);
+  filterLemmas(lemmas, lems, &d_statistics.d_inferBounds);
 
   if (options::nlExtTangentPlanes() && options::nlExtTangentPlanesInterleave())
   {
     lemmas = checkTangentPlanes();
-    filterLemmas(lemmas, lems);
+    filterLemmas(lemmas, lems, &d_statistics.d_tangentPlanes);
   }
 
   if (!lems.empty())
@@ -1195,7 +1289,7 @@ int NonlinearExtension::checkLastCall(const std::vector<Node>& assertions,
   }
 
   // from inferred bound inferences : now do ones that introduce new terms
-  filterLemmas(nt_lemmas, lems);
+  filterLemmas(nt_lemmas, lems, &d_statistics.d_inferBounds);
   if (!lems.empty())
   {
     Trace("nl-ext") << "  ...finished with " << lems.size()
@@ -1207,7 +1301,7 @@ int NonlinearExtension::checkLastCall(const std::vector<Node>& assertions,
   //   x*y + x*z >= t => exists k. k = y + z ^ x*k >= t
   if( options::nlExtFactor() ){
     lemmas = checkFactoring(assertions, false_asserts);
-    filterLemmas(lemmas, lems);
+    filterLemmas(lemmas, lems, &d_statistics.d_factoring);
     if (!lems.empty())
     {
       Trace("nl-ext") << "  ...finished with " << lems.size() << " new lemmas."
@@ -1220,7 +1314,7 @@ int NonlinearExtension::checkLastCall(const std::vector<Node>& assertions,
   //  e.g. ( y>=0 ^ s <= x*z ^ x*y <= t ) => y*s <= z*t
   if (options::nlExtResBound()) {
     lemmas = checkMonomialInferResBounds();
-    filterLemmas(lemmas, lems);
+    filterLemmas(lemmas, lems, &d_statistics.d_resBounds);
     if (!lems.empty())
     {
       Trace("nl-ext") << "  ...finished with " << lems.size() << " new lemmas."
@@ -1233,12 +1327,12 @@ int NonlinearExtension::checkLastCall(const std::vector<Node>& assertions,
   if (options::nlExtTangentPlanes() && !options::nlExtTangentPlanesInterleave())
   {
     lemmas = checkTangentPlanes();
-    filterLemmas(lemmas, wlems);
+    filterLemmas(lemmas, wlems, &d_statistics.d_tangentPlanes);
   }
   if (options::nlExtTfTangentPlanes())
   {
     lemmas = checkTranscendentalTangentPlanes();
-    filterLemmas(lemmas, wlems);
+    filterLemmas(lemmas, wlems, &d_statistics.d_tfTangentPlanes);
   }
   Trace("nl-ext") << "  ...finished with " << wlems.size() << " waiting lemmas."
                   << std::endl;
@@ -1373,8 +1467,20 @@ bool NonlinearExtension::modelBasedRefinement(std::vector<Node>& mlems,
     if (!false_asserts.empty() || num_shared_wrong_value > 0)
     {
       complete_status = num_shared_wrong_value > 0 ? -1 : 0;
+      // incremental linearization is the cheap first tier, unless it has
+      // not settled the constraints for a while
+      if (options::nlCov() && d_linRounds >= options::nlCovLinRounds()
+          && checkCoverings(assertions, mlems))
+      {
+        return true;
+      }
       checkLastCall(assertions, false_asserts, xts, mlems, mlemsPp, wlems);
       if (!mlems.empty() || !mlemsPp.empty())
+      {
+        d_linRounds++;
+        return true;
+      }
+      if (options::nlCov() && checkCoverings(assertions, mlems))
       {
         return true;
       }
@@ -2158,6 +2264,18 @@ std::vector<Node> NonlinearExtension::checkTangentPlanes() {
                                                     nm->mkNode(MULT, b_v, a),
                                                     nm->mkNode(MULT, a_v, b)),
                                          nm->mkNode(MULT, a_v, b_v));
+                // the lemmas below are determined by t and the tangent plane,
+                // skip them if they were all sent for this point before
+                Node groupKey = nm->mkNode(MINUS, t, tplane);
+                if (hasSentLemmaGroup(groupKey))
+                {
+                  Trace("nl-ext-tplanes")
+                      << "Tangent plane lemmas for " << groupKey
+                      << " were sent before" << std::endl;
+                  ++d_statistics.d_tangentPlanesCached;
+                  continue;
+                }
+                size_t groupStart = lemmas.size();
                 for (unsigned d = 0; d < 4; d++) {
                   Node aa = nm->mkNode(d == 0 || d == 3 ? GEQ : LEQ, a, a_v);
                   Node ab = nm->mkNode(d == 1 || d == 3 ? GEQ : LEQ, b, b_v);
@@ -2216,6 +2334,7 @@ std::vector<Node> NonlinearExtension::checkTangentPlanes() {
                     << "Tangent plane lemma (reverse) : " << lb_reverse2
                     << std::endl;
                 lemmas.push_back(lb_reverse2);
+                addLemmaGroup(groupKey, lemmas, groupStart);
               }
             }
           }
@@ -27,6 +27,7 @@
 #include <utility>
 #include <vector>
 
+#include "context/cdhashmap.h"
 #include "context/cdhashset.h"
 #include "context/cdinsert_hashmap.h"
 #include "context/cdlist.h"
@@ -34,9 +35,11 @@
 #include "context/context.h"
 #include "expr/kind.h"
 #include "expr/node.h"
+#include "theory/arith/nl_coverings.h"
 #include "theory/arith/nl_model.h"
 #include "theory/arith/theory_arith.h"
 #include "theory/uf/equality_engine.h"
+#include "util/statistics_registry.h"
 
 namespace CVC4 {
 namespace theory {
@@ -383,14 +386,33 @@ class NonlinearExtension {
   /** Is n entailed with polarity pol in the current context? */
   bool isEntailed(Node n, bool pol);
 
+  /** The number of lemmas a lemma schema generated, and how many were new. */
+  struct LemmaFamilyStats
+  {
+    IntStat d_generated;
+    IntStat d_new;
+    LemmaFamilyStats(const std::string& name);
+    ~LemmaFamilyStats();
+  };
+
   /**
    * Potentially adds lemmas to the set out and clears lemmas. Returns
    * the number of lemmas added to out. We do not add lemmas that have already
-   * been sent on the output channel of TheoryArith.
+   * been sent on the output channel of TheoryArith. If family is not null,
+   * its statistics count the lemmas.
    */
-  unsigned filterLemmas(std::vector<Node>& lemmas, std::vector<Node>& out);
+  unsigned filterLemmas(std::vector<Node>& lemmas,
+                        std::vector<Node>& out,
+                        LemmaFamilyStats* family = nullptr);
   /** singleton version of above */
   unsigned filterLemma(Node lem, std::vector<Node>& out);
+  /**
+   * Refutes the univariate constraints among assertions with d_coverings,
+   * adding the conflicts to lems (see NlCoverings::check). Returns true if
+   * lems is non-empty.
+   */
+  bool checkCoverings(const std::vector<Node>& assertions,
+                      std::vector<Node>& lems);
 
   /**
    * Send lemmas in out on the output channel of theory of arithmetic.
@@ -424,6 +446,23 @@ class NonlinearExtension {
 
   /** cache of all lemmas sent on the output channel (user-context-dependent) */
   NodeSet d_lemmas;
+  /**
+   * Lemmas that a schema generates together for one term and model point,
+   * e.g. the tangent planes of a monomial at a point, stored as the
+   * conjunction of their rewritten forms under a key naming the term and the
+   * point (user-context-dependent).
+   */
+  context::CDHashMap<Node, Node, NodeHashFunction> d_lemmaGroups;
+  /**
+   * Have all lemmas of the group with the given key been sent on the output
+   * channel? If so, the schema need not generate them again.
+   */
+  bool hasSentLemmaGroup(Node key) const;
+  /**
+   * Stores lemmas[start], ..., lemmas.back(), of which there are at least
+   * two, as the group of key.
+   */
+  void addLemmaGroup(Node key, const std::vector<Node>& lemmas, size_t start);
   /** cache of terms t for which we have added the lemma ( t = 0 V t != 0 ). */
   NodeSet d_zero_split;
 
@@ -457,6 +496,13 @@ class NonlinearExtension {
   eq::EqualityEngine* d_ee;
   // needs last call effort
   bool d_needsLastCall;
+  /** The complete procedure for univariate constraints. */
+  NlCoverings d_coverings;
+  /**
+   * The number of successive model-based refinement rounds in which
+   * incremental linearization sent lemmas, see options::nlCovLinRounds().
+   */
+  unsigned d_linRounds;
 
   // if d_c_info[lit][x] = ( r, coeff, k ), then ( lit <=>  (coeff * x) <k> r )
   std::map<Node, std::map<Node, ConstraintInfo> > d_c_info;
@@ -939,6 +985,28 @@ class NonlinearExtension {
    */
   bool checkTfTangentPlanesFun(Node tf, unsigned d, std::vector<Node>& lems);
   //-------------------------------------------- end lemma schemas
+
+  class Statistics
+  {
+   public:
+    LemmaFamilyStats d_splitZero;
+    LemmaFamilyStats d_tfInitialRefine;
+    LemmaFamilyStats d_sign;
+    LemmaFamilyStats d_tfMonotonic;
+    LemmaFamilyStats d_magnitude;
+    LemmaFamilyStats d_inferBounds;
+    LemmaFamilyStats d_factoring;
+    LemmaFamilyStats d_resBounds;
+    LemmaFamilyStats d_tangentPlanes;
+    LemmaFamilyStats d_tfTangentPlanes;
+    LemmaFamilyStats d_coverings;
+    /** Tangent plane groups that were not generated since they were sent. */
+    IntStat d_tangentPlanesCached;
+
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
 }; /* class NonlinearExtension */
 
 }  // namespace arith
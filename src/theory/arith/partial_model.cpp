@@ -35,6 +35,7 @@ ArithVariables::ArithVariables(context::Context* c, DeltaComputeCallback deltaCo
    d_nodeToArithVarMap(),
    d_boundsQueue(),
    d_enqueueingBoundCounts(true),
+   d_boundChanges(),
    d_lbRevertHistory(c, true, LowerBoundCleanUp(this)),
    d_ubRevertHistory(c, true, UpperBoundCleanUp(this)),
    d_deltaIsSafe(false),
@@ -443,6 +444,7 @@ void ArithVariables::setLowerBoundConstraint(ConstraintP c){
   invalidateDelta();
   VarInfo& vi = d_vars.get(x);
   pushLowerBound(vi);
+  d_boundChanges.softAdd(x);
   BoundsInfo prev;
   if(vi.setLowerBound(c, prev)){
     addToBoundQueue(x, prev);
@@ -462,6 +464,7 @@ void ArithVariables::setUpperBoundConstraint(ConstraintP c){
   invalidateDelta();
   VarInfo& vi = d_vars.get(x);
   pushUpperBound(vi);
+  d_boundChanges.softAdd(x);
   BoundsInfo prev;
   if(vi.setUpperBound(c, prev)){
     addToBoundQueue(x, prev);
@@ -607,6 +610,7 @@ void ArithVariables::popUpperBound(AVCPair* c){
   if(vi.setUpperBound(c->second, prev)){
     addToBoundQueue(x, prev);
   }
+  d_boundChanges.softAdd(x);
   --vi.d_pushCount;
 }
 
@@ -617,6 +621,7 @@ void ArithVariables::popLowerBound(AVCPair* c){
   if(vi.setLowerBound(c->second, prev)){
     addToBoundQueue(x, prev);
   }
+  d_boundChanges.softAdd(x);
   --vi.d_pushCount;
 }
 
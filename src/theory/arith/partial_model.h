@@ -136,6 +136,9 @@ private:
    */
   bool d_enqueueingBoundCounts;
 
+  /** The variables whose lower or upper bound changed, including on backtracking. */
+  DenseSet d_boundChanges;
+
  public:
 
   /** Returns the number of variables. */
@@ -386,6 +389,13 @@ public:
   bool boundsQueueEmpty() const;
   void processBoundsQueue(BoundUpdateCallback& changed);
 
+  /**
+   * The variables whose lower or upper bound changed since the last call to
+   * clearBoundChanges().
+   */
+  const DenseSet& getBoundChanges() const { return d_boundChanges; }
+  void clearBoundChanges() { d_boundChanges.purge(); }
+
   void printEntireModel(std::ostream& out) const;
 
 
@@ -0,0 +1,172 @@
+/*********************                                                        */
+/*! \file row_activity.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Incrementally maintained minimum and maximum activities of the
+ ** rows of the tableau.
+ **/
+
+#include "theory/arith/row_activity.h"
+
+#include "base/output.h"
+#include "theory/arith/partial_model.h"
+#include "theory/arith/tableau.h"
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+RowActivity::RowActivity(ArithVariables& vars, const Tableau& tableau)
+    : d_vars(vars), d_tableau(tableau)
+{
+}
+
+const DeltaRational& RowActivity::getActivity(RowIndex ridx, bool rowUb)
+{
+  includeBoundChanges();
+  if (ridx >= d_rows.size())
+  {
+    d_rows.resize(ridx + 1);
+  }
+  Activities& a = d_rows[ridx];
+  if (a.d_stamp != d_tableau.getRowStamp(ridx))
+  {
+    recompute(ridx, a);
+  }
+  Assert(a.d_stamp == d_tableau.getRowStamp(ridx));
+  return rowUb ? a.d_max : a.d_min;
+}
+
+void RowActivity::includeBoundChanges()
+{
+  const DenseSet& changed = d_vars.getBoundChanges();
+  if (changed.empty())
+  {
+    return;
+  }
+  for (DenseSet::const_iterator i = changed.begin(), iend = changed.end();
+       i != iend;
+       ++i)
+  {
+    includeBoundChange(*i);
+  }
+  d_vars.clearBoundChanges();
+}
+
+void RowActivity::includeBoundChange(ArithVar v)
+{
+  if (v >= d_bounds.size())
+  {
+    d_bounds.resize(v + 1);
+  }
+  Bounds& b = d_bounds[v];
+  bool hasLower = d_vars.hasLowerBound(v);
+  bool hasUpper = d_vars.hasUpperBound(v);
+
+  // the changes of the bound values, a missing bound counts as 0
+  DeltaRational lowerDiff, upperDiff;
+  if (hasLower)
+  {
+    lowerDiff = d_vars.getLowerBound(v);
+  }
+  if (b.d_hasLower)
+  {
+    lowerDiff = lowerDiff - b.d_lower;
+  }
+  if (hasUpper)
+  {
+    upperDiff = d_vars.getUpperBound(v);
+  }
+  if (b.d_hasUpper)
+  {
+    upperDiff = upperDiff - b.d_upper;
+  }
+
+  if (lowerDiff.sgn() != 0 || upperDiff.sgn() != 0)
+  {
+    // only the rows that have not changed since they were computed contain
+    // the old bounds, the others are recomputed when they are asked for
+    for (Tableau::ColIterator i = d_tableau.colIterator(v); !i.atEnd(); ++i)
+    {
+      const Tableau::Entry& entry = *i;
+      RowIndex ridx = entry.getRowIndex();
+      if (ridx >= d_rows.size()
+          || d_rows[ridx].d_stamp != d_tableau.getRowStamp(ridx))
+      {
+        continue;
+      }
+      Activities& a = d_rows[ridx];
+      const Rational& c = entry.getCoefficient();
+      if (c.sgn() > 0)
+      {
+        a.d_max.addProduct(upperDiff, c);
+        a.d_min.addProduct(lowerDiff, c);
+      }
+      else
+      {
+        a.d_max.addProduct(lowerDiff, c);
+        a.d_min.addProduct(upperDiff, c);
+      }
+    }
+  }
+
+  b.d_hasLower = hasLower;
+  b.d_hasUpper = hasUpper;
+  if (hasLower)
+  {
+    b.d_lower = d_vars.getLowerBound(v);
+  }
+  if (hasUpper)
+  {
+    b.d_upper = d_vars.getUpperBound(v);
+  }
+}
+
+void RowActivity::recompute(RowIndex ridx, Activities& a)
+{
+  a.d_min = DeltaRational();
+  a.d_max = DeltaRational();
+  for (Tableau::RowIterator i = d_tableau.ridRowIterator(ridx); !i.atEnd();
+       ++i)
+  {
+    const Tableau::Entry& entry = *i;
+    ArithVar v = entry.getColVar();
+    const Rational& c = entry.getCoefficient();
+    bool hasLower = d_vars.hasLowerBound(v);
+    bool hasUpper = d_vars.hasUpperBound(v);
+    if (c.sgn() > 0)
+    {
+      if (hasUpper)
+      {
+        a.d_max.addProduct(d_vars.getUpperBound(v), c);
+      }
+      if (hasLower)
+      {
+        a.d_min.addProduct(d_vars.getLowerBound(v), c);
+      }
+    }
+    else
+    {
+      if (hasLower)
+      {
+        a.d_max.addProduct(d_vars.getLowerBound(v), c);
+      }
+      if (hasUpper)
+      {
+        a.d_min.addProduct(d_vars.getUpperBound(v), c);
+      }
+    }
+  }
+  a.d_stamp = d_tableau.getRowStamp(ridx);
+  Debug("arith::activity") << "recomputed row " << ridx << " " << a.d_min
+                           << " " << a.d_max << std::endl;
+}
+
+}/* CVC4::theory::arith namespace */
+}/* CVC4::theory namespace */
+}/* CVC4 namespace */
@@ -0,0 +1,91 @@
+/*********************                                                        */
+/*! \file row_activity.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Incrementally maintained minimum and maximum activities of the
+ ** rows of the tableau.
+ **
+ ** The maximum activity of a row 0 = \sum_i c_i * x_i is the sum of c_i * u_i
+ ** for c_i > 0 and c_i * l_i for c_i < 0, where l_i and u_i are the current
+ ** bounds of x_i. The minimum activity is the same with the bounds swapped.
+ ** Missing bounds contribute 0, which is the value
+ ** LinearEqualityModule::computeRowBound() computes when the bounds are
+ ** complete but for the skipped variable.
+ **
+ ** Instead of rescanning the row on each query, the activities are kept up
+ ** to date from the bound changes that ArithVariables records: a change of a
+ ** bound of x adds c * (new - old) to the activities of the rows of x. A row
+ ** that the tableau changed (see Tableau::getRowStamp()) is recomputed when
+ ** it is asked for next.
+ **/
+
+#include "cvc4_private.h"
+
+#pragma once
+
+#include <vector>
+
+#include "theory/arith/arithvar.h"
+#include "theory/arith/delta_rational.h"
+#include "theory/arith/matrix.h"
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+class ArithVariables;
+class Tableau;
+
+class RowActivity
+{
+ public:
+  RowActivity(ArithVariables& vars, const Tableau& tableau);
+
+  /**
+   * The maximum (if rowUb) or minimum activity of the row, skipping the
+   * missing bounds.
+   */
+  const DeltaRational& getActivity(RowIndex ridx, bool rowUb);
+
+ private:
+  struct Activities
+  {
+    /** The Tableau::getRowStamp() the activities are valid for, 0 if none. */
+    uint64_t d_stamp;
+    DeltaRational d_min;
+    DeltaRational d_max;
+    Activities() : d_stamp(0) {}
+  };
+
+  /** The bounds of a variable that the activities of its rows contain. */
+  struct Bounds
+  {
+    bool d_hasLower;
+    bool d_hasUpper;
+    DeltaRational d_lower;
+    DeltaRational d_upper;
+    Bounds() : d_hasLower(false), d_hasUpper(false) {}
+  };
+
+  /** Includes the bound changes recorded by ArithVariables. */
+  void includeBoundChanges();
+  /** Includes the change of the bounds of v in the rows of v. */
+  void includeBoundChange(ArithVar v);
+  /** Recomputes the activities of the row from scratch. */
+  void recompute(RowIndex ridx, Activities& a);
+
+  ArithVariables& d_vars;
+  const Tableau& d_tableau;
+
+  std::vector<Activities> d_rows;
+  std::vector<Bounds> d_bounds;
+}; /* class RowActivity */
+
+}/* CVC4::theory::arith namespace */
+}/* CVC4::theory namespace */
+}/* CVC4 namespace */
@@ -233,7 +233,7 @@ void SumOfInfeasibilitiesSPD::adjustFocusAndError(const UpdateInfo& up, const AV
 UpdateInfo SumOfInfeasibilitiesSPD::selectUpdate(LinearEqualityModule::UpdatePreferenceFunction upf, LinearEqualityModule::VarPreferenceFunction bpf) {
   UpdateInfo selected;
 
-  static int instance = 0 ;
+  static thread_local int instance = 0 ;
   ++instance;
 
   Debug("soi::selectPrimalUpdate")
@@ -357,7 +357,7 @@ void SumOfInfeasibilitiesSPD::debugPrintSignal(ArithVar updated) const{
 void SumOfInfeasibilitiesSPD::updateAndSignal(const UpdateInfo& selected, WitnessImprovement w){
   ArithVar nonbasic = selected.nonbasic();
 
-  static bool verbose = false;
+  static thread_local bool verbose = false;
 
   Debug("updateAndSignal") << "updateAndSignal " << selected << endl;
 
@@ -845,7 +845,7 @@ bool SumOfInfeasibilitiesSPD::generateSOIConflict(const ArithVarVec& subset){
 
 
 WitnessImprovement SumOfInfeasibilitiesSPD::SOIConflict(){
-  static int instance = 0;
+  static thread_local int instance = 0;
   instance++;
   
   Debug("arith::SOIConflict") << "SumOfInfeasibilitiesSPD::SOIConflict() start "
@@ -952,8 +952,8 @@ bool SumOfInfeasibilitiesSPD::debugSOI(WitnessImprovement w, ostream& out, int i
 }
 
 Result::Sat SumOfInfeasibilitiesSPD::sumOfInfeasibilities(){
-  static int instance = 0;
-  static bool verbose = false;
+  static thread_local int instance = 0;
+  static thread_local bool verbose = false;
 
   TimerStat::CodeTimer codeTimer(d_statistics.d_soiTimer);
 
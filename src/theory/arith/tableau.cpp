@@ -33,6 +33,7 @@ void Tableau::pivot(ArithVar oldBasic, ArithVar newBasic, CoefficientChangeCallb
 
   RowIndex ridx = basicToRowIndex(oldBasic);
 
+  touchRow(ridx);
   rowPivot(oldBasic, newBasic, cb);
   Assert(ridx == basicToRowIndex(newBasic));
 
@@ -48,6 +49,7 @@ void Tableau::pivot(ArithVar oldBasic, ArithVar newBasic, CoefficientChangeCallb
 
     RowIndex to = entry.getRowIndex();
     Rational coeff = entry.getCoefficient();
+    touchRow(to);
     if(cb.canUseRow(to)){
       rowPlusBufferTimesConstant(to, coeff, cb);
     }else{
@@ -107,6 +109,7 @@ void Tableau::addRow(ArithVar basic,
 
   RowIndex newRow = Matrix<Rational>::addRow(coefficients, variables);
   addEntry(newRow, basic, Rational(-1));
+  touchRow(newRow);
 
   Assert(!d_basic2RowIndex.isKey(basic));
   Assert(!d_rowIndex2basic.isKey(newRow));
@@ -148,6 +151,7 @@ void Tableau::addRow(ArithVar basic,
 void Tableau::removeBasicRow(ArithVar basic){
   RowIndex rid = basicToRowIndex(basic);
 
+  touchRow(rid);
   removeRow(rid);
   d_basic2RowIndex.remove(basic);
   d_rowIndex2basic.remove(rid);
@@ -156,6 +160,7 @@ void Tableau::removeBasicRow(ArithVar basic){
 void Tableau::substitutePlusTimesConstant(ArithVar to, ArithVar from, const Rational& mult,  CoefficientChangeCallback& cb){
   if(!mult.isZero()){
     RowIndex to_idx = basicToRowIndex(to);
+    touchRow(to_idx);
     addEntry(to_idx, from, mult); // Add an entry to be cancelled out
     RowIndex from_idx = basicToRowIndex(from);
 
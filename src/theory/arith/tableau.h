@@ -48,9 +48,13 @@ private:
   typedef DenseMap<ArithVar> RowIndexToBasicMap;
   RowIndexToBasicMap d_rowIndex2basic;
 
+  // RowIndex |-> the stamp of the last change to the row
+  std::vector<uint64_t> d_rowStamps;
+  uint64_t d_lastStamp;
+
 public:
 
-  Tableau() : Matrix<Rational>(Rational(0)) {}
+  Tableau() : Matrix<Rational>(Rational(0)), d_lastStamp(0) {}
 
   typedef Matrix<Rational>::ColIterator ColIterator;
   typedef Matrix<Rational>::RowIterator RowIterator;
@@ -102,6 +106,16 @@ public:
     return findEntry(basicToRowIndex(basic), col);
   }
 
+  /**
+   * Returns a stamp that changes whenever the entries of the row change
+   * (including when its row index is reused), so that information cached
+   * per row can be checked for being stale. The stamp is never 0.
+   */
+  uint64_t getRowStamp(RowIndex rid) const {
+    Assert(rid < d_rowStamps.size());
+    return d_rowStamps[rid];
+  }
+
   /**
    * Adds a row to the tableau.
    * The new row is equivalent to:
@@ -140,6 +154,7 @@ public:
 
   void directlyAddToCoefficient(ArithVar rowVar, ArithVar col, const Rational& mult,  CoefficientChangeCallback& cb){
     RowIndex ridx = basicToRowIndex(rowVar);
+    touchRow(ridx);
     manipulateRowEntry(ridx, col, mult, cb);
   }
 
@@ -155,6 +170,14 @@ private:
   /* Changes the basic variable on the row for basicOld to basicNew. */
   void rowPivot(ArithVar basicOld, ArithVar basicNew, CoefficientChangeCallback& cb);
 
+  /* Gives the row a new stamp. */
+  void touchRow(RowIndex rid){
+    if(rid >= d_rowStamps.size()){
+      d_rowStamps.resize(rid + 1, 0);
+    }
+    d_rowStamps[rid] = ++d_lastStamp;
+  }
+
 };/* class Tableau */
 
 
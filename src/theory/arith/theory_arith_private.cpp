@@ -19,6 +19,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <map>
 #include <queue>
 #include <vector>
@@ -52,6 +53,7 @@
 #include "theory/arith/cut_log.h"
 #include "theory/arith/delta_rational.h"
 #include "theory/arith/dio_solver.h"
+#include "theory/arith/fp_simplex.h"
 #include "theory/arith/linear_equality.h"
 #include "theory/arith/matrix.h"
 #include "theory/arith/nonlinear_extension.h"
@@ -110,6 +112,7 @@ TheoryArithPrivate::TheoryArithPrivate(TheoryArith& containing,
               d_tableau,
               d_rowTracking,
               BasicVarModelUpdateCallBack(*this)),
+      d_rowActivity(d_partialModel, d_tableau),
       d_diosolver(c),
       d_restartsCounter(0),
       d_tableauSizeHasBeenModified(false),
@@ -142,6 +145,9 @@ TheoryArithPrivate::TheoryArithPrivate(TheoryArith& containing,
       d_fullCheckCounter(0),
       d_cutCount(c, 0),
       d_cutInContext(c),
+      d_gomoryCutRows(c),
+      d_gomoryCuts(u),
+      d_cutsSinceBranch(0),
       d_likelyIntegerInfeasible(c, false),
       d_guessedCoeffSet(c, false),
       d_guessedCoeffs(),
@@ -344,6 +350,7 @@ TheoryArithPrivate::Statistics::Statistics()
   , d_presolveTime("theory::arith::presolveTime")
   , d_newPropTime("theory::arith::newPropTimer")
   , d_externalBranchAndBounds("theory::arith::externalBranchAndBounds",0)
+  , d_gomoryCuts("theory::arith::gomoryCuts", 0)
   , d_initialTableauSize("theory::arith::initialTableauSize", 0)
   , d_currSetToSmaller("theory::arith::currSetToSmaller", 0)
   , d_smallerSetToCurr("theory::arith::smallerSetToCurr", 0)
@@ -406,6 +413,12 @@ TheoryArithPrivate::Statistics::Statistics()
   , d_mipProofsAttempted("theory::arith::z::mip::proofs::attempted", 0)
   , d_mipProofsSuccessful("theory::arith::z::mip::proofs::successful", 0)
   , d_numBranchesFailed("theory::arith::z::mip::branch::proof::failed", 0)
+  , d_fpWarmStartCalls("theory::arith::fp::calls", 0)
+  , d_fpWarmStartPivots("theory::arith::fp::pivots", 0)
+  , d_fpWarmStartDecided("theory::arith::fp::decided", 0)
+  , d_fpWarmStartRepairs("theory::arith::fp::repairs", 0)
+  , d_fpWarmStartFailures("theory::arith::fp::failures", 0)
+  , d_fpWarmStartTimer("theory::arith::fp::timer")
 {
   smtStatisticsRegistry()->registerStat(&d_statAssertUpperConflicts);
   smtStatisticsRegistry()->registerStat(&d_statAssertLowerConflicts);
@@ -421,6 +434,7 @@ TheoryArithPrivate::Statistics::Statistics()
   smtStatisticsRegistry()->registerStat(&d_newPropTime);
 
   smtStatisticsRegistry()->registerStat(&d_externalBranchAndBounds);
+  smtStatisticsRegistry()->registerStat(&d_gomoryCuts);
 
   smtStatisticsRegistry()->registerStat(&d_initialTableauSize);
   smtStatisticsRegistry()->registerStat(&d_currSetToSmaller);
@@ -497,6 +511,13 @@ TheoryArithPrivate::Statistics::Statistics()
   smtStatisticsRegistry()->registerStat(&d_mipProofsAttempted);
   smtStatisticsRegistry()->registerStat(&d_mipProofsSuccessful);
   smtStatisticsRegistry()->registerStat(&d_numBranchesFailed);
+
+  smtStatisticsRegistry()->registerStat(&d_fpWarmStartCalls);
+  smtStatisticsRegistry()->registerStat(&d_fpWarmStartPivots);
+  smtStatisticsRegistry()->registerStat(&d_fpWarmStartDecided);
+  smtStatisticsRegistry()->registerStat(&d_fpWarmStartRepairs);
+  smtStatisticsRegistry()->registerStat(&d_fpWarmStartFailures);
+  smtStatisticsRegistry()->registerStat(&d_fpWarmStartTimer);
 }
 
 TheoryArithPrivate::Statistics::~Statistics(){
@@ -514,6 +535,7 @@ TheoryArithPrivate::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_newPropTime);
 
   smtStatisticsRegistry()->unregisterStat(&d_externalBranchAndBounds);
+  smtStatisticsRegistry()->unregisterStat(&d_gomoryCuts);
 
   smtStatisticsRegistry()->unregisterStat(&d_initialTableauSize);
   smtStatisticsRegistry()->unregisterStat(&d_currSetToSmaller);
@@ -591,6 +613,13 @@ TheoryArithPrivate::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_mipProofsAttempted);
   smtStatisticsRegistry()->unregisterStat(&d_mipProofsSuccessful);
   smtStatisticsRegistry()->unregisterStat(&d_numBranchesFailed);
+
+  smtStatisticsRegistry()->unregisterStat(&d_fpWarmStartCalls);
+  smtStatisticsRegistry()->unregisterStat(&d_fpWarmStartPivots);
+  smtStatisticsRegistry()->unregisterStat(&d_fpWarmStartDecided);
+  smtStatisticsRegistry()->unregisterStat(&d_fpWarmStartRepairs);
+  smtStatisticsRegistry()->unregisterStat(&d_fpWarmStartFailures);
+  smtStatisticsRegistry()->unregisterStat(&d_fpWarmStartTimer);
 }
 
 bool complexityBelow(const DenseMap<Rational>& row, uint32_t cap){
@@ -2137,7 +2166,7 @@ Node flattenAndSort(Node n){
 void TheoryArithPrivate::outputConflicts(){
   Debug("arith::conflict") << "outputting conflicts" << std::endl;
   Assert(anyConflict());
-  static unsigned int conflicts = 0;
+  static thread_local unsigned int conflicts = 0;
   
   if(!conflictQueueEmpty()){
     Assert(!d_conflicts.empty());
@@ -2199,9 +2228,9 @@ void TheoryArithPrivate::outputConflicts(){
   }
 }
 
-void TheoryArithPrivate::outputLemma(TNode lem) {
+void TheoryArithPrivate::outputLemma(TNode lem, bool removable) {
   Debug("arith::lemma") << "Arith Lemma: " << lem << std::endl;
-  (d_containing.d_out)->lemma(lem);
+  (d_containing.d_out)->lemma(lem, removable);
 }
 
 // void TheoryArithPrivate::branchVector(const std::vector<ArithVar>& lemmas){
@@ -3287,6 +3316,42 @@ bool TheoryArithPrivate::solveRelaxationOrPanic(Theory::Effort effortLevel){
   return false;
 }
 
+Result::Sat TheoryArithPrivate::fpWarmStart()
+{
+  if (d_tableau.getNumRows() < options::arithFpWarmStartRows()
+      || (d_errorSet.errorEmpty() && !d_errorSet.moreSignals()))
+  {
+    return Result::SAT_UNKNOWN;
+  }
+  TimerStat::CodeTimer codeTimer(d_statistics.d_fpWarmStartTimer);
+  ++d_statistics.d_fpWarmStartCalls;
+
+  FloatingPointSimplex fp(d_partialModel, d_tableau);
+  LinResult res = fp.solve(options::arithFpWarmStartPivots());
+  d_statistics.d_fpWarmStartPivots += fp.getPivots();
+  Debug("arith::fp") << "fpWarmStart() " << res << " after " << fp.getPivots()
+                     << " pivots" << endl;
+  if (res != LinFeasible && res != LinInfeasible)
+  {
+    // the exact state has not been touched
+    ++d_statistics.d_fpWarmStartFailures;
+    return Result::SAT_UNKNOWN;
+  }
+
+  // the exact simplex verifies the basis, and repairs it if it is not
+  // decided yet
+  Result::Sat status = d_attemptSolSimplex.attempt(fp.extractSolution());
+  if (status == Result::SAT_UNKNOWN)
+  {
+    ++d_statistics.d_fpWarmStartRepairs;
+  }
+  else
+  {
+    ++d_statistics.d_fpWarmStartDecided;
+  }
+  return status;
+}
+
 bool TheoryArithPrivate::solveRealRelaxation(Theory::Effort effortLevel){
   TimerStat::CodeTimer codeTimer(d_statistics.d_solveRealRelaxTimer);
   Assert(d_qflraStatus != Result::SAT);
@@ -3312,7 +3377,11 @@ bool TheoryArithPrivate::solveRealRelaxation(Theory::Effort effortLevel){
     << endl;
   
   bool noPivotLimitPass1 = noPivotLimit && !useApprox;
-  d_qflraStatus = simplex.findModel(noPivotLimitPass1);
+  Result::Sat warmStart =
+      options::arithFpWarmStart() ? fpWarmStart() : Result::SAT_UNKNOWN;
+  d_qflraStatus = warmStart != Result::SAT_UNKNOWN
+                      ? warmStart
+                      : simplex.findModel(noPivotLimitPass1);
 
   Debug("TheoryArithPrivate::solveRealRelaxation")
     << "solveRealRelaxation()" << " pass1 " << d_qflraStatus << endl;
@@ -3844,10 +3913,28 @@ void TheoryArithPrivate::check(Theory::Effort effortLevel){
       }
     }
 
+    if (!emmittedConflictOrSplit && options::arithGomoryCuts()
+        && d_cutsSinceBranch < options::arithCutBranchRatio())
+    {
+      Node possibleLemma = gomoryCut();
+      if (!possibleLemma.isNull())
+      {
+        ++(d_statistics.d_gomoryCuts);
+        ++d_cutsSinceBranch;
+        d_cutCount = d_cutCount + 1;
+        emmittedConflictOrSplit = true;
+        Debug("arith::lemma") << "gomory cut " << possibleLemma << endl;
+        // the cuts are removable, the SAT solver ages them out with the other
+        // learned clauses
+        outputLemma(possibleLemma, true);
+      }
+    }
+
     if(!emmittedConflictOrSplit) {
       Node possibleLemma = roundRobinBranch();
       if(!possibleLemma.isNull()){
         ++(d_statistics.d_externalBranchAndBounds);
+        d_cutsSinceBranch = 0;
         d_cutCount = d_cutCount + 1;
         emmittedConflictOrSplit = true;
         Debug("arith::lemma") << "rrbranch lemma"
@@ -3966,6 +4053,148 @@ Node TheoryArithPrivate::roundRobinBranch(){
   }
 }
 
+Node TheoryArithPrivate::gomoryCut()
+{
+  // the candidate rows, by the distance of the assignment of their basic
+  // variable to the closest integer, most fractional first
+  std::vector<std::pair<Rational, ArithVar>> rows;
+  for (ArithVar v = 0, max = d_partialModel.getNumberOfVariables(); v < max;
+       ++v)
+  {
+    if (!isInteger(v) || !d_tableau.isBasic(v) || d_gomoryCutRows.contains(v))
+    {
+      continue;
+    }
+    const DeltaRational& d = d_partialModel.getAssignment(v);
+    if (!d.infinitesimalIsZero() || d.isIntegral())
+    {
+      continue;
+    }
+    Rational f = d.getNoninfinitesimalPart().floor_frac();
+    Rational dist = f < Rational(1, 2) ? f : Rational(1) - f;
+    rows.push_back(std::make_pair(dist, v));
+  }
+  std::sort(rows.begin(),
+            rows.end(),
+            [](const std::pair<Rational, ArithVar>& a,
+               const std::pair<Rational, ArithVar>& b) {
+              return a.first > b.first;
+            });
+  for (const std::pair<Rational, ArithVar>& r : rows)
+  {
+    d_gomoryCutRows.insert(r.second);
+    ConstraintCPVec exp;
+    Node cut = gomoryCutFromRow(r.second, exp);
+    if (cut.isNull())
+    {
+      continue;
+    }
+    Node lem = cut;
+    if (!exp.empty())
+    {
+      // a single clause, removable lemmas cannot contain Boolean structure
+      Node bounds = Constraint::externalExplainByAssertions(exp);
+      NodeBuilder<> nb(kind::OR);
+      if (bounds.getKind() == kind::AND)
+      {
+        for (const Node& b : bounds)
+        {
+          nb << b.negate();
+        }
+      }
+      else
+      {
+        nb << bounds.negate();
+      }
+      nb << cut;
+      lem = nb;
+    }
+    if (d_gomoryCuts.contains(lem))
+    {
+      continue;
+    }
+    d_gomoryCuts.insert(lem);
+    Trace("integers") << "integers: gomory cut on " << r.second << ": " << lem
+                      << endl;
+    return lem;
+  }
+  return Node::null();
+}
+
+Node TheoryArithPrivate::gomoryCutFromRow(ArithVar basic,
+                                          ConstraintCPVec& exp) const
+{
+  // The row is basic = sum_j a_j x_j. Each nonbasic x_j is at a bound b_j,
+  // and y_j is its distance to it, i.e. x_j - b_j at a lower bound and
+  // b_j - x_j at an upper bound. Then basic - sum_j c_j y_j = beta, where c_j
+  // is a_j at a lower bound and -a_j at an upper bound, and beta is the
+  // fractional assignment of basic. With f0 the fractional part of beta, and
+  // f_j that of -c_j, the Gomory mixed-integer cut is
+  //   sum_j g_j y_j >= 1
+  // where g_j is f_j/f0 if f_j <= f0 and (1-f_j)/(1-f0) otherwise for integral
+  // y_j, and -c_j/f0 if -c_j > 0 and c_j/(1-f0) otherwise for the others.
+  // It holds for all integral values of basic, and is violated by y_j = 0.
+  Rational f0 =
+      d_partialModel.getAssignment(basic).getNoninfinitesimalPart().floor_frac();
+  Assert(f0.sgn() > 0);
+  Rational oneMinusF0 = Rational(1) - f0;
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<Node> sum;
+  Rational rhs(1);
+  for (Tableau::RowIterator i = d_tableau.basicRowIterator(basic); !i.atEnd();
+       ++i)
+  {
+    const Tableau::Entry& entry = *i;
+    ArithVar x = entry.getColVar();
+    if (x == basic)
+    {
+      continue;
+    }
+    const DeltaRational& value = d_partialModel.getAssignment(x);
+    if (!value.infinitesimalIsZero())
+    {
+      return Node::null();
+    }
+    bool atLower = d_partialModel.hasLowerBound(x)
+                   && d_partialModel.getLowerBound(x) == value;
+    if (!atLower
+        && !(d_partialModel.hasUpperBound(x)
+             && d_partialModel.getUpperBound(x) == value))
+    {
+      return Node::null();
+    }
+    const Rational& b = value.getNoninfinitesimalPart();
+    Rational c = atLower ? entry.getCoefficient() : -entry.getCoefficient();
+    Rational g;
+    if (isInteger(x) && b.isIntegral())
+    {
+      Rational fj = (-c).floor_frac();
+      g = fj <= f0 ? fj / f0 : (Rational(1) - fj) / oneMinusF0;
+    }
+    else
+    {
+      g = c.sgn() < 0 ? -c / f0 : c / oneMinusF0;
+    }
+    if (g.isZero())
+    {
+      // an integral term, whose bound is not needed
+      continue;
+    }
+    exp.push_back(atLower ? d_partialModel.getLowerBoundConstraint(x)
+                          : d_partialModel.getUpperBoundConstraint(x));
+    // g * y_j is g * x_j - g * b at a lower bound and g * b - g * x_j at an
+    // upper bound
+    Rational coeff = atLower ? g : -g;
+    rhs += coeff * b;
+    sum.push_back(nm->mkNode(
+        kind::MULT, mkRationalNode(coeff), d_partialModel.asNode(x)));
+  }
+  Node lhs = sum.empty() ? mkRationalNode(Rational(0))
+                         : (sum.size() == 1 ? sum[0]
+                                            : nm->mkNode(kind::PLUS, sum));
+  return Rewriter::rewrite(nm->mkNode(kind::GEQ, lhs, mkRationalNode(rhs)));
+}
+
 bool TheoryArithPrivate::splitDisequalities(){
   bool splitSomething = false;
 
@@ -4764,7 +4993,11 @@ bool TheoryArithPrivate::attemptSingleton(RowIndex ridx, bool rowUp){
   Debug("arith::prop") << "  " << propagateMightSucceed(v, vUp) << endl;
 
   if(propagateMightSucceed(v, vUp)){
-    DeltaRational dr = d_linEq.computeRowBound(ridx, rowUp, v);
+    // v lacks the bound, so the activity of the row skips it
+    DeltaRational dr = options::arithRowActivity()
+                           ? d_rowActivity.getActivity(ridx, rowUp)
+                           : d_linEq.computeRowBound(ridx, rowUp, v);
+    Assert(dr == d_linEq.computeRowBound(ridx, rowUp, v));
     DeltaRational bound = dr / (- coeff);
     return tryToPropagate(ridx, rowUp, v, vUp, bound);
   }
@@ -4787,8 +5020,11 @@ bool TheoryArithPrivate::attemptFull(RowIndex ridx, bool rowUp){
   }
   if(candidates.empty()){ return false; }
 
-  const DeltaRational slack =
-    d_linEq.computeRowBound(ridx, rowUp, ARITHVAR_SENTINEL);
+  const DeltaRational slack = options::arithRowActivity()
+                                  ? d_rowActivity.getActivity(ridx, rowUp)
+                                  : d_linEq.computeRowBound(
+                                        ridx, rowUp, ARITHVAR_SENTINEL);
+  Assert(slack == d_linEq.computeRowBound(ridx, rowUp, ARITHVAR_SENTINEL));
   bool any = false;
   vector<const Tableau::Entry*>::const_iterator i, iend;
   for(i = candidates.begin(), iend = candidates.end(); i != iend; ++i){
@@ -4931,7 +5167,7 @@ bool TheoryArithPrivate::propagateCandidateRow(RowIndex ridx){
   uint32_t rowLength = d_tableau.getRowLength(ridx);
 
   bool success = false;
-  static int instance = 0;
+  static thread_local int instance = 0;
   ++instance;
 
   Debug("arith::prop")
@@ -55,6 +55,7 @@
 #include "theory/arith/normal_form.h"
 #include "theory/arith/partial_model.h"
 #include "theory/arith/partial_model.h"
+#include "theory/arith/row_activity.h"
 #include "theory/arith/simplex.h"
 #include "theory/arith/soi_simplex.h"
 #include "theory/arith/theory_arith.h"
@@ -285,6 +286,12 @@ private:
    */
   LinearEqualityModule d_linEq;
 
+  /**
+   * The bound activities of the rows, which bound propagation uses instead
+   * of rescanning the rows (--arith-row-activity).
+   */
+  RowActivity d_rowActivity;
+
   /**
    * A Diophantine equation solver.  Accesses the tableau and partial
    * model (each in a read-only fashion).
@@ -392,6 +399,12 @@ private:
   /* Sets d_qflraStatus */
   void importSolution(const ApproximateSimplex::Solution& solution);
   bool solveRelaxationOrPanic(Theory::Effort effortLevel);
+  /**
+   * Runs the floating-point simplex on a copy of the tableau and imports its
+   * basis. Returns SAT or UNSAT if the imported basis decides the relaxation
+   * and SAT_UNKNOWN otherwise, leaving the rest to the exact simplex.
+   */
+  Result::Sat fpWarmStart();
   context::CDO<int> d_lastContextIntegerAttempted;
   bool replayLog(ApproximateSimplex* approx);
 
@@ -518,6 +531,25 @@ private:
    */
   Node roundRobinBranch();
 
+  /**
+   * Returns a Gomory mixed-integer cut from the row of a basic integer
+   * variable with a non-integer assignment, as a clause of the form
+   * (or (not b1) ... (not bn) cut), where the bi are the bounds of the
+   * nonbasic variables of the row, which must all be at one of their bounds.
+   * The clause is flat, so it can be sent as a removable lemma. The cut is
+   * violated by the current assignment. The rows are tried from the most
+   * fractional assignment on, and each row is tried at most once per context.
+   * Returns Node::null() if no row yields a new cut.
+   */
+  Node gomoryCut();
+
+  /**
+   * Returns the Gomory mixed-integer cut of the row of the basic variable
+   * basic, or Node::null() if some nonbasic variable of the row is not at one
+   * of its bounds. The explanation of the bounds used is added to exp.
+   */
+  Node gomoryCutFromRow(ArithVar basic, ConstraintCPVec& exp) const;
+
 public:
   /**
    * This requests a new unique ArithVar value for x.
@@ -654,7 +686,7 @@ private:
     (d_containing.d_out)->setIncomplete();
     d_nlIncomplete = true;
   }
-  void outputLemma(TNode lem);
+  void outputLemma(TNode lem, bool removable = false);
   inline void outputPropagate(TNode lit) { (d_containing.d_out)->propagate(lit); }
   inline void outputRestart() { (d_containing.d_out)->demandRestart(); }
 
@@ -677,6 +709,13 @@ private:
   context::CDO<unsigned> d_cutCount;
   context::CDHashSet<ArithVar, std::hash<ArithVar> > d_cutInContext;
 
+  /** The basic variables whose row was tried for a Gomory cut in context */
+  context::CDHashSet<ArithVar, std::hash<ArithVar> > d_gomoryCutRows;
+  /** The Gomory cuts sent as lemmas, which are not sent again */
+  context::CDHashSet<Node, NodeHashFunction> d_gomoryCuts;
+  /** The number of Gomory cuts sent since the last branch */
+  unsigned d_cutsSinceBranch;
+
   context::CDO<bool> d_likelyIntegerInfeasible;
 
 
@@ -741,6 +780,7 @@ private:
     TimerStat d_newPropTime;
 
     IntStat d_externalBranchAndBounds;
+    IntStat d_gomoryCuts;
 
     IntStat d_initialTableauSize;
     IntStat d_currSetToSmaller;
@@ -819,6 +859,13 @@ private:
 
     IntStat d_numBranchesFailed;
 
+    IntStat d_fpWarmStartCalls;
+    IntStat d_fpWarmStartPivots;
+    IntStat d_fpWarmStartDecided;
+    IntStat d_fpWarmStartRepairs;
+    IntStat d_fpWarmStartFailures;
+    TimerStat d_fpWarmStartTimer;
+
 
 
     Statistics();
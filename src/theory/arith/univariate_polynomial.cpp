@@ -0,0 +1,350 @@
+/*********************                                                        */
+/*! \file univariate_polynomial.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Univariate polynomials with rational coefficients and the
+ ** isolation of their real roots.
+ **
+ ** Univariate polynomials with rational coefficients and the isolation of
+ ** their real roots.
+ **/
+
+#include "theory/arith/univariate_polynomial.h"
+
+#include <iostream>
+
+#include "base/check.h"
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+UnivariatePolynomial::UnivariatePolynomial(const std::vector<Rational>& coeffs)
+    : d_coeffs(coeffs)
+{
+  normalize();
+}
+
+void UnivariatePolynomial::normalize()
+{
+  while (!d_coeffs.empty() && d_coeffs.back().isZero())
+  {
+    d_coeffs.pop_back();
+  }
+}
+
+Rational UnivariatePolynomial::getCoefficient(unsigned i) const
+{
+  return i < d_coeffs.size() ? d_coeffs[i] : Rational(0);
+}
+
+Rational UnivariatePolynomial::getLeadingCoefficient() const
+{
+  return d_coeffs.empty() ? Rational(0) : d_coeffs.back();
+}
+
+Rational UnivariatePolynomial::evaluate(const Rational& x) const
+{
+  // Horner's scheme
+  Rational v(0);
+  for (size_t i = d_coeffs.size(); i-- > 0;)
+  {
+    v = v * x + d_coeffs[i];
+  }
+  return v;
+}
+
+UnivariatePolynomial UnivariatePolynomial::derivative() const
+{
+  std::vector<Rational> coeffs;
+  for (size_t i = 1, size = d_coeffs.size(); i < size; i++)
+  {
+    coeffs.push_back(d_coeffs[i] * Rational(static_cast<unsigned long>(i)));
+  }
+  return UnivariatePolynomial(coeffs);
+}
+
+UnivariatePolynomial UnivariatePolynomial::operator*(
+    const UnivariatePolynomial& p) const
+{
+  if (isZero() || p.isZero())
+  {
+    return UnivariatePolynomial();
+  }
+  std::vector<Rational> coeffs(d_coeffs.size() + p.d_coeffs.size() - 1);
+  for (size_t i = 0, isize = d_coeffs.size(); i < isize; i++)
+  {
+    for (size_t j = 0, jsize = p.d_coeffs.size(); j < jsize; j++)
+    {
+      coeffs[i + j] += d_coeffs[i] * p.d_coeffs[j];
+    }
+  }
+  return UnivariatePolynomial(coeffs);
+}
+
+UnivariatePolynomial UnivariatePolynomial::operator-(
+    const UnivariatePolynomial& p) const
+{
+  std::vector<Rational> coeffs(std::max(d_coeffs.size(), p.d_coeffs.size()));
+  for (size_t i = 0, size = coeffs.size(); i < size; i++)
+  {
+    coeffs[i] = getCoefficient(i) - p.getCoefficient(i);
+  }
+  return UnivariatePolynomial(coeffs);
+}
+
+void UnivariatePolynomial::divide(const UnivariatePolynomial& d,
+                                  UnivariatePolynomial& q,
+                                  UnivariatePolynomial& r) const
+{
+  Assert(!d.isZero());
+  std::vector<Rational> rem = d_coeffs;
+  int dd = d.getDegree();
+  std::vector<Rational> quot(
+      getDegree() >= dd ? static_cast<size_t>(getDegree() - dd + 1) : 0);
+  Rational lc = d.getLeadingCoefficient();
+  for (int k = getDegree(); k >= dd; k--)
+  {
+    Rational c = rem[k] / lc;
+    quot[k - dd] = c;
+    if (c.isZero())
+    {
+      continue;
+    }
+    for (int j = 0; j <= dd; j++)
+    {
+      rem[k - dd + j] -= c * d.d_coeffs[j];
+    }
+  }
+  q = UnivariatePolynomial(quot);
+  r = UnivariatePolynomial(rem);
+}
+
+UnivariatePolynomial UnivariatePolynomial::gcd(const UnivariatePolynomial& a,
+                                               const UnivariatePolynomial& b)
+{
+  UnivariatePolynomial x = a;
+  UnivariatePolynomial y = b;
+  while (!y.isZero())
+  {
+    UnivariatePolynomial q, r;
+    x.divide(y, q, r);
+    x = y;
+    y = r;
+  }
+  if (!x.isZero())
+  {
+    Rational lc = x.getLeadingCoefficient();
+    for (Rational& c : x.d_coeffs)
+    {
+      c = c / lc;
+    }
+  }
+  return x;
+}
+
+UnivariatePolynomial UnivariatePolynomial::squareFreePart() const
+{
+  if (isZero())
+  {
+    return *this;
+  }
+  UnivariatePolynomial q, r;
+  divide(gcd(*this, derivative()), q, r);
+  Assert(r.isZero());
+  return q;
+}
+
+void UnivariatePolynomial::getSturmSequence(
+    std::vector<UnivariatePolynomial>& seq) const
+{
+  seq.clear();
+  seq.push_back(*this);
+  seq.push_back(derivative());
+  while (!seq.back().isZero())
+  {
+    UnivariatePolynomial q, r;
+    seq[seq.size() - 2].divide(seq.back(), q, r);
+    seq.push_back(UnivariatePolynomial() - r);
+  }
+  seq.pop_back();
+}
+
+unsigned UnivariatePolynomial::signChanges(
+    const std::vector<UnivariatePolynomial>& seq, const Rational& x)
+{
+  unsigned changes = 0;
+  int last = 0;
+  for (const UnivariatePolynomial& p : seq)
+  {
+    int s = p.sgnAt(x);
+    if (s != 0)
+    {
+      if (last != 0 && s != last)
+      {
+        changes++;
+      }
+      last = s;
+    }
+  }
+  return changes;
+}
+
+unsigned UnivariatePolynomial::countRoots(const Rational& a,
+                                          const Rational& b) const
+{
+  Assert(!isZero());
+  std::vector<UnivariatePolynomial> seq;
+  squareFreePart().getSturmSequence(seq);
+  unsigned va = signChanges(seq, a);
+  unsigned vb = signChanges(seq, b);
+  return va > vb ? va - vb : 0;
+}
+
+void UnivariatePolynomial::isolateRoots(std::vector<Root>& roots) const
+{
+  Assert(!isZero());
+  roots.clear();
+  UnivariatePolynomial sf = squareFreePart();
+  if (sf.getDegree() < 1)
+  {
+    return;
+  }
+  // Cauchy: every root is less than 1 + max |a_i / a_n| in magnitude
+  Rational bound(0);
+  Rational lc = sf.getLeadingCoefficient();
+  for (const Rational& c : sf.d_coeffs)
+  {
+    Rational b = (c / lc).abs();
+    if (b > bound)
+    {
+      bound = b;
+    }
+  }
+  bound = bound + Rational(1);
+  std::vector<UnivariatePolynomial> seq;
+  sf.getSturmSequence(seq);
+  unsigned n = signChanges(seq, -bound) - signChanges(seq, bound);
+  sf.isolateRoots(seq, -bound, bound, n, roots);
+}
+
+void UnivariatePolynomial::isolateRoots(
+    const std::vector<UnivariatePolynomial>& seq,
+    const Rational& lower,
+    const Rational& upper,
+    unsigned n,
+    std::vector<Root>& roots) const
+{
+  if (n == 0)
+  {
+    return;
+  }
+  if (n == 1)
+  {
+    Root r;
+    r.d_lower = lower;
+    r.d_upper = upper;
+    // a bound may be a root found by an earlier bisection, shrink the
+    // interval until neither is
+    while (!r.isExact() && (sgnAt(r.d_lower) == 0 || sgnAt(r.d_upper) == 0))
+    {
+      Rational mid = (r.d_lower + r.d_upper) / Rational(2);
+      if (sgnAt(mid) == 0)
+      {
+        r.d_lower = mid;
+        r.d_upper = mid;
+      }
+      else if (signChanges(seq, r.d_lower) - signChanges(seq, mid) == 1)
+      {
+        r.d_upper = mid;
+      }
+      else
+      {
+        r.d_lower = mid;
+      }
+    }
+    roots.push_back(r);
+    return;
+  }
+  Rational mid = (lower + upper) / Rational(2);
+  unsigned nlower = signChanges(seq, lower) - signChanges(seq, mid);
+  if (sgnAt(mid) == 0)
+  {
+    // nlower counts mid itself
+    isolateRoots(seq, lower, mid, nlower - 1, roots);
+    Root r;
+    r.d_lower = mid;
+    r.d_upper = mid;
+    roots.push_back(r);
+    isolateRoots(seq, mid, upper, n - nlower, roots);
+  }
+  else
+  {
+    isolateRoots(seq, lower, mid, nlower, roots);
+    isolateRoots(seq, mid, upper, n - nlower, roots);
+  }
+}
+
+void UnivariatePolynomial::refineRoot(Root& root) const
+{
+  if (root.isExact())
+  {
+    return;
+  }
+  Rational mid = (root.d_lower + root.d_upper) / Rational(2);
+  int s = sgnAt(mid);
+  if (s == 0)
+  {
+    root.d_lower = mid;
+    root.d_upper = mid;
+  }
+  else if (s == sgnAt(root.d_lower))
+  {
+    root.d_lower = mid;
+  }
+  else
+  {
+    root.d_upper = mid;
+  }
+}
+
+std::ostream& operator<<(std::ostream& out, const UnivariatePolynomial& p)
+{
+  if (p.isZero())
+  {
+    return out << "0";
+  }
+  bool first = true;
+  for (int i = p.getDegree(); i >= 0; i--)
+  {
+    Rational c = p.getCoefficient(i);
+    if (c.isZero())
+    {
+      continue;
+    }
+    if (!first)
+    {
+      out << " + ";
+    }
+    first = false;
+    out << c;
+    if (i > 0)
+    {
+      out << "*x";
+      if (i > 1)
+      {
+        out << "^" << i;
+      }
+    }
+  }
+  return out;
+}
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
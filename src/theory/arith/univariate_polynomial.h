@@ -0,0 +1,122 @@
+/*********************                                                        */
+/*! \file univariate_polynomial.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Univariate polynomials with rational coefficients and the
+ ** isolation of their real roots.
+ **
+ ** The real roots of a polynomial are isolated with its Sturm sequence: the
+ ** number of sign changes of the sequence at a minus the number at b is the
+ ** number of distinct roots in (a, b]. Bisecting the interval given by the
+ ** Cauchy bound with these counts yields an interval for each root that
+ ** contains no other root, or the root itself when a bisection point hits
+ ** it.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__ARITH__UNIVARIATE_POLYNOMIAL_H
+#define CVC4__THEORY__ARITH__UNIVARIATE_POLYNOMIAL_H
+
+#include <iosfwd>
+#include <vector>
+
+#include "util/rational.h"
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+class UnivariatePolynomial
+{
+ public:
+  /** The zero polynomial. */
+  UnivariatePolynomial() {}
+  /** The polynomial with the given coefficients, by increasing degree. */
+  UnivariatePolynomial(const std::vector<Rational>& coeffs);
+
+  bool isZero() const { return d_coeffs.empty(); }
+  /** The degree of this polynomial, -1 for the zero polynomial. */
+  int getDegree() const { return static_cast<int>(d_coeffs.size()) - 1; }
+  /** The coefficient of x^i. */
+  Rational getCoefficient(unsigned i) const;
+  /** The coefficient of the highest power, or 0. */
+  Rational getLeadingCoefficient() const;
+
+  /** The value of this polynomial at x. */
+  Rational evaluate(const Rational& x) const;
+  /** The sign of the value of this polynomial at x. */
+  int sgnAt(const Rational& x) const { return evaluate(x).sgn(); }
+
+  UnivariatePolynomial derivative() const;
+  UnivariatePolynomial operator*(const UnivariatePolynomial& p) const;
+  UnivariatePolynomial operator-(const UnivariatePolynomial& p) const;
+
+  /**
+   * Divides this polynomial by the non-zero polynomial d, so that
+   * this = q * d + r with the degree of r less than that of d.
+   */
+  void divide(const UnivariatePolynomial& d,
+              UnivariatePolynomial& q,
+              UnivariatePolynomial& r) const;
+  /** The monic greatest common divisor, the zero polynomial if both are. */
+  static UnivariatePolynomial gcd(const UnivariatePolynomial& a,
+                                  const UnivariatePolynomial& b);
+  /** This polynomial divided by its gcd with its derivative. */
+  UnivariatePolynomial squareFreePart() const;
+
+  /** An isolated real root. */
+  struct Root
+  {
+    /**
+     * The root is exactly d_lower if d_lower == d_upper, and otherwise the
+     * only root in the open interval, whose bounds are not roots.
+     */
+    Rational d_lower;
+    Rational d_upper;
+    bool isExact() const { return d_lower == d_upper; }
+  };
+
+  /**
+   * Isolates the real roots of this non-zero polynomial, in increasing
+   * order.
+   */
+  void isolateRoots(std::vector<Root>& roots) const;
+  /**
+   * Halves the interval of a root of this square-free polynomial, which may
+   * make the root exact.
+   */
+  void refineRoot(Root& root) const;
+  /** The number of distinct real roots in (a, b]. */
+  unsigned countRoots(const Rational& a, const Rational& b) const;
+
+ private:
+  /** Removes the zero coefficients of the highest powers. */
+  void normalize();
+  /** The Sturm sequence of this square-free polynomial. */
+  void getSturmSequence(std::vector<UnivariatePolynomial>& seq) const;
+  /** The number of sign changes of the Sturm sequence at x. */
+  static unsigned signChanges(const std::vector<UnivariatePolynomial>& seq,
+                              const Rational& x);
+  /** Isolates the n roots in the open interval (lower, upper). */
+  void isolateRoots(const std::vector<UnivariatePolynomial>& seq,
+                    const Rational& lower,
+                    const Rational& upper,
+                    unsigned n,
+                    std::vector<Root>& roots) const;
+
+  std::vector<Rational> d_coeffs;
+}; /* class UnivariatePolynomial */
+
+std::ostream& operator<<(std::ostream& out, const UnivariatePolynomial& p);
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__ARITH__UNIVARIATE_POLYNOMIAL_H */
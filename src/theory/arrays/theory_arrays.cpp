@@ -79,6 +79,9 @@ TheoryArrays::TheoryArrays(context::Context* c,
           name + "theory::arrays::number of setModelVal splits", 0),
       d_numSetModelValConflicts(
           name + "theory::arrays::number of setModelVal conflicts", 0),
+      d_numRowIndicesSkipped(
+          name + "theory::arrays::number of indices skipped for Row lemmas",
+          0),
       d_ppEqualityEngine(u, name + "theory::arrays::pp", true),
       d_ppFacts(u),
       //      d_ppCache(u),
@@ -125,6 +128,7 @@ TheoryArrays::TheoryArrays(context::Context* c,
   smtStatisticsRegistry()->registerStat(&d_numGetModelValConflicts);
   smtStatisticsRegistry()->registerStat(&d_numSetModelValSplits);
   smtStatisticsRegistry()->registerStat(&d_numSetModelValConflicts);
+  smtStatisticsRegistry()->registerStat(&d_numRowIndicesSkipped);
 
   d_true = NodeManager::currentNM()->mkConst<bool>(true);
   d_false = NodeManager::currentNM()->mkConst<bool>(false);
@@ -176,6 +180,7 @@ TheoryArrays::~TheoryArrays() {
   smtStatisticsRegistry()->unregisterStat(&d_numGetModelValConflicts);
   smtStatisticsRegistry()->unregisterStat(&d_numSetModelValSplits);
   smtStatisticsRegistry()->unregisterStat(&d_numSetModelValConflicts);
+  smtStatisticsRegistry()->unregisterStat(&d_numRowIndicesSkipped);
 }
 
 void TheoryArrays::setMasterEqualityEngine(eq::EqualityEngine* eq) {
@@ -1319,7 +1324,8 @@ void TheoryArrays::check(Effort e) {
     return;
   }
 
-  getOutputChannel().spendResource(options::theoryCheckStep());
+  getOutputChannel().spendResource(ResourceManager::Resource::TheoryCheckStep,
+                                   options::theoryCheckStep());
 
   TimerStat::CodeTimer checkTimer(d_checkTime);
 
@@ -1955,14 +1961,18 @@ void TheoryArrays::checkRowLemmas(TNode a, TNode b)
     }
   }
 
+  // Indices that are already equal give the same lemmas (up to congruence).
+  // If this merge is undone, so is the merge of their classes.
+  std::vector<TNode> indices;
+  getDistinctIndices(i_a, indices);
+
   const CTNodeList* st_b = d_infoMap.getStores(b);
   const CTNodeList* inst_b = d_infoMap.getInStores(b);
   size_t its;
 
   RowLemmaType lem;
 
-  for(it = 0 ; it < i_a->size(); ++it) {
-    TNode i = (*i_a)[it];
+  for (TNode i : indices) {
     its = 0;
     for ( ; its < st_b->size(); ++its) {
       TNode store = (*st_b)[its];
@@ -1976,8 +1986,7 @@ void TheoryArrays::checkRowLemmas(TNode a, TNode b)
   }
 
   if (!options::arraysOptimizeLinear() || d_infoMap.isNonLinear(b)) {
-    for(it = 0 ; it < i_a->size(); ++it ) {
-      TNode i = (*i_a)[it];
+    for (TNode i : indices) {
       its = 0;
       for ( ; its < inst_b->size(); ++its) {
         TNode store = (*inst_b)[its];
@@ -1993,6 +2002,27 @@ void TheoryArrays::checkRowLemmas(TNode a, TNode b)
   Trace("arrays-crl")<<"Arrays::checkLemmas done.\n";
 }
 
+void TheoryArrays::getDistinctIndices(const CTNodeList* indices,
+                                      std::vector<TNode>& distinct)
+{
+  std::unordered_set<TNode, TNodeHashFunction> reps;
+  for (size_t it = 0; it < indices->size(); ++it)
+  {
+    TNode i = (*indices)[it];
+    TNode rep = d_equalityEngine.hasTerm(i)
+                    ? d_equalityEngine.getRepresentative(i)
+                    : i;
+    if (reps.insert(rep).second)
+    {
+      distinct.push_back(i);
+    }
+    else
+    {
+      ++d_numRowIndicesSkipped;
+    }
+  }
+}
+
 void TheoryArrays::propagate(RowLemmaType lem)
 {
   Debug("pf::array") << "TheoryArrays: RowLemma Propagate called. options::arraysPropagate() = "
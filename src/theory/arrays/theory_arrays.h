@@ -127,6 +127,8 @@ class TheoryArrays : public Theory {
   IntStat d_numSetModelValSplits;
   /** conflicts in setModelVal */
   IntStat d_numSetModelValConflicts;
+  /** indices for which no Row lemmas were queued, since an equal index was */
+  IntStat d_numRowIndicesSkipped;
 
   // Merge reason types
 
@@ -442,6 +444,13 @@ class TheoryArrays : public Theory {
   void checkStore(TNode a);
   void checkRowForIndex(TNode i, TNode a);
   void checkRowLemmas(TNode a, TNode b);
+  /**
+   * Adds to distinct one index of indices per equivalence class. A Row
+   * lemma for any other index of the class follows from the one for this
+   * index by congruence.
+   */
+  void getDistinctIndices(const CTNodeList* indices,
+                          std::vector<TNode>& distinct);
   void propagate(RowLemmaType lem);
   void queueRowLemma(RowLemmaType lem);
   bool dischargeLemmas();
@@ -25,15 +25,49 @@ namespace arrays {
 namespace attr {
   struct ArrayConstantMostFrequentValueTag { };
   struct ArrayConstantMostFrequentValueCountTag { };
+  struct ArrayConstantDepthTag { };
+  struct ArrayConstantDefaultValueTag { };
 }/* CVC4::theory::arrays::attr namespace */
 
 typedef expr::Attribute<attr::ArrayConstantMostFrequentValueCountTag, uint64_t> ArrayConstantMostFrequentValueCountAttr;
 typedef expr::Attribute<attr::ArrayConstantMostFrequentValueTag, Node> ArrayConstantMostFrequentValueAttr;
+typedef expr::Attribute<attr::ArrayConstantDepthTag, uint64_t> ArrayConstantDepthAttr;
+typedef expr::Attribute<attr::ArrayConstantDefaultValueTag, Node> ArrayConstantDefaultValueAttr;
+
+/**
+ * Computes the most frequently written value of the constant store, which is
+ * not cached when its depth made it irrelevant to the normal form.
+ */
+static void computeMostFrequentValue(TNode store)
+{
+  std::unordered_map<TNode, uint64_t, TNodeHashFunction> counts;
+  uint64_t max = 0;
+  TNode maxValue;
+  for (TNode s = store; s.getKind() == kind::STORE; s = s[0])
+  {
+    uint64_t count = ++counts[s[2]];
+    if (count > max || (count == max && s[2] < maxValue))
+    {
+      max = count;
+      maxValue = s[2];
+    }
+  }
+  setMostFrequentValue(store, maxValue);
+  setMostFrequentValueCount(store, max);
+}
 
 Node getMostFrequentValue(TNode store) {
+  if (!store.hasAttribute(ArrayConstantMostFrequentValueCountAttr()))
+  {
+    computeMostFrequentValue(store);
+  }
   return store.getAttribute(ArrayConstantMostFrequentValueAttr());
 }
 uint64_t getMostFrequentValueCount(TNode store) {
+  if (!store.hasAttribute(ArrayConstantMostFrequentValueCountAttr()))
+  {
+    computeMostFrequentValue(store);
+  }
   return store.getAttribute(ArrayConstantMostFrequentValueCountAttr());
 }
 
@@ -44,6 +78,34 @@ void setMostFrequentValueCount(TNode store, uint64_t count) {
   return store.setAttribute(ArrayConstantMostFrequentValueCountAttr(), count);
 }
 
+uint64_t getConstantDepth(TNode a)
+{
+  if (a.getKind() == kind::STORE_ALL)
+  {
+    return 0;
+  }
+  Assert(a.getKind() == kind::STORE);
+  return a.getAttribute(ArrayConstantDepthAttr());
+}
+Node getConstantDefaultValue(TNode a)
+{
+  if (a.getKind() == kind::STORE_ALL)
+  {
+    return Node::fromExpr(a.getConst<ArrayStoreAll>().getExpr());
+  }
+  Assert(a.getKind() == kind::STORE);
+  return a.getAttribute(ArrayConstantDefaultValueAttr());
+}
+
+void setConstantDepth(TNode store, uint64_t depth)
+{
+  store.setAttribute(ArrayConstantDepthAttr(), depth);
+}
+void setConstantDefaultValue(TNode store, TNode value)
+{
+  store.setAttribute(ArrayConstantDefaultValueAttr(), value);
+}
+
 }/* CVC4::theory::arrays namespace */
 }/* CVC4::theory namespace */
 }/* CVC4 namespace */
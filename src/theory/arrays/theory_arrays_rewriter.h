@@ -36,6 +36,17 @@ uint64_t getMostFrequentValueCount(TNode store);
 void setMostFrequentValue(TNode store, TNode value);
 void setMostFrequentValueCount(TNode store, uint64_t count);
 
+/**
+ * The number of nested stores of the constant array a, and its value at the
+ * indices it does not store to. They are cached on each constant store by
+ * ArrayStoreTypeRule::computeIsConst, so that a constant store chain does not
+ * need to be walked to its STORE_ALL to be extended or read.
+ */
+uint64_t getConstantDepth(TNode a);
+Node getConstantDefaultValue(TNode a);
+void setConstantDepth(TNode store, uint64_t depth);
+void setConstantDefaultValue(TNode store, TNode value);
+
 static inline Node mkEqNode(Node a, Node b) {
   return a.eqNode(b);
 }
@@ -62,8 +73,6 @@ class TheoryArraysRewriter : public TheoryRewriter
     // Go through nested stores looking for where to insert index
     // Also check whether we are replacing an existing store
     TNode replacedValue;
-    unsigned depth = 1;
-    unsigned valCount = 1;
     while (store.getKind() == kind::STORE) {
       if (index == store[1]) {
         replacedValue = store[2];
@@ -73,27 +82,16 @@ class TheoryArraysRewriter : public TheoryRewriter
       else if (!(index < store[1])) {
         break;
       }
-      if (value == store[2]) {
-        valCount += 1;
-      }
-      depth += 1;
       indices.push_back(store[1]);
       elements.push_back(store[2]);
       store = store[0];
     }
     Node n = store;
 
-    // Get the default value at the bottom of the nested stores
-    while (store.getKind() == kind::STORE) {
-      if (value == store[2]) {
-        valCount += 1;
-      }
-      depth += 1;
-      store = store[0];
-    }
-    Assert(store.getKind() == kind::STORE_ALL);
-    ArrayStoreAll storeAll = store.getConst<ArrayStoreAll>();
-    Node defaultValue = Node::fromExpr(storeAll.getExpr());
+    // Get the default value at the bottom of the nested stores, which is
+    // cached on the constant store
+    Node defaultValue = getConstantDefaultValue(store);
+    unsigned depth = indices.size() + getConstantDepth(store) + 1;
     NodeManager* nm = NodeManager::currentNM();
 
     // Check if we are writing to default value - if so the store
@@ -122,10 +120,24 @@ class TheoryArraysRewriter : public TheoryRewriter
       return n;
     }
 
-    if (indexCard.isInfinite()) {
+    // No value is written more than depth times, hence the default value
+    // stays the most frequent one if there are more than twice as many
+    // indices as stores
+    if (indexCard.isInfinite()
+        || indexCard.compare(2 * depth) == Cardinality::GREATER)
+    {
       return n;
     }
 
+    unsigned valCount = 1;
+    for (store = node[0]; store.getKind() == kind::STORE; store = store[0])
+    {
+      if (value == store[2] && index != store[1])
+      {
+        valCount += 1;
+      }
+    }
+
     // When index sort is finite, we have to check whether there is any value
     // that is written to more than the default value.  If so, it must become
     // the new default value
@@ -242,6 +254,26 @@ class TheoryArraysRewriter : public TheoryRewriter
         TNode index = node[1];
         Node n;
         bool val;
+        if (store.isConst() && index.isConst())
+        {
+          // The indices of a constant array decrease towards its STORE_ALL,
+          // hence we can stop at the first one smaller than index
+          while (store.getKind() == kind::STORE && !(store[1] < index))
+          {
+            if (index == store[1])
+            {
+              Trace("arrays-postrewrite") << "Arrays::postRewrite returning "
+                                          << store[2] << std::endl;
+              return RewriteResponse(REWRITE_DONE, store[2]);
+            }
+            store = store[0];
+          }
+          n = getConstantDefaultValue(store);
+          Trace("arrays-postrewrite")
+              << "Arrays::postRewrite returning " << n << std::endl;
+          Assert(n.isConst());
+          return RewriteResponse(REWRITE_DONE, n);
+        }
         while (store.getKind() == kind::STORE) {
           if (index == store[1]) {
             val = true;
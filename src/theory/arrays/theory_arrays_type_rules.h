@@ -95,18 +95,9 @@ struct ArrayStoreTypeRule {
       return false;
     }
 
-    unsigned depth = 1;
-    unsigned valCount = 1;
-    while (store.getKind() == kind::STORE) {
-      depth += 1;
-      if (store[2] == value) {
-        valCount += 1;
-      }
-      store = store[0];
-    }
-    Assert(store.getKind() == kind::STORE_ALL);
-    ArrayStoreAll storeAll = store.getConst<ArrayStoreAll>();
-    Node defaultValue = Node::fromExpr(storeAll.getExpr());
+    // The depth and the default value of store are cached, see below
+    uint64_t depth = getConstantDepth(store) + 1;
+    Node defaultValue = getConstantDefaultValue(store);
     if (value == defaultValue) {
       return false;
     }
@@ -114,39 +105,50 @@ struct ArrayStoreTypeRule {
     // Get the cardinality of the index type
     Cardinality indexCard = index.getType().getCardinality();
 
-    if (indexCard.isInfinite()) {
-      return true;
-    }
-
     // When index sort is finite, we have to check whether there is any value
     // that is written to more than the default value.  If so, it is not in
-    // normal form.
-
-    // Get the most frequently written value for n[0]
-    TNode mostFrequentValue;
-    unsigned mostFrequentValueCount = 0;
-    store = n[0];
-    if (store.getKind() == kind::STORE) {
-      mostFrequentValue = getMostFrequentValue(store);
-      mostFrequentValueCount = getMostFrequentValueCount(store);
-    }
+    // normal form.  No value is written more than depth times, so this can
+    // only happen for chains with at least half as many stores as indices.
+    if (!indexCard.isInfinite()
+        && indexCard.compare(2 * depth) != Cardinality::GREATER)
+    {
+      unsigned valCount = 1;
+      for (; store.getKind() == kind::STORE; store = store[0])
+      {
+        if (store[2] == value)
+        {
+          valCount += 1;
+        }
+      }
 
-    // Compute the most frequently written value for n
-    if (valCount > mostFrequentValueCount ||
-        (valCount == mostFrequentValueCount && value < mostFrequentValue)) {
-      mostFrequentValue = value;
-      mostFrequentValueCount = valCount;
-    }
+      // Get the most frequently written value for n[0]
+      TNode mostFrequentValue;
+      unsigned mostFrequentValueCount = 0;
+      store = n[0];
+      if (store.getKind() == kind::STORE) {
+        mostFrequentValue = getMostFrequentValue(store);
+        mostFrequentValueCount = getMostFrequentValueCount(store);
+      }
 
-    // Need to make sure the default value count is larger, or the same and the default value is expression-order-less-than nextValue
-    Cardinality::CardinalityComparison compare = indexCard.compare(mostFrequentValueCount + depth);
-    Assert(compare != Cardinality::UNKNOWN);
-    if (compare == Cardinality::LESS ||
-        (compare == Cardinality::EQUAL && (!(defaultValue < mostFrequentValue)))) {
-      return false;
+      // Compute the most frequently written value for n
+      if (valCount > mostFrequentValueCount ||
+          (valCount == mostFrequentValueCount && value < mostFrequentValue)) {
+        mostFrequentValue = value;
+        mostFrequentValueCount = valCount;
+      }
+
+      // Need to make sure the default value count is larger, or the same and the default value is expression-order-less-than nextValue
+      Cardinality::CardinalityComparison compare = indexCard.compare(mostFrequentValueCount + depth);
+      Assert(compare != Cardinality::UNKNOWN);
+      if (compare == Cardinality::LESS ||
+          (compare == Cardinality::EQUAL && (!(defaultValue < mostFrequentValue)))) {
+        return false;
+      }
+      setMostFrequentValue(n, mostFrequentValue);
+      setMostFrequentValueCount(n, mostFrequentValueCount);
     }
-    setMostFrequentValue(n, mostFrequentValue);
-    setMostFrequentValueCount(n, mostFrequentValueCount);
+    setConstantDepth(n, depth);
+    setConstantDefaultValue(n, defaultValue);
     return true;
   }
 
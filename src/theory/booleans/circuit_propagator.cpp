@@ -72,6 +72,10 @@ void CircuitPropagator::computeBackEdges(TNode node) {
         TNode childNode = current[child];
         // Add the back edge
         d_backEdges[childNode].push_back(current);
+        if (isAssigned(childNode))
+        {
+          countAssignedChild(current, getAssignment(childNode));
+        }
         // Add to the queue if not seen yet
         if (d_seen.find(childNode) == d_seen.end()) {
           toVisit.push_back(childNode);
@@ -216,18 +220,16 @@ void CircuitPropagator::propagateForward(TNode child, bool childAssignment) {
     switch(parent.getKind()) {
     case kind::AND:
       if (childAssignment) {
-        TNode::iterator holdout;
-        holdout = find_if (parent.begin(), parent.end(), not1(IsAssignedTo(*this, true)));
-        if (holdout == parent.end()) { // all children are assigned TRUE
+        unsigned numTrue = getNumChildrenAssigned(parent);
+        if (numTrue == parent.getNumChildren()) { // all children are assigned TRUE
           // AND ...(x=TRUE)...: if all children now assigned to TRUE, assign(AND = TRUE)
           assignAndEnqueue(parent, true);
-        } else if (isAssignedTo(parent, false)) {// the AND is FALSE
-          // is the holdout unique ?
-          TNode::iterator other = find_if (holdout + 1, parent.end(), not1(IsAssignedTo(*this, true)));
-          if (other == parent.end()) { // the holdout is unique
-            // AND ...(x=TRUE)...: if all children BUT ONE now assigned to TRUE, and AND == FALSE, assign(last_holdout = FALSE)
-            assignAndEnqueue(*holdout, false);
-          }
+        } else if (numTrue + 1 == parent.getNumChildren() && isAssignedTo(parent, false)) {// the AND is FALSE, and the holdout is unique
+          // AND ...(x=TRUE)...: if all children BUT ONE now assigned to TRUE, and AND == FALSE, assign(last_holdout = FALSE)
+          TNode::iterator holdout;
+          holdout = find_if (parent.begin(), parent.end(), not1(IsAssignedTo(*this, true)));
+          Assert(holdout != parent.end());
+          assignAndEnqueue(*holdout, false);
         }
       } else {
         // AND ...(x=FALSE)...: assign(AND = FALSE)
@@ -239,18 +241,16 @@ void CircuitPropagator::propagateForward(TNode child, bool childAssignment) {
         // OR ...(x=TRUE)...: assign(OR = TRUE)
         assignAndEnqueue(parent, true);
       } else {
-        TNode::iterator holdout;
-        holdout = find_if (parent.begin(), parent.end(), not1(IsAssignedTo(*this, false)));
-        if (holdout == parent.end()) { // all children are assigned FALSE
+        unsigned numFalse = getNumChildrenAssigned(parent);
+        if (numFalse == parent.getNumChildren()) { // all children are assigned FALSE
           // OR ...(x=FALSE)...: if all children now assigned to FALSE, assign(OR = FALSE)
           assignAndEnqueue(parent, false);
-        } else if (isAssignedTo(parent, true)) {// the OR is TRUE
-          // is the holdout unique ?
-          TNode::iterator other = find_if (holdout + 1, parent.end(), not1(IsAssignedTo(*this, false)));
-          if (other == parent.end()) { // the holdout is unique
-            // OR ...(x=FALSE)...: if all children BUT ONE now assigned to FALSE, and OR == TRUE, assign(last_holdout = TRUE)
-            assignAndEnqueue(*holdout, true);
-          }
+        } else if (numFalse + 1 == parent.getNumChildren() && isAssignedTo(parent, true)) {// the OR is TRUE, and the holdout is unique
+          // OR ...(x=FALSE)...: if all children BUT ONE now assigned to FALSE, and OR == TRUE, assign(last_holdout = TRUE)
+          TNode::iterator holdout;
+          holdout = find_if (parent.begin(), parent.end(), not1(IsAssignedTo(*this, false)));
+          Assert(holdout != parent.end());
+          assignAndEnqueue(*holdout, true);
         }
       }
       break;
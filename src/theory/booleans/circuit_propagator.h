@@ -21,10 +21,9 @@
 
 #include <functional>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
-#include "context/cdhashmap.h"
-#include "context/cdhashset.h"
 #include "context/cdo.h"
 #include "context/context.h"
 #include "expr/node.h"
@@ -72,8 +71,12 @@ class CircuitPropagator
         d_learnedLiteralClearer(&d_context, d_learnedLiterals),
         d_backEdges(),
         d_backEdgesClearer(&d_context, d_backEdges),
-        d_seen(&d_context),
-        d_state(&d_context),
+        d_seen(),
+        d_seenClearer(&d_context, d_seen),
+        d_state(),
+        d_stateClearer(&d_context, d_state),
+        d_numChildrenAssigned(),
+        d_numChildrenAssignedClearer(&d_context, d_numChildrenAssigned),
         d_forwardPropagation(enableForward),
         d_backwardPropagation(enableBackward),
         d_needsFinish(false)
@@ -83,7 +86,7 @@ class CircuitPropagator
   /** Get Node assignment in circuit.  Assert-fails if Node is unassigned. */
   bool getAssignment(TNode n) const
   {
-    AssignmentMap::iterator i = d_state.find(n);
+    AssignmentMap::const_iterator i = d_state.find(n);
     Assert(i != d_state.end() && (*i).second != UNASSIGNED);
     return (*i).second == ASSIGNED_TO_TRUE;
   }
@@ -199,9 +202,12 @@ class CircuitPropagator
   /**
    * Assignment status of each node.
    */
-  typedef context::CDHashMap<TNode, AssignmentStatus, TNodeHashFunction>
+  typedef std::unordered_map<TNode, AssignmentStatus, TNodeHashFunction>
       AssignmentMap;
 
+  /** Number of assigned children of each AND and OR node */
+  typedef std::unordered_map<TNode, unsigned, TNodeHashFunction> CountMap;
+
   /**
    * Assign Node in circuit with the value and add it to the queue; note
    * conflicts.
@@ -236,11 +242,43 @@ class CircuitPropagator
     {
       // If unassigned, mark it as assigned
       d_state[n] = value ? ASSIGNED_TO_TRUE : ASSIGNED_TO_FALSE;
+      // Count it for its parents
+      BackEdgesMap::const_iterator it = d_backEdges.find(n);
+      if (it != d_backEdges.end())
+      {
+        for (TNode parent : it->second)
+        {
+          countAssignedChild(parent, value);
+        }
+      }
       // Add for further propagation
       d_propagationQueue.push_back(n);
     }
   }
 
+  /**
+   * Count a child of parent that is assigned to value, if parent is an AND
+   * and value is true, or parent is an OR and value is false.
+   */
+  void countAssignedChild(TNode parent, bool value)
+  {
+    Kind k = parent.getKind();
+    if ((k == kind::AND && value) || (k == kind::OR && !value))
+    {
+      ++d_numChildrenAssigned[parent];
+    }
+  }
+
+  /**
+   * Get the number of children of parent that are assigned to true, if parent
+   * is an AND, or to false, if parent is an OR.
+   */
+  unsigned getNumChildrenAssigned(TNode parent) const
+  {
+    CountMap::const_iterator it = d_numChildrenAssigned.find(parent);
+    return it == d_numChildrenAssigned.end() ? 0 : it->second;
+  }
+
   /**
    * Compute the map from nodes to the nodes that use it.
    */
@@ -294,10 +332,33 @@ class CircuitPropagator
 
   /** Nodes that have been attached already (computed forward edges for) */
   // All the nodes we've visited so far
-  context::CDHashSet<Node, NodeHashFunction> d_seen;
+  std::unordered_set<Node, NodeHashFunction> d_seen;
+
+  /**
+   * Similar data clearer for the visited nodes.
+   */
+  DataClearer<std::unordered_set<Node, NodeHashFunction>> d_seenClearer;
 
   AssignmentMap d_state;
 
+  /**
+   * Similar data clearer for the assignment status.
+   */
+  DataClearer<AssignmentMap> d_stateClearer;
+
+  /**
+   * The number of children of each AND (resp. OR) node of the circuit that
+   * are assigned to true (resp. false), counted with multiplicity. This
+   * makes forward propagation through a gate independent of its number of
+   * children.
+   */
+  CountMap d_numChildrenAssigned;
+
+  /**
+   * Similar data clearer for the numbers of assigned children.
+   */
+  DataClearer<CountMap> d_numChildrenAssignedClearer;
+
   /** Whether to perform forward propagation */
   const bool d_forwardPropagation;
 
@@ -36,14 +36,23 @@ bool AbstractionModule::applyAbstraction(const std::vector<Node>& assertions,
 
   TimerStat::CodeTimer abstractionTimer(d_statistics.d_abstractionTime);
 
-  TNodeSet seen;
+  TNodeBoolMap atomsCache;
+  d_signatureNodes = 0;
+  unsigned limit = options::bvAbstractionLimit();
   for (unsigned i = 0; i < assertions.size(); ++i)
   {
     if (assertions[i].getKind() == kind::OR)
     {
       for (unsigned j = 0; j < assertions[i].getNumChildren(); ++j)
       {
-        if (!isConjunctionOfAtoms(assertions[i][j], seen))
+        if (limit > 0 && d_signatureNodes >= limit)
+        {
+          // the remaining assertions keep no signature and are not abstracted
+          Debug("bv-abstraction")
+              << "AbstractionModule::applyAbstraction limit reached\n";
+          break;
+        }
+        if (!isConjunctionOfAtoms(assertions[i][j], atomsCache))
         {
           continue;
         }
@@ -54,6 +63,7 @@ bool AbstractionModule::applyAbstraction(const std::vector<Node>& assertions,
       }
     }
   }
+  d_statistics.d_numSignatureNodes += d_signatureNodes;
   finalizeSignatures();
 
   for (unsigned i = 0; i < assertions.size(); ++i)
@@ -108,27 +118,34 @@ bool AbstractionModule::applyAbstraction(const std::vector<Node>& assertions,
   return d_funcToSignature.size() != 0;
 }
 
-bool AbstractionModule::isConjunctionOfAtoms(TNode node, TNodeSet& seen)
+bool AbstractionModule::isConjunctionOfAtoms(TNode node, TNodeBoolMap& cache)
 {
-  if (seen.find(node)!= seen.end())
-    return true;
+  TNodeBoolMap::const_iterator it = cache.find(node);
+  if (it != cache.end())
+  {
+    return it->second;
+  }
 
+  bool res = true;
   if (!node.getType().isBitVector() && node.getKind() != kind::AND)
   {
-    return utils::isBVPredicate(node);
+    res = utils::isBVPredicate(node);
   }
-
-  if (node.getNumChildren() == 0)
-    return true;
-
-  for (unsigned i = 0; i < node.getNumChildren(); ++i) {
-    if (!isConjunctionOfAtoms(node[i], seen))
+  else
+  {
+    for (unsigned i = 0; i < node.getNumChildren(); ++i)
     {
-      return false;
+      if (!isConjunctionOfAtoms(node[i], cache))
+      {
+        res = false;
+        break;
+      }
     }
   }
-  seen.insert(node);
-  return true;
+  // failures are cached as well, the same subterm often occurs in many
+  // disjuncts
+  cache[node] = res;
+  return res;
 }
 
 
@@ -260,18 +277,122 @@ void AbstractionModule::skolemizeArguments(std::vector<Node>& assertions)
 }
 
 void AbstractionModule::storeSignature(Node signature, TNode assertion) {
-  if(d_signatures.find(signature) == d_signatures.end()) {
-    d_signatures[signature] = 0;
-  }
-  d_signatures[signature] = d_signatures[signature] + 1;
+  ++d_signatures[signature];
   d_assertionToSignature[assertion] = signature;
 }
 
 Node AbstractionModule::computeSignature(TNode node) {
   resetSignatureIndex();
+  // Maps the visited nodes to their signature, or to the null node while
+  // their children are processed. Children are pushed in reverse order, so
+  // that variables are numbered from left to right as in a recursive
+  // traversal.
   NodeNodeMap cache;
-  Node sig = computeSignatureRec(node, cache);
-  return sig;
+  std::vector<TNode> visit;
+  visit.push_back(node);
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    if (cur.getKind() == kind::CONST_BITVECTOR)
+    {
+      visit.pop_back();
+      continue;
+    }
+    NodeNodeMap::iterator it = cache.find(cur);
+    if (it == cache.end())
+    {
+      ++d_signatureNodes;
+      if (cur.getNumChildren() == 0)
+      {
+        visit.pop_back();
+        cache[cur] = getSignatureSkolem(cur);
+        continue;
+      }
+      cache[cur] = Node::null();
+      for (unsigned i = cur.getNumChildren(); i > 0; --i)
+      {
+        visit.push_back(cur[i - 1]);
+      }
+      continue;
+    }
+    visit.pop_back();
+    if (!it->second.isNull())
+    {
+      continue;
+    }
+    NodeBuilder<> builder(cur.getKind());
+    if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+    {
+      builder << cur.getOperator();
+    }
+    for (const TNode& child : cur)
+    {
+      if (child.getKind() == kind::CONST_BITVECTOR)
+      {
+        builder << child;
+      }
+      else
+      {
+        Assert(cache.find(child) != cache.end());
+        builder << cache[child];
+      }
+    }
+    Node result = builder;
+    it->second = result;
+  }
+  if (node.getKind() == kind::CONST_BITVECTOR)
+  {
+    return node;
+  }
+  Assert(cache.find(node) != cache.end());
+  return cache[node];
+}
+
+size_t AbstractionModule::computeShapeHash(TNode sig, TNodeHashMap& cache)
+{
+  std::vector<TNode> visit;
+  visit.push_back(sig);
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    if (cache.find(cur) != cache.end())
+    {
+      visit.pop_back();
+      continue;
+    }
+    Kind k = cur.getKind();
+    if (cur.getNumChildren() == 0)
+    {
+      visit.pop_back();
+      // skolems and constants may be unified with each other
+      cache[cur] = (k == kind::SKOLEM || k == kind::CONST_BITVECTOR)
+                       ? kind::SKOLEM
+                       : k;
+      continue;
+    }
+    bool ready = true;
+    for (const TNode& child : cur)
+    {
+      if (cache.find(child) == cache.end())
+      {
+        visit.push_back(child);
+        ready = false;
+      }
+    }
+    if (!ready)
+    {
+      continue;
+    }
+    visit.pop_back();
+    size_t hash = k;
+    hash = hash * 31 + cur.getNumChildren();
+    for (const TNode& child : cur)
+    {
+      hash = hash * 1000003 ^ cache[child];
+    }
+    cache[cur] = hash;
+  }
+  return cache[sig];
 }
 
 Node AbstractionModule::getSignatureSkolem(TNode node)
@@ -324,33 +445,6 @@ Node AbstractionModule::getGeneralizedSignature(Node node) {
   return generalized_signature;
 }
 
-Node AbstractionModule::computeSignatureRec(TNode node, NodeNodeMap& cache) {
-  if (cache.find(node) != cache.end()) {
-    return cache.find(node)->second;
-  }
-
-  if (node.getNumChildren() == 0) {
-    if (node.getKind() == kind::CONST_BITVECTOR)
-      return node;
-
-    Node sig = getSignatureSkolem(node);
-    cache[node] = sig;
-    return sig;
-  }
-
-  NodeBuilder<> builder(node.getKind());
-  if (node.getMetaKind() == kind::metakind::PARAMETERIZED) {
-    builder << node.getOperator();
-  }
-  for (unsigned i = 0; i < node.getNumChildren(); ++i) {
-    Node converted = computeSignatureRec(node[i], cache);
-    builder << converted;
-  }
-  Node result = builder;
-  cache[node] = result;
-  return result;
-}
-
 /**
  * Returns 0, if the two are equal,
  * 1 if s is a generalization of t
@@ -436,28 +530,42 @@ void AbstractionModule::finalizeSignatures()
       << d_signatures.size() << "\n";
   TNodeSet new_signatures;
 
-  // "unify" signatures
+  // Signatures that comparePatterns may unify have the same shape, hence it
+  // suffices to compare the signatures within the buckets of a shape hash
+  // rather than all pairs of signatures.
+  TNodeHashMap shapeCache;
+  std::unordered_map<size_t, std::vector<TNode>> buckets;
   for (SignatureMap::const_iterator ss = d_signatures.begin();
        ss != d_signatures.end();
        ++ss)
   {
-    for (SignatureMap::const_iterator tt = ss; tt != d_signatures.end(); ++tt)
-    {
-      TNode t = getGeneralization(tt->first);
-      TNode s = getGeneralization(ss->first);
+    buckets[computeShapeHash(ss->first, shapeCache)].push_back(ss->first);
+  }
 
-      if (t != s)
+  // "unify" signatures
+  for (const std::pair<const size_t, std::vector<TNode>>& bucket : buckets)
+  {
+    const std::vector<TNode>& sigs = bucket.second;
+    for (size_t i = 0, size = sigs.size(); i < size; ++i)
+    {
+      for (size_t j = i; j < size; ++j)
       {
-        int status = comparePatterns(s, t);
-        Assert(status);
-        if (status < 0) continue;
-        if (status == 1)
-        {
-          storeGeneralization(t, s);
-        }
-        else
+        TNode t = getGeneralization(sigs[j]);
+        TNode s = getGeneralization(sigs[i]);
+
+        if (t != s)
         {
-          storeGeneralization(s, t);
+          int status = comparePatterns(s, t);
+          Assert(status);
+          if (status < 0) continue;
+          if (status == 1)
+          {
+            storeGeneralization(t, s);
+          }
+          else
+          {
+            storeGeneralization(s, t);
+          }
         }
       }
     }
@@ -1114,15 +1222,18 @@ AbstractionModule::Statistics::Statistics(const std::string& name)
     : d_numFunctionsAbstracted(name + "::abstraction::NumFunctionsAbstracted",
                                0),
       d_numArgsSkolemized(name + "::abstraction::NumArgsSkolemized", 0),
+      d_numSignatureNodes(name + "::abstraction::NumSignatureNodes", 0),
       d_abstractionTime(name + "::abstraction::AbstractionTime")
 {
   smtStatisticsRegistry()->registerStat(&d_numFunctionsAbstracted);
   smtStatisticsRegistry()->registerStat(&d_numArgsSkolemized);
+  smtStatisticsRegistry()->registerStat(&d_numSignatureNodes);
   smtStatisticsRegistry()->registerStat(&d_abstractionTime);
 }
 
 AbstractionModule::Statistics::~Statistics() {
   smtStatisticsRegistry()->unregisterStat(&d_numFunctionsAbstracted);
   smtStatisticsRegistry()->unregisterStat(&d_numArgsSkolemized);
+  smtStatisticsRegistry()->unregisterStat(&d_numSignatureNodes);
   smtStatisticsRegistry()->unregisterStat(&d_abstractionTime);
 }
@@ -37,6 +37,7 @@ class AbstractionModule {
   struct Statistics {
     IntStat d_numFunctionsAbstracted;
     IntStat d_numArgsSkolemized;
+    IntStat d_numSignatureNodes;
     TimerStat d_abstractionTime;
     Statistics(const std::string& name);
     ~Statistics();
@@ -136,6 +137,8 @@ class AbstractionModule {
   typedef std::unordered_map<unsigned, unsigned> IndexMap;
   typedef std::unordered_map<unsigned, std::vector<Node> > SkolemMap;
   typedef std::unordered_map<TNode, unsigned, TNodeHashFunction > SignatureMap;
+  typedef std::unordered_map<TNode, bool, TNodeHashFunction> TNodeBoolMap;
+  typedef std::unordered_map<TNode, size_t, TNodeHashFunction> TNodeHashMap;
 
   ArgsTable d_argsTable;
 
@@ -158,8 +161,14 @@ class AbstractionModule {
   void finalizeSignatures();
   Node abstractSignatures(TNode assertion);
   Node computeSignature(TNode node);
+  /**
+   * Returns a hash of the shape of signature sig, i.e. of its kinds, with its
+   * leaves (skolems and constants) and operators ignored. Two signatures with
+   * different shapes are incomparable by comparePatterns.
+   */
+  static size_t computeShapeHash(TNode sig, TNodeHashMap& cache);
 
-  bool isConjunctionOfAtoms(TNode node, TNodeSet& seen);
+  bool isConjunctionOfAtoms(TNode node, TNodeBoolMap& cache);
 
   TNode getGeneralization(TNode term);
   void storeGeneralization(TNode s, TNode t);
@@ -170,7 +179,6 @@ class AbstractionModule {
 
   unsigned getBitwidthIndex(unsigned bitwidth);
   void resetSignatureIndex();
-  Node computeSignatureRec(TNode, NodeNodeMap&);
   void storeSignature(Node signature, TNode assertion);
   bool hasSignature(Node node);
 
@@ -193,6 +201,8 @@ class AbstractionModule {
   TNodeSet d_lemmaAtoms;
   TNodeSet d_inputAtoms;
   void storeLemma(TNode lemma);
+  /** The number of nodes visited by computeSignature */
+  uint64_t d_signatureNodes;
 
   Statistics d_statistics;
 
@@ -210,6 +220,7 @@ public:
     , d_addedLemmas()
     , d_lemmaAtoms()
     , d_inputAtoms()
+    , d_signatureNodes(0)
     , d_statistics(name)
   {}
   /**
@@ -20,6 +20,7 @@
 
 #include "base/check.h"
 #include "options/bv_options.h"
+#include "prop/cnf_stream.h"
 #include "prop/sat_solver_factory.h"
 #include "smt/smt_statistics_registry.h"
 
@@ -352,22 +353,86 @@ bool AigBitblaster::solve(TNode node) {
 
 void addAliases(Abc_Frame_t* pAbc);
 
-void AigBitblaster::simplifyAig() {
-  TimerStat::CodeTimer simpTimer(d_statistics.d_simplificationTime);
+namespace {
 
-  Abc_AigCleanup(currentAigM());
-  Assert(Abc_NtkCheck(currentAigNtk()));
+/**
+ * Run the ABC script of --bv-aig-simp on ntk, which the global ABC frame takes
+ * over. Returns the resulting network.
+ */
+Abc_Ntk_t* runAbcScript(Abc_Ntk_t* ntk)
+{
+  Abc_AigCleanup((Abc_Aig_t*)ntk->pManFunc);
+  Assert(Abc_NtkCheck(ntk));
 
-  const char* command = options::bitvectorAigSimplifications().c_str(); 
+  const char* command = options::bitvectorAigSimplifications().c_str();
   Abc_Frame_t* pAbc = Abc_FrameGetGlobalFrame();
-  Abc_FrameSetCurrentNetwork(pAbc, currentAigNtk());
+  Abc_FrameReplaceCurrentNetwork(pAbc, ntk);
 
-  addAliases(pAbc); 
+  addAliases(pAbc);
   if ( Cmd_CommandExecute( pAbc, command ) ) {
     fprintf( stdout, "Cannot execute command \"%s\".\n", command );
-    exit(-1); 
+    exit(-1);
+  }
+  return Abc_FrameReadNtk(pAbc);
+}
+
+/**
+ * Add the clauses of pCnf, the CNF of pMan, to satSolver. The CNF variables
+ * of the first combinational inputs and outputs of pMan are mapped to the
+ * literals in inputs and outputs, the other variables get fresh SAT
+ * variables. A single clause buffer is used for all clauses. Returns the
+ * number of fresh variables.
+ */
+unsigned assertCnf(Aig_Man_t* pMan,
+                   Cnf_Dat_t* pCnf,
+                   prop::SatSolver* satSolver,
+                   const std::vector<prop::SatLiteral>& inputs,
+                   const std::vector<prop::SatLiteral>& outputs)
+{
+  std::vector<prop::SatLiteral> vars(pCnf->nVars, prop::undefSatLiteral);
+  for (unsigned i = 0; i < inputs.size(); ++i)
+  {
+    Assert(i < static_cast<unsigned>(Aig_ManCiNum(pMan)));
+    vars[pCnf->pVarNums[Aig_ManCi(pMan, i)->Id]] = inputs[i];
+  }
+  for (unsigned i = 0; i < outputs.size(); ++i)
+  {
+    Assert(i < static_cast<unsigned>(Aig_ManCoNum(pMan)));
+    vars[pCnf->pVarNums[Aig_ManCo(pMan, i)->Id]] = outputs[i];
   }
-  s_abcAigNetwork = Abc_FrameReadNtk(pAbc);
+  unsigned numVariables = 0;
+  for (prop::SatLiteral& var : vars)
+  {
+    if (var.isNull())
+    {
+      var = prop::SatLiteral(satSolver->newVar(false, false, false));
+      ++numVariables;
+    }
+  }
+
+  prop::SatClause clause;
+  for (int i = 0; i < pCnf->nClauses; ++i)
+  {
+    clause.clear();
+    for (int* pLit = pCnf->pClauses[i]; pLit < pCnf->pClauses[i + 1]; ++pLit)
+    {
+      int int_lit = Cnf_Lit2Var(*pLit);
+      Assert(int_lit != 0);
+      unsigned index = int_lit < 0 ? -int_lit : int_lit;
+      Assert(index - 1 < vars.size());
+      prop::SatLiteral lit = vars[index - 1];
+      clause.push_back(int_lit < 0 ? ~lit : lit);
+    }
+    satSolver->addClause(clause, false);
+  }
+  return numVariables;
+}
+
+}  // namespace
+
+void AigBitblaster::simplifyAig() {
+  TimerStat::CodeTimer simpTimer(d_statistics.d_simplificationTime);
+  s_abcAigNetwork = runAbcScript(currentAigNtk());
 }
 
 
@@ -390,42 +455,15 @@ void AigBitblaster::convertToCnfAndAssert() {
   Assert(Aig_ManCheck(pMan));
   pCnf = Cnf_DeriveFast( pMan, 0 );
 
-  assertToSatSolver(pCnf); 
-    
+  // the output is asserted by the CNF
+  d_statistics.d_numVariables += assertCnf(pMan, pCnf, d_satSolver.get(), {}, {});
+  d_statistics.d_numClauses += pCnf->nClauses;
+
   Cnf_DataFree( pCnf );
   Cnf_ManFree();
   Aig_ManStop(pMan);
 }
 
-void AigBitblaster::assertToSatSolver(Cnf_Dat_t* pCnf) {
-  unsigned numVariables = pCnf->nVars;
-  unsigned numClauses = pCnf->nClauses;
-  
-  d_statistics.d_numVariables += numVariables; 
-  d_statistics.d_numClauses += numClauses; 
-
-  // create variables in the sat solver
-  std::vector<prop::SatVariable> sat_variables;
-  for (unsigned i = 0; i < numVariables; ++i) {
-    sat_variables.push_back(d_satSolver->newVar(false, false, false)); 
-  }
-
-  // construct clauses and add to sat solver
-  int * pLit, * pStop;
-  for (unsigned i = 0; i < numClauses; i++ ) {
-    prop::SatClause clause; 
-    for (pLit = pCnf->pClauses[i], pStop = pCnf->pClauses[i+1]; pLit < pStop; pLit++ ) {
-      int int_lit = Cnf_Lit2Var(*pLit);
-      Assert(int_lit != 0);
-      unsigned index = int_lit < 0? -int_lit : int_lit;
-      Assert(index - 1 < sat_variables.size());
-      prop::SatLiteral lit(sat_variables[index-1], int_lit < 0); 
-      clause.push_back(lit); 
-    }
-    d_satSolver->addClause(clause, false);
-  }
-}
-
 void addAliases(Abc_Frame_t* pAbc) {
   std::vector<std::string> aliases;
   aliases.push_back("alias b balance");
@@ -446,6 +484,11 @@ void addAliases(Abc_Frame_t* pAbc) {
   aliases.push_back("alias rfl rf -l");
   aliases.push_back("alias rfzl rfz -l");
   aliases.push_back("alias brw \"b; rw\"");
+  aliases.push_back("alias resyn \"b; rw; rwz; b; rwz; b\"");
+  aliases.push_back("alias resyn2 \"b; rw; rf; b; rw; rwz; b; rfz; rwz; b\"");
+  aliases.push_back(
+      "alias compress2 \"b -l; rw -l; rf -l; b -l; rw -l; rwz -l; b -l; rfz "
+      "-l; rwz -l; b -l\"");
 
   for (unsigned i = 0; i < aliases.size(); ++i) {
     if ( Cmd_CommandExecute( pAbc, aliases[i].c_str() ) ) {
@@ -468,6 +511,150 @@ Abc_Obj_t* AigBitblaster::getBBAtom(TNode atom) const {
   return d_bbAtoms.find(atom)->second;
 }
 
+AigCnfConverter::AigCnfConverter(prop::SatSolver* satSolver,
+                                 prop::CnfStream* cnfStream,
+                                 const std::string& name)
+    : d_satSolver(satSolver), d_cnfStream(cnfStream), d_statistics(name)
+{
+  // makes sure that ABC is started
+  currentAigNtk();
+}
+
+AigCnfConverter::~AigCnfConverter() {}
+
+void AigCnfConverter::addDefinition(prop::SatLiteral lit, Node def)
+{
+  d_pending.push_back(std::make_pair(lit, def));
+}
+
+void AigCnfConverter::flush()
+{
+  if (d_pending.empty())
+  {
+    return;
+  }
+  ++d_statistics.d_numBatches;
+  Debug("bitvector-aig") << "AigCnfConverter::flush " << d_pending.size()
+                         << " definitions\n";
+
+  Abc_Ntk_t* ntk = Abc_NtkAlloc(ABC_NTK_STRASH, ABC_FUNC_AIG, 1);
+  char pName[] = "CVC4::theory::bv::AigCnfConverter";
+  ntk->pName = Extra_UtilStrsav(pName);
+  std::vector<prop::SatLiteral> outputs;
+  for (const std::pair<prop::SatLiteral, Node>& def : d_pending)
+  {
+    Abc_Obj_t* po = Abc_NtkCreatePo(ntk);
+    Abc_ObjAddFanin(po, convert(ntk, def.second));
+    outputs.push_back(def.first);
+  }
+  {
+    TimerStat::CodeTimer simpTimer(d_statistics.d_simplificationTime);
+    ntk = runAbcScript(ntk);
+  }
+
+  TimerStat::CodeTimer cnfConversionTimer(d_statistics.d_cnfConversionTime);
+  Assert(Abc_NtkIsStrash(ntk));
+  Aig_Man_t* pMan = Abc_NtkToDar(ntk, 0, 0);
+  Assert(pMan != NULL);
+  Assert(Aig_ManCheck(pMan));
+  // all outputs are equivalent to the literals of their atoms
+  Cnf_Dat_t* pCnf = Cnf_Derive(pMan, Aig_ManCoNum(pMan));
+  d_statistics.d_numVariables +=
+      assertCnf(pMan, pCnf, d_satSolver, d_inputs, outputs);
+  d_statistics.d_numClauses += pCnf->nClauses;
+  Cnf_DataFree(pCnf);
+  Cnf_ManFree();
+  Aig_ManStop(pMan);
+
+  d_pending.clear();
+  d_cache.clear();
+  d_inputs.clear();
+}
+
+Abc_Obj_t* AigCnfConverter::convert(Abc_Ntk_t* ntk, TNode n)
+{
+  TNodeAigMap::const_iterator it = d_cache.find(n);
+  if (it != d_cache.end())
+  {
+    return it->second;
+  }
+  Abc_Aig_t* man = (Abc_Aig_t*)ntk->pManFunc;
+  Abc_Obj_t* result = NULL;
+  switch (n.getKind())
+  {
+    case kind::AND:
+    case kind::OR:
+    case kind::XOR:
+    {
+      result = convert(ntk, n[0]);
+      for (unsigned i = 1; i < n.getNumChildren(); ++i)
+      {
+        Abc_Obj_t* child = convert(ntk, n[i]);
+        result = n.getKind() == kind::AND
+                     ? Abc_AigAnd(man, result, child)
+                     : n.getKind() == kind::OR ? Abc_AigOr(man, result, child)
+                                               : Abc_AigXor(man, result, child);
+      }
+      break;
+    }
+    case kind::IMPLIES:
+      result = Abc_AigOr(
+          man, Abc_ObjNot(convert(ntk, n[0])), convert(ntk, n[1]));
+      break;
+    case kind::ITE:
+      result = Abc_AigMux(man,
+                          convert(ntk, n[0]),
+                          convert(ntk, n[1]),
+                          convert(ntk, n[2]));
+      break;
+    case kind::NOT: result = Abc_ObjNot(convert(ntk, n[0])); break;
+    case kind::CONST_BOOLEAN:
+      result = n.getConst<bool>() ? Abc_AigConst1(ntk)
+                                  : Abc_ObjNot(Abc_AigConst1(ntk));
+      break;
+    case kind::EQUAL:
+      if (n[0].getType().isBoolean())
+      {
+        result = Abc_ObjNot(
+            Abc_AigXor(man, convert(ntk, n[0]), convert(ntk, n[1])));
+        break;
+      }
+      CVC4_FALLTHROUGH;
+    default:
+    {
+      // the bits of terms and Boolean variables keep their literals
+      d_cnfStream->ensureLiteral(n);
+      d_inputs.push_back(d_cnfStream->getLiteral(n));
+      result = Abc_NtkCreatePi(ntk);
+    }
+  }
+  d_cache.insert(std::make_pair(n, result));
+  return result;
+}
+
+AigCnfConverter::Statistics::Statistics(const std::string& name)
+    : d_numBatches(name + "::aig::numBatches", 0),
+      d_numClauses(name + "::aig::numClauses", 0),
+      d_numVariables(name + "::aig::numVariables", 0),
+      d_simplificationTime(name + "::aig::simplificationTime"),
+      d_cnfConversionTime(name + "::aig::cnfConversionTime")
+{
+  smtStatisticsRegistry()->registerStat(&d_numBatches);
+  smtStatisticsRegistry()->registerStat(&d_numClauses);
+  smtStatisticsRegistry()->registerStat(&d_numVariables);
+  smtStatisticsRegistry()->registerStat(&d_simplificationTime);
+  smtStatisticsRegistry()->registerStat(&d_cnfConversionTime);
+}
+
+AigCnfConverter::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numBatches);
+  smtStatisticsRegistry()->unregisterStat(&d_numClauses);
+  smtStatisticsRegistry()->unregisterStat(&d_numVariables);
+  smtStatisticsRegistry()->unregisterStat(&d_simplificationTime);
+  smtStatisticsRegistry()->unregisterStat(&d_cnfConversionTime);
+}
+
 AigBitblaster::Statistics::Statistics()
   : d_numClauses("theory::bv::AigBitblaster::numClauses", 0)
   , d_numVariables("theory::bv::AigBitblaster::numVariables", 0)
@@ -34,6 +34,12 @@ typedef Abc_Aig_t_ Abc_Aig_t;
 class Cnf_Dat_t_;
 typedef Cnf_Dat_t_ Cnf_Dat_t;
 
+namespace CVC4 {
+namespace prop {
+class CnfStream;
+}
+}  // namespace CVC4
+
 namespace CVC4 {
 namespace theory {
 namespace bv {
@@ -81,7 +87,6 @@ class AigBitblaster : public TBitblaster<Abc_Obj_t*>
   Abc_Obj_t* mkInput(TNode input);
   bool hasInput(TNode input);
   void convertToCnfAndAssert();
-  void assertToSatSolver(Cnf_Dat_t* pCnf);
   Node getModelFromSatSolver(TNode a, bool fullModel) override
   {
     Unreachable();
@@ -110,6 +115,58 @@ class AigBitblaster : public TBitblaster<Abc_Obj_t*>
   Statistics d_statistics;
 };
 
+/**
+ * Translates batches of bit-blasted atom definitions to CNF through an AIG,
+ * for the lazy bit-blaster. Each batch is built into a fresh AIG network,
+ * simplified by the ABC script of --bv-aig-simp, and its CNF is added to the
+ * SAT solver in one go. The leaves of the definitions (the bits of terms and
+ * Boolean variables) and the atoms keep the literals the CNF stream gives
+ * them, so that the rest of the lazy bit-blaster is unaffected.
+ */
+class AigCnfConverter
+{
+ public:
+  AigCnfConverter(prop::SatSolver* satSolver,
+                  prop::CnfStream* cnfStream,
+                  const std::string& name);
+  ~AigCnfConverter();
+
+  /** Queue the definition lit <=> def. */
+  void addDefinition(prop::SatLiteral lit, Node def);
+
+  /** Convert the queued definitions and add their clauses. */
+  void flush();
+
+ private:
+  typedef std::unordered_map<TNode, Abc_Obj_t*, TNodeHashFunction> TNodeAigMap;
+
+  /** Convert n to the current network, creating inputs for its leaves. */
+  Abc_Obj_t* convert(Abc_Ntk_t* ntk, TNode n);
+
+  prop::SatSolver* d_satSolver;
+  prop::CnfStream* d_cnfStream;
+  /** The queued definitions */
+  std::vector<std::pair<prop::SatLiteral, Node>> d_pending;
+  /** The AIGs of the nodes of the current batch */
+  TNodeAigMap d_cache;
+  /** The literals of the inputs of the current network, in order */
+  std::vector<prop::SatLiteral> d_inputs;
+
+  class Statistics
+  {
+   public:
+    IntStat d_numBatches;
+    IntStat d_numClauses;
+    IntStat d_numVariables;
+    TimerStat d_simplificationTime;
+    TimerStat d_cnfConversionTime;
+    Statistics(const std::string& name);
+    ~Statistics();
+  };
+
+  Statistics d_statistics;
+};
+
 #else /* CVC4_USE_ABC */
 
 /**
@@ -121,6 +178,12 @@ class AigBitblaster : public TBitblaster<Abc_Obj_t*>
   AigBitblaster() = delete;
 };
 
+/** Dummy version of AigCnfConverter, see above. */
+class AigCnfConverter
+{
+  AigCnfConverter() = delete;
+};
+
 #endif /* CVC4_USE_ABC */
 
 }  // namespace bv
@@ -23,6 +23,8 @@
 #include <ostream>
 
 #include "expr/node.h"
+#include "options/bv_options.h"
+#include "options/smt_options.h"
 #include "theory/bv/bitblast/bitblast_utils.h"
 #include "theory/bv/theory_bv_utils.h"
 #include "theory/rewriter.h"
@@ -353,6 +355,38 @@ void DefaultCompBB (TNode node, std::vector<T>& bits, TBitblaster<T>* bb) {
   bits.push_back(a_eq_b);   
 }
 
+/**
+ * Multiplies a and b with the circuit chosen by --bv-multiplier, or reuses a
+ * multiplier of the same operand bits built before. Proofs only know the
+ * shift and add multiplier of every term, so they use it unshared.
+ */
+template <class T>
+void mkMultiplier(const std::vector<T>& a,
+                  const std::vector<T>& b,
+                  std::vector<T>& res,
+                  TBitblaster<T>* bb)
+{
+  Assert(res.size() == 0);
+  bool share = options::bvShareArithCircuits() && !options::proof();
+  if (share && bb->getSharedProduct(a, b, res))
+  {
+    return;
+  }
+  if (options::bvMultiplier() == options::BvMultiplierMode::WALLACE
+      && a.size() >= options::bvMultiplierWidth() && !options::proof())
+  {
+    wallaceTreeMultiplier(a, b, res);
+  }
+  else
+  {
+    shiftAddMultiplier(a, b, res);
+  }
+  if (share)
+  {
+    bb->storeSharedProduct(a, b, res);
+  }
+}
+
 template <class T>
 void DefaultMultBB (TNode node, std::vector<T>& res, TBitblaster<T>* bb) {
   Debug("bitvector") << "theory::bv:: DefaultMultBB bitblasting "<< node << "\n";
@@ -384,9 +418,7 @@ void DefaultMultBB (TNode node, std::vector<T>& res, TBitblaster<T>* bb) {
     std::vector<T> current;
     bb->bbTerm(node[i], current);
     newres.clear(); 
-    // constructs a simple shift and add multiplier building the result
-    // in res
-    shiftAddMultiplier(res, current, newres);
+    mkMultiplier(res, current, newres, bb);
     res = newres;
   }
   if(Debug.isOn("bitvector-bb")) {
@@ -512,19 +544,33 @@ void uDivModRec(const std::vector<T>& a, const std::vector<T>& b, std::vector<T>
 
 }
 
+/**
+ * Divides a by b with the circuit chosen by --bv-divider, or reuses a
+ * divider of the same operand bits built before. The quotient of a division
+ * by 0 is 11..11 and the remainder is a.
+ */
 template <class T>
-void DefaultUdivBB(TNode node, std::vector<T>& q, TBitblaster<T>* bb)
+void mkDivider(const std::vector<T>& a,
+               const std::vector<T>& b,
+               std::vector<T>& q,
+               std::vector<T>& r,
+               TBitblaster<T>* bb)
 {
-  Debug("bitvector-bb") << "theory::bv::DefaultUdivBB bitblasting " << node
-                        << "\n";
-  Assert(node.getKind() == kind::BITVECTOR_UDIV_TOTAL && q.size() == 0);
-
-  std::vector<T> a, b;
-  bb->bbTerm(node[0], a);
-  bb->bbTerm(node[1], b);
-
-  std::vector<T> r;
-  uDivModRec(a, b, q, r, utils::getSize(node));
+  Assert(q.size() == 0 && r.size() == 0);
+  bool share = options::bvShareArithCircuits() && !options::proof();
+  if (share && bb->getSharedDivision(a, b, q, r))
+  {
+    return;
+  }
+  if (options::bvDivider() == options::BvDividerMode::NON_RESTORING
+      && a.size() >= options::bvDividerWidth() && !options::proof())
+  {
+    nonRestoringDivider(a, b, q, r);
+  }
+  else
+  {
+    uDivModRec(a, b, q, r, a.size());
+  }
   // adding a special case for division by 0
   std::vector<T> iszero;
   for (unsigned i = 0; i < b.size(); ++i)
@@ -538,6 +584,25 @@ void DefaultUdivBB(TNode node, std::vector<T>& q, TBitblaster<T>* bb)
     q[i] = mkIte(b_is_0, mkTrue<T>(), q[i]);  // a udiv 0 is 11..11
     r[i] = mkIte(b_is_0, a[i], r[i]);         // a urem 0 is a
   }
+  if (share)
+  {
+    bb->storeSharedDivision(a, b, q, r);
+  }
+}
+
+template <class T>
+void DefaultUdivBB(TNode node, std::vector<T>& q, TBitblaster<T>* bb)
+{
+  Debug("bitvector-bb") << "theory::bv::DefaultUdivBB bitblasting " << node
+                        << "\n";
+  Assert(node.getKind() == kind::BITVECTOR_UDIV_TOTAL && q.size() == 0);
+
+  std::vector<T> a, b;
+  bb->bbTerm(node[0], a);
+  bb->bbTerm(node[1], b);
+
+  std::vector<T> r;
+  mkDivider(a, b, q, r, bb);
 
   // cache the remainder in case we need it later
   Node remainder = Rewriter::rewrite(NodeManager::currentNM()->mkNode(
@@ -557,20 +622,7 @@ void DefaultUremBB(TNode node, std::vector<T>& rem, TBitblaster<T>* bb)
   bb->bbTerm(node[1], b);
 
   std::vector<T> q;
-  uDivModRec(a, b, q, rem, utils::getSize(node));
-  // adding a special case for division by 0
-  std::vector<T> iszero;
-  for (unsigned i = 0; i < b.size(); ++i)
-  {
-    iszero.push_back(mkIff(b[i], mkFalse<T>()));
-  }
-  T b_is_0 = mkAnd(iszero);
-
-  for (unsigned i = 0; i < q.size(); ++i)
-  {
-    q[i] = mkIte(b_is_0, mkTrue<T>(), q[i]);  // a udiv 0 is 11..11
-    rem[i] = mkIte(b_is_0, a[i], rem[i]);     // a urem 0 is a
-  }
+  mkDivider(a, b, q, rem, bb);
 
   // cache the quotient in case we need it later
   Node quotient = Rewriter::rewrite(NodeManager::currentNM()->mkNode(
@@ -220,6 +220,129 @@ inline void shiftAddMultiplier(const std::vector<T>&a, const std::vector<T>&b, s
   }
 }
 
+/**
+ * Constructs a Wallace tree multiplier: the partial products are reduced
+ * column-wise with full adders until every column has at most two bits,
+ * which are summed by a final ripple carry adder. The circuit has the
+ * size of the shift and add multiplier but logarithmic depth in the
+ * reduction.
+ *
+ * @param a first factor
+ * @param b second factor
+ * @param res the product modulo 2^a.size()
+ */
+template <class T>
+inline void wallaceTreeMultiplier(const std::vector<T>& a,
+                                  const std::vector<T>& b,
+                                  std::vector<T>& res)
+{
+  Assert(a.size() == b.size() && res.size() == 0);
+  unsigned n = a.size();
+  std::vector<std::vector<T> > columns(n);
+  for (unsigned i = 0; i < n; ++i)
+  {
+    for (unsigned j = 0; i + j < n; ++j)
+    {
+      columns[i + j].push_back(mkAnd(b[i], a[j]));
+    }
+  }
+
+  bool reduced = false;
+  while (!reduced)
+  {
+    reduced = true;
+    std::vector<std::vector<T> > next(n);
+    for (unsigned k = 0; k < n; ++k)
+    {
+      const std::vector<T>& col = columns[k];
+      unsigned j = 0;
+      for (; j + 3 <= col.size(); j += 3)
+      {
+        T x_xor_y = mkXor(col[j], col[j + 1]);
+        next[k].push_back(mkXor(x_xor_y, col[j + 2]));
+        // the carry out of the most significant column is dropped
+        if (k + 1 < n)
+        {
+          next[k + 1].push_back(
+              mkOr(mkAnd(col[j], col[j + 1]), mkAnd(x_xor_y, col[j + 2])));
+        }
+      }
+      for (; j < col.size(); ++j)
+      {
+        next[k].push_back(col[j]);
+      }
+    }
+    columns.swap(next);
+    for (unsigned k = 0; k < n && reduced; ++k)
+    {
+      reduced = columns[k].size() <= 2;
+    }
+  }
+
+  std::vector<T> x, y;
+  for (unsigned k = 0; k < n; ++k)
+  {
+    x.push_back(columns[k].size() > 0 ? columns[k][0] : mkFalse<T>());
+    y.push_back(columns[k].size() > 1 ? columns[k][1] : mkFalse<T>());
+  }
+  rippleCarryAdder(x, y, res, mkFalse<T>());
+}
+
+/**
+ * Constructs a non-restoring divider. Every step adds or subtracts the
+ * divisor depending on the sign of the partial remainder, which needs a
+ * single adder per step instead of the subtractor and multiplexer of a
+ * restoring divider. The result for b = 0 is unspecified.
+ *
+ * @param a the dividend
+ * @param b the divisor
+ * @param q the quotient
+ * @param r the remainder
+ */
+template <class T>
+inline void nonRestoringDivider(const std::vector<T>& a,
+                                const std::vector<T>& b,
+                                std::vector<T>& q,
+                                std::vector<T>& r)
+{
+  Assert(a.size() == b.size() && q.size() == 0 && r.size() == 0);
+  unsigned n = a.size();
+  // the partial remainder lies in [-2b, 2b) and needs two extra bits
+  std::vector<T> divisor = b;
+  divisor.push_back(mkFalse<T>());
+  divisor.push_back(mkFalse<T>());
+  std::vector<T> rem;
+  makeZero(rem, n + 2);
+  makeZero(q, n);
+  T negative = mkFalse<T>();
+
+  for (int i = n - 1; i >= 0; --i)
+  {
+    lshift(rem, 1);
+    rem[0] = a[i];
+    // subtract the divisor from a non-negative remainder, add it otherwise
+    T subtract = mkNot(negative);
+    std::vector<T> operand;
+    for (unsigned j = 0; j < n + 2; ++j)
+    {
+      operand.push_back(mkXor(divisor[j], subtract));
+    }
+    std::vector<T> sum;
+    rippleCarryAdder(rem, operand, sum, subtract);
+    rem.swap(sum);
+    negative = rem[n + 1];
+    q[i] = mkNot(negative);
+  }
+
+  // restore a negative final remainder
+  std::vector<T> restored;
+  rippleCarryAdder(rem, divisor, restored, mkFalse<T>());
+  for (unsigned i = 0; i < n; ++i)
+  {
+    r.push_back(mkIte(negative, restored[i], rem[i]));
+  }
+}
+
 template <class T>
 T inline uLessThanBB(const std::vector<T>&a, const std::vector<T>& b, bool orEqual) {
   Assert(a.size() && b.size());
@@ -19,6 +19,8 @@
 #ifndef CVC4__THEORY__BV__BITBLAST__BITBLASTER_H
 #define CVC4__THEORY__BV__BITBLAST__BITBLASTER_H
 
+#include <algorithm>
+#include <map>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -66,6 +68,23 @@ class TBitblaster
   std::unique_ptr<prop::CnfStream> d_cnfStream;
   proof::BitVectorProof* d_bvp;
 
+  /** A bit-blasted multiplier or divider and the bits of its operands. */
+  struct ArithCircuit
+  {
+    Bits d_a;
+    Bits d_b;
+    /** The product, or the quotient of a divider. */
+    Bits d_first;
+    /** The remainder of a divider. */
+    Bits d_second;
+  };
+  typedef std::map<std::pair<T, T>, std::vector<ArithCircuit> >
+      ArithCircuitMap;
+  /** The multipliers indexed by the lowest bits of their operands. */
+  ArithCircuitMap d_products;
+  /** The dividers indexed by the lowest bits of their operands. */
+  ArithCircuitMap d_divisions;
+
   void initAtomBBStrategies();
   void initTermBBStrategies();
 
@@ -93,6 +112,20 @@ class TBitblaster
   virtual void storeBBTerm(TNode term, const Bits& bits);
   virtual void setProofLog(proof::BitVectorProof* bvp);
 
+  /**
+   * Get the product of a and b from a multiplier built before for the same
+   * operand bits, or for operands whose low bits are a and b, since the low
+   * bits of a product only depend on the low bits of the factors.
+   */
+  bool getSharedProduct(const Bits& a, const Bits& b, Bits& res) const;
+  void storeSharedProduct(const Bits& a, const Bits& b, const Bits& res);
+  /** Get the quotient and remainder of a divider built before for a, b. */
+  bool getSharedDivision(const Bits& a, const Bits& b, Bits& q, Bits& r) const;
+  void storeSharedDivision(const Bits& a,
+                           const Bits& b,
+                           const Bits& q,
+                           const Bits& r);
+
   /**
    * Return a constant representing the value of a in the  model.
    * If fullModel is true set unconstrained bits to 0. If not return
@@ -111,7 +144,8 @@ class MinisatEmptyNotify : public prop::BVSatSolverNotify
   void notify(prop::SatClause& clause) override {}
   void spendResource(unsigned amount) override
   {
-    NodeManager::currentResourceManager()->spendResource(amount);
+    NodeManager::currentResourceManager()->spendResource(
+        ResourceManager::Resource::BvSatConflictsStep, amount);
   }
   void safePoint(unsigned amount) override {}
 };
@@ -186,7 +220,9 @@ TBitblaster<T>::TBitblaster()
       d_modelCache(),
       d_nullContext(new context::Context()),
       d_cnfStream(),
-      d_bvp(nullptr)
+      d_bvp(nullptr),
+      d_products(),
+      d_divisions()
 {
   initAtomBBStrategies();
   initTermBBStrategies();
@@ -210,6 +246,87 @@ void TBitblaster<T>::storeBBTerm(TNode node, const Bits& bits)
   d_termCache.insert(std::make_pair(node, bits));
 }
 
+template <class T>
+bool TBitblaster<T>::getSharedProduct(const Bits& a,
+                                      const Bits& b,
+                                      Bits& res) const
+{
+  Assert(a.size() == b.size() && a.size() > 0 && res.size() == 0);
+  for (unsigned swap = 0; swap < 2; ++swap)
+  {
+    const Bits& x = swap ? b : a;
+    const Bits& y = swap ? a : b;
+    typename ArithCircuitMap::const_iterator it =
+        d_products.find(std::make_pair(x[0], y[0]));
+    if (it == d_products.end())
+    {
+      continue;
+    }
+    for (const ArithCircuit& c : it->second)
+    {
+      if (c.d_a.size() >= x.size()
+          && std::equal(x.begin(), x.end(), c.d_a.begin())
+          && std::equal(y.begin(), y.end(), c.d_b.begin()))
+      {
+        res.assign(c.d_first.begin(), c.d_first.begin() + x.size());
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+template <class T>
+void TBitblaster<T>::storeSharedProduct(const Bits& a,
+                                        const Bits& b,
+                                        const Bits& res)
+{
+  ArithCircuit c;
+  c.d_a = a;
+  c.d_b = b;
+  c.d_first = res;
+  d_products[std::make_pair(a[0], b[0])].push_back(c);
+}
+
+template <class T>
+bool TBitblaster<T>::getSharedDivision(const Bits& a,
+                                       const Bits& b,
+                                       Bits& q,
+                                       Bits& r) const
+{
+  Assert(a.size() == b.size() && a.size() > 0);
+  typename ArithCircuitMap::const_iterator it =
+      d_divisions.find(std::make_pair(a[0], b[0]));
+  if (it == d_divisions.end())
+  {
+    return false;
+  }
+  for (const ArithCircuit& c : it->second)
+  {
+    if (c.d_a == a && c.d_b == b)
+    {
+      q = c.d_first;
+      r = c.d_second;
+      return true;
+    }
+  }
+  return false;
+}
+
+template <class T>
+void TBitblaster<T>::storeSharedDivision(const Bits& a,
+                                         const Bits& b,
+                                         const Bits& q,
+                                         const Bits& r)
+{
+  ArithCircuit c;
+  c.d_a = a;
+  c.d_b = b;
+  c.d_first = q;
+  c.d_second = r;
+  d_divisions[std::make_pair(a[0], b[0])].push_back(c);
+}
+
 template <class T>
 void TBitblaster<T>::invalidateModelCache()
 {
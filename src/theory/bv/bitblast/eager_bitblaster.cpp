@@ -37,7 +37,9 @@ EagerBitblaster::EagerBitblaster(TheoryBV* theory_bv, context::Context* c)
       d_bv(theory_bv),
       d_bbAtoms(),
       d_variables(),
-      d_notify()
+      d_notify(),
+      d_activations(c),
+      d_liveActivations()
 {
   prop::SatSolver *solver = nullptr;
   switch (options::bvSatSolver())
@@ -75,10 +77,17 @@ EagerBitblaster::~EagerBitblaster() {}
 
 void EagerBitblaster::bbFormula(TNode node)
 {
-  /* For incremental eager solving we assume formulas at context levels > 1. */
-  if (options::incrementalSolving() && d_context->getLevel() > 1)
+  /* For incremental eager solving the formulas only hold if the activation
+   * literal of their level is assumed. This includes the base level, which
+   * is popped by resetAssertions() while the bit-blasted terms and atom
+   * definitions are kept for the formulas asserted after the reset. */
+  if (options::incrementalSolving() && d_context->getLevel() > 0)
   {
     d_cnfStream->ensureLiteral(node);
+    prop::SatClause clause;
+    clause.push_back(~getActivation());
+    clause.push_back(d_cnfStream->getLiteral(node));
+    d_satSolver->addClause(clause, false);
   }
   else
   {
@@ -152,7 +161,8 @@ void EagerBitblaster::bbTerm(TNode node, Bits& bits) {
     return;
   }
 
-  d_bv->spendResource(options::bitblastStep());
+  d_bv->spendResource(ResourceManager::Resource::BitblastStep,
+                      options::bitblastStep());
   Debug("bitvector-bitblast") << "Bitblasting node " << node << "\n";
 
   d_termBBStrategies[node.getKind()](node, bits, this);
@@ -189,18 +199,59 @@ bool EagerBitblaster::solve() {
   //   Rewriter::garbageCollect();
   //   nm->reclaimZombiesUntil(options::zombieHuntThreshold());
   // }
-  return prop::SAT_VALUE_TRUE == d_satSolver->solve();
+  retireActivations();
+  if (d_activations.empty())
+  {
+    return prop::SAT_VALUE_TRUE == d_satSolver->solve();
+  }
+  std::vector<prop::SatLiteral> assumptions;
+  for (const std::pair<unsigned, prop::SatLiteral>& activation : d_activations)
+  {
+    assumptions.push_back(activation.second);
+  }
+  return prop::SAT_VALUE_TRUE == d_satSolver->solve(assumptions);
+}
+
+prop::SatLiteral EagerBitblaster::getActivation()
+{
+  unsigned level = d_context->getLevel();
+  if (!d_activations.empty() && d_activations.back().first == level)
+  {
+    return d_activations.back().second;
+  }
+  retireActivations();
+  // the variable must survive variable elimination to be assumed later
+  prop::SatLiteral activation(d_satSolver->newVar(false, false, false));
+  d_activations.push_back(std::make_pair(level, activation));
+  d_liveActivations.push_back(activation);
+  return activation;
 }
 
-bool EagerBitblaster::solve(const std::vector<Node>& assumptions)
+void EagerBitblaster::retireActivations()
 {
-  std::vector<prop::SatLiteral> assumpts;
-  for (const Node& assumption : assumptions)
+  if (d_liveActivations.size() == d_activations.size())
+  {
+    return;
+  }
+  std::unordered_set<prop::SatLiteral, prop::SatLiteralHashFunction> active;
+  for (const std::pair<unsigned, prop::SatLiteral>& activation : d_activations)
   {
-    Assert(d_cnfStream->hasLiteral(assumption));
-    assumpts.push_back(d_cnfStream->getLiteral(assumption));
+    active.insert(activation.second);
+  }
+  std::vector<prop::SatLiteral> live;
+  for (const prop::SatLiteral& activation : d_liveActivations)
+  {
+    if (active.find(activation) != active.end())
+    {
+      live.push_back(activation);
+      continue;
+    }
+    Debug("bitvector") << "EagerBitblaster: retiring " << activation << "\n";
+    prop::SatClause clause;
+    clause.push_back(~activation);
+    d_satSolver->addClause(clause, false);
   }
-  return prop::SAT_VALUE_TRUE == d_satSolver->solve(assumpts);
+  d_liveActivations.swap(live);
 }
 
 /**
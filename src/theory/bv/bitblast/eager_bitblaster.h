@@ -20,7 +20,10 @@
 #define CVC4__THEORY__BV__BITBLAST__EAGER_BITBLASTER_H
 
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include "context/cdlist.h"
 #include "theory/bv/bitblast/bitblaster.h"
 
 #include "proof/bitvector_proof.h"
@@ -52,8 +55,11 @@ class EagerBitblaster : public TBitblaster<Node>
   void storeBBTerm(TNode node, const Bits& bits) override;
 
   bool assertToSat(TNode node, bool propagate = true);
+  /**
+   * Solves the formulas of the current context. With incremental solving the
+   * formulas are enabled by the activation literals of their levels.
+   */
   bool solve();
-  bool solve(const std::vector<Node>& assumptions);
   bool collectModelInfo(TheoryModel* m, bool fullModel);
 
  private:
@@ -70,6 +76,22 @@ class EagerBitblaster : public TBitblaster<Node>
   // This is either an MinisatEmptyNotify or NULL.
   std::unique_ptr<MinisatEmptyNotify> d_notify;
 
+  /**
+   * The activation literal guarding the formulas of each context level,
+   * removed when the level is popped.
+   */
+  context::CDList<std::pair<unsigned, prop::SatLiteral> > d_activations;
+  /** The activation literals that have not been retired yet. */
+  std::vector<prop::SatLiteral> d_liveActivations;
+
+  /** The activation literal of the current context level. */
+  prop::SatLiteral getActivation();
+  /**
+   * Permanently disable the formulas of the popped levels by asserting the
+   * negation of their activation literals.
+   */
+  void retireActivations();
+
   Node getModelFromSatSolver(TNode a, bool fullModel) override;
   prop::SatSolver* getSatSolver() override { return d_satSolver.get(); }
   bool isSharedTerm(TNode node);
@@ -25,6 +25,7 @@
 #include "prop/sat_solver_factory.h"
 #include "smt/smt_statistics_registry.h"
 #include "theory/bv/abstraction.h"
+#include "theory/bv/bitblast/aig_bitblaster.h"
 #include "theory/bv/theory_bv.h"
 #include "theory/bv/theory_bv_utils.h"
 #include "theory/rewriter.h"
@@ -73,6 +74,7 @@ TLazyBitblaster::TLazyBitblaster(context::Context* c,
       d_abstraction(NULL),
       d_emptyNotify(emptyNotify),
       d_fullModelAssertionLevel(c, 0),
+      d_sharedTerms(options::proof() ? nullptr : bv->getBitblastTermCache()),
       d_name(name),
       d_statistics(name)
 {
@@ -84,7 +86,7 @@ TLazyBitblaster::TLazyBitblaster(context::Context* c,
                                  d_nullRegistrar.get(),
                                  d_nullContext.get(),
                                  options::proof(),
-                                 "LazyBitblaster"));
+                                 d_name));
 
   d_satSolverNotify.reset(
       d_emptyNotify
@@ -93,6 +95,28 @@ TLazyBitblaster::TLazyBitblaster(context::Context* c,
                 d_cnfStream.get(), bv, this));
 
   d_satSolver->setNotify(d_satSolverNotify.get());
+  initAigCnf();
+}
+
+void TLazyBitblaster::initAigCnf()
+{
+#ifdef CVC4_USE_ABC
+  if (options::bitvectorAig())
+  {
+    d_aigCnf.reset(
+        new AigCnfConverter(d_satSolver.get(), d_cnfStream.get(), d_name));
+  }
+#endif
+}
+
+void TLazyBitblaster::flushAigCnf()
+{
+#ifdef CVC4_USE_ABC
+  if (d_aigCnf)
+  {
+    d_aigCnf->flush();
+  }
+#endif
 }
 
 void TLazyBitblaster::setAbstraction(AbstractionModule* abs) {
@@ -177,9 +201,18 @@ void TLazyBitblaster::bbAtom(TNode node)
     atom_bb = Rewriter::rewrite(atom_bb);
   }
 
+  storeBBAtom(node, atom_bb);
+#ifdef CVC4_USE_ABC
+  if (d_aigCnf)
+  {
+    // the definition is converted with the others at the next check
+    d_aigCnf->addDefinition(d_cnfStream->getLiteral(node), atom_bb);
+    return;
+  }
+#endif
+
   // asserting that the atom is true iff the definition holds
   Node atom_definition = nm->mkNode(kind::EQUAL, node, atom_bb);
-  storeBBAtom(node, atom_bb);
   d_cnfStream->convertAndAssert(
       atom_definition, false, false, RULE_INVALID, TNode::null());
 }
@@ -195,6 +228,46 @@ void TLazyBitblaster::storeBBAtom(TNode atom, Node atom_bb) {
 void TLazyBitblaster::storeBBTerm(TNode node, const Bits& bits) {
   if( d_bvp ){ d_bvp->registerTermBB(node.toExpr()); }
   d_termCache.insert(std::make_pair(node, bits));
+  if (d_sharedTerms != nullptr)
+  {
+    d_sharedTerms->d_bits.insert(std::make_pair(node, bits));
+  }
+}
+
+bool TLazyBitblaster::importBBTerm(TNode node)
+{
+  if (d_sharedTerms->d_bits.find(node) == d_sharedTerms->d_bits.end())
+  {
+    return false;
+  }
+  // the subterms of a shared term are shared, the variables are among them
+  std::vector<TNode> visit;
+  visit.push_back(node);
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (hasBBTerm(cur))
+    {
+      continue;
+    }
+    std::unordered_map<Node, Bits, NodeHashFunction>::const_iterator it =
+        d_sharedTerms->d_bits.find(cur);
+    if (it == d_sharedTerms->d_bits.end())
+    {
+      continue;
+    }
+    d_termCache.insert(std::make_pair(cur, it->second));
+    ++d_statistics.d_numImportedTerms;
+    if (d_sharedTerms->d_variables.find(cur)
+        != d_sharedTerms->d_variables.end())
+    {
+      d_variables.insert(cur);
+      continue;
+    }
+    visit.insert(visit.end(), cur.begin(), cur.end());
+  }
+  return true;
 }
 
 
@@ -209,6 +282,10 @@ void TLazyBitblaster::makeVariable(TNode var, Bits& bits) {
     bits.push_back(utils::mkBitOf(var, i));
   }
   d_variables.insert(var);
+  if (d_sharedTerms != nullptr)
+  {
+    d_sharedTerms->d_variables.insert(var);
+  }
 }
 
 uint64_t TLazyBitblaster::computeAtomWeight(TNode node, NodeSet& seen)
@@ -232,9 +309,16 @@ void TLazyBitblaster::bbTerm(TNode node, Bits& bits) {
     getBBTerm(node, bits);
     return;
   }
+  if (d_sharedTerms != nullptr && importBBTerm(node))
+  {
+    // bit-blasted by another bit-blaster
+    getBBTerm(node, bits);
+    return;
+  }
   Assert(node.getType().isBitVector());
 
-  d_bv->spendResource(options::bitblastStep());
+  d_bv->spendResource(ResourceManager::Resource::BitblastStep,
+                      options::bitblastStep());
   Debug("bitvector-bitblast") << "Bitblasting term " << node <<"\n";
   ++d_statistics.d_numTerms;
 
@@ -281,6 +365,7 @@ void TLazyBitblaster::explain(TNode atom, std::vector<TNode>& explanation) {
  */
 
 bool TLazyBitblaster::propagate() {
+  flushAigCnf();
   return d_satSolver->propagate() == prop::SAT_VALUE_TRUE;
 }
 
@@ -295,6 +380,7 @@ bool TLazyBitblaster::assertToSat(TNode lit, bool propagate) {
   Assert(utils::isBitblastAtom(atom));
 
   Assert(hasBBAtom(atom));
+  flushAigCnf();
 
   prop::SatLiteral markerLit = d_cnfStream->getLiteral(atom);
 
@@ -329,6 +415,7 @@ bool TLazyBitblaster::solve() {
   }
   Debug("bitvector") << "TLazyBitblaster::solve() asserted atoms " << d_assertedAtoms->size() <<"\n";
   d_fullModelAssertionLevel.set(d_bv->numAssertions());
+  flushAigCnf();
   return prop::SAT_VALUE_TRUE == d_satSolver->solve();
 }
 
@@ -341,6 +428,7 @@ prop::SatValue TLazyBitblaster::solveWithBudget(unsigned long budget) {
     }
   }
   Debug("bitvector") << "TLazyBitblaster::solveWithBudget() asserted atoms " << d_assertedAtoms->size() <<"\n";
+  flushAigCnf();
   return d_satSolver->solve(budget);
 }
 
@@ -372,6 +460,7 @@ TLazyBitblaster::Statistics::Statistics(const std::string& prefix) :
   d_numAtomClauses(prefix + "::NumAtomSatClauses", 0),
   d_numTerms(prefix + "::NumBitblastedTerms", 0),
   d_numAtoms(prefix + "::NumBitblastedAtoms", 0),
+  d_numImportedTerms(prefix + "::NumImportedTerms", 0),
   d_numExplainedPropagations(prefix + "::NumExplainedPropagations", 0),
   d_numBitblastingPropagations(prefix + "::NumBitblastingPropagations", 0),
   d_bitblastTimer(prefix + "::BitblastTimer")
@@ -380,6 +469,7 @@ TLazyBitblaster::Statistics::Statistics(const std::string& prefix) :
   smtStatisticsRegistry()->registerStat(&d_numAtomClauses);
   smtStatisticsRegistry()->registerStat(&d_numTerms);
   smtStatisticsRegistry()->registerStat(&d_numAtoms);
+  smtStatisticsRegistry()->registerStat(&d_numImportedTerms);
   smtStatisticsRegistry()->registerStat(&d_numExplainedPropagations);
   smtStatisticsRegistry()->registerStat(&d_numBitblastingPropagations);
   smtStatisticsRegistry()->registerStat(&d_bitblastTimer);
@@ -391,6 +481,7 @@ TLazyBitblaster::Statistics::~Statistics() {
   smtStatisticsRegistry()->unregisterStat(&d_numAtomClauses);
   smtStatisticsRegistry()->unregisterStat(&d_numTerms);
   smtStatisticsRegistry()->unregisterStat(&d_numAtoms);
+  smtStatisticsRegistry()->unregisterStat(&d_numImportedTerms);
   smtStatisticsRegistry()->unregisterStat(&d_numExplainedPropagations);
   smtStatisticsRegistry()->unregisterStat(&d_numBitblastingPropagations);
   smtStatisticsRegistry()->unregisterStat(&d_bitblastTimer);
@@ -428,12 +519,12 @@ void TLazyBitblaster::MinisatNotify::notify(prop::SatClause& clause) {
 
 void TLazyBitblaster::MinisatNotify::spendResource(unsigned amount)
 {
-  d_bv->spendResource(amount);
+  d_bv->spendResource(ResourceManager::Resource::BvSatConflictsStep, amount);
 }
 
 void TLazyBitblaster::MinisatNotify::safePoint(unsigned amount)
 {
-  d_bv->d_out->safePoint(amount);
+  d_bv->d_out->safePoint(ResourceManager::Resource::BvSatConflictsStep, amount);
 }
 
 EqualityStatus TLazyBitblaster::getEqualityStatus(TNode a, TNode b)
@@ -573,19 +664,28 @@ void TLazyBitblaster::clearSolver() {
   d_bbAtoms.clear();
   d_variables.clear();
   d_termCache.clear();
+  d_products.clear();
+  d_divisions.clear();
 
   invalidateModelCache();
-  // recreate sat solver
+  // recreate sat solver, the converter refers to the old one
+  d_aigCnf.reset();
   d_satSolver.reset(
       prop::SatSolverFactory::createMinisat(d_ctx, smtStatisticsRegistry()));
-  d_cnfStream.reset(new prop::TseitinCnfStream(
-      d_satSolver.get(), d_nullRegistrar.get(), d_nullContext.get()));
+  // delete the old stream first, the new one registers the same statistics
+  d_cnfStream.reset();
+  d_cnfStream.reset(new prop::TseitinCnfStream(d_satSolver.get(),
+                                               d_nullRegistrar.get(),
+                                               d_nullContext.get(),
+                                               options::proof(),
+                                               d_name));
   d_satSolverNotify.reset(
       d_emptyNotify
           ? (prop::BVSatSolverNotify*)new MinisatEmptyNotify()
           : (prop::BVSatSolverNotify*)new MinisatNotify(
                 d_cnfStream.get(), d_bv, this));
   d_satSolver->setNotify(d_satSolverNotify.get());
+  initAigCnf();
 }
 
 }  // namespace bv
@@ -34,6 +34,22 @@ namespace theory {
 namespace bv {
 
 class TheoryBV;
+class AigCnfConverter;
+
+/**
+ * The bits of the terms bit-blasted by the lazy bit-blasters of a TheoryBV.
+ * The bit-blasters (of the bitblast sub-solver and of the quick checks of the
+ * sub-solvers) encode their atoms in different SAT solvers, but the bits of a
+ * term are the same nodes for all of them, hence a term is only bit-blasted
+ * once, and its bits are imported by the other bit-blasters.
+ */
+struct LazyBitblastTermCache
+{
+  /** the bits of the bit-blasted terms */
+  std::unordered_map<Node, std::vector<Node>, NodeHashFunction> d_bits;
+  /** the terms that were bit-blasted as variables */
+  std::unordered_set<Node, NodeHashFunction> d_variables;
+};
 
 class TLazyBitblaster : public TBitblaster<Node>
 {
@@ -130,6 +146,8 @@ class TLazyBitblaster : public TBitblaster<Node>
   std::unique_ptr<prop::NullRegistrar> d_nullRegistrar;
   std::unique_ptr<prop::BVSatSolverInterface> d_satSolver;
   std::unique_ptr<prop::BVSatSolverNotify> d_satSolverNotify;
+  /** Converts the atom definitions through an AIG, with --bitblast-aig */
+  std::unique_ptr<AigCnfConverter> d_aigCnf;
 
   AssertionList*
       d_assertedAtoms;            /**< context dependent list storing the atoms
@@ -148,6 +166,18 @@ class TLazyBitblaster : public TBitblaster<Node>
   context::CDO<int> d_fullModelAssertionLevel;
 
   void addAtom(TNode atom);
+  /**
+   * Import the bits of node and of its subterms from d_sharedTerms, if node
+   * is there, and register the variables among them. Returns false if node
+   * is not in d_sharedTerms.
+   */
+  bool importBBTerm(TNode node);
+  /** The bits shared with the other bit-blasters, if any */
+  LazyBitblastTermCache* d_sharedTerms;
+  /** Create d_aigCnf for the current SAT solver if AIGs are used */
+  void initAigCnf();
+  /** Add the clauses of the queued atom definitions to the SAT solver */
+  void flushAigCnf();
   bool hasValue(TNode a);
   Node getModelFromSatSolver(TNode a, bool fullModel) override;
   prop::SatSolver* getSatSolver() override { return d_satSolver.get(); }
@@ -157,6 +187,7 @@ class TLazyBitblaster : public TBitblaster<Node>
    public:
     IntStat d_numTermClauses, d_numAtomClauses;
     IntStat d_numTerms, d_numAtoms;
+    IntStat d_numImportedTerms;
     IntStat d_numExplainedPropagations;
     IntStat d_numBitblastingPropagations;
     TimerStat d_bitblastTimer;
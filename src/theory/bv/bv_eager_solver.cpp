@@ -28,7 +28,6 @@ namespace bv {
 
 EagerBitblastSolver::EagerBitblastSolver(context::Context* c, TheoryBV* bv)
     : d_assertionSet(c),
-      d_assumptionSet(c),
       d_context(c),
       d_bitblaster(),
       d_aigBitblaster(),
@@ -70,14 +69,10 @@ bool EagerBitblastSolver::isInitialized() {
 }
 
 void EagerBitblastSolver::assertFormula(TNode formula) {
-  d_bv->spendResource(1);
+  d_bv->spendResource(ResourceManager::Resource::BvEagerAssertStep, 1);
   Assert(isInitialized());
   Debug("bitvector-eager") << "EagerBitblastSolver::assertFormula " << formula
                            << "\n";
-  if (options::incrementalSolving() && d_context->getLevel() > 1)
-  {
-    d_assumptionSet.insert(formula);
-  }
   d_assertionSet.insert(formula);
   // ensures all atoms are bit-blasted and converted to AIG
   if (d_useAig) {
@@ -112,12 +107,6 @@ bool EagerBitblastSolver::checkSat() {
 #endif
   }
 
-  if (options::incrementalSolving())
-  {
-    const std::vector<Node> assumptions = {d_assumptionSet.key_begin(),
-                                           d_assumptionSet.key_end()};
-    return d_bitblaster->solve(assumptions);
-  }
   return d_bitblaster->solve();
 }
 
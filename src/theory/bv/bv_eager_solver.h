@@ -52,7 +52,6 @@ class EagerBitblastSolver {
 
  private:
   context::CDHashSet<Node, NodeHashFunction> d_assertionSet;
-  context::CDHashSet<Node, NodeHashFunction> d_assumptionSet;
   context::Context* d_context;
 
   /** Bitblasters */
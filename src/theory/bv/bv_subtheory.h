@@ -39,7 +39,8 @@ enum SubTheory {
   SUB_CORE = 1,
   SUB_BITBLAST = 2,
   SUB_INEQUALITY = 3,
-  SUB_ALGEBRAIC = 4
+  SUB_ALGEBRAIC = 4,
+  SUB_DOMAIN = 5
 };
 
 inline std::ostream& operator<<(std::ostream& out, SubTheory subtheory) {
@@ -52,6 +53,8 @@ inline std::ostream& operator<<(std::ostream& out, SubTheory subtheory) {
       return out << "BV_INEQUALITY_SUBTHEORY";
     case SUB_ALGEBRAIC:
       return out << "BV_ALGEBRAIC_SUBTHEORY";
+    case SUB_DOMAIN:
+      return out << "BV_DOMAIN_SUBTHEORY";
     default:
       break;
   }
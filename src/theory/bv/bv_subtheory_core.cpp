@@ -41,7 +41,6 @@ CoreSolver::CoreSolver(context::Context* c, TheoryBV* bv)
     d_lemmaThreshold(16),
     d_useSlicer(false),
     d_preregisterCalled(false),
-    d_checkCalled(false),
     d_reasons(c)
 {
   // The kinds we are treating as function application in congruence
@@ -86,6 +85,10 @@ void CoreSolver::setMasterEqualityEngine(eq::EqualityEngine* eq) {
 }
 
 void CoreSolver::enableSlicer() {
+  if (d_useSlicer) {
+    // already enabled by a previous check-sat
+    return;
+  }
   AlwaysAssert(!d_preregisterCalled);
   d_useSlicer = true;
   d_statistics.d_slicerEnabled.setData(true);
@@ -96,8 +99,8 @@ void CoreSolver::preRegister(TNode node) {
   if (node.getKind() == kind::EQUAL) {
       d_equalityEngine.addTriggerEquality(node);
       if (d_useSlicer) {
+        // the slicing is only refined, this may happen after a check
         d_slicer->processEquality(node);
-        AlwaysAssert(!d_checkCalled);
       }
   } else {
     d_equalityEngine.addTerm(node);
@@ -145,10 +148,15 @@ bool CoreSolver::decomposeFact(TNode fact) {
   Node b_eq_new_b = nm->mkNode(kind::EQUAL, b, new_b);
 
   bool ok = true;
-  ok = assertFactToEqualityEngine(a_eq_new_a, utils::mkTrue());
-  if (!ok) return false;
-  ok = assertFactToEqualityEngine(b_eq_new_b, utils::mkTrue());
-  if (!ok) return false;
+  // skip the decompositions that are trivial or already known
+  if (new_a != a && !areKnownEqual(a, new_a)) {
+    ok = assertFactToEqualityEngine(a_eq_new_a, utils::mkTrue());
+    if (!ok) return false;
+  }
+  if (new_b != b && !areKnownEqual(b, new_b)) {
+    ok = assertFactToEqualityEngine(b_eq_new_b, utils::mkTrue());
+    if (!ok) return false;
+  }
   ok = assertFactToEqualityEngine(fact, fact);
   if (!ok) return false;
 
@@ -168,12 +176,18 @@ bool CoreSolver::decomposeFact(TNode fact) {
   return true;
 }
 
+bool CoreSolver::areKnownEqual(TNode a, TNode b) const
+{
+  return d_equalityEngine.hasTerm(a) && d_equalityEngine.hasTerm(b)
+         && d_equalityEngine.areEqual(a, b);
+}
+
 bool CoreSolver::check(Theory::Effort e) {
   Trace("bitvector::core") << "CoreSolver::check \n";
 
-  d_bv->spendResource(options::theoryCheckStep());
+  d_bv->spendResource(ResourceManager::Resource::TheoryCheckStep,
+                      options::theoryCheckStep());
 
-  d_checkCalled = true;
   Assert(!d_bv->inConflict());
   ++(d_statistics.d_numCallstoCheck);
   bool ok = true;
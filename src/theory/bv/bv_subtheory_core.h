@@ -89,7 +89,6 @@ class CoreSolver : public SubtheorySolver {
   /** Used to ensure that the core slicer is used properly*/
   bool d_useSlicer;
   bool d_preregisterCalled;
-  bool d_checkCalled;
   
   /** To make sure we keep the explanations */
   context::CDHashSet<Node, NodeHashFunction> d_reasons;
@@ -97,6 +96,8 @@ class CoreSolver : public SubtheorySolver {
   void buildModel();
   bool assertFactToEqualityEngine(TNode fact, TNode reason);
   bool decomposeFact(TNode fact);
+  /** Returns true if a and b are in the same class of the equality engine */
+  bool areKnownEqual(TNode a, TNode b) const;
   Node getBaseDecomposition(TNode a);
   bool isCompleteForTerm(TNode term, TNodeBoolMap& seen);
   Statistics d_statistics;
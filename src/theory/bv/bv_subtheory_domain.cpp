@@ -0,0 +1,801 @@
+/*********************                                                        */
+/*! \file bv_subtheory_domain.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Word-level propagation of known bits and intervals.
+ **
+ ** Word-level propagation of known bits and intervals.
+ **/
+
+#include "theory/bv/bv_subtheory_domain.h"
+
+#include "options/bv_options.h"
+#include "options/smt_options.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/bv/theory_bv.h"
+#include "theory/bv/theory_bv_utils.h"
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+DomainSolver::DomainSolver(context::Context* c, TheoryBV* bv)
+    : SubtheorySolver(c, bv),
+      d_entries(c),
+      d_static(),
+      d_parents(),
+      d_atoms(),
+      d_registeredAtoms(),
+      d_asserted(c),
+      d_explanations(c),
+      d_queue(),
+      d_candidates(),
+      d_conflict(),
+      d_statistics()
+{
+}
+
+DomainSolver::~DomainSolver() {}
+
+bool DomainSolver::isDomainAtom(TNode atom)
+{
+  switch (atom.getKind())
+  {
+    case kind::EQUAL: return atom[0].getType().isBitVector();
+    case kind::BITVECTOR_ULT:
+    case kind::BITVECTOR_ULE:
+    case kind::BITVECTOR_SLT:
+    case kind::BITVECTOR_SLE: return true;
+    default: return false;
+  }
+}
+
+void DomainSolver::preRegister(TNode node)
+{
+  if (isDomainAtom(node))
+  {
+    registerAtom(node);
+  }
+}
+
+void DomainSolver::registerAtom(TNode atom)
+{
+  if (!d_registeredAtoms.insert(atom).second)
+  {
+    return;
+  }
+  for (unsigned i = 0; i < 2; ++i)
+  {
+    registerTerm(atom[i]);
+    if (!atom[i].isConst())
+    {
+      d_atoms[atom[i]].push_back(atom);
+    }
+  }
+}
+
+void DomainSolver::registerTerm(TNode term)
+{
+  std::vector<TNode> stack;
+  stack.push_back(term);
+  while (!stack.empty())
+  {
+    TNode t = stack.back();
+    if (t.isConst() || d_static.find(t) != d_static.end())
+    {
+      stack.pop_back();
+      continue;
+    }
+    // register the children first
+    bool ready = true;
+    for (const TNode& child : t)
+    {
+      if (child.getType().isBitVector() && !child.isConst()
+          && d_static.find(child) == d_static.end())
+      {
+        stack.push_back(child);
+        ready = false;
+      }
+    }
+    if (!ready)
+    {
+      continue;
+    }
+    stack.pop_back();
+    std::vector<WordDomain> children;
+    for (const TNode& child : t)
+    {
+      if (!child.getType().isBitVector())
+      {
+        children.push_back(WordDomain());
+        continue;
+      }
+      if (child.isConst())
+      {
+        children.push_back(WordDomain(child.getConst<BitVector>()));
+        continue;
+      }
+      children.push_back(d_static[child]);
+      d_parents[child].push_back(t);
+    }
+    d_static[t] = computeForward(t, children);
+  }
+}
+
+DomainSolver::Entry DomainSolver::getEntry(TNode term) const
+{
+  EntryMap::const_iterator it = d_entries.find(term);
+  if (it != d_entries.end())
+  {
+    return (*it).second;
+  }
+  Entry entry;
+  if (term.isConst())
+  {
+    entry.d_domain = WordDomain(term.getConst<BitVector>());
+    return entry;
+  }
+  DomainMap::const_iterator st = d_static.find(term);
+  entry.d_domain =
+      st != d_static.end() ? st->second : WordDomain(utils::getSize(term));
+  return entry;
+}
+
+Node DomainSolver::mkReason(std::vector<TNode>& reasons)
+{
+  std::vector<TNode> conjuncts;
+  for (const TNode& reason : reasons)
+  {
+    if (!reason.isNull())
+    {
+      conjuncts.push_back(reason);
+    }
+  }
+  if (conjuncts.empty())
+  {
+    return Node::null();
+  }
+  return utils::flattenAnd(conjuncts);
+}
+
+bool DomainSolver::update(TNode term,
+                          const WordDomain& d,
+                          std::vector<TNode>& reasons)
+{
+  Entry entry = getEntry(term);
+  if (!entry.d_domain.intersect(d))
+  {
+    return true;
+  }
+  ++(d_statistics.d_numUpdates);
+  reasons.push_back(entry.d_reason);
+  entry.d_reason = mkReason(reasons);
+  Debug("bv-domain") << "DomainSolver::update " << term << " : "
+                     << entry.d_domain << "\n";
+  if (entry.d_domain.isEmpty())
+  {
+    Assert(!entry.d_reason.isNull());
+    d_conflict = entry.d_reason;
+    return false;
+  }
+  if (term.isConst())
+  {
+    return true;
+  }
+  d_entries.insert(term, entry);
+  d_queue.push_back(term);
+  NodeListMap::const_iterator it = d_atoms.find(term);
+  if (it != d_atoms.end())
+  {
+    d_candidates.insert(it->second.begin(), it->second.end());
+  }
+  return true;
+}
+
+bool DomainSolver::assertAtom(TNode atom, TNode fact)
+{
+  bool polarity = fact.getKind() != kind::NOT;
+  Kind k = atom.getKind();
+  TNode a = atom[0];
+  TNode b = atom[1];
+  if (!polarity && k != kind::EQUAL)
+  {
+    // not (a < b) is b <= a and not (a <= b) is b < a
+    std::swap(a, b);
+    k = k == kind::BITVECTOR_ULT
+            ? kind::BITVECTOR_ULE
+            : k == kind::BITVECTOR_ULE
+                  ? kind::BITVECTOR_ULT
+                  : k == kind::BITVECTOR_SLT ? kind::BITVECTOR_SLE
+                                             : kind::BITVECTOR_SLT;
+  }
+  Entry ea = getEntry(a);
+  Entry eb = getEntry(b);
+  const WordDomain& da = ea.d_domain;
+  const WordDomain& db = eb.d_domain;
+  unsigned width = utils::getSize(a);
+  BitVector one(width, 1u);
+  BitVector umax = BitVector::mkOnes(width);
+  BitVector smin = BitVector::mkMinSigned(width);
+  BitVector smax = BitVector::mkMaxSigned(width);
+  // the restrictions of a and b implied by the atom
+  WordDomain na(width);
+  WordDomain nb(width);
+  switch (k)
+  {
+    case kind::EQUAL:
+      if (polarity)
+      {
+        na = db;
+        nb = da;
+      }
+      else
+      {
+        if (db.isFixed())
+        {
+          na = da;
+          na.exclude(db.getUnsignedLower());
+        }
+        if (da.isFixed())
+        {
+          nb = db;
+          nb.exclude(da.getUnsignedLower());
+        }
+      }
+      break;
+    case kind::BITVECTOR_ULT:
+      if (db.getUnsignedUpper() == BitVector(width)
+          || da.getUnsignedLower() == umax)
+      {
+        na.setEmpty();
+        break;
+      }
+      na.restrictUnsigned(BitVector(width), db.getUnsignedUpper() - one);
+      nb.restrictUnsigned(da.getUnsignedLower() + one, umax);
+      break;
+    case kind::BITVECTOR_ULE:
+      na.restrictUnsigned(BitVector(width), db.getUnsignedUpper());
+      nb.restrictUnsigned(da.getUnsignedLower(), umax);
+      break;
+    case kind::BITVECTOR_SLT:
+      if (db.getSignedUpper() == smin || da.getSignedLower() == smax)
+      {
+        na.setEmpty();
+        break;
+      }
+      na.restrictSigned(smin, db.getSignedUpper() - one);
+      nb.restrictSigned(da.getSignedLower() + one, smax);
+      break;
+    default:
+      Assert(k == kind::BITVECTOR_SLE);
+      na.restrictSigned(smin, db.getSignedUpper());
+      nb.restrictSigned(da.getSignedLower(), smax);
+      break;
+  }
+  std::vector<TNode> reasons;
+  reasons.push_back(fact);
+  reasons.push_back(eb.d_reason);
+  if (!update(a, na, reasons))
+  {
+    return false;
+  }
+  reasons.clear();
+  reasons.push_back(fact);
+  reasons.push_back(ea.d_reason);
+  return update(b, nb, reasons);
+}
+
+bool DomainSolver::propagateForward(TNode term)
+{
+  std::vector<WordDomain> children;
+  std::vector<Node> reasons;
+  for (const TNode& child : term)
+  {
+    if (!child.getType().isBitVector())
+    {
+      children.push_back(WordDomain());
+      continue;
+    }
+    Entry entry = getEntry(child);
+    children.push_back(entry.d_domain);
+    reasons.push_back(entry.d_reason);
+  }
+  WordDomain d = computeForward(term, children);
+  if (d.isTop())
+  {
+    return true;
+  }
+  std::vector<TNode> treasons(reasons.begin(), reasons.end());
+  return update(term, d, treasons);
+}
+
+bool DomainSolver::propagateBackward(TNode term)
+{
+  Entry entry = getEntry(term);
+  std::vector<WordDomain> children;
+  std::vector<Node> reasons;
+  for (const TNode& child : term)
+  {
+    if (!child.getType().isBitVector())
+    {
+      children.push_back(WordDomain());
+      reasons.push_back(Node::null());
+      continue;
+    }
+    Entry centry = getEntry(child);
+    children.push_back(centry.d_domain);
+    reasons.push_back(centry.d_reason);
+  }
+  for (unsigned i = 0; i < term.getNumChildren(); ++i)
+  {
+    if (!term[i].getType().isBitVector() || term[i].isConst())
+    {
+      continue;
+    }
+    WordDomain d = computeBackward(term, i, entry.d_domain, children);
+    if (d.isTop())
+    {
+      continue;
+    }
+    std::vector<TNode> treasons;
+    treasons.push_back(entry.d_reason);
+    for (unsigned j = 0; j < reasons.size(); ++j)
+    {
+      if (j != i)
+      {
+        treasons.push_back(reasons[j]);
+      }
+    }
+    if (!update(term[i], d, treasons))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool DomainSolver::propagateQueue()
+{
+  unsigned steps = 0;
+  while (!d_queue.empty())
+  {
+    if (++steps > options::bvDomainSolverSteps())
+    {
+      // give up on the fixpoint, what was derived so far is still valid
+      ++(d_statistics.d_numBudgetOuts);
+      d_queue.clear();
+      break;
+    }
+    Node term = d_queue.back();
+    d_queue.pop_back();
+    NodeListMap::const_iterator it = d_parents.find(term);
+    if (it != d_parents.end())
+    {
+      for (const Node& parent : it->second)
+      {
+        if (!propagateForward(parent))
+        {
+          return false;
+        }
+      }
+    }
+    if (!propagateBackward(term))
+    {
+      return false;
+    }
+    it = d_atoms.find(term);
+    if (it != d_atoms.end())
+    {
+      for (const Node& atom : it->second)
+      {
+        NodeMap::const_iterator fact = d_asserted.find(atom);
+        if (fact != d_asserted.end() && !assertAtom(atom, (*fact).second))
+        {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void DomainSolver::propagateAtom(TNode atom)
+{
+  if (d_asserted.find(atom) != d_asserted.end())
+  {
+    return;
+  }
+  Entry ea = getEntry(atom[0]);
+  Entry eb = getEntry(atom[1]);
+  const WordDomain& da = ea.d_domain;
+  const WordDomain& db = eb.d_domain;
+  bool known = false;
+  bool value = false;
+  switch (atom.getKind())
+  {
+    case kind::EQUAL:
+      if (da.isFixed() && db.isFixed()
+          && da.getUnsignedLower() == db.getUnsignedLower())
+      {
+        known = value = true;
+      }
+      else if (da.isDisjoint(db))
+      {
+        known = true;
+      }
+      break;
+    case kind::BITVECTOR_ULT:
+      if (da.getUnsignedUpper().unsignedLessThan(db.getUnsignedLower()))
+      {
+        known = value = true;
+      }
+      else if (db.getUnsignedUpper().unsignedLessThanEq(da.getUnsignedLower()))
+      {
+        known = true;
+      }
+      break;
+    case kind::BITVECTOR_ULE:
+      if (da.getUnsignedUpper().unsignedLessThanEq(db.getUnsignedLower()))
+      {
+        known = value = true;
+      }
+      else if (db.getUnsignedUpper().unsignedLessThan(da.getUnsignedLower()))
+      {
+        known = true;
+      }
+      break;
+    case kind::BITVECTOR_SLT:
+      if (da.getSignedUpper().signedLessThan(db.getSignedLower()))
+      {
+        known = value = true;
+      }
+      else if (db.getSignedUpper().signedLessThanEq(da.getSignedLower()))
+      {
+        known = true;
+      }
+      break;
+    default:
+      Assert(atom.getKind() == kind::BITVECTOR_SLE);
+      if (da.getSignedUpper().signedLessThanEq(db.getSignedLower()))
+      {
+        known = value = true;
+      }
+      else if (db.getSignedUpper().signedLessThan(da.getSignedLower()))
+      {
+        known = true;
+      }
+      break;
+  }
+  if (!known)
+  {
+    return;
+  }
+  std::vector<TNode> reasons;
+  reasons.push_back(ea.d_reason);
+  reasons.push_back(eb.d_reason);
+  Node explanation = mkReason(reasons);
+  if (explanation.isNull())
+  {
+    // follows from the terms alone, which is left to the rewriter
+    return;
+  }
+  Node literal = value ? Node(atom) : atom.notNode();
+  if (d_explanations.find(literal) != d_explanations.end())
+  {
+    return;
+  }
+  Debug("bv-domain") << "DomainSolver::propagate " << literal << "\n";
+  ++(d_statistics.d_numPropagations);
+  d_explanations.insert(literal, explanation);
+  d_bv->storePropagation(literal, SUB_DOMAIN);
+}
+
+bool DomainSolver::check(Theory::Effort e)
+{
+  Debug("bv-domain") << "DomainSolver::check(" << e << ")\n";
+  TimerStat::CodeTimer checkTimer(d_statistics.d_solveTime);
+  ++(d_statistics.d_numCallsToCheck);
+  d_bv->spendResource(ResourceManager::Resource::TheoryCheckStep,
+                      options::theoryCheckStep());
+
+  bool ok = true;
+  while (!done() && ok)
+  {
+    TNode fact = get();
+    TNode atom = fact.getKind() == kind::NOT ? fact[0] : fact;
+    if (!isDomainAtom(atom))
+    {
+      continue;
+    }
+    registerAtom(atom);
+    d_asserted.insert(atom, fact);
+    ok = assertAtom(atom, fact);
+  }
+  ok = ok && propagateQueue();
+  d_queue.clear();
+
+  if (!ok)
+  {
+    ++(d_statistics.d_numConflicts);
+    Debug("bv-domain") << "DomainSolver::conflict " << d_conflict << "\n";
+    d_candidates.clear();
+    d_bv->setConflict(d_conflict);
+    return false;
+  }
+  for (const Node& atom : d_candidates)
+  {
+    propagateAtom(atom);
+  }
+  d_candidates.clear();
+  return true;
+}
+
+void DomainSolver::explain(TNode literal, std::vector<TNode>& assumptions)
+{
+  NodeMap::const_iterator it = d_explanations.find(literal);
+  Assert(it != d_explanations.end());
+  TNode explanation = (*it).second;
+  if (explanation.getKind() == kind::AND)
+  {
+    assumptions.insert(
+        assumptions.end(), explanation.begin(), explanation.end());
+  }
+  else
+  {
+    assumptions.push_back(explanation);
+  }
+}
+
+EqualityStatus DomainSolver::getEqualityStatus(TNode a, TNode b)
+{
+  if (d_static.find(a) == d_static.end() && d_static.find(b) == d_static.end())
+  {
+    return EQUALITY_UNKNOWN;
+  }
+  WordDomain da = getEntry(a).d_domain;
+  WordDomain db = getEntry(b).d_domain;
+  if (da.isFixed() && db.isFixed()
+      && da.getUnsignedLower() == db.getUnsignedLower())
+  {
+    return EQUALITY_TRUE;
+  }
+  if (da.isDisjoint(db))
+  {
+    return EQUALITY_FALSE;
+  }
+  return EQUALITY_UNKNOWN;
+}
+
+WordDomain DomainSolver::computeForward(TNode term,
+                                        const std::vector<WordDomain>& children)
+{
+  unsigned width = utils::getSize(term);
+  switch (term.getKind())
+  {
+    case kind::BITVECTOR_NOT: return WordDomain::mkNot(children[0]);
+    case kind::BITVECTOR_NEG: return WordDomain::mkNeg(children[0]);
+    case kind::BITVECTOR_AND:
+    case kind::BITVECTOR_OR:
+    case kind::BITVECTOR_XOR:
+    case kind::BITVECTOR_PLUS:
+    case kind::BITVECTOR_MULT:
+    case kind::BITVECTOR_CONCAT:
+    {
+      WordDomain d = children[0];
+      for (unsigned i = 1; i < children.size(); ++i)
+      {
+        switch (term.getKind())
+        {
+          case kind::BITVECTOR_AND:
+            d = WordDomain::mkAnd(d, children[i]);
+            break;
+          case kind::BITVECTOR_OR: d = WordDomain::mkOr(d, children[i]); break;
+          case kind::BITVECTOR_XOR:
+            d = WordDomain::mkXor(d, children[i]);
+            break;
+          case kind::BITVECTOR_PLUS:
+            d = WordDomain::mkPlus(d, children[i]);
+            break;
+          case kind::BITVECTOR_MULT:
+            d = WordDomain::mkMult(d, children[i]);
+            break;
+          default: d = WordDomain::mkConcat(d, children[i]); break;
+        }
+      }
+      return d;
+    }
+    case kind::BITVECTOR_SUB:
+      return WordDomain::mkPlus(children[0], WordDomain::mkNeg(children[1]));
+    case kind::BITVECTOR_EXTRACT:
+      return WordDomain::mkExtract(children[0],
+                                   utils::getExtractHigh(term),
+                                   utils::getExtractLow(term));
+    case kind::BITVECTOR_ZERO_EXTEND:
+      return WordDomain::mkZeroExtend(
+          children[0],
+          term.getOperator()
+              .getConst<BitVectorZeroExtend>()
+              .zeroExtendAmount);
+    case kind::BITVECTOR_SIGN_EXTEND:
+      return WordDomain::mkSignExtend(children[0],
+                                      utils::getSignExtendAmount(term));
+    case kind::BITVECTOR_SHL:
+      return WordDomain::mkShl(children[0], children[1]);
+    case kind::BITVECTOR_LSHR:
+      return WordDomain::mkLshr(children[0], children[1]);
+    case kind::BITVECTOR_ASHR:
+      return WordDomain::mkAshr(children[0], children[1]);
+    case kind::BITVECTOR_UDIV_TOTAL:
+      return WordDomain::mkUdiv(children[0], children[1]);
+    case kind::BITVECTOR_UREM_TOTAL:
+      return WordDomain::mkUrem(children[0], children[1]);
+    case kind::BITVECTOR_ITE:
+      if (children[0].isFixed())
+      {
+        return children[0].getOnes().isBitSet(0) ? children[1] : children[2];
+      }
+      return WordDomain::mkHull(children[1], children[2]);
+    case kind::ITE: return WordDomain::mkHull(children[1], children[2]);
+    default: return WordDomain(width);
+  }
+}
+
+WordDomain DomainSolver::computeBackward(TNode term,
+                                         unsigned i,
+                                         const WordDomain& domain,
+                                         const std::vector<WordDomain>& children)
+{
+  unsigned width = utils::getSize(term[i]);
+  WordDomain d(width);
+  switch (term.getKind())
+  {
+    case kind::BITVECTOR_NOT: return WordDomain::mkNot(domain);
+    case kind::BITVECTOR_NEG: return WordDomain::mkNeg(domain);
+    case kind::BITVECTOR_AND:
+    {
+      // a bit is 0 if the result is 0 and all others are 1
+      BitVector others = BitVector::mkOnes(width);
+      for (unsigned j = 0; j < children.size(); ++j)
+      {
+        if (j != i)
+        {
+          others = others & children[j].getOnes();
+        }
+      }
+      d.restrictBits(domain.getZeros() & others, domain.getOnes());
+      d.restrictUnsigned(domain.getUnsignedLower(), BitVector::mkOnes(width));
+      return d;
+    }
+    case kind::BITVECTOR_OR:
+    {
+      // a bit is 1 if the result is 1 and all others are 0
+      BitVector others = BitVector::mkOnes(width);
+      for (unsigned j = 0; j < children.size(); ++j)
+      {
+        if (j != i)
+        {
+          others = others & children[j].getZeros();
+        }
+      }
+      d.restrictBits(domain.getZeros(), domain.getOnes() & others);
+      d.restrictUnsigned(BitVector(width), domain.getUnsignedUpper());
+      return d;
+    }
+    case kind::BITVECTOR_XOR:
+    case kind::BITVECTOR_PLUS:
+    {
+      // subtract the others from the result
+      bool isXor = term.getKind() == kind::BITVECTOR_XOR;
+      WordDomain others = WordDomain(BitVector(width));
+      for (unsigned j = 0; j < children.size(); ++j)
+      {
+        if (j != i)
+        {
+          others = isXor ? WordDomain::mkXor(others, children[j])
+                         : WordDomain::mkPlus(others, children[j]);
+        }
+      }
+      return isXor ? WordDomain::mkXor(domain, others)
+                   : WordDomain::mkPlus(domain, WordDomain::mkNeg(others));
+    }
+    case kind::BITVECTOR_SUB:
+      return i == 0 ? WordDomain::mkPlus(domain, children[1])
+                    : WordDomain::mkPlus(children[0],
+                                         WordDomain::mkNeg(domain));
+    case kind::BITVECTOR_CONCAT:
+    {
+      unsigned low = 0;
+      for (unsigned j = i + 1; j < children.size(); ++j)
+      {
+        low += children[j].getWidth();
+      }
+      return WordDomain::mkExtract(domain, low + width - 1, low);
+    }
+    case kind::BITVECTOR_EXTRACT:
+    {
+      unsigned high = utils::getExtractHigh(term);
+      unsigned low = utils::getExtractLow(term);
+      d.restrictBits(
+          BitVector(width, domain.getZeros().getValue().multiplyByPow2(low)),
+          BitVector(width, domain.getOnes().getValue().multiplyByPow2(low)));
+      if (high + 1 == width)
+      {
+        // the dropped low bits can be anything
+        Integer pow = Integer(1).multiplyByPow2(low);
+        Integer rest = pow - Integer(1);
+        d.restrictUnsigned(
+            BitVector(width, domain.getUnsignedLower().getValue() * pow),
+            BitVector(width,
+                      domain.getUnsignedUpper().getValue() * pow + rest));
+        d.restrictSigned(
+            BitVector(width, domain.getSignedLower().toSignedInteger() * pow),
+            BitVector(width,
+                      domain.getSignedUpper().toSignedInteger() * pow + rest));
+      }
+      return d;
+    }
+    case kind::BITVECTOR_ZERO_EXTEND:
+    case kind::BITVECTOR_SIGN_EXTEND:
+      return WordDomain::mkExtract(domain, width - 1, 0);
+    case kind::BITVECTOR_SHL:
+    case kind::BITVECTOR_LSHR:
+    {
+      if (i != 0 || !children[1].isFixed()
+          || children[1].getUnsignedLower().getValue() >= Integer(width))
+      {
+        return d;
+      }
+      unsigned s = children[1].getUnsignedLower().getValue().getUnsignedInt();
+      if (term.getKind() == kind::BITVECTOR_SHL)
+      {
+        // the low bits of the result are the shifted high bits of the child
+        d.restrictBits(
+            BitVector(width, domain.getZeros().getValue().divByPow2(s)),
+            BitVector(width, domain.getOnes().getValue().divByPow2(s)));
+      }
+      else
+      {
+        d.restrictBits(
+            BitVector(width, domain.getZeros().getValue().multiplyByPow2(s)),
+            BitVector(width, domain.getOnes().getValue().multiplyByPow2(s)));
+      }
+      return d;
+    }
+    default: return d;
+  }
+}
+
+DomainSolver::Statistics::Statistics()
+    : d_numCallsToCheck("theory::bv::domain::NumCallsToCheck", 0),
+      d_numUpdates("theory::bv::domain::NumUpdates", 0),
+      d_numConflicts("theory::bv::domain::NumConflicts", 0),
+      d_numPropagations("theory::bv::domain::NumPropagations", 0),
+      d_numBudgetOuts("theory::bv::domain::NumBudgetOuts", 0),
+      d_solveTime("theory::bv::domain::SolveTime")
+{
+  smtStatisticsRegistry()->registerStat(&d_numCallsToCheck);
+  smtStatisticsRegistry()->registerStat(&d_numUpdates);
+  smtStatisticsRegistry()->registerStat(&d_numConflicts);
+  smtStatisticsRegistry()->registerStat(&d_numPropagations);
+  smtStatisticsRegistry()->registerStat(&d_numBudgetOuts);
+  smtStatisticsRegistry()->registerStat(&d_solveTime);
+}
+
+DomainSolver::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numCallsToCheck);
+  smtStatisticsRegistry()->unregisterStat(&d_numUpdates);
+  smtStatisticsRegistry()->unregisterStat(&d_numConflicts);
+  smtStatisticsRegistry()->unregisterStat(&d_numPropagations);
+  smtStatisticsRegistry()->unregisterStat(&d_numBudgetOuts);
+  smtStatisticsRegistry()->unregisterStat(&d_solveTime);
+}
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
@@ -0,0 +1,154 @@
+/*********************                                                        */
+/*! \file bv_subtheory_domain.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Word-level propagation of known bits and intervals.
+ **
+ ** Keeps a WordDomain for every bit-vector term below the registered atoms
+ ** and propagates the asserted atoms through the terms: forwards from the
+ ** arguments of an operator to its result, and backwards from the result to
+ ** the arguments. An empty domain is a conflict, and the atoms whose value
+ ** follows from the domains of their sides are propagated, so that cheap
+ ** bound reasoning does not have to wait for the bit-blaster. Every domain
+ ** comes with the conjunction of the facts it was derived from, which
+ ** explains the conflicts and propagations.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__BV__BV_SUBTHEORY__DOMAIN_H
+#define CVC4__THEORY__BV__BV_SUBTHEORY__DOMAIN_H
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "context/cdhashmap.h"
+#include "theory/bv/bv_subtheory.h"
+#include "theory/bv/bv_word_domain.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+class DomainSolver : public SubtheorySolver
+{
+ public:
+  DomainSolver(context::Context* c, TheoryBV* bv);
+  ~DomainSolver();
+
+  bool check(Theory::Effort e) override;
+  void explain(TNode literal, std::vector<TNode>& assumptions) override;
+  void preRegister(TNode node) override;
+  /** Only finds conflicts and propagations, never a model. */
+  bool isComplete() override { return false; }
+  bool collectModelInfo(TheoryModel* m, bool fullModel) override
+  {
+    return true;
+  }
+  Node getModelValue(TNode var) override { return Node::null(); }
+  EqualityStatus getEqualityStatus(TNode a, TNode b) override;
+
+ private:
+  /** A domain and the conjunction of the facts it follows from. */
+  struct Entry
+  {
+    WordDomain d_domain;
+    /** The null node if the domain follows from the term alone. */
+    Node d_reason;
+  };
+
+  typedef context::CDHashMap<Node, Entry, NodeHashFunction> EntryMap;
+  typedef context::CDHashMap<Node, Node, NodeHashFunction> NodeMap;
+  typedef std::unordered_map<Node, std::vector<Node>, NodeHashFunction>
+      NodeListMap;
+  typedef std::unordered_map<Node, WordDomain, NodeHashFunction> DomainMap;
+
+  /** Whether atom is a relation this solver reasons about. */
+  static bool isDomainAtom(TNode atom);
+
+  /** The domain of term computed from the domains of its children. */
+  static WordDomain computeForward(TNode term,
+                                   const std::vector<WordDomain>& children);
+  /**
+   * The domain of child i of term computed from the domain of term and the
+   * domains of the other children.
+   */
+  static WordDomain computeBackward(TNode term,
+                                    unsigned i,
+                                    const WordDomain& domain,
+                                    const std::vector<WordDomain>& children);
+
+  /** The conjunction of the non-null reasons, null if there is none. */
+  static Node mkReason(std::vector<TNode>& reasons);
+
+  void registerAtom(TNode atom);
+  void registerTerm(TNode term);
+
+  /** The current domain of term. */
+  Entry getEntry(TNode term) const;
+
+  /**
+   * Intersect the domain of term with d, which follows from reasons. Returns
+   * false and sets d_conflict if the domain becomes empty.
+   */
+  bool update(TNode term, const WordDomain& d, std::vector<TNode>& reasons);
+
+  /** Restrict the domains of the sides of the asserted atom. */
+  bool assertAtom(TNode atom, TNode fact);
+  /** Recompute the domain of term from its children. */
+  bool propagateForward(TNode term);
+  /** Recompute the domains of the children of term. */
+  bool propagateBackward(TNode term);
+  /** Propagate the changes of the domains in d_queue. */
+  bool propagateQueue();
+  /** Propagate atom if its value follows from the domains of its sides. */
+  void propagateAtom(TNode atom);
+
+  /** The domains of the terms in the current context. */
+  EntryMap d_entries;
+  /** The domains of the registered terms that hold in every context. */
+  DomainMap d_static;
+  /** The registered terms each term is a child of. */
+  NodeListMap d_parents;
+  /** The registered atoms each term is a side of. */
+  NodeListMap d_atoms;
+  std::unordered_set<Node, NodeHashFunction> d_registeredAtoms;
+  /** The asserted atoms and the facts asserting them. */
+  NodeMap d_asserted;
+  /** The explanations of the propagated literals. */
+  NodeMap d_explanations;
+  /** The terms whose domains changed during the current check. */
+  std::vector<Node> d_queue;
+  /** The atoms with a side whose domain changed during the current check. */
+  std::unordered_set<Node, NodeHashFunction> d_candidates;
+  /** The conflict found by update(). */
+  Node d_conflict;
+
+  class Statistics
+  {
+   public:
+    IntStat d_numCallsToCheck;
+    IntStat d_numUpdates;
+    IntStat d_numConflicts;
+    IntStat d_numPropagations;
+    IntStat d_numBudgetOuts;
+    TimerStat d_solveTime;
+    Statistics();
+    ~Statistics();
+  };
+
+  Statistics d_statistics;
+}; /* class DomainSolver */
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__BV__BV_SUBTHEORY__DOMAIN_H */
@@ -0,0 +1,800 @@
+/*********************                                                        */
+/*! \file bv_word_domain.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Abstract domains of bit-vector values.
+ **
+ ** Abstract domains of bit-vector values.
+ **/
+
+#include "theory/bv/bv_word_domain.h"
+
+#include <algorithm>
+#include <ostream>
+
+#include "base/check.h"
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+namespace {
+
+/** The bits below position k. */
+BitVector lowMask(unsigned width, unsigned k)
+{
+  return BitVector(width, Integer(1).multiplyByPow2(k) - Integer(1));
+}
+
+BitVector signMask(unsigned width)
+{
+  return BitVector(width).setBit(width - 1);
+}
+
+const BitVector& umin(const BitVector& a, const BitVector& b)
+{
+  return b.unsignedLessThan(a) ? b : a;
+}
+
+const BitVector& umax(const BitVector& a, const BitVector& b)
+{
+  return a.unsignedLessThan(b) ? b : a;
+}
+
+const BitVector& smin(const BitVector& a, const BitVector& b)
+{
+  return b.signedLessThan(a) ? b : a;
+}
+
+const BitVector& smax(const BitVector& a, const BitVector& b)
+{
+  return a.signedLessThan(b) ? b : a;
+}
+
+/** The position of the highest bit of x, which must not be 0. */
+unsigned highestBit(const BitVector& x)
+{
+  Assert(x != BitVector(x.getSize()));
+  return x.getValue().length() - 1;
+}
+
+/** The bits above the highest bit in which a and b differ. */
+BitVector commonPrefix(const BitVector& a, const BitVector& b)
+{
+  if (a == b)
+  {
+    return BitVector::mkOnes(a.getSize());
+  }
+  return ~lowMask(a.getSize(), highestBit(a ^ b) + 1);
+}
+
+/**
+ * Compute in res the smallest value that is not smaller than lo (unsigned),
+ * has the bits of zeros cleared and the bits of ones set. Returns false if
+ * there is no such value.
+ */
+bool nextConsistent(const BitVector& lo,
+                    const BitVector& zeros,
+                    const BitVector& ones,
+                    BitVector& res)
+{
+  unsigned width = lo.getSize();
+  BitVector v = (lo | ones) & ~zeros;
+  if (v == lo)
+  {
+    res = v;
+    return true;
+  }
+  unsigned h = highestBit(v ^ lo);
+  if (v.isBitSet(h))
+  {
+    // bit h is a known 1 where lo has a 0, the bits below it are free
+    res = (v & ~lowMask(width, h)) | (ones & lowMask(width, h));
+    return true;
+  }
+  // bit h is a known 0 where lo has a 1, a free 0 above it must become 1
+  for (unsigned j = h + 1; j < width; ++j)
+  {
+    if (!v.isBitSet(j) && !zeros.isBitSet(j))
+    {
+      res = (v & ~lowMask(width, j)) | (ones & lowMask(width, j));
+      res = res.setBit(j);
+      return true;
+    }
+  }
+  return false;
+}
+
+/** The largest value not larger than hi, see nextConsistent(). */
+bool prevConsistent(const BitVector& hi,
+                    const BitVector& zeros,
+                    const BitVector& ones,
+                    BitVector& res)
+{
+  BitVector r;
+  if (!nextConsistent(~hi, ones, zeros, r))
+  {
+    return false;
+  }
+  res = ~r;
+  return true;
+}
+
+/** The value of bit i in d: 0, 1, or 2 if it is not known. */
+unsigned getBit(const WordDomain& d, unsigned i)
+{
+  return d.getOnes().isBitSet(i) ? 1 : (d.getZeros().isBitSet(i) ? 0 : 2);
+}
+
+/** The number of low bits of d that are known to be 0. */
+unsigned trailingZeros(const WordDomain& d)
+{
+  unsigned i = 0;
+  while (i < d.getWidth() && d.getZeros().isBitSet(i))
+  {
+    ++i;
+  }
+  return i;
+}
+
+/** The value of x capped at width, for shift amounts. */
+unsigned shiftAmount(const BitVector& x, unsigned width)
+{
+  return x.getValue() >= Integer(width) ? width
+                                        : x.getValue().getUnsignedInt();
+}
+
+WordDomain mkEmpty(unsigned width)
+{
+  WordDomain d(width);
+  d.setEmpty();
+  return d;
+}
+
+}  // namespace
+
+WordDomain::WordDomain() : d_empty(true) {}
+
+WordDomain::WordDomain(unsigned width)
+    : d_empty(false),
+      d_zeros(width),
+      d_ones(width),
+      d_ulo(width),
+      d_uhi(BitVector::mkOnes(width)),
+      d_slo(BitVector::mkMinSigned(width)),
+      d_shi(BitVector::mkMaxSigned(width))
+{
+}
+
+WordDomain::WordDomain(const BitVector& c)
+    : d_empty(false),
+      d_zeros(~c),
+      d_ones(c),
+      d_ulo(c),
+      d_uhi(c),
+      d_slo(c),
+      d_shi(c)
+{
+}
+
+WordDomain::WordDomain(const BitVector& zeros,
+                       const BitVector& ones,
+                       const BitVector& ulo,
+                       const BitVector& uhi,
+                       const BitVector& slo,
+                       const BitVector& shi)
+    : d_empty(false),
+      d_zeros(zeros),
+      d_ones(ones),
+      d_ulo(ulo),
+      d_uhi(uhi),
+      d_slo(slo),
+      d_shi(shi)
+{
+  normalize();
+}
+
+void WordDomain::normalize()
+{
+  unsigned width = getWidth();
+  BitVector zero(width);
+  BitVector sign = signMask(width);
+  bool changed = true;
+  while (changed && !d_empty)
+  {
+    WordDomain old = *this;
+    if ((d_zeros & d_ones) != zero)
+    {
+      d_empty = true;
+      return;
+    }
+    // tighten the intervals to the values that agree with the known bits
+    BitVector lo, hi;
+    if (!nextConsistent(d_ulo, d_zeros, d_ones, lo)
+        || !prevConsistent(d_uhi, d_zeros, d_ones, hi)
+        || hi.unsignedLessThan(lo))
+    {
+      d_empty = true;
+      return;
+    }
+    d_ulo = lo;
+    d_uhi = hi;
+    // the signed order is the unsigned order with the sign bit flipped
+    BitVector fzeros = (d_zeros & ~sign) | (d_ones & sign);
+    BitVector fones = (d_ones & ~sign) | (d_zeros & sign);
+    if (!nextConsistent(d_slo ^ sign, fzeros, fones, lo)
+        || !prevConsistent(d_shi ^ sign, fzeros, fones, hi)
+        || hi.unsignedLessThan(lo))
+    {
+      d_empty = true;
+      return;
+    }
+    d_slo = lo ^ sign;
+    d_shi = hi ^ sign;
+    if ((d_zeros | d_ones).isBitSet(width - 1))
+    {
+      // both intervals lie in the same half, where the two orders agree
+      lo = umax(d_ulo, d_slo);
+      hi = umin(d_uhi, d_shi);
+      if (hi.unsignedLessThan(lo))
+      {
+        d_empty = true;
+        return;
+      }
+      d_ulo = d_slo = lo;
+      d_uhi = d_shi = hi;
+    }
+    // all values of an interval share the common prefix of its bounds
+    BitVector prefix = commonPrefix(d_ulo, d_uhi);
+    d_zeros = d_zeros | (prefix & ~d_ulo);
+    d_ones = d_ones | (prefix & d_ulo);
+    prefix = commonPrefix(d_slo ^ sign, d_shi ^ sign);
+    d_zeros = d_zeros | (prefix & ~d_slo);
+    d_ones = d_ones | (prefix & d_slo);
+    changed = old != *this;
+  }
+}
+
+bool WordDomain::isTop() const
+{
+  unsigned width = getWidth();
+  return !d_empty && d_zeros == BitVector(width) && d_ones == BitVector(width)
+         && d_ulo == BitVector(width) && d_uhi == BitVector::mkOnes(width)
+         && d_slo == BitVector::mkMinSigned(width)
+         && d_shi == BitVector::mkMaxSigned(width);
+}
+
+bool WordDomain::contains(const BitVector& c) const
+{
+  return !d_empty && (c & d_zeros) == BitVector(getWidth())
+         && (c & d_ones) == d_ones && d_ulo.unsignedLessThanEq(c)
+         && c.unsignedLessThanEq(d_uhi) && d_slo.signedLessThanEq(c)
+         && c.signedLessThanEq(d_shi);
+}
+
+bool WordDomain::intersect(const WordDomain& d)
+{
+  if (d_empty)
+  {
+    return false;
+  }
+  if (d.d_empty)
+  {
+    d_empty = true;
+    return true;
+  }
+  Assert(getWidth() == d.getWidth());
+  WordDomain res(d_zeros | d.d_zeros,
+                 d_ones | d.d_ones,
+                 umax(d_ulo, d.d_ulo),
+                 umin(d_uhi, d.d_uhi),
+                 smax(d_slo, d.d_slo),
+                 smin(d_shi, d.d_shi));
+  if (res == *this)
+  {
+    return false;
+  }
+  *this = res;
+  return true;
+}
+
+bool WordDomain::restrictUnsigned(const BitVector& lo, const BitVector& hi)
+{
+  unsigned width = getWidth();
+  return intersect(WordDomain(BitVector(width),
+                              BitVector(width),
+                              lo,
+                              hi,
+                              BitVector::mkMinSigned(width),
+                              BitVector::mkMaxSigned(width)));
+}
+
+bool WordDomain::restrictSigned(const BitVector& lo, const BitVector& hi)
+{
+  unsigned width = getWidth();
+  return intersect(WordDomain(BitVector(width),
+                              BitVector(width),
+                              BitVector(width),
+                              BitVector::mkOnes(width),
+                              lo,
+                              hi));
+}
+
+bool WordDomain::restrictBits(const BitVector& zeros, const BitVector& ones)
+{
+  unsigned width = getWidth();
+  return intersect(WordDomain(zeros,
+                              ones,
+                              BitVector(width),
+                              BitVector::mkOnes(width),
+                              BitVector::mkMinSigned(width),
+                              BitVector::mkMaxSigned(width)));
+}
+
+bool WordDomain::exclude(const BitVector& c)
+{
+  if (!contains(c))
+  {
+    return false;
+  }
+  if (isFixed())
+  {
+    d_empty = true;
+    return true;
+  }
+  BitVector one(getWidth(), 1u);
+  BitVector ulo = d_ulo, uhi = d_uhi, slo = d_slo, shi = d_shi;
+  // the domain is not fixed, so neither interval is a single value
+  if (c == ulo)
+  {
+    ulo = ulo + one;
+  }
+  else if (c == uhi)
+  {
+    uhi = uhi - one;
+  }
+  if (c == slo)
+  {
+    slo = slo + one;
+  }
+  else if (c == shi)
+  {
+    shi = shi - one;
+  }
+  return intersect(WordDomain(d_zeros, d_ones, ulo, uhi, slo, shi));
+}
+
+bool WordDomain::isDisjoint(const WordDomain& d) const
+{
+  WordDomain both = *this;
+  both.intersect(d);
+  return both.isEmpty();
+}
+
+bool WordDomain::operator==(const WordDomain& d) const
+{
+  if (d_empty || d.d_empty)
+  {
+    return d_empty == d.d_empty && getWidth() == d.getWidth();
+  }
+  return d_zeros == d.d_zeros && d_ones == d.d_ones && d_ulo == d.d_ulo
+         && d_uhi == d.d_uhi && d_slo == d.d_slo && d_shi == d.d_shi;
+}
+
+WordDomain WordDomain::mkNot(const WordDomain& a)
+{
+  if (a.d_empty)
+  {
+    return a;
+  }
+  // ~x = -x - 1 reverses both orders
+  return WordDomain(a.d_ones, a.d_zeros, ~a.d_uhi, ~a.d_ulo, ~a.d_shi, ~a.d_slo);
+}
+
+WordDomain WordDomain::mkAnd(const WordDomain& a, const WordDomain& b)
+{
+  unsigned width = a.getWidth();
+  if (a.d_empty || b.d_empty)
+  {
+    return mkEmpty(width);
+  }
+  return WordDomain(a.d_zeros | b.d_zeros,
+                    a.d_ones & b.d_ones,
+                    BitVector(width),
+                    umin(a.d_uhi, b.d_uhi),
+                    BitVector::mkMinSigned(width),
+                    BitVector::mkMaxSigned(width));
+}
+
+WordDomain WordDomain::mkOr(const WordDomain& a, const WordDomain& b)
+{
+  unsigned width = a.getWidth();
+  if (a.d_empty || b.d_empty)
+  {
+    return mkEmpty(width);
+  }
+  return WordDomain(a.d_zeros & b.d_zeros,
+                    a.d_ones | b.d_ones,
+                    umax(a.d_ulo, b.d_ulo),
+                    BitVector::mkOnes(width),
+                    BitVector::mkMinSigned(width),
+                    BitVector::mkMaxSigned(width));
+}
+
+WordDomain WordDomain::mkXor(const WordDomain& a, const WordDomain& b)
+{
+  unsigned width = a.getWidth();
+  if (a.d_empty || b.d_empty)
+  {
+    return mkEmpty(width);
+  }
+  return WordDomain((a.d_zeros & b.d_zeros) | (a.d_ones & b.d_ones),
+                    (a.d_zeros & b.d_ones) | (a.d_ones & b.d_zeros),
+                    BitVector(width),
+                    BitVector::mkOnes(width),
+                    BitVector::mkMinSigned(width),
+                    BitVector::mkMaxSigned(width));
+}
+
+WordDomain WordDomain::mkPlus(const WordDomain& a, const WordDomain& b)
+{
+  unsigned width = a.getWidth();
+  if (a.d_empty || b.d_empty)
+  {
+    return mkEmpty(width);
+  }
+  if (a.isFixed() && b.isFixed())
+  {
+    return WordDomain(a.d_ulo + b.d_ulo);
+  }
+  // ripple the known bits through the adder
+  Integer zeros(0), ones(0);
+  unsigned carry = 0;
+  for (unsigned i = 0; i < width; ++i)
+  {
+    unsigned x = getBit(a, i), y = getBit(b, i);
+    if (x != 2 && y != 2 && carry != 2)
+    {
+      if ((x ^ y ^ carry) == 1)
+      {
+        ones = ones.setBit(i);
+      }
+      else
+      {
+        zeros = zeros.setBit(i);
+      }
+    }
+    unsigned numOnes = (x == 1) + (y == 1) + (carry == 1);
+    unsigned numZeros = (x == 0) + (y == 0) + (carry == 0);
+    carry = numOnes >= 2 ? 1 : (numZeros >= 2 ? 0 : 2);
+  }
+  // the bounds are sums if both or none of them overflow
+  Integer mod = Integer(1).multiplyByPow2(width);
+  Integer ulo = a.d_ulo.getValue() + b.d_ulo.getValue();
+  Integer uhi = a.d_uhi.getValue() + b.d_uhi.getValue();
+  if (uhi >= mod && ulo < mod)
+  {
+    ulo = Integer(0);
+    uhi = mod - Integer(1);
+  }
+  Integer half = Integer(1).multiplyByPow2(width - 1);
+  Integer slo = a.d_slo.toSignedInteger() + b.d_slo.toSignedInteger();
+  Integer shi = a.d_shi.toSignedInteger() + b.d_shi.toSignedInteger();
+  if ((slo < -half && shi >= -half) || (slo < half && shi >= half))
+  {
+    slo = -half;
+    shi = half - Integer(1);
+  }
+  return WordDomain(BitVector(width, zeros),
+                    BitVector(width, ones),
+                    BitVector(width, ulo),
+                    BitVector(width, uhi),
+                    BitVector(width, slo),
+                    BitVector(width, shi));
+}
+
+WordDomain WordDomain::mkNeg(const WordDomain& a)
+{
+  return mkPlus(mkNot(a), WordDomain(BitVector(a.getWidth(), 1u)));
+}
+
+WordDomain WordDomain::mkMult(const WordDomain& a, const WordDomain& b)
+{
+  unsigned width = a.getWidth();
+  if (a.d_empty || b.d_empty)
+  {
+    return mkEmpty(width);
+  }
+  if (a.isFixed() && b.isFixed())
+  {
+    return WordDomain(a.d_ulo * b.d_ulo);
+  }
+  unsigned tz = std::min(width, trailingZeros(a) + trailingZeros(b));
+  BitVector ones(width);
+  if (a.d_ones.isBitSet(0) && b.d_ones.isBitSet(0))
+  {
+    ones = ones.setBit(0);
+  }
+  BitVector ulo(width);
+  BitVector uhi = BitVector::mkOnes(width);
+  Integer hi = a.d_uhi.getValue() * b.d_uhi.getValue();
+  if (hi < Integer(1).multiplyByPow2(width))
+  {
+    ulo = BitVector(width, a.d_ulo.getValue() * b.d_ulo.getValue());
+    uhi = BitVector(width, hi);
+  }
+  return WordDomain(lowMask(width, tz),
+                    ones,
+                    ulo,
+                    uhi,
+                    BitVector::mkMinSigned(width),
+                    BitVector::mkMaxSigned(width));
+}
+
+WordDomain WordDomain::mkConcat(const WordDomain& hi, const WordDomain& lo)
+{
+  if (hi.d_empty || lo.d_empty)
+  {
+    return mkEmpty(hi.getWidth() + lo.getWidth());
+  }
+  // the signed value is the signed value of hi shifted plus the value of lo
+  return WordDomain(hi.d_zeros.concat(lo.d_zeros),
+                    hi.d_ones.concat(lo.d_ones),
+                    hi.d_ulo.concat(lo.d_ulo),
+                    hi.d_uhi.concat(lo.d_uhi),
+                    hi.d_slo.concat(lo.d_ulo),
+                    hi.d_shi.concat(lo.d_uhi));
+}
+
+WordDomain WordDomain::mkExtract(const WordDomain& a,
+                                 unsigned high,
+                                 unsigned low)
+{
+  unsigned width = a.getWidth();
+  unsigned rwidth = high - low + 1;
+  if (a.d_empty)
+  {
+    return mkEmpty(rwidth);
+  }
+  BitVector ulo(rwidth);
+  BitVector uhi = BitVector::mkOnes(rwidth);
+  BitVector slo = BitVector::mkMinSigned(rwidth);
+  BitVector shi = BitVector::mkMaxSigned(rwidth);
+  if (high + 1 == width)
+  {
+    // dropping low bits is monotone in both orders
+    ulo = a.d_ulo.extract(high, low);
+    uhi = a.d_uhi.extract(high, low);
+    slo = a.d_slo.extract(high, low);
+    shi = a.d_shi.extract(high, low);
+  }
+  else if (a.d_ulo.extract(width - 1, high + 1)
+           == a.d_uhi.extract(width - 1, high + 1))
+  {
+    // the dropped high bits are the same for all values
+    ulo = a.d_ulo.extract(high, low);
+    uhi = a.d_uhi.extract(high, low);
+  }
+  return WordDomain(a.d_zeros.extract(high, low),
+                    a.d_ones.extract(high, low),
+                    ulo,
+                    uhi,
+                    slo,
+                    shi);
+}
+
+WordDomain WordDomain::mkZeroExtend(const WordDomain& a, unsigned amount)
+{
+  if (amount == 0 || a.d_empty)
+  {
+    return amount == 0 ? a : mkEmpty(a.getWidth() + amount);
+  }
+  BitVector ulo = a.d_ulo.zeroExtend(amount);
+  BitVector uhi = a.d_uhi.zeroExtend(amount);
+  return WordDomain(BitVector::mkOnes(amount).concat(a.d_zeros),
+                    a.d_ones.zeroExtend(amount),
+                    ulo,
+                    uhi,
+                    ulo,
+                    uhi);
+}
+
+WordDomain WordDomain::mkSignExtend(const WordDomain& a, unsigned amount)
+{
+  if (amount == 0 || a.d_empty)
+  {
+    return amount == 0 ? a : mkEmpty(a.getWidth() + amount);
+  }
+  unsigned width = a.getWidth() + amount;
+  return WordDomain(a.d_zeros.signExtend(amount),
+                    a.d_ones.signExtend(amount),
+                    BitVector(width),
+                    BitVector::mkOnes(width),
+                    a.d_slo.signExtend(amount),
+                    a.d_shi.signExtend(amount));
+}
+
+WordDomain WordDomain::mkShl(const WordDomain& a, const WordDomain& b)
+{
+  unsigned width = a.getWidth();
+  if (a.d_empty || b.d_empty)
+  {
+    return mkEmpty(width);
+  }
+  BitVector ulo(width);
+  BitVector uhi = BitVector::mkOnes(width);
+  if (!b.isFixed())
+  {
+    // at least the smallest shift amount of low bits are 0
+    unsigned tz =
+        std::min(width, trailingZeros(a) + shiftAmount(b.d_ulo, width));
+    return WordDomain(lowMask(width, tz),
+                      BitVector(width),
+                      ulo,
+                      uhi,
+                      BitVector::mkMinSigned(width),
+                      BitVector::mkMaxSigned(width));
+  }
+  unsigned s = shiftAmount(b.d_ulo, width);
+  if (s == width)
+  {
+    return WordDomain(BitVector(width));
+  }
+  Integer hi = a.d_uhi.getValue().multiplyByPow2(s);
+  if (hi < Integer(1).multiplyByPow2(width))
+  {
+    ulo = BitVector(width, a.d_ulo.getValue().multiplyByPow2(s));
+    uhi = BitVector(width, hi);
+  }
+  return WordDomain(
+      BitVector(width, a.d_zeros.getValue().multiplyByPow2(s))
+          | lowMask(width, s),
+      BitVector(width, a.d_ones.getValue().multiplyByPow2(s)),
+      ulo,
+      uhi,
+      BitVector::mkMinSigned(width),
+      BitVector::mkMaxSigned(width));
+}
+
+WordDomain WordDomain::mkLshr(const WordDomain& a, const WordDomain& b)
+{
+  unsigned width = a.getWidth();
+  if (a.d_empty || b.d_empty)
+  {
+    return mkEmpty(width);
+  }
+  unsigned minShift = shiftAmount(b.d_ulo, width);
+  unsigned maxShift = shiftAmount(b.d_uhi, width);
+  // shifting right further makes the value smaller
+  BitVector ulo(width, a.d_ulo.getValue().divByPow2(maxShift));
+  BitVector uhi(width, a.d_uhi.getValue().divByPow2(minShift));
+  BitVector zeros = ~lowMask(width, width - minShift);
+  BitVector ones(width);
+  if (b.isFixed())
+  {
+    zeros = zeros | BitVector(width, a.d_zeros.getValue().divByPow2(minShift));
+    ones = BitVector(width, a.d_ones.getValue().divByPow2(minShift));
+  }
+  return WordDomain(zeros,
+                    ones,
+                    ulo,
+                    uhi,
+                    BitVector::mkMinSigned(width),
+                    BitVector::mkMaxSigned(width));
+}
+
+WordDomain WordDomain::mkAshr(const WordDomain& a, const WordDomain& b)
+{
+  unsigned width = a.getWidth();
+  if (a.d_empty || b.d_empty)
+  {
+    return mkEmpty(width);
+  }
+  BitVector sign = signMask(width);
+  if (!b.isFixed())
+  {
+    // the sign bit is kept
+    return WordDomain(a.d_zeros & sign,
+                      a.d_ones & sign,
+                      BitVector(width),
+                      BitVector::mkOnes(width),
+                      BitVector::mkMinSigned(width),
+                      BitVector::mkMaxSigned(width));
+  }
+  // shifting by more than width - 1 bits leaves only copies of the sign bit
+  BitVector s(width, std::min(shiftAmount(b.d_ulo, width), width - 1));
+  return WordDomain(a.d_zeros.arithRightShift(s),
+                    a.d_ones.arithRightShift(s),
+                    BitVector(width),
+                    BitVector::mkOnes(width),
+                    a.d_slo.arithRightShift(s),
+                    a.d_shi.arithRightShift(s));
+}
+
+WordDomain WordDomain::mkUdiv(const WordDomain& a, const WordDomain& b)
+{
+  unsigned width = a.getWidth();
+  if (a.d_empty || b.d_empty)
+  {
+    return mkEmpty(width);
+  }
+  BitVector zero(width);
+  if (b.d_ulo == zero)
+  {
+    return b.isFixed() ? WordDomain(BitVector::mkOnes(width))
+                       : WordDomain(width);
+  }
+  return WordDomain(zero,
+                    zero,
+                    a.d_ulo.unsignedDivTotal(b.d_uhi),
+                    a.d_uhi.unsignedDivTotal(b.d_ulo),
+                    BitVector::mkMinSigned(width),
+                    BitVector::mkMaxSigned(width));
+}
+
+WordDomain WordDomain::mkUrem(const WordDomain& a, const WordDomain& b)
+{
+  unsigned width = a.getWidth();
+  if (a.d_empty || b.d_empty)
+  {
+    return mkEmpty(width);
+  }
+  if (a.d_uhi.unsignedLessThan(b.d_ulo))
+  {
+    return a;
+  }
+  // the remainder is not larger than the dividend, also if b is 0
+  BitVector zero(width);
+  BitVector uhi = a.d_uhi;
+  if (b.d_ulo != zero)
+  {
+    uhi = umin(uhi, b.d_uhi - BitVector(width, 1u));
+  }
+  return WordDomain(zero,
+                    zero,
+                    zero,
+                    uhi,
+                    BitVector::mkMinSigned(width),
+                    BitVector::mkMaxSigned(width));
+}
+
+WordDomain WordDomain::mkHull(const WordDomain& a, const WordDomain& b)
+{
+  if (a.d_empty || b.d_empty)
+  {
+    return a.d_empty ? b : a;
+  }
+  return WordDomain(a.d_zeros & b.d_zeros,
+                    a.d_ones & b.d_ones,
+                    umin(a.d_ulo, b.d_ulo),
+                    umax(a.d_uhi, b.d_uhi),
+                    smin(a.d_slo, b.d_slo),
+                    smax(a.d_shi, b.d_shi));
+}
+
+std::ostream& operator<<(std::ostream& out, const WordDomain& d)
+{
+  if (d.isEmpty())
+  {
+    return out << "{}";
+  }
+  for (unsigned i = d.getWidth(); i > 0; --i)
+  {
+    out << (d.getOnes().isBitSet(i - 1)
+                ? '1'
+                : (d.getZeros().isBitSet(i - 1) ? '0' : 'x'));
+  }
+  return out << " u[" << d.getUnsignedLower().getValue() << ", "
+             << d.getUnsignedUpper().getValue() << "] s["
+             << d.getSignedLower().toSignedInteger() << ", "
+             << d.getSignedUpper().toSignedInteger() << "]";
+}
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
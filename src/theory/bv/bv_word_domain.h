@@ -0,0 +1,132 @@
+/*********************                                                        */
+/*! \file bv_word_domain.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Abstract domains of bit-vector values.
+ **
+ ** A WordDomain over-approximates the values a bit-vector term can take by
+ ** its known bits, an unsigned interval and a signed interval. The three
+ ** parts are kept consistent with each other: the bounds of the intervals
+ ** agree with the known bits, and the common prefix of the bounds of an
+ ** interval is known. The transfer functions compute the domain of an
+ ** operator application from the domains of its arguments.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__BV__BV_WORD_DOMAIN_H
+#define CVC4__THEORY__BV__BV_WORD_DOMAIN_H
+
+#include <iosfwd>
+
+#include "util/bitvector.h"
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+class WordDomain
+{
+ public:
+  /** An empty domain of width 0, only used as a placeholder. */
+  WordDomain();
+  /** The domain of all values of the given width. */
+  explicit WordDomain(unsigned width);
+  /** The domain containing only c. */
+  explicit WordDomain(const BitVector& c);
+
+  unsigned getWidth() const { return d_zeros.getSize(); }
+  bool isEmpty() const { return d_empty; }
+  /** Whether the domain contains exactly one value. */
+  bool isFixed() const { return !d_empty && d_ulo == d_uhi; }
+  /** Whether nothing is known about the values. */
+  bool isTop() const;
+  bool contains(const BitVector& c) const;
+
+  /** The bits known to be 0. */
+  const BitVector& getZeros() const { return d_zeros; }
+  /** The bits known to be 1. */
+  const BitVector& getOnes() const { return d_ones; }
+  const BitVector& getUnsignedLower() const { return d_ulo; }
+  const BitVector& getUnsignedUpper() const { return d_uhi; }
+  const BitVector& getSignedLower() const { return d_slo; }
+  const BitVector& getSignedUpper() const { return d_shi; }
+
+  /** Intersect with d, returns true if this domain changed. */
+  bool intersect(const WordDomain& d);
+  /** Keep the values in the unsigned interval [lo, hi]. */
+  bool restrictUnsigned(const BitVector& lo, const BitVector& hi);
+  /** Keep the values in the signed interval [lo, hi]. */
+  bool restrictSigned(const BitVector& lo, const BitVector& hi);
+  /** Keep the values whose bits in zeros are 0 and whose bits in ones are 1. */
+  bool restrictBits(const BitVector& zeros, const BitVector& ones);
+  /** Remove c, which has an effect only if c is a bound of an interval. */
+  bool exclude(const BitVector& c);
+  void setEmpty() { d_empty = true; }
+
+  /** Whether no value is in both this domain and d. */
+  bool isDisjoint(const WordDomain& d) const;
+
+  bool operator==(const WordDomain& d) const;
+  bool operator!=(const WordDomain& d) const { return !(*this == d); }
+
+  static WordDomain mkNot(const WordDomain& a);
+  static WordDomain mkAnd(const WordDomain& a, const WordDomain& b);
+  static WordDomain mkOr(const WordDomain& a, const WordDomain& b);
+  static WordDomain mkXor(const WordDomain& a, const WordDomain& b);
+  static WordDomain mkPlus(const WordDomain& a, const WordDomain& b);
+  static WordDomain mkNeg(const WordDomain& a);
+  static WordDomain mkMult(const WordDomain& a, const WordDomain& b);
+  /** The domain of (concat hi lo). */
+  static WordDomain mkConcat(const WordDomain& hi, const WordDomain& lo);
+  static WordDomain mkExtract(const WordDomain& a,
+                              unsigned high,
+                              unsigned low);
+  static WordDomain mkZeroExtend(const WordDomain& a, unsigned amount);
+  static WordDomain mkSignExtend(const WordDomain& a, unsigned amount);
+  static WordDomain mkShl(const WordDomain& a, const WordDomain& b);
+  static WordDomain mkLshr(const WordDomain& a, const WordDomain& b);
+  static WordDomain mkAshr(const WordDomain& a, const WordDomain& b);
+  /** The domain of bvudiv with x / 0 = ~0. */
+  static WordDomain mkUdiv(const WordDomain& a, const WordDomain& b);
+  /** The domain of bvurem with x % 0 = x. */
+  static WordDomain mkUrem(const WordDomain& a, const WordDomain& b);
+  /** The smallest domain containing the values of a and b. */
+  static WordDomain mkHull(const WordDomain& a, const WordDomain& b);
+
+ private:
+  /** Build a domain from its parts and normalize it. */
+  WordDomain(const BitVector& zeros,
+             const BitVector& ones,
+             const BitVector& ulo,
+             const BitVector& uhi,
+             const BitVector& slo,
+             const BitVector& shi);
+
+  /**
+   * Make the parts consistent with each other, or mark the domain as empty if
+   * they contradict each other.
+   */
+  void normalize();
+
+  bool d_empty;
+  BitVector d_zeros;
+  BitVector d_ones;
+  BitVector d_ulo;
+  BitVector d_uhi;
+  BitVector d_slo;
+  BitVector d_shi;
+}; /* class WordDomain */
+
+std::ostream& operator<<(std::ostream& out, const WordDomain& d);
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__BV__BV_WORD_DOMAIN_H */
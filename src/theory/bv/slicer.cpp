@@ -35,15 +35,12 @@ void intersect(const std::vector<TermId>& v1,
                const std::vector<TermId>& v2,
                std::vector<TermId>& intersection)
 {
+  TermSet s2(v2.begin(), v2.end());
   for (const TermId id1 : v1)
   {
-    for (const TermId id2 : v2)
+    if (s2.find(id1) != s2.end())
     {
-      if (id2 == id1)
-      {
-        intersection.push_back(id1);
-        break;
-      }
+      intersection.push_back(id1);
     }
   }
 }
@@ -93,6 +90,28 @@ bool Base::isCutPoint (Index index) const
   return (bit_mask & d_repr[vector_index]) != 0;
 }
 
+Index Base::nextCutPoint(Index index) const
+{
+  Index i = index + 1;
+  while (i < d_size)
+  {
+    Index vector_index = i / 32;
+    uint32_t word = d_repr[vector_index] >> (i % 32);
+    if (word != 0)
+    {
+      while ((word & 1u) == 0)
+      {
+        word = word >> 1;
+        ++i;
+      }
+      // the end of the bv may be marked in the last word
+      return i < d_size ? i : d_size;
+    }
+    i = (vector_index + 1) * 32;
+  }
+  return d_size;
+}
+
 void Base::diffCutPoints(const Base& other, Base& res) const {
   Assert(d_size == other.d_size && res.d_size == d_size);
   for (unsigned i = 0; i < d_repr.size(); ++i) {
@@ -192,7 +211,6 @@ TermId UnionFind::addTerm(Index bitwidth) {
   ++(d_statistics.d_numNodes);
   
   TermId id = d_nodes.size() - 1; 
-  d_representatives.insert(id);
   ++(d_statistics.d_numRepresentatives); 
 
   Debug("bv-slicer-uf") << "UnionFind::addTerm " << id << " size " << bitwidth << endl;
@@ -241,18 +259,21 @@ void UnionFind::merge(TermId t1, TermId t2) {
 
   Assert(!hasChildren(t1) && !hasChildren(t2));
   setRepr(t1, t2); 
-  d_representatives.erase(t1);
   d_statistics.d_numRepresentatives += -1; 
 }
 
 TermId UnionFind::find(TermId id) {
-  TermId repr = getRepr(id); 
-  if (repr != UndefinedId) {
-    TermId find_id =  find(repr);
-    setRepr(id, find_id);
-    return find_id; 
+  TermId repr = id;
+  while (getRepr(repr) != UndefinedId) {
+    repr = getRepr(repr);
   }
-  return id; 
+  // compress the path
+  while (id != repr) {
+    TermId next = getRepr(id);
+    setRepr(id, repr);
+    id = next;
+  }
+  return repr; 
 }
 /** 
  * Splits the representative of the term between i-1 and i
@@ -420,26 +441,33 @@ void UnionFind::alignSlicings(const ExtractTerm& term1, const ExtractTerm& term2
     getNormalForm(term2, nf2); 
 
     // align the cuts points of the two slicings
-    // FIXME: this can be done more efficiently
     cuts.sliceWith(nf1.base);
     cuts.sliceWith(nf2.base); 
 
-    for (unsigned i = 0; i < cuts.getBitwidth(); ++i) {
-      if (cuts.isCutPoint(i)) {
-        if (!nf1.base.isCutPoint(i)) {
-          pair<TermId, Index> pair1 = nf1.getTerm(i, *this);
-          split(pair1.first, i - pair1.second);
-          changed = true; 
-        }
-        if (!nf2.base.isCutPoint(i)) {
-          pair<TermId, Index> pair2 = nf2.getTerm(i, *this);
-          split(pair2.first, i - pair2.second);
-          changed = true; 
-        }
-      }
-    }
+    splitAtCuts(nf1, cuts, changed);
+    splitAtCuts(nf2, cuts, changed);
   } while (changed); 
 }
+
+void UnionFind::splitAtCuts(const NormalForm& nf, const Base& cuts, bool& changed) {
+  // walk the cut points and the slices of the normal form together
+  Index start = 0;
+  unsigned k = 0;
+  for (Index i = cuts.nextCutPoint(0); i < cuts.getBitwidth();
+       i = cuts.nextCutPoint(i)) {
+    if (nf.base.isCutPoint(i)) {
+      continue;
+    }
+    while (start + getBitwidth(nf.decomp[k]) <= i) {
+      start += getBitwidth(nf.decomp[k]);
+      ++k;
+    }
+    Assert(k < nf.decomp.size());
+    // the slice may have been split since nf was computed, split descends
+    split(nf.decomp[k], i - start);
+    changed = true;
+  }
+}
 /** 
  * Given an extract term a[i:j] makes sure a is sliced
  * at indices i and j. 
@@ -466,12 +494,15 @@ ExtractTerm Slicer::registerTerm(TNode node) {
     high = utils::getExtractHigh(node);
     low = utils::getExtractLow(node); 
   }
-  if (d_nodeToId.find(n) == d_nodeToId.end()) {
-    TermId id = d_unionFind.addTerm(utils::getSize(n)); 
+  std::unordered_map<Node, TermId, NodeHashFunction>::const_iterator it =
+      d_nodeToId.find(n);
+  TermId id;
+  if (it == d_nodeToId.end()) {
+    id = d_unionFind.addTerm(utils::getSize(n)); 
     d_nodeToId[n] = id;
-    d_idToNode[id] = n; 
+  } else {
+    id = it->second;
   }
-  TermId id = d_nodeToId[n];
   ExtractTerm res(id, high, low); 
   Debug("bv-slicer") << "Slicer::registerTerm " << node << " => " << res.debugPrint() << endl;
   return res; 
@@ -507,8 +538,10 @@ void Slicer::getBaseDecomposition(TNode node, std::vector<Node>& decomp) {
     low = utils::getExtractLow(node);
     top = node[0]; 
   }
-  AlwaysAssert(d_nodeToId.find(top) != d_nodeToId.end());
-  TermId id = d_nodeToId[top];
+  std::unordered_map<Node, TermId, NodeHashFunction>::const_iterator it =
+      d_nodeToId.find(top);
+  AlwaysAssert(it != d_nodeToId.end());
+  TermId id = it->second;
   NormalForm nf(high-low+1); 
   d_unionFind.getNormalForm(ExtractTerm(id, high, low), nf);
   
@@ -55,6 +55,11 @@ public:
   void sliceAt(Index index); 
   void sliceWith(const Base& other);
   bool isCutPoint(Index index) const;
+  /**
+   * Returns the smallest cut point greater than index, or the bitwidth if
+   * there is none. Skips the words without cut points.
+   */
+  Index nextCutPoint(Index index) const;
   void diffCutPoints(const Base& other, Base& res) const;
   bool isEmpty() const;
   std::string debugPrint() const;
@@ -155,11 +160,14 @@ class UnionFind {
   
   /// map from TermId to the nodes that represent them 
   std::vector<Node> d_nodes;
-  /// a term is in this set if it is its own representative
-  TermSet d_representatives;
   
   void getDecomposition(const ExtractTerm& term, Decomposition& decomp);
   void handleCommonSlice(const Decomposition& d1, const Decomposition& d2, TermId common);
+  /**
+   * Splits the slices of nf at the cut points of cuts that are not cut points
+   * of nf, and sets changed to true if there are any.
+   */
+  void splitAtCuts(const NormalForm& nf, const Base& cuts, bool& changed);
   /// getter methods for the internal nodes
   TermId getRepr(TermId id)  const {
     Assert(id < d_nodes.size());
@@ -205,8 +213,7 @@ class UnionFind {
   
 public:
   UnionFind()
-    : d_nodes(),
-      d_representatives()
+    : d_nodes()
   {}
 
   TermId addTerm(Index bitwidth);
@@ -226,16 +233,21 @@ public:
   friend class Slicer; 
 };
 
+/**
+ * The slicer only ever refines the slicing of the terms, and every slicing of
+ * a term is a valid decomposition of it, hence it needs no backtracking: the
+ * equalities of all contexts can be processed, in any order, including after
+ * the first check. It keeps references to the terms, which may outlive the
+ * user context that created them.
+ */
 class Slicer {
-  std::unordered_map<TermId, TNode> d_idToNode;
-  std::unordered_map<TNode, TermId, TNodeHashFunction> d_nodeToId;
-  std::unordered_map<TNode, bool, TNodeHashFunction> d_coreTermCache;
+  std::unordered_map<Node, TermId, NodeHashFunction> d_nodeToId;
+  std::unordered_map<Node, bool, NodeHashFunction> d_coreTermCache;
   UnionFind d_unionFind;
   ExtractTerm registerTerm(TNode node); 
 public:
   Slicer()
-    : d_idToNode(),
-      d_nodeToId(),
+    : d_nodeToId(),
       d_coreTermCache(),
       d_unionFind()
   {}
@@ -22,10 +22,12 @@
 #include "proof/theory_proof.h"
 #include "smt/smt_statistics_registry.h"
 #include "theory/bv/abstraction.h"
+#include "theory/bv/bitblast/lazy_bitblaster.h"
 #include "theory/bv/bv_eager_solver.h"
 #include "theory/bv/bv_subtheory_algebraic.h"
 #include "theory/bv/bv_subtheory_bitblast.h"
 #include "theory/bv/bv_subtheory_core.h"
+#include "theory/bv/bv_subtheory_domain.h"
 #include "theory/bv/bv_subtheory_inequality.h"
 #include "theory/bv/slicer.h"
 #include "theory/bv/theory_bv_rewrite_rules_normalization.h"
@@ -68,6 +70,9 @@ TheoryBV::TheoryBV(context::Context* c,
       d_propagatedBy(c),
       d_eagerSolver(),
       d_abstractionModule(new AbstractionModule(getStatsPrefix(THEORY_BV))),
+      d_bbTermCache(options::bitvectorShareBitblastTerms()
+                        ? new LazyBitblastTermCache()
+                        : nullptr),
       d_isCoreTheory(false),
       d_calledPreregister(false),
       d_needsLastCallCheck(false),
@@ -95,6 +100,12 @@ TheoryBV::TheoryBV(context::Context* c,
     d_subtheoryMap[SUB_INEQUALITY] = d_subtheories.back().get();
   }
 
+  if (options::bitvectorDomainSolver() && !options::proof())
+  {
+    d_subtheories.emplace_back(new DomainSolver(c, this));
+    d_subtheoryMap[SUB_DOMAIN] = d_subtheories.back().get();
+  }
+
   if (options::bitvectorAlgebraicSolver() && !options::proof())
   {
     d_subtheories.emplace_back(new AlgebraicSolver(c, this));
@@ -122,9 +133,9 @@ void TheoryBV::setMasterEqualityEngine(eq::EqualityEngine* eq) {
   }
 }
 
-void TheoryBV::spendResource(unsigned amount)
+void TheoryBV::spendResource(ResourceManager::Resource r, unsigned amount)
 {
-  getOutputChannel().spendResource(amount);
+  getOutputChannel().spendResource(r, amount);
 }
 
 TheoryBV::Statistics::Statistics():
@@ -134,7 +145,8 @@ TheoryBV::Statistics::Statistics():
   d_numCallsToCheckFullEffort("theory::bv::NumFullCheckCalls", 0),
   d_numCallsToCheckStandardEffort("theory::bv::NumStandardCheckCalls", 0),
   d_weightComputationTimer("theory::bv::weightComputationTimer"),
-  d_numMultSlice("theory::bv::NumMultSliceApplied", 0)
+  d_numMultSlice("theory::bv::NumMultSliceApplied", 0),
+  d_rewriteRules("theory::bv::rewriteRules")
 {
   smtStatisticsRegistry()->registerStat(&d_avgConflictSize);
   smtStatisticsRegistry()->registerStat(&d_solveSubstitutions);
@@ -143,6 +155,11 @@ TheoryBV::Statistics::Statistics():
   smtStatisticsRegistry()->registerStat(&d_numCallsToCheckStandardEffort);
   smtStatisticsRegistry()->registerStat(&d_weightComputationTimer);
   smtStatisticsRegistry()->registerStat(&d_numMultSlice);
+  RewriteRuleStatistics::reset(options::bvRewriteRuleStats());
+  if (options::bvRewriteRuleStats())
+  {
+    smtStatisticsRegistry()->registerStat(&d_rewriteRules);
+  }
 }
 
 TheoryBV::Statistics::~Statistics() {
@@ -153,6 +170,10 @@ TheoryBV::Statistics::~Statistics() {
   smtStatisticsRegistry()->unregisterStat(&d_numCallsToCheckStandardEffort);
   smtStatisticsRegistry()->unregisterStat(&d_weightComputationTimer);
   smtStatisticsRegistry()->unregisterStat(&d_numMultSlice);
+  if (options::bvRewriteRuleStats())
+  {
+    smtStatisticsRegistry()->unregisterStat(&d_rewriteRules);
+  }
 }
 
 Node TheoryBV::getBVDivByZero(Kind k, unsigned width) {
@@ -828,7 +849,7 @@ void TheoryBV::presolve() {
   Debug("bitvector") << "TheoryBV::presolve" << endl;
 }
 
-static int prop_count = 0;
+static thread_local int prop_count = 0;
 
 bool TheoryBV::storePropagation(TNode literal, SubTheory subtheory)
 {
@@ -928,6 +949,10 @@ EqualityStatus TheoryBV::getEqualityStatus(TNode a, TNode b)
 
 
 void TheoryBV::enableCoreTheorySlicer() {
+  if (d_isCoreTheory) {
+    // already enabled by a previous check-sat
+    return;
+  }
   Assert(!d_calledPreregister);
   d_isCoreTheory = true;
   if (d_subtheoryMap.find(SUB_CORE) != d_subtheoryMap.end()) {
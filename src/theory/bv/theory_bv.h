@@ -26,6 +26,7 @@
 #include "context/cdlist.h"
 #include "context/context.h"
 #include "theory/bv/bv_subtheory.h"
+#include "theory/bv/theory_bv_rewriter.h"
 #include "theory/bv/theory_bv_utils.h"
 #include "theory/theory.h"
 #include "util/hash.h"
@@ -51,6 +52,7 @@ class BitblastSolver;
 class EagerBitblastSolver;
 
 class AbstractionModule;
+struct LazyBitblastTermCache;
 
 class TheoryBV : public Theory {
 
@@ -125,13 +127,15 @@ public:
     IntStat     d_numCallsToCheckStandardEffort;
     TimerStat   d_weightComputationTimer;
     IntStat     d_numMultSlice;
+    /** The statistics of the rewrite rules, if --bv-rewrite-rule-stats */
+    RewriteRuleStat d_rewriteRules;
     Statistics();
     ~Statistics();
   };
 
   Statistics d_statistics;
 
-  void spendResource(unsigned amount);
+  void spendResource(ResourceManager::Resource r, unsigned amount);
 
   /**
    * Return the uninterpreted function symbol corresponding to division-by-zero
@@ -182,6 +186,10 @@ public:
 
   std::unique_ptr<EagerBitblastSolver> d_eagerSolver;
   std::unique_ptr<AbstractionModule> d_abstractionModule;
+  /** The bits shared by the lazy bit-blasters, if --bv-share-bb-terms */
+  std::unique_ptr<LazyBitblastTermCache> d_bbTermCache;
+  /** Get the bits shared by the lazy bit-blasters, or null */
+  LazyBitblastTermCache* getBitblastTermCache() { return d_bbTermCache.get(); }
   bool d_isCoreTheory;
   bool d_calledPreregister;
   
@@ -264,6 +272,7 @@ public:
   friend class EqualitySolver;
   friend class CoreSolver;
   friend class InequalitySolver;
+  friend class DomainSolver;
   friend class AlgebraicSolver;
   friend class EagerBitblastSolver;
 };/* class TheoryBV */
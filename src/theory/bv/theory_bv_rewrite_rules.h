@@ -19,6 +19,9 @@
 
 #pragma once
 
+#include <stdint.h>
+
+#include <chrono>
 #include <sstream>
 
 #include "context/context.h"
@@ -193,6 +196,8 @@ enum RewriteRuleId
   ConcatToMult,
   IsPowerOfTwo,
   MultSltMult,
+  // not a rule, the number of rules
+  LastRewriteRule
 };
 
 inline std::ostream& operator << (std::ostream& out, RewriteRuleId ruleId) {
@@ -349,65 +354,73 @@ inline std::ostream& operator << (std::ostream& out, RewriteRuleId ruleId) {
   }
 };
 
+/**
+ * The number of tries and applications of each rewrite rule, and the time
+ * spent in them, if --bv-rewrite-rule-stats is on. The time of a rule
+ * includes the time of the rules it applies itself. Like the rewriter, the
+ * statistics are per thread, and they are reset when a bit-vector theory is
+ * created.
+ */
+class RewriteRuleStatistics
+{
+ public:
+  struct Counters
+  {
+    /** The number of calls to applies() */
+    uint64_t d_tries;
+    /** The number of calls to apply() */
+    uint64_t d_applications;
+    /** The time spent in applies() and apply() */
+    uint64_t d_nanoseconds;
+  };
+
+  /** Are the statistics recorded? */
+  static bool isEnabled() { return s_enabled; }
+  /** Enable or disable recording the statistics, and reset them */
+  static void reset(bool enabled);
+  /** Get the counters of the given rule */
+  static Counters& get(RewriteRuleId rule) { return s_counters[rule]; }
+
+ private:
+  static thread_local bool s_enabled;
+  static thread_local Counters s_counters[LastRewriteRule];
+}; /* class RewriteRuleStatistics */
+
 template <RewriteRuleId rule>
 class RewriteRule {
 
-  // class RuleStatistics {
-
-  //   /** The name of the rule prefixed with the prefix */
-  //   static std::string getStatName(const char* prefix) {
-  //     std::stringstream statName;
-  //     statName << prefix << rule;
-  //     return statName.str();
-  //   }
-
-  // public:
-
-  //   /** Number of applications of this rule */
-  //   IntStat d_ruleApplications;
-
-  //   /** Constructor */
-  //   RuleStatistics()
-  //   : d_ruleApplications(getStatName("theory::bv::RewriteRules::count"), 0) {
-  //     currentStatisticsRegistry()->registerStat(&d_ruleApplications);
-  //   }
-
-  //   /** Destructor */
-  //   ~RuleStatistics() {
-  //     StatisticsRegistry::unregisterStat(&d_ruleApplications);
-  //   }
-  // };
-
-  // /* Statistics about the rule */
-  // // NOTE: Cannot have static fields like this, or else you can't have
-  // // two SmtEngines in the process (the second-to-be-destroyed will
-  // // have a dangling pointer and segfault).  If this statistic is needed,
-  // // fix the rewriter by making it an instance per-SmtEngine (instead of
-  // // static).
-  // static RuleStatistics* s_statistics;
-
   /** Actually apply the rewrite rule */
   static inline Node apply(TNode node) {
     Unreachable();
     SuppressWrongNoReturnWarning;
   }
 
-public:
-
-  RewriteRule() {
-    
-    // if (s_statistics == NULL) {
-    //   s_statistics = new RuleStatistics();
-    // }
-    
+  /** Run the rule, and record its statistics */
+  static Node runWithStatistics(TNode node)
+  {
+    if (rule == EmptyRule)
+    {
+      return node;
+    }
+    RewriteRuleStatistics::Counters& counters =
+        RewriteRuleStatistics::get(rule);
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    ++counters.d_tries;
+    Node result = node;
+    if (applies(node))
+    {
+      ++counters.d_applications;
+      result = run<false>(node);
+    }
+    counters.d_nanoseconds +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+    return result;
   }
 
-  ~RewriteRule() {
-    
-    // delete s_statistics;
-    // s_statistics = NULL;
-    
-  }
+public:
 
   static inline bool applies(TNode node)
   {
@@ -417,10 +430,13 @@ public:
 
   template<bool checkApplies>
   static inline Node run(TNode node) {
+    if (checkApplies && RewriteRuleStatistics::isEnabled())
+    {
+      return runWithStatistics(node);
+    }
     if (!checkApplies || applies(node)) {
       Debug("theory::bv::rewrite") << "RewriteRule<" << rule << ">(" << node << ")" << std::endl;
       Assert(checkApplies || applies(node));
-      //++ s_statistics->d_ruleApplications;
       Node result = apply(node);
       if (result != node) {
         if(Dump.isOn("bv-rewrites")) {
@@ -442,11 +458,6 @@ public:
   }
 };
 
-
- // template<RewriteRuleId rule>
- //   typename RewriteRule<rule>::RuleStatistics* RewriteRule<rule>::s_statistics = NULL;
-
-
 /** Have to list all the rewrite rules to get the statistics out */
 struct AllRewriteRules {
   RewriteRule<EmptyRule>                      rule00;
@@ -628,6 +639,29 @@ struct ApplyRuleToChildren {
   }
 };
 
+/**
+ * Apply the rule R to current if it applies. Returns true if current was
+ * rewritten to a constant, to which no rule applies, so that the strategies
+ * can stop early.
+ */
+template <class R>
+inline bool tryRule(Node& current)
+{
+  if (RewriteRuleStatistics::isEnabled())
+  {
+    current = R::template run<true>(current);
+  }
+  else if (R::applies(current))
+  {
+    current = R::template run<false>(current);
+  }
+  else
+  {
+    return false;
+  }
+  return current.isConst();
+}
+
 template <
   typename R1,
   typename R2  = RewriteRule<EmptyRule>,
@@ -653,26 +687,26 @@ template <
 struct LinearRewriteStrategy {
   static Node apply(TNode node) {
     Node current = node;
-    if (R1::applies(current)) current  = R1::template run<false>(current);
-    if (R2::applies(current)) current  = R2::template run<false>(current);
-    if (R3::applies(current)) current  = R3::template run<false>(current);
-    if (R4::applies(current)) current  = R4::template run<false>(current);
-    if (R5::applies(current)) current  = R5::template run<false>(current);
-    if (R6::applies(current)) current  = R6::template run<false>(current);
-    if (R7::applies(current)) current  = R7::template run<false>(current);
-    if (R8::applies(current)) current  = R8::template run<false>(current);
-    if (R9::applies(current)) current  = R9::template run<false>(current);
-    if (R10::applies(current)) current = R10::template run<false>(current);
-    if (R11::applies(current)) current = R11::template run<false>(current);
-    if (R12::applies(current)) current = R12::template run<false>(current);
-    if (R13::applies(current)) current = R13::template run<false>(current);
-    if (R14::applies(current)) current = R14::template run<false>(current);
-    if (R15::applies(current)) current = R15::template run<false>(current);
-    if (R16::applies(current)) current = R16::template run<false>(current);
-    if (R17::applies(current)) current = R17::template run<false>(current);
-    if (R18::applies(current)) current = R18::template run<false>(current);
-    if (R19::applies(current)) current = R19::template run<false>(current);
-    if (R20::applies(current)) current = R20::template run<false>(current);
+    if (tryRule<R1>(current)) return current;
+    if (tryRule<R2>(current)) return current;
+    if (tryRule<R3>(current)) return current;
+    if (tryRule<R4>(current)) return current;
+    if (tryRule<R5>(current)) return current;
+    if (tryRule<R6>(current)) return current;
+    if (tryRule<R7>(current)) return current;
+    if (tryRule<R8>(current)) return current;
+    if (tryRule<R9>(current)) return current;
+    if (tryRule<R10>(current)) return current;
+    if (tryRule<R11>(current)) return current;
+    if (tryRule<R12>(current)) return current;
+    if (tryRule<R13>(current)) return current;
+    if (tryRule<R14>(current)) return current;
+    if (tryRule<R15>(current)) return current;
+    if (tryRule<R16>(current)) return current;
+    if (tryRule<R17>(current)) return current;
+    if (tryRule<R18>(current)) return current;
+    if (tryRule<R19>(current)) return current;
+    if (tryRule<R20>(current)) return current;
     return current;
   }
 };
@@ -705,26 +739,26 @@ struct FixpointRewriteStrategy {
     Node current = node;
     do {
       previous = current;
-      if (R1::applies(current)) current  = R1::template run<false>(current);
-      if (R2::applies(current)) current  = R2::template run<false>(current);
-      if (R3::applies(current)) current  = R3::template run<false>(current);
-      if (R4::applies(current)) current  = R4::template run<false>(current);
-      if (R5::applies(current)) current  = R5::template run<false>(current);
-      if (R6::applies(current)) current  = R6::template run<false>(current);
-      if (R7::applies(current)) current  = R7::template run<false>(current);
-      if (R8::applies(current)) current  = R8::template run<false>(current);
-      if (R9::applies(current)) current  = R9::template run<false>(current);
-      if (R10::applies(current)) current = R10::template run<false>(current);
-      if (R11::applies(current)) current = R11::template run<false>(current);
-      if (R12::applies(current)) current = R12::template run<false>(current);
-      if (R13::applies(current)) current = R13::template run<false>(current);
-      if (R14::applies(current)) current = R14::template run<false>(current);
-      if (R15::applies(current)) current = R15::template run<false>(current);
-      if (R16::applies(current)) current = R16::template run<false>(current);
-      if (R17::applies(current)) current = R17::template run<false>(current);
-      if (R18::applies(current)) current = R18::template run<false>(current);
-      if (R19::applies(current)) current = R19::template run<false>(current);
-      if (R20::applies(current)) current = R20::template run<false>(current);
+      if (tryRule<R1>(current)) return current;
+      if (tryRule<R2>(current)) return current;
+      if (tryRule<R3>(current)) return current;
+      if (tryRule<R4>(current)) return current;
+      if (tryRule<R5>(current)) return current;
+      if (tryRule<R6>(current)) return current;
+      if (tryRule<R7>(current)) return current;
+      if (tryRule<R8>(current)) return current;
+      if (tryRule<R9>(current)) return current;
+      if (tryRule<R10>(current)) return current;
+      if (tryRule<R11>(current)) return current;
+      if (tryRule<R12>(current)) return current;
+      if (tryRule<R13>(current)) return current;
+      if (tryRule<R14>(current)) return current;
+      if (tryRule<R15>(current)) return current;
+      if (tryRule<R16>(current)) return current;
+      if (tryRule<R17>(current)) return current;
+      if (tryRule<R18>(current)) return current;
+      if (tryRule<R19>(current)) return current;
+      if (tryRule<R20>(current)) return current;
     } while (previous != current);
     
     return current;
@@ -29,6 +29,65 @@ using namespace CVC4;
 using namespace CVC4::theory;
 using namespace CVC4::theory::bv;
 
+thread_local bool RewriteRuleStatistics::s_enabled = false;
+thread_local RewriteRuleStatistics::Counters
+    RewriteRuleStatistics::s_counters[LastRewriteRule];
+
+void RewriteRuleStatistics::reset(bool enabled)
+{
+  s_enabled = enabled;
+  for (Counters& c : s_counters)
+  {
+    c = Counters();
+  }
+}
+
+void RewriteRuleStat::flushInformation(std::ostream& out) const
+{
+  out << "[";
+  bool first = true;
+  for (unsigned i = 0; i < LastRewriteRule; ++i)
+  {
+    RewriteRuleId rule = static_cast<RewriteRuleId>(i);
+    const RewriteRuleStatistics::Counters& c = RewriteRuleStatistics::get(rule);
+    if (c.d_tries == 0)
+    {
+      continue;
+    }
+    out << (first ? "" : ", ") << "(" << rule << " : " << c.d_tries << " tries, "
+        << c.d_applications << " applications, " << c.d_nanoseconds << "ns)";
+    first = false;
+  }
+  out << "]";
+}
+
+void RewriteRuleStat::safeFlushInformation(int fd) const
+{
+  // the names of the rules cannot be printed safely, so print their ids
+  safe_print(fd, "[");
+  bool first = true;
+  for (unsigned i = 0; i < LastRewriteRule; ++i)
+  {
+    const RewriteRuleStatistics::Counters& c =
+        RewriteRuleStatistics::get(static_cast<RewriteRuleId>(i));
+    if (c.d_tries == 0)
+    {
+      continue;
+    }
+    safe_print(fd, first ? "(" : ", (");
+    safe_print<uint64_t>(fd, i);
+    safe_print(fd, " : ");
+    safe_print<uint64_t>(fd, c.d_tries);
+    safe_print(fd, " tries, ");
+    safe_print<uint64_t>(fd, c.d_applications);
+    safe_print(fd, " applications, ");
+    safe_print<uint64_t>(fd, c.d_nanoseconds);
+    safe_print(fd, "ns)");
+    first = false;
+  }
+  safe_print(fd, "]");
+}
+
 TheoryBVRewriter::TheoryBVRewriter() { initializeRewrites(); }
 
 RewriteResponse TheoryBVRewriter::preRewrite(TNode node) {
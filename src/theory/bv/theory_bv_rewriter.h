@@ -30,6 +30,20 @@ namespace bv {
 struct AllRewriteRules;
 typedef RewriteResponse (*RewriteFunction) (TNode, bool);
 
+/**
+ * A statistic that reports, for each bit-vector rewrite rule that was tried,
+ * the number of tries and applications and the time spent, if
+ * --bv-rewrite-rule-stats is on. See RewriteRuleStatistics.
+ */
+class RewriteRuleStat : public Stat
+{
+ public:
+  RewriteRuleStat(const std::string& name) : Stat(name) {}
+
+  void flushInformation(std::ostream& out) const override;
+  void safeFlushInformation(int fd) const override;
+}; /* class RewriteRuleStat */
+
 class TheoryBVRewriter : public TheoryRewriter
 {
  public:
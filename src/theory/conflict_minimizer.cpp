@@ -0,0 +1,144 @@
+/*********************                                                        */
+/*! \file conflict_minimizer.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the minimization of theory conflicts
+ **/
+
+#include "theory/conflict_minimizer.h"
+
+#include "base/exception.h"
+#include "options/smt_options.h"
+#include "options/theory_options.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+#include "smt/smt_statistics_registry.h"
+
+using namespace CVC4::kind;
+
+namespace CVC4 {
+namespace theory {
+
+ConflictMinimizer::ConflictMinimizer() : d_numChecks(0) {}
+
+ConflictMinimizer::~ConflictMinimizer() {}
+
+Node ConflictMinimizer::minimize(Node conflict)
+{
+  if (!options::conflictMin() || options::proof()
+      || conflict.getKind() != AND
+      || conflict.getNumChildren() < options::conflictMinSize())
+  {
+    return conflict;
+  }
+  // The subsolvers share the options, do not minimize their own conflicts
+  SmtEngine* smt = smt::currentSmtEngine();
+  if (smt->isInternalSubsolver() || smt->getLogicInfo().isQuantified())
+  {
+    return conflict;
+  }
+  Trace("conflict-min") << "ConflictMinimizer::minimize: " << conflict
+                        << std::endl;
+  std::vector<Node> lits(conflict.begin(), conflict.end());
+  std::vector<Node> background;
+  std::vector<Node> core;
+  d_numChecks = 0;
+  try
+  {
+    quickXplain(background, false, lits, core);
+  }
+  catch (const Exception& e)
+  {
+    Trace("conflict-min") << "...failed: " << e << std::endl;
+    return conflict;
+  }
+  Trace("conflict-min") << "...kept " << core.size() << " of " << lits.size()
+                        << " literals after " << d_numChecks << " checks"
+                        << std::endl;
+  if (core.empty() || core.size() == lits.size())
+  {
+    return conflict;
+  }
+  ++d_statistics.d_conflictsMinimized;
+  d_statistics.d_literalsRemoved += lits.size() - core.size();
+  return core.size() == 1 ? core[0]
+                          : NodeManager::currentNM()->mkNode(AND, core);
+}
+
+void ConflictMinimizer::quickXplain(std::vector<Node>& background,
+                                    bool checkBackground,
+                                    const std::vector<Node>& lits,
+                                    std::vector<Node>& core)
+{
+  if (checkBackground && isUnsat(background))
+  {
+    return;
+  }
+  if (lits.size() == 1)
+  {
+    core.push_back(lits[0]);
+    return;
+  }
+  size_t half = lits.size() / 2;
+  std::vector<Node> lits1(lits.begin(), lits.begin() + half);
+  std::vector<Node> lits2(lits.begin() + half, lits.end());
+  size_t size = background.size();
+  // the literals of lits2 needed together with lits1
+  std::vector<Node> core2;
+  background.insert(background.end(), lits1.begin(), lits1.end());
+  quickXplain(background, true, lits2, core2);
+  background.resize(size);
+  // the literals of lits1 needed together with core2
+  std::vector<Node> core1;
+  background.insert(background.end(), core2.begin(), core2.end());
+  quickXplain(background, !core2.empty(), lits1, core1);
+  background.resize(size);
+  core.insert(core.end(), core1.begin(), core1.end());
+  core.insert(core.end(), core2.begin(), core2.end());
+}
+
+bool ConflictMinimizer::isUnsat(const std::vector<Node>& lits)
+{
+  if (lits.empty() || d_numChecks >= options::conflictMinChecks())
+  {
+    return false;
+  }
+  d_numChecks++;
+  ++d_statistics.d_checks;
+  SmtEngine checker(NodeManager::currentNM()->toExprManager());
+  checker.setIsInternalSubsolver();
+  checker.setLogic(smt::currentSmtEngine()->getLogicInfo());
+  for (const Node& lit : lits)
+  {
+    checker.assertFormula(lit.toExpr());
+  }
+  Result r = checker.checkSat();
+  Trace("conflict-min-debug") << "...check of " << lits.size()
+                              << " literals: " << r << std::endl;
+  return r.asSatisfiabilityResult().isSat() == Result::UNSAT;
+}
+
+ConflictMinimizer::Statistics::Statistics()
+    : d_conflictsMinimized("theory::ConflictMinimizer::conflictsMinimized", 0),
+      d_literalsRemoved("theory::ConflictMinimizer::literalsRemoved", 0),
+      d_checks("theory::ConflictMinimizer::checks", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_conflictsMinimized);
+  smtStatisticsRegistry()->registerStat(&d_literalsRemoved);
+  smtStatisticsRegistry()->registerStat(&d_checks);
+}
+
+ConflictMinimizer::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_conflictsMinimized);
+  smtStatisticsRegistry()->unregisterStat(&d_literalsRemoved);
+  smtStatisticsRegistry()->unregisterStat(&d_checks);
+}
+
+}  // namespace theory
+}  // namespace CVC4
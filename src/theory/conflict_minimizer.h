@@ -0,0 +1,91 @@
+/*********************                                                        */
+/*! \file conflict_minimizer.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Minimization of theory conflicts
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__CONFLICT_MINIMIZER_H
+#define CVC4__THEORY__CONFLICT_MINIMIZER_H
+
+#include <vector>
+
+#include "expr/node.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+
+/**
+ * Shrinks the theory conflicts before they are sent to the SAT solver, so
+ * that the learned clauses are stronger. A conflict is minimized with
+ * QuickXplain (Junker, AAAI 2004): subsets of its literals are checked by a
+ * subsolver, and the literals that are not needed for their
+ * unsatisfiability are dropped.
+ *
+ * A literal is only dropped when a subsolver showed that the remaining ones
+ * are unsatisfiable, hence the result is a conflict whenever the input is,
+ * even if the budget of options::conflictMinChecks() checks runs out, or a
+ * check is unknown.
+ */
+class ConflictMinimizer
+{
+ public:
+  ConflictMinimizer();
+  ~ConflictMinimizer();
+
+  /**
+   * Returns a conjunction of a subset of the literals of the conjunction
+   * conflict that is still unsatisfiable, or conflict itself if
+   * --conflict-min is disabled, conflict is smaller than
+   * options::conflictMinSize(), or no literal could be dropped.
+   */
+  Node minimize(Node conflict);
+
+ private:
+  /**
+   * QuickXplain: adds to core a subset of lits such that background and this
+   * subset are unsatisfiable, assuming background and lits are. If
+   * checkBackground is true, background is checked first, and nothing is
+   * added if it is unsatisfiable on its own.
+   */
+  void quickXplain(std::vector<Node>& background,
+                   bool checkBackground,
+                   const std::vector<Node>& lits,
+                   std::vector<Node>& core);
+  /**
+   * Returns true if the conjunction of lits was shown unsatisfiable by a
+   * subsolver. Returns false without checking once the budget of checks of
+   * the current minimization is spent.
+   */
+  bool isUnsat(const std::vector<Node>& lits);
+
+  /** The number of checks made by the current minimization */
+  unsigned d_numChecks;
+
+  class Statistics
+  {
+   public:
+    /** Number of conflicts that were shrunk */
+    IntStat d_conflictsMinimized;
+    /** Number of literals dropped from the conflicts */
+    IntStat d_literalsRemoved;
+    /** Number of subsolver checks */
+    IntStat d_checks;
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
+}; /* class ConflictMinimizer */
+
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__CONFLICT_MINIMIZER_H */
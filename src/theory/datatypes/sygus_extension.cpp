@@ -1045,8 +1045,13 @@ Node SygusExtension::registerSearchValue(Node a,
       quantifiers::DivByZeroSygusInvarianceTest dbzet;
       Trace("sygus-sb-mexp-debug") << "Minimize explanation for div-by-zero in "
                                    << bv << std::endl;
-      registerSymBreakLemmaForValue(
-          a, nv, dbzet, Node::null(), var_count, lemmas);
+      registerSymBreakLemmaForValue(a,
+                                    nv,
+                                    dbzet,
+                                    Node::null(),
+                                    var_count,
+                                    usesSharedSymBreakLemmas(a),
+                                    lemmas);
       return Node::null();
     }else{
       std::unordered_map<Node, Node, NodeHashFunction>::iterator itsv =
@@ -1149,8 +1154,11 @@ Node SygusExtension::registerSearchValue(Node a,
         eset.init(d_tds, tn, aconj, a, bvr);
 
         Trace("sygus-sb-mexp-debug") << "Minimize explanation for eval[" << d_tds->sygusToBuiltin( bad_val ) << "] = " << bvr << std::endl;
+        // the explanation does not depend on a if a has no examples
+        bool isShared = !by_examples && usesSharedSymBreakLemmas(a)
+                        && !aconj->getPbe()->hasExamples(a);
         registerSymBreakLemmaForValue(
-            a, bad_val, eset, bad_val_o, var_count, lemmas);
+            a, bad_val, eset, bad_val_o, var_count, isShared, lemmas);
 
         // other generalization criteria go here
 
@@ -1173,6 +1181,7 @@ void SygusExtension::registerSymBreakLemmaForValue(
     quantifiers::SygusInvarianceTest& et,
     Node valr,
     std::map<TypeNode, int>& var_count,
+    bool isShared,
     std::vector<Node>& lemmas)
 {
   TypeNode tn = val.getType();
@@ -1185,9 +1194,28 @@ void SygusExtension::registerSymBreakLemmaForValue(
   lem = lem.negate();
   Trace("sygus-sb-exc") << "  ........exc lemma is " << lem << ", size = " << sz
                         << std::endl;
+  if (isShared && d_shared_sb_lemma_set.insert(lem).second)
+  {
+    Trace("sygus-sb-exc") << "  ........shared with other anchors" << std::endl;
+    d_shared_sb_lemmas[tn][sz].push_back(lem);
+    for (const std::pair<const Node, bool>& r : d_register_st)
+    {
+      if (r.second && r.first != a && usesSharedSymBreakLemmas(r.first))
+      {
+        registerSymBreakLemma(tn, lem, sz, r.first, lemmas);
+      }
+    }
+  }
   registerSymBreakLemma(tn, lem, sz, a, lemmas);
 }
 
+bool SygusExtension::usesSharedSymBreakLemmas(Node a)
+{
+  return options::sygusSymBreakShare()
+         && !d_tds->isVariableAgnosticEnumerator(a)
+         && !d_tds->isBasicEnumerator(a);
+}
+
 void SygusExtension::registerSymBreakLemma( TypeNode tn, Node lem, unsigned sz, Node a, std::vector< Node >& lemmas ) {
   // lem holds for all terms of type tn, and is applicable to terms of size sz
   Trace("sygus-sb-debug") << "  register sym break lemma : " << lem
@@ -1384,6 +1412,21 @@ void SygusExtension::registerSizeTerm(Node e, std::vector<Node>& lemmas)
       lemmas.push_back(preNoVarProc);
     }
   }
+  if (usesSharedSymBreakLemmas(e))
+  {
+    // the lemma templates derived for previous anchors apply to e as well
+    for (const std::pair<const TypeNode, std::map<unsigned, std::vector<Node>>>&
+             sbt : d_shared_sb_lemmas)
+    {
+      for (const std::pair<const unsigned, std::vector<Node>>& sbs : sbt.second)
+      {
+        for (const Node& lem : sbs.second)
+        {
+          registerSymBreakLemma(sbt.first, lem, sbs.first, e, lemmas);
+        }
+      }
+    }
+  }
 }
 
 void SygusExtension::registerMeasureTerm( Node m ) {
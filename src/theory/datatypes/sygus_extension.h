@@ -205,6 +205,23 @@ private:
   };
   /** An instance of the above cache, for each anchor */
   std::map< Node, SearchCache > d_cache;
+  /**
+   * The symmetry breaking lemma templates for (types, sizes) that were derived
+   * by rewriting alone, i.e. not based on the examples of an anchor. They hold
+   * for all anchors, hence they are added to the cache of all anchors that
+   * use them (see usesSharedSymBreakLemmas), including the anchors registered
+   * later, e.g. by further calls to check-synth.
+   */
+  std::map<TypeNode, std::map<unsigned, std::vector<Node>>> d_shared_sb_lemmas;
+  /** The lemma templates in d_shared_sb_lemmas */
+  std::unordered_set<Node, NodeHashFunction> d_shared_sb_lemma_set;
+  /**
+   * Whether anchor a shares the symmetry breaking lemma templates derived by
+   * rewriting alone with other anchors. This is the case if
+   * --sygus-sym-break-share is enabled, and a is neither variable agnostic
+   * nor a basic enumerator.
+   */
+  bool usesSharedSymBreakLemmas(Node a);
   //-----------------------------------traversal predicates
   /** pre/post traversal predicates for each type, variable
    *
@@ -423,6 +440,9 @@ private:
    * the symmetry breaking lemma template, which is a restriction to the above
    * generalization.
    *
+   * If isShared is true, the lemma template does not depend on a, and is
+   * also registered for all other anchors that use shared lemma templates.
+   *
    * This function may add instances of the symmetry breaking template for
    * existing search terms, which are added to lemmas.
    */
@@ -431,6 +451,7 @@ private:
                                      quantifiers::SygusInvarianceTest& et,
                                      Node valr,
                                      std::map<TypeNode, int>& var_count,
+                                     bool isShared,
                                      std::vector<Node>& lemmas);
   /** Add symmetry breaking lemmas for term
    *
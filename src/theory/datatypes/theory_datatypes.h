@@ -21,6 +21,7 @@
 
 #include <iostream>
 #include <map>
+#include <unordered_map>
 
 #include "context/cdlist.h"
 #include "expr/attribute.h"
@@ -339,9 +340,18 @@ private:
   Node removeUninterpretedConstants( Node n, std::map< Node, Node >& visited );
   /** for checking if cycles exist */
   void checkCycles();
-  Node searchForCycle( TNode n, TNode on,
-                       std::map< TNode, bool >& visited, std::map< TNode, bool >& proc,
-                       std::vector< TNode >& explanation, bool firstTime = true );
+  /**
+   * Search for a cycle of constructor applications from the equivalence class
+   * of n, where visited contains the classes on the current path and proc
+   * contains the classes from which no cycle is reachable.
+   */
+  Node searchForCycle(
+      TNode n,
+      TNode on,
+      std::unordered_map<TNode, bool, TNodeHashFunction>& visited,
+      std::unordered_map<TNode, bool, TNodeHashFunction>& proc,
+      std::vector<TNode>& explanation,
+      bool firstTime = true);
   /** for checking whether two codatatype terms must be equal */
   void separateBisimilar( std::vector< Node >& part, std::vector< std::vector< Node > >& part_out,
                           std::vector< TNode >& exp,
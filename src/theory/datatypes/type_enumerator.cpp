@@ -22,8 +22,58 @@ using namespace CVC4;
 using namespace theory;
 using namespace datatypes;
 
+bool DatatypesEnumeratorCache::getTerm(TypeNode tn,
+                                       bool childEnum,
+                                       unsigned i,
+                                       Node& ret)
+{
+  Stream& s = d_streams[std::pair<TypeNode, bool>(tn, childEnum)];
+  if (i < s.d_terms.size())
+  {
+    ret = s.d_terms[i];
+    return true;
+  }
+  if (s.d_busy)
+  {
+    return false;
+  }
+  s.d_busy = true;
+  if (s.d_enum == nullptr)
+  {
+    if (tn.isDatatype())
+    {
+      s.d_enum.reset(new TypeEnumerator(
+          new DatatypesEnumerator(tn, childEnum, d_tep, this)));
+    }
+    else
+    {
+      s.d_enum.reset(new TypeEnumerator(tn, d_tep));
+    }
+    s.d_terms.push_back(**s.d_enum);
+  }
+  // enumerate terms until index is reached
+  while (i >= s.d_terms.size() && !s.d_enum->isFinished())
+  {
+    ++(*s.d_enum);
+    if (!s.d_enum->isFinished())
+    {
+      s.d_terms.push_back(**s.d_enum);
+    }
+  }
+  s.d_busy = false;
+  ret = i < s.d_terms.size() ? s.d_terms[i] : Node::null();
+  return true;
+}
+
 Node DatatypesEnumerator::getTermEnum( TypeNode tn, unsigned i ){
    Node ret;
+   bool childEnum = tn.isDatatype() && d_has_debruijn;
+   if (d_cache->getTerm(tn, childEnum, i, ret))
+   {
+     Debug("dt-enum-debug") << "...cached term enum " << tn << " " << i
+                            << " : " << ret << std::endl;
+     return ret;
+   }
    if( i<d_terms[tn].size() ){
      ret = d_terms[tn][i];
    }else{
@@ -34,9 +84,12 @@ Node DatatypesEnumerator::getTermEnum( TypeNode tn, unsigned i ){
        //initialize child enumerator for type
        tei = d_children.size();
        d_te_index[tn] = tei;
-       if( tn.isDatatype() && d_has_debruijn ){
-         //must indicate that this is a child enumerator (do not normalize constants for it)
-         DatatypesEnumerator * dte = new DatatypesEnumerator( tn, true, d_tep );
+       if (tn.isDatatype())
+       {
+         // if childEnum, must indicate that this is a child enumerator (do not
+         // normalize constants for it)
+         DatatypesEnumerator* dte =
+             new DatatypesEnumerator(tn, childEnum, d_tep, d_cache);
          d_children.push_back( TypeEnumerator( dte ) );
        }else{
          d_children.push_back( TypeEnumerator( tn, d_tep ) );
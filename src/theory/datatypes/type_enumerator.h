@@ -19,6 +19,10 @@
 #ifndef CVC4__THEORY__DATATYPES__TYPE_ENUMERATOR_H
 #define CVC4__THEORY__DATATYPES__TYPE_ENUMERATOR_H
 
+#include <map>
+#include <memory>
+#include <vector>
+
 #include "expr/dtype.h"
 #include "expr/kind.h"
 #include "expr/type.h"
@@ -30,10 +34,56 @@ namespace CVC4 {
 namespace theory {
 namespace datatypes {
 
+/**
+ * The enumerations of the selector argument types of a datatypes enumerator.
+ *
+ * A top-level datatypes enumerator owns one of these, and shares it with its
+ * copies and with all the datatypes enumerators it creates (transitively) for
+ * the types of its selectors. Each of these types is then enumerated once,
+ * and its terms are read by index, instead of every enumerator re-creating
+ * the enumerators of the types of its selectors. For recursive datatypes,
+ * this avoids enumerating the same type again at each level of nesting.
+ */
+class DatatypesEnumeratorCache
+{
+ public:
+  DatatypesEnumeratorCache(TypeEnumeratorProperties* tep) : d_tep(tep) {}
+  /**
+   * Sets ret to the i^th term of the enumeration of tn, or to null if tn has
+   * less than i+1 terms. The flag childEnum is passed to the datatypes
+   * enumerator of tn, if tn is a datatype.
+   *
+   * Returns false if the term is not enumerated yet and the enumeration of
+   * tn is being extended, i.e. it is needed to extend the enumeration of tn
+   * itself. The caller must then enumerate tn on its own.
+   */
+  bool getTerm(TypeNode tn, bool childEnum, unsigned i, Node& ret);
+
+ private:
+  /** The enumeration of a type */
+  struct Stream
+  {
+    Stream() : d_busy(false) {}
+    /** The terms enumerated so far */
+    std::vector<Node> d_terms;
+    /** The enumerator producing them */
+    std::unique_ptr<TypeEnumerator> d_enum;
+    /** Whether d_enum is being incremented */
+    bool d_busy;
+  };
+  /** type properties */
+  TypeEnumeratorProperties* d_tep;
+  /** The enumerations, for each type and child enumerator flag */
+  std::map<std::pair<TypeNode, bool>, Stream> d_streams;
+}; /* class DatatypesEnumeratorCache */
 
 class DatatypesEnumerator : public TypeEnumeratorBase<DatatypesEnumerator> {
   /** type properties */
   TypeEnumeratorProperties * d_tep;
+  /** The cache that this enumerator owns, if it is a top-level enumerator */
+  std::shared_ptr<DatatypesEnumeratorCache> d_cacheOwner;
+  /** The cache used for the types of the selectors */
+  DatatypesEnumeratorCache* d_cache;
   /** The datatype we're enumerating */
   const DType& d_datatype;
   /** extra cons */
@@ -46,11 +96,13 @@ class DatatypesEnumerator : public TypeEnumeratorBase<DatatypesEnumerator> {
   Node d_zeroTerm;
   /** Whether we are currently considering the above term */
   bool d_zeroTermActive;
-  /** list of type enumerators (one for each type in a selector argument) */
+  /**
+   * List of type enumerators (one for each type in a selector argument),
+   * only used when the enumeration of the type in d_cache is being extended.
+   */
   std::map< TypeNode, unsigned > d_te_index;
   std::vector< TypeEnumerator > d_children;
-  //std::vector< DatatypesEnumerator > d_dt_children;
-  /** terms produced for types */
+  /** terms produced for types by d_children */
   std::map< TypeNode, std::vector< Node > > d_terms;
   /** arg type of each selector, for each constructor */
   std::vector< std::vector< TypeNode > > d_sel_types;
@@ -88,6 +140,8 @@ class DatatypesEnumerator : public TypeEnumeratorBase<DatatypesEnumerator> {
   DatatypesEnumerator(TypeNode type, TypeEnumeratorProperties* tep = nullptr)
       : TypeEnumeratorBase<DatatypesEnumerator>(type),
         d_tep(tep),
+        d_cacheOwner(new DatatypesEnumeratorCache(tep)),
+        d_cache(d_cacheOwner.get()),
         d_datatype(type.getDType()),
         d_type(type),
         d_ctor(0),
@@ -101,6 +155,24 @@ class DatatypesEnumerator : public TypeEnumeratorBase<DatatypesEnumerator> {
                       TypeEnumeratorProperties* tep = nullptr)
       : TypeEnumeratorBase<DatatypesEnumerator>(type),
         d_tep(tep),
+        d_cacheOwner(new DatatypesEnumeratorCache(tep)),
+        d_cache(d_cacheOwner.get()),
+        d_datatype(type.getDType()),
+        d_type(type),
+        d_ctor(0),
+        d_zeroTermActive(false)
+  {
+    d_child_enum = childEnum;
+    init();
+  }
+  /** Constructs an enumerator using the cache of another enumerator */
+  DatatypesEnumerator(TypeNode type,
+                      bool childEnum,
+                      TypeEnumeratorProperties* tep,
+                      DatatypesEnumeratorCache* cache)
+      : TypeEnumeratorBase<DatatypesEnumerator>(type),
+        d_tep(tep),
+        d_cache(cache),
         d_datatype(type.getDType()),
         d_type(type),
         d_ctor(0),
@@ -112,6 +184,8 @@ class DatatypesEnumerator : public TypeEnumeratorBase<DatatypesEnumerator> {
   DatatypesEnumerator(const DatatypesEnumerator& de)
       : TypeEnumeratorBase<DatatypesEnumerator>(de.getType()),
         d_tep(de.d_tep),
+        d_cacheOwner(de.d_cacheOwner),
+        d_cache(de.d_cache),
         d_datatype(de.d_datatype),
         d_type(de.d_type),
         d_ctor(de.d_ctor),
@@ -138,6 +138,109 @@ Node Evaluator::eval(TNode n,
   return ret;
 }
 
+void Evaluator::eval(TNode n,
+                     const std::vector<Node>& args,
+                     const std::vector<std::vector<Node>>& points,
+                     std::vector<Node>& res) const
+{
+  Trace("evaluator") << "Evaluating " << n << " on " << points.size()
+                     << " points" << std::endl;
+  // The subterms of n in post-order. For each subterm, we store the positions
+  // of its children in this list, and the position of the subterm in args if
+  // it is a variable, or -1 otherwise.
+  std::vector<TNode> terms;
+  std::vector<std::vector<size_t>> termChildren;
+  std::vector<ptrdiff_t> termArg;
+  std::unordered_map<TNode, size_t, TNodeHashFunction> termPos;
+  bool compiled = true;
+  std::vector<TNode> visit;
+  visit.emplace_back(n);
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    if (termPos.find(cur) != termPos.end())
+    {
+      visit.pop_back();
+      continue;
+    }
+    // operators are evaluated separately in evalInternal
+    if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+    {
+      compiled = false;
+      break;
+    }
+    bool doProcess = true;
+    for (const auto& curChild : cur)
+    {
+      if (termPos.find(curChild) == termPos.end())
+      {
+        visit.emplace_back(curChild);
+        doProcess = false;
+      }
+    }
+    if (!doProcess)
+    {
+      continue;
+    }
+    visit.pop_back();
+    ptrdiff_t pos = -1;
+    if (cur.isVar())
+    {
+      const auto& it = std::find(args.begin(), args.end(), cur);
+      if (it == args.end())
+      {
+        // the variable is not a valid EvalResult on any point
+        compiled = false;
+        break;
+      }
+      pos = std::distance(args.begin(), it);
+    }
+    termPos[cur] = terms.size();
+    terms.push_back(cur);
+    termChildren.emplace_back();
+    for (const auto& curChild : cur)
+    {
+      termChildren.back().push_back(termPos[curChild]);
+    }
+    termArg.push_back(pos);
+  }
+  Trace("evaluator") << "Evaluator: compiled " << terms.size()
+                     << " subterms, success = " << compiled << std::endl;
+
+  std::vector<EvalResult> results(terms.size());
+  std::vector<const EvalResult*> children;
+  for (const std::vector<Node>& vals : points)
+  {
+    Assert(vals.size() == args.size());
+    bool success = compiled;
+    for (size_t i = 0, nterms = terms.size(); success && i < nterms; i++)
+    {
+      children.clear();
+      for (size_t c : termChildren[i])
+      {
+        children.push_back(&results[c]);
+      }
+      TNode currNodeVal = termArg[i] < 0 ? terms[i] : TNode(vals[termArg[i]]);
+      results[i] = evalNode(terms[i], currNodeVal, children);
+      success = results[i].d_tag != EvalResult::INVALID;
+    }
+    Node ret;
+    if (success)
+    {
+      // n is the last subterm in post-order
+      ret = results.back().toNode();
+      Assert(ret
+             == Rewriter::rewrite(n.substitute(
+                    args.begin(), args.end(), vals.begin(), vals.end())));
+    }
+    else
+    {
+      ret = eval(n, args, vals);
+    }
+    res.push_back(ret);
+  }
+}
+
 EvalResult Evaluator::evalInternal(
     TNode n,
     const std::vector<Node>& args,
@@ -301,493 +404,504 @@ EvalResult Evaluator::evalInternal(
         continue;
       }
 
-      switch (currNodeVal.getKind())
+      // evaluate currNode from the results of its children
+      std::vector<const EvalResult*> children;
+      for (const auto& currNodeChild : currNode)
       {
-        case kind::CONST_BOOLEAN:
-          results[currNode] = EvalResult(currNodeVal.getConst<bool>());
-          break;
+        children.push_back(&results[currNodeChild]);
+      }
+      EvalResult& res = results[currNode];
+      res = evalNode(currNode, currNodeVal, children);
+      if (res.d_tag == EvalResult::INVALID)
+      {
+        evalAsNode[currNode] =
+            needsReconstruct ? reconstruct(currNode, results, evalAsNode)
+                             : currNodeVal;
+      }
+    }
+  }
 
-        case kind::NOT:
-        {
-          results[currNode] = EvalResult(!(results[currNode[0]].d_bool));
-          break;
-        }
+  return results[n];
+}
 
-        case kind::AND:
-        {
-          bool res = results[currNode[0]].d_bool;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res && results[currNode[i]].d_bool;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+EvalResult Evaluator::evalNode(
+    TNode currNode,
+    TNode currNodeVal,
+    const std::vector<const EvalResult*>& children) const
+{
+  EvalResult ret;
+  switch (currNodeVal.getKind())
+  {
+    case kind::CONST_BOOLEAN:
+      ret = EvalResult(currNodeVal.getConst<bool>());
+      break;
 
-        case kind::OR:
-        {
-          bool res = results[currNode[0]].d_bool;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res || results[currNode[i]].d_bool;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+    case kind::NOT:
+    {
+      ret = EvalResult(!(children[0]->d_bool));
+      break;
+    }
 
-        case kind::CONST_RATIONAL:
-        {
-          const Rational& r = currNodeVal.getConst<Rational>();
-          results[currNode] = EvalResult(r);
-          break;
-        }
+    case kind::AND:
+    {
+      bool res = children[0]->d_bool;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res && children[i]->d_bool;
+      }
+      ret = EvalResult(res);
+      break;
+    }
 
-        case kind::PLUS:
-        {
-          Rational res = results[currNode[0]].d_rat;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res + results[currNode[i]].d_rat;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+    case kind::OR:
+    {
+      bool res = children[0]->d_bool;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res || children[i]->d_bool;
+      }
+      ret = EvalResult(res);
+      break;
+    }
 
-        case kind::MINUS:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x - y);
-          break;
-        }
+    case kind::CONST_RATIONAL:
+    {
+      const Rational& r = currNodeVal.getConst<Rational>();
+      ret = EvalResult(r);
+      break;
+    }
 
-        case kind::UMINUS:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          results[currNode] = EvalResult(-x);
-          break;
-        }
-        case kind::MULT:
-        case kind::NONLINEAR_MULT:
-        {
-          Rational res = results[currNode[0]].d_rat;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res * results[currNode[i]].d_rat;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+    case kind::PLUS:
+    {
+      Rational res = children[0]->d_rat;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res + children[i]->d_rat;
+      }
+      ret = EvalResult(res);
+      break;
+    }
 
-        case kind::GEQ:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x >= y);
-          break;
-        }
-        case kind::LEQ:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x <= y);
-          break;
-        }
-        case kind::GT:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x > y);
-          break;
-        }
-        case kind::LT:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x < y);
-          break;
-        }
-        case kind::ABS:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          results[currNode] = EvalResult(x.abs());
-          break;
-        }
-        case kind::CONST_STRING:
-          results[currNode] = EvalResult(currNodeVal.getConst<String>());
-          break;
+    case kind::MINUS:
+    {
+      const Rational& x = children[0]->d_rat;
+      const Rational& y = children[1]->d_rat;
+      ret = EvalResult(x - y);
+      break;
+    }
 
-        case kind::STRING_CONCAT:
-        {
-          String res = results[currNode[0]].d_str;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res.concat(results[currNode[i]].d_str);
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+    case kind::UMINUS:
+    {
+      const Rational& x = children[0]->d_rat;
+      ret = EvalResult(-x);
+      break;
+    }
+    case kind::MULT:
+    case kind::NONLINEAR_MULT:
+    {
+      Rational res = children[0]->d_rat;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res * children[i]->d_rat;
+      }
+      ret = EvalResult(res);
+      break;
+    }
 
-        case kind::STRING_LENGTH:
-        {
-          const String& s = results[currNode[0]].d_str;
-          results[currNode] = EvalResult(Rational(s.size()));
-          break;
-        }
+    case kind::GEQ:
+    {
+      const Rational& x = children[0]->d_rat;
+      const Rational& y = children[1]->d_rat;
+      ret = EvalResult(x >= y);
+      break;
+    }
+    case kind::LEQ:
+    {
+      const Rational& x = children[0]->d_rat;
+      const Rational& y = children[1]->d_rat;
+      ret = EvalResult(x <= y);
+      break;
+    }
+    case kind::GT:
+    {
+      const Rational& x = children[0]->d_rat;
+      const Rational& y = children[1]->d_rat;
+      ret = EvalResult(x > y);
+      break;
+    }
+    case kind::LT:
+    {
+      const Rational& x = children[0]->d_rat;
+      const Rational& y = children[1]->d_rat;
+      ret = EvalResult(x < y);
+      break;
+    }
+    case kind::ABS:
+    {
+      const Rational& x = children[0]->d_rat;
+      ret = EvalResult(x.abs());
+      break;
+    }
+    case kind::CONST_STRING:
+      ret = EvalResult(currNodeVal.getConst<String>());
+      break;
 
-        case kind::STRING_SUBSTR:
-        {
-          const String& s = results[currNode[0]].d_str;
-          Integer s_len(s.size());
-          Integer i = results[currNode[1]].d_rat.getNumerator();
-          Integer j = results[currNode[2]].d_rat.getNumerator();
-
-          if (i.strictlyNegative() || j.strictlyNegative() || i >= s_len)
-          {
-            results[currNode] = EvalResult(String(""));
-          }
-          else if (i + j > s_len)
-          {
-            results[currNode] =
-                EvalResult(s.suffix((s_len - i).toUnsignedInt()));
-          }
-          else
-          {
-            results[currNode] =
-                EvalResult(s.substr(i.toUnsignedInt(), j.toUnsignedInt()));
-          }
-          break;
-        }
+    case kind::STRING_CONCAT:
+    {
+      String res = children[0]->d_str;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res.concat(children[i]->d_str);
+      }
+      ret = EvalResult(res);
+      break;
+    }
 
-        case kind::STRING_CHARAT:
-        {
-          const String& s = results[currNode[0]].d_str;
-          Integer s_len(s.size());
-          Integer i = results[currNode[1]].d_rat.getNumerator();
-          if (i.strictlyNegative() || i >= s_len)
-          {
-            results[currNode] = EvalResult(String(""));
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.substr(i.toUnsignedInt(), 1));
-          }
-          break;
-        }
+    case kind::STRING_LENGTH:
+    {
+      const String& s = children[0]->d_str;
+      ret = EvalResult(Rational(s.size()));
+      break;
+    }
 
-        case kind::STRING_STRCTN:
-        {
-          const String& s = results[currNode[0]].d_str;
-          const String& t = results[currNode[1]].d_str;
-          results[currNode] = EvalResult(s.find(t) != std::string::npos);
-          break;
-        }
+    case kind::STRING_SUBSTR:
+    {
+      const String& s = children[0]->d_str;
+      Integer s_len(s.size());
+      Integer i = children[1]->d_rat.getNumerator();
+      Integer j = children[2]->d_rat.getNumerator();
 
-        case kind::STRING_STRIDOF:
-        {
-          const String& s = results[currNode[0]].d_str;
-          Integer s_len(s.size());
-          const String& x = results[currNode[1]].d_str;
-          Integer i = results[currNode[2]].d_rat.getNumerator();
-
-          if (i.strictlyNegative())
-          {
-            results[currNode] = EvalResult(Rational(-1));
-          }
-          else
-          {
-            size_t r = s.find(x, i.toUnsignedInt());
-            if (r == std::string::npos)
-            {
-              results[currNode] = EvalResult(Rational(-1));
-            }
-            else
-            {
-              results[currNode] = EvalResult(Rational(r));
-            }
-          }
-          break;
-        }
+      if (i.strictlyNegative() || j.strictlyNegative() || i >= s_len)
+      {
+        ret = EvalResult(String(""));
+      }
+      else if (i + j > s_len)
+      {
+        ret =
+            EvalResult(s.suffix((s_len - i).toUnsignedInt()));
+      }
+      else
+      {
+        ret =
+            EvalResult(s.substr(i.toUnsignedInt(), j.toUnsignedInt()));
+      }
+      break;
+    }
 
-        case kind::STRING_STRREPL:
-        {
-          const String& s = results[currNode[0]].d_str;
-          const String& x = results[currNode[1]].d_str;
-          const String& y = results[currNode[2]].d_str;
-          results[currNode] = EvalResult(s.replace(x, y));
-          break;
-        }
+    case kind::STRING_CHARAT:
+    {
+      const String& s = children[0]->d_str;
+      Integer s_len(s.size());
+      Integer i = children[1]->d_rat.getNumerator();
+      if (i.strictlyNegative() || i >= s_len)
+      {
+        ret = EvalResult(String(""));
+      }
+      else
+      {
+        ret = EvalResult(s.substr(i.toUnsignedInt(), 1));
+      }
+      break;
+    }
 
-        case kind::STRING_PREFIX:
-        {
-          const String& t = results[currNode[0]].d_str;
-          const String& s = results[currNode[1]].d_str;
-          if (s.size() < t.size())
-          {
-            results[currNode] = EvalResult(false);
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.prefix(t.size()) == t);
-          }
-          break;
-        }
+    case kind::STRING_STRCTN:
+    {
+      const String& s = children[0]->d_str;
+      const String& t = children[1]->d_str;
+      ret = EvalResult(s.find(t) != std::string::npos);
+      break;
+    }
 
-        case kind::STRING_SUFFIX:
-        {
-          const String& t = results[currNode[0]].d_str;
-          const String& s = results[currNode[1]].d_str;
-          if (s.size() < t.size())
-          {
-            results[currNode] = EvalResult(false);
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.suffix(t.size()) == t);
-          }
-          break;
-        }
+    case kind::STRING_STRIDOF:
+    {
+      const String& s = children[0]->d_str;
+      Integer s_len(s.size());
+      const String& x = children[1]->d_str;
+      Integer i = children[2]->d_rat.getNumerator();
 
-        case kind::STRING_ITOS:
+      if (i.strictlyNegative())
+      {
+        ret = EvalResult(Rational(-1));
+      }
+      else
+      {
+        size_t r = s.find(x, i.toUnsignedInt());
+        if (r == std::string::npos)
         {
-          Integer i = results[currNode[0]].d_rat.getNumerator();
-          if (i.strictlyNegative())
-          {
-            results[currNode] = EvalResult(String(""));
-          }
-          else
-          {
-            results[currNode] = EvalResult(String(i.toString()));
-          }
-          break;
+          ret = EvalResult(Rational(-1));
         }
-
-        case kind::STRING_STOI:
+        else
         {
-          const String& s = results[currNode[0]].d_str;
-          if (s.isNumber())
-          {
-            results[currNode] = EvalResult(Rational(s.toNumber()));
-          }
-          else
-          {
-            results[currNode] = EvalResult(Rational(-1));
-          }
-          break;
+          ret = EvalResult(Rational(r));
         }
+      }
+      break;
+    }
 
-        case kind::STRING_CODE:
-        {
-          const String& s = results[currNode[0]].d_str;
-          if (s.size() == 1)
-          {
-            results[currNode] = EvalResult(
-                Rational(String::convertUnsignedIntToCode(s.getVec()[0])));
-          }
-          else
-          {
-            results[currNode] = EvalResult(Rational(-1));
-          }
-          break;
-        }
+    case kind::STRING_STRREPL:
+    {
+      const String& s = children[0]->d_str;
+      const String& x = children[1]->d_str;
+      const String& y = children[2]->d_str;
+      ret = EvalResult(s.replace(x, y));
+      break;
+    }
 
-        case kind::CONST_BITVECTOR:
-          results[currNode] = EvalResult(currNodeVal.getConst<BitVector>());
-          break;
+    case kind::STRING_PREFIX:
+    {
+      const String& t = children[0]->d_str;
+      const String& s = children[1]->d_str;
+      if (s.size() < t.size())
+      {
+        ret = EvalResult(false);
+      }
+      else
+      {
+        ret = EvalResult(s.prefix(t.size()) == t);
+      }
+      break;
+    }
 
-        case kind::BITVECTOR_NOT:
-          results[currNode] = EvalResult(~results[currNode[0]].d_bv);
-          break;
+    case kind::STRING_SUFFIX:
+    {
+      const String& t = children[0]->d_str;
+      const String& s = children[1]->d_str;
+      if (s.size() < t.size())
+      {
+        ret = EvalResult(false);
+      }
+      else
+      {
+        ret = EvalResult(s.suffix(t.size()) == t);
+      }
+      break;
+    }
 
-        case kind::BITVECTOR_NEG:
-          results[currNode] = EvalResult(-results[currNode[0]].d_bv);
-          break;
+    case kind::STRING_ITOS:
+    {
+      Integer i = children[0]->d_rat.getNumerator();
+      if (i.strictlyNegative())
+      {
+        ret = EvalResult(String(""));
+      }
+      else
+      {
+        ret = EvalResult(String(i.toString()));
+      }
+      break;
+    }
 
-        case kind::BITVECTOR_EXTRACT:
-        {
-          unsigned lo = bv::utils::getExtractLow(currNodeVal);
-          unsigned hi = bv::utils::getExtractHigh(currNodeVal);
-          results[currNode] =
-              EvalResult(results[currNode[0]].d_bv.extract(hi, lo));
-          break;
-        }
+    case kind::STRING_STOI:
+    {
+      const String& s = children[0]->d_str;
+      if (s.isNumber())
+      {
+        ret = EvalResult(Rational(s.toNumber()));
+      }
+      else
+      {
+        ret = EvalResult(Rational(-1));
+      }
+      break;
+    }
 
-        case kind::BITVECTOR_CONCAT:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res.concat(results[currNode[i]].d_bv);
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+    case kind::STRING_CODE:
+    {
+      const String& s = children[0]->d_str;
+      if (s.size() == 1)
+      {
+        ret = EvalResult(
+            Rational(String::convertUnsignedIntToCode(s.getVec()[0])));
+      }
+      else
+      {
+        ret = EvalResult(Rational(-1));
+      }
+      break;
+    }
 
-        case kind::BITVECTOR_PLUS:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res + results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+    case kind::CONST_BITVECTOR:
+      ret = EvalResult(currNodeVal.getConst<BitVector>());
+      break;
 
-        case kind::BITVECTOR_MULT:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res * results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-        case kind::BITVECTOR_AND:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res & results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+    case kind::BITVECTOR_NOT:
+      ret = EvalResult(~children[0]->d_bv);
+      break;
 
-        case kind::BITVECTOR_OR:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res | results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+    case kind::BITVECTOR_NEG:
+      ret = EvalResult(-children[0]->d_bv);
+      break;
 
-        case kind::BITVECTOR_XOR:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res ^ results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-        case kind::BITVECTOR_UDIV:
-        case kind::BITVECTOR_UDIV_TOTAL:
+    case kind::BITVECTOR_EXTRACT:
+    {
+      unsigned lo = bv::utils::getExtractLow(currNodeVal);
+      unsigned hi = bv::utils::getExtractHigh(currNodeVal);
+      ret =
+          EvalResult(children[0]->d_bv.extract(hi, lo));
+      break;
+    }
+
+    case kind::BITVECTOR_CONCAT:
+    {
+      BitVector res = children[0]->d_bv;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res.concat(children[i]->d_bv);
+      }
+      ret = EvalResult(res);
+      break;
+    }
+
+    case kind::BITVECTOR_PLUS:
+    {
+      BitVector res = children[0]->d_bv;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res + children[i]->d_bv;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+
+    case kind::BITVECTOR_MULT:
+    {
+      BitVector res = children[0]->d_bv;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res * children[i]->d_bv;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+    case kind::BITVECTOR_AND:
+    {
+      BitVector res = children[0]->d_bv;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res & children[i]->d_bv;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+
+    case kind::BITVECTOR_OR:
+    {
+      BitVector res = children[0]->d_bv;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res | children[i]->d_bv;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+
+    case kind::BITVECTOR_XOR:
+    {
+      BitVector res = children[0]->d_bv;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res ^ children[i]->d_bv;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+    case kind::BITVECTOR_UDIV:
+    case kind::BITVECTOR_UDIV_TOTAL:
+    {
+      if (currNodeVal.getKind() == kind::BITVECTOR_UDIV_TOTAL
+          || children[1]->d_bv.getValue() != 0)
+      {
+        BitVector res = children[0]->d_bv;
+        res = res.unsignedDivTotal(children[1]->d_bv);
+        ret = EvalResult(res);
+      }
+      else
+      {
+        ret = EvalResult();
+      }
+      break;
+    }
+    case kind::BITVECTOR_UREM:
+    case kind::BITVECTOR_UREM_TOTAL:
+    {
+      if (currNodeVal.getKind() == kind::BITVECTOR_UREM_TOTAL
+          || children[1]->d_bv.getValue() != 0)
+      {
+        BitVector res = children[0]->d_bv;
+        res = res.unsignedRemTotal(children[1]->d_bv);
+        ret = EvalResult(res);
+      }
+      else
+      {
+        ret = EvalResult();
+      }
+      break;
+    }
+
+    case kind::EQUAL:
+    {
+      EvalResult lhs = *children[0];
+      EvalResult rhs = *children[1];
+
+      switch (lhs.d_tag)
+      {
+        case EvalResult::BOOL:
         {
-          if (currNodeVal.getKind() == kind::BITVECTOR_UDIV_TOTAL
-              || results[currNode[1]].d_bv.getValue() != 0)
-          {
-            BitVector res = results[currNode[0]].d_bv;
-            res = res.unsignedDivTotal(results[currNode[1]].d_bv);
-            results[currNode] = EvalResult(res);
-          }
-          else
-          {
-            results[currNode] = EvalResult();
-            evalAsNode[currNode] =
-                needsReconstruct ? reconstruct(currNode, results, evalAsNode)
-                                 : currNodeVal;
-          }
+          ret = EvalResult(lhs.d_bool == rhs.d_bool);
           break;
         }
-        case kind::BITVECTOR_UREM:
-        case kind::BITVECTOR_UREM_TOTAL:
+
+        case EvalResult::BITVECTOR:
         {
-          if (currNodeVal.getKind() == kind::BITVECTOR_UREM_TOTAL
-              || results[currNode[1]].d_bv.getValue() != 0)
-          {
-            BitVector res = results[currNode[0]].d_bv;
-            res = res.unsignedRemTotal(results[currNode[1]].d_bv);
-            results[currNode] = EvalResult(res);
-          }
-          else
-          {
-            results[currNode] = EvalResult();
-            evalAsNode[currNode] =
-                needsReconstruct ? reconstruct(currNode, results, evalAsNode)
-                                 : currNodeVal;
-          }
+          ret = EvalResult(lhs.d_bv == rhs.d_bv);
           break;
         }
 
-        case kind::EQUAL:
+        case EvalResult::RATIONAL:
         {
-          EvalResult lhs = results[currNode[0]];
-          EvalResult rhs = results[currNode[1]];
-
-          switch (lhs.d_tag)
-          {
-            case EvalResult::BOOL:
-            {
-              results[currNode] = EvalResult(lhs.d_bool == rhs.d_bool);
-              break;
-            }
-
-            case EvalResult::BITVECTOR:
-            {
-              results[currNode] = EvalResult(lhs.d_bv == rhs.d_bv);
-              break;
-            }
-
-            case EvalResult::RATIONAL:
-            {
-              results[currNode] = EvalResult(lhs.d_rat == rhs.d_rat);
-              break;
-            }
-
-            case EvalResult::STRING:
-            {
-              results[currNode] = EvalResult(lhs.d_str == rhs.d_str);
-              break;
-            }
-
-            default:
-            {
-              Trace("evaluator") << "Theory " << Theory::theoryOf(currNode[0])
-                                 << " not supported" << std::endl;
-              results[currNode] = EvalResult();
-              evalAsNode[currNode] =
-                  needsReconstruct ? reconstruct(currNode, results, evalAsNode)
-                                   : currNodeVal;
-              break;
-            }
-          }
-
+          ret = EvalResult(lhs.d_rat == rhs.d_rat);
           break;
         }
 
-        case kind::ITE:
+        case EvalResult::STRING:
         {
-          if (results[currNode[0]].d_bool)
-          {
-            results[currNode] = results[currNode[1]];
-          }
-          else
-          {
-            results[currNode] = results[currNode[2]];
-          }
+          ret = EvalResult(lhs.d_str == rhs.d_str);
           break;
         }
 
         default:
         {
-          Trace("evaluator") << "Kind " << currNodeVal.getKind()
+          Trace("evaluator") << "Theory " << Theory::theoryOf(currNode[0])
                              << " not supported" << std::endl;
-          results[currNode] = EvalResult();
-          evalAsNode[currNode] =
-              needsReconstruct ? reconstruct(currNode, results, evalAsNode)
-                               : currNodeVal;
+          ret = EvalResult();
+          break;
         }
       }
+
+      break;
     }
-  }
 
-  return results[n];
+    case kind::ITE:
+    {
+      if (children[0]->d_bool)
+      {
+        ret = *children[1];
+      }
+      else
+      {
+        ret = *children[2];
+      }
+      break;
+    }
+
+    default:
+    {
+      Trace("evaluator") << "Kind " << currNodeVal.getKind()
+                         << " not supported" << std::endl;
+      ret = EvalResult();
+    }
+  }
+  return ret;
 }
 
 Node Evaluator::reconstruct(
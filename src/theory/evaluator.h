@@ -95,6 +95,23 @@ class Evaluator
   Node eval(TNode n,
             const std::vector<Node>& args,
             const std::vector<Node>& vals) const;
+  /**
+   * Evaluates node `n` under each of the substitutions described by the
+   * variable names `args` and the values `points[i]`, and appends the results
+   * to `res` in the order of the points. The result for each point is the
+   * same as that of `eval(n, args, points[i])`.
+   *
+   * Node `n` is compiled once into a list of its subterms in post-order, which
+   * is then run on each point with a single vector of EvalResult, without any
+   * hash map lookups. Points for which some subterm of `n` does not evaluate
+   * to a supported constant, and all points when `n` contains a subterm that
+   * is not supported by the compiled list (e.g. an application of a lambda),
+   * are evaluated with the method above.
+   */
+  void eval(TNode n,
+            const std::vector<Node>& args,
+            const std::vector<std::vector<Node>>& points,
+            std::vector<Node>& res) const;
 
  private:
   /**
@@ -118,6 +135,19 @@ class Evaluator
       const std::vector<Node>& args,
       const std::vector<Node>& vals,
       std::unordered_map<TNode, Node, NodeHashFunction>& evalAsNode) const;
+  /**
+   * Evaluates node `currNode`, whose value under the substitution is
+   * `currNodeVal`, from the results of the evaluation of its children. This
+   * method is the step of the evaluation that is shared by the methods above.
+   * Notice that `currNodeVal` differs from `currNode` if `currNode` is a
+   * variable, or if it was reconstructed from its children.
+   *
+   * The method returns an invalid EvalResult if `currNodeVal` has a kind that
+   * is not supported, or if its value cannot be represented as an EvalResult.
+   */
+  EvalResult evalNode(TNode currNode,
+                      TNode currNodeVal,
+                      const std::vector<const EvalResult*>& children) const;
   /** reconstruct
    *
    * This function reconstructs the result of evaluating n using a combination
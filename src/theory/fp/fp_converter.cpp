@@ -924,6 +924,34 @@ Node FpConverter::convert(TNode node)
         }
         else
         {
+          opCache::const_iterator itc = d_opCache.find(current);
+          if (itc != d_opCache.end())
+          {
+            // The operation was encoded in a previous user context. Its
+            // arguments are converted again, which adds the assertions of the
+            // leaves below it to the current user context.
+            bool recurseNeeded = false;
+            for (const Node& cc : current)
+            {
+              TypeNode tc = cc.getType();
+              if ((tc.isRoundingMode() && r.find(cc) == r.end())
+                  || (tc.isFloatingPoint() && f.find(cc) == f.end()))
+              {
+                if (!recurseNeeded)
+                {
+                  workStack.push_back(current);
+                  recurseNeeded = true;
+                }
+                workStack.push_back(cc);
+              }
+            }
+            if (recurseNeeded)
+            {
+              continue;  // i.e. recurse!
+            }
+            f.insert(current, itc->second);
+            continue;
+          }
           switch (current.getKind())
           {
             case kind::CONST_FLOATINGPOINT:
@@ -1310,6 +1338,14 @@ Node FpConverter::convert(TNode node)
               Unreachable() << "Unknown kind of type FloatingPoint";
               break;
           }
+          // remember the encoding of the operation for other user contexts,
+          // unless its encoding relies on an additional assertion
+          fpMap::const_iterator itf = f.find(current);
+          if (itf != f.end()
+              && current.getKind() != kind::FLOATINGPOINT_TO_FP_REAL)
+          {
+            d_opCache.insert(std::pair<Node, uf>(current, (*itf).second));
+          }
         }
       }
       // Returns a floating-point type so don't alter the return value
@@ -21,6 +21,8 @@
 #ifndef CVC4__THEORY__FP__FP_CONVERTER_H
 #define CVC4__THEORY__FP__FP_CONVERTER_H
 
+#include <unordered_map>
+
 #include "base/check.h"
 #include "context/cdhashmap.h"
 #include "context/cdlist.h"
@@ -324,6 +326,18 @@ class FpConverter
   ubvMap u;
   sbvMap s;
 
+  typedef std::unordered_map<Node, uf, NodeHashFunction> opCache;
+  /**
+   * The encodings of floating-point operations, which unlike the maps above
+   * persist across user contexts. Since the encoding of an operation is a
+   * function of the encodings of its arguments, and the encodings of leaves
+   * are the same in each user context, the encoding of an operation that is
+   * converted again after a pop can be reused. Only the additional assertions
+   * of its leaves must be added again, which is ensured by converting its
+   * arguments.
+   */
+  opCache d_opCache;
+
   /* These functions take a symfpu object and convert it to a node.
    * These should ensure that constant folding it will give a
    * constant of the right type.
@@ -119,6 +119,9 @@ TheoryFp::TheoryFp(context::Context *c,
       d_toRealMap(u),
       realToFloatMap(u),
       floatToRealMap(u),
+      d_divMap(u),
+      d_sqrtMap(u),
+      d_fmaMap(u),
       abstractionMap(u)
 {
   // Kinds that are to be handled in the congruence closure
@@ -394,6 +397,149 @@ Node TheoryFp::abstractFloatToReal(Node node)
   return uf;
 }
 
+Node TheoryFp::abstractArith(Node node)
+{
+  Kind k = node.getKind();
+  Assert(k == kind::FLOATINGPOINT_DIV || k == kind::FLOATINGPOINT_SQRT
+         || k == kind::FLOATINGPOINT_FMA);
+  TypeNode t(node.getType());
+  Assert(t.getKind() == kind::FLOATINGPOINT_TYPE);
+
+  conversionAbstractionMap &ufMap =
+      k == kind::FLOATINGPOINT_DIV
+          ? d_divMap
+          : (k == kind::FLOATINGPOINT_SQRT ? d_sqrtMap : d_fmaMap);
+
+  NodeManager *nm = NodeManager::currentNM();
+  ComparisonUFMap::const_iterator i(ufMap.find(t));
+
+  Node fun;
+  if (i == ufMap.end())
+  {
+    std::vector<TypeNode> args;
+    for (const Node &nc : node)
+    {
+      args.push_back(nc.getType());
+    }
+    const char *name = k == kind::FLOATINGPOINT_DIV
+                           ? "floatingpoint_abstract_div"
+                           : (k == kind::FLOATINGPOINT_SQRT
+                                  ? "floatingpoint_abstract_sqrt"
+                                  : "floatingpoint_abstract_fma");
+    fun = nm->mkSkolem(name,
+                       nm->mkFunctionType(args, t),
+                       name,
+                       NodeManager::SKOLEM_EXACT_NAME);
+    ufMap.insert(t, fun);
+  }
+  else
+  {
+    fun = (*i).second;
+  }
+  std::vector<Node> children;
+  children.push_back(fun);
+  children.insert(children.end(), node.begin(), node.end());
+  Node uf = nm->mkNode(kind::APPLY_UF, children);
+
+  abstractionMap.insert(uf, node);
+
+  return uf;
+}
+
+void TheoryFp::sendArithAbstractionLemmas(Node abstract, Node node)
+{
+  NodeManager *nm = NodeManager::currentNM();
+  Kind k = node.getKind();
+
+  Node resNaN = nm->mkNode(kind::FLOATINGPOINT_ISNAN, abstract);
+  std::vector<Node> nan;
+  std::vector<Node> isZero;
+  std::vector<Node> isInf;
+  std::vector<Node> isNeg;
+  for (size_t i = 1, nchild = node.getNumChildren(); i < nchild; ++i)
+  {
+    nan.push_back(nm->mkNode(kind::FLOATINGPOINT_ISNAN, node[i]));
+    isZero.push_back(nm->mkNode(kind::FLOATINGPOINT_ISZ, node[i]));
+    isInf.push_back(nm->mkNode(kind::FLOATINGPOINT_ISINF, node[i]));
+    isNeg.push_back(nm->mkNode(kind::FLOATINGPOINT_ISNEG, node[i]));
+  }
+
+  if (k == kind::FLOATINGPOINT_DIV)
+  {
+    // NaN exactly when an argument is NaN, 0/0 or inf/inf
+    Node n = nm->mkNode(kind::OR,
+                        nan[0],
+                        nan[1],
+                        nm->mkNode(kind::AND, isZero[0], isZero[1]),
+                        nm->mkNode(kind::AND, isInf[0], isInf[1]));
+    handleLemma(nm->mkNode(kind::EQUAL, resNaN, n));
+
+    // Otherwise, the sign is the exclusive or of the signs of the arguments
+    Node sign = nm->mkNode(
+        kind::IMPLIES,
+        resNaN.negate(),
+        nm->mkNode(kind::EQUAL,
+                   nm->mkNode(kind::FLOATINGPOINT_ISNEG, abstract),
+                   nm->mkNode(kind::XOR, isNeg[0], isNeg[1])));
+    handleLemma(sign);
+
+    // Special values
+    Node resInf = nm->mkNode(kind::FLOATINGPOINT_ISINF, abstract);
+    Node resZero = nm->mkNode(kind::FLOATINGPOINT_ISZ, abstract);
+    handleLemma(nm->mkNode(
+        kind::IMPLIES,
+        nm->mkNode(kind::AND, isInf[0], isInf[1].negate(), nan[1].negate()),
+        resInf));
+    handleLemma(nm->mkNode(
+        kind::IMPLIES,
+        nm->mkNode(kind::AND, isZero[1], isZero[0].negate(), nan[0].negate()),
+        resInf));
+    handleLemma(nm->mkNode(
+        kind::IMPLIES,
+        nm->mkNode(kind::AND, isZero[0], isZero[1].negate(), nan[1].negate()),
+        resZero));
+    handleLemma(nm->mkNode(
+        kind::IMPLIES,
+        nm->mkNode(kind::AND, isInf[1], isInf[0].negate(), nan[0].negate()),
+        resZero));
+  }
+  else if (k == kind::FLOATINGPOINT_SQRT)
+  {
+    // NaN exactly when the argument is NaN or negative and non-zero
+    Node n = nm->mkNode(kind::OR,
+                        nan[0],
+                        nm->mkNode(kind::AND, isNeg[0], isZero[0].negate()));
+    handleLemma(nm->mkNode(kind::EQUAL, resNaN, n));
+
+    // The square root of positive arguments is positive
+    handleLemma(
+        nm->mkNode(kind::IMPLIES,
+                   nm->mkNode(kind::FLOATINGPOINT_ISPOS, node[1]),
+                   nm->mkNode(kind::FLOATINGPOINT_ISPOS, abstract)));
+
+    // Zeros and infinities are fixed points
+    Node fixed = nm->mkNode(
+        kind::OR,
+        isZero[0],
+        nm->mkNode(kind::AND, isInf[0], isNeg[0].negate()));
+    handleLemma(nm->mkNode(
+        kind::IMPLIES, fixed, nm->mkNode(kind::EQUAL, abstract, node[1])));
+  }
+  else
+  {
+    Assert(k == kind::FLOATINGPOINT_FMA);
+    // NaN when an argument is NaN or the product is inf * 0
+    Node n = nm->mkNode(kind::OR,
+                        nan[0],
+                        nan[1],
+                        nan[2],
+                        nm->mkNode(kind::OR,
+                                   nm->mkNode(kind::AND, isInf[0], isZero[1]),
+                                   nm->mkNode(kind::AND, isZero[0], isInf[1])));
+    handleLemma(nm->mkNode(kind::IMPLIES, n, resNaN));
+  }
+}
+
 Node TheoryFp::expandDefinition(LogicRequest &lr, Node node)
 {
   Trace("fp-expandDefinition") << "TheoryFp::expandDefinition(): " << node
@@ -449,6 +595,13 @@ Node TheoryFp::expandDefinition(LogicRequest &lr, Node node)
   {
     enableUF(lr);
   }
+  else if (options::fpLazyArith()
+           && (res.getKind() == kind::FLOATINGPOINT_DIV
+               || res.getKind() == kind::FLOATINGPOINT_SQRT
+               || res.getKind() == kind::FLOATINGPOINT_FMA))
+  {
+    enableUF(lr);
+  }
 
   if (res != node) {
     Trace("fp-expandDefinition") << "TheoryFp::expandDefinition(): " << node
@@ -511,6 +664,16 @@ Node TheoryFp::ppRewrite(TNode node)
     // TODO : rounding-mode specific bounds on floats that don't give infinity
     // BEWARE of directed rounding!   #1914
   }
+  else if (options::fpLazyArith()
+           && (node.getKind() == kind::FLOATINGPOINT_DIV
+               || node.getKind() == kind::FLOATINGPOINT_SQRT
+               || node.getKind() == kind::FLOATINGPOINT_FMA))
+  {
+    // Abstract the expensive operations, they are bit-blasted only if the
+    // model violates them, see refineAbstraction
+    res = abstractArith(node);
+    sendArithAbstractionLemmas(res, node);
+  }
 
   if (res != node)
   {
@@ -734,6 +897,48 @@ bool TheoryFp::refineAbstraction(TheoryModel *m, TNode abstract, TNode concrete)
       return false;
     }
   }
+  else if (k == kind::FLOATINGPOINT_DIV || k == kind::FLOATINGPOINT_SQRT
+           || k == kind::FLOATINGPOINT_FMA)
+  {
+    // Get the values
+    Assert(m->hasTerm(abstract));
+    Node abstractValue = m->getValue(abstract);
+    Assert(abstractValue.isConst());
+
+    // Work out the actual value for those args
+    NodeManager *nm = NodeManager::currentNM();
+    std::vector<Node> values;
+    for (const Node &nc : concrete)
+    {
+      Node v = m->getValue(nc);
+      Assert(v.isConst());
+      values.push_back(v);
+    }
+    Node concreteValue = Rewriter::rewrite(nm->mkNode(k, values));
+    Assert(concreteValue.isConst());
+
+    Trace("fp-refineAbstraction")
+        << "TheoryFp::refineAbstraction(): " << abstract << " = "
+        << abstractValue << std::endl
+        << "TheoryFp::refineAbstraction(): " << concrete << " = "
+        << concreteValue << std::endl;
+
+    if (abstractValue != concreteValue)
+    {
+      // The instance is violated, hence we bit-blast the operation. The lemma
+      // is not preprocessed, since that would abstract concrete again.
+      Node lem = nm->mkNode(kind::EQUAL, abstract, concrete);
+      Trace("fp") << "TheoryFp::refineAbstraction(): asserting " << lem
+                  << std::endl;
+      d_out->lemma(lem, false, false);
+      return true;
+    }
+    else
+    {
+      // No refinement needed
+      return false;
+    }
+  }
   else
   {
     Unreachable() << "Unknown abstraction";
@@ -137,6 +137,20 @@ class TheoryFp : public Theory {
   Node abstractRealToFloat(Node);
   Node abstractFloatToReal(Node);
 
+  /** Uninterpretted functions for lazy handling of div, sqrt and fma */
+  conversionAbstractionMap d_divMap;
+  conversionAbstractionMap d_sqrtMap;
+  conversionAbstractionMap d_fmaMap;
+
+  /**
+   * Abstract the division, square root or fused multiply-add node by an
+   * application of an uninterpreted function, which is refined to node when
+   * the model violates it (see option fpLazyArith).
+   */
+  Node abstractArith(Node node);
+  /** Send the cheap lemmas about the abstraction abstract of node */
+  void sendArithAbstractionLemmas(Node abstract, Node node);
+
   typedef context::CDHashMap<Node, Node, NodeHashFunction> abstractionMapType;
   abstractionMapType abstractionMap;  // abstract -> original
 
@@ -59,21 +59,6 @@ IDLAssertion::IDLAssertion(const IDLAssertion& other)
 , d_original(other.d_original)
 {}
 
-bool IDLAssertion::propagate(IDLModel& model) const {
-  Debug("theory::idl::model") << model << std::endl;
-  Assert(ok());
-  // Should be d_x - d_y <= d_c, or d_x - d_c <= d_y
-  Integer x_value = model.getValue(d_x);
-  Integer y_value = model.getValue(d_y);
-  if (x_value - y_value > d_c) {
-    model.setValue(d_y, x_value - d_c, IDLReason(d_x, d_original));
-    Debug("theory::idl::model") << model << std::endl;
-    return true;
-  } else {
-    return false;
-  }
-}
-
 void IDLAssertion::toStream(std::ostream& out) const {
   out << "IDL[" << d_x << " - " << d_y << " " << d_op << " " << d_c << "]";
 }
@@ -17,7 +17,8 @@
 
 #pragma once
 
-#include "theory/idl/idl_model.h"
+#include "expr/node.h"
+#include "util/integer.h"
 
 namespace CVC4 {
 namespace theory {
@@ -58,19 +59,7 @@ public:
   TNode getY() const { return d_y; }
   Kind getOp() const { return d_op;}
   Integer getC() const { return d_c; }
-
-  /**
-   * Propagate the constraint using the model. For example, if the constraint
-   * is of the form x - y <= -1, and the value of x in the model is 0, then
-   *
-   *   (x - y <= -1) and (x = 0) implies y >= x + 1 = 1
-   *
-   * If the value of y is less then 1, is is set to 1 and true is returned. If
-   * the value of y is 1 or more, than false is return.
-   *
-   * @return true if value of y was updated
-   */
-  bool propagate(IDLModel& model) const;
+  TNode getOriginal() const { return d_original; }
 
   /** Is this constraint proper */
   bool ok() const {
@@ -0,0 +1,264 @@
+/*********************                                                        */
+/*! \file idl_graph.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The constraint graph of the IDL solver.
+ **
+ ** The constraint graph of the IDL solver, with incremental negative cycle
+ ** detection and theory propagation of implied constraints.
+ **/
+
+#include "theory/idl/idl_graph.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+using namespace CVC4;
+using namespace theory;
+using namespace idl;
+
+namespace {
+
+/** A vertex in the queue of a search, by increasing distance */
+typedef std::pair<Integer, unsigned> QueueElement;
+typedef std::priority_queue<QueueElement, std::vector<QueueElement>,
+                            std::greater<QueueElement> > SearchQueue;
+
+/** Predecessor of the start of a search */
+const unsigned NO_EDGE = -1;
+
+}/* anonymous namespace */
+
+void IDLGraph::Search::resize(unsigned n) {
+  d_stamp.resize(n, 0);
+  d_distance.resize(n);
+  d_predecessor.resize(n, NO_EDGE);
+  d_settled.resize(n, false);
+}
+
+void IDLGraph::Search::clear() {
+  if (++d_current == 0) {
+    // The stamps wrapped around, old ones could match again
+    std::fill(d_stamp.begin(), d_stamp.end(), 0);
+    d_current = 1;
+  }
+}
+
+void IDLGraph::Search::visit(unsigned v, const Integer& distance, unsigned predecessor) {
+  if (d_stamp[v] != d_current) {
+    d_stamp[v] = d_current;
+    d_settled[v] = false;
+  }
+  d_distance[v] = distance;
+  d_predecessor[v] = predecessor;
+}
+
+IDLGraph::IDLGraph(context::Context* c)
+: d_edgesSize(c, 0)
+{
+  // The zero vertex
+  getVertex(TNode::null());
+}
+
+unsigned IDLGraph::getVertex(TNode var) {
+  std::unordered_map<Node, unsigned, NodeHashFunction>::const_iterator find = d_vertices.find(var);
+  if (find != d_vertices.end()) {
+    return (*find).second;
+  }
+  unsigned v = d_vertexVariables.size();
+  d_vertices[var] = v;
+  d_vertexVariables.push_back(var);
+  d_potential.push_back(Integer(0));
+  d_outgoing.push_back(std::vector<unsigned>());
+  d_incoming.push_back(std::vector<unsigned>());
+  d_atoms.push_back(std::vector<Atom>());
+  d_forward.resize(v + 1);
+  d_backward.resize(v + 1);
+  return v;
+}
+
+void IDLGraph::backtrack() {
+  // The edges are removed in the reverse order of their addition, so each one
+  // is the last in the lists of its vertices
+  while (d_edges.size() > d_edgesSize) {
+    const Edge& e = d_edges.back();
+    Assert(d_outgoing[e.d_source].back() == d_edges.size() - 1);
+    Assert(d_incoming[e.d_target].back() == d_edges.size() - 1);
+    d_outgoing[e.d_source].pop_back();
+    d_incoming[e.d_target].pop_back();
+    d_edges.pop_back();
+  }
+}
+
+bool IDLGraph::addEdge(unsigned u, unsigned v, const Integer& w, TNode label,
+                       std::vector<TNode>& conflict) {
+  Debug("theory::idl::graph") << "IDLGraph::addEdge(" << u << " -> " << v
+                              << ", " << w << ", " << label << ")" << std::endl;
+  backtrack();
+
+  // How much the new edge lowers the potential of its target
+  Integer gamma = d_potential[u] + w - d_potential[v];
+  if (u == v && gamma < 0) {
+    // A negative self loop
+    conflict.push_back(label);
+    return false;
+  }
+
+  if (gamma < 0) {
+    // Vertices whose potential must be lowered, by how much (negative), and
+    // the edge that forces it. The new edge is the predecessor of v.
+    unsigned newEdge = d_edges.size();
+    SearchQueue queue;
+    d_forward.clear();
+    d_forward.visit(v, gamma, newEdge);
+    queue.push(QueueElement(gamma, v));
+
+    // The new potentials, only applied if there is no cycle
+    std::vector<std::pair<unsigned, Integer> > updates;
+
+    while (!queue.empty()) {
+      QueueElement top = queue.top();
+      queue.pop();
+      unsigned s = top.second;
+      if (d_forward.d_settled[s] || top.first != d_forward.d_distance[s]) {
+        // Stale entry
+        continue;
+      }
+      d_forward.d_settled[s] = true;
+      Integer sPotential = d_potential[s] + d_forward.d_distance[s];
+      updates.push_back(std::make_pair(s, sPotential));
+
+      const std::vector<unsigned>& outgoing = d_outgoing[s];
+      for (unsigned i = 0; i < outgoing.size(); ++i) {
+        const Edge& e = d_edges[outgoing[i]];
+        unsigned t = e.d_target;
+        Integer tGamma = sPotential + e.d_weight - d_potential[t];
+        if (tGamma >= 0) {
+          // The constraint still holds
+          continue;
+        }
+        if (t == u) {
+          // Back to the source, the cycle is the new edge and the path to s
+          conflict.push_back(label);
+          conflict.push_back(e.d_label);
+          while (s != v) {
+            const Edge& p = d_edges[d_forward.d_predecessor[s]];
+            conflict.push_back(p.d_label);
+            s = p.d_source;
+          }
+          Debug("theory::idl::graph") << "IDLGraph::addEdge(): cycle of size "
+                                      << conflict.size() << std::endl;
+          return false;
+        }
+        if (d_forward.visited(t)
+            && (d_forward.d_settled[t] || d_forward.d_distance[t] <= tGamma)) {
+          continue;
+        }
+        d_forward.visit(t, tGamma, outgoing[i]);
+        queue.push(QueueElement(tGamma, t));
+      }
+    }
+
+    for (unsigned i = 0; i < updates.size(); ++i) {
+      d_potential[updates[i].first] = updates[i].second;
+    }
+  }
+
+  unsigned id = d_edges.size();
+  d_edges.push_back(Edge(u, v, w, label));
+  d_outgoing[u].push_back(id);
+  d_incoming[v].push_back(id);
+  d_edgesSize = d_edges.size();
+  return true;
+}
+
+void IDLGraph::addAtom(unsigned u, unsigned v, const Integer& w, TNode literal) {
+  d_atoms[u].push_back(Atom(v, w, literal));
+}
+
+void IDLGraph::search(unsigned start, bool backward, unsigned limit,
+                      Search& data, std::vector<unsigned>& settled) {
+  SearchQueue queue;
+  data.clear();
+  data.visit(start, Integer(0), NO_EDGE);
+  queue.push(QueueElement(Integer(0), start));
+
+  while (!queue.empty() && settled.size() < limit) {
+    QueueElement top = queue.top();
+    queue.pop();
+    unsigned s = top.second;
+    if (data.d_settled[s] || top.first != data.d_distance[s]) {
+      continue;
+    }
+    data.d_settled[s] = true;
+    settled.push_back(s);
+
+    const std::vector<unsigned>& edges = backward ? d_incoming[s] : d_outgoing[s];
+    for (unsigned i = 0; i < edges.size(); ++i) {
+      const Edge& e = d_edges[edges[i]];
+      unsigned t = backward ? e.d_source : e.d_target;
+      Integer reduced = d_potential[e.d_source] + e.d_weight - d_potential[e.d_target];
+      Assert(reduced >= 0);
+      Integer distance = data.d_distance[s] + reduced;
+      if (data.visited(t)
+          && (data.d_settled[t] || data.d_distance[t] <= distance)) {
+        continue;
+      }
+      data.visit(t, distance, edges[i]);
+      queue.push(QueueElement(distance, t));
+    }
+  }
+}
+
+void IDLGraph::getImplied(unsigned limit,
+                          std::vector<std::pair<TNode, std::vector<TNode> > >& implied) {
+  backtrack();
+  Assert(!d_edges.empty());
+  const Edge& edge = d_edges.back();
+  unsigned u = edge.d_source;
+  unsigned v = edge.d_target;
+
+  // The vertices reachable from v, and the ones reaching u
+  std::vector<unsigned> targets, sources;
+  search(v, false, limit, d_forward, targets);
+  search(u, true, limit, d_backward, sources);
+
+  for (unsigned i = 0; i < sources.size(); ++i) {
+    unsigned x = sources[i];
+    // The reduced costs of a path differ from its weight by the potentials of
+    // its ends
+    Integer xu = d_backward.d_distance[x] - d_potential[x] + d_potential[u];
+    const std::vector<Atom>& atoms = d_atoms[x];
+    for (unsigned j = 0; j < atoms.size(); ++j) {
+      const Atom& atom = atoms[j];
+      unsigned y = atom.d_target;
+      if (!d_forward.visited(y)) {
+        continue;
+      }
+      Integer vy = d_forward.d_distance[y] - d_potential[v] + d_potential[y];
+      if (xu + edge.d_weight + vy > atom.d_weight) {
+        continue;
+      }
+      // The path x -> u -> v -> y implies the atom
+      std::vector<TNode> explanation;
+      for (unsigned s = x; s != u; ) {
+        const Edge& p = d_edges[d_backward.d_predecessor[s]];
+        explanation.push_back(p.d_label);
+        s = p.d_target;
+      }
+      explanation.push_back(edge.d_label);
+      for (unsigned t = y; t != v; ) {
+        const Edge& p = d_edges[d_forward.d_predecessor[t]];
+        explanation.push_back(p.d_label);
+        t = p.d_source;
+      }
+      implied.push_back(std::make_pair(TNode(atom.d_literal), explanation));
+    }
+  }
+}
@@ -0,0 +1,174 @@
+/*********************                                                        */
+/*! \file idl_graph.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The constraint graph of the IDL solver.
+ **
+ ** The constraint graph of the IDL solver, with incremental negative cycle
+ ** detection and theory propagation of implied constraints.
+ **/
+
+#pragma once
+
+#include "cvc4_private.h"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "context/cdo.h"
+#include "expr/node.h"
+#include "util/integer.h"
+
+namespace CVC4 {
+namespace theory {
+namespace idl {
+
+/**
+ * The graph of the asserted difference constraints: each constraint
+ * (v - u <= w) is an edge u -> v of weight w, labelled with the literal it
+ * comes from. Constant bounds are edges from or to the zero vertex 0, which
+ * stands for the constant 0.
+ *
+ * The graph maintains a potential function pi such that pi(v) <= pi(u) + w
+ * for every edge, so that pi - pi(0) is a model of the constraints. Adding an
+ * edge only updates the potential of the vertices whose constraints it
+ * violates, with a Dijkstra search on the reduced costs pi(u) + w - pi(v),
+ * which are non-negative (Cotton and Maler, "Fast and Flexible Difference
+ * Constraint Propagation for DPLL(T)", SAT 2006). If the search comes back
+ * to the source of the new edge, the edge closes a negative cycle and the
+ * labels of the cycle are a minimal conflict. The same reduced costs are used
+ * to find the registered constraints that are implied by a new edge.
+ *
+ * The edges are context dependent, and are removed lazily when the context is
+ * popped. The potential is not: since removing edges only relaxes the
+ * constraints, it stays a model of the remaining ones.
+ */
+class IDLGraph {
+
+  /** An edge u -> v, for the constraint v - u <= w */
+  struct Edge {
+    unsigned d_source;
+    unsigned d_target;
+    Integer d_weight;
+    Node d_label;
+    Edge(unsigned source, unsigned target, const Integer& weight, TNode label)
+    : d_source(source), d_target(target), d_weight(weight), d_label(label)
+    {}
+  };
+
+  /** A registered constraint, which can be propagated if implied */
+  struct Atom {
+    unsigned d_target;
+    Integer d_weight;
+    Node d_literal;
+    Atom(unsigned target, const Integer& weight, TNode literal)
+    : d_target(target), d_weight(weight), d_literal(literal)
+    {}
+  };
+
+  /** The variables of the vertices, null for the zero vertex */
+  std::vector<Node> d_vertexVariables;
+
+  /** Map from variables to their vertices */
+  std::unordered_map<Node, unsigned, NodeHashFunction> d_vertices;
+
+  /** The potential of the vertices */
+  std::vector<Integer> d_potential;
+
+  /** All edges, in the order they were added */
+  std::vector<Edge> d_edges;
+
+  /** The number of edges of the current context */
+  context::CDO<unsigned> d_edgesSize;
+
+  /** The outgoing and the incoming edges of each vertex, by increasing id */
+  std::vector<std::vector<unsigned> > d_outgoing;
+  std::vector<std::vector<unsigned> > d_incoming;
+
+  /** The registered constraints, by source vertex */
+  std::vector<std::vector<Atom> > d_atoms;
+
+  /** The per vertex data of a search, valid if the stamp is current */
+  struct Search {
+    std::vector<unsigned> d_stamp;
+    std::vector<Integer> d_distance;
+    std::vector<unsigned> d_predecessor;
+    std::vector<bool> d_settled;
+    unsigned d_current;
+
+    Search() : d_current(1) {}
+    /** Make room for n vertices */
+    void resize(unsigned n);
+    /** Start a new search, invalidating the data of all vertices */
+    void clear();
+    /** Was the vertex reached by the current search */
+    bool visited(unsigned v) const { return d_stamp[v] == d_current; }
+    /** Set the distance of the vertex and the edge it was reached by */
+    void visit(unsigned v, const Integer& distance, unsigned predecessor);
+  };
+
+  /** The data of the searches from the target and the source of an edge */
+  Search d_forward;
+  Search d_backward;
+
+  /** Remove the edges of the popped contexts */
+  void backtrack();
+
+  /**
+   * Run a Dijkstra search from the vertex on the reduced costs, following the
+   * incoming edges if backward, and the outgoing ones otherwise, until limit
+   * vertices are settled. The settled vertices are added to settled.
+   */
+  void search(unsigned start, bool backward, unsigned limit, Search& data,
+              std::vector<unsigned>& settled);
+
+public:
+
+  /** Create an empty graph, with only the zero vertex */
+  IDLGraph(context::Context* c);
+
+  /** Get the vertex of the variable (the zero vertex if null) */
+  unsigned getVertex(TNode var);
+
+  /** The number of vertices */
+  unsigned getNumVertices() const { return d_vertexVariables.size(); }
+
+  /** The variable of the vertex (null for the zero vertex) */
+  TNode getVariable(unsigned v) const { return d_vertexVariables[v]; }
+
+  /** The value of the vertex in the model of the current constraints */
+  Integer getValue(unsigned v) const { return d_potential[v] - d_potential[0]; }
+
+  /**
+   * Add the edge u -> v for the constraint (v - u <= w) with the given label.
+   * Returns false if it closes a negative cycle, in which case the labels of
+   * the cycle are added to conflict and the edge is not added.
+   */
+  bool addEdge(unsigned u, unsigned v, const Integer& w, TNode label,
+               std::vector<TNode>& conflict);
+
+  /**
+   * Register the literal as standing for the constraint (v - u <= w), so that
+   * it is returned by getImplied() when it is implied.
+   */
+  void addAtom(unsigned u, unsigned v, const Integer& w, TNode literal);
+
+  /**
+   * Find the registered constraints implied by a path through the last
+   * added edge, looking at no more than limit vertices on either side of the
+   * edge. Each is returned with the labels of the path that implies it.
+   */
+  void getImplied(unsigned limit,
+                  std::vector<std::pair<TNode, std::vector<TNode> > >& implied);
+
+};/* class IDLGraph */
+
+}/* CVC4::theory::idl namespace */
+}/* CVC4::theory namespace */
+}/* CVC4 namespace */
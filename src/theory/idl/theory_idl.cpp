@@ -18,11 +18,10 @@
 #include "theory/idl/theory_idl.h"
 
 #include <set>
-#include <queue>
 
 #include "options/idl_options.h"
 #include "theory/rewriter.h"
-
+#include "theory/theory_model.h"
 
 using namespace std;
 
@@ -34,10 +33,42 @@ TheoryIdl::TheoryIdl(context::Context* c, context::UserContext* u,
                      OutputChannel& out, Valuation valuation,
                      const LogicInfo& logicInfo)
     : Theory(THEORY_ARITH, c, u, out, valuation, logicInfo)
-    , d_model(c)
-    , d_assertionsDB(c)
+    , d_graph(c)
+    , d_explanations(c)
 {}
 
+/** The conjunction of the distinct literals */
+static Node mkConjunction(const std::vector<TNode>& literals) {
+  std::set<TNode> distinct(literals.begin(), literals.end());
+  if (distinct.size() == 1) {
+    return *distinct.begin();
+  }
+  NodeBuilder<> conjunction(kind::AND);
+  for (std::set<TNode>::const_iterator it = distinct.begin(); it != distinct.end(); ++ it) {
+    conjunction << *it;
+  }
+  return conjunction;
+}
+
+void TheoryIdl::preRegisterTerm(TNode node) {
+  Kind k = node.getKind();
+  if (k != kind::LEQ && k != kind::LT && k != kind::GEQ && k != kind::GT) {
+    return;
+  }
+  IDLAssertion assertion(node);
+  if (!assertion.ok()) {
+    return;
+  }
+  Assert(assertion.getOp() == kind::LEQ);
+  Debug("theory::idl") << "TheoryIdl::preRegisterTerm(): " << assertion << std::endl;
+  // The atom is (x - y <= c), the edge y -> x, and its negation is
+  // (y - x <= -c - 1), the edge x -> y
+  unsigned x = d_graph.getVertex(assertion.getX());
+  unsigned y = d_graph.getVertex(assertion.getY());
+  d_graph.addAtom(y, x, assertion.getC(), node);
+  d_graph.addAtom(x, y, -assertion.getC() - 1, node.notNode());
+}
+
 Node TheoryIdl::ppRewrite(TNode atom) {
   if (atom.getKind() == kind::EQUAL  && options::idlRewriteEq()) {
     // If the option is turned on, each equality into two inequalities. This in
@@ -92,61 +123,70 @@ bool TheoryIdl::processAssertion(const IDLAssertion& assertion) {
 
   Debug("theory::idl") << "TheoryIdl::processAssertion(" << assertion << ")" << std::endl;
 
-  // Add the constraint (x - y op c) to the list assertions of x
-  d_assertionsDB.add(assertion, assertion.getX());
-
-  // Update the model, if forced by the assertion
-  bool y_updated = assertion.propagate(d_model);
-
-  // If the value of y was updated, we might need to update further
-  if (y_updated) {
-
-    std::queue<TNode> queue; // Queue of variables to consider
-    std::set<TNode> inQueue; // Current elements of the queue
-
-    // Add the first updated variable to the queue
-    queue.push(assertion.getY());
-    inQueue.insert(assertion.getY());
-
-    while (!queue.empty()) {
-      // Pop a new variable x off the queue
-      TNode x = queue.front();
-      queue.pop();
-      inQueue.erase(x);
-
-      // Go through the constraint (x - y op c), and update values of y
-      IDLAssertionDB::iterator it(d_assertionsDB, x);
-      while (!it.done()) {
-        // Get the assertion and update y
-        IDLAssertion x_y_assertion = it.get();
-        y_updated = x_y_assertion.propagate(d_model);
-        // If updated add to the queue
-        if (y_updated) {
-          // If the variable that we updated is the same as the first
-          // variable that we updated, it's a cycle of updates => conflict
-          if (x_y_assertion.getY() == assertion.getX()) {
-            std::vector<TNode> reasons;
-            d_model.getReasonCycle(x_y_assertion.getY(), reasons);
-            // Construct the reason of the conflict
-            Node conflict = NodeManager::currentNM()->mkNode(kind::AND, reasons);
-            d_out->conflict(conflict);
-            return false;
-          } else {
-            // No cycle, just a model update, so we add to the queue
-            TNode y = x_y_assertion.getY();
-            if (inQueue.count(y) == 0) {
-              queue.push(y);
-              inQueue.insert(x_y_assertion.getY());
-            }
-          }
-        }
-        // Go to the next constraint
-        it.next();
-      }
+  // The constraint (x - y <= c) is the edge y -> x, and an equality is also
+  // the edge x -> y for (y - x <= -c)
+  TNode x = assertion.getX();
+  TNode y = assertion.getY();
+  if (!addConstraint(y, x, assertion.getC(), assertion.getOriginal())) {
+    return false;
+  }
+  if (assertion.getOp() == kind::EQUAL) {
+    return addConstraint(x, y, -assertion.getC(), assertion.getOriginal());
+  }
+  return true;
+}
+
+bool TheoryIdl::addConstraint(TNode u, TNode v, const Integer& w, TNode assertion) {
+  std::vector<TNode> conflict;
+  bool ok = d_graph.addEdge(d_graph.getVertex(u), d_graph.getVertex(v), w, assertion, conflict);
+  if (!ok) {
+    // The new constraint closes a negative cycle
+    Node reason = mkConjunction(conflict);
+    Debug("theory::idl") << "TheoryIdl::addConstraint(): conflict " << reason << std::endl;
+    d_out->conflict(reason);
+    return false;
+  }
+
+  unsigned limit = options::idlPropagationLimit();
+  if (limit == 0) {
+    return true;
+  }
+  std::vector<std::pair<TNode, std::vector<TNode> > > implied;
+  d_graph.getImplied(limit, implied);
+  for (unsigned i = 0; i < implied.size(); ++ i) {
+    TNode literal = implied[i].first;
+    bool value;
+    if (!d_valuation.isSatLiteral(literal)
+        || d_valuation.hasSatValue(literal, value)
+        || d_explanations.find(literal) != d_explanations.end()) {
+      // Not in the SAT solver, or already assigned
+      continue;
+    }
+    d_explanations.insert(literal, mkConjunction(implied[i].second));
+    Debug("theory::idl") << "TheoryIdl::addConstraint(): propagating " << literal << std::endl;
+    if (!d_out->propagate(literal)) {
+      return false;
     }
   }
 
-  // Everything fine, no conflict
+  return true;
+}
+
+Node TheoryIdl::explain(TNode literal) {
+  explanation_map::const_iterator find = d_explanations.find(literal);
+  Assert(find != d_explanations.end());
+  return (*find).second;
+}
+
+bool TheoryIdl::collectModelInfo(TheoryModel* m) {
+  NodeManager* nm = NodeManager::currentNM();
+  // The zero vertex has no variable
+  for (unsigned v = 1; v < d_graph.getNumVertices(); ++ v) {
+    Node value = nm->mkConst(Rational(d_graph.getValue(v)));
+    if (!m->assertEquality(d_graph.getVariable(v), value, true)) {
+      return false;
+    }
+  }
   return true;
 }
 
@@ -19,28 +19,38 @@
 
 #include "cvc4_private.h"
 
+#include "context/cdhashmap.h"
+#include "theory/idl/idl_assertion.h"
+#include "theory/idl/idl_graph.h"
 #include "theory/theory.h"
-#include "theory/idl/idl_model.h"
-#include "theory/idl/idl_assertion_db.h"
 
 namespace CVC4 {
 namespace theory {
 namespace idl {
 
 /**
- * Handles integer difference logic (IDL) constraints.
+ * Handles integer difference logic (IDL) constraints, with an incremental
+ * negative cycle detection on the graph of the constraints (see IDLGraph).
  */
 class TheoryIdl : public Theory {
 
-  /** The current model */
-  IDLModel d_model;
+  typedef context::CDHashMap<Node, Node, NodeHashFunction> explanation_map;
 
-  /** The asserted constraints, organized by variable */
-  IDLAssertionDB d_assertionsDB;
+  /** The graph of the asserted constraints */
+  IDLGraph d_graph;
+
+  /** The explanations of the propagated literals */
+  explanation_map d_explanations;
 
   /** Process a new assertion, returns false if in conflict */
   bool processAssertion(const IDLAssertion& assertion);
 
+  /**
+   * Add the constraint (v - u <= w) from the assertion to the graph, and
+   * propagate the constraints it implies. Returns false if in conflict.
+   */
+  bool addConstraint(TNode u, TNode v, const Integer& w, TNode assertion);
+
 public:
 
   /** Theory constructor. */
@@ -50,9 +60,18 @@ public:
   /** Pre-processing of input atoms */
   Node ppRewrite(TNode atom) override;
 
+  /** Register the constraints that can be propagated */
+  void preRegisterTerm(TNode node) override;
+
   /** Check the assertions for satisfiability */
   void check(Effort effort) override;
 
+  /** Explain a propagated literal */
+  Node explain(TNode literal) override;
+
+  /** Set the values of the variables in the model */
+  bool collectModelInfo(TheoryModel* m) override;
+
   /** Identity string */
   std::string identify() const override { return "THEORY_IDL"; }
 
@@ -78,11 +78,12 @@ class OutputChannel {
 
   /**
    * With safePoint(), the theory signals that it is at a safe point
-   * and can be interrupted.
+   * and can be interrupted. It spends the given amount of resources of kind
+   * r first, see spendResource().
    *
    * @throws Interrupted if the theory can be safely interrupted.
    */
-  virtual void safePoint(uint64_t amount) {}
+  virtual void safePoint(ResourceManager::Resource r, uint64_t amount) {}
 
   /**
    * Indicate a theory conflict has arisen.
@@ -170,9 +171,10 @@ class OutputChannel {
    * termination occurs in the main search loop, so while theories
    * should call OutputChannel::spendResource() during particularly
    * long-running operations, they cannot rely on resource() to break
-   * out of infinite or intractable computations.
+   * out of infinite or intractable computations. The kind r of the
+   * resource is accounted for separately, and may have its own limit.
    */
-  virtual void spendResource(unsigned amount) {}
+  virtual void spendResource(ResourceManager::Resource r, unsigned amount) {}
 
   /**
    * Handle user attribute.
@@ -23,77 +23,6 @@ using namespace CVC4::theory;
 using namespace CVC4::theory::quantifiers;
 using namespace CVC4::kind;
 
-struct sortTypeOrder {
-  expr::TermCanonize* d_tu;
-  bool operator() (TypeNode i, TypeNode j) {
-    return d_tu->getIdForType( i )<d_tu->getIdForType( j );
-  }
-};
-
-Node AlphaEquivalenceNode::registerNode(Node q, Node t)
-{
-  AlphaEquivalenceNode* aen = this;
-  std::vector<Node> tt;
-  std::vector<int> arg_index;
-  tt.push_back(t);
-  std::map< Node, bool > visited;
-  while( !tt.empty() ){
-    if( tt.size()==arg_index.size()+1 ){
-      Node t = tt.back();
-      Node op;
-      if( t.hasOperator() ){
-        if( visited.find( t )==visited.end() ){
-          visited[t] = true;
-          op = t.getOperator();
-          arg_index.push_back( 0 );
-        }else{
-          op = t;
-          arg_index.push_back( -1 );
-        }
-      }else{
-        op = t;
-        arg_index.push_back( 0 );
-      }
-      Trace("aeq-debug") << op << " ";
-      aen = &(aen->d_children[op][t.getNumChildren()]);
-    }else{
-      Node t = tt.back();
-      int i = arg_index.back();
-      if( i==-1 || i==(int)t.getNumChildren() ){
-        tt.pop_back();
-        arg_index.pop_back();
-      }else{
-        tt.push_back( t[i] );
-        arg_index[arg_index.size()-1]++;
-      }
-    }
-  }
-  Trace("aeq-debug") << std::endl;
-  if( aen->d_quant.isNull() ){
-    aen->d_quant = q;
-  }
-  return aen->d_quant;
-}
-
-Node AlphaEquivalenceTypeNode::registerNode(Node q,
-                                            Node t,
-                                            std::vector<TypeNode>& typs,
-                                            std::map<TypeNode, int>& typ_count)
-{
-  AlphaEquivalenceTypeNode* aetn = this;
-  unsigned index = 0;
-  while (index < typs.size())
-  {
-    TypeNode curr = typs[index];
-    Assert(typ_count.find(curr) != typ_count.end());
-    Trace("aeq-debug") << "[" << curr << " " << typ_count[curr] << "] ";
-    aetn = &(aetn->d_children[curr][typ_count[curr]]);
-    index = index + 1;
-  }
-  Trace("aeq-debug") << " : ";
-  return aetn->d_data.registerNode(q, t);
-}
-
 Node AlphaEquivalenceDb::addTerm(Node q)
 {
   Assert(q.getKind() == FORALL);
@@ -102,22 +31,24 @@ Node AlphaEquivalenceDb::addTerm(Node q)
   Node t = d_tc->getCanonicalTerm(q[1], true);
   Trace("aeq") << "  canonical form: " << t << std::endl;
   //compute variable type counts
-  std::map< TypeNode, int > typ_count;
-  std::vector< TypeNode > typs;
-  for( unsigned i=0; i<q[0].getNumChildren(); i++ ){
-    TypeNode tn = q[0][i].getType();
-    typ_count[tn]++;
-    if( std::find( typs.begin(), typs.end(), tn )==typs.end() ){
-      typs.push_back( tn );
+  std::map<TypeNode, size_t> typ_count;
+  for (const Node& v : q[0])
+  {
+    typ_count[v.getType()]++;
+  }
+  std::vector<std::pair<Node, std::map<TypeNode, size_t>>>& bucket =
+      d_index[t];
+  for (const std::pair<Node, std::map<TypeNode, size_t>>& e : bucket)
+  {
+    if (e.second == typ_count)
+    {
+      Trace("aeq") << "  ...result : " << e.first << std::endl;
+      return e.first;
     }
   }
-  sortTypeOrder sto;
-  sto.d_tu = d_tc;
-  std::sort( typs.begin(), typs.end(), sto );
-  Trace("aeq-debug") << "  ";
-  Node ret = d_ae_typ_trie.registerNode(q, t, typs, typ_count);
-  Trace("aeq") << "  ...result : " << ret << std::endl;
-  return ret;
+  bucket.emplace_back(q, typ_count);
+  Trace("aeq") << "  ...result : " << q << std::endl;
+  return q;
 }
 
 AlphaEquivalence::AlphaEquivalence(QuantifiersEngine* qe)
@@ -17,6 +17,10 @@
 #ifndef CVC4__ALPHA_EQUIVALENCE_H
 #define CVC4__ALPHA_EQUIVALENCE_H
 
+#include <map>
+#include <unordered_map>
+#include <vector>
+
 #include "theory/quantifiers/quant_util.h"
 
 #include "expr/term_canonize.h"
@@ -25,54 +29,6 @@ namespace CVC4 {
 namespace theory {
 namespace quantifiers {
 
-/**
- * This is a discrimination tree index for terms. It handles variadic
- * operators by indexing based on operator arity, and flattens multiple
- * occurrences of subterms.
- *
- * For example, the term
- * +( f( x ), +( a, f(x), b ) )
- *   is stored at:
- * d_children[+][2].d_children[f][1].
- *   d_children[x][0].d_children[+][3].
- *     d_children[a][0].d_children[f(x)][0].
- *       d_children[b][0]
- * Notice that the second occurrence of f(x) is flattened.
- */
-class AlphaEquivalenceNode {
-public:
- /** children of this node */
- std::map<Node, std::map<int, AlphaEquivalenceNode> > d_children;
- /** the data at this node */
- Node d_quant;
- /** Registers term q to this trie. The term t is the canonical form of q. */
- Node registerNode(Node q, Node t);
-};
-
-/**
- * This trie stores a trie of the above form for each multi-set of types. For
- * each term t registered to this node, we store t in the appropriate
- * AlphaEquivalenceNode trie. For example, if t contains 2 free variables
- * of type T1 and 3 free variables of type T2, then it is stored at
- * d_children[T1][2].d_children[T2][3].
- */
-class AlphaEquivalenceTypeNode {
-public:
- /** children of this node */
- std::map<TypeNode, std::map<int, AlphaEquivalenceTypeNode> > d_children;
- /** the database of terms at this node */
- AlphaEquivalenceNode d_data;
- /** register node
-  *
-  * This registers term q to this trie. The term t is the canonical form of
-  * q, typs/typ_count represent a multi-set of types of free variables in t.
-  */
- Node registerNode(Node q,
-                   Node t,
-                   std::vector<TypeNode>& typs,
-                   std::map<TypeNode, int>& typ_count);
-};
-
 /**
  * Stores a database of quantified formulas, which computes alpha-equivalence.
  */
@@ -89,8 +45,17 @@ class AlphaEquivalenceDb
   Node addTerm(Node q);
 
  private:
-  /** a trie per # of variables per type */
-  AlphaEquivalenceTypeNode d_ae_typ_trie;
+  /**
+   * The quantified formulas added to this database, indexed by the canonical
+   * form of their body. Since nodes are hash-consed, the bodies of
+   * alpha-equivalent formulas have the same canonical form, hence the
+   * formulas are only compared with the ones of the same bucket, on the
+   * number of bound variables of each type.
+   */
+  std::unordered_map<Node,
+                     std::vector<std::pair<Node, std::map<TypeNode, size_t>>>,
+                     NodeHashFunction>
+      d_index;
   /** pointer to the term canonize utility */
   expr::TermCanonize* d_tc;
 };
@@ -212,6 +212,82 @@ static Node dropChild(Node n, unsigned index)
   return nb.getNumChildren() == 1 ? nb[0] : nb.constructNode();
 }
 
+Node BvInverter::getIC(
+    bool pol, Kind litk, Kind k, unsigned index, Node x, Node s, Node t)
+{
+  TypeNode tn = x.getType();
+  ICKey key(pol, litk, k, index, tn);
+  std::pair<Node, Node>& vars = d_ic_vars[tn];
+  if (vars.first.isNull())
+  {
+    NodeManager* nm = NodeManager::currentNM();
+    vars.first = nm->mkBoundVar("s", tn);
+    vars.second = nm->mkBoundVar("t", tn);
+  }
+  std::map<ICKey, Node>::iterator it = d_ic_cache.find(key);
+  Node ic;
+  if (it != d_ic_cache.end())
+  {
+    ic = it->second;
+  }
+  else
+  {
+    // The invertibility conditions only depend on the structure of the
+    // literal, hence we compute them once for each key, where s and t are
+    // replaced by variables.
+    Node vs = vars.first;
+    Node vt = vars.second;
+    switch (k)
+    {
+      case BITVECTOR_MULT:
+        ic = utils::getICBvMult(pol, litk, k, index, x, vs, vt);
+        break;
+      case BITVECTOR_SHL:
+        ic = utils::getICBvShl(pol, litk, k, index, x, vs, vt);
+        break;
+      case BITVECTOR_UREM_TOTAL:
+        ic = utils::getICBvUrem(pol, litk, k, index, x, vs, vt);
+        break;
+      case BITVECTOR_UDIV_TOTAL:
+        ic = utils::getICBvUdiv(pol, litk, k, index, x, vs, vt);
+        break;
+      case BITVECTOR_AND:
+      case BITVECTOR_OR:
+        ic = utils::getICBvAndOr(pol, litk, k, index, x, vs, vt);
+        break;
+      case BITVECTOR_LSHR:
+        ic = utils::getICBvLshr(pol, litk, k, index, x, vs, vt);
+        break;
+      case BITVECTOR_ASHR:
+        ic = utils::getICBvAshr(pol, litk, k, index, x, vs, vt);
+        break;
+      default:
+        Assert(k == UNDEFINED_KIND);
+        if (litk == BITVECTOR_ULT || litk == BITVECTOR_UGT)
+        {
+          ic = utils::getICBvUltUgt(pol, litk, x, vt);
+        }
+        else
+        {
+          Assert(litk == BITVECTOR_SLT || litk == BITVECTOR_SGT);
+          ic = utils::getICBvSltSgt(pol, litk, x, vt);
+        }
+    }
+    d_ic_cache[key] = ic;
+  }
+  std::vector<Node> vars_vec;
+  std::vector<Node> subs;
+  if (!s.isNull())
+  {
+    vars_vec.push_back(vars.first);
+    subs.push_back(s);
+  }
+  vars_vec.push_back(vars.second);
+  subs.push_back(t);
+  return ic.substitute(
+      vars_vec.begin(), vars_vec.end(), subs.begin(), subs.end());
+}
+
 Node BvInverter::solveBvLit(Node sv,
                             Node lit,
                             std::vector<unsigned>& path,
@@ -306,33 +382,12 @@ Node BvInverter::solveBvLit(Node sv,
       Node inv = bv::utils::mkConst(w, inv_val);
       t = nm->mkNode(BITVECTOR_MULT, inv, t);
     }
-    else if (k == BITVECTOR_MULT)
-    {
-      ic = utils::getICBvMult(pol, litk, k, index, x, s, t);
-    }
-    else if (k == BITVECTOR_SHL)
-    {
-      ic = utils::getICBvShl(pol, litk, k, index, x, s, t);
-    }
-    else if (k == BITVECTOR_UREM_TOTAL)
+    else if (k == BITVECTOR_MULT || k == BITVECTOR_SHL
+             || k == BITVECTOR_UREM_TOTAL || k == BITVECTOR_UDIV_TOTAL
+             || k == BITVECTOR_AND || k == BITVECTOR_OR
+             || k == BITVECTOR_LSHR || k == BITVECTOR_ASHR)
     {
-      ic = utils::getICBvUrem(pol, litk, k, index, x, s, t);
-    }
-    else if (k == BITVECTOR_UDIV_TOTAL)
-    {
-      ic = utils::getICBvUdiv(pol, litk, k, index, x, s, t);
-    }
-    else if (k == BITVECTOR_AND || k == BITVECTOR_OR)
-    {
-      ic = utils::getICBvAndOr(pol, litk, k, index, x, s, t);
-    }
-    else if (k == BITVECTOR_LSHR)
-    {
-      ic = utils::getICBvLshr(pol, litk, k, index, x, s, t);
-    }
-    else if (k == BITVECTOR_ASHR)
-    {
-      ic = utils::getICBvAshr(pol, litk, k, index, x, s, t);
+      ic = getIC(pol, litk, k, index, x, s, t);
     }
     else if (k == BITVECTOR_CONCAT)
     {
@@ -373,13 +428,10 @@ Node BvInverter::solveBvLit(Node sv,
     {
       ic = utils::getICBvSext(pol, litk, index, x, sv_t, t);
     }
-    else if (litk == BITVECTOR_ULT || litk == BITVECTOR_UGT)
-    {
-      ic = utils::getICBvUltUgt(pol, litk, x, t);
-    }
-    else if (litk == BITVECTOR_SLT || litk == BITVECTOR_SGT)
+    else if (litk == BITVECTOR_ULT || litk == BITVECTOR_UGT
+             || litk == BITVECTOR_SLT || litk == BITVECTOR_SGT)
     {
-      ic = utils::getICBvSltSgt(pol, litk, x, t);
+      ic = getIC(pol, litk, UNDEFINED_KIND, 0, x, Node::null(), t);
     }
     else if (pol == false)
     {
@@ -18,6 +18,7 @@
 #define CVC4__BV_INVERTER_H
 
 #include <map>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -97,6 +98,19 @@ class BvInverter
  private:
   /** Dummy variables for each type */
   std::map<TypeNode, Node> d_solve_var;
+  /**
+   * The key of an invertibility condition, that is, the polarity and kind of
+   * the literal, the kind of the term containing the solve variable and the
+   * index of the solve variable in it, and the type of the solve variable.
+   */
+  typedef std::tuple<bool, Kind, Kind, unsigned, TypeNode> ICKey;
+  /**
+   * Maps keys to invertibility conditions, where the terms other than the
+   * solve variable are the variables in d_ic_vars.
+   */
+  std::map<ICKey, Node> d_ic_cache;
+  /** The variables standing for terms s and t in d_ic_cache, for each type */
+  std::map<TypeNode, std::pair<Node, Node>> d_ic_vars;
 
   /** Helper function for getPathToPv */
   Node getPathToPv(Node lit,
@@ -105,6 +119,18 @@ class BvInverter
                    std::vector<unsigned>& path,
                    std::unordered_set<TNode, TNodeHashFunction>& visited);
 
+  /** get invertibility condition
+   *
+   * Returns the invertibility condition for the literal x <k> s <litk> t with
+   * polarity pol, where index is the index of x in the term of kind k, and x
+   * is the solve variable of its type. If k is UNDEFINED_KIND, this is the
+   * condition for x <litk> t with polarity pol, where litk is an inequality.
+   * The conditions are cached for each key, since they only depend on s and
+   * t through substitution.
+   */
+  Node getIC(
+      bool pol, Kind litk, Kind k, unsigned index, Node x, Node s, Node t);
+
   /** Helper function for getInv.
    *
    * This expects a condition cond where:
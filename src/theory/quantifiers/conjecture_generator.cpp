@@ -74,8 +74,10 @@ Node OpArgIndex::getGroundTerm( ConjectureGenerator * s, std::vector< TNode >& a
   }
 }
 
-void OpArgIndex::getGroundTerms( ConjectureGenerator * s, std::vector< TNode >& terms ) {
-  terms.insert( terms.end(), d_op_terms.begin(), d_op_terms.end() );
+void OpArgIndex::getGroundTerms(
+    ConjectureGenerator* s, std::unordered_set<TNode, TNodeHashFunction>& terms)
+{
+  terms.insert( d_op_terms.begin(), d_op_terms.end() );
   for( std::map< TNode, OpArgIndex >::iterator it = d_child.begin(); it != d_child.end(); ++it ){
     if( s->isGroundEqc( it->first ) ){
       it->second.getGroundTerms( s, terms );
@@ -93,7 +95,9 @@ ConjectureGenerator::ConjectureGenerator(QuantifiersEngine* qe,
       d_subs_confirmCount(0),
       d_subs_unkCount(0),
       d_fullEffortCount(0),
-      d_hasAddedLemma(false)
+      d_hasAddedLemma(false),
+      d_roundTerms(0),
+      d_roundBudgetExceeded(false)
 {
   d_true = NodeManager::currentNM()->mkConst(true);
   d_false = NodeManager::currentNM()->mkConst(false);
@@ -218,12 +222,12 @@ bool ConjectureGenerator::isUniversalLessThan( TNode rt1, TNode rt2 ) {
 
 
 bool ConjectureGenerator::isReportedCanon( TNode n ) {
-  return std::find( d_ue_canon.begin(), d_ue_canon.end(), n )==d_ue_canon.end();
+  return d_ue_canon.find(n) == d_ue_canon.end();
 }
 
 void ConjectureGenerator::markReportedCanon( TNode n ) {
   if( !isReportedCanon( n ) ){
-    d_ue_canon.push_back( n );
+    d_ue_canon.insert(n);
   }
 }
 
@@ -324,7 +328,7 @@ bool ConjectureGenerator::isGroundEqc( TNode r ) {
 }
 
 bool ConjectureGenerator::isGroundTerm( TNode n ) {
-  return std::find( d_ground_terms.begin(), d_ground_terms.end(), n )!=d_ground_terms.end();
+  return d_ground_terms.find(n) != d_ground_terms.end();
 }
 
 bool ConjectureGenerator::needsCheck( Theory::Effort e ) {
@@ -369,6 +373,14 @@ void ConjectureGenerator::check(Theory::Effort e, QEffort quant_e)
       }
       eq::EqualityEngine * ee = getEqualityEngine();
       d_conj_count = 0;
+      d_roundTerms = 0;
+      d_roundBudgetExceeded = false;
+      if (options::conjectureGenTimeLimit() > 0)
+      {
+        d_roundDeadline =
+            std::chrono::steady_clock::now()
+            + std::chrono::milliseconds(options::conjectureGenTimeLimit());
+      }
 
       Trace("sg-proc") << "Get eq classes..." << std::endl;
       d_op_arg_index.clear();
@@ -521,7 +533,7 @@ void ConjectureGenerator::check(Theory::Effort e, QEffort quant_e)
       Trace("sg-proc") << "Build theorem index..." << std::endl;
       d_ue_canon.clear();
       d_thm_index.clear();
-      std::vector< Node > provenConj;
+      std::unordered_set<Node, NodeHashFunction> provenConj;
       quantifiers::FirstOrderModel* m = d_quantEngine->getModel();
       for( unsigned i=0; i<m->getNumAssertedQuantifiers(); i++ ){
         Node q = m->getAssertedQuantifier( i );
@@ -534,7 +546,8 @@ void ConjectureGenerator::check(Theory::Effort e, QEffort quant_e)
             TNode nl = q[1][r==0 ? 0 : 1];
             TNode nr = q[1][r==0 ? 1 : 0];
             Node eq = nl.eqNode( nr );
-            if( r==1 || std::find( d_conjectures.begin(), d_conjectures.end(), q )==d_conjectures.end() ){
+            if (r == 1 || d_conjecture_set.find(q) == d_conjecture_set.end())
+            {
               //check if it contains only relevant functions
               if( d_tge.isRelevantTerm( eq ) ){
                 //make it canonical
@@ -563,7 +576,7 @@ void ConjectureGenerator::check(Theory::Effort e, QEffort quant_e)
                 }
                 Trace("sg-conjecture") << "*** CONJECTURE : currently proven" << (isSubsume ? " and subsumed" : "");
                 Trace("sg-conjecture") << " : " << q[1] << std::endl;
-                provenConj.push_back( q );
+                provenConj.insert(q);
               }
               if( !isSubsume ){
                 Trace("thm-db-debug") << "Adding theorem to database " << eq[0] << " == " << eq[1] << std::endl;
@@ -580,7 +593,8 @@ void ConjectureGenerator::check(Theory::Effort e, QEffort quant_e)
       //examine status of other conjectures
       for( unsigned i=0; i<d_conjectures.size(); i++ ){
         Node q = d_conjectures[i];
-        if( std::find( provenConj.begin(), provenConj.end(), q )==provenConj.end() ){
+        if (provenConj.find(q) == provenConj.end())
+        {
           //check each skolem variable
           bool disproven = true;
           std::vector<Node> skolems;
@@ -652,7 +666,12 @@ void ConjectureGenerator::check(Theory::Effort e, QEffort quant_e)
         d_tge.d_var_id.clear();
         d_tge.d_var_limit.clear();
         d_tge.reset( depth, true, TypeNode::null() );
-        while( d_tge.getNextTerm() ){
+        while (!d_roundBudgetExceeded && d_tge.getNextTerm())
+        {
+          if (countRoundTerm())
+          {
+            break;
+          }
           //construct term
           Node nn = d_tge.getTerm();
           if( !options::conjectureFilterCanonical() || considerTermCanon( nn, true ) ){
@@ -785,7 +804,12 @@ void ConjectureGenerator::check(Theory::Effort e, QEffort quant_e)
             Trace("sg-proc") << "Generate relevant RHS terms of type " << rt_types[i] << " at depth " << rdepth << "..." << std::endl;
             d_tge.reset( rdepth, false, rt_types[i] );
 
-            while( d_tge.getNextTerm() ){
+            while (!d_roundBudgetExceeded && d_tge.getNextTerm())
+            {
+              if (countRoundTerm())
+              {
+                break;
+              }
               Node rhs = d_tge.getTerm();
               if( considerTermCanon( rhs, false ) ){
                 Trace("sg-rel-prop") << "Relevant RHS : " << rhs << std::endl;
@@ -820,14 +844,23 @@ void ConjectureGenerator::check(Theory::Effort e, QEffort quant_e)
               }
             }
           }
-          if( (int)addedLemmas>=options::conjectureGenPerRound() ){
+          if (d_roundBudgetExceeded
+              || (int)addedLemmas >= options::conjectureGenPerRound())
+          {
             break;
           }
         }
-        if( (int)addedLemmas>=options::conjectureGenPerRound() ){
+        if (d_roundBudgetExceeded
+            || (int)addedLemmas >= options::conjectureGenPerRound())
+        {
           break;
         }
       }
+      if (d_roundBudgetExceeded)
+      {
+        Trace("sg-engine") << "...budget of the round ran out after "
+                           << d_roundTerms << " terms." << std::endl;
+      }
       Trace("sg-stats") << "Total conjectures considered : " << d_conj_count << std::endl;
       if( Trace.isOn("thm-ee") ){
         Trace("thm-ee") << "Universal equality engine is : " << std::endl;
@@ -914,6 +947,7 @@ unsigned ConjectureGenerator::flushWaitingConjectures( unsigned& addedLemmas, in
               }
               rsg = Rewriter::rewrite( rsg );
               d_conjectures.push_back( rsg );
+              d_conjecture_set.insert(rsg);
               d_eq_conjectures[lhs].push_back( rhs );
               d_eq_conjectures[rhs].push_back( lhs );
 
@@ -941,6 +975,19 @@ unsigned ConjectureGenerator::flushWaitingConjectures( unsigned& addedLemmas, in
   return addedLemmas;
 }
 
+bool ConjectureGenerator::countRoundTerm()
+{
+  d_roundTerms++;
+  unsigned maxTerms = options::conjectureGenMaxTerms();
+  if ((maxTerms > 0 && d_roundTerms > maxTerms)
+      || (options::conjectureGenTimeLimit() > 0
+          && std::chrono::steady_clock::now() >= d_roundDeadline))
+  {
+    d_roundBudgetExceeded = true;
+  }
+  return d_roundBudgetExceeded;
+}
+
 bool ConjectureGenerator::considerTermCanon( Node ln, bool genRelevant ){
   if( !ln.isNull() ){
     //do not consider if it is non-canonical, and either:
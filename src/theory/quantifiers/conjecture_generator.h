@@ -17,6 +17,9 @@
 #ifndef CONJECTURE_GENERATOR_H
 #define CONJECTURE_GENERATOR_H
 
+#include <chrono>
+#include <unordered_set>
+
 #include "context/cdhashmap.h"
 #include "expr/node_trie.h"
 #include "theory/quantifiers/quant_util.h"
@@ -39,7 +42,8 @@ public:
   std::vector< TNode > d_op_terms;
   void addTerm( std::vector< TNode >& terms, TNode n, unsigned index = 0 );
   Node getGroundTerm( ConjectureGenerator * s, std::vector< TNode >& args );
-  void getGroundTerms( ConjectureGenerator * s, std::vector< TNode >& terms );
+  void getGroundTerms(ConjectureGenerator* s,
+                      std::unordered_set<TNode, TNodeHashFunction>& terms);
 };
 
 class PatternTypIndex
@@ -317,7 +321,7 @@ private:
   bool isUniversalLessThan( TNode rt1, TNode rt2 );
 
   /** the nodes we have reported as canonical representative */
-  std::vector< TNode > d_ue_canon;
+  std::unordered_set<TNode, TNodeHashFunction> d_ue_canon;
   /** is reported canon */
   bool isReportedCanon( TNode n );
   /** mark that term has been reported as canonical rep */
@@ -326,6 +330,8 @@ private:
 private:  //information regarding the conjectures
   /** list of all conjectures */
   std::vector< Node > d_conjectures;
+  /** the set of all conjectures, for fast lookups */
+  std::unordered_set<Node, NodeHashFunction> d_conjecture_set;
   /** list of all waiting conjectures */
   std::vector< Node > d_waiting_conjectures_lhs;
   std::vector< Node > d_waiting_conjectures_rhs;
@@ -430,7 +436,7 @@ public:  //for property enumeration
 private:  //information about ground equivalence classes
   TNode d_bool_eqc[2];
   std::map< TNode, Node > d_ground_eqc_map;
-  std::vector< TNode > d_ground_terms;
+  std::unordered_set<TNode, TNodeHashFunction> d_ground_terms;
   //operator independent term index
   std::map< TNode, OpArgIndex > d_op_arg_index;
   //is handled term
@@ -446,6 +452,19 @@ private:  //information about ground equivalence classes
   bool d_hasAddedLemma;
   //flush the waiting conjectures
   unsigned flushWaitingConjectures( unsigned& addedLemmas, int ldepth, int rdepth );
+  /** the number of terms generated in the current round */
+  unsigned d_roundTerms;
+  /** the end of the current round, if options::conjectureGenTimeLimit() */
+  std::chrono::steady_clock::time_point d_roundDeadline;
+  /** whether the budget of the current round ran out */
+  bool d_roundBudgetExceeded;
+  /**
+   * Counts a generated term, and returns true if the budget of the current
+   * round, given by options::conjectureGenMaxTerms() and
+   * options::conjectureGenTimeLimit(), ran out. The round then stops
+   * generating terms, and only the conjectures found so far are considered.
+   */
+  bool countRoundTerm();
 public:
   ConjectureGenerator( QuantifiersEngine * qe, context::Context* c );
   ~ConjectureGenerator();
@@ -963,7 +963,7 @@ void InstMatchGeneratorMulti::processNewInstantiations(QuantifiersEngine* qe,
       }
     }
     // shared and set variable, try to merge
-    std::map<Node, InstMatchTrie>::iterator it = tr->d_data.find(n);
+    InstMatchTrie::DataMap::iterator it = tr->d_data.find(n);
     if (it != tr->d_data.end())
     {
       processNewInstantiations(qe,
@@ -989,7 +989,7 @@ void InstMatchGeneratorMulti::processNewInstantiations(QuantifiersEngine* qe,
           Node en = (*eqc);
           if (en != n)
           {
-            std::map<Node, InstMatchTrie>::iterator itc = tr->d_data.find(en);
+            InstMatchTrie::DataMap::iterator itc = tr->d_data.find(en);
             if (itc != tr->d_data.end())
             {
               processNewInstantiations(qe,
@@ -1028,7 +1028,7 @@ void InstMatchGeneratorMulti::processNewInstantiations(QuantifiersEngine* qe,
 InstMatchGeneratorSimple::InstMatchGeneratorSimple(Node q,
                                                    Node pat,
                                                    QuantifiersEngine* qe)
-    : d_quant(q), d_match_pattern(pat)
+    : d_quant(q), d_match_pattern(pat), d_instantiated(qe->getUserContext())
 {
   if( d_match_pattern.getKind()==NOT ){
     d_match_pattern = d_match_pattern[0];
@@ -1063,6 +1063,54 @@ int InstMatchGeneratorSimple::addInstantiations(Node q,
                                                 Trigger* tparent)
 {
   int addedLemmas = 0;
+  if (qe->inConflict())
+  {
+    return addedLemmas;
+  }
+  std::vector<TNodeTrie*> tats;
+  getTries(qe, tats);
+  if (tats.empty())
+  {
+    return addedLemmas;
+  }
+  std::vector<std::pair<int, Node> > shape;
+  getShape(qe, shape);
+  for (TNodeTrie* tat : tats)
+  {
+    InstMatch m(q);
+    addInstantiations(m, qe, addedLemmas, tat, shape);
+    if (qe->inConflict())
+    {
+      break;
+    }
+  }
+  return addedLemmas;
+}
+
+void InstMatchGeneratorSimple::collectMatchRequests(
+    QuantifiersEngine* qe,
+    std::vector<std::pair<TNodeTrie*, std::vector<std::pair<int, Node> > > >&
+        requests)
+{
+  std::vector<TNodeTrie*> tats;
+  getTries(qe, tats);
+  if (tats.empty())
+  {
+    return;
+  }
+  std::vector<std::pair<int, Node> > shape;
+  getShape(qe, shape);
+  for (TNodeTrie* tat : tats)
+  {
+    requests.push_back(
+        std::pair<TNodeTrie*, std::vector<std::pair<int, Node> > >(tat,
+                                                                   shape));
+  }
+}
+
+void InstMatchGeneratorSimple::getTries(QuantifiersEngine* qe,
+                                        std::vector<TNodeTrie*>& tats)
+{
   TNodeTrie* tat;
   if( d_eqc.isNull() ){
     tat = qe->getTermDatabase()->getTermArgTrie( d_op );
@@ -1072,18 +1120,14 @@ int InstMatchGeneratorSimple::addInstantiations(Node q,
     }else{
       //iterate over all classes except r
       tat = qe->getTermDatabase()->getTermArgTrie( Node::null(), d_op );
-      if (tat && !qe->inConflict())
+      if (tat)
       {
         Node r = qe->getEqualityQuery()->getRepresentative(d_eqc);
         for (std::pair<const TNode, TNodeTrie>& t : tat->d_data)
         {
           if (t.first != r)
           {
-            InstMatch m( q );
-            addInstantiations(m, qe, addedLemmas, 0, &(t.second));
-            if( qe->inConflict() ){
-              break;
-            }
+            tats.push_back(&(t.second));
           }
         }
       }
@@ -1091,25 +1135,56 @@ int InstMatchGeneratorSimple::addInstantiations(Node q,
     }
   }
   Debug("simple-trigger-debug") << "Adding instantiations based on " << tat << " from " << d_op << " " << d_eqc << std::endl;
-  if (tat && !qe->inConflict())
+  if (tat)
   {
-    InstMatch m( q );
-    addInstantiations( m, qe, addedLemmas, 0, tat );
+    tats.push_back(tat);
   }
-  return addedLemmas;
 }
 
-void InstMatchGeneratorSimple::addInstantiations(InstMatch& m,
-                                                 QuantifiersEngine* qe,
-                                                 int& addedLemmas,
-                                                 unsigned argIndex,
-                                                 TNodeTrie* tat)
+void InstMatchGeneratorSimple::getShape(
+    QuantifiersEngine* qe, std::vector<std::pair<int, Node> >& shape)
 {
-  Debug("simple-trigger-debug") << "Add inst " << argIndex << " " << d_match_pattern << std::endl;
-  if (argIndex == d_match_pattern.getNumChildren())
+  for (unsigned i = 0, nchild = d_match_pattern.getNumChildren(); i < nchild;
+       i++)
   {
-    Assert(!tat->d_data.empty());
-    TNode t = tat->getData();
+    std::map<unsigned, int>::iterator itv = d_var_num.find(i);
+    if (itv != d_var_num.end() && itv->second != -1)
+    {
+      // the first argument with the same variable
+      std::map<unsigned, int>::iterator itf = d_var_num.begin();
+      while (itf->second != itv->second)
+      {
+        ++itf;
+      }
+      shape.push_back(std::pair<int, Node>(itf->first, Node::null()));
+    }
+    else
+    {
+      // inst constants from other quantified formulas are treated as ground
+      // terms  TODO: remove this?
+      Node r = qe->getEqualityQuery()->getRepresentative(d_match_pattern[i]);
+      shape.push_back(std::pair<int, Node>(-1, r));
+    }
+  }
+}
+
+void InstMatchGeneratorSimple::addInstantiations(
+    InstMatch& m,
+    QuantifiersEngine* qe,
+    int& addedLemmas,
+    TNodeTrie* tat,
+    const std::vector<std::pair<int, Node> >& shape)
+{
+  Debug("simple-trigger-debug") << "Add inst " << d_match_pattern << std::endl;
+  const std::vector<TNode>& matches =
+      qe->getTermDatabase()->getMatches(tat, shape);
+  for (const TNode& t : matches)
+  {
+    if (d_instantiated.find(t) != d_instantiated.end())
+    {
+      ++(qe->d_statistics.d_simple_trigger_matches_skipped);
+      continue;
+    }
     Debug("simple-trigger") << "Actual term is " << t << std::endl;
     //convert to actual used terms
     for (std::map<unsigned, int>::iterator it = d_var_num.begin();
@@ -1118,6 +1193,8 @@ void InstMatchGeneratorSimple::addInstantiations(InstMatch& m,
     {
       if( it->second>=0 ){
         Assert(it->first < t.getNumChildren());
+        Assert(t[it->first].getType().isComparableTo(
+            d_match_pattern_arg_types[it->first]));
         Debug("simple-trigger") << "...set " << it->second << " " << t[it->first] << std::endl;
         m.setValue( it->second, t[it->first] );
       }
@@ -1127,36 +1204,12 @@ void InstMatchGeneratorSimple::addInstantiations(InstMatch& m,
     if (qe->getInstantiate()->addInstantiation(d_quant, m))
     {
       addedLemmas++;
+      d_instantiated.insert(t);
       Debug("simple-trigger") << "-> Produced instantiation " << m << std::endl;
     }
-  }else{
-    if( d_match_pattern[argIndex].getKind()==INST_CONSTANT ){
-      int v = d_var_num[argIndex];
-      if( v!=-1 ){
-        for (std::pair<const TNode, TNodeTrie>& tt : tat->d_data)
-        {
-          Node t = tt.first;
-          Node prev = m.get( v );
-          //using representatives, just check if equal
-          Assert(
-              t.getType().isComparableTo(d_match_pattern_arg_types[argIndex]));
-          if( prev.isNull() || prev==t ){
-            m.setValue( v, t);
-            addInstantiations(m, qe, addedLemmas, argIndex + 1, &(tt.second));
-            m.setValue( v, prev);
-            if( qe->inConflict() ){
-              break;
-            }
-          }
-        }
-        return;
-      }
-      //inst constant from another quantified formula, treat as ground term  TODO: remove this?
-    }
-    Node r = qe->getEqualityQuery()->getRepresentative( d_match_pattern[argIndex] );
-    std::map<TNode, TNodeTrie>::iterator it = tat->d_data.find(r);
-    if( it!=tat->d_data.end() ){
-      addInstantiations( m, qe, addedLemmas, argIndex+1, &(it->second) );
+    if (qe->inConflict())
+    {
+      break;
     }
   }
 }
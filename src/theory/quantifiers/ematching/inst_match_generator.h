@@ -18,6 +18,9 @@
 #define CVC4__THEORY__QUANTIFIERS__INST_MATCH_GENERATOR_H
 
 #include <map>
+#include <vector>
+
+#include "context/cdhashset.h"
 #include "expr/node_trie.h"
 #include "theory/quantifiers/inst_match_trie.h"
 
@@ -101,6 +104,18 @@ public:
   * A heuristic value indicating how active this generator is.
   */
   virtual int getActiveScore( QuantifiersEngine * qe ) { return 0; }
+  /** collect match requests
+   *
+   * Adds to requests the term arg tries and shapes whose matches this
+   * generator will ask for in this round, see TermDb::prefetchMatches. Only
+   * simple triggers do so, other generators do not add any request.
+   */
+  virtual void collectMatchRequests(
+      QuantifiersEngine* qe,
+      std::vector<std::pair<TNodeTrie*, std::vector<std::pair<int, Node> > > >&
+          requests)
+  {
+  }
  protected:
   /** send instantiation
    *
@@ -619,6 +634,11 @@ class InstMatchGeneratorSimple : public IMGenerator {
                         Trigger* tparent) override;
   /** Get active score. */
   int getActiveScore(QuantifiersEngine* qe) override;
+  /** Collect match requests. */
+  void collectMatchRequests(
+      QuantifiersEngine* qe,
+      std::vector<std::pair<TNodeTrie*, std::vector<std::pair<int, Node> > > >&
+          requests) override;
 
  private:
   /** quantified formula for the trigger term */
@@ -647,20 +667,41 @@ class InstMatchGeneratorSimple : public IMGenerator {
    * child is not a variable.
    */
   std::map<unsigned, int> d_var_num;
+  /**
+   * The ground terms whose matches gave an instantiation lemma, in the
+   * current user context. The instantiation for a term only depends on the
+   * term, and once its lemma is added it stays in the instantiation trie of
+   * d_quant, so matching the term again in a later round can only give a
+   * duplicate. We skip these terms, which avoids the entailment and
+   * duplicate checks of Instantiate::addInstantiation for all the terms that
+   * were already matched in the previous rounds.
+   */
+  context::CDHashSet<Node, NodeHashFunction> d_instantiated;
+  /**
+   * Get the term indices we are matching against in the current context,
+   * there are several if d_eqc is non-null and d_pol is false.
+   */
+  void getTries(QuantifiersEngine* qe, std::vector<TNodeTrie*>& tats);
+  /** Get the shape of d_match_pattern, see TermDb::getMatches. */
+  void getShape(QuantifiersEngine* qe,
+                std::vector<std::pair<int, Node> >& shape);
   /** add instantiations, helper function.
    *
    * m is the current match we are building,
    * addedLemmas is the number of lemmas we have added via calls to
    *                qe->getInstantiate()->aaddInstantiation(...),
-   * argIndex is the argument index in d_match_pattern we are currently
-   *              matching,
-   * tat is the term index we are currently traversing.
+   * tat is the term index we are matching against,
+   * shape is the shape of d_match_pattern.
+   *
+   * The matches of d_match_pattern in tat are obtained from
+   * TermDb::getMatches, which shares them between all simple triggers that
+   * have the same shape in this round.
    */
   void addInstantiations(InstMatch& m,
                          QuantifiersEngine* qe,
                          int& addedLemmas,
-                         unsigned argIndex,
-                         TNodeTrie* tat);
+                         TNodeTrie* tat,
+                         const std::vector<std::pair<int, Node> >& shape);
 };/* class InstMatchGeneratorSimple */
 }
 }
@@ -189,6 +189,43 @@ void InstStrategyAutoGenTriggers::processResetInstantiationRound( Theory::Effort
     }
   }
   d_processed_trigger.clear();
+  size_t numThreads = options::instMatchThreads();
+  if (numThreads > 1)
+  {
+    // Compute the matches of the simple triggers of the active quantified
+    // formulas in parallel, against the term indices of this round. The
+    // instantiations for them are still added one quantified formula at a
+    // time in process.
+    std::vector<std::pair<TNodeTrie*, std::vector<std::pair<int, Node> > > >
+        requests;
+    FirstOrderModel* fm = d_quantEngine->getModel();
+    for (unsigned i = 0, nquant = fm->getNumAssertedQuantifiers(); i < nquant;
+         i++)
+    {
+      Node q = fm->getAssertedQuantifier(i, true);
+      if (!fm->isQuantifierActive(q))
+      {
+        continue;
+      }
+      for (unsigned r = 0; r < 2; r++)
+      {
+        std::map<Node, std::map<Trigger*, bool> >::iterator it =
+            d_auto_gen_trigger[r].find(q);
+        if (it == d_auto_gen_trigger[r].end())
+        {
+          continue;
+        }
+        for (const std::pair<Trigger* const, bool>& t : it->second)
+        {
+          if (t.first != nullptr && t.second)
+          {
+            t.first->collectMatchRequests(requests);
+          }
+        }
+      }
+    }
+    d_quantEngine->getTermDatabase()->prefetchMatches(requests, numThreads);
+  }
   Trace("inst-alg-debug") << "done reset auto-gen triggers" << std::endl;
 }
 
@@ -918,6 +918,13 @@ int Trigger::getActiveScore() {
   return d_mg->getActiveScore( d_quantEngine );
 }
 
+void Trigger::collectMatchRequests(
+    std::vector<std::pair<TNodeTrie*, std::vector<std::pair<int, Node> > > >&
+        requests)
+{
+  d_mg->collectMatchRequests(d_quantEngine, requests);
+}
+
 TriggerTrie::TriggerTrie()
 {}
 
@@ -20,6 +20,7 @@
 #include <map>
 
 #include "expr/node.h"
+#include "expr/node_trie.h"
 #include "theory/quantifiers/inst_match.h"
 #include "options/quantifiers_options.h"
 
@@ -204,6 +205,13 @@ class Trigger {
   *   --trigger-active-sel.
   */
   int getActiveScore();
+  /**
+   * Add to requests the term arg tries and shapes whose matches this trigger
+   * will ask for in this round, see TermDb::prefetchMatches.
+   */
+  void collectMatchRequests(
+      std::vector<std::pair<TNodeTrie*, std::vector<std::pair<int, Node> > > >&
+          requests);
   /** print debug information for the trigger */
   void debugPrint(const char* c)
   {
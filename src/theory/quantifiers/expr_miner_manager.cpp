@@ -138,6 +138,10 @@ bool ExpressionMinerManager::addTerm(Node sol,
     solb = d_tds->sygusToBuiltin(sol);
   }
 
+  // the values of the previous term are not needed anymore, the values of
+  // this one are computed once for all miners
+  d_sampler.clearEvaluationCache();
+
   // add to the candidate rewrite rule database
   bool ret = true;
   if (d_doRewSynth)
@@ -29,10 +29,21 @@ namespace CVC4 {
 namespace theory {
 namespace quantifiers {
 
-struct ExtRewriteAttributeId
+struct ExtRewriteNormalFormAttributeId
 {
 };
-typedef expr::Attribute<ExtRewriteAttributeId, Node> ExtRewriteAttribute;
+struct ExtRewriteAggrNormalFormAttributeId
+{
+};
+/**
+ * Whether a term is its own (aggressive) extended rewritten form. Unlike the
+ * caches of the extended rewriters, which are bounded, these are kept for
+ * all terms, since they do not keep any term alive.
+ */
+typedef expr::Attribute<ExtRewriteNormalFormAttributeId, bool, false, true>
+    ExtRewriteNormalFormAttribute;
+typedef expr::Attribute<ExtRewriteAggrNormalFormAttributeId, bool, false, true>
+    ExtRewriteAggrNormalFormAttribute;
 
 ExtendedRewriter::ExtendedRewriter(bool aggr) : d_aggr(aggr)
 {
@@ -40,10 +51,62 @@ ExtendedRewriter::ExtendedRewriter(bool aggr) : d_aggr(aggr)
   d_false = NodeManager::currentNM()->mkConst(false);
 }
 
+Node ExtendedRewriter::getCache(Node n)
+{
+  std::unordered_map<Node, Node, NodeHashFunction>::iterator it =
+      d_cache.find(n);
+  if (it != d_cache.end())
+  {
+    return it->second;
+  }
+  it = d_oldCache.find(n);
+  if (it == d_oldCache.end())
+  {
+    return Node::null();
+  }
+  Node ret = it->second;
+  d_oldCache.erase(it);
+  setCache(n, ret);
+  return ret;
+}
+
 void ExtendedRewriter::setCache(Node n, Node ret)
 {
-  ExtRewriteAttribute era;
-  n.setAttribute(era, ret);
+  unsigned long bound = options::sygusExtRewCacheSize();
+  if (bound > 0 && d_cache.size() >= bound && d_cache.find(n) == d_cache.end())
+  {
+    // evict the entries that were not used since the last eviction
+    d_oldCache.clear();
+    d_oldCache.swap(d_cache);
+  }
+  d_cache[n] = ret;
+}
+
+void ExtendedRewriter::clearCache()
+{
+  d_cache.clear();
+  d_oldCache.clear();
+}
+
+bool ExtendedRewriter::isNormalForm(TNode n) const
+{
+  return d_aggr ? n.getAttribute(ExtRewriteAggrNormalFormAttribute())
+                : n.getAttribute(ExtRewriteNormalFormAttribute());
+}
+
+void ExtendedRewriter::setNormalForm(TNode n)
+{
+  if (d_aggr)
+  {
+    n.setAttribute(ExtRewriteAggrNormalFormAttribute(), true);
+  }
+  else
+  {
+    n.setAttribute(ExtRewriteNormalFormAttribute(), true);
+  }
+  // drop the entry that may have been cached while computing the rewrite
+  d_cache.erase(n);
+  d_oldCache.erase(n);
 }
 
 bool ExtendedRewriter::addToChildren(Node nc,
@@ -68,10 +131,17 @@ Node ExtendedRewriter::extendedRewrite(Node n)
     return n;
   }
 
+  // Is it known to be in normal form? This is checked first, since it is
+  // the common case, e.g. for the terms of the sygus enumerator.
+  if (isNormalForm(n))
+  {
+    return n;
+  }
   // has it already been computed?
-  if (n.hasAttribute(ExtRewriteAttribute()))
+  Node cached = getCache(n);
+  if (!cached.isNull())
   {
-    return n.getAttribute(ExtRewriteAttribute());
+    return cached;
   }
 
   Node ret = n;
@@ -237,7 +307,14 @@ Node ExtendedRewriter::extendedRewrite(Node n)
       Trace("q-ext-rewrite-nf") << "ext-rew normal form : " << n << std::endl;
     }
   }
-  setCache(n, ret);
+  if (n == ret)
+  {
+    setNormalForm(n);
+  }
+  else
+  {
+    setCache(n, ret);
+  }
   return ret;
 }
 
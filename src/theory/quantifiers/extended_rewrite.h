@@ -51,6 +51,8 @@ class ExtendedRewriter
   ~ExtendedRewriter() {}
   /** return the extended rewritten form of n */
   Node extendedRewrite(Node n);
+  /** clear the cache of the extended rewritten forms */
+  void clearCache();
 
  private:
   /**
@@ -67,8 +69,24 @@ class ExtendedRewriter
   /** true/false nodes */
   Node d_true;
   Node d_false;
+  /** get the cached extended rewritten form of n, or null if none */
+  Node getCache(Node n);
   /** cache that the extended rewritten form of n is ret */
   void setCache(Node n, Node ret);
+  /** is n known to be its own extended rewritten form? */
+  bool isNormalForm(TNode n) const;
+  /** remember that n is its own extended rewritten form */
+  void setNormalForm(TNode n);
+  /**
+   * The cache of the extended rewritten forms that differ from their input,
+   * bounded by --sygus-ext-rew-cache-size. It has two generations: new
+   * entries go to d_cache, and when d_cache is full, it becomes d_oldCache,
+   * whose previous entries are evicted. An entry of d_oldCache that is used
+   * again moves back to d_cache. Hence the entries that survive an eviction
+   * are the ones used since the previous one.
+   */
+  std::unordered_map<Node, Node, NodeHashFunction> d_cache;
+  std::unordered_map<Node, Node, NodeHashFunction> d_oldCache;
   /** add to children
    *
    * Adds nc to the vector of children, if dropDup is true, we do not add
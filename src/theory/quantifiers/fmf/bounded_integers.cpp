@@ -95,6 +95,12 @@ void BoundedIntegers::presolve() {
   d_bnd_it.clear();
 }
 
+void BoundedIntegers::reset_round(Theory::Effort e)
+{
+  d_bound_values.clear();
+  d_range_elements.clear();
+}
+
 bool BoundedIntegers::hasNonBoundVar( Node f, Node b, std::map< Node, bool >& visited ) {
   if( visited.find( b )==visited.end() ){
     visited[b] = true;
@@ -567,10 +573,10 @@ void BoundedIntegers::getBoundValues( Node f, Node v, RepSetIterator * rsi, Node
   getBounds( f, v, rsi, l, u );
   Trace("bound-int-rsi") << "Get value in model for..." << l << " and " << u << std::endl;
   if( !l.isNull() ){
-    l = d_quantEngine->getModel()->getValue( l );
+    l = getBoundTermValue(l);
   }
   if( !u.isNull() ){
-    u = d_quantEngine->getModel()->getValue( u );
+    u = getBoundTermValue(u);
   }
   Trace("bound-int-rsi") << "Value is " << l << " ... " << u << std::endl;
   return;
@@ -625,7 +631,7 @@ Node BoundedIntegers::getSetRangeValue( Node q, Node v, RepSetIterator * rsi ) {
   Trace("bound-int-rsi") << "Get value in model for..." << sr << std::endl;
   Assert(!expr::hasFreeVar(sr));
   Node sro = sr;
-  sr = d_quantEngine->getModel()->getValue(sr);
+  sr = getBoundTermValue(sr);
   // if non-constant, then sr does not occur in the model, we fail
   if (!sr.isConst())
   {
@@ -729,6 +735,23 @@ bool BoundedIntegers::getRsiSubsitution( Node q, Node v, std::vector< Node >& va
   }
 }
 
+Node BoundedIntegers::getBoundTermValue(Node n)
+{
+  TheoryModel* m = d_quantEngine->getModel();
+  if (!m->isBuiltSuccess())
+  {
+    return m->getValue(n);
+  }
+  std::map<Node, Node>::iterator it = d_bound_values.find(n);
+  if (it != d_bound_values.end())
+  {
+    return it->second;
+  }
+  Node val = m->getValue(n);
+  d_bound_values[n] = val;
+  return val;
+}
+
 Node BoundedIntegers::matchBoundVar( Node v, Node t, Node e ){
   if( t==v ){
     return e;
@@ -781,10 +804,18 @@ bool BoundedIntegers::getBoundElements( RepSetIterator * rsi, bool initial, Node
         if( ra==d_quantEngine->getTermUtil()->d_true ){
           long rr = range.getConst<Rational>().getNumerator().getLong()+1;
           Trace("bound-int-rsi")  << "Actual bound range is " << rr << std::endl;
-          for( unsigned k=0; k<rr; k++ ){
+          // the ranges enumerated in this round that start at tl share their
+          // elements, up to the length of the shorter one
+          std::vector<Node>& relems = d_range_elements[tl];
+          for (long k = relems.size(); k < rr; k++)
+          {
             Node t = NodeManager::currentNM()->mkNode(PLUS, tl, NodeManager::currentNM()->mkConst( Rational(k) ) );
             t = Rewriter::rewrite( t );
-            elements.push_back( t );
+            relems.push_back( t );
+          }
+          if (rr > 0)
+          {
+            elements.insert(elements.end(), relems.begin(), relems.begin() + rr);
           }
           return true;
         }else{
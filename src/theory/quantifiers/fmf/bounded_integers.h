@@ -164,6 +164,7 @@ public:
   virtual ~BoundedIntegers();
 
   void presolve() override;
+  void reset_round(Theory::Effort e) override;
   bool needsCheck(Theory::Effort e) override;
   void check(Theory::Effort e, QEffort quant_e) override;
   void checkOwnership(Node q) override;
@@ -227,6 +228,18 @@ public:
   Node matchBoundVar( Node v, Node t, Node e );
   
   bool getRsiSubsitution( Node q, Node v, std::vector< Node >& vars, std::vector< Node >& subs, RepSetIterator * rsi );
+  /**
+   * Get the value of bound term n in the current model. Values are cached in
+   * d_bound_values once the model is successfully built.
+   */
+  Node getBoundTermValue(Node n);
+  /** The values of bound terms in the model of the current round */
+  std::map<Node, Node> d_bound_values;
+  /**
+   * Maps terms l to the elements l, l+1, ..., l+k of the longest integer range
+   * starting at l that was enumerated in the current round.
+   */
+  std::map<Node, std::vector<Node> > d_range_elements;
 };
 
 }
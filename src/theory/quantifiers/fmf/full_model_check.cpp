@@ -94,14 +94,15 @@ int EntryTrie::getGeneralizationIndex( FirstOrderModelFmc * m, std::vector<Node>
   }else{
     int minIndex = -1;
     Node st = m->getStar(inst[index].getType());
-    if (d_child.find(st) != d_child.end())
+    std::map<Node, EntryTrie>::iterator it = d_child.find(st);
+    if (it != d_child.end())
     {
-      minIndex = d_child[st].getGeneralizationIndex(m, inst, index + 1);
+      minIndex = it->second.getGeneralizationIndex(m, inst, index + 1);
     }
     Node cc = inst[index];
-    if (cc != st && d_child.find(cc) != d_child.end())
+    if (cc != st && (it = d_child.find(cc)) != d_child.end())
     {
-      int gindex = d_child[cc].getGeneralizationIndex(m, inst, index + 1);
+      int gindex = it->second.getGeneralizationIndex(m, inst, index + 1);
       if (minIndex == -1 || (gindex != -1 && gindex < minIndex))
       {
         minIndex = gindex;
@@ -1036,11 +1037,14 @@ void FullModelChecker::doUninterpretedCompose( FirstOrderModelFmc * fm, Node f,
     if( entries.empty() ){
       d.addEntry(fm, mkCond(cond), Node::null());
     }else{
-      //add them to the definition
-      for( unsigned e=0; e<df.d_cond.size(); e++ ){
-        if ( entries.find(e)!=entries.end() ){
+      // add them to the definition, in the order of the entries of df
+      for (const std::pair<const int, Node>& e : entries)
+      {
+        if (e.first >= 0)
+        {
+          Assert(e.first < static_cast<int>(df.d_cond.size()));
           Trace("fmf-uf-process-debug") << "Add entry..." << std::endl;
-          d.addEntry(fm, entries[e], df.d_value[e] );
+          d.addEntry(fm, e.second, df.d_value[e.first]);
           Trace("fmf-uf-process-debug") << "Done add entry." << std::endl;
         }
       }
@@ -1106,18 +1110,20 @@ void FullModelChecker::doUninterpretedCompose2( FirstOrderModelFmc * fm, Node f,
       cond[j + 1] = fm->getStar(v.getType());
     }else{
       if( !v.isNull() ){
-        if (curr.d_child.find(v) != curr.d_child.end())
+        std::map<Node, EntryTrie>::iterator it = curr.d_child.find(v);
+        if (it != curr.d_child.end())
         {
           Trace("fmc-uf-process") << "follow value..." << std::endl;
           doUninterpretedCompose2(
-              fm, f, entries, index + 1, cond, val, curr.d_child[v]);
+              fm, f, entries, index + 1, cond, val, it->second);
         }
         Node st = fm->getStar(v.getType());
-        if (curr.d_child.find(st) != curr.d_child.end())
+        it = curr.d_child.find(st);
+        if (it != curr.d_child.end())
         {
           Trace("fmc-uf-process") << "follow star..." << std::endl;
           doUninterpretedCompose2(
-              fm, f, entries, index + 1, cond, val, curr.d_child[st]);
+              fm, f, entries, index + 1, cond, val, it->second);
         }
       }
     }
@@ -310,6 +310,18 @@ void ModelEngine::exhaustiveInstantiate( Node f, int effort ){
             }
           }else{
             Debug("fmf-model-eval") << "* Failed Add instantiation " << m << std::endl;
+            if (options::instNoEntail() && options::instNoEntailPrefix())
+            {
+              int index = getEntailedPrefix(f, riter);
+              if (index >= 0)
+              {
+                // all tuples that agree with this one up to index are entailed
+                Debug("fmf-model-eval") << "* Skip entailed prefix at index "
+                                        << index << std::endl;
+                riter.incrementAtIndex(index);
+                continue;
+              }
+            }
           }
           riter.increment();
         }
@@ -327,6 +339,27 @@ void ModelEngine::exhaustiveInstantiate( Node f, int effort ){
   }
 }
 
+int ModelEngine::getEntailedPrefix(Node f, RepSetIterator& riter)
+{
+  TermDb* tdb = d_quantEngine->getTermDatabase();
+  EqualityQuery* qy = d_quantEngine->getEqualityQuery();
+  // the terms of the substitution, in the order of the iteration
+  std::vector<Node> terms;
+  std::map<TNode, TNode> subs;
+  // the full tuple is checked by the instantiation itself
+  for (unsigned i = 0, nterms = riter.getNumTerms(); i + 1 < nterms; i++)
+  {
+    unsigned v = riter.getVariableOrder(i);
+    terms.push_back(riter.getCurrentTerm(v));
+    subs[f[0][v]] = terms.back();
+    if (tdb->isEntailed(f[1], subs, false, true, qy))
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
 void ModelEngine::debugPrint( const char* c ){
   Trace( c ) << "Quantifiers: " << std::endl;
   for( unsigned i=0; i<d_quantEngine->getModel()->getNumAssertedQuantifiers(); i++ ){
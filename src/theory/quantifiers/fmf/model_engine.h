@@ -36,6 +36,13 @@ private:
   int checkModel();
   //exhaustively instantiate quantifier (possibly using mbqi)
   void exhaustiveInstantiate( Node f, int effort = 0 );
+  /**
+   * Returns the smallest index i (in the order of riter) such that the body of
+   * f is currently entailed when its variables at indices 0...i are replaced
+   * by the current terms of riter, or -1 if there is none smaller than the
+   * last index.
+   */
+  int getEntailedPrefix(Node f, RepSetIterator& riter);
 private:
   //temporary statistics
   //is the exhaustive instantiation incomplete?
@@ -40,7 +40,7 @@ bool InstMatchTrie::addInstMatch(QuantifiersEngine* qe,
   }
   unsigned i_index = imtio ? imtio->d_order[index] : index;
   Node n = m[i_index];
-  std::map<Node, InstMatchTrie>::iterator it = d_data.find(n);
+  DataMap::iterator it = d_data.find(n);
   if (it != d_data.end())
   {
     bool ret =
@@ -63,7 +63,7 @@ bool InstMatchTrie::addInstMatch(QuantifiersEngine* qe,
         Node en = (*eqc);
         if (en != n)
         {
-          std::map<Node, InstMatchTrie>::iterator itc = d_data.find(en);
+          DataMap::iterator itc = d_data.find(en);
           if (itc != d_data.end())
           {
             if (itc->second.addInstMatch(
@@ -93,7 +93,7 @@ bool InstMatchTrie::removeInstMatch(Node q,
   Assert(!imtio || index < imtio->d_order.size());
   unsigned i_index = imtio ? imtio->d_order[index] : index;
   Node n = m[i_index];
-  std::map<Node, InstMatchTrie>::iterator it = d_data.find(n);
+  DataMap::iterator it = d_data.find(n);
   if (it != d_data.end())
   {
     if ((index + 1) == q[0].getNumChildren()
@@ -120,7 +120,7 @@ bool InstMatchTrie::recordInstLemma(Node q,
     return true;
   }
   unsigned i_index = imtio ? imtio->d_order[index] : index;
-  std::map<Node, InstMatchTrie>::iterator it = d_data.find(m[i_index]);
+  DataMap::iterator it = d_data.find(m[i_index]);
   if (it != d_data.end())
   {
     return it->second.recordInstLemma(q, m, lem, imtio, index + 1);
@@ -298,7 +298,7 @@ bool CDInstMatchTrie::addInstMatch(QuantifiersEngine* qe,
     return reset;
   }
   Node n = m[index];
-  std::map<Node, CDInstMatchTrie*>::iterator it = d_data.find(n);
+  DataMap::iterator it = d_data.find(n);
   if (it != d_data.end())
   {
     bool ret =
@@ -321,7 +321,7 @@ bool CDInstMatchTrie::addInstMatch(QuantifiersEngine* qe,
         Node en = (*eqc);
         if (en != n)
         {
-          std::map<Node, CDInstMatchTrie*>::iterator itc = d_data.find(en);
+          DataMap::iterator itc = d_data.find(en);
           if (itc != d_data.end())
           {
             if (itc->second->addInstMatch(qe, f, m, c, modEq, index + 1, true))
@@ -359,7 +359,7 @@ bool CDInstMatchTrie::removeInstMatch(Node q,
     }
     return false;
   }
-  std::map<Node, CDInstMatchTrie*>::iterator it = d_data.find(m[index]);
+  DataMap::iterator it = d_data.find(m[index]);
   if (it != d_data.end())
   {
     return it->second->removeInstMatch(q, m, index + 1);
@@ -381,7 +381,7 @@ bool CDInstMatchTrie::recordInstLemma(Node q,
     }
     return false;
   }
-  std::map<Node, CDInstMatchTrie*>::iterator it = d_data.find(m[index]);
+  DataMap::iterator it = d_data.find(m[index]);
   if (it != d_data.end())
   {
     return it->second->recordInstLemma(q, m, lem, index + 1);
@@ -18,6 +18,7 @@
 #define CVC4__THEORY__QUANTIFIERS__INST_MATCH_TRIE_H
 
 #include <map>
+#include <unordered_map>
 
 #include "context/cdlist.h"
 #include "context/cdo.h"
@@ -42,6 +43,13 @@ namespace inst {
 class InstMatchTrie
 {
  public:
+  /**
+   * The children of a node of the trie. Since this is a hash map, the
+   * instantiations are enumerated in an unspecified (but deterministic)
+   * order.
+   */
+  typedef std::unordered_map<Node, InstMatchTrie, NodeHashFunction> DataMap;
+
   /** index ordering */
   class ImtIndexOrder
   {
@@ -172,7 +180,7 @@ class InstMatchTrie
     print(out, q, terms, firstTime, useActive, active);
   }
   /** the data */
-  std::map<Node, InstMatchTrie> d_data;
+  DataMap d_data;
 
  private:
   /** helper for print
@@ -221,6 +229,9 @@ class InstMatchTrie
 class CDInstMatchTrie
 {
  public:
+  /** The children of a node of the trie */
+  typedef std::unordered_map<Node, CDInstMatchTrie*, NodeHashFunction> DataMap;
+
   CDInstMatchTrie(context::Context* c) : d_valid(c, false) {}
   ~CDInstMatchTrie();
 
@@ -342,7 +353,7 @@ class CDInstMatchTrie
 
  private:
   /** the data */
-  std::map<Node, CDInstMatchTrie*> d_data;
+  DataMap d_data;
   /** is valid */
   context::CDO<bool> d_valid;
   /** helper for print
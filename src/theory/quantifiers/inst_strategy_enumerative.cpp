@@ -14,8 +14,11 @@
 
 #include "theory/quantifiers/inst_strategy_enumerative.h"
 
+#include <algorithm>
+
 #include "options/quantifiers_options.h"
 #include "theory/quantifiers/instantiate.h"
+#include "theory/quantifiers/quantifiers_attributes.h"
 #include "theory/quantifiers/relevant_domain.h"
 #include "theory/quantifiers/term_database.h"
 #include "theory/quantifiers/term_util.h"
@@ -152,6 +155,25 @@ void InstStrategyEnum::check(Theory::Effort e, QEffort quant_e)
   }
 }
 
+namespace {
+
+/** Orders terms by increasing instantiation level */
+struct SortInstLevel
+{
+  static uint64_t getLevel(const Node& t)
+  {
+    return t.hasAttribute(InstLevelAttribute())
+               ? t.getAttribute(InstLevelAttribute())
+               : 0;
+  }
+  bool operator()(const Node& a, const Node& b) const
+  {
+    return getLevel(a) < getLevel(b);
+  }
+};
+
+}  // namespace
+
 bool InstStrategyEnum::process(Node f, bool fullEffort, bool isRd)
 {
   // ignore if constant true (rare case of non-standard quantifier whose body is
@@ -165,7 +187,12 @@ bool InstStrategyEnum::process(Node f, bool fullEffort, bool isRd)
   std::vector<bool> max_zero;
   bool has_zero = false;
   std::map<TypeNode, std::vector<Node> > term_db_list;
+  std::vector<std::vector<Node> > rd_list;
   std::vector<TypeNode> ftypes;
+  // The enumeration below tries the tuples of the first terms of each list
+  // first. The term database lists its terms in order of creation, we also
+  // put the terms of lower instantiation levels first.
+  SortInstLevel cmpAge;
   TermDb* tdb = d_quantEngine->getTermDatabase();
   EqualityQuery* qy = d_quantEngine->getEqualityQuery();
   // iterate over substitutions for variables
@@ -176,7 +203,10 @@ bool InstStrategyEnum::process(Node f, bool fullEffort, bool isRd)
     unsigned ts;
     if (isRd)
     {
-      ts = d_rd->getRDomain(f, i)->d_terms.size();
+      // copy the relevant domain, to sort it by age below
+      rd_list.push_back(d_rd->getRDomain(f, i)->d_terms);
+      std::stable_sort(rd_list[i].begin(), rd_list[i].end(), cmpAge);
+      ts = rd_list[i].size();
     }
     else
     {
@@ -199,6 +229,8 @@ bool InstStrategyEnum::process(Node f, bool fullEffort, bool isRd)
             }
           }
         }
+        std::stable_sort(
+            term_db_list[tn].begin(), term_db_list[tn].end(), cmpAge);
         ts = term_db_list[tn].size();
       }
       else
@@ -282,10 +314,9 @@ bool InstStrategyEnum::process(Node f, bool fullEffort, bool isRd)
             }
             else if (isRd)
             {
-              terms.push_back(d_rd->getRDomain(f, i)->d_terms[childIndex[i]]);
-              Trace("inst-alg-rd")
-                  << "  " << d_rd->getRDomain(f, i)->d_terms[childIndex[i]]
-                  << std::endl;
+              terms.push_back(rd_list[i][childIndex[i]]);
+              Trace("inst-alg-rd") << "  " << rd_list[i][childIndex[i]]
+                                   << std::endl;
             }
             else
             {
@@ -305,6 +336,29 @@ bool InstStrategyEnum::process(Node f, bool fullEffort, bool isRd)
           else
           {
             index--;
+            if (options::instNoEntail() && options::instNoEntailPrefix())
+            {
+              // If f is entailed for a prefix of terms, so are all the
+              // instances that extend it, hence we move on to the next term
+              // for the last variable of the prefix. The full tuple is
+              // checked by the instantiation itself.
+              std::map<TNode, TNode> subs;
+              for (unsigned i = 0, nchild = f[0].getNumChildren();
+                   i + 1 < nchild && !terms[i].isNull();
+                   i++)
+              {
+                subs[f[0][i]] = terms[i];
+                if (tdb->isEntailed(f[1], subs, false, true, qy))
+                {
+                  Trace("inst-alg-rd")
+                      << "Entailed for prefix of size " << (i + 1)
+                      << std::endl;
+                  childIndex.resize(i + 1);
+                  index = i;
+                  break;
+                }
+              }
+            }
           }
         }
       } while (success);
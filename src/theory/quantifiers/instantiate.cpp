@@ -38,6 +38,8 @@ Instantiate::Instantiate(QuantifiersEngine* qe, context::UserContext* u)
       d_term_db(nullptr),
       d_term_util(nullptr),
       d_total_inst_count_debug(0),
+      d_budget_exceeded(false),
+      d_statistics(d_total_inst_debug),
       d_c_inst_match_trie_dom(u)
 {
 }
@@ -66,6 +68,8 @@ bool Instantiate::reset(Theory::Effort e)
   }
   d_term_db = d_qe->getTermDatabase();
   d_term_util = d_qe->getTermUtil();
+  d_inst_round_count.clear();
+  d_budget_exceeded = false;
   return true;
 }
 
@@ -78,6 +82,12 @@ bool Instantiate::checkComplete()
         << "Set incomplete due to recorded instantiations." << std::endl;
     return false;
   }
+  if (d_budget_exceeded)
+  {
+    Trace("quant-engine-debug")
+        << "Set incomplete due to the instantiation budget." << std::endl;
+    return false;
+  }
   return true;
 }
 
@@ -110,11 +120,22 @@ bool Instantiate::addInstantiation(
     Node q, std::vector<Node>& terms, bool mkRep, bool modEq, bool doVts)
 {
   // For resource-limiting (also does a time check).
-  d_qe->getOutputChannel().safePoint(options::quantifierStep());
+  d_qe->getOutputChannel().safePoint(ResourceManager::Resource::QuantifierStep,
+                                     options::quantifierStep());
   Assert(!d_qe->inConflict());
   Assert(terms.size() == q[0].getNumChildren());
   Assert(d_term_db != nullptr);
   Assert(d_term_util != nullptr);
+  // check the budget of q for this round before doing any work
+  if (options::instBudget() > 0
+      && d_inst_round_count[q] >= options::instBudget())
+  {
+    Trace("inst-add-debug") << "For quantified formula " << q
+                            << ", budget exceeded." << std::endl;
+    ++(d_statistics.d_inst_budget);
+    d_budget_exceeded = true;
+    return false;
+  }
   Trace("inst-add-debug") << "For quantified formula " << q
                           << ", add instantiation: " << std::endl;
   for (unsigned i = 0, size = terms.size(); i < size; i++)
@@ -280,6 +301,10 @@ bool Instantiate::addInstantiation(
 
   d_total_inst_debug[q]++;
   d_temp_inst_debug[q]++;
+  if (options::instBudget() > 0)
+  {
+    d_inst_round_count[q]++;
+  }
   d_total_inst_count_debug++;
   if (Trace.isOn("inst"))
   {
@@ -776,18 +801,51 @@ void Instantiate::debugPrintModel()
   }
 }
 
-Instantiate::Statistics::Statistics()
+void Instantiate::InstPerQuantStat::flushInformation(std::ostream& out) const
+{
+  // the quantified formulas with the most instantiations first
+  std::vector<std::pair<int, Node> > counts;
+  for (const std::pair<const Node, int>& i : d_instPerQuant)
+  {
+    counts.push_back(std::pair<int, Node>(-i.second, i.first));
+  }
+  std::sort(counts.begin(), counts.end());
+  static const size_t maxPrinted = 10;
+  out << "[";
+  for (size_t i = 0, size = std::min(counts.size(), maxPrinted); i < size; i++)
+  {
+    out << (i > 0 ? ", " : "") << "(" << counts[i].second << " : "
+        << -counts[i].first << ")";
+  }
+  if (counts.size() > maxPrinted)
+  {
+    out << ", ...";
+  }
+  out << "]";
+}
+
+void Instantiate::InstPerQuantStat::safeFlushInformation(int fd) const
+{
+  // printing the quantified formulas would allocate
+  safe_print(fd, "<unsupported>");
+}
+
+Instantiate::Statistics::Statistics(const std::map<Node, int>& instPerQuant)
     : d_instantiations("Instantiate::Instantiations_Total", 0),
       d_inst_duplicate("Instantiate::Duplicate_Inst", 0),
       d_inst_duplicate_eq("Instantiate::Duplicate_Inst_Eq", 0),
       d_inst_duplicate_ent("Instantiate::Duplicate_Inst_Entailed", 0),
-      d_inst_duplicate_model_true("Instantiate::Duplicate_Inst_Model_True", 0)
+      d_inst_duplicate_model_true("Instantiate::Duplicate_Inst_Model_True", 0),
+      d_inst_budget("Instantiate::Inst_Over_Budget", 0),
+      d_inst_per_quant("Instantiate::Instantiations_Per_Quant", instPerQuant)
 {
   smtStatisticsRegistry()->registerStat(&d_instantiations);
   smtStatisticsRegistry()->registerStat(&d_inst_duplicate);
   smtStatisticsRegistry()->registerStat(&d_inst_duplicate_eq);
   smtStatisticsRegistry()->registerStat(&d_inst_duplicate_ent);
   smtStatisticsRegistry()->registerStat(&d_inst_duplicate_model_true);
+  smtStatisticsRegistry()->registerStat(&d_inst_budget);
+  smtStatisticsRegistry()->registerStat(&d_inst_per_quant);
 }
 
 Instantiate::Statistics::~Statistics()
@@ -797,6 +855,8 @@ Instantiate::Statistics::~Statistics()
   smtStatisticsRegistry()->unregisterStat(&d_inst_duplicate_eq);
   smtStatisticsRegistry()->unregisterStat(&d_inst_duplicate_ent);
   smtStatisticsRegistry()->unregisterStat(&d_inst_duplicate_model_true);
+  smtStatisticsRegistry()->unregisterStat(&d_inst_budget);
+  smtStatisticsRegistry()->unregisterStat(&d_inst_per_quant);
 }
 
 } /* CVC4::theory::quantifiers namespace */
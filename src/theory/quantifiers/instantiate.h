@@ -18,6 +18,7 @@
 #define CVC4__THEORY__QUANTIFIERS__INSTANTIATE_H
 
 #include <map>
+#include <unordered_map>
 
 #include "expr/node.h"
 #include "theory/quantifiers/inst_match_trie.h"
@@ -328,6 +329,25 @@ class Instantiate : public QuantifiersUtil
                                    std::map<Node, std::vector<Node> >& tvec);
   //--------------------------------------end user-level interface utilities
 
+  /**
+   * A statistic for the quantified formulas with the most instantiations,
+   * which are often the ones responsible for matching loops.
+   */
+  class InstPerQuantStat : public Stat
+  {
+   public:
+    InstPerQuantStat(const std::string& name,
+                     const std::map<Node, int>& instPerQuant)
+        : Stat(name), d_instPerQuant(instPerQuant)
+    {
+    }
+    void flushInformation(std::ostream& out) const override;
+    void safeFlushInformation(int fd) const override;
+
+   private:
+    /** the number of instantiations of each quantified formula */
+    const std::map<Node, int>& d_instPerQuant;
+  }; /* class Instantiate::InstPerQuantStat */
   /** statistics class
    *
    * This tracks statistics on the number of instantiations successfully
@@ -342,10 +362,11 @@ class Instantiate : public QuantifiersUtil
     IntStat d_inst_duplicate_eq;
     IntStat d_inst_duplicate_ent;
     IntStat d_inst_duplicate_model_true;
-    Statistics();
+    IntStat d_inst_budget;
+    InstPerQuantStat d_inst_per_quant;
+    Statistics(const std::map<Node, int>& instPerQuant);
     ~Statistics();
   }; /* class Instantiate::Statistics */
-  Statistics d_statistics;
 
  private:
   /** record instantiation, return true if it was not a duplicate
@@ -379,6 +400,15 @@ class Instantiate : public QuantifiersUtil
   std::map<Node, int> d_total_inst_debug;
   /** statistics for debugging total instantiations per quantifier per round */
   std::map<Node, int> d_temp_inst_debug;
+  /**
+   * The number of instantiations of each quantified formula in this round,
+   * counted when options::instBudget() is set.
+   */
+  std::unordered_map<Node, unsigned, NodeHashFunction> d_inst_round_count;
+  /** whether an instantiation was rejected by the budget in this round */
+  bool d_budget_exceeded;
+  /** the statistics, which refer to d_total_inst_debug */
+  Statistics d_statistics;
 
   /** list of all instantiations produced for each quantifier
    *
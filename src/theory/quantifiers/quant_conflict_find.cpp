@@ -947,6 +947,7 @@ void QuantInfo::debugPrintMatch( const char * c ) {
 MatchGen::MatchGen()
   : d_matched_basis(),
     d_binding(),
+    d_evaluated_round(0),
     d_tgt(),
     d_tgt_orig(),
     d_wasSet(),
@@ -963,6 +964,7 @@ MatchGen::MatchGen()
 MatchGen::MatchGen( QuantInfo * qi, Node n, bool isVar )
   : d_matched_basis(),
     d_binding(),
+    d_evaluated_round(0),
     d_tgt(),
     d_tgt_orig(),
     d_wasSet(),
@@ -1194,6 +1196,16 @@ bool MatchGen::reset_round(QuantConflictFind* p)
       return false;
     }
   }
+  d_qni_bound_cons.clear();
+  d_qni_bound_cons_var.clear();
+  d_qni_bound.clear();
+  // The ground subterms only depend on the equality state, which does not
+  // change between the effort levels of a call to QuantConflictFind::check.
+  if (d_evaluated_round == p->d_round)
+  {
+    return true;
+  }
+  d_evaluated_round = p->d_round;
   for( std::map< int, TNode >::iterator it = d_qni_gterm.begin(); it != d_qni_gterm.end(); ++it ){
     d_qni_gterm_rep[it->first] = p->getRepresentative( it->second );
   }
@@ -1241,9 +1253,6 @@ bool MatchGen::reset_round(QuantConflictFind* p)
       }
     }
   }
-  d_qni_bound_cons.clear();
-  d_qni_bound_cons_var.clear();
-  d_qni_bound.clear();
   return true;
 }
 
@@ -1844,7 +1853,8 @@ QuantConflictFind::QuantConflictFind(QuantifiersEngine* qe, context::Context* c)
       d_conflict(c, false),
       d_true(NodeManager::currentNM()->mkConst<bool>(true)),
       d_false(NodeManager::currentNM()->mkConst<bool>(false)),
-      d_effort(EFFORT_INVALID)
+      d_effort(EFFORT_INVALID),
+      d_round(0)
 {
 }
 
@@ -1987,6 +1997,7 @@ void QuantConflictFind::check(Theory::Effort level, QEffort quant_e)
   }
   unsigned addedLemmas = 0;
   ++(d_statistics.d_inst_rounds);
+  ++d_round;
   double clSet = 0;
   int prevEt = 0;
   if (Trace.isOn("qcf-engine"))
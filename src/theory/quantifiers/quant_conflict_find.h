@@ -63,6 +63,11 @@ private:
   bool d_binding;
   //int getVarBindingVar();
   std::map< int, Node > d_ground_eval;
+  /**
+   * The value of QuantConflictFind::d_round when d_qni_gterm_rep and
+   * d_ground_eval were last computed by reset_round.
+   */
+  unsigned d_evaluated_round;
   //determine variable order
   void determineVariableOrder( QuantInfo * qi, std::vector< int >& bvars );
   void collectBoundVar( QuantInfo * qi, Node n, std::vector< int >& cbvars, std::map< Node, bool >& visited, bool& hasNested );
@@ -92,9 +97,11 @@ public:
   bool d_type_not;
   /** reset round
    *
-   * Called once at the beginning of each full/last-call effort, prior to
-   * processing this match generator. This method returns false if the reset
-   * failed, e.g. if a conflict was encountered during term indexing.
+   * Called at the beginning of each effort level of a full/last-call effort,
+   * prior to processing this match generator. The ground subterms are only
+   * evaluated at the first call for each call to QuantConflictFind::check.
+   * This method returns false if the reset failed, e.g. if a conflict was
+   * encountered during term indexing.
    */
   bool reset_round(QuantConflictFind* p);
   void reset( QuantConflictFind * p, bool tgt, QuantInfo * qi );
@@ -227,6 +234,8 @@ private:  //for equivalence classes
 
  private:
   Effort d_effort;
+  /** the number of calls to check, see MatchGen::reset_round */
+  unsigned d_round;
 
  public:
   bool areMatchEqual( TNode n1, TNode n2 );
@@ -34,10 +34,12 @@ void RelevantDomain::RDomain::merge( RDomain * r ) {
     r->addTerm( d_terms[i] );
   }
   d_terms.clear();
+  d_termSet.clear();
 }
 
 void RelevantDomain::RDomain::addTerm( Node t ) {
-  if( std::find( d_terms.begin(), d_terms.end(), t )==d_terms.end() ){
+  if (d_termSet.insert(t).second)
+  {
     d_terms.push_back( t );
   }
 }
@@ -64,8 +66,10 @@ void RelevantDomain::RDomain::removeRedundantTerms( QuantifiersEngine * qe ) {
     }
   }
   d_terms.clear();
+  d_termSet.clear();
   for( std::map< Node, Node >::iterator it = rterms.begin(); it != rterms.end(); ++it ){
     d_terms.push_back( it->second );
+    d_termSet.insert(it->second);
   }
 }
 
@@ -75,23 +79,49 @@ RelevantDomain::RelevantDomain( QuantifiersEngine* qe ) : d_qe( qe ){
    d_is_computed = false;
 }
 
-RelevantDomain::~RelevantDomain() {
-  for( std::map< Node, std::map< int, RDomain * > >::iterator itr = d_rel_doms.begin(); itr != d_rel_doms.end(); ++itr ){
-    for( std::map< int, RDomain * >::iterator itr2 = itr->second.begin(); itr2 != itr->second.end(); ++itr2 ){
-      RDomain * current = (*itr2).second;
-      Assert(current != NULL);
-      delete current;
-    }
+RelevantDomain::~RelevantDomain() {}
+
+RelevantDomain::RDomain * RelevantDomain::getRDomain( Node n, int i, bool getParent ) {
+  Assert(i >= 0);
+  std::unordered_map<Node, size_t, NodeHashFunction>::iterator it =
+      d_rel_dom_id.find(n);
+  size_t id;
+  if (it == d_rel_dom_id.end())
+  {
+    id = d_rel_doms.size();
+    d_rel_dom_id[n] = id;
+    d_rel_doms.emplace_back();
+  }
+  else
+  {
+    id = it->second;
   }
+  std::vector<RDomain*>& rds = d_rel_doms[id];
+  if (rds.size() <= static_cast<size_t>(i))
+  {
+    rds.resize(i + 1, nullptr);
+  }
+  if (rds[i] == nullptr)
+  {
+    d_domains.emplace_back(new RDomain(n, i));
+    rds[i] = d_domains.back().get();
+  }
+  return getParent ? rds[i]->getParent() : rds[i];
 }
 
-RelevantDomain::RDomain * RelevantDomain::getRDomain( Node n, int i, bool getParent ) {
-  if( d_rel_doms.find( n )==d_rel_doms.end() || d_rel_doms[n].find( i )==d_rel_doms[n].end() ){
-    d_rel_doms[n][i] = new RDomain;
-    d_rn_map[d_rel_doms[n][i]] = n;
-    d_ri_map[d_rel_doms[n][i]] = i;
+void RelevantDomain::merge(RDomain* r1, RDomain* r2)
+{
+  r1 = r1->getParent();
+  r2 = r2->getParent();
+  if (r1 == r2)
+  {
+    return;
   }
-  return getParent ? d_rel_doms[n][i]->getParent() : d_rel_doms[n][i];
+  if (r1->d_terms.size() > r2->d_terms.size())
+  {
+    std::swap(r1, r2);
+  }
+  r1->merge(r2);
 }
 
 bool RelevantDomain::reset( Theory::Effort e ) {
@@ -103,17 +133,52 @@ void RelevantDomain::registerQuantifier(Node q) {}
 void RelevantDomain::compute(){
   if( !d_is_computed ){
     d_is_computed = true;
-    for( std::map< Node, std::map< int, RDomain * > >::iterator it = d_rel_doms.begin(); it != d_rel_doms.end(); ++it ){
-      for( std::map< int, RDomain * >::iterator it2 = it->second.begin(); it2 != it->second.end(); ++it2 ){
-        it2->second->reset();
+    FirstOrderModel* fm = d_qe->getModel();
+    std::vector<Node> quants;
+    for (unsigned i = 0; i < fm->getNumAssertedQuantifiers(); i++)
+    {
+      quants.push_back(fm->getAssertedQuantifier(i));
+    }
+    if (quants == d_computedQuants)
+    {
+      // the quantified formulas are the same, restore their contribution
+      Trace("rel-dom-debug") << "reuse relevant domain of quantified formulas"
+                             << std::endl;
+      for (size_t i = 0, size = d_domains.size(); i < size; i++)
+      {
+        RDomain* r = d_domains[i].get();
+        r->reset();
+        if (i < d_quantParents.size())
+        {
+          r->d_parent = d_quantParents[i];
+          for (const Node& t : d_quantTerms[i])
+          {
+            r->addTerm(t);
+          }
+        }
       }
     }
-    FirstOrderModel* fm = d_qe->getModel();
-    for( unsigned i=0; i<fm->getNumAssertedQuantifiers(); i++ ){
-      Node q = fm->getAssertedQuantifier( i );
-      Node icf = d_qe->getTermUtil()->getInstConstantBody( q );
-      Trace("rel-dom-debug") << "compute relevant domain for " << icf << std::endl;
-      computeRelevantDomain( q, icf, true, true );
+    else
+    {
+      for (std::unique_ptr<RDomain>& r : d_domains)
+      {
+        r->reset();
+      }
+      for (const Node& q : quants)
+      {
+        Node icf = d_qe->getTermUtil()->getInstConstantBody( q );
+        Trace("rel-dom-debug") << "compute relevant domain for " << icf << std::endl;
+        computeRelevantDomain( q, icf, true, true );
+      }
+      d_computedQuants = quants;
+      d_quantParents.clear();
+      d_quantTerms.clear();
+      for (std::unique_ptr<RDomain>& r : d_domains)
+      {
+        RDomain* rp = r->getParent();
+        d_quantParents.push_back(rp == r.get() ? nullptr : rp);
+        d_quantTerms.push_back(r->d_terms);
+      }
     }
 
     Trace("rel-dom-debug") << "account for ground terms" << std::endl;
@@ -135,22 +200,22 @@ void RelevantDomain::compute(){
       }
     }
     //print debug
-    for( std::map< Node, std::map< int, RDomain * > >::iterator it = d_rel_doms.begin(); it != d_rel_doms.end(); ++it ){
-      Trace("rel-dom") << "Relevant domain for " << it->first << " : " << std::endl;
-      for( std::map< int, RDomain * >::iterator it2 = it->second.begin(); it2 != it->second.end(); ++it2 ){
-        Trace("rel-dom") << "   " << it2->first << " : ";
-        RDomain * r = it2->second;
-        RDomain * rp = r->getParent();
-        if( r==rp ){
-          r->removeRedundantTerms( d_qe );
-          for( unsigned i=0; i<r->d_terms.size(); i++ ){
-            Trace("rel-dom") << r->d_terms[i] << " ";
-          }
-        }else{
-          Trace("rel-dom") << "Dom( " << d_rn_map[rp] << ", " << d_ri_map[rp] << " ) ";
+    for (std::unique_ptr<RDomain>& rr : d_domains)
+    {
+      RDomain* r = rr.get();
+      Trace("rel-dom") << "Relevant domain for " << r->getNode() << " "
+                       << r->getIndex() << " : ";
+      RDomain * rp = r->getParent();
+      if( r==rp ){
+        r->removeRedundantTerms( d_qe );
+        for( unsigned i=0; i<r->d_terms.size(); i++ ){
+          Trace("rel-dom") << r->d_terms[i] << " ";
         }
-        Trace("rel-dom") << std::endl;
+      }else{
+        Trace("rel-dom") << "Dom( " << rp->getNode() << ", " << rp->getIndex()
+                         << " ) ";
       }
+      Trace("rel-dom") << std::endl;
     }
   }
 }
@@ -185,11 +250,8 @@ void RelevantDomain::computeRelevantDomain( Node q, Node n, bool hasPol, bool po
     if( d_rel_dom_lit[hasPol][pol][n].d_merge ){
       Assert(d_rel_dom_lit[hasPol][pol][n].d_rd[0] != NULL
              && d_rel_dom_lit[hasPol][pol][n].d_rd[1] != NULL);
-      RDomain * rd1 = d_rel_dom_lit[hasPol][pol][n].d_rd[0]->getParent();
-      RDomain * rd2 = d_rel_dom_lit[hasPol][pol][n].d_rd[1]->getParent();
-      if( rd1!=rd2 ){
-        rd1->merge( rd2 );
-      }
+      merge(d_rel_dom_lit[hasPol][pol][n].d_rd[0],
+            d_rel_dom_lit[hasPol][pol][n].d_rd[1]);
     }else{
       if( d_rel_dom_lit[hasPol][pol][n].d_rd[0]!=NULL ){
         RDomain * rd = d_rel_dom_lit[hasPol][pol][n].d_rd[0]->getParent();
@@ -209,14 +271,11 @@ void RelevantDomain::computeRelevantDomainOpCh( RDomain * rf, Node n ) {
     unsigned id = n.getAttribute(InstVarNumAttribute());
     Trace("rel-dom-debug") << n << " is variable # " << id << " for " << q;
     Trace("rel-dom-debug") << " with body : " << d_qe->getTermUtil()->getInstConstantBody( q ) << std::endl;
-    RDomain * rq = getRDomain( q, id );
-    if( rf!=rq ){
-      rq->merge( rf );
-    }
+    merge(getRDomain(q, id), rf);
   }else if( !TermUtil::hasInstConstAttr( n ) ){
     Trace("rel-dom-debug") << "...add ground term to rel dom " << n << std::endl;
     //term to add
-    rf->addTerm( n );
+    rf->getParent()->addTerm( n );
   }
 }
 
@@ -17,6 +17,11 @@
 #ifndef CVC4__THEORY__QUANTIFIERS__RELEVANT_DOMAIN_H
 #define CVC4__THEORY__QUANTIFIERS__RELEVANT_DOMAIN_H
 
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include "theory/quantifiers/first_order_model.h"
 #include "theory/quantifiers/quant_util.h"
 
@@ -63,7 +68,7 @@ class RelevantDomain : public QuantifiersUtil
   class RDomain
   {
   public:
-    RDomain() : d_parent( NULL ) {}
+    RDomain(Node n, int i) : d_parent(NULL), d_node(n), d_index(i) {}
     /** the set of terms in this relevant domain */
     std::vector< Node > d_terms;
     /** reset this object */
@@ -71,6 +76,7 @@ class RelevantDomain : public QuantifiersUtil
     {
       d_parent = NULL;
       d_terms.clear();
+      d_termSet.clear();
     }
     /** merge this with r
      * This sets d_parent of this to r and
@@ -86,11 +92,22 @@ class RelevantDomain : public QuantifiersUtil
      */
     void removeRedundantTerms( QuantifiersEngine * qe );
     /** is n in this relevant domain? */
-    bool hasTerm( Node n ) { return std::find( d_terms.begin(), d_terms.end(), n )!=d_terms.end(); }
+    bool hasTerm(Node n) { return d_termSet.find(n) != d_termSet.end(); }
+    /** the function or quantified formula of this relevant domain */
+    Node getNode() const { return d_node; }
+    /** the argument or variable number of this relevant domain */
+    int getIndex() const { return d_index; }
 
    private:
+    friend class RelevantDomain;
     /** the parent of this relevant domain */
     RDomain* d_parent;
+    /** the terms of d_terms, for membership tests */
+    std::unordered_set<Node, NodeHashFunction> d_termSet;
+    /** the function or quantified formula of this relevant domain */
+    Node d_node;
+    /** the argument or variable number of this relevant domain */
+    int d_index;
   };
   /** get the relevant domain
    *
@@ -103,18 +120,33 @@ class RelevantDomain : public QuantifiersUtil
   RDomain* getRDomain(Node n, int i, bool getParent = true);
 
  private:
-  /** the relevant domains for each quantified formula and function,
-   * for each variable # and argument #.
+  /** all relevant domain objects, in the order of their creation */
+  std::vector<std::unique_ptr<RDomain>> d_domains;
+  /** the id of each quantified formula and function in d_rel_doms */
+  std::unordered_map<Node, size_t, NodeHashFunction> d_rel_dom_id;
+  /** the relevant domains for each quantified formula and function (by id),
+   * for each variable # and argument # (null if not created yet).
    */
-  std::map< Node, std::map< int, RDomain * > > d_rel_doms;
-  /** stores the function or quantified formula associated with
-   * each relevant domain object.
+  std::vector<std::vector<RDomain*>> d_rel_doms;
+  /** merge the (representative) relevant domains r1 and r2
+   *
+   * The domain with fewer terms is merged into the other one, so that the
+   * terms are copied at most a logarithmic number of times.
    */
-  std::map< RDomain *, Node > d_rn_map;
-  /** stores the argument or variable number associated with
-   * each relevant domain object.
+  void merge(RDomain* r1, RDomain* r2);
+  /** The asserted quantified formulas of the last call to compute. */
+  std::vector<Node> d_computedQuants;
+  /**
+   * The state of the first d_quantParents.size() relevant domain objects
+   * after accounting for the quantified formulas d_computedQuants in the
+   * last call to compute, that is, their representative and their terms.
+   * This only depends on the quantified formulas, and is restored by the
+   * next call to compute when they are the same, instead of traversing
+   * the quantified formulas again. The ground terms of the term database
+   * are added at each call.
    */
-  std::map< RDomain *, int > d_ri_map;
+  std::vector<RDomain*> d_quantParents;
+  std::vector<std::vector<Node>> d_quantTerms;
   /** Quantifiers engine associated with this utility. */
   QuantifiersEngine* d_qe;
   /** have we computed the relevant domain on this full effort check? */
@@ -575,7 +575,17 @@ Node CegSingleInv::reconstructToSyntax(Node s,
     if( reconstructed==1 ){
       Trace("csi-sol") << "Solution (post-reconstruction into Sygus): " << d_sygus_solution << std::endl;
     }
-  }else{
+    else if (options::cegqiSingleInvReconstructFallback())
+    {
+      // use the solution outside of the grammar
+      Warning() << "Reconstruction to syntax failed, the solution of "
+                   "single invocation does not respect the grammar."
+                << std::endl;
+      reconstructed = 0;
+    }
+  }
+  if (reconstructed == 0)
+  {
     Trace("csi-sol") << "Post-process solution..." << std::endl;
     Node prev = d_solution;
     if (options::minSynthSol())
@@ -125,8 +125,9 @@ Node CegSingleInvSol::reconstructSolution(Node sol,
   }
   if (Trace.isOn("csi-rcons"))
   {
-    for (std::map<TypeNode, std::map<Node, int> >::iterator it =
-             d_rcons_to_id.begin();
+    for (std::map<TypeNode,
+                  std::unordered_map<Node, int, NodeHashFunction> >::iterator
+             it = d_rcons_to_id.begin();
          it != d_rcons_to_id.end();
          ++it)
     {
@@ -135,7 +136,8 @@ Node CegSingleInvSol::reconstructSolution(Node sol,
       const DType& dt = tn.getDType();
       Trace("csi-rcons") << "Terms to reconstruct of type " << dt.getName()
                          << " : " << std::endl;
-      for (std::map<Node, int>::iterator it2 = it->second.begin();
+      for (std::unordered_map<Node, int, NodeHashFunction>::iterator it2 =
+               it->second.begin();
            it2 != it->second.end();
            ++it2)
       {
@@ -151,9 +153,25 @@ Node CegSingleInvSol::reconstructSolution(Node sol,
   {
     int index = 0;
     std::map< TypeNode, bool > active;
-    for( std::map< TypeNode, std::map< Node, int > >::iterator it = d_rcons_to_id.begin(); it != d_rcons_to_id.end(); ++it ){
+    for (std::map<TypeNode,
+                  std::unordered_map<Node, int, NodeHashFunction> >::iterator
+             it = d_rcons_to_id.begin();
+         it != d_rcons_to_id.end();
+         ++it)
+    {
       active[it->first] = true;
     }
+    // reconstructed terms are propagated bottom-up, instead of searching for
+    // a reconstruction of the root after each enumerated term
+    initReconstructOptions();
+    if (d_reconstruct.find(d_root_id) != d_reconstruct.end())
+    {
+      Node ret = d_reconstruct[d_root_id];
+      Trace("csi-rcons") << "Sygus solution (after propagation) is : " << ret
+                         << std::endl;
+      reconstructed = 1;
+      return ret;
+    }
     //enumerate for all types
     do {
       std::vector< TypeNode > to_erase;
@@ -166,7 +184,8 @@ Node CegSingleInvSol::reconstructSolution(Node sol,
           Node nb = d_qe->getTermDatabaseSygus()->sygusToBuiltin( ns, stn );
           Node nr = Rewriter::rewrite( nb );//d_qe->getTermDatabaseSygus()->getNormalized( stn, nb, false, false );
           Trace("csi-rcons-debug2") << "  - try " << ns << " -> " << nr << " for " << stn << " " << nr.getKind() << std::endl;
-          std::map< Node, int >::iterator itt = d_rcons_to_id[stn].find( nr );
+          std::unordered_map<Node, int, NodeHashFunction>::iterator itt =
+              d_rcons_to_id[stn].find(nr);
           if (itt != d_rcons_to_id[stn].end())
           {
             // if it is not already reconstructed
@@ -174,13 +193,13 @@ Node CegSingleInvSol::reconstructSolution(Node sol,
             {
               Trace("csi-rcons") << "...reconstructed " << ns << " for term "
                                  << nr << std::endl;
-              setReconstructed(itt->second, ns);
-              Trace("csi-rcons-debug")
-                  << "...path to root, try reconstruction." << std::endl;
-              d_tmp_fail.clear();
-              Node ret = getReconstructedSolution(d_root_id);
-              if (!ret.isNull())
+              std::vector<int> todo;
+              markReconstructed(itt->second, ns, todo);
+              propagateReconstructed(todo);
+              std::map<int, Node>::iterator itr = d_reconstruct.find(d_root_id);
+              if (itr != d_reconstruct.end())
               {
+                Node ret = itr->second;
                 Trace("csi-rcons")
                     << "Sygus solution (after enumeration) is : " << ret
                     << std::endl;
@@ -203,8 +222,11 @@ Node CegSingleInvSol::reconstructSolution(Node sol,
 
   // we ran out of elements, return null
   reconstructed = -1;
-  Warning() << CommandFailure(
-      "Cannot get synth function: reconstruction to syntax failed.");
+  if (!options::cegqiSingleInvReconstructFallback())
+  {
+    Warning() << CommandFailure(
+        "Cannot get synth function: reconstruction to syntax failed.");
+  }
   // could return sol here, however, we choose to fail by returning null, since
   // it indicates a failure.
   return Node::null();
@@ -212,7 +234,8 @@ Node CegSingleInvSol::reconstructSolution(Node sol,
 
 int CegSingleInvSol::collectReconstructNodes(Node t, TypeNode stn, int& status)
 {
-  std::map< Node, int >::iterator itri = d_rcons_to_status[stn].find( t );
+  std::unordered_map<Node, int, NodeHashFunction>::iterator itri =
+      d_rcons_to_status[stn].find(t);
   if( itri!=d_rcons_to_status[stn].end() ){
     status = itri->second;
     //Trace("csi-rcons-debug") << "-> (cached) " << status << " for " << d_rcons_to_id[stn][t] << std::endl;
@@ -459,7 +482,8 @@ Node CegSingleInvSol::CegSingleInvSol::getReconstructedSolution(int id,
   if( it!=d_reconstruct.end() ){
     return it->second;
   }else{
-    if( std::find( d_tmp_fail.begin(), d_tmp_fail.end(), id )!=d_tmp_fail.end() ){
+    if (d_tmp_fail.find(id) != d_tmp_fail.end())
+    {
       return Node::null();
     }else{
       // try each child option
@@ -499,7 +523,7 @@ Node CegSingleInvSol::CegSingleInvSol::getReconstructedSolution(int id,
           }
         }
       }
-      d_tmp_fail.push_back( id );
+      d_tmp_fail.insert(id);
       return Node::null();
     }
   }
@@ -507,7 +531,8 @@ Node CegSingleInvSol::CegSingleInvSol::getReconstructedSolution(int id,
 
 int CegSingleInvSol::allocate(Node n, TypeNode stn)
 {
-  std::map< Node, int >::iterator it = d_rcons_to_id[stn].find( n );
+  std::unordered_map<Node, int, NodeHashFunction>::iterator it =
+      d_rcons_to_id[stn].find(n);
   if( it==d_rcons_to_id[stn].end() ){
     int ret = d_id_count;
     if( Trace.isOn("csi-rcons-debug") ){
@@ -555,6 +580,103 @@ void CegSingleInvSol::setReconstructed(int id, Node n)
   }
 }
 
+void CegSingleInvSol::initReconstructOptions()
+{
+  d_rcons_options.clear();
+  d_rcons_watch.clear();
+  for (const std::pair<const int, std::map<Node, std::vector<int> > >& ito :
+       d_reconstruct_op)
+  {
+    for (const std::pair<const Node, std::vector<int> >& itt : ito.second)
+    {
+      RconsOption o;
+      o.d_id = ito.first;
+      o.d_cons = itt.first;
+      o.d_children = &itt.second;
+      o.d_pending = 0;
+      for (int c : itt.second)
+      {
+        if (d_reconstruct.find(c) == d_reconstruct.end())
+        {
+          o.d_pending++;
+          d_rcons_watch[c].push_back(d_rcons_options.size());
+        }
+      }
+      d_rcons_options.push_back(o);
+    }
+  }
+  // the options whose children are all reconstructed
+  std::vector<int> todo;
+  for (const RconsOption& o : d_rcons_options)
+  {
+    if (o.d_pending == 0 && d_reconstruct.find(o.d_id) == d_reconstruct.end())
+    {
+      std::vector<Node> children;
+      children.push_back(o.d_cons);
+      for (int c : *o.d_children)
+      {
+        children.push_back(d_reconstruct[c]);
+      }
+      markReconstructed(
+          o.d_id,
+          NodeManager::currentNM()->mkNode(APPLY_CONSTRUCTOR, children),
+          todo);
+    }
+  }
+  propagateReconstructed(todo);
+}
+
+void CegSingleInvSol::markReconstructed(int id,
+                                        Node n,
+                                        std::vector<int>& todo)
+{
+  for (int m : d_eqc[d_rep[id]])
+  {
+    if (d_reconstruct.find(m) == d_reconstruct.end())
+    {
+      d_reconstruct[m] = n;
+      todo.push_back(m);
+    }
+  }
+}
+
+void CegSingleInvSol::propagateReconstructed(std::vector<int>& todo)
+{
+  while (!todo.empty())
+  {
+    int id = todo.back();
+    todo.pop_back();
+    std::unordered_map<int, std::vector<size_t> >::iterator itw =
+        d_rcons_watch.find(id);
+    if (itw == d_rcons_watch.end())
+    {
+      continue;
+    }
+    for (size_t i : itw->second)
+    {
+      RconsOption& o = d_rcons_options[i];
+      Assert(o.d_pending > 0);
+      o.d_pending--;
+      if (o.d_pending > 0 || d_reconstruct.find(o.d_id) != d_reconstruct.end())
+      {
+        continue;
+      }
+      std::vector<Node> children;
+      children.push_back(o.d_cons);
+      for (int c : *o.d_children)
+      {
+        children.push_back(d_reconstruct[c]);
+      }
+      Node ret = NodeManager::currentNM()->mkNode(APPLY_CONSTRUCTOR, children);
+      Trace("csi-rcons-debug") << "...propagated reconstruction of " << o.d_id
+                               << std::endl;
+      markReconstructed(o.d_id, ret, todo);
+    }
+    // each term is reconstructed once
+    d_rcons_watch.erase(itw);
+  }
+}
+
 void CegSingleInvSol::getEquivalentTerms(Kind k,
                                          Node n,
                                          std::vector<Node>& equiv)
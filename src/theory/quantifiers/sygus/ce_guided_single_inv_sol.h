@@ -18,6 +18,8 @@
 #define CVC4__THEORY__QUANTIFIERS__CE_GUIDED_SINGLE_INV_SOL_H
 
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "context/cdhashmap.h"
@@ -83,8 +85,10 @@ private:
   int d_root_id;
   std::map< int, Node > d_id_node;
   std::map< int, TypeNode > d_id_type;
-  std::map< TypeNode, std::map< Node, int > > d_rcons_to_id;
-  std::map< TypeNode, std::map< Node, int > > d_rcons_to_status;
+  std::map<TypeNode, std::unordered_map<Node, int, NodeHashFunction> >
+      d_rcons_to_id;
+  std::map<TypeNode, std::unordered_map<Node, int, NodeHashFunction> >
+      d_rcons_to_status;
 
   std::map< int, std::map< Node, std::vector< int > > > d_reconstruct_op;
   std::map< int, Node > d_reconstruct;
@@ -98,7 +102,7 @@ private:
   std::map< Node, std::vector< Node > > d_eqt_eqc;
 
   //cache when reconstructing solutions
-  std::vector< int > d_tmp_fail;
+  std::unordered_set<int> d_tmp_fail;
   // get reconstructed solution
   Node getReconstructedSolution( int id, bool mod_eq = true );
 
@@ -113,6 +117,41 @@ private:
                                int& status);
   bool getPathToRoot( int id );
   void setReconstructed( int id, Node n );
+  /**
+   * An option for reconstructing a term: the term of identifier d_id is
+   * reconstructed by an application of the constructor d_cons to the
+   * reconstructions of the terms of identifiers d_children, d_pending of
+   * which are not reconstructed yet.
+   */
+  struct RconsOption
+  {
+    int d_id;
+    Node d_cons;
+    const std::vector<int>* d_children;
+    size_t d_pending;
+  };
+  /** the options of all terms, built from d_reconstruct_op */
+  std::vector<RconsOption> d_rcons_options;
+  /** the indices of the options that have each term as a child */
+  std::unordered_map<int, std::vector<size_t> > d_rcons_watch;
+  /**
+   * Build the options above and propagate the terms that are reconstructed
+   * already. After this, a term is reconstructed as soon as one of its
+   * options has all its children reconstructed, using
+   * propagateReconstructed.
+   */
+  void initReconstructOptions();
+  /**
+   * Set n as the reconstruction of the equivalence class of id, and add its
+   * members that were not reconstructed to todo.
+   */
+  void markReconstructed(int id, Node n, std::vector<int>& todo);
+  /**
+   * Propagate the reconstruction of the terms in todo to the terms that
+   * have them as children, bottom-up. Each option is visited once per child,
+   * hence the total work over all calls is linear in the size of the options.
+   */
+  void propagateReconstructed(std::vector<int>& todo);
   //get equivalent terms to n with top symbol k
   void getEquivalentTerms( Kind k, Node n, std::vector< Node >& equiv );
   //register equivalent terms
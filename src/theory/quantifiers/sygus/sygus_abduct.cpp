@@ -41,22 +41,26 @@ Node SygusAbduct::mkAbductionConjecture(const std::string& name,
                                         const std::vector<Node>& axioms,
                                         TypeNode abdGType)
 {
-  NodeManager* nm = NodeManager::currentNM();
-  std::unordered_set<Node, NodeHashFunction> symset;
-  for (size_t i = 0, size = asserts.size(); i < size; i++)
-  {
-    expr::getSymbols(asserts[i], symset);
-  }
-  Trace("sygus-abduct-debug")
-      << "...finish, got " << symset.size() << " symbols." << std::endl;
+  SygusAbduct sa;
+  sa.initialize(axioms, abdGType);
+  return sa.mkConjecture(name, asserts);
+}
 
-  Trace("sygus-abduct-debug") << "Setup symbols..." << std::endl;
-  std::vector<Node> syms;
-  std::vector<Node> vars;
-  std::vector<Node> varlist;
-  std::vector<TypeNode> varlistTypes;
-  for (const Node& s : symset)
+void SygusAbduct::addSymbols(Node n,
+                             std::unordered_set<Node, NodeHashFunction>& symset,
+                             std::vector<Node>& syms,
+                             std::vector<Node>& vars,
+                             std::vector<Node>& varlist)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  std::unordered_set<Node, NodeHashFunction> nsyms;
+  expr::getSymbols(n, nsyms);
+  for (const Node& s : nsyms)
   {
+    if (!symset.insert(s).second)
+    {
+      continue;
+    }
     TypeNode tn = s.getType();
     // Notice that we allow for non-first class (e.g. function) variables here.
     // This is applicable to the case where we are doing get-abduct in a logic
@@ -68,180 +72,265 @@ Node SygusAbduct::mkAbductionConjecture(const std::string& name,
     vars.push_back(var);
     Node vlv = nm->mkBoundVar(ss.str(), tn);
     varlist.push_back(vlv);
-    varlistTypes.push_back(tn);
     // set that this variable encodes the term s
     SygusVarToTermAttribute sta;
     vlv.setAttribute(sta, s);
   }
-  // make the sygus variable list
-  Node abvl = nm->mkNode(BOUND_VAR_LIST, varlist);
-  Trace("sygus-abduct-debug") << "...finish" << std::endl;
-
-  Trace("sygus-abduct-debug") << "Make abduction predicate..." << std::endl;
-  // make the abduction predicate to synthesize
-  TypeNode abdType = varlistTypes.empty() ? nm->booleanType()
-                                          : nm->mkPredicateType(varlistTypes);
-  Node abd = nm->mkBoundVar(name.c_str(), abdType);
-  Trace("sygus-abduct-debug") << "...finish" << std::endl;
+}
 
-  // if provided, we will associate it with the function-to-synthesize
-  if (!abdGType.isNull())
-  {
-    Assert(abdGType.isDatatype() && abdGType.getDType().isSygus());
-    // must convert all constructors to version with bound variables in "vars"
-    std::vector<SygusDatatype> sdts;
-    std::set<Type> unres;
+TypeNode SygusAbduct::mkGrammar(TypeNode abdGType,
+                                const std::vector<Node>& syms,
+                                const std::vector<Node>& varlist,
+                                Node abvl)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  Assert(abdGType.isDatatype() && abdGType.getDType().isSygus());
+  // must convert all constructors to version with bound variables in "vars"
+  std::vector<SygusDatatype> sdts;
+  std::set<Type> unres;
 
-    Trace("sygus-abduct-debug") << "Process abduction type:" << std::endl;
-    Trace("sygus-abduct-debug") << abdGType.getDType().getName() << std::endl;
+  Trace("sygus-abduct-debug") << "Process abduction type:" << std::endl;
+  Trace("sygus-abduct-debug") << abdGType.getDType().getName() << std::endl;
 
-    // datatype types we need to process
-    std::vector<TypeNode> dtToProcess;
-    // datatype types we have processed
-    std::map<TypeNode, TypeNode> dtProcessed;
-    dtToProcess.push_back(abdGType);
-    std::stringstream ssutn0;
-    ssutn0 << abdGType.getDType().getName() << "_s";
-    TypeNode abdTNew =
-        nm->mkSort(ssutn0.str(), ExprManager::SORT_FLAG_PLACEHOLDER);
-    unres.insert(abdTNew.toType());
-    dtProcessed[abdGType] = abdTNew;
+  // datatype types we need to process
+  std::vector<TypeNode> dtToProcess;
+  // datatype types we have processed
+  std::map<TypeNode, TypeNode> dtProcessed;
+  dtToProcess.push_back(abdGType);
+  std::stringstream ssutn0;
+  ssutn0 << abdGType.getDType().getName() << "_s";
+  TypeNode abdTNew =
+      nm->mkSort(ssutn0.str(), ExprManager::SORT_FLAG_PLACEHOLDER);
+  unres.insert(abdTNew.toType());
+  dtProcessed[abdGType] = abdTNew;
 
-    // We must convert all symbols in the sygus datatype type abdGType to
-    // apply the substitution { syms -> varlist }, where syms is the free
-    // variables of the input problem, and varlist is the formal argument list
-    // of the abduct-to-synthesize. For example, given user-provided sygus
-    // grammar:
-    //   G -> a | +( b, G )
-    // we synthesize a abduct A with two arguments x_a and x_b corresponding to
-    // a and b, and reconstruct the grammar:
-    //   G' -> x_a | +( x_b, G' )
-    // In this way, x_a and x_b are treated as bound variables and handled as
-    // arguments of the abduct-to-synthesize instead of as free variables with
-    // no relation to A. We additionally require that x_a, when printed, prints
-    // "a", which we do with a custom sygus callback below.
+  // We must convert all symbols in the sygus datatype type abdGType to
+  // apply the substitution { syms -> varlist }, where syms is the free
+  // variables of the input problem, and varlist is the formal argument list
+  // of the abduct-to-synthesize. For example, given user-provided sygus
+  // grammar:
+  //   G -> a | +( b, G )
+  // we synthesize a abduct A with two arguments x_a and x_b corresponding to
+  // a and b, and reconstruct the grammar:
+  //   G' -> x_a | +( x_b, G' )
+  // In this way, x_a and x_b are treated as bound variables and handled as
+  // arguments of the abduct-to-synthesize instead of as free variables with
+  // no relation to A. We additionally require that x_a, when printed, prints
+  // "a", which we do with a custom sygus callback below.
 
-    // We are traversing over the subfield types of the datatype to convert
-    // them into the form described above.
-    while (!dtToProcess.empty())
+  // We are traversing over the subfield types of the datatype to convert
+  // them into the form described above.
+  while (!dtToProcess.empty())
+  {
+    std::vector<TypeNode> dtNextToProcess;
+    for (const TypeNode& curr : dtToProcess)
     {
-      std::vector<TypeNode> dtNextToProcess;
-      for (const TypeNode& curr : dtToProcess)
+      Assert(curr.isDatatype() && curr.getDType().isSygus());
+      const DType& dtc = curr.getDType();
+      std::stringstream ssdtn;
+      ssdtn << dtc.getName() << "_s";
+      sdts.push_back(SygusDatatype(ssdtn.str()));
+      Trace("sygus-abduct-debug")
+          << "Process datatype " << sdts.back().getName() << "..."
+          << std::endl;
+      for (unsigned j = 0, ncons = dtc.getNumConstructors(); j < ncons; j++)
       {
-        Assert(curr.isDatatype() && curr.getDType().isSygus());
-        const DType& dtc = curr.getDType();
-        std::stringstream ssdtn;
-        ssdtn << dtc.getName() << "_s";
-        sdts.push_back(SygusDatatype(ssdtn.str()));
-        Trace("sygus-abduct-debug")
-            << "Process datatype " << sdts.back().getName() << "..."
-            << std::endl;
-        for (unsigned j = 0, ncons = dtc.getNumConstructors(); j < ncons; j++)
+        Node op = dtc[j].getSygusOp();
+        // apply the substitution to the argument
+        Node ops = op.substitute(
+            syms.begin(), syms.end(), varlist.begin(), varlist.end());
+        Trace("sygus-abduct-debug") << "  Process constructor " << op << " / "
+                                    << ops << "..." << std::endl;
+        std::vector<TypeNode> cargs;
+        for (unsigned k = 0, nargs = dtc[j].getNumArgs(); k < nargs; k++)
         {
-          Node op = dtc[j].getSygusOp();
-          // apply the substitution to the argument
-          Node ops = op.substitute(
-              syms.begin(), syms.end(), varlist.begin(), varlist.end());
-          Trace("sygus-abduct-debug") << "  Process constructor " << op << " / "
-                                      << ops << "..." << std::endl;
-          std::vector<TypeNode> cargs;
-          for (unsigned k = 0, nargs = dtc[j].getNumArgs(); k < nargs; k++)
+          TypeNode argt = dtc[j].getArgType(k);
+          std::map<TypeNode, TypeNode>::iterator itdp =
+              dtProcessed.find(argt);
+          TypeNode argtNew;
+          if (itdp == dtProcessed.end())
           {
-            TypeNode argt = dtc[j].getArgType(k);
-            std::map<TypeNode, TypeNode>::iterator itdp =
-                dtProcessed.find(argt);
-            TypeNode argtNew;
-            if (itdp == dtProcessed.end())
-            {
-              std::stringstream ssutn;
-              ssutn << argt.getDType().getName() << "_s";
-              argtNew =
-                  nm->mkSort(ssutn.str(), ExprManager::SORT_FLAG_PLACEHOLDER);
-              Trace("sygus-abduct-debug")
-                  << "    ...unresolved type " << argtNew << " for " << argt
-                  << std::endl;
-              unres.insert(argtNew.toType());
-              dtProcessed[argt] = argtNew;
-              dtNextToProcess.push_back(argt);
-            }
-            else
-            {
-              argtNew = itdp->second;
-            }
+            std::stringstream ssutn;
+            ssutn << argt.getDType().getName() << "_s";
+            argtNew =
+                nm->mkSort(ssutn.str(), ExprManager::SORT_FLAG_PLACEHOLDER);
             Trace("sygus-abduct-debug")
-                << "    Arg #" << k << ": " << argtNew << std::endl;
-            cargs.push_back(argtNew);
+                << "    ...unresolved type " << argtNew << " for " << argt
+                << std::endl;
+            unres.insert(argtNew.toType());
+            dtProcessed[argt] = argtNew;
+            dtNextToProcess.push_back(argt);
           }
-          // callback prints as the expression
-          std::shared_ptr<SygusPrintCallback> spc;
-          std::vector<Expr> args;
-          if (op.getKind() == LAMBDA)
+          else
           {
-            Node opBody = op[1];
-            for (const Node& v : op[0])
-            {
-              args.push_back(v.toExpr());
-            }
-            spc = std::make_shared<printer::SygusExprPrintCallback>(
-                opBody.toExpr(), args);
+            argtNew = itdp->second;
           }
-          else if (cargs.empty())
+          Trace("sygus-abduct-debug")
+              << "    Arg #" << k << ": " << argtNew << std::endl;
+          cargs.push_back(argtNew);
+        }
+        // callback prints as the expression
+        std::shared_ptr<SygusPrintCallback> spc;
+        std::vector<Expr> args;
+        if (op.getKind() == LAMBDA)
+        {
+          Node opBody = op[1];
+          for (const Node& v : op[0])
           {
-            spc = std::make_shared<printer::SygusExprPrintCallback>(op.toExpr(),
-                                                                    args);
+            args.push_back(v.toExpr());
           }
-          std::stringstream ss;
-          ss << ops.getKind();
-          Trace("sygus-abduct-debug")
-              << "Add constructor : " << ops << std::endl;
-          sdts.back().addConstructor(ops, ss.str(), cargs, spc);
+          spc = std::make_shared<printer::SygusExprPrintCallback>(
+              opBody.toExpr(), args);
+        }
+        else if (cargs.empty())
+        {
+          spc = std::make_shared<printer::SygusExprPrintCallback>(op.toExpr(),
+                                                                  args);
         }
+        std::stringstream ss;
+        ss << ops.getKind();
         Trace("sygus-abduct-debug")
-            << "Set sygus : " << dtc.getSygusType() << " " << abvl << std::endl;
-        TypeNode stn = dtc.getSygusType();
-        sdts.back().initializeDatatype(
-            stn, abvl, dtc.getSygusAllowConst(), dtc.getSygusAllowAll());
+            << "Add constructor : " << ops << std::endl;
+        sdts.back().addConstructor(ops, ss.str(), cargs, spc);
       }
-      dtToProcess.clear();
-      dtToProcess.insert(
-          dtToProcess.end(), dtNextToProcess.begin(), dtNextToProcess.end());
+      Trace("sygus-abduct-debug")
+          << "Set sygus : " << dtc.getSygusType() << " " << abvl << std::endl;
+      TypeNode stn = dtc.getSygusType();
+      sdts.back().initializeDatatype(
+          stn, abvl, dtc.getSygusAllowConst(), dtc.getSygusAllowAll());
     }
-    Trace("sygus-abduct-debug")
-        << "Make " << sdts.size() << " datatype types..." << std::endl;
-    // extract the datatypes
-    std::vector<Datatype> datatypes;
-    for (unsigned i = 0, ndts = sdts.size(); i < ndts; i++)
-    {
-      datatypes.push_back(sdts[i].getDatatype());
-    }
-    // make the datatype types
-    std::vector<DatatypeType> datatypeTypes =
-        nm->toExprManager()->mkMutualDatatypeTypes(
-            datatypes, unres, ExprManager::DATATYPE_FLAG_PLACEHOLDER);
-    TypeNode abdGTypeS = TypeNode::fromType(datatypeTypes[0]);
-    if (Trace.isOn("sygus-abduct-debug"))
+    dtToProcess.clear();
+    dtToProcess.insert(
+        dtToProcess.end(), dtNextToProcess.begin(), dtNextToProcess.end());
+  }
+  Trace("sygus-abduct-debug")
+      << "Make " << sdts.size() << " datatype types..." << std::endl;
+  // extract the datatypes
+  std::vector<Datatype> datatypes;
+  for (unsigned i = 0, ndts = sdts.size(); i < ndts; i++)
+  {
+    datatypes.push_back(sdts[i].getDatatype());
+  }
+  // make the datatype types
+  std::vector<DatatypeType> datatypeTypes =
+      nm->toExprManager()->mkMutualDatatypeTypes(
+          datatypes, unres, ExprManager::DATATYPE_FLAG_PLACEHOLDER);
+  TypeNode abdGTypeS = TypeNode::fromType(datatypeTypes[0]);
+  if (Trace.isOn("sygus-abduct-debug"))
+  {
+    Trace("sygus-abduct-debug") << "Made datatype types:" << std::endl;
+    for (unsigned j = 0, ndts = datatypeTypes.size(); j < ndts; j++)
     {
-      Trace("sygus-abduct-debug") << "Made datatype types:" << std::endl;
-      for (unsigned j = 0, ndts = datatypeTypes.size(); j < ndts; j++)
+      const DType& dtj = TypeNode::fromType(datatypeTypes[j]).getDType();
+      Trace("sygus-abduct-debug") << "#" << j << ": " << dtj << std::endl;
+      for (unsigned k = 0, ncons = dtj.getNumConstructors(); k < ncons; k++)
       {
-        const DType& dtj = TypeNode::fromType(datatypeTypes[j]).getDType();
-        Trace("sygus-abduct-debug") << "#" << j << ": " << dtj << std::endl;
-        for (unsigned k = 0, ncons = dtj.getNumConstructors(); k < ncons; k++)
+        for (unsigned l = 0, nargs = dtj[k].getNumArgs(); l < nargs; l++)
         {
-          for (unsigned l = 0, nargs = dtj[k].getNumArgs(); l < nargs; l++)
+          if (!dtj[k].getArgType(l).isDatatype())
           {
-            if (!dtj[k].getArgType(l).isDatatype())
-            {
-              Trace("sygus-abduct-debug")
-                  << "Argument " << l << " of " << dtj[k]
-                  << " is not datatype : " << dtj[k].getArgType(l) << std::endl;
-              AlwaysAssert(false);
-            }
+            Trace("sygus-abduct-debug")
+                << "Argument " << l << " of " << dtj[k]
+                << " is not datatype : " << dtj[k].getArgType(l) << std::endl;
+            AlwaysAssert(false);
           }
         }
       }
     }
+  }
 
+  return abdGTypeS;
+}
+
+void SygusAbduct::initialize(const std::vector<Node>& axioms,
+                             TypeNode abdGType)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  d_axioms = axioms;
+  d_abdGType = abdGType;
+  d_symset.clear();
+  d_syms.clear();
+  d_vars.clear();
+  d_varlist.clear();
+  d_subs.clear();
+  Trace("sygus-abduct-debug") << "Setup symbols..." << std::endl;
+  for (const Node& a : axioms)
+  {
+    addSymbols(a, d_symset, d_syms, d_vars, d_varlist);
+  }
+  Trace("sygus-abduct-debug")
+      << "...finish, got " << d_symset.size() << " symbols." << std::endl;
+  // make the sygus variable list
+  d_abvl = nm->mkNode(BOUND_VAR_LIST, d_varlist);
+  // if provided, we will associate it with the function-to-synthesize
+  d_abdGTypeS = abdGType.isNull()
+                    ? TypeNode::null()
+                    : mkGrammar(abdGType, d_syms, d_varlist, d_abvl);
+  std::vector<Node> saxioms;
+  for (const Node& a : axioms)
+  {
+    Node sa = a.substitute(
+        d_syms.begin(), d_syms.end(), d_vars.begin(), d_vars.end());
+    d_subs[a] = sa;
+    saxioms.push_back(sa);
+  }
+  d_aconj = saxioms.size() == 0
+                ? nm->mkConst(true)
+                : (saxioms.size() == 1 ? saxioms[0] : nm->mkNode(AND, saxioms));
+}
+
+bool SygusAbduct::isInitializedFor(const std::vector<Node>& axioms,
+                                   TypeNode abdGType) const
+{
+  return !d_abvl.isNull() && abdGType == d_abdGType && axioms == d_axioms;
+}
+
+Node SygusAbduct::mkConjecture(const std::string& name,
+                               const std::vector<Node>& asserts)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  Assert(!d_abvl.isNull());
+  // The symbols of the assertions that are not in the axioms, typically those
+  // of the goal, extend the encoding of the axioms for this call only.
+  std::unordered_set<Node, NodeHashFunction> symset = d_symset;
+  std::vector<Node> syms = d_syms;
+  std::vector<Node> vars = d_vars;
+  std::vector<Node> varlist = d_varlist;
+  for (const Node& a : asserts)
+  {
+    if (d_subs.find(a) == d_subs.end())
+    {
+      addSymbols(a, symset, syms, vars, varlist);
+    }
+  }
+  Node abvl = d_abvl;
+  TypeNode abdGTypeS = d_abdGTypeS;
+  if (syms.size() > d_syms.size())
+  {
+    Trace("sygus-abduct-debug")
+        << "...extend with " << (syms.size() - d_syms.size())
+        << " symbols of the goal." << std::endl;
+    abvl = nm->mkNode(BOUND_VAR_LIST, varlist);
+    if (!d_abdGType.isNull())
+    {
+      abdGTypeS = mkGrammar(d_abdGType, syms, varlist, abvl);
+    }
+  }
+  std::vector<TypeNode> varlistTypes;
+  for (const Node& v : varlist)
+  {
+    varlistTypes.push_back(v.getType());
+  }
+
+  Trace("sygus-abduct-debug") << "Make abduction predicate..." << std::endl;
+  // make the abduction predicate to synthesize
+  TypeNode abdType = varlistTypes.empty() ? nm->booleanType()
+                                          : nm->mkPredicateType(varlistTypes);
+  Node abd = nm->mkBoundVar(name.c_str(), abdType);
+  Trace("sygus-abduct-debug") << "...finish" << std::endl;
+
+  if (!abdGTypeS.isNull())
+  {
     Trace("sygus-abduct-debug")
         << "Make sygus grammar attribute..." << std::endl;
     Node sym = nm->mkBoundVar("sfproxy_abduct", abdGTypeS);
@@ -265,8 +354,19 @@ Node SygusAbduct::mkAbductionConjecture(const std::string& name,
   Trace("sygus-abduct-debug") << "...finish" << std::endl;
 
   Trace("sygus-abduct-debug") << "Make conjecture body..." << std::endl;
-  Node input = asserts.size() == 1 ? asserts[0] : nm->mkNode(AND, asserts);
-  input = input.substitute(syms.begin(), syms.end(), vars.begin(), vars.end());
+  // the axioms were substituted when initializing, the new symbols cannot
+  // occur in them
+  std::vector<Node> sasserts;
+  for (const Node& a : asserts)
+  {
+    std::unordered_map<Node, Node, NodeHashFunction>::iterator its =
+        d_subs.find(a);
+    sasserts.push_back(
+        its != d_subs.end()
+            ? its->second
+            : a.substitute(syms.begin(), syms.end(), vars.begin(), vars.end()));
+  }
+  Node input = sasserts.size() == 1 ? sasserts[0] : nm->mkNode(AND, sasserts);
   // A(x) => ~input( x )
   input = nm->mkNode(OR, abdApp.negate(), input.negate());
   Trace("sygus-abduct-debug") << "...finish" << std::endl;
@@ -286,12 +386,8 @@ Node SygusAbduct::mkAbductionConjecture(const std::string& name,
   Node instAttr = nm->mkNode(INST_ATTRIBUTE, sygusVar);
   std::vector<Node> iplc;
   iplc.push_back(instAttr);
-  Node aconj = axioms.size() == 0
-                   ? nm->mkConst(true)
-                   : (axioms.size() == 1 ? axioms[0] : nm->mkNode(AND, axioms));
-  aconj = aconj.substitute(syms.begin(), syms.end(), vars.begin(), vars.end());
-  Trace("sygus-abduct") << "---> Assumptions: " << aconj << std::endl;
-  Node sc = nm->mkNode(AND, aconj, abdApp);
+  Trace("sygus-abduct") << "---> Assumptions: " << d_aconj << std::endl;
+  Node sc = nm->mkNode(AND, d_aconj, abdApp);
   Node vbvl = nm->mkNode(BOUND_VAR_LIST, vars);
   sc = nm->mkNode(EXISTS, vbvl, sc);
   Node sygusScVar = nm->mkSkolem("sygus_sc", nm->booleanType());
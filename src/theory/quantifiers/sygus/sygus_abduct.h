@@ -17,6 +17,8 @@
 #define CVC4__THEORY__QUANTIFIERS__SYGUS_ABDUCT_H
 
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include "expr/node.h"
 #include "expr/type.h"
@@ -81,6 +83,66 @@ class SygusAbduct
                                     const std::vector<Node>& asserts,
                                     const std::vector<Node>& axioms,
                                     TypeNode abdGType);
+
+  /**
+   * Set the axioms and the grammar of the abduction problems made by this
+   * utility. This computes the parts of the encoding that only depend on
+   * them: the formal argument list of the abduct-to-synthesize, the axioms
+   * over it, and the grammar abdGType converted to it. These are reused by
+   * all calls to mkConjecture below, so that repeated abduction queries
+   * against the same axioms only encode their goals.
+   */
+  void initialize(const std::vector<Node>& axioms, TypeNode abdGType);
+  /** Was this utility initialized with these axioms and grammar? */
+  bool isInitializedFor(const std::vector<Node>& axioms,
+                        TypeNode abdGType) const;
+  /**
+   * Same as mkAbductionConjecture above, for the axioms and grammar this
+   * utility was initialized with. If asserts have free symbols that are not
+   * in the axioms, the formal argument list and the grammar are extended for
+   * this call only.
+   */
+  Node mkConjecture(const std::string& name, const std::vector<Node>& asserts);
+
+ private:
+  /** The axioms and the grammar of the call to initialize */
+  std::vector<Node> d_axioms;
+  TypeNode d_abdGType;
+  /** The free symbols of the axioms */
+  std::unordered_set<Node, NodeHashFunction> d_symset;
+  /**
+   * The free symbols of the axioms, the variables they are replaced by in the
+   * body of the conjecture, and the formal arguments of the abduct that
+   * correspond to them.
+   */
+  std::vector<Node> d_syms;
+  std::vector<Node> d_vars;
+  std::vector<Node> d_varlist;
+  /** The formal argument list of the abduct */
+  Node d_abvl;
+  /** The grammar abdGType over d_abvl, null if abdGType is */
+  TypeNode d_abdGTypeS;
+  /** The conjunction of the axioms over d_vars */
+  Node d_aconj;
+  /** The assertions over d_vars, for those of the axioms */
+  std::unordered_map<Node, Node, NodeHashFunction> d_subs;
+  /**
+   * Add the symbols of n that are not in symset to syms, and corresponding
+   * fresh variables to vars and varlist.
+   */
+  static void addSymbols(Node n,
+                         std::unordered_set<Node, NodeHashFunction>& symset,
+                         std::vector<Node>& syms,
+                         std::vector<Node>& vars,
+                         std::vector<Node>& varlist);
+  /**
+   * Convert the grammar abdGType to one over formal argument list abvl, by
+   * the substitution { syms -> varlist }.
+   */
+  static TypeNode mkGrammar(TypeNode abdGType,
+                            const std::vector<Node>& syms,
+                            const std::vector<Node>& varlist,
+                            Node abvl);
 };
 
 }  // namespace quantifiers
@@ -142,6 +142,7 @@ Node SygusEnumerator::getCurrent()
 SygusEnumerator::TermCache::TermCache()
     : d_tds(nullptr),
       d_pbe(nullptr),
+      d_bank(nullptr),
       d_isSygusType(false),
       d_numConClasses(0),
       d_sizeEnum(0),
@@ -152,13 +153,15 @@ SygusEnumerator::TermCache::TermCache()
 void SygusEnumerator::TermCache::initialize(Node e,
                                             TypeNode tn,
                                             TermDbSygus* tds,
-                                            SygusPbe* pbe)
+                                            SygusPbe* pbe,
+                                            SygusTermBank* bank)
 {
   Trace("sygus-enum-debug") << "Init term cache " << tn << "..." << std::endl;
   d_enum = e;
   d_tn = tn;
   d_tds = tds;
   d_pbe = pbe;
+  d_bank = nullptr;
   d_sizeStartIndex[0] = 0;
   d_isSygusType = false;
 
@@ -176,6 +179,8 @@ void SygusEnumerator::TermCache::initialize(Node e,
   }
 
   d_isSygusType = true;
+  // only sygus types are stored in the term bank
+  d_bank = bank;
 
   // get argument types for all constructors
   std::map<unsigned, std::vector<TypeNode>> argTypes;
@@ -353,8 +358,28 @@ bool SygusEnumerator::TermCache::addTerm(Node n)
   d_terms.push_back(n);
   return true;
 }
+void SygusEnumerator::TermCache::addBankTerm(Node n)
+{
+  Assert(d_isSygusType);
+  if (options::sygusSymBreakDynamic())
+  {
+    // remember its builtin version, for the uniqueness of the terms we add
+    // with addTerm later
+    Node bn = d_tds->sygusToBuiltin(n);
+    d_bterms.insert(d_tds->getExtRewriter()->extendedRewrite(bn));
+  }
+  Trace("sygus-enum-terms") << "tc(" << d_tn << "): term (bank) " << n
+                            << std::endl;
+  d_terms.push_back(n);
+}
 void SygusEnumerator::TermCache::pushEnumSizeIndex()
 {
+  // if we are the first to finish this size, store its terms in the bank
+  if (d_bank != nullptr && d_bank->getNumSizes(d_tn) == d_sizeEnum)
+  {
+    d_bank->addTerms(
+        d_tn, d_terms.begin() + getIndexForSize(d_sizeEnum), d_terms.end());
+  }
   d_sizeEnum++;
   d_sizeStartIndex[d_sizeEnum] = d_terms.size();
   Trace("sygus-enum-debug") << "tc(" << d_tn << "): size " << d_sizeEnum
@@ -381,7 +406,20 @@ unsigned SygusEnumerator::TermCache::getNumTerms() const
 }
 
 bool SygusEnumerator::TermCache::isComplete() const { return d_isComplete; }
-void SygusEnumerator::TermCache::setComplete() { d_isComplete = true; }
+void SygusEnumerator::TermCache::setComplete()
+{
+  d_isComplete = true;
+  if (d_bank != nullptr && d_bank->getNumSizes(d_tn) == d_sizeEnum)
+  {
+    d_bank->addTerms(
+        d_tn, d_terms.begin() + getIndexForSize(d_sizeEnum), d_terms.end());
+    d_bank->setComplete(d_tn);
+  }
+}
+SygusTermBank* SygusEnumerator::TermCache::getTermBank() const
+{
+  return d_bank;
+}
 unsigned SygusEnumerator::TermEnum::getCurrentSize() { return d_currSize; }
 SygusEnumerator::TermEnum::TermEnum() : d_se(nullptr), d_currSize(0) {}
 SygusEnumerator::TermEnumSlave::TermEnumSlave()
@@ -539,7 +577,13 @@ void SygusEnumerator::initializeTermCache(TypeNode tn)
       pbe = nullptr;
     }
   }
-  d_tcache[tn].initialize(d_enum, tn, d_tds, pbe);
+  // the terms only depend on tn if we do not use the examples
+  SygusTermBank* bank = nullptr;
+  if (options::sygusEnumBank() && pbe == nullptr)
+  {
+    bank = d_tds->getTermBank();
+  }
+  d_tcache[tn].initialize(d_enum, tn, d_tds, pbe, bank);
 }
 
 SygusEnumerator::TermEnum* SygusEnumerator::getMasterEnumForType(TypeNode tn)
@@ -589,6 +633,8 @@ SygusEnumerator::TermEnum* SygusEnumerator::getMasterEnumForType(TypeNode tn)
 SygusEnumerator::TermEnumMaster::TermEnumMaster()
     : TermEnum(),
       d_isIncrementing(false),
+      d_isReplaying(false),
+      d_replayIndex(0),
       d_currTermSet(false),
       d_consClassNum(0),
       d_ccWeight(0),
@@ -611,6 +657,9 @@ bool SygusEnumerator::TermEnumMaster::initialize(SygusEnumerator* se,
   d_currChildSize = 0;
   d_ccCons.clear();
   d_isIncrementing = false;
+  // start with the terms that other enumerators stored in the bank, if any
+  d_isReplaying = d_se->d_tcache[tn].getTermBank() != nullptr;
+  d_replayIndex = 0;
   d_currTermSet = false;
   bool ret = increment();
   Trace("sygus-enum-debug") << "master(" << tn
@@ -680,6 +729,10 @@ bool SygusEnumerator::TermEnumMaster::incrementInternal()
   {
     return false;
   }
+  if (d_isReplaying)
+  {
+    return incrementReplay();
+  }
   Trace("sygus-enum-debug2") << "master(" << d_tn
                              << "): get last constructor class..." << std::endl;
   // the maximum index of a constructor class to consider
@@ -894,6 +947,58 @@ bool SygusEnumerator::TermEnumMaster::incrementInternal()
   return incrementInternal();
 }
 
+bool SygusEnumerator::TermEnumMaster::incrementReplay()
+{
+  SygusEnumerator::TermCache& tc = d_se->d_tcache[d_tn];
+  SygusTermBank* bank = tc.getTermBank();
+  Assert(bank != nullptr);
+  size_t nsizes = bank->getNumSizes(d_tn);
+  if (d_currSize >= nsizes)
+  {
+    // we are now at the state we would have been in after finishing the
+    // stored sizes ourselves, and continue by constructing terms
+    Trace("sygus-enum-debug2") << "master(" << d_tn
+                               << "): finish replay at size " << d_currSize
+                               << "\n";
+    d_isReplaying = false;
+    return incrementInternal();
+  }
+  const std::vector<Node>& terms = bank->getTerms(d_tn, d_currSize);
+  if (d_replayIndex < terms.size())
+  {
+    d_currTerm = terms[d_replayIndex];
+    d_currTermSet = true;
+    d_replayIndex++;
+    tc.addBankTerm(d_currTerm);
+    return true;
+  }
+  if (d_currSize + 1 == nsizes && bank->isComplete(d_tn))
+  {
+    Trace("cegqi-engine") << "master(" << d_tn << "): complete at size "
+                          << d_currSize << " (term bank)" << std::endl;
+    tc.setComplete();
+    return false;
+  }
+  // increment the size bound, as in incrementInternal
+  d_currSize++;
+  d_replayIndex = 0;
+  Trace("sygus-enum-debug2") << "master(" << d_tn
+                             << "): replay size++ : " << d_currSize << "\n";
+  if (Trace.isOn("cegqi-engine"))
+  {
+    if (d_se->d_tlEnum == this)
+    {
+      Trace("cegqi-engine") << "SygusEnumerator::size = " << d_currSize
+                            << " (term bank)" << std::endl;
+    }
+  }
+  tc.pushEnumSizeIndex();
+  d_consClassNum = 1;
+  d_currTermSet = true;
+  d_currTerm = Node::null();
+  return true;
+}
+
 bool SygusEnumerator::TermEnumMaster::initializeChildren()
 {
   Trace("sygus-enum-debug2")
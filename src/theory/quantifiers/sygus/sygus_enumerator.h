@@ -100,7 +100,8 @@ class SygusEnumerator : public EnumValGenerator
     void initialize(Node e,
                     TypeNode tn,
                     TermDbSygus* tds,
-                    SygusPbe* pbe = nullptr);
+                    SygusPbe* pbe = nullptr,
+                    SygusTermBank* bank = nullptr);
     /** get last constructor class index for weight
      *
      * This returns a minimal index n such that all constructor classes at
@@ -122,6 +123,12 @@ class SygusEnumerator : public EnumValGenerator
      * on the redundancy criteria used by this class.
      */
     bool addTerm(Node n);
+    /**
+     * Add sygus term n, taken from the term bank, to this cache. The term is
+     * known to be unique, since the terms of the bank were added by addTerm to
+     * a cache for the same type.
+     */
+    void addBankTerm(Node n);
     /**
      * Indicate to this cache that we are finished enumerating terms of the
      * current size.
@@ -139,6 +146,11 @@ class SygusEnumerator : public EnumValGenerator
     bool isComplete() const;
     /** set that we are finished enumerating terms */
     void setComplete();
+    /**
+     * Get the term bank this cache shares its terms with, or nullptr if the
+     * terms of this cache are specific to the enumerator.
+     */
+    SygusTermBank* getTermBank() const;
 
    private:
     /** the enumerator this cache is for */
@@ -149,6 +161,8 @@ class SygusEnumerator : public EnumValGenerator
     TermDbSygus* d_tds;
     /** pointer to the PBE utility (used for symmetry breaking) */
     SygusPbe* d_pbe;
+    /** pointer to the term bank (see getTermBank) */
+    SygusTermBank* d_bank;
     //-------------------------static information about type
     /** is d_tn a sygus type? */
     bool d_isSygusType;
@@ -326,6 +340,13 @@ class SygusEnumerator : public EnumValGenerator
    private:
     /** are we currently inside a increment() call? */
     bool d_isIncrementing;
+    /**
+     * Are we replaying the terms of the term bank? This is the case until we
+     * reach the first size that is not stored in the bank.
+     */
+    bool d_isReplaying;
+    /** the index of the next term of the current size to replay */
+    size_t d_replayIndex;
     /** cache for getCurrent() */
     Node d_currTerm;
     /** is d_currTerm set */
@@ -376,6 +397,11 @@ class SygusEnumerator : public EnumValGenerator
     bool initializeChild(unsigned i, unsigned sizeMin);
     /** increment internal, helper for increment() */
     bool incrementInternal();
+    /**
+     * Replay the next term of the bank, helper for incrementInternal(). Sets
+     * d_isReplaying to false if the current size is not stored in the bank.
+     */
+    bool incrementReplay();
   };
   /** an interpreted value enumerator
    *
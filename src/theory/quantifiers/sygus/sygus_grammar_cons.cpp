@@ -80,9 +80,9 @@ void CegGrammarConstructor::collectTerms(
         if( tn.isReal() ){
           c = NodeManager::currentNM()->mkConst( c.getConst<Rational>().abs() );
         }
-        if( std::find( consts[tn].begin(), consts[tn].end(), c )==consts[tn].end() ){
+        if (consts[tn].insert(c).second)
+        {
           Trace("cegqi-debug") << "...consider const : " << c << std::endl;
-          consts[tn].insert(c);
         }
       }
       // recurse
@@ -516,14 +516,35 @@ void CegGrammarConstructor::mkSygusDefaultGrammar(
   std::map<TypeNode, TypeNode> sygus_to_builtin;
 
   std::vector<TypeNode> types;
+  // The variables by the type whose grammar they appear in: their own type,
+  // and the range type if they are functions. This avoids a pass over all
+  // variables for each type, which matters with large contexts.
+  std::map<TypeNode, std::vector<Node>> type_to_vars;
   // Collect connected types for each of the variables.
-  for (unsigned i = 0, size = sygus_vars.size(); i < size; ++i)
+  for (const Node& sv : sygus_vars)
   {
-    TypeNode tni = sygus_vars[i].getType();
-    collectSygusGrammarTypesFor(tni, types);
+    TypeNode svt = sv.getType();
+    std::map<TypeNode, std::vector<Node>>::iterator itv =
+        type_to_vars.find(svt);
+    if (itv == type_to_vars.end())
+    {
+      collectSygusGrammarTypesFor(svt, types);
+      itv = type_to_vars.insert(std::make_pair(svt, std::vector<Node>())).first;
+    }
+    itv->second.push_back(sv);
+    if (svt.isFunction())
+    {
+      type_to_vars[svt.getRangeType()].push_back(sv);
+    }
   }
   // collect connected types to range
   collectSygusGrammarTypesFor(range, types);
+  // maps types to their index in types
+  std::map<TypeNode, unsigned> type_to_index;
+  for (unsigned i = 0, size = types.size(); i < size; ++i)
+  {
+    type_to_index[types[i]] = i;
+  }
 
   // create placeholder for boolean type (kept apart since not collected)
   std::stringstream ssb;
@@ -597,7 +618,7 @@ void CegGrammarConstructor::mkSygusDefaultGrammar(
     Trace("sygus-grammar-def")
         << "Grammar constructor mode for this type is " << tsgcm << std::endl;
     //add variables
-    for (const Node& sv : sygus_vars)
+    for (const Node& sv : type_to_vars[types[i]])
     {
       TypeNode svt = sv.getType();
       if (svt == types[i])
@@ -617,10 +638,8 @@ void CegGrammarConstructor::mkSygusDefaultGrammar(
         std::vector<TypeNode> stypes;
         for (unsigned k = 0, ntypes = argTypes.size(); k < ntypes; k++)
         {
-          unsigned index =
-              std::distance(types.begin(),
-                            std::find(types.begin(), types.end(), argTypes[k]));
-          stypes.push_back(unres_types[index]);
+          Assert(type_to_index.find(argTypes[k]) != type_to_index.end());
+          stypes.push_back(unres_types[type_to_index[argTypes[k]]]);
         }
         std::stringstream ss;
         ss << "apply_" << sv;
@@ -646,12 +665,14 @@ void CegGrammarConstructor::mkSygusDefaultGrammar(
           itec = extra_cons.find(types[i]);
       if (itec != extra_cons.end())
       {
+        std::unordered_set<Node, NodeHashFunction> cset(consts.begin(),
+                                                        consts.end());
         for (std::unordered_set<Node, NodeHashFunction>::iterator set_it =
                  itec->second.begin();
              set_it != itec->second.end();
              ++set_it)
         {
-          if (std::find(consts.begin(), consts.end(), *set_it) == consts.end())
+          if (cset.insert(*set_it).second)
           {
             consts.push_back(*set_it);
           }
@@ -768,12 +789,8 @@ void CegGrammarConstructor::mkSygusDefaultGrammar(
       sdts[i].addConstructor(STRING_CONCAT, cargsBinary);
       // length
       TypeNode intType = nm->integerType();
-      Assert(std::find(types.begin(), types.end(), intType) != types.end());
-      unsigned i_intType = std::distance(
-          types.begin(),
-          std::find(types.begin(),
-                    types.end(),
-                    intType));
+      Assert(type_to_index.find(intType) != type_to_index.end());
+      unsigned i_intType = type_to_index[intType];
       std::vector<TypeNode> cargsLen;
       cargsLen.push_back(unres_t);
       sdts[i_intType].addConstructor(STRING_LENGTH, cargsLen);
@@ -785,19 +802,14 @@ void CegGrammarConstructor::mkSygusDefaultGrammar(
       Trace("sygus-grammar-def") << "......finding unres type for index type "
                                  << types[i].getArrayIndexType() << "\n";
       // retrieve index and constituent unresolved types
-      Assert(std::find(types.begin(), types.end(), types[i].getArrayIndexType())
-             != types.end());
-      unsigned i_indexType = std::distance(
-          types.begin(),
-          std::find(types.begin(), types.end(), types[i].getArrayIndexType()));
+      Assert(type_to_index.find(types[i].getArrayIndexType())
+             != type_to_index.end());
+      unsigned i_indexType = type_to_index[types[i].getArrayIndexType()];
       TypeNode unres_indexType = unres_types[i_indexType];
-      Assert(std::find(
-                 types.begin(), types.end(), types[i].getArrayConstituentType())
-             != types.end());
-      unsigned i_constituentType = std::distance(
-          types.begin(),
-          std::find(
-              types.begin(), types.end(), types[i].getArrayConstituentType()));
+      Assert(type_to_index.find(types[i].getArrayConstituentType())
+             != type_to_index.end());
+      unsigned i_constituentType =
+          type_to_index[types[i].getArrayConstituentType()];
       TypeNode unres_constituentType = unres_types[i_constituentType];
       // add (store ArrayType IndexType ConstituentType)
       Trace("sygus-grammar-def") << "...add for STORE\n";
@@ -840,9 +852,8 @@ void CegGrammarConstructor::mkSygusDefaultGrammar(
           cargsCons.push_back(type_to_unres[crange]);
           // add to the selector type the selector operator
 
-          Assert(std::find(types.begin(), types.end(), crange) != types.end());
-          unsigned i_selType = std::distance(
-              types.begin(), std::find(types.begin(), types.end(), crange));
+          Assert(type_to_index.find(crange) != type_to_index.end());
+          unsigned i_selType = type_to_index[crange];
           TypeNode arg_type = dt[k][j].getType();
           arg_type = arg_type.getSelectorDomainType();
           Assert(type_to_unres.find(arg_type) != type_to_unres.end());
@@ -296,7 +296,10 @@ void SygusGrammarNorm::TransfChain::buildType(SygusGrammarNorm* sygus_norm,
   unsigned nb_op_pos = op_pos.size();
   /* TODO do this properly */
   /* Remove from op_pos the positions claimed by the transformation */
-  std::sort(op_pos.begin(), op_pos.end());
+  if (!std::is_sorted(op_pos.begin(), op_pos.end()))
+  {
+    std::sort(op_pos.begin(), op_pos.end());
+  }
   std::sort(claimed.begin(), claimed.end());
   std::vector<unsigned> difference;
   std::set_difference(op_pos.begin(),
@@ -510,8 +513,12 @@ TypeNode SygusGrammarNorm::normalizeSygusRec(TypeNode tn,
     Trace("sygus-grammar-normalize-trie") << "\n";
   }
   /* Checks if unresolved type already created (and returns) or creates it
-   * (and then proceeds to definition) */
-  std::sort(op_pos.begin(), op_pos.end());
+   * (and then proceeds to definition). The positions are usually already
+   * sorted, e.g. when recursing on the elements of a chain. */
+  if (!std::is_sorted(op_pos.begin(), op_pos.end()))
+  {
+    std::sort(op_pos.begin(), op_pos.end());
+  }
   if (d_tries[tn].getOrMakeType(tn, unres_tn, op_pos))
   {
     if (Trace.isOn("sygus-grammar-normalize-trie"))
@@ -19,6 +19,7 @@
 #include "theory/quantifiers/sygus/synth_conjecture.h"
 #include "theory/quantifiers/sygus/term_database_sygus.h"
 #include "theory/quantifiers/term_util.h"
+#include "util/hash.h"
 #include "util/random.h"
 
 using namespace CVC4;
@@ -296,19 +297,22 @@ bool SygusPbe::initialize(Node conj,
   return true;
 }
 
-Node SygusPbe::PbeTrie::addTerm(Node b, const std::vector<Node>& exOut)
+size_t SygusPbe::PbeIndex::ExOutHashFunction::operator()(
+    const std::vector<Node>& exOut) const
 {
-  PbeTrie* curr = this;
+  uint64_t hash = fnv1a::fnv1a_64(exOut.size());
   for (const Node& eo : exOut)
   {
-    curr = &(curr->d_children[eo]);
+    hash = fnv1a::fnv1a_64(NodeHashFunction()(eo), hash);
   }
-  if (!curr->d_children.empty())
-  {
-    return curr->d_children.begin()->first;
-  }
-  curr->d_children.insert(std::pair<Node, PbeTrie>(b, PbeTrie()));
-  return b;
+  return static_cast<size_t>(hash);
+}
+
+Node SygusPbe::PbeIndex::addTerm(Node b, const std::vector<Node>& exOut)
+{
+  // does nothing if exOut is already in the index
+  return d_terms.insert(std::pair<std::vector<Node>, Node>(exOut, b))
+      .first->second;
 }
 
 bool SygusPbe::hasExamples(Node e)
@@ -386,8 +390,8 @@ Node SygusPbe::addSearchVal(TypeNode tn, Node e, Node bvr)
     d_sygus_unif[ee].computeExamples(e, bvr, vals);
     Assert(vals.size() == d_examples[ee].size());
     Trace("sygus-pbe-debug") << "...got " << vals << std::endl;
-    Trace("sygus-pbe-debug") << "Add to trie..." << std::endl;
-    Node ret = d_pbe_trie[e][tn].addTerm(bvr, vals);
+    Trace("sygus-pbe-debug") << "Add to index..." << std::endl;
+    Node ret = d_pbe_index[e][tn].addTerm(bvr, vals);
     Trace("sygus-pbe-debug") << "...got " << ret << std::endl;
     if (ret != bvr)
     {
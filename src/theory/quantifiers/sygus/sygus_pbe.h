@@ -17,6 +17,8 @@
 #ifndef CVC4__THEORY__QUANTIFIERS__SYGUS_PBE_H
 #define CVC4__THEORY__QUANTIFIERS__SYGUS_PBE_H
 
+#include <unordered_map>
+
 #include "context/cdhashmap.h"
 #include "theory/quantifiers/sygus/sygus_module.h"
 #include "theory/quantifiers/sygus/sygus_unif_io.h"
@@ -264,29 +266,39 @@ class SygusPbe : public SygusModule
    *   term x is indexed by 0,1
    *   term x+y is indexed by 1,4
    *   term 0 is indexed by 0,0.
+   *
+   * Since candidates are always added with their evaluation on all examples,
+   * the index is a hash table on the vector of evaluations, where vectors
+   * with the same hash are compared in full. This is much smaller than a trie
+   * with a level per example when there are many examples.
    */
-  class PbeTrie
+  class PbeIndex
   {
    public:
-    PbeTrie() {}
-    ~PbeTrie() {}
-    /** the children for this node in the trie */
-    std::map<Node, PbeTrie> d_children;
-    /** clear this trie */
-    void clear() { d_children.clear(); }
+    /** clear this index */
+    void clear() { d_terms.clear(); }
     /**
-     * Add term b whose value on examples is exOut to the trie. Return
-     * the first term registered to this trie whose evaluation was exOut.
+     * Add term b whose value on examples is exOut to the index. Return
+     * the first term registered to this index whose evaluation was exOut.
      */
     Node addTerm(Node b, const std::vector<Node>& exOut);
+
+   private:
+    /** hash function for vectors of evaluations */
+    struct ExOutHashFunction
+    {
+      size_t operator()(const std::vector<Node>& exOut) const;
+    };
+    /** map from vectors of evaluations to the first term added for them */
+    std::unordered_map<std::vector<Node>, Node, ExOutHashFunction> d_terms;
   };
-  /** trie of candidate solutions tried
+  /** index of candidate solutions tried
   * This stores information for each (enumerator, type),
   * where type is a type in the grammar of the space of solutions for a subterm
   * of e. This is used for symmetry breaking in quantifier-free reasoning
   * about SyGuS datatypes.
   */
-  std::map<Node, std::map<TypeNode, PbeTrie> > d_pbe_trie;
+  std::map<Node, std::map<TypeNode, PbeIndex> > d_pbe_index;
   //--------------------------------- end PBE search values
 };
 
@@ -0,0 +1,57 @@
+/*********************                                                        */
+/*! \file sygus_term_bank.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the bank of the terms enumerated for sygus types
+ **/
+
+#include "theory/quantifiers/sygus/sygus_term_bank.h"
+
+#include "base/check.h"
+
+namespace CVC4 {
+namespace theory {
+namespace quantifiers {
+
+size_t SygusTermBank::getNumSizes(TypeNode tn) const
+{
+  std::unordered_map<TypeNode, TypeTerms, TypeNodeHashFunction>::const_iterator
+      it = d_types.find(tn);
+  return it == d_types.end() ? 0 : it->second.d_terms.size();
+}
+
+const std::vector<Node>& SygusTermBank::getTerms(TypeNode tn, size_t s) const
+{
+  std::unordered_map<TypeNode, TypeTerms, TypeNodeHashFunction>::const_iterator
+      it = d_types.find(tn);
+  Assert(it != d_types.end());
+  Assert(s < it->second.d_terms.size());
+  return it->second.d_terms[s];
+}
+
+void SygusTermBank::addTerms(TypeNode tn,
+                             std::vector<Node>::const_iterator begin,
+                             std::vector<Node>::const_iterator end)
+{
+  TypeTerms& tt = d_types[tn];
+  Assert(!tt.d_complete);
+  tt.d_terms.emplace_back(begin, end);
+}
+
+bool SygusTermBank::isComplete(TypeNode tn) const
+{
+  std::unordered_map<TypeNode, TypeTerms, TypeNodeHashFunction>::const_iterator
+      it = d_types.find(tn);
+  return it != d_types.end() && it->second.d_complete;
+}
+
+void SygusTermBank::setComplete(TypeNode tn) { d_types[tn].d_complete = true; }
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace CVC4
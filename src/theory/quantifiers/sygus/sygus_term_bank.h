@@ -0,0 +1,81 @@
+/*********************                                                        */
+/*! \file sygus_term_bank.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A bank of the terms enumerated for sygus types
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__QUANTIFIERS__SYGUS__SYGUS_TERM_BANK_H
+#define CVC4__THEORY__QUANTIFIERS__SYGUS__SYGUS_TERM_BANK_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/type_node.h"
+
+namespace CVC4 {
+namespace theory {
+namespace quantifiers {
+
+/** SygusTermBank
+ *
+ * This class stores, for sygus datatype types, the terms enumerated by the
+ * fast enumerator (SygusEnumerator) for each size that it completed, in the
+ * order they were enumerated. When the redundancy criteria of the enumerator
+ * only depend on the type (that is, when no symmetry breaking based on
+ * examples is used), this sequence is the same for all enumerators of the
+ * type. Thus, a new enumerator may start by replaying the terms of this bank,
+ * instead of constructing them and checking their redundancy again.
+ *
+ * The bank is owned by the sygus term database, and hence persists across the
+ * conjectures of a solver.
+ */
+class SygusTermBank
+{
+ public:
+  /** The number of sizes of terms of type tn that are stored */
+  size_t getNumSizes(TypeNode tn) const;
+  /** Get the terms of type tn and size s, where s < getNumSizes(tn) */
+  const std::vector<Node>& getTerms(TypeNode tn, size_t s) const;
+  /**
+   * Add the terms of type tn of size getNumSizes(tn), that is, of the next
+   * size to store.
+   */
+  void addTerms(TypeNode tn,
+                std::vector<Node>::const_iterator begin,
+                std::vector<Node>::const_iterator end);
+  /**
+   * Are all terms of type tn stored? This is the case if the enumeration of tn
+   * finished after the terms of the last stored size.
+   */
+  bool isComplete(TypeNode tn) const;
+  /** Set that all terms of type tn are stored */
+  void setComplete(TypeNode tn);
+
+ private:
+  /** The information stored for a type */
+  struct TypeTerms
+  {
+    TypeTerms() : d_complete(false) {}
+    /** The terms of each size */
+    std::vector<std::vector<Node>> d_terms;
+    /** Whether all terms of the type are stored */
+    bool d_complete;
+  };
+  /** The terms stored for each type */
+  std::unordered_map<TypeNode, TypeTerms, TypeNodeHashFunction> d_types;
+};
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__QUANTIFIERS__SYGUS__SYGUS_TERM_BANK_H */
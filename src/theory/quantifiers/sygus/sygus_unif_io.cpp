@@ -18,6 +18,7 @@
 #include "theory/evaluator.h"
 #include "theory/quantifiers/sygus/term_database_sygus.h"
 #include "theory/quantifiers/term_util.h"
+#include "theory/quantifiers_engine.h"
 #include "util/random.h"
 
 #include <math.h>
@@ -515,6 +516,8 @@ void SygusUnifIo::initializeCandidate(
 {
   d_examples.clear();
   d_examples_out.clear();
+  d_out_classes.clear();
+  d_examples_out_class.clear();
   d_ecache.clear();
   d_candidate = f;
   SygusUnif::initializeCandidate(qe, f, enums, strategy_lemmas);
@@ -526,6 +529,17 @@ void SygusUnifIo::addExample(const std::vector<Node>& input, Node output)
 {
   d_examples.push_back(input);
   d_examples_out.push_back(output);
+  std::map<Node, unsigned>::iterator it = d_out_classes.find(output);
+  if (it == d_out_classes.end())
+  {
+    unsigned c = d_out_classes.size();
+    d_out_classes[output] = c;
+    d_examples_out_class.push_back(c);
+  }
+  else
+  {
+    d_examples_out_class.push_back(it->second);
+  }
 }
 
 void SygusUnifIo::computeExamples(Node e, Node bv, std::vector<Node>& exOut)
@@ -539,12 +553,8 @@ void SygusUnifIo::computeExamples(Node e, Node bv, std::vector<Node>& exOut)
   }
   TypeNode xtn = e.getType();
   std::vector<Node>& eocv = eoc[bv];
-  for (size_t j = 0, size = d_examples.size(); j < size; j++)
-  {
-    Node res = d_tds->evaluateBuiltin(xtn, bv, d_examples[j]);
-    exOut.push_back(res);
-    eocv.push_back(res);
-  }
+  d_tds->evaluateBuiltin(xtn, bv, d_examples, eocv);
+  exOut.insert(exOut.end(), eocv.begin(), eocv.end());
 }
 
 void SygusUnifIo::clearExampleCache(Node e, Node bv)
@@ -1576,38 +1586,34 @@ Node SygusUnifIo::constructBestConditional(Node ce,
   Trace("sygus-sui-dt-igain") << std::endl;
   // set of indices that are active in this branch, i.e. x.d_vals[i] is true
   std::vector<unsigned> activeIndices;
-  // map (j,t,s) -> n, such that the j^th condition in the vector conds
-  // evaluates to t (typically true/false) on n active I/O pairs with output s.
-  std::map<unsigned, std::map<Node, std::map<Node, unsigned>>> eval;
-  // map (j,t) -> m, such that the j^th condition in the vector conds
-  // evaluates to t (typically true/false) for m active I/O pairs.
-  std::map<unsigned, std::map<Node, unsigned>> evalCount;
-  unsigned nconds = conds.size();
-  EnumCache& ecache = d_ecache[ce];
-  // Get the index of conds[j] in the enumerator cache, this is to look up
-  // its evaluation on each point.
-  std::vector<unsigned> eindex;
-  for (unsigned j = 0; j < nconds; j++)
-  {
-    eindex.push_back(ecache.d_enum_val_to_index[conds[j]]);
-  }
-  unsigned activePoints = 0;
   for (unsigned i = 0, npoints = x.d_vals.size(); i < npoints; i++)
   {
     if (x.d_vals[i].getConst<bool>())
     {
-      activePoints++;
-      Node eo = d_examples_out[i];
-      for (unsigned j = 0; j < nconds; j++)
-      {
-        Node resn = ecache.d_enum_vals_res[eindex[j]][i];
-        Assert(resn.isConst());
-        eval[j][resn][eo]++;
-        evalCount[j][resn]++;
-      }
+      activeIndices.push_back(i);
     }
   }
+  unsigned activePoints = activeIndices.size();
   AlwaysAssert(activePoints > 0);
+  unsigned nconds = conds.size();
+  EnumCache& ecache = d_ecache[ce];
+  QuantifiersEngine::Statistics& stats = d_qe->d_statistics;
+  ++(stats.d_sygus_unif_dt_cond_choices);
+  stats.d_sygus_unif_dt_conds_scored += nconds;
+  // The order in which we sum the terms of the entropy below is the order of
+  // the condition values and outputs as nodes, which makes the comparisons of
+  // entropies independent of the order of the examples.
+  std::vector<unsigned> classOrder;
+  for (const std::pair<const Node, unsigned>& oc : d_out_classes)
+  {
+    classOrder.push_back(oc.second);
+  }
+  unsigned nclasses = classOrder.size();
+  bool falseFirst = d_false < d_true;
+  // counts[nclasses * t + s] is the number of active I/O pairs with output
+  // class s on which the current condition evaluates to t, where t is 1 for
+  // true and 0 for false.
+  std::vector<unsigned> counts(2 * nclasses);
   // find the condition that leads to the lowest entropy
   // initially set minEntropy to > 1.0.
   double minEntropy = 2.0;
@@ -1615,6 +1621,18 @@ Node SygusUnifIo::constructBestConditional(Node ce,
   int numEqual = 1;
   for (unsigned j = 0; j < nconds; j++)
   {
+    // Get the evaluation of conds[j] on each point from the enumerator cache.
+    const std::vector<Node>& res =
+        ecache.d_enum_vals_res[ecache.d_enum_val_to_index[conds[j]]];
+    std::fill(counts.begin(), counts.end(), 0);
+    unsigned trueCount = 0;
+    for (unsigned i : activeIndices)
+    {
+      Assert(res[i].isConst() && res[i].getType().isBoolean());
+      unsigned t = res[i].getConst<bool>() ? 1 : 0;
+      counts[nclasses * t + d_examples_out_class[i]]++;
+      trueCount += t;
+    }
     // To compute the entropy for a condition C, for pair of terms (s, t), let
     //   prob(t) be the probability C evaluates to t on an active point,
     //   prob(s|t) be the probability that an active point on which C
@@ -1624,23 +1642,26 @@ Node SygusUnifIo::constructBestConditional(Node ce,
     // where notice this is always between 0 and 1.
     double entropySum = 0.0;
     Trace("sygus-sui-dt-igain") << j << " : ";
-    for (std::pair<const Node, std::map<Node, unsigned>>& ej : eval[j])
+    for (unsigned k = 0; k < 2; k++)
     {
-      unsigned ecount = evalCount[j][ej.first];
+      unsigned t = (k == 0) == falseFirst ? 0 : 1;
+      unsigned ecount = t == 1 ? trueCount : activePoints - trueCount;
       if (ecount > 0)
       {
         double probBranch = double(ecount) / double(activePoints);
-        Trace("sygus-sui-dt-igain") << ej.first << " -> ( ";
-        for (std::pair<const Node, unsigned>& eej : ej.second)
+        Trace("sygus-sui-dt-igain") << (t == 1 ? d_true : d_false) << " -> ( ";
+        std::map<Node, unsigned>::const_iterator itc = d_out_classes.begin();
+        for (unsigned s : classOrder)
         {
-          if (eej.second > 0)
+          unsigned scount = counts[nclasses * t + s];
+          if (scount > 0)
           {
-            double probVal = double(eej.second) / double(ecount);
-            Trace("sygus-sui-dt-igain")
-                << eej.first << ":" << eej.second << " ";
+            double probVal = double(scount) / double(ecount);
+            Trace("sygus-sui-dt-igain") << itc->first << ":" << scount << " ";
             double factor = -probVal * log2(probVal);
             entropySum += probBranch * factor;
           }
+          ++itc;
         }
         Trace("sygus-sui-dt-igain") << ") ";
       }
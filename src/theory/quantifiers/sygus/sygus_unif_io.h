@@ -362,6 +362,14 @@ class SygusUnifIo : public SygusUnif
   std::vector<std::vector<Node>> d_examples;
   /** output of I/O examples */
   std::vector<Node> d_examples_out;
+  /**
+   * The distinct outputs of I/O examples, mapped to an identifier. The i^th
+   * example has output d_examples_out[i], whose identifier is
+   * d_examples_out_class[i]. These are used for computing the information gain
+   * of conditions in constructBestConditional without comparing nodes.
+   */
+  std::map<Node, unsigned> d_out_classes;
+  std::vector<unsigned> d_examples_out_class;
 
   /** cache for computeExamples */
   std::map<Node, std::map<Node, std::vector<Node>>> d_exOutCache;
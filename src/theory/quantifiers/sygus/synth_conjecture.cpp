@@ -569,22 +569,36 @@ bool SynthConjecture::doCheck(std::vector<Node>& lems)
     if (options::sygusVerifySubcall())
     {
       Trace("cegqi-engine") << "  *** Verify with subcall..." << std::endl;
-      SmtEngine verifySmt(nm->toExprManager());
-      verifySmt.setIsInternalSubsolver();
-      verifySmt.setLogic(smt::currentSmtEngine()->getLogicInfo());
-      verifySmt.assertFormula(query.toExpr());
-      Result r = verifySmt.checkSat();
+      Result r;
+      if (options::sygusVerifyInc())
+      {
+        r = checkVerifyIncremental(query);
+      }
+      else
+      {
+        SmtEngine verifySmt(nm->toExprManager());
+        verifySmt.setIsInternalSubsolver();
+        verifySmt.setLogic(smt::currentSmtEngine()->getLogicInfo());
+        verifySmt.assertFormula(query.toExpr());
+        r = verifySmt.checkSat();
+        if (r.asSatisfiabilityResult().isSat() == Result::SAT)
+        {
+          for (const Node& v : d_ce_sk_vars)
+          {
+            Node mv = Node::fromExpr(verifySmt.getValue(v.toExpr()));
+            d_ce_sk_var_mvs.push_back(mv);
+          }
+        }
+      }
       Trace("cegqi-engine") << "  ...got " << r << std::endl;
       if (r.asSatisfiabilityResult().isSat() == Result::SAT)
       {
         Trace("cegqi-engine") << "  * Verification lemma failed for:\n   ";
         // do not send out
-        for (unsigned i = 0, size = d_ce_sk_vars.size(); i < size; i++)
+        for (unsigned i = 0, size = d_ce_sk_var_mvs.size(); i < size; i++)
         {
-          Node v = d_ce_sk_vars[i];
-          Node mv = Node::fromExpr(verifySmt.getValue(v.toExpr()));
-          Trace("cegqi-engine") << vars[i] << " -> " << mv << " ";
-          d_ce_sk_var_mvs.push_back(mv);
+          Trace("cegqi-engine") << vars[i] << " -> " << d_ce_sk_var_mvs[i]
+                                << " ";
         }
         Trace("cegqi-engine") << std::endl;
 #ifdef CVC4_ASSERTIONS
@@ -632,6 +646,50 @@ bool SynthConjecture::doCheck(std::vector<Node>& lems)
   return true;
 }
 
+Result SynthConjecture::checkVerifyIncremental(Node query)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  if (d_verifySmt == nullptr)
+  {
+    // The subsolver is incremental, which requires it to have its own options,
+    // and hence its own expression manager.
+    d_verifyEm.reset(new ExprManager(nm->getOptions()));
+    d_verifySmt.reset(new SmtEngine(d_verifyEm.get()));
+    d_verifySmt->setIsInternalSubsolver();
+    d_verifySmt->setLogic(smt::currentSmtEngine()->getLogicInfo());
+    d_verifySmt->setOption("incremental", true);
+  }
+  Expr equery;
+  try
+  {
+    equery = query.toExpr().exportTo(d_verifyEm.get(), d_verifyVarMap);
+  }
+  catch (const CVC4::ExportUnsupportedException& e)
+  {
+    std::stringstream msg;
+    msg << "Unable to export " << query
+        << " but exporting expressions is required for --sygus-verify-inc.";
+    throw OptionException(msg.str());
+  }
+  // the candidate is only asserted in this scope, so that the subsolver can
+  // be used for the next candidates
+  d_verifySmt->push();
+  d_verifySmt->assertFormula(equery);
+  Result r = d_verifySmt->checkSat();
+  if (r.asSatisfiabilityResult().isSat() == Result::SAT)
+  {
+    for (const Node& v : d_ce_sk_vars)
+    {
+      Expr ev = v.toExpr().exportTo(d_verifyEm.get(), d_verifyVarMap);
+      Expr emv = d_verifySmt->getValue(ev).exportTo(nm->toExprManager(),
+                                                    d_verifyVarMap);
+      d_ce_sk_var_mvs.push_back(Node::fromExpr(emv));
+    }
+  }
+  d_verifySmt->pop();
+  return r;
+}
+
 bool SynthConjecture::checkSideCondition(const std::vector<Node>& cvals) const
 {
   if (!d_embedSideCondition.isNull())
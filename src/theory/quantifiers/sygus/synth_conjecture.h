@@ -20,6 +20,9 @@
 
 #include <memory>
 
+#include "expr/expr_manager.h"
+#include "expr/variable_type_map.h"
+#include "smt/smt_engine.h"
 #include "theory/decision_manager.h"
 #include "theory/quantifiers/expr_miner_manager.h"
 #include "theory/quantifiers/sygus/ce_guided_single_inv.h"
@@ -196,6 +199,28 @@ class SynthConjecture
   /** connective core utility */
   std::unique_ptr<CegisCoreConnective> d_sygus_ccore;
 
+  //------------------------incremental verification
+  /**
+   * The expression manager of the subsolver below. The subsolver has its own
+   * expression manager so that it can be incremental regardless of the
+   * options of the main solver.
+   */
+  std::unique_ptr<ExprManager> d_verifyEm;
+  /** map for exporting expressions to d_verifyEm and back */
+  ExprManagerMapCollection d_verifyVarMap;
+  /**
+   * The subsolver for the verification lemmas of this conjecture when
+   * sygusVerifyInc is enabled. It is constructed on the first check only.
+   */
+  std::unique_ptr<SmtEngine> d_verifySmt;
+  /**
+   * Check the satisfiability of query with the subsolver above, in a new
+   * scope of the subsolver. If the result is sat, this adds the values of
+   * d_ce_sk_vars in the model of query to d_ce_sk_var_mvs.
+   */
+  Result checkVerifyIncremental(Node query);
+  //------------------------end incremental verification
+
   //------------------------modules
   /** program by examples module */
   std::unique_ptr<SygusPbe> d_ceg_pbe;
@@ -52,7 +52,8 @@ TermDbSygus::TermDbSygus(context::Context* c, QuantifiersEngine* qe)
       d_ext_rw(new ExtendedRewriter(true)),
       d_eval(new Evaluator),
       d_funDefEval(new FunDefEvaluator),
-      d_eval_unfold(new SygusEvalUnfold(this))
+      d_eval_unfold(new SygusEvalUnfold(this)),
+      d_termBank(new SygusTermBank)
 {
   d_true = NodeManager::currentNM()->mkConst( true );
   d_false = NodeManager::currentNM()->mkConst( false );
@@ -992,6 +993,43 @@ Node TermDbSygus::evaluateBuiltin(TypeNode tn,
   return rewriteNode(res);
 }
 
+void TermDbSygus::evaluateBuiltin(TypeNode tn,
+                                  Node bn,
+                                  const std::vector<std::vector<Node>>& pts,
+                                  std::vector<Node>& res,
+                                  bool tryEval)
+{
+  if (pts.empty())
+  {
+    return;
+  }
+  if (pts[0].empty())
+  {
+    res.insert(res.end(), pts.size(), Rewriter::rewrite(bn));
+    return;
+  }
+  Assert(isRegistered(tn));
+  SygusTypeInfo& ti = getTypeInfo(tn);
+  const std::vector<Node>& varlist = ti.getVarList();
+
+  std::vector<Node> evals;
+  if (tryEval && options::sygusEvalOpt())
+  {
+    d_eval->eval(bn, varlist, pts, evals);
+  }
+  for (size_t i = 0, npts = pts.size(); i < npts; i++)
+  {
+    Assert(varlist.size() == pts[i].size());
+    Node r = i < evals.size() ? evals[i] : Node::null();
+    if (r.isNull())
+    {
+      r = bn.substitute(
+          varlist.begin(), varlist.end(), pts[i].begin(), pts[i].end());
+    }
+    res.push_back(rewriteNode(r));
+  }
+}
+
 Node TermDbSygus::evaluateWithUnfolding(
     Node n, std::unordered_map<Node, Node, NodeHashFunction>& visited)
 {
@@ -25,6 +25,7 @@
 #include "theory/quantifiers/fun_def_evaluator.h"
 #include "theory/quantifiers/sygus/sygus_eval_unfold.h"
 #include "theory/quantifiers/sygus/sygus_explain.h"
+#include "theory/quantifiers/sygus/sygus_term_bank.h"
 #include "theory/quantifiers/sygus/type_info.h"
 #include "theory/quantifiers/term_database.h"
 
@@ -83,6 +84,8 @@ class TermDbSygus {
   FunDefEvaluator* getFunDefEvaluator() { return d_funDefEval.get(); }
   /** evaluation unfolding utility */
   SygusEvalUnfold* getEvalUnfold() { return d_eval_unfold.get(); }
+  /** bank of the terms enumerated for sygus types */
+  SygusTermBank* getTermBank() { return d_termBank.get(); }
   //------------------------------end utilities
 
   //------------------------------enumerators
@@ -272,6 +275,16 @@ class TermDbSygus {
                        Node bn,
                        std::vector<Node>& args,
                        bool tryEval = true);
+  /**
+   * Same as above, for each of the points in pts, where the result for pts[i]
+   * is appended to res. If tryEval is true, the points are passed to the
+   * evaluator together, so that bn is traversed only once.
+   */
+  void evaluateBuiltin(TypeNode tn,
+                       Node bn,
+                       const std::vector<std::vector<Node>>& pts,
+                       std::vector<Node>& res,
+                       bool tryEval = true);
   /** evaluate with unfolding
    *
    * n is any term that may involve sygus evaluation functions. This function
@@ -330,6 +343,8 @@ class TermDbSygus {
   std::unique_ptr<FunDefEvaluator> d_funDefEval;
   /** evaluation function unfolding utility */
   std::unique_ptr<SygusEvalUnfold> d_eval_unfold;
+  /** bank of the terms enumerated for sygus types */
+  std::unique_ptr<SygusTermBank> d_termBank;
   //------------------------------end utilities
 
   //------------------------------enumerators
@@ -167,6 +167,7 @@ void SygusSampler::initializeSygus(TermDbSygus* tds,
 void SygusSampler::initializeSamples(unsigned nsamples)
 {
   d_samples.clear();
+  d_evalCache.clear();
   std::vector<TypeNode> types;
   for (const Node& v : d_vars)
   {
@@ -465,6 +466,26 @@ void SygusSampler::addSamplePoint(std::vector<Node>& pt)
 Node SygusSampler::evaluate(Node n, unsigned index)
 {
   Assert(index < d_samples.size());
+  std::unordered_map<Node, std::vector<Node>, NodeHashFunction>::iterator itc =
+      d_evalCache.find(n);
+  if (itc == d_evalCache.end())
+  {
+    if (d_evalCache.size() >= d_evalCacheLimit)
+    {
+      d_evalCache.clear();
+    }
+    itc = d_evalCache.insert(std::make_pair(n, std::vector<Node>())).first;
+  }
+  std::vector<Node>& cvals = itc->second;
+  if (cvals.size() < d_samples.size())
+  {
+    // sample points may have been added since
+    cvals.resize(d_samples.size());
+  }
+  if (!cvals[index].isNull())
+  {
+    return cvals[index];
+  }
   // do beta-reductions in n first
   n = Rewriter::rewrite(n);
   // use efficient rewrite for substitution + rewrite
@@ -473,6 +494,7 @@ Node SygusSampler::evaluate(Node n, unsigned index)
   if (!ev.isNull())
   {
     Trace("sygus-sample-ev") << ev << std::endl;
+    cvals[index] = ev;
     return ev;
   }
   Trace("sygus-sample-ev") << "null" << std::endl;
@@ -482,9 +504,12 @@ Node SygusSampler::evaluate(Node n, unsigned index)
   ev = n.substitute(d_vars.begin(), d_vars.end(), pt.begin(), pt.end());
   ev = Rewriter::rewrite(ev);
   Trace("sygus-sample-ev") << ev << std::endl;
+  cvals[index] = ev;
   return ev;
 }
 
+void SygusSampler::clearEvaluationCache() { d_evalCache.clear(); }
+
 int SygusSampler::getDiffSamplePointIndex(Node a, Node b)
 {
   for (unsigned i = 0, nsamp = d_samples.size(); i < nsamp; i++)
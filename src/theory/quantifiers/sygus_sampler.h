@@ -18,6 +18,7 @@
 #define CVC4__THEORY__QUANTIFIERS__SYGUS_SAMPLER_H
 
 #include <map>
+#include <unordered_map>
 #include "theory/evaluator.h"
 #include "theory/quantifiers/lazy_trie.h"
 #include "theory/quantifiers/sygus/term_database_sygus.h"
@@ -115,6 +116,14 @@ class SygusSampler : public LazyTrieEvaluator
   void addSamplePoint(std::vector<Node>& pt);
   /** evaluate n on sample point index */
   Node evaluate(Node n, unsigned index) override;
+  /**
+   * Clear the cache of the values of terms on the sample points. The cache
+   * lets the clients of this sampler share the evaluations of a term, e.g.
+   * the miners of an ExpressionMinerManager which all evaluate the same
+   * enumerated term, and is cleared by them when they move on to the next
+   * term.
+   */
+  void clearEvaluationCache();
   /**
    * Compute the variables from the domain of d_var_index that occur in n,
    * store these in the vector fvs.
@@ -181,6 +190,14 @@ class SygusSampler : public LazyTrieEvaluator
   std::vector<std::vector<Node> > d_samples;
   /** evaluator class */
   Evaluator d_eval;
+  /**
+   * The values of terms on the sample points, indexed by sample point (null
+   * if not computed yet). This is cleared when it has more than
+   * d_evalCacheLimit terms.
+   */
+  std::unordered_map<Node, std::vector<Node>, NodeHashFunction> d_evalCache;
+  /** maximum number of terms in d_evalCache */
+  static const size_t d_evalCacheLimit = 1024;
   /** data structure to check duplication of sample points */
   class PtTrie
   {
@@ -14,6 +14,10 @@
 
 #include "theory/quantifiers/term_database.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 #include "options/base_options.h"
 #include "options/quantifiers_options.h"
 #include "options/theory_options.h"
@@ -246,16 +250,20 @@ void TermDb::addTerm(Node n,
   }
 }
 
-void TermDb::computeArgReps( TNode n ) {
-  if (d_arg_reps.find(n) == d_arg_reps.end())
+const std::vector<TNode>& TermDb::computeArgReps(TNode n)
+{
+  const std::vector<TNode>* cached = d_arg_reps.find(n);
+  if (cached != nullptr)
   {
-    eq::EqualityEngine * ee = d_quantEngine->getActiveEqualityEngine();
-    for (const TNode& nc : n)
-    {
-      TNode r = ee->hasTerm(nc) ? ee->getRepresentative(nc) : nc;
-      d_arg_reps[n].push_back( r );
-    }
+    return *cached;
   }
+  std::vector<TNode>& reps = d_arg_reps[n];
+  eq::EqualityEngine* ee = d_quantEngine->getActiveEqualityEngine();
+  for (const TNode& nc : n)
+  {
+    reps.push_back(ee->hasTerm(nc) ? ee->getRepresentative(nc) : nc);
+  }
+  return reps;
 }
 
 void TermDb::computeUfEqcTerms( TNode f ) {
@@ -279,9 +287,9 @@ void TermDb::computeUfEqcTerms( TNode f ) {
     {
       if (hasTermCurrent(n) && isTermActive(n))
       {
-        computeArgReps(n);
+        const std::vector<TNode>& reps = computeArgReps(n);
         TNode r = ee->hasTerm(n) ? ee->getRepresentative(n) : n;
-        d_func_map_eqc_trie[f].d_data[r].addTerm(n, d_arg_reps[n]);
+        d_func_map_eqc_trie[f].d_data[r].addTerm(n, reps);
       }
     }
   }
@@ -309,6 +317,8 @@ void TermDb::computeUfTerms( TNode f ) {
   unsigned relevantCount = 0;
   eq::EqualityEngine* ee = d_quantEngine->getActiveEqualityEngine();
   NodeManager* nm = NodeManager::currentNM();
+  // the elements of d_func_map_rel_dom[f][i], for fast membership checks
+  std::map<unsigned, std::unordered_set<TNode, TNodeHashFunction> > relDomSet;
   for (const Node& ff : ops)
   {
     std::map<Node, std::vector<Node> >::iterator it = d_op_map.find(ff);
@@ -335,24 +345,21 @@ void TermDb::computeUfTerms( TNode f ) {
         continue;
       }
 
-      computeArgReps(n);
+      const std::vector<TNode>& reps = computeArgReps(n);
       Trace("term-db-debug") << "Adding term " << n << " with arg reps : ";
-      for (unsigned i = 0, size = d_arg_reps[n].size(); i < size; i++)
+      for (unsigned i = 0, size = reps.size(); i < size; i++)
       {
-        Trace("term-db-debug") << d_arg_reps[n][i] << " ";
-        if (std::find(d_func_map_rel_dom[f][i].begin(),
-                      d_func_map_rel_dom[f][i].end(),
-                      d_arg_reps[n][i])
-            == d_func_map_rel_dom[f][i].end())
+        Trace("term-db-debug") << reps[i] << " ";
+        if (relDomSet[i].insert(reps[i]).second)
         {
-          d_func_map_rel_dom[f][i].push_back(d_arg_reps[n][i]);
+          d_func_map_rel_dom[f][i].push_back(reps[i]);
         }
       }
       Trace("term-db-debug") << std::endl;
       Assert(ee->hasTerm(n));
       Trace("term-db-debug") << "  and value : " << ee->getRepresentative(n)
                              << std::endl;
-      Node at = d_func_map_trie[f].addOrGetTerm(n, d_arg_reps[n]);
+      Node at = d_func_map_trie[f].addOrGetTerm(n, reps);
       Assert(ee->hasTerm(at));
       Trace("term-db-debug2") << "...add term returned " << at << std::endl;
       if (at != n && ee->areEqual(at, n))
@@ -1018,6 +1025,7 @@ bool TermDb::reset( Theory::Effort effort ){
   d_arg_reps.clear();
   d_func_map_trie.clear();
   d_func_map_eqc_trie.clear();
+  d_matches.clear();
   d_func_map_rel_dom.clear();
   d_consistent_ee = true;
 
@@ -1218,6 +1226,107 @@ TNodeTrie* TermDb::getTermArgTrie(Node eqc, Node f)
   }
 }
 
+const std::vector<TNode>& TermDb::getMatches(
+    TNodeTrie* tat, const std::vector<std::pair<int, Node> >& shape)
+{
+  std::map<std::vector<std::pair<int, Node> >, std::vector<TNode> >& tm =
+      d_matches[tat];
+  std::map<std::vector<std::pair<int, Node> >, std::vector<TNode> >::iterator
+      it = tm.find(shape);
+  if (it != tm.end())
+  {
+    return it->second;
+  }
+  std::vector<TNode>& matches = tm[shape];
+  std::vector<TNode> args(shape.size());
+  computeMatches(tat, shape, 0, args, matches);
+  Trace("term-db-matches") << "Computed " << matches.size()
+                           << " matches for a shape of " << shape.size()
+                           << " arguments" << std::endl;
+  return matches;
+}
+
+void TermDb::prefetchMatches(
+    const std::vector<
+        std::pair<TNodeTrie*, std::vector<std::pair<int, Node> > > >& requests,
+    size_t numThreads)
+{
+  // Create the entries of the new matches on this thread, the workers only
+  // fill them.
+  std::vector<std::pair<size_t, std::vector<TNode>*> > todo;
+  for (size_t i = 0, nreqs = requests.size(); i < nreqs; i++)
+  {
+    std::map<std::vector<std::pair<int, Node> >, std::vector<TNode> >& tm =
+        d_matches[requests[i].first];
+    if (tm.find(requests[i].second) == tm.end())
+    {
+      todo.push_back(std::pair<size_t, std::vector<TNode>*>(
+          i, &tm[requests[i].second]));
+    }
+  }
+  Trace("term-db-matches") << "Prefetch the matches of " << todo.size()
+                           << " shapes" << std::endl;
+  std::atomic<size_t> next(0);
+  auto run = [&requests, &todo, &next]() {
+    std::vector<TNode> args;
+    for (size_t j = next++; j < todo.size(); j = next++)
+    {
+      const std::pair<TNodeTrie*, std::vector<std::pair<int, Node> > >& r =
+          requests[todo[j].first];
+      args.assign(r.second.size(), TNode::null());
+      computeMatches(r.first, r.second, 0, args, *todo[j].second);
+    }
+  };
+  numThreads = std::min(numThreads, todo.size());
+  if (numThreads <= 1)
+  {
+    run();
+    return;
+  }
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < numThreads; t++)
+  {
+    threads.emplace_back(run);
+  }
+  for (std::thread& t : threads)
+  {
+    t.join();
+  }
+}
+
+void TermDb::computeMatches(TNodeTrie* tat,
+                            const std::vector<std::pair<int, Node> >& shape,
+                            unsigned argIndex,
+                            std::vector<TNode>& args,
+                            std::vector<TNode>& matches)
+{
+  if (argIndex == shape.size())
+  {
+    Assert(!tat->d_data.empty());
+    matches.push_back(tat->getData());
+    return;
+  }
+  int j = shape[argIndex].first;
+  if (j == static_cast<int>(argIndex))
+  {
+    // a variable
+    for (std::pair<const TNode, TNodeTrie>& t : tat->d_data)
+    {
+      args[argIndex] = t.first;
+      computeMatches(&t.second, shape, argIndex + 1, args, matches);
+    }
+    return;
+  }
+  // a ground term, or a variable that is already matched
+  TNode r = j < 0 ? TNode(shape[argIndex].second) : args[j];
+  std::map<TNode, TNodeTrie>::iterator it = tat->d_data.find(r);
+  if (it != tat->d_data.end())
+  {
+    args[argIndex] = r;
+    computeMatches(&it->second, shape, argIndex + 1, args, matches);
+  }
+}
+
 TNode TermDb::getCongruentTerm( Node f, Node n ) {
   if( options::ufHo() ){
     f = getOperatorRepresentative( f );
@@ -1225,8 +1334,7 @@ TNode TermDb::getCongruentTerm( Node f, Node n ) {
   computeUfTerms( f );
   std::map<Node, TNodeTrie>::iterator itut = d_func_map_trie.find(f);
   if( itut!=d_func_map_trie.end() ){
-    computeArgReps( n );
-    return itut->second.existsTerm( d_arg_reps[n] );
+    return itut->second.existsTerm(computeArgReps(n));
   }else{
     return TNode::null();
   }
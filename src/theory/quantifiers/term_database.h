@@ -18,9 +18,11 @@
 #define CVC4__THEORY__QUANTIFIERS__TERM_DATABASE_H
 
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "expr/attribute.h"
+#include "expr/node_map.h"
 #include "expr/node_trie.h"
 #include "theory/quantifiers/quant_util.h"
 #include "theory/theory.h"
@@ -156,6 +158,37 @@ class TermDb : public QuantifiersUtil {
   /** get the term arg trie for f-applications in the equivalence class of eqc.
    */
   TNodeTrie* getTermArgTrie(Node eqc, Node f);
+  /** get matches
+   *
+   * Returns the terms indexed by tat, a term arg trie of this database, whose
+   * arguments match shape. The shape has one entry per argument: (-1, r)
+   * matches the arguments whose representative is r, and (j, null) matches
+   * any argument if j is the index of this argument, or the same argument as
+   * at index j otherwise. For example, the trigger f( x, a, x ) has the shape
+   * [ (0, null), (-1, rep(a)), (0, null) ].
+   *
+   * The matches are computed once per round for each trie and shape, so that
+   * the simple triggers of different quantified formulas with the same shape
+   * share a single traversal of the trie.
+   */
+  const std::vector<TNode>& getMatches(
+      TNodeTrie* tat, const std::vector<std::pair<int, Node> >& shape);
+  /** prefetch matches
+   *
+   * Computes the matches of the given term arg tries and shapes, as
+   * getMatches does, in up to numThreads worker threads. The later calls to
+   * getMatches for these tries and shapes in this round return them.
+   *
+   * The workers only traverse the tries, which must be computed beforehand
+   * (e.g. by getTermArgTrie), and create neither nodes nor node references:
+   * the tries and the matches consist of TNodes, and the nodes of the shapes
+   * are created by the caller. The results do not depend on numThreads.
+   */
+  void prefetchMatches(
+      const std::vector<
+          std::pair<TNodeTrie*, std::vector<std::pair<int, Node> > > >&
+          requests,
+      size_t numThreads);
   /** get congruent term
   * If possible, returns a term t such that:
   * (1) t is a term that is currently indexed by this database,
@@ -327,10 +360,14 @@ class TermDb : public QuantifiersUtil {
   /** count of the number of non-redundant ground terms per operator */
   std::map< Node, int > d_op_nonred_count;
   /** mapping from terms to representatives of their arguments */
-  std::map< TNode, std::vector< TNode > > d_arg_reps;
+  expr::NodeMap<std::vector<TNode>> d_arg_reps;
   /** map from operators to trie */
   std::map<Node, TNodeTrie> d_func_map_trie;
   std::map<Node, TNodeTrie> d_func_map_eqc_trie;
+  /** the matches computed by getMatches in this round, per trie and shape */
+  std::map<TNodeTrie*,
+           std::map<std::vector<std::pair<int, Node> >, std::vector<TNode> > >
+      d_matches;
   /** mapping from operators to their representative relevant domains */
   std::map< Node, std::map< unsigned, std::vector< Node > > > d_func_map_rel_dom;
   /** has map */
@@ -364,10 +401,21 @@ class TermDb : public QuantifiersUtil {
   * Ensure that an entry for f is in d_func_map_trie
   */
   void computeUfTerms( TNode f );
+  /** helper for getMatches
+   *
+   * Adds to matches the terms of tat that match shape from argument index
+   * argIndex onwards, where args are the arguments matched so far. This does
+   * not access the database, so that it can run in worker threads.
+   */
+  static void computeMatches(TNodeTrie* tat,
+                      const std::vector<std::pair<int, Node> >& shape,
+                      unsigned argIndex,
+                      std::vector<TNode>& args,
+                      std::vector<TNode>& matches);
   /** compute arg reps
-  * Ensure that an entry for n is in d_arg_reps
+  * Ensure that an entry for n is in d_arg_reps, and return it
   */
-  void computeArgReps(TNode n);
+  const std::vector<TNode>& computeArgReps(TNode n);
   //------------------------------higher-order term indexing
   /**
    * Map from non-variable function terms to the operator used to purify it in
@@ -22,6 +22,7 @@
 #include "theory/quantifiers/ematching/instantiation_engine.h"
 #include "theory/quantifiers/fmf/model_engine.h"
 #include "theory/quantifiers/quantifiers_attributes.h"
+#include "theory/quantifiers/sygus/term_database_sygus.h"
 #include "theory/quantifiers/term_database.h"
 #include "theory/quantifiers/term_util.h"
 #include "theory/quantifiers_engine.h"
@@ -83,6 +84,15 @@ void TheoryQuantifiers::presolve() {
   }
 }
 
+void TheoryQuantifiers::notifyMemoryPressure()
+{
+  QuantifiersEngine* qe = getQuantifiersEngine();
+  if (qe != nullptr && qe->getTermDatabaseSygus() != nullptr)
+  {
+    qe->getTermDatabaseSygus()->getExtRewriter()->clearCache();
+  }
+}
+
 void TheoryQuantifiers::ppNotifyAssertions(
     const std::vector<Node>& assertions) {
   Trace("quantifiers-presolve")
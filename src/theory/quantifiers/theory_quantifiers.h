@@ -43,6 +43,7 @@ class TheoryQuantifiers : public Theory {
   void finishInit() override;
   void preRegisterTerm(TNode n) override;
   void presolve() override;
+  void notifyMemoryPressure() override;
   void ppNotifyAssertions(const std::vector<Node>& assertions) override;
   void check(Effort e) override;
   bool collectModelInfo(TheoryModel* m) override;
@@ -1233,6 +1233,8 @@ QuantifiersEngine::Statistics::Statistics()
       d_instantiation_rounds_lc("QuantifiersEngine::Rounds_Instantiation_Last_Call", 0),
       d_triggers("QuantifiersEngine::Triggers", 0),
       d_simple_triggers("QuantifiersEngine::Triggers_Simple", 0),
+      d_simple_trigger_matches_skipped(
+          "QuantifiersEngine::Triggers_Simple_Matches_Skipped", 0),
       d_multi_triggers("QuantifiersEngine::Triggers_Multi", 0),
       d_multi_trigger_instantiations("QuantifiersEngine::Multi_Trigger_Instantiations", 0),
       d_red_alpha_equiv("QuantifiersEngine::Reductions_Alpha_Equivalence", 0),
@@ -1244,7 +1246,9 @@ QuantifiersEngine::Statistics::Statistics()
       d_instantiations_fmf_exh("QuantifiersEngine::Instantiations_Fmf_Exh", 0),
       d_instantiations_fmf_mbqi("QuantifiersEngine::Instantiations_Fmf_Mbqi", 0),
       d_instantiations_cbqi("QuantifiersEngine::Instantiations_Cbqi", 0),
-      d_instantiations_rr("QuantifiersEngine::Instantiations_Rewrite_Rules", 0)
+      d_instantiations_rr("QuantifiersEngine::Instantiations_Rewrite_Rules", 0),
+      d_sygus_unif_dt_cond_choices("SygusUnifIo::DtConditionChoices", 0),
+      d_sygus_unif_dt_conds_scored("SygusUnifIo::DtConditionsScored", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_time);
   smtStatisticsRegistry()->registerStat(&d_qcf_time);
@@ -1254,6 +1258,7 @@ QuantifiersEngine::Statistics::Statistics()
   smtStatisticsRegistry()->registerStat(&d_instantiation_rounds_lc);
   smtStatisticsRegistry()->registerStat(&d_triggers);
   smtStatisticsRegistry()->registerStat(&d_simple_triggers);
+  smtStatisticsRegistry()->registerStat(&d_simple_trigger_matches_skipped);
   smtStatisticsRegistry()->registerStat(&d_multi_triggers);
   smtStatisticsRegistry()->registerStat(&d_multi_trigger_instantiations);
   smtStatisticsRegistry()->registerStat(&d_red_alpha_equiv);
@@ -1266,6 +1271,8 @@ QuantifiersEngine::Statistics::Statistics()
   smtStatisticsRegistry()->registerStat(&d_instantiations_fmf_mbqi);
   smtStatisticsRegistry()->registerStat(&d_instantiations_cbqi);
   smtStatisticsRegistry()->registerStat(&d_instantiations_rr);
+  smtStatisticsRegistry()->registerStat(&d_sygus_unif_dt_cond_choices);
+  smtStatisticsRegistry()->registerStat(&d_sygus_unif_dt_conds_scored);
 }
 
 QuantifiersEngine::Statistics::~Statistics(){
@@ -1277,6 +1284,7 @@ QuantifiersEngine::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_instantiation_rounds_lc);
   smtStatisticsRegistry()->unregisterStat(&d_triggers);
   smtStatisticsRegistry()->unregisterStat(&d_simple_triggers);
+  smtStatisticsRegistry()->unregisterStat(&d_simple_trigger_matches_skipped);
   smtStatisticsRegistry()->unregisterStat(&d_multi_triggers);
   smtStatisticsRegistry()->unregisterStat(&d_multi_trigger_instantiations);
   smtStatisticsRegistry()->unregisterStat(&d_red_alpha_equiv);
@@ -1289,6 +1297,8 @@ QuantifiersEngine::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_instantiations_fmf_mbqi);
   smtStatisticsRegistry()->unregisterStat(&d_instantiations_cbqi);
   smtStatisticsRegistry()->unregisterStat(&d_instantiations_rr);
+  smtStatisticsRegistry()->unregisterStat(&d_sygus_unif_dt_cond_choices);
+  smtStatisticsRegistry()->unregisterStat(&d_sygus_unif_dt_conds_scored);
 }
 
 eq::EqualityEngine* QuantifiersEngine::getMasterEqualityEngine() const
@@ -284,6 +284,7 @@ public:
     IntStat d_instantiation_rounds_lc;
     IntStat d_triggers;
     IntStat d_simple_triggers;
+    IntStat d_simple_trigger_matches_skipped;
     IntStat d_multi_triggers;
     IntStat d_multi_trigger_instantiations;
     IntStat d_red_alpha_equiv;
@@ -296,6 +297,10 @@ public:
     IntStat d_instantiations_fmf_mbqi;
     IntStat d_instantiations_cbqi;
     IntStat d_instantiations_rr;
+    /** number of conditions chosen by information gain in sygus unif */
+    IntStat d_sygus_unif_dt_cond_choices;
+    /** number of conditions whose information gain was computed */
+    IntStat d_sygus_unif_dt_conds_scored;
     Statistics();
     ~Statistics();
   };/* class QuantifiersEngine::Statistics */
@@ -81,6 +81,44 @@ struct RewriteStackElement {
   NodeBuilder<> builder;
 };
 
+/**
+ * The stacks of the nested calls of rewriteTo(), which a call leaves empty
+ * but keeps, so that their storage is reused by the next call at the same
+ * depth. Each depth has its own stack, so that a nested call does not
+ * invalidate the references into the stack of its caller.
+ */
+class RewriteStackScope
+{
+ public:
+  RewriteStackScope()
+  {
+    if (s_depth == s_stacks.size())
+    {
+      s_stacks.emplace_back(new vector<RewriteStackElement>());
+    }
+    d_stack = s_stacks[s_depth].get();
+    ++s_depth;
+  }
+  ~RewriteStackScope()
+  {
+    // also when leaving by an exception, e.g. on a resource limit
+    d_stack->clear();
+    --s_depth;
+  }
+  /** The stack of this call */
+  vector<RewriteStackElement>& get() { return *d_stack; }
+
+ private:
+  vector<RewriteStackElement>* d_stack;
+  static thread_local vector<unique_ptr<vector<RewriteStackElement>>>
+      s_stacks;
+  static thread_local size_t s_depth;
+};
+
+thread_local vector<unique_ptr<vector<RewriteStackElement>>>
+    RewriteStackScope::s_stacks;
+thread_local size_t RewriteStackScope::s_depth = 0;
+
 Node Rewriter::rewrite(TNode node) {
   if (node.getNumChildren() == 0)
   {
@@ -92,6 +130,18 @@ Node Rewriter::rewrite(TNode node) {
   return rewriter.rewriteTo(theoryOf(node), node);
 }
 
+void Rewriter::rewriteBatch(std::vector<Node>& nodes)
+{
+  Rewriter& rewriter = getInstance();
+  for (Node& n : nodes)
+  {
+    if (n.getNumChildren() > 0)
+    {
+      n = rewriter.rewriteTo(theoryOf(n), n);
+    }
+  }
+}
+
 Rewriter& Rewriter::getInstance()
 {
   thread_local static Rewriter rewriter;
@@ -118,7 +168,8 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId, Node node) {
   }
 
   // Put the node on the stack in order to start the "recursive" rewrite
-  vector<RewriteStackElement> rewriteStack;
+  RewriteStackScope scope;
+  vector<RewriteStackElement>& rewriteStack = scope.get();
   rewriteStack.push_back(RewriteStackElement(node, theoryId));
 
   ResourceManager* rm = NULL;
@@ -131,7 +182,8 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId, Node node) {
 
     if (hasSmtEngine &&
 		d_iterationCount % ResourceManager::getFrequencyCount() == 0) {
-      rm->spendResource(options::rewriteStep());
+      rm->spendResource(ResourceManager::Resource::RewriteStep,
+                        options::rewriteStep());
       d_iterationCount = 0;
     }
 
@@ -201,12 +253,29 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId, Node node) {
         }
       }
 
+      // Append the children that were rewritten already to the builder
+      // directly, rather than pushing them to the stack only to find them in
+      // the post-rewrite cache
+      TheoryId childTheoryId = THEORY_LAST;
+      while (child < rewriteStackTop.node.getNumChildren())
+      {
+        TNode childNode = rewriteStackTop.node[child];
+        childTheoryId = theoryOf(childNode);
+        Node childCached = getPostRewriteCache(childTheoryId, childNode);
+        if (childCached.isNull())
+        {
+          break;
+        }
+        rewriteStackTop.builder << childCached;
+        child = rewriteStackTop.nextChild++;
+      }
+
       // Process the next child
       if(child < rewriteStackTop.node.getNumChildren()) {
         // The child node
         Node childNode = rewriteStackTop.node[child];
         // Push the rewrite request to the stack (NOTE: rewriteStackTop might be a bad reference now)
-        rewriteStack.push_back(RewriteStackElement(childNode, theoryOf(childNode)));
+        rewriteStack.push_back(RewriteStackElement(childNode, childTheoryId));
         // Go on with the rewriting
         continue;
       }
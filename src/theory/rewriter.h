@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "expr/node.h"
 #include "theory/theory_rewriter.h"
 #include "util/unsafe_interrupt_exception.h"
@@ -40,6 +43,12 @@ class Rewriter {
    */
   static Node rewrite(TNode node);
 
+  /**
+   * Rewrites each of the nodes in place. This is equivalent to calling
+   * rewrite() on each of them, but looks up the rewriter once.
+   */
+  static void rewriteBatch(std::vector<Node>& nodes);
+
   /**
    * Garbage collects the rewrite caches.
    */
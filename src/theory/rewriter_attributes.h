@@ -29,8 +29,12 @@ struct RewriteCacheTag {};
 template <theory::TheoryId theoryId>
 struct RewriteAttibute {
 
-  typedef expr::Attribute< RewriteCacheTag<true, theoryId>, Node> pre_rewrite;
-  typedef expr::Attribute< RewriteCacheTag<false, theoryId>, Node> post_rewrite;
+  // The caches are looked up on every visit of the rewriter, so they are
+  // dense
+  typedef expr::Attribute<RewriteCacheTag<true, theoryId>, Node, false, true>
+      pre_rewrite;
+  typedef expr::Attribute<RewriteCacheTag<false, theoryId>, Node, false, true>
+      post_rewrite;
 
   /**
    * Get the value of the pre-rewrite cache.
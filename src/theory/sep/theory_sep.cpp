@@ -226,15 +226,14 @@ void TheorySep::postProcessModel( TheoryModel* m ){
     Assert(d_loc_to_data_type.find(it->first) != d_loc_to_data_type.end());
     Trace("sep-model") << "Model for heap, type = " << it->first << " with data type " << d_loc_to_data_type[it->first] << " : " << std::endl;
     TypeNode data_type = d_loc_to_data_type[it->first];
-    computeLabelModel( it->second );
-    if( d_label_model[it->second].d_heap_locs_model.empty() ){
+    HeapInfo& heap = computeLabelModel( it->second );
+    if( heap.d_heap_locs_model.empty() ){
       Trace("sep-model") << "  [empty]" << std::endl;
     }else{
-      for( unsigned j=0; j<d_label_model[it->second].d_heap_locs_model.size(); j++ ){
-        Assert(d_label_model[it->second].d_heap_locs_model[j].getKind()
-               == kind::SINGLETON);
+      for( unsigned j=0; j<heap.d_heap_locs_model.size(); j++ ){
+        Assert(heap.d_heap_locs_model[j].getKind() == kind::SINGLETON);
         std::vector< Node > pto_children;
-        Node l = d_label_model[it->second].d_heap_locs_model[j][0];
+        Node l = heap.d_heap_locs_model[j][0];
         Assert(l.isConst());
         pto_children.push_back( l );
         Trace("sep-model") << " " << l << " -> ";
@@ -308,7 +307,8 @@ void TheorySep::check(Effort e) {
     return;
   }
 
-  getOutputChannel().spendResource(options::theoryCheckStep());
+  getOutputChannel().spendResource(ResourceManager::Resource::TheoryCheckStep,
+                                   options::theoryCheckStep());
 
   TimerStat::CodeTimer checkTimer(d_checkTime);
   Trace("sep-check") << "Sep::check(): " << e << endl;
@@ -513,14 +513,19 @@ void TheorySep::check(Effort e) {
 
   if( e == EFFORT_LAST_CALL && !d_conflict && !d_valuation.needCheck() ){
     Trace("sep-process") << "Checking heap at full effort..." << std::endl;
+    // the models of the labels are only computed for the labels the checks
+    // below refer to, over the locations of the current model
     d_label_model.clear();
+    d_loc_index.clear();
     d_tmodel.clear();
     d_pto_model.clear();
     Trace("sep-process") << "---Locations---" << std::endl;
     std::map< Node, int > min_id;
+    std::unordered_set< Node, NodeHashFunction > all_references;
     for( std::map< TypeNode, std::vector< Node > >::iterator itt = d_type_references_all.begin(); itt != d_type_references_all.end(); ++itt ){
       for( unsigned k=0; k<itt->second.size(); k++ ){
         Node t = itt->second[k];
+        all_references.insert( t );
         Trace("sep-process") << "  " << t << " = ";
         if( d_valuation.getModel()->hasTerm( t ) ){
           Node v = d_valuation.getModel()->getRepresentative( t );
@@ -545,9 +550,9 @@ void TheorySep::check(Effort e) {
     }
     Trace("sep-process") << "---" << std::endl;
     //build positive/negative assertion lists for labels
-    std::map< Node, bool > assert_active;
+    std::unordered_map< Node, bool, NodeHashFunction > assert_active;
     //get the inactive assertions
-    std::map< Node, std::vector< Node > > lbl_to_assertions;
+    std::unordered_map< Node, std::vector< Node >, NodeHashFunction > lbl_to_assertions;
     for( NodeList::const_iterator i = d_spatial_assertions.begin(); i != d_spatial_assertions.end(); ++i ) {
       Node fact = (*i);
       bool polarity = fact.getKind() != kind::NOT;
@@ -567,8 +572,7 @@ void TheorySep::check(Effort e) {
             d_pto_model[vv] = s_atom[1];
             
             //replace this on pto-model since this term is more relevant
-            TypeNode vtn = vv.getType();
-            if( std::find( d_type_references_all[vtn].begin(), d_type_references_all[vtn].end(), s_atom[0] )!=d_type_references_all[vtn].end() ){
+            if( all_references.find( s_atom[0] )!=all_references.end() ){
               d_tmodel[vv] = s_atom[0];
             }
           }
@@ -591,17 +595,6 @@ void TheorySep::check(Effort e) {
         setInactiveAssertionRec( fact, lbl_to_assertions, assert_active );
       }
     }
-    //set up model information based on active assertions
-    for( NodeList::const_iterator i = d_spatial_assertions.begin(); i != d_spatial_assertions.end(); ++i ) {
-      Node fact = (*i);
-      bool polarity = fact.getKind() != kind::NOT;
-      TNode atom = polarity ? fact : fact[0];
-      TNode s_atom = atom[0];
-      TNode s_lbl = atom[1];
-      if( assert_active[fact] ){
-        computeLabelModel( s_lbl );
-      }
-    }
     //debug print
     if( Trace.isOn("sep-process") ){
       Trace("sep-process") << "--- Current spatial assertions : " << std::endl;
@@ -685,7 +678,7 @@ void TheorySep::check(Effort e) {
               TypeNode tn = getReferenceType( s_atom );
               tn = NodeManager::currentNM()->mkSetType(tn);
               //tn = NodeManager::currentNM()->mkSetType(NodeManager::currentNM()->mkRefType(tn));
-              Node o_b_lbl_mval = d_label_model[s_lbl].getValue( tn );
+              Node o_b_lbl_mval = computeLabelModel( s_lbl ).getValue( tn );
               Trace("sep-process") << "    Model for " << s_lbl << " : " << o_b_lbl_mval << std::endl;
 
               //get model values
@@ -695,8 +688,7 @@ void TheorySep::check(Effort e) {
               {
                 int sub_index = sub_element.first;
                 Node sub_lbl = sub_element.second;
-                computeLabelModel( sub_lbl );
-                Node lbl_mval = d_label_model[sub_lbl].getValue( tn );
+                Node lbl_mval = computeLabelModel( sub_lbl ).getValue( tn );
                 Trace("sep-process-debug") << "  child " << sub_index << " : " << sub_lbl << ", mval = " << lbl_mval << std::endl;
                 mvals[sub_index] = lbl_mval;
               }
@@ -763,12 +755,11 @@ void TheorySep::check(Effort e) {
         TypeNode data_type = d_loc_to_data_type[it->first];
         //if the data type is finite
         if( data_type.isInterpretedFinite() ){
-          computeLabelModel( it->second );
+          HeapInfo& heap = computeLabelModel( it->second );
           Trace("sep-process-debug") << "Check heap data for " << it->first << " -> " << data_type << std::endl;
-          for( unsigned j=0; j<d_label_model[it->second].d_heap_locs_model.size(); j++ ){
-            Assert(d_label_model[it->second].d_heap_locs_model[j].getKind()
-                   == kind::SINGLETON);
-            Node l = d_label_model[it->second].d_heap_locs_model[j][0];
+          for( unsigned j=0; j<heap.d_heap_locs_model.size(); j++ ){
+            Assert(heap.d_heap_locs_model[j].getKind() == kind::SINGLETON);
+            Node l = heap.d_heap_locs_model[j][0];
             Trace("sep-process-debug") << "  location : " << l << std::endl;
             if( d_pto_model[l].isNull() ){
               needAddLemma = true;
@@ -1325,13 +1316,9 @@ Node TheorySep::instantiateLabel( Node n, Node o_lbl, Node lbl, Node lbl_v, std:
           if( n.getKind()==kind::SEP_WAND && sub_index==1 ){
             Assert(d_label_map[n][lbl].find(0) != d_label_map[n][lbl].end());
             Node sub_lbl_0 = d_label_map[n][lbl][0];
-            computeLabelModel( sub_lbl_0 );
-            Assert(d_label_model.find(sub_lbl_0) != d_label_model.end());
-            lbl_mval = NodeManager::currentNM()->mkNode( kind::UNION, lbl, d_label_model[sub_lbl_0].getValue( rtn ) );
+            lbl_mval = NodeManager::currentNM()->mkNode( kind::UNION, lbl, computeLabelModel( sub_lbl_0 ).getValue( rtn ) );
           }else{
-            computeLabelModel( sub_lbl );
-            Assert(d_label_model.find(sub_lbl) != d_label_model.end());
-            lbl_mval = d_label_model[sub_lbl].getValue( rtn );
+            lbl_mval = computeLabelModel( sub_lbl ).getValue( rtn );
           }
           Trace("sep-inst-debug") << "Sublabel value is " << lbl_mval  << std::endl;
           mvals[sub_index] = lbl_mval;
@@ -1351,7 +1338,7 @@ Node TheorySep::instantiateLabel( Node n, Node o_lbl, Node lbl, Node lbl_v, std:
           std::vector< Node > vs;
           for( std::map< int, Node >::iterator itl = d_label_map[n][lbl].begin(); itl != d_label_map[n][lbl].end(); ++itl ){
             Node sub_lbl = itl->second;
-            Node lbl_mval = d_label_model[sub_lbl].getValue( rtn );
+            Node lbl_mval = computeLabelModel( sub_lbl ).getValue( rtn );
             for( unsigned j=0; j<vs.size(); j++ ){
               bchildren.push_back( NodeManager::currentNM()->mkNode( kind::INTERSECTION, lbl_mval, vs[j] ).eqNode( empSet ) );
             }
@@ -1392,7 +1379,7 @@ Node TheorySep::instantiateLabel( Node n, Node o_lbl, Node lbl, Node lbl_v, std:
           std::vector< Node > wchildren;
           //disjoint constraints
           Node sub_lbl_0 = d_label_map[n][lbl][0];
-          Node lbl_mval_0 = d_label_model[sub_lbl_0].getValue( rtn );
+          Node lbl_mval_0 = computeLabelModel( sub_lbl_0 ).getValue( rtn );
           wchildren.push_back( NodeManager::currentNM()->mkNode( kind::INTERSECTION, lbl_mval_0, lbl ).eqNode( empSet ).negate() );
           
           //return the lemma
@@ -1406,10 +1393,8 @@ Node TheorySep::instantiateLabel( Node n, Node o_lbl, Node lbl, Node lbl_v, std:
       }
     }else if( n.getKind()==kind::SEP_PTO ){
       //check if this pto reference is in the base label, if not, then it does not need to be added as an assumption
-      Assert(d_label_model.find(o_lbl) != d_label_model.end());
       Node vr = d_valuation.getModel()->getRepresentative( n[0] );
-      Node svr = NodeManager::currentNM()->mkNode( kind::SINGLETON, vr );
-      bool inBaseHeap = std::find( d_label_model[o_lbl].d_heap_locs_model.begin(), d_label_model[o_lbl].d_heap_locs_model.end(), svr )!=d_label_model[o_lbl].d_heap_locs_model.end();
+      bool inBaseHeap = computeLabelModel( o_lbl ).hasLocation( getLocationIndex( vr ) );
       Trace("sep-inst-debug") << "Is in base (non-instantiating) heap : " << inBaseHeap << " for value ref " << vr << " in " << o_lbl << std::endl;
       std::vector< Node > children;
       if( inBaseHeap ){
@@ -1464,7 +1449,8 @@ Node TheorySep::instantiateLabel( Node n, Node o_lbl, Node lbl, Node lbl_v, std:
   }
 }
 
-void TheorySep::setInactiveAssertionRec( Node fact, std::map< Node, std::vector< Node > >& lbl_to_assertions, std::map< Node, bool >& assert_active ) {
+void TheorySep::setInactiveAssertionRec( Node fact, std::unordered_map< Node, std::vector< Node >, NodeHashFunction >& lbl_to_assertions,
+                                         std::unordered_map< Node, bool, NodeHashFunction >& assert_active ) {
   Trace("sep-process-debug") << "setInactiveAssertionRec::inactive : " << fact << std::endl;
   assert_active[fact] = false;
   bool polarity = fact.getKind() != kind::NOT;
@@ -1497,9 +1483,20 @@ void TheorySep::getLabelChildren( Node s_atom, Node lbl, std::vector< Node >& ch
   Assert(children.size() > 1);
 }
 
-void TheorySep::computeLabelModel( Node lbl ) {
-  if( !d_label_model[lbl].d_computed ){
-    d_label_model[lbl].d_computed = true;
+unsigned TheorySep::getLocationIndex( Node v ) {
+  std::unordered_map< Node, unsigned, NodeHashFunction >::iterator it = d_loc_index.find( v );
+  if( it!=d_loc_index.end() ){
+    return it->second;
+  }
+  unsigned i = d_loc_index.size();
+  d_loc_index[v] = i;
+  return i;
+}
+
+TheorySep::HeapInfo& TheorySep::computeLabelModel( Node lbl ) {
+  HeapInfo& heap = d_label_model[lbl];
+  if( !heap.d_computed ){
+    heap.d_computed = true;
 
     //we must get the value of lbl from the model: this is being run at last call, after the model is constructed
     //Assert(...); TODO
@@ -1508,20 +1505,25 @@ void TheorySep::computeLabelModel( Node lbl ) {
     if( v_val.getKind()!=kind::EMPTYSET ){
       while( v_val.getKind()==kind::UNION ){
         Assert(v_val[1].getKind() == kind::SINGLETON);
-        d_label_model[lbl].d_heap_locs_model.push_back( v_val[1] );
+        heap.d_heap_locs_model.push_back( v_val[1] );
         v_val = v_val[0];
       }
       if( v_val.getKind()==kind::SINGLETON ){
-        d_label_model[lbl].d_heap_locs_model.push_back( v_val );
+        heap.d_heap_locs_model.push_back( v_val );
       }else{
         throw Exception("Could not establish value of heap in model.");
         Assert(false);
       }
     }
-    for( unsigned j=0; j<d_label_model[lbl].d_heap_locs_model.size(); j++ ){
-      Node u = d_label_model[lbl].d_heap_locs_model[j];
+    for( unsigned j=0; j<heap.d_heap_locs_model.size(); j++ ){
+      Node u = heap.d_heap_locs_model[j];
       Assert(u.getKind() == kind::SINGLETON);
       u = u[0];
+      unsigned index = getLocationIndex( u );
+      if( index>=heap.d_heap_locs_index.size() ){
+        heap.d_heap_locs_index.resize( index+1, false );
+      }
+      heap.d_heap_locs_index[index] = true;
       Node tt;
       std::map< Node, Node >::iterator itm = d_tmodel.find( u );
       if( itm==d_tmodel.end() ) {
@@ -1539,9 +1541,10 @@ void TheorySep::computeLabelModel( Node lbl ) {
       }
       Node stt = NodeManager::currentNM()->mkNode( kind::SINGLETON, tt );
       Trace("sep-process-debug") << "...model : add " << tt << " for " << u << " in lbl " << lbl << std::endl;
-      d_label_model[lbl].d_heap_locs.push_back( stt );
+      heap.d_heap_locs.push_back( stt );
     }
   }
+  return heap;
 }
 
 Node TheorySep::getRepresentative( Node t ) {
@@ -1776,17 +1779,22 @@ void TheorySep::debugPrintHeap( HeapInfo& heap, const char * c ) {
 
 Node TheorySep::HeapInfo::getValue( TypeNode tn ) {
   Assert(d_heap_locs.size() == d_heap_locs_model.size());
+  if( !d_value.isNull() && d_value_type==tn ){
+    return d_value;
+  }
   if( d_heap_locs.empty() ){
-    return NodeManager::currentNM()->mkConst(EmptySet(tn.toType()));
+    d_value = NodeManager::currentNM()->mkConst(EmptySet(tn.toType()));
   }else if( d_heap_locs.size()==1 ){
-    return d_heap_locs[0];
+    d_value = d_heap_locs[0];
   }else{
     Node curr = NodeManager::currentNM()->mkNode( kind::UNION, d_heap_locs[0], d_heap_locs[1] );
     for( unsigned j=2; j<d_heap_locs.size(); j++ ){
       curr = NodeManager::currentNM()->mkNode( kind::UNION, curr, d_heap_locs[j] );
     }
-    return curr;
+    d_value = curr;
   }
+  d_value_type = tn;
+  return d_value;
 }
 
 }/* CVC4::theory::sep namespace */
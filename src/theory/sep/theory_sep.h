@@ -19,6 +19,10 @@
 #ifndef CVC4__THEORY__SEP__THEORY_SEP_H
 #define CVC4__THEORY__SEP__THEORY_SEP_H
 
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include "context/cdhashmap.h"
 #include "context/cdhashset.h"
 #include "context/cdlist.h"
@@ -291,11 +295,25 @@ class TheorySep : public Theory {
     bool d_computed;
     std::vector< Node > d_heap_locs;
     std::vector< Node > d_heap_locs_model;
+    //the set of the indices of the locations of d_heap_locs_model
+    std::vector< bool > d_heap_locs_index;
+    //is the location of the given index in the heap
+    bool hasLocation( unsigned i ) const {
+      return i<d_heap_locs_index.size() && d_heap_locs_index[i];
+    }
     //get value
     Node getValue( TypeNode tn );
+  private:
+    //the cached value, and its type
+    Node d_value;
+    TypeNode d_value_type;
   };
-  //heap info ( label -> HeapInfo )
-  std::map< Node, HeapInfo > d_label_model;
+  //heap info ( label -> HeapInfo ), computed lazily by computeLabelModel
+  std::unordered_map< Node, HeapInfo, NodeHashFunction > d_label_model;
+  //the indices of the model values of the locations of the current model
+  std::unordered_map< Node, unsigned, NodeHashFunction > d_loc_index;
+  //get the index of the model value of a location
+  unsigned getLocationIndex( Node v );
   // loc -> { data_1, ..., data_n } where (not (pto loc data_1))...(not (pto loc data_n))).
   std::map< Node, std::vector< Node > > d_heap_locs_nptos;
 
@@ -303,10 +321,11 @@ class TheorySep : public Theory {
   void validatePto( HeapAssertInfo * ei, Node ei_n );
   void addPto( HeapAssertInfo * ei, Node ei_n, Node p, bool polarity );
   void mergePto( Node p1, Node p2 );
-  void computeLabelModel( Node lbl );
+  HeapInfo& computeLabelModel( Node lbl );
   Node instantiateLabel( Node n, Node o_lbl, Node lbl, Node lbl_v, std::map< Node, Node >& visited, std::map< Node, Node >& pto_model, 
                          TypeNode rtn, std::map< Node, bool >& active_lbl, unsigned ind = 0 );
-  void setInactiveAssertionRec( Node fact, std::map< Node, std::vector< Node > >& lbl_to_assertions, std::map< Node, bool >& assert_active );
+  void setInactiveAssertionRec( Node fact, std::unordered_map< Node, std::vector< Node >, NodeHashFunction >& lbl_to_assertions,
+                                std::unordered_map< Node, bool, NodeHashFunction >& assert_active );
 
   Node mkUnion( TypeNode tn, std::vector< Node >& locs );
 
@@ -106,7 +106,6 @@ void CardinalityExtension::check()
 void CardinalityExtension::checkRegister()
 {
   Trace("sets") << "Cardinality graph..." << std::endl;
-  NodeManager* nm = NodeManager::currentNM();
   // first, ensure cardinality relationships are added as lemmas for all
   // non-basic set terms
   const std::vector<Node>& setEqc = d_state.getSetsEqClasses();
@@ -120,7 +119,7 @@ void CardinalityExtension::checkRegister()
         // if setminus, do for intersection instead
         if (n.getKind() == SETMINUS)
         {
-          n = Rewriter::rewrite(nm->mkNode(INTERSECTION, n[0], n[1]));
+          n = getCardGraphTerms(n).d_base;
         }
         registerCardinalityTerm(n);
       }
@@ -183,6 +182,7 @@ void CardinalityExtension::checkCardCycles()
   // build order of equivalence classes, also build cardinality graph
   const std::vector<Node>& setEqc = d_state.getSetsEqClasses();
   d_oSetEqc.clear();
+  d_oSetEqcSet.clear();
   d_card_parent.clear();
   for (const Node& s : setEqc)
   {
@@ -224,7 +224,7 @@ void CardinalityExtension::checkCardCyclesRec(Node eqc,
     }
     return;
   }
-  if (std::find(d_oSetEqc.begin(), d_oSetEqc.end(), eqc) != d_oSetEqc.end())
+  if (d_oSetEqcSet.find(eqc) != d_oSetEqcSet.end())
   {
     // already processed
     return;
@@ -234,6 +234,7 @@ void CardinalityExtension::checkCardCyclesRec(Node eqc,
   {
     // no non-variable sets, trivial
     d_oSetEqc.push_back(eqc);
+    d_oSetEqcSet.insert(eqc);
     return;
   }
   curr.push_back(eqc);
@@ -249,28 +250,11 @@ void CardinalityExtension::checkCardCyclesRec(Node eqc,
     }
     Trace("sets-debug") << "Build cardinality parents for " << n << "..."
                         << std::endl;
-    std::vector<Node> sib;
-    unsigned true_sib = 0;
-    if (n.getKind() == INTERSECTION)
-    {
-      d_localBase[n] = n;
-      for (unsigned e = 0; e < 2; e++)
-      {
-        Node sm = Rewriter::rewrite(nm->mkNode(SETMINUS, n[e], n[1 - e]));
-        sib.push_back(sm);
-      }
-      true_sib = 2;
-    }
-    else
-    {
-      Node si = Rewriter::rewrite(nm->mkNode(INTERSECTION, n[0], n[1]));
-      sib.push_back(si);
-      d_localBase[n] = si;
-      Node osm = Rewriter::rewrite(nm->mkNode(SETMINUS, n[1], n[0]));
-      sib.push_back(osm);
-      true_sib = 1;
-    }
-    Node u = Rewriter::rewrite(nm->mkNode(UNION, n[0], n[1]));
+    const CardGraphTerms& cgt = getCardGraphTerms(n);
+    const std::vector<Node>& sib = cgt.d_sib;
+    unsigned true_sib = nk == INTERSECTION ? 2 : 1;
+    d_localBase[n] = cgt.d_base;
+    Node u = cgt.d_union;
     if (!d_ee.hasTerm(u))
     {
       u = Node::null();
@@ -505,6 +489,39 @@ void CardinalityExtension::checkCardCyclesRec(Node eqc,
   curr.pop_back();
   // parents now processed, can add to ordered list
   d_oSetEqc.push_back(eqc);
+  d_oSetEqcSet.insert(eqc);
+}
+
+const CardinalityExtension::CardGraphTerms&
+CardinalityExtension::getCardGraphTerms(Node n)
+{
+  std::map<Node, CardGraphTerms>::iterator it = d_card_graph_terms.find(n);
+  if (it != d_card_graph_terms.end())
+  {
+    return it->second;
+  }
+  Assert(n.getKind() == INTERSECTION || n.getKind() == SETMINUS);
+  NodeManager* nm = NodeManager::currentNM();
+  CardGraphTerms& cgt = d_card_graph_terms[n];
+  if (n.getKind() == INTERSECTION)
+  {
+    cgt.d_base = n;
+    for (unsigned e = 0; e < 2; e++)
+    {
+      Node sm = Rewriter::rewrite(nm->mkNode(SETMINUS, n[e], n[1 - e]));
+      cgt.d_sib.push_back(sm);
+    }
+  }
+  else
+  {
+    Node si = Rewriter::rewrite(nm->mkNode(INTERSECTION, n[0], n[1]));
+    cgt.d_sib.push_back(si);
+    cgt.d_base = si;
+    Node osm = Rewriter::rewrite(nm->mkNode(SETMINUS, n[1], n[0]));
+    cgt.d_sib.push_back(osm);
+  }
+  cgt.d_union = Rewriter::rewrite(nm->mkNode(UNION, n[0], n[1]));
+  return cgt;
 }
 
 void CardinalityExtension::checkNormalForms(std::vector<Node>& intro_sets)
@@ -17,6 +17,8 @@
 #ifndef CVC4__THEORY__SETS__CARDINALITY_EXTENSION_H
 #define CVC4__THEORY__SETS__CARDINALITY_EXTENSION_H
 
+#include <unordered_set>
+
 #include "context/cdhashset.h"
 #include "context/context.h"
 #include "theory/sets/inference_manager.h"
@@ -316,6 +318,33 @@ class CardinalityExtension
   NodeSet d_card_processed;
   /** The ordered set of equivalence classes, see checkCardCycles. */
   std::vector<Node> d_oSetEqc;
+  /** The equivalence classes in d_oSetEqc, for membership checks */
+  std::unordered_set<Node, NodeHashFunction> d_oSetEqcSet;
+  /** The terms adjacent to a set term in the cardinality graph */
+  struct CardGraphTerms
+  {
+    /**
+     * The rewritten siblings of the term. For A ^ B, these are A \ B and
+     * B \ A. For A \ B, these are A ^ B and B \ A.
+     */
+    std::vector<Node> d_sib;
+    /** The local base of the term, see d_localBase */
+    Node d_base;
+    /**
+     * The rewritten union of the children of the term, which is a parent of
+     * the term if it exists in the current context.
+     */
+    Node d_union;
+  };
+  /**
+   * Maps intersection and set minus terms to the terms adjacent to them in the
+   * cardinality graph. Since these are computed by rewriting only, this map
+   * does not depend on the context, and it avoids rebuilding these terms each
+   * time the cardinality graph is constructed.
+   */
+  std::map<Node, CardGraphTerms> d_card_graph_terms;
+  /** Get the entry of d_card_graph_terms for n, computing it if necessary */
+  const CardGraphTerms& getCardGraphTerms(Node n);
   /**
    * This maps set terms to the set of representatives of their "parent" sets,
    * see checkCardCycles.
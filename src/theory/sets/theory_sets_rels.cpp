@@ -16,6 +16,7 @@
 
 #include "theory/sets/theory_sets_rels.h"
 #include "expr/datatype.h"
+#include "smt/smt_statistics_registry.h"
 #include "theory/sets/theory_sets_private.h"
 #include "theory/sets/theory_sets.h"
 
@@ -36,8 +37,15 @@ TheorySetsRels::TheorySetsRels(SolverState& s,
                                InferenceManager& im,
                                eq::EqualityEngine& e,
                                context::UserContext* u)
-    : d_state(s), d_im(im), d_ee(e), d_shared_terms(u)
+    : d_state(s),
+      d_im(im),
+      d_ee(e),
+      d_shared_terms(u),
+      d_composeTime("theory::sets::rels::composeTime"),
+      d_tcInferenceTime("theory::sets::rels::tcInferenceTime")
 {
+  smtStatisticsRegistry()->registerStat(&d_composeTime);
+  smtStatisticsRegistry()->registerStat(&d_tcInferenceTime);
   d_trueNode = NodeManager::currentNM()->mkConst(true);
   d_falseNode = NodeManager::currentNM()->mkConst(false);
   d_ee.addFunctionKind(PRODUCT);
@@ -49,7 +57,11 @@ TheorySetsRels::TheorySetsRels(SolverState& s,
   d_ee.addFunctionKind(APPLY_CONSTRUCTOR);
 }
 
-TheorySetsRels::~TheorySetsRels() {}
+TheorySetsRels::~TheorySetsRels()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_composeTime);
+  smtStatisticsRegistry()->unregisterStat(&d_tcInferenceTime);
+}
 
 void TheorySetsRels::check(Theory::Effort level)
 {
@@ -642,8 +654,8 @@ void TheorySetsRels::check(Theory::Effort level)
 
     Node rel_rep = getRepresentative( tc_rel[0] );
     Node tc_rel_rep = getRepresentative( tc_rel );
-    std::vector< Node > members = d_rReps_memberReps_cache[rel_rep];
-    std::vector< Node > exps = d_rReps_memberReps_exp_cache[rel_rep];
+    const std::vector<Node>& members = d_rReps_memberReps_cache[rel_rep];
+    const std::vector<Node>& exps = d_rReps_memberReps_exp_cache[rel_rep];
 
     for( unsigned int i = 0; i < members.size(); i++ ) {
       Node fst_element_rep = getRepresentative( RelsUtils::nthElementOfTuple( members[i], 0 ));
@@ -669,25 +681,31 @@ void TheorySetsRels::check(Theory::Effort level)
     }
   }
 
-  void TheorySetsRels::doTCInference( std::map< Node, std::unordered_set<Node, NodeHashFunction> > rel_tc_graph, std::map< Node, Node > rel_tc_graph_exps, Node tc_rel ) {
+  void TheorySetsRels::doTCInference( std::map< Node, std::unordered_set<Node, NodeHashFunction> >& rel_tc_graph, std::map< Node, Node >& rel_tc_graph_exps, Node tc_rel ) {
     Trace("rels-debug") << "[Theory::Rels] ****** doTCInference !" << std::endl;
+    TimerStat::CodeTimer tcTimer(d_tcInferenceTime);
     for (TC_GRAPH_IT tc_graph_it = rel_tc_graph.begin();
          tc_graph_it != rel_tc_graph.end();
          ++tc_graph_it)
     {
+      // The nodes reached from the source node of the current edges. These
+      // are shared among all edges from the source node, so that each node
+      // reachable from it is traversed once, instead of once per edge. The
+      // membership of the pair of the source node and a reached node is
+      // inferred when the node is first reached.
+      std::unordered_set<Node, NodeHashFunction> seen;
+      seen.insert(tc_graph_it->first);
       for (std::unordered_set<Node, NodeHashFunction>::iterator
                snd_elements_it = tc_graph_it->second.begin();
            snd_elements_it != tc_graph_it->second.end();
            ++snd_elements_it)
       {
         std::vector< Node > reasons;
-        std::unordered_set<Node, NodeHashFunction> seen;
         Node tuple = RelsUtils::constructPair( tc_rel, getRepresentative( tc_graph_it->first ), getRepresentative( *snd_elements_it) );
         Assert(rel_tc_graph_exps.find(tuple) != rel_tc_graph_exps.end());
         Node exp   = rel_tc_graph_exps.find( tuple )->second;
 
         reasons.push_back( exp );
-        seen.insert( tc_graph_it->first );
         doTCInference( tc_rel, reasons, rel_tc_graph, rel_tc_graph_exps, tc_graph_it->first, *snd_elements_it, seen);
       }
     }
@@ -994,8 +1012,8 @@ void TheorySetsRels::check(Theory::Effort level)
     }
     NodeManager* nm = NodeManager::currentNM();
 
-    std::vector<Node>   members = d_rReps_memberReps_cache[rel0_rep];
-    std::vector<Node>   exps    = d_rReps_memberReps_exp_cache[rel0_rep];
+    const std::vector<Node>& members = d_rReps_memberReps_cache[rel0_rep];
+    const std::vector<Node>& exps = d_rReps_memberReps_exp_cache[rel0_rep];
 
     Assert(members.size() == exps.size());
 
@@ -1028,64 +1046,107 @@ void TheorySetsRels::check(Theory::Effort level)
        d_rReps_memberReps_cache.find( r2_rep ) == d_rReps_memberReps_cache.end() ) {
       return;
     }
-    NodeManager* nm = NodeManager::currentNM();
-
-    std::vector<Node> r1_rep_exps = d_rReps_memberReps_exp_cache[r1_rep];
-    std::vector<Node> r2_rep_exps = d_rReps_memberReps_exp_cache[r2_rep];
+    TimerStat::CodeTimer composeTimer(d_composeTime);
+    const std::vector<Node>& r1_rep_exps = d_rReps_memberReps_exp_cache[r1_rep];
+    const std::vector<Node>& r2_rep_exps = d_rReps_memberReps_exp_cache[r2_rep];
     unsigned int r1_tuple_len = r1.getType().getSetElementType().getTupleLength();
-    unsigned int r2_tuple_len = r2.getType().getSetElementType().getTupleLength();
+    bool isProduct = rel.getKind() == kind::PRODUCT;
+
+    // For joins, index the members of r2 by the representative of their
+    // leftmost element, so that each member of r1 is only composed with the
+    // members of r2 whose leftmost element is equal to its rightmost element.
+    // Members whose leftmost element is not a term of the equality engine
+    // can only be compared by areEqual, in which case we consider all members
+    // of r2 for each member of r1.
+    std::unordered_map<Node, std::vector<unsigned>, NodeHashFunction> r2_index;
+    bool r2_indexed = !isProduct;
+    for (unsigned j = 0, size = r2_rep_exps.size(); r2_indexed && j < size; j++)
+    {
+      Node r2_lmost = RelsUtils::nthElementOfTuple(r2_rep_exps[j][0], 0);
+      if (!hasTerm(r2_lmost))
+      {
+        r2_indexed = false;
+        break;
+      }
+      r2_index[getRepresentative(r2_lmost)].push_back(j);
+    }
+    std::vector<unsigned> r2_all;
+    for (unsigned j = 0, size = r2_rep_exps.size(); j < size; j++)
+    {
+      r2_all.push_back(j);
+    }
+    std::vector<unsigned> r2_none;
 
     for( unsigned int i = 0; i < r1_rep_exps.size(); i++ ) {
-      for( unsigned int j = 0; j < r2_rep_exps.size(); j++ ) {
-        std::vector<Node> tuple_elements;
-        TypeNode tn = rel.getType().getSetElementType();
-        Node r1_rmost = RelsUtils::nthElementOfTuple( r1_rep_exps[i][0], r1_tuple_len-1 );
+      Node r1_rmost = RelsUtils::nthElementOfTuple( r1_rep_exps[i][0], r1_tuple_len-1 );
+      const std::vector<unsigned>* r2_cands = &r2_all;
+      if (r2_indexed && hasTerm(r1_rmost))
+      {
+        std::unordered_map<Node, std::vector<unsigned>, NodeHashFunction>::
+            iterator it = r2_index.find(getRepresentative(r1_rmost));
+        r2_cands = it == r2_index.end() ? &r2_none : &it->second;
+      }
+      for (unsigned j : *r2_cands)
+      {
         Node r2_lmost = RelsUtils::nthElementOfTuple( r2_rep_exps[j][0], 0 );
-        tuple_elements.push_back(tn.getDType()[0].getConstructor());
+        if (isProduct || areEqual(r1_rmost, r2_lmost))
+        {
+          composeMembers(rel, r1_rep_exps[i], r2_rep_exps[j]);
+        }
+      }
+    }
+  }
 
-        if( (areEqual(r1_rmost, r2_lmost) && rel.getKind() == kind::JOIN) ||
-            rel.getKind() == kind::PRODUCT ) {
-          bool isProduct = rel.getKind() == kind::PRODUCT;
-          unsigned int k = 0;
-          unsigned int l = 1;
+  void TheorySetsRels::composeMembers(Node rel, Node exp1, Node exp2)
+  {
+    NodeManager* nm = NodeManager::currentNM();
+    Node r1 = rel[0];
+    Node r2 = rel[1];
+    unsigned int r1_tuple_len = r1.getType().getSetElementType().getTupleLength();
+    unsigned int r2_tuple_len = r2.getType().getSetElementType().getTupleLength();
+    bool isProduct = rel.getKind() == kind::PRODUCT;
+    std::vector<Node> tuple_elements;
+    TypeNode tn = rel.getType().getSetElementType();
+    Node r1_rmost = RelsUtils::nthElementOfTuple( exp1[0], r1_tuple_len-1 );
+    Node r2_lmost = RelsUtils::nthElementOfTuple( exp2[0], 0 );
+    tuple_elements.push_back(tn.getDType()[0].getConstructor());
 
-          for( ; k < r1_tuple_len - 1; ++k ) {
-            tuple_elements.push_back( RelsUtils::nthElementOfTuple( r1_rep_exps[i][0], k ) );
-          }
-          if(isProduct) {
-            tuple_elements.push_back( RelsUtils::nthElementOfTuple( r1_rep_exps[i][0], k ) );
-            tuple_elements.push_back( RelsUtils::nthElementOfTuple( r2_rep_exps[j][0], 0 ) );
-          }
-          for( ; l < r2_tuple_len; ++l ) {
-            tuple_elements.push_back( RelsUtils::nthElementOfTuple( r2_rep_exps[j][0], l ) );
-          }
+    unsigned int k = 0;
+    unsigned int l = 1;
 
-          Node composed_tuple = NodeManager::currentNM()->mkNode(kind::APPLY_CONSTRUCTOR, tuple_elements);
-          Node fact = NodeManager::currentNM()->mkNode(kind::MEMBER, composed_tuple, rel);
-          std::vector<Node> reasons;
-          reasons.push_back( r1_rep_exps[i] );
-          reasons.push_back( r2_rep_exps[j] );
+    for( ; k < r1_tuple_len - 1; ++k ) {
+      tuple_elements.push_back( RelsUtils::nthElementOfTuple( exp1[0], k ) );
+    }
+    if(isProduct) {
+      tuple_elements.push_back( RelsUtils::nthElementOfTuple( exp1[0], k ) );
+      tuple_elements.push_back( RelsUtils::nthElementOfTuple( exp2[0], 0 ) );
+    }
+    for( ; l < r2_tuple_len; ++l ) {
+      tuple_elements.push_back( RelsUtils::nthElementOfTuple( exp2[0], l ) );
+    }
 
-          if( r1 != r1_rep_exps[i][1] ) {
-            reasons.push_back( NodeManager::currentNM()->mkNode(kind::EQUAL, r1, r1_rep_exps[i][1]) );
-          }
-          if( r2 != r2_rep_exps[j][1] ) {
-            reasons.push_back( NodeManager::currentNM()->mkNode(kind::EQUAL, r2, r2_rep_exps[j][1]) );
-          }
-          if( isProduct ) {
-            sendInfer(fact,
-                      nm->mkNode(kind::AND, reasons),
-                      "PRODUCT-Compose");
-          } else {
-            if( r1_rmost != r2_lmost ) {
-              reasons.push_back( NodeManager::currentNM()->mkNode(kind::EQUAL, r1_rmost, r2_lmost) );
-            }
-            sendInfer(fact, nm->mkNode(kind::AND, reasons), "JOIN-Compose");
-          }
-        }
+    Node composed_tuple = nm->mkNode(kind::APPLY_CONSTRUCTOR, tuple_elements);
+    Node fact = nm->mkNode(kind::MEMBER, composed_tuple, rel);
+    std::vector<Node> reasons;
+    reasons.push_back( exp1 );
+    reasons.push_back( exp2 );
+
+    if( r1 != exp1[1] ) {
+      reasons.push_back( nm->mkNode(kind::EQUAL, r1, exp1[1]) );
+    }
+    if( r2 != exp2[1] ) {
+      reasons.push_back( nm->mkNode(kind::EQUAL, r2, exp2[1]) );
+    }
+    if( isProduct ) {
+      sendInfer(fact,
+                nm->mkNode(kind::AND, reasons),
+                "PRODUCT-Compose");
+    } else {
+      if( r1_rmost != r2_lmost ) {
+        reasons.push_back( nm->mkNode(kind::EQUAL, r1_rmost, r2_lmost) );
       }
+      sendInfer(fact, nm->mkNode(kind::AND, reasons), "JOIN-Compose");
     }
-
   }
 
   void TheorySetsRels::doPendingInfers()
@@ -26,6 +26,7 @@
 #include "theory/sets/solver_state.h"
 #include "theory/theory.h"
 #include "theory/uf/equality_engine.h"
+#include "util/statistics_registry.h"
 
 namespace CVC4 {
 namespace theory {
@@ -118,6 +119,11 @@ private:
   std::map< Node, std::map< Node, std::unordered_set<Node, NodeHashFunction> > >     d_tcr_tcGraph;
   std::map< Node, std::map< Node, Node > > d_tcr_tcGraph_exps;
 
+  /** Time spent composing the members of joins and products */
+  TimerStat d_composeTime;
+  /** Time spent inferring the members of transitive closures */
+  TimerStat d_tcInferenceTime;
+
  private:
   /** Send infer
    *
@@ -157,11 +163,16 @@ private:
   void applyTCRule( Node mem, Node rel, Node rel_rep, Node exp);
   void buildTCGraphForRel( Node tc_rel );
   void doTCInference();
-  void doTCInference( std::map< Node, std::unordered_set<Node, NodeHashFunction> > rel_tc_graph, std::map< Node, Node > rel_tc_graph_exps, Node tc_rel );
+  void doTCInference( std::map< Node, std::unordered_set<Node, NodeHashFunction> >& rel_tc_graph, std::map< Node, Node >& rel_tc_graph_exps, Node tc_rel );
   void doTCInference(Node tc_rel, std::vector< Node > reasons, std::map< Node, std::unordered_set< Node, NodeHashFunction > >& tc_graph,
                        std::map< Node, Node >& rel_tc_graph_exps, Node start_node_rep, Node cur_node_rep, std::unordered_set< Node, NodeHashFunction >& seen );
 
   void composeMembersForRels( Node );
+  /**
+   * Infer the membership of the composition of the members of rel[0] and
+   * rel[1] whose explanations are exp1 and exp2 in the join or product rel.
+   */
+  void composeMembers(Node rel, Node exp1, Node exp2);
   void computeMembersForBinOpRel( Node );
   void computeMembersForIdenTerm( Node );
   void computeMembersForUnaryOpRel( Node );
@@ -27,6 +27,9 @@ SharedTermsDatabase::SharedTermsDatabase(TheoryEngine* theoryEngine,
                                          context::Context* context)
     : ContextNotifyObj(context),
       d_statSharedTerms("theory::shared_terms", 0),
+      d_statAssertedEqualities("theory::shared_terms::assertedEqualities", 0),
+      d_statPropagatedEqualities("theory::shared_terms::propagatedEqualities",
+                                 0),
       d_addedSharedTermsSize(context, 0),
       d_termsToTheories(context),
       d_alreadyNotifiedMap(context),
@@ -37,11 +40,15 @@ SharedTermsDatabase::SharedTermsDatabase(TheoryEngine* theoryEngine,
       d_inConflict(context, false),
       d_conflictPolarity() {
   smtStatisticsRegistry()->registerStat(&d_statSharedTerms);
+  smtStatisticsRegistry()->registerStat(&d_statAssertedEqualities);
+  smtStatisticsRegistry()->registerStat(&d_statPropagatedEqualities);
 }
 
 SharedTermsDatabase::~SharedTermsDatabase()
 {
   smtStatisticsRegistry()->unregisterStat(&d_statSharedTerms);
+  smtStatisticsRegistry()->unregisterStat(&d_statAssertedEqualities);
+  smtStatisticsRegistry()->unregisterStat(&d_statPropagatedEqualities);
 }
 
 void SharedTermsDatabase::addEqualityToPropagate(TNode equality) {
@@ -62,6 +69,7 @@ void SharedTermsDatabase::addSharedTerm(TNode atom, TNode term, Theory::Set theo
     d_addedSharedTerms.push_back(atom);
     d_addedSharedTermsSize = d_addedSharedTermsSize + 1;
     d_termsToTheories[search_pair] = theories;
+    ++d_statSharedTerms;
   } else {
     Assert(theories != (*find).second);
     d_termsToTheories[search_pair] = Theory::setUnion(theories, (*find).second);
@@ -131,6 +139,7 @@ bool SharedTermsDatabase::propagateSharedEquality(TheoryId theory, TNode a, TNod
   }
 
   // Propagate away
+  ++d_statPropagatedEqualities;
   Node equality = a.eqNode(b);
   if (value) {
     d_theoryEngine->assertToTheory(equality, equality, theory, THEORY_BUILTIN);
@@ -198,6 +207,7 @@ void SharedTermsDatabase::assertEquality(TNode equality, bool polarity, TNode re
 {
   Debug("shared-terms-database::assert") << "SharedTermsDatabase::assertEquality(" << equality << ", " << (polarity ? "true" : "false") << ", " << reason << ")" << endl;
   // Add it to the equality engine
+  ++d_statAssertedEqualities;
   d_equalityEngine.assertEquality(equality, polarity, reason);
   // Check for conflict
   checkForConflict();
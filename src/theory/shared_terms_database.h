@@ -9,8 +9,20 @@
  ** All rights reserved.  See the file COPYING in the top-level source
  ** directory for licensing information.\endverbatim
  **
- ** [[ Add lengthier description here ]]
- ** \todo document this file
+ ** \brief The database of the terms that are shared between theories.
+ **
+ ** A term is shared if it occurs in atoms of more than one theory. The
+ ** database records, for each atom, its shared subterms and the theories
+ ** that use them, and keeps an equality engine over the shared terms. The
+ ** engine receives the equalities between shared terms that the SAT solver
+ ** asserts or that theories propagate (see TheoryEngine::assertToTheory),
+ ** and notifies each theory that was told about a term when the term becomes
+ ** equal or disequal to another of its shared terms.
+ **
+ ** Each theory still runs its own congruence closure over its own terms,
+ ** so an equality between shared terms is merged once here and once in
+ ** every theory that uses them. The statistics below count these round
+ ** trips.
  **/
 
 #include "cvc4_private.h"
@@ -43,6 +55,10 @@ private:
 
   /** Some statistics */
   IntStat d_statSharedTerms;
+  /** The equalities between shared terms asserted to the database */
+  IntStat d_statAssertedEqualities;
+  /** The equalities between shared terms sent to a theory */
+  IntStat d_statPropagatedEqualities;
 
   // Needs to be a map from Nodes as after a backtrack they might not exist
   typedef std::unordered_map<Node, shared_terms_list, TNodeHashFunction> SharedTermsMap;
@@ -19,6 +19,7 @@
 
 #include "theory/sort_inference.h"
 
+#include <memory>
 #include <vector>
 
 #include "options/quantifiers_options.h"
@@ -34,8 +35,12 @@ using namespace std;
 namespace CVC4 {
 
 void SortInference::UnionFind::print(const char * c){
-  for( std::map< int, int >::iterator it = d_eqc.begin(); it != d_eqc.end(); ++it ){
-    Trace(c) << "s_" << it->first << " = s_" << it->second << ", ";
+  for (size_t i = 0, size = d_eqc.size(); i < size; i++)
+  {
+    if (d_eqc[i] != static_cast<int>(i))
+    {
+      Trace(c) << "s_" << i << " = s_" << d_eqc[i] << ", ";
+    }
   }
   for( unsigned i=0; i<d_deq.size(); i++ ){
     Trace(c) << "s_" << d_deq[i].first << " != s_" << d_deq[i].second << ", ";
@@ -44,29 +49,39 @@ void SortInference::UnionFind::print(const char * c){
 }
 void SortInference::UnionFind::set( UnionFind& c ) {
   clear();
-  for( std::map< int, int >::iterator it = c.d_eqc.begin(); it != c.d_eqc.end(); ++it ){
-    d_eqc[ it->first ] = it->second;
-  }
+  d_eqc = c.d_eqc;
   d_deq.insert( d_deq.end(), c.d_deq.begin(), c.d_deq.end() );
 }
 int SortInference::UnionFind::getRepresentative( int t ){
-  std::map< int, int >::iterator it = d_eqc.find( t );
-  if( it==d_eqc.end() || it->second==t ){
-    return t;
-  }else{
-    int rt = getRepresentative( it->second );
+  int rt = t;
+  while (rt < static_cast<int>(d_eqc.size()) && d_eqc[rt] != rt)
+  {
+    rt = d_eqc[rt];
+  }
+  // compress the path
+  while (t != rt)
+  {
+    int next = d_eqc[t];
     d_eqc[t] = rt;
-    return rt;
+    t = next;
+  }
+  return rt;
+}
+void SortInference::UnionFind::setParent( int t, int p ){
+  while (static_cast<int>(d_eqc.size()) <= t)
+  {
+    d_eqc.push_back(d_eqc.size());
   }
+  d_eqc[t] = p;
 }
 void SortInference::UnionFind::setEqual( int t1, int t2 ){
   if( t1!=t2 ){
     int rt1 = getRepresentative( t1 );
     int rt2 = getRepresentative( t2 );
     if( rt1>rt2 ){
-      d_eqc[rt1] = rt2;
+      setParent( rt1, rt2 );
     }else{
-      d_eqc[rt2] = rt1;
+      setParent( rt2, rt1 );
     }
   }
 }
@@ -82,7 +97,8 @@ bool SortInference::UnionFind::isValid() {
 
 void SortInference::recordSubsort( TypeNode tn, int s ){
   s = d_type_union_find.getRepresentative( s );
-  if( std::find( d_sub_sorts.begin(), d_sub_sorts.end(), s )==d_sub_sorts.end() ){
+  if (d_sub_sort_set.insert(s).second)
+  {
     d_sub_sorts.push_back( s );
     d_type_sub_sorts[tn].push_back( s );
   }
@@ -99,6 +115,7 @@ void SortInference::printSort( const char* c, int t ){
 
 void SortInference::reset() {
   d_sub_sorts.clear();
+  d_sub_sort_set.clear();
   d_non_monotonic_sorts.clear();
   d_type_sub_sorts.clear();
   //reset info
@@ -108,23 +125,32 @@ void SortInference::reset() {
   d_id_for_types.clear();
   d_op_return_types.clear();
   d_op_arg_types.clear();
+  d_equality_types.clear();
   d_var_types.clear();
   //for rewriting
   d_symbol_map.clear();
   d_const_map.clear();
 }
 
-void SortInference::initialize(const std::vector<Node>& assertions)
+bool SortInference::initialize(const std::vector<Node>& assertions)
 {
   Trace("sort-inference-proc") << "Calculating sort inference..." << std::endl;
+  startTimeLimit();
   // process all assertions
-  std::map<Node, int> visited;
+  NodeIntMap visited;
   for (const Node& a : assertions)
   {
     Trace("sort-inference-debug") << "Process " << a << std::endl;
-    std::map<Node, Node> var_bound;
+    NodeNodeMap var_bound;
     process(a, var_bound, visited);
   }
+  if (d_timedOut)
+  {
+    Trace("sort-inference-proc") << "...out of time" << std::endl;
+    stopTimeLimit();
+    reset();
+    return false;
+  }
   Trace("sort-inference-proc") << "...done" << std::endl;
   for (const std::pair<const Node, int>& rt : d_op_return_types)
   {
@@ -162,14 +188,21 @@ void SortInference::initialize(const std::vector<Node>& assertions)
   // determine monotonicity of sorts
   Trace("sort-inference-proc")
       << "Calculating monotonicty for subsorts..." << std::endl;
-  std::map<Node, std::map<int, bool> > visitedm;
+  std::unordered_map<Node, unsigned, NodeHashFunction> visitedm;
   for (const Node& a : assertions)
   {
     Trace("sort-inference-debug")
         << "Process monotonicity for " << a << std::endl;
-    std::map<Node, Node> var_bound;
+    NodeNodeMap var_bound;
     processMonotonic(a, true, true, var_bound, visitedm);
   }
+  stopTimeLimit();
+  if (d_timedOut)
+  {
+    Trace("sort-inference-proc") << "...out of time" << std::endl;
+    reset();
+    return false;
+  }
   Trace("sort-inference-proc") << "...done" << std::endl;
 
   Trace("sort-inference") << "We have " << d_sub_sorts.size()
@@ -191,6 +224,7 @@ void SortInference::initialize(const std::vector<Node>& assertions)
       Trace("sort-inference") << " is not monotonic." << std::endl;
     }
   }
+  return true;
 }
 
 Node SortInference::simplify(Node n,
@@ -288,19 +322,55 @@ void SortInference::getNewAssertions(std::vector<Node>& new_asserts)
 
 void SortInference::computeMonotonicity(const std::vector<Node>& assertions)
 {
-  std::map<Node, std::map<int, bool> > visitedmt;
+  std::unordered_map<Node, unsigned, NodeHashFunction> visitedmt;
   Trace("sort-inference-proc")
       << "Calculating monotonicty for types..." << std::endl;
+  startTimeLimit();
   for (const Node& a : assertions)
   {
     Trace("sort-inference-debug")
         << "Process type monotonicity for " << a << std::endl;
-    std::map<Node, Node> var_bound;
+    NodeNodeMap var_bound;
     processMonotonic(a, true, true, var_bound, visitedmt, true);
   }
+  stopTimeLimit();
+  if (d_timedOut)
+  {
+    // the types found so far may not be all the non-monotonic ones
+    Trace("sort-inference-proc") << "...out of time" << std::endl;
+    d_monotonicityTimedOut = true;
+    return;
+  }
   Trace("sort-inference-proc") << "...done" << std::endl;
 }
 
+void SortInference::startTimeLimit()
+{
+  d_timedOut = false;
+  d_steps = 0;
+  unsigned long limit = options::sortInferenceTimeLimit();
+  d_hasDeadline = limit > 0;
+  if (d_hasDeadline)
+  {
+    d_deadline = std::chrono::steady_clock::now()
+                 + std::chrono::milliseconds(limit);
+  }
+}
+
+bool SortInference::outOfTime()
+{
+  if (!d_hasDeadline)
+  {
+    return false;
+  }
+  if (!d_timedOut && ++d_steps % 1024 == 0
+      && std::chrono::steady_clock::now() > d_deadline)
+  {
+    d_timedOut = true;
+  }
+  return d_timedOut;
+}
+
 void SortInference::setEqual( int t1, int t2 ){
   if( t1!=t2 ){
     int rt1 = d_type_union_find.getRepresentative( t1 );
@@ -336,7 +406,7 @@ void SortInference::setEqual( int t1, int t2 ){
           return;
         }
       }
-      d_type_union_find.d_eqc[rt1] = rt2;
+      d_type_union_find.setParent( rt1, rt2 );
     }
   }
 }
@@ -355,196 +425,352 @@ int SortInference::getIdForType( TypeNode tn ){
   }
 }
 
-int SortInference::process( Node n, std::map< Node, Node >& var_bound, std::map< Node, int >& visited ){
-  std::map< Node, int >::iterator itv = visited.find( n );
-  if( itv!=visited.end() ){
-    return itv->second;
-  }else{
-    //add to variable bindings
-    bool use_new_visited = false;
-    std::map< Node, int > new_visited;
-    if( n.getKind()==kind::FORALL || n.getKind()==kind::EXISTS ){
-      if( d_var_types.find( n )!=d_var_types.end() ){
-        return getIdForType( n.getType() );
-      }else{
+namespace {
+
+/** A node to visit in SortInference::process */
+struct ProcessFrame
+{
+  ProcessFrame(TNode n, size_t cache)
+      : d_node(n), d_cache(cache), d_childCache(cache), d_post(false)
+  {
+  }
+  /** the node */
+  TNode d_node;
+  /** the index of the cache of the node */
+  size_t d_cache;
+  /** the index of the cache of its children */
+  size_t d_childCache;
+  /** whether its children were processed */
+  bool d_post;
+};
+
+/** whether the i^th child of n is processed by sort inference */
+bool processChild(TNode n, size_t i)
+{
+  if (n.getKind() == kind::FORALL || n.getKind() == kind::EXISTS)
+  {
+    return options::userPatternsQuant() == options::UserPatMode::IGNORE
+               ? i == 1
+               : i >= 1;
+  }
+  return true;
+}
+
+}  // namespace
+
+int SortInference::process(Node n, NodeNodeMap& var_bound, NodeIntMap& visited)
+{
+  // the caches of the quantified formulas being processed
+  std::vector<std::unique_ptr<NodeIntMap> > qcaches;
+  std::vector<NodeIntMap*> caches;
+  caches.push_back(&visited);
+  std::vector<ProcessFrame> visit;
+  visit.push_back(ProcessFrame(n, 0));
+  while (!visit.empty())
+  {
+    ProcessFrame cur = visit.back();
+    visit.pop_back();
+    TNode cn = cur.d_node;
+    NodeIntMap& cache = *caches[cur.d_cache];
+    Kind k = cn.getKind();
+    bool isQuant = k == kind::FORALL || k == kind::EXISTS;
+    if (!cur.d_post)
+    {
+      if (cache.find(cn) != cache.end())
+      {
+        continue;
+      }
+      if (outOfTime())
+      {
+        return 0;
+      }
+      if (isQuant)
+      {
+        if (d_var_types.find(cn) != d_var_types.end())
+        {
+          cache[cn] = getIdForType(cn.getType());
+          continue;
+        }
         //apply sort inference to quantified variables
-        for( size_t i=0; i<n[0].getNumChildren(); i++ ){
-          TypeNode nitn = n[0][i].getType();
-          if( !nitn.isSort() )
+        NodeIntMap& vts = d_var_types[cn];
+        for (const Node& v : cn[0])
+        {
+          TypeNode nitn = v.getType();
+          if (!nitn.isSort())
           {
             // If the variable is of an interpreted sort, we assume the
             // the sort of the variable will stay the same sort.
-            d_var_types[n][n[0][i]] = getIdForType( nitn );
+            vts[v] = getIdForType(nitn);
           }
           else
           {
             // If it is of an uninterpreted sort, infer subsorts.
-            d_var_types[n][n[0][i]] = d_sortCount;
+            vts[v] = d_sortCount;
             d_sortCount++;
           }
-          var_bound[ n[0][i] ] = n;
+          var_bound[v] = cn;
         }
+        qcaches.emplace_back(new NodeIntMap);
+        caches.push_back(qcaches.back().get());
+        cur.d_childCache = caches.size() - 1;
       }
-      use_new_visited = true;
-    }
-
-    //process children
-    std::vector< Node > children;
-    std::vector< int > child_types;
-    for( size_t i=0; i<n.getNumChildren(); i++ ){
-      bool processChild = true;
-      if( n.getKind()==kind::FORALL || n.getKind()==kind::EXISTS ){
-        processChild =
-            options::userPatternsQuant() == options::UserPatMode::IGNORE
-                ? i == 1
-                : i >= 1;
+      cur.d_post = true;
+      visit.push_back(cur);
+      // visit the children in order
+      for (size_t i = cn.getNumChildren(); i > 0; i--)
+      {
+        if (processChild(cn, i - 1))
+        {
+          visit.push_back(ProcessFrame(cn[i - 1], cur.d_childCache));
+        }
       }
-      if( processChild ){
-        children.push_back( n[i] );
-        child_types.push_back( process( n[i], var_bound, use_new_visited ? new_visited : visited ) );
+      continue;
+    }
+    std::vector<TNode> children;
+    std::vector<int> child_types;
+    NodeIntMap& ccache = *caches[cur.d_childCache];
+    for (size_t i = 0, nchild = cn.getNumChildren(); i < nchild; i++)
+    {
+      if (processChild(cn, i))
+      {
+        Assert(ccache.find(cn[i]) != ccache.end());
+        children.push_back(cn[i]);
+        child_types.push_back(ccache[cn[i]]);
       }
     }
 
     //remove from variable bindings
-    if( n.getKind()==kind::FORALL || n.getKind()==kind::EXISTS ){
-      //erase from variable bound
-      for( size_t i=0; i<n[0].getNumChildren(); i++ ){
-        var_bound.erase( n[0][i] );
+    if (isQuant)
+    {
+      for (const Node& v : cn[0])
+      {
+        var_bound.erase(v);
       }
+      Assert(cur.d_childCache == caches.size() - 1);
+      caches.pop_back();
+      qcaches.pop_back();
     }
-    Trace("sort-inference-debug") << "...Process " << n << std::endl;
+    Trace("sort-inference-debug") << "...Process " << cn << std::endl;
 
     int retType;
-    if( n.getKind()==kind::EQUAL && !n[0].getType().isBoolean() ){
-      Trace("sort-inference-debug") << "For equality " << n << ", set equal types from : " << n[0].getType() << " " << n[1].getType() << std::endl;
+    if (k == kind::EQUAL && !cn[0].getType().isBoolean())
+    {
+      Trace("sort-inference-debug")
+          << "For equality " << cn << ", set equal types from : "
+          << cn[0].getType() << " " << cn[1].getType() << std::endl;
       //if original types are mixed (e.g. Int/Real), don't commit type equality in either direction
-      if( n[0].getType()!=n[1].getType() ){
+      if (cn[0].getType() != cn[1].getType())
+      {
         //for now, assume the original types
-        for( unsigned i=0; i<2; i++ ){
-          int ct = getIdForType( n[i].getType() );
-          setEqual( child_types[i], ct );
+        for (unsigned i = 0; i < 2; i++)
+        {
+          int ct = getIdForType(cn[i].getType());
+          setEqual(child_types[i], ct);
         }
-      }else{
+      }
+      else
+      {
         //we only require that the left and right hand side must be equal
-        setEqual( child_types[0], child_types[1] );
+        setEqual(child_types[0], child_types[1]);
       }
-      d_equality_types[n] = child_types[0];
-      retType = getIdForType( n.getType() );
-    }else if( n.getKind()==kind::APPLY_UF ){
-      Node op = n.getOperator();
+      d_equality_types[cn] = child_types[0];
+      retType = getIdForType(cn.getType());
+    }
+    else if (k == kind::APPLY_UF)
+    {
+      Node op = cn.getOperator();
       TypeNode tn_op = op.getType();
-      if( d_op_return_types.find( op )==d_op_return_types.end() ){
-        if( n.getType().isBoolean() ){
+      std::map<Node, int>::iterator itr = d_op_return_types.find(op);
+      if (itr == d_op_return_types.end())
+      {
+        int rt;
+        if (cn.getType().isBoolean())
+        {
           //use booleans
-          d_op_return_types[op] = getIdForType( n.getType() );
-        }else{
+          rt = getIdForType(cn.getType());
+        }
+        else
+        {
           //assign arbitrary sort for return type
-          d_op_return_types[op] = d_sortCount;
+          rt = d_sortCount;
           d_sortCount++;
         }
-        // d_type_eq_class[d_sortCount].push_back( op );
+        itr = d_op_return_types.insert(std::pair<Node, int>(op, rt)).first;
         // assign arbitrary sort for argument types
-        for( size_t i=0; i<n.getNumChildren(); i++ ){
-          d_op_arg_types[op].push_back(d_sortCount);
+        std::vector<int>& ats = d_op_arg_types[op];
+        for (size_t i = 0, nchild = cn.getNumChildren(); i < nchild; i++)
+        {
+          ats.push_back(d_sortCount);
           d_sortCount++;
         }
       }
-      for( size_t i=0; i<n.getNumChildren(); i++ ){
+      const std::vector<int>& ats = d_op_arg_types[op];
+      for (size_t i = 0, nchild = cn.getNumChildren(); i < nchild; i++)
+      {
         //the argument of the operator must match the return type of the subterm
-        if( n[i].getType()!=tn_op[i] ){
+        if (cn[i].getType() != tn_op[i])
+        {
           //if type mismatch, assume original types
-          Trace("sort-inference-debug") << "Argument " << i << " of " << op << " " << n[i] << " has type " << n[i].getType();
-          Trace("sort-inference-debug") << ", while operator arg has type " << tn_op[i] << std::endl;
-          int ct1 = getIdForType( n[i].getType() );
-          setEqual( child_types[i], ct1 );
-          int ct2 = getIdForType( tn_op[i] );
-          setEqual( d_op_arg_types[op][i], ct2 );
-        }else{
-          setEqual( child_types[i], d_op_arg_types[op][i] );
+          Trace("sort-inference-debug")
+              << "Argument " << i << " of " << op << " " << cn[i]
+              << " has type " << cn[i].getType();
+          Trace("sort-inference-debug")
+              << ", while operator arg has type " << tn_op[i] << std::endl;
+          int ct1 = getIdForType(cn[i].getType());
+          setEqual(child_types[i], ct1);
+          int ct2 = getIdForType(tn_op[i]);
+          setEqual(ats[i], ct2);
+        }
+        else
+        {
+          setEqual(child_types[i], ats[i]);
         }
       }
       //return type is the return type
-      retType = d_op_return_types[op];
-    }else{
-      std::map< Node, Node >::iterator it = var_bound.find( n );
-      if( it!=var_bound.end() ){
-        Trace("sort-inference-debug") << n << " is a bound variable." << std::endl;
+      retType = itr->second;
+    }
+    else
+    {
+      NodeNodeMap::iterator it = var_bound.find(cn);
+      if (it != var_bound.end())
+      {
+        Trace("sort-inference-debug")
+            << cn << " is a bound variable." << std::endl;
         //the return type was specified while binding
-        retType = d_var_types[it->second][n];
-      }else if( n.getKind() == kind::VARIABLE || n.getKind()==kind::SKOLEM ){
-        Trace("sort-inference-debug") << n << " is a variable." << std::endl;
-        if( d_op_return_types.find( n )==d_op_return_types.end() ){
+        retType = d_var_types[it->second][cn];
+      }
+      else if (k == kind::VARIABLE || k == kind::SKOLEM)
+      {
+        Trace("sort-inference-debug") << cn << " is a variable." << std::endl;
+        std::map<Node, int>::iterator itr = d_op_return_types.find(cn);
+        if (itr == d_op_return_types.end())
+        {
           //assign arbitrary sort
-          d_op_return_types[n] = d_sortCount;
+          itr = d_op_return_types.insert(std::pair<Node, int>(cn, d_sortCount))
+                    .first;
           d_sortCount++;
-          // d_type_eq_class[d_sortCount].push_back( n );
         }
-        retType = d_op_return_types[n];
-      }else if( n.isConst() ){
-        Trace("sort-inference-debug") << n << " is a constant." << std::endl;
+        retType = itr->second;
+      }
+      else if (cn.isConst())
+      {
+        Trace("sort-inference-debug") << cn << " is a constant." << std::endl;
         //can be any type we want
         retType = d_sortCount;
         d_sortCount++;
-      }else{
-        Trace("sort-inference-debug") << n << " is a interpreted symbol." << std::endl;
+      }
+      else
+      {
+        Trace("sort-inference-debug")
+            << cn << " is a interpreted symbol." << std::endl;
         //it is an interpreted term
-        for( size_t i=0; i<children.size(); i++ ){
-          Trace("sort-inference-debug") << children[i] << " forced to have " << children[i].getType() << std::endl;
+        for (size_t i = 0, nchild = children.size(); i < nchild; i++)
+        {
+          Trace("sort-inference-debug")
+              << children[i] << " forced to have " << children[i].getType()
+              << std::endl;
           //must enforce the actual type of the operator on the children
-          int ct = getIdForType( children[i].getType() );
-          setEqual( child_types[i], ct );
+          int ct = getIdForType(children[i].getType());
+          setEqual(child_types[i], ct);
         }
         //return type must be the actual return type
-        retType = getIdForType( n.getType() );
+        retType = getIdForType(cn.getType());
       }
     }
-    Trace("sort-inference-debug") << "...Type( " << n << " ) = ";
-    printSort("sort-inference-debug", retType );
+    Trace("sort-inference-debug") << "...Type( " << cn << " ) = ";
+    printSort("sort-inference-debug", retType);
     Trace("sort-inference-debug") << std::endl;
-    visited[n] = retType;
-    return retType;
+    cache[cn] = retType;
   }
+  return visited[n];
 }
 
-void SortInference::processMonotonic( Node n, bool pol, bool hasPol, std::map< Node, Node >& var_bound, std::map< Node, std::map< int, bool > >& visited, bool typeMode ) {
-  int pindex = hasPol ? ( pol ? 1 : -1 ) : 0;
-  if( visited[n].find( pindex )==visited[n].end() ){
-    visited[n][pindex] = true;
-    Trace("sort-inference-debug") << "...Process monotonic " << pol << " " << hasPol << " " << n << std::endl;
-    if( n.getKind()==kind::FORALL ){
-      //only consider variables universally if it is possible this quantified formula is asserted positively
-      if( !hasPol || pol ){
-        for( unsigned i=0; i<n[0].getNumChildren(); i++ ){
-          var_bound[n[0][i]] = n;
-        }
+void SortInference::processMonotonic(
+    Node n,
+    bool pol,
+    bool hasPol,
+    NodeNodeMap& var_bound,
+    std::unordered_map<Node, unsigned, NodeHashFunction>& visited,
+    bool typeMode)
+{
+  // the nodes to visit with their polarity, and the quantified formulas whose
+  // variables to unbind, which are marked by a null polarity
+  std::vector<std::pair<TNode, int> > visit;
+  visit.push_back(std::pair<TNode, int>(n, hasPol ? (pol ? 1 : -1) : 0));
+  while (!visit.empty())
+  {
+    TNode cn = visit.back().first;
+    int pindex = visit.back().second;
+    visit.pop_back();
+    if (pindex == 2)
+    {
+      for (const Node& v : cn[0])
+      {
+        var_bound.erase(v);
       }
-      processMonotonic( n[1], pol, hasPol, var_bound, visited, typeMode );
-      if( !hasPol || pol ){
-        for( unsigned i=0; i<n[0].getNumChildren(); i++ ){
-          var_bound.erase( n[0][i] );
+      continue;
+    }
+    bool cpol = pindex == 1;
+    bool chasPol = pindex != 0;
+    // one bit per polarity
+    unsigned bit = 1 << (pindex + 1);
+    unsigned& vbits = visited[cn];
+    if ((vbits & bit) != 0)
+    {
+      continue;
+    }
+    vbits |= bit;
+    if (outOfTime())
+    {
+      return;
+    }
+    Trace("sort-inference-debug") << "...Process monotonic " << cpol << " "
+                                  << chasPol << " " << cn << std::endl;
+    if (cn.getKind() == kind::FORALL)
+    {
+      //only consider variables universally if it is possible this quantified formula is asserted positively
+      if (!chasPol || cpol)
+      {
+        for (const Node& v : cn[0])
+        {
+          var_bound[v] = cn;
         }
+        visit.push_back(std::pair<TNode, int>(cn, 2));
       }
-      return;
-    }else if( n.getKind()==kind::EQUAL ){
-      if( !hasPol || pol ){
-        for( unsigned i=0; i<2; i++ ){
-          if( var_bound.find( n[i] )!=var_bound.end() ){
-            if( !typeMode ){
-              int sid = getSortId( var_bound[n[i]], n[i] );
+      visit.push_back(std::pair<TNode, int>(cn[1], pindex));
+      continue;
+    }
+    else if (cn.getKind() == kind::EQUAL)
+    {
+      if (!chasPol || cpol)
+      {
+        for (unsigned i = 0; i < 2; i++)
+        {
+          NodeNodeMap::iterator it = var_bound.find(cn[i]);
+          if (it != var_bound.end())
+          {
+            if (!typeMode)
+            {
+              int sid = getSortId(it->second, cn[i]);
               d_non_monotonic_sorts[sid] = true;
-            }else{
-              d_non_monotonic_sorts_orig[n[i].getType()] = true;
+            }
+            else
+            {
+              d_non_monotonic_sorts_orig[cn[i].getType()] = true;
             }
             break;
           }
         }
       }
     }
-    for( unsigned i=0; i<n.getNumChildren(); i++ ){
+    // visit the children in order
+    for (size_t i = cn.getNumChildren(); i > 0; i--)
+    {
       bool npol;
       bool nhasPol;
-      theory::QuantPhaseReq::getPolarity( n, i, hasPol, pol, nhasPol, npol );
-      processMonotonic( n[i], npol, nhasPol, var_bound, visited, typeMode );
+      theory::QuantPhaseReq::getPolarity(cn, i - 1, chasPol, cpol, nhasPol, npol);
+      visit.push_back(
+          std::pair<TNode, int>(cn[i - 1], nhasPol ? (npol ? 1 : -1) : 0));
     }
   }
 }
@@ -799,8 +1025,8 @@ void SortInference::setSkolemVar( Node f, Node v, Node sk ){
   Trace("sort-inference-temp") << "Set skolem var for " << f << ", variable " << v << std::endl;
   if( isWellSortedFormula( f ) && d_var_types.find( f )==d_var_types.end() ){
     //calculate the sort for variables if not done so already
-    std::map< Node, Node > var_bound;
-    std::map< Node, int > visited;
+    NodeNodeMap var_bound;
+    NodeIntMap visited;
     process( f, var_bound, visited );
   }
   d_op_return_types[sk] = getSortId( f, v );
@@ -851,6 +1077,10 @@ void SortInference::getSortConstraints( Node n, UnionFind& uf ) {
 
 bool SortInference::isMonotonic( TypeNode tn ) {
   Assert(tn.isSort());
+  if (d_monotonicityTimedOut)
+  {
+    return false;
+  }
   return d_non_monotonic_sorts_orig.find( tn )==d_non_monotonic_sorts_orig.end();
 }
 
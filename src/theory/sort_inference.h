@@ -17,8 +17,11 @@
 #ifndef CVC4__SORT_INFERENCE_H
 #define CVC4__SORT_INFERENCE_H
 
+#include <chrono>
 #include <iostream>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <map>
 #include "expr/node.h"
@@ -38,6 +41,7 @@ class SortInference {
 private:
   //all subsorts
   std::vector< int > d_sub_sorts;
+  std::unordered_set< int > d_sub_sort_set;
   std::map< int, bool > d_non_monotonic_sorts;
   std::map< TypeNode, std::vector< int > > d_type_sub_sorts;
   void recordSubsort( TypeNode tn, int s );
@@ -48,13 +52,15 @@ public:
     UnionFind( UnionFind& c ){
       set( c );
     }
-    std::map< int, int > d_eqc;
+    /** the parent of each id, the ids past its end are their own parent */
+    std::vector< int > d_eqc;
     //pairs that must be disequal
     std::vector< std::pair< int, int > > d_deq;
     void print(const char * c);
     void clear() { d_eqc.clear(); d_deq.clear(); }
     void set( UnionFind& c );
     int getRepresentative( int t );
+    void setParent( int t, int p );
     void setEqual( int t1, int t2 );
     void setDisequal( int t1, int t2 ){ d_deq.push_back( std::pair< int, int >( t1, t2 ) ); }
     bool areEqual( int t1, int t2 ) { return getRepresentative( t1 )==getRepresentative( t2 ); }
@@ -67,21 +73,59 @@ public:
   UnionFind d_type_union_find;
   std::map< int, TypeNode > d_type_types;
   std::map< TypeNode, int > d_id_for_types;
+  typedef std::unordered_map<Node, int, NodeHashFunction> NodeIntMap;
+  typedef std::unordered_map<Node, Node, NodeHashFunction> NodeNodeMap;
   //for apply uf operators
   std::map< Node, int > d_op_return_types;
-  std::map< Node, std::vector< int > > d_op_arg_types;
-  std::map< Node, int > d_equality_types;
+  std::unordered_map<Node, std::vector<int>, NodeHashFunction> d_op_arg_types;
+  NodeIntMap d_equality_types;
   //for bound variables
-  std::map< Node, std::map< Node, int > > d_var_types;
+  std::map< Node, NodeIntMap > d_var_types;
   //get representative
   void setEqual( int t1, int t2 );
   int getIdForType( TypeNode tn );
   void printSort( const char* c, int t );
-  //process
-  int process( Node n, std::map< Node, Node >& var_bound, std::map< Node, int >& visited );
+  /**
+   * Process n, whose nodes are traversed iteratively, and return its sort id.
+   * The nodes below a quantified formula are cached in a separate table,
+   * since the bound variables of the formula give them their own sorts.
+   * Returns 0 if the time limit ran out.
+   */
+  int process(Node n, NodeNodeMap& var_bound, NodeIntMap& visited);
   // for monotonicity inference
  private:
-  void processMonotonic( Node n, bool pol, bool hasPol, std::map< Node, Node >& var_bound, std::map< Node, std::map< int, bool > >& visited, bool typeMode = false );
+  /**
+   * Process the monotonicity of the sorts (or, if typeMode is true, of the
+   * types) of the variables in n, traversed iteratively. The argument visited
+   * stores the polarities with which each node was processed.
+   */
+  void processMonotonic(Node n,
+                        bool pol,
+                        bool hasPol,
+                        NodeNodeMap& var_bound,
+                        std::unordered_map<Node, unsigned, NodeHashFunction>&
+                            visited,
+                        bool typeMode = false);
+
+  // for the time limit options::sortInferenceTimeLimit()
+ private:
+  /** start the time limit, if any */
+  void startTimeLimit();
+  /** stop the time limit */
+  void stopTimeLimit() { d_hasDeadline = false; }
+  /**
+   * Count a step, and return true if the time limit ran out. The clock is
+   * only read every few steps.
+   */
+  bool outOfTime();
+  /** whether there is a time limit */
+  bool d_hasDeadline;
+  /** whether the time limit ran out */
+  bool d_timedOut;
+  /** the number of steps since the limit was started */
+  uint64_t d_steps;
+  /** the end of the time limit */
+  std::chrono::steady_clock::time_point d_deadline;
 
 //for rewriting
 private:
@@ -105,14 +149,23 @@ private:
   void reset();
 
  public:
-  SortInference() : d_sortCount(1) {}
+  SortInference()
+      : d_sortCount(1),
+        d_hasDeadline(false),
+        d_timedOut(false),
+        d_steps(0),
+        d_monotonicityTimedOut(false)
+  {
+  }
   ~SortInference(){}
 
   /** initialize
    *
    * This initializes this class. The input formula is indicated by assertions.
+   * Returns false if options::sortInferenceTimeLimit() ran out, in which case
+   * nothing was inferred and simplify() must not be called.
    */
-  void initialize(const std::vector<Node>& assertions);
+  bool initialize(const std::vector<Node>& assertions);
   /** simplify
    *
    * This returns the simplified form of formula n, based on the information
@@ -139,7 +192,8 @@ private:
    *
    * This computes whether sorts are monotonic (see e.g. Claessen 2011). If
    * this function is called, then calls to isMonotonic() can subsequently be
-   * used to query whether sorts are monotonic.
+   * used to query whether sorts are monotonic. If
+   * options::sortInferenceTimeLimit() runs out, no sort is monotonic.
    */
   void computeMonotonicity(const std::vector<Node>& assertions);
   /** return true if tn was inferred to be monotonic */
@@ -159,6 +213,8 @@ public:
 private:
   // store monotonicity for original sorts as well
  std::map<TypeNode, bool> d_non_monotonic_sorts_orig;
+ /** whether the time limit ran out when computing the above */
+ bool d_monotonicityTimedOut;
 };
 
 }
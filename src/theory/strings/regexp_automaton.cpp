@@ -0,0 +1,581 @@
+/*********************                                                        */
+/*! \file regexp_automaton.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of deterministic automata for constant regular
+ ** expressions
+ **/
+
+#include "theory/strings/regexp_automaton.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+
+#include "base/check.h"
+
+using namespace CVC4::kind;
+
+namespace CVC4 {
+namespace theory {
+namespace strings {
+
+/** RegExpNfa
+ *
+ * A non-deterministic automaton with epsilon transitions over ranges of
+ * character codes, used for constructing instances of RegExpAutomaton.
+ */
+class RegExpNfa
+{
+ public:
+  RegExpNfa(size_t maxStates) : d_maxStates(maxStates) {}
+  /**
+   * Add the states for regular expression r, where start and end are set to
+   * the initial and final states of r. Returns false if r is not supported or
+   * if there are too many states.
+   */
+  bool addFragment(Node r, unsigned& start, unsigned& end);
+  /**
+   * Construct in res the deterministic automaton for the language from start
+   * to end. Returns false if it has too many states.
+   */
+  bool determinize(unsigned start, unsigned end, RegExpAutomaton& res);
+
+ private:
+  /** A transition by the characters in [d_lo, d_hi] to d_target */
+  struct Transition
+  {
+    unsigned d_lo;
+    unsigned d_hi;
+    unsigned d_target;
+  };
+  /** A state of the automaton */
+  struct State
+  {
+    /** The targets of epsilon transitions */
+    std::vector<unsigned> d_eps;
+    /** The other transitions */
+    std::vector<Transition> d_trans;
+  };
+  /** The states */
+  std::vector<State> d_states;
+  /** The maximal number of states */
+  size_t d_maxStates;
+  /** Make a new state s, returns false if there are too many states */
+  bool mkState(unsigned& s);
+  /** Add the epsilon closure of the states in set to set, and sort it */
+  void closure(std::vector<unsigned>& set) const;
+  /** Add the states of a, where start and end are as in addFragment */
+  bool addAutomaton(const RegExpAutomaton& a, unsigned& start, unsigned& end);
+};
+
+bool RegExpNfa::mkState(unsigned& s)
+{
+  if (d_states.size() >= d_maxStates)
+  {
+    return false;
+  }
+  s = d_states.size();
+  d_states.emplace_back();
+  return true;
+}
+
+bool RegExpNfa::addFragment(Node r, unsigned& start, unsigned& end)
+{
+  unsigned cs, ce;
+  Kind k = r.getKind();
+  switch (k)
+  {
+    case STRING_TO_REGEXP:
+    {
+      if (r[0].getKind() != CONST_STRING || !mkState(start))
+      {
+        return false;
+      }
+      end = start;
+      for (unsigned c : r[0].getConst<String>().getVec())
+      {
+        unsigned next;
+        if (!mkState(next))
+        {
+          return false;
+        }
+        unsigned code = String::convertUnsignedIntToCode(c);
+        d_states[end].d_trans.push_back(Transition{code, code, next});
+        end = next;
+      }
+      return true;
+    }
+    case REGEXP_CONCAT:
+    {
+      if (!mkState(start))
+      {
+        return false;
+      }
+      end = start;
+      for (const Node& rc : r)
+      {
+        if (!addFragment(rc, cs, ce))
+        {
+          return false;
+        }
+        d_states[end].d_eps.push_back(cs);
+        end = ce;
+      }
+      return true;
+    }
+    case REGEXP_UNION:
+    {
+      if (!mkState(start) || !mkState(end))
+      {
+        return false;
+      }
+      for (const Node& rc : r)
+      {
+        if (!addFragment(rc, cs, ce))
+        {
+          return false;
+        }
+        d_states[start].d_eps.push_back(cs);
+        d_states[ce].d_eps.push_back(end);
+      }
+      return true;
+    }
+    case REGEXP_INTER:
+    {
+      std::unique_ptr<RegExpAutomaton> a;
+      for (const Node& rc : r)
+      {
+        std::unique_ptr<RegExpAutomaton> ac =
+            RegExpAutomaton::mkAutomaton(rc, d_maxStates);
+        if (ac == nullptr)
+        {
+          return false;
+        }
+        if (a == nullptr)
+        {
+          a = std::move(ac);
+          continue;
+        }
+        std::unique_ptr<RegExpAutomaton> ai(new RegExpAutomaton);
+        if (!RegExpAutomaton::mkProduct(*a, *ac, false, d_maxStates, *ai))
+        {
+          return false;
+        }
+        a = std::move(ai);
+      }
+      return addAutomaton(*a, start, end);
+    }
+    case REGEXP_STAR:
+    case REGEXP_PLUS:
+    case REGEXP_OPT:
+    {
+      if (!mkState(start) || !mkState(end) || !addFragment(r[0], cs, ce))
+      {
+        return false;
+      }
+      d_states[start].d_eps.push_back(cs);
+      d_states[ce].d_eps.push_back(end);
+      if (k != REGEXP_PLUS)
+      {
+        d_states[start].d_eps.push_back(end);
+      }
+      if (k != REGEXP_OPT)
+      {
+        d_states[ce].d_eps.push_back(cs);
+      }
+      return true;
+    }
+    case REGEXP_LOOP:
+    {
+      // r[0]{l,u} is r[0]^l followed by u-l nested optional copies of r[0],
+      // and r[0]{l,} is r[0]^l followed by r[0]*.
+      for (unsigned i = 1, nchild = r.getNumChildren(); i < nchild; i++)
+      {
+        if (!r[i].isConst()
+            || !r[i].getConst<Rational>().getNumerator().fitsUnsignedInt())
+        {
+          return false;
+        }
+      }
+      unsigned l = r[1].getConst<Rational>().getNumerator().toUnsignedInt();
+      if (!mkState(start))
+      {
+        return false;
+      }
+      end = start;
+      for (unsigned i = 0; i < l; i++)
+      {
+        if (!addFragment(r[0], cs, ce))
+        {
+          return false;
+        }
+        d_states[end].d_eps.push_back(cs);
+        end = ce;
+      }
+      if (r.getNumChildren() == 2)
+      {
+        if (!addFragment(r[0], cs, ce))
+        {
+          return false;
+        }
+        d_states[end].d_eps.push_back(cs);
+        d_states[ce].d_eps.push_back(cs);
+        d_states[cs].d_eps.push_back(ce);
+        end = ce;
+        return true;
+      }
+      unsigned u = r[2].getConst<Rational>().getNumerator().toUnsignedInt();
+      unsigned last;
+      if (!mkState(last))
+      {
+        return false;
+      }
+      for (unsigned i = l; i < u; i++)
+      {
+        if (!addFragment(r[0], cs, ce))
+        {
+          return false;
+        }
+        d_states[end].d_eps.push_back(cs);
+        d_states[end].d_eps.push_back(last);
+        end = ce;
+      }
+      d_states[end].d_eps.push_back(last);
+      end = last;
+      return true;
+    }
+    case REGEXP_RANGE:
+    {
+      if (r[0].getKind() != CONST_STRING || r[1].getKind() != CONST_STRING
+          || r[0].getConst<String>().size() != 1
+          || r[1].getConst<String>().size() != 1 || !mkState(start)
+          || !mkState(end))
+      {
+        return false;
+      }
+      unsigned a =
+          String::convertUnsignedIntToCode(r[0].getConst<String>().front());
+      unsigned b =
+          String::convertUnsignedIntToCode(r[1].getConst<String>().front());
+      if (a <= b)
+      {
+        d_states[start].d_trans.push_back(Transition{a, b, end});
+      }
+      return true;
+    }
+    case REGEXP_SIGMA:
+    {
+      if (!mkState(start) || !mkState(end))
+      {
+        return false;
+      }
+      d_states[start].d_trans.push_back(
+          Transition{0, String::num_codes() - 1, end});
+      return true;
+    }
+    case REGEXP_EMPTY: return mkState(start) && mkState(end);
+    default: return false;
+  }
+}
+
+bool RegExpNfa::addAutomaton(const RegExpAutomaton& a,
+                             unsigned& start,
+                             unsigned& end)
+{
+  start = d_states.size();
+  for (size_t i = 0, nstates = a.getNumStates(); i < nstates; i++)
+  {
+    unsigned s;
+    if (!mkState(s))
+    {
+      return false;
+    }
+  }
+  if (!mkState(end))
+  {
+    return false;
+  }
+  for (size_t i = 0, nstates = a.getNumStates(); i < nstates; i++)
+  {
+    const RegExpAutomaton::State& as = a.d_states[i];
+    State& s = d_states[start + i];
+    for (size_t j = 0, ntrans = as.d_trans.size(); j < ntrans; j++)
+    {
+      unsigned hi = j + 1 < ntrans ? as.d_trans[j + 1].first - 1
+                                   : String::num_codes() - 1;
+      s.d_trans.push_back(
+          Transition{as.d_trans[j].first, hi, start + as.d_trans[j].second});
+    }
+    if (as.d_accept)
+    {
+      s.d_eps.push_back(end);
+    }
+  }
+  return true;
+}
+
+void RegExpNfa::closure(std::vector<unsigned>& set) const
+{
+  std::vector<bool> visited(d_states.size(), false);
+  std::vector<unsigned> toVisit = set;
+  set.clear();
+  while (!toVisit.empty())
+  {
+    unsigned s = toVisit.back();
+    toVisit.pop_back();
+    if (visited[s])
+    {
+      continue;
+    }
+    visited[s] = true;
+    set.push_back(s);
+    toVisit.insert(
+        toVisit.end(), d_states[s].d_eps.begin(), d_states[s].d_eps.end());
+  }
+  std::sort(set.begin(), set.end());
+}
+
+bool RegExpNfa::determinize(unsigned start, unsigned end, RegExpAutomaton& res)
+{
+  res.d_states.clear();
+  std::map<std::vector<unsigned>, unsigned> ids;
+  std::vector<std::vector<unsigned>> sets;
+  sets.push_back(std::vector<unsigned>{start});
+  closure(sets[0]);
+  ids[sets[0]] = 0;
+  res.d_states.emplace_back();
+  for (size_t i = 0; i < sets.size(); i++)
+  {
+    // copy, since sets is modified below
+    std::vector<unsigned> curr = sets[i];
+    // the characters at which the targets of the transitions may change
+    std::vector<unsigned> bounds;
+    bounds.push_back(0);
+    for (unsigned s : curr)
+    {
+      for (const Transition& t : d_states[s].d_trans)
+      {
+        bounds.push_back(t.d_lo);
+        if (t.d_hi + 1 < String::num_codes())
+        {
+          bounds.push_back(t.d_hi + 1);
+        }
+      }
+    }
+    std::sort(bounds.begin(), bounds.end());
+    bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+    RegExpAutomaton::State ds;
+    ds.d_accept = std::binary_search(curr.begin(), curr.end(), end);
+    for (unsigned c : bounds)
+    {
+      std::vector<unsigned> next;
+      for (unsigned s : curr)
+      {
+        for (const Transition& t : d_states[s].d_trans)
+        {
+          if (t.d_lo <= c && c <= t.d_hi)
+          {
+            next.push_back(t.d_target);
+          }
+        }
+      }
+      closure(next);
+      std::map<std::vector<unsigned>, unsigned>::iterator it = ids.find(next);
+      unsigned id;
+      if (it == ids.end())
+      {
+        if (sets.size() >= d_maxStates)
+        {
+          return false;
+        }
+        id = sets.size();
+        ids[next] = id;
+        sets.push_back(next);
+        res.d_states.emplace_back();
+      }
+      else
+      {
+        id = it->second;
+      }
+      if (ds.d_trans.empty() || ds.d_trans.back().second != id)
+      {
+        ds.d_trans.push_back(std::pair<unsigned, unsigned>(c, id));
+      }
+    }
+    res.d_states[i] = ds;
+  }
+  return true;
+}
+
+std::unique_ptr<RegExpAutomaton> RegExpAutomaton::mkAutomaton(
+    Node r, size_t maxStates)
+{
+  RegExpNfa nfa(maxStates);
+  unsigned start, end;
+  std::unique_ptr<RegExpAutomaton> res(new RegExpAutomaton);
+  if (!nfa.addFragment(r, start, end) || !nfa.determinize(start, end, *res))
+  {
+    return nullptr;
+  }
+  return res;
+}
+
+unsigned RegExpAutomaton::getNext(unsigned s, unsigned c) const
+{
+  const std::vector<std::pair<unsigned, unsigned>>& trans =
+      d_states[s].d_trans;
+  std::vector<std::pair<unsigned, unsigned>>::const_iterator it =
+      std::upper_bound(
+          trans.begin(),
+          trans.end(),
+          std::pair<unsigned, unsigned>(c,
+                                        std::numeric_limits<unsigned>::max()));
+  Assert(it != trans.begin());
+  --it;
+  return it->second;
+}
+
+bool RegExpAutomaton::accepts(const String& s) const
+{
+  unsigned curr = 0;
+  for (unsigned c : s.getVec())
+  {
+    curr = getNext(curr, String::convertUnsignedIntToCode(c));
+  }
+  return d_states[curr].d_accept;
+}
+
+bool RegExpAutomaton::isEmpty() const
+{
+  std::vector<bool> visited(d_states.size(), false);
+  std::vector<unsigned> toVisit;
+  toVisit.push_back(0);
+  while (!toVisit.empty())
+  {
+    unsigned s = toVisit.back();
+    toVisit.pop_back();
+    if (visited[s])
+    {
+      continue;
+    }
+    if (d_states[s].d_accept)
+    {
+      return false;
+    }
+    visited[s] = true;
+    for (const std::pair<unsigned, unsigned>& t : d_states[s].d_trans)
+    {
+      toVisit.push_back(t.second);
+    }
+  }
+  return true;
+}
+
+bool RegExpAutomaton::mkProduct(const RegExpAutomaton& a,
+                                const RegExpAutomaton& b,
+                                bool complB,
+                                size_t maxStates,
+                                RegExpAutomaton& res)
+{
+  res.d_states.clear();
+  std::map<std::pair<unsigned, unsigned>, unsigned> ids;
+  std::vector<std::pair<unsigned, unsigned>> pairs;
+  pairs.push_back(std::pair<unsigned, unsigned>(0, 0));
+  ids[pairs[0]] = 0;
+  res.d_states.emplace_back();
+  for (size_t i = 0; i < pairs.size(); i++)
+  {
+    const State& sa = a.d_states[pairs[i].first];
+    const State& sb = b.d_states[pairs[i].second];
+    State ds;
+    ds.d_accept = sa.d_accept && (sb.d_accept != complB);
+    // walk the transitions of both states, whose intervals both start at 0
+    size_t ia = 0;
+    size_t ib = 0;
+    unsigned c = 0;
+    while (true)
+    {
+      std::pair<unsigned, unsigned> next(sa.d_trans[ia].second,
+                                         sb.d_trans[ib].second);
+      std::map<std::pair<unsigned, unsigned>, unsigned>::iterator it =
+          ids.find(next);
+      unsigned id;
+      if (it == ids.end())
+      {
+        if (pairs.size() >= maxStates)
+        {
+          return false;
+        }
+        id = pairs.size();
+        ids[next] = id;
+        pairs.push_back(next);
+        res.d_states.emplace_back();
+      }
+      else
+      {
+        id = it->second;
+      }
+      if (ds.d_trans.empty() || ds.d_trans.back().second != id)
+      {
+        ds.d_trans.push_back(std::pair<unsigned, unsigned>(c, id));
+      }
+      unsigned na = ia + 1 < sa.d_trans.size() ? sa.d_trans[ia + 1].first
+                                               : String::num_codes();
+      unsigned nb = ib + 1 < sb.d_trans.size() ? sb.d_trans[ib + 1].first
+                                               : String::num_codes();
+      c = std::min(na, nb);
+      if (c >= String::num_codes())
+      {
+        break;
+      }
+      if (na == c)
+      {
+        ia++;
+      }
+      if (nb == c)
+      {
+        ib++;
+      }
+    }
+    res.d_states[i] = ds;
+  }
+  return true;
+}
+
+bool RegExpAutomaton::isIntersectionEmpty(const RegExpAutomaton& a,
+                                          size_t maxStates,
+                                          bool& empty) const
+{
+  RegExpAutomaton prod;
+  if (!mkProduct(*this, a, false, maxStates, prod))
+  {
+    return false;
+  }
+  empty = prod.isEmpty();
+  return true;
+}
+
+bool RegExpAutomaton::includes(const RegExpAutomaton& a,
+                               size_t maxStates,
+                               bool& incl) const
+{
+  // the language of a is included in the one of this automaton if no word
+  // is accepted by a and rejected by this automaton
+  RegExpAutomaton prod;
+  if (!mkProduct(a, *this, true, maxStates, prod))
+  {
+    return false;
+  }
+  incl = prod.isEmpty();
+  return true;
+}
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace CVC4
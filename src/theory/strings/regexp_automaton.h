@@ -0,0 +1,109 @@
+/*********************                                                        */
+/*! \file regexp_automaton.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Deterministic automata for constant regular expressions
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__STRINGS__REGEXP_AUTOMATON_H
+#define CVC4__THEORY__STRINGS__REGEXP_AUTOMATON_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "expr/node.h"
+#include "util/regexp.h"
+
+namespace CVC4 {
+namespace theory {
+namespace strings {
+
+/** RegExpAutomaton
+ *
+ * A deterministic finite automaton whose transitions are labeled by ranges of
+ * character codes, in [0, String::num_codes()). The automaton is complete,
+ * that is, the transitions of each state partition the alphabet. States from
+ * which no accepting state is reachable may hence exist.
+ *
+ * Automata are constructed for constant regular expressions, by a Thompson
+ * construction of a non-deterministic automaton over ranges followed by a
+ * subset construction, where intersections are handled by a product of the
+ * automata of their children.
+ */
+class RegExpAutomaton
+{
+ public:
+  /**
+   * Construct the automaton for the (rewritten) constant regular expression
+   * r. Returns null if r contains operators that are not supported, or if
+   * the construction requires more than maxStates states.
+   */
+  static std::unique_ptr<RegExpAutomaton> mkAutomaton(Node r,
+                                                       size_t maxStates);
+  /** Get the number of states of this automaton */
+  size_t getNumStates() const { return d_states.size(); }
+  /** Does this automaton accept s? */
+  bool accepts(const String& s) const;
+  /** Is the language of this automaton empty? */
+  bool isEmpty() const;
+  /**
+   * Set empty to whether the intersection of the languages of this automaton
+   * and a is empty. Returns false if this could not be determined within
+   * maxStates states of the product automaton.
+   */
+  bool isIntersectionEmpty(const RegExpAutomaton& a,
+                           size_t maxStates,
+                           bool& empty) const;
+  /**
+   * Set incl to whether the language of this automaton includes the language
+   * of a. Returns false if this could not be determined within maxStates
+   * states of the product automaton.
+   */
+  bool includes(const RegExpAutomaton& a, size_t maxStates, bool& incl) const;
+
+ private:
+  /** A state of the automaton */
+  struct State
+  {
+    State() : d_accept(false) {}
+    /**
+     * The transitions of this state, as pairs (c, t) sorted by c, where the
+     * first c is zero. The characters in [c, c') go to state t, where c' is
+     * the character of the next transition (or String::num_codes() for the
+     * last transition).
+     */
+    std::vector<std::pair<unsigned, unsigned>> d_trans;
+    /** Whether this state is accepting */
+    bool d_accept;
+  };
+  /** The states of this automaton, where state 0 is the initial state */
+  std::vector<State> d_states;
+  /** Get the state reached from state s by character code c */
+  unsigned getNext(unsigned s, unsigned c) const;
+  /**
+   * Construct the product of a and b in res, whose states are accepting if
+   * the corresponding state of a is accepting and the corresponding state of
+   * b is accepting (if complB is false) or not accepting (if complB is true).
+   * Returns false if the product has more than maxStates states.
+   */
+  static bool mkProduct(const RegExpAutomaton& a,
+                        const RegExpAutomaton& b,
+                        bool complB,
+                        size_t maxStates,
+                        RegExpAutomaton& res);
+  friend class RegExpNfa;
+};
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__STRINGS__REGEXP_AUTOMATON_H */
@@ -28,6 +28,12 @@ namespace CVC4 {
 namespace theory {
 namespace strings {
 
+/**
+ * The maximal number of states of the automata constructed for deciding
+ * inclusion and empty intersection.
+ */
+static const size_t s_automataMaxStates = 10000;
+
 RegExpOpr::RegExpOpr()
     : d_emptyString(NodeManager::currentNM()->mkConst(::CVC4::String(""))),
       d_true(NodeManager::currentNM()->mkConst(true)),
@@ -697,8 +703,7 @@ Node RegExpOpr::derivativeSingle( Node r, CVC4::String c ) {
 void RegExpOpr::firstChars(Node r, std::set<unsigned> &pcset, SetNodes &pvset)
 {
   Trace("regexp-fset") << "Start FSET(" << mkString(r) << ")" << std::endl;
-  std::map<Node, std::pair<std::set<unsigned>, SetNodes> >::const_iterator itr =
-      d_fset_cache.find(r);
+  const auto& itr = d_fset_cache.find(r);
   if(itr != d_fset_cache.end()) {
     pcset.insert((itr->second).first.begin(), (itr->second).first.end());
     pvset.insert((itr->second).second.begin(), (itr->second).second.end());
@@ -842,7 +847,7 @@ void RegExpOpr::simplify(Node t, std::vector< Node > &new_nodes, bool polarity)
 void RegExpOpr::simplifyNRegExp( Node s, Node r, std::vector< Node > &new_nodes ) {
   std::pair < Node, Node > p(s, r);
   NodeManager *nm = NodeManager::currentNM();
-  std::map < std::pair< Node, Node >, Node >::const_iterator itr = d_simpl_neg_cache.find(p);
+  const auto& itr = d_simpl_neg_cache.find(p);
   if(itr != d_simpl_neg_cache.end()) {
     new_nodes.push_back( itr->second );
   } else {
@@ -1062,7 +1067,7 @@ void RegExpOpr::simplifyNRegExp( Node s, Node r, std::vector< Node > &new_nodes
 void RegExpOpr::simplifyPRegExp( Node s, Node r, std::vector< Node > &new_nodes ) {
   std::pair < Node, Node > p(s, r);
   NodeManager *nm = NodeManager::currentNM();
-  std::map < std::pair< Node, Node >, Node >::const_iterator itr = d_simpl_cache.find(p);
+  const auto& itr = d_simpl_cache.find(p);
   if(itr != d_simpl_cache.end()) {
     new_nodes.push_back( itr->second );
   } else {
@@ -1369,7 +1374,7 @@ void RegExpOpr::convert2(unsigned cnt, Node n, Node &r1, Node &r2) {
 }
 
 bool RegExpOpr::testNoRV(Node r) {
-  std::map< Node, bool >::const_iterator itr = d_norv_cache.find(r);
+  const auto& itr = d_norv_cache.find(r);
   if(itr != d_norv_cache.end()) {
     return itr->second;
   } else {
@@ -1402,7 +1407,7 @@ Node RegExpOpr::intersectInternal( Node r1, Node r2, std::map< PairNodes, Node >
   //      }
   //}
   std::pair < Node, Node > p(r1, r2);
-  std::map < PairNodes, Node >::const_iterator itr = d_inter_cache.find(p);
+  const auto& itr = d_inter_cache.find(p);
   Node rNode;
   if(itr != d_inter_cache.end()) {
     rNode = itr->second;
@@ -1522,7 +1527,7 @@ Node RegExpOpr::intersectInternal( Node r1, Node r2, std::map< PairNodes, Node >
 
 Node RegExpOpr::removeIntersection(Node r) {
   Assert(checkConstRegExp(r));
-  std::map < Node, Node >::const_iterator itr = d_rm_inter_cache.find(r);
+  const auto& itr = d_rm_inter_cache.find(r);
   if(itr != d_rm_inter_cache.end()) {
     return itr->second;
   }
@@ -1720,18 +1725,34 @@ bool RegExpOpr::regExpIncludes(Node r1, Node r2)
     return true;
   }
 
-  // This method only works on a fragment of regular expressions
-  if (!utils::isSimpleRegExp(r1) || !utils::isSimpleRegExp(r2))
-  {
-    return false;
-  }
-
   const auto& it = d_inclusionCache.find(std::make_pair(r1, r2));
   if (it != d_inclusionCache.end())
   {
     return (*it).second;
   }
 
+  // This method only works on a fragment of regular expressions, unless we
+  // are using automata
+  if (!utils::isSimpleRegExp(r1) || !utils::isSimpleRegExp(r2))
+  {
+    if (!options::stringRegExpAutomata())
+    {
+      return false;
+    }
+    RegExpAutomaton* a1 = getAutomaton(r1);
+    RegExpAutomaton* a2 = a1 == nullptr ? nullptr : getAutomaton(r2);
+    bool result = false;
+    if (a2 != nullptr && !a1->includes(*a2, s_automataMaxStates, result))
+    {
+      result = false;
+    }
+    Trace("regexp-automata") << "Automata inclusion of " << mkString(r2)
+                             << " in " << mkString(r1) << " : " << result
+                             << std::endl;
+    d_inclusionCache[std::make_pair(r1, r2)] = result;
+    return result;
+  }
+
   std::vector<Node> v1, v2;
   utils::getRegexpComponents(r1, v1);
   utils::getRegexpComponents(r2, v2);
@@ -1819,6 +1840,66 @@ bool RegExpOpr::regExpIncludes(Node r1, Node r2)
   return result;
 }
 
+bool RegExpOpr::isIntersectionEmpty(Node r1, Node r2)
+{
+  if (!options::stringRegExpAutomata())
+  {
+    return false;
+  }
+  RegExpAutomaton* a1 = getAutomaton(r1);
+  RegExpAutomaton* a2 = a1 == nullptr ? nullptr : getAutomaton(r2);
+  bool empty = false;
+  if (a2 != nullptr && !a1->isIntersectionEmpty(*a2, s_automataMaxStates, empty))
+  {
+    empty = false;
+  }
+  Trace("regexp-automata") << "Automata intersection of " << mkString(r1)
+                           << " and " << mkString(r2)
+                           << " is empty : " << empty << std::endl;
+  return empty;
+}
+
+size_t RegExpOpr::getCacheSize() const
+{
+  return d_simpl_cache.size() + d_simpl_neg_cache.size()
+         + d_delta_cache.size() + d_dv_cache.size() + d_deriv_cache.size()
+         + d_constCache.size() + d_fset_cache.size() + d_inter_cache.size()
+         + d_rm_inter_cache.size() + d_norv_cache.size()
+         + d_inclusionCache.size() + d_automata.size();
+}
+
+void RegExpOpr::clearCaches()
+{
+  d_simpl_cache.clear();
+  d_simpl_neg_cache.clear();
+  d_delta_cache.clear();
+  d_dv_cache.clear();
+  d_deriv_cache.clear();
+  d_constCache.clear();
+  d_fset_cache.clear();
+  d_inter_cache.clear();
+  d_rm_inter_cache.clear();
+  d_norv_cache.clear();
+  d_inclusionCache.clear();
+  d_automata.clear();
+}
+
+RegExpAutomaton* RegExpOpr::getAutomaton(Node r)
+{
+  std::map<Node, std::unique_ptr<RegExpAutomaton> >::iterator it =
+      d_automata.find(r);
+  if (it != d_automata.end())
+  {
+    return it->second.get();
+  }
+  std::unique_ptr<RegExpAutomaton>& a = d_automata[r];
+  a = RegExpAutomaton::mkAutomaton(r, s_automataMaxStates);
+  Trace("regexp-automata") << "Automaton for " << mkString(r) << " has "
+                           << (a == nullptr ? 0 : a->getNumStates())
+                           << " states" << std::endl;
+  return a.get();
+}
+
 }/* CVC4::theory::strings namespace */
 }/* CVC4::theory namespace */
 }/* CVC4 namespace */
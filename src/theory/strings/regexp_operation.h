@@ -23,10 +23,13 @@
 #include <set>
 #include <algorithm>
 #include <climits>
+#include <memory>
+#include <unordered_map>
 #include "util/hash.h"
 #include "util/regexp.h"
 #include "theory/theory.h"
 #include "theory/rewriter.h"
+#include "theory/strings/regexp_automaton.h"
 //#include "context/cdhashmap.h"
 
 namespace CVC4 {
@@ -71,21 +74,41 @@ class RegExpOpr {
   Node d_sigma;
   Node d_sigma_star;
 
-  std::map<PairNodes, Node> d_simpl_cache;
-  std::map<PairNodes, Node> d_simpl_neg_cache;
-  std::map<Node, std::pair<int, Node> > d_delta_cache;
-  std::map<PairNodeStr, Node> d_dv_cache;
-  std::map<PairNodeStr, std::pair<Node, int> > d_deriv_cache;
-  std::map<Node, std::pair<Node, int> > d_compl_cache;
+  typedef PairHashFunction<Node, Node, NodeHashFunction, NodeHashFunction>
+      PairNodesHashFunction;
+  typedef PairHashFunction<Node,
+                           CVC4::String,
+                           NodeHashFunction,
+                           CVC4::strings::StringHashFunction>
+      PairNodeStrHashFunction;
+
+  std::unordered_map<PairNodes, Node, PairNodesHashFunction> d_simpl_cache;
+  std::unordered_map<PairNodes, Node, PairNodesHashFunction> d_simpl_neg_cache;
+  std::unordered_map<Node, std::pair<int, Node>, NodeHashFunction>
+      d_delta_cache;
+  std::unordered_map<PairNodeStr, Node, PairNodeStrHashFunction> d_dv_cache;
+  std::unordered_map<PairNodeStr, std::pair<Node, int>, PairNodeStrHashFunction>
+      d_deriv_cache;
   /** cache mapping regular expressions to whether they contain constants */
   std::unordered_map<Node, RegExpConstType, NodeHashFunction> d_constCache;
-  std::map<Node, std::pair<std::set<unsigned>, std::set<Node> > > d_cset_cache;
-  std::map<Node, std::pair<std::set<unsigned>, std::set<Node> > > d_fset_cache;
-  std::map<PairNodes, Node> d_inter_cache;
-  std::map<Node, Node> d_rm_inter_cache;
-  std::map<Node, bool> d_norv_cache;
-  std::map<Node, std::vector<PairNodes> > d_split_cache;
-  std::map<PairNodes, bool> d_inclusionCache;
+  std::unordered_map<Node,
+                     std::pair<std::set<unsigned>, std::set<Node> >,
+                     NodeHashFunction>
+      d_fset_cache;
+  std::unordered_map<PairNodes, Node, PairNodesHashFunction> d_inter_cache;
+  std::unordered_map<Node, Node, NodeHashFunction> d_rm_inter_cache;
+  std::unordered_map<Node, bool, NodeHashFunction> d_norv_cache;
+  std::unordered_map<PairNodes, bool, PairNodesHashFunction> d_inclusionCache;
+  /**
+   * Maps constant regular expressions to their automata, or to null if the
+   * automaton could not be constructed.
+   */
+  std::map<Node, std::unique_ptr<RegExpAutomaton> > d_automata;
+  /**
+   * Get the automaton of the constant regular expression r, or null if it
+   * could not be constructed.
+   */
+  RegExpAutomaton* getAutomaton(Node r);
   void simplifyPRegExp(Node s, Node r, std::vector<Node> &new_nodes);
   void simplifyNRegExp(Node s, Node r, std::vector<Node> &new_nodes);
   /**
@@ -138,7 +161,8 @@ class RegExpOpr {
    * the regular expression `r2` (i.e. `r1` matches a superset of sequences
    * that `r2` matches). This method only works on a fragment of regular
    * expressions, specifically regular expressions that pass the
-   * `isSimpleRegExp` check.
+   * `isSimpleRegExp` check, unless option `--re-automata` is set, in which
+   * case the automata of constant regular expressions are compared.
    *
    * @param r1 The regular expression that may include `r2` (must be in
    *           rewritten form)
@@ -147,6 +171,20 @@ class RegExpOpr {
    * @return True if the inclusion can be shown, false otherwise
    */
   bool regExpIncludes(Node r1, Node r2);
+  /**
+   * Returns true if we can show that the intersection of the constant
+   * regular expressions `r1` and `r2` is empty using their automata. This
+   * method returns false if option `--re-automata` is not set.
+   */
+  bool isIntersectionEmpty(Node r1, Node r2);
+  /** Get the total number of entries in the caches of this class */
+  size_t getCacheSize() const;
+  /**
+   * Clear the caches of this class. This does not affect the correctness of
+   * the methods of this class, but terms they construct using fresh skolems
+   * may be constructed again with new skolems.
+   */
+  void clearCaches();
 };
 
 }/* CVC4::theory::strings namespace */
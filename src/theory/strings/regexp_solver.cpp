@@ -57,6 +57,12 @@ Node RegExpSolver::mkAnd(Node c1, Node c2)
   return NodeManager::currentNM()->mkNode(AND, c1, c2);
 }
 
+void RegExpSolver::clearCaches()
+{
+  d_regexp_opr.clearCaches();
+  ++(d_parent.d_statistics.d_regexp_cache_clears);
+}
+
 void RegExpSolver::check(const std::map<Node, std::vector<Node> >& mems)
 {
   bool addedLemma = false;
@@ -64,6 +70,18 @@ void RegExpSolver::check(const std::map<Node, std::vector<Node> >& mems)
   std::vector<Node> processed;
   std::vector<Node> cprocessed;
 
+  // clear the caches of the regular expression operations if they are too
+  // large
+  size_t cacheSize = d_regexp_opr.getCacheSize();
+  d_parent.d_statistics.d_regexp_cache_entries.maxAssign(cacheSize);
+  unsigned cacheLimit = options::stringRegExpCacheLimit();
+  if (cacheLimit > 0 && cacheSize > cacheLimit)
+  {
+    Trace("regexp-process") << "Clear caches of size " << cacheSize
+                            << std::endl;
+    clearCaches();
+  }
+
   Trace("regexp-process") << "Checking Memberships ... " << std::endl;
   for (const std::pair<const Node, std::vector<Node> >& mr : mems)
   {
@@ -422,11 +440,17 @@ bool RegExpSolver::checkEqcIntersect(const std::vector<Node>& mems)
       rcti = rct;
       continue;
     }
-    bool spflag = false;
-    Node resR = d_regexp_opr.intersect(mi[1], m[1], spflag);
-    // intersection should be computable
-    Assert(!resR.isNull());
-    Assert(!spflag);
+    // check with automata first, which avoids computing the intersection
+    // when it is empty
+    Node resR = d_emptyRegexp;
+    if (!d_regexp_opr.isIntersectionEmpty(mi[1], m[1]))
+    {
+      bool spflag = false;
+      resR = d_regexp_opr.intersect(mi[1], m[1], spflag);
+      // intersection should be computable
+      Assert(!resR.isNull());
+      Assert(!spflag);
+    }
     if (resR == d_emptyRegexp)
     {
       // conflict, explain
@@ -63,6 +63,8 @@ class RegExpSolver
    * engine of the theory of strings.
    */
   void check(const std::map<Node, std::vector<Node>>& mems);
+  /** Clear the caches of the regular expression operations */
+  void clearCaches();
 
  private:
   /**
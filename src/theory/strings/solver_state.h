@@ -75,6 +75,12 @@ class EqcInfo
   context::CDO<Node> d_prefixC;
   /** same as above, for suffix. */
   context::CDO<Node> d_suffixC;
+  /**
+   * The identifier of the normal form cached for this equivalence class by
+   * the theory of strings, or zero if no cached normal form is valid. This is
+   * reset to zero when this equivalence class is merged with another one.
+   */
+  context::CDO<unsigned> d_nfCacheId;
 };
 
 /**
@@ -24,6 +24,7 @@
 #include "smt/command.h"
 #include "smt/logic_exception.h"
 #include "smt/smt_statistics_registry.h"
+#include "theory/evaluator.h"
 #include "theory/ext_theory.h"
 #include "theory/rewriter.h"
 #include "theory/strings/theory_strings_rewriter.h"
@@ -96,6 +97,7 @@ TheoryStrings::TheoryStrings(context::Context* c,
       d_equalityEngine(d_notify, c, "theory::strings", true),
       d_state(c, d_equalityEngine, d_valuation),
       d_im(*this, c, u, d_state, out),
+      d_nf_cache_next_id(1),
       d_nf_pairs(c),
       d_pregistered_terms_cache(u),
       d_registered_terms_cache(u),
@@ -461,6 +463,11 @@ bool TheoryStrings::doReduction(int effort, Node n, bool& isCd)
 /////////////////////////////////////////////////////////////////////////////
 
 
+void TheoryStrings::notifyMemoryPressure()
+{
+  d_regexp_solver.clearCaches();
+}
+
 void TheoryStrings::presolve() {
   Debug("strings-presolve") << "TheoryStrings::Presolving : get fmf options " << (options::stringFMF() ? "true" : "false") << std::endl;
   initializeStrategy();
@@ -1072,6 +1079,15 @@ void TheoryStrings::eqNotifyNewClass(TNode t){
 
 /** called when two equivalance classes will merge */
 void TheoryStrings::eqNotifyPreMerge(TNode t1, TNode t2){
+  // the normal forms cached for the two classes are no longer valid
+  for (TNode t : {t1, t2})
+  {
+    EqcInfo* ei = d_state.getOrMakeEqcInfo(t, false);
+    if (ei && ei->d_nfCacheId.get() != 0)
+    {
+      ei->d_nfCacheId = 0;
+    }
+  }
   EqcInfo* e2 = d_state.getOrMakeEqcInfo(t2, false);
   if( e2 ){
     EqcInfo* e1 = d_state.getOrMakeEqcInfo(t1);
@@ -1528,6 +1544,12 @@ void TheoryStrings::checkExtfEval( int effort ) {
   NodeManager* nm = NodeManager::currentNM();
   bool has_nreduce = false;
   std::vector< Node > terms = getExtTheory()->getActive();
+  // the values of the terms in the model, if effort=3
+  std::map<Node, Node> mvals;
+  if (effort == 3)
+  {
+    getExtfModelValues(terms, mvals);
+  }
   for (const Node& n : terms)
   {
     // Setup information about n, including if it is equal to a constant.
@@ -1571,8 +1593,10 @@ void TheoryStrings::checkExtfEval( int effort ) {
           << ", constant = " << einfo.d_const << ", effort=" << effort << "..."
           << std::endl;
       einfo.d_exp.insert(einfo.d_exp.end(), exp.begin(), exp.end());
-      // inference is rewriting the substituted node
-      Node nrc = Rewriter::rewrite( sn );
+      // inference is rewriting the substituted node, or its value computed
+      // by the evaluator above
+      std::map<Node, Node>::iterator itm = mvals.find(n);
+      Node nrc = itm != mvals.end() ? itm->second : Rewriter::rewrite(sn);
       //if rewrites to a constant, then do the inference and mark as reduced
       if( nrc.isConst() ){
         if( effort<3 ){
@@ -1717,6 +1741,69 @@ void TheoryStrings::checkExtfEval( int effort ) {
   d_has_extf = has_nreduce;
 }
 
+void TheoryStrings::getExtfModelValues(const std::vector<Node>& terms,
+                                       std::map<Node, Node>& vals)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  // the terms and points to evaluate, for each kind
+  std::map<Kind, std::vector<Node> > kterms;
+  std::map<Kind, std::vector<std::vector<Node> > > kpoints;
+  for (const Node& n : terms)
+  {
+    Kind k = n.getKind();
+    // the kinds of extended functions that are supported by the evaluator
+    if (k != STRING_SUBSTR && k != STRING_STRIDOF && k != STRING_STRCTN
+        && k != STRING_STRREPL && k != STRING_ITOS && k != STRING_STOI
+        && k != STRING_CODE)
+    {
+      continue;
+    }
+    std::vector<Node> pt;
+    for (const Node& nc : n)
+    {
+      Node mv = d_valuation.getModel()->getRepresentative(nc);
+      if (!mv.isConst())
+      {
+        break;
+      }
+      pt.push_back(mv);
+    }
+    if (pt.size() < n.getNumChildren())
+    {
+      continue;
+    }
+    Node& pattern = d_extf_eval_pattern[k];
+    if (pattern.isNull())
+    {
+      std::vector<Node> vars;
+      for (const Node& nc : n)
+      {
+        vars.push_back(nm->mkBoundVar(nc.getType()));
+      }
+      pattern = nm->mkNode(k, vars);
+    }
+    Assert(pattern.getNumChildren() == n.getNumChildren());
+    kterms[k].push_back(n);
+    kpoints[k].push_back(pt);
+  }
+  Evaluator eval;
+  std::vector<Node> res;
+  for (const std::pair<const Kind, std::vector<Node> >& kt : kterms)
+  {
+    Node pattern = d_extf_eval_pattern[kt.first];
+    std::vector<Node> vars(pattern.begin(), pattern.end());
+    res.clear();
+    eval.eval(pattern, vars, kpoints[kt.first], res);
+    Assert(res.size() == kt.second.size());
+    for (size_t i = 0, nterms = kt.second.size(); i < nterms; i++)
+    {
+      Trace("strings-extf-debug") << "Model value of " << kt.second[i]
+                                  << " is " << res[i] << std::endl;
+      vals[kt.second[i]] = res[i];
+    }
+  }
+}
+
 void TheoryStrings::checkExtfInference( Node n, Node nr, ExtfInfoTmp& in, int effort ){
   if (in.d_const.isNull())
   {
@@ -2625,6 +2712,14 @@ void TheoryStrings::checkCodes()
 //compute d_normal_forms_(base,exp,exp_depend)[eqc]
 void TheoryStrings::normalizeEquivalenceClass( Node eqc ) {
   Trace("strings-process-debug") << "Process equivalence class " << eqc << std::endl;
+  if (options::stringNfCache() && getCachedNormalForm(eqc))
+  {
+    Trace("strings-process-debug")
+        << "Return process equivalence class " << eqc << " : cached."
+        << std::endl;
+    ++(d_statistics.d_nf_cache_hits);
+    return;
+  }
   if (d_state.areEqual(eqc, d_emptyString))
   {
 #ifdef CVC4_ASSERTIONS
@@ -2677,6 +2772,76 @@ void TheoryStrings::normalizeEquivalenceClass( Node eqc ) {
         << " : returned, size = " << d_normal_form[eqc].d_nf.size()
         << std::endl;
   }
+  if (options::stringNfCache())
+  {
+    cacheNormalForm(eqc);
+  }
+}
+
+bool TheoryStrings::getCachedNormalForm(Node eqc)
+{
+  std::map<Node, CachedNormalForm>::iterator it = d_nf_cache.find(eqc);
+  if (it == d_nf_cache.end())
+  {
+    return false;
+  }
+  CachedNormalForm& cnf = it->second;
+  EqcInfo* ei = d_state.getOrMakeEqcInfo(eqc, false);
+  if (ei == nullptr || ei->d_nfCacheId.get() != cnf.d_id)
+  {
+    return false;
+  }
+  for (const std::pair<Node, unsigned>& d : cnf.d_deps)
+  {
+    // the class of the dependency must still have the entry that was used
+    std::map<Node, CachedNormalForm>::iterator itd = d_nf_cache.find(d.first);
+    if (itd == d_nf_cache.end() || itd->second.d_id != d.second
+        || d_normal_form.find(d.first) == d_normal_form.end())
+    {
+      return false;
+    }
+    EqcInfo* eid = d_state.getOrMakeEqcInfo(d.first, false);
+    if (eid == nullptr || eid->d_nfCacheId.get() != d.second)
+    {
+      return false;
+    }
+  }
+  Assert(d_normal_form.find(eqc) == d_normal_form.end());
+  d_normal_form[eqc] = cnf.d_nf;
+  return true;
+}
+
+void TheoryStrings::cacheNormalForm(Node eqc)
+{
+  CachedNormalForm& cnf = d_nf_cache[eqc];
+  cnf.d_id = d_nf_cache_next_id++;
+  cnf.d_nf = getNormalForm(eqc);
+  cnf.d_deps.clear();
+  // the normal form depends on the classes of the components of the
+  // concatenation terms of eqc, as considered in getNormalForms
+  std::unordered_set<Node, NodeHashFunction> deps;
+  eq::EqClassIterator eqc_i = eq::EqClassIterator(eqc, &d_equalityEngine);
+  while (!eqc_i.isFinished())
+  {
+    Node n = (*eqc_i);
+    ++eqc_i;
+    if (n.getKind() != STRING_CONCAT || d_congruent.find(n) != d_congruent.end())
+    {
+      continue;
+    }
+    for (const Node& nc : n)
+    {
+      Node nr = d_equalityEngine.getRepresentative(nc);
+      if (deps.insert(nr).second)
+      {
+        std::map<Node, CachedNormalForm>::iterator itd = d_nf_cache.find(nr);
+        unsigned id = itd == d_nf_cache.end() ? 0 : itd->second.d_id;
+        cnf.d_deps.push_back(std::pair<Node, unsigned>(nr, id));
+      }
+    }
+  }
+  EqcInfo* ei = d_state.getOrMakeEqcInfo(eqc);
+  ei->d_nfCacheId = cnf.d_id;
 }
 
 NormalForm& TheoryStrings::getNormalForm(Node n)
@@ -4447,12 +4612,18 @@ TheoryStrings::Statistics::Statistics()
     : d_splits("theory::strings::NumOfSplitOnDemands", 0),
       d_eq_splits("theory::strings::NumOfEqSplits", 0),
       d_deq_splits("theory::strings::NumOfDiseqSplits", 0),
-      d_loop_lemmas("theory::strings::NumOfLoops", 0)
+      d_loop_lemmas("theory::strings::NumOfLoops", 0),
+      d_regexp_cache_clears("theory::strings::NumOfRegExpCacheClears", 0),
+      d_regexp_cache_entries("theory::strings::MaxRegExpCacheEntries", 0),
+      d_nf_cache_hits("theory::strings::NumOfNormalFormCacheHits", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_splits);
   smtStatisticsRegistry()->registerStat(&d_eq_splits);
   smtStatisticsRegistry()->registerStat(&d_deq_splits);
   smtStatisticsRegistry()->registerStat(&d_loop_lemmas);
+  smtStatisticsRegistry()->registerStat(&d_regexp_cache_clears);
+  smtStatisticsRegistry()->registerStat(&d_regexp_cache_entries);
+  smtStatisticsRegistry()->registerStat(&d_nf_cache_hits);
 }
 
 TheoryStrings::Statistics::~Statistics(){
@@ -4460,6 +4631,9 @@ TheoryStrings::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_eq_splits);
   smtStatisticsRegistry()->unregisterStat(&d_deq_splits);
   smtStatisticsRegistry()->unregisterStat(&d_loop_lemmas);
+  smtStatisticsRegistry()->unregisterStat(&d_regexp_cache_clears);
+  smtStatisticsRegistry()->unregisterStat(&d_regexp_cache_entries);
+  smtStatisticsRegistry()->unregisterStat(&d_nf_cache_hits);
 }
 
 /** run the given inference step */
@@ -38,6 +38,7 @@
 
 #include <climits>
 #include <deque>
+#include <unordered_set>
 
 namespace CVC4 {
 namespace theory {
@@ -225,6 +226,43 @@ class TheoryStrings : public Theory {
   std::map<Node, NormalForm> d_normal_form;
   /** get normal form */
   NormalForm& getNormalForm(Node n);
+  /** A normal form cached for an equivalence class */
+  struct CachedNormalForm
+  {
+    CachedNormalForm() : d_id(0) {}
+    /**
+     * The identifier of this entry, which is valid if it is the value of
+     * d_nfCacheId in the equivalence class information of its class.
+     */
+    unsigned d_id;
+    /** The normal form */
+    NormalForm d_nf;
+    /**
+     * The representatives of the classes whose normal forms were used for
+     * computing d_nf, paired with the identifiers of their cached normal forms
+     * at that time.
+     */
+    std::vector<std::pair<Node, unsigned> > d_deps;
+  };
+  /**
+   * Map from equivalence classes to the normal form last computed for them by
+   * normalizeEquivalenceClass. The entry for a class is reused in a full
+   * effort check when the class has not been merged since the normal form
+   * was computed (as witnessed by its identifier) and the classes it depends
+   * on have valid entries that are the ones it was computed from.
+   */
+  std::map<Node, CachedNormalForm> d_nf_cache;
+  /** The identifier given to the next entry of the above cache */
+  unsigned d_nf_cache_next_id;
+  /**
+   * If eqc has a valid entry in the above cache, set its normal form to the
+   * cached one and return true. This method should only be called on eqc
+   * after it was called (or the normal form was computed) for the classes that
+   * eqc depends on, which is ensured by the order of d_strings_eqc.
+   */
+  bool getCachedNormalForm(Node eqc);
+  /** Cache the normal form that was computed for eqc */
+  void cacheNormalForm(Node eqc);
   //map of pairs of terms that have the same normal form
   NodeIntMap d_nf_pairs;
   std::map< Node, std::vector< Node > > d_nf_pairs_data;
@@ -313,6 +351,7 @@ private:
   /////////////////////////////////////////////////////////////////////////////
  public:
   void presolve() override;
+  void notifyMemoryPressure() override;
   void shutdown() override {}
 
   /////////////////////////////////////////////////////////////////////////////
@@ -683,6 +722,12 @@ private:
     IntStat d_eq_splits;
     IntStat d_deq_splits;
     IntStat d_loop_lemmas;
+    /** number of clears of the caches of regular expression operations */
+    IntStat d_regexp_cache_clears;
+    /** maximal total size of the caches of regular expression operations */
+    IntStat d_regexp_cache_entries;
+    /** number of normal forms of equivalence classes reused from the cache */
+    IntStat d_nf_cache_hits;
     Statistics();
     ~Statistics();
   };/* class TheoryStrings::Statistics */
@@ -727,6 +772,22 @@ private:
    * effort=3, we apply context-dependent simplification based on model values.
    */
   void checkExtfEval(int effort);
+  /**
+   * Compute the values of the active extended functions terms in the current
+   * model, for use in checkExtfEval when effort=3. The terms are grouped by
+   * their kind, and the terms of each group are evaluated in a single call to
+   * the evaluator on the pattern of the group (see d_extf_eval_pattern), where
+   * each point consists of the model values of the children of a term. Terms
+   * whose kind is not supported by the evaluator, or whose children have
+   * non-constant model values, are not added to vals.
+   */
+  void getExtfModelValues(const std::vector<Node>& terms,
+                          std::map<Node, Node>& vals);
+  /**
+   * Map from kinds of extended functions to terms of the form k(x1, ..., xn)
+   * where x1, ..., xn are bound variables, used in the method above.
+   */
+  std::map<Kind, Node> d_extf_eval_pattern;
   /** check cycles
    *
    * This inference schema ensures that a containment ordering < over the
@@ -32,7 +32,7 @@ namespace theory {
 namespace strings {
 
 StringsPreprocess::StringsPreprocess(SkolemCache *sc, context::UserContext *u)
-    : d_sc(sc)
+    : d_sc(sc), d_reductions(u)
 {
   //Constants
   d_zero = NodeManager::currentNM()->mkConst(Rational(0));
@@ -45,9 +45,65 @@ StringsPreprocess::~StringsPreprocess(){
 
 }
 
-Node StringsPreprocess::simplify( Node t, std::vector< Node > &new_nodes ) {
+bool StringsPreprocess::isReducible(Kind k)
+{
+  return k == STRING_SUBSTR || k == STRING_STRIDOF || k == STRING_ITOS
+         || k == STRING_STOI || k == STRING_STRREPL || k == STRING_STRREPLALL
+         || k == STRING_TOLOWER || k == STRING_TOUPPER || k == STRING_STRCTN
+         || k == STRING_LEQ;
+}
+
+Node StringsPreprocess::simplify(Node t, std::vector<Node>& new_nodes)
+{
+  if (!isReducible(t.getKind()))
+  {
+    return reduce(t, new_nodes);
+  }
+  // reduce the rewritten form of t, so that the terms that only differ
+  // syntactically share their skolems
+  Node tr = Rewriter::rewrite(t);
+  if (tr.getKind() != t.getKind())
+  {
+    tr = t;
+  }
+  NodeReductionMap::const_iterator it = d_reductions.find(tr);
+  if (it != d_reductions.end())
+  {
+    Trace("strings-preprocess-debug")
+        << "StringsPreprocess::simplify: " << t << " -> " << (*it).second.first
+        << " (cached)" << std::endl;
+    if (!(*it).second.second.isNull())
+    {
+      new_nodes.push_back((*it).second.second);
+    }
+    return (*it).second.first;
+  }
+  size_t prev_new_nodes = new_nodes.size();
+  Node ret = reduce(tr, new_nodes);
+  if (ret == tr)
+  {
+    Assert(new_nodes.size() == prev_new_nodes);
+    return t;
+  }
+  Node lem;
+  if (new_nodes.size() == prev_new_nodes + 1)
+  {
+    lem = new_nodes.back();
+  }
+  else if (new_nodes.size() > prev_new_nodes)
+  {
+    lem = NodeManager::currentNM()->mkNode(
+        AND,
+        std::vector<Node>(new_nodes.begin() + prev_new_nodes,
+                          new_nodes.end()));
+  }
+  d_reductions[tr] = std::pair<Node, Node>(ret, lem);
+  return ret;
+}
+
+Node StringsPreprocess::reduce( Node t, std::vector< Node > &new_nodes ) {
   unsigned prev_new_nodes = new_nodes.size();
-  Trace("strings-preprocess-debug") << "StringsPreprocess::simplify: " << t << std::endl;
+  Trace("strings-preprocess-debug") << "StringsPreprocess::reduce: " << t << std::endl;
   Node retNode = t;
   NodeManager *nm = NodeManager::currentNM();
 
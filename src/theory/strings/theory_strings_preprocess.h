@@ -46,6 +46,10 @@ public:
   *   (exists k) new_nodes => t = t'
   * is valid, where k are the free skolems introduced when constructing
   * new_nodes.
+  *
+  * The reduction is computed for the rewritten form of t, and is cached in
+  * the user context, so that terms that are equal after rewriting share
+  * their skolems and return the same new_nodes.
   */
  Node simplify(Node t, std::vector<Node> &new_nodes);
  /**
@@ -72,6 +76,17 @@ private:
  Node d_empty_str;
  /** pointer to the skolem cache used by this class */
  SkolemCache *d_sc;
+ typedef context::CDHashMap<Node, std::pair<Node, Node>, NodeHashFunction>
+     NodeReductionMap;
+ /**
+  * Maps rewritten extended terms to the result of their reduction and the
+  * conjunction of the new nodes it created (null if there are none).
+  */
+ NodeReductionMap d_reductions;
+ /** Returns true if the extended terms of kind k are reduced by reduce */
+ static bool isReducible(Kind k);
+ /** Reduces t, as described in simplify, without caching */
+ Node reduce(Node t, std::vector<Node> &new_nodes);
  /**
   * Applies simplify to all top-level extended function subterms of t. New
   * assertions created in this reduction are added to new_nodes. The argument
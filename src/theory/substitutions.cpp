@@ -38,6 +38,9 @@ Node SubstitutionMap::internalSubstitute(TNode t, NodeCache& cache) {
     return t;
   }
 
+  // Only the dependencies of our own cache are tracked
+  bool track = &cache == &d_substitutionCache;
+
   // Do a topological sort of the subexpressions and substitute them
   vector<substitution_stack_element> toVisit;
   toVisit.push_back((TNode) t);
@@ -72,6 +75,10 @@ Node SubstitutionMap::internalSubstitute(TNode t, NodeCache& cache) {
       internalSubstitute(rhs, cache);
       d_substitutions[current] = cache[rhs];
       cache[current] = cache[rhs];
+      if (track)
+      {
+        addDependent(rhs, current);
+      }
       toVisit.pop_back();
       continue;
     }
@@ -82,16 +89,28 @@ Node SubstitutionMap::internalSubstitute(TNode t, NodeCache& cache) {
       NodeBuilder<> builder(current.getKind());
       if (current.getMetaKind() == kind::metakind::PARAMETERIZED) {
         builder << Node(cache[current.getOperator()]);
+        if (track)
+        {
+          addDependent(current.getOperator(), current);
+        }
       }
       for (unsigned i = 0; i < current.getNumChildren(); ++ i) {
         Assert(cache.find(current[i]) != cache.end());
         builder << Node(cache[current[i]]);
+        if (track)
+        {
+          addDependent(current[i], current);
+        }
       }
       // Mark the substitution and continue
       Node result = builder;
       if (result != current) {
         find = cache.find(result);
         if (find != cache.end()) {
+          if (track)
+          {
+            addDependent(result, current);
+          }
           result = find->second;
         }
         else {
@@ -102,6 +121,11 @@ Node SubstitutionMap::internalSubstitute(TNode t, NodeCache& cache) {
             internalSubstitute(rhs, cache);
             d_substitutions[result] = cache[rhs];
             cache[result] = cache[rhs];
+            if (track)
+            {
+              addDependent(rhs, result);
+              addDependent(result, current);
+            }
             result = cache[rhs];
           }
         }
@@ -186,10 +210,11 @@ void SubstitutionMap::addSubstitution(TNode x, TNode t, bool invalidateCache)
 
   // Also invalidate the cache if necessary
   if (invalidateCache) {
-    d_cacheInvalidated = true;
+    invalidateDependents(x);
   }
   else {
     d_substitutionCache[x] = d_substitutions[x];
+    d_cacheUntracked = true;
   }
 }
 
@@ -201,13 +226,51 @@ void SubstitutionMap::addSubstitutions(SubstitutionMap& subMap, bool invalidateC
   for (; it != it_end; ++ it) {
     Assert(d_substitutions.find((*it).first) == d_substitutions.end());
     d_substitutions[(*it).first] = (*it).second;
-    if (!invalidateCache) {
+    if (invalidateCache) {
+      invalidateDependents((*it).first);
+    }
+    else {
       d_substitutionCache[(*it).first] = d_substitutions[(*it).first];
+      d_cacheUntracked = true;
     }
   }
-  if (invalidateCache) {
+}
+
+void SubstitutionMap::addDependent(TNode dep, TNode n)
+{
+  d_dependents[dep].push_back(n);
+}
+
+void SubstitutionMap::invalidateDependents(TNode x)
+{
+  if (d_cacheInvalidated)
+  {
+    return;
+  }
+  // The dependencies of the results that contain a substituted term (rather
+  // than a variable) are not tracked, so the whole cache is cleared
+  if (d_cacheUntracked || x.getNumChildren() > 0)
+  {
     d_cacheInvalidated = true;
+    return;
+  }
+  // Remove the result of x and, transitively, the results computed from it
+  std::vector<Node> toErase;
+  toErase.push_back(x);
+  while (!toErase.empty())
+  {
+    Node n = toErase.back();
+    toErase.pop_back();
+    d_substitutionCache.erase(n);
+    std::unordered_map<Node, std::vector<Node>, NodeHashFunction>::iterator it =
+        d_dependents.find(n);
+    if (it != d_dependents.end())
+    {
+      toErase.insert(toErase.end(), it->second.begin(), it->second.end());
+      d_dependents.erase(it);
+    }
   }
+  Debug("substitution") << "-- invalidated the cache for " << x << endl;
 }
 
 static bool check(TNode node,
@@ -237,7 +300,9 @@ Node SubstitutionMap::apply(TNode t) {
   // Setup the cache
   if (d_cacheInvalidated) {
     d_substitutionCache.clear();
+    d_dependents.clear();
     d_cacheInvalidated = false;
+    d_cacheUntracked = false;
     Debug("substitution") << "-- reset the cache" << endl;
   }
 
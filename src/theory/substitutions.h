@@ -60,6 +60,20 @@ private:
   /** Cache of the already performed substitutions */
   NodeCache d_substitutionCache;
 
+  /**
+   * Maps each node in d_substitutionCache to the nodes whose cached results
+   * were computed from its result. When a variable is substituted, only the
+   * results that depend on it are removed from the cache.
+   */
+  std::unordered_map<Node, std::vector<Node>, NodeHashFunction> d_dependents;
+
+  /**
+   * Whether d_substitutionCache has entries whose dependencies are not in
+   * d_dependents, that were added by addSubstitution without invalidating the
+   * cache.
+   */
+  bool d_cacheUntracked;
+
   /** Whether or not to substitute under quantifiers */
   bool d_substituteUnderQuantifiers;
 
@@ -72,6 +86,15 @@ private:
   /** Internal method that performs substitution */
   Node internalSubstitute(TNode t, NodeCache& cache);
 
+  /** Record that the cached result of n was computed from that of dep */
+  void addDependent(TNode dep, TNode n);
+
+  /**
+   * Invalidate the cached results that depend on x, for a new substitution
+   * of x.
+   */
+  void invalidateDependents(TNode x);
+
   /** Helper class to invalidate cache on user pop */
   class CacheInvalidator : public context::ContextNotifyObj {
     bool& d_cacheInvalidated;
@@ -97,6 +120,8 @@ public:
   SubstitutionMap(context::Context* context, bool substituteUnderQuantifiers = true, bool solvedForm = false) :
     d_substitutions(context),
     d_substitutionCache(),
+    d_dependents(),
+    d_cacheUntracked(false),
     d_substituteUnderQuantifiers(substituteUnderQuantifiers),
     d_cacheInvalidated(false),
     d_solvedForm(solvedForm),
@@ -166,6 +191,8 @@ public:
     return d_substitutions.empty();
   }
 
+  size_t size() const { return d_substitutions.size(); }
+
   // NOTE [MGD]: removed clear() and swap() from the interface
   // when this data structure became context-dependent
   // because they weren't used---and it's not clear how they
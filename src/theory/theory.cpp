@@ -66,7 +66,6 @@ Theory::Theory(TheoryId id,
       d_userContext(userContext),
       d_logicInfo(logicInfo),
       d_facts(satContext),
-      d_factsHead(satContext, 0),
       d_sharedTermsIndex(satContext, 0),
       d_careGraph(NULL),
       d_quantEngine(NULL),
@@ -28,6 +28,7 @@
 #include "context/cdhashset.h"
 #include "context/cdlist.h"
 #include "context/cdo.h"
+#include "context/cdtrail_queue.h"
 #include "context/context.h"
 #include "expr/node.h"
 #include "lib/ffs.h"
@@ -110,11 +111,11 @@ private:
    *
    * These can not be TNodes as some atoms (such as equalities) are sent
    * across theories without being stored in a global map.
+   *
+   * The queue keeps all the facts of the current context, and the index of
+   * its head is saved together with its size.
    */
-  context::CDList<Assertion> d_facts;
-
-  /** Index into the head of the facts list */
-  context::CDO<unsigned> d_factsHead;
+  context::CDTrailQueue<Assertion> d_facts;
 
   /** Add shared term to the theory. */
   void addSharedTermInternal(TNode node);
@@ -310,7 +311,7 @@ public:
   }
 
   /** Returns true if the assertFact queue is empty*/
-  bool done() const { return d_factsHead == d_facts.size(); }
+  bool done() const { return d_facts.empty(); }
   /**
    * Destructs a Theory.
    */
@@ -452,7 +453,7 @@ public:
     Trace("theory") << "Theory<" << getId() << ">::assertFact["
                     << d_satContext->getLevel() << "](" << assertion << ", "
                     << (isPreregistered ? "true" : "false") << ")" << std::endl;
-    d_facts.push_back(Assertion(assertion, isPreregistered));
+    d_facts.enqueue(Assertion(assertion, isPreregistered));
   }
 
   /**
@@ -604,6 +605,14 @@ public:
    */
   virtual void notifyRestart() { }
 
+  /**
+   * Notification sent to the theory at a restart when the memory of the
+   * process is under pressure (see ResourceManager::setMemoryLimit). The
+   * theory should clear the caches that it can rebuild. As for
+   * notifyRestart(), this function should not use the output channel.
+   */
+  virtual void notifyMemoryPressure() {}
+
   /**
    * Identify this theory (for debugging, dynamic configuration,
    * etc..)
@@ -724,7 +733,7 @@ public:
    * @return true iff facts have been asserted to this theory.
    */
   bool hasFacts() { 
-    return !d_facts.empty(); 
+    return d_facts.size() > 0;
   }
 
   /** Return total number of facts asserted to this theory */
@@ -861,10 +870,12 @@ inline theory::Assertion Theory::get() {
   Assert(!done()) << "Theory::get() called with assertion queue empty!";
 
   // Get the assertion
-  Assertion fact = d_facts[d_factsHead];
-  d_factsHead = d_factsHead + 1;
+  Assertion fact = d_facts.front();
+  d_facts.dequeue();
 
-  Trace("theory") << "Theory::get() => " << fact << " (" << d_facts.size() - d_factsHead << " left)" << std::endl;
+  Trace("theory") << "Theory::get() => " << fact << " ("
+                  << d_facts.size() - d_facts.frontIndex() << " left)"
+                  << std::endl;
 
   if(Dump.isOn("state")) {
     Dump("state") << AssertCommand(fact.assertion.toExpr());
@@ -16,6 +16,7 @@
 
 #include "theory/theory_engine.h"
 
+#include <chrono>
 #include <list>
 #include <vector>
 
@@ -28,7 +29,9 @@
 #include "options/bv_options.h"
 #include "options/options.h"
 #include "options/proof_options.h"
+#include "options/prop_options.h"
 #include "options/quantifiers_options.h"
+#include "options/smt_options.h"
 #include "options/theory_options.h"
 #include "preprocessing/assertion_pipeline.h"
 #include "proof/cnf_proof.h"
@@ -141,9 +144,12 @@ theory::LemmaStatus TheoryEngine::EngineOutputChannel::lemma(TNode lemma,
 
   PROOF({ registerLemmaRecipe(lemma, lemma, preprocess, d_theory); });
 
+  int64_t duplicates = d_engine->d_duplicateLemmas.getData();
   theory::LemmaStatus result =
       d_engine->lemma(lemma, rule, false, removable, preprocess,
                       sendAtoms ? d_theory : theory::THEORY_LAST);
+  d_statistics.duplicateLemmas +=
+      d_engine->d_duplicateLemmas.getData() - duplicates;
   return result;
 }
 
@@ -241,8 +247,11 @@ theory::LemmaStatus TheoryEngine::EngineOutputChannel::splitLemma(
 
   Debug("pf::explain") << "TheoryEngine::EngineOutputChannel::splitLemma( "
                        << lemma << " )" << std::endl;
+  int64_t duplicates = d_engine->d_duplicateLemmas.getData();
   theory::LemmaStatus result =
       d_engine->lemma(lemma, RULE_SPLIT, false, removable, false, d_theory);
+  d_statistics.duplicateLemmas +=
+      d_engine->d_duplicateLemmas.getData() - duplicates;
   return result;
 }
 
@@ -269,6 +278,14 @@ void TheoryEngine::EngineOutputChannel::conflict(TNode conflictNode,
 
 void TheoryEngine::finishInit() {
 
+  // The logic can be extended after the theories are added (by
+  // SmtEngine::setDefaults()), construct the theories it now enables
+  for(TheoryId theoryId = theory::THEORY_FIRST; theoryId != theory::THEORY_LAST; ++ theoryId) {
+    if (d_theoryTable[theoryId] == NULL && d_logicInfo.isTheoryEnabled(theoryId)) {
+      constructTheory(theoryId);
+    }
+  }
+
   //initialize the quantifiers engine, master equality engine, model, model builder
   if( d_logicInfo.isQuantified() ) {
     // initialize the quantifiers engine
@@ -304,6 +321,28 @@ void TheoryEngine::finishInit() {
       d_theoryTable[theoryId]->finishInit();
     }
   }
+  d_finishedInit = true;
+}
+
+Theory* TheoryEngine::constructTheory(TheoryId theoryId) const {
+  Assert(d_theoryTable[theoryId] == NULL);
+  Trace("theory") << "TheoryEngine: constructing " << theoryId << std::endl;
+  // Only adds to the table, so the engine is logically unchanged
+  TheoryEngine* engine = const_cast<TheoryEngine*>(this);
+  TheoryConstructor::addTheory(engine, theoryId);
+  Theory* theory = d_theoryTable[theoryId];
+#ifdef CVC4_PROOF
+  ProofManager::currentPM()->getTheoryProofEngine()->registerTheory(theory);
+#endif
+  if (d_quantEngine != nullptr) {
+    theory->setQuantifiersEngine(d_quantEngine);
+    theory->setMasterEqualityEngine(d_masterEqualityEngine);
+  }
+  if (d_finishedInit) {
+    theory->setDecisionManager(d_decManager.get());
+    theory->finishInit();
+  }
+  return theory;
 }
 
 void TheoryEngine::eqNotifyNewClass(TNode t){
@@ -338,18 +377,24 @@ TheoryEngine::TheoryEngine(context::Context* context,
       d_inConflict(context, false),
       d_inSatMode(false),
       d_hasShutDown(false),
+      d_finishedInit(false),
       d_incomplete(context, false),
       d_propagationMap(context),
       d_propagationMapTimestamp(context, 0),
       d_propagatedLiterals(context),
       d_propagatedLiteralsIndex(context, 0),
       d_atomRequests(context),
+      d_lemmaCache(userContext),
+      d_duplicateLemmas("TheoryEngine::duplicateLemmas", 0),
       d_tform_remover(iteRemover),
       d_combineTheoriesTime("TheoryEngine::combineTheoriesTime"),
+      d_combineTheoriesAgreed("TheoryEngine::combineTheoriesAgreed", 0),
+      d_modelsReused("TheoryEngine::modelsReused", 0),
       d_true(),
       d_false(),
       d_interrupted(false),
       d_resourceManager(NodeManager::currentResourceManager()),
+      d_memoryPressureCount(0),
       d_channels(channels),
       d_inPreregister(false),
       d_factsAsserted(context, false),
@@ -364,9 +409,22 @@ TheoryEngine::TheoryEngine(context::Context* context,
   {
     d_theoryTable[theoryId] = NULL;
     d_theoryOut[theoryId] = NULL;
+    d_ppStaticLearnTime[theoryId] = 0;
+    const char* efforts[] = {"standard", "full", "combination", "last-call"};
+    for (size_t e = 0; e < 4; ++e)
+    {
+      d_checkRegions[theoryId][e] =
+          Profiler::isEnabled()
+              ? Profiler::registerRegion(theory::getStatsPrefix(theoryId)
+                                         + "::check::" + efforts[e])
+              : Profiler::UNREGISTERED;
+    }
   }
 
   smtStatisticsRegistry()->registerStat(&d_combineTheoriesTime);
+  smtStatisticsRegistry()->registerStat(&d_combineTheoriesAgreed);
+  smtStatisticsRegistry()->registerStat(&d_modelsReused);
+  smtStatisticsRegistry()->registerStat(&d_duplicateLemmas);
   d_true = NodeManager::currentNM()->mkConst<bool>(true);
   d_false = NodeManager::currentNM()->mkConst<bool>(false);
 
@@ -399,6 +457,9 @@ TheoryEngine::~TheoryEngine() {
   delete d_masterEqualityEngine;
 
   smtStatisticsRegistry()->unregisterStat(&d_combineTheoriesTime);
+  smtStatisticsRegistry()->unregisterStat(&d_combineTheoriesAgreed);
+  smtStatisticsRegistry()->unregisterStat(&d_modelsReused);
+  smtStatisticsRegistry()->unregisterStat(&d_duplicateLemmas);
   smtStatisticsRegistry()->unregisterStat(&d_arithSubstitutionsAdded);
 }
 
@@ -543,6 +604,17 @@ void TheoryEngine::dumpAssertions(const char* tag) {
  * Check all (currently-active) theories for conflicts.
  * @param effort the effort level to use
  */
+uint32_t TheoryEngine::getCheckRegion(TheoryId theory,
+                                      Theory::Effort effort) const
+{
+  size_t e = Theory::fullEffort(effort)
+                 ? 1
+                 : effort == Theory::EFFORT_COMBINATION
+                       ? 2
+                       : effort == Theory::EFFORT_LAST_CALL ? 3 : 0;
+  return d_checkRegions[theory][e];
+}
+
 void TheoryEngine::check(Theory::Effort effort) {
   // spendResource();
 
@@ -554,6 +626,7 @@ void TheoryEngine::check(Theory::Effort effort) {
 #endif
 #define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY) \
     if (theory::TheoryTraits<THEORY>::hasCheck && d_logicInfo.isTheoryEnabled(THEORY)) { \
+       ProfileScope checkScope(getCheckRegion(THEORY, effort)); \
        theoryOf(THEORY)->check(effort); \
        if (d_inConflict) { \
          Debug("conflict") << THEORY << " in conflict. " << std::endl; \
@@ -630,7 +703,7 @@ void TheoryEngine::check(Theory::Effort effort) {
         printAssertions("theory::assertions-model");
       }
       //checks for theories requiring the model go at last call
-      d_curr_model->reset();
+      resetModel();
       for (TheoryId theoryId = THEORY_FIRST; theoryId < THEORY_LAST; ++theoryId) {
         if( theoryId!=THEORY_QUANTIFIERS ){
           Theory* theory = d_theoryTable[theoryId];
@@ -734,6 +807,16 @@ void TheoryEngine::combineTheories() {
     Assert(d_sharedTerms.isShared(carePair.a) || carePair.a.isConst());
     Assert(d_sharedTerms.isShared(carePair.b) || carePair.b.isConst());
 
+    // With model-based theory combination, we only split if the models
+    // disagree on the equality
+    if (options::tcModelBased() && modelsAgreeOn(carePair.a, carePair.b))
+    {
+      Debug("combineTheories") << "TheoryEngine::combineTheories(): models agree"
+                               << endl;
+      ++d_combineTheoriesAgreed;
+      continue;
+    }
+
     // The equality in question (order for no repetition)
     Node equality = carePair.a.eqNode(carePair.b);
     // EqualityStatus es = getEqualityStatus(carePair.a, carePair.b);
@@ -767,6 +850,46 @@ void TheoryEngine::combineTheories() {
   }
 }
 
+bool TheoryEngine::modelsAgreeOn(TNode a, TNode b)
+{
+  // the theories that have both terms, constants are known to all of them
+  Theory::Set theories = Theory::AllTheories;
+  if (!a.isConst())
+  {
+    theories &= d_sharedTerms.getNotifiedTheories(a);
+  }
+  if (!b.isConst())
+  {
+    theories &= d_sharedTerms.getNotifiedTheories(b);
+  }
+  bool agreeTrue = true;
+  bool agreeFalse = true;
+  TheoryId theoryId;
+  while ((theoryId = Theory::setPop(theories)) != THEORY_LAST)
+  {
+    if (!d_logicInfo.isTheoryEnabled(theoryId))
+    {
+      continue;
+    }
+    switch (theoryOf(theoryId)->getEqualityStatus(a, b))
+    {
+      case EQUALITY_TRUE_AND_PROPAGATED:
+      case EQUALITY_TRUE:
+      case EQUALITY_TRUE_IN_MODEL: agreeFalse = false; break;
+      case EQUALITY_FALSE_AND_PROPAGATED:
+      case EQUALITY_FALSE:
+      case EQUALITY_FALSE_IN_MODEL: agreeTrue = false; break;
+      default: return false;
+    }
+    if (!agreeTrue && !agreeFalse)
+    {
+      return false;
+    }
+  }
+  // at least one theory must have answered
+  return !agreeTrue || !agreeFalse;
+}
+
 void TheoryEngine::propagate(Theory::Effort effort) {
   // Reset the interrupt flag
   d_interrupted = false;
@@ -924,6 +1047,44 @@ void TheoryEngine::postProcessModel( theory::TheoryModel* m ){
   }
 }
 
+void TheoryEngine::resetModel()
+{
+  if (!options::modelReuse() || d_logicInfo.isQuantified()
+      || d_logicInfo.isTheoryEnabled(THEORY_SEP))
+  {
+    d_curr_model->reset();
+    return;
+  }
+  std::vector<Node> facts;
+  for (TheoryId theoryId = THEORY_FIRST; theoryId < THEORY_LAST; ++theoryId)
+  {
+    Theory* theory = d_theoryTable[theoryId];
+    if (theory && d_logicInfo.isTheoryEnabled(theoryId))
+    {
+      for (context::CDList<Assertion>::const_iterator
+               it = theory->facts_begin(),
+               it_end = theory->facts_end();
+           it != it_end;
+           ++it)
+      {
+        facts.push_back((*it).assertion);
+      }
+    }
+  }
+  std::sort(facts.begin(), facts.end());
+  if (d_curr_model->isBuiltSuccess() && !d_curr_model->hasApproximations()
+      && facts == d_modelFacts)
+  {
+    Trace("model-builder") << "TheoryEngine: reuse the model of the previous "
+                              "check"
+                           << std::endl;
+    ++d_modelsReused;
+    return;
+  }
+  d_modelFacts.swap(facts);
+  d_curr_model->reset();
+}
+
 TheoryModel* TheoryEngine::getModel() {
   return d_curr_model;
 }
@@ -1030,19 +1191,57 @@ void TheoryEngine::notifyRestart() {
 
   // notify each theory using the statement above
   CVC4_FOR_EACH_THEORY;
+
+  // Restarts are safe points to clear the caches, since no rewriting is in
+  // progress.
+  uint64_t pressure = d_resourceManager->getMemoryPressureCount();
+  if (pressure != d_memoryPressureCount)
+  {
+    Trace("theory::memory") << "TheoryEngine::notifyRestart: clearing caches"
+                            << std::endl;
+    d_memoryPressureCount = pressure;
+    Rewriter::clearCaches();
+    for (TheoryId theoryId = theory::THEORY_FIRST;
+         theoryId != theory::THEORY_LAST;
+         ++theoryId)
+    {
+      if (d_theoryTable[theoryId] && d_logicInfo.isTheoryEnabled(theoryId))
+      {
+        d_theoryTable[theoryId]->notifyMemoryPressure();
+      }
+    }
+  }
 }
 
 void TheoryEngine::ppStaticLearn(TNode in, NodeBuilder<>& learned) {
   // Reset the interrupt flag
   d_interrupted = false;
 
-  // Definition of the statement that is to be run by every theory
+  uint64_t limit = options::staticLearningTimeLimit() * 1000;
+  // Definition of the statement that is to be run by every theory. The
+  // static learning of a theory that is not enabled is skipped, except for
+  // UF, which learns about equalities of any sort. A theory that has used up
+  // its time limit is skipped for the remaining assertions.
 #ifdef CVC4_FOR_EACH_THEORY_STATEMENT
 #undef CVC4_FOR_EACH_THEORY_STATEMENT
 #endif
-#define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY) \
-  if (theory::TheoryTraits<THEORY>::hasPpStaticLearn) { \
-    theoryOf(THEORY)->ppStaticLearn(in, learned); \
+#define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY)                                 \
+  if (theory::TheoryTraits<THEORY>::hasPpStaticLearn                           \
+      && (THEORY == THEORY_UF || d_logicInfo.isTheoryEnabled(THEORY))          \
+      && (limit == 0 || d_ppStaticLearnTime[THEORY] < limit))                  \
+  {                                                                            \
+    auto start = std::chrono::steady_clock::now();                             \
+    theoryOf(THEORY)->ppStaticLearn(in, learned);                              \
+    d_ppStaticLearnTime[THEORY] +=                                             \
+        std::chrono::duration_cast<std::chrono::microseconds>(                 \
+            std::chrono::steady_clock::now() - start)                          \
+            .count();                                                          \
+    if (limit > 0 && d_ppStaticLearnTime[THEORY] >= limit)                     \
+    {                                                                          \
+      Trace("static-learning")                                                 \
+          << "...static learning of " << THEORY << " exceeded its time limit"  \
+          << endl;                                                             \
+    }                                                                          \
   }
 
   // static learning for each theory using the statement above
@@ -1861,9 +2060,16 @@ theory::LemmaStatus TheoryEngine::lemma(TNode node,
                      << QueryCommand(n.toExpr());
   }
 
-  // Share with other portfolio threads
-  if(d_channels->getLemmaOutputChannel() != NULL) {
-    d_channels->getLemmaOutputChannel()->notifyNewLemma(node.toExpr());
+  // Share with other portfolio threads, the receiving threads only import
+  // clauses, so we only export short disjunctions
+  if (d_channels->getLemmaOutputChannel() != NULL)
+  {
+    Node n = negated ? node.negate() : Node(node);
+    if (n.getKind() == kind::OR
+        && n.getNumChildren() <= options::shareLemmaLength())
+    {
+      d_channels->getLemmaOutputChannel()->notifyNewLemma(n.toExpr());
+    }
   }
 
   AssertionPipeline additionalLemmas;
@@ -1892,6 +2098,22 @@ theory::LemmaStatus TheoryEngine::lemma(TNode node,
     Debug("lemma-ites") << endl;
   }
 
+  // Skip the lemmas whose clauses the SAT solver already has. Removable
+  // lemmas are not cached, since their clauses may have been deleted.
+  if (!removable && options::lemmaCache() && !options::proof())
+  {
+    Node key = negated ? additionalLemmas[0].notNode() : additionalLemmas[0];
+    if (d_lemmaCache.find(key) != d_lemmaCache.end())
+    {
+      Debug("theory::lemma") << "TheoryEngine::lemma: duplicate " << key
+                             << std::endl;
+      ++d_duplicateLemmas;
+      d_lemmasAdded = true;
+      return theory::LemmaStatus(key, d_userContext->getLevel());
+    }
+    d_lemmaCache.insert(key);
+  }
+
   // assert to prop engine
   d_propEngine->assertLemma(additionalLemmas[0], negated, removable, rule, node);
   for (unsigned i = 1; i < additionalLemmas.size(); ++ i) {
@@ -1959,6 +2181,7 @@ void TheoryEngine::conflict(TNode conflict, TheoryId theoryId) {
     Node fullConflict = mkExplanation(explanationVector);
     Debug("theory::conflict") << "TheoryEngine::conflict(" << conflict << ", " << theoryId << "): full = " << fullConflict << endl;
     Assert(properConflict(fullConflict));
+    fullConflict = d_conflictMinimizer.minimize(fullConflict);
     lemma(fullConflict, RULE_CONFLICT, true, true, false, THEORY_LAST);
 
   } else {
@@ -1989,7 +2212,12 @@ void TheoryEngine::conflict(TNode conflict, TheoryId theoryId) {
         ProofManager::getCnfProof()->setProofRecipe(proofRecipe);
       });
 
-    lemma(conflict, RULE_CONFLICT, true, true, false, THEORY_LAST);
+    lemma(d_conflictMinimizer.minimize(conflict),
+          RULE_CONFLICT,
+          true,
+          true,
+          false,
+          THEORY_LAST);
   }
 
   PROOF({
@@ -2008,10 +2236,6 @@ void TheoryEngine::staticInitializeBVOptions(
       throw ModalException(
           "Slicer currently only supports pure QF_BV formulas. Use "
           "--bv-eq-slicer=off");
-    if (options::incrementalSolving())
-      throw ModalException(
-          "Slicer does not currently support incremental mode. Use "
-          "--bv-eq-slicer=off");
     if (options::produceModels())
       throw ModalException(
           "Slicer does not currently support model generation. Use "
@@ -2313,9 +2537,9 @@ std::pair<bool, Node> TheoryEngine::entailmentCheck(
   }
 }
 
-void TheoryEngine::spendResource(unsigned amount)
+void TheoryEngine::spendResource(ResourceManager::Resource r, unsigned amount)
 {
-  d_resourceManager->spendResource(amount);
+  d_resourceManager->spendResource(r, amount);
 }
 
 void TheoryEngine::enableTheoryAlternative(const std::string& name){
@@ -2335,13 +2559,15 @@ TheoryEngine::Statistics::Statistics(theory::TheoryId theory):
     propagations(getStatsPrefix(theory) + "::propagations", 0),
     lemmas(getStatsPrefix(theory) + "::lemmas", 0),
     requirePhase(getStatsPrefix(theory) + "::requirePhase", 0),
-    restartDemands(getStatsPrefix(theory) + "::restartDemands", 0)
+    restartDemands(getStatsPrefix(theory) + "::restartDemands", 0),
+    duplicateLemmas(getStatsPrefix(theory) + "::duplicateLemmas", 0)
 {
   smtStatisticsRegistry()->registerStat(&conflicts);
   smtStatisticsRegistry()->registerStat(&propagations);
   smtStatisticsRegistry()->registerStat(&lemmas);
   smtStatisticsRegistry()->registerStat(&requirePhase);
   smtStatisticsRegistry()->registerStat(&restartDemands);
+  smtStatisticsRegistry()->registerStat(&duplicateLemmas);
 }
 
 TheoryEngine::Statistics::~Statistics() {
@@ -2350,6 +2576,7 @@ TheoryEngine::Statistics::~Statistics() {
   smtStatisticsRegistry()->unregisterStat(&lemmas);
   smtStatisticsRegistry()->unregisterStat(&requirePhase);
   smtStatisticsRegistry()->unregisterStat(&restartDemands);
+  smtStatisticsRegistry()->unregisterStat(&duplicateLemmas);
 }
 
 }/* CVC4 namespace */
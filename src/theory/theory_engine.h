@@ -36,6 +36,7 @@
 #include "smt/command.h"
 #include "smt_util/lemma_channels.h"
 #include "theory/atom_requests.h"
+#include "theory/conflict_minimizer.h"
 #include "theory/decision_manager.h"
 #include "theory/interrupted.h"
 #include "theory/rewriter.h"
@@ -252,6 +253,8 @@ class TheoryEngine {
 
    public:
     IntStat conflicts, propagations, lemmas, requirePhase, restartDemands;
+    /** Number of lemmas that were not asserted since they already were */
+    IntStat duplicateLemmas;
 
     Statistics(theory::TheoryId theory);
     ~Statistics();
@@ -281,8 +284,9 @@ class TheoryEngine {
     EngineOutputChannel(TheoryEngine* engine, theory::TheoryId theory)
         : d_engine(engine), d_statistics(theory), d_theory(theory) {}
 
-    void safePoint(uint64_t amount) override {
-      spendResource(amount);
+    void safePoint(ResourceManager::Resource r, uint64_t amount) override
+    {
+      spendResource(r, amount);
       if (d_engine->d_interrupted) {
         throw theory::Interrupted();
       }
@@ -323,8 +327,9 @@ class TheoryEngine {
       d_engine->setIncomplete(d_theory);
     }
 
-    void spendResource(unsigned amount) override {
-      d_engine->spendResource(amount);
+    void spendResource(ResourceManager::Resource r, unsigned amount) override
+    {
+      d_engine->spendResource(r, amount);
     }
 
     void handleUserAttribute(const char* attr, theory::Theory* t) override {
@@ -367,6 +372,17 @@ class TheoryEngine {
    */
   bool d_hasShutDown;
 
+  /** Was finishInit() called */
+  bool d_finishedInit;
+
+  /**
+   * Construct the theory, which is not constructed yet, and set it up like
+   * the theories constructed before finishInit(). This happens for the
+   * theories that are not enabled by the logic when they are first used (see
+   * SmtEngine::finishInit()).
+   */
+  theory::Theory* constructTheory(theory::TheoryId theoryId) const;
+
   /**
    * True if a theory has notified us of incompleteness (at this
    * context level or below).
@@ -433,6 +449,20 @@ class TheoryEngine {
   /** Atom requests from lemmas */
   AtomRequests d_atomRequests;
 
+  /**
+   * The non-removable lemmas (rewritten, and negated if asserted negated)
+   * asserted in the current user context. The SAT solver keeps their clauses
+   * until the user context is popped, hence a lemma in this set is not
+   * asserted again (see options::lemmaCache()).
+   */
+  context::CDHashSet<Node, NodeHashFunction> d_lemmaCache;
+
+  /** Number of lemmas not asserted since they were in d_lemmaCache */
+  IntStat d_duplicateLemmas;
+
+  /** Shrinks the conflicts before they are asserted (see --conflict-min) */
+  theory::ConflictMinimizer d_conflictMinimizer;
+
   /**
    * Adds a new lemma, returning its status.
    * @param node the lemma
@@ -458,12 +488,54 @@ class TheoryEngine {
   /** Time spent in theory combination */
   TimerStat d_combineTheoriesTime;
 
+  /**
+   * The profiler regions of the checks of each theory, by effort (standard,
+   * full, combination, last call).
+   */
+  uint32_t d_checkRegions[theory::THEORY_LAST][4];
+
+  /** Get the profiler region of the check of theory at effort */
+  uint32_t getCheckRegion(theory::TheoryId theory,
+                          theory::Theory::Effort effort) const;
+
+  /**
+   * Number of care pairs on which no split was sent since the models of the
+   * theories agreed on them (with --tc-model-based).
+   */
+  IntStat d_combineTheoriesAgreed;
+
+  /**
+   * The facts asserted to the theories (sorted) when the current model was
+   * last reset. With --model-reuse, a model built for these facts is kept
+   * as long as the facts are the same.
+   */
+  std::vector<Node> d_modelFacts;
+
+  /** Number of times a previously built model was reused */
+  IntStat d_modelsReused;
+
+  /**
+   * Resets the current model, unless --model-reuse is enabled and the model
+   * was successfully built for the facts that are currently asserted.
+   */
+  void resetModel();
+
   Node d_true;
   Node d_false;
 
   /** Whether we were just interrupted (or not) */
   bool d_interrupted;
+  /**
+   * The time in microseconds spent by each theory in ppStaticLearn, which is
+   * bounded by --static-learning-tlimit.
+   */
+  uint64_t d_ppStaticLearnTime[theory::THEORY_LAST];
   ResourceManager* d_resourceManager;
+  /**
+   * The memory pressure count of the resource manager when the caches were
+   * last cleared.
+   */
+  uint64_t d_memoryPressureCount;
 
   /** Container for lemma input and output channels. */
   LemmaChannels* d_channels;
@@ -481,7 +553,7 @@ public:
   void interrupt();
 
   /** "Spend" a resource during a search or preprocessing.*/
-  void spendResource(unsigned amount);
+  void spendResource(ResourceManager::Resource r, unsigned amount);
 
   /**
    * Adds a theory. Only one theory per TheoryId can be present, so if
@@ -680,6 +752,14 @@ public:
    */
   void combineTheories();
 
+  /**
+   * Do the candidate models of the theories that share both a and b agree on
+   * whether a = b? This is the case if all of them know the status of a = b
+   * in their model, and the statuses are either all true or all false. Then
+   * model-based theory combination does not need to split on a = b.
+   */
+  bool modelsAgreeOn(TNode a, TNode b);
+
   /**
    * Calls ppStaticLearn() on all theories, accumulating their
    * combined contributions in the "learned" builder.
@@ -698,7 +778,9 @@ public:
   void postsolve();
 
   /**
-   * Calls notifyRestart() on all active theories.
+   * Calls notifyRestart() on all active theories. If memory pressure was
+   * signaled since the last restart, also clears the rewriter caches and
+   * calls notifyMemoryPressure() on all active theories.
    */
   void notifyRestart();
 
@@ -788,23 +870,25 @@ public:
   theory::TheoryEngineModelBuilder* getModelBuilder() { return d_curr_model_builder; }
 
   /**
-   * Get the theory associated to a given Node.
+   * Get the theory associated to a given Node, constructing it if it was
+   * not yet.
    *
-   * @returns the theory, or NULL if the TNode is
-   * of built-in type.
+   * @returns the theory
    */
   inline theory::Theory* theoryOf(TNode node) const {
-    return d_theoryTable[theory::Theory::theoryOf(node)];
+    return theoryOf(theory::Theory::theoryOf(node));
   }
 
   /**
-   * Get the theory associated to a the given theory id.
+   * Get the theory associated to a the given theory id, constructing it if
+   * it was not yet.
    *
    * @returns the theory
    */
   inline theory::Theory* theoryOf(theory::TheoryId theoryId) const {
     Assert(theoryId < theory::THEORY_LAST);
-    return d_theoryTable[theoryId];
+    theory::Theory* theory = d_theoryTable[theoryId];
+    return theory != NULL ? theory : constructTheory(theoryId);
   }
 
   inline bool isTheoryEnabled(theory::TheoryId theoryId) const {
@@ -1149,7 +1149,7 @@ void TheoryEngineModelBuilder::debugCheckModel(TheoryModel* tm)
     for (; !eqc_i.isFinished(); ++eqc_i)
     {
       Node n = *eqc_i;
-      static int repCheckInstance = 0;
+      static thread_local int repCheckInstance = 0;
       ++repCheckInstance;
 
       // non-linear mult is not necessarily accurate wrt getValue
@@ -1185,7 +1185,11 @@ Node TheoryEngineModelBuilder::normalize(TheoryModel* m, TNode r, bool evalOnly)
   }
   Trace("model-builder-debug") << "do normalize on " << r << std::endl;
   Node retNode = r;
-  if (r.getNumChildren() > 0)
+  if (r.getKind() == kind::STORE && !r.isConst())
+  {
+    retNode = normalizeStores(m, r, evalOnly);
+  }
+  else if (r.getNumChildren() > 0)
   {
     std::vector<Node> children;
     if (r.getMetaKind() == kind::metakind::PARAMETERIZED)
@@ -1195,32 +1199,10 @@ Node TheoryEngineModelBuilder::normalize(TheoryModel* m, TNode r, bool evalOnly)
     bool childrenConst = true;
     for (size_t i = 0; i < r.getNumChildren(); ++i)
     {
-      Node ri = r[i];
-      bool recurse = true;
+      Node ri = normalizeChild(m, r[i], evalOnly);
       if (!ri.isConst())
       {
-        if (m->d_equalityEngine->hasTerm(ri))
-        {
-          itMap =
-              d_constantReps.find(m->d_equalityEngine->getRepresentative(ri));
-          if (itMap != d_constantReps.end())
-          {
-            ri = (*itMap).second;
-            recurse = false;
-          }
-          else if (!evalOnly)
-          {
-            recurse = false;
-          }
-        }
-        if (recurse)
-        {
-          ri = normalize(m, ri, evalOnly);
-        }
-        if (!ri.isConst())
-        {
-          childrenConst = false;
-        }
+        childrenConst = false;
       }
       children.push_back(ri);
     }
@@ -1236,6 +1218,80 @@ Node TheoryEngineModelBuilder::normalize(TheoryModel* m, TNode r, bool evalOnly)
   return retNode;
 }
 
+Node TheoryEngineModelBuilder::normalizeChild(TheoryModel* m,
+                                              TNode ri,
+                                              bool evalOnly)
+{
+  if (ri.isConst())
+  {
+    return ri;
+  }
+  if (m->d_equalityEngine->hasTerm(ri))
+  {
+    std::map<Node, Node>::iterator itMap =
+        d_constantReps.find(m->d_equalityEngine->getRepresentative(ri));
+    if (itMap != d_constantReps.end())
+    {
+      return (*itMap).second;
+    }
+    else if (!evalOnly)
+    {
+      return ri;
+    }
+  }
+  return normalize(m, ri, evalOnly);
+}
+
+Node TheoryEngineModelBuilder::normalizeStores(TheoryModel* m,
+                                               TNode r,
+                                               bool evalOnly)
+{
+  // Collect the writes of the chain of stores r, down to the first array that
+  // is not a store built for the model (typically a STORE_ALL). Only the
+  // outermost write to an index matters.
+  std::map<Node, Node> writes;
+  std::vector<Node> indices;
+  std::vector<Node> values;
+  bool childrenConst = true;
+  TNode base = r;
+  do
+  {
+    Node index = normalizeChild(m, base[1], evalOnly);
+    Node value = normalizeChild(m, base[2], evalOnly);
+    childrenConst = childrenConst && index.isConst() && value.isConst();
+    indices.push_back(index);
+    values.push_back(value);
+    writes.insert(std::pair<Node, Node>(index, value));
+    base = base[0];
+  } while (base.getKind() == kind::STORE && !base.isConst()
+           && !m->d_equalityEngine->hasTerm(base));
+  Node ret = normalizeChild(m, base, evalOnly);
+  NodeManager* nm = NodeManager::currentNM();
+  if (!childrenConst || !ret.isConst())
+  {
+    // as in normalize, rewrite the stores whose children are constant
+    for (size_t i = indices.size(); i > 0; --i)
+    {
+      bool rewrite = ret.isConst() && indices[i - 1].isConst()
+                     && values[i - 1].isConst();
+      ret = nm->mkNode(kind::STORE, ret, indices[i - 1], values[i - 1]);
+      if (rewrite)
+      {
+        ret = Rewriter::rewrite(ret);
+      }
+    }
+    return ret;
+  }
+  // Adding the writes by increasing index extends the normal form of the
+  // constant array at its top, instead of inserting each write into it
+  for (const std::pair<const Node, Node>& w : writes)
+  {
+    ret = Rewriter::rewrite(nm->mkNode(kind::STORE, ret, w.first, w.second));
+  }
+  Assert(ret.isConst());
+  return ret;
+}
+
 bool TheoryEngineModelBuilder::preProcessBuildModel(TheoryModel* m)
 {
   return true;
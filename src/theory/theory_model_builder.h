@@ -142,6 +142,22 @@ class TheoryEngineModelBuilder : public ModelBuilder
    * each child is constant.
    */
   Node normalize(TheoryModel* m, TNode r, bool evalOnly);
+  /** normalize child
+   *
+   * Returns the normalized form of the child ri of a term being normalized,
+   * which is the constant representative of its equivalence class if it has
+   * one, and ri itself if it is in m's equality engine and evalOnly is false.
+   */
+  Node normalizeChild(TheoryModel* m, TNode ri, bool evalOnly);
+  /** normalize stores
+   *
+   * Normalizes the array r of kind STORE. The stores that the array theory
+   * builds for array models may nest thousands of writes; their normal form
+   * is built by adding the writes in increasing order of indices, which takes
+   * linear time instead of quadratic time when inserting each write into the
+   * normal form of the stores below it.
+   */
+  Node normalizeStores(TheoryModel* m, TNode r, bool evalOnly);
   /** assign constant representative
    *
    * Called when equivalence class eqc is assigned a constant
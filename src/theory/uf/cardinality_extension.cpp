@@ -23,7 +23,6 @@
 #include "theory/theory_model.h"
 
 //#define ONE_SPLIT_REGION
-//#define COMBINE_REGIONS_SMALL_INTO_LARGE
 //#define LAZY_REL_EQC
 
 using namespace std;
@@ -307,8 +306,14 @@ bool Region::check( Theory::Effort level, int cardinality,
           //choose remaining nodes with the highest degrees
           sortInternalDegree sidObj;
           sidObj.r = this;
-          std::sort( newClique.begin(), newClique.end(), sidObj );
-          int offset = ( cardinality - d_testCliqueSize ) + 1;
+          // only the first offset members are needed
+          size_t offset = std::min(
+              static_cast<size_t>(cardinality - d_testCliqueSize + 1),
+              newClique.size());
+          std::partial_sort(newClique.begin(),
+                            newClique.begin() + offset,
+                            newClique.end(),
+                            sidObj);
           newClique.erase( newClique.begin() + offset, newClique.end() );
         }else{
           //scan for the highest degree
@@ -953,11 +958,12 @@ int SortModel::forceCombineRegion( int ri, bool useDensity ){
 
 
 int SortModel::combineRegions( int ai, int bi ){
-#ifdef COMBINE_REGIONS_SMALL_INTO_LARGE
+  // Combine the smaller region into the larger one, so that each node moves
+  // to a new region at most logarithmically many times.
   if( d_regions[ai]->getNumReps()<d_regions[bi]->getNumReps() ){
     return combineRegions( bi, ai );
   }
-#endif
+  ++(d_thss->d_statistics.d_region_combines);
   Debug("uf-ss-region") << "uf-ss: Combine Region #" << bi << " with Region #" << ai << std::endl;
   Assert(isValid(ai) && isValid(bi));
   Region* region_bi = d_regions[bi];
@@ -1591,6 +1597,8 @@ void CardinalityExtension::check(Theory::Effort level)
         }
       }
       for( std::map< TypeNode, SortModel* >::iterator it = d_rep_model.begin(); it != d_rep_model.end(); ++it ){
+        TimerStat::CodeTimer checkTimer(
+            *d_statistics.getCheckTime(it->first));
         it->second->check( level, d_out );
         if( it->second->isConflict() ){
           d_conflict = true;
@@ -1870,7 +1878,8 @@ CardinalityExtension::Statistics::Statistics()
       d_split_lemmas("CardinalityExtension::Split_Lemmas", 0),
       d_disamb_term_lemmas("CardinalityExtension::Disambiguate_Term_Lemmas", 0),
       d_totality_lemmas("CardinalityExtension::Totality_Lemmas", 0),
-      d_max_model_size("CardinalityExtension::Max_Model_Size", 1)
+      d_max_model_size("CardinalityExtension::Max_Model_Size", 1),
+      d_region_combines("CardinalityExtension::Region_Combines", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_clique_conflicts);
   smtStatisticsRegistry()->registerStat(&d_clique_lemmas);
@@ -1878,6 +1887,7 @@ CardinalityExtension::Statistics::Statistics()
   smtStatisticsRegistry()->registerStat(&d_disamb_term_lemmas);
   smtStatisticsRegistry()->registerStat(&d_totality_lemmas);
   smtStatisticsRegistry()->registerStat(&d_max_model_size);
+  smtStatisticsRegistry()->registerStat(&d_region_combines);
 }
 
 CardinalityExtension::Statistics::~Statistics()
@@ -1888,6 +1898,27 @@ CardinalityExtension::Statistics::~Statistics()
   smtStatisticsRegistry()->unregisterStat(&d_disamb_term_lemmas);
   smtStatisticsRegistry()->unregisterStat(&d_totality_lemmas);
   smtStatisticsRegistry()->unregisterStat(&d_max_model_size);
+  smtStatisticsRegistry()->unregisterStat(&d_region_combines);
+  for (std::pair<const TypeNode, TimerStat*>& t : d_check_time)
+  {
+    smtStatisticsRegistry()->unregisterStat(t.second);
+    delete t.second;
+  }
+}
+
+TimerStat* CardinalityExtension::Statistics::getCheckTime(TypeNode tn)
+{
+  std::map<TypeNode, TimerStat*>::iterator it = d_check_time.find(tn);
+  if (it != d_check_time.end())
+  {
+    return it->second;
+  }
+  std::stringstream ss;
+  ss << "CardinalityExtension::Check_Time::" << tn;
+  TimerStat* t = new TimerStat(ss.str());
+  smtStatisticsRegistry()->registerStat(t);
+  d_check_time[tn] = t;
+  return t;
 }
 
 }/* CVC4::theory namespace::uf */
@@ -417,8 +417,16 @@ class CardinalityExtension
     IntStat d_disamb_term_lemmas;
     IntStat d_totality_lemmas;
     IntStat d_max_model_size;
+    /** number of combinations of regions */
+    IntStat d_region_combines;
     Statistics();
     ~Statistics();
+    /** get the timer for the checks of the sort model of tn */
+    TimerStat* getCheckTime(TypeNode tn);
+
+   private:
+    /** the time spent in the checks of the sort model for each type */
+    std::map<TypeNode, TimerStat*> d_check_time;
   };
   /** statistics class */
   Statistics d_statistics;
@@ -17,6 +17,7 @@
 
 #include "theory/uf/equality_engine.h"
 
+#include "options/uf_options.h"
 #include "smt/smt_statistics_registry.h"
 
 namespace CVC4 {
@@ -27,12 +28,16 @@ EqualityEngine::Statistics::Statistics(std::string name)
     : mergesCount(name + "::mergesCount", 0),
       termsCount(name + "::termsCount", 0),
       functionTermsCount(name + "::functionTermsCount", 0),
-      constantTermsCount(name + "::constantTermsCount", 0)
+      constantTermsCount(name + "::constantTermsCount", 0),
+      explanationsCached(name + "::explanationsCached", 0),
+      explanationCacheHits(name + "::explanationCacheHits", 0)
 {
   smtStatisticsRegistry()->registerStat(&mergesCount);
   smtStatisticsRegistry()->registerStat(&termsCount);
   smtStatisticsRegistry()->registerStat(&functionTermsCount);
   smtStatisticsRegistry()->registerStat(&constantTermsCount);
+  smtStatisticsRegistry()->registerStat(&explanationsCached);
+  smtStatisticsRegistry()->registerStat(&explanationCacheHits);
 }
 
 EqualityEngine::Statistics::~Statistics() {
@@ -40,6 +45,8 @@ EqualityEngine::Statistics::~Statistics() {
   smtStatisticsRegistry()->unregisterStat(&termsCount);
   smtStatisticsRegistry()->unregisterStat(&functionTermsCount);
   smtStatisticsRegistry()->unregisterStat(&constantTermsCount);
+  smtStatisticsRegistry()->unregisterStat(&explanationsCached);
+  smtStatisticsRegistry()->unregisterStat(&explanationCacheHits);
 }
 
 /**
@@ -122,6 +129,8 @@ EqualityEngine::EqualityEngine(context::Context* context, std::string name, bool
 , d_deducedDisequalitiesSize(context, 0)
 , d_deducedDisequalityReasonsSize(context, 0)
 , d_propagatedDisequalities(context)
+, d_explainedEqualities(context)
+, d_explainedDisequalities(context)
 , d_name(name)
 {
   init();
@@ -147,6 +156,8 @@ EqualityEngine::EqualityEngine(EqualityEngineNotify& notify, context::Context* c
 , d_deducedDisequalitiesSize(context, 0)
 , d_deducedDisequalityReasonsSize(context, 0)
 , d_propagatedDisequalities(context)
+, d_explainedEqualities(context)
+, d_explainedDisequalities(context)
 , d_name(name)
 {
   init();
@@ -175,8 +186,8 @@ EqualityNodeId EqualityEngine::newApplicationNode(TNode original, EqualityNodeId
   EqualityNodeId funId = newNode(original);
   FunctionApplication funOriginal(type, t1, t2);
   // The function application we're creating
-  EqualityNodeId t1ClassId = getEqualityNode(t1).getFind();
-  EqualityNodeId t2ClassId = getEqualityNode(t2).getFind();
+  EqualityNodeId t1ClassId = getFind(t1);
+  EqualityNodeId t2ClassId = getFind(t2);
   FunctionApplication funNormalized(type, t1ClassId, t2ClassId);
 
   // We add the original version
@@ -236,6 +247,7 @@ EqualityNodeId EqualityEngine::newNode(TNode node) {
   d_isInternal.push_back(true);
   // Add the equality node to the nodes
   d_equalityNodes.push_back(EqualityNode(newId));
+  d_findIds.push_back(newId);
 
   // Increase the counters
   d_nodesCount = d_nodesCount + 1;
@@ -461,8 +473,8 @@ void EqualityEngine::assertEquality(TNode eq, bool polarity, TNode reason, unsig
     // If both have constant representatives, we don't notify anyone
     EqualityNodeId a = getNodeId(eq[0]);
     EqualityNodeId b = getNodeId(eq[1]);
-    EqualityNodeId aClassId = getEqualityNode(a).getFind();
-    EqualityNodeId bClassId = getEqualityNode(b).getFind();
+    EqualityNodeId aClassId = getFind(a);
+    EqualityNodeId bClassId = getFind(b);
     if (d_isConstant[aClassId] && d_isConstant[bClassId]) {
       return;
     }
@@ -521,32 +533,30 @@ void EqualityEngine::assertEquality(TNode eq, bool polarity, TNode reason, unsig
 TNode EqualityEngine::getRepresentative(TNode t) const {
   Debug("equality::internal") << d_name << "::eq::getRepresentative(" << t << ")" << std::endl;
   Assert(hasTerm(t));
-  EqualityNodeId representativeId = getEqualityNode(t).getFind();
+  EqualityNodeId representativeId = getFind(t);
   Assert(!d_isInternal[representativeId]);
   Debug("equality::internal") << d_name << "::eq::getRepresentative(" << t << ") => " << d_nodes[representativeId] << std::endl;
   return d_nodes[representativeId];
 }
 
-bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vector<TriggerId>& triggersFired) {
+bool EqualityEngine::merge(EqualityNodeId class1Id, EqualityNodeId class2Id, std::vector<TriggerId>& triggersFired) {
 
-  Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << ")" << std::endl;
+  Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << ")" << std::endl;
 
   Assert(triggersFired.empty());
 
   ++ d_stats.mergesCount;
 
-  EqualityNodeId class1Id = class1.getFind();
-  EqualityNodeId class2Id = class2.getFind();
+  Assert(getFind(class1Id) == class1Id);
+  Assert(getFind(class2Id) == class2Id);
 
   Node n1 = d_nodes[class1Id];
   Node n2 = d_nodes[class2Id];
-  EqualityNode cc1 = getEqualityNode(n1);
-  EqualityNode cc2 = getEqualityNode(n2);
   bool doNotify = false;
   // notify the theory
   // the second part of this check is needed due to the internal implementation of this class.
   // It ensures that we are merging terms and not operators.
-  if (d_performNotify && class1Id==cc1.getFind() && class2Id==cc2.getFind()) {
+  if (d_performNotify && class1Id == getFind(n1) && class2Id == getFind(n2)) {
     doNotify = true;
   }
   if (doNotify) {
@@ -583,15 +593,15 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   }
 
   // Update class2 representative information
-  Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): updating class " << class2Id << std::endl;
+  Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): updating class " << class2Id << std::endl;
   EqualityNodeId currentId = class2Id;
   do {
     // Get the current node
     EqualityNode& currentNode = getEqualityNode(currentId);
 
     // Update it's find to class1 id
-    Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): " << currentId << "->" << class1Id << std::endl;
-    currentNode.setFind(class1Id);
+    Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): " << currentId << "->" << class1Id << std::endl;
+    d_findIds[currentId] = class1Id;
 
     // Go through the triggers and inform if necessary
     TriggerId currentTrigger = d_nodeTriggers[currentId];
@@ -621,11 +631,11 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   // Update class2 table lookup and information if not a boolean
   // since booleans can't be in an application
   if (!d_isEquality[class2Id]) {
-    Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): updating lookups of " << class2Id << std::endl;
+    Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): updating lookups of " << class2Id << std::endl;
     do {
       // Get the current node
       EqualityNode& currentNode = getEqualityNode(currentId);
-      Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): updating lookups of node " << currentId << std::endl;
+      Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): updating lookups of node " << currentId << std::endl;
 
       // Go through the uselist and check for congruences
       UseListNodeId currentUseId = currentNode.getUseList();
@@ -634,7 +644,7 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
         UseListNode& useNode = d_useListNodes[currentUseId];
         // Get the function application
         EqualityNodeId funId = useNode.getApplicationId();
-        Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): " << d_nodes[currentId] << " in " << d_nodes[funId] << std::endl;
+        Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): " << d_nodes[currentId] << " in " << d_nodes[funId] << std::endl;
         const FunctionApplication& fun = d_applications[useNode.getApplicationId()].normalized;
         // If it's interpreted and we can interpret
   if (fun.isInterpreted() && class1isConstant && !d_isInternal[currentId]) {
@@ -643,13 +653,13 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
     subtermEvaluates(getNodeId(term));
   }
   // Check if there is an application with find arguments
-        EqualityNodeId aNormalized = getEqualityNode(fun.a).getFind();
-        EqualityNodeId bNormalized = getEqualityNode(fun.b).getFind();
+        EqualityNodeId aNormalized = getFind(fun.a);
+        EqualityNodeId bNormalized = getFind(fun.b);
         FunctionApplication funNormalized(fun.type, aNormalized, bNormalized);
         ApplicationIdsMap::iterator find = d_applicationLookup.find(funNormalized);
         if (find != d_applicationLookup.end()) {
           // Applications fun and the funNormalized can be merged due to congruence
-          if (getEqualityNode(funId).getFind() != getEqualityNode(find->second).getFind()) {
+          if (getFind(funId) != getFind(find->second)) {
             enqueue(MergeCandidate(funId, find->second, MERGED_THROUGH_CONGRUENCE, TNode::null()));
           }
         } else {
@@ -667,7 +677,7 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   }
 
   // Now merge the lists
-  class1.merge<true>(class2);
+  getEqualityNode(class1Id).merge<true>(getEqualityNode(class2Id));
 
   // notify the theory
   if (doNotify) {
@@ -750,22 +760,22 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   return true;
 }
 
-void EqualityEngine::undoMerge(EqualityNode& class1, EqualityNode& class2, EqualityNodeId class2Id) {
+void EqualityEngine::undoMerge(EqualityNodeId class1Id, EqualityNodeId class2Id) {
 
-  Debug("equality") << d_name << "::eq::undoMerge(" << class1.getFind() << "," << class2Id << ")" << std::endl;
+  Debug("equality") << d_name << "::eq::undoMerge(" << class1Id << "," << class2Id << ")" << std::endl;
 
   // Now unmerge the lists (same as merge)
-  class1.merge<false>(class2);
+  getEqualityNode(class1Id).merge<false>(getEqualityNode(class2Id));
 
   // Update class2 representative information
   EqualityNodeId currentId = class2Id;
-  Debug("equality") << d_name << "::eq::undoMerge(" << class1.getFind() << "," << class2Id << "): undoing representative info" << std::endl;
+  Debug("equality") << d_name << "::eq::undoMerge(" << class1Id << "," << class2Id << "): undoing representative info" << std::endl;
   do {
     // Get the current node
     EqualityNode& currentNode = getEqualityNode(currentId);
 
     // Update it's find to class1 id
-    currentNode.setFind(class2Id);
+    d_findIds[currentId] = class2Id;
 
     // Go through the trigger list (if any) and undo the class
     TriggerId currentTrigger = d_nodeTriggers[currentId];
@@ -801,7 +811,7 @@ void EqualityEngine::backtrack() {
       Equality& eq = d_assertedEqualities[i];
       // Undo the merge
       if (eq.lhs != null_id) {
-        undoMerge(d_equalityNodes[eq.lhs], d_equalityNodes[eq.rhs], eq.rhs);
+        undoMerge(eq.lhs, eq.rhs);
       }
     }
 
@@ -880,6 +890,7 @@ void EqualityEngine::backtrack() {
     d_isInternal.resize(d_nodesCount);
     d_equalityGraph.resize(d_nodesCount);
     d_equalityNodes.resize(d_nodesCount);
+    d_findIds.resize(d_nodesCount);
   }
 
   if (d_deducedDisequalities.size() > d_deducedDisequalitiesSize) {
@@ -943,6 +954,14 @@ void EqualityEngine::explainEquality(TNode t1, TNode t2, bool polarity,
   EqualityNodeId t1Id = getNodeId(t1);
   EqualityNodeId t2Id = getNodeId(t2);
 
+  // Without proofs, a repeated explanation can be taken from the cache
+  bool useCache = !eqp && options::ufExplainCache();
+  if (useCache && getCachedExplanation(t1Id, t2Id, polarity, equalities))
+  {
+    return;
+  }
+  size_t start = equalities.size();
+
   std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*> cache;
   if (polarity) {
     // Get the explanation
@@ -1031,6 +1050,11 @@ void EqualityEngine::explainEquality(TNode t1, TNode t2, bool polarity,
       }
     }
   }
+
+  if (useCache)
+  {
+    cacheExplanation(t1Id, t2Id, polarity, equalities, start);
+  }
 }
 
 void EqualityEngine::explainPredicate(TNode p, bool polarity,
@@ -1040,10 +1064,56 @@ void EqualityEngine::explainPredicate(TNode p, bool polarity,
                     << std::endl;
   // Must have the term
   Assert(hasTerm(p));
+  EqualityNodeId pId = getNodeId(p);
+  EqualityNodeId valueId = polarity ? d_trueId : d_falseId;
+  // Without proofs, a repeated explanation can be taken from the cache
+  bool useCache = !eqp && options::ufExplainCache();
+  if (useCache && getCachedExplanation(pId, valueId, true, assertions))
+  {
+    return;
+  }
+  size_t start = assertions.size();
   std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*> cache;
   // Get the explanation
-  getExplanation(
-      getNodeId(p), polarity ? d_trueId : d_falseId, assertions, cache, eqp);
+  getExplanation(pId, valueId, assertions, cache, eqp);
+  if (useCache)
+  {
+    cacheExplanation(pId, valueId, true, assertions, start);
+  }
+}
+
+bool EqualityEngine::getCachedExplanation(EqualityNodeId t1Id,
+                                          EqualityNodeId t2Id,
+                                          bool polarity,
+                                          std::vector<TNode>& equalities) const
+{
+  const ExplanationCache& ec =
+      polarity ? d_explainedEqualities : d_explainedDisequalities;
+  ExplanationCache::const_iterator it = ec.find(std::minmax(t1Id, t2Id));
+  if (it == ec.end())
+  {
+    return false;
+  }
+  Trace("eq-exp") << d_name << "::eq::getCachedExplanation(" << d_nodes[t1Id]
+                  << "," << d_nodes[t2Id] << ", " << polarity
+                  << ") size = " << (*it).second.size() << std::endl;
+  ++d_stats.explanationCacheHits;
+  equalities.insert(
+      equalities.end(), (*it).second.begin(), (*it).second.end());
+  return true;
+}
+
+void EqualityEngine::cacheExplanation(EqualityNodeId t1Id,
+                                      EqualityNodeId t2Id,
+                                      bool polarity,
+                                      const std::vector<TNode>& equalities,
+                                      size_t start) const
+{
+  ExplanationCache& ec =
+      polarity ? d_explainedEqualities : d_explainedDisequalities;
+  ++d_stats.explanationsCached;
+  ec.insert(std::minmax(t1Id, t2Id),
+            std::vector<TNode>(equalities.begin() + start, equalities.end()));
 }
 
 void EqualityEngine::getExplanation(
@@ -1102,13 +1172,13 @@ void EqualityEngine::getExplanation(
 
   // We can only explain the nodes that got merged
 #ifdef CVC4_ASSERTIONS
-  bool canExplain = getEqualityNode(t1Id).getFind() == getEqualityNode(t2Id).getFind()
+  bool canExplain = getFind(t1Id) == getFind(t2Id)
                   || (d_done && isConstant(t1Id) && isConstant(t2Id));
 
   if (!canExplain) {
     Warning() << "Can't explain equality:" << std::endl;
-    Warning() << d_nodes[t1Id] << " with find " << d_nodes[getEqualityNode(t1Id).getFind()] << std::endl;
-    Warning() << d_nodes[t2Id] << " with find " << d_nodes[getEqualityNode(t2Id).getFind()] << std::endl;
+    Warning() << d_nodes[t1Id] << " with find " << d_nodes[getFind(t1Id)] << std::endl;
+    Warning() << d_nodes[t2Id] << " with find " << d_nodes[getFind(t2Id)] << std::endl;
   }
   Assert(canExplain);
 #endif
@@ -1279,7 +1349,7 @@ void EqualityEngine::getExplanation(
                 std::shared_ptr<EqProof> eqpcc =
                     eqpc ? std::make_shared<EqProof>() : nullptr;
                 getExplanation(childId,
-                               getEqualityNode(childId).getFind(),
+                               getFind(childId),
                                equalities,
                                cache,
                                eqpcc.get());
@@ -1468,13 +1538,13 @@ void EqualityEngine::addTriggerEqualityInternal(TNode t1, TNode t2, TNode trigge
 
   // Get the information about t1
   EqualityNodeId t1Id = getNodeId(t1);
-  EqualityNodeId t1classId = getEqualityNode(t1Id).getFind();
+  EqualityNodeId t1classId = getFind(t1Id);
   // We will attach it to the class representative, since then we know how to backtrack it
   TriggerId t1TriggerId = d_nodeTriggers[t1classId];
 
   // Get the information about t2
   EqualityNodeId t2Id = getNodeId(t2);
-  EqualityNodeId t2classId = getEqualityNode(t2Id).getFind();
+  EqualityNodeId t2classId = getFind(t2Id);
   // We will attach it to the class representative, since then we know how to backtrack it
   TriggerId t2TriggerId = d_nodeTriggers[t2classId];
 
@@ -1577,8 +1647,8 @@ void EqualityEngine::propagate() {
     d_propagationQueue.pop_front();
 
     // Get the representatives
-    EqualityNodeId t1classId = getEqualityNode(current.t1Id).getFind();
-    EqualityNodeId t2classId = getEqualityNode(current.t2Id).getFind();
+    EqualityNodeId t1classId = getFind(current.t1Id);
+    EqualityNodeId t2classId = getFind(current.t2Id);
 
     // If already the same, we're done
     if (t1classId == t2classId) {
@@ -1592,9 +1662,6 @@ void EqualityEngine::propagate() {
     EqualityNode& node1 = getEqualityNode(t1classId);
     EqualityNode& node2 = getEqualityNode(t2classId);
 
-    Assert(node1.getFind() == t1classId);
-    Assert(node2.getFind() == t2classId);
-
     // Add the actual equality to the equality graph
     addGraphEdge(current.t1Id, current.t2Id, current.type, current.reason);
 
@@ -1645,14 +1712,14 @@ void EqualityEngine::propagate() {
       Debug("equality") << d_name << "::eq::propagate(): merging " << d_nodes[current.t1Id]<< " into " << d_nodes[current.t2Id] << std::endl;
       d_assertedEqualities.push_back(Equality(t2classId, t1classId));
       d_assertedEqualitiesCount = d_assertedEqualitiesCount + 1;
-      if (!merge(node2, node1, triggers)) {
+      if (!merge(t2classId, t1classId, triggers)) {
         d_done = true;
       }
     } else {
       Debug("equality") << d_name << "::eq::propagate(): merging " << d_nodes[current.t2Id] << " into " << d_nodes[current.t1Id] << std::endl;
       d_assertedEqualities.push_back(Equality(t1classId, t2classId));
       d_assertedEqualitiesCount = d_assertedEqualitiesCount + 1;
-    if (!merge(node1, node2, triggers)) {
+    if (!merge(t1classId, t2classId, triggers)) {
         d_done = true;
       }
     }
@@ -1709,7 +1776,7 @@ void EqualityEngine::debugPrintGraph() const {
   Debug("equality::graph") << std::endl << "Dumping graph" << std::endl;
   for (EqualityNodeId nodeId = 0; nodeId < d_nodes.size(); ++ nodeId) {
 
-    Debug("equality::graph") << d_nodes[nodeId] << " " << nodeId << "(" << getEqualityNode(nodeId).getFind() << "):";
+    Debug("equality::graph") << d_nodes[nodeId] << " " << nodeId << "(" << getFind(nodeId) << "):";
 
     EqualityEdgeId edgeId = d_equalityGraph[nodeId];
     while (edgeId != null_edge) {
@@ -1729,7 +1796,7 @@ bool EqualityEngine::areEqual(TNode t1, TNode t2) const {
   Assert(hasTerm(t1));
   Assert(hasTerm(t2));
 
-  bool result = getEqualityNode(t1).getFind() == getEqualityNode(t2).getFind();
+  bool result = getFind(t1) == getFind(t2);
   Debug("equality") << (result ? "\t(YES)" : "\t(NO)") << std::endl;
   return result;
 }
@@ -1753,8 +1820,8 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
   }
 
   // Get equivalence classes
-  EqualityNodeId t1ClassId = getEqualityNode(t1Id).getFind();
-  EqualityNodeId t2ClassId = getEqualityNode(t2Id).getFind();
+  EqualityNodeId t1ClassId = getFind(t1Id);
+  EqualityNodeId t2ClassId = getFind(t2Id);
 
   // We are semantically const, for remembering stuff
   EqualityEngine* nonConst = const_cast<EqualityEngine*>(this);
@@ -1774,7 +1841,7 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
   FunctionApplication eqNormalized(APP_EQUALITY, t1ClassId, t2ClassId);
   ApplicationIdsMap::const_iterator find = d_applicationLookup.find(eqNormalized);
   if (find != d_applicationLookup.end()) {
-    if (getEqualityNode(find->second).getFind() == getEqualityNode(d_falseId).getFind()) {
+    if (getFind(find->second) == getFind(d_falseId)) {
       if (ensureProof) {
         const FunctionApplication original = d_applications[find->second].original;
         nonConst->d_deducedDisequalityReasons.push_back(EqualityPair(t1Id, original.a));
@@ -1791,7 +1858,7 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
   std::swap(eqNormalized.a, eqNormalized.b);
   find = d_applicationLookup.find(eqNormalized);
   if (find != d_applicationLookup.end()) {
-    if (getEqualityNode(find->second).getFind() == getEqualityNode(d_falseId).getFind()) {
+    if (getFind(find->second) == getFind(d_falseId)) {
       if (ensureProof) {
         const FunctionApplication original = d_applications[find->second].original;
         nonConst->d_deducedDisequalityReasons.push_back(EqualityPair(t2Id, original.a));
@@ -1812,7 +1879,7 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
 size_t EqualityEngine::getSize(TNode t) {
   // Add the term
   addTermInternal(t);
-  return getEqualityNode(getEqualityNode(t).getFind()).getSize();
+  return getEqualityNode(getFind(t)).getSize();
 }
 
 
@@ -1842,8 +1909,7 @@ void EqualityEngine::addTriggerTerm(TNode t, TheoryId tag)
 
   // Get the node id
   EqualityNodeId eqNodeId = getNodeId(t);
-  EqualityNode& eqNode = getEqualityNode(eqNodeId);
-  EqualityNodeId classId = eqNode.getFind();
+  EqualityNodeId classId = getFind(eqNodeId);
 
   // Possibly existing set of triggers
   TriggerTermSetRef triggerSetRef = d_nodeIndividualTrigger[classId];
@@ -1909,7 +1975,7 @@ void EqualityEngine::addTriggerTerm(TNode t, TheoryId tag)
 
 bool EqualityEngine::isTriggerTerm(TNode t, TheoryId tag) const {
   if (!hasTerm(t)) return false;
-  EqualityNodeId classId = getEqualityNode(t).getFind();
+  EqualityNodeId classId = getFind(t);
   TriggerTermSetRef triggerSetRef = d_nodeIndividualTrigger[classId];
   return triggerSetRef != +null_set_id && getTriggerTermSet(triggerSetRef).hasTrigger(tag);
 }
@@ -1917,7 +1983,7 @@ bool EqualityEngine::isTriggerTerm(TNode t, TheoryId tag) const {
 
 TNode EqualityEngine::getTriggerTermRepresentative(TNode t, TheoryId tag) const {
   Assert(isTriggerTerm(t, tag));
-  EqualityNodeId classId = getEqualityNode(t).getFind();
+  EqualityNodeId classId = getFind(t);
   const TriggerTermSet& triggerSet = getTriggerTermSet(d_nodeIndividualTrigger[classId]);
   unsigned i = 0;
   Theory::Set tags = triggerSet.tags;
@@ -1949,7 +2015,7 @@ void EqualityEngine::storeApplicationLookup(FunctionApplication& funNormalized,
 void EqualityEngine::getUseListTerms(TNode t, std::set<TNode>& output) {
   if (hasTerm(t)) {
     // Get the equivalence class
-    EqualityNodeId classId = getEqualityNode(t).getFind();
+    EqualityNodeId classId = getFind(t);
     // Go through the equivalence class and get where t is used in
     EqualityNodeId currentId = classId;
     do {
@@ -2057,8 +2123,8 @@ void EqualityEngine::storePropagatedDisequality(TheoryId tag, EqualityNodeId lhs
     // Check that the reasons are valid
     for (unsigned i = ref.mergesStart; i < ref.mergesEnd; ++ i) {
       Assert(
-          getEqualityNode(d_deducedDisequalityReasons[i].first).getFind()
-          == getEqualityNode(d_deducedDisequalityReasons[i].second).getFind());
+          getFind(d_deducedDisequalityReasons[i].first)
+          == getFind(d_deducedDisequalityReasons[i].second));
     }
 #endif
     if (Debug.isOn("equality::disequality")) {
@@ -2119,7 +2185,7 @@ void EqualityEngine::getDisequalities(bool allowConstants, EqualityNodeId classI
 
       const FunctionApplication& fun = d_applications[useListNode.getApplicationId()].original;
       // If it's an equality asserted to false, we do the work
-      if (fun.isEquality() && getEqualityNode(funId).getFind() == getEqualityNode(d_false).getFind()) {
+      if (fun.isEquality() && getFind(funId) == getFind(d_false)) {
         // Get the other equality member
         bool lhs = false;
         EqualityNodeId toCompare = fun.b;
@@ -2128,7 +2194,7 @@ void EqualityEngine::getDisequalities(bool allowConstants, EqualityNodeId classI
           lhs = true;
         }
         // Representative of the other member
-        EqualityNodeId toCompareRep = getEqualityNode(toCompare).getFind();
+        EqualityNodeId toCompareRep = getFind(toCompare);
         if (toCompareRep == classId) {
           // We're in conflict, so we will send it out from merge
           out.clear();
@@ -2186,7 +2252,7 @@ bool EqualityEngine::propagateTriggerTermDisequalities(Theory::Set tags, Trigger
     // Figure out who we are comparing to in the original equality
     EqualityNodeId toCompare = disequalityInfo.lhs ? fun.a : fun.b;
     EqualityNodeId myCompare = disequalityInfo.lhs ? fun.b : fun.a;
-    if (getEqualityNode(toCompare).getFind() == getEqualityNode(myCompare).getFind()) {
+    if (getFind(toCompare) == getFind(myCompare)) {
       // We're propagating a != a, which means we're inconsistent, just bail and let it go into
       // a regular conflict
       return !d_done;
@@ -2230,7 +2296,7 @@ EqClassesIterator::EqClassesIterator(const eq::EqualityEngine* ee)
   Assert(d_ee->consistent());
   d_it = 0;
   // Go to the first non-internal node that is it's own representative
-  if(d_it < d_ee->d_nodesCount && (d_ee->d_isInternal[d_it] || d_ee->getEqualityNode(d_it).getFind() != d_it)) {
+  if(d_it < d_ee->d_nodesCount && (d_ee->d_isInternal[d_it] || d_ee->getFind(d_it) != d_it)) {
     ++d_it;
   }
 }
@@ -2249,7 +2315,7 @@ bool EqClassesIterator::operator!=(const EqClassesIterator& i) const {
 
 EqClassesIterator& EqClassesIterator::operator++() {
   ++d_it;
-  while(d_it < d_ee->d_nodesCount && (d_ee->d_isInternal[d_it] || d_ee->getEqualityNode(d_it).getFind() != d_it)) {
+  while(d_it < d_ee->d_nodesCount && (d_ee->d_isInternal[d_it] || d_ee->getFind(d_it) != d_it)) {
     ++d_it;
   }
   return *this;
@@ -2276,7 +2342,7 @@ EqClassIterator::EqClassIterator(Node eqc, const eq::EqualityEngine* ee)
 {
   Assert(d_ee->consistent());
   d_current = d_start = d_ee->getNodeId(eqc);
-  Assert(d_start == d_ee->getEqualityNode(d_start).getFind());
+  Assert(d_start == d_ee->getFind(d_start));
   Assert(!d_ee->d_isInternal[d_start]);
 }
 
@@ -2295,7 +2361,7 @@ bool EqClassIterator::operator!=(const EqClassIterator& i) const {
 EqClassIterator& EqClassIterator::operator++() {
   Assert(!isFinished());
 
-  Assert(d_start == d_ee->getEqualityNode(d_current).getFind());
+  Assert(d_start == d_ee->getFind(d_current));
   Assert(!d_ee->d_isInternal[d_current]);
 
   // Find the next one
@@ -2303,7 +2369,7 @@ EqClassIterator& EqClassIterator::operator++() {
     d_current = d_ee->getEqualityNode(d_current).getNext();
   } while(d_ee->d_isInternal[d_current]);
 
-  Assert(d_start == d_ee->getEqualityNode(d_current).getFind());
+  Assert(d_start == d_ee->getFind(d_current));
   Assert(!d_ee->d_isInternal[d_current]);
 
   if(d_current == d_start) {
@@ -218,6 +218,10 @@ public:
     IntStat functionTermsCount;
     /** Number of constant terms managed by the system */
     IntStat constantTermsCount;
+    /** Number of explanations stored in the explanation cache */
+    IntStat explanationsCached;
+    /** Number of explanations answered by the explanation cache */
+    IntStat explanationCacheHits;
 
     Statistics(std::string name);
 
@@ -285,6 +289,13 @@ private:
   /** Map from ids to the equality nodes */
   std::vector<EqualityNode> d_equalityNodes;
 
+  /**
+   * Map from ids to the ids of their representatives. This is kept apart
+   * from d_equalityNodes since find is by far the most frequent access, and
+   * a dense array of ids keeps more of it in cache.
+   */
+  std::vector<EqualityNodeId> d_findIds;
+
   /** Number of asserted equalities we have so far */
   context::CDO<DefaultSizeType> d_assertedEqualitiesCount;
 
@@ -385,14 +396,24 @@ private:
   /** Returns the id of the node */
   EqualityNodeId getNodeId(TNode node) const;
 
+  /** Returns the id of the representative of the given node */
+  EqualityNodeId getFind(EqualityNodeId nodeId) const
+  {
+    Assert(nodeId < d_findIds.size());
+    return d_findIds[nodeId];
+  }
+
+  /** Returns the id of the representative of the given node */
+  EqualityNodeId getFind(TNode node) const { return getFind(getNodeId(node)); }
+
   /**
-   * Merge the class2 into class1
+   * Merge the class2 into class1, both given by their representatives
    * @return true if ok, false if to break out
    */
-  bool merge(EqualityNode& class1, EqualityNode& class2, std::vector<TriggerId>& triggers);
+  bool merge(EqualityNodeId class1Id, EqualityNodeId class2Id, std::vector<TriggerId>& triggers);
 
   /** Undo the merge of class2 into class1 */
-  void undoMerge(EqualityNode& class1, EqualityNode& class2, EqualityNodeId class2Id);
+  void undoMerge(EqualityNodeId class1Id, EqualityNodeId class2Id);
 
   /** Backtrack the information if necessary */
   void backtrack();
@@ -475,7 +496,7 @@ private:
    * Returns true if it's a constant
    */
   bool isConstant(EqualityNodeId id) const {
-    return d_isConstant[getEqualityNode(id).getFind()];
+    return d_isConstant[getFind(id)];
   }
 
   /**
@@ -494,8 +515,8 @@ private:
    */
   void addTriggerToList(EqualityNodeId nodeId, TriggerId triggerId);
 
-  /** Statistics */
-  Statistics d_stats;
+  /** Statistics (mutable, since explanations are counted) */
+  mutable Statistics d_stats;
 
   /** Add a new function application node to the database, i.e APP t1 t2 */
   EqualityNodeId newApplicationNode(TNode original, EqualityNodeId t1, EqualityNodeId t2, FunctionApplicationType type);
@@ -672,6 +693,42 @@ private:
   typedef context::CDHashMap<EqualityPair, Theory::Set, EqualityPairHashFunction> PropagatedDisequalitiesMap;
   PropagatedDisequalitiesMap d_propagatedDisequalities;
 
+  /**
+   * Map from the (ordered) ids of the terms of an equality to the asserted
+   * equalities that explain it. When proofs are disabled, explainEquality and
+   * explainPredicate answer a repeated request from these caches instead of
+   * searching the proof forest again. Since an explanation stays valid until
+   * one of its equalities is retracted, the entries are added in the current
+   * context and removed on backtracking. One cache is for equalities and one
+   * for disequalities.
+   */
+  typedef context::CDHashMap<EqualityPair,
+                             std::vector<TNode>,
+                             EqualityPairHashFunction>
+      ExplanationCache;
+  mutable ExplanationCache d_explainedEqualities;
+  mutable ExplanationCache d_explainedDisequalities;
+
+  /**
+   * Adds the explanation of t1Id = t2Id (or of its negation, if polarity is
+   * false) to equalities from the cache and returns true, or returns false if
+   * it is not cached.
+   */
+  bool getCachedExplanation(EqualityNodeId t1Id,
+                            EqualityNodeId t2Id,
+                            bool polarity,
+                            std::vector<TNode>& equalities) const;
+
+  /**
+   * Caches the explanation of t1Id = t2Id (or of its negation), which are
+   * the equalities added to equalities from index start.
+   */
+  void cacheExplanation(EqualityNodeId t1Id,
+                        EqualityNodeId t2Id,
+                        bool polarity,
+                        const std::vector<TNode>& equalities,
+                        size_t start) const;
+
   /**
    * Has this equality been propagated to anyone.
    */
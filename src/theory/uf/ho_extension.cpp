@@ -217,6 +217,9 @@ unsigned HoExtension::checkExtensionality(TheoryModel* m)
     ++eqcs_i;
   }
 
+  // index of the partial applications, built on demand
+  std::map<TNode, std::map<TNode, TNode> > apps;
+  bool appsComputed = false;
   for (std::map<TypeNode, std::vector<Node> >::iterator itf = func_eqcs.begin();
        itf != func_eqcs.end();
        ++itf)
@@ -229,6 +232,16 @@ unsigned HoExtension::checkExtensionality(TheoryModel* m)
         // extensionality to ensure distinctness
         if (!ee->areDisequal(itf->second[j], itf->second[k], false))
         {
+          if (!appsComputed)
+          {
+            computeApplicationIndex(apps);
+            appsComputed = true;
+          }
+          if (hasDistinctApplication(itf->second[j], itf->second[k], apps))
+          {
+            // already distinct, no need for extensionality
+            continue;
+          }
           Node deq =
               Rewriter::rewrite(itf->second[j].eqNode(itf->second[k]).negate());
           // either add to model, or add lemma
@@ -272,6 +285,59 @@ unsigned HoExtension::checkExtensionality(TheoryModel* m)
   return num_lemmas;
 }
 
+void HoExtension::computeApplicationIndex(
+    std::map<TNode, std::map<TNode, TNode> >& apps)
+{
+  eq::EqualityEngine* ee = d_parent.getEqualityEngine();
+  eq::EqClassesIterator eqcs_i = eq::EqClassesIterator(ee);
+  while (!eqcs_i.isFinished())
+  {
+    TNode eqc = (*eqcs_i);
+    eq::EqClassIterator eqc_i = eq::EqClassIterator(eqc, ee);
+    while (!eqc_i.isFinished())
+    {
+      TNode n = *eqc_i;
+      if (n.getKind() == HO_APPLY)
+      {
+        TNode f = ee->getRepresentative(n[0]);
+        TNode a = ee->getRepresentative(n[1]);
+        // one application per argument suffices, since all of them are equal
+        apps[f].insert(std::pair<TNode, TNode>(a, eqc));
+      }
+      ++eqc_i;
+    }
+    ++eqcs_i;
+  }
+}
+
+bool HoExtension::hasDistinctApplication(
+    TNode f, TNode g, const std::map<TNode, std::map<TNode, TNode> >& apps)
+{
+  std::map<TNode, std::map<TNode, TNode> >::const_iterator itf = apps.find(f);
+  std::map<TNode, std::map<TNode, TNode> >::const_iterator itg = apps.find(g);
+  if (itf == apps.end() || itg == apps.end())
+  {
+    return false;
+  }
+  if (itg->second.size() < itf->second.size())
+  {
+    std::swap(itf, itg);
+  }
+  eq::EqualityEngine* ee = d_parent.getEqualityEngine();
+  for (const std::pair<const TNode, TNode>& fa : itf->second)
+  {
+    std::map<TNode, TNode>::const_iterator itga = itg->second.find(fa.first);
+    if (itga != itg->second.end()
+        && ee->areDisequal(fa.second, itga->second, false))
+    {
+      Trace("uf-ho-debug") << "  " << f << " and " << g
+                           << " differ on argument " << fa.first << std::endl;
+      return true;
+    }
+  }
+  return false;
+}
+
 unsigned HoExtension::applyAppCompletion(TNode n)
 {
   Assert(n.getKind() == APPLY_UF);
@@ -300,6 +366,10 @@ unsigned HoExtension::checkAppCompletion()
   eq::EqualityEngine* ee = d_parent.getEqualityEngine();
   eq::EqClassesIterator eqcs_i = eq::EqClassesIterator(ee);
   std::map<TNode, std::vector<Node> > apply_uf;
+  // The applications to complete. They are only processed after the
+  // traversal of the equality engine, which they modify, so that a single
+  // traversal completes all the applications whose operator is relevant.
+  std::vector<Node> toComplete;
   while (!eqcs_i.isFinished())
   {
     Node eqc = (*eqcs_i);
@@ -311,19 +381,14 @@ unsigned HoExtension::checkAppCompletion()
       Node n = *eqc_i;
       if (n.getKind() == APPLY_UF || n.getKind() == HO_APPLY)
       {
-        int curr_sum = 0;
         std::map<TNode, bool> curr_rops;
         if (n.getKind() == APPLY_UF)
         {
           TNode rop = ee->getRepresentative(n.getOperator());
           if (rlvOp.find(rop) != rlvOp.end())
           {
-            // try if its operator is relevant
-            curr_sum = applyAppCompletion(n);
-            if (curr_sum > 0)
-            {
-              return curr_sum;
-            }
+            // its operator is relevant
+            toComplete.push_back(n);
           }
           else
           {
@@ -360,14 +425,9 @@ unsigned HoExtension::checkAppCompletion()
                 apply_uf.find(rop);
             if (itu != apply_uf.end())
             {
-              for (unsigned j = 0, size = itu->second.size(); j < size; j++)
-              {
-                curr_sum = applyAppCompletion(itu->second[j]);
-                if (curr_sum > 0)
-                {
-                  return curr_sum;
-                }
-              }
+              toComplete.insert(
+                  toComplete.end(), itu->second.begin(), itu->second.end());
+              apply_uf.erase(itu);
             }
           }
         }
@@ -376,7 +436,16 @@ unsigned HoExtension::checkAppCompletion()
     }
     ++eqcs_i;
   }
-  return 0;
+  unsigned num_facts = 0;
+  for (const Node& n : toComplete)
+  {
+    num_facts += applyAppCompletion(n);
+    if (d_parent.inConflict())
+    {
+      break;
+    }
+  }
+  return num_facts;
 }
 
 unsigned HoExtension::check()
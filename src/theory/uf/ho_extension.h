@@ -138,6 +138,9 @@ class HoExtension
    * Check whether extensionality should be applied for any pair of terms in the
    * equality engine.
    *
+   * Pairs of functions that have disequal applications to the same argument
+   * are skipped, since they are already distinct.
+   *
    * If we pass a null model m to this function, then we add extensionality
    * lemmas to the output channel and return the total number of lemmas added.
    * We only add lemmas for functions whose type is finite, since pairs of
@@ -153,6 +156,20 @@ class HoExtension
    * finite.
    */
   unsigned checkExtensionality(TheoryModel* m = nullptr);
+  /**
+   * Computes the index of the partial applications (HO_APPLY terms) of the
+   * equality engine, which maps the representative of a function and the
+   * representative of an argument to the representative of the application
+   * of the former to the latter.
+   */
+  void computeApplicationIndex(std::map<TNode, std::map<TNode, TNode> >& apps);
+  /**
+   * Returns true if the functions f and g, which are representatives, have
+   * disequal applications to the same argument in index apps, in which case
+   * they are distinct and need no extensionality.
+   */
+  bool hasDistinctApplication(
+      TNode f, TNode g, const std::map<TNode, std::map<TNode, TNode> >& apps);
 
   /** applyAppCompletion
    * This infers a correspondence between APPLY_UF and HO_APPLY
@@ -0,0 +1,226 @@
+/*********************                                                        */
+/*! \file dary_heap.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief An indexed d-ary heap of small unsigned integers
+ **
+ ** An indexed d-ary heap of small unsigned integers, e.g. variable ids.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__DARY_HEAP_H
+#define CVC4__DARY_HEAP_H
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "base/check.h"
+
+namespace CVC4 {
+
+/**
+ * A d-ary heap that orders its elements greatest-first (i.e., in the opposite
+ * direction of the provided comparator), like BinaryHeap.
+ *
+ * The elements are unsigned integers that are used as indices: the position
+ * of each element in the heap is stored in a vector indexed by the element.
+ * Hence there are no handles, an element is updated or erased by its value,
+ * and a push, an erase or an update does not allocate once the vector is
+ * large enough. An element may be in the heap at most once.
+ *
+ * The keys of the elements are not stored in the heap, they are read by the
+ * comparator. When the key of an element changes, update() restores the heap
+ * in either direction (increase or decrease key). When the comparator itself
+ * changes, setComparator() rebuilds the heap in linear time.
+ *
+ * A larger arity makes the heap shallower, which makes pushes and key
+ * increases cheaper at the expense of pops and key decreases.
+ */
+template <class Elem, class CmpFcn = std::less<Elem>, unsigned Arity = 4>
+class IndexedDAryHeap
+{
+  static_assert(Arity >= 2, "the arity of a heap must be at least 2");
+
+ public:
+  typedef typename std::vector<Elem>::const_iterator const_iterator;
+  typedef const_iterator iterator;
+
+  IndexedDAryHeap(const CmpFcn& c = CmpFcn()) : d_cmp(c) {}
+
+  size_t size() const { return d_heap.size(); }
+  bool empty() const { return d_heap.empty(); }
+
+  /** Iteration over the elements, in no particular order. */
+  const_iterator begin() const { return d_heap.begin(); }
+  const_iterator end() const { return d_heap.end(); }
+
+  bool contains(Elem e) const
+  {
+    return static_cast<size_t>(e) < d_pos.size() && d_pos[e] != NOT_IN_HEAP;
+  }
+
+  void push(Elem e)
+  {
+    Assert(!contains(e));
+    if (static_cast<size_t>(e) >= d_pos.size())
+    {
+      d_pos.resize(static_cast<size_t>(e) + 1, NOT_IN_HEAP);
+    }
+    d_pos[e] = d_heap.size();
+    d_heap.push_back(e);
+    upHeap(d_heap.size() - 1);
+  }
+
+  const Elem& top() const
+  {
+    Assert(!empty());
+    return d_heap.front();
+  }
+
+  void pop()
+  {
+    Assert(!empty());
+    erase(d_heap.front());
+  }
+
+  void erase(Elem e)
+  {
+    Assert(contains(e));
+    size_t pos = d_pos[e];
+    d_pos[e] = NOT_IN_HEAP;
+    Elem last = d_heap.back();
+    d_heap.pop_back();
+    if (pos < d_heap.size())
+    {
+      // move the last element into the hole
+      d_heap[pos] = last;
+      d_pos[last] = pos;
+      restore(pos);
+    }
+  }
+
+  /** Restores the heap after the key of e increased or decreased. */
+  void update(Elem e)
+  {
+    Assert(contains(e));
+    restore(d_pos[e]);
+  }
+
+  /** Changes the comparator and rebuilds the heap. */
+  void setComparator(const CmpFcn& c)
+  {
+    d_cmp = c;
+    // Floyd's construction: sift down every inner node, deepest first
+    for (size_t i = d_heap.size(); i > 1;)
+    {
+      --i;
+      if (i % Arity == 1)
+      {
+        // i is the first child of its parent
+        downHeap(parent(i));
+      }
+    }
+  }
+
+  void clear()
+  {
+    for (Elem e : d_heap)
+    {
+      d_pos[e] = NOT_IN_HEAP;
+    }
+    d_heap.clear();
+  }
+
+ private:
+  /** The position of the elements not in the heap */
+  static const size_t NOT_IN_HEAP;
+
+  static size_t parent(size_t pos) { return (pos - 1) / Arity; }
+  static size_t firstChild(size_t pos) { return Arity * pos + 1; }
+
+  /** Returns true if a should be above b */
+  bool gt(Elem a, Elem b) const { return d_cmp(b, a); }
+
+  void place(size_t pos, Elem e)
+  {
+    d_heap[pos] = e;
+    d_pos[e] = pos;
+  }
+
+  void restore(size_t pos)
+  {
+    if (pos > 0 && gt(d_heap[pos], d_heap[parent(pos)]))
+    {
+      upHeap(pos);
+    }
+    else
+    {
+      downHeap(pos);
+    }
+  }
+
+  void upHeap(size_t pos)
+  {
+    Elem e = d_heap[pos];
+    while (pos > 0)
+    {
+      size_t par = parent(pos);
+      if (!gt(e, d_heap[par]))
+      {
+        break;
+      }
+      place(pos, d_heap[par]);
+      pos = par;
+    }
+    place(pos, e);
+  }
+
+  void downHeap(size_t pos)
+  {
+    Elem e = d_heap[pos];
+    size_t n = d_heap.size();
+    for (size_t child = firstChild(pos); child < n; child = firstChild(pos))
+    {
+      // the greatest child
+      size_t best = child;
+      size_t end = child + Arity < n ? child + Arity : n;
+      for (size_t c = child + 1; c < end; ++c)
+      {
+        if (gt(d_heap[c], d_heap[best]))
+        {
+          best = c;
+        }
+      }
+      if (!gt(d_heap[best], e))
+      {
+        break;
+      }
+      place(pos, d_heap[best]);
+      pos = best;
+    }
+    place(pos, e);
+  }
+
+  /** The elements, as an implicit Arity-ary tree */
+  std::vector<Elem> d_heap;
+  /** The position in d_heap of each element, or NOT_IN_HEAP */
+  std::vector<size_t> d_pos;
+  /** The comparator */
+  CmpFcn d_cmp;
+}; /* class IndexedDAryHeap<> */
+
+template <class Elem, class CmpFcn, unsigned Arity>
+const size_t IndexedDAryHeap<Elem, CmpFcn, Arity>::NOT_IN_HEAP =
+    std::numeric_limits<size_t>::max();
+
+}  // namespace CVC4
+
+#endif /* CVC4__DARY_HEAP_H */
@@ -42,6 +42,18 @@ inline size_t gmpz_hash(const mpz_t toHash) {
   return hash;
 }/* gmpz_hash() */
 
+/** Hashes an unsigned long like gmpz_hash() hashes the same value. */
+inline size_t gmpz_hash_ui(unsigned long toHash) {
+  size_t hash = 0;
+  while (toHash != 0) {
+    hash = hash * 2;
+    hash = hash xor static_cast<mp_limb_t>(toHash & GMP_NUMB_MASK);
+    // two shifts, a limb may be as wide as an unsigned long
+    toHash = (toHash >> (GMP_NUMB_BITS / 2)) >> (GMP_NUMB_BITS - GMP_NUMB_BITS / 2);
+  }
+  return hash;
+}/* gmpz_hash_ui() */
+
 }/* CVC4 namespace */
 
 #endif /* CVC4__GMP_UTIL_H */
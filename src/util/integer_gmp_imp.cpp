@@ -34,97 +34,395 @@ using namespace std;
 
 namespace CVC4 {
 
-Integer::Integer(const char* s, unsigned base)
-  : d_value(s, base)
-{}
+Integer::Integer(const char* s, unsigned base) : d_small(0), d_big(nullptr)
+{
+  mpz_class val(s, base);
+  setMpz(val);
+}
 
 Integer::Integer(const std::string& s, unsigned base)
-  : d_value(s, base)
-{}
+    : d_small(0), d_big(nullptr)
+{
+  mpz_class val(s, base);
+  setMpz(val);
+}
+
+void Integer::setMpz(mpz_class& val)
+{
+  if (val.fits_slong_p() && fitsSmall(val.get_si()))
+  {
+    delete d_big;
+    d_big = nullptr;
+    d_small = val.get_si();
+  }
+  else
+  {
+    if (isSmall())
+    {
+      d_big = new mpz_class();
+    }
+    d_big->swap(val);
+  }
+}
+
+bool Integer::mulSmall(long a, long b, long& r)
+{
+  if (a == 0 || b == 0)
+  {
+    r = 0;
+    return true;
+  }
+  // neither a nor b is LONG_MIN, so the absolute values are defined
+  long absA = a < 0 ? -a : a;
+  long absB = b < 0 ? -b : b;
+  if (absA > std::numeric_limits<long>::max() / absB)
+  {
+    return false;
+  }
+  r = a * b;
+  return true;
+}
+
+Integer Integer::addSlow(const Integer& y, bool subtract) const
+{
+  mpz_class tx, ty, res;
+  if (subtract)
+  {
+    mpz_sub(res.get_mpz_t(), toMpz(tx).get_mpz_t(), y.toMpz(ty).get_mpz_t());
+  }
+  else
+  {
+    mpz_add(res.get_mpz_t(), toMpz(tx).get_mpz_t(), y.toMpz(ty).get_mpz_t());
+  }
+  return fromMpz(res);
+}
 
+Integer Integer::mulSlow(const Integer& y) const
+{
+  mpz_class tx, ty, res;
+  mpz_mul(res.get_mpz_t(), toMpz(tx).get_mpz_t(), y.toMpz(ty).get_mpz_t());
+  return fromMpz(res);
+}
 
 bool Integer::fitsSignedInt() const {
-  return d_value.fits_sint_p();
+  if (isSmall())
+  {
+    return d_small >= std::numeric_limits<int>::min()
+           && d_small <= std::numeric_limits<int>::max();
+  }
+  return d_big->fits_sint_p();
 }
 
 bool Integer::fitsUnsignedInt() const {
-  return d_value.fits_uint_p();
+  if (isSmall())
+  {
+    return d_small >= 0
+           && static_cast<unsigned long>(d_small)
+                  <= std::numeric_limits<unsigned int>::max();
+  }
+  return d_big->fits_uint_p();
 }
 
 signed int Integer::getSignedInt() const {
   // ensure there isn't overflow
-  CheckArgument(d_value <= std::numeric_limits<int>::max(), this,
-                "Overflow detected in Integer::getSignedInt().");
-  CheckArgument(d_value >= std::numeric_limits<int>::min(), this,
-                "Overflow detected in Integer::getSignedInt().");
   CheckArgument(fitsSignedInt(), this,
                 "Overflow detected in Integer::getSignedInt().");
-  return (signed int) d_value.get_si();
+  if (isSmall())
+  {
+    return static_cast<signed int>(d_small);
+  }
+  return (signed int) d_big->get_si();
 }
 
 unsigned int Integer::getUnsignedInt() const {
   // ensure there isn't overflow
-  CheckArgument(d_value <= std::numeric_limits<unsigned int>::max(), this,
-                "Overflow detected in Integer::getUnsignedInt()");
-  CheckArgument(d_value >= std::numeric_limits<unsigned int>::min(), this,
+  CheckArgument(sgn() >= 0 && *this <= std::numeric_limits<unsigned int>::max(),
+                this,
                 "Overflow detected in Integer::getUnsignedInt()");
   CheckArgument(fitsSignedInt(), this,
                 "Overflow detected in Integer::getUnsignedInt()");
-  return (unsigned int) d_value.get_ui();
+  return static_cast<unsigned int>(d_small);
 }
 
 bool Integer::fitsSignedLong() const {
-  return d_value.fits_slong_p();
+  if (isSmall())
+  {
+    return true;
+  }
+  return d_big->fits_slong_p();
 }
 
 bool Integer::fitsUnsignedLong() const {
-  return d_value.fits_ulong_p();
+  if (isSmall())
+  {
+    return d_small >= 0;
+  }
+  return d_big->fits_ulong_p();
+}
+
+Integer Integer::multiplyByPow2(uint32_t pow) const
+{
+  if (isSmall() && d_small == 0)
+  {
+    return *this;
+  }
+  if (isSmall() && pow < s_smallBits
+      && absSmall() <= static_cast<unsigned long>(
+             std::numeric_limits<long>::max() >> pow))
+  {
+    return fromSmall(d_small * (1L << pow));
+  }
+  mpz_class tmp, result;
+  mpz_mul_2exp(result.get_mpz_t(), toMpz(tmp).get_mpz_t(), pow);
+  return fromMpz(result);
 }
 
 Integer Integer::oneExtend(uint32_t size, uint32_t amount) const {
   // check that the size is accurate
   DebugCheckArgument((*this) < Integer(1).multiplyByPow2(size), size);
-  mpz_class res = d_value;
+  mpz_class res = get_mpz();
 
   for (unsigned i = size; i < size + amount; ++i) {
     mpz_setbit(res.get_mpz_t(), i);
   }
 
-  return Integer(res);
+  return fromMpz(res);
+}
+
+Integer Integer::extractBitRange(uint32_t bitCount, uint32_t low) const
+{
+  const unsigned wordBits = std::numeric_limits<unsigned long>::digits;
+  if (isSmall() && bitCount < s_smallBits && low < wordBits
+      && static_cast<uint64_t>(low) + bitCount <= wordBits)
+  {
+    // the bits of the two's complement, which GMP uses for negative values
+    unsigned long bits = static_cast<unsigned long>(d_small) >> low;
+    return fromSmall(static_cast<long>(bits & ((1UL << bitCount) - 1)));
+  }
+  // bitCount = high-low+1
+  uint32_t high = low + bitCount-1;
+  //— Function: void mpz_fdiv_r_2exp (mpz_t r, mpz_t n, mp_bitcnt_t b)
+  mpz_class tmp, rem, div;
+  mpz_fdiv_r_2exp(rem.get_mpz_t(), toMpz(tmp).get_mpz_t(), high+1);
+  mpz_fdiv_q_2exp(div.get_mpz_t(), rem.get_mpz_t(), low);
+
+  return fromMpz(div);
+}
+
+void Integer::floorQR(Integer& q,
+                      Integer& r,
+                      const Integer& x,
+                      const Integer& y)
+{
+  if (x.isSmall() && y.isSmall() && y.d_small != 0)
+  {
+    long qs = x.d_small / y.d_small;
+    long rs = x.d_small % y.d_small;
+    if (rs != 0 && (rs < 0) != (y.d_small < 0))
+    {
+      qs -= 1;
+      rs += y.d_small;
+    }
+    q = fromSmall(qs);
+    r = fromSmall(rs);
+    return;
+  }
+  mpz_class tx, ty, qv, rv;
+  mpz_fdiv_qr(qv.get_mpz_t(),
+              rv.get_mpz_t(),
+              x.toMpz(tx).get_mpz_t(),
+              y.toMpz(ty).get_mpz_t());
+  q = fromMpz(qv);
+  r = fromMpz(rv);
+}
+
+void Integer::ceilingQR(Integer& q,
+                        Integer& r,
+                        const Integer& x,
+                        const Integer& y)
+{
+  if (x.isSmall() && y.isSmall() && y.d_small != 0)
+  {
+    long qs = x.d_small / y.d_small;
+    long rs = x.d_small % y.d_small;
+    if (rs != 0 && (rs < 0) == (y.d_small < 0))
+    {
+      qs += 1;
+      rs -= y.d_small;
+    }
+    q = fromSmall(qs);
+    r = fromSmall(rs);
+    return;
+  }
+  mpz_class tx, ty, qv, rv;
+  mpz_cdiv_qr(qv.get_mpz_t(),
+              rv.get_mpz_t(),
+              x.toMpz(tx).get_mpz_t(),
+              y.toMpz(ty).get_mpz_t());
+  q = fromMpz(qv);
+  r = fromMpz(rv);
 }
 
 Integer Integer::exactQuotient(const Integer& y) const {
   DebugCheckArgument(y.divides(*this), y);
-  mpz_class q;
-  mpz_divexact(q.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-  return Integer( q );
+  if (isSmall() && y.isSmall() && y.d_small != 0)
+  {
+    return fromSmall(d_small / y.d_small);
+  }
+  mpz_class tx, ty, q;
+  mpz_divexact(q.get_mpz_t(), toMpz(tx).get_mpz_t(), y.toMpz(ty).get_mpz_t());
+  return fromMpz(q);
+}
+
+Integer Integer::pow(unsigned long int exp) const
+{
+  if (isSmall())
+  {
+    // square and multiply while the intermediate results fit
+    long result = 1;
+    long base = d_small;
+    unsigned long e = exp;
+    bool fits = true;
+    while (fits && e != 0)
+    {
+      if (e & 1)
+      {
+        fits = mulSmall(result, base, result);
+      }
+      e >>= 1;
+      if (fits && e != 0)
+      {
+        fits = mulSmall(base, base, base);
+      }
+    }
+    if (fits)
+    {
+      return fromSmall(result);
+    }
+  }
+  mpz_class tmp, result;
+  mpz_pow_ui(result.get_mpz_t(), toMpz(tmp).get_mpz_t(), exp);
+  return fromMpz(result);
+}
+
+Integer Integer::gcd(const Integer& y) const
+{
+  if (isSmall() && y.isSmall())
+  {
+    unsigned long a = absSmall();
+    unsigned long b = y.absSmall();
+    while (b != 0)
+    {
+      unsigned long t = a % b;
+      a = b;
+      b = t;
+    }
+    return fromSmall(static_cast<long>(a));
+  }
+  mpz_class tx, ty, result;
+  mpz_gcd(result.get_mpz_t(), toMpz(tx).get_mpz_t(), y.toMpz(ty).get_mpz_t());
+  return fromMpz(result);
+}
+
+Integer Integer::lcm(const Integer& y) const
+{
+  if (isSmall() && y.isSmall())
+  {
+    if (d_small == 0 || y.d_small == 0)
+    {
+      return Integer();
+    }
+    long g = gcd(y).d_small;
+    long result;
+    if (mulSmall(static_cast<long>(absSmall()) / g,
+                 static_cast<long>(y.absSmall()),
+                 result))
+    {
+      return fromSmall(result);
+    }
+  }
+  mpz_class tx, ty, result;
+  mpz_lcm(result.get_mpz_t(), toMpz(tx).get_mpz_t(), y.toMpz(ty).get_mpz_t());
+  return fromMpz(result);
 }
 
 Integer Integer::modAdd(const Integer& y, const Integer& m) const
 {
-  mpz_class res;
-  mpz_add(res.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-  mpz_mod(res.get_mpz_t(), res.get_mpz_t(), m.d_value.get_mpz_t());
-  return Integer(res);
+  mpz_class tx, ty, tm, res;
+  mpz_add(res.get_mpz_t(), toMpz(tx).get_mpz_t(), y.toMpz(ty).get_mpz_t());
+  mpz_mod(res.get_mpz_t(), res.get_mpz_t(), m.toMpz(tm).get_mpz_t());
+  return fromMpz(res);
 }
 
 Integer Integer::modMultiply(const Integer& y, const Integer& m) const
 {
-  mpz_class res;
-  mpz_mul(res.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-  mpz_mod(res.get_mpz_t(), res.get_mpz_t(), m.d_value.get_mpz_t());
-  return Integer(res);
+  mpz_class tx, ty, tm, res;
+  mpz_mul(res.get_mpz_t(), toMpz(tx).get_mpz_t(), y.toMpz(ty).get_mpz_t());
+  mpz_mod(res.get_mpz_t(), res.get_mpz_t(), m.toMpz(tm).get_mpz_t());
+  return fromMpz(res);
 }
 
 Integer Integer::modInverse(const Integer& m) const
 {
   PrettyCheckArgument(m > 0, m, "m must be greater than zero");
-  mpz_class res;
-  if (mpz_invert(res.get_mpz_t(), d_value.get_mpz_t(), m.d_value.get_mpz_t())
+  mpz_class tx, tm, res;
+  if (mpz_invert(res.get_mpz_t(), toMpz(tx).get_mpz_t(), m.toMpz(tm).get_mpz_t())
       == 0)
   {
     return Integer(-1);
   }
-  return Integer(res);
+  return fromMpz(res);
 }
+
+unsigned Integer::isPow2() const
+{
+  if (isSmall())
+  {
+    if (d_small <= 0 || (d_small & (d_small - 1)) != 0) return 0;
+    unsigned k = 1;
+    for (long v = d_small; v != 1; v >>= 1)
+    {
+      ++k;
+    }
+    return k;
+  }
+  if (sgn() <= 0) return 0;
+  // check that the number of ones in the binary representation is 1
+  if (mpz_popcount(d_big->get_mpz_t()) == 1) {
+    // return the index of the first one plus 1
+    return mpz_scan1(d_big->get_mpz_t(), 0) + 1;
+  }
+  return 0;
+}
+
+size_t Integer::length() const
+{
+  if (isSmall())
+  {
+    size_t n = 1;
+    for (unsigned long v = absSmall(); v > 1; v >>= 1)
+    {
+      ++n;
+    }
+    return n;
+  }
+  return mpz_sizeinbase(d_big->get_mpz_t(), 2);
+}
+
+void Integer::extendedGcd(
+    Integer& g, Integer& s, Integer& t, const Integer& a, const Integer& b)
+{
+  //see the documentation for:
+  //mpz_gcdext (mpz_t g, mpz_t s, mpz_t t, mpz_t a, mpz_t b);
+  mpz_class ta, tb, gv, sv, tv;
+  mpz_gcdext(gv.get_mpz_t(),
+             sv.get_mpz_t(),
+             tv.get_mpz_t(),
+             a.toMpz(ta).get_mpz_t(),
+             b.toMpz(tb).get_mpz_t());
+  g = fromMpz(gv);
+  s = fromMpz(sv);
+  t = fromMpz(tv);
+}
+
 } /* namespace CVC4 */
@@ -13,6 +13,8 @@
  ** integer.
  **
  ** A multiprecision integer constant; wraps a GMP multiprecision integer.
+ ** Values that fit into a machine word are stored inline and only promoted
+ ** to GMP when an operation overflows.
  **/
 
 #include "cvc4_public.h"
@@ -34,26 +36,99 @@ class Rational;
 class CVC4_PUBLIC Integer {
 private:
   /**
-   * Stores the value of the rational is stored in a C++ GMP integer class.
-   * Using this instead of mpz_t allows for easier destruction.
+   * The value if d_big is null. LONG_MIN is never stored here, so that the
+   * negation and absolute value of a small value are small too.
    */
-  mpz_class d_value;
+  long d_small;
 
   /**
-   * Gets a reference to the gmp data that backs up the integer.
+   * The value if it does not fit into d_small. The representation is
+   * canonical: d_big is null iff the value fits.
+   */
+  mpz_class* d_big;
+
+  bool isSmall() const { return d_big == nullptr; }
+
+  /** Whether v can be stored in d_small. */
+  static bool fitsSmall(long v)
+  {
+    return v != std::numeric_limits<long>::min();
+  }
+
+  /** r = a + b, returns false if r does not fit into d_small. */
+  static bool addSmall(long a, long b, long& r)
+  {
+    if ((b > 0 && a > std::numeric_limits<long>::max() - b)
+        || (b < 0 && a < std::numeric_limits<long>::min() - b))
+    {
+      return false;
+    }
+    r = a + b;
+    return fitsSmall(r);
+  }
+
+  /** r = a * b, returns false if r does not fit into d_small. */
+  static bool mulSmall(long a, long b, long& r);
+
+  /**
+   * Gets a copy of the gmp data that backs up the integer.
    * Only accessible to friend classes.
    */
-  const mpz_class& get_mpz() const { return d_value; }
+  mpz_class get_mpz() const
+  {
+    return isSmall() ? mpz_class(d_small) : *d_big;
+  }
+
+  /** The value as a GMP integer, in tmp if it is small. */
+  const mpz_class& toMpz(mpz_class& tmp) const
+  {
+    if (isSmall())
+    {
+      tmp = d_small;
+      return tmp;
+    }
+    return *d_big;
+  }
+
+  /** Take the value of val, leaving val in an unspecified state. */
+  void setMpz(mpz_class& val);
 
   /**
    * Constructs an Integer by copying a GMP C++ primitive.
    */
-  Integer(const mpz_class& val) : d_value(val) {}
+  Integer(const mpz_class& val) : d_small(0), d_big(nullptr)
+  {
+    mpz_class tmp(val);
+    setMpz(tmp);
+  }
+
+  /** Constructs a small Integer. */
+  static Integer fromSmall(long v)
+  {
+    Integer res;
+    if (fitsSmall(v))
+    {
+      res.d_small = v;
+    }
+    else
+    {
+      res.d_big = new mpz_class(v);
+    }
+    return res;
+  }
+
+  /** Constructs an Integer from a result of GMP, which is consumed. */
+  static Integer fromMpz(mpz_class& val)
+  {
+    Integer res;
+    res.setMpz(val);
+    return res;
+  }
 
 public:
 
   /** Constructs a rational with the value 0. */
-  Integer() : d_value(0){}
+  Integer() : d_small(0), d_big(nullptr) {}
 
   /**
    * Constructs a Integer from a C string.
@@ -64,134 +139,239 @@ public:
   explicit Integer(const char* s, unsigned base = 10);
   explicit Integer(const std::string& s, unsigned base = 10);
 
-  Integer(const Integer& q) : d_value(q.d_value) {}
+  Integer(const Integer& q)
+      : d_small(q.d_small), d_big(q.isSmall() ? nullptr : new mpz_class(*q.d_big))
+  {
+  }
 
-  Integer(  signed int z) : d_value(z) {}
-  Integer(unsigned int z) : d_value(z) {}
-  Integer(  signed long int z) : d_value(z) {}
-  Integer(unsigned long int z) : d_value(z) {}
+  Integer(Integer&& q) : d_small(q.d_small), d_big(q.d_big)
+  {
+    q.d_small = 0;
+    q.d_big = nullptr;
+  }
+
+  Integer(signed int z) : Integer(static_cast<long>(z)) {}
+  Integer(unsigned int z) : d_small(0), d_big(nullptr) { setUnsigned(z); }
+  Integer(signed long int z) : d_small(z), d_big(nullptr)
+  {
+    if (!fitsSmall(z))
+    {
+      d_small = 0;
+      d_big = new mpz_class(z);
+    }
+  }
+  Integer(unsigned long int z) : d_small(0), d_big(nullptr)
+  {
+    setUnsigned(z);
+  }
 
 #ifdef CVC4_NEED_INT64_T_OVERLOADS
-  Integer( int64_t z) : d_value(static_cast<long>(z)) {}
-  Integer(uint64_t z) : d_value(static_cast<unsigned long>(z)) {}
+  Integer(int64_t z) : Integer(static_cast<long>(z)) {}
+  Integer(uint64_t z) : Integer(static_cast<unsigned long>(z)) {}
 #endif /* CVC4_NEED_INT64_T_OVERLOADS */
 
-  ~Integer() {}
+  ~Integer() { delete d_big; }
 
   /**
    * Returns a copy of d_value to enable public access of GMP data.
    */
   mpz_class getValue() const
   {
-    return d_value;
+    return get_mpz();
   }
 
   Integer& operator=(const Integer& x){
     if(this == &x) return *this;
-    d_value = x.d_value;
+    if (x.isSmall())
+    {
+      delete d_big;
+      d_big = nullptr;
+      d_small = x.d_small;
+    }
+    else if (isSmall())
+    {
+      d_big = new mpz_class(*x.d_big);
+    }
+    else
+    {
+      *d_big = *x.d_big;
+    }
+    return *this;
+  }
+
+  Integer& operator=(Integer&& x)
+  {
+    if (this == &x) return *this;
+    delete d_big;
+    d_small = x.d_small;
+    d_big = x.d_big;
+    x.d_small = 0;
+    x.d_big = nullptr;
     return *this;
   }
 
   bool operator==(const Integer& y) const {
-    return d_value == y.d_value;
+    if (isSmall() || y.isSmall())
+    {
+      // the representation is canonical
+      return isSmall() && y.isSmall() && d_small == y.d_small;
+    }
+    return *d_big == *y.d_big;
   }
 
   Integer operator-() const {
-    return Integer(-(d_value));
+    if (isSmall())
+    {
+      return fromSmall(-d_small);
+    }
+    mpz_class res = -(*d_big);
+    return fromMpz(res);
   }
 
 
   bool operator!=(const Integer& y) const {
-    return d_value != y.d_value;
+    return !(*this == y);
   }
 
   bool operator< (const Integer& y) const {
-    return d_value < y.d_value;
+    return compare(y) < 0;
   }
 
   bool operator<=(const Integer& y) const {
-    return d_value <= y.d_value;
+    return compare(y) <= 0;
   }
 
   bool operator> (const Integer& y) const {
-    return d_value > y.d_value;
+    return compare(y) > 0;
   }
 
   bool operator>=(const Integer& y) const {
-    return d_value >= y.d_value;
+    return compare(y) >= 0;
   }
 
 
   Integer operator+(const Integer& y) const {
-    return Integer( d_value + y.d_value );
+    long r;
+    if (isSmall() && y.isSmall() && addSmall(d_small, y.d_small, r))
+    {
+      return fromSmall(r);
+    }
+    return addSlow(y, false);
   }
   Integer& operator+=(const Integer& y) {
-    d_value += y.d_value;
-    return *this;
+    long r;
+    if (isSmall() && y.isSmall() && addSmall(d_small, y.d_small, r))
+    {
+      d_small = r;
+      return *this;
+    }
+    return *this = addSlow(y, false);
   }
 
   Integer operator-(const Integer& y) const {
-    return Integer( d_value - y.d_value );
+    long r;
+    if (isSmall() && y.isSmall() && addSmall(d_small, -y.d_small, r))
+    {
+      return fromSmall(r);
+    }
+    return addSlow(y, true);
   }
   Integer& operator-=(const Integer& y) {
-    d_value -= y.d_value;
-    return *this;
+    long r;
+    if (isSmall() && y.isSmall() && addSmall(d_small, -y.d_small, r))
+    {
+      d_small = r;
+      return *this;
+    }
+    return *this = addSlow(y, true);
   }
 
   Integer operator*(const Integer& y) const {
-    return Integer( d_value * y.d_value );
+    long r;
+    if (isSmall() && y.isSmall() && mulSmall(d_small, y.d_small, r))
+    {
+      return fromSmall(r);
+    }
+    return mulSlow(y);
   }
   Integer& operator*=(const Integer& y) {
-    d_value *= y.d_value;
-    return *this;
+    long r;
+    if (isSmall() && y.isSmall() && mulSmall(d_small, y.d_small, r))
+    {
+      d_small = r;
+      return *this;
+    }
+    return *this = mulSlow(y);
   }
 
 
   Integer bitwiseOr(const Integer& y) const {
-    mpz_class result;
-    mpz_ior(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer(result);
+    if (isSmall() && y.isSmall())
+    {
+      return fromSmall(d_small | y.d_small);
+    }
+    mpz_class tx, ty, result;
+    mpz_ior(result.get_mpz_t(),
+            toMpz(tx).get_mpz_t(),
+            y.toMpz(ty).get_mpz_t());
+    return fromMpz(result);
   }
 
   Integer bitwiseAnd(const Integer& y) const {
-    mpz_class result;
-    mpz_and(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer(result);
+    if (isSmall() && y.isSmall())
+    {
+      return fromSmall(d_small & y.d_small);
+    }
+    mpz_class tx, ty, result;
+    mpz_and(result.get_mpz_t(),
+            toMpz(tx).get_mpz_t(),
+            y.toMpz(ty).get_mpz_t());
+    return fromMpz(result);
   }
 
   Integer bitwiseXor(const Integer& y) const {
-    mpz_class result;
-    mpz_xor(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer(result);
+    if (isSmall() && y.isSmall())
+    {
+      return fromSmall(d_small ^ y.d_small);
+    }
+    mpz_class tx, ty, result;
+    mpz_xor(result.get_mpz_t(),
+            toMpz(tx).get_mpz_t(),
+            y.toMpz(ty).get_mpz_t());
+    return fromMpz(result);
   }
 
   Integer bitwiseNot() const {
+    if (isSmall())
+    {
+      return fromSmall(~d_small);
+    }
     mpz_class result;
-    mpz_com(result.get_mpz_t(), d_value.get_mpz_t());
-    return Integer(result);
+    mpz_com(result.get_mpz_t(), d_big->get_mpz_t());
+    return fromMpz(result);
   }
 
   /**
    * Return this*(2^pow).
    */
-  Integer multiplyByPow2(uint32_t pow) const{
-    mpz_class result;
-    mpz_mul_2exp(result.get_mpz_t(), d_value.get_mpz_t(), pow);
-    return Integer( result );
-  }
+  Integer multiplyByPow2(uint32_t pow) const;
 
   /**
    * Returns the Integer obtained by setting the ith bit of the
    * current Integer to 1.
    */
   Integer setBit(uint32_t i) const {
-    mpz_class res = d_value;
+    if (isSmall() && i < s_smallBits)
+    {
+      return fromSmall(d_small | (1L << i));
+    }
+    mpz_class res = get_mpz();
     mpz_setbit(res.get_mpz_t(), i);
-    return Integer(res);
+    return fromMpz(res);
   }
 
   bool isBitSet(uint32_t i) const {
-    return !extractBitRange(1, i).isZero();
+    return testBit(i);
   }
 
   /**
@@ -201,62 +381,56 @@ public:
   Integer oneExtend(uint32_t size, uint32_t amount) const;
 
   uint32_t toUnsignedInt() const {
-    return  mpz_get_ui(d_value.get_mpz_t());
+    if (isSmall())
+    {
+      // like mpz_get_ui, the low bits of the absolute value
+      return static_cast<uint32_t>(absSmall());
+    }
+    return  mpz_get_ui(d_big->get_mpz_t());
   }
 
   /** See GMP Documentation. */
-  Integer extractBitRange(uint32_t bitCount, uint32_t low) const {
-    // bitCount = high-low+1
-    uint32_t high = low + bitCount-1;
-    //— Function: void mpz_fdiv_r_2exp (mpz_t r, mpz_t n, mp_bitcnt_t b)
-    mpz_class rem, div;
-    mpz_fdiv_r_2exp(rem.get_mpz_t(), d_value.get_mpz_t(), high+1);
-    mpz_fdiv_q_2exp(div.get_mpz_t(), rem.get_mpz_t(), low);
-
-    return Integer(div);
-  }
+  Integer extractBitRange(uint32_t bitCount, uint32_t low) const;
 
   /**
    * Returns the floor(this / y)
    */
   Integer floorDivideQuotient(const Integer& y) const {
-    mpz_class q;
-    mpz_fdiv_q(q.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer( q );
+    Integer q, r;
+    floorQR(q, r, *this, y);
+    return q;
   }
 
   /**
    * Returns r == this - floor(this/y)*y
    */
   Integer floorDivideRemainder(const Integer& y) const {
-    mpz_class r;
-    mpz_fdiv_r(r.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer( r );
+    Integer q, r;
+    floorQR(q, r, *this, y);
+    return r;
   }
 
   /**
    * Computes a floor quotient and remainder for x divided by y.
    */
-  static void floorQR(Integer& q, Integer& r, const Integer& x, const Integer& y) {
-    mpz_fdiv_qr(q.d_value.get_mpz_t(), r.d_value.get_mpz_t(), x.d_value.get_mpz_t(), y.d_value.get_mpz_t());
-  }
+  static void floorQR(Integer& q, Integer& r, const Integer& x, const Integer& y);
 
   /**
    * Returns the ceil(this / y)
    */
   Integer ceilingDivideQuotient(const Integer& y) const {
-    mpz_class q;
-    mpz_cdiv_q(q.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer( q );
+    Integer q, r;
+    ceilingQR(q, r, *this, y);
+    return q;
   }
 
   /**
    * Returns the ceil(this / y)
    */
   Integer ceilingDivideRemainder(const Integer& y) const {
-    mpz_class r;
-    mpz_cdiv_r(r.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer( r );
+    Integer q, r;
+    ceilingQR(q, r, *this, y);
+    return r;
   }
 
   /**
@@ -324,23 +498,45 @@ public:
    * Returns y mod 2^exp
    */
   Integer modByPow2(uint32_t exp) const {
-    mpz_class res;
-    mpz_fdiv_r_2exp(res.get_mpz_t(), d_value.get_mpz_t(), exp);
-    return Integer(res);
+    if (isSmall() && exp < s_smallBits)
+    {
+      return fromSmall(d_small & ((1L << exp) - 1));
+    }
+    if (isSmall() && d_small >= 0)
+    {
+      return *this;
+    }
+    mpz_class tmp, res;
+    mpz_fdiv_r_2exp(res.get_mpz_t(), toMpz(tmp).get_mpz_t(), exp);
+    return fromMpz(res);
   }
 
   /**
    * Returns y / 2^exp
    */
   Integer divByPow2(uint32_t exp) const {
+    if (isSmall())
+    {
+      if (exp >= s_smallBits)
+      {
+        return fromSmall(d_small < 0 ? -1 : 0);
+      }
+      // rounds towards minus infinity like mpz_fdiv_q_2exp
+      return fromSmall(d_small >= 0 ? d_small >> exp
+                                    : -((-d_small - 1) >> exp) - 1);
+    }
     mpz_class res;
-    mpz_fdiv_q_2exp(res.get_mpz_t(), d_value.get_mpz_t(), exp);
-    return Integer(res);
+    mpz_fdiv_q_2exp(res.get_mpz_t(), d_big->get_mpz_t(), exp);
+    return fromMpz(res);
   }
 
 
   int sgn() const {
-    return mpz_sgn(d_value.get_mpz_t());
+    if (isSmall())
+    {
+      return d_small > 0 ? 1 : (d_small < 0 ? -1 : 0);
+    }
+    return mpz_sgn(d_big->get_mpz_t());
   }
 
   inline bool strictlyPositive() const {
@@ -356,11 +552,11 @@ public:
   }
 
   bool isOne() const {
-    return mpz_cmp_si(d_value.get_mpz_t(), 1) == 0;
+    return isSmall() && d_small == 1;
   }
 
   bool isNegativeOne() const {
-    return mpz_cmp_si(d_value.get_mpz_t(), -1) == 0;
+    return isSmall() && d_small == -1;
   }
 
   /**
@@ -368,29 +564,17 @@ public:
    *
    * @param exp the exponent
    */
-  Integer pow(unsigned long int exp) const {
-    mpz_class result;
-    mpz_pow_ui(result.get_mpz_t(), d_value.get_mpz_t(), exp);
-    return Integer(result);
-  }
+  Integer pow(unsigned long int exp) const;
 
   /**
    * Return the greatest common divisor of this integer with another.
    */
-  Integer gcd(const Integer& y) const {
-    mpz_class result;
-    mpz_gcd(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer(result);
-  }
+  Integer gcd(const Integer& y) const;
 
   /**
    * Return the least common multiple of this integer with another.
    */
-  Integer lcm(const Integer& y) const {
-    mpz_class result;
-    mpz_lcm(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer(result);
-  }
+  Integer lcm(const Integer& y) const;
 
   /**
    * Compute addition of this Integer x + y modulo m.
@@ -421,7 +605,12 @@ public:
    * ! zero.divides(zero)
    */
   bool divides(const Integer& y) const {
-    int res = mpz_divisible_p(y.d_value.get_mpz_t(), d_value.get_mpz_t());
+    if (isSmall() && y.isSmall())
+    {
+      return d_small == 0 ? y.d_small == 0 : y.d_small % d_small == 0;
+    }
+    mpz_class tx, ty;
+    int res = mpz_divisible_p(y.toMpz(ty).get_mpz_t(), toMpz(tx).get_mpz_t());
     return res != 0;
   }
 
@@ -429,11 +618,15 @@ public:
    * Return the absolute value of this integer.
    */
   Integer abs() const {
-    return d_value >= 0 ? *this : -*this;
+    return sgn() >= 0 ? *this : -*this;
   }
 
   std::string toString(int base = 10) const{
-    return d_value.get_str(base);
+    if (isSmall() && base == 10)
+    {
+      return std::to_string(d_small);
+    }
+    return get_mpz().get_str(base);
   }
 
   bool fitsSignedInt() const;
@@ -449,17 +642,27 @@ public:
   bool fitsUnsignedLong() const;
 
   long getLong() const {
-    long si = d_value.get_si();
+    if (isSmall())
+    {
+      return d_small;
+    }
+    long si = d_big->get_si();
     // ensure there wasn't overflow
-    CheckArgument(mpz_cmp_si(d_value.get_mpz_t(), si) == 0, this,
+    CheckArgument(mpz_cmp_si(d_big->get_mpz_t(), si) == 0, this,
                  "Overflow detected in Integer::getLong().");
     return si;
   }
 
   unsigned long getUnsignedLong() const {
-    unsigned long ui = d_value.get_ui();
+    if (isSmall())
+    {
+      CheckArgument(d_small >= 0, this,
+                    "Overflow detected in Integer::getUnsignedLong().");
+      return d_small;
+    }
+    unsigned long ui = d_big->get_ui();
     // ensure there wasn't overflow
-    CheckArgument(mpz_cmp_ui(d_value.get_mpz_t(), ui) == 0, this,
+    CheckArgument(mpz_cmp_ui(d_big->get_mpz_t(), ui) == 0, this,
                   "Overflow detected in Integer::getUnsignedLong().");
     return ui;
   }
@@ -469,7 +672,11 @@ public:
    * numerator, the denominator.
    */
   size_t hash() const {
-    return gmpz_hash(d_value.get_mpz_t());
+    if (isSmall())
+    {
+      return gmpz_hash_ui(absSmall());
+    }
+    return gmpz_hash(d_big->get_mpz_t());
   }
 
   /**
@@ -479,41 +686,29 @@ public:
    * @return true if bit n is set in this integer; false otherwise
    */
   bool testBit(unsigned n) const {
-    return mpz_tstbit(d_value.get_mpz_t(), n);
+    if (isSmall())
+    {
+      // the two's complement of a negative value like mpz_tstbit
+      return n >= s_smallBits ? d_small < 0
+                              : (static_cast<unsigned long>(d_small) >> n) & 1;
+    }
+    return mpz_tstbit(d_big->get_mpz_t(), n);
   }
 
   /**
    * Returns k if the integer is equal to 2^(k-1)
    * @return k if the integer is equal to 2^(k-1) and 0 otherwise
    */
-  unsigned isPow2() const {
-    if (d_value <= 0) return 0;
-    // check that the number of ones in the binary representation is 1
-    if (mpz_popcount(d_value.get_mpz_t()) == 1) {
-      // return the index of the first one plus 1
-      return mpz_scan1(d_value.get_mpz_t(), 0) + 1;
-    }
-    return 0; 
-  }
+  unsigned isPow2() const;
+
 
-  
   /**
    * If x != 0, returns the smallest n s.t. 2^{n-1} <= abs(x) < 2^{n}.
    * If x == 0, returns 1.
    */
-  size_t length() const {
-    if(sgn() == 0){
-      return 1;
-    }else{
-      return mpz_sizeinbase(d_value.get_mpz_t(),2);
-    }
-  }
+  size_t length() const;
 
-  static void extendedGcd(Integer& g, Integer& s, Integer& t, const Integer& a, const Integer& b){
-    //see the documentation for:
-    //mpz_gcdext (mpz_t g, mpz_t s, mpz_t t, mpz_t a, mpz_t b);
-    mpz_gcdext (g.d_value.get_mpz_t(), s.d_value.get_mpz_t(), t.d_value.get_mpz_t(), a.d_value.get_mpz_t(), b.d_value.get_mpz_t());
-  }
+  static void extendedGcd(Integer& g, Integer& s, Integer& t, const Integer& a, const Integer& b);
 
   /** Returns a reference to the minimum of two integers. */
   static const Integer& min(const Integer& a, const Integer& b){
@@ -526,6 +721,54 @@ public:
   }
 
   friend class CVC4::Rational;
+
+ private:
+  /** The number of value bits of d_small. */
+  static const unsigned s_smallBits = std::numeric_limits<long>::digits;
+
+  /** The absolute value of a small value. */
+  unsigned long absSmall() const
+  {
+    return d_small < 0 ? -static_cast<unsigned long>(d_small) : d_small;
+  }
+
+  template <class T>
+  void setUnsigned(T z)
+  {
+    if (z <= static_cast<unsigned long>(std::numeric_limits<long>::max()))
+    {
+      d_small = static_cast<long>(z);
+    }
+    else
+    {
+      d_big = new mpz_class(static_cast<unsigned long>(z));
+    }
+  }
+
+  /** -1, 0 or 1 as this is less than, equal to or greater than y. */
+  int compare(const Integer& y) const
+  {
+    if (isSmall() && y.isSmall())
+    {
+      return d_small < y.d_small ? -1 : (d_small > y.d_small ? 1 : 0);
+    }
+    if (y.isSmall())
+    {
+      return mpz_cmp_si(d_big->get_mpz_t(), y.d_small);
+    }
+    if (isSmall())
+    {
+      return -mpz_cmp_si(y.d_big->get_mpz_t(), d_small);
+    }
+    return mpz_cmp(d_big->get_mpz_t(), y.d_big->get_mpz_t());
+  }
+
+  /** this + y or this - y in GMP. */
+  Integer addSlow(const Integer& y, bool subtract) const;
+  /** this * y in GMP. */
+  Integer mulSlow(const Integer& y) const;
+  /** The ceiling quotient and remainder of x divided by y. */
+  static void ceilingQR(Integer& q, Integer& r, const Integer& x, const Integer& y);
 };/* class Integer */
 
 struct IntegerHashFunction {
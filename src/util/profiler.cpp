@@ -0,0 +1,503 @@
+/*********************                                                        */
+/*! \file profiler.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A hierarchical profiler of code regions
+ **/
+
+#include "util/profiler.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "base/check.h"
+#include "lib/clock_gettime.h"
+#include "util/safe_print.h"
+
+namespace CVC4 {
+
+namespace {
+
+/** The maximal number of regions */
+const uint32_t MAX_REGIONS = 4096;
+/** The maximal number of nodes of the call tree of a thread */
+const uint32_t MAX_NODES = 8192;
+/** The maximal depth of the call tree of a thread */
+const uint32_t MAX_DEPTH = 256;
+/** The maximal number of profiled threads */
+const uint32_t MAX_THREADS = 64;
+/** The maximal number of calls in the trace of a thread */
+const size_t MAX_EVENTS = 1 << 20;
+/** The null node */
+const uint32_t NO_NODE = UINT32_MAX;
+
+/** A node of the call tree, i.e. a region entered from its parent */
+struct ProfileNode
+{
+  /** The region */
+  uint32_t d_region;
+  /** The parent node */
+  uint32_t d_parent;
+  /** The child created last */
+  std::atomic<uint32_t> d_firstChild;
+  /** The sibling created before this node */
+  uint32_t d_nextSibling;
+  /** The ticks spent in the completed calls */
+  std::atomic<uint64_t> d_ticks;
+  /** The number of completed calls */
+  std::atomic<uint64_t> d_calls;
+};
+
+/** A call of a region in a trace */
+struct TraceEvent
+{
+  /** The region */
+  uint32_t d_region;
+  /** The ticks when the region was entered and exited */
+  uint64_t d_begin;
+  uint64_t d_end;
+};
+
+/** The profile of a thread, which only this thread modifies */
+struct ThreadProfile
+{
+  ThreadProfile()
+      : d_numNodes(1), d_current(0), d_depth(0), d_lost(0), d_trace(0)
+  {
+    d_nodes[0].d_region = Profiler::UNREGISTERED;
+    d_nodes[0].d_parent = NO_NODE;
+    d_nodes[0].d_firstChild = NO_NODE;
+    d_nodes[0].d_nextSibling = NO_NODE;
+    d_nodes[0].d_ticks = 0;
+    d_nodes[0].d_calls = 0;
+  }
+  /** The nodes, where node 0 is the root */
+  ProfileNode d_nodes[MAX_NODES];
+  /** The number of nodes */
+  std::atomic<uint32_t> d_numNodes;
+  /** The node of the region entered last */
+  uint32_t d_current;
+  /** The start ticks of the regions on the stack */
+  uint64_t d_start[MAX_DEPTH];
+  /** The depth of the stack */
+  uint32_t d_depth;
+  /** The number of nested regions entered but not recorded */
+  uint32_t d_lost;
+  /** The calls recorded in the trace d_trace */
+  std::vector<TraceEvent> d_events;
+  /** The trace that d_events belong to */
+  std::atomic<uint32_t> d_trace;
+};
+
+/** The names of the regions */
+std::atomic<const char*> s_regionNames[MAX_REGIONS];
+/** The number of regions */
+std::atomic<uint32_t> s_numRegions(0);
+/** Maps names to regions, guarded by s_regionMutex */
+std::unordered_map<std::string, uint32_t> s_regions;
+std::mutex s_regionMutex;
+
+/** The profiles of the threads */
+std::atomic<ThreadProfile*> s_threads[MAX_THREADS];
+/** The number of threads that requested a profile */
+std::atomic<uint32_t> s_numThreads(0);
+
+/** The ticks and nanoseconds when profiling was first enabled */
+uint64_t s_startTicks = 0;
+uint64_t s_startNanos = 0;
+
+/** Whether a trace is being recorded */
+std::atomic<bool> s_tracing(false);
+/** The number of traces started, i.e. the current trace */
+std::atomic<uint32_t> s_traceId(0);
+/** The ticks when the current trace was started */
+uint64_t s_traceStartTicks = 0;
+
+uint64_t readNanos()
+{
+  timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return static_cast<uint64_t>(t.tv_sec) * 1000000000 + t.tv_nsec;
+}
+
+inline uint64_t readTicks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return readNanos();
+#endif
+}
+
+/** Get the profile of the current thread, or null if it has none */
+ThreadProfile* getThreadProfile()
+{
+  static thread_local ThreadProfile* t_profile = nullptr;
+  static thread_local bool t_init = false;
+  if (!t_init)
+  {
+    t_init = true;
+    uint32_t i = s_numThreads.fetch_add(1);
+    if (i < MAX_THREADS)
+    {
+      // never freed, so that it can be reported after the thread exits
+      t_profile = new ThreadProfile;
+      s_threads[i].store(t_profile, std::memory_order_release);
+    }
+  }
+  return t_profile;
+}
+
+/** Get the number of seconds per tick */
+double getSecondsPerTick()
+{
+  uint64_t ticks = readTicks() - s_startTicks;
+  uint64_t nanos = readNanos() - s_startNanos;
+  if (ticks == 0 || nanos < 1000000)
+  {
+    return 1e-9;
+  }
+  return 1e-9 * nanos / ticks;
+}
+
+/**
+ * Call visit(node, depth) for the nodes of the call tree of tp in depth-first
+ * order, except for the root.
+ */
+template <typename Visitor>
+void visitTree(const ThreadProfile* tp, Visitor visit)
+{
+  uint32_t stack[MAX_DEPTH + 1];
+  uint32_t depths[MAX_DEPTH + 1];
+  size_t size = 0;
+  uint32_t child =
+      tp->d_nodes[0].d_firstChild.load(std::memory_order_acquire);
+  while (true)
+  {
+    if (child != NO_NODE && size <= MAX_DEPTH)
+    {
+      const ProfileNode& node = tp->d_nodes[child];
+      uint32_t depth = size == 0 ? 1 : depths[size - 1] + 1;
+      visit(node, depth);
+      stack[size] = child;
+      depths[size] = depth;
+      ++size;
+      child = node.d_firstChild.load(std::memory_order_acquire);
+      continue;
+    }
+    if (size == 0)
+    {
+      break;
+    }
+    --size;
+    child = tp->d_nodes[stack[size]].d_nextSibling;
+  }
+}
+
+/**
+ * Record a call of the given region in the trace of tp, if it was entered
+ * after the trace started
+ */
+void recordEvent(ThreadProfile* tp,
+                 uint32_t region,
+                 uint64_t begin,
+                 uint64_t end)
+{
+  uint32_t trace = s_traceId.load(std::memory_order_acquire);
+  if (tp->d_trace.load(std::memory_order_relaxed) != trace)
+  {
+    tp->d_events.clear();
+    tp->d_trace.store(trace, std::memory_order_release);
+  }
+  if (begin >= s_traceStartTicks && tp->d_events.size() < MAX_EVENTS)
+  {
+    tp->d_events.push_back({region, begin, end});
+  }
+}
+
+/** Print the name as a JSON string */
+void printJsonName(std::ostream& out, const char* name)
+{
+  out << '"';
+  for (const char* c = name; *c != 0; ++c)
+  {
+    if (*c == '"' || *c == '\\')
+    {
+      out << '\\';
+    }
+    out << *c;
+  }
+  out << '"';
+}
+
+}  // namespace
+
+std::atomic<bool> Profiler::s_enabled(false);
+
+void Profiler::setEnabled(bool enabled)
+{
+  if (enabled && s_startNanos == 0)
+  {
+    s_startTicks = readTicks();
+    s_startNanos = readNanos();
+  }
+  s_enabled = enabled;
+}
+
+uint32_t Profiler::registerRegion(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(s_regionMutex);
+  std::unordered_map<std::string, uint32_t>::const_iterator it =
+      s_regions.find(name);
+  if (it != s_regions.end())
+  {
+    return it->second;
+  }
+  uint32_t region = s_numRegions.load(std::memory_order_relaxed);
+  if (region == MAX_REGIONS)
+  {
+    return UNREGISTERED;
+  }
+  // never freed, so that it can be reported from a signal handler
+  s_regionNames[region].store(strdup(name.c_str()), std::memory_order_release);
+  s_numRegions.store(region + 1, std::memory_order_release);
+  s_regions[name] = region;
+  return region;
+}
+
+void Profiler::enter(uint32_t region)
+{
+  ThreadProfile* tp = getThreadProfile();
+  if (tp == nullptr)
+  {
+    return;
+  }
+  if (tp->d_lost > 0 || region == UNREGISTERED || tp->d_depth == MAX_DEPTH)
+  {
+    ++tp->d_lost;
+    return;
+  }
+  ProfileNode& current = tp->d_nodes[tp->d_current];
+  uint32_t child = current.d_firstChild.load(std::memory_order_relaxed);
+  while (child != NO_NODE && tp->d_nodes[child].d_region != region)
+  {
+    child = tp->d_nodes[child].d_nextSibling;
+  }
+  if (child == NO_NODE)
+  {
+    child = tp->d_numNodes.load(std::memory_order_relaxed);
+    if (child == MAX_NODES)
+    {
+      ++tp->d_lost;
+      return;
+    }
+    ProfileNode& node = tp->d_nodes[child];
+    node.d_region = region;
+    node.d_parent = tp->d_current;
+    node.d_firstChild.store(NO_NODE, std::memory_order_relaxed);
+    node.d_nextSibling = current.d_firstChild.load(std::memory_order_relaxed);
+    node.d_ticks.store(0, std::memory_order_relaxed);
+    node.d_calls.store(0, std::memory_order_relaxed);
+    tp->d_numNodes.store(child + 1, std::memory_order_release);
+    current.d_firstChild.store(child, std::memory_order_release);
+  }
+  tp->d_current = child;
+  tp->d_start[tp->d_depth++] = readTicks();
+}
+
+void Profiler::exit()
+{
+  ThreadProfile* tp = getThreadProfile();
+  if (tp == nullptr)
+  {
+    return;
+  }
+  if (tp->d_lost > 0)
+  {
+    --tp->d_lost;
+    return;
+  }
+  Assert(tp->d_depth > 0);
+  uint64_t end = readTicks();
+  uint64_t begin = tp->d_start[--tp->d_depth];
+  uint64_t ticks = end - begin;
+  ProfileNode& node = tp->d_nodes[tp->d_current];
+  if (s_tracing.load(std::memory_order_relaxed))
+  {
+    recordEvent(tp, node.d_region, begin, end);
+  }
+  node.d_ticks.store(node.d_ticks.load(std::memory_order_relaxed) + ticks,
+                     std::memory_order_relaxed);
+  node.d_calls.store(node.d_calls.load(std::memory_order_relaxed) + 1,
+                     std::memory_order_relaxed);
+  tp->d_current = node.d_parent;
+}
+
+void Profiler::flush(std::ostream& out)
+{
+  double secondsPerTick = getSecondsPerTick();
+  uint32_t numThreads = std::min(s_numThreads.load(), MAX_THREADS);
+  for (uint32_t i = 0; i < numThreads; ++i)
+  {
+    const ThreadProfile* tp = s_threads[i].load(std::memory_order_acquire);
+    if (tp == nullptr)
+    {
+      continue;
+    }
+    out << "thread " << i << std::endl;
+    visitTree(tp, [&](const ProfileNode& node, uint32_t depth) {
+      out << std::string(2 * depth, ' ')
+          << s_regionNames[node.d_region].load(std::memory_order_acquire)
+          << ": " << std::fixed << std::setprecision(6)
+          << node.d_ticks.load(std::memory_order_relaxed) * secondsPerTick
+          << "s, " << node.d_calls.load(std::memory_order_relaxed)
+          << " calls" << std::endl;
+    });
+  }
+}
+
+void Profiler::safeFlush(int fd)
+{
+  double secondsPerTick = getSecondsPerTick();
+  uint32_t numThreads = std::min(s_numThreads.load(), MAX_THREADS);
+  for (uint32_t i = 0; i < numThreads; ++i)
+  {
+    const ThreadProfile* tp = s_threads[i].load(std::memory_order_acquire);
+    if (tp == nullptr)
+    {
+      continue;
+    }
+    safe_print(fd, "thread ");
+    safe_print<uint32_t>(fd, i);
+    safe_print(fd, "\n");
+    visitTree(tp, [&](const ProfileNode& node, uint32_t depth) {
+      for (uint32_t d = 0; d < depth; ++d)
+      {
+        safe_print(fd, "  ");
+      }
+      const char* name =
+          s_regionNames[node.d_region].load(std::memory_order_acquire);
+      if (write(fd, name, strlen(name)) < 0)
+      {
+        abort();
+      }
+      safe_print(fd, ": ");
+      safe_print<double>(
+          fd, node.d_ticks.load(std::memory_order_relaxed) * secondsPerTick);
+      safe_print(fd, "s, ");
+      safe_print<uint64_t>(fd, node.d_calls.load(std::memory_order_relaxed));
+      safe_print(fd, " calls\n");
+    });
+  }
+}
+
+SExpr Profiler::getValue()
+{
+  double secondsPerTick = getSecondsPerTick();
+  uint32_t numThreads = std::min(s_numThreads.load(), MAX_THREADS);
+  std::vector<SExpr> threads;
+  for (uint32_t i = 0; i < numThreads; ++i)
+  {
+    const ThreadProfile* tp = s_threads[i].load(std::memory_order_acquire);
+    if (tp == nullptr)
+    {
+      continue;
+    }
+    // the children of the nodes on the current path, by depth
+    std::vector<std::vector<SExpr>> levels(1);
+    std::vector<const ProfileNode*> path;
+    auto close = [&levels, &path, secondsPerTick](size_t depth) {
+      while (path.size() >= depth)
+      {
+        const ProfileNode* node = path.back();
+        path.pop_back();
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(6)
+           << node->d_ticks.load(std::memory_order_relaxed) * secondsPerTick;
+        std::vector<SExpr> v;
+        v.push_back(SExpr(std::string(
+            s_regionNames[node->d_region].load(std::memory_order_acquire))));
+        v.push_back(SExpr(Rational::fromDecimal(ss.str())));
+        v.push_back(SExpr(
+            Integer(node->d_calls.load(std::memory_order_relaxed))));
+        v.push_back(SExpr(levels.back()));
+        levels.pop_back();
+        levels.back().push_back(SExpr(v));
+      }
+    };
+    visitTree(tp, [&](const ProfileNode& node, uint32_t depth) {
+      close(depth);
+      path.push_back(&node);
+      levels.emplace_back();
+    });
+    close(1);
+    std::vector<SExpr> t;
+    t.push_back(SExpr("thread " + std::to_string(i)));
+    t.push_back(SExpr(levels[0]));
+    threads.push_back(SExpr(t));
+  }
+  return SExpr(threads);
+}
+
+bool Profiler::beginTrace()
+{
+  bool tracing = false;
+  if (!s_tracing.compare_exchange_strong(tracing, true))
+  {
+    return false;
+  }
+  s_traceStartTicks = readTicks();
+  s_traceId.fetch_add(1, std::memory_order_release);
+  return true;
+}
+
+void Profiler::endTrace() { s_tracing.store(false); }
+
+void Profiler::writeTrace(std::ostream& out)
+{
+  double microsPerTick = 1e6 * getSecondsPerTick();
+  uint32_t trace = s_traceId.load(std::memory_order_acquire);
+  uint32_t numThreads = std::min(s_numThreads.load(), MAX_THREADS);
+  out << "{\"traceEvents\": [";
+  bool first = true;
+  for (uint32_t i = 0; i < numThreads; ++i)
+  {
+    const ThreadProfile* tp = s_threads[i].load(std::memory_order_acquire);
+    if (tp == nullptr || tp->d_trace.load(std::memory_order_acquire) != trace)
+    {
+      continue;
+    }
+    for (const TraceEvent& e : tp->d_events)
+    {
+      out << (first ? "" : ",") << std::endl << "{\"name\": ";
+      first = false;
+      printJsonName(out,
+                    s_regionNames[e.d_region].load(std::memory_order_acquire));
+      out << ", \"ph\": \"X\", \"pid\": 0, \"tid\": " << i << std::fixed
+          << std::setprecision(3) << ", \"ts\": "
+          << (e.d_begin - s_traceStartTicks) * microsPerTick
+          << ", \"dur\": " << (e.d_end - e.d_begin) * microsPerTick << "}";
+    }
+  }
+  out << std::endl << "], \"displayTimeUnit\": \"ms\"}" << std::endl;
+}
+
+}  // namespace CVC4
@@ -0,0 +1,125 @@
+/*********************                                                        */
+/*! \file profiler.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A hierarchical profiler of code regions
+ **
+ ** A low-overhead profiler that records the time spent in nested code regions
+ ** as a call tree per thread. The regions are those of the timers used via
+ ** CodeTimer, and others registered explicitly. Time is measured with the time
+ ** stamp counter where available. The profiler can also record a trace of the
+ ** calls of the regions, in Chrome trace format.
+ **/
+
+#include "cvc4_private_library.h"
+
+#ifndef CVC4__UTIL__PROFILER_H
+#define CVC4__UTIL__PROFILER_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <iosfwd>
+#include <string>
+
+#include "util/sexpr.h"
+
+namespace CVC4 {
+
+/**
+ * The profiler. Each thread records the regions it enters in its own fixed
+ * size buffer, which is never reallocated or freed, so that the profile can
+ * be reported from a signal handler, or from another thread while a query is
+ * running. Nodes that do not fit are not recorded, their time is attributed
+ * to their parent.
+ */
+class CVC4_PUBLIC Profiler
+{
+ public:
+  /** The identifier of a region that is not registered */
+  static const uint32_t UNREGISTERED = UINT32_MAX;
+
+  /** Enable or disable profiling */
+  static void setEnabled(bool enabled);
+  /** Is profiling enabled? */
+  static bool isEnabled()
+  {
+    return s_enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Register the region with the given name, and return its identifier.
+   * Registering the same name again returns the same identifier. Returns
+   * UNREGISTERED if there are too many regions.
+   */
+  static uint32_t registerRegion(const std::string& name);
+
+  /** Enter the region with the given identifier on the current thread */
+  static void enter(uint32_t region);
+  /** Exit the region entered last on the current thread */
+  static void exit();
+
+  /** Print the profile as a tree */
+  static void flush(std::ostream& out);
+  /** Print the profile as a tree. Safe to use in a signal handler. */
+  static void safeFlush(int fd);
+  /** Get the profile as a tree (region, seconds, calls, children) */
+  static SExpr getValue();
+
+  /**
+   * Start recording a trace of the calls of the regions on all threads,
+   * discarding the trace recorded before. Returns false if a trace is being
+   * recorded already, in which case nothing is done.
+   */
+  static bool beginTrace();
+  /** Stop recording the trace */
+  static void endTrace();
+  /**
+   * Write the trace recorded last in Chrome trace format, as read by
+   * chrome://tracing and Perfetto. Must not be called while other threads
+   * record a trace.
+   */
+  static void writeTrace(std::ostream& out);
+
+ private:
+  /**
+   * Whether profiling is enabled. It is read by every ProfileScope on any
+   * thread, and may be set while other threads run.
+   */
+  static std::atomic<bool> s_enabled;
+}; /* class Profiler */
+
+/** Enters a region on construction and exits it on destruction */
+class ProfileScope
+{
+ public:
+  ProfileScope(uint32_t region) : d_active(Profiler::isEnabled())
+  {
+    if (d_active)
+    {
+      Profiler::enter(region);
+    }
+  }
+  ~ProfileScope()
+  {
+    if (d_active)
+    {
+      Profiler::exit();
+    }
+  }
+
+ private:
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+  /** Whether the region was entered */
+  bool d_active;
+}; /* class ProfileScope */
+
+}  // namespace CVC4
+
+#endif /* CVC4__UTIL__PROFILER_H */
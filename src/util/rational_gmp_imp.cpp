@@ -16,6 +16,9 @@
 #include "util/rational.h"
 
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
 #include <sstream>
 #include <string>
 
@@ -29,6 +32,188 @@
 
 namespace CVC4 {
 
+namespace {
+
+/** The greatest common divisor of a and b. */
+unsigned long gcdSmall(unsigned long a, unsigned long b)
+{
+  while (b != 0)
+  {
+    unsigned long t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+unsigned long absSmall(long a)
+{
+  return a < 0 ? -static_cast<unsigned long>(a) : a;
+}
+
+}  // namespace
+
+Rational::Rational(const char* s, unsigned base)
+    : d_num(0), d_den(1), d_big(nullptr)
+{
+  mpq_class val(s, base);
+  val.canonicalize();
+  setMpq(val);
+}
+
+Rational::Rational(const std::string& s, unsigned base)
+    : d_num(0), d_den(1), d_big(nullptr)
+{
+  mpq_class val(s, base);
+  val.canonicalize();
+  setMpq(val);
+}
+
+void Rational::setMpq(mpq_class& val)
+{
+  mpz_srcptr num = val.get_num_mpz_t();
+  mpz_srcptr den = val.get_den_mpz_t();
+  if (mpz_fits_slong_p(num) && mpz_fits_slong_p(den)
+      && Integer::fitsSmall(mpz_get_si(num)))
+  {
+    delete d_big;
+    d_big = nullptr;
+    d_num = mpz_get_si(num);
+    d_den = mpz_get_si(den);
+  }
+  else
+  {
+    if (isSmall())
+    {
+      d_big = new mpq_class();
+    }
+    mpq_swap(d_big->get_mpq_t(), val.get_mpq_t());
+  }
+}
+
+void Rational::setFraction(long n, long d)
+{
+  // a zero denominator is left to GMP
+  if (d == 0 || !Integer::fitsSmall(n) || !Integer::fitsSmall(d))
+  {
+    mpq_class val(n, d);
+    val.canonicalize();
+    setMpq(val);
+    return;
+  }
+  if (d < 0)
+  {
+    n = -n;
+    d = -d;
+  }
+  long g = static_cast<long>(gcdSmall(absSmall(n), d));
+  delete d_big;
+  d_big = nullptr;
+  d_num = n / g;
+  d_den = d / g;
+}
+
+bool Rational::addFraction(
+    long an, long ad, long bn, long bd, long& rn, long& rd)
+{
+  // see Knuth, TAOCP Vol. 2, 4.5.1: with g = gcd(ad, bd), the gcd of the
+  // result only has factors of g
+  long g = static_cast<long>(gcdSmall(ad, bd));
+  long x, y, t;
+  if (!Integer::mulSmall(an, bd / g, x) || !Integer::mulSmall(bn, ad / g, y)
+      || !Integer::addSmall(x, y, t))
+  {
+    return false;
+  }
+  if (t == 0)
+  {
+    rn = 0;
+    rd = 1;
+    return true;
+  }
+  long g2 = g == 1 ? 1 : static_cast<long>(gcdSmall(absSmall(t), g));
+  long d;
+  if (!Integer::mulSmall(ad / g, bd / g2, d))
+  {
+    return false;
+  }
+  rn = t / g2;
+  rd = d;
+  return true;
+}
+
+bool Rational::mulFraction(
+    long an, long ad, long bn, long bd, long& rn, long& rd)
+{
+  if (an == 0 || bn == 0)
+  {
+    rn = 0;
+    rd = 1;
+    return true;
+  }
+  // cancel the common factors across the operands, which keeps the result
+  // canonical
+  long g1 = static_cast<long>(gcdSmall(absSmall(an), bd));
+  long g2 = static_cast<long>(gcdSmall(absSmall(bn), ad));
+  long n, d;
+  if (!Integer::mulSmall(an / g1, bn / g2, n)
+      || !Integer::mulSmall(ad / g2, bd / g1, d))
+  {
+    return false;
+  }
+  rn = n;
+  rd = d;
+  return true;
+}
+
+Rational Rational::addSlow(const Rational& y, bool subtract) const
+{
+  mpq_class tx, ty, res;
+  if (subtract)
+  {
+    mpq_sub(res.get_mpq_t(), toMpq(tx).get_mpq_t(), y.toMpq(ty).get_mpq_t());
+  }
+  else
+  {
+    mpq_add(res.get_mpq_t(), toMpq(tx).get_mpq_t(), y.toMpq(ty).get_mpq_t());
+  }
+  return fromMpq(res);
+}
+
+Rational Rational::mulSlow(const Rational& y, bool divide) const
+{
+  mpq_class tx, ty, res;
+  if (divide)
+  {
+    mpq_div(res.get_mpq_t(), toMpq(tx).get_mpq_t(), y.toMpq(ty).get_mpq_t());
+  }
+  else
+  {
+    mpq_mul(res.get_mpq_t(), toMpq(tx).get_mpq_t(), y.toMpq(ty).get_mpq_t());
+  }
+  return fromMpq(res);
+}
+
+int Rational::cmpSlow(const Rational& x) const
+{
+  //Don't use mpq_class's cmp() function.
+  //The name ends up conflicting with this function.
+  mpq_class tx, ty;
+  return mpq_cmp(toMpq(tx).get_mpq_t(), x.toMpq(ty).get_mpq_t());
+}
+
+Rational& Rational::addProduct(const Rational& a, const Rational& b)
+{
+  long pn, pd;
+  if (isSmall() && a.isSmall() && b.isSmall()
+      && mulSmall(a.d_num, a.d_den, b.d_num, b.d_den, pn, pd)
+      && addSmall(d_num, d_den, pn, pd, d_num, d_den))
+  {
+    return *this;
+  }
+  return *this += a * b;
+}
+
 std::ostream& operator<<(std::ostream& os, const Rational& q){
   return os << q.toString();
 }
@@ -91,9 +276,9 @@ Maybe<Rational> Rational::fromDouble(double d)
 {
   using namespace std;
   if(isfinite(d)){
-    Rational q;
-    mpq_set_d(q.d_value.get_mpq_t(), d);
-    return q;
+    mpq_class q;
+    mpq_set_d(q.get_mpq_t(), d);
+    return fromMpq(q);
   }
   return Maybe<Rational>();
 }
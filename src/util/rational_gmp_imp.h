@@ -28,6 +28,7 @@
 #include <cstddef>
 
 #include <gmp.h>
+#include <limits>
 #include <string>
 
 #include "base/exception.h"
@@ -54,10 +55,20 @@ namespace CVC4 {
 class CVC4_PUBLIC Rational {
 private:
   /**
-   * Stores the value of the rational is stored in a C++ GMP rational class.
-   * Using this instead of mpq_t allows for easier destruction.
+   * The numerator and denominator if d_big is null. The denominator is
+   * positive, and neither is LONG_MIN.
    */
-  mpq_class d_value;
+  long d_num;
+  long d_den;
+
+  /**
+   * Stores the value of the rational if it does not fit into d_num and
+   * d_den, in a C++ GMP rational class. The representation is canonical:
+   * d_big is null iff the value fits.
+   */
+  mpq_class* d_big;
+
+  bool isSmall() const { return d_big == nullptr; }
 
   /**
    * Constructs a Rational from a mpq_class object.
@@ -65,7 +76,103 @@ private:
    * Assumes that the value is in canonical form, and thus does not
    * have to call canonicalize() on the value.
    */
-  Rational(const mpq_class& val) : d_value(val) {  }
+  Rational(const mpq_class& val) : d_num(0), d_den(1), d_big(nullptr)
+  {
+    mpq_class tmp(val);
+    setMpq(tmp);
+  }
+
+  /** The value as a GMP rational, in tmp if it is small. */
+  const mpq_class& toMpq(mpq_class& tmp) const
+  {
+    if (isSmall())
+    {
+      mpq_set_si(tmp.get_mpq_t(), d_num, d_den);
+      return tmp;
+    }
+    return *d_big;
+  }
+
+  /** Take the canonical value of val, leaving val in an unspecified state. */
+  void setMpq(mpq_class& val);
+
+  /** Set the value to n/d, which is canonicalized. */
+  void setFraction(long n, long d);
+
+  template <class T>
+  void setUnsignedFraction(T n, T d)
+  {
+    const unsigned long max = std::numeric_limits<long>::max();
+    if (n <= max && d <= max)
+    {
+      setFraction(static_cast<long>(n), static_cast<long>(d));
+    }
+    else
+    {
+      mpq_class val(static_cast<unsigned long>(n), static_cast<unsigned long>(d));
+      val.canonicalize();
+      setMpq(val);
+    }
+  }
+
+  /** Constructs a Rational from a result of GMP, which is consumed. */
+  static Rational fromMpq(mpq_class& val)
+  {
+    Rational res;
+    res.setMpq(val);
+    return res;
+  }
+
+  /**
+   * rn/rd = an/ad + bn/bd for canonical small operands, returns false if the
+   * result does not fit.
+   */
+  static bool addSmall(long an, long ad, long bn, long bd, long& rn, long& rd)
+  {
+    if (ad == 1 && bd == 1)
+    {
+      long r;
+      if (!Integer::addSmall(an, bn, r))
+      {
+        return false;
+      }
+      rn = r;
+      rd = 1;
+      return true;
+    }
+    return addFraction(an, ad, bn, bd, rn, rd);
+  }
+  static bool addFraction(
+      long an, long ad, long bn, long bd, long& rn, long& rd);
+
+  /**
+   * rn/rd = an/ad * bn/bd for canonical small operands, returns false if the
+   * result does not fit.
+   */
+  static bool mulSmall(long an, long ad, long bn, long bd, long& rn, long& rd)
+  {
+    if (ad == 1 && bd == 1)
+    {
+      long r;
+      if (!Integer::mulSmall(an, bn, r))
+      {
+        return false;
+      }
+      rn = r;
+      rd = 1;
+      return true;
+    }
+    return mulFraction(an, ad, bn, bd, rn, rd);
+  }
+  static bool mulFraction(
+      long an, long ad, long bn, long bd, long& rn, long& rd);
+
+  /** this + y or this - y in GMP. */
+  Rational addSlow(const Rational& y, bool subtract) const;
+  /** this * y or this / y in GMP. */
+  Rational mulSlow(const Rational& y, bool divide) const;
+  /** Compare in GMP. */
+  int cmpSlow(const Rational& x) const;
 
 public:
 
@@ -78,9 +185,7 @@ public:
   static Rational fromDecimal(const std::string& dec);
 
   /** Constructs a rational with the value 0/1. */
-  Rational() : d_value(0){
-    d_value.canonicalize();
-  }
+  Rational() : d_num(0), d_den(1), d_big(nullptr) {}
 
   /**
    * Constructs a Rational from a C string in a given base (defaults to 10).
@@ -89,88 +194,116 @@ public:
    * For more information about what is a valid rational string,
    * see GMP's documentation for mpq_set_str().
    */
-  explicit Rational(const char* s, unsigned base = 10): d_value(s, base) {
-    d_value.canonicalize();
-  }
-  Rational(const std::string& s, unsigned base = 10) : d_value(s, base) {
-    d_value.canonicalize();
-  }
+  explicit Rational(const char* s, unsigned base = 10);
+  Rational(const std::string& s, unsigned base = 10);
 
   /**
    * Creates a Rational from another Rational, q, by performing a deep copy.
    */
-  Rational(const Rational& q) : d_value(q.d_value) {
-    d_value.canonicalize();
+  Rational(const Rational& q)
+      : d_num(q.d_num),
+        d_den(q.d_den),
+        d_big(q.isSmall() ? nullptr : new mpq_class(*q.d_big))
+  {
+  }
+
+  Rational(Rational&& q) : d_num(q.d_num), d_den(q.d_den), d_big(q.d_big)
+  {
+    q.d_num = 0;
+    q.d_den = 1;
+    q.d_big = nullptr;
   }
 
   /**
    * Constructs a canonical Rational from a numerator.
    */
-  Rational(signed int n) : d_value(n,1) {
-    d_value.canonicalize();
+  Rational(signed int n) : d_num(0), d_den(1), d_big(nullptr)
+  {
+    setFraction(n, 1);
   }
-  Rational(unsigned int n) : d_value(n,1) {
-    d_value.canonicalize();
+  Rational(unsigned int n) : d_num(0), d_den(1), d_big(nullptr)
+  {
+    setUnsignedFraction(n, 1u);
   }
-  Rational(signed long int n) : d_value(n,1) {
-    d_value.canonicalize();
+  Rational(signed long int n) : d_num(0), d_den(1), d_big(nullptr)
+  {
+    setFraction(n, 1);
   }
-  Rational(unsigned long int n) : d_value(n,1) {
-    d_value.canonicalize();
+  Rational(unsigned long int n) : d_num(0), d_den(1), d_big(nullptr)
+  {
+    setUnsignedFraction(n, 1ul);
   }
 
 #ifdef CVC4_NEED_INT64_T_OVERLOADS
-  Rational(int64_t n) : d_value(static_cast<long>(n), 1) {
-    d_value.canonicalize();
-  }
-  Rational(uint64_t n) : d_value(static_cast<unsigned long>(n), 1) {
-    d_value.canonicalize();
-  }
+  Rational(int64_t n) : Rational(static_cast<long>(n)) {}
+  Rational(uint64_t n) : Rational(static_cast<unsigned long>(n)) {}
 #endif /* CVC4_NEED_INT64_T_OVERLOADS */
 
   /**
    * Constructs a canonical Rational from a numerator and denominator.
    */
-  Rational(signed int n, signed int d) : d_value(n,d) {
-    d_value.canonicalize();
+  Rational(signed int n, signed int d) : d_num(0), d_den(1), d_big(nullptr)
+  {
+    setFraction(n, d);
   }
-  Rational(unsigned int n, unsigned int d) : d_value(n,d) {
-    d_value.canonicalize();
+  Rational(unsigned int n, unsigned int d)
+      : d_num(0), d_den(1), d_big(nullptr)
+  {
+    setUnsignedFraction(n, d);
   }
-  Rational(signed long int n, signed long int d) : d_value(n,d) {
-    d_value.canonicalize();
+  Rational(signed long int n, signed long int d)
+      : d_num(0), d_den(1), d_big(nullptr)
+  {
+    setFraction(n, d);
   }
-  Rational(unsigned long int n, unsigned long int d) : d_value(n,d) {
-    d_value.canonicalize();
+  Rational(unsigned long int n, unsigned long int d)
+      : d_num(0), d_den(1), d_big(nullptr)
+  {
+    setUnsignedFraction(n, d);
   }
 
 #ifdef CVC4_NEED_INT64_T_OVERLOADS
-  Rational(int64_t n, int64_t d) : d_value(static_cast<long>(n), static_cast<long>(d)) {
-    d_value.canonicalize();
+  Rational(int64_t n, int64_t d)
+      : Rational(static_cast<long>(n), static_cast<long>(d))
+  {
   }
-  Rational(uint64_t n, uint64_t d) : d_value(static_cast<unsigned long>(n), static_cast<unsigned long>(d)) {
-    d_value.canonicalize();
+  Rational(uint64_t n, uint64_t d)
+      : Rational(static_cast<unsigned long>(n), static_cast<unsigned long>(d))
+  {
   }
 #endif /* CVC4_NEED_INT64_T_OVERLOADS */
 
-  Rational(const Integer& n, const Integer& d) :
-    d_value(n.get_mpz(), d.get_mpz())
+  Rational(const Integer& n, const Integer& d)
+      : d_num(0), d_den(1), d_big(nullptr)
   {
-    d_value.canonicalize();
+    if (n.isSmall() && d.isSmall())
+    {
+      setFraction(n.d_small, d.d_small);
+    }
+    else
+    {
+      mpq_class val(n.get_mpz(), d.get_mpz());
+      val.canonicalize();
+      setMpq(val);
+    }
   }
-  Rational(const Integer& n) :
-    d_value(n.get_mpz())
+  Rational(const Integer& n) : d_num(n.d_small), d_den(1), d_big(nullptr)
   {
-    d_value.canonicalize();
+    if (!n.isSmall())
+    {
+      d_num = 0;
+      d_big = new mpq_class(*n.d_big);
+    }
   }
-  ~Rational() {}
+  ~Rational() { delete d_big; }
 
   /**
    * Returns a copy of d_value to enable public access of GMP data.
    */
   mpq_class getValue() const
   {
-    return d_value;
+    mpq_class tmp;
+    return toMpq(tmp);
   }
 
   /**
@@ -178,7 +311,11 @@ public:
    * Note that this makes a deep copy of the numerator.
    */
   Integer getNumerator() const {
-    return Integer(d_value.get_num());
+    if (isSmall())
+    {
+      return Integer(d_num);
+    }
+    return Integer(d_big->get_num());
   }
 
   /**
@@ -186,7 +323,11 @@ public:
    * Note that this makes a deep copy of the denominator.
    */
   Integer getDenominator() const {
-    return Integer(d_value.get_den());
+    if (isSmall())
+    {
+      return Integer(d_den);
+    }
+    return Integer(d_big->get_den());
   }
 
   static Maybe<Rational> fromDouble(double d);
@@ -197,7 +338,8 @@ public:
    * infinity, and underflow may result in zero.
    */
   double getDouble() const {
-    return d_value.get_d();
+    mpq_class tmp;
+    return toMpq(tmp).get_d();
   }
 
   Rational inverse() const {
@@ -205,13 +347,30 @@ public:
   }
 
   int cmp(const Rational& x) const {
-    //Don't use mpq_class's cmp() function.
-    //The name ends up conflicting with this function.
-    return mpq_cmp(d_value.get_mpq_t(), x.d_value.get_mpq_t());
+    if (isSmall() && x.isSmall())
+    {
+      long l, r;
+      if (d_den == x.d_den)
+      {
+        l = d_num;
+        r = x.d_num;
+      }
+      else if (!Integer::mulSmall(d_num, x.d_den, l)
+               || !Integer::mulSmall(x.d_num, d_den, r))
+      {
+        return cmpSlow(x);
+      }
+      return l < r ? -1 : (l > r ? 1 : 0);
+    }
+    return cmpSlow(x);
   }
 
   int sgn() const {
-    return mpq_sgn(d_value.get_mpq_t());
+    if (isSmall())
+    {
+      return d_num > 0 ? 1 : (d_num < 0 ? -1 : 0);
+    }
+    return mpq_sgn(d_big->get_mpq_t());
   }
 
   bool isZero() const {
@@ -219,11 +378,11 @@ public:
   }
 
   bool isOne() const {
-    return mpq_cmp_si(d_value.get_mpq_t(), 1, 1) == 0;
+    return isSmall() && d_num == 1 && d_den == 1;
   }
 
   bool isNegativeOne() const {
-    return mpq_cmp_si(d_value.get_mpq_t(), -1, 1) == 0;
+    return isSmall() && d_num == -1 && d_den == 1;
   }
 
   Rational abs() const {
@@ -235,14 +394,22 @@ public:
   }
 
   Integer floor() const {
+    if (isSmall())
+    {
+      return Integer(d_num).floorDivideQuotient(Integer(d_den));
+    }
     mpz_class q;
-    mpz_fdiv_q(q.get_mpz_t(), d_value.get_num_mpz_t(), d_value.get_den_mpz_t());
+    mpz_fdiv_q(q.get_mpz_t(), d_big->get_num_mpz_t(), d_big->get_den_mpz_t());
     return Integer(q);
   }
 
   Integer ceiling() const {
+    if (isSmall())
+    {
+      return Integer(d_num).ceilingDivideQuotient(Integer(d_den));
+    }
     mpz_class q;
-    mpz_cdiv_q(q.get_mpz_t(), d_value.get_num_mpz_t(), d_value.get_den_mpz_t());
+    mpz_cdiv_q(q.get_mpz_t(), d_big->get_num_mpz_t(), d_big->get_den_mpz_t());
     return Integer(q);
   }
 
@@ -252,78 +419,177 @@ public:
 
   Rational& operator=(const Rational& x){
     if(this == &x) return *this;
-    d_value = x.d_value;
+    if (x.isSmall())
+    {
+      delete d_big;
+      d_big = nullptr;
+      d_num = x.d_num;
+      d_den = x.d_den;
+    }
+    else if (isSmall())
+    {
+      d_big = new mpq_class(*x.d_big);
+    }
+    else
+    {
+      *d_big = *x.d_big;
+    }
+    return *this;
+  }
+
+  Rational& operator=(Rational&& x)
+  {
+    if (this == &x) return *this;
+    delete d_big;
+    d_num = x.d_num;
+    d_den = x.d_den;
+    d_big = x.d_big;
+    x.d_num = 0;
+    x.d_den = 1;
+    x.d_big = nullptr;
     return *this;
   }
 
   Rational operator-() const{
-    return Rational(-(d_value));
+    if (isSmall())
+    {
+      Rational res;
+      res.d_num = -d_num;
+      res.d_den = d_den;
+      return res;
+    }
+    mpq_class res = -(*d_big);
+    return fromMpq(res);
   }
 
   bool operator==(const Rational& y) const {
-    return d_value == y.d_value;
+    if (isSmall() || y.isSmall())
+    {
+      // the representation is canonical
+      return isSmall() && y.isSmall() && d_num == y.d_num && d_den == y.d_den;
+    }
+    return *d_big == *y.d_big;
   }
 
   bool operator!=(const Rational& y) const {
-    return d_value != y.d_value;
+    return !(*this == y);
   }
 
   bool operator< (const Rational& y) const {
-    return d_value < y.d_value;
+    return cmp(y) < 0;
   }
 
   bool operator<=(const Rational& y) const {
-    return d_value <= y.d_value;
+    return cmp(y) <= 0;
   }
 
   bool operator> (const Rational& y) const {
-    return d_value > y.d_value;
+    return cmp(y) > 0;
   }
 
   bool operator>=(const Rational& y) const {
-    return d_value >= y.d_value;
+    return cmp(y) >= 0;
   }
 
   Rational operator+(const Rational& y) const{
-    return Rational( d_value + y.d_value );
+    Rational res;
+    if (isSmall() && y.isSmall()
+        && addSmall(d_num, d_den, y.d_num, y.d_den, res.d_num, res.d_den))
+    {
+      return res;
+    }
+    return addSlow(y, false);
   }
   Rational operator-(const Rational& y) const {
-    return Rational( d_value - y.d_value );
+    Rational res;
+    if (isSmall() && y.isSmall()
+        && addSmall(d_num, d_den, -y.d_num, y.d_den, res.d_num, res.d_den))
+    {
+      return res;
+    }
+    return addSlow(y, true);
   }
 
   Rational operator*(const Rational& y) const {
-    return Rational( d_value * y.d_value );
+    Rational res;
+    if (isSmall() && y.isSmall()
+        && mulSmall(d_num, d_den, y.d_num, y.d_den, res.d_num, res.d_den))
+    {
+      return res;
+    }
+    return mulSlow(y, false);
   }
   Rational operator/(const Rational& y) const {
-    return Rational( d_value / y.d_value );
+    Rational res;
+    // division by zero is left to GMP
+    if (isSmall() && y.isSmall() && y.d_num != 0
+        && mulSmall(d_num,
+                    d_den,
+                    y.d_num < 0 ? -y.d_den : y.d_den,
+                    y.d_num < 0 ? -y.d_num : y.d_num,
+                    res.d_num,
+                    res.d_den))
+    {
+      return res;
+    }
+    return mulSlow(y, true);
   }
 
   Rational& operator+=(const Rational& y){
-    d_value += y.d_value;
-    return (*this);
+    if (isSmall() && y.isSmall()
+        && addSmall(d_num, d_den, y.d_num, y.d_den, d_num, d_den))
+    {
+      return *this;
+    }
+    return *this = addSlow(y, false);
   }
   Rational& operator-=(const Rational& y){
-    d_value -= y.d_value;
-    return (*this);
+    if (isSmall() && y.isSmall()
+        && addSmall(d_num, d_den, -y.d_num, y.d_den, d_num, d_den))
+    {
+      return *this;
+    }
+    return *this = addSlow(y, true);
   }
 
   Rational& operator*=(const Rational& y){
-    d_value *= y.d_value;
-    return (*this);
+    if (isSmall() && y.isSmall()
+        && mulSmall(d_num, d_den, y.d_num, y.d_den, d_num, d_den))
+    {
+      return *this;
+    }
+    return *this = mulSlow(y, false);
   }
 
   Rational& operator/=(const Rational& y){
-    d_value /= y.d_value;
-    return (*this);
+    return *this = *this / y;
   }
 
+  /**
+   * Computes this += a * b. If the numerators and denominators of the
+   * operands and of the result fit into a machine word, this is done in
+   * machine arithmetic and does not allocate; otherwise it falls back to GMP.
+   */
+  Rational& addProduct(const Rational& a, const Rational& b);
+
   bool isIntegral() const{
-    return getDenominator() == 1;
+    if (isSmall())
+    {
+      return d_den == 1;
+    }
+    return mpz_cmp_ui(d_big->get_den_mpz_t(), 1) == 0;
   }
 
   /** Returns a string representing the rational in the given base. */
   std::string toString(int base = 10) const {
-    return d_value.get_str(base);
+    if (isSmall() && base == 10)
+    {
+      return d_den == 1
+                 ? std::to_string(d_num)
+                 : std::to_string(d_num) + "/" + std::to_string(d_den);
+    }
+    mpq_class tmp;
+    return toMpq(tmp).get_str(base);
   }
 
   /**
@@ -331,8 +597,14 @@ public:
    * denominator.
    */
   size_t hash() const {
-    size_t numeratorHash = gmpz_hash(d_value.get_num_mpz_t());
-    size_t denominatorHash = gmpz_hash(d_value.get_den_mpz_t());
+    if (isSmall())
+    {
+      unsigned long absNum =
+          d_num < 0 ? -static_cast<unsigned long>(d_num) : d_num;
+      return gmpz_hash_ui(absNum) xor gmpz_hash_ui(d_den);
+    }
+    size_t numeratorHash = gmpz_hash(d_big->get_num_mpz_t());
+    size_t denominatorHash = gmpz_hash(d_big->get_den_mpz_t());
 
     return numeratorHash xor denominatorHash;
   }
@@ -22,6 +22,7 @@
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <utility>
 
 #include "base/check.h"
 #include "base/exception.h"
@@ -68,6 +69,16 @@ String::String(const std::vector<unsigned> &s) : d_str(s)
 #endif
 }
 
+String::String(std::vector<unsigned>&& s) : d_str(std::move(s))
+{
+#ifdef CVC4_ASSERTIONS
+  for (unsigned u : d_str)
+  {
+    Assert(convertUnsignedIntToCode(u) < num_codes());
+  }
+#endif
+}
+
 int String::cmp(const String &y) const {
   if (size() != y.size()) {
     return size() < y.size() ? -1 : 1;
@@ -83,9 +94,11 @@ int String::cmp(const String &y) const {
 }
 
 String String::concat(const String &other) const {
-  std::vector<unsigned int> ret_vec(d_str);
+  std::vector<unsigned int> ret_vec;
+  ret_vec.reserve(size() + other.size());
+  ret_vec.insert(ret_vec.end(), d_str.begin(), d_str.end());
   ret_vec.insert(ret_vec.end(), other.d_str.begin(), other.d_str.end());
-  return String(ret_vec);
+  return String(std::move(ret_vec));
 }
 
 bool String::strncmp(const String &y, const std::size_t np) const {
@@ -435,10 +448,11 @@ String String::replace(const String &s, const String &t) const {
   std::size_t ret = find(s);
   if (ret != std::string::npos) {
     std::vector<unsigned int> vec;
+    vec.reserve(size() - s.size() + t.size());
     vec.insert(vec.begin(), d_str.begin(), d_str.begin() + ret);
     vec.insert(vec.end(), t.d_str.begin(), t.d_str.end());
     vec.insert(vec.end(), d_str.begin() + ret + s.size(), d_str.end());
-    return String(vec);
+    return String(std::move(vec));
   } else {
     return *this;
   }
@@ -446,18 +460,15 @@ String String::replace(const String &s, const String &t) const {
 
 String String::substr(std::size_t i) const {
   Assert(i <= size());
-  std::vector<unsigned int> ret_vec;
-  std::vector<unsigned int>::const_iterator itr = d_str.begin() + i;
-  ret_vec.insert(ret_vec.end(), itr, d_str.end());
-  return String(ret_vec);
+  std::vector<unsigned int> ret_vec(d_str.begin() + i, d_str.end());
+  return String(std::move(ret_vec));
 }
 
 String String::substr(std::size_t i, std::size_t j) const {
   Assert(i + j <= size());
-  std::vector<unsigned int> ret_vec;
   std::vector<unsigned int>::const_iterator itr = d_str.begin() + i;
-  ret_vec.insert(ret_vec.end(), itr, itr + j);
-  return String(ret_vec);
+  std::vector<unsigned int> ret_vec(itr, itr + j);
+  return String(std::move(ret_vec));
 }
 
 bool String::isNumber() const {
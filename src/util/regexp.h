@@ -25,6 +25,7 @@
 #include <ostream>
 #include <string>
 #include <vector>
+#include "util/hash.h"
 #include "util/rational.h"
 
 namespace CVC4 {
@@ -92,13 +93,7 @@ class CVC4_PUBLIC String {
   explicit String(const char* s, bool useEscSequences = false)
       : d_str(toInternal(std::string(s), useEscSequences)) {}
   explicit String(const std::vector<unsigned>& s);
-
-  String& operator=(const String& y) {
-    if (this != &y) {
-      d_str = y.d_str;
-    }
-    return *this;
-  }
+  explicit String(std::vector<unsigned>&& s);
 
   String concat(const String& other) const;
 
@@ -240,7 +235,12 @@ namespace strings {
 
 struct CVC4_PUBLIC StringHashFunction {
   size_t operator()(const ::CVC4::String& s) const {
-    return std::hash<std::string>()(s.toString());
+    uint64_t ret = fnv1a::fnv1a_64(s.size());
+    for (unsigned c : s.getVec())
+    {
+      ret = fnv1a::fnv1a_64(c, ret);
+    }
+    return static_cast<size_t>(ret);
   }
 }; /* struct StringHashFunction */
 
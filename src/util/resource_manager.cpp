@@ -16,6 +16,13 @@
 **/
 #include "util/resource_manager.h"
 
+#include <cstdio>
+#include <sstream>
+#ifndef __WIN32__
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
 #include "base/check.h"
 #include "base/output.h"
 #include "options/smt_options.h"
@@ -101,6 +108,7 @@ bool Timer::expired() const {
 }
 
 const uint64_t ResourceManager::s_resourceCount = 1000;
+const uint64_t ResourceManager::s_memoryCheckInterval = 4096;
 
 ResourceManager::ResourceManager()
   : d_cumulativeTimer()
@@ -118,9 +126,83 @@ ResourceManager::ResourceManager()
   , d_on(false)
   , d_cpuTime(false)
   , d_spendResourceCalls(0)
+  , d_resourceKindLimitOn(false)
+  , d_memoryLimit(0)
+  , d_memorySoftLimit(0)
+  , d_nextMemoryPressure(0)
+  , d_memoryPressureCount(0)
+  , d_outOfMemory(false)
   , d_hardListeners()
   , d_softListeners()
-{}
+  , d_progressInterval(0)
+  , d_progressListeners()
+{
+  for (size_t i = 0; i < static_cast<size_t>(Resource::Count); ++i)
+  {
+    d_resourceSteps[i] = 0;
+    d_resourceUnits[i] = 0;
+    d_thisCallResourceUnits[i] = 0;
+    d_resourceBudgetPerCallOf[i] = 0;
+  }
+}
+
+const char* ResourceManager::toString(Resource r)
+{
+  switch (r)
+  {
+    case Resource::BitblastStep: return "bitblast";
+    case Resource::BvEagerAssertStep: return "bv-eager-assert";
+    case Resource::BvPropagationStep: return "bv-propagation";
+    case Resource::BvSatConflictsStep: return "bv-sat-conflict";
+    case Resource::CnfStep: return "cnf";
+    case Resource::DecisionStep: return "decision";
+    case Resource::LemmaStep: return "lemma";
+    case Resource::ParseStep: return "parse";
+    case Resource::PreprocessStep: return "preprocess";
+    case Resource::QuantifierStep: return "quantifier";
+    case Resource::RestartStep: return "restart";
+    case Resource::RewriteStep: return "rewrite";
+    case Resource::SatConflictStep: return "sat-conflict";
+    case Resource::TheoryCheckStep: return "theory-check";
+    default: Unreachable();
+  }
+  return nullptr;
+}
+
+bool ResourceManager::parseResourceLimits(
+    const std::string& spec, std::vector<std::pair<Resource, uint64_t>>& limits)
+{
+  std::stringstream ss(spec);
+  std::string item;
+  while (std::getline(ss, item, ','))
+  {
+    size_t start = item.find_first_not_of(' ');
+    size_t eq = item.find('=');
+    if (start == std::string::npos || eq == std::string::npos)
+    {
+      return false;
+    }
+    std::string name = item.substr(start, eq - start);
+    std::string units = item.substr(eq + 1);
+    if (units.empty()
+        || units.find_first_not_of("0123456789") != std::string::npos)
+    {
+      return false;
+    }
+    size_t i = 0;
+    while (i < static_cast<size_t>(Resource::Count)
+           && name != toString(static_cast<Resource>(i)))
+    {
+      ++i;
+    }
+    if (i == static_cast<size_t>(Resource::Count))
+    {
+      return false;
+    }
+    limits.emplace_back(static_cast<Resource>(i), std::stoull(units));
+  }
+  return true;
+}
 
 
 void ResourceManager::setResourceLimit(uint64_t units, bool cumulative) {
@@ -135,6 +217,20 @@ void ResourceManager::setResourceLimit(uint64_t units, bool cumulative) {
   }
 }
 
+void ResourceManager::setResourceLimit(Resource r, uint64_t units)
+{
+  Trace("limit") << "ResourceManager: setting per-call limit of " << toString(r)
+                 << " resources to " << units << endl;
+  d_on = true;
+  d_resourceBudgetPerCallOf[static_cast<size_t>(r)] = units;
+  d_resourceKindLimitOn = false;
+  for (size_t i = 0; i < static_cast<size_t>(Resource::Count); ++i)
+  {
+    d_resourceKindLimitOn = d_resourceKindLimitOn
+                            || d_resourceBudgetPerCallOf[i] != 0;
+  }
+}
+
 void ResourceManager::setTimeLimit(uint64_t millis, bool cumulative) {
   d_on = true;
   if(cumulative) {
@@ -149,6 +245,81 @@ void ResourceManager::setTimeLimit(uint64_t millis, bool cumulative) {
 
 }
 
+void ResourceManager::setMemoryLimit(uint64_t megabytes, bool soft)
+{
+  Trace("limit") << "ResourceManager: setting " << (soft ? "soft " : "")
+                 << "memory limit to " << megabytes << " MB" << endl;
+  d_on = true;
+  uint64_t bytes = megabytes * 1024 * 1024;
+  if (soft)
+  {
+    d_memorySoftLimit = bytes;
+    d_nextMemoryPressure = bytes;
+  }
+  else
+  {
+    d_memoryLimit = bytes;
+  }
+}
+
+uint64_t ResourceManager::getMemoryUsage()
+{
+#if defined(__linux__)
+  // the second field of statm is the resident set size, in pages
+  FILE* statm = fopen("/proc/self/statm", "r");
+  if (statm != nullptr)
+  {
+    unsigned long size = 0, resident = 0;
+    int read = fscanf(statm, "%lu %lu", &size, &resident);
+    fclose(statm);
+    if (read == 2)
+    {
+      return static_cast<uint64_t>(resident) * sysconf(_SC_PAGESIZE);
+    }
+  }
+#endif
+#ifndef __WIN32__
+  // otherwise, the peak resident set size is the best we know
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#ifdef __APPLE__
+    return usage.ru_maxrss;
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+  }
+#endif
+  return 0;
+}
+
+void ResourceManager::checkMemory()
+{
+  uint64_t usage = getMemoryUsage();
+  if (d_memoryLimit != 0 && usage >= d_memoryLimit)
+  {
+    Trace("limit") << "ResourceManager::checkMemory: " << usage
+                   << " bytes, out of memory" << std::endl;
+    d_outOfMemory = true;
+  }
+  if (d_memorySoftLimit == 0)
+  {
+    return;
+  }
+  if (usage < d_memorySoftLimit)
+  {
+    d_nextMemoryPressure = d_memorySoftLimit;
+  }
+  else if (usage >= d_nextMemoryPressure)
+  {
+    Trace("limit") << "ResourceManager::checkMemory: " << usage
+                   << " bytes, memory pressure" << std::endl;
+    ++d_memoryPressureCount;
+    // signal it again only if the memory keeps growing
+    d_nextMemoryPressure = usage + d_memorySoftLimit / 8;
+  }
+}
+
 const uint64_t& ResourceManager::getResourceUsage() const {
   return d_cumulativeResourceUsed;
 }
@@ -173,16 +344,32 @@ uint64_t ResourceManager::getTimeRemaining() const {
   return d_thisCallTimeBudget - time_passed;
 }
 
-void ResourceManager::spendResource(unsigned amount)
+void ResourceManager::spendResource(Resource r, unsigned amount)
 {
   ++d_spendResourceCalls;
   d_cumulativeResourceUsed += amount;
+  size_t i = static_cast<size_t>(r);
+  ++d_resourceSteps[i];
+  d_resourceUnits[i] += amount;
+  d_thisCallResourceUnits[i] += amount;
+  if (d_progressInterval != 0
+      && d_spendResourceCalls % d_progressInterval == 0)
+  {
+    d_progressListeners.notify();
+  }
   if (!d_on) return;
 
-  Debug("limit") << "ResourceManager::spendResource()" << std::endl;
+  Debug("limit") << "ResourceManager::spendResource(" << toString(r) << ")"
+                 << std::endl;
   d_thisCallResourceUsed += amount;
+  if ((d_memoryLimit != 0 || d_memorySoftLimit != 0)
+      && d_spendResourceCalls % s_memoryCheckInterval == 0)
+  {
+    checkMemory();
+  }
   if(out()) {
-    Trace("limit") << "ResourceManager::spendResource: interrupt!" << std::endl;
+    Trace("limit") << "ResourceManager::spendResource: interrupt on "
+                   << toString(r) << "!" << std::endl;
     Trace("limit") << "          on call " << d_spendResourceCalls << std::endl;
     if (outOfTime()) {
       Trace("limit") << "ResourceManager::spendResource: elapsed time"
@@ -203,8 +390,18 @@ void ResourceManager::beginCall() {
 
   d_perCallTimer.set(d_timeBudgetPerCall, !d_cpuTime);
   d_thisCallResourceUsed = 0;
+  for (size_t i = 0; i < static_cast<size_t>(Resource::Count); ++i)
+  {
+    d_thisCallResourceUnits[i] = 0;
+  }
   if (!d_on) return;
 
+  if (d_memoryLimit != 0 || d_memorySoftLimit != 0)
+  {
+    d_outOfMemory = false;
+    checkMemory();
+  }
+
   if (cumulativeLimitOn()) {
     if (d_resourceBudgetCumulative) {
       d_thisCallResourceBudget = d_resourceBudgetCumulative <= d_cumulativeResourceUsed ? 0 :
@@ -253,6 +450,17 @@ bool ResourceManager::perCallLimitOn() const {
 }
 
 bool ResourceManager::outOfResources() const {
+  if (d_resourceKindLimitOn)
+  {
+    for (size_t i = 0; i < static_cast<size_t>(Resource::Count); ++i)
+    {
+      if (d_resourceBudgetPerCallOf[i] != 0
+          && d_thisCallResourceUnits[i] >= d_resourceBudgetPerCallOf[i])
+      {
+        return true;
+      }
+    }
+  }
   // resource limiting not enabled
   if (d_resourceBudgetPerCall == 0 &&
       d_resourceBudgetCumulative == 0)
@@ -296,4 +504,16 @@ ListenerCollection::Registration* ResourceManager::registerSoftListener(
   return d_softListeners.registerListener(listener);
 }
 
+void ResourceManager::setProgressInterval(uint64_t calls)
+{
+  Trace("limit") << "ResourceManager::setProgressInterval(" << calls << ")\n";
+  d_progressInterval = calls;
+}
+
+ListenerCollection::Registration* ResourceManager::registerProgressListener(
+    Listener* listener)
+{
+  return d_progressListeners.registerListener(listener);
+}
+
 } /* namespace CVC4 */
@@ -23,6 +23,10 @@
 #include <cstddef>
 #include <sys/time.h>
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "base/exception.h"
 #include "base/listener.h"
 #include "util/unsafe_interrupt_exception.h"
@@ -74,7 +78,42 @@ class CVC4_PUBLIC Timer {
 
 
 class CVC4_PUBLIC ResourceManager {
+ public:
+  /**
+   * The kinds of resources. The amount spent per step of each kind is given
+   * by the corresponding option, e.g. options::rewriteStep().
+   */
+  enum class Resource
+  {
+    BitblastStep,
+    BvEagerAssertStep,
+    BvPropagationStep,
+    BvSatConflictsStep,
+    CnfStep,
+    DecisionStep,
+    LemmaStep,
+    ParseStep,
+    PreprocessStep,
+    QuantifierStep,
+    RestartStep,
+    RewriteStep,
+    SatConflictStep,
+    TheoryCheckStep,
+    /** The number of kinds of resources, not a kind */
+    Count
+  };
+
+  /** Get the name of the given kind of resources, e.g. "rewrite" */
+  static const char* toString(Resource r);
 
+  /**
+   * Parse a list of limits of kinds of resources, like "quantifier=100,
+   * bitblast=2000". Returns false if spec is not such a list.
+   */
+  static bool parseResourceLimits(
+      const std::string& spec, std::vector<std::pair<Resource, uint64_t>>& limits);
+
+ private:
   Timer d_cumulativeTimer;
   Timer d_perCallTimer;
 
@@ -107,8 +146,43 @@ class CVC4_PUBLIC ResourceManager {
   bool d_cpuTime;
   uint64_t d_spendResourceCalls;
 
+  /** The number of steps spent, per kind of resources */
+  uint64_t d_resourceSteps[static_cast<size_t>(Resource::Count)];
+  /** The amount of resource used, per kind of resources */
+  uint64_t d_resourceUnits[static_cast<size_t>(Resource::Count)];
+  /** The amount of resource used during this call, per kind of resources */
+  uint64_t d_thisCallResourceUnits[static_cast<size_t>(Resource::Count)];
+  /**
+   * A user-imposed per-call budget, per kind of resources, and whether there
+   * is one for any kind. 0 = no limit.
+   */
+  uint64_t d_resourceBudgetPerCallOf[static_cast<size_t>(Resource::Count)];
+  bool d_resourceKindLimitOn;
+
+  /** A user-imposed limit on the resident memory, in bytes. 0 = no limit. */
+  uint64_t d_memoryLimit;
+  /**
+   * A user-imposed soft limit on the resident memory, in bytes, past which
+   * memory pressure is signaled. 0 = no limit.
+   */
+  uint64_t d_memorySoftLimit;
+  /** The resident memory past which memory pressure is signaled next */
+  uint64_t d_nextMemoryPressure;
+  /** The number of times memory pressure was signaled */
+  uint64_t d_memoryPressureCount;
+  /** Whether the last measure of the resident memory was over its limit */
+  bool d_outOfMemory;
+
   /** Counter indicating how often to check resource manager in loops */
   static const uint64_t s_resourceCount;
+  /** The number of calls to spendResource() between two memory measures */
+  static const uint64_t s_memoryCheckInterval;
+
+  /**
+   * Measure the resident memory, and update d_outOfMemory and the memory
+   * pressure accordingly.
+   */
+  void checkMemory();
 
   /** Receives a notification on reaching a hard limit. */
   ListenerCollection d_hardListeners;
@@ -116,6 +190,15 @@ class CVC4_PUBLIC ResourceManager {
   /** Receives a notification on reaching a hard limit. */
   ListenerCollection d_softListeners;
 
+  /**
+   * The number of calls to spendResource() between two notifications of the
+   * progress listeners. 0 = no notifications.
+   */
+  uint64_t d_progressInterval;
+
+  /** Receives a notification every d_progressInterval spendResource() calls. */
+  ListenerCollection d_progressListeners;
+
   /**
    * ResourceManagers cannot be copied as they are given an explicit
    * list of Listeners to respond to.
@@ -132,13 +215,22 @@ public:
 
   ResourceManager();
 
-  bool limitOn() const { return cumulativeLimitOn() || perCallLimitOn(); }
+  bool limitOn() const
+  {
+    return cumulativeLimitOn() || perCallLimitOn() || d_resourceKindLimitOn
+           || d_memoryLimit != 0;
+  }
   bool cumulativeLimitOn() const;
   bool perCallLimitOn() const;
 
   bool outOfResources() const;
   bool outOfTime() const;
-  bool out() const { return d_on && (outOfResources() || outOfTime()); }
+  bool outOfMemory() const { return d_outOfMemory; }
+
+  bool out() const
+  {
+    return d_on && (outOfResources() || outOfTime() || outOfMemory());
+  }
 
 
   /**
@@ -152,12 +244,51 @@ public:
   uint64_t getResourceBudgetForThisCall() {
     return d_thisCallResourceBudget;
   }
-  // Throws an UnsafeInterruptException if there are no remaining resources.
-  void spendResource(unsigned amount);
+
+  /**
+   * Get the number of steps spent of the given kind of resources. This
+   * returns a const uint64_t& to support being used as a ReferenceStat.
+   */
+  const uint64_t& getResourceSteps(Resource r) const
+  {
+    return d_resourceSteps[static_cast<size_t>(r)];
+  }
+  /**
+   * Get the amount of resource used of the given kind. This returns a const
+   * uint64_t& to support being used as a ReferenceStat.
+   */
+  const uint64_t& getResourceUnits(Resource r) const
+  {
+    return d_resourceUnits[static_cast<size_t>(r)];
+  }
+
+  /**
+   * Spend a step of the given kind of resources, which uses the given amount
+   * of resource. Throws an UnsafeInterruptException if there are no remaining
+   * resources.
+   */
+  void spendResource(Resource r, unsigned amount);
 
   void setHardLimit(bool value);
   void setResourceLimit(uint64_t units, bool cumulative = false);
+  /** Set a per-call limit of the given kind of resources (0 = no limit). */
+  void setResourceLimit(Resource r, uint64_t units);
   void setTimeLimit(uint64_t millis, bool cumulative = false);
+  /**
+   * Set a limit on the resident memory of the process, in megabytes (0 = no
+   * limit). Past the limit, we are out of resources as for the other limits.
+   * Past a soft limit, memory pressure is signaled instead, and signaled again
+   * each time the memory grows by another eighth of the soft limit.
+   */
+  void setMemoryLimit(uint64_t megabytes, bool soft = false);
+  /**
+   * Get the number of times memory pressure was signaled. Owners of caches
+   * that can be rebuilt clear them when this number changes, at points where
+   * this is safe.
+   */
+  uint64_t getMemoryPressureCount() const { return d_memoryPressureCount; }
+  /** Get the resident memory of this process in bytes, or 0 if unknown */
+  static uint64_t getMemoryUsage();
   void useCPUTime(bool cpu);
 
   void enable(bool on);
@@ -192,6 +323,23 @@ public:
    */
   ListenerCollection::Registration* registerSoftListener(Listener* listener);
 
+  /**
+   * Sets the number of calls to spendResource() between two notifications
+   * of the progress listeners, or 0 to not notify them.
+   */
+  void setProgressInterval(uint64_t calls);
+
+  /**
+   * Registers a listener that is notified periodically while resources are
+   * spent, see setProgressInterval(). The listener is notified by the thread
+   * spending the resources, so it may call back into the solver.
+   *
+   * This Registration must be destroyed by the user before this
+   * ResourceManager.
+   */
+  ListenerCollection::Registration* registerProgressListener(
+      Listener* listener);
+
 };/* class ResourceManager */
 
 
@@ -17,6 +17,7 @@
 
 #include "util/statistics.h"
 
+#include <iomanip>
 #include <typeinfo>
 
 #include "util/safe_print.h"
@@ -25,6 +26,70 @@
 
 namespace CVC4 {
 
+namespace {
+
+/** Print the given string as a JSON string */
+void printJsonString(std::ostream& out, const std::string& s)
+{
+  out << '"';
+  for (char c : s)
+  {
+    switch (c)
+    {
+      case '"': out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      case '\t': out << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+              << static_cast<int>(c) << std::dec << std::setfill(' ');
+        }
+        else
+        {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+}
+
+/** Print the given value of a statistic as a JSON value */
+void printJsonValue(std::ostream& out, const SExpr& value)
+{
+  if (value.isInteger())
+  {
+    out << value.getIntegerValue();
+  }
+  else if (value.isRational())
+  {
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(9)
+        << value.getRationalValue().getDouble();
+    out.flags(flags);
+    out.precision(precision);
+  }
+  else if (value.isAtom())
+  {
+    printJsonString(out, value.getValue());
+  }
+  else
+  {
+    out << '[';
+    const std::vector<SExpr>& children = value.getChildren();
+    for (size_t i = 0, size = children.size(); i < size; ++i)
+    {
+      out << (i == 0 ? "" : ", ");
+      printJsonValue(out, children[i]);
+    }
+    out << ']';
+  }
+}
+
+}  // namespace
+
 std::string StatisticsBase::s_regDelim("::");
 
 bool StatisticsBase::StatCmp::operator()(const Stat* s1, const Stat* s2) const {
@@ -94,6 +159,28 @@ Statistics& Statistics::operator=(const Statistics& stats) {
   return this->operator=((const StatisticsBase&)stats);
 }
 
+Statistics Statistics::getDelta(const StatisticsBase& previous) const
+{
+  Statistics delta(*this);
+  delta.clear();
+  for (StatSet::iterator i = d_stats.begin(); i != d_stats.end(); ++i)
+  {
+    const std::string& name = (*i)->getName();
+    SExpr value = (*i)->getValue();
+    SExpr prev = previous.getStatistic(name);
+    if (value.isInteger() && prev.isInteger())
+    {
+      value = SExpr(value.getIntegerValue() - prev.getIntegerValue());
+    }
+    else if (value.isRational() && prev.isRational())
+    {
+      value = SExpr(value.getRationalValue() - prev.getRationalValue());
+    }
+    delta.d_stats.insert(new SExprStat(name, value));
+  }
+  return delta;
+}
+
 StatisticsBase::const_iterator StatisticsBase::begin() const {
   return iterator(d_stats.begin());
 }
@@ -131,6 +218,38 @@ void StatisticsBase::safeFlushInformation(int fd) const {
 #endif /* CVC4_STATISTICS_ON */
 }
 
+void StatisticsBase::flushInformationJson(std::ostream& out) const
+{
+  flushInformationJson(out, {this});
+}
+
+void StatisticsBase::flushInformationJson(
+    std::ostream& out, const std::vector<const StatisticsBase*>& stats)
+{
+  out << '{';
+#ifdef CVC4_STATISTICS_ON
+  bool first = true;
+  for (const StatisticsBase* sb : stats)
+  {
+    for (StatSet::iterator i = sb->d_stats.begin(); i != sb->d_stats.end();
+         ++i)
+    {
+      out << (first ? "" : ", ");
+      first = false;
+      std::string name = (*i)->getName();
+      if (sb->d_prefix != "")
+      {
+        name = sb->d_prefix + s_regDelim + name;
+      }
+      printJsonString(out, name);
+      out << ": ";
+      printJsonValue(out, (*i)->getValue());
+    }
+  }
+#endif /* CVC4_STATISTICS_ON */
+  out << '}';
+}
+
 SExpr StatisticsBase::getStatistic(std::string name) const {
   SExpr value;
   IntStat s(name, 0);
@@ -25,6 +25,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "util/sexpr.h"
 
@@ -90,6 +91,20 @@ public:
    */
   void safeFlushInformation(int fd) const;
 
+  /**
+   * Flush all statistics to the given output stream as a JSON object, which
+   * maps the names of the statistics to their values. Integers and
+   * rationals are numbers, lists are arrays, and other values are strings.
+   */
+  void flushInformationJson(std::ostream& out) const;
+
+  /**
+   * Flush the statistics of all of the given sets to the given output stream
+   * as a single JSON object, see flushInformationJson.
+   */
+  static void flushInformationJson(
+      std::ostream& out, const std::vector<const StatisticsBase*>& stats);
+
   /** Get the value of a named statistic. */
   SExpr getStatistic(std::string name) const;
 
@@ -128,6 +143,14 @@ public:
   Statistics& operator=(const StatisticsBase& stats);
   Statistics& operator=(const Statistics& stats);
 
+  /**
+   * Get the change of these statistics since the given earlier statistics.
+   * The values of integer and rational statistics are the difference to
+   * their earlier value (or their value, if they did not exist before). The
+   * values of other statistics are their current value.
+   */
+  Statistics getDelta(const StatisticsBase& previous) const;
+
 };/* class Statistics */
 
 }/* CVC4 namespace */
@@ -46,6 +46,7 @@
 
 #include "base/exception.h"
 #include "lib/clock_gettime.h"
+#include "util/profiler.h"
 #include "util/safe_print.h"
 #include "util/statistics.h"
 
@@ -576,6 +577,30 @@ public:
 
 };/* class SExprStat */
 
+/**
+ * A statistic that reports the profile of the timed regions, see
+ * util/profiler.h.
+ */
+class ProfilerStat : public Stat {
+public:
+  ProfilerStat(const std::string& name) : Stat(name) {}
+
+  void flushInformation(std::ostream& out) const override
+  {
+    out << std::endl;
+    Profiler::flush(out);
+  }
+
+  void safeFlushInformation(int fd) const override
+  {
+    safe_print(fd, "\n");
+    Profiler::safeFlush(fd);
+  }
+
+  SExpr getValue() const override { return Profiler::getValue(); }
+
+};/* class ProfilerStat */
+
 template <class T>
 class HistogramStat : public Stat {
 private:
@@ -712,6 +737,10 @@ class CVC4_PUBLIC TimerStat : public BackedStat<timespec> {
   /** Whether this timer is currently running */
   bool d_running;
 
+  /** The profiler region of this timer, if d_hasRegion */
+  mutable uint32_t d_region;
+  mutable bool d_hasRegion;
+
 public:
 
   typedef CVC4::CodeTimer CodeTimer;
@@ -721,7 +750,13 @@ public:
    * timers have a 0.0 value and are not running.
    */
   TimerStat(const std::string& name)
-      : BackedStat<timespec>(name, {0, 0}), d_start{0, 0}, d_running(false) {}
+      : BackedStat<timespec>(name, {0, 0}),
+        d_start{0, 0},
+        d_running(false),
+        d_region(Profiler::UNREGISTERED),
+        d_hasRegion(false)
+  {
+  }
 
   /** Start the timer. */
   void start();
@@ -735,6 +770,17 @@ public:
   /** If the timer is currently running */
   bool running() const;
 
+  /** Get the profiler region of this timer, registered on first use */
+  uint32_t getProfileRegion() const
+  {
+    if (!d_hasRegion)
+    {
+      d_region = Profiler::registerRegion(getName());
+      d_hasRegion = true;
+    }
+    return d_region;
+  }
+
   timespec getData() const override;
 
   void safeFlushInformation(int fd) const override
@@ -753,11 +799,13 @@ public:
 /**
  * Utility class to make it easier to call stop() at the end of a
  * code block.  When constructed, it starts the timer.  When
- * destructed, it stops the timer.
+ * destructed, it stops the timer.  If profiling is enabled, the code
+ * block is also a region of the profiler, named like the timer.
  */
 class CodeTimer {
   TimerStat& d_timer;
   bool d_reentrant;
+  bool d_profiled;
 
   /** Private copy constructor undefined (no copy permitted). */
   CodeTimer(const CodeTimer& timer) = delete;
@@ -765,13 +813,22 @@ class CodeTimer {
   CodeTimer& operator=(const CodeTimer& timer) = delete;
 
 public:
-  CodeTimer(TimerStat& timer, bool allow_reentrant = false) : d_timer(timer), d_reentrant(false) {
+  CodeTimer(TimerStat& timer, bool allow_reentrant = false) : d_timer(timer), d_reentrant(false), d_profiled(false) {
     if(!allow_reentrant || !(d_reentrant = d_timer.running())) {
       d_timer.start();
+      if (Profiler::isEnabled())
+      {
+        d_profiled = true;
+        Profiler::enter(d_timer.getProfileRegion());
+      }
     }
   }
   ~CodeTimer() {
     if(!d_reentrant) {
+      if (d_profiled)
+      {
+        Profiler::exit();
+      }
       d_timer.stop();
     }
   }
@@ -0,0 +1,136 @@
+/*********************                                                        */
+/*! \file SolverTest.java
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Tests of the solver of the Java API.
+ **
+ ** Tests of the solver of the Java API.
+ **/
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import cvc4.api.*;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+public class SolverTest {
+  Solver solver;
+
+  @Before
+  public void initialize() {
+    solver = new Solver();
+  }
+
+  @After
+  public void close() {
+    solver.close();
+  }
+
+  @Test
+  public void checkSat() {
+    solver.setLogic("QF_LIA");
+    Sort intSort = solver.getIntegerSort();
+    Term x = solver.mkConst(intSort, "x");
+    Term zero = solver.mkInteger(0);
+    solver.assertFormula(solver.mkTerm(Kind.GT, x, zero));
+    assertTrue(solver.checkSat().isSat());
+    solver.assertFormula(solver.mkTerm(Kind.LT, x, zero));
+    assertTrue(solver.checkSat().isUnsat());
+  }
+
+  @Test
+  public void terms() {
+    Sort boolSort = solver.getBooleanSort();
+    Term[] pq = solver.mkConsts(boolSort, new String[] {"p", "q"});
+    Term t = solver.mkTerm(Kind.AND, pq);
+    assertEquals(Kind.AND, t.getKind());
+    assertEquals(boolSort, t.getSort());
+    assertArrayEquals(pq, t.getChildren());
+    assertEquals(t, solver.mkTerm(Kind.AND, pq[0], pq[1]));
+    assertEquals(t.hashCode(), solver.mkTerm(Kind.AND, pq).hashCode());
+    assertEquals("p", pq[0].toString());
+  }
+
+  @Test(expected = CVC4ApiException.class)
+  public void mkTermError() {
+    Term x = solver.mkConst(solver.getIntegerSort(), "x");
+    solver.mkTerm(Kind.AND, x, x);
+  }
+
+  @Test
+  public void mkTerms() {
+    Sort intSort = solver.getIntegerSort();
+    Term[] xs = solver.mkConsts(intSort, new String[] {"x", "y", "z"});
+    // 3 = x + y, 4 = 3 + z, 5 = (4 > x)
+    Term[] roots = solver.mkTerms(xs,
+        new Kind[] {Kind.PLUS, Kind.PLUS, Kind.GT},
+        new int[] {2, 2, 2},
+        new int[] {0, 1, 3, 2, 4, 0},
+        new int[] {5, 3});
+    Term sum = solver.mkTerm(Kind.PLUS, xs[0], xs[1]);
+    assertEquals(2, roots.length);
+    assertEquals(sum, roots[1]);
+    assertEquals(solver.mkTerm(Kind.GT, solver.mkTerm(Kind.PLUS, sum, xs[2]),
+                     xs[0]),
+        roots[0]);
+  }
+
+  @Test(expected = CVC4ApiException.class)
+  public void mkTermsCycle() {
+    Term[] xs = solver.mkConsts(solver.getIntegerSort(), new String[] {"x"});
+    solver.mkTerms(xs, new Kind[] {Kind.PLUS}, new int[] {2},
+        new int[] {0, 1}, new int[] {1});
+  }
+
+  @Test
+  public void getValue() {
+    solver.setOption("produce-models", "true");
+    Sort intSort = solver.getIntegerSort();
+    String[] names = new String[10];
+    for (int i = 0; i < names.length; i++) {
+      names[i] = "x" + i;
+    }
+    Term[] xs = solver.mkConsts(intSort, names);
+    Term[] equalities = new Term[xs.length];
+    for (int i = 0; i < xs.length; i++) {
+      equalities[i] = solver.mkTerm(Kind.EQUAL, xs[i], solver.mkInteger(i));
+    }
+    solver.assertFormulas(equalities);
+    assertTrue(solver.checkSat().isSat());
+    Term[] values = solver.getValue(xs);
+    for (int i = 0; i < xs.length; i++) {
+      assertEquals(solver.mkInteger(i), values[i]);
+    }
+    assertEquals(values[3], solver.getValue(xs[3]));
+  }
+
+  @Test
+  public void pushPop() {
+    solver.setOption("incremental", "true");
+    Term p = solver.mkConst(solver.getBooleanSort(), "p");
+    solver.assertFormula(p);
+    solver.push();
+    solver.assertFormula(solver.mkTerm(Kind.NOT, p));
+    assertTrue(solver.checkSat().isUnsat());
+    solver.pop();
+    assertTrue(solver.checkSat().isSat());
+  }
+
+  @Test
+  public void recycle() {
+    solver.setLogic("QF_UF");
+    Term p = solver.mkConst(solver.getBooleanSort(), "p");
+    solver.assertFormula(solver.mkTerm(Kind.AND, p, solver.mkTerm(Kind.NOT, p)));
+    assertTrue(solver.checkSat().isUnsat());
+    solver.recycle();
+    assertTrue(solver.checkSat().isSat());
+  }
+}
@@ -0,0 +1,161 @@
+/*********************                                                        */
+/*! \file benchmark.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A minimal microbenchmark harness
+ **
+ ** A minimal microbenchmark harness in the style of Google Benchmark. A
+ ** benchmark is a function taking a State, which sets up its data and then
+ ** runs its timed loop while state.keepRunning() returns true. The number of
+ ** iterations is chosen by the harness, such that the loop runs for at least
+ ** the minimum time.
+ **/
+
+#ifndef CVC4__TEST__PERF__MICRO__BENCHMARK_H
+#define CVC4__TEST__PERF__MICRO__BENCHMARK_H
+
+#include <stdint.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace CVC4 {
+namespace bench {
+
+/** The state of a run of a benchmark */
+class State
+{
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  State(uint64_t iterations)
+      : d_iterations(iterations),
+        d_remaining(iterations),
+        d_started(false),
+        d_running(false),
+        d_elapsed(0),
+        d_items(0)
+  {
+  }
+
+  /**
+   * Returns true while iterations remain. The timer is started at the first
+   * call, and stopped when the iterations are exhausted.
+   */
+  bool keepRunning()
+  {
+    if (!d_started)
+    {
+      d_started = true;
+      resumeTiming();
+    }
+    if (d_remaining > 0)
+    {
+      --d_remaining;
+      return true;
+    }
+    pauseTiming();
+    return false;
+  }
+
+  /** Stop the timer, e.g. while preparing the data of the next iteration */
+  void pauseTiming()
+  {
+    if (d_running)
+    {
+      d_elapsed += Clock::now() - d_start;
+      d_running = false;
+    }
+  }
+  /** Restart the timer */
+  void resumeTiming()
+  {
+    if (!d_running)
+    {
+      d_start = Clock::now();
+      d_running = true;
+    }
+  }
+
+  /** The number of iterations of this run */
+  uint64_t iterations() const { return d_iterations; }
+  /** The time spent in the timed loop, in seconds */
+  double elapsed() const
+  {
+    return std::chrono::duration<double>(d_elapsed).count();
+  }
+
+  /**
+   * Set the number of items processed in total, if an iteration processes
+   * more than one (e.g. inserts a batch of elements)
+   */
+  void setItemsProcessed(uint64_t items) { d_items = items; }
+  /** The number of items processed, or 0 if not set */
+  uint64_t itemsProcessed() const { return d_items; }
+
+ private:
+  /** The number of iterations */
+  uint64_t d_iterations;
+  /** The number of iterations that remain */
+  uint64_t d_remaining;
+  /** Whether the timed loop was started */
+  bool d_started;
+  /** Whether the timer is running */
+  bool d_running;
+  /** The time at which the timer was last resumed */
+  Clock::time_point d_start;
+  /** The time accumulated while the timer was running */
+  Clock::duration d_elapsed;
+  /** The number of items processed */
+  uint64_t d_items;
+}; /* class State */
+
+/** A benchmark function */
+using Function = void (*)(State&);
+
+/** A registered benchmark */
+struct Benchmark
+{
+  std::string d_name;
+  Function d_function;
+};
+
+/** Get the registered benchmarks */
+std::vector<Benchmark>& getBenchmarks();
+
+/** Registers a benchmark on construction */
+struct Registration
+{
+  Registration(const char* name, Function f)
+  {
+    getBenchmarks().push_back({name, f});
+  }
+};
+
+/**
+ * Prevent the compiler from optimizing away the computation of a value that
+ * is not used otherwise
+ */
+template <class T>
+inline void doNotOptimize(const T& value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}  // namespace bench
+}  // namespace CVC4
+
+/** Register the benchmark function under the given name */
+#define CVC4_BENCHMARK(name, function)                                  \
+  static ::CVC4::bench::Registration CVC4_BENCHMARK_CONCAT(             \
+      cvc4_benchmark_registration_, __LINE__)(name, function)
+#define CVC4_BENCHMARK_CONCAT(a, b) CVC4_BENCHMARK_CONCAT2(a, b)
+#define CVC4_BENCHMARK_CONCAT2(a, b) a##b
+
+#endif /* CVC4__TEST__PERF__MICRO__BENCHMARK_H */
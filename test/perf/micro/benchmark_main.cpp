@@ -0,0 +1,152 @@
+/*********************                                                        */
+/*! \file benchmark_main.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The driver of the microbenchmarks
+ **
+ ** Runs the registered microbenchmarks whose name matches the filter, and
+ ** reports the time per iteration, as a table or as JSON.
+ **
+ ** Usage: microbenchmarks [--filter=REGEX] [--min-time=SECONDS] [--json]
+ **/
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <string>
+
+#include "benchmark.h"
+
+namespace CVC4 {
+namespace bench {
+
+std::vector<Benchmark>& getBenchmarks()
+{
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+namespace {
+
+/** The result of running a benchmark */
+struct Result
+{
+  uint64_t d_iterations;
+  double d_seconds;
+  uint64_t d_items;
+};
+
+/**
+ * Run the benchmark with an increasing number of iterations, until the timed
+ * loop runs for at least minTime seconds
+ */
+Result run(const Benchmark& b, double minTime)
+{
+  uint64_t iterations = 1;
+  while (true)
+  {
+    State state(iterations);
+    b.d_function(state);
+    double elapsed = state.elapsed();
+    if (elapsed >= minTime || iterations >= 1000000000)
+    {
+      return {iterations, elapsed, state.itemsProcessed()};
+    }
+    // grow by at least 2x and at most 10x, aiming a bit past the minimum
+    double factor = elapsed > 0 ? 1.4 * minTime / elapsed : 10;
+    factor = std::min(std::max(factor, 2.0), 10.0);
+    iterations = static_cast<uint64_t>(iterations * factor);
+  }
+}
+
+}  // namespace
+}  // namespace bench
+}  // namespace CVC4
+
+using namespace CVC4::bench;
+
+int main(int argc, char* argv[])
+{
+  std::regex filter(".*");
+  double minTime = 0.5;
+  bool json = false;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (strncmp(argv[i], "--filter=", 9) == 0)
+    {
+      filter = std::regex(argv[i] + 9);
+    }
+    else if (strncmp(argv[i], "--min-time=", 11) == 0)
+    {
+      minTime = atof(argv[i] + 11);
+    }
+    else if (strcmp(argv[i], "--json") == 0)
+    {
+      json = true;
+    }
+    else
+    {
+      std::cerr << "usage: " << argv[0]
+                << " [--filter=REGEX] [--min-time=SECONDS] [--json]"
+                << std::endl;
+      return 1;
+    }
+  }
+
+  std::vector<Benchmark> benchmarks = getBenchmarks();
+  std::sort(benchmarks.begin(),
+            benchmarks.end(),
+            [](const Benchmark& a, const Benchmark& b) {
+              return a.d_name < b.d_name;
+            });
+
+  if (json)
+  {
+    std::cout << "{";
+  }
+  else
+  {
+    std::cout << std::left << std::setw(48) << "benchmark" << std::right
+              << std::setw(14) << "iterations" << std::setw(14) << "ns/iter"
+              << std::setw(16) << "items/s" << std::endl;
+  }
+  bool first = true;
+  for (const Benchmark& b : benchmarks)
+  {
+    if (!std::regex_search(b.d_name, filter))
+    {
+      continue;
+    }
+    Result r = run(b, minTime);
+    double ns = r.d_seconds * 1e9 / r.d_iterations;
+    double itemsPerSecond = r.d_items > 0 ? r.d_items / r.d_seconds : 0;
+    if (json)
+    {
+      std::cout << (first ? "" : ",") << std::endl
+                << "  \"" << b.d_name << "\": {\"iterations\": "
+                << r.d_iterations << ", \"ns_per_iteration\": " << ns
+                << ", \"items_per_second\": " << itemsPerSecond << "}";
+    }
+    else
+    {
+      std::cout << std::left << std::setw(48) << b.d_name << std::right
+                << std::setw(14) << r.d_iterations << std::setw(14)
+                << std::fixed << std::setprecision(1) << ns << std::setw(16)
+                << std::setprecision(0) << itemsPerSecond << std::endl;
+    }
+    first = false;
+  }
+  if (json)
+  {
+    std::cout << std::endl << "}" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,196 @@
+/*********************                                                        */
+/*! \file context_bench.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Microbenchmarks of the context-dependent data structures
+ **/
+
+#include <array>
+#include <vector>
+
+#include "benchmark.h"
+#include "context/cdflat_hashmap.h"
+#include "context/cdhashmap.h"
+#include "context/cdo.h"
+#include "context/cdundo_trail.h"
+#include "context/context.h"
+
+using namespace CVC4;
+using namespace CVC4::context;
+using namespace CVC4::bench;
+
+namespace {
+
+const int NUM_KEYS = 1000;
+
+/** The maps to compare, CVC4_BENCHMARK cannot take their template names */
+typedef CDHashMap<int, int> IntMap;
+typedef CDFlatHashMap<int, int> IntFlatMap;
+
+/** A structure of which each context level only changes one word */
+typedef std::array<uint64_t, 64> Block;
+const size_t NUM_BLOCKS = 256;
+
+/** Insert fresh keys in a new context level, and pop it */
+template <class M>
+void mapInsert(State& state)
+{
+  Context ctx;
+  M map(&ctx);
+  while (state.keepRunning())
+  {
+    ctx.push();
+    for (int i = 0; i < NUM_KEYS; ++i)
+    {
+      map.insert(i, i);
+    }
+    ctx.pop();
+  }
+  state.setItemsProcessed(state.iterations() * NUM_KEYS);
+}
+CVC4_BENCHMARK("cdhashmap/insert", mapInsert<IntMap>);
+CVC4_BENCHMARK("cdflat_hashmap/insert", mapInsert<IntFlatMap>);
+
+/**
+ * Overwrite keys inserted at level 0 in nested context levels, which saves
+ * and restores their values
+ */
+template <class M>
+void mapOverwriteNested(State& state)
+{
+  Context ctx;
+  M map(&ctx);
+  for (int i = 0; i < NUM_KEYS; ++i)
+  {
+    map.insert(i, i);
+  }
+  while (state.keepRunning())
+  {
+    for (int level = 0; level < 10; ++level)
+    {
+      ctx.push();
+      for (int i = level; i < NUM_KEYS; i += 10)
+      {
+        map.insert(i, level);
+      }
+    }
+    ctx.popto(0);
+  }
+  state.setItemsProcessed(state.iterations() * NUM_KEYS);
+}
+CVC4_BENCHMARK("cdhashmap/overwrite_nested", mapOverwriteNested<IntMap>);
+CVC4_BENCHMARK("cdflat_hashmap/overwrite_nested",
+               mapOverwriteNested<IntFlatMap>);
+
+/** Look up keys inserted at different context levels */
+template <class M>
+void mapLookup(State& state)
+{
+  Context ctx;
+  M map(&ctx);
+  for (int level = 0; level < 10; ++level)
+  {
+    ctx.push();
+    for (int i = level; i < 10 * NUM_KEYS; i += 10)
+    {
+      map.insert(i, level);
+    }
+  }
+  while (state.keepRunning())
+  {
+    // half of the lookups miss
+    for (int i = 0; i < 20 * NUM_KEYS; i += 10)
+    {
+      doNotOptimize(map.find(i));
+    }
+  }
+  state.setItemsProcessed(state.iterations() * 2 * NUM_KEYS);
+  ctx.popto(0);
+}
+CVC4_BENCHMARK("cdhashmap/lookup", mapLookup<IntMap>);
+CVC4_BENCHMARK("cdflat_hashmap/lookup", mapLookup<IntFlatMap>);
+
+/** Push a context level, overwrite one key and pop the level again */
+template <class M>
+void mapPushPop(State& state)
+{
+  Context ctx;
+  M map(&ctx);
+  for (int i = 0; i < NUM_KEYS; ++i)
+  {
+    map.insert(i, i);
+  }
+  while (state.keepRunning())
+  {
+    ctx.push();
+    map.insert(0, 1);
+    ctx.pop();
+  }
+}
+CVC4_BENCHMARK("cdhashmap/push_pop", mapPushPop<IntMap>);
+CVC4_BENCHMARK("cdflat_hashmap/push_pop", mapPushPop<IntFlatMap>);
+
+/**
+ * Push a context level, change one word of each block and pop the level
+ * again, with blocks in CDOs, which save a whole block at the first change
+ */
+void cdoBlockPushPop(State& state)
+{
+  Context ctx;
+  Block zero;
+  zero.fill(0);
+  std::vector<CDO<Block>*> cdos;
+  for (size_t i = 0; i < NUM_BLOCKS; ++i)
+  {
+    cdos.push_back(new (true) CDO<Block>(&ctx, zero));
+  }
+  uint64_t r = 0;
+  while (state.keepRunning())
+  {
+    ctx.push();
+    for (CDO<Block>* cdo : cdos)
+    {
+      Block b = cdo->get();
+      b[r % b.size()] = r + 1;
+      cdo->set(b);
+    }
+    ctx.pop();
+    ++r;
+  }
+  state.setItemsProcessed(state.iterations() * NUM_BLOCKS);
+  for (CDO<Block>* cdo : cdos)
+  {
+    cdo->deleteSelf();
+  }
+}
+CVC4_BENCHMARK("cdo/block_push_pop", cdoBlockPushPop);
+
+/** The same as cdo/block_push_pop, with the changed words saved in a trail */
+void undoTrailBlockPushPop(State& state)
+{
+  Context ctx;
+  Block zero;
+  zero.fill(0);
+  std::vector<Block> blocks(NUM_BLOCKS, zero);
+  CDUndoTrail trail(&ctx);
+  uint64_t r = 0;
+  while (state.keepRunning())
+  {
+    ctx.push();
+    for (Block& b : blocks)
+    {
+      trail.set(b[r % b.size()], r + 1);
+    }
+    ctx.pop();
+    ++r;
+  }
+  state.setItemsProcessed(state.iterations() * NUM_BLOCKS);
+}
+CVC4_BENCHMARK("cdundo_trail/block_push_pop", undoTrailBlockPushPop);
+
+}  // namespace
@@ -0,0 +1,210 @@
+/*********************                                                        */
+/*! \file expr_bench.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Microbenchmarks of node construction, attributes and type checking
+ **/
+
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark.h"
+#include "expr/attribute.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "expr/node_map.h"
+#include "util/rational.h"
+
+using namespace CVC4;
+using namespace CVC4::kind;
+using namespace CVC4::bench;
+
+namespace {
+
+const unsigned NUM_NODES = 1000;
+
+/** Construct a node that exists already, i.e. a hit of the node pool */
+void nodeManagerMkNodeExisting(State& state)
+{
+  NodeManager nm(nullptr);
+  NodeManagerScope scope(&nm);
+  Node x = nm.mkSkolem("x", nm.integerType());
+  Node y = nm.mkSkolem("y", nm.integerType());
+  // keep the node alive, so that constructing it again finds it in the pool
+  Node sum = nm.mkNode(PLUS, x, y);
+  while (state.keepRunning())
+  {
+    for (unsigned i = 0; i < NUM_NODES; ++i)
+    {
+      doNotOptimize(nm.mkNode(PLUS, x, y));
+    }
+  }
+  state.setItemsProcessed(state.iterations() * NUM_NODES);
+}
+CVC4_BENCHMARK("node_manager/mk_node_existing", nodeManagerMkNodeExisting);
+
+/**
+ * Construct fresh nodes, and release them, i.e. a miss of the node pool
+ * followed by the reclamation of the node
+ */
+void nodeManagerMkNodeFresh(State& state)
+{
+  NodeManager nm(nullptr);
+  NodeManagerScope scope(&nm);
+  Node x = nm.mkSkolem("x", nm.integerType());
+  unsigned k = 0;
+  std::vector<Node> nodes;
+  nodes.reserve(NUM_NODES);
+  while (state.keepRunning())
+  {
+    for (unsigned i = 0; i < NUM_NODES; ++i, ++k)
+    {
+      nodes.push_back(nm.mkNode(PLUS, x, nm.mkConst(Rational(k))));
+    }
+    nodes.clear();
+  }
+  state.setItemsProcessed(state.iterations() * NUM_NODES);
+}
+CVC4_BENCHMARK("node_manager/mk_node_fresh", nodeManagerMkNodeFresh);
+
+/** Construct n-ary nodes that exist already */
+void nodeManagerMkNodeNary(State& state)
+{
+  NodeManager nm(nullptr);
+  NodeManagerScope scope(&nm);
+  std::vector<Node> children;
+  for (unsigned i = 0; i < 16; ++i)
+  {
+    children.push_back(nm.mkSkolem("x", nm.integerType()));
+  }
+  // keep the node alive, so that constructing it again finds it in the pool
+  Node sum = nm.mkNode(PLUS, children);
+  while (state.keepRunning())
+  {
+    for (unsigned i = 0; i < NUM_NODES; ++i)
+    {
+      doNotOptimize(nm.mkNode(PLUS, children));
+    }
+  }
+  state.setItemsProcessed(state.iterations() * NUM_NODES);
+}
+CVC4_BENCHMARK("node_manager/mk_node_nary", nodeManagerMkNodeNary);
+
+/** Construct fresh variables */
+void nodeManagerMkSkolem(State& state)
+{
+  NodeManager nm(nullptr);
+  NodeManagerScope scope(&nm);
+  TypeNode intType = nm.integerType();
+  std::vector<Node> vars;
+  vars.reserve(NUM_NODES);
+  while (state.keepRunning())
+  {
+    for (unsigned i = 0; i < NUM_NODES; ++i)
+    {
+      vars.push_back(nm.mkSkolem("x", intType));
+    }
+    vars.clear();
+  }
+  state.setItemsProcessed(state.iterations() * NUM_NODES);
+}
+CVC4_BENCHMARK("node_manager/mk_skolem", nodeManagerMkSkolem);
+
+struct BenchAttributeTag
+{
+};
+typedef expr::Attribute<BenchAttributeTag, Node> HashAttribute;
+typedef expr::Attribute<BenchAttributeTag, Node, false, true> DenseAttribute;
+
+/** Look up an attribute on NUM_NODES nodes */
+template <class AttrKind>
+void attributeLookup(State& state)
+{
+  NodeManager nm(nullptr);
+  NodeManagerScope scope(&nm);
+  std::vector<Node> nodes;
+  for (unsigned i = 0; i < NUM_NODES; ++i)
+  {
+    nodes.push_back(nm.mkSkolem("x", nm.integerType()));
+    nodes.back().setAttribute(AttrKind(), nodes.front());
+  }
+  while (state.keepRunning())
+  {
+    for (const Node& n : nodes)
+    {
+      doNotOptimize(n.getAttribute(AttrKind()));
+    }
+  }
+  state.setItemsProcessed(state.iterations() * NUM_NODES);
+}
+CVC4_BENCHMARK("attribute/hash_lookup", attributeLookup<HashAttribute>);
+CVC4_BENCHMARK("attribute/dense_lookup", attributeLookup<DenseAttribute>);
+
+/**
+ * Compute the types of fresh nodes, which are constructed while the timer is
+ * paused, and whose children have their types computed already
+ */
+void nodeManagerTypeCheck(State& state)
+{
+  NodeManager nm(nullptr);
+  NodeManagerScope scope(&nm);
+  Node x = nm.mkSkolem("x", nm.integerType());
+  nm.getType(x, true);
+  unsigned k = 0;
+  std::vector<Node> nodes;
+  while (state.keepRunning())
+  {
+    state.pauseTiming();
+    nodes.clear();
+    for (unsigned i = 0; i < NUM_NODES; ++i, ++k)
+    {
+      Node sum = nm.mkNode(PLUS, x, nm.mkConst(Rational(k)));
+      nodes.push_back(nm.mkNode(LEQ, sum, x));
+    }
+    state.resumeTiming();
+    for (const Node& n : nodes)
+    {
+      doNotOptimize(nm.getType(n, true));
+    }
+  }
+  state.setItemsProcessed(state.iterations() * NUM_NODES);
+}
+CVC4_BENCHMARK("node_manager/type_check", nodeManagerTypeCheck);
+
+using NodeHashMap = std::unordered_map<Node, Node, NodeHashFunction>;
+
+/** Fill and then look up a cache of the kind used by preprocessing passes */
+template <class Map>
+void nodeCacheLookup(State& state)
+{
+  NodeManager nm(nullptr);
+  NodeManagerScope scope(&nm);
+  std::vector<Node> nodes;
+  for (unsigned i = 0; i < NUM_NODES; ++i)
+  {
+    nodes.push_back(nm.mkSkolem("x", nm.integerType()));
+  }
+  Map cache;
+  while (state.keepRunning())
+  {
+    cache.clear();
+    for (const Node& n : nodes)
+    {
+      cache[n] = n;
+    }
+    for (const Node& n : nodes)
+    {
+      doNotOptimize(cache[n]);
+    }
+  }
+  state.setItemsProcessed(state.iterations() * NUM_NODES);
+}
+CVC4_BENCHMARK("node_cache/unordered_map", nodeCacheLookup<NodeHashMap>);
+CVC4_BENCHMARK("node_cache/node_map", nodeCacheLookup<expr::NodeMap<Node>>);
+
+}  // namespace
@@ -0,0 +1,254 @@
+/*********************                                                        */
+/*! \file theory_bench.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Microbenchmarks of the equality engine and the rewriter
+ **/
+
+#include <vector>
+
+#include "benchmark.h"
+#include "context/context.h"
+#include "expr/expr_manager.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+#include "theory/rewriter.h"
+#include "theory/uf/equality_engine.h"
+#include "util/bitvector.h"
+#include "util/rational.h"
+
+using namespace CVC4;
+using namespace CVC4::kind;
+using namespace CVC4::smt;
+using namespace CVC4::theory;
+using namespace CVC4::bench;
+
+namespace {
+
+const unsigned NUM_TERMS = 1000;
+
+/** A solver, in whose scope the benchmark runs */
+struct Environment
+{
+  Environment() : d_smt(&d_em), d_scope(&d_smt) {}
+  NodeManager* nm() { return NodeManager::currentNM(); }
+  ExprManager d_em;
+  SmtEngine d_smt;
+  SmtScope d_scope;
+};
+
+/** The terms of the equality engine benchmarks */
+struct EqualityTerms
+{
+  /** Make NUM_TERMS variables, and their applications of a function */
+  EqualityTerms(NodeManager* nm)
+  {
+    TypeNode u = nm->mkSort("U");
+    Node f = nm->mkSkolem("f", nm->mkFunctionType(u, u));
+    for (unsigned i = 0; i < NUM_TERMS; ++i)
+    {
+      d_vars.push_back(nm->mkSkolem("x", u));
+      d_apps.push_back(nm->mkNode(APPLY_UF, f, d_vars.back()));
+    }
+    for (unsigned i = 0; i + 1 < NUM_TERMS; ++i)
+    {
+      d_eqs.push_back(d_vars[i].eqNode(d_vars[i + 1]));
+    }
+  }
+  std::vector<Node> d_vars;
+  std::vector<Node> d_apps;
+  std::vector<Node> d_eqs;
+};
+
+/** Merge a chain of variables in a new context level, and pop it */
+void equalityEngineMerge(State& state)
+{
+  Environment env;
+  EqualityTerms terms(env.nm());
+  context::Context ctx;
+  eq::EqualityEngine ee(&ctx, "bench", false);
+  for (const Node& x : terms.d_vars)
+  {
+    ee.addTerm(x);
+  }
+  while (state.keepRunning())
+  {
+    ctx.push();
+    for (const Node& eq : terms.d_eqs)
+    {
+      ee.assertEquality(eq, true, eq);
+    }
+    ctx.pop();
+  }
+  state.setItemsProcessed(state.iterations() * terms.d_eqs.size());
+}
+CVC4_BENCHMARK("equality_engine/merge", equalityEngineMerge);
+
+/**
+ * Merge a chain of variables whose function applications are registered, so
+ * that each merge also merges two applications by congruence
+ */
+void equalityEngineMergeCongruence(State& state)
+{
+  Environment env;
+  EqualityTerms terms(env.nm());
+  context::Context ctx;
+  eq::EqualityEngine ee(&ctx, "bench", false);
+  ee.addFunctionKind(APPLY_UF);
+  for (const Node& app : terms.d_apps)
+  {
+    ee.addTerm(app);
+  }
+  while (state.keepRunning())
+  {
+    ctx.push();
+    for (const Node& eq : terms.d_eqs)
+    {
+      ee.assertEquality(eq, true, eq);
+    }
+    ctx.pop();
+  }
+  state.setItemsProcessed(state.iterations() * terms.d_eqs.size());
+}
+CVC4_BENCHMARK("equality_engine/merge_congruence",
+               equalityEngineMergeCongruence);
+
+/**
+ * Explain the equality of the ends of a chain of variables, and of their
+ * function applications
+ */
+void equalityEngineExplain(State& state)
+{
+  Environment env;
+  EqualityTerms terms(env.nm());
+  context::Context ctx;
+  eq::EqualityEngine ee(&ctx, "bench", false);
+  ee.addFunctionKind(APPLY_UF);
+  for (const Node& app : terms.d_apps)
+  {
+    ee.addTerm(app);
+  }
+  for (const Node& eq : terms.d_eqs)
+  {
+    ee.assertEquality(eq, true, eq);
+  }
+  std::vector<TNode> assumptions;
+  while (state.keepRunning())
+  {
+    assumptions.clear();
+    ee.explainEquality(
+        terms.d_vars.front(), terms.d_vars.back(), true, assumptions);
+    assumptions.clear();
+    ee.explainEquality(
+        terms.d_apps.front(), terms.d_apps.back(), true, assumptions);
+  }
+}
+CVC4_BENCHMARK("equality_engine/explain", equalityEngineExplain);
+
+/**
+ * Rewrite fresh arithmetic terms, which are constructed while the timer is
+ * paused
+ */
+void rewriterArith(State& state)
+{
+  Environment env;
+  NodeManager* nm = env.nm();
+  Node x = nm->mkSkolem("x", nm->integerType());
+  Node y = nm->mkSkolem("y", nm->integerType());
+  Node one = nm->mkConst(Rational(1));
+  Node three = nm->mkConst(Rational(3));
+  unsigned k = 0;
+  std::vector<Node> terms;
+  while (state.keepRunning())
+  {
+    state.pauseTiming();
+    terms.clear();
+    for (unsigned i = 0; i < NUM_TERMS; ++i, ++k)
+    {
+      // (x + k * y) - (3 * x + 1) <= k
+      Node c = nm->mkConst(Rational(k));
+      Node lhs = nm->mkNode(PLUS, x, nm->mkNode(MULT, c, y));
+      Node rhs = nm->mkNode(PLUS, nm->mkNode(MULT, three, x), one);
+      terms.push_back(nm->mkNode(LEQ, nm->mkNode(MINUS, lhs, rhs), c));
+    }
+    state.resumeTiming();
+    for (const Node& t : terms)
+    {
+      doNotOptimize(Rewriter::rewrite(t));
+    }
+  }
+  state.setItemsProcessed(state.iterations() * NUM_TERMS);
+}
+CVC4_BENCHMARK("rewriter/arith", rewriterArith);
+
+/**
+ * Rewrite fresh bit-vector terms, which are constructed while the timer is
+ * paused
+ */
+void rewriterBv(State& state)
+{
+  Environment env;
+  NodeManager* nm = env.nm();
+  Node x = nm->mkSkolem("x", nm->mkBitVectorType(32));
+  Node y = nm->mkSkolem("y", nm->mkBitVectorType(32));
+  Node extract = nm->mkConst(BitVectorExtract(15, 0));
+  unsigned k = 0;
+  std::vector<Node> terms;
+  while (state.keepRunning())
+  {
+    state.pauseTiming();
+    terms.clear();
+    for (unsigned i = 0; i < NUM_TERMS; ++i, ++k)
+    {
+      // ((x * k) + (y & k))[15:0] :: (x << 1)[15:0]
+      Node c = nm->mkConst(BitVector(32, k));
+      Node sum = nm->mkNode(BITVECTOR_PLUS,
+                            nm->mkNode(BITVECTOR_MULT, x, c),
+                            nm->mkNode(BITVECTOR_AND, y, c));
+      Node shift =
+          nm->mkNode(BITVECTOR_SHL, x, nm->mkConst(BitVector(32, 1u)));
+      terms.push_back(nm->mkNode(BITVECTOR_CONCAT,
+                                 nm->mkNode(extract, sum),
+                                 nm->mkNode(extract, shift)));
+    }
+    state.resumeTiming();
+    for (const Node& t : terms)
+    {
+      doNotOptimize(Rewriter::rewrite(t));
+    }
+  }
+  state.setItemsProcessed(state.iterations() * NUM_TERMS);
+}
+CVC4_BENCHMARK("rewriter/bv", rewriterBv);
+
+/** Rewrite terms that were rewritten before, i.e. hit the rewrite cache */
+void rewriterCached(State& state)
+{
+  Environment env;
+  NodeManager* nm = env.nm();
+  Node x = nm->mkSkolem("x", nm->integerType());
+  std::vector<Node> terms;
+  for (unsigned i = 0; i < NUM_TERMS; ++i)
+  {
+    terms.push_back(nm->mkNode(PLUS, x, nm->mkConst(Rational(i))));
+    Rewriter::rewrite(terms.back());
+  }
+  while (state.keepRunning())
+  {
+    for (const Node& t : terms)
+    {
+      doNotOptimize(Rewriter::rewrite(t));
+    }
+  }
+  state.setItemsProcessed(state.iterations() * NUM_TERMS);
+}
+CVC4_BENCHMARK("rewriter/cached", rewriterCached);
+
+}  // namespace
@@ -0,0 +1,141 @@
+/*********************                                                        */
+/*! \file util_bench.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Microbenchmarks of the arbitrary precision arithmetic
+ **/
+
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "util/integer.h"
+#include "util/rational.h"
+
+using namespace CVC4;
+using namespace CVC4::bench;
+
+namespace {
+
+const unsigned NUM_VALUES = 1000;
+
+/** Make NUM_VALUES integers of the given number of decimal digits */
+std::vector<Integer> mkIntegers(unsigned digits)
+{
+  std::vector<Integer> values;
+  for (unsigned i = 0; i < NUM_VALUES; ++i)
+  {
+    std::string s(digits, '7');
+    s[0] = '1' + i % 9;
+    s[digits - 1] = '1' + i % 7;
+    values.push_back(Integer(s));
+  }
+  return values;
+}
+
+/** Make NUM_VALUES rationals with small numerators and denominators */
+std::vector<Rational> mkRationals()
+{
+  std::vector<Rational> values;
+  for (unsigned i = 0; i < NUM_VALUES; ++i)
+  {
+    values.push_back(Rational(static_cast<signed long>(i) - 500,
+                              static_cast<signed long>(i % 97 + 1)));
+  }
+  return values;
+}
+
+void integerAddSmall(State& state)
+{
+  std::vector<Integer> values = mkIntegers(6);
+  while (state.keepRunning())
+  {
+    Integer sum;
+    for (const Integer& v : values)
+    {
+      sum = sum + v;
+    }
+    doNotOptimize(sum);
+  }
+  state.setItemsProcessed(state.iterations() * NUM_VALUES);
+}
+CVC4_BENCHMARK("integer/add_small", integerAddSmall);
+
+void integerMulSmall(State& state)
+{
+  std::vector<Integer> values = mkIntegers(6);
+  while (state.keepRunning())
+  {
+    for (const Integer& v : values)
+    {
+      doNotOptimize(v * v);
+    }
+  }
+  state.setItemsProcessed(state.iterations() * NUM_VALUES);
+}
+CVC4_BENCHMARK("integer/mul_small", integerMulSmall);
+
+void integerMulBig(State& state)
+{
+  std::vector<Integer> values = mkIntegers(60);
+  while (state.keepRunning())
+  {
+    for (const Integer& v : values)
+    {
+      doNotOptimize(v * v);
+    }
+  }
+  state.setItemsProcessed(state.iterations() * NUM_VALUES);
+}
+CVC4_BENCHMARK("integer/mul_big", integerMulBig);
+
+void integerGcd(State& state)
+{
+  std::vector<Integer> values = mkIntegers(20);
+  while (state.keepRunning())
+  {
+    for (unsigned i = 0; i + 1 < NUM_VALUES; ++i)
+    {
+      doNotOptimize(values[i].gcd(values[i + 1]));
+    }
+  }
+  state.setItemsProcessed(state.iterations() * (NUM_VALUES - 1));
+}
+CVC4_BENCHMARK("integer/gcd", integerGcd);
+
+void rationalAdd(State& state)
+{
+  std::vector<Rational> values = mkRationals();
+  while (state.keepRunning())
+  {
+    Rational sum;
+    for (const Rational& v : values)
+    {
+      sum = sum + v;
+    }
+    doNotOptimize(sum);
+  }
+  state.setItemsProcessed(state.iterations() * NUM_VALUES);
+}
+CVC4_BENCHMARK("rational/add", rationalAdd);
+
+void rationalMul(State& state)
+{
+  std::vector<Rational> values = mkRationals();
+  while (state.keepRunning())
+  {
+    for (unsigned i = 0; i + 1 < NUM_VALUES; ++i)
+    {
+      doNotOptimize(values[i] * values[i + 1]);
+    }
+  }
+  state.setItemsProcessed(state.iterations() * (NUM_VALUES - 1));
+}
+CVC4_BENCHMARK("rational/mul", rationalMul);
+
+}  // namespace
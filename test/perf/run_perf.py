@@ -0,0 +1,265 @@
+#!/usr/bin/env python3
+"""
+Usage:
+
+    run_perf.py [--repeat N] [--timeout SECONDS] [--output results.json]
+        [--baseline baseline.json] [--update-baseline]
+        [--time-threshold T] [--memory-threshold M] [--units-threshold U]
+        [--min-time SECONDS]
+        cvc4-binary benchmark-dir benchmark [benchmark ...]
+
+Runs each benchmark (given relative to benchmark-dir) with statistics enabled
+and records its wall time (the median of N runs), its maximum resident set
+size, and a few key statistics. The results are written as JSON. If a
+baseline is given, the results are compared against it, and the script exits
+with a nonzero status if any benchmark regressed by more than the given
+thresholds (relative to the baseline). With --update-baseline, the results
+are written to the baseline instead.
+"""
+
+import argparse
+import json
+import os
+import re
+import shlex
+import statistics
+import subprocess
+import sys
+import threading
+import time
+
+COMMAND_LINE = 'COMMAND-LINE:'
+
+EXIT_OK = 0
+EXIT_FAILURE = 1
+
+# The statistics that are recorded for each benchmark
+KEY_STATS = [
+    'smt::SmtEngine::resourceUnitsUsed',
+    'smt::SmtEngine::solveTime',
+    'smt::SmtEngine::processAssertionsTime',
+    'sat::conflicts',
+    'sat::decisions',
+    'sat::propagations',
+    'theory::conflicts',
+    'theory::lemmas',
+]
+
+
+def get_logic(benchmark_path, benchmark_content):
+    """Returns the logic of the benchmark, i.e. the argument of its set-logic
+    command, or SyGuS for SyGuS benchmarks."""
+
+    if benchmark_path.endswith('.sy'):
+        return 'SyGuS'
+    match = re.search(r'\(\s*set-logic\s+([A-Za-z_]+)\s*\)', benchmark_content)
+    return match.group(1) if match else 'ALL'
+
+
+def get_command_line(benchmark_content):
+    """Returns the options given in the first COMMAND-LINE directive of the
+    benchmark, if any."""
+
+    for line in benchmark_content.splitlines():
+        line = line.strip()
+        if line.startswith(';') or line.startswith('%'):
+            line = line[1:].lstrip()
+            if line.startswith(COMMAND_LINE):
+                return shlex.split(line[len(COMMAND_LINE):])
+    return []
+
+
+def parse_stats(error_output):
+    """Returns the key statistics from the JSON statistics, i.e. the last line
+    of the error output that is a JSON object."""
+
+    for line in reversed(error_output.splitlines()):
+        line = line.strip()
+        if not line.startswith('{'):
+            continue
+        try:
+            stats = json.loads(line)
+        except ValueError:
+            continue
+        result = {}
+        for name in KEY_STATS:
+            if name in stats:
+                try:
+                    result[name] = float(stats[name])
+                except (TypeError, ValueError):
+                    pass
+        return result
+    return {}
+
+
+def run_process(args, timeout):
+    """Runs a process with the arguments `args` and a timeout `timeout` in
+    seconds. Returns the wall time, the maximum resident set size in
+    kilobytes, the error output and the exit code of the process. If the
+    process times out, the exit code is 124."""
+
+    timed_out = threading.Event()
+    start = time.perf_counter()
+    proc = subprocess.Popen(
+        args, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+
+    def kill():
+        timed_out.set()
+        proc.kill()
+
+    timer = threading.Timer(timeout, kill)
+    timer.start()
+    try:
+        err = proc.stderr.read()
+        # Waiting with wait4 gives the resource usage of the process itself,
+        # rather than of all children as getrusage does
+        _, status, rusage = os.wait4(proc.pid, 0)
+    finally:
+        timer.cancel()
+        proc.stderr.close()
+    wall = time.perf_counter() - start
+    if timed_out.is_set():
+        return timeout, rusage.ru_maxrss, '', 124
+    if os.WIFEXITED(status):
+        exit_status = os.WEXITSTATUS(status)
+    else:
+        exit_status = 128 + os.WTERMSIG(status)
+    # the process is reaped already, so Popen must not wait for it
+    proc.returncode = exit_status
+    return wall, rusage.ru_maxrss, err.decode(), exit_status
+
+
+def run_benchmark(cvc4_binary, benchmark_dir, benchmark, repeat, timeout,
+                  solver_options):
+    """Runs the benchmark `repeat` times and returns its results. The
+    `solver_options` are passed to CVC4 after the options of the benchmark."""
+
+    benchmark_path = os.path.join(benchmark_dir, benchmark)
+    with open(benchmark_path, 'r') as f:
+        content = f.read()
+    args = [cvc4_binary, '--stats', '--stats-json'] + \
+        get_command_line(content) + solver_options + [benchmark_path]
+
+    times = []
+    memory = 0
+    stats = {}
+    exit_status = EXIT_OK
+    for _ in range(repeat):
+        wall, maxrss, err, exit_status = run_process(args, timeout)
+        times.append(wall)
+        memory = max(memory, maxrss)
+        if exit_status == 124:
+            break
+        stats = parse_stats(err)
+
+    return {
+        'logic': get_logic(benchmark_path, content),
+        'exit': exit_status,
+        'time': statistics.median(times),
+        'memory': memory,
+        'stats': stats,
+    }
+
+
+def compare(results, baseline, time_threshold, memory_threshold,
+            units_threshold, min_time):
+    """Compares the results against the baseline and prints the differences.
+    Returns the number of regressions."""
+
+    regressions = 0
+    for benchmark, res in sorted(results.items()):
+        if benchmark not in baseline:
+            print('{}: not in baseline'.format(benchmark))
+            continue
+        base = baseline[benchmark]
+        problems = []
+        if res['exit'] != base['exit']:
+            problems.append('exit status {} (baseline {})'.format(
+                res['exit'], base['exit']))
+        if res['time'] > base['time'] * (1 + time_threshold) and \
+                res['time'] - base['time'] > min_time:
+            problems.append('time {:.3f}s (baseline {:.3f}s)'.format(
+                res['time'], base['time']))
+        if base['memory'] > 0 and \
+                res['memory'] > base['memory'] * (1 + memory_threshold):
+            problems.append('memory {}KB (baseline {}KB)'.format(
+                res['memory'], base['memory']))
+        # resource units are deterministic, so they detect regressions
+        # independently of the noise in the time measurements
+        units = 'smt::SmtEngine::resourceUnitsUsed'
+        if units in res['stats'] and units in base['stats'] and \
+                res['stats'][units] > \
+                base['stats'][units] * (1 + units_threshold):
+            problems.append('resource units {:.0f} (baseline {:.0f})'.format(
+                res['stats'][units], base['stats'][units]))
+        if problems:
+            regressions += 1
+            print('{}: REGRESSION: {}'.format(benchmark, ', '.join(problems)))
+        else:
+            print('{}: ok ({:.3f}s, baseline {:.3f}s)'.format(
+                benchmark, res['time'], base['time']))
+    return regressions
+
+
+def main():
+    """Parses the command line arguments and then calls the core of the
+    script."""
+
+    parser = argparse.ArgumentParser(
+        description=
+        'Runs benchmarks and compares their performance against a baseline.')
+    parser.add_argument('--repeat', type=int, default=3)
+    parser.add_argument('--timeout', type=float, default=600.0)
+    parser.add_argument('--output')
+    parser.add_argument('--baseline')
+    parser.add_argument('--update-baseline', action='store_true')
+    parser.add_argument('--time-threshold', type=float, default=0.1)
+    parser.add_argument('--memory-threshold', type=float, default=0.1)
+    parser.add_argument('--units-threshold', type=float, default=0.02)
+    parser.add_argument('--min-time', type=float, default=0.05)
+    parser.add_argument('--solver-option', action='append', default=[],
+                        help='additional option for CVC4, e.g. '
+                        '--solver-option=--sat-branching=chb to compare a '
+                        'heuristic against the baseline')
+    parser.add_argument('cvc4_binary')
+    parser.add_argument('benchmark_dir')
+    parser.add_argument('benchmarks', nargs='+')
+    args = parser.parse_args()
+    cvc4_binary = os.path.abspath(args.cvc4_binary)
+
+    results = {}
+    for benchmark in args.benchmarks:
+        results[benchmark] = run_benchmark(cvc4_binary, args.benchmark_dir,
+                                           benchmark, max(args.repeat, 1),
+                                           args.timeout, args.solver_option)
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+
+    if args.baseline and args.update_baseline:
+        with open(args.baseline, 'w') as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+        print('Baseline written to {}'.format(args.baseline))
+        return EXIT_OK
+
+    if not args.baseline or not os.path.exists(args.baseline):
+        print('No baseline to compare against, run with --update-baseline to '
+              'create one')
+        for benchmark, res in sorted(results.items()):
+            print('{}: {:.3f}s, {}KB'.format(benchmark, res['time'],
+                                             res['memory']))
+        return EXIT_OK
+
+    with open(args.baseline, 'r') as f:
+        baseline = json.load(f)
+    regressions = compare(results, baseline, args.time_threshold,
+                          args.memory_threshold, args.units_threshold,
+                          args.min_time)
+    print('{} of {} benchmarks regressed'.format(regressions, len(results)))
+    return EXIT_FAILURE if regressions > 0 else EXIT_OK
+
+
+if __name__ == "__main__":
+    exit_code = main()
+    sys.exit(exit_code)
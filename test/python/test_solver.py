@@ -0,0 +1,101 @@
+import threading
+import unittest
+
+import pycvc4
+from pycvc4 import kinds
+
+
+class SolverTest(unittest.TestCase):
+
+    def setUp(self):
+        self.solver = pycvc4.Solver()
+
+    def test_check_sat(self):
+        self.solver.setLogic("QF_LIA")
+        intSort = self.solver.getIntegerSort()
+        x = self.solver.mkConst(intSort, "x")
+        zero = self.solver.mkReal(0)
+        self.solver.assertFormula(self.solver.mkTerm(kinds.Gt, x, zero))
+        self.assertTrue(self.solver.checkSat().isSat())
+        self.solver.assertFormula(self.solver.mkTerm(kinds.Lt, x, zero))
+        self.assertTrue(self.solver.checkSat().isUnsat())
+
+    def test_check_sat_assuming(self):
+        boolSort = self.solver.getBooleanSort()
+        p = self.solver.mkConst(boolSort, "p")
+        self.assertTrue(self.solver.checkSatAssuming(p).isSat())
+        self.assertTrue(
+            self.solver.checkSatAssuming([p, p.notTerm()]).isUnsat())
+
+    def test_terms(self):
+        boolSort = self.solver.getBooleanSort()
+        p, q = self.solver.mkConsts(boolSort, ["p", "q"])
+        t = self.solver.mkTerm(kinds.And, [p, q])
+        self.assertEqual(t.getKind(), kinds.And)
+        self.assertEqual(t.getSort(), boolSort)
+        self.assertEqual(list(t), [p, q])
+        self.assertEqual(t, p.andTerm(q))
+        self.assertEqual(hash(t), hash(p.andTerm(q)))
+        self.assertEqual(len({t, p.andTerm(q), p}), 2)
+        self.assertEqual(str(p), "p")
+
+    def test_errors(self):
+        intSort = self.solver.getIntegerSort()
+        x = self.solver.mkConst(intSort, "x")
+        with self.assertRaises(RuntimeError):
+            self.solver.mkTerm(kinds.And, x, x)
+
+    def test_get_values(self):
+        self.solver.setOption("produce-models", "true")
+        intSort = self.solver.getIntegerSort()
+        xs = self.solver.mkConsts(intSort, ["x{}".format(i) for i in range(10)])
+        self.solver.assertFormulas(
+            self.solver.mkTerm(kinds.Equal, x, self.solver.mkReal(i))
+            for i, x in enumerate(xs))
+        self.assertTrue(self.solver.checkSat().isSat())
+        values = self.solver.getValues(xs)
+        self.assertEqual(values, [self.solver.mkReal(i) for i in range(10)])
+        self.assertEqual(self.solver.getValue(xs[3]), values[3])
+
+    def test_push_pop(self):
+        boolSort = self.solver.getBooleanSort()
+        self.solver.setOption("incremental", "true")
+        p = self.solver.mkConst(boolSort, "p")
+        self.solver.assertFormula(p)
+        self.solver.push()
+        self.solver.assertFormula(p.notTerm())
+        self.assertTrue(self.solver.checkSat().isUnsat())
+        self.solver.pop()
+        self.assertTrue(self.solver.checkSat().isSat())
+
+    def test_recycle(self):
+        self.solver.setLogic("QF_UF")
+        boolSort = self.solver.getBooleanSort()
+        p = self.solver.mkConst(boolSort, "p")
+        self.solver.assertFormula(p.andTerm(p.notTerm()))
+        self.assertTrue(self.solver.checkSat().isUnsat())
+        self.solver.recycle()
+        self.assertTrue(self.solver.checkSat().isSat())
+
+    def test_check_sat_releases_gil(self):
+        # Solvers are independent, so they can be run from different threads
+        solvers = [pycvc4.Solver() for _ in range(4)]
+        results = [None] * len(solvers)
+
+        def run(i):
+            s = solvers[i]
+            p = s.mkConst(s.getBooleanSort(), "p")
+            s.assertFormula(p)
+            results[i] = s.checkSat()
+
+        threads = [threading.Thread(target=run, args=(i,))
+                   for i in range(len(solvers))]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.assertTrue(all(r.isSat() for r in results))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,44 @@
+import unittest
+
+import pycvc4
+from pycvc4 import kinds
+
+
+class TermBuilderTest(unittest.TestCase):
+
+    def setUp(self):
+        self.solver = pycvc4.Solver()
+        self.builder = pycvc4.TermBuilder(self.solver)
+
+    def test_mk_term(self):
+        boolSort = self.solver.getBooleanSort()
+        p = self.solver.mkConst(boolSort, "p")
+        q = self.solver.mkConst(boolSort, "q")
+        hp, hq = self.builder.addTerms([p, q])
+        h = self.builder.mkTerm(kinds.And, hp, hq)
+        self.assertEqual(len(self.builder), 3)
+        self.assertEqual(self.builder.getTerm(h), p.andTerm(q))
+
+    def test_mk_terms(self):
+        intSort = self.solver.getIntegerSort()
+        xs = self.solver.mkConsts(intSort, ["x{}".format(i) for i in range(8)])
+        self.builder.reserve(16)
+        handles = self.builder.addTerms(xs)
+        sums = self.builder.mkTerms(
+            kinds.Plus, zip(handles[:-1], handles[1:]))
+        self.assertEqual(len(sums), len(xs) - 1)
+        terms = self.builder.getTerms(sums)
+        for i, t in enumerate(terms):
+            self.assertEqual(t, self.solver.mkTerm(kinds.Plus, xs[i], xs[i + 1]))
+
+    def test_type_error(self):
+        intSort = self.solver.getIntegerSort()
+        x = self.solver.mkConst(intSort, "x")
+        hx = self.builder.addTerm(x)
+        h = self.builder.mkTerm(kinds.And, hx, hx)
+        with self.assertRaises(RuntimeError):
+            self.builder.getTerm(h)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -1,3 +1,5 @@
+; COMMAND-LINE:
+; COMMAND-LINE: --fast-parser
 (set-logic QF_NIA)
 (set-info :smt-lib-version 2.0)
 (set-info :status unsat)
@@ -0,0 +1,16 @@
+; COMMAND-LINE: --idl-propagation-limit=0
+; COMMAND-LINE: --idl-propagation-limit=32
+; EXPECT: unsat
+(set-logic QF_IDL)
+(declare-fun a () Int)
+(declare-fun b () Int)
+(declare-fun c () Int)
+(declare-fun d () Int)
+(declare-fun p () Bool)
+(assert (< (- a b) 0))
+(assert (or (<= (- b c) (- 1)) (<= (- b d) (- 2)) p))
+(assert (=> p (> (- a b) 0)))
+(assert (or (<= (- c a) 1) (= c (- a 5))))
+(assert (<= (- d a) 2))
+(assert (or (>= (- c d) 1) (>= (- a c) 0)))
+(check-sat)
@@ -0,0 +1,15 @@
+; COMMAND-LINE: --check-models
+; EXPECT: sat
+(set-logic QF_IDL)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(declare-fun w () Int)
+(assert (< (- x y) (- 3)))
+(assert (or (<= (- y z) (- 2)) (= y (+ z 7))))
+(assert (>= (- z x) 1))
+(assert (or (> (- w x) 10) (< (- w z) (- 10))))
+(assert (distinct w z))
+(assert (<= x 0))
+(assert (>= y (- 5)))
+(check-sat)
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --solve-int-as-bv=16
+; COMMAND-LINE: --solve-int-as-bv=16 --no-solve-int-as-bv-ranges
+; EXPECT: sat
+(set-logic QF_NIA)
+(set-info :status sat)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (and (<= 0 x) (<= x 10)))
+(assert (and (< (- 3) y) (not (> y 5))))
+(assert (and (<= 2 (* 2 z)) (<= (* 2 z) 9)))
+(assert (= (+ (* x y) z) 47))
+(assert (> (* (- x y) z) 7))
+(check-sat)
@@ -0,0 +1,29 @@
+; COMMAND-LINE: --incremental --gomory-cuts
+; COMMAND-LINE: --incremental --gomory-cuts --cut-branch-ratio=100
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(push 1)
+(assert (<= 1 (- (* 3 x) (* 3 y))))
+(assert (<= (- (* 3 x) (* 3 y)) 2))
+(check-sat)
+(pop 1)
+; y is bounded, so the cut of the row of x is explained by the bounds of
+; both nonbasic variables of the row
+(push 1)
+(assert (<= 1 (- (* 3 x) (* 3 y))))
+(assert (<= (- (* 3 x) (* 3 y)) 2))
+(assert (and (<= 0 x) (<= x 5)))
+(assert (and (<= 0 y) (<= y 5)))
+(check-sat)
+(pop 1)
+(assert (<= 1 (+ (* 2 x) (* 4 y) (* 3 z))))
+(assert (<= (+ (* 2 x) (* 4 y) (* 3 z)) 2))
+(assert (and (<= 0 x) (<= x 5)))
+(assert (and (<= 0 y) (<= y 5)))
+(assert (and (<= 0 z) (<= z 5)))
+(check-sat)
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --pb-native
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(declare-fun c () Bool)
+(declare-fun d () Bool)
+(declare-fun x () Int)
+(assert (<= (+ (ite a 1 0) (ite b 1 0) (ite c 1 0) (ite d 1 0) (ite (> x 0) 1 0)) 2))
+(assert (= (+ (ite a 1 0) (ite (not d) 1 0) (ite (> x 0) 0 1)) 1))
+(assert (or a b))
+(assert (or c d))
+(assert (> x 5))
+(check-sat)
@@ -0,0 +1,28 @@
+; COMMAND-LINE: --incremental --arith-row-activity
+; COMMAND-LINE: --incremental --no-arith-row-activity
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(declare-fun w () Real)
+(assert (<= 0 x 4))
+(assert (<= 0 y 3))
+(assert (<= (+ x y z) 10))
+(assert (>= (- (* 2 z) w) 1))
+(assert (or (>= w 6) (>= (+ x y) 6)))
+(check-sat)
+(push 1)
+(assert (>= w 20))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (<= x 1))
+(check-sat)
+(assert (>= z 5))
+(assert (> w 19))
+(check-sat)
+(pop 1)
@@ -0,0 +1,11 @@
+; COMMAND-LINE: --static-learning-tlimit=1
+; EXPECT: unsat
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(assert (= z (ite (< x y) x y)))
+(assert (> z x))
+(assert (> (ite (> x 0.0) 1.0 2.0) z))
+(assert (< z (ite (< x 0.0) x 3.0)))
+(check-sat)
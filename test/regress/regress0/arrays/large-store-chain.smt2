@@ -0,0 +1,366 @@
+; COMMAND-LINE: --check-models
+(set-logic QF_AUFBVLIA)
+(set-info :status sat)
+(declare-fun a () (Array Int Int))
+(declare-fun b () (Array (_ BitVec 8) (_ BitVec 8)))
+(assert (= (select a 0) 0))
+(assert (= (select a 37) 1))
+(assert (= (select a 74) 2))
+(assert (= (select a 111) 0))
+(assert (= (select a 148) 1))
+(assert (= (select a 185) 2))
+(assert (= (select a 22) 1))
+(assert (= (select a 59) 2))
+(assert (= (select a 96) 0))
+(assert (= (select a 133) 1))
+(assert (= (select a 170) 2))
+(assert (= (select a 7) 1))
+(assert (= (select a 44) 2))
+(assert (= (select a 81) 0))
+(assert (= (select a 118) 1))
+(assert (= (select a 155) 2))
+(assert (= (select a 192) 0))
+(assert (= (select a 29) 2))
+(assert (= (select a 66) 0))
+(assert (= (select a 103) 1))
+(assert (= (select a 140) 2))
+(assert (= (select a 177) 0))
+(assert (= (select a 14) 2))
+(assert (= (select a 51) 0))
+(assert (= (select a 88) 1))
+(assert (= (select a 125) 2))
+(assert (= (select a 162) 0))
+(assert (= (select a 199) 1))
+(assert (= (select a 36) 0))
+(assert (= (select a 73) 1))
+(assert (= (select a 110) 2))
+(assert (= (select a 147) 0))
+(assert (= (select a 184) 1))
+(assert (= (select a 21) 0))
+(assert (= (select a 58) 1))
+(assert (= (select a 95) 2))
+(assert (= (select a 132) 0))
+(assert (= (select a 169) 1))
+(assert (= (select a 6) 0))
+(assert (= (select a 43) 1))
+(assert (= (select a 80) 2))
+(assert (= (select a 117) 0))
+(assert (= (select a 154) 1))
+(assert (= (select a 191) 2))
+(assert (= (select a 28) 1))
+(assert (= (select a 65) 2))
+(assert (= (select a 102) 0))
+(assert (= (select a 139) 1))
+(assert (= (select a 176) 2))
+(assert (= (select a 13) 1))
+(assert (= (select a 50) 2))
+(assert (= (select a 87) 0))
+(assert (= (select a 124) 1))
+(assert (= (select a 161) 2))
+(assert (= (select a 198) 0))
+(assert (= (select a 35) 2))
+(assert (= (select a 72) 0))
+(assert (= (select a 109) 1))
+(assert (= (select a 146) 2))
+(assert (= (select a 183) 0))
+(assert (= (select a 20) 2))
+(assert (= (select a 57) 0))
+(assert (= (select a 94) 1))
+(assert (= (select a 131) 2))
+(assert (= (select a 168) 0))
+(assert (= (select a 5) 2))
+(assert (= (select a 42) 0))
+(assert (= (select a 79) 1))
+(assert (= (select a 116) 2))
+(assert (= (select a 153) 0))
+(assert (= (select a 190) 1))
+(assert (= (select a 27) 0))
+(assert (= (select a 64) 1))
+(assert (= (select a 101) 2))
+(assert (= (select a 138) 0))
+(assert (= (select a 175) 1))
+(assert (= (select a 12) 0))
+(assert (= (select a 49) 1))
+(assert (= (select a 86) 2))
+(assert (= (select a 123) 0))
+(assert (= (select a 160) 1))
+(assert (= (select a 197) 2))
+(assert (= (select a 34) 1))
+(assert (= (select a 71) 2))
+(assert (= (select a 108) 0))
+(assert (= (select a 145) 1))
+(assert (= (select a 182) 2))
+(assert (= (select a 19) 1))
+(assert (= (select a 56) 2))
+(assert (= (select a 93) 0))
+(assert (= (select a 130) 1))
+(assert (= (select a 167) 2))
+(assert (= (select a 4) 1))
+(assert (= (select a 41) 2))
+(assert (= (select a 78) 0))
+(assert (= (select a 115) 1))
+(assert (= (select a 152) 2))
+(assert (= (select a 189) 0))
+(assert (= (select a 26) 2))
+(assert (= (select a 63) 0))
+(assert (= (select a 100) 1))
+(assert (= (select a 137) 2))
+(assert (= (select a 174) 0))
+(assert (= (select a 11) 2))
+(assert (= (select a 48) 0))
+(assert (= (select a 85) 1))
+(assert (= (select a 122) 2))
+(assert (= (select a 159) 0))
+(assert (= (select a 196) 1))
+(assert (= (select a 33) 0))
+(assert (= (select a 70) 1))
+(assert (= (select a 107) 2))
+(assert (= (select a 144) 0))
+(assert (= (select a 181) 1))
+(assert (= (select a 18) 0))
+(assert (= (select a 55) 1))
+(assert (= (select a 92) 2))
+(assert (= (select a 129) 0))
+(assert (= (select a 166) 1))
+(assert (= (select a 3) 0))
+(assert (= (select a 40) 1))
+(assert (= (select a 77) 2))
+(assert (= (select a 114) 0))
+(assert (= (select a 151) 1))
+(assert (= (select a 188) 2))
+(assert (= (select a 25) 1))
+(assert (= (select a 62) 2))
+(assert (= (select a 99) 0))
+(assert (= (select a 136) 1))
+(assert (= (select a 173) 2))
+(assert (= (select a 10) 1))
+(assert (= (select a 47) 2))
+(assert (= (select a 84) 0))
+(assert (= (select a 121) 1))
+(assert (= (select a 158) 2))
+(assert (= (select a 195) 0))
+(assert (= (select a 32) 2))
+(assert (= (select a 69) 0))
+(assert (= (select a 106) 1))
+(assert (= (select a 143) 2))
+(assert (= (select a 180) 0))
+(assert (= (select a 17) 2))
+(assert (= (select a 54) 0))
+(assert (= (select a 91) 1))
+(assert (= (select a 128) 2))
+(assert (= (select a 165) 0))
+(assert (= (select a 2) 2))
+(assert (= (select a 39) 0))
+(assert (= (select a 76) 1))
+(assert (= (select a 113) 2))
+(assert (= (select a 150) 0))
+(assert (= (select a 187) 1))
+(assert (= (select a 24) 0))
+(assert (= (select a 61) 1))
+(assert (= (select a 98) 2))
+(assert (= (select a 135) 0))
+(assert (= (select a 172) 1))
+(assert (= (select a 9) 0))
+(assert (= (select a 46) 1))
+(assert (= (select a 83) 2))
+(assert (= (select a 120) 0))
+(assert (= (select a 157) 1))
+(assert (= (select a 194) 2))
+(assert (= (select a 31) 1))
+(assert (= (select a 68) 2))
+(assert (= (select a 105) 0))
+(assert (= (select a 142) 1))
+(assert (= (select a 179) 2))
+(assert (= (select a 16) 1))
+(assert (= (select a 53) 2))
+(assert (= (select a 90) 0))
+(assert (= (select a 127) 1))
+(assert (= (select a 164) 2))
+(assert (= (select a 1) 1))
+(assert (= (select a 38) 2))
+(assert (= (select a 75) 0))
+(assert (= (select a 112) 1))
+(assert (= (select a 149) 2))
+(assert (= (select a 186) 0))
+(assert (= (select a 23) 2))
+(assert (= (select a 60) 0))
+(assert (= (select a 97) 1))
+(assert (= (select a 134) 2))
+(assert (= (select a 171) 0))
+(assert (= (select a 8) 2))
+(assert (= (select a 45) 0))
+(assert (= (select a 82) 1))
+(assert (= (select a 119) 2))
+(assert (= (select a 156) 0))
+(assert (= (select a 193) 1))
+(assert (= (select a 30) 0))
+(assert (= (select a 67) 1))
+(assert (= (select a 104) 2))
+(assert (= (select a 141) 0))
+(assert (= (select a 178) 1))
+(assert (= (select a 15) 0))
+(assert (= (select a 52) 1))
+(assert (= (select a 89) 2))
+(assert (= (select a 126) 0))
+(assert (= (select a 163) 1))
+(assert (= (select b (_ bv0 8)) (_ bv2 8)))
+(assert (= (select b (_ bv101 8)) (_ bv1 8)))
+(assert (= (select b (_ bv202 8)) (_ bv1 8)))
+(assert (= (select b (_ bv47 8)) (_ bv1 8)))
+(assert (= (select b (_ bv148 8)) (_ bv2 8)))
+(assert (= (select b (_ bv249 8)) (_ bv1 8)))
+(assert (= (select b (_ bv94 8)) (_ bv1 8)))
+(assert (= (select b (_ bv195 8)) (_ bv1 8)))
+(assert (= (select b (_ bv40 8)) (_ bv2 8)))
+(assert (= (select b (_ bv141 8)) (_ bv1 8)))
+(assert (= (select b (_ bv242 8)) (_ bv1 8)))
+(assert (= (select b (_ bv87 8)) (_ bv1 8)))
+(assert (= (select b (_ bv188 8)) (_ bv2 8)))
+(assert (= (select b (_ bv33 8)) (_ bv1 8)))
+(assert (= (select b (_ bv134 8)) (_ bv1 8)))
+(assert (= (select b (_ bv235 8)) (_ bv1 8)))
+(assert (= (select b (_ bv80 8)) (_ bv2 8)))
+(assert (= (select b (_ bv181 8)) (_ bv1 8)))
+(assert (= (select b (_ bv26 8)) (_ bv1 8)))
+(assert (= (select b (_ bv127 8)) (_ bv1 8)))
+(assert (= (select b (_ bv228 8)) (_ bv2 8)))
+(assert (= (select b (_ bv73 8)) (_ bv1 8)))
+(assert (= (select b (_ bv174 8)) (_ bv1 8)))
+(assert (= (select b (_ bv19 8)) (_ bv1 8)))
+(assert (= (select b (_ bv120 8)) (_ bv2 8)))
+(assert (= (select b (_ bv221 8)) (_ bv1 8)))
+(assert (= (select b (_ bv66 8)) (_ bv1 8)))
+(assert (= (select b (_ bv167 8)) (_ bv1 8)))
+(assert (= (select b (_ bv12 8)) (_ bv2 8)))
+(assert (= (select b (_ bv113 8)) (_ bv1 8)))
+(assert (= (select b (_ bv214 8)) (_ bv1 8)))
+(assert (= (select b (_ bv59 8)) (_ bv1 8)))
+(assert (= (select b (_ bv160 8)) (_ bv2 8)))
+(assert (= (select b (_ bv5 8)) (_ bv1 8)))
+(assert (= (select b (_ bv106 8)) (_ bv1 8)))
+(assert (= (select b (_ bv207 8)) (_ bv1 8)))
+(assert (= (select b (_ bv52 8)) (_ bv2 8)))
+(assert (= (select b (_ bv153 8)) (_ bv1 8)))
+(assert (= (select b (_ bv254 8)) (_ bv1 8)))
+(assert (= (select b (_ bv99 8)) (_ bv1 8)))
+(assert (= (select b (_ bv200 8)) (_ bv2 8)))
+(assert (= (select b (_ bv45 8)) (_ bv1 8)))
+(assert (= (select b (_ bv146 8)) (_ bv1 8)))
+(assert (= (select b (_ bv247 8)) (_ bv1 8)))
+(assert (= (select b (_ bv92 8)) (_ bv2 8)))
+(assert (= (select b (_ bv193 8)) (_ bv1 8)))
+(assert (= (select b (_ bv38 8)) (_ bv1 8)))
+(assert (= (select b (_ bv139 8)) (_ bv1 8)))
+(assert (= (select b (_ bv240 8)) (_ bv2 8)))
+(assert (= (select b (_ bv85 8)) (_ bv1 8)))
+(assert (= (select b (_ bv186 8)) (_ bv1 8)))
+(assert (= (select b (_ bv31 8)) (_ bv1 8)))
+(assert (= (select b (_ bv132 8)) (_ bv2 8)))
+(assert (= (select b (_ bv233 8)) (_ bv1 8)))
+(assert (= (select b (_ bv78 8)) (_ bv1 8)))
+(assert (= (select b (_ bv179 8)) (_ bv1 8)))
+(assert (= (select b (_ bv24 8)) (_ bv2 8)))
+(assert (= (select b (_ bv125 8)) (_ bv1 8)))
+(assert (= (select b (_ bv226 8)) (_ bv1 8)))
+(assert (= (select b (_ bv71 8)) (_ bv1 8)))
+(assert (= (select b (_ bv172 8)) (_ bv2 8)))
+(assert (= (select b (_ bv17 8)) (_ bv1 8)))
+(assert (= (select b (_ bv118 8)) (_ bv1 8)))
+(assert (= (select b (_ bv219 8)) (_ bv1 8)))
+(assert (= (select b (_ bv64 8)) (_ bv2 8)))
+(assert (= (select b (_ bv165 8)) (_ bv1 8)))
+(assert (= (select b (_ bv10 8)) (_ bv1 8)))
+(assert (= (select b (_ bv111 8)) (_ bv1 8)))
+(assert (= (select b (_ bv212 8)) (_ bv2 8)))
+(assert (= (select b (_ bv57 8)) (_ bv1 8)))
+(assert (= (select b (_ bv158 8)) (_ bv1 8)))
+(assert (= (select b (_ bv3 8)) (_ bv1 8)))
+(assert (= (select b (_ bv104 8)) (_ bv2 8)))
+(assert (= (select b (_ bv205 8)) (_ bv1 8)))
+(assert (= (select b (_ bv50 8)) (_ bv1 8)))
+(assert (= (select b (_ bv151 8)) (_ bv1 8)))
+(assert (= (select b (_ bv252 8)) (_ bv2 8)))
+(assert (= (select b (_ bv97 8)) (_ bv1 8)))
+(assert (= (select b (_ bv198 8)) (_ bv1 8)))
+(assert (= (select b (_ bv43 8)) (_ bv1 8)))
+(assert (= (select b (_ bv144 8)) (_ bv2 8)))
+(assert (= (select b (_ bv245 8)) (_ bv1 8)))
+(assert (= (select b (_ bv90 8)) (_ bv1 8)))
+(assert (= (select b (_ bv191 8)) (_ bv1 8)))
+(assert (= (select b (_ bv36 8)) (_ bv2 8)))
+(assert (= (select b (_ bv137 8)) (_ bv1 8)))
+(assert (= (select b (_ bv238 8)) (_ bv1 8)))
+(assert (= (select b (_ bv83 8)) (_ bv1 8)))
+(assert (= (select b (_ bv184 8)) (_ bv2 8)))
+(assert (= (select b (_ bv29 8)) (_ bv1 8)))
+(assert (= (select b (_ bv130 8)) (_ bv1 8)))
+(assert (= (select b (_ bv231 8)) (_ bv1 8)))
+(assert (= (select b (_ bv76 8)) (_ bv2 8)))
+(assert (= (select b (_ bv177 8)) (_ bv1 8)))
+(assert (= (select b (_ bv22 8)) (_ bv1 8)))
+(assert (= (select b (_ bv123 8)) (_ bv1 8)))
+(assert (= (select b (_ bv224 8)) (_ bv2 8)))
+(assert (= (select b (_ bv69 8)) (_ bv1 8)))
+(assert (= (select b (_ bv170 8)) (_ bv1 8)))
+(assert (= (select b (_ bv15 8)) (_ bv1 8)))
+(assert (= (select b (_ bv116 8)) (_ bv2 8)))
+(assert (= (select b (_ bv217 8)) (_ bv1 8)))
+(assert (= (select b (_ bv62 8)) (_ bv1 8)))
+(assert (= (select b (_ bv163 8)) (_ bv1 8)))
+(assert (= (select b (_ bv8 8)) (_ bv2 8)))
+(assert (= (select b (_ bv109 8)) (_ bv1 8)))
+(assert (= (select b (_ bv210 8)) (_ bv1 8)))
+(assert (= (select b (_ bv55 8)) (_ bv1 8)))
+(assert (= (select b (_ bv156 8)) (_ bv2 8)))
+(assert (= (select b (_ bv1 8)) (_ bv1 8)))
+(assert (= (select b (_ bv102 8)) (_ bv1 8)))
+(assert (= (select b (_ bv203 8)) (_ bv1 8)))
+(assert (= (select b (_ bv48 8)) (_ bv2 8)))
+(assert (= (select b (_ bv149 8)) (_ bv1 8)))
+(assert (= (select b (_ bv250 8)) (_ bv1 8)))
+(assert (= (select b (_ bv95 8)) (_ bv1 8)))
+(assert (= (select b (_ bv196 8)) (_ bv2 8)))
+(assert (= (select b (_ bv41 8)) (_ bv1 8)))
+(assert (= (select b (_ bv142 8)) (_ bv1 8)))
+(assert (= (select b (_ bv243 8)) (_ bv1 8)))
+(assert (= (select b (_ bv88 8)) (_ bv2 8)))
+(assert (= (select b (_ bv189 8)) (_ bv1 8)))
+(assert (= (select b (_ bv34 8)) (_ bv1 8)))
+(assert (= (select b (_ bv135 8)) (_ bv1 8)))
+(assert (= (select b (_ bv236 8)) (_ bv2 8)))
+(assert (= (select b (_ bv81 8)) (_ bv1 8)))
+(assert (= (select b (_ bv182 8)) (_ bv1 8)))
+(assert (= (select b (_ bv27 8)) (_ bv1 8)))
+(assert (= (select b (_ bv128 8)) (_ bv2 8)))
+(assert (= (select b (_ bv229 8)) (_ bv1 8)))
+(assert (= (select b (_ bv74 8)) (_ bv1 8)))
+(assert (= (select b (_ bv175 8)) (_ bv1 8)))
+(assert (= (select b (_ bv20 8)) (_ bv2 8)))
+(assert (= (select b (_ bv121 8)) (_ bv1 8)))
+(assert (= (select b (_ bv222 8)) (_ bv1 8)))
+(assert (= (select b (_ bv67 8)) (_ bv1 8)))
+(assert (= (select b (_ bv168 8)) (_ bv2 8)))
+(assert (= (select b (_ bv13 8)) (_ bv1 8)))
+(assert (= (select b (_ bv114 8)) (_ bv1 8)))
+(assert (= (select b (_ bv215 8)) (_ bv1 8)))
+(assert (= (select b (_ bv60 8)) (_ bv2 8)))
+(assert (= (select b (_ bv161 8)) (_ bv1 8)))
+(assert (= (select b (_ bv6 8)) (_ bv1 8)))
+(assert (= (select b (_ bv107 8)) (_ bv1 8)))
+(assert (= (select b (_ bv208 8)) (_ bv2 8)))
+(assert (= (select b (_ bv53 8)) (_ bv1 8)))
+(assert (= (select b (_ bv154 8)) (_ bv1 8)))
+(assert (= (select b (_ bv255 8)) (_ bv1 8)))
+(assert (= (select b (_ bv100 8)) (_ bv2 8)))
+(assert (= (select b (_ bv201 8)) (_ bv1 8)))
+(assert (= (select b (_ bv46 8)) (_ bv1 8)))
+(assert (= (select b (_ bv147 8)) (_ bv1 8)))
+(assert (= (select b (_ bv248 8)) (_ bv2 8)))
+(assert (= (select b (_ bv93 8)) (_ bv1 8)))
+(assert (= (select b (_ bv194 8)) (_ bv1 8)))
+(assert (= (select b (_ bv39 8)) (_ bv1 8)))
+(assert (= (select b (_ bv140 8)) (_ bv2 8)))
+(assert (= (select b (_ bv241 8)) (_ bv1 8)))
+(assert (= (select b (_ bv86 8)) (_ bv1 8)))
+(assert (= (select b (_ bv187 8)) (_ bv1 8)))
+(check-sat)
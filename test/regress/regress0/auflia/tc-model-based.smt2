@@ -0,0 +1,14 @@
+; COMMAND-LINE: --tc-model-based
+; EXPECT: unsat
+(set-logic QF_AUFLIA)
+(declare-fun f (Int) Int)
+(declare-fun a () (Array Int Int))
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (<= x (+ y z)))
+(assert (<= (+ y z) x))
+(assert (= z (- (select a x) (select a y))))
+(assert (= (select a x) (select a y)))
+(assert (not (= (f x) (f y))))
+(check-sat)
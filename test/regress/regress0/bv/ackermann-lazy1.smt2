@@ -0,0 +1,16 @@
+; COMMAND-LINE: --bitblast=eager --no-check-unsat-cores
+; COMMAND-LINE: --bitblast=eager --ackermann-lazy --no-check-unsat-cores
+; EXPECT: unsat
+(set-logic QF_UFBV)
+(declare-fun f ((_ BitVec 8)) (_ BitVec 8))
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (= (f #x00) #x01))
+(assert (= (f #x01) #x02))
+(assert (= (f #x02) #x03))
+(assert (= (f (bvadd x #x01)) #x05))
+(assert (= (f (bvadd x #x02)) #x06))
+(assert (= (f y) (bvadd (f x) #x01)))
+(assert (= y (bvadd x #x01)))
+(assert (= (f x) #x05))
+(check-sat)
@@ -0,0 +1,15 @@
+; COMMAND-LINE: --bitblast=eager --no-check-models
+; COMMAND-LINE: --bitblast=eager --ackermann-lazy --no-check-models
+; EXPECT: sat
+(set-logic QF_UFBV)
+(declare-fun f ((_ BitVec 8)) (_ BitVec 8))
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (= (f #x00) #x01))
+(assert (= (f #x01) #x02))
+(assert (= (f #x02) #x03))
+(assert (= (f (bvadd x #x01)) #x05))
+(assert (= (f y) (bvadd (f x) #x01)))
+(assert (not (= x #x00)))
+(assert (not (= x #x01)))
+(check-sat)
@@ -0,0 +1,19 @@
+; COMMAND-LINE: --bv-abstraction --bv-abstraction-limit=8
+; COMMAND-LINE: --bv-abstraction
+; EXPECT: unsat
+(set-logic QF_BV)
+(set-info :status unsat)
+(declare-const x (_ BitVec 8))
+(declare-const y (_ BitVec 8))
+(declare-const z (_ BitVec 8))
+(assert
+ (or
+  (and (= (bvadd x y) z) (bvult x #x10))
+  (and (= (bvadd y z) x) (bvult y #x10))
+  (and (= (bvadd z x) y) (bvult z #x10))
+ )
+)
+(assert (bvuge x #x10))
+(assert (bvuge y #x10))
+(assert (bvuge z #x10))
+(check-sat)
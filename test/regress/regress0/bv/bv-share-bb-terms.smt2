@@ -0,0 +1,13 @@
+; COMMAND-LINE: --bitblast=lazy --bv-algebraic-solver --bv-quick-xplain
+; COMMAND-LINE: --bitblast=lazy --bv-algebraic-solver --bv-quick-xplain --no-bv-share-bb-terms
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(declare-fun z () (_ BitVec 8))
+(assert (= (bvmul x y) z))
+(assert (= (bvadd x #x01) y))
+(assert (bvult z #x10))
+(assert (bvugt x #x05))
+(assert (bvult x #x0f))
+(check-sat)
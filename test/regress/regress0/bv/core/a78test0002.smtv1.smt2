@@ -1,3 +1,5 @@
+; COMMAND-LINE:
+; COMMAND-LINE: --fast-parser
 (set-option :incremental false)
 (set-info :source "Bit-vector benchmarks from Dawson Engler's tool contributed by Vijay Ganesh
 (vganesh@stanford.edu).  Translated into SMT-LIB format by Clark Barrett using
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --incremental --bv-domain-solver
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (bvult x #x10))
+(assert (bvult y #x10))
+(push 1)
+(assert (= (bvadd x y) #xF0))
+(check-sat)
+(pop 1)
+(assert (= (bvadd x y) #x1E))
+(check-sat)
@@ -0,0 +1,27 @@
+; COMMAND-LINE: --incremental --bitblast=eager
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_BV)
+(declare-fun a () (_ BitVec 16))
+(declare-fun b () (_ BitVec 16))
+(declare-fun c () (_ BitVec 16))
+(assert (bvult a (bvadd b c)))
+(check-sat)
+(push 1)
+(assert (bvult c b))
+(push 1)
+(assert (bvugt c b))
+(check-sat)
+(pop 1)
+(check-sat)
+(assert (= a (bvadd b c)))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= b #x0000))
+(assert (= c #x0001))
+(check-sat)
+(pop 1)
@@ -0,0 +1,16 @@
+; COMMAND-LINE: --incremental --bitblast=eager
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 32))
+(declare-fun y () (_ BitVec 32))
+(assert (= (bvmul x y) #x0000002A))
+(assert (= x #x00000006))
+(check-sat)
+(reset-assertions)
+(assert (= (bvmul x y) #x0000002A))
+(assert (= x #x00000007))
+(check-sat)
+(assert (= y #x00000005))
+(check-sat)
@@ -0,0 +1,16 @@
+; COMMAND-LINE: --incremental --bv-multiplier=wallace --bv-multiplier-width=4 --bv-divider=non-restoring --bv-divider-width=4
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (= (bvmul x y) #x2A))
+(assert (= (bvurem x #x07) #x00))
+(assert (bvult #x01 x))
+(assert (= (bvmul ((_ extract 3 0) x) ((_ extract 3 0) y)) #xA))
+(check-sat)
+(push 1)
+(assert (bvult x #x08))
+(assert (= (bvudiv x y) #x00))
+(check-sat)
+(pop 1)
@@ -0,0 +1,11 @@
+; COMMAND-LINE: --bv-native-xor
+; COMMAND-LINE: --bv-native-xor --bitblast=eager
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun a () (_ BitVec 16))
+(declare-fun b () (_ BitVec 16))
+(declare-fun c () (_ BitVec 16))
+(assert (= (bvadd a b c) (bvxor a b c)))
+(assert (= (bvand a c) #x0000))
+(assert (= (bvand a b) #x0001))
+(check-sat)
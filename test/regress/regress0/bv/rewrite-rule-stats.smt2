@@ -0,0 +1,9 @@
+; COMMAND-LINE: --bv-rewrite-rule-stats --stats
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (= (bvand x #x00) (bvadd y #x01)))
+(assert (= (bvmul y #x02) (bvshl y #x01)))
+(assert (bvult (bvor x #xff) (bvnot (bvxor y y))))
+(check-sat)
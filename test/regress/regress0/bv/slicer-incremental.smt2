@@ -0,0 +1,21 @@
+; COMMAND-LINE: --incremental --bitblast=lazy --bv-eq-slicer=on
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 16))
+(declare-fun y () (_ BitVec 16))
+(declare-fun z () (_ BitVec 8))
+(assert (= ((_ extract 15 8) x) ((_ extract 7 0) y)))
+(check-sat)
+(push 1)
+(assert (= (concat z ((_ extract 7 0) y)) x))
+(assert (not (= z ((_ extract 15 8) y))))
+(assert (= ((_ extract 15 8) y) ((_ extract 7 0) y)))
+(check-sat)
+(pop 1)
+(assert (= ((_ extract 11 4) x) z))
+(check-sat)
+(assert (not (= ((_ extract 11 8) x) ((_ extract 3 0) y))))
+(check-sat)
@@ -0,0 +1,13 @@
+; COMMAND-LINE: --bv-sls=10000 --check-models
+; EXPECT: sat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 32))
+(declare-fun y () (_ BitVec 32))
+(declare-fun z () (_ BitVec 8))
+(declare-fun b () Bool)
+(assert (= (bvadd x y) #x00001234))
+(assert (bvult x #x00000100))
+(assert (= ((_ extract 7 0) y) (bvxor z #xf0)))
+(assert (or b (= z #x0f)))
+(assert (= (ite b (bvmul x #x00000003) y) #x00000021))
+(check-sat)
@@ -0,0 +1,86 @@
+; EXPECT: unsat
+(set-logic QF_UF)
+(declare-fun a0 () Bool)
+(declare-fun a1 () Bool)
+(declare-fun a2 () Bool)
+(declare-fun a3 () Bool)
+(declare-fun a4 () Bool)
+(declare-fun a5 () Bool)
+(declare-fun a6 () Bool)
+(declare-fun a7 () Bool)
+(declare-fun a8 () Bool)
+(declare-fun a9 () Bool)
+(declare-fun a10 () Bool)
+(declare-fun a11 () Bool)
+(declare-fun a12 () Bool)
+(declare-fun a13 () Bool)
+(declare-fun a14 () Bool)
+(declare-fun a15 () Bool)
+(declare-fun a16 () Bool)
+(declare-fun a17 () Bool)
+(declare-fun a18 () Bool)
+(declare-fun a19 () Bool)
+(declare-fun a20 () Bool)
+(declare-fun a21 () Bool)
+(declare-fun a22 () Bool)
+(declare-fun a23 () Bool)
+(declare-fun a24 () Bool)
+(declare-fun a25 () Bool)
+(declare-fun a26 () Bool)
+(declare-fun a27 () Bool)
+(declare-fun a28 () Bool)
+(declare-fun a29 () Bool)
+(declare-fun a30 () Bool)
+(declare-fun a31 () Bool)
+(declare-fun a32 () Bool)
+(declare-fun a33 () Bool)
+(declare-fun a34 () Bool)
+(declare-fun a35 () Bool)
+(declare-fun a36 () Bool)
+(declare-fun a37 () Bool)
+(declare-fun a38 () Bool)
+(declare-fun a39 () Bool)
+(declare-fun p () Bool)
+(assert (not a0))
+(assert (not a1))
+(assert (not a2))
+(assert (not a3))
+(assert (not a4))
+(assert (not a5))
+(assert (not a6))
+(assert (not a7))
+(assert (not a8))
+(assert (not a9))
+(assert (not a10))
+(assert (not a11))
+(assert (not a12))
+(assert (not a13))
+(assert (not a14))
+(assert (not a15))
+(assert (not a16))
+(assert (not a17))
+(assert (not a18))
+(assert (not a19))
+(assert (or a0 a1 a2 a3 a4 a5 a6 a7 a8 a9 a10 a11 a12 a13 a14 a15 a16 a17 a18 a19 p))
+(assert (not (and a20 a21 a22 a23 a24 a25 a26 a27 a28 a29 a30 a31 a32 a33 a34 a35 a36 a37 a38 a39)))
+(assert a20)
+(assert a21)
+(assert a22)
+(assert a23)
+(assert a24)
+(assert a25)
+(assert a26)
+(assert a27)
+(assert a28)
+(assert a29)
+(assert a30)
+(assert a31)
+(assert a32)
+(assert a33)
+(assert a34)
+(assert a35)
+(assert a36)
+(assert a37)
+(assert a38)
+(assert (or (not p) a39))
+(check-sat)
@@ -0,0 +1,16 @@
+; COMMAND-LINE: --decision=justification --decision-use-weight --decision-weight-internal=usr1
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(declare-fun c () Bool)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(define-fun s () Int (+ (ite a x y) (ite b (ite c x 1) y) (ite (and a c) 2 x)))
+(assert (or (and a (> s 10)) (and (not a) b (> s 20))))
+(assert (or (and c (< x 0)) (and (not c) (< y 0))))
+(assert (<= x 3))
+(assert (<= y 3))
+(assert (=> a (< (+ x y) 0)))
+(assert (=> (not a) (and (<= (+ x y) 2) (=> b (< x 2)))))
+(check-sat)
@@ -0,0 +1,13 @@
+; COMMAND-LINE: --finite-model-find --mbqi=none
+; COMMAND-LINE: --finite-model-find --mbqi=none --no-inst-no-entail-prefix
+(set-logic UF)
+(set-info :status sat)
+(declare-sort U 0)
+(declare-fun P (U U U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(assert (distinct a b c))
+(assert (P b b b))
+(assert (forall ((x U) (y U) (z U)) (or (= x a) (P x y z) (not (P y x z)))))
+(check-sat)
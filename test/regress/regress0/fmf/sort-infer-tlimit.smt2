@@ -0,0 +1,15 @@
+; COMMAND-LINE: --sort-inference --finite-model-find
+; COMMAND-LINE: --sort-inference --finite-model-find --sort-inference-tlimit=1
+; COMMAND-LINE: --sort-inference --finite-model-find --uf-ss-fair-monotone --sort-inference-tlimit=1
+; EXPECT: sat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun g (U) U)
+(declare-fun a () U)
+(declare-fun b () U)
+(assert (forall ((x U)) (= (f (f x)) x)))
+(assert (forall ((x U) (y U)) (=> (= (g x) (g y)) (= x y))))
+(assert (not (= (f a) a)))
+(assert (not (= (g b) a)))
+(check-sat)
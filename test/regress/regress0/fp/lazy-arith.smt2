@@ -0,0 +1,14 @@
+; REQUIRES: symfpu
+; COMMAND-LINE: --fp-lazy-arith
+; COMMAND-LINE:
+; EXPECT: unsat
+(set-logic QF_FP)
+(declare-const x Float32)
+(declare-const y Float32)
+(assert (= x (fp #b0 #x81 #b00000000000000000000000)))
+(assert (= y (fp #b0 #x80 #b00000000000000000000000)))
+(assert (or (fp.isNegative (fp.sqrt RNE x))
+            (not (= (fp.sqrt RNE x) y))
+            (not (= (fp.div RNE x y) y))
+            (fp.isNaN (fp.fma RNE x y y))))
+(check-sat)
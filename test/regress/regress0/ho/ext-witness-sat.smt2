@@ -0,0 +1,15 @@
+; COMMAND-LINE: --uf-ho
+; EXPECT: sat
+(set-logic ALL)
+(set-info :status sat)
+(declare-fun f (Bool) Bool)
+(declare-fun g (Bool) Bool)
+(declare-fun h (Bool) Bool)
+(declare-fun p ((-> Bool Bool)) Bool)
+(assert (f true))
+(assert (not (g true)))
+(assert (h false))
+(assert (p f))
+(assert (not (p h)))
+(assert (or (= g h) (= f h)))
+(check-sat)
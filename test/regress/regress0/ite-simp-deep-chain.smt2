@@ -0,0 +1,408 @@
+; COMMAND-LINE: --ite-simp --simp-ite-compress
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun c0 () Bool)
+(declare-fun c1 () Bool)
+(declare-fun c2 () Bool)
+(declare-fun c3 () Bool)
+(declare-fun c4 () Bool)
+(declare-fun c5 () Bool)
+(declare-fun c6 () Bool)
+(declare-fun c7 () Bool)
+(declare-fun c8 () Bool)
+(declare-fun c9 () Bool)
+(declare-fun c10 () Bool)
+(declare-fun c11 () Bool)
+(declare-fun c12 () Bool)
+(declare-fun c13 () Bool)
+(declare-fun c14 () Bool)
+(declare-fun c15 () Bool)
+(declare-fun c16 () Bool)
+(declare-fun c17 () Bool)
+(declare-fun c18 () Bool)
+(declare-fun c19 () Bool)
+(declare-fun c20 () Bool)
+(declare-fun c21 () Bool)
+(declare-fun c22 () Bool)
+(declare-fun c23 () Bool)
+(declare-fun c24 () Bool)
+(declare-fun c25 () Bool)
+(declare-fun c26 () Bool)
+(declare-fun c27 () Bool)
+(declare-fun c28 () Bool)
+(declare-fun c29 () Bool)
+(declare-fun c30 () Bool)
+(declare-fun c31 () Bool)
+(declare-fun c32 () Bool)
+(declare-fun c33 () Bool)
+(declare-fun c34 () Bool)
+(declare-fun c35 () Bool)
+(declare-fun c36 () Bool)
+(declare-fun c37 () Bool)
+(declare-fun c38 () Bool)
+(declare-fun c39 () Bool)
+(declare-fun c40 () Bool)
+(declare-fun c41 () Bool)
+(declare-fun c42 () Bool)
+(declare-fun c43 () Bool)
+(declare-fun c44 () Bool)
+(declare-fun c45 () Bool)
+(declare-fun c46 () Bool)
+(declare-fun c47 () Bool)
+(declare-fun c48 () Bool)
+(declare-fun c49 () Bool)
+(declare-fun c50 () Bool)
+(declare-fun c51 () Bool)
+(declare-fun c52 () Bool)
+(declare-fun c53 () Bool)
+(declare-fun c54 () Bool)
+(declare-fun c55 () Bool)
+(declare-fun c56 () Bool)
+(declare-fun c57 () Bool)
+(declare-fun c58 () Bool)
+(declare-fun c59 () Bool)
+(declare-fun c60 () Bool)
+(declare-fun c61 () Bool)
+(declare-fun c62 () Bool)
+(declare-fun c63 () Bool)
+(declare-fun c64 () Bool)
+(declare-fun c65 () Bool)
+(declare-fun c66 () Bool)
+(declare-fun c67 () Bool)
+(declare-fun c68 () Bool)
+(declare-fun c69 () Bool)
+(declare-fun c70 () Bool)
+(declare-fun c71 () Bool)
+(declare-fun c72 () Bool)
+(declare-fun c73 () Bool)
+(declare-fun c74 () Bool)
+(declare-fun c75 () Bool)
+(declare-fun c76 () Bool)
+(declare-fun c77 () Bool)
+(declare-fun c78 () Bool)
+(declare-fun c79 () Bool)
+(declare-fun c80 () Bool)
+(declare-fun c81 () Bool)
+(declare-fun c82 () Bool)
+(declare-fun c83 () Bool)
+(declare-fun c84 () Bool)
+(declare-fun c85 () Bool)
+(declare-fun c86 () Bool)
+(declare-fun c87 () Bool)
+(declare-fun c88 () Bool)
+(declare-fun c89 () Bool)
+(declare-fun c90 () Bool)
+(declare-fun c91 () Bool)
+(declare-fun c92 () Bool)
+(declare-fun c93 () Bool)
+(declare-fun c94 () Bool)
+(declare-fun c95 () Bool)
+(declare-fun c96 () Bool)
+(declare-fun c97 () Bool)
+(declare-fun c98 () Bool)
+(declare-fun c99 () Bool)
+(declare-fun c100 () Bool)
+(declare-fun c101 () Bool)
+(declare-fun c102 () Bool)
+(declare-fun c103 () Bool)
+(declare-fun c104 () Bool)
+(declare-fun c105 () Bool)
+(declare-fun c106 () Bool)
+(declare-fun c107 () Bool)
+(declare-fun c108 () Bool)
+(declare-fun c109 () Bool)
+(declare-fun c110 () Bool)
+(declare-fun c111 () Bool)
+(declare-fun c112 () Bool)
+(declare-fun c113 () Bool)
+(declare-fun c114 () Bool)
+(declare-fun c115 () Bool)
+(declare-fun c116 () Bool)
+(declare-fun c117 () Bool)
+(declare-fun c118 () Bool)
+(declare-fun c119 () Bool)
+(declare-fun c120 () Bool)
+(declare-fun c121 () Bool)
+(declare-fun c122 () Bool)
+(declare-fun c123 () Bool)
+(declare-fun c124 () Bool)
+(declare-fun c125 () Bool)
+(declare-fun c126 () Bool)
+(declare-fun c127 () Bool)
+(declare-fun c128 () Bool)
+(declare-fun c129 () Bool)
+(declare-fun c130 () Bool)
+(declare-fun c131 () Bool)
+(declare-fun c132 () Bool)
+(declare-fun c133 () Bool)
+(declare-fun c134 () Bool)
+(declare-fun c135 () Bool)
+(declare-fun c136 () Bool)
+(declare-fun c137 () Bool)
+(declare-fun c138 () Bool)
+(declare-fun c139 () Bool)
+(declare-fun c140 () Bool)
+(declare-fun c141 () Bool)
+(declare-fun c142 () Bool)
+(declare-fun c143 () Bool)
+(declare-fun c144 () Bool)
+(declare-fun c145 () Bool)
+(declare-fun c146 () Bool)
+(declare-fun c147 () Bool)
+(declare-fun c148 () Bool)
+(declare-fun c149 () Bool)
+(declare-fun c150 () Bool)
+(declare-fun c151 () Bool)
+(declare-fun c152 () Bool)
+(declare-fun c153 () Bool)
+(declare-fun c154 () Bool)
+(declare-fun c155 () Bool)
+(declare-fun c156 () Bool)
+(declare-fun c157 () Bool)
+(declare-fun c158 () Bool)
+(declare-fun c159 () Bool)
+(declare-fun c160 () Bool)
+(declare-fun c161 () Bool)
+(declare-fun c162 () Bool)
+(declare-fun c163 () Bool)
+(declare-fun c164 () Bool)
+(declare-fun c165 () Bool)
+(declare-fun c166 () Bool)
+(declare-fun c167 () Bool)
+(declare-fun c168 () Bool)
+(declare-fun c169 () Bool)
+(declare-fun c170 () Bool)
+(declare-fun c171 () Bool)
+(declare-fun c172 () Bool)
+(declare-fun c173 () Bool)
+(declare-fun c174 () Bool)
+(declare-fun c175 () Bool)
+(declare-fun c176 () Bool)
+(declare-fun c177 () Bool)
+(declare-fun c178 () Bool)
+(declare-fun c179 () Bool)
+(declare-fun c180 () Bool)
+(declare-fun c181 () Bool)
+(declare-fun c182 () Bool)
+(declare-fun c183 () Bool)
+(declare-fun c184 () Bool)
+(declare-fun c185 () Bool)
+(declare-fun c186 () Bool)
+(declare-fun c187 () Bool)
+(declare-fun c188 () Bool)
+(declare-fun c189 () Bool)
+(declare-fun c190 () Bool)
+(declare-fun c191 () Bool)
+(declare-fun c192 () Bool)
+(declare-fun c193 () Bool)
+(declare-fun c194 () Bool)
+(declare-fun c195 () Bool)
+(declare-fun c196 () Bool)
+(declare-fun c197 () Bool)
+(declare-fun c198 () Bool)
+(declare-fun c199 () Bool)
+(declare-fun c200 () Bool)
+(declare-fun c201 () Bool)
+(declare-fun c202 () Bool)
+(declare-fun c203 () Bool)
+(declare-fun c204 () Bool)
+(declare-fun c205 () Bool)
+(declare-fun c206 () Bool)
+(declare-fun c207 () Bool)
+(declare-fun c208 () Bool)
+(declare-fun c209 () Bool)
+(declare-fun c210 () Bool)
+(declare-fun c211 () Bool)
+(declare-fun c212 () Bool)
+(declare-fun c213 () Bool)
+(declare-fun c214 () Bool)
+(declare-fun c215 () Bool)
+(declare-fun c216 () Bool)
+(declare-fun c217 () Bool)
+(declare-fun c218 () Bool)
+(declare-fun c219 () Bool)
+(declare-fun c220 () Bool)
+(declare-fun c221 () Bool)
+(declare-fun c222 () Bool)
+(declare-fun c223 () Bool)
+(declare-fun c224 () Bool)
+(declare-fun c225 () Bool)
+(declare-fun c226 () Bool)
+(declare-fun c227 () Bool)
+(declare-fun c228 () Bool)
+(declare-fun c229 () Bool)
+(declare-fun c230 () Bool)
+(declare-fun c231 () Bool)
+(declare-fun c232 () Bool)
+(declare-fun c233 () Bool)
+(declare-fun c234 () Bool)
+(declare-fun c235 () Bool)
+(declare-fun c236 () Bool)
+(declare-fun c237 () Bool)
+(declare-fun c238 () Bool)
+(declare-fun c239 () Bool)
+(declare-fun c240 () Bool)
+(declare-fun c241 () Bool)
+(declare-fun c242 () Bool)
+(declare-fun c243 () Bool)
+(declare-fun c244 () Bool)
+(declare-fun c245 () Bool)
+(declare-fun c246 () Bool)
+(declare-fun c247 () Bool)
+(declare-fun c248 () Bool)
+(declare-fun c249 () Bool)
+(declare-fun c250 () Bool)
+(declare-fun c251 () Bool)
+(declare-fun c252 () Bool)
+(declare-fun c253 () Bool)
+(declare-fun c254 () Bool)
+(declare-fun c255 () Bool)
+(declare-fun c256 () Bool)
+(declare-fun c257 () Bool)
+(declare-fun c258 () Bool)
+(declare-fun c259 () Bool)
+(declare-fun c260 () Bool)
+(declare-fun c261 () Bool)
+(declare-fun c262 () Bool)
+(declare-fun c263 () Bool)
+(declare-fun c264 () Bool)
+(declare-fun c265 () Bool)
+(declare-fun c266 () Bool)
+(declare-fun c267 () Bool)
+(declare-fun c268 () Bool)
+(declare-fun c269 () Bool)
+(declare-fun c270 () Bool)
+(declare-fun c271 () Bool)
+(declare-fun c272 () Bool)
+(declare-fun c273 () Bool)
+(declare-fun c274 () Bool)
+(declare-fun c275 () Bool)
+(declare-fun c276 () Bool)
+(declare-fun c277 () Bool)
+(declare-fun c278 () Bool)
+(declare-fun c279 () Bool)
+(declare-fun c280 () Bool)
+(declare-fun c281 () Bool)
+(declare-fun c282 () Bool)
+(declare-fun c283 () Bool)
+(declare-fun c284 () Bool)
+(declare-fun c285 () Bool)
+(declare-fun c286 () Bool)
+(declare-fun c287 () Bool)
+(declare-fun c288 () Bool)
+(declare-fun c289 () Bool)
+(declare-fun c290 () Bool)
+(declare-fun c291 () Bool)
+(declare-fun c292 () Bool)
+(declare-fun c293 () Bool)
+(declare-fun c294 () Bool)
+(declare-fun c295 () Bool)
+(declare-fun c296 () Bool)
+(declare-fun c297 () Bool)
+(declare-fun c298 () Bool)
+(declare-fun c299 () Bool)
+(declare-fun c300 () Bool)
+(declare-fun c301 () Bool)
+(declare-fun c302 () Bool)
+(declare-fun c303 () Bool)
+(declare-fun c304 () Bool)
+(declare-fun c305 () Bool)
+(declare-fun c306 () Bool)
+(declare-fun c307 () Bool)
+(declare-fun c308 () Bool)
+(declare-fun c309 () Bool)
+(declare-fun c310 () Bool)
+(declare-fun c311 () Bool)
+(declare-fun c312 () Bool)
+(declare-fun c313 () Bool)
+(declare-fun c314 () Bool)
+(declare-fun c315 () Bool)
+(declare-fun c316 () Bool)
+(declare-fun c317 () Bool)
+(declare-fun c318 () Bool)
+(declare-fun c319 () Bool)
+(declare-fun c320 () Bool)
+(declare-fun c321 () Bool)
+(declare-fun c322 () Bool)
+(declare-fun c323 () Bool)
+(declare-fun c324 () Bool)
+(declare-fun c325 () Bool)
+(declare-fun c326 () Bool)
+(declare-fun c327 () Bool)
+(declare-fun c328 () Bool)
+(declare-fun c329 () Bool)
+(declare-fun c330 () Bool)
+(declare-fun c331 () Bool)
+(declare-fun c332 () Bool)
+(declare-fun c333 () Bool)
+(declare-fun c334 () Bool)
+(declare-fun c335 () Bool)
+(declare-fun c336 () Bool)
+(declare-fun c337 () Bool)
+(declare-fun c338 () Bool)
+(declare-fun c339 () Bool)
+(declare-fun c340 () Bool)
+(declare-fun c341 () Bool)
+(declare-fun c342 () Bool)
+(declare-fun c343 () Bool)
+(declare-fun c344 () Bool)
+(declare-fun c345 () Bool)
+(declare-fun c346 () Bool)
+(declare-fun c347 () Bool)
+(declare-fun c348 () Bool)
+(declare-fun c349 () Bool)
+(declare-fun c350 () Bool)
+(declare-fun c351 () Bool)
+(declare-fun c352 () Bool)
+(declare-fun c353 () Bool)
+(declare-fun c354 () Bool)
+(declare-fun c355 () Bool)
+(declare-fun c356 () Bool)
+(declare-fun c357 () Bool)
+(declare-fun c358 () Bool)
+(declare-fun c359 () Bool)
+(declare-fun c360 () Bool)
+(declare-fun c361 () Bool)
+(declare-fun c362 () Bool)
+(declare-fun c363 () Bool)
+(declare-fun c364 () Bool)
+(declare-fun c365 () Bool)
+(declare-fun c366 () Bool)
+(declare-fun c367 () Bool)
+(declare-fun c368 () Bool)
+(declare-fun c369 () Bool)
+(declare-fun c370 () Bool)
+(declare-fun c371 () Bool)
+(declare-fun c372 () Bool)
+(declare-fun c373 () Bool)
+(declare-fun c374 () Bool)
+(declare-fun c375 () Bool)
+(declare-fun c376 () Bool)
+(declare-fun c377 () Bool)
+(declare-fun c378 () Bool)
+(declare-fun c379 () Bool)
+(declare-fun c380 () Bool)
+(declare-fun c381 () Bool)
+(declare-fun c382 () Bool)
+(declare-fun c383 () Bool)
+(declare-fun c384 () Bool)
+(declare-fun c385 () Bool)
+(declare-fun c386 () Bool)
+(declare-fun c387 () Bool)
+(declare-fun c388 () Bool)
+(declare-fun c389 () Bool)
+(declare-fun c390 () Bool)
+(declare-fun c391 () Bool)
+(declare-fun c392 () Bool)
+(declare-fun c393 () Bool)
+(declare-fun c394 () Bool)
+(declare-fun c395 () Bool)
+(declare-fun c396 () Bool)
+(declare-fun c397 () Bool)
+(declare-fun c398 () Bool)
+(declare-fun c399 () Bool)
+(define-fun t () Int (ite c399 400 (ite c398 399 (ite c397 398 (ite c396 397 (ite c395 396 (ite c394 395 (ite c393 394 (ite c392 393 (ite c391 392 (ite c390 391 (ite c389 390 (ite c388 389 (ite c387 388 (ite c386 387 (ite c385 386 (ite c384 385 (ite c383 384 (ite c382 383 (ite c381 382 (ite c380 381 (ite c379 380 (ite c378 379 (ite c377 378 (ite c376 377 (ite c375 376 (ite c374 375 (ite c373 374 (ite c372 373 (ite c371 372 (ite c370 371 (ite c369 370 (ite c368 369 (ite c367 368 (ite c366 367 (ite c365 366 (ite c364 365 (ite c363 364 (ite c362 363 (ite c361 362 (ite c360 361 (ite c359 360 (ite c358 359 (ite c357 358 (ite c356 357 (ite c355 356 (ite c354 355 (ite c353 354 (ite c352 353 (ite c351 352 (ite c350 351 (ite c349 350 (ite c348 349 (ite c347 348 (ite c346 347 (ite c345 346 (ite c344 345 (ite c343 344 (ite c342 343 (ite c341 342 (ite c340 341 (ite c339 340 (ite c338 339 (ite c337 338 (ite c336 337 (ite c335 336 (ite c334 335 (ite c333 334 (ite c332 333 (ite c331 332 (ite c330 331 (ite c329 330 (ite c328 329 (ite c327 328 (ite c326 327 (ite c325 326 (ite c324 325 (ite c323 324 (ite c322 323 (ite c321 322 (ite c320 321 (ite c319 320 (ite c318 319 (ite c317 318 (ite c316 317 (ite c315 316 (ite c314 315 (ite c313 314 (ite c312 313 (ite c311 312 (ite c310 311 (ite c309 310 (ite c308 309 (ite c307 308 (ite c306 307 (ite c305 306 (ite c304 305 (ite c303 304 (ite c302 303 (ite c301 302 (ite c300 301 (ite c299 300 (ite c298 299 (ite c297 298 (ite c296 297 (ite c295 296 (ite c294 295 (ite c293 294 (ite c292 293 (ite c291 292 (ite c290 291 (ite c289 290 (ite c288 289 (ite c287 288 (ite c286 287 (ite c285 286 (ite c284 285 (ite c283 284 (ite c282 283 (ite c281 282 (ite c280 281 (ite c279 280 (ite c278 279 (ite c277 278 (ite c276 277 (ite c275 276 (ite c274 275 (ite c273 274 (ite c272 273 (ite c271 272 (ite c270 271 (ite c269 270 (ite c268 269 (ite c267 268 (ite c266 267 (ite c265 266 (ite c264 265 (ite c263 264 (ite c262 263 (ite c261 262 (ite c260 261 (ite c259 260 (ite c258 259 (ite c257 258 (ite c256 257 (ite c255 256 (ite c254 255 (ite c253 254 (ite c252 253 (ite c251 252 (ite c250 251 (ite c249 250 (ite c248 249 (ite c247 248 (ite c246 247 (ite c245 246 (ite c244 245 (ite c243 244 (ite c242 243 (ite c241 242 (ite c240 241 (ite c239 240 (ite c238 239 (ite c237 238 (ite c236 237 (ite c235 236 (ite c234 235 (ite c233 234 (ite c232 233 (ite c231 232 (ite c230 231 (ite c229 230 (ite c228 229 (ite c227 228 (ite c226 227 (ite c225 226 (ite c224 225 (ite c223 224 (ite c222 223 (ite c221 222 (ite c220 221 (ite c219 220 (ite c218 219 (ite c217 218 (ite c216 217 (ite c215 216 (ite c214 215 (ite c213 214 (ite c212 213 (ite c211 212 (ite c210 211 (ite c209 210 (ite c208 209 (ite c207 208 (ite c206 207 (ite c205 206 (ite c204 205 (ite c203 204 (ite c202 203 (ite c201 202 (ite c200 201 (ite c199 200 (ite c198 199 (ite c197 198 (ite c196 197 (ite c195 196 (ite c194 195 (ite c193 194 (ite c192 193 (ite c191 192 (ite c190 191 (ite c189 190 (ite c188 189 (ite c187 188 (ite c186 187 (ite c185 186 (ite c184 185 (ite c183 184 (ite c182 183 (ite c181 182 (ite c180 181 (ite c179 180 (ite c178 179 (ite c177 178 (ite c176 177 (ite c175 176 (ite c174 175 (ite c173 174 (ite c172 173 (ite c171 172 (ite c170 171 (ite c169 170 (ite c168 169 (ite c167 168 (ite c166 167 (ite c165 166 (ite c164 165 (ite c163 164 (ite c162 163 (ite c161 162 (ite c160 161 (ite c159 160 (ite c158 159 (ite c157 158 (ite c156 157 (ite c155 156 (ite c154 155 (ite c153 154 (ite c152 153 (ite c151 152 (ite c150 151 (ite c149 150 (ite c148 149 (ite c147 148 (ite c146 147 (ite c145 146 (ite c144 145 (ite c143 144 (ite c142 143 (ite c141 142 (ite c140 141 (ite c139 140 (ite c138 139 (ite c137 138 (ite c136 137 (ite c135 136 (ite c134 135 (ite c133 134 (ite c132 133 (ite c131 132 (ite c130 131 (ite c129 130 (ite c128 129 (ite c127 128 (ite c126 127 (ite c125 126 (ite c124 125 (ite c123 124 (ite c122 123 (ite c121 122 (ite c120 121 (ite c119 120 (ite c118 119 (ite c117 118 (ite c116 117 (ite c115 116 (ite c114 115 (ite c113 114 (ite c112 113 (ite c111 112 (ite c110 111 (ite c109 110 (ite c108 109 (ite c107 108 (ite c106 107 (ite c105 106 (ite c104 105 (ite c103 104 (ite c102 103 (ite c101 102 (ite c100 101 (ite c99 100 (ite c98 99 (ite c97 98 (ite c96 97 (ite c95 96 (ite c94 95 (ite c93 94 (ite c92 93 (ite c91 92 (ite c90 91 (ite c89 90 (ite c88 89 (ite c87 88 (ite c86 87 (ite c85 86 (ite c84 85 (ite c83 84 (ite c82 83 (ite c81 82 (ite c80 81 (ite c79 80 (ite c78 79 (ite c77 78 (ite c76 77 (ite c75 76 (ite c74 75 (ite c73 74 (ite c72 73 (ite c71 72 (ite c70 71 (ite c69 70 (ite c68 69 (ite c67 68 (ite c66 67 (ite c65 66 (ite c64 65 (ite c63 64 (ite c62 63 (ite c61 62 (ite c60 61 (ite c59 60 (ite c58 59 (ite c57 58 (ite c56 57 (ite c55 56 (ite c54 55 (ite c53 54 (ite c52 53 (ite c51 52 (ite c50 51 (ite c49 50 (ite c48 49 (ite c47 48 (ite c46 47 (ite c45 46 (ite c44 45 (ite c43 44 (ite c42 43 (ite c41 42 (ite c40 41 (ite c39 40 (ite c38 39 (ite c37 38 (ite c36 37 (ite c35 36 (ite c34 35 (ite c33 34 (ite c32 33 (ite c31 32 (ite c30 31 (ite c29 30 (ite c28 29 (ite c27 28 (ite c26 27 (ite c25 26 (ite c24 25 (ite c23 24 (ite c22 23 (ite c21 22 (ite c20 21 (ite c19 20 (ite c18 19 (ite c17 18 (ite c16 17 (ite c15 16 (ite c14 15 (ite c13 14 (ite c12 13 (ite c11 12 (ite c10 11 (ite c9 10 (ite c8 9 (ite c7 8 (ite c6 7 (ite c5 6 (ite c4 5 (ite c3 4 (ite c2 3 (ite c1 2 (ite c0 1 0)))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))
+(assert (= x t))
+(assert (> x 400))
+(check-sat)
@@ -0,0 +1,8 @@
+; COMMAND-LINE: --nl-ext --nl-cov
+; EXPECT: unsat
+(set-logic QF_NRA)
+(set-info :status unsat)
+(declare-fun x () Real)
+(assert (= (* x x) 2.0))
+(assert (> (* x x x) 3.0))
+(check-sat)
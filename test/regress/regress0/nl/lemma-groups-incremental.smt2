@@ -0,0 +1,23 @@
+; COMMAND-LINE: --incremental --nl-ext --nl-ext-tplanes
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT: unsat
+(set-logic QF_NRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(push 1)
+(assert (> x 0))
+(assert (> y 0))
+(assert (< (* x y) 0))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (< x 0))
+(assert (> y 0))
+(assert (> (* x y) 0))
+(check-sat)
+(pop 1)
+(assert (> x 0))
+(assert (< y 0))
+(assert (> (* x y) 0))
+(check-sat)
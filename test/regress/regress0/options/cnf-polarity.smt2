@@ -0,0 +1,23 @@
+; COMMAND-LINE: --incremental --cnf-polarity
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun p () Bool)
+(declare-fun q () Bool)
+(define-fun g () Bool (and (> x 0) (or p (< y 0))))
+; g only occurs positively
+(assert (or g q))
+(check-sat)
+(push 1)
+; now g also occurs negatively, its definition must be completed
+(assert (> x 0))
+(assert p)
+(assert (= y 7))
+(assert (or (not g) (= y 3)))
+(check-sat)
+(pop 1)
+(assert (not q))
+(check-sat)
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --conflict-min --conflict-min-size=2
+; EXPECT: unsat
+(set-logic QF_UFLRA)
+(declare-fun f (Real) Real)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(declare-fun w () Real)
+(assert (or (< x y) (= (f x) z)))
+(assert (or (< y z) (= (f y) w)))
+(assert (or (< z x) (= (f z) x)))
+(assert (< w (+ x y z)))
+(assert (> w (+ x y z)))
+(check-sat)
@@ -0,0 +1,15 @@
+; COMMAND-LINE: --finite-model-find
+; COMMAND-LINE: --finite-model-find --no-lazy-theories
+; EXPECT: sat
+; the cardinality constraints of finite model finding use arithmetic, which
+; is not in the logic
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(declare-fun f (U) U)
+(assert (distinct a b c))
+(assert (= (f a) b))
+(assert (not (= (f b) a)))
+(check-sat)
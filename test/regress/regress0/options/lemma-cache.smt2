@@ -0,0 +1,19 @@
+; COMMAND-LINE: --incremental --lemma-cache
+; COMMAND-LINE: --incremental --no-lemma-cache
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (and (<= 0 x) (<= x 2) (<= 0 y) (<= y 2)))
+(push 1)
+(assert (distinct (f x) (f y) (f 0) (f 1)))
+(assert (or (= x y) (= x 0) (= y 1)))
+(check-sat)
+(pop 1)
+(assert (distinct (f x) (f 0)))
+(check-sat)
+(assert (distinct (f x) (f 1) (f 2)))
+(check-sat)
@@ -0,0 +1,7 @@
+; COMMAND-LINE: --mem-limit=1
+; EXPECT: unknown
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (and (< 0 x) (< x y) (< y 3)))
+(check-sat)
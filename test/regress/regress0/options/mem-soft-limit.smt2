@@ -0,0 +1,10 @@
+; COMMAND-LINE: --mem-soft-limit=1
+; EXPECT: sat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+(declare-fun y () String)
+(assert (str.in.re x (re.+ (re.union (str.to.re "ab") (str.to.re "c")))))
+(assert (= (str.len x) 2))
+(assert (not (= x "cc")))
+(assert (= y (str.++ x "c")))
+(check-sat)
@@ -0,0 +1,17 @@
+; COMMAND-LINE: --threads=2 --cube-depth=2
+; COMMAND-LINE: --threads=3 --cube-depth=3 --produce-models
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun p () Bool)
+(assert (> (f x) (f y)))
+(assert (or (= x (+ y 1)) (< x 0) p))
+(assert (or (not p) (> y 3)))
+(check-sat)
+(push 1)
+(assert (= x y))
+(check-sat)
+(pop 1)
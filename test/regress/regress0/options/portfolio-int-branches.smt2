@@ -0,0 +1,16 @@
+; COMMAND-LINE: --threads=2 --cube-depth=2 --cube-int-branches
+; COMMAND-LINE: --threads=3 --cube-depth=3 --cube-int-branches --produce-models
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (and (>= x 0) (<= x 20) (>= y (- 5)) (< y 15)))
+(assert (= (+ (* 3 x) (* 5 y)) (+ (* 7 z) 2)))
+(assert (or (> (+ x y) 12) (< (- x z) (- 4))))
+(check-sat)
+(push 1)
+(assert (= (* 2 x) (+ (* 2 y) 1)))
+(check-sat)
+(pop 1)
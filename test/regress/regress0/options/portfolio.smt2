@@ -0,0 +1,11 @@
+; COMMAND-LINE: --threads=3
+; COMMAND-LINE: --threads=2 --produce-models
+; COMMAND-LINE: --threads=2 --no-share-lemmas
+; EXPECT: sat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (> (f x) (f y)))
+(assert (or (= x (+ y 1)) (< x 0)))
+(check-sat)
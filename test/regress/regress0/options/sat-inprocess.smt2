@@ -0,0 +1,83 @@
+; COMMAND-LINE: --incremental --sat-inprocess --sat-inprocess-interval=1
+; COMMAND-LINE: --incremental --sat-tiered-reduce --sat-inprocess --sat-inprocess-interval=1
+; COMMAND-LINE: --incremental --sat-branching=chb --sat-lemma-bump
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun p00 () Bool)
+(declare-fun p01 () Bool)
+(declare-fun p02 () Bool)
+(declare-fun p03 () Bool)
+(declare-fun p10 () Bool)
+(declare-fun p11 () Bool)
+(declare-fun p12 () Bool)
+(declare-fun p13 () Bool)
+(declare-fun p20 () Bool)
+(declare-fun p21 () Bool)
+(declare-fun p22 () Bool)
+(declare-fun p23 () Bool)
+(declare-fun p30 () Bool)
+(declare-fun p31 () Bool)
+(declare-fun p32 () Bool)
+(declare-fun p33 () Bool)
+(declare-fun p40 () Bool)
+(declare-fun p41 () Bool)
+(declare-fun p42 () Bool)
+(declare-fun p43 () Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(assert (or p00 p01 p02 p03))
+(assert (or p10 p11 p12 p13))
+(assert (or p20 p21 p22 p23))
+(assert (or p30 p31 p32 p33))
+(assert (or p40 p41 p42 p43))
+(assert (= p00 (= (f a) b)))
+(check-sat)
+(push 1)
+(assert (or (not p00) (not p10)))
+(assert (or (not p00) (not p20)))
+(assert (or (not p00) (not p30)))
+(assert (or (not p00) (not p40)))
+(assert (or (not p10) (not p20)))
+(assert (or (not p10) (not p30)))
+(assert (or (not p10) (not p40)))
+(assert (or (not p20) (not p30)))
+(assert (or (not p20) (not p40)))
+(assert (or (not p30) (not p40)))
+(assert (or (not p01) (not p11)))
+(assert (or (not p01) (not p21)))
+(assert (or (not p01) (not p31)))
+(assert (or (not p01) (not p41)))
+(assert (or (not p11) (not p21)))
+(assert (or (not p11) (not p31)))
+(assert (or (not p11) (not p41)))
+(assert (or (not p21) (not p31)))
+(assert (or (not p21) (not p41)))
+(assert (or (not p31) (not p41)))
+(assert (or (not p02) (not p12)))
+(assert (or (not p02) (not p22)))
+(assert (or (not p02) (not p32)))
+(assert (or (not p02) (not p42)))
+(assert (or (not p12) (not p22)))
+(assert (or (not p12) (not p32)))
+(assert (or (not p12) (not p42)))
+(assert (or (not p22) (not p32)))
+(assert (or (not p22) (not p42)))
+(assert (or (not p32) (not p42)))
+(assert (or (not p03) (not p13)))
+(assert (or (not p03) (not p23)))
+(assert (or (not p03) (not p33)))
+(assert (or (not p03) (not p43)))
+(assert (or (not p13) (not p23)))
+(assert (or (not p13) (not p33)))
+(assert (or (not p13) (not p43)))
+(assert (or (not p23) (not p33)))
+(assert (or (not p23) (not p43)))
+(assert (or (not p33) (not p43)))
+(check-sat)
+(pop 1)
+(assert (not (= (f a) b)))
+(check-sat)
@@ -0,0 +1,17 @@
+; COMMAND-LINE: --incremental --sat-release-lemma-vars
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (and (<= 0 x) (<= 0 y) (<= 0 z)))
+(assert (= (+ (* 3 x) (* 5 y) (* 7 z)) 101))
+(check-sat)
+(push 1)
+(assert (= (+ (* 2 x) (* 4 y) (* 6 z)) 57))
+(check-sat)
+(pop 1)
+(assert (> z x))
+(check-sat)
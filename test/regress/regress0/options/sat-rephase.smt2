@@ -0,0 +1,13 @@
+; COMMAND-LINE: --sat-target-phase --sat-rephase --sat-rephase-interval=1 --restart-int-base=1
+; EXPECT: sat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 16))
+(declare-fun y () (_ BitVec 16))
+(declare-fun z () (_ BitVec 16))
+(assert (= (bvmul x y) #x3c05))
+(assert (bvult #x0001 x))
+(assert (bvult #x0001 y))
+(assert (bvult x y))
+(assert (= z (bvxor x (bvshl y #x0003))))
+(assert (not (= ((_ extract 0 0) z) #b0)))
+(check-sat)
@@ -0,0 +1,28 @@
+; REQUIRES: cadical
+; COMMAND-LINE: --incremental --sat-solver=cadical
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (or (= (f a) b) (> x (+ y 2))))
+(assert (or (not (= a b)) (< x y)))
+(check-sat)
+(push 1)
+(assert (= a b))
+(assert (= (f a) a))
+(assert (not (= (f b) b)))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (not (= (f a) b)))
+(check-sat)
+(assert (<= x y))
+(check-sat)
+(pop 1)
@@ -0,0 +1,14 @@
+; EXPECT: sat
+(set-logic UFLIA)
+(declare-fun x () Int)
+(declare-fun f (Int) Int)
+(assert (= x 5))
+; the let is parallel, the x bound to y is the declared one
+(assert (let ((x 1) (y x)) (and (= x 1) (= y 5))))
+; nested lets shadow each other
+(assert (let ((z x)) (let ((z (+ z 1))) (and (= z 6) (let ((z (* z 2))) (= z 12))))))
+; a quantifier shadows a let binding in its body only
+(assert (let ((y 3)) (and (exists ((y Int)) (= y 4)) (= y 3))))
+; a let in the body of a quantifier
+(assert (exists ((y Int)) (let ((w (f y)) (y 2)) (and (= w (f 0)) (= y 2)))))
+(check-sat)
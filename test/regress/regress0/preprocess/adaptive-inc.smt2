@@ -0,0 +1,19 @@
+; COMMAND-LINE: --incremental --preprocess-adaptive --preprocess-profile
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (= z (ite (< x y) x y)))
+(check-sat)
+(assert (> x 3))
+(check-sat)
+(push 1)
+(assert (> z x))
+(check-sat)
+(pop 1)
+(assert (> y 5))
+(check-sat)
@@ -0,0 +1,21 @@
+; COMMAND-LINE: --incremental
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun c () Bool)
+(declare-fun d () Bool)
+(declare-fun x () Int)
+(assert (= x (ite c 1 (ite d 2 3))))
+(check-sat)
+(push 1)
+(assert (> (ite c 1 (ite d 2 3)) 3))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (>= (ite c 1 (ite d 2 3)) 3))
+(check-sat)
+(assert (or c d))
+(check-sat)
+(pop 1)
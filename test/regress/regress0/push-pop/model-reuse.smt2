@@ -0,0 +1,18 @@
+; COMMAND-LINE: --incremental --model-reuse --produce-models
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (= (f x) (+ y 1)))
+(check-sat)
+(check-sat)
+(push 1)
+(assert (= x y))
+(assert (= (f y) y))
+(check-sat)
+(pop 1)
+(check-sat)
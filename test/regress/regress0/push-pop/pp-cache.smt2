@@ -0,0 +1,44 @@
+; COMMAND-LINE: --incremental
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (> y 0))
+(check-sat)
+(push)
+(assert (= x (+ y 1)))
+(assert (< x 2))
+(check-sat)
+(pop)
+(push)
+(assert (= x (+ y 1)))
+(assert (< x 3))
+(check-sat)
+(pop)
+; the substitution of y learned here is popped, so it must not be applied to
+; the assertions below
+(push)
+(assert (= y 5))
+(check-sat)
+(pop)
+(push)
+(assert (= x (+ y 1)))
+(assert (< x 3))
+(check-sat)
+(pop)
+(push)
+(define-fun f ((a Int)) Int (+ a 1))
+(assert (< (f y) 2))
+(check-sat)
+(pop)
+(push)
+(define-fun f ((a Int)) Int (- a 1))
+(assert (< (f y) 2))
+(check-sat)
+(pop)
@@ -0,0 +1,24 @@
+; COMMAND-LINE: --incremental --sat-assumptions
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun p () Bool)
+(declare-fun q () Bool)
+(assert (or p (> x 3)))
+(assert (or q (< y 0)))
+(assert (=> (> x 3) (< x y)))
+(check-sat)
+; the atoms are known to the SAT solver, and are assumed directly
+(check-sat-assuming ((not p) (not q)))
+(check-sat-assuming ((not p) q))
+; (< x 0) is a new atom, and is asserted in a new context
+(check-sat-assuming ((not p) (< x 0)))
+(check-sat-assuming (p (not q)))
+; the assumptions above are not kept
+(check-sat)
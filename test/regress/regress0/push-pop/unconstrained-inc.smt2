@@ -0,0 +1,18 @@
+; COMMAND-LINE: --incremental --unconstrained-simp
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: sat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (= (bvadd x y) #x05))
+(check-sat)
+(push 1)
+(assert (= x #x00))
+(assert (= y #x01))
+(check-sat)
+(pop 1)
+(check-sat)
+(assert (= y #x03))
+(check-sat)
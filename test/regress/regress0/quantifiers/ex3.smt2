@@ -1,3 +1,5 @@
+; COMMAND-LINE:
+; COMMAND-LINE: --inst-match-threads=4
 (set-logic AUFLIRA)
 (set-info :smt-lib-version 2.0)
 (set-info :category "industrial")
@@ -0,0 +1,12 @@
+; COMMAND-LINE: --inst-budget=2
+; EXPECT: unsat
+(set-logic UFLIA)
+(set-info :status unsat)
+(declare-fun f (Int) Int)
+(declare-fun P (Int) Bool)
+; a matching loop, each instance introduces a new term for the trigger
+(assert (forall ((x Int)) (! (< (f x) (f (+ x 1))) :pattern ((f x)))))
+(assert (forall ((x Int)) (P x)))
+(assert (= (f 0) 0))
+(assert (not (P 5)))
+(check-sat)
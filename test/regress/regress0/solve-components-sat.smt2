@@ -0,0 +1,17 @@
+; COMMAND-LINE: --solve-components=2
+; EXPECT: sat
+; EXPECT: ((x 4) (y 1) (a 2) (b 0))
+(set-option :produce-models true)
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun a () Int)
+(declare-fun b () Int)
+(assert (= (+ x y) 5))
+(assert (> x 3))
+(assert (>= y 1))
+(assert (= (- a b) 2))
+(assert (< a 3))
+(assert (>= b 0))
+(check-sat)
+(get-value (x y a b))
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --solve-components=2
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun p () Bool)
+(declare-fun q () Bool)
+(assert (> (f x) (f y)))
+(assert (or (= x y) (> x 10)))
+(assert (< x 5))
+(assert (or p q))
+(assert (not (and p q)))
+(check-sat)
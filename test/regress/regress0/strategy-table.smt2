@@ -0,0 +1,16 @@
+; COMMAND-LINE: --incremental --strategy-table=strategy-table.txt
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun a () (_ BitVec 8))
+(declare-fun b () (_ BitVec 8))
+(declare-fun c () Bool)
+(assert (= a (ite c (ite (= b #x01) #x02 #x03) b)))
+(check-sat)
+(push 1)
+(declare-fun w () (_ BitVec 64))
+(assert (= ((_ extract 7 0) w) a))
+(assert (= w (_ bv0 64)))
+(assert (not (= a #x00)))
+(check-sat)
+(pop 1)
@@ -1,3 +1,5 @@
+; COMMAND-LINE:
+; COMMAND-LINE: --strings-guess-model
 (set-logic SLIA)
 (set-option :strings-exp true)
 (set-info :status sat)
@@ -0,0 +1,12 @@
+; COMMAND-LINE: --strings-exp
+; COMMAND-LINE: --strings-exp --no-strings-lazy-pp
+; EXPECT: unsat
+(set-logic SLIA)
+(set-info :status unsat)
+(declare-fun x () String)
+(declare-fun y () String)
+(declare-fun n () Int)
+(assert (= (str.indexof x y n) 2))
+(assert (= (str.substr x (+ n 1) 3) "abc"))
+(assert (or (= (str.indexof x y (+ 0 n)) 3) (= (str.substr x (+ 1 n) 3) "abd")))
+(check-sat)
@@ -1,3 +1,5 @@
+; COMMAND-LINE:
+; COMMAND-LINE: --fast-parser
 (set-option :incremental false)
 (set-info :source "CADE ATP System competition. See http://www.cs.miami.edu/~tptp/CASC
  for more information. 
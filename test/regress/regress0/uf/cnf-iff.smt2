@@ -1,3 +1,5 @@
+; COMMAND-LINE:
+; COMMAND-LINE: --fast-parser
 (set-logic QF_UF)
 (set-info :status unsat)
 (declare-sort U 0)
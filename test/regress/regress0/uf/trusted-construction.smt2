@@ -0,0 +1,9 @@
+; COMMAND-LINE: --trusted-construction
+; EXPECT: sat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(define-fun g ((y Int)) Int (f (+ (f y) (f (+ y 1)))))
+(assert (> (g (g (g (g (g (g x)))))) (g (g (g (g (g x)))))))
+(assert (distinct (f x) (g x) (g (g x))))
+(check-sat)
@@ -0,0 +1,21 @@
+; COMMAND-LINE: --unsat-cores-assumptions --minimize-unsat-cores
+; EXPECT: unsat
+; EXPECT: (
+; EXPECT: a1
+; EXPECT: a2
+; EXPECT: a4
+; EXPECT: )
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(declare-fun d () U)
+(declare-fun f (U) U)
+(assert (! (= a b) :named a1))
+(assert (! (= b c) :named a2))
+(assert (! (= c d) :named a3))
+(assert (! (not (= (f a) (f c))) :named a4))
+(assert (! (or (= a d) (= b d)) :named a5))
+(check-sat)
+(get-unsat-core)
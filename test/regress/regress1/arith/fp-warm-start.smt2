@@ -0,0 +1,155 @@
+; COMMAND-LINE: --fp-warm-start --fp-warm-start-rows=100
+; COMMAND-LINE: --no-fp-warm-start
+; EXPECT: sat
+(set-logic QF_LRA)
+(declare-fun x0 () Real)
+(declare-fun x1 () Real)
+(declare-fun x2 () Real)
+(declare-fun x3 () Real)
+(declare-fun x4 () Real)
+(declare-fun x5 () Real)
+(declare-fun x6 () Real)
+(declare-fun x7 () Real)
+(declare-fun x8 () Real)
+(declare-fun x9 () Real)
+(declare-fun x10 () Real)
+(declare-fun x11 () Real)
+(declare-fun x12 () Real)
+(declare-fun x13 () Real)
+(declare-fun x14 () Real)
+(declare-fun x15 () Real)
+(declare-fun x16 () Real)
+(declare-fun x17 () Real)
+(declare-fun x18 () Real)
+(declare-fun x19 () Real)
+(declare-fun x20 () Real)
+(declare-fun x21 () Real)
+(declare-fun x22 () Real)
+(declare-fun x23 () Real)
+(declare-fun x24 () Real)
+(declare-fun x25 () Real)
+(declare-fun x26 () Real)
+(declare-fun x27 () Real)
+(declare-fun x28 () Real)
+(declare-fun x29 () Real)
+(declare-fun x30 () Real)
+(declare-fun x31 () Real)
+(declare-fun x32 () Real)
+(declare-fun x33 () Real)
+(declare-fun x34 () Real)
+(declare-fun x35 () Real)
+(declare-fun x36 () Real)
+(declare-fun x37 () Real)
+(declare-fun x38 () Real)
+(declare-fun x39 () Real)
+(assert (>= (+ (* 3 x25) (* -2 x36) (* 3 x4) (* -3 x32)) 41))
+(assert (<= (+ (* 1 x11) (* 2 x4) (* 1 x37) (* 1 x14)) 44))
+(assert (>= (+ (* -3 x39) (* 1 x32) (* -1 x30) (* -2 x28)) 65))
+(assert (<= (+ (* 1 x26) (* -2 x24) (* 1 x29) (* 2 x1)) -54))
+(assert (>= (+ (* -3 x22) (* -2 x4) (* 3 x8) (* -2 x7)) -94))
+(assert (<= (+ (* -2 x8) (* -2 x14) (* 3 x9) (* 2 x23)) 85))
+(assert (>= (+ (* -1 x34) (* -1 x33) (* 1 x28) (* 1 x23)) 3))
+(assert (<= (+ (* -1 x29) (* 2 x27) (* -3 x28) (* -1 x24)) 55))
+(assert (>= (+ (* -2 x20) (* 2 x1) (* -3 x36) (* -2 x39)) -49))
+(assert (<= (+ (* 3 x39) (* -1 x16) (* 2 x32) (* -3 x7)) -16))
+(assert (>= (+ (* -2 x33) (* 2 x10) (* -1 x2) (* -3 x17)) -1))
+(assert (<= (+ (* -1 x26) (* -2 x38) (* -1 x9) (* -3 x34)) 73))
+(assert (>= (+ (* 3 x5) (* 3 x36) (* -2 x13) (* -3 x35)) 83))
+(assert (<= (+ (* 2 x39) (* -2 x1) (* -1 x20) (* -3 x10)) -29))
+(assert (>= (+ (* 1 x5) (* 2 x7) (* -1 x18) (* -1 x1)) 2))
+(assert (<= (+ (* -1 x16) (* 1 x17) (* -3 x3) (* 2 x10)) 56))
+(assert (>= (+ (* -2 x0) (* -1 x18) (* 1 x4) (* -3 x38)) 41))
+(assert (<= (+ (* -3 x31) (* -1 x28) (* 1 x23) (* -1 x32)) 15))
+(assert (>= (+ (* -2 x9) (* -3 x23) (* 3 x26) (* -3 x4)) -136))
+(assert (<= (+ (* -2 x37) (* -2 x25) (* 3 x33) (* -3 x0)) -48))
+(assert (>= (+ (* -3 x20) (* -1 x18) (* -3 x34) (* -3 x2)) 51))
+(assert (<= (+ (* -3 x38) (* -3 x2) (* -3 x7) (* -2 x31)) 77))
+(assert (>= (+ (* -1 x30) (* 3 x11) (* 3 x25) (* 3 x39)) -5))
+(assert (<= (+ (* -3 x24) (* -3 x23) (* -1 x35) (* 3 x7)) -66))
+(assert (>= (+ (* 2 x34) (* 1 x12) (* -3 x11) (* 3 x4)) 8))
+(assert (<= (+ (* -2 x4) (* -2 x39) (* 2 x14) (* -2 x24)) -53))
+(assert (>= (+ (* 1 x30) (* 1 x27) (* -2 x12) (* -1 x4)) 45))
+(assert (<= (+ (* -3 x22) (* -1 x11) (* 1 x10) (* 3 x27)) 63))
+(assert (>= (+ (* 2 x13) (* 1 x21) (* -1 x17) (* -3 x27)) -23))
+(assert (<= (+ (* -3 x22) (* 3 x30) (* -3 x3) (* -3 x32)) 32))
+(assert (>= (+ (* 3 x25) (* -3 x16) (* -1 x39) (* 1 x9)) 77))
+(assert (<= (+ (* 1 x16) (* 1 x20) (* 1 x2) (* -2 x4)) -64))
+(assert (>= (+ (* 1 x35) (* -3 x17) (* -3 x24) (* -1 x0)) -80))
+(assert (<= (+ (* -3 x4) (* 1 x3) (* -3 x0) (* 2 x6)) -109))
+(assert (>= (+ (* 1 x6) (* 1 x32) (* 2 x17) (* 1 x33)) 12))
+(assert (<= (+ (* 2 x8) (* 2 x38) (* -3 x36) (* -1 x10)) -141))
+(assert (>= (+ (* -1 x24) (* 3 x27) (* 3 x3) (* -2 x32)) 35))
+(assert (<= (+ (* -3 x30) (* -1 x21) (* 2 x16) (* 2 x1)) -121))
+(assert (>= (+ (* 2 x34) (* 2 x17) (* -3 x22) (* 2 x27)) 42))
+(assert (<= (+ (* 2 x36) (* 2 x6) (* -1 x10) (* 3 x14)) -51))
+(assert (>= (+ (* -1 x2) (* 2 x8) (* 2 x18) (* -1 x9)) 9))
+(assert (<= (+ (* 2 x27) (* 2 x31) (* 2 x7) (* 3 x29)) 90))
+(assert (>= (+ (* 2 x22) (* -3 x1) (* -2 x8) (* -1 x26)) 113))
+(assert (<= (+ (* -1 x7) (* -3 x25) (* 3 x22) (* -3 x38)) 21))
+(assert (>= (+ (* 1 x37) (* 1 x4) (* 2 x2) (* 2 x39)) -17))
+(assert (<= (+ (* -2 x36) (* 2 x9) (* -3 x1) (* 2 x35)) 2))
+(assert (>= (+ (* -2 x35) (* -1 x29) (* -3 x23) (* -2 x18)) -72))
+(assert (<= (+ (* 1 x28) (* 2 x26) (* 2 x34) (* 2 x27)) -18))
+(assert (>= (+ (* -1 x21) (* 1 x31) (* -1 x27) (* 3 x36)) 23))
+(assert (<= (+ (* -1 x17) (* -2 x14) (* -1 x24) (* -3 x1)) 66))
+(assert (>= (+ (* 2 x37) (* -3 x25) (* 3 x13) (* -3 x21)) -15))
+(assert (<= (+ (* 3 x6) (* -1 x7) (* -3 x39) (* 1 x30)) 15))
+(assert (>= (+ (* 3 x30) (* -1 x15) (* -2 x39) (* -1 x23)) 55))
+(assert (<= (+ (* 3 x8) (* 1 x10) (* -1 x34) (* -2 x14)) -4))
+(assert (>= (+ (* -1 x36) (* 1 x4) (* 1 x16) (* 3 x7)) -20))
+(assert (<= (+ (* -1 x31) (* 1 x36) (* 3 x1) (* -2 x18)) -81))
+(assert (>= (+ (* 1 x1) (* 2 x7) (* -3 x15) (* -2 x3)) -76))
+(assert (<= (+ (* 2 x6) (* 2 x26) (* 3 x3) (* 1 x20)) -76))
+(assert (>= (+ (* -2 x39) (* -1 x15) (* -1 x6) (* -2 x12)) 60))
+(assert (<= (+ (* 1 x4) (* 3 x12) (* -2 x17) (* -3 x32)) -62))
+(assert (>= (+ (* -1 x39) (* 2 x13) (* 2 x22) (* -3 x37)) 26))
+(assert (<= (+ (* -2 x8) (* 2 x28) (* 3 x29) (* 2 x25)) 88))
+(assert (>= (+ (* -3 x35) (* 1 x12) (* -3 x21) (* -2 x20)) -11))
+(assert (<= (+ (* -2 x31) (* 2 x22) (* -1 x14) (* 2 x15)) 46))
+(assert (>= (+ (* -3 x31) (* -3 x38) (* 3 x2) (* -1 x12)) 33))
+(assert (<= (+ (* 3 x11) (* -2 x34) (* -3 x2) (* -3 x7)) 70))
+(assert (>= (+ (* -2 x33) (* -3 x15) (* -1 x19) (* -3 x18)) -111))
+(assert (<= (+ (* -2 x15) (* -1 x36) (* -1 x17) (* 2 x26)) -91))
+(assert (>= (+ (* -3 x19) (* -1 x27) (* -2 x39) (* -2 x37)) -7))
+(assert (<= (+ (* 2 x22) (* 3 x31) (* 3 x39) (* -2 x15)) -69))
+(assert (>= (+ (* 1 x35) (* -3 x24) (* -3 x27) (* -3 x16)) -76))
+(assert (<= (+ (* -1 x36) (* -2 x38) (* 3 x4) (* -2 x20)) 93))
+(assert (>= (+ (* -3 x4) (* -2 x32) (* 1 x34) (* 1 x7)) -86))
+(assert (<= (+ (* 3 x28) (* -3 x18) (* -3 x21) (* -3 x23)) -178))
+(assert (>= (+ (* 3 x19) (* 2 x20) (* -1 x11) (* -3 x1)) 33))
+(assert (<= (+ (* 2 x34) (* -1 x17) (* -3 x19) (* -1 x12)) -14))
+(assert (>= (+ (* 2 x23) (* -1 x14) (* -3 x31) (* -3 x39)) 78))
+(assert (<= (+ (* -3 x25) (* -2 x28) (* -3 x4) (* 1 x24)) -60))
+(assert (>= (+ (* -2 x20) (* -2 x4) (* 3 x21) (* -1 x38)) 37))
+(assert (<= (+ (* -1 x25) (* 3 x11) (* -3 x33) (* -2 x21)) -28))
+(assert (>= (+ (* -3 x33) (* -2 x20) (* 3 x25) (* 1 x8)) 33))
+(assert (<= (+ (* -3 x23) (* -1 x32) (* -2 x24) (* 1 x20)) -70))
+(assert (>= (+ (* -3 x23) (* 3 x1) (* 2 x5) (* 3 x33)) -70))
+(assert (<= (+ (* -1 x4) (* -1 x38) (* 3 x34) (* 3 x30)) 24))
+(assert (>= (+ (* -2 x32) (* -1 x23) (* 2 x36) (* 2 x28)) -16))
+(assert (<= (+ (* 2 x27) (* -2 x8) (* 1 x37) (* 3 x34)) 61))
+(assert (>= (+ (* 1 x38) (* -1 x32) (* 2 x31) (* 1 x35)) -28))
+(assert (<= (+ (* 1 x16) (* -3 x11) (* 3 x26) (* 2 x0)) -62))
+(assert (>= (+ (* 3 x39) (* 2 x26) (* 1 x8) (* -1 x18)) -115))
+(assert (<= (+ (* 2 x28) (* -2 x11) (* 1 x2) (* 3 x4)) 11))
+(assert (>= (+ (* 3 x26) (* -2 x37) (* 3 x12) (* -2 x10)) -135))
+(assert (<= (+ (* -2 x21) (* -2 x6) (* -1 x18) (* 1 x38)) -29))
+(assert (>= (+ (* -1 x17) (* 2 x19) (* 2 x24) (* -3 x16)) 30))
+(assert (<= (+ (* -1 x10) (* 1 x4) (* 3 x24) (* -1 x17)) 23))
+(assert (>= (+ (* 1 x23) (* -1 x25) (* -2 x18) (* -2 x24)) -60))
+(assert (<= (+ (* 2 x22) (* -2 x14) (* -3 x13) (* 2 x23)) 3))
+(assert (>= (+ (* 1 x33) (* 1 x19) (* -1 x3) (* -3 x11)) -20))
+(assert (<= (+ (* -3 x29) (* -1 x34) (* -2 x36) (* 3 x27)) -23))
+(assert (>= (+ (* -3 x9) (* 2 x19) (* 1 x13) (* 3 x15)) 68))
+(assert (<= (+ (* -2 x14) (* 1 x21) (* 3 x29) (* -1 x9)) 98))
+(assert (>= (+ (* -2 x20) (* 3 x27) (* 2 x30) (* 2 x23)) 134))
+(assert (<= (+ (* 3 x7) (* 3 x32) (* -1 x23) (* -3 x38)) 44))
+(assert (>= (+ (* -2 x16) (* 1 x12) (* 1 x17) (* -3 x13)) -37))
+(assert (<= (+ (* -3 x38) (* -2 x13) (* -3 x12) (* -2 x15)) 26))
+(assert (>= (+ (* 2 x25) (* -2 x7) (* 2 x22) (* -3 x34)) 61))
+(assert (<= (+ (* -3 x34) (* -1 x14) (* -1 x26) (* 1 x2)) 45))
+(assert (>= (+ (* -3 x35) (* -3 x37) (* -2 x17) (* -3 x14)) 18))
+(assert (<= (+ (* -2 x24) (* 2 x6) (* 2 x23) (* 2 x34)) -47))
+(assert (>= (+ (* -3 x0) (* 2 x13) (* 2 x9) (* -1 x2)) 27))
+(assert (<= (+ (* 1 x20) (* 3 x34) (* -2 x38) (* -1 x12)) 13))
+(check-sat)
@@ -1,4 +1,5 @@
 ; COMMAND-LINE: --quant-ind --conjecture-gen
+; COMMAND-LINE: --quant-ind --conjecture-gen --conjecture-gen-max-terms=100000 --conjecture-gen-tlimit=60000
 ; EXPECT: unsat
 (set-logic UFDTLIA)
 (set-info :status unsat)
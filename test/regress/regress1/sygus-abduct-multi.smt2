@@ -0,0 +1,21 @@
+; COMMAND-LINE: --produce-abducts --check-abducts
+; SCRUBBER: sed -e 's/(define-fun A () Bool .*)/(define-fun A () Bool)/'
+; EXPECT: (define-fun A () Bool)
+; EXPECT: (define-fun A () Bool)
+; EXPECT: (define-fun A () Bool)
+
+(set-logic QF_LIA)
+
+(declare-fun n () Int)
+(declare-fun m () Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+
+(assert (>= n 1))
+(assert (and (<= n x) (<= x (+ n 5))))
+
+; The encoding of the assertions is shared by the queries below, the last one
+; has a symbol that does not occur in the assertions.
+(get-abduct A (>= x 1))
+(get-abduct A (> x n))
+(get-abduct A (< x y))
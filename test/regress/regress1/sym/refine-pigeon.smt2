@@ -0,0 +1,14 @@
+; COMMAND-LINE: --symmetry-breaker-exp --symmetry-breaker-refine
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x1 () Int)
+(declare-fun x2 () Int)
+(declare-fun x3 () Int)
+(declare-fun x4 () Int)
+(assert (and (<= 1 x1) (<= x1 3)))
+(assert (and (<= 1 x2) (<= x2 3)))
+(assert (and (<= 1 x3) (<= x3 3)))
+(assert (and (<= 1 x4) (<= x4 3)))
+(assert (distinct (f x1) (f x2) (f x3) (f x4)))
+(check-sat)
@@ -3,7 +3,7 @@
 Usage:
 
     run_regression.py [--enable-proof] [--with-lfsc] [--dump]
-        [--use-skip-return-code] [wrapper] cvc4-binary
+        [--use-skip-return-code] [--fast-parser] [wrapper] cvc4-binary
         [benchmark.cvc | benchmark.smt | benchmark.smt2 | benchmark.p]
 
 Runs benchmark and checks for correct exit status and output.
@@ -30,6 +30,8 @@ EXIT_OK = 0
 EXIT_FAILURE = 1
 EXIT_SKIP = 77
 
+FAST_PARSER_UNSUPPORTED = 'not supported by the fast SMT-LIBv2 parser'
+
 
 def run_process(args, cwd, timeout, s_input=None):
     """Runs a process with a timeout `timeout` in seconds. `args` are the
@@ -151,14 +153,16 @@ def run_benchmark(dump, wrapper, scrubber, error_scrubber, cvc4_binary,
     return (output.strip(), error.strip(), exit_status)
 
 
-def run_regression(unsat_cores, proofs, dump, use_skip_return_code, wrapper,
-                   cvc4_binary, benchmark_path, timeout):
+def run_regression(unsat_cores, proofs, dump, use_skip_return_code,
+                   fast_parser, wrapper, cvc4_binary, benchmark_path, timeout):
     """Determines the expected output for a benchmark, runs CVC4 on it and then
     checks whether the output corresponds to the expected output. Optionally
     uses a wrapper `wrapper`, tests unsat cores (if unsat_cores is true),
     checks proofs (if proofs is true), or dumps a benchmark and uses that as
     the input (if dump is true). `use_skip_return_code` enables/disables
-    returning 77 when a test is skipped."""
+    returning 77 when a test is skipped. If `fast_parser` is true, SMT-LIB 2
+    benchmarks are parsed with the hand-written parser and other benchmarks
+    are skipped."""
 
     if not os.access(cvc4_binary, os.X_OK):
         sys.exit(
@@ -255,12 +259,23 @@ def run_regression(unsat_cores, proofs, dump, use_skip_return_code, wrapper,
         if logic_match and len(logic_match) == 1:
             logic = logic_match[0]
 
+    if fast_parser:
+        # Error messages differ between the parsers, so only benchmarks that
+        # are expected to succeed are checked.
+        if benchmark_ext != '.smt2' or expected_error != '' \
+            or expected_exit_status != 0:
+            print('1..0 # Skipped regression: not checked with --fast-parser')
+            return (EXIT_SKIP if use_skip_return_code else EXIT_OK)
+        basic_command_line_args.append('--fast-parser')
+
     if 'CVC4_REGRESSION_ARGS' in os.environ:
         basic_command_line_args += shlex.split(
             os.environ['CVC4_REGRESSION_ARGS'])
 
-    if not unsat_cores and ('(get-unsat-core)' in benchmark_content
-                            or '(get-unsat-assumptions)' in benchmark_content):
+    # Assumption-based unsat cores do not require proof support
+    if not unsat_cores and '--unsat-cores-assumptions' not in benchmark_content \
+        and ('(get-unsat-core)' in benchmark_content
+             or '(get-unsat-assumptions)' in benchmark_content):
         print(
             '1..0 # Skipped regression: unsat cores not supported without proof support'
         )
@@ -344,6 +359,12 @@ def run_regression(unsat_cores, proofs, dump, use_skip_return_code, wrapper,
             command_line_args, benchmark_dir, benchmark_basename, timeout)
         output = re.sub(r'^[ \t]*', '', output, flags=re.MULTILINE)
         error = re.sub(r'^[ \t]*', '', error, flags=re.MULTILINE)
+        if fast_parser and FAST_PARSER_UNSUPPORTED in error:
+            print('# Skipped command line options ({}): {}'.format(
+                command_line_args, FAST_PARSER_UNSUPPORTED))
+            if len(command_line_args_configs) == 1:
+                return (EXIT_SKIP if use_skip_return_code else EXIT_OK)
+            continue
         if output != expected_output:
             exit_code = EXIT_FAILURE
             print(
@@ -391,6 +412,7 @@ def main():
     parser.add_argument('--with-lfsc', action='store_true')
     parser.add_argument('--dump', action='store_true')
     parser.add_argument('--use-skip-return-code', action='store_true')
+    parser.add_argument('--fast-parser', action='store_true')
     parser.add_argument('wrapper', nargs='*')
     parser.add_argument('cvc4_binary')
     parser.add_argument('benchmark')
@@ -404,8 +426,8 @@ def main():
     timeout = float(os.getenv('TEST_TIMEOUT', 600.0))
 
     return run_regression(args.enable_proof, args.with_lfsc, args.dump,
-                          args.use_skip_return_code, wrapper, cvc4_binary,
-                          args.benchmark, timeout)
+                          args.use_skip_return_code, args.fast_parser,
+                          wrapper, cvc4_binary, args.benchmark, timeout)
 
 
 if __name__ == "__main__":
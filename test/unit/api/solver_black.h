@@ -16,6 +16,9 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include <atomic>
+#include <sstream>
+
 #include "api/cvc4cpp.h"
 #include "base/configuration.h"
 
@@ -99,11 +102,28 @@ class SolverBlack : public CxxTest::TestSuite
   void testCheckValid2();
   void testCheckValidAssuming1();
   void testCheckValidAssuming2();
+  void testGetValue();
+  void testGetNextMus();
+  void testCheckOpt();
 
   void testSetInfo();
   void testSetLogic();
   void testSetOption();
 
+  void testRecycle();
+
+  void testMkSharedSolver();
+
+  void testFork();
+
+  void testWriteReadBinary();
+  void testTraceReplay();
+
+  void testCheckSatAsync();
+  void testCheckSatAsyncCancel();
+
+  void testTermBuilder();
+
  private:
   std::unique_ptr<Solver> d_solver;
 };
@@ -1194,6 +1214,100 @@ void SolverBlack::testCheckValidAssuming2()
       CVC4ApiException&);
 }
 
+void SolverBlack::testGetValue()
+{
+  d_solver->setOption("produce-models", "true");
+  Sort intSort = d_solver->getIntegerSort();
+  Sort funSort = d_solver->mkFunctionSort(intSort, intSort);
+  Term x = d_solver->mkConst(intSort, "x");
+  Term y = d_solver->mkConst(intSort, "y");
+  Term f = d_solver->mkConst(funSort, "f");
+  Term fx = d_solver->mkTerm(APPLY_UF, f, x);
+  Term sum = d_solver->mkTerm(PLUS, fx, y);
+  d_solver->assertFormula(d_solver->mkTerm(EQUAL, x, d_solver->mkReal(2)));
+  d_solver->assertFormula(d_solver->mkTerm(EQUAL, sum, d_solver->mkReal(5)));
+  TS_ASSERT(d_solver->checkSat().isSat());
+  std::vector<Term> values;
+  TS_ASSERT_THROWS_NOTHING(values = d_solver->getValue({x, fx, y, sum}));
+  TS_ASSERT_EQUALS(values.size(), 4u);
+  TS_ASSERT_EQUALS(values[0], d_solver->mkReal(2));
+  TS_ASSERT_EQUALS(values[3], d_solver->mkReal(5));
+  TS_ASSERT_EQUALS(values[1], d_solver->getValue(fx));
+  TS_ASSERT_EQUALS(values[2], d_solver->getValue(y));
+}
+
+void SolverBlack::testGetNextMus()
+{
+  d_solver->setOption("unsat-cores-assumptions", "true");
+  d_solver->setOption("mus-threads", "2");
+  Sort boolSort = d_solver->getBooleanSort();
+  Term x = d_solver->mkConst(boolSort, "x");
+  Term y = d_solver->mkConst(boolSort, "y");
+  Term z = d_solver->mkConst(boolSort, "z");
+  d_solver->assertFormula(x);
+  d_solver->assertFormula(d_solver->mkTerm(NOT, x));
+  d_solver->assertFormula(y);
+  d_solver->assertFormula(d_solver->mkTerm(NOT, y));
+  d_solver->assertFormula(z);
+  TS_ASSERT(d_solver->checkSat().isUnsat());
+  std::vector<Term> mus;
+  std::vector<std::vector<Term>> muses;
+  while (d_solver->getNextMus(mus))
+  {
+    TS_ASSERT_EQUALS(mus.size(), 2u);
+    muses.push_back(mus);
+  }
+  TS_ASSERT_EQUALS(muses.size(), 2u);
+  TS_ASSERT(muses[0] != muses[1]);
+}
+
+void SolverBlack::testCheckOpt()
+{
+  d_solver->setOption("incremental", "true");
+  d_solver->setOption("produce-models", "true");
+  d_solver->setOption("produce-unsat-assumptions", "true");
+  d_solver->setOption("unsat-cores-assumptions", "true");
+  Sort intSort = d_solver->getIntegerSort();
+  Sort bvSort = d_solver->mkBitVectorSort(8);
+  Term x = d_solver->mkConst(intSort, "x");
+  Term y = d_solver->mkConst(intSort, "y");
+  Term b = d_solver->mkConst(bvSort, "b");
+  // 3 <= x + y <= 10, x <= 7, b <u 200
+  Term sum = d_solver->mkTerm(PLUS, x, y);
+  d_solver->assertFormula(d_solver->mkTerm(LEQ, d_solver->mkReal(3), sum));
+  d_solver->assertFormula(d_solver->mkTerm(LEQ, sum, d_solver->mkReal(10)));
+  d_solver->assertFormula(d_solver->mkTerm(LEQ, x, d_solver->mkReal(7)));
+  d_solver->assertFormula(
+      d_solver->mkTerm(BITVECTOR_ULT, b, d_solver->mkBitVector(8, 200)));
+  // violating y >= 5 costs 2, violating y <= 0 costs 1
+  TS_ASSERT_THROWS(d_solver->assertSoft(d_solver->mkTrue(), 0),
+                   CVC4ApiException&);
+  uint32_t soft = d_solver->assertSoft(
+      d_solver->mkTerm(GEQ, y, d_solver->mkReal(5)), 2);
+  TS_ASSERT_EQUALS(
+      d_solver->assertSoft(d_solver->mkTerm(LEQ, y, d_solver->mkReal(0))),
+      soft);
+  uint32_t ox = d_solver->maximize(x);
+  uint32_t ob = d_solver->maximize(b);
+  TS_ASSERT_THROWS(d_solver->minimize(d_solver->mkTrue()), CVC4ApiException&);
+
+  TS_ASSERT(d_solver->checkOpt().isSat());
+  TS_ASSERT_EQUALS(d_solver->getObjectiveValue(soft), d_solver->mkReal(1));
+  TS_ASSERT_EQUALS(d_solver->getObjectiveValue(ox), d_solver->mkReal(5));
+  TS_ASSERT_EQUALS(d_solver->getObjectiveValue(ob),
+                   d_solver->mkBitVector(8, 199));
+  TS_ASSERT_EQUALS(d_solver->getValue(x), d_solver->mkReal(5));
+  TS_ASSERT_EQUALS(d_solver->getValue(b), d_solver->mkBitVector(8, 199));
+
+  // the objectives of a popped level are removed
+  d_solver->push();
+  uint32_t oy = d_solver->minimize(y);
+  TS_ASSERT(d_solver->checkOpt().isSat());
+  TS_ASSERT_EQUALS(d_solver->getObjectiveValue(oy), d_solver->mkReal(5));
+  d_solver->pop();
+  TS_ASSERT_THROWS(d_solver->getObjectiveValue(oy), CVC4ApiException&);
+}
+
 void SolverBlack::testSetLogic()
 {
   TS_ASSERT_THROWS_NOTHING(d_solver->setLogic("AUFLIRA"));
@@ -1211,3 +1325,260 @@ void SolverBlack::testSetOption()
   TS_ASSERT_THROWS(d_solver->setOption("bv-sat-solver", "minisat"),
                    CVC4ApiException&);
 }
+
+void SolverBlack::testRecycle()
+{
+  d_solver->setLogic("QF_LIA");
+  Sort intSort = d_solver->getIntegerSort();
+  Term x = d_solver->mkConst(intSort, "x");
+  Term zero = d_solver->mkReal(0);
+  d_solver->assertFormula(d_solver->mkTerm(GT, x, zero));
+  d_solver->assertFormula(d_solver->mkTerm(LT, x, zero));
+  TS_ASSERT(d_solver->checkSat().isUnsat());
+
+  // the assertions are gone, and the terms remain valid
+  TS_ASSERT_THROWS_NOTHING(d_solver->recycle());
+  d_solver->assertFormula(d_solver->mkTerm(GT, x, zero));
+  TS_ASSERT(d_solver->checkSat().isSat());
+
+  for (unsigned i = 0; i < 10; ++i)
+  {
+    TS_ASSERT_THROWS_NOTHING(d_solver->recycle());
+    d_solver->assertFormula(d_solver->mkTerm(LT, x, zero));
+    TS_ASSERT(d_solver->checkSat().isSat());
+  }
+}
+
+void SolverBlack::testMkSharedSolver()
+{
+  // declared first so that the terms below are destroyed before it
+  std::unique_ptr<Solver> shared;
+  TS_ASSERT_THROWS_NOTHING(shared = d_solver->mkSharedSolver());
+
+  Sort intSort = d_solver->getIntegerSort();
+  Term x = d_solver->mkConst(intSort, "x");
+  Term zero = d_solver->mkReal(0);
+  d_solver->assertFormula(d_solver->mkTerm(GT, x, zero));
+
+  // terms of the parent are used in the shared solver without export
+  TS_ASSERT_THROWS_NOTHING(shared->assertFormula(shared->mkTerm(LT, x, zero)));
+  TS_ASSERT(shared->checkSat().isSat());
+  // assertions are not shared
+  TS_ASSERT_THROWS_NOTHING(shared->assertFormula(shared->mkTerm(GT, x, zero)));
+  TS_ASSERT(shared->checkSat().isUnsat());
+  TS_ASSERT(d_solver->checkSat().isSat());
+  // the term store outlives the parent
+  d_solver.reset();
+  TS_ASSERT_THROWS_NOTHING(shared->mkTerm(PLUS, x, zero));
+}
+
+void SolverBlack::testFork()
+{
+  // declared first so that the terms below are destroyed before them
+  std::unique_ptr<Solver> fork1, fork2;
+  d_solver->setOption("produce-assertions", "true");
+  d_solver->setOption("produce-models", "true");
+
+  Sort intSort = d_solver->getIntegerSort();
+  Term x = d_solver->mkConst(intSort, "x");
+  Term a = d_solver->mkVar(intSort, "a");
+  Term twice =
+      d_solver->defineFun("twice", {a}, intSort, d_solver->mkTerm(PLUS, a, a));
+  d_solver->assertFormula(d_solver->mkTerm(GT, x, d_solver->mkReal(0)));
+  d_solver->assertFormula(d_solver->mkTerm(
+      LT, d_solver->mkTerm(APPLY_UF, twice, x), d_solver->mkReal(10)));
+
+  TS_ASSERT_THROWS_NOTHING(fork1 = d_solver->fork());
+  TS_ASSERT_THROWS_NOTHING(fork2 = d_solver->fork());
+
+  fork1->assertFormula(d_solver->mkTerm(EQUAL, x, d_solver->mkReal(2)));
+  TS_ASSERT(fork1->checkSat().isSat());
+  TS_ASSERT_EQUALS(fork1->getValue(x), d_solver->mkReal(2));
+  // the assertions of the parent are at the base level of the fork
+  fork1->push();
+  fork1->assertFormula(d_solver->mkTerm(LT, x, d_solver->mkReal(0)));
+  TS_ASSERT(fork1->checkSat().isUnsat());
+  fork1->pop();
+  TS_ASSERT(fork1->checkSat().isSat());
+
+  // using the defined function of the parent
+  fork2->assertFormula(d_solver->mkTerm(EQUAL, x, d_solver->mkReal(7)));
+  TS_ASSERT(fork2->checkSat().isUnsat());
+
+  // the parent is not affected by its forks
+  TS_ASSERT(d_solver->checkSat().isSat());
+}
+
+void SolverBlack::testWriteReadBinary()
+{
+  std::stringstream ss;
+  d_solver->setOption("produce-assertions", "true");
+  d_solver->setLogic("QF_UFBV");
+  Sort bvSort = d_solver->mkBitVectorSort(8);
+  Sort uSort = d_solver->mkUninterpretedSort("u");
+  Sort funSort = d_solver->mkFunctionSort(uSort, bvSort);
+  Term f = d_solver->mkConst(funSort, "f");
+  Term x = d_solver->mkConst(uSort, "x");
+  Term y = d_solver->mkConst(uSort, "y");
+  Term fx = d_solver->mkTerm(APPLY_UF, f, x);
+  Term fy = d_solver->mkTerm(APPLY_UF, f, y);
+  Term ext = d_solver->mkTerm(d_solver->mkOp(BITVECTOR_EXTRACT, 3, 0), fx);
+  d_solver->assertFormula(d_solver->mkTerm(EQUAL, x, y));
+  d_solver->assertFormula(d_solver->mkTerm(
+      DISTINCT, d_solver->mkTerm(BITVECTOR_PLUS, fx, fx), fy));
+  d_solver->assertFormula(
+      d_solver->mkTerm(EQUAL, ext, d_solver->mkBitVector(4, 5)));
+  TS_ASSERT_THROWS_NOTHING(d_solver->writeBinary(ss));
+
+  Solver reader;
+  TS_ASSERT_THROWS_NOTHING(reader.readBinary(ss));
+  TS_ASSERT(reader.checkSat().isSat());
+
+  // malformed inputs are rejected
+  std::stringstream bad("CVC4SMT");
+  Solver badReader;
+  TS_ASSERT_THROWS(badReader.readBinary(bad), CVC4ApiException&);
+}
+
+void SolverBlack::testTraceReplay()
+{
+  std::stringstream trace;
+  d_solver->startTrace(trace);
+  d_solver->setOption("incremental", "true");
+  d_solver->setOption("produce-models", "true");
+  d_solver->setLogic("QF_LIA");
+  Term x = d_solver->mkConst(d_solver->getIntegerSort(), "x");
+  Term zero = d_solver->mkReal(0);
+  d_solver->assertFormula(d_solver->mkTerm(GT, x, zero));
+  d_solver->push();
+  d_solver->assertFormula(d_solver->mkTerm(LT, x, zero));
+  TS_ASSERT(d_solver->checkSat().isUnsat());
+  d_solver->pop();
+  TS_ASSERT(d_solver
+                ->checkSatAssuming(
+                    d_solver->mkTerm(EQUAL, x, d_solver->mkReal(1)))
+                .isSat());
+  TS_ASSERT_EQUALS(d_solver->getValue(x), d_solver->mkReal(1));
+  d_solver->stopTrace();
+  // not recorded
+  d_solver->resetAssertions();
+
+  Solver replayer;
+  std::stringstream timings;
+  TS_ASSERT_THROWS_NOTHING(replayer.replayTrace(trace, timings));
+  // one line per command, including the declaration of x
+  std::vector<std::string> names;
+  std::string line;
+  while (std::getline(timings, line))
+  {
+    std::stringstream ls(line);
+    size_t index;
+    std::string name;
+    double seconds;
+    TS_ASSERT(ls >> index >> name >> seconds);
+    TS_ASSERT_EQUALS(index, names.size());
+    TS_ASSERT(seconds >= 0);
+    names.push_back(name);
+  }
+  std::vector<std::string> expected = {"set-option",
+                                       "set-option",
+                                       "set-logic",
+                                       "declare-fun",
+                                       "assert",
+                                       "push",
+                                       "assert",
+                                       "check-sat",
+                                       "pop",
+                                       "check-sat-assuming",
+                                       "get-value"};
+  TS_ASSERT_EQUALS(names, expected);
+  // the replayed solver is in the state of the recorded one
+  TS_ASSERT(replayer.checkSat().isSat());
+}
+
+void SolverBlack::testCheckSatAsync()
+{
+  Sort intSort = d_solver->getIntegerSort();
+  Term x = d_solver->mkConst(intSort, "x");
+  d_solver->assertFormula(
+      d_solver->mkTerm(GT, x, d_solver->mkReal(5)));
+  CheckSatHandle handle = d_solver->checkSatAsync();
+  TS_ASSERT(handle.get().isSat());
+  TS_ASSERT(handle.isReady());
+  TS_ASSERT(handle.get().isSat());
+  // the solver can be used again once the check has finished
+  TS_ASSERT(d_solver->checkSat().isSat());
+}
+
+void SolverBlack::testCheckSatAsyncCancel()
+{
+  // factoring the product of two large 32-bit primes is hard
+  Sort bvSort = d_solver->mkBitVectorSort(64);
+  Term x = d_solver->mkConst(bvSort, "x");
+  Term y = d_solver->mkConst(bvSort, "y");
+  Term one = d_solver->mkBitVector(64, 1);
+  Term bound = d_solver->mkBitVector(64, 4294967296);
+  d_solver->assertFormula(
+      d_solver->mkTerm(EQUAL,
+                       d_solver->mkTerm(BITVECTOR_MULT, x, y),
+                       d_solver->mkBitVector(64, "18446743979220271189", 10)));
+  d_solver->assertFormula(d_solver->mkTerm(BITVECTOR_UGT, x, one));
+  d_solver->assertFormula(d_solver->mkTerm(BITVECTOR_UGT, y, one));
+  d_solver->assertFormula(d_solver->mkTerm(BITVECTOR_ULT, x, bound));
+  d_solver->assertFormula(d_solver->mkTerm(BITVECTOR_ULT, y, bound));
+
+  std::atomic<unsigned> calls(0);
+  CheckSatHandle handle = d_solver->checkSatAsync(
+      [&calls](const CheckSatProgress&) { ++calls; }, 1);
+  while (calls == 0)
+  {
+    TS_ASSERT(!handle.waitFor(10));
+  }
+  handle.cancel();
+  Result r = handle.get();
+  TS_ASSERT(r.isSatUnknown());
+}
+
+void SolverBlack::testTermBuilder()
+{
+  Sort intSort = d_solver->getIntegerSort();
+  Sort bvSort = d_solver->mkBitVectorSort(8);
+  Term x = d_solver->mkConst(intSort, "x");
+  Term y = d_solver->mkConst(intSort, "y");
+  Term b = d_solver->mkConst(bvSort, "b");
+  Term f = d_solver->mkConst(d_solver->mkFunctionSort(intSort, intSort), "f");
+
+  TermBuilder builder(*d_solver);
+  builder.reserve(8);
+  TermBuilder::Handle hx = builder.addTerm(x);
+  TermBuilder::Handle hy = builder.addTerm(y);
+  TermBuilder::Handle hf = builder.addTerm(f);
+  TermBuilder::Handle hb = builder.addTerm(b);
+  TermBuilder::Handle hsum = builder.mkTerm(PLUS, {hx, hy});
+  TermBuilder::Handle happ = builder.mkTerm(APPLY_UF, {hf, hsum});
+  TermBuilder::Handle heq = builder.mkTerm(EQUAL, {happ, hsum});
+  TermBuilder::Handle hext =
+      builder.mkTerm(d_solver->mkOp(BITVECTOR_EXTRACT, 3, 0), {hb});
+  TS_ASSERT_EQUALS(builder.size(), 8);
+
+  Term sum = d_solver->mkTerm(PLUS, x, y);
+  TS_ASSERT_EQUALS(builder.getTerm(hx), x);
+  TS_ASSERT_EQUALS(builder.getTerm(hsum), sum);
+  TS_ASSERT_EQUALS(
+      builder.getTerm(heq),
+      d_solver->mkTerm(EQUAL, d_solver->mkTerm(APPLY_UF, f, sum), sum));
+  TS_ASSERT_EQUALS(
+      builder.getTerm(hext),
+      d_solver->mkTerm(d_solver->mkOp(BITVECTOR_EXTRACT, 3, 0), b));
+
+  TS_ASSERT_THROWS(builder.addTerm(Term()), CVC4ApiException&);
+  TS_ASSERT_THROWS(builder.mkTerm(PLUS, {hx, 17}), CVC4ApiException&);
+  TS_ASSERT_THROWS(builder.mkTerm(NOT, {hx, hy}), CVC4ApiException&);
+  TS_ASSERT_THROWS(builder.getTerm(17), CVC4ApiException&);
+  // types are checked when getting a term at the latest
+  TS_ASSERT_THROWS(builder.getTerm(builder.mkTerm(PLUS, {hx, hb})),
+                   CVC4ApiException&);
+
+  Solver slv;
+  TS_ASSERT_THROWS(TermBuilder(slv).addTerm(x), CVC4ApiException&);
+}
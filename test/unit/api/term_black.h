@@ -39,6 +39,7 @@ class TermBlack : public CxxTest::TestSuite
   void testIteTerm();
 
   void testTermAssignment();
+  void testTermCopies();
 
  private:
   Solver d_solver;
@@ -578,3 +579,27 @@ void TermBlack::testTermAssignment()
   t2 = d_solver.mkReal(2);
   TS_ASSERT_EQUALS(t1, d_solver.mkReal(1));
 }
+
+void TermBlack::testTermCopies()
+{
+  Sort intSort = d_solver.getIntegerSort();
+  Term x = d_solver.mkConst(intSort, "x");
+  Term sum = d_solver.mkTerm(PLUS, x, d_solver.mkReal(1));
+  std::vector<Term> copies(100, sum);
+  copies.resize(200, x);
+  Term self = sum;
+  const Term& ref = self;
+  self = ref;
+  TS_ASSERT_EQUALS(self, sum);
+  Term::const_iterator it = sum.begin();
+  {
+    // the iterator keeps the term alive
+    Term tmp = d_solver.mkTerm(PLUS, x, d_solver.mkReal(2));
+    it = tmp.begin();
+  }
+  TS_ASSERT_EQUALS(*it, x);
+  Term::const_iterator it2 = it;
+  TS_ASSERT(it == it2);
+  copies.clear();
+  TS_ASSERT_EQUALS(sum, d_solver.mkTerm(PLUS, x, d_solver.mkReal(1)));
+}
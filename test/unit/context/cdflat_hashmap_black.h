@@ -0,0 +1,200 @@
+/*********************                                                        */
+/*! \file cdflat_hashmap_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of CVC4::context::CDFlatHashMap<>.
+ **
+ ** Black box testing of CVC4::context::CDFlatHashMap<>, and a comparison of
+ ** its results with CDHashMap<>. Their throughput is compared by the
+ ** microbenchmarks in test/perf/micro.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <map>
+
+#include "context/cdflat_hashmap.h"
+#include "context/cdhashmap.h"
+#include "context/context.h"
+
+using namespace std;
+using namespace CVC4;
+using namespace CVC4::context;
+
+class CDFlatHashMapBlack : public CxxTest::TestSuite
+{
+ private:
+  Context* d_context;
+
+  /** The contents of map, ordered */
+  template <class M>
+  std::map<int, int> getElements(const M& map)
+  {
+    std::map<int, int> elements;
+    for (typename M::const_iterator it = map.begin(); it != map.end(); ++it)
+    {
+      elements[(*it).first] = (*it).second;
+    }
+    return elements;
+  }
+
+  /**
+   * A sequence of inserts, overwrites, lookups, pushes and pops on map.
+   * Returns the sum of the values found by the lookups, and of the sizes of
+   * map after the pops.
+   */
+  template <class M>
+  size_t workload(M& map, int numKeys, int numRounds)
+  {
+    size_t sum = 0;
+    for (int k = 0; k < numKeys; k++)
+    {
+      map.insert(k, k);
+    }
+    for (int r = 0; r < numRounds; r++)
+    {
+      d_context->push();
+      for (int k = 0; k < numKeys; k += 7)
+      {
+        map.insert(k, k + r);
+        map.insert(numKeys + r * numKeys + k, r);
+      }
+      for (int k = 0; k < 2 * numKeys; k++)
+      {
+        typename M::const_iterator it = map.find(k);
+        if (it != map.end())
+        {
+          sum += (*it).second;
+        }
+      }
+      d_context->pop();
+      sum += map.size();
+    }
+    return sum;
+  }
+
+ public:
+  void setUp() override { d_context = new Context; }
+
+  void tearDown() override { delete d_context; }
+
+  void testSimpleSequence()
+  {
+    CDFlatHashMap<int, int> map(d_context);
+    TS_ASSERT(map.empty());
+    map.insert(3, 4);
+    TS_ASSERT_EQUALS(map.size(), 1u);
+    TS_ASSERT_EQUALS(map.count(3), 1u);
+    TS_ASSERT_EQUALS(map.count(4), 0u);
+
+    d_context->push();
+    {
+      map.insert(5, 6);
+      map.insert(3, 7);
+      map[9] = 10;
+      TS_ASSERT_EQUALS(map.size(), 3u);
+      TS_ASSERT_EQUALS(map[3].get(), 7);
+      TS_ASSERT_EQUALS((*map.find(9)).second, 10);
+
+      d_context->push();
+      {
+        map[5] = 12;
+        map.insert(1, 2);
+        TS_ASSERT_EQUALS(map.size(), 4u);
+        TS_ASSERT_EQUALS(map.find(5)->second, 12);
+      }
+      d_context->pop();
+
+      TS_ASSERT_EQUALS(map.size(), 3u);
+      TS_ASSERT_EQUALS(map.find(5)->second, 6);
+      TS_ASSERT(map.find(1) == map.end());
+    }
+    d_context->pop();
+
+    std::map<int, int> expected = {{3, 4}};
+    TS_ASSERT(getElements(map) == expected);
+  }
+
+  void testInsertionOrder()
+  {
+    CDFlatHashMap<int, int> map(d_context);
+    for (int i = 0; i < 100; i++)
+    {
+      map.insert(100 - i, i);
+    }
+    int i = 0;
+    for (CDFlatHashMap<int, int>::iterator it = map.begin(); it != map.end();
+         ++it, ++i)
+    {
+      TS_ASSERT_EQUALS((*it).first, 100 - i);
+    }
+    TS_ASSERT_EQUALS(i, 100);
+  }
+
+  void testGrowAcrossScopes()
+  {
+    CDFlatHashMap<int, int> map(d_context);
+    for (int level = 0; level < 10; level++)
+    {
+      d_context->push();
+      for (int i = 0; i < 100; i++)
+      {
+        map.insert(level * 100 + i, level);
+        // overwrite the keys of the levels below
+        map.insert(i, level);
+      }
+    }
+    TS_ASSERT_EQUALS(map.size(), 1000u);
+    for (int level = 9; level >= 0; level--)
+    {
+      TS_ASSERT_EQUALS(map.find(0)->second, level);
+      d_context->pop();
+      TS_ASSERT_EQUALS(map.size(), 100u * level);
+      TS_ASSERT(map.find(level * 100) == map.end() || level == 0);
+      for (int k = 0; k < level * 100; k++)
+      {
+        TS_ASSERT_EQUALS(map.find(k)->second, k < 100 ? level - 1 : k / 100);
+      }
+    }
+    TS_ASSERT(map.empty());
+  }
+
+  void testClear()
+  {
+    CDFlatHashMap<int, int> map(d_context);
+    map.insert(1, 1);
+    d_context->push();
+    map.insert(1, 2);
+    map.insert(2, 2);
+    map.clear();
+    TS_ASSERT(map.empty());
+    map.insert(3, 3);
+    d_context->pop();
+    TS_ASSERT(map.empty());
+    map.insert(4, 4);
+    TS_ASSERT_EQUALS(map.find(4)->second, 4);
+  }
+
+  void testSameResultsAsCDHashMap()
+  {
+    // the same workload on both maps, which must give the same results
+    const int numKeys = 2000;
+    const int numRounds = 50;
+    size_t sum;
+    {
+      CDHashMap<int, int> map(d_context);
+      sum = workload(map, numKeys, numRounds);
+      TS_ASSERT_EQUALS(map.size(), static_cast<size_t>(numKeys));
+    }
+    {
+      CDFlatHashMap<int, int> map(d_context);
+      TS_ASSERT_EQUALS(workload(map, numKeys, numRounds), sum);
+      TS_ASSERT_EQUALS(map.size(), static_cast<size_t>(numKeys));
+    }
+  }
+};
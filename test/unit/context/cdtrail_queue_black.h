@@ -0,0 +1,76 @@
+/*********************                                                        */
+/*! \file cdtrail_queue_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of CVC4::context::CDTrailQueue<>.
+ **
+ ** Black box testing of CVC4::context::CDTrailQueue<>.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include "context/cdtrail_queue.h"
+#include "context/context.h"
+
+using namespace std;
+using namespace CVC4;
+using namespace CVC4::context;
+
+class CDTrailQueueBlack : public CxxTest::TestSuite
+{
+ private:
+  Context* d_context;
+
+ public:
+  void setUp() override { d_context = new Context; }
+
+  void tearDown() override { delete d_context; }
+
+  void testEnqueueDequeue()
+  {
+    CDTrailQueue<int> q(d_context);
+    TS_ASSERT(q.empty());
+    TS_ASSERT_EQUALS(q.enqueue(1), 0u);
+    TS_ASSERT_EQUALS(q.enqueue(2), 1u);
+    TS_ASSERT_EQUALS(q.front(), 1);
+    q.dequeue();
+    TS_ASSERT_EQUALS(q.front(), 2);
+    TS_ASSERT_EQUALS(q.frontIndex(), 1u);
+    q.dequeue();
+    TS_ASSERT(q.empty());
+    // dequeued elements stay on the trail
+    TS_ASSERT_EQUALS(q.size(), 2u);
+    TS_ASSERT_EQUALS(q[0], 1);
+    TS_ASSERT_EQUALS(*q.begin(), 1);
+  }
+
+  void testBacktrack()
+  {
+    CDTrailQueue<int> q(d_context);
+    q.enqueue(1);
+    q.enqueue(2);
+    d_context->push();
+    q.dequeue();
+    q.enqueue(3);
+    d_context->push();
+    q.dequeue();
+    q.dequeue();
+    TS_ASSERT(q.empty());
+    d_context->pop();
+    TS_ASSERT_EQUALS(q.front(), 2);
+    TS_ASSERT_EQUALS(q.size(), 3u);
+    d_context->pop();
+    TS_ASSERT_EQUALS(q.front(), 1);
+    TS_ASSERT_EQUALS(q.size(), 2u);
+    // a scope that only dequeues
+    d_context->push();
+    q.dequeue();
+    d_context->pop();
+    TS_ASSERT_EQUALS(q.frontIndex(), 0u);
+  }
+};
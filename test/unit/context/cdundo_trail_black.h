@@ -0,0 +1,132 @@
+/*********************                                                        */
+/*! \file cdundo_trail_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of CVC4::context::CDUndoTrail.
+ **
+ ** Black box testing of CVC4::context::CDUndoTrail, and a comparison of its
+ ** results with CDO<>. Their throughput is compared by the microbenchmarks
+ ** in test/perf/micro.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <array>
+#include <vector>
+
+#include "context/cdo.h"
+#include "context/cdundo_trail.h"
+#include "context/context.h"
+
+using namespace std;
+using namespace CVC4;
+using namespace CVC4::context;
+
+class CDUndoTrailBlack : public CxxTest::TestSuite
+{
+ private:
+  Context* d_context;
+
+  /** A structure of which each scope only changes one field */
+  typedef std::array<uint64_t, 64> Block;
+
+  /** The number of blocks in the comparison with CDO<> */
+  static const size_t s_numBlocks = 256;
+  /** The number of rounds of the comparison with CDO<> */
+  static const size_t s_numRounds = 200;
+
+ public:
+  void setUp() override { d_context = new Context; }
+
+  void tearDown() override { delete d_context; }
+
+  void testSetAndRestore()
+  {
+    CDUndoTrail trail(d_context);
+    int x = 1;
+    bool b = false;
+    double d = 0.5;
+    trail.set(x, 2);
+    // nothing is logged at level 0
+    TS_ASSERT_EQUALS(trail.size(), 0u);
+    d_context->push();
+    trail.set(x, 3);
+    trail.set(b, true);
+    trail.set(x, 4);
+    TS_ASSERT_EQUALS(trail.size(), 3u);
+    d_context->push();
+    trail.set(d, 1.5);
+    trail.set(x, 5);
+    TS_ASSERT_EQUALS(x, 5);
+    d_context->pop();
+    TS_ASSERT_EQUALS(x, 4);
+    TS_ASSERT_EQUALS(d, 0.5);
+    TS_ASSERT(b);
+    TS_ASSERT_EQUALS(trail.size(), 3u);
+    d_context->pop();
+    TS_ASSERT_EQUALS(x, 2);
+    TS_ASSERT(!b);
+    TS_ASSERT_EQUALS(trail.size(), 0u);
+  }
+
+  void testEmptyScopes()
+  {
+    CDUndoTrail trail(d_context);
+    unsigned x = 0;
+    d_context->push();
+    trail.set(x, 1u);
+    d_context->push();
+    d_context->push();
+    d_context->pop();
+    trail.set(x, 2u);
+    d_context->pop();
+    TS_ASSERT_EQUALS(x, 1u);
+    d_context->push();
+    d_context->pop();
+    TS_ASSERT_EQUALS(x, 1u);
+    d_context->pop();
+    TS_ASSERT_EQUALS(x, 0u);
+  }
+
+  void testSameResultsAsCDO()
+  {
+    // the same sequence of writes, once on CDO<Block>s that copy a whole
+    // block at the first write in a scope, once on plain blocks with a trail
+    std::vector<CDO<Block>*> cdos;
+    std::vector<Block> blocks(s_numBlocks);
+    Block zero;
+    zero.fill(0);
+    for (size_t i = 0; i < s_numBlocks; i++)
+    {
+      cdos.push_back(new (true) CDO<Block>(d_context, zero));
+      blocks[i] = zero;
+    }
+
+    CDUndoTrail trail(d_context);
+    for (size_t r = 0; r < s_numRounds; r++)
+    {
+      d_context->push();
+      for (size_t i = 0; i < s_numBlocks; i++)
+      {
+        Block b = cdos[i]->get();
+        b[r % b.size()] = r + 1;
+        cdos[i]->set(b);
+        trail.set(blocks[i][r % blocks[i].size()], uint64_t(r + 1));
+        TS_ASSERT(cdos[i]->get() == blocks[i]);
+      }
+      d_context->pop();
+    }
+
+    for (size_t i = 0; i < s_numBlocks; i++)
+    {
+      TS_ASSERT(cdos[i]->get() == zero);
+      TS_ASSERT(blocks[i] == zero);
+      cdos[i]->deleteSelf();
+    }
+  }
+};
@@ -93,5 +93,70 @@ private:
 #endif /* __CVC4__CONTEXT__CONTEXT_MM_H */
   }
 
+  void testAccounting()
+  {
+#ifndef CVC4_DEBUG_CONTEXT_MEMORY_MANAGER
+    unsigned chunkSizeBytes = 16384;
+    d_cmm->newData(100);
+    TS_ASSERT_EQUALS(d_cmm->getBytesAllocated(), 100u);
+    d_cmm->push();
+    // more than the rest of the first chunk, at level 1
+    for (unsigned i = 0; i < 5; i++)
+    {
+      d_cmm->newData(chunkSizeBytes / 4);
+    }
+    TS_ASSERT_EQUALS(d_cmm->getBytesAllocated(), 100u + 5 * chunkSizeBytes / 4);
+    d_cmm->push();
+    d_cmm->newData(10);
+    std::vector<uint64_t> levels;
+    d_cmm->getMaxLevelBytes(levels);
+    TS_ASSERT_EQUALS(levels.size(), 3u);
+    TS_ASSERT_EQUALS(levels[0], 100u);
+    TS_ASSERT_EQUALS(levels[1], 5u * chunkSizeBytes / 4);
+    TS_ASSERT_EQUALS(levels[2], 10u);
+    d_cmm->pop();
+    d_cmm->pop();
+    TS_ASSERT_EQUALS(d_cmm->getBytesAllocated(), 100u);
+    TS_ASSERT_EQUALS(d_cmm->getMaxBytesAllocated(), 110u + 5 * chunkSizeBytes / 4);
+    TS_ASSERT_EQUALS(d_cmm->getMaxChunks(), 2u);
+    // the maxima of the popped levels are kept
+    d_cmm->getMaxLevelBytes(levels);
+    TS_ASSERT_EQUALS(levels.size(), 3u);
+    TS_ASSERT_EQUALS(levels[2], 10u);
+
+    d_cmm->setTrackTypes(true);
+    d_cmm->recordSave("T", 8);
+    d_cmm->recordSave("T", 8);
+    TS_ASSERT_EQUALS(d_cmm->getTypeSaves().size(), 1u);
+    TS_ASSERT_EQUALS(d_cmm->getTypeSaves().begin()->second.first, 2u);
+    TS_ASSERT_EQUALS(d_cmm->getTypeSaves().begin()->second.second, 16u);
+#endif /* CVC4_DEBUG_CONTEXT_MEMORY_MANAGER */
+  }
+
+  void testReleaseAfterDeepPop()
+  {
+#ifndef CVC4_DEBUG_CONTEXT_MEMORY_MANAGER
+    unsigned chunkSizeBytes = 16384;
+    // a deep push that uses 50 chunks, including the initial one
+    d_cmm->push();
+    for (unsigned i = 0; i < 50; i++)
+    {
+      d_cmm->newData(chunkSizeBytes);
+    }
+    d_cmm->pop();
+    // the chunks are kept while they were used recently
+    TS_ASSERT_EQUALS(d_cmm->getChunksReleased(), 0u);
+    // many shallow pushes and pops, after which the chunks are released
+    for (unsigned i = 0; i < 1000; i++)
+    {
+      d_cmm->push();
+      d_cmm->newData(10);
+      d_cmm->pop();
+    }
+    TS_ASSERT(d_cmm->getChunksReleased() > 0);
+    TS_ASSERT_EQUALS(d_cmm->getMaxChunks(), 50u);
+#endif /* CVC4_DEBUG_CONTEXT_MEMORY_MANAGER */
+  }
+
   void tearDown() override { delete d_cmm; }
 };
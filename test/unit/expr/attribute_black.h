@@ -135,4 +135,91 @@ private:
     delete node;
   }
 
+  struct DenseNodeAttributeId {};
+  typedef expr::Attribute<DenseNodeAttributeId, Node, false, true>
+      DenseNodeAttribute;
+  void testDenseNodes(){
+    TypeNode booleanType = d_nodeManager->booleanType();
+    Node* node = new Node(d_nodeManager->mkSkolem("b", booleanType));
+
+    Node val(d_nodeManager->mkSkolem("b", booleanType));
+    Node data0;
+    Node data1;
+
+    DenseNodeAttribute attr;
+    TS_ASSERT(!node->hasAttribute(attr));
+    TS_ASSERT(!node->getAttribute(attr, data0));
+    node->setAttribute(attr, val);
+    TS_ASSERT(node->getAttribute(attr, data1));
+    TS_ASSERT_EQUALS(data1, val);
+    // a null value is a value
+    node->setAttribute(attr, Node::null());
+    TS_ASSERT(node->hasAttribute(attr));
+    TS_ASSERT(node->getAttribute(attr, data1));
+    TS_ASSERT(data1.isNull());
+
+    delete node;
+  }
+
+  struct DenseBoolAttributeId {};
+  typedef expr::Attribute<DenseBoolAttributeId, bool, false, true>
+      DenseBoolAttribute;
+  void testDenseBools(){
+    TypeNode booleanType = d_nodeManager->booleanType();
+    Node* node = new Node(d_nodeManager->mkSkolem("b", booleanType));
+
+    bool data0 = true;
+    bool data1 = false;
+
+    DenseBoolAttribute attr;
+    TS_ASSERT(node->getAttribute(attr, data0));
+    TS_ASSERT_EQUALS(false, data0);
+    node->setAttribute(attr, true);
+    TS_ASSERT(node->getAttribute(attr, data1));
+    TS_ASSERT_EQUALS(true, data1);
+    node->setAttribute(attr, false);
+    TS_ASSERT(!node->getAttribute(attr));
+
+    delete node;
+  }
+
+  void testDenseManyNodes(){
+    // enough nodes to span several pages of the dense tables
+    TypeNode booleanType = d_nodeManager->booleanType();
+    std::vector<Node> nodes;
+    for (unsigned i = 0; i < 5000; ++i)
+    {
+      nodes.push_back(d_nodeManager->mkSkolem("b", booleanType));
+    }
+    DenseNodeAttribute nattr;
+    DenseBoolAttribute battr;
+    for (unsigned i = 0; i < nodes.size(); i += 2)
+    {
+      nodes[i].setAttribute(nattr, nodes[nodes.size() - 1 - i]);
+      nodes[i].setAttribute(battr, true);
+    }
+    for (unsigned i = 0; i < nodes.size(); ++i)
+    {
+      TS_ASSERT_EQUALS(nodes[i].hasAttribute(nattr), i % 2 == 0);
+      TS_ASSERT_EQUALS(nodes[i].getAttribute(battr), i % 2 == 0);
+      if (i % 2 == 0)
+      {
+        TS_ASSERT_EQUALS(nodes[i].getAttribute(nattr),
+                         nodes[nodes.size() - 1 - i]);
+      }
+    }
+
+    // deleting the attributes removes them from all nodes
+    expr::attr::AttributeUniqueId nid =
+        expr::attr::AttributeManager::getAttributeId(nattr);
+    expr::attr::AttributeUniqueId bid =
+        expr::attr::AttributeManager::getAttributeId(battr);
+    d_nodeManager->deleteAttributes({&nid, &bid});
+    for (const Node& n : nodes)
+    {
+      TS_ASSERT(!n.hasAttribute(nattr));
+      TS_ASSERT(!n.getAttribute(battr));
+    }
+  }
+
 };
@@ -135,7 +135,7 @@ class AttributeWhite : public CxxTest::TestSuite {
 //    TS_ASSERT_DIFFERS(theory::PostRewriteCache::s_id, theory::PostRewriteCacheTop::s_id);
 //    TS_ASSERT_DIFFERS(theory::PreRewriteCacheTop::s_id, theory::PostRewriteCacheTop::s_id);
 
-    lastId = attr::LastAttributeId<TypeNode, false>::getId();
+    lastId = attr::LastAttributeId<DenseAttrTable<TypeNode>, false>::getId();
     TS_ASSERT_LESS_THAN(TypeAttr::s_id, lastId);
   }
 
@@ -97,6 +97,41 @@ class NodeAlgorithmBlack : public CxxTest::TestSuite
     TS_ASSERT(syms.find(var) == syms.end());
   }
 
+  // the free variables and symbols are cached, querying a subterm first must
+  // not change the result of a query on a term containing it
+  void testGetFreeVariablesCached()
+  {
+    Node x = d_nodeManager->mkSkolem("x", d_nodeManager->integerType());
+    Node y = d_nodeManager->mkSkolem("y", d_nodeManager->integerType());
+    Node var = d_nodeManager->mkBoundVar(*d_intTypeNode);
+    Node sum = d_nodeManager->mkNode(PLUS, var, var);
+    Node qeq = d_nodeManager->mkNode(EQUAL, x, sum);
+    Node bvl = d_nodeManager->mkNode(BOUND_VAR_LIST, var);
+    Node quant = d_nodeManager->mkNode(EXISTS, bvl, qeq);
+    Node res = d_nodeManager->mkNode(
+        AND, d_nodeManager->mkNode(EQUAL, y, sum), quant);
+
+    std::unordered_set<Node, NodeHashFunction> fvs;
+    TS_ASSERT(getFreeVariables(qeq, fvs));
+    TS_ASSERT_EQUALS(fvs.size(), 1);
+    TS_ASSERT(!hasFreeVar(quant));
+    fvs.clear();
+    TS_ASSERT(getFreeVariables(res, fvs));
+    TS_ASSERT_EQUALS(fvs.size(), 1);
+    TS_ASSERT(fvs.find(var) != fvs.end());
+
+    std::unordered_set<Node, NodeHashFunction> syms;
+    getSymbols(quant, syms);
+    TS_ASSERT_EQUALS(syms.size(), 1);
+    syms.clear();
+    getSymbols(res, syms);
+    TS_ASSERT_EQUALS(syms.size(), 2);
+    TS_ASSERT(hasSubterm(res, x));
+    TS_ASSERT(hasSubterm(res, y));
+    TS_ASSERT(!hasSubterm(quant, y));
+    TS_ASSERT(!hasSubterm(x, x, true));
+  }
+
   void testGetOperatorsMap()
   {
     // map to store result
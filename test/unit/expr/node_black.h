@@ -662,6 +662,30 @@ class NodeBlack : public CxxTest::TestSuite {
               << n << std::endl;
   }
 
+  void testDagifierSharing() {
+    TypeNode intType = d_nodeManager->integerType();
+    Node x = d_nodeManager->mkSkolem("x", intType, "",
+                                     NodeManager::SKOLEM_EXACT_NAME);
+
+    // a term whose tree has 2^100 leaves, but whose DAG has 101 nodes
+    Node n = x;
+    for (unsigned i = 0; i < 100; ++i)
+    {
+      n = d_nodeManager->mkNode(PLUS, n, n);
+    }
+
+    stringstream sstr;
+    sstr << Node::setdepth(-1)
+         << Node::setlanguage(language::output::LANG_SMTLIB_V2_6)
+         << Node::dag(1) << n;
+    const std::string s = sstr.str();
+    TS_ASSERT(s.find("(let ((_let_0 (+ x x))) (let ((_let_1 (+ _let_0 _let_0)))")
+              == 0);
+    TS_ASSERT(s.find("(let ((_let_98 (+ _let_97 _let_97))) (+ _let_98 _let_98)")
+              != std::string::npos);
+    TS_ASSERT(s.find("_let_99") == std::string::npos);
+  }
+
   void testForEachOverNodeAsNodes() {
     const std::vector<Node> skolems =
         makeNSkolemNodes(d_nodeManager, 3, d_nodeManager->integerType());
@@ -22,6 +22,7 @@
 #include "base/output.h"
 #include "expr/node_manager.h"
 #include "expr/node_manager_attributes.h"
+#include "options/expr_options.h"
 #include "test_utils.h"
 #include "util/integer.h"
 #include "util/rational.h"
@@ -78,6 +79,23 @@ class NodeManagerBlack : public CxxTest::TestSuite {
     TS_ASSERT_EQUALS( n[2], z);
   }
 
+  void testMkNodeExisting() {
+    Node x = d_nodeManager->mkSkolem("x",d_nodeManager->booleanType());
+    Node y = d_nodeManager->mkSkolem("y",d_nodeManager->booleanType());
+    Node z = d_nodeManager->mkSkolem("z",d_nodeManager->booleanType());
+    NodeBuilder<3> nb(d_nodeManager, AND);
+    nb << x << y << z;
+    Node n = nb.constructNode();
+    Node m = d_nodeManager->mkNode(AND, x, y, z);
+    TS_ASSERT_EQUALS( n, m );
+    TS_ASSERT_EQUALS( n.getId(), m.getId() );
+    TS_ASSERT_EQUALS( d_nodeManager->mkNode(NOT, n),
+                      d_nodeManager->mkNode(NOT, m) );
+    Node o = d_nodeManager->mkNode(AND, z, y, x);
+    TS_ASSERT_DIFFERS( n, o );
+    TS_ASSERT_EQUALS( o[0], z );
+  }
+
   void testMkNodeFourChildren() {
     Node x1 = d_nodeManager->mkSkolem("x1",d_nodeManager->booleanType());
     Node x2 = d_nodeManager->mkSkolem("x2",d_nodeManager->booleanType());
@@ -297,6 +315,64 @@ class NodeManagerBlack : public CxxTest::TestSuite {
 
   }
 
+  void testNodeArena()
+  {
+    Options opts;
+    opts.setOption("node-arena", "true");
+    NodeManager* nm = new NodeManager(NULL, opts);
+    {
+      NodeManagerScope nms(nm);
+      TypeNode intType = nm->integerType();
+      Node x = nm->mkSkolem("x", intType);
+      std::vector<Node> terms;
+      for (unsigned i = 0; i < 64; ++i)
+      {
+        terms.push_back(nm->mkNode(PLUS, x, nm->mkConst(Rational(i))));
+      }
+      // large enough to not be allocated from the slabs
+      Node sum = nm->mkNode(PLUS, terms);
+      TS_ASSERT_EQUALS(sum.getNumChildren(), 64u);
+      TS_ASSERT_EQUALS(sum, nm->mkNode(PLUS, terms));
+      TS_ASSERT_EQUALS(terms[3], nm->mkNode(PLUS, x, nm->mkConst(Rational(3))));
+      terms.clear();
+      nm->reclaimZombiesUntil(0);
+      TS_ASSERT_EQUALS(sum[5][1], nm->mkConst(Rational(5)));
+      // leave some nodes alive, they are released in bulk
+      sum = Node::null();
+      terms.push_back(nm->mkNode(MULT, x, x));
+    }
+    delete nm;
+  }
+
+  void testTrustedConstruction()
+  {
+    Options opts;
+    opts.setOption("trusted-construction", "true");
+    NodeManager* nm = new NodeManager(NULL, opts);
+    {
+      NodeManagerScope nms(nm);
+      Node x = nm->mkSkolem("x", nm->integerType());
+      Node b = nm->mkSkolem("b", nm->booleanType());
+      Node sum = x;
+      for (unsigned i = 0; i < 1000; ++i)
+      {
+        sum = nm->mkNode(PLUS, sum, x);
+      }
+      // the types are known as soon as the nodes are built, unchecked
+      TS_ASSERT(nm->hasAttribute(sum, expr::TypeAttr()));
+      TS_ASSERT(!nm->getAttribute(sum, expr::TypeCheckedAttr()));
+      Node geq = nm->mkNode(GEQ, sum, x);
+      TS_ASSERT_EQUALS(nm->getType(geq, true), nm->booleanType());
+      TS_ASSERT(nm->getAttribute(sum[0], expr::TypeCheckedAttr()));
+
+      // ill-typed terms are only rejected when they are checked
+      Node bad = nm->mkNode(PLUS, x, b);
+      TS_ASSERT_THROWS(nm->getType(nm->mkNode(GEQ, bad, x), true),
+                       TypeCheckingExceptionPrivate&);
+    }
+    delete nm;
+  }
+
   /* This test is only valid if assertions are enabled. */
   void testMkNodeTooFew() {
 #ifdef CVC4_ASSERTIONS
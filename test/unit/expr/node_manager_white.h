@@ -17,6 +17,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include <string>
+#include <vector>
 
 #include "expr/node_manager.h"
 #include "test_utils.h"
@@ -51,6 +52,49 @@ class NodeManagerWhite : public CxxTest::TestSuite {
     TS_ASSERT_EQUALS(n.getId(), m.getId());
   }
 
+  void testBoundedReclaim()
+  {
+    size_t poolSize = d_nm->poolSize();
+    {
+      std::vector<Node> nodes;
+      for (unsigned i = 0; i < 6000; ++i)
+      {
+        nodes.push_back(d_nm->mkConst(Rational(i)));
+      }
+      TS_ASSERT_EQUALS(d_nm->poolSize(), poolSize + 6000);
+    }
+    // some zombies were reclaimed, but at most --gc-batch at a time
+    TS_ASSERT(d_nm->poolSize() < poolSize + 6000);
+    TS_ASSERT(!d_nm->d_zombies.empty());
+    TS_ASSERT(d_nm->d_zombies.size() <= 5000);
+    TS_ASSERT_EQUALS(d_nm->d_zombies.size(), d_nm->d_zombieStack.size());
+    d_nm->reclaimZombies();
+    TS_ASSERT(d_nm->d_zombies.empty());
+    TS_ASSERT(d_nm->d_zombieStack.empty());
+    TS_ASSERT_EQUALS(d_nm->poolSize(), poolSize);
+  }
+
+  void testPoolEraseKeepsLookups()
+  {
+    size_t poolSize = d_nm->poolSize();
+    std::vector<Node> odd;
+    {
+      std::vector<Node> even;
+      for (unsigned i = 0; i < 2000; ++i)
+      {
+        (i % 2 == 0 ? even : odd).push_back(d_nm->mkConst(Rational(i)));
+      }
+    }
+    d_nm->reclaimZombies();
+    TS_ASSERT_EQUALS(d_nm->poolSize(), poolSize + 1000);
+    // the remaining nodes are still found after the others were erased
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+      TS_ASSERT_EQUALS(d_nm->mkConst(Rational(2 * i + 1)), odd[i]);
+    }
+    TS_ASSERT_EQUALS(d_nm->poolSize(), poolSize + 1000);
+  }
+
   void testOversizedNodeBuilder() {
     NodeBuilder<> nb;
 
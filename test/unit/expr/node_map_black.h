@@ -0,0 +1,102 @@
+/*********************                                                        */
+/*! \file node_map_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of CVC4::expr::NodeMap
+ **
+ ** Black box testing of CVC4::expr::NodeMap.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <vector>
+
+#include "expr/node_manager.h"
+#include "expr/node_map.h"
+
+using namespace CVC4;
+using namespace CVC4::expr;
+using namespace CVC4::kind;
+
+class NodeMapBlack : public CxxTest::TestSuite
+{
+ private:
+  NodeManager* d_nodeManager;
+  NodeManagerScope* d_scope;
+
+ public:
+  void setUp() override
+  {
+    d_nodeManager = new NodeManager(NULL);
+    d_scope = new NodeManagerScope(d_nodeManager);
+  }
+
+  void tearDown() override
+  {
+    delete d_scope;
+    delete d_nodeManager;
+  }
+
+  void testInsertFind()
+  {
+    Node x = d_nodeManager->mkSkolem("x", d_nodeManager->integerType());
+    Node y = d_nodeManager->mkSkolem("y", d_nodeManager->integerType());
+    Node sum = d_nodeManager->mkNode(PLUS, x, y);
+
+    NodeMap<Node> map;
+    TS_ASSERT(map.empty());
+    TS_ASSERT(map.find(x) == nullptr);
+
+    map.insert(x, y);
+    map[sum] = x;
+    TS_ASSERT_EQUALS(map.size(), 2u);
+    TS_ASSERT(map.contains(x));
+    TS_ASSERT(!map.contains(y));
+    TS_ASSERT_EQUALS(*map.find(x), y);
+    TS_ASSERT_EQUALS(map[sum], x);
+
+    // operator[] inserts a default value
+    TS_ASSERT(map[y].isNull());
+    TS_ASSERT_EQUALS(map.size(), 3u);
+
+    TS_ASSERT(map.erase(x));
+    TS_ASSERT(!map.erase(x));
+    TS_ASSERT(!map.contains(x));
+    TS_ASSERT_EQUALS(map.size(), 2u);
+  }
+
+  void testClear()
+  {
+    std::vector<Node> vars;
+    NodeMap<uint32_t> map;
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+      vars.push_back(
+          d_nodeManager->mkSkolem("x", d_nodeManager->integerType()));
+      map[vars.back()] = i;
+    }
+    TS_ASSERT_EQUALS(map.size(), 1000u);
+
+    map.clear();
+    TS_ASSERT(map.empty());
+    for (const Node& v : vars)
+    {
+      TS_ASSERT(!map.contains(v));
+    }
+
+    // entries of a new epoch start from the default value
+    TS_ASSERT_EQUALS(map[vars[5]], 0u);
+    map[vars[7]] = 3;
+    TS_ASSERT_EQUALS(map.size(), 2u);
+    TS_ASSERT_EQUALS(*map.find(vars[7]), 3u);
+
+    map.release();
+    TS_ASSERT(map.empty());
+    TS_ASSERT(!map.contains(vars[7]));
+  }
+};
@@ -159,6 +159,55 @@ private:
     TS_ASSERT_EQUALS( symtab.lookup("x"), x );
   }
 
+  void testNestedScopes()
+  {
+    SymbolTable symtab;
+    Type booleanType = d_exprManager->booleanType();
+    Expr x = d_exprManager->mkVar(booleanType);
+    Expr y = d_exprManager->mkVar(booleanType);
+    Expr z = d_exprManager->mkVar(booleanType);
+    symtab.bind("x", x);
+    symtab.pushScope();
+    symtab.bind("x", y);
+    symtab.bind("y", y);
+    symtab.pushScope();
+    symtab.bind("x", z);
+    // rebinding in the same scope
+    symtab.bind("x", x);
+    symtab.bind("z", z);
+    TS_ASSERT_EQUALS(symtab.getLevel(), 2u);
+    TS_ASSERT_EQUALS(symtab.lookup("x"), x);
+
+    symtab.popScope();
+    TS_ASSERT_EQUALS(symtab.lookup("x"), y);
+    TS_ASSERT(symtab.isBound("y"));
+    TS_ASSERT(!symtab.isBound("z"));
+
+    symtab.popScope();
+    TS_ASSERT_EQUALS(symtab.getLevel(), 0u);
+    TS_ASSERT_EQUALS(symtab.lookup("x"), x);
+    TS_ASSERT(!symtab.isBound("y"));
+  }
+
+  void testBindLevelZero()
+  {
+    SymbolTable symtab;
+    Type booleanType = d_exprManager->booleanType();
+    Expr x = d_exprManager->mkVar(booleanType);
+    Expr y = d_exprManager->mkVar(booleanType);
+    symtab.pushScope();
+    symtab.bind("x", x, true);
+    symtab.bind("y", y);
+    // a level zero binding under a binding of the scope
+    symtab.bind("y", x, true);
+    TS_ASSERT_EQUALS(symtab.lookup("y"), y);
+    symtab.popScope();
+    TS_ASSERT(symtab.isBound("x"));
+    TS_ASSERT_EQUALS(symtab.lookup("x"), x);
+    TS_ASSERT(symtab.isBound("y"));
+    TS_ASSERT_EQUALS(symtab.lookup("y"), x);
+  }
+
   void testBadPop() {
     SymbolTable symtab;
     // TODO: What kind of exception gets thrown here?
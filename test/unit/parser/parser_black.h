@@ -304,15 +304,13 @@ public:
   }
 };/* class Cvc4ParserTest */
 
-class Smt2ParserTest : public CxxTest::TestSuite, public ParserBlack {
+/** Tests of SMT-LIB 2 inputs, shared by both SMT-LIB 2 parsers */
+class Smt2ParserBlack : public ParserBlack
+{
   typedef ParserBlack super;
 
-public:
-  Smt2ParserTest() : ParserBlack(LANG_SMTLIB_V2) { }
-
-  void setUp() override { super::setUp(); }
-
-  void tearDown() override { super::tearDown(); }
+ public:
+  Smt2ParserBlack() : ParserBlack(LANG_SMTLIB_V2) {}
 
   void setupContext(Parser& parser) override
   {
@@ -322,7 +320,7 @@ public:
     super::setupContext(parser);
   }
 
-  void testGoodSmt2Inputs() {
+  void checkGoodSmt2Inputs() {
     tryGoodInput(""); // empty string is OK
     tryGoodInput("(set-logic QF_UF)");
     tryGoodInput("(set-info :notes |This is a note, take note!|)");
@@ -344,7 +342,7 @@ public:
     tryGoodInput("; a comment\n(check-sat ; goodbye\n)");
   }
 
-  void testBadSmt2Inputs() {
+  void checkBadSmt2Inputs() {
 // competition builds don't do any checking
 #ifndef CVC4_COMPETITION_MODE
     tryBadInput("(assert)"); // no args
@@ -359,7 +357,7 @@ public:
 #endif /* ! CVC4_COMPETITION_MODE */
   }
 
-  void testGoodSmt2Exprs() {
+  void checkGoodSmt2Exprs() {
     tryGoodExpr("(and a b)");
     tryGoodExpr("(or (and a b) c)");
     tryGoodExpr("(=> (and (=> a b) a) b)");
@@ -374,7 +372,7 @@ public:
     tryGoodExpr("(* 5 01)"); // '01' is OK in non-strict mode
   }
 
-  void testBadSmt2Exprs() {
+  void checkBadSmt2Exprs() {
 // competition builds don't do any checking
 #ifndef CVC4_COMPETITION_MODE
     tryBadExpr("(and)"); // wrong arity
@@ -401,4 +399,60 @@ public:
     tryBadExpr("(* 5 01)", true); // '01' is not a valid integer constant
 #endif /* ! CVC4_COMPETITION_MODE */
   }
+}; /* class Smt2ParserBlack */
+
+class Smt2ParserTest : public CxxTest::TestSuite, public Smt2ParserBlack {
+  typedef Smt2ParserBlack super;
+
+public:
+  void setUp() override { super::setUp(); }
+
+  void tearDown() override { super::tearDown(); }
+
+  void testGoodSmt2Inputs() { checkGoodSmt2Inputs(); }
+
+  void testBadSmt2Inputs() { checkBadSmt2Inputs(); }
+
+  void testGoodSmt2Exprs() { checkGoodSmt2Exprs(); }
+
+  void testBadSmt2Exprs() { checkBadSmt2Exprs(); }
 };/* class Smt2ParserTest */
+
+/** Tests of the hand-written SMT-LIB 2 parser (--fast-parser) */
+class Smt2FastParserTest : public CxxTest::TestSuite, public Smt2ParserBlack {
+  typedef Smt2ParserBlack super;
+
+public:
+  void setUp() override
+  {
+    d_options.setOption("fast-parser", "true");
+    super::setUp();
+  }
+
+  void tearDown() override { super::tearDown(); }
+
+  void testGoodSmt2Inputs()
+  {
+    checkGoodSmt2Inputs();
+    tryGoodInput("(set-logic QF_UF) (declare-fun a () Bool) "
+                 "(assert (let ((b (not a))) (let ((c (and a b))) c)))");
+    tryGoodInput("(set-logic UF) (declare-sort U 0) "
+                 "(assert (forall ((x U) (y U)) (! (= x y) :pattern (x))))");
+    tryGoodInput("(set-logic QF_UF) (define-fun f ((a Bool)) Bool (not a)) "
+                 "(push 1) (assert (! (f true) :named n)) (pop 1)");
+    // handed to the ANTLR parser
+    tryGoodInput("(set-logic ALL) (declare-datatypes ((L 0)) (((nil)))) "
+                 "(declare-fun x () L) (assert (= x nil))");
+    tryGoodInput("(set-logic ALL) (define-fun-rec f ((x Int)) Int "
+                 "(ite (<= x 0) 0 (f (- x 1)))) (assert (= (f 1) 0))");
+  }
+
+  void testBadSmt2Inputs()
+  {
+    checkBadSmt2Inputs();
+  }
+
+  void testGoodSmt2Exprs() { checkGoodSmt2Exprs(); }
+
+  void testBadSmt2Exprs() { checkBadSmt2Exprs(); }
+};/* class Smt2FastParserTest */
@@ -337,6 +337,46 @@ class TheoryBVGaussWhite : public CxxTest::TestSuite
     testGaussElimX(Integer(11), rhs, lhs, BVGauss::Result::UNIQUE);
   }
 
+  void testGaussElimModWide()
+  {
+    std::vector<Integer> rhs;
+    std::vector<std::vector<Integer>> lhs;
+
+    /* -------------------------------------------------------------------
+     *   lhs   rhs  modulo { 2^32 + 15 }
+     *  --^--   ^
+     *  1 1 1   5
+     *  2 3 5   8
+     *  4 0 5   2
+     * ------------------------------------------------------------------- */
+    rhs = {Integer(5), Integer(8), Integer(2)};
+    lhs = {{Integer(1), Integer(1), Integer(1)},
+           {Integer(2), Integer(3), Integer(5)},
+           {Integer(4), Integer(0), Integer(5)}};
+    std::cout << "matrix 0, modulo 2^32 + 15" << std::endl;
+    testGaussElimX(Integer(4294967311u), rhs, lhs, BVGauss::Result::UNIQUE);
+
+    /* -------------------------------------------------------------------
+     * 70 x 70 upper triangular matrix of ones, with rows packed into more
+     * than one word modulo 2
+     * ------------------------------------------------------------------- */
+    size_t n = 70;
+    rhs = std::vector<Integer>(n);
+    lhs = std::vector<std::vector<Integer>>(n, std::vector<Integer>(n));
+    for (size_t i = 0; i < n; ++i)
+    {
+      rhs[i] = Integer(i % 3 == 0 ? 1 : 0);
+      for (size_t j = 0; j < n; ++j)
+      {
+        lhs[i][j] = Integer(j >= i ? 1 : 0);
+      }
+    }
+    std::cout << "matrix 70x70, modulo 2" << std::endl;
+    testGaussElimX(Integer(2), rhs, lhs, BVGauss::Result::UNIQUE);
+    std::cout << "matrix 70x70, modulo 3" << std::endl;
+    testGaussElimX(Integer(3), rhs, lhs, BVGauss::Result::UNIQUE);
+  }
+
   void testGaussElimUniqueDone()
   {
     std::vector<Integer> rhs;
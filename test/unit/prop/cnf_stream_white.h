@@ -294,4 +294,27 @@ class CnfStreamWhite : public CxxTest::TestSuite {
     TS_ASSERT(d_satSolver->addClauseCalled());
     TS_ASSERT(d_cnfStream->hasLiteral(a_and_b));
   }
+
+  void testGateHashing()
+  {
+    NodeManagerScope nms(d_nodeManager);
+    Node a = d_nodeManager->mkVar(d_nodeManager->booleanType());
+    Node b = d_nodeManager->mkVar(d_nodeManager->booleanType());
+    Node a_and_b = d_nodeManager->mkNode(kind::AND, a, b);
+    Node b_and_a = d_nodeManager->mkNode(kind::AND, b, a);
+    // ~b | ~~~a is the negation of a & b
+    Node nnna = a.notNode().notNode().notNode();
+    Node nb_or_na = d_nodeManager->mkNode(kind::OR, b.notNode(), nnna);
+    d_cnfStream->ensureLiteral(a_and_b);
+    d_satSolver->reset();
+    // Equal gates share the literal without new clauses
+    d_cnfStream->ensureLiteral(b_and_a);
+    TS_ASSERT(!d_satSolver->addClauseCalled());
+    TS_ASSERT_EQUALS(d_cnfStream->getLiteral(a_and_b),
+                     d_cnfStream->getLiteral(b_and_a));
+    d_cnfStream->ensureLiteral(nb_or_na);
+    TS_ASSERT(!d_satSolver->addClauseCalled());
+    TS_ASSERT_EQUALS(d_cnfStream->getLiteral(a_and_b),
+                     ~d_cnfStream->getLiteral(nb_or_na));
+  }
 };
@@ -180,4 +180,58 @@ class TheoryEvaluatorWhite : public CxxTest::TestSuite
       TS_ASSERT_EQUALS(r, d_nm->mkConst(Rational(-1)));
     }
   }
+
+  void testPoints()
+  {
+    TypeNode intType = d_nm->integerType();
+    TypeNode bv8Type = d_nm->mkBitVectorType(8);
+
+    Node x = d_nm->mkVar("x", intType);
+    Node y = d_nm->mkVar("y", intType);
+    Node u = d_nm->mkVar("u", bv8Type);
+    Node v = d_nm->mkVar("v", bv8Type);
+
+    Evaluator eval;
+
+    // (ite (>= x y) (+ x y) (* x y)) on each point
+    {
+      Node t = d_nm->mkNode(kind::ITE,
+                            d_nm->mkNode(kind::GEQ, x, y),
+                            d_nm->mkNode(kind::PLUS, x, y),
+                            d_nm->mkNode(kind::MULT, x, y));
+      std::vector<Node> args = {x, y};
+      std::vector<std::vector<Node>> points;
+      for (int i = -2; i <= 2; i++)
+      {
+        points.push_back({d_nm->mkConst(Rational(i)),
+                          d_nm->mkConst(Rational(3 - i))});
+      }
+      std::vector<Node> res;
+      eval.eval(t, args, points, res);
+      TS_ASSERT_EQUALS(res.size(), points.size());
+      for (size_t i = 0, npoints = points.size(); i < npoints; i++)
+      {
+        TS_ASSERT_EQUALS(res[i], eval.eval(t, args, points[i]));
+      }
+    }
+
+    // (bvudiv u v), where the point with v = 0 is not a valid EvalResult
+    {
+      Node t = d_nm->mkNode(kind::BITVECTOR_UDIV, u, v);
+      std::vector<Node> args = {u, v};
+      Node c = d_nm->mkConst(BitVector(8, (unsigned int)42));
+      std::vector<std::vector<Node>> points = {
+          {c, d_nm->mkConst(BitVector(8, (unsigned int)5))},
+          {c, d_nm->mkConst(BitVector(8, (unsigned int)0))}};
+      std::vector<Node> res;
+      eval.eval(t, args, points, res);
+      TS_ASSERT_EQUALS(res.size(), 2u);
+      TS_ASSERT_EQUALS(res[0], d_nm->mkConst(BitVector(8, (unsigned int)8)));
+      TS_ASSERT_EQUALS(res[1],
+                       Rewriter::rewrite(t.substitute(args.begin(),
+                                                      args.end(),
+                                                      points[1].begin(),
+                                                      points[1].end())));
+    }
+  }
 };
@@ -72,6 +72,12 @@ class RegexpOperationBlack : public CxxTest::TestSuite
     TS_ASSERT(!d_regExpOpr->regExpIncludes(r1, r2));
   }
 
+  bool isIntersectionEmpty(Node r1, Node r2)
+  {
+    return d_regExpOpr->isIntersectionEmpty(Rewriter::rewrite(r1),
+                                            Rewriter::rewrite(r2));
+  }
+
   void testBasic()
   {
     Node sigma = d_nm->mkNode(REGEXP_SIGMA, std::vector<Node>{});
@@ -142,6 +148,40 @@ class RegexpOperationBlack : public CxxTest::TestSuite
     doesNotInclude(_a_abc_, _abc_);
   }
 
+  void testAutomata()
+  {
+    d_smt->setOption("re-automata", SExpr(true));
+    Node sigma = d_nm->mkNode(REGEXP_SIGMA, std::vector<Node>{});
+    Node a = d_nm->mkNode(STRING_TO_REGEXP, d_nm->mkConst(String("a")));
+    Node b = d_nm->mkNode(STRING_TO_REGEXP, d_nm->mkConst(String("b")));
+    Node ab = d_nm->mkNode(STRING_TO_REGEXP, d_nm->mkConst(String("ab")));
+    Node aStar = d_nm->mkNode(REGEXP_STAR, a);
+    Node bStar = d_nm->mkNode(REGEXP_STAR, b);
+    Node bPlus = d_nm->mkNode(REGEXP_CONCAT, b, bStar);
+    Node aOrBStar = d_nm->mkNode(REGEXP_STAR, d_nm->mkNode(REGEXP_UNION, a, b));
+    Node abStar = d_nm->mkNode(REGEXP_STAR, ab);
+    Node aToC = d_nm->mkNode(REGEXP_RANGE,
+                             d_nm->mkConst(String("a")),
+                             d_nm->mkConst(String("c")));
+    Node aToCStar = d_nm->mkNode(REGEXP_STAR, aToC);
+    Node sigmaA = d_nm->mkNode(REGEXP_CONCAT, sigma, a);
+
+    includes(aOrBStar, aStar);
+    doesNotInclude(aStar, aOrBStar);
+    includes(aOrBStar, abStar);
+    doesNotInclude(abStar, aOrBStar);
+    includes(aToCStar, aOrBStar);
+    doesNotInclude(aOrBStar, aToCStar);
+    includes(aOrBStar, d_nm->mkNode(REGEXP_INTER, aToCStar, aOrBStar));
+    doesNotInclude(sigmaA, aStar);
+
+    TS_ASSERT(isIntersectionEmpty(aStar, bPlus));
+    TS_ASSERT(!isIntersectionEmpty(aStar, bStar));
+    TS_ASSERT(!isIntersectionEmpty(aOrBStar, abStar));
+    TS_ASSERT(isIntersectionEmpty(abStar, sigmaA));
+    TS_ASSERT(!isIntersectionEmpty(aToCStar, sigmaA));
+  }
+
  private:
   ExprManager* d_em;
   SmtEngine* d_smt;
@@ -0,0 +1,190 @@
+/*********************                                                        */
+/*! \file theory_arith_basis_factorization_white.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the LU factorization of simplex bases.
+ **
+ ** White box testing of the LU factorization of simplex bases.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "theory/arith/basis_factorization.h"
+
+using namespace CVC4;
+using namespace CVC4::theory::arith;
+
+class TheoryArithBasisFactorizationWhite : public CxxTest::TestSuite
+{
+  typedef BasisFactorization::SparseVector SparseVector;
+
+  /** A random sparse column with a large entry at row diag. */
+  SparseVector randomColumn(std::mt19937& rng, uint32_t size, uint32_t diag)
+  {
+    SparseVector col;
+    for (uint32_t i = 0; i < size; ++i)
+    {
+      if (i == diag)
+      {
+        col.push_back(std::make_pair(i, 4.0 + rng() % 4));
+      }
+      else if (rng() % 4 == 0)
+      {
+        col.push_back(std::make_pair(i, double(int(rng() % 7) - 3)));
+      }
+    }
+    return col;
+  }
+
+  /** B x for the basis with the given columns. */
+  std::vector<double> multiply(const std::vector<SparseVector>& columns,
+                               const std::vector<double>& x)
+  {
+    std::vector<double> b(columns.size(), 0.0);
+    for (uint32_t k = 0; k < columns.size(); ++k)
+    {
+      for (const std::pair<uint32_t, double>& e : columns[k])
+      {
+        b[e.first] += e.second * x[k];
+      }
+    }
+    return b;
+  }
+
+  /** Checks ftran() and btran() against the basis with the given columns. */
+  void checkSolves(const BasisFactorization& lu,
+                   const std::vector<SparseVector>& columns,
+                   std::mt19937& rng)
+  {
+    uint32_t size = columns.size();
+    std::vector<double> x(size);
+    for (double& v : x)
+    {
+      v = double(int(rng() % 11) - 5);
+    }
+    std::vector<double> b = multiply(columns, x);
+    lu.ftran(b, NULL);
+    for (uint32_t k = 0; k < size; ++k)
+    {
+      TS_ASSERT_DELTA(b[k], x[k], 1e-8);
+    }
+
+    // B^T y = c, i.e. column k of B times y is c[k]
+    std::vector<double> y(size);
+    for (double& v : y)
+    {
+      v = double(int(rng() % 11) - 5);
+    }
+    std::vector<double> c(size, 0.0);
+    for (uint32_t k = 0; k < size; ++k)
+    {
+      for (const std::pair<uint32_t, double>& e : columns[k])
+      {
+        c[k] += e.second * y[e.first];
+      }
+    }
+    lu.btran(c);
+    for (uint32_t i = 0; i < size; ++i)
+    {
+      TS_ASSERT_DELTA(c[i], y[i], 1e-8);
+    }
+  }
+
+ public:
+  void testIdentity()
+  {
+    std::vector<SparseVector> columns(3);
+    for (uint32_t k = 0; k < 3; ++k)
+    {
+      columns[k].push_back(std::make_pair(k, -1.0));
+    }
+    BasisFactorization lu;
+    TS_ASSERT(lu.factorize(columns));
+    std::vector<double> b = {1.0, 2.0, 3.0};
+    lu.ftran(b, NULL);
+    TS_ASSERT_EQUALS(b[0], -1.0);
+    TS_ASSERT_EQUALS(b[1], -2.0);
+    TS_ASSERT_EQUALS(b[2], -3.0);
+  }
+
+  void testSingular()
+  {
+    std::vector<SparseVector> columns(2);
+    columns[0].push_back(std::make_pair(0, 1.0));
+    columns[0].push_back(std::make_pair(1, 2.0));
+    columns[1].push_back(std::make_pair(0, 2.0));
+    columns[1].push_back(std::make_pair(1, 4.0));
+    BasisFactorization lu;
+    TS_ASSERT(!lu.factorize(columns));
+  }
+
+  void testFactorize()
+  {
+    std::mt19937 rng(7);
+    for (uint32_t size = 1; size < 40; size += 3)
+    {
+      // permute the diagonal so that the pivots are not in order
+      std::vector<uint32_t> diag(size);
+      for (uint32_t k = 0; k < size; ++k)
+      {
+        diag[k] = k;
+      }
+      std::shuffle(diag.begin(), diag.end(), rng);
+      std::vector<SparseVector> columns;
+      for (uint32_t k = 0; k < size; ++k)
+      {
+        columns.push_back(randomColumn(rng, size, diag[k]));
+      }
+      BasisFactorization lu;
+      TS_ASSERT(lu.factorize(columns));
+      checkSolves(lu, columns, rng);
+    }
+  }
+
+  void testForrestTomlinUpdates()
+  {
+    std::mt19937 rng(11);
+    const uint32_t size = 25;
+    std::vector<SparseVector> columns;
+    for (uint32_t k = 0; k < size; ++k)
+    {
+      columns.push_back(randomColumn(rng, size, k));
+    }
+    BasisFactorization lu;
+    TS_ASSERT(lu.factorize(columns));
+    for (uint32_t u = 0; u < 60; ++u)
+    {
+      uint32_t position = rng() % size;
+      SparseVector col = randomColumn(rng, size, position);
+      std::vector<double> b(size, 0.0);
+      for (const std::pair<uint32_t, double>& e : col)
+      {
+        b[e.first] = e.second;
+      }
+      std::vector<double> spike;
+      lu.ftran(b, &spike);
+      if (std::fabs(b[position]) < 1e-3)
+      {
+        // the new basis would be (nearly) singular
+        continue;
+      }
+      columns[position] = col;
+      if (!lu.update(position, spike))
+      {
+        TS_ASSERT(lu.factorize(columns));
+      }
+      checkSolves(lu, columns, rng);
+    }
+    TS_ASSERT_LESS_THAN(0u, lu.getNumUpdates());
+  }
+};
@@ -0,0 +1,131 @@
+/*********************                                                        */
+/*! \file theory_arith_univariate_polynomial_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of univariate polynomials and their real roots.
+ **
+ ** Black box testing of univariate polynomials and their real roots.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <vector>
+
+#include "theory/arith/univariate_polynomial.h"
+#include "util/rational.h"
+
+using namespace CVC4;
+using namespace CVC4::theory::arith;
+
+class TheoryArithUnivariatePolynomialBlack : public CxxTest::TestSuite
+{
+  typedef UnivariatePolynomial::Root Root;
+
+  UnivariatePolynomial mkPoly(const std::vector<int>& coeffs)
+  {
+    std::vector<Rational> rs;
+    for (int c : coeffs)
+    {
+      rs.push_back(Rational(c));
+    }
+    return UnivariatePolynomial(rs);
+  }
+
+  /** Checks that roots isolates the roots of p, in increasing order. */
+  void checkRoots(const UnivariatePolynomial& p, const std::vector<Root>& roots)
+  {
+    UnivariatePolynomial sf = p.squareFreePart();
+    for (size_t i = 0; i < roots.size(); i++)
+    {
+      const Root& r = roots[i];
+      if (r.isExact())
+      {
+        TS_ASSERT_EQUALS(p.sgnAt(r.d_lower), 0);
+      }
+      else
+      {
+        TS_ASSERT(r.d_lower < r.d_upper);
+        TS_ASSERT_EQUALS(sf.countRoots(r.d_lower, r.d_upper), 1u);
+        TS_ASSERT_DIFFERS(sf.sgnAt(r.d_lower), 0);
+        TS_ASSERT_DIFFERS(sf.sgnAt(r.d_upper), 0);
+      }
+      if (i > 0)
+      {
+        TS_ASSERT(roots[i - 1].d_upper <= r.d_lower);
+      }
+    }
+  }
+
+ public:
+  void testArithmetic()
+  {
+    // (x - 1) * (x + 2) = x^2 + x - 2
+    UnivariatePolynomial p = mkPoly({-1, 1}) * mkPoly({2, 1});
+    TS_ASSERT_EQUALS(p.getDegree(), 2);
+    TS_ASSERT_EQUALS(p.getCoefficient(0), Rational(-2));
+    TS_ASSERT_EQUALS(p.getCoefficient(1), Rational(1));
+    TS_ASSERT_EQUALS(p.evaluate(Rational(3)), Rational(10));
+    TS_ASSERT_EQUALS(p.derivative().getCoefficient(0), Rational(1));
+    TS_ASSERT((p - p).isZero());
+
+    UnivariatePolynomial q, r;
+    p.divide(mkPoly({-1, 1}), q, r);
+    TS_ASSERT(r.isZero());
+    TS_ASSERT_EQUALS(q.evaluate(Rational(0)), Rational(2));
+  }
+
+  void testGcd()
+  {
+    // gcd((x - 1)^2 (x + 3), (x - 1) (x - 5)) = x - 1
+    UnivariatePolynomial a =
+        mkPoly({-1, 1}) * mkPoly({-1, 1}) * mkPoly({3, 1});
+    UnivariatePolynomial b = mkPoly({-1, 1}) * mkPoly({-5, 1});
+    UnivariatePolynomial g = UnivariatePolynomial::gcd(a, b);
+    TS_ASSERT_EQUALS(g.getDegree(), 1);
+    TS_ASSERT_EQUALS(g.getLeadingCoefficient(), Rational(1));
+    TS_ASSERT_EQUALS(g.sgnAt(Rational(1)), 0);
+    TS_ASSERT_EQUALS(a.squareFreePart().getDegree(), 2);
+  }
+
+  void testIsolateRationalRoots()
+  {
+    // 2 (x - 1/2) x (x + 3)^2 has the roots -3, 0 and 1/2
+    UnivariatePolynomial p =
+        mkPoly({-1, 2}) * mkPoly({0, 1}) * mkPoly({3, 1}) * mkPoly({3, 1});
+    std::vector<Root> roots;
+    p.isolateRoots(roots);
+    TS_ASSERT_EQUALS(roots.size(), 3u);
+    checkRoots(p, roots);
+    TS_ASSERT_EQUALS(p.countRoots(Rational(-10), Rational(10)), 3u);
+    TS_ASSERT_EQUALS(p.countRoots(Rational(-1), Rational(0)), 1u);
+  }
+
+  void testIsolateIrrationalRoots()
+  {
+    // x^2 - 2 has the roots -sqrt(2) and sqrt(2), x^2 + 1 has none
+    UnivariatePolynomial p = mkPoly({-2, 0, 1}) * mkPoly({1, 0, 1});
+    std::vector<Root> roots;
+    p.isolateRoots(roots);
+    TS_ASSERT_EQUALS(roots.size(), 2u);
+    checkRoots(p, roots);
+    UnivariatePolynomial sf = p.squareFreePart();
+    Root r = roots[1];
+    for (unsigned i = 0; i < 20; i++)
+    {
+      sf.refineRoot(r);
+    }
+    TS_ASSERT(!r.isExact());
+    TS_ASSERT(r.d_lower * r.d_lower < Rational(2));
+    TS_ASSERT(r.d_upper * r.d_upper > Rational(2));
+    TS_ASSERT(r.d_upper - r.d_lower < Rational(1, 1000));
+
+    std::vector<Root> none;
+    mkPoly({1, 0, 1}).isolateRoots(none);
+    TS_ASSERT(none.empty());
+  }
+};
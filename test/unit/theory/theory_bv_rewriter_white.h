@@ -100,6 +100,34 @@ class TheoryBvRewriterWhite : public CxxTest::TestSuite
     TS_ASSERT_EQUALS(nr, Rewriter::rewrite(nr));
   }
 
+  void testRewriteBatch()
+  {
+    TypeNode bvType = d_nm->mkBitVectorType(8);
+
+    Node zero = d_nm->mkConst(BitVector(8, 0u));
+    Node x = d_nm->mkVar("x", bvType);
+    Node y = d_nm->mkVar("y", bvType);
+    Node sum = d_nm->mkNode(BITVECTOR_PLUS, x, zero);
+    Node prod = d_nm->mkNode(BITVECTOR_MULT, sum, y);
+
+    // shared subterms, a term that is rewritten already, and a leaf
+    std::vector<Node> nodes = {d_nm->mkNode(EQUAL, prod, sum),
+                               d_nm->mkNode(BITVECTOR_ULT, sum, prod),
+                               d_nm->mkNode(BITVECTOR_AND, x, y),
+                               x};
+    std::vector<Node> expected;
+    for (const Node& n : nodes)
+    {
+      expected.push_back(Rewriter::rewrite(n));
+    }
+    Rewriter::clearCaches();
+    Rewriter::rewriteBatch(nodes);
+    TS_ASSERT_EQUALS(nodes, expected);
+    // again, now that the terms are in the cache
+    Rewriter::rewriteBatch(nodes);
+    TS_ASSERT_EQUALS(nodes, expected);
+  }
+
  private:
   ExprManager* d_em;
   SmtEngine* d_smt;
@@ -0,0 +1,148 @@
+/*********************                                                        */
+/*! \file theory_bv_word_domain_white.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the abstract domains of bit-vector values.
+ **
+ ** White box testing of the abstract domains of bit-vector values.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <functional>
+#include <vector>
+
+#include "theory/bv/bv_word_domain.h"
+
+using namespace CVC4;
+using namespace CVC4::theory::bv;
+
+class TheoryBvWordDomainWhite : public CxxTest::TestSuite
+{
+  static const unsigned s_width = 4;
+
+  BitVector bv(unsigned value) { return BitVector(s_width, value); }
+
+  std::vector<WordDomain> someDomains()
+  {
+    std::vector<WordDomain> domains;
+    domains.push_back(WordDomain(s_width));
+    domains.push_back(WordDomain(bv(5)));
+    WordDomain d(s_width);
+    d.restrictUnsigned(bv(2), bv(9));
+    domains.push_back(d);
+    d = WordDomain(s_width);
+    d.restrictBits(bv(1), bv(8));
+    domains.push_back(d);
+    d = WordDomain(s_width);
+    d.restrictSigned(bv(14), bv(3));
+    domains.push_back(d);
+    d.exclude(bv(3));
+    domains.push_back(d);
+    return domains;
+  }
+
+  /** Check that f over-approximates op on all pairs of someDomains(). */
+  void checkSound(
+      std::function<WordDomain(const WordDomain&, const WordDomain&)> f,
+      std::function<BitVector(const BitVector&, const BitVector&)> op)
+  {
+    std::vector<WordDomain> domains = someDomains();
+    for (const WordDomain& a : domains)
+    {
+      for (const WordDomain& b : domains)
+      {
+        WordDomain r = f(a, b);
+        for (unsigned x = 0; x < (1u << s_width); ++x)
+        {
+          for (unsigned y = 0; y < (1u << s_width); ++y)
+          {
+            if (a.contains(bv(x)) && b.contains(bv(y)))
+            {
+              TS_ASSERT(r.contains(op(bv(x), bv(y))));
+            }
+          }
+        }
+      }
+    }
+  }
+
+ public:
+  void testNormalize()
+  {
+    // the bounds move to the nearest values with the known bits
+    WordDomain d(s_width);
+    d.restrictBits(bv(1), bv(0));
+    d.restrictUnsigned(bv(3), bv(9));
+    TS_ASSERT_EQUALS(d.getUnsignedLower(), bv(4));
+    TS_ASSERT_EQUALS(d.getUnsignedUpper(), bv(8));
+    // the common prefix of the bounds is known
+    TS_ASSERT(d.getZeros().isBitSet(2) == false);
+    d.restrictUnsigned(bv(4), bv(6));
+    TS_ASSERT(d.getZeros().isBitSet(3));
+    TS_ASSERT(d.getOnes().isBitSet(2));
+    // an unsigned interval in the lower half bounds the signed interval
+    TS_ASSERT_EQUALS(d.getSignedLower(), bv(4));
+    TS_ASSERT_EQUALS(d.getSignedUpper(), bv(6));
+    d.exclude(bv(4));
+    TS_ASSERT(d.isFixed());
+    TS_ASSERT_EQUALS(d.getUnsignedLower(), bv(6));
+    d.exclude(bv(6));
+    TS_ASSERT(d.isEmpty());
+  }
+
+  void testDisjoint()
+  {
+    WordDomain a(s_width);
+    a.restrictUnsigned(bv(0), bv(7));
+    WordDomain b(s_width);
+    b.restrictSigned(bv(8), bv(15));
+    TS_ASSERT(a.isDisjoint(b));
+    TS_ASSERT(!a.isDisjoint(WordDomain(s_width)));
+  }
+
+  void testTransferFunctions()
+  {
+    checkSound(WordDomain::mkAnd,
+               [](const BitVector& x, const BitVector& y) { return x & y; });
+    checkSound(WordDomain::mkOr,
+               [](const BitVector& x, const BitVector& y) { return x | y; });
+    checkSound(WordDomain::mkXor,
+               [](const BitVector& x, const BitVector& y) { return x ^ y; });
+    checkSound(WordDomain::mkPlus,
+               [](const BitVector& x, const BitVector& y) { return x + y; });
+    checkSound(WordDomain::mkMult,
+               [](const BitVector& x, const BitVector& y) { return x * y; });
+    checkSound(WordDomain::mkShl, [](const BitVector& x, const BitVector& y) {
+      return x.leftShift(y);
+    });
+    checkSound(WordDomain::mkLshr, [](const BitVector& x, const BitVector& y) {
+      return x.logicalRightShift(y);
+    });
+    checkSound(WordDomain::mkAshr, [](const BitVector& x, const BitVector& y) {
+      return x.arithRightShift(y);
+    });
+    checkSound(WordDomain::mkUdiv, [](const BitVector& x, const BitVector& y) {
+      return x.unsignedDivTotal(y);
+    });
+    checkSound(WordDomain::mkUrem, [](const BitVector& x, const BitVector& y) {
+      return x.unsignedRemTotal(y);
+    });
+  }
+
+  void testPlusBounds()
+  {
+    // [2, 9] + [2, 9] does not overflow
+    WordDomain a(s_width);
+    a.restrictUnsigned(bv(2), bv(5));
+    WordDomain r = WordDomain::mkPlus(a, a);
+    TS_ASSERT_EQUALS(r.getUnsignedLower(), bv(4));
+    TS_ASSERT_EQUALS(r.getUnsignedUpper(), bv(10));
+    TS_ASSERT(!r.contains(bv(12)));
+  }
+};
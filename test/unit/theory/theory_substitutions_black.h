@@ -0,0 +1,111 @@
+/*********************                                                        */
+/*! \file theory_substitutions_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of the substitution maps of theory simplification.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <memory>
+
+#include "context/context.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "theory/substitutions.h"
+#include "util/rational.h"
+
+using namespace CVC4;
+using namespace CVC4::context;
+using namespace CVC4::theory;
+
+class TheorySubstitutionsBlack : public CxxTest::TestSuite
+{
+ public:
+  void setUp() override
+  {
+    d_nm.reset(new NodeManager(nullptr));
+    d_scope.reset(new NodeManagerScope(d_nm.get()));
+    d_context.reset(new Context());
+  }
+
+  void tearDown() override
+  {
+    d_context.reset();
+    d_scope.reset();
+    d_nm.reset();
+  }
+
+  void testApplyAfterAdd()
+  {
+    Node one = d_nm->mkConst(Rational(1));
+    Node three = d_nm->mkConst(Rational(3));
+    Node x = d_nm->mkSkolem("x", d_nm->integerType());
+    Node y = d_nm->mkSkolem("y", d_nm->integerType());
+    Node z = d_nm->mkSkolem("z", d_nm->integerType());
+    Node yp1 = d_nm->mkNode(kind::PLUS, y, one);
+    Node xz = d_nm->mkNode(kind::PLUS, x, z);
+    Node yy = d_nm->mkNode(kind::MULT, y, y);
+
+    SubstitutionMap subs(d_context.get());
+    subs.addSubstitution(x, yp1);
+    TS_ASSERT_EQUALS(subs.apply(xz), d_nm->mkNode(kind::PLUS, yp1, z));
+    TS_ASSERT_EQUALS(subs.apply(yy), yy);
+
+    // the results that contain z must be recomputed, the others not
+    subs.addSubstitution(z, three);
+    TS_ASSERT_EQUALS(subs.apply(xz), d_nm->mkNode(kind::PLUS, yp1, three));
+    TS_ASSERT_EQUALS(subs.apply(yy), yy);
+
+    // y occurs in the result of x
+    subs.addSubstitution(y, three);
+    Node tp1 = d_nm->mkNode(kind::PLUS, three, one);
+    TS_ASSERT_EQUALS(subs.apply(x), tp1);
+    TS_ASSERT_EQUALS(subs.apply(xz), d_nm->mkNode(kind::PLUS, tp1, three));
+    TS_ASSERT_EQUALS(subs.apply(yy), d_nm->mkNode(kind::MULT, three, three));
+  }
+
+  void testApplyAfterPop()
+  {
+    Node one = d_nm->mkConst(Rational(1));
+    Node x = d_nm->mkSkolem("x", d_nm->integerType());
+    Node y = d_nm->mkSkolem("y", d_nm->integerType());
+    Node xy = d_nm->mkNode(kind::PLUS, x, y);
+
+    SubstitutionMap subs(d_context.get());
+    subs.addSubstitution(x, one);
+    d_context->push();
+    subs.addSubstitution(y, one);
+    TS_ASSERT_EQUALS(subs.apply(xy), d_nm->mkNode(kind::PLUS, one, one));
+    d_context->pop();
+    TS_ASSERT_EQUALS(subs.apply(xy), d_nm->mkNode(kind::PLUS, one, y));
+  }
+
+  void testApplyAfterAddTerm()
+  {
+    Node zero = d_nm->mkConst(Rational(0));
+    Node x = d_nm->mkSkolem("x", d_nm->integerType());
+    Node y = d_nm->mkSkolem("y", d_nm->integerType());
+    Node z = d_nm->mkSkolem("z", d_nm->integerType());
+    Node xy = d_nm->mkNode(kind::PLUS, x, y);
+    Node zy = d_nm->mkNode(kind::PLUS, z, y);
+    Node lt = d_nm->mkNode(kind::LT, xy, zero);
+
+    SubstitutionMap subs(d_context.get());
+    subs.addSubstitution(x, z);
+    TS_ASSERT_EQUALS(subs.apply(lt), d_nm->mkNode(kind::LT, zy, zero));
+    // a substituted term, which the results contain without depending on it
+    subs.addSubstitution(zy, zero);
+    TS_ASSERT_EQUALS(subs.apply(lt), d_nm->mkNode(kind::LT, zero, zero));
+  }
+
+ private:
+  std::unique_ptr<NodeManager> d_nm;
+  std::unique_ptr<NodeManagerScope> d_scope;
+  std::unique_ptr<Context> d_context;
+};
@@ -212,6 +212,54 @@ class TypeEnumeratorWhite : public CxxTest::TestSuite {
     TS_ASSERT( ! te.isFinished() );
   }
 
+  void testDatatypesNested() {
+    Datatype colors(d_em, "Colors");
+    colors.addConstructor(DatatypeConstructor("red"));
+    colors.addConstructor(DatatypeConstructor("blue"));
+    TypeNode colorsType = TypeNode::fromType(d_em->mkDatatypeType(colors));
+    Datatype listColors(d_em, "ListColors");
+    DatatypeConstructor consC("cons");
+    consC.addArg("car", colorsType.toType());
+    consC.addArg("cdr", DatatypeSelfType());
+    listColors.addConstructor(consC);
+    listColors.addConstructor(DatatypeConstructor("nil"));
+    TypeNode listColorsType = TypeNode::fromType(d_em->mkDatatypeType(listColors));
+    Datatype listLists(d_em, "ListLists");
+    DatatypeConstructor consL("consL");
+    consL.addArg("carL", listColorsType.toType());
+    consL.addArg("cdrL", DatatypeSelfType());
+    listLists.addConstructor(consL);
+    listLists.addConstructor(DatatypeConstructor("nilL"));
+    TypeNode listListsType = TypeNode::fromType(d_em->mkDatatypeType(listLists));
+
+    // the enumerators of the nested types share their terms, which must not
+    // change the enumeration
+    TypeEnumerator te(listListsType);
+    std::vector<Node> terms;
+    std::unordered_set<Node, NodeHashFunction> termSet;
+    for (unsigned i = 0; i < 50; ++i, ++te)
+    {
+      TS_ASSERT(!te.isFinished());
+      TS_ASSERT((*te).isConst());
+      TS_ASSERT_EQUALS((*te).getType(), listListsType);
+      terms.push_back(*te);
+      termSet.insert(*te);
+    }
+    TS_ASSERT_EQUALS(termSet.size(), terms.size());
+    // a copy continues the same enumeration
+    TypeEnumerator te2(listListsType);
+    for (unsigned i = 0; i < 25; ++i)
+    {
+      ++te2;
+    }
+    TypeEnumerator te3 = te2;
+    for (unsigned i = 25; i < 50; ++i, ++te2, ++te3)
+    {
+      TS_ASSERT_EQUALS(*te2, terms[i]);
+      TS_ASSERT_EQUALS(*te3, terms[i]);
+    }
+  }
+
   void NOTYETtestDatatypesInfinite2() {
     //TypeNode datatype;
     //TypeEnumerator te(datatype);
@@ -0,0 +1,131 @@
+/*********************                                                        */
+/*! \file dary_heap_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of CVC4::IndexedDAryHeap
+ **
+ ** Black box testing of CVC4::IndexedDAryHeap.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <vector>
+
+#include "test_utils.h"
+#include "util/dary_heap.h"
+
+using namespace CVC4;
+using namespace std;
+
+class DAryHeapBlack : public CxxTest::TestSuite
+{
+ public:
+  void setUp() override {}
+
+  void tearDown() override {}
+
+  /** Compares elements by their keys, which live outside of the heap. */
+  struct Cmp
+  {
+    const vector<int>* d_keys;
+    bool d_reverse;
+    Cmp(const vector<int>* keys = nullptr, bool reverse = false)
+        : d_keys(keys), d_reverse(reverse)
+    {
+    }
+    bool operator()(unsigned a, unsigned b) const
+    {
+      return d_reverse ? (*d_keys)[b] < (*d_keys)[a]
+                       : (*d_keys)[a] < (*d_keys)[b];
+    }
+  };
+
+  void testPushPopErase()
+  {
+    IndexedDAryHeap<unsigned> heap;
+    TS_ASSERT(heap.empty());
+#ifdef CVC4_ASSERTIONS
+    TS_UTILS_EXPECT_ABORT(heap.top());
+    TS_UTILS_EXPECT_ABORT(heap.pop());
+#endif /* CVC4_ASSERTIONS */
+    TS_ASSERT_EQUALS(heap.begin(), heap.end());
+
+    heap.push(5);
+    heap.push(30);
+    heap.push(12);
+    heap.push(0);
+    TS_ASSERT_EQUALS(heap.size(), 4u);
+    TS_ASSERT(heap.contains(12));
+    TS_ASSERT(!heap.contains(13));
+    TS_ASSERT(!heap.contains(100));
+    TS_ASSERT_EQUALS(heap.top(), 30u);
+
+    heap.erase(12);
+    TS_ASSERT(!heap.contains(12));
+    TS_ASSERT_EQUALS(heap.size(), 3u);
+    heap.pop();
+    TS_ASSERT_EQUALS(heap.top(), 5u);
+    heap.pop();
+    TS_ASSERT_EQUALS(heap.top(), 0u);
+    heap.pop();
+    TS_ASSERT(heap.empty());
+
+    // elements can be pushed again once removed
+    heap.push(12);
+    heap.push(30);
+    TS_ASSERT_EQUALS(heap.top(), 30u);
+    heap.clear();
+    TS_ASSERT(heap.empty());
+    TS_ASSERT(!heap.contains(30));
+    heap.push(30);
+    TS_ASSERT_EQUALS(heap.top(), 30u);
+  }
+
+  void testUpdateAndComparator()
+  {
+    const unsigned n = 1000;
+    vector<int> keys(n);
+    Cmp cmp(&keys);
+    IndexedDAryHeap<unsigned, Cmp> heap(cmp);
+    for (unsigned x = 0; x < n; ++x)
+    {
+      keys[x] = static_cast<int>((x * 7919) % 1009);
+      heap.push(x);
+    }
+    TS_ASSERT_EQUALS(heap.size(), n);
+
+    // increase and decrease some keys
+    for (unsigned x = 0; x < n; x += 7)
+    {
+      keys[x] = (x % 2 == 0) ? keys[x] + 500 : keys[x] - 500;
+      heap.update(x);
+    }
+    heap.erase(10);
+    heap.erase(999);
+    TS_ASSERT_EQUALS(heap.size(), n - 2);
+
+    int last = keys[heap.top()];
+    for (unsigned i = 0; i < 400; ++i)
+    {
+      TS_ASSERT_LESS_THAN_EQUALS(keys[heap.top()], last);
+      last = keys[heap.top()];
+      heap.pop();
+    }
+
+    // reverse the order of the remaining elements
+    heap.setComparator(Cmp(&keys, true));
+    TS_ASSERT_EQUALS(heap.size(), n - 402);
+    last = keys[heap.top()];
+    while (!heap.empty())
+    {
+      TS_ASSERT_LESS_THAN_EQUALS(last, keys[heap.top()]);
+      last = keys[heap.top()];
+      heap.pop();
+    }
+  }
+}; /* class DAryHeapBlack */
@@ -556,4 +556,43 @@ public:
       }
     }
   }
+
+  void testWordBoundary()
+  {
+    const long maxLong = std::numeric_limits<long>::max();
+    const long minLong = std::numeric_limits<long>::min();
+    Integer max(maxLong);
+    Integer min(minLong);
+    Integer one(1);
+
+    // values beyond a machine word are promoted and demoted again
+    Integer maxPlusOne = max + one;
+    TS_ASSERT_EQUALS(maxPlusOne.toString(), "9223372036854775808");
+    TS_ASSERT(!maxPlusOne.fitsSignedLong());
+    TS_ASSERT_EQUALS(maxPlusOne - one, max);
+    TS_ASSERT_EQUALS((maxPlusOne - one).hash(), max.hash());
+    TS_ASSERT_EQUALS(min.getLong(), minLong);
+    TS_ASSERT_EQUALS((-min).toString(), "9223372036854775808");
+    TS_ASSERT_EQUALS(-(-min), min);
+    TS_ASSERT_EQUALS(min.abs(), maxPlusOne);
+    TS_ASSERT_EQUALS((max * max).toString(),
+                     "85070591730234615847396907784232501249");
+    TS_ASSERT_EQUALS((max * max).floorDivideQuotient(max), max);
+    TS_ASSERT_EQUALS(min.floorDivideQuotient(Integer(-1)), maxPlusOne);
+    TS_ASSERT_EQUALS(one.multiplyByPow2(63), maxPlusOne);
+    TS_ASSERT_EQUALS(maxPlusOne.divByPow2(63), one);
+    TS_ASSERT_EQUALS(Integer(2).pow(63), maxPlusOne);
+    TS_ASSERT_EQUALS(Integer(3).pow(39).toString(), "4052555153018976267");
+    TS_ASSERT_EQUALS(Integer(3).pow(40).toString(), "12157665459056928801");
+    TS_ASSERT(Integer(std::numeric_limits<unsigned long>::max()) > max);
+
+    // bit operations use the two's complement of negative values
+    Integer minusTwo(-2);
+    TS_ASSERT(minusTwo.testBit(100));
+    TS_ASSERT(!minusTwo.testBit(0));
+    TS_ASSERT_EQUALS(minusTwo.extractBitRange(4, 62), Integer(15));
+    TS_ASSERT_EQUALS(minusTwo.modByPow2(64).toString(), "18446744073709551614");
+    TS_ASSERT_EQUALS(Integer(-5).divByPow2(1), Integer(-3));
+    TS_ASSERT_EQUALS(minusTwo.bitwiseAnd(max), max - one);
+  }
 };
@@ -15,6 +15,7 @@
  **/
 
 #include <cxxtest/TestSuite.h>
+#include <limits>
 #include <sstream>
 
 #include "util/rational.h"
@@ -44,4 +45,49 @@ public:
     TS_ASSERT_THROWS( Rational::fromDecimal("Hello, world!");, const std::invalid_argument& );
   }
 
+  void testAddProduct() {
+    Rational q(1, 2);
+    q.addProduct(Rational(2, 3), Rational(-3, 4));
+    TS_ASSERT_EQUALS(q, Rational(0, 1));
+    q.addProduct(Rational(5, 1), Rational(7, 1));
+    TS_ASSERT_EQUALS(q, Rational(35, 1));
+    // aliasing the operands
+    q.addProduct(q, q);
+    TS_ASSERT_EQUALS(q, Rational(35 + 35 * 35, 1));
+
+    // results beyond 64 bits fall back to multi-precision arithmetic
+    Rational big(Integer("4611686018427387903"), Integer(1));
+    Rational r(Integer("4611686018427387903"), Integer(1));
+    r.addProduct(big, big);
+    TS_ASSERT_EQUALS(r, big + big * big);
+    Rational c(canReduce);
+    Rational s(1, 3);
+    s.addProduct(c, Rational(3, 7));
+    TS_ASSERT_EQUALS(s, Rational(1, 3) + c * Rational(3, 7));
+  }
+
+  void testWordBoundary() {
+    const long maxLong = std::numeric_limits<long>::max();
+    Rational max(maxLong, 1L);
+    Rational half(1, 2);
+
+    Rational sum = max + half;
+    TS_ASSERT_EQUALS(sum.toString(), "18446744073709551615/2");
+    TS_ASSERT_EQUALS(sum.getNumerator(), Integer(maxLong) * 2 + 1);
+    TS_ASSERT_EQUALS(sum - half, max);
+    TS_ASSERT_EQUALS((sum - half).hash(), max.hash());
+    TS_ASSERT(sum > max);
+    TS_ASSERT_EQUALS(sum.floor(), Integer(maxLong));
+    TS_ASSERT_EQUALS(sum.ceiling(), Integer(maxLong) + 1);
+
+    // the denominators overflow, the result does not
+    Rational a(1L, maxLong);
+    Rational b(1L, maxLong - 1);
+    TS_ASSERT_EQUALS((a * b) / b, a);
+    TS_ASSERT_EQUALS((a + b) - b, a);
+    TS_ASSERT(a < b);
+    TS_ASSERT_EQUALS(Rational(-6, -4), Rational(3, 2));
+    TS_ASSERT_EQUALS(Rational(6, -4).toString(), "-3/2");
+  }
+
 };
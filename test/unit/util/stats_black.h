@@ -180,4 +180,32 @@ public:
 #endif /* CVC4_STATISTICS_ON */
   }
 
+  void testJsonAndDelta()
+  {
+#ifdef CVC4_STATISTICS_ON
+    StatisticsRegistry reg;
+    IntStat sInt("my int", 10);
+    BackedStat<string> backedStr("backed \"str\"", "a");
+    reg.registerStat(&sInt);
+    reg.registerStat(&backedStr);
+
+    Statistics before(reg);
+    sInt.setData(15);
+    backedStr.setData("b");
+    Statistics after(reg);
+
+    stringstream sstr;
+    after.flushInformationJson(sstr);
+    TS_ASSERT_EQUALS(sstr.str(),
+                     "{\"backed \\\"str\\\"\": \"b\", \"my int\": 15}");
+    sstr.str("");
+    after.getDelta(before).flushInformationJson(sstr);
+    TS_ASSERT_EQUALS(sstr.str(),
+                     "{\"backed \\\"str\\\"\": \"b\", \"my int\": 5}");
+
+    reg.unregisterStat(&sInt);
+    reg.unregisterStat(&backedStr);
+#endif /* CVC4_STATISTICS_ON */
+  }
+
 };